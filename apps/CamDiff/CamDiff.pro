@@ -0,0 +1,36 @@
+#-------------------------------------------------
+#
+# Command line tool to compare Gerber and Excellon files by their rendered images
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+TARGET = cam-diff
+
+# Console application (no GUI)
+CONFIG += console
+CONFIG -= app_bundle
+
+# Set the path for the generated binary
+GENERATED_DIR = ../../generated
+
+# Use common project definitions
+include(../../common.pri)
+
+QT += core widgets network xml sql
+
+LIBS += \
+    -L$${DESTDIR} \
+    -llibrepcbcommon
+
+INCLUDEPATH += \
+    ../../libs
+
+DEPENDPATH += \
+    ../../libs/librepcb/common
+
+PRE_TARGETDEPS += \
+    $${DESTDIR}/liblibrepcbcommon.a
+
+SOURCES += \
+    main.cpp \
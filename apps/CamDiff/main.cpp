@@ -0,0 +1,298 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <librepcb/common/application.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/jobscheduler.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/cam/camimage.h>
+#include <librepcb/common/cam/camimagecomparator.h>
+#include <librepcb/common/cam/excellonreader.h>
+#include <librepcb/common/cam/gerberreader.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+using namespace librepcb;
+
+/*****************************************************************************************
+ *  Types
+ ****************************************************************************************/
+
+/// The files to compare and their images (or the error message if reading failed)
+struct Entry {
+    QString name;       ///< relative path used for the output
+    FilePath fileA;
+    FilePath fileB;
+    CamImage imageA;
+    CamImage imageB;
+    QString error;
+};
+
+/**
+ * @brief Reads both files of an entry in the JobScheduler
+ */
+class ReadJob final : public QRunnable
+{
+    public:
+        explicit ReadJob(Entry& entry) noexcept : mEntry(entry) {setAutoDelete(true);}
+        void run() noexcept override;
+
+    private:
+        Entry& mEntry;
+};
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static bool isCamFile(const QString& filename) noexcept;
+static CamImage readCamFile(const FilePath& filepath);
+static QStringList getCamFiles(const FilePath& dir) noexcept;
+static void writeDifferenceImage(const Entry& entry,
+                                 const CamImageComparator::Result& result,
+                                 const FilePath& dir, qreal pixelsPerMm);
+
+/*****************************************************************************************
+ *  main()
+ ****************************************************************************************/
+
+int main(int argc, char* argv[])
+{
+    // No windows are shown at all, so run without a display (e.g. on build servers)
+    // unless another platform plugin is explicitly requested.
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv);
+
+    QCoreApplication::setOrganizationName("LibrePCB");
+    QCoreApplication::setApplicationName("CamDiff");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compare Gerber and Excellon files by their rendered "
+                                     "images. If directories are given, all CAM files with "
+                                     "the same name are compared. The exit code is 0 if "
+                                     "there are no differences, 1 if there are differences "
+                                     "and 2 on errors.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("a", "First file or directory.");
+    parser.addPositionalArgument("b", "Second file or directory.");
+    parser.addOption(QCommandLineOption("resolution",
+        "Rendering resolution in pixels per millimeter. Default: 40.", "pixels"));
+    parser.addOption(QCommandLineOption("tolerance",
+        "Maximum allowed displacement of edges in millimeters. Default: 0.025.", "mm"));
+    parser.addOption(QCommandLineOption("diff-images",
+        "Write an image of every file with differences into the given directory (red: "
+        "only in the first file, green: only in the second file).", "directory"));
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    if (parser.positionalArguments().count() != 2) {
+        err << "Exactly two files or directories must be specified." << endl;
+        parser.showHelp(2);
+    }
+
+    CamImageComparator::Options options;
+    if (parser.isSet("resolution")) {
+        bool ok = false;
+        options.pixelsPerMm = parser.value("resolution").toDouble(&ok);
+        if ((!ok) || (options.pixelsPerMm <= 0)) {
+            err << "Invalid resolution: " << parser.value("resolution") << endl;
+            return 2;
+        }
+    }
+    if (parser.isSet("tolerance")) {
+        try {
+            options.tolerance = Length::fromMm(parser.value("tolerance")); // can throw
+        } catch (const Exception& e) {
+            err << "Invalid tolerance: " << e.getMsg() << endl;
+            return 2;
+        }
+    }
+    FilePath diffImageDir;
+    if (parser.isSet("diff-images")) {
+        diffImageDir = FilePath(QFileInfo(parser.value("diff-images")).absoluteFilePath());
+    }
+
+    // collect the files to compare
+    FilePath pathA(QFileInfo(parser.positionalArguments().at(0)).absoluteFilePath());
+    FilePath pathB(QFileInfo(parser.positionalArguments().at(1)).absoluteFilePath());
+    QVector<Entry> entries;
+    if (pathA.isExistingDir() && pathB.isExistingDir()) {
+        QStringList names = getCamFiles(pathA) + getCamFiles(pathB);
+        names.removeDuplicates();
+        names.sort();
+        foreach (const QString& name, names) {
+            Entry entry;
+            entry.name = name;
+            entry.fileA = pathA.getPathTo(name);
+            entry.fileB = pathB.getPathTo(name);
+            entries.append(entry);
+        }
+    } else if (pathA.isExistingFile() && pathB.isExistingFile()) {
+        Entry entry;
+        entry.name = pathA.getFilename();
+        entry.fileA = pathA;
+        entry.fileB = pathB;
+        entries.append(entry);
+    } else {
+        err << "Both arguments must be existing files or existing directories." << endl;
+        return 2;
+    }
+
+    // read all files in parallel, then compare them one after the other (the tiles of
+    // each comparison are rendered in parallel)
+    JobScheduler scheduler;
+    {
+        JobScheduler::Group jobs(scheduler, JobScheduler::Priority::Interactive);
+        for (Entry& entry : entries) {
+            jobs.start(new ReadJob(entry));
+        }
+        jobs.waitForDone();
+    }
+    bool different = false;
+    bool failed = false;
+    foreach (const Entry& entry, entries) {
+        if (!entry.error.isEmpty()) {
+            out << entry.name << ": ERROR: " << entry.error << endl;
+            failed = true;
+            continue;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        CamImageComparator::Result result = CamImageComparator::compare(
+            entry.imageA, entry.imageB, options, scheduler);
+        if (result.isEqual()) {
+            out << entry.name << ": OK (" << timer.elapsed() << " ms)" << endl;
+            continue;
+        }
+        different = true;
+        qreal pixelArea = qPow(1 / options.pixelsPerMm, 2);
+        out << entry.name << ": DIFFERENT (" << result.differentPixels << " pixels, "
+            << QString::number(result.differentPixels * pixelArea, 'f', 3) << " mm²)"
+            << endl;
+        for (int i = 0; i < result.differences.count(); ++i) {
+            if (i >= 10) {
+                out << "  ... and " << (result.differences.count() - i) << " more areas"
+                    << endl;
+                break;
+            }
+            const QRectF& r = result.differences.at(i).rect;
+            out << QString("  at (%1, %2) - (%3, %4) mm")
+                   .arg(r.left() / 1e6, 0, 'f', 3).arg(r.top() / 1e6, 0, 'f', 3)
+                   .arg(r.right() / 1e6, 0, 'f', 3).arg(r.bottom() / 1e6, 0, 'f', 3)
+                << endl;
+        }
+        if (diffImageDir.isValid()) {
+            try {
+                writeDifferenceImage(entry, result, diffImageDir, options.pixelsPerMm); // can throw
+            } catch (const Exception& e) {
+                err << "Failed to write difference image: " << e.getMsg() << endl;
+                failed = true;
+            }
+        }
+    }
+    return failed ? 2 : (different ? 1 : 0);
+}
+
+/*****************************************************************************************
+ *  ReadJob
+ ****************************************************************************************/
+
+void ReadJob::run() noexcept
+{
+    try {
+        mEntry.imageA = readCamFile(mEntry.fileA); // can throw
+        mEntry.imageB = readCamFile(mEntry.fileB); // can throw
+    } catch (const Exception& e) {
+        mEntry.error = e.getMsg();
+    }
+}
+
+/*****************************************************************************************
+ *  Helper Functions
+ ****************************************************************************************/
+
+static bool isCamFile(const QString& filename) noexcept
+{
+    static const QRegularExpression regex("\\.(gbr|ger|pho|art|drl|xln|exc|drd|g[a-z0-9]{1,2})$",
+                                          QRegularExpression::CaseInsensitiveOption);
+    return regex.match(filename).hasMatch();
+}
+
+static CamImage readCamFile(const FilePath& filepath)
+{
+    if (!filepath.isExistingFile()) {
+        throw RuntimeError(__FILE__, __LINE__, QString("The file \"%1\" does not exist.")
+                           .arg(filepath.toNative()));
+    }
+    QByteArray content = FileUtils::readFile(filepath); // can throw
+    static const QRegularExpression excellonSuffix("^(drl|xln|exc|drd)$",
+                                                   QRegularExpression::CaseInsensitiveOption);
+    if (excellonSuffix.match(filepath.getSuffix()).hasMatch() || content.startsWith("M48")) {
+        return ExcellonReader::read(content); // can throw
+    } else {
+        return GerberReader::read(content); // can throw
+    }
+}
+
+static QStringList getCamFiles(const FilePath& dir) noexcept
+{
+    QStringList names;
+    QDirIterator it(dir.toStr(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        FilePath filepath(it.next());
+        if (isCamFile(filepath.getFilename())) {
+            names.append(filepath.toRelative(dir));
+        }
+    }
+    return names;
+}
+
+static void writeDifferenceImage(const Entry& entry,
+                                 const CamImageComparator::Result& result,
+                                 const FilePath& dir, qreal pixelsPerMm)
+{
+    // show all differences with some context, but limit the size of the image
+    QRectF rect;
+    foreach (const CamImageComparator::Difference& difference, result.differences) {
+        rect = rect.isNull() ? difference.rect : rect.united(difference.rect);
+    }
+    rect.adjust(-2000000, -2000000, 2000000, 2000000);
+    rect = rect.intersected(result.area);
+    qreal maxPixelsPerMm = 4000 / (qMax(rect.width(), rect.height()) / 1e6);
+    QImage image = CamImageComparator::renderDifference(entry.imageA, entry.imageB, rect,
+                                                        qMin(pixelsPerMm, maxPixelsPerMm));
+    FilePath filepath = dir.getPathTo(entry.name + ".png");
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    if (!image.save(filepath.toStr(), "PNG")) {
+        throw RuntimeError(__FILE__, __LINE__, QString("Could not write \"%1\".")
+                           .arg(filepath.toNative()));
+    }
+}
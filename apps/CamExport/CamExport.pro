@@ -0,0 +1,42 @@
+#-------------------------------------------------
+#
+# Command line tool to export fabrication data of projects
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+TARGET = cam-export
+
+# Console application (no GUI)
+CONFIG += console
+CONFIG -= app_bundle
+
+# Set the path for the generated binary
+GENERATED_DIR = ../../generated
+
+# Use common project definitions
+include(../../common.pri)
+
+QT += core widgets network xml sql
+
+LIBS += \
+    -L$${DESTDIR} \
+    -llibrepcbproject \
+    -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
+    -llibrepcbcommon       # Another order could end up in "undefined reference" errors!
+
+INCLUDEPATH += \
+    ../../libs
+
+DEPENDPATH += \
+    ../../libs/librepcb/project \
+    ../../libs/librepcb/library \
+    ../../libs/librepcb/common
+
+PRE_TARGETDEPS += \
+    $${DESTDIR}/liblibrepcbproject.a \
+    $${DESTDIR}/liblibrepcblibrary.a \
+    $${DESTDIR}/liblibrepcbcommon.a
+
+SOURCES += \
+    main.cpp \
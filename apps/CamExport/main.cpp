@@ -0,0 +1,422 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <QtNetwork>
+#include <librepcb/common/application.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardgerberexport.h>
+#include <librepcb/project/boards/boardpickplaceexport.h>
+#include <librepcb/project/boards/boardipc2581export.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/circuitsnapshot.h>
+#include <librepcb/project/circuit/circuitbomexport.h>
+#include <librepcb/project/circuit/circuitnetlistexport.h>
+#include <librepcb/project/erc/ercmsg.h>
+#include <librepcb/project/erc/ercmsglist.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+using namespace librepcb;
+using namespace librepcb::project;
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static void addOptions(QCommandLineParser& parser) noexcept;
+static int runJob(const QStringList& arguments, const QDir& workingDir, QTextStream& out,
+                  QTextStream& err) noexcept;
+static int runDaemon(const QString& name) noexcept;
+static void processDaemonRequest(QLocalSocket& socket) noexcept;
+static int runClient(const QString& name, const QStringList& arguments) noexcept;
+static QList<Board*> getBoardsToExport(const Project& project, const QStringList& names);
+static FilePath getOutputDirectory(const Project& project, const Board& board,
+                                   const QString& outputDir, bool multipleBoards) noexcept;
+
+/*****************************************************************************************
+ *  main()
+ ****************************************************************************************/
+
+int main(int argc, char* argv[])
+{
+    // No windows are shown at all, so run without a display (e.g. on build servers)
+    // unless another platform plugin is explicitly requested.
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv);
+
+    QCoreApplication::setOrganizationName("LibrePCB");
+    QCoreApplication::setApplicationName("CamExport");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Export Gerber and Excellon files (and optionally the "
+                                     "BOM and the netlist) of LibrePCB projects.");
+    parser.addHelpOption();
+    addOptions(parser);
+    parser.process(app);
+
+    if (parser.isSet("daemon")) {
+        return runDaemon(parser.value("daemon"));
+    } else if (parser.isSet("connect")) {
+        return runClient(parser.value("connect"), app.arguments());
+    } else {
+        QTextStream out(stdout);
+        QTextStream err(stderr);
+        if (parser.positionalArguments().count() != 1) {
+            err << "Exactly one project file must be specified." << endl;
+            parser.showHelp(1);
+        }
+        return runJob(app.arguments(), QDir::current(), out, err);
+    }
+}
+
+/*****************************************************************************************
+ *  addOptions()
+ ****************************************************************************************/
+
+static void addOptions(QCommandLineParser& parser) noexcept
+{
+    parser.addPositionalArgument("project", "Path to the project file (*.lpp).");
+    parser.addOption(QCommandLineOption(QStringList() << "b" << "board",
+        "Name of the board to export (may be given multiple times). Default: all boards.",
+        "name"));
+    parser.addOption(QCommandLineOption(QStringList() << "o" << "output",
+        "Output directory. If multiple boards are exported, a subdirectory is created "
+        "for each board. Default: \"output/<version>/gerber\" within the project.",
+        "directory"));
+    parser.addOption(QCommandLineOption("erc",
+        "Report the messages of the electrical rule check. Projects with errors are "
+        "reported as failed, but are exported anyway."));
+    parser.addOption(QCommandLineOption("drc",
+        "Run the design rule check before exporting. Boards with violations are "
+        "reported as failed, but are exported anyway."));
+    parser.addOption(QCommandLineOption("bom",
+        "Export the bill of materials of each board as CSV file."));
+    parser.addOption(QCommandLineOption("netlist",
+        "Export the netlist of each board as CSV file."));
+    parser.addOption(QCommandLineOption("pnp",
+        "Export the pick-and-place file of each board as CSV file."));
+    parser.addOption(QCommandLineOption("ipc2581",
+        "Export each board additionally as IPC-2581 XML file."));
+    parser.addOption(QCommandLineOption("merge-copper",
+        "Merge the copper of each net into unified regions in the Gerber files. This "
+        "takes longer, but avoids overlapping objects in the files."));
+    parser.addOption(QCommandLineOption("force",
+        "Export the Gerber and Excellon files even if the board did not change since "
+        "the last export into the same output directory."));
+    parser.addOption(QCommandLineOption("daemon",
+        "Keep running and process the jobs sent by \"--connect <name>\" over the local "
+        "socket with the given name, one after the other. This avoids the startup costs "
+        "for every job (e.g. on build servers).", "name"));
+    parser.addOption(QCommandLineOption("connect",
+        "Send the job to the daemon listening on the local socket with the given name "
+        "instead of processing it in this process (the output and the exit code are "
+        "the same).", "name"));
+}
+
+/*****************************************************************************************
+ *  runJob()
+ ****************************************************************************************/
+
+/**
+ * @brief Process a single export job
+ *
+ * @param arguments     The command line arguments (incl. the program name)
+ * @param workingDir    The directory to resolve relative paths against
+ * @param out           Stream for the progress output
+ * @param err           Stream for the error output
+ *
+ * @return The exit code (0 on success)
+ */
+static int runJob(const QStringList& arguments, const QDir& workingDir, QTextStream& out,
+                  QTextStream& err) noexcept
+{
+    QCommandLineParser parser;
+    addOptions(parser);
+    if (!parser.parse(arguments)) {
+        err << parser.errorText() << endl;
+        return 1;
+    }
+    if (parser.positionalArguments().count() != 1) {
+        err << "Exactly one project file must be specified." << endl;
+        return 1;
+    }
+    FilePath projectFp(workingDir.absoluteFilePath(parser.positionalArguments().first()));
+    QString outputOption = parser.value("output");
+    if (!outputOption.isEmpty()) {
+        outputOption = workingDir.absoluteFilePath(outputOption);
+    }
+
+    try
+    {
+        Project project(projectFp, true, true); // read-only, model-only; can throw
+        QList<Board*> boards = getBoardsToExport(project, parser.values("board")); // can throw
+        int failures = 0;
+        if (parser.isSet("erc")) {
+            out << "Check electrical rules..." << endl;
+            bool hasErrors = false;
+            foreach (const ErcMsg* msg, project.getErcMsgList().getItems()) {
+                if (msg->isIgnored()) {
+                    continue;
+                }
+                bool isError = (msg->getMsgType() == ErcMsg::ErcMsgType_t::CircuitError)
+                            || (msg->getMsgType() == ErcMsg::ErcMsgType_t::SchematicError)
+                            || (msg->getMsgType() == ErcMsg::ErcMsgType_t::BoardError);
+                err << QString("  %1: %2").arg(isError ? "Error" : "Warning", msg->getMsg())
+                    << endl;
+                hasErrors = hasErrors || isError;
+            }
+            if (hasErrors) {
+                ++failures;
+            }
+        }
+        foreach (Board* board, boards) {
+            if (parser.isSet("drc")) {
+                out << QString("Check design rules of board \"%1\"...").arg(board->getName()) << endl;
+                BoardDesignRuleCheck& drc = board->getDesignRuleCheck();
+                drc.execute();
+                foreach (const BoardDesignRuleCheck::Violation& violation, drc.getViolations()) {
+                    err << QString("  %1 at (%2, %3)").arg(violation.message)
+                           .arg(violation.position.getX().toMm())
+                           .arg(violation.position.getY().toMm()) << endl;
+                }
+                if (!drc.getViolations().isEmpty()) {
+                    ++failures;
+                }
+            }
+            FilePath outputDir = getOutputDirectory(project, *board, outputOption,
+                                                    boards.count() > 1);
+            out << QString("Export board \"%1\" to \"%2\"...").arg(board->getName(),
+                                                                   outputDir.toNative()) << endl;
+            try {
+                BoardGerberExport grbExport(*board, outputDir);
+                grbExport.setMergeCopperRegions(parser.isSet("merge-copper"));
+                if (!grbExport.exportAllLayers(parser.isSet("force"))) { // can throw
+                    out << "  Board is unchanged, existing files are up to date." << endl;
+                }
+                if (parser.isSet("pnp")) {
+                    QString projectName = FilePath::cleanFileName(project.getName(),
+                                          FilePath::ReplaceSpaces | FilePath::KeepCase);
+                    BoardPickPlaceExport pnpExport(*board);
+                    pnpExport.exportToFile(outputDir.getPathTo(projectName % "_PNP.csv")); // can throw
+                }
+                if (parser.isSet("ipc2581")) {
+                    QString projectName = FilePath::cleanFileName(project.getName(),
+                                          FilePath::ReplaceSpaces | FilePath::KeepCase);
+                    BoardIpc2581Export ipcExport(*board);
+                    ipcExport.exportToFile(outputDir.getPathTo(projectName % "_IPC2581.xml")); // can throw
+                }
+                if (parser.isSet("bom") || parser.isSet("netlist")) {
+                    CircuitSnapshot snapshot(project.getCircuit(), board);
+                    QString projectName = FilePath::cleanFileName(project.getName(),
+                                          FilePath::ReplaceSpaces | FilePath::KeepCase);
+                    if (parser.isSet("bom")) {
+                        CircuitBomExport bomExport(snapshot);
+                        bomExport.exportToFile(outputDir.getPathTo(projectName % "_BOM.csv")); // can throw
+                    }
+                    if (parser.isSet("netlist")) {
+                        CircuitNetlistExport netlistExport(snapshot);
+                        netlistExport.exportToFile(outputDir.getPathTo(projectName % "_NETLIST.csv")); // can throw
+                    }
+                }
+            } catch (const Exception& e) {
+                err << QString("Failed to export board \"%1\": %2").arg(board->getName(),
+                                                                        e.getMsg()) << endl;
+                ++failures;
+            }
+        }
+        return (failures > 0) ? 1 : 0;
+    }
+    catch (const Exception& e)
+    {
+        err << QString("Failed to open project \"%1\": %2").arg(projectFp.toNative(),
+                                                                e.getMsg()) << endl;
+        return 1;
+    }
+}
+
+/*****************************************************************************************
+ *  runDaemon()
+ ****************************************************************************************/
+
+/**
+ * @brief Process the jobs sent by clients until the process is terminated
+ *
+ * Each client sends one request as a single line of JSON, containing its working
+ * directory ("cwd") and its command line arguments ("args"). The reply consists of
+ * JSON lines with the output ("out"), the error output ("err") and finally the exit
+ * code ("exit"). The jobs are processed sequentially in the main thread, pending
+ * connections just wait.
+ */
+static int runDaemon(const QString& name) noexcept
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (probe.waitForConnected(1000)) {
+        err << QString("Another daemon is already listening on \"%1\".").arg(name) << endl;
+        return 1;
+    }
+    QLocalServer server;
+    QLocalServer::removeServer(name); // remove the socket file of a crashed daemon
+    if (!server.listen(name)) {
+        err << QString("Failed to listen on \"%1\": %2").arg(name, server.errorString())
+            << endl;
+        return 1;
+    }
+    out << QString("Waiting for jobs on \"%1\"...").arg(server.fullServerName()) << endl;
+    QObject::connect(&server, &QLocalServer::newConnection, [&server](){
+        while (QLocalSocket* socket = server.nextPendingConnection()) {
+            QObject::connect(socket, &QLocalSocket::disconnected,
+                             socket, &QLocalSocket::deleteLater);
+            QObject::connect(socket, &QLocalSocket::readyRead,
+                             [socket](){processDaemonRequest(*socket);});
+        }
+    });
+    return QCoreApplication::exec();
+}
+
+static void processDaemonRequest(QLocalSocket& socket) noexcept
+{
+    if (!socket.canReadLine()) {
+        return; // wait for the rest of the request
+    }
+    QJsonObject request = QJsonDocument::fromJson(socket.readLine()).object();
+    QString outText, errText;
+    QTextStream out(&outText);
+    QTextStream err(&errText);
+    QStringList arguments;
+    foreach (const QJsonValue& value, request.value("args").toArray()) {
+        arguments.append(value.toString());
+    }
+    QElapsedTimer timer;
+    timer.start();
+    int exitCode = runJob(arguments, QDir(request.value("cwd").toString()), out, err);
+    QTextStream(stdout) << QString("Job %1 finished with exit code %2 (%3 ms)")
+        .arg(arguments.mid(1).join(" ")).arg(exitCode).arg(timer.elapsed()) << endl;
+    out.flush();
+    err.flush();
+    QJsonObject outReply, errReply, exitReply;
+    outReply.insert("out", outText);
+    errReply.insert("err", errText);
+    exitReply.insert("exit", exitCode);
+    foreach (const QJsonObject& reply, QList<QJsonObject>() << outReply << errReply << exitReply) {
+        socket.write(QJsonDocument(reply).toJson(QJsonDocument::Compact) + '\n');
+    }
+    socket.disconnectFromServer(); // flushes the reply
+}
+
+/*****************************************************************************************
+ *  runClient()
+ ****************************************************************************************/
+
+static int runClient(const QString& name, const QStringList& arguments) noexcept
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    QLocalSocket socket;
+    socket.connectToServer(name);
+    if (!socket.waitForConnected(5000)) {
+        err << QString("Failed to connect to the daemon \"%1\": %2").arg(name,
+               socket.errorString()) << endl;
+        return 1;
+    }
+    QJsonObject request;
+    request.insert("cwd", QDir::currentPath());
+    request.insert("args", QJsonArray::fromStringList(arguments));
+    socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+
+    // jobs may take a long time, so wait without timeout until the exit code arrives
+    while (socket.canReadLine() || socket.waitForReadyRead(-1)) {
+        while (socket.canReadLine()) {
+            QJsonObject reply = QJsonDocument::fromJson(socket.readLine()).object();
+            if (reply.contains("out")) {
+                out << reply.value("out").toString() << flush;
+            } else if (reply.contains("err")) {
+                err << reply.value("err").toString() << flush;
+            } else if (reply.contains("exit")) {
+                return reply.value("exit").toInt(1);
+            }
+        }
+    }
+    err << QString("Lost the connection to the daemon \"%1\".").arg(name) << endl;
+    return 1;
+}
+
+/*****************************************************************************************
+ *  getBoardsToExport()
+ ****************************************************************************************/
+
+static QList<Board*> getBoardsToExport(const Project& project, const QStringList& names)
+{
+    if (names.isEmpty()) {
+        return project.getBoards();
+    }
+
+    QList<Board*> boards;
+    foreach (const QString& name, names) {
+        Board* board = project.getBoardByName(name);
+        if (!board) {
+            throw RuntimeError(__FILE__, __LINE__,
+                QString("The project does not contain a board named \"%1\".").arg(name));
+        }
+        if (!boards.contains(board)) {
+            boards.append(board);
+        }
+    }
+    return boards;
+}
+
+/*****************************************************************************************
+ *  getOutputDirectory()
+ ****************************************************************************************/
+
+static FilePath getOutputDirectory(const Project& project, const Board& board,
+                                   const QString& outputDir, bool multipleBoards) noexcept
+{
+    FilePath dir;
+    if (outputDir.isEmpty()) {
+        // same default directory as in the fabrication output dialog
+        QString version = FilePath::cleanFileName(project.getVersion(),
+                          FilePath::ReplaceSpaces | FilePath::KeepCase);
+        dir = project.getPath().getPathTo(QString("output/%1/gerber").arg(version));
+    } else {
+        dir = FilePath(QFileInfo(outputDir).absoluteFilePath());
+    }
+    if (multipleBoards) {
+        // avoid overwriting the files of other boards (file names only contain the
+        // project name)
+        dir = dir.getPathTo(FilePath::cleanFileName(board.getName(),
+                            FilePath::ReplaceSpaces | FilePath::KeepCase));
+    }
+    return dir;
+}
@@ -17,10 +17,12 @@ include(../../common.pri)
 isEmpty(UUID_LIST_FILEPATH):UUID_LIST_FILEPATH = $$absolute_path("UUID_List.ini")
 DEFINES += UUID_LIST_FILEPATH=\\\"$${UUID_LIST_FILEPATH}\\\"
 
-QT += core widgets xml network
+QT += core widgets xml sql network
 
 LIBS += \
     -L$${DESTDIR} \
+    -llibrepcbworkspace \
+    -llibrepcbproject \
     -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
     -llibrepcbcommon       # Another order could end up in "undefined reference" errors!
 
@@ -28,19 +30,25 @@ INCLUDEPATH += \
     ../../libs
 
 DEPENDPATH += \
+    ../../libs/librepcb/workspace \
+    ../../libs/librepcb/project \
     ../../libs/librepcb/library \
     ../../libs/librepcb/common
 
 PRE_TARGETDEPS += \
+    $${DESTDIR}/liblibrepcbworkspace.a \
+    $${DESTDIR}/liblibrepcbproject.a \
     $${DESTDIR}/liblibrepcblibrary.a \
     $${DESTDIR}/liblibrepcbcommon.a
 
 SOURCES += \
+    eaglelibraryconverter.cpp \
     main.cpp \
     mainwindow.cpp \
     polygonsimplifier.cpp \
 
 HEADERS += \
+    eaglelibraryconverter.h \
     mainwindow.h \
     polygonsimplifier.h \
 
@@ -0,0 +1,781 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <librepcb/common/fileio/smartxmlfile.h>
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/cmp/component.h>
+#include "eaglelibraryconverter.h"
+#include "polygonsimplifier.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+using namespace library;
+
+/*****************************************************************************************
+ *  Class EagleLibraryConverter::ElementConverter
+ ****************************************************************************************/
+
+/**
+ * @brief Converts a single library element in a thread pool worker
+ */
+class EagleLibraryConverter::ElementConverter final : public QRunnable
+{
+    public:
+        ElementConverter(EagleLibraryConverter& converter, const FilePath& filepath,
+                         DomElement* node, FileResult& result) noexcept :
+            mConverter(converter), mFilePath(filepath), mNode(node), mResult(result)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            QElapsedTimer timer;
+            timer.start();
+            bool success = false;
+            try {
+                success = mConverter.convertElement(mFilePath, mNode); // can throw
+            } catch (const Exception& e) {
+                mConverter.addError(e.getMsg(), mFilePath);
+            }
+
+            QMutexLocker locker(&mConverter.mResultsMutex);
+            mResult.readElements++;
+            if (success) mResult.convertedElements++;
+            mResult.elapsedMs += timer.elapsed();
+        }
+
+    private:
+        EagleLibraryConverter& mConverter;
+        FilePath mFilePath;
+        DomElement* mNode;
+        FileResult& mResult;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+EagleLibraryConverter::EagleLibraryConverter(const FilePath& uuidListFilePath,
+                                             const FilePath& outputDirectory) noexcept :
+    mOutputDirectory(outputDirectory),
+    mUuidList(uuidListFilePath.toStr(), QSettings::IniFormat)
+{
+}
+
+EagleLibraryConverter::~EagleLibraryConverter() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+EagleLibraryConverter::FileResult EagleLibraryConverter::convertFile(ConvertFileType_t type,
+                                                                     const FilePath& filepath) noexcept
+{
+    return convertFiles({filepath}, {type}).first();
+}
+
+QVector<EagleLibraryConverter::FileResult> EagleLibraryConverter::convertFiles(
+        const QList<FilePath>& filepaths, const QList<ConvertFileType_t>& types) noexcept
+{
+    // Read all files first, the DOM trees must be kept until all elements are converted
+    QVector<FileResult> results;
+    std::vector<std::unique_ptr<DomDocument>> documents;
+    QList<QPair<int, DomElement*>> elements; // index of the file, element node
+    foreach (const FilePath& filepath, filepaths) {
+        results.append(FileResult{filepath, 0, 0, 0});
+        try
+        {
+            SmartXmlFile file(filepath, false, true);
+            std::unique_ptr<DomDocument> doc = file.parseFileAndBuildDomTree(); // can throw
+            DomElement* library = doc->getRoot().getFirstChild("drawing/library", true, true);
+            QList<DomElement*> childs;
+            foreach (ConvertFileType_t type, types) {
+                DomElement* node = nullptr;
+                switch (type)
+                {
+                    case ConvertFileType_t::Symbols_to_Symbols:
+                        node = library->getFirstChild("symbols", true);
+                        break;
+                    case ConvertFileType_t::Packages_to_PackagesAndDevices:
+                        node = library->getFirstChild("packages", true);
+                        break;
+                    case ConvertFileType_t::Devices_to_Components:
+                        node = library->getFirstChild("devicesets", true);
+                        break;
+                    default:
+                        throw Exception(__FILE__, __LINE__);
+                }
+                childs.append(node->getChilds());
+            }
+            foreach (DomElement* child, childs) {
+                elements.append(qMakePair(results.count() - 1, child));
+            }
+            documents.push_back(std::move(doc));
+        }
+        catch (Exception& e)
+        {
+            addError(e.getMsg(), filepath);
+        }
+    }
+
+    // Convert Elements (concurrently, they are independent of each other)
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+    for (int i = 0; i < elements.count(); ++i) {
+        const QPair<int, DomElement*>& element = elements.at(i);
+        pool.start(new ElementConverter(*this, results.at(element.first).filepath,
+                                        element.second, results[element.first]));
+    }
+    pool.waitForDone();
+
+    QMutexLocker locker(&mUuidListMutex);
+    mUuidList.sync();
+    return results;
+}
+
+QStringList EagleLibraryConverter::takeErrors() noexcept
+{
+    QMutexLocker locker(&mErrorsMutex);
+    QStringList errors = mErrors;
+    mErrors.clear();
+    return errors;
+}
+
+void EagleLibraryConverter::addError(const QString& msg, const FilePath& inputFile, int inputLine) noexcept
+{
+    QMutexLocker locker(&mErrorsMutex);
+    mErrors.append(QString("%1 (%2:%3)").arg(msg).arg(inputFile.toNative()).arg(inputLine));
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+Uuid EagleLibraryConverter::getOrCreateUuid(const FilePath& filepath, const QString& cat,
+                                             const QString& key1, const QString& key2)
+{
+    QString allowedChars("_-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz");
+
+    QString settingsKey = filepath.getFilename() % '_' % key1 % '_' % key2;
+    settingsKey.replace("{", "");
+    settingsKey.replace("}", "");
+    settingsKey.replace(" ", "_");
+    for (int i=0; i<settingsKey.length(); i++)
+    {
+        if (!allowedChars.contains(settingsKey[i]))
+            settingsKey.replace(i, 1, QString("__U%1__").arg(QString::number(settingsKey[i].unicode(), 16).toUpper()));
+    }
+    settingsKey.prepend(cat % '/');
+
+    QMutexLocker locker(&mUuidListMutex);
+    Uuid uuid = Uuid::createRandom();
+    QString value = mUuidList.value(settingsKey).toString();
+    if (!value.isEmpty()) uuid = Uuid(value); //Uuid(QString("{%1}").arg(value));
+
+    if (uuid.isNull())
+    {
+        addError("Invalid UUID in *.ini file: " % settingsKey, filepath);
+        return Uuid::createRandom();
+    }
+    mUuidList.setValue(settingsKey, uuid.toStr());
+    return uuid;
+}
+
+QString EagleLibraryConverter::createDescription(const FilePath& filepath, const QString& name)
+{
+    return QString("\n\nThis element was automatically imported from Eagle\n"
+                   "Filepath: %1\nName: %2\n"
+                   "NOTE: Remove this text after manual rework!")
+            .arg(filepath.getFilename(), name);
+}
+
+QString EagleLibraryConverter::convertSchematicLayer(int eagleLayerId)
+{
+    switch (eagleLayerId)
+    {
+        case 93: return GraphicsLayer::sSymbolPinNames;
+        case 94: return GraphicsLayer::sSymbolOutlines;
+        case 95: return GraphicsLayer::sSymbolNames;
+        case 96: return GraphicsLayer::sSymbolValues;
+        case 99: return GraphicsLayer::sSchematicReferences; // ???
+        default: throw Exception(__FILE__, __LINE__, QString("Invalid schematic layer: %1").arg(eagleLayerId));
+    }
+}
+
+QString EagleLibraryConverter::convertBoardLayer(int eagleLayerId)
+{
+    switch (eagleLayerId)
+    {
+        case 1:  return GraphicsLayer::sTopCopper;
+        case 16: return GraphicsLayer::sBotCopper;
+        case 20: return GraphicsLayer::sBoardOutlines;
+        case 21: return GraphicsLayer::sTopPlacement;
+        case 22: return GraphicsLayer::sBotPlacement;
+        case 25: return GraphicsLayer::sTopNames;
+        case 27: return GraphicsLayer::sTopValues;
+        case 29: return GraphicsLayer::sTopStopMask;
+        case 31: return GraphicsLayer::sTopSolderPaste;
+        case 35: return GraphicsLayer::sTopGlue;
+        case 39: return GraphicsLayer::sTopCourtyard;
+        //case 41: return Layer::sTopCopperRestrict;
+        //case 42: return Layer::sBotCopperRestrict;
+        //case 43: return Layer::sViaRestrict;
+        case 46: return GraphicsLayer::sBoardMillingPth;
+        case 48: return GraphicsLayer::sBoardDocumentation;
+        case 49: return GraphicsLayer::sBoardDocumentation; // reference
+        case 51: return GraphicsLayer::sTopDocumentation;
+        case 52: return GraphicsLayer::sBotDocumentation;
+        default: throw Exception(__FILE__, __LINE__, QString("Invalid board layer: %1").arg(eagleLayerId));
+    }
+}
+
+bool EagleLibraryConverter::convertElement(const FilePath& filepath, DomElement* node)
+{
+    if (node->getName() == "symbol")
+        return convertSymbol(filepath, node);
+    else if (node->getName() == "package")
+        return convertPackage(filepath, node);
+    else if (node->getName() == "deviceset")
+        return convertDevice(filepath, node);
+    else
+        throw Exception(__FILE__, __LINE__, node->getName());
+}
+
+bool EagleLibraryConverter::convertSymbol(const FilePath& filepath, DomElement* node)
+{
+    try
+    {
+        QString name = node->getAttribute<QString>("name", true);
+        QString desc = createDescription(filepath, name);
+        Uuid uuid = getOrCreateUuid(filepath, "symbols", name);
+        bool rotate180 = false;
+        if (filepath.getFilename() == "con-lsta.lbr" && name.startsWith("FE")) rotate180 = true;
+        if (filepath.getFilename() == "con-lstb.lbr" && name.startsWith("MA")) rotate180 = true;
+
+        // create symbol
+        Symbol* symbol = new Symbol(uuid, Version("0.1"), "LibrePCB", name, desc, "");
+
+        foreach (DomElement* child, node->getChilds()) {
+            if (child->getName() == "wire")
+            {
+                QString layerName = convertSchematicLayer(child->getAttribute<uint>("layer", true));
+                bool fill = false;
+                bool isGrabArea = true;
+                Length lineWidth = child->getAttribute<Length>("width", true);
+                Point startpos = Point(child->getAttribute<Length>("x1", true), child->getAttribute<Length>("y1", true));
+                Point endpos = Point(child->getAttribute<Length>("x2", true), child->getAttribute<Length>("y2", true));
+                Angle angle = child->hasAttribute("curve") ? child->getAttribute<Angle>("curve", true) : Angle(0);
+                if (rotate180) {
+                    startpos = Point(-startpos.getX(), -startpos.getY());
+                    endpos = Point(-endpos.getX(), -endpos.getY());
+                }
+                symbol->getPolygons().append(std::shared_ptr<Polygon>(Polygon::createCurve(
+                    layerName, lineWidth, fill, isGrabArea, startpos, endpos, angle)));
+            }
+            else if (child->getName() == "rectangle")
+            {
+                QString layerName = convertSchematicLayer(child->getAttribute<uint>("layer", true));
+                bool fill = true;
+                bool isGrabArea = true;
+                Length lineWidth(0);
+                if (child->hasAttribute("width")) lineWidth = child->getAttribute<Length>("width", true);
+                Point p1(child->getAttribute<Length>("x1", true), child->getAttribute<Length>("y1", true));
+                Point p2(child->getAttribute<Length>("x2", true), child->getAttribute<Length>("y1", true));
+                Point p3(child->getAttribute<Length>("x2", true), child->getAttribute<Length>("y2", true));
+                Point p4(child->getAttribute<Length>("x1", true), child->getAttribute<Length>("y2", true));
+                std::shared_ptr<Polygon> polygon(new Polygon(layerName, lineWidth, fill, isGrabArea, p1));
+                polygon->getSegments().append(std::make_shared<PolygonSegment>(p2, Angle::deg0()));
+                polygon->getSegments().append(std::make_shared<PolygonSegment>(p3, Angle::deg0()));
+                polygon->getSegments().append(std::make_shared<PolygonSegment>(p4, Angle::deg0()));
+                polygon->getSegments().append(std::make_shared<PolygonSegment>(p1, Angle::deg0()));
+                symbol->getPolygons().append(polygon);
+            }
+            else if (child->getName() == "polygon")
+            {
+                QString layerName = convertSchematicLayer(child->getAttribute<uint>("layer", true));
+                bool fill = false;
+                bool isGrabArea = true;
+                Length lineWidth(0);
+                if (child->hasAttribute("width")) lineWidth = child->getAttribute<Length>("width", true);
+                std::shared_ptr<Polygon> polygon(new Polygon(layerName, lineWidth, fill, isGrabArea, Point(0, 0)));
+                foreach (DomElement* vertex, child->getChilds()) {
+                    Point p(vertex->getAttribute<Length>("x", true), vertex->getAttribute<Length>("y", true));
+                    if (vertex == child->getFirstChild())
+                        polygon->setStartPos(p);
+                    else
+                        polygon->getSegments().append(std::make_shared<PolygonSegment>(p, Angle::deg0()));
+                }
+                polygon->close();
+                symbol->getPolygons().append(polygon);
+            }
+            else if (child->getName() == "circle")
+            {
+                QString layerName = convertSchematicLayer(child->getAttribute<uint>("layer", true));
+                Length radius(child->getAttribute<Length>("radius", true));
+                Point center(child->getAttribute<Length>("x", true), child->getAttribute<Length>("y", true));
+                Length lineWidth = child->getAttribute<Length>("width", true);
+                bool fill = (lineWidth == 0);
+                bool isGrabArea = true;
+                symbol->getEllipses().append(std::make_shared<Ellipse>(layerName,
+                    lineWidth, fill, isGrabArea, center, radius, radius, Angle::deg0()));
+            }
+            else if (child->getName() == "text")
+            {
+                QString layerName = convertSchematicLayer(child->getAttribute<uint>("layer", true));
+                QString textStr = child->getText<QString>(true);
+                Length height = child->getAttribute<Length>("size", true)*2;
+                if (textStr == ">NAME") {
+                    textStr = "${SYM::NAME}";
+                    height = Length::fromMm(3.175);
+                } else if (textStr == ">VALUE") {
+                    textStr = "${CMP::VALUE}";
+                    height = Length::fromMm(2.5);
+                }
+                Point pos = Point(child->getAttribute<Length>("x", true), child->getAttribute<Length>("y", true));
+                int angleDeg = 0;
+                if (child->hasAttribute("rot")) angleDeg = child->getAttribute<QString>("rot", true).remove("R").toInt();
+                if (rotate180) {
+                    pos = Point(-pos.getX(), -pos.getY());
+                    angleDeg += 180;
+                }
+                Angle rot = Angle::fromDeg(angleDeg);
+                Alignment align(HAlign::left(), VAlign::bottom());
+                symbol->getTexts().append(std::make_shared<Text>(
+                    layerName, textStr, pos, rot, height, align));
+            }
+            else if (child->getName() == "pin")
+            {
+                Uuid pinUuid = getOrCreateUuid(filepath, "symbol_pins", uuid.toStr(), child->getAttribute<QString>("name", true));
+                QString name = child->getAttribute<QString>("name", true);
+                Point pos = Point(child->getAttribute<Length>("x", true), child->getAttribute<Length>("y", true));
+                Length len(7620000);
+                if (child->hasAttribute("length")) {
+                    if (child->getAttribute<QString>("length", true) == "point")
+                        len.setLengthNm(0);
+                    else if (child->getAttribute<QString>("length", true) == "short")
+                        len.setLengthNm(2540000);
+                    else if (child->getAttribute<QString>("length", true) == "middle")
+                        len.setLengthNm(5080000);
+                    else if (child->getAttribute<QString>("length", true) == "long")
+                        len.setLengthNm(7620000);
+                    else
+                        throw Exception(__FILE__, __LINE__, "Invalid symbol pin length: " % child->getAttribute<QString>("length", false));
+                }
+                int angleDeg = 0;
+                if (child->hasAttribute("rot")) angleDeg = child->getAttribute<QString>("rot", true).remove("R").toInt();
+                if (rotate180) {
+                    pos = Point(-pos.getX(), -pos.getY());
+                    angleDeg += 180;
+                }
+                Angle rot = Angle::fromDeg(angleDeg);
+                symbol->getPins().append(std::make_shared<SymbolPin>(pinUuid, name,
+                                                                     pos, len, rot));
+            }
+            else
+            {
+                addError(QString("Unknown node name: %1/%2").arg(node->getName()).arg(child->getName()), filepath);
+                return false;
+            }
+        }
+
+        // convert line rects to polygon rects
+        PolygonSimplifier<Symbol> polygonSimplifier(*symbol);
+        polygonSimplifier.convertLineRectsToPolygonRects(false, true);
+        polygonSimplifier.joinLinesToPolygons();
+
+        // save symbol to file
+        symbol->saveIntoParentDirectory(mOutputDirectory.getPathTo("sym"));
+        delete symbol;
+    }
+    catch (Exception& e)
+    {
+        addError(e.getMsg(), filepath);
+        return false;
+    }
+
+    return true;
+}
+
+bool EagleLibraryConverter::convertPackage(const FilePath& filepath, DomElement* node)
+{
+    try
+    {
+        QString name = node->getAttribute<QString>("name", true);
+        QString desc = node->getFirstChild("description", false) ? node->getFirstChild("description", true)->getText<QString>(false) : "";
+        desc.append(createDescription(filepath, name));
+        bool rotate180 = false;
+        //if (filepath.getFilename() == "con-lsta.lbr" && name.startsWith("FE")) rotate180 = true;
+        //if (filepath.getFilename() == "con-lstb.lbr" && name.startsWith("MA")) rotate180 = true;
+
+        // create footprint
+        Uuid fptUuid = getOrCreateUuid(filepath, "packages_to_footprints", name);
+        Footprint footprint(fptUuid, "default", "");
+
+        // create package
+        Uuid pkgUuid = getOrCreateUuid(filepath, "packages_to_packages", name);
+        Package* package = new Package(pkgUuid, Version("0.1"), "LibrePCB", name, desc, "");
+
+        foreach (DomElement* child, node->getChilds()) {
+            if (child->getName() == "description")
+            {
+                // nothing to do
+            }
+            else if (child->getName() == "wire")
+            {
+                QString layerName = convertBoardLayer(child->getAttribute<uint>("layer", true));
+                bool fill = false;
+                bool isGrabArea = true;
+                Length lineWidth = child->getAttribute<Length>("width", true);
+                Point startpos = Point(child->getAttribute<Length>("x1", true), child->getAttribute<Length>("y1", true));
+                Point endpos = Point(child->getAttribute<Length>("x2", true), child->getAttribute<Length>("y2", true));
+                Angle angle = child->hasAttribute("curve") ? child->getAttribute<Angle>("curve", true) : Angle(0);
+                if (rotate180) {
+                    startpos = Point(-startpos.getX(), -startpos.getY());
+                    endpos = Point(-endpos.getX(), -endpos.getY());
+                }
+                footprint.getPolygons().append(std::shared_ptr<Polygon>(Polygon::createCurve(
+                    layerName, lineWidth, fill, isGrabArea, startpos, endpos, angle)));
+            }
+            else if (child->getName() == "rectangle")
+            {
+                QString layerName = convertBoardLayer(child->getAttribute<uint>("layer", true));
+                bool fill = true;
+                bool isGrabArea = true;
+                Length lineWidth(0);
+                if (child->hasAttribute("width")) lineWidth = child->getAttribute<Length>("width", true);
+                Point p1(child->getAttribute<Length>("x1", true), child->getAttribute<Length>("y1", true));
+                Point p2(child->getAttribute<Length>("x2", true), child->getAttribute<Length>("y1", true));
+                Point p3(child->getAttribute<Length>("x2", true), child->getAttribute<Length>("y2", true));
+                Point p4(child->getAttribute<Length>("x1", true), child->getAttribute<Length>("y2", true));
+                std::shared_ptr<Polygon> polygon(new Polygon(layerName, lineWidth, fill, isGrabArea, p1));
+                polygon->getSegments().append(std::make_shared<PolygonSegment>(p2, Angle::deg0()));
+                polygon->getSegments().append(std::make_shared<PolygonSegment>(p3, Angle::deg0()));
+                polygon->getSegments().append(std::make_shared<PolygonSegment>(p4, Angle::deg0()));
+                polygon->getSegments().append(std::make_shared<PolygonSegment>(p1, Angle::deg0()));
+                footprint.getPolygons().append(polygon);
+            }
+            else if (child->getName() == "polygon")
+            {
+                QString layerName = convertBoardLayer(child->getAttribute<uint>("layer", true));
+                bool fill = false;
+                bool isGrabArea = true;
+                Length lineWidth(0);
+                if (child->hasAttribute("width")) lineWidth = child->getAttribute<Length>("width", true);
+                std::shared_ptr<Polygon> polygon(new Polygon(layerName, lineWidth, fill, isGrabArea, Point(0, 0)));
+                foreach (DomElement* vertex, child->getChilds()) {
+                    Point p(vertex->getAttribute<Length>("x", true), vertex->getAttribute<Length>("y", true));
+                    if (vertex == child->getFirstChild())
+                        polygon->setStartPos(p);
+                    else
+                        polygon->getSegments().append(std::make_shared<PolygonSegment>(p, Angle::deg0()));
+                }
+                polygon->close();
+                footprint.getPolygons().append(polygon);
+            }
+            else if (child->getName() == "circle")
+            {
+                QString layerName = convertBoardLayer(child->getAttribute<uint>("layer", true));
+                Length radius(child->getAttribute<Length>("radius", true));
+                Point center(child->getAttribute<Length>("x", true), child->getAttribute<Length>("y", true));
+                Length lineWidth = child->getAttribute<Length>("width", true);
+                bool fill = (lineWidth == 0);
+                bool isGrabArea = true;
+                std::shared_ptr<Ellipse> ellipse(new Ellipse(layerName, lineWidth, fill, isGrabArea,
+                                                 center, radius, radius, Angle::deg0()));
+                footprint.getEllipses().append(ellipse);
+            }
+            else if (child->getName() == "text")
+            {
+                QString layerName = convertBoardLayer(child->getAttribute<uint>("layer", true));
+                QString textStr = child->getText<QString>(true);
+                Length height = child->getAttribute<Length>("size", true)*2;
+                if (textStr == ">NAME") {
+                    textStr = "${CMP::NAME}";
+                    height = Length::fromMm(2.5);
+                } else if (textStr == ">VALUE") {
+                    textStr = "${CMP::VALUE}";
+                    height = Length::fromMm(2.0);
+                }
+                Point pos = Point(child->getAttribute<Length>("x", true), child->getAttribute<Length>("y", true));
+                int angleDeg = 0;
+                if (child->hasAttribute("rot")) angleDeg = child->getAttribute<QString>("rot", true).remove("R").toInt();
+                if (rotate180) {
+                    pos = Point(-pos.getX(), -pos.getY());
+                    angleDeg += 180;
+                }
+                Angle rot = Angle::fromDeg(angleDeg);
+                Alignment align(HAlign::left(), VAlign::bottom());
+                std::shared_ptr<Text> text(new Text(layerName, textStr, pos, rot, height, align));
+                footprint.getTexts().append(text);
+            }
+            else if (child->getName() == "pad")
+            {
+                Uuid padUuid = getOrCreateUuid(filepath, "package_pads", fptUuid.toStr(), child->getAttribute<QString>("name", true));
+                QString name = child->getAttribute<QString>("name", true);
+                // add package pad
+                package->getPads().append(std::make_shared<PackagePad>(padUuid, name));
+                // add footprint pad
+                Point pos = Point(child->getAttribute<Length>("x", true), child->getAttribute<Length>("y", true));
+                Length drillDiameter = child->getAttribute<Length>("drill", true);
+                Length padDiameter = drillDiameter * 2;
+                if (child->hasAttribute("diameter")) padDiameter = child->getAttribute<Length>("diameter", true);
+                Length width = padDiameter;
+                Length height = padDiameter;
+                FootprintPad::Shape shape;
+                QString shapeStr = child->hasAttribute("shape") ? child->getAttribute<QString>("shape", true) : "round";
+                if (shapeStr == "square") {
+                    shape = FootprintPad::Shape::RECT;
+                } else if (shapeStr == "octagon") {
+                    shape = FootprintPad::Shape::OCTAGON;
+                } else if (shapeStr == "round") {
+                    shape = FootprintPad::Shape::ROUND;
+                } else if (shapeStr == "long") {
+                    shape = FootprintPad::Shape::ROUND;
+                    width = padDiameter * 2;
+                } else {
+                    throw Exception(__FILE__, __LINE__, "Invalid shape: " % shapeStr % " :: " % filepath.toStr());
+                }
+                int angleDeg = 0;
+                if (child->hasAttribute("rot")) angleDeg = child->getAttribute<QString>("rot", true).remove("R").toInt();
+                if (rotate180) {
+                    pos = Point(-pos.getX(), -pos.getY());
+                    angleDeg += 180;
+                }
+                Angle rot = Angle::fromDeg(angleDeg);
+                std::shared_ptr<FootprintPad> fptPad(new FootprintPad(
+                    padUuid, pos, rot, shape, width, height, drillDiameter,
+                    FootprintPad::BoardSide::THT));
+                footprint.getPads().append(fptPad);
+            }
+            else if (child->getName() == "smd")
+            {
+                Uuid padUuid = getOrCreateUuid(filepath, "package_pads", fptUuid.toStr(), child->getAttribute<QString>("name", true));
+                QString name = child->getAttribute<QString>("name", true);
+                // add package pad
+                package->getPads().append(std::make_shared<PackagePad>(padUuid, name));
+                // add footprint pad
+                QString layerName = convertBoardLayer(child->getAttribute<uint>("layer", true));
+                FootprintPad::BoardSide side;
+                if (layerName == GraphicsLayer::sTopCopper) {
+                    side = FootprintPad::BoardSide::TOP;
+                } else if (layerName == GraphicsLayer::sBotCopper) {
+                    side = FootprintPad::BoardSide::BOTTOM;
+                } else {
+                    throw Exception(__FILE__, __LINE__, QString("Invalid pad layer: %1").arg(layerName));
+                }
+                Point pos = Point(child->getAttribute<Length>("x", true), child->getAttribute<Length>("y", true));
+                int angleDeg = 0;
+                if (child->hasAttribute("rot")) angleDeg = child->getAttribute<QString>("rot", true).remove("R").toInt();
+                if (rotate180) {
+                    pos = Point(-pos.getX(), -pos.getY());
+                    angleDeg += 180;
+                }
+                Angle rot = Angle::fromDeg(angleDeg);
+                Length width = child->getAttribute<Length>("dx", true);
+                Length height = child->getAttribute<Length>("dy", true);
+                std::shared_ptr<FootprintPad> fptPad(new FootprintPad(
+                    padUuid, pos, rot, FootprintPad::Shape::RECT, width, height,
+                    Length(0), side));
+                footprint.getPads().append(fptPad);
+            }
+            else if (child->getName() == "hole")
+            {
+                Point pos(child->getAttribute<Length>("x", true), child->getAttribute<Length>("y", true));
+                Length diameter(child->getAttribute<Length>("drill", true));
+                footprint.getHoles().append(std::make_shared<Hole>(pos, diameter));
+            }
+            else
+            {
+                addError(QString("Unknown node name: %1/%2").arg(node->getName()).arg(child->getName()), filepath);
+                return false;
+            }
+        }
+
+        // convert line rects to polygon rects
+        PolygonSimplifier<Footprint> polygonSimplifier(footprint);
+        polygonSimplifier.convertLineRectsToPolygonRects(false, true);
+        polygonSimplifier.joinLinesToPolygons();
+
+        // add footprint to package
+        package->getFootprints().append(std::make_shared<Footprint>(footprint));
+
+        // save package to file
+        package->saveIntoParentDirectory(mOutputDirectory.getPathTo("pkg"));
+
+        // clean up
+        delete package;
+    }
+    catch (Exception& e)
+    {
+        addError(e.getMsg(), filepath);
+        return false;
+    }
+
+    return true;
+}
+
+bool EagleLibraryConverter::convertDevice(const FilePath& filepath, DomElement* node)
+{
+    try
+    {
+        QString name = node->getAttribute<QString>("name", true);
+
+        // abort if device name ends with "-US"
+        if (name.endsWith("-US")) return false;
+
+        Uuid uuid = getOrCreateUuid(filepath, "devices_to_components", name);
+        QString desc = node->getFirstChild("description", false) ? node->getFirstChild("description", true)->getText<QString>(false) : "";
+        desc.append(createDescription(filepath, name));
+
+        // create  component
+        Component* component = new Component(uuid, Version("0.1"), "LibrePCB", name, desc, "");
+
+        // properties
+        component->getPrefixes().insert("", node->hasAttribute("prefix") ? node->getAttribute<QString>("prefix", false) : "");
+
+        // symbol variant
+        Uuid symbVarUuid = getOrCreateUuid(filepath, "component_symbolvariants", uuid.toStr());
+        std::shared_ptr<ComponentSymbolVariant> symbvar(new ComponentSymbolVariant(symbVarUuid, "", "default", ""));
+        component->getSymbolVariants().append(symbvar);
+
+        // signals
+        DomElement* device = node->getFirstChild("devices/device", true, true);
+        for (DomElement* connect = device->getFirstChild("connects/connect", false, false);
+             connect; connect = connect->getNextSibling())
+        {
+            QString gateName = connect->getAttribute<QString>("gate", true);
+            QString pinName = connect->getAttribute<QString>("pin", true);
+            if (pinName.contains("@")) pinName.truncate(pinName.indexOf("@"));
+            if (pinName.contains("#")) pinName.truncate(pinName.indexOf("#"));
+            Uuid signalUuid = getOrCreateUuid(filepath, "gatepins_to_componentsignals", uuid.toStr(), gateName % pinName);
+
+            if (!component->getSignals().contains(signalUuid))
+            {
+                // create signal
+                component->getSignals().append(std::make_shared<ComponentSignal>(signalUuid, pinName));
+            }
+        }
+
+        // symbol variant items
+        foreach (DomElement* gate, node->getFirstChild("gates", true)->getChilds()) {
+            QString gateName = gate->getAttribute<QString>("name", true);
+            QString symbolName = gate->getAttribute<QString>("symbol", true);
+            Uuid symbolUuid = getOrCreateUuid(filepath, "symbols", symbolName);
+
+            // create symbol variant item
+            Uuid symbVarItemUuid = getOrCreateUuid(filepath, "symbolgates_to_symbvaritems", uuid.toStr(), gateName);
+            std::shared_ptr<ComponentSymbolVariantItem> item(new ComponentSymbolVariantItem(symbVarItemUuid, symbolUuid, true, (gateName == "G$1") ? "" : gateName));
+
+            // connect pins
+            for (DomElement* connect = device->getFirstChild("connects/connect", false, false);
+                 connect; connect = connect->getNextSibling())
+            {
+                if (connect->getAttribute<QString>("gate", true) == gateName)
+                {
+                    QString pinName = connect->getAttribute<QString>("pin", true);
+                    Uuid pinUuid = getOrCreateUuid(filepath, "symbol_pins", symbolUuid.toStr(), pinName);
+                    if (pinName.contains("@")) pinName.truncate(pinName.indexOf("@"));
+                    if (pinName.contains("#")) pinName.truncate(pinName.indexOf("#"));
+                    Uuid signalUuid = getOrCreateUuid(filepath, "gatepins_to_componentsignals", uuid.toStr(), gateName % pinName);
+                    item->getPinSignalMap().append(
+                        std::make_shared<ComponentPinSignalMapItem>(pinUuid,
+                            signalUuid, CmpSigPinDisplayType::componentSignal()));
+                }
+            }
+
+            symbvar->getSymbolItems().append(item);
+        }
+
+        // create devices
+        foreach (DomElement* deviceNode, node->getFirstChild("devices", true)->getChilds()) {
+            if (!deviceNode->hasAttribute("package")) continue;
+
+            QString deviceName = deviceNode->getAttribute<QString>("name", false);
+            QString packageName = deviceNode->getAttribute<QString>("package", true);
+            Uuid pkgUuid = getOrCreateUuid(filepath, "packages_to_packages", packageName);
+            Uuid fptUuid = getOrCreateUuid(filepath, "packages_to_footprints", packageName);
+
+            Uuid compUuid = getOrCreateUuid(filepath, "devices_to_devices", name, deviceName);
+            QString compName = deviceName.isEmpty() ? name : QString("%1_%2").arg(name, deviceName);
+            Device* device = new Device(compUuid, Version("0.1"), "LibrePCB", compName, desc, "");
+            device->setComponentUuid(component->getUuid());
+            device->setPackageUuid(pkgUuid);
+
+            // connect pads
+            for (DomElement* connect = deviceNode->getFirstChild("connects/*", false, false);
+                 connect; connect = connect->getNextSibling())
+            {
+                QString gateName = connect->getAttribute<QString>("gate", true);
+                QString pinName = connect->getAttribute<QString>("pin", true);
+                QString padNames = connect->getAttribute<QString>("pad", true);
+                if (pinName.contains("@")) pinName.truncate(pinName.indexOf("@"));
+                if (pinName.contains("#")) pinName.truncate(pinName.indexOf("#"));
+                if (connect->hasAttribute("route"))
+                {
+                    if (connect->getAttribute<QString>("route", true) != "any")
+                        addError(QString("Unknown connect route: %1/%2").arg(node->getName()).arg(connect->getAttribute<QString>("route", false)), filepath);
+                }
+                foreach (const QString& padName, padNames.split(" ", QString::SkipEmptyParts))
+                {
+                    Uuid padUuid = getOrCreateUuid(filepath, "package_pads", fptUuid.toStr(), padName);
+                    Uuid signalUuid = getOrCreateUuid(filepath, "gatepins_to_componentsignals", uuid.toStr(), gateName % pinName);
+                    device->getPadSignalMap().append(
+                        std::make_shared<DevicePadSignalMapItem>(padUuid, signalUuid));
+                }
+            }
+
+            // save device
+            device->saveIntoParentDirectory(mOutputDirectory.getPathTo("dev"));
+            delete device;
+        }
+
+        // save component to file
+        component->saveIntoParentDirectory(mOutputDirectory.getPathTo("cmp"));
+        delete component;
+    }
+    catch (Exception& e)
+    {
+        addError(e.getMsg(), filepath);
+        return false;
+    }
+
+    return true;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,143 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef EAGLELIBRARYCONVERTER_H
+#define EAGLELIBRARYCONVERTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/domelement.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class EagleLibraryConverter
+ ****************************************************************************************/
+
+/**
+ * @brief Converts the elements of Eagle libraries (*.lbr) to LibrePCB library elements
+ *
+ * The elements are converted concurrently in a thread pool. The UUIDs of the created
+ * elements are stored in (and loaded from) a UUID list file, so converting the same
+ * Eagle libraries again reproduces the same UUIDs. All access to this list is locked,
+ * thus it can be shared by all elements of all converted files.
+ */
+class EagleLibraryConverter final
+{
+    public:
+
+        // Types
+        enum class ConvertFileType_t {
+            Symbols_to_Symbols,
+            Packages_to_PackagesAndDevices,
+            Devices_to_Components
+        };
+        struct FileResult {
+            FilePath filepath;
+            int readElements;
+            int convertedElements;
+            qint64 elapsedMs; ///< sum of the conversion times of all elements
+        };
+
+        // Constructors / Destructor
+        EagleLibraryConverter() = delete;
+        EagleLibraryConverter(const EagleLibraryConverter& other) = delete;
+        EagleLibraryConverter(const FilePath& uuidListFilePath,
+                              const FilePath& outputDirectory) noexcept;
+        ~EagleLibraryConverter() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Convert all elements of the given type from a single file
+         */
+        FileResult convertFile(ConvertFileType_t type, const FilePath& filepath) noexcept;
+
+        /**
+         * @brief Convert all elements of the given types from many files at once
+         *
+         * In contrast to calling #convertFile() for each file, the elements of all files
+         * are converted in a single thread pool, so small files do not limit the
+         * parallelism.
+         *
+         * @return The results of all files (in the same order as the given files)
+         */
+        QVector<FileResult> convertFiles(const QList<FilePath>& filepaths,
+                                         const QList<ConvertFileType_t>& types) noexcept;
+
+        /**
+         * @brief Get and clear the errors which occurred since the last call
+         *
+         * This method is thread-safe.
+         */
+        QStringList takeErrors() noexcept;
+
+        /**
+         * @brief Add an error message to the list returned by #takeErrors()
+         *
+         * This method is thread-safe.
+         */
+        void addError(const QString& msg, const FilePath& inputFile = FilePath(),
+                      int inputLine = 0) noexcept;
+
+        // Operator Overloadings
+        EagleLibraryConverter& operator=(const EagleLibraryConverter& rhs) = delete;
+
+
+    private:
+
+        class ElementConverter;
+
+        // Private Methods
+        Uuid getOrCreateUuid(const FilePath& filepath, const QString& cat,
+                             const QString& key1, const QString& key2 = QString());
+        QString createDescription(const FilePath& filepath, const QString& name);
+        QString convertSchematicLayer(int eagleLayerId);
+        QString convertBoardLayer(int eagleLayerId);
+        bool convertElement(const FilePath& filepath, DomElement* node);
+        bool convertSymbol(const FilePath& filepath, DomElement* node);
+        bool convertPackage(const FilePath& filepath, DomElement* node);
+        bool convertDevice(const FilePath& filepath, DomElement* node);
+
+
+        // Attributes
+        FilePath mOutputDirectory;
+        QSettings mUuidList;            ///< the UUIDs of all converted elements
+        QMutex mUuidListMutex;          ///< locks the access to #mUuidList
+        QStringList mErrors;            ///< see #takeErrors()
+        QMutex mErrorsMutex;            ///< locks the access to #mErrors
+        QMutex mResultsMutex;           ///< locks the access to the FileResult objects
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // EAGLELIBRARYCONVERTER_H
@@ -23,10 +23,28 @@
 
 #include <QtCore>
 #include <QtWidgets>
-#include <QApplication>
+#include <librepcb/common/application.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include "eaglelibraryconverter.h"
 #include "mainwindow.h"
 
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
 using namespace librepcb;
+using namespace librepcb::workspace;
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static int runBatch(const QString& inputDir, const QString& outputDir,
+                    const QString& uuidList, const QString& workspacePath,
+                    const QString& statisticsFile);
+static bool rescanWorkspaceLibraries(const QString& workspacePath);
 
 /*****************************************************************************************
  *  main()
@@ -34,13 +52,187 @@ using namespace librepcb;
 
 int main(int argc, char* argv[])
 {
-    QApplication app(argc, argv);
+    // Without an input directory on the command line, the GUI is shown. Otherwise no
+    // windows are shown at all, so run without a display unless another platform plugin
+    // is explicitly requested.
+    bool batch = false;
+    for (int i = 1; i < argc; ++i) {
+        QByteArray arg(argv[i]);
+        if ((arg == "-o") || (arg == "--output") || (arg == "-u") || (arg == "--uuid-list")
+            || (arg == "-w") || (arg == "--workspace") || (arg == "-s")
+            || (arg == "--statistics")) {
+            ++i; // skip the value of the option
+        } else if (!arg.startsWith("-")) {
+            batch = true;
+        }
+    }
+    if (batch && qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv);
 
     QCoreApplication::setOrganizationName("LibrePCB");
     QCoreApplication::setApplicationName("EagleImport");
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Import Eagle libraries (*.lbr) into a LibrePCB "
+                                     "library. Without an input directory, the graphical "
+                                     "user interface is shown.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("input", "Directory containing the *.lbr files to import "
+                                 "(batch mode).", "[input]");
+    QCommandLineOption outputOption(QStringList() << "o" << "output",
+        "Output directory (required in batch mode).", "directory");
+    QCommandLineOption uuidListOption(QStringList() << "u" << "uuid-list",
+        "UUID list file to use. Default: " UUID_LIST_FILEPATH, "file", UUID_LIST_FILEPATH);
+    QCommandLineOption workspaceOption(QStringList() << "w" << "workspace",
+        "Rescan the libraries of this workspace after the import.", "directory");
+    QCommandLineOption statisticsOption(QStringList() << "s" << "statistics",
+        "Write the import statistics of all files to this CSV file.", "file");
+    parser.addOption(outputOption);
+    parser.addOption(uuidListOption);
+    parser.addOption(workspaceOption);
+    parser.addOption(statisticsOption);
+    parser.process(app);
+
+    if (parser.positionalArguments().count() > 1) {
+        parser.showHelp(1);
+    } else if (parser.positionalArguments().count() == 1) {
+        if (!parser.isSet(outputOption)) {
+            QTextStream(stderr) << "No output directory specified." << endl;
+            return 1;
+        }
+        return runBatch(parser.positionalArguments().first(), parser.value(outputOption),
+                        parser.value(uuidListOption), parser.value(workspaceOption),
+                        parser.value(statisticsOption));
+    }
+
     MainWindow w;
     w.show();
 
     return QApplication::exec();
 }
+
+/*****************************************************************************************
+ *  runBatch()
+ ****************************************************************************************/
+
+static int runBatch(const QString& inputDir, const QString& outputDir,
+                    const QString& uuidList, const QString& workspacePath,
+                    const QString& statisticsFile)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    FilePath inputPath(QFileInfo(inputDir).absoluteFilePath());
+    FilePath outputPath(QFileInfo(outputDir).absoluteFilePath());
+    FilePath uuidListPath(QFileInfo(uuidList).absoluteFilePath());
+    if (!inputPath.isExistingDir()) {
+        err << QString("Input directory not found: \"%1\"").arg(inputPath.toNative()) << endl;
+        return 1;
+    }
+
+    QList<FilePath> files;
+    QDir dir(inputPath.toStr());
+    foreach (const QString& filename, dir.entryList(QStringList("*.lbr"), QDir::Files, QDir::Name)) {
+        files.append(inputPath.getPathTo(filename));
+    }
+
+    try {
+        FileUtils::makePath(outputPath); // can throw
+    } catch (const Exception& e) {
+        err << "Fatal Error: " << e.getMsg() << endl;
+        return 1;
+    }
+
+    // all elements of all files are converted at once, sharing the same UUID list
+    QElapsedTimer timer;
+    timer.start();
+    EagleLibraryConverter converter(uuidListPath, outputPath);
+    QVector<EagleLibraryConverter::FileResult> results = converter.convertFiles(files,
+        {EagleLibraryConverter::ConvertFileType_t::Symbols_to_Symbols,
+         EagleLibraryConverter::ConvertFileType_t::Packages_to_PackagesAndDevices,
+         EagleLibraryConverter::ConvertFileType_t::Devices_to_Components});
+    qint64 elapsedMs = timer.elapsed();
+    QStringList errors = converter.takeErrors();
+
+    // statistics
+    int readElements = 0;
+    int convertedElements = 0;
+    QString csv("file,read_elements,converted_elements,conversion_time_ms\n");
+    foreach (const EagleLibraryConverter::FileResult& result, results) {
+        readElements += result.readElements;
+        convertedElements += result.convertedElements;
+        out << QString("%1 of %2 elements converted in %3 ms: %4")
+               .arg(result.convertedElements, 5).arg(result.readElements, 5)
+               .arg(result.elapsedMs, 7).arg(result.filepath.toNative()) << endl;
+        csv += QString("\"%1\",%2,%3,%4\n").arg(result.filepath.getFilename())
+               .arg(result.readElements).arg(result.convertedElements).arg(result.elapsedMs);
+    }
+    foreach (const QString& error, errors) {
+        err << "ERROR: " << error << endl;
+    }
+    out << endl << QString("%1 files: %2 of %3 elements converted in %4 s, %5 errors")
+           .arg(results.count()).arg(convertedElements).arg(readElements)
+           .arg(elapsedMs / 1000.0, 0, 'f', 1).arg(errors.count()) << endl;
+
+    if (!statisticsFile.isEmpty()) {
+        try {
+            FileUtils::writeFile(FilePath(QFileInfo(statisticsFile).absoluteFilePath()),
+                                 csv.toUtf8()); // can throw
+        } catch (const Exception& e) {
+            err << "Failed to write statistics: " << e.getMsg() << endl;
+            return 1;
+        }
+    }
+
+    // only one rescan for all imported elements
+    if ((!workspacePath.isEmpty()) && (!rescanWorkspaceLibraries(workspacePath))) {
+        return 1;
+    }
+    return errors.isEmpty() ? 0 : 1;
+}
+
+/*****************************************************************************************
+ *  rescanWorkspaceLibraries()
+ ****************************************************************************************/
+
+static bool rescanWorkspaceLibraries(const QString& workspacePath)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    try
+    {
+        FilePath wsPath(QFileInfo(workspacePath).absoluteFilePath());
+        if (!Workspace::isValidWorkspacePath(wsPath)) {
+            err << QString("Invalid workspace: \"%1\"").arg(wsPath.toNative()) << endl;
+            return false;
+        }
+        Workspace workspace(wsPath); // can throw
+
+        // the scan runs in its own thread, so wait until it has finished
+        bool success = false;
+        QEventLoop loop;
+        QObject::connect(&workspace.getLibraryDb(), &WorkspaceLibraryDb::scanSucceeded,
+                         &loop, [&](int elementCount) {
+            out << QString("Workspace libraries rescanned: %1 elements").arg(elementCount) << endl;
+            success = true;
+            loop.quit();
+        });
+        QObject::connect(&workspace.getLibraryDb(), &WorkspaceLibraryDb::scanFailed,
+                         &loop, [&](const QString& errorMsg) {
+            err << "Workspace library rescan failed: " << errorMsg << endl;
+            loop.quit();
+        });
+        workspace.getLibraryDb().startLibraryRescan();
+        loop.exec();
+        return success;
+    }
+    catch (const Exception& e)
+    {
+        err << "Fatal Error: " << e.getMsg() << endl;
+        return false;
+    }
+}
@@ -5,7 +5,7 @@
 #include <QtWidgets>
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/fileio/filepath.h>
-#include <librepcb/common/fileio/domelement.h>
+#include "eaglelibraryconverter.h"
 
 namespace Ui {
 class MainWindow;
@@ -40,30 +40,9 @@ class MainWindow : public QMainWindow
 
     private:
 
-        enum class ConvertFileType_t {
-            Symbols_to_Symbols,
-            Packages_to_PackagesAndDevices,
-            Devices_to_Components
-        };
-
         void reset();
         void addError(const QString& msg, const librepcb::FilePath& inputFile = librepcb::FilePath(), int inputLine = 0);
-        librepcb::Uuid getOrCreateUuid(QSettings& outputSettings,
-                                       const librepcb::FilePath& filepath,
-                                       const QString& cat, const QString& key1,
-                                       const QString& key2 = QString());
-        QString createDescription(const librepcb::FilePath& filepath, const QString& name);
-        QString convertSchematicLayer(int eagleLayerId);
-        QString convertBoardLayer(int eagleLayerId);
-        void convertAllFiles(ConvertFileType_t type);
-        void convertFile(ConvertFileType_t type, QSettings& outputSettings,
-                         const librepcb::FilePath& filepath);
-        bool convertSymbol(QSettings& outputSettings, const librepcb::FilePath& filepath,
-                           librepcb::DomElement* node);
-        bool convertPackage(QSettings& outputSettings, const librepcb::FilePath& filepath,
-                            librepcb::DomElement* node);
-        bool convertDevice(QSettings& outputSettings, const librepcb::FilePath& filepath,
-                           librepcb::DomElement* node);
+        void convertAllFiles(EagleLibraryConverter::ConvertFileType_t type);
 
         // Attributes
         Ui::MainWindow *ui;
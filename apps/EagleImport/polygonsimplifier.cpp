@@ -53,36 +53,106 @@ PolygonSimplifier<LibElemType>::~PolygonSimplifier()
 template <typename LibElemType>
 void PolygonSimplifier<LibElemType>::convertLineRectsToPolygonRects(bool fillArea, bool isGrabArea) noexcept
 {
-    QList<Polygon*> lines;
-    while (findLineRectangle(lines)) {
-        QSet<LengthBase_t> xValues, yValues;
-        foreach (const Polygon* line, lines) {
-            xValues.insert(line->getStartPos().getX().toNm());
-            xValues.insert(line->getSegments().first()->getEndPos().getX().toNm());
-            yValues.insert(line->getStartPos().getY().toNm());
-            yValues.insert(line->getSegments().first()->getEndPos().getY().toNm());
+    QVector<std::shared_ptr<Polygon>> polygons = getAllPolygons();
+
+    // build the endpoint index of all straight horizontal and vertical lines
+    QVector<bool> candidates(polygons.count(), false);
+    EndpointIndex index;
+    for (int i = 0; i < polygons.count(); ++i) {
+        const Polygon& line = *polygons.at(i);
+        if ((line.getSegments().count() == 1) && (line.getSegments().first()->getAngle() == 0)
+            && (isHLine(line) || isVLine(line))) {
+            candidates[i] = true;
+            index[toKey(line.getStartPos())].append(i);
+            index[toKey(getEndPos(line))].append(i);
+        }
+    }
+
+    // find rectangles, starting at each (not yet used) horizontal line
+    QVector<bool> used(polygons.count(), false);
+    QVector<std::shared_ptr<Polygon>> rects;
+    QVector<int> lines;
+    for (int i = 0; i < polygons.count(); ++i) {
+        if ((!candidates.at(i)) || used.at(i) || (!isHLine(*polygons.at(i)))) continue;
+        if (!findLineRectangle(polygons, index, used, i, lines)) continue;
+
+        // create the new polygon (p1 is the start of the first line)
+        const Polygon& first = *polygons.at(lines.first());
+        Point p = first.getStartPos();
+        Polygon* rect = new Polygon(first.getLayerName(), first.getLineWidth(), fillArea,
+                                    isGrabArea, p);
+        foreach (int line, lines) {
+            p = getOtherEnd(*polygons.at(line), p);
+            rect->getSegments().append(std::make_shared<PolygonSegment>(p, Angle::deg0()));
+            used[line] = true;
         }
-        if (xValues.count() != 2 || yValues.count() != 2) break;
-        //Q_ASSERT(xValues.count() == 2 && yValues.count() == 2);
-        Point p1(xValues.values().first(), yValues.values().first());
-        Point p2(xValues.values().first(), yValues.values().last());
-        Point p3(xValues.values().last(), yValues.values().last());
-        Point p4(xValues.values().last(), yValues.values().first());
-
-        // create the new polygon
-        QString layerName = lines.first()->getLayerName();
-        Length lineWidth = lines.first()->getLineWidth();
-
-        Polygon* rect = new Polygon(layerName, lineWidth, fillArea, isGrabArea, p1);
-        rect->getSegments().append(std::make_shared<PolygonSegment>(p2, Angle::deg0()));
-        rect->getSegments().append(std::make_shared<PolygonSegment>(p3, Angle::deg0()));
-        rect->getSegments().append(std::make_shared<PolygonSegment>(p4, Angle::deg0()));
-        rect->getSegments().append(std::make_shared<PolygonSegment>(p1, Angle::deg0()));
-        mLibraryElement.getPolygons().append(std::shared_ptr<Polygon>(rect));
-
-        // remove all lines
-        foreach (Polygon* line, lines)
-            mLibraryElement.getPolygons().remove(line);
+        rects.append(std::shared_ptr<Polygon>(rect));
+    }
+
+    if (!rects.isEmpty()) {
+        replacePolygons(polygons, used, rects);
+    }
+}
+
+template <typename LibElemType>
+void PolygonSimplifier<LibElemType>::joinLinesToPolygons() noexcept
+{
+    QVector<std::shared_ptr<Polygon>> polygons = getAllPolygons();
+
+    // build the endpoint index of all (not filled) single segment polygons
+    QVector<bool> candidates(polygons.count(), false);
+    EndpointIndex index;
+    for (int i = 0; i < polygons.count(); ++i) {
+        const Polygon& line = *polygons.at(i);
+        if ((line.getSegments().count() == 1) && (!line.isFilled())
+            && (line.getStartPos() != getEndPos(line))) {
+            candidates[i] = true;
+            index[toKey(line.getStartPos())].append(i);
+            index[toKey(getEndPos(line))].append(i);
+        }
+    }
+
+    QVector<bool> used(polygons.count(), false);
+    QVector<std::shared_ptr<Polygon>> joined;
+    for (int i = 0; i < polygons.count(); ++i) {
+        if ((!candidates.at(i)) || used.at(i)) continue;
+
+        // walk backwards to the beginning of the chain (or around a closed loop)
+        int first = i;
+        Point p = polygons.at(i)->getStartPos();
+        for (int prev = findJoinableLine(polygons, index, first, p);
+             (prev >= 0) && (prev != i); prev = findJoinableLine(polygons, index, first, p)) {
+            p = getOtherEnd(*polygons.at(prev), p);
+            first = prev;
+        }
+
+        // walk forward and collect all segments
+        const Polygon& firstLine = *polygons.at(first);
+        Polygon* polygon = new Polygon(firstLine.getLayerName(), firstLine.getLineWidth(),
+                                       false, firstLine.isGrabArea(), p);
+        int count = 0;
+        for (int line = first; (line >= 0) && ((line != first) || (count == 0));
+             line = findJoinableLine(polygons, index, line, p)) {
+            const Polygon& l = *polygons.at(line);
+            const Angle& angle = l.getSegments().first()->getAngle();
+            bool reversed = (l.getStartPos() != p);
+            p = getOtherEnd(l, p);
+            polygon->getSegments().append(
+                std::make_shared<PolygonSegment>(p, reversed ? -angle : angle));
+            used[line] = true;
+            ++count;
+        }
+
+        if (count > 1) {
+            joined.append(std::shared_ptr<Polygon>(polygon));
+        } else {
+            used[first] = false; // nothing to join, keep the original line
+            delete polygon;
+        }
+    }
+
+    if (!joined.isEmpty()) {
+        replacePolygons(polygons, used, joined);
     }
 }
 
@@ -91,81 +161,101 @@ void PolygonSimplifier<LibElemType>::convertLineRectsToPolygonRects(bool fillAre
  ****************************************************************************************/
 
 template <typename LibElemType>
-bool PolygonSimplifier<LibElemType>::findLineRectangle(QList<Polygon*>& lines) noexcept
+QVector<std::shared_ptr<Polygon>> PolygonSimplifier<LibElemType>::getAllPolygons() noexcept
 {
-    // find lines
-    QList<Polygon*> linePolygons;
-    for (Polygon& polygon : mLibraryElement.getPolygons()) {
-        if (polygon.getSegments().count() == 1)
-            linePolygons.append(&polygon);
+    QVector<std::shared_ptr<Polygon>> polygons;
+    polygons.reserve(mLibraryElement.getPolygons().count());
+    for (int i = 0; i < mLibraryElement.getPolygons().count(); ++i) {
+        polygons.append(mLibraryElement.getPolygons().value(i));
     }
+    return polygons;
+}
 
-    // find rectangle
-    Polygon* line;
-    Length width;
-    for (int i=0; i<linePolygons.count(); i++) {
-        lines.clear();
-        Point p = linePolygons.at(i)->getStartPos();
-        if (findHLine(linePolygons, p, nullptr, &line)) {
-            lines.append(line);
-            width = line->getLineWidth();
-            if (findVLine(linePolygons, p, &width, &line)) {
-                lines.append(line);
-                if (findHLine(linePolygons, p, &width, &line)) {
-                    lines.append(line);
-                    if (findVLine(linePolygons, p, &width, &line)) {
-                        lines.append(line);
-                        return true;
-                    }
-                }
-            }
+template <typename LibElemType>
+void PolygonSimplifier<LibElemType>::replacePolygons(
+        const QVector<std::shared_ptr<Polygon>>& polygons, const QVector<bool>& remove,
+        const QVector<std::shared_ptr<Polygon>>& additional) noexcept
+{
+    // rebuilding the whole list is much faster than removing the elements one by one
+    mLibraryElement.getPolygons().clear();
+    for (int i = 0; i < polygons.count(); ++i) {
+        if (!remove.at(i)) {
+            mLibraryElement.getPolygons().append(polygons.at(i));
         }
     }
-
-    lines.clear();
-    return false;
+    foreach (const std::shared_ptr<Polygon>& polygon, additional) {
+        mLibraryElement.getPolygons().append(polygon);
+    }
 }
 
 template <typename LibElemType>
-bool PolygonSimplifier<LibElemType>::findHLine(const QList<Polygon*>& lines, Point& p,
-                                               Length* width, Polygon** line) noexcept
+bool PolygonSimplifier<LibElemType>::findLineRectangle(
+        const QVector<std::shared_ptr<Polygon>>& polygons, const EndpointIndex& index,
+        const QVector<bool>& used, int first, QVector<int>& lines) const noexcept
 {
-    foreach (Polygon* polygon, lines) {
-        if (width) {if (polygon->getLineWidth() != *width) continue;}
-        Point p1 = polygon->getStartPos();
-        Point p2 = polygon->getSegments().first()->getEndPos();
-        if ((p1 == p) && (p2.getY() == p.getY())) {
-            *line = polygon;
-            p = p2;
-            return true;
-        } else if ((p2 == p) && (p1.getY() == p.getY())) {
-            *line = polygon;
-            p = p1;
-            return true;
+    // the rectangle a -> b -> c -> d -> a consists of the lines H1, V2, H3 and V4
+    const Polygon& h1 = *polygons.at(first);
+    Point a = h1.getStartPos();
+    Point b = getEndPos(h1);
+    auto isCandidate = [&](int i, bool horizontal) {
+        const Polygon& line = *polygons.at(i);
+        return (!used.at(i)) && (i != first) && (horizontal ? isHLine(line) : isVLine(line))
+            && (line.getLineWidth() == h1.getLineWidth())
+            && (line.getLayerName() == h1.getLayerName());
+    };
+    foreach (int v2, index.value(toKey(b))) {
+        if (!isCandidate(v2, false)) continue;
+        Point c = getOtherEnd(*polygons.at(v2), b);
+        foreach (int h3, index.value(toKey(c))) {
+            if (!isCandidate(h3, true)) continue;
+            Point d = getOtherEnd(*polygons.at(h3), c);
+            foreach (int v4, index.value(toKey(d))) {
+                if ((v4 == v2) || (!isCandidate(v4, false))) continue;
+                if (getOtherEnd(*polygons.at(v4), d) != a) continue;
+                lines = {first, v2, h3, v4};
+                return true;
+            }
         }
     }
     return false;
 }
 
 template <typename LibElemType>
-bool PolygonSimplifier<LibElemType>::findVLine(const QList<Polygon*>& lines, Point& p,
-                                               Length* width, Polygon** line) noexcept
+int PolygonSimplifier<LibElemType>::findJoinableLine(
+        const QVector<std::shared_ptr<Polygon>>& polygons, const EndpointIndex& index,
+        int line, const Point& p) const noexcept
 {
-    foreach (Polygon* polygon, lines) {
-        if (width) {if (polygon->getLineWidth() != *width) continue;}
-        Point p1 = polygon->getStartPos();
-        Point p2 = polygon->getSegments().first()->getEndPos();
-        if ((p1 == p) && (p2.getX() == p.getX())) {
-            *line = polygon;
-            p = p2;
-            return true;
-        } else if ((p2 == p) && (p1.getX() == p.getX())) {
-            *line = polygon;
-            p = p1;
-            return true;
-        }
+    // lines are not joined at junctions, i.e. exactly two lines must end at this point
+    const QVector<int> lines = index.value(toKey(p));
+    if (lines.count() != 2) return -1;
+    int other = (lines.at(0) == line) ? lines.at(1) : lines.at(0);
+    const Polygon& l1 = *polygons.at(line);
+    const Polygon& l2 = *polygons.at(other);
+    if ((other == line) || (l1.getLayerName() != l2.getLayerName())
+        || (l1.getLineWidth() != l2.getLineWidth()) || (l1.isGrabArea() != l2.isGrabArea())) {
+        return -1;
     }
-    return false;
+    return other;
+}
+
+template <typename LibElemType>
+Point PolygonSimplifier<LibElemType>::getOtherEnd(const Polygon& line, const Point& p) noexcept
+{
+    return (line.getStartPos() == p) ? getEndPos(line) : line.getStartPos();
+}
+
+template <typename LibElemType>
+bool PolygonSimplifier<LibElemType>::isHLine(const Polygon& line) noexcept
+{
+    const Point& p2 = getEndPos(line);
+    return (line.getStartPos().getY() == p2.getY()) && (line.getStartPos().getX() != p2.getX());
+}
+
+template <typename LibElemType>
+bool PolygonSimplifier<LibElemType>::isVLine(const Polygon& line) noexcept
+{
+    const Point& p2 = getEndPos(line);
+    return (line.getStartPos().getX() == p2.getX()) && (line.getStartPos().getY() != p2.getY());
 }
 
 /*****************************************************************************************
@@ -38,6 +38,10 @@ namespace librepcb {
 
 /**
  * @brief The PolygonSimplifier class
+ *
+ * Merges the single line polygons imported from Eagle into fewer, bigger polygons. All
+ * lookups of adjacent lines are done with a hash index of the line endpoints, so the
+ * runtime grows nearly linear with the number of polygons of the library element.
  */
 template <typename LibElemType>
 class PolygonSimplifier
@@ -49,17 +53,46 @@ class PolygonSimplifier
         ~PolygonSimplifier();
 
         // General Methods
+
+        /**
+         * @brief Replace each four lines which form a closed rectangle by a single polygon
+         *
+         * Only straight, horizontal or vertical lines with the same layer and width are
+         * merged.
+         */
         void convertLineRectsToPolygonRects(bool fillArea, bool isGrabArea) noexcept;
 
+        /**
+         * @brief Join lines which are connected end-to-end to polygons with multiple segments
+         *
+         * Lines are only joined at endpoints where no other line starts or ends (i.e. no
+         * junctions), and only if they have the same layer, width and grab area flag.
+         */
+        void joinLinesToPolygons() noexcept;
+
 
     private:
 
+        // Types
+        typedef QPair<LengthBase_t, LengthBase_t> PointKey;
+        typedef QHash<PointKey, QVector<int>> EndpointIndex;
+
         // Private Methods
-        bool findLineRectangle(QList<librepcb::Polygon*>& lines) noexcept;
-        bool findHLine(const QList<Polygon*>& lines, librepcb::Point& p,
-                       librepcb::Length* width, librepcb::Polygon** line) noexcept;
-        bool findVLine(const QList<Polygon*>& lines, librepcb::Point& p,
-                       librepcb::Length* width, librepcb::Polygon** line) noexcept;
+        QVector<std::shared_ptr<Polygon>> getAllPolygons() noexcept;
+        void replacePolygons(const QVector<std::shared_ptr<Polygon>>& polygons,
+                             const QVector<bool>& remove,
+                             const QVector<std::shared_ptr<Polygon>>& additional) noexcept;
+        bool findLineRectangle(const QVector<std::shared_ptr<Polygon>>& polygons,
+                               const EndpointIndex& index, const QVector<bool>& used,
+                               int first, QVector<int>& lines) const noexcept;
+        int findJoinableLine(const QVector<std::shared_ptr<Polygon>>& polygons,
+                             const EndpointIndex& index, int line,
+                             const Point& p) const noexcept;
+        static PointKey toKey(const Point& p) noexcept {return qMakePair(p.getX().toNm(), p.getY().toNm());}
+        static const Point& getEndPos(const Polygon& line) noexcept {return line.getSegments().first()->getEndPos();}
+        static Point getOtherEnd(const Polygon& line, const Point& p) noexcept;
+        static bool isHLine(const Polygon& line) noexcept;
+        static bool isVLine(const Polygon& line) noexcept;
 
 
         // Attributes
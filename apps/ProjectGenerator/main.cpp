@@ -0,0 +1,153 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <librepcb/common/application.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/uuid.h>
+#include "projectgenerator.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+using namespace librepcb;
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static int getPositiveValue(const QCommandLineParser& parser, const QCommandLineOption& option);
+
+/*****************************************************************************************
+ *  main()
+ ****************************************************************************************/
+
+int main(int argc, char* argv[])
+{
+    // No windows are shown at all, so run without a display (e.g. on build servers)
+    // unless another platform plugin is explicitly requested.
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv);
+
+    QCoreApplication::setOrganizationName("LibrePCB");
+    QCoreApplication::setApplicationName("ProjectGenerator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generate synthetic LibrePCB projects of configurable "
+                                     "size for benchmarks and scale tests. The same options "
+                                     "always generate the same project structure and UUIDs.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("output", "Output directory (must not exist yet). The "
+        "library and the project are created in the subdirectories \"library\" and "
+        "\"project\".");
+    QCommandLineOption componentsOption("components",
+        "Count of component instances. Default: 1000.", "count", "1000");
+    QCommandLineOption netsOption("nets",
+        "Count of nets. Default: 500.", "count", "500");
+    QCommandLineOption tracesOption("traces",
+        "Maximum count of trace segments on the board. Default: 5000.", "count", "5000");
+    QCommandLineOption sheetsOption("sheets",
+        "Count of schematic pages. Default: 10.", "count", "10");
+    QCommandLineOption partsOption("library-parts",
+        "Count of different parts in the generated library. Default: 50.", "count", "50");
+    QCommandLineOption seedOption("seed",
+        "Seed for the pseudo random number generator. Default: 1.", "number", "1");
+    parser.addOption(componentsOption);
+    parser.addOption(netsOption);
+    parser.addOption(tracesOption);
+    parser.addOption(sheetsOption);
+    parser.addOption(partsOption);
+    parser.addOption(seedOption);
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    if (parser.positionalArguments().count() != 1) {
+        err << "Exactly one output directory must be specified." << endl;
+        parser.showHelp(1);
+    }
+    FilePath outputDir(QFileInfo(parser.positionalArguments().first()).absoluteFilePath());
+    if (outputDir.isExistingDir() || outputDir.isExistingFile()) {
+        err << QString("The output directory \"%1\" exists already.").arg(outputDir.toNative()) << endl;
+        return 1;
+    }
+
+    ProjectGenerator::Options options;
+    options.components = getPositiveValue(parser, componentsOption);
+    options.nets = getPositiveValue(parser, netsOption);
+    options.traces = getPositiveValue(parser, tracesOption);
+    options.sheets = getPositiveValue(parser, sheetsOption);
+    options.libraryParts = getPositiveValue(parser, partsOption);
+    bool ok = false;
+    options.seed = parser.value(seedOption).toUInt(&ok);
+    if ((!ok) || (options.seed == 0)) {
+        err << QString("Invalid value for \"--%1\": %2").arg(seedOption.names().first(),
+                                                           parser.value(seedOption)) << endl;
+        return 1;
+    }
+    if ((options.components < 0) || (options.nets < 0) || (options.traces < 0) ||
+        (options.sheets < 0) || (options.libraryParts < 0)) {
+        return 1; // error message already printed
+    }
+
+    try
+    {
+        // make the UUIDs reproducible too (the timestamps in the files are not)
+        Uuid::setDeterministicSeed(options.seed);
+        ProjectGenerator generator(options);
+        FilePath libDir = outputDir.getPathTo("library/Synthetic.lplib");
+        out << QString("Generate library \"%1\"...").arg(libDir.toNative()) << endl;
+        generator.generateLibrary(libDir); // can throw
+        FilePath projectFp = outputDir.getPathTo("project/Synthetic.lpp");
+        out << QString("Generate project \"%1\"...").arg(projectFp.toNative()) << endl;
+        int netlines = generator.generateProject(projectFp); // can throw
+        out << QString("Done: %1 components, %2 nets, %3 traces.").arg(options.components)
+               .arg(options.nets).arg(netlines) << endl;
+        return 0;
+    }
+    catch (const Exception& e)
+    {
+        err << QString("Failed to generate the project: %1").arg(e.getMsg()) << endl;
+        return 1;
+    }
+}
+
+/*****************************************************************************************
+ *  getPositiveValue()
+ ****************************************************************************************/
+
+static int getPositiveValue(const QCommandLineParser& parser, const QCommandLineOption& option)
+{
+    bool ok = false;
+    int value = parser.value(option).toInt(&ok);
+    if ((!ok) || (value < 1)) {
+        QTextStream(stderr) << QString("Invalid value for \"--%1\": %2")
+                               .arg(option.names().first(), parser.value(option)) << endl;
+        return -1;
+    }
+    return value;
+}
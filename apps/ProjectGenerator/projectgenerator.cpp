@@ -0,0 +1,305 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "projectgenerator.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/version.h>
+#include <librepcb/library/library.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/cmp/cmpsigpindisplaytype.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/library/projectlibrary.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/circuit/componentsignalinstance.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/items/si_symbol.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+using namespace project;
+
+/*****************************************************************************************
+ *  Constants
+ ****************************************************************************************/
+
+static const char* sAuthor = "LibrePCB Project Generator";
+static const Length sPinPitch(2540000);     ///< 2.54mm between pins and pads
+static const Length sTraceWidth(250000);
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ProjectGenerator::ProjectGenerator(const Options& options) noexcept :
+    mOptions(options), mRandom(options.seed)
+{
+}
+
+ProjectGenerator::~ProjectGenerator() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void ProjectGenerator::generateLibrary(const FilePath& libDir)
+{
+    library::Library lib(Uuid::createRandom(), Version("0.1"), sAuthor, "Synthetic Library",
+                         "Generated library for benchmarks and scale tests.", "");
+    lib.saveTo(libDir); // can throw
+    mLibDir = libDir;
+
+    mParts.clear();
+    for (int i = 0; i < mOptions.libraryParts; ++i) {
+        generatePart(i); // can throw
+    }
+}
+
+int ProjectGenerator::generateProject(const FilePath& projectFile)
+{
+    if (mParts.isEmpty() || (mOptions.nets < 1) || (mOptions.sheets < 1)) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+
+    QScopedPointer<Project> project(Project::create(projectFile)); // can throw
+    Circuit& circuit = project->getCircuit();
+
+    // net signals (all in the default net class)
+    NetClass* netclass = circuit.getNetClasses().first();
+    QVector<NetSignal*> netsignals;
+    for (int i = 0; i < mOptions.nets; ++i) {
+        NetSignal* netsignal = new NetSignal(circuit, *netclass, QString("N%1").arg(i + 1), false);
+        circuit.addNetSignal(*netsignal); // can throw
+        netsignals.append(netsignal);
+    }
+
+    // schematic pages and board
+    QVector<Schematic*> schematics;
+    for (int i = 0; i < mOptions.sheets; ++i) {
+        Schematic* schematic = project->createSchematic(QString("Sheet %1").arg(i + 1)); // can throw
+        project->addSchematic(*schematic); // can throw
+        schematics.append(schematic);
+        schematic->beginBulkUpdate();
+    }
+    Board* board = project->createBoard("Board"); // can throw
+    project->addBoard(*board); // can throw
+    board->beginBulkUpdate();
+
+    // components (symbols in a grid on every page, devices in a grid on the board)
+    int boardColumns = qMax(1, qCeil(qSqrt(mOptions.components)));
+    QVector<QList<BI_FootprintPad*>> padsOfNets(mOptions.nets);
+    for (int i = 0; i < mOptions.components; ++i) {
+        const Part& part = mParts.at(random(mParts.count()));
+        addPartToProject(*project, part); // can throw
+        ComponentInstance* cmp = new ComponentInstance(circuit,
+            *project->getLibrary().getComponent(part.component), part.symbolVariant,
+            QString("U%1").arg(i + 1)); // can throw
+        circuit.addComponentInstance(*cmp); // can throw
+        QList<int> netsOfPads;
+        foreach (const Uuid& signal, part.signalUuids) {
+            int net = random(mOptions.nets);
+            cmp->getSignalInstance(signal)->setNetSignal(netsignals.at(net)); // can throw
+            netsOfPads.append(net);
+        }
+
+        int index = i / mOptions.sheets;
+        Point symbolPos(sPinPitch * 10 * (index % 10), sPinPitch * -10 * (index / 10));
+        Schematic* schematic = schematics.at(i % mOptions.sheets);
+        schematic->addSymbol(*new SI_Symbol(*schematic, *cmp, part.symbolItem, symbolPos)); // can throw
+
+        Point devicePos(sPinPitch * 6 * (i % boardColumns), sPinPitch * 10 * (i / boardColumns));
+        BI_Device* device = new BI_Device(*board, *cmp, part.device, part.footprint,
+                                          devicePos, Angle::deg0(), false); // can throw
+        board->addDeviceInstance(*device); // can throw
+        for (int k = 0; k < part.pads.count(); ++k) {
+            padsOfNets[netsOfPads.at(k)].append(device->getFootprint().getPad(part.pads.at(k)));
+        }
+    }
+
+    // traces between the pads of the same nets (interleaved over all nets, on alternating
+    // layers, L-shaped if the pads are not aligned)
+    QList<GraphicsLayer*> layers = {
+        board->getLayerStack().getLayer(GraphicsLayer::sTopCopper),
+        board->getLayerStack().getLayer(GraphicsLayer::sBotCopper)};
+    QHash<QPair<BI_FootprintPad*, GraphicsLayer*>, BI_NetPoint*> padNetPoints;
+    auto getPadNetPoint = [&](BI_FootprintPad& pad, GraphicsLayer& layer) {
+        BI_NetPoint*& netpoint = padNetPoints[qMakePair(&pad, &layer)];
+        if (!netpoint) {
+            netpoint = new BI_NetPoint(*board, layer, *pad.getCompSigInstNetSignal(), pad); // can throw
+            board->addNetPoint(*netpoint); // can throw
+        }
+        return netpoint;
+    };
+    int netlines = 0;
+    int connections = 0;
+    bool padsLeft = true;
+    for (int round = 0; padsLeft && (netlines < mOptions.traces); ++round) {
+        padsLeft = false;
+        for (int net = 0; (net < mOptions.nets) && (netlines < mOptions.traces); ++net) {
+            const QList<BI_FootprintPad*>& pads = padsOfNets.at(net);
+            if (pads.count() < round + 2) continue;
+            padsLeft = true;
+            GraphicsLayer& layer = *layers.at(connections++ % layers.count());
+            BI_NetPoint* start = getPadNetPoint(*pads.at(round), layer);
+            BI_NetPoint* end = getPadNetPoint(*pads.at(round + 1), layer);
+            Point startPos = start->getPosition();
+            Point endPos = end->getPosition();
+            if ((startPos.getX() != endPos.getX()) && (startPos.getY() != endPos.getY())) {
+                BI_NetPoint* corner = new BI_NetPoint(*board, layer, *netsignals.at(net),
+                    Point(endPos.getX(), startPos.getY())); // can throw
+                board->addNetPoint(*corner); // can throw
+                board->addNetLine(*new BI_NetLine(*board, *start, *corner, sTraceWidth)); // can throw
+                ++netlines;
+                start = corner;
+            }
+            board->addNetLine(*new BI_NetLine(*board, *start, *end, sTraceWidth)); // can throw
+            ++netlines;
+        }
+    }
+
+    board->endBulkUpdate();
+    foreach (Schematic* schematic, schematics) {
+        schematic->endBulkUpdate();
+    }
+    project->save(true); // can throw
+    return netlines;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void ProjectGenerator::generatePart(int index)
+{
+    Part part;
+    part.symbol = Uuid::createRandom();
+    part.component = Uuid::createRandom();
+    part.symbolVariant = Uuid::createRandom();
+    part.symbolItem = Uuid::createRandom();
+    part.package = Uuid::createRandom();
+    part.footprint = Uuid::createRandom();
+    part.device = Uuid::createRandom();
+    int pinCount = 2 * (1 + random(8)); // 2..16 pins
+    QString name = QString("Synthetic Part %1").arg(index + 1);
+    Version version("0.1");
+
+    library::Symbol symbol(part.symbol, version, sAuthor, name, "", "synthetic");
+    library::Component component(part.component, version, sAuthor, name, "", "synthetic");
+    component.getPrefixes().setDefaultValue("U");
+    auto symbolVariant = std::make_shared<library::ComponentSymbolVariant>(
+        part.symbolVariant, "", "default", "");
+    auto symbolItem = std::make_shared<library::ComponentSymbolVariantItem>(
+        part.symbolItem, part.symbol, true, "");
+    library::Package package(part.package, version, sAuthor, name, "", "synthetic");
+    auto footprint = std::make_shared<library::Footprint>(part.footprint, "default", "");
+    library::Device device(part.device, version, sAuthor, name, "", "synthetic");
+    device.setComponentUuid(part.component);
+    device.setPackageUuid(part.package);
+
+    for (int i = 0; i < pinCount; ++i) {
+        // two columns of pins and pads, like a DIP package
+        bool right = (i >= pinCount / 2);
+        int row = right ? (pinCount - 1 - i) : i;
+        QString pinName = QString::number(i + 1);
+        Uuid pin = Uuid::createRandom();
+        Uuid signal = Uuid::createRandom();
+        Uuid pad = Uuid::createRandom();
+        symbol.getPins().append(std::make_shared<library::SymbolPin>(pin, pinName,
+            Point(sPinPitch * (right ? 3 : -3), sPinPitch * -row), sPinPitch,
+            right ? Angle::deg180() : Angle::deg0()));
+        component.getSignals().append(std::make_shared<library::ComponentSignal>(signal, pinName));
+        symbolItem->getPinSignalMap().append(std::make_shared<library::ComponentPinSignalMapItem>(
+            pin, signal, library::CmpSigPinDisplayType::componentSignal()));
+        package.getPads().append(std::make_shared<library::PackagePad>(pad, pinName));
+        footprint->getPads().append(std::make_shared<library::FootprintPad>(pad,
+            Point(sPinPitch * (right ? 3 : 0), sPinPitch * row), Angle::deg0(),
+            library::FootprintPad::Shape::ROUND, Length(1600000), Length(1600000),
+            Length(800000), library::FootprintPad::BoardSide::THT));
+        device.getPadSignalMap().append(std::make_shared<library::DevicePadSignalMapItem>(
+            pad, signal));
+        part.signalUuids.append(signal);
+        part.pads.append(pad);
+    }
+    symbolVariant->getSymbolItems().append(symbolItem);
+    component.getSymbolVariants().append(symbolVariant);
+    package.getFootprints().append(footprint);
+
+    // can throw
+    symbol.saveIntoParentDirectory(library::Library::getElementsDirectory<library::Symbol>(mLibDir));
+    component.saveIntoParentDirectory(library::Library::getElementsDirectory<library::Component>(mLibDir));
+    package.saveIntoParentDirectory(library::Library::getElementsDirectory<library::Package>(mLibDir));
+    device.saveIntoParentDirectory(library::Library::getElementsDirectory<library::Device>(mLibDir));
+    mParts.append(part);
+}
+
+void ProjectGenerator::addPartToProject(Project& project, const Part& part)
+{
+    // copy the elements from the generated library, like when adding them in the editor
+    ProjectLibrary& lib = project.getLibrary();
+    using library::Library;
+    if (!lib.getSymbol(part.symbol)) {
+        lib.addSymbol(*new library::Symbol(Library::getElementsDirectory<library::Symbol>(
+            mLibDir).getPathTo(part.symbol.toStr()), true)); // can throw
+    }
+    if (!lib.getComponent(part.component)) {
+        lib.addComponent(*new library::Component(Library::getElementsDirectory<library::Component>(
+            mLibDir).getPathTo(part.component.toStr()), true)); // can throw
+    }
+    if (!lib.getPackage(part.package)) {
+        lib.addPackage(*new library::Package(Library::getElementsDirectory<library::Package>(
+            mLibDir).getPathTo(part.package.toStr()), true)); // can throw
+    }
+    if (!lib.getDevice(part.device)) {
+        lib.addDevice(*new library::Device(Library::getElementsDirectory<library::Device>(
+            mLibDir).getPathTo(part.device.toStr()), true)); // can throw
+    }
+}
+
+int ProjectGenerator::random(int max) noexcept
+{
+    // not std::uniform_int_distribution, its results differ between implementations
+    return static_cast<int>(mRandom() % static_cast<quint32>(qMax(max, 1)));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
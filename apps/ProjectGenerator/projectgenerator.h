@@ -0,0 +1,145 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROJECTGENERATOR_H
+#define PROJECTGENERATOR_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <random>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace project {
+class Project;
+}
+
+/*****************************************************************************************
+ *  Class ProjectGenerator
+ ****************************************************************************************/
+
+/**
+ * @brief The ProjectGenerator class generates synthetic projects of configurable size
+ *
+ * First a library with synthetic parts is generated (every part consists of a symbol, a
+ * component, a package with THT pads and a device), then a project which contains
+ * instances of these parts. All signals of the components are connected to randomly
+ * chosen nets, and the pads of the same nets are connected with traces on the board.
+ *
+ * All random decisions are made with a pseudo random number generator initialized with
+ * #Options::seed, so the same options always lead to the same project structure. To get
+ * reproducible UUIDs as well, librepcb::Uuid::setDeterministicSeed() must be called
+ * before generating anything.
+ *
+ * @note The generated projects are intended for benchmarks and scale tests only: the
+ *       schematics contain no wires (the nets are defined only in the circuit) and the
+ *       traces are not checked for clearance violations.
+ */
+class ProjectGenerator final
+{
+        Q_DECLARE_TR_FUNCTIONS(ProjectGenerator)
+
+    public:
+
+        // Types
+        struct Options {
+            int components;     ///< count of component instances
+            int nets;           ///< count of net signals
+            int traces;         ///< count of trace segments (netlines) on the board
+            int sheets;         ///< count of schematic pages
+            int libraryParts;   ///< count of parts (4 library elements each) in the library
+            quint32 seed;       ///< seed of the pseudo random number generator
+        };
+
+        // Constructors / Destructor
+        ProjectGenerator() = delete;
+        ProjectGenerator(const ProjectGenerator& other) = delete;
+        explicit ProjectGenerator(const Options& options) noexcept;
+        ~ProjectGenerator() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Generate the synthetic library
+         *
+         * @param libDir    The library directory to create (*.lplib)
+         *
+         * @throws Exception on error
+         */
+        void generateLibrary(const FilePath& libDir);
+
+        /**
+         * @brief Generate the synthetic project (requires #generateLibrary() first)
+         *
+         * @param projectFile   The project file to create (*.lpp)
+         *
+         * @return The count of netlines added to the board (may be less than
+         *         #Options::traces if there are not enough pads to connect)
+         *
+         * @throws Exception on error
+         */
+        int generateProject(const FilePath& projectFile);
+
+        // Operator Overloadings
+        ProjectGenerator& operator=(const ProjectGenerator& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct Part {
+            Uuid symbol;
+            Uuid component;
+            Uuid symbolVariant;
+            Uuid symbolItem;
+            Uuid package;
+            Uuid footprint;
+            Uuid device;
+            QList<Uuid> signalUuids;    ///< same order as #pads
+            QList<Uuid> pads;           ///< package pads, same order as #signalUuids
+        };
+
+        // Private Methods
+        void generatePart(int index);
+        void addPartToProject(project::Project& project, const Part& part);
+        int random(int max) noexcept;
+
+
+        // Attributes
+        Options mOptions;
+        std::mt19937 mRandom;   ///< its sequence is the same on all platforms
+        FilePath mLibDir;
+        QVector<Part> mParts;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // PROJECTGENERATOR_H
@@ -40,9 +40,11 @@ PRE_TARGETDEPS += \
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
+    projectlibraryupdater.cpp \
 
 HEADERS += \
     mainwindow.h \
+    projectlibraryupdater.h \
 
 FORMS += \
     mainwindow.ui \
@@ -24,21 +24,160 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/application.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include "projectlibraryupdater.h"
 #include "mainwindow.h"
 
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+using namespace librepcb;
+using namespace librepcb::workspace;
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static int runHeadless(const QCommandLineParser& parser, const QString& workspacePath,
+                       const QStringList& elements, bool dryRun);
+
 /*****************************************************************************************
  *  main()
  ****************************************************************************************/
 
 int main(int argc, char* argv[])
 {
-    librepcb::Application app(argc, argv);
+    // Without projects (or elements) on the command line, the GUI is shown. Otherwise no windows
+    // are shown at all, so run without a display unless another platform plugin is
+    // explicitly requested.
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        QByteArray arg(argv[i]);
+        if ((arg == "-w") || (arg == "--workspace")) {
+            ++i; // skip the value of the option
+        } else if ((arg == "-e") || (arg == "--element")) {
+            ++i; // skip the value of the option
+            headless = true;
+        } else if (!arg.startsWith("-")) {
+            headless = true;
+        }
+    }
+    if (headless && qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv);
 
     QCoreApplication::setOrganizationName("LibrePCB");
     QCoreApplication::setApplicationName("ProjectLibraryUpdater");
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Update the library elements of LibrePCB projects to "
+                                     "the latest versions of a workspace. Without projects, "
+                                     "the graphical user interface is shown.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("projects", "Paths to the project files (*.lpp).",
+                                 "[projects...]");
+    QCommandLineOption workspaceOption(QStringList() << "w" << "workspace",
+        "Workspace directory. Default: the most recently used workspace.", "directory");
+    QCommandLineOption elementOption(QStringList() << "e" << "element",
+        "Also update all projects of the workspace which contain this library element, "
+        "according to the where-used index of the workspace library database. Can be "
+        "given multiple times.", "uuid");
+    QCommandLineOption dryRunOption(QStringList() << "n" << "dry-run",
+        "Only report which library elements would change, but do not modify the projects.");
+    parser.addOption(workspaceOption);
+    parser.addOption(elementOption);
+    parser.addOption(dryRunOption);
+    parser.process(app);
+
+    if ((!parser.positionalArguments().isEmpty()) || parser.isSet(elementOption)) {
+        return runHeadless(parser, parser.value(workspaceOption),
+                           parser.values(elementOption), parser.isSet(dryRunOption));
+    }
+
     MainWindow w;
     w.show();
 
     return QApplication::exec();
 }
+
+/*****************************************************************************************
+ *  runHeadless()
+ ****************************************************************************************/
+
+static int runHeadless(const QCommandLineParser& parser, const QString& workspacePath,
+                       const QStringList& elements, bool dryRun)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QList<FilePath> projects;
+    foreach (const QString& arg, parser.positionalArguments()) {
+        projects.append(FilePath(QFileInfo(arg).absoluteFilePath()));
+    }
+    QSet<Uuid> elementUuids;
+    foreach (const QString& element, elements) {
+        Uuid uuid(element);
+        if (uuid.isNull()) {
+            err << QString("Invalid element UUID: \"%1\"").arg(element) << endl;
+            return 1;
+        }
+        elementUuids.insert(uuid);
+    }
+
+    try
+    {
+        FilePath wsPath = workspacePath.isEmpty() ? Workspace::getMostRecentlyUsedWorkspacePath()
+                          : FilePath(QFileInfo(workspacePath).absoluteFilePath());
+        if (!Workspace::isValidWorkspacePath(wsPath)) {
+            err << QString("Invalid workspace: \"%1\"").arg(wsPath.toNative()) << endl;
+            return 1;
+        }
+        Workspace workspace(wsPath); // can throw
+
+        // look up the projects using the elements once the project index is up to date
+        if (!elementUuids.isEmpty()) {
+            workspace.getLibraryDb().waitForProjectIndex();
+            QList<FilePath> usingProjects =
+                workspace.getLibraryDb().getProjectsUsingElements(elementUuids).toList(); // can throw
+            std::sort(usingProjects.begin(), usingProjects.end(),
+                      [](const FilePath& a, const FilePath& b) {return a.toStr() < b.toStr();});
+            foreach (const FilePath& project, usingProjects) {
+                if (!projects.contains(project)) {
+                    projects.append(project);
+                }
+            }
+            if (projects.isEmpty()) {
+                out << "No projects contain the given elements." << endl;
+                return 0;
+            }
+        }
+
+        ProjectLibraryUpdater updater(workspace);
+        int failedProjects = 0;
+        foreach (const ProjectLibraryUpdater::Result& result, updater.update(projects, dryRun)) {
+            out << result.project.toNative() << ":" << endl;
+            foreach (const ProjectLibraryUpdater::Change& change, result.changes) {
+                out << QString("  %1 %2").arg(ProjectLibraryUpdater::actionToString(change.action),
+                                              change.elementDir) << endl;
+            }
+            if (!result.error.isEmpty()) {
+                err << QString("  ERROR: %1").arg(result.error) << endl;
+                ++failedProjects;
+            } else if (result.changes.isEmpty()) {
+                out << "  up to date" << endl;
+            }
+        }
+        out << QString("%1 of %2 projects %3.").arg(projects.count() - failedProjects)
+               .arg(projects.count()).arg(dryRun ? "checked" : "updated") << endl;
+        return (failedProjects > 0) ? 1 : 0;
+    }
+    catch (const Exception& e)
+    {
+        err << QString("Failed to open workspace: %1").arg(e.getMsg()) << endl;
+        return 1;
+    }
+}
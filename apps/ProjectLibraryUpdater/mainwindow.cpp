@@ -2,15 +2,7 @@
 #include <QtWidgets>
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
-#include <librepcb/common/fileio/fileutils.h>
-#include <librepcb/common/fileio/smartxmlfile.h>
-#include <librepcb/common/fileio/domdocument.h>
-#include <librepcb/common/fileio/domelement.h>
-#include <librepcb/library/cmp/component.h>
-#include <librepcb/library/sym/symbol.h>
-#include <librepcb/library/dev/device.h>
-#include <librepcb/library/pkg/footprint.h>
-#include <librepcb/library/pkg/package.h>
+#include "projectlibraryupdater.h"
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
 
@@ -80,85 +72,22 @@ void MainWindow::on_pushButton_2_clicked()
         FilePath workspacePath(ui->workspacepath->text());
         Workspace workspace(workspacePath);
 
+        QList<FilePath> projects;
         for (int i = 0; i < ui->projectfiles->count(); i++)
-        {
-            // open the project xml file
-            FilePath projectFilepath(ui->projectfiles->item(i)->text());
-            SmartXmlFile projectFile(projectFilepath, false, true);
-            std::unique_ptr<DomDocument> projectDoc = projectFile.parseFileAndBuildDomTree();
-
-            // remove the whole library directory
-            FilePath libDir = projectFilepath.getParentDir().getPathTo("library");
-            FileUtils::removeDirRecursively(libDir); // can throw
-
-            // components & symbols
-            SmartXmlFile circuitFile(projectFilepath.getParentDir().getPathTo("core/circuit.xml"), false, true);
-            std::unique_ptr<DomDocument> circuitDoc = circuitFile.parseFileAndBuildDomTree();
-            foreach (DomElement* node, circuitDoc->getRoot().getChilds("component")) {
-                Uuid compUuid = node->getAttribute<Uuid>("component", true);
-                FilePath filepath = workspace.getLibraryDb().getLatestComponent(compUuid);
-                if (!filepath.isExistingDir()) {
-                    qDebug() << filepath.toStr();
-                    throw RuntimeError(__FILE__, __LINE__,
-                        QString("Missing component: %1").arg(compUuid.toStr()));
-                }
-                // open & copy component
-                Component latestComp(filepath, true);
-                FilePath dest = libDir.getPathTo("cmp").getPathTo(filepath.getFilename());
-                if (!dest.isExistingDir()) FileUtils::copyDirRecursively(filepath, dest);
-                ui->log->addItem(latestComp.getFilePath().toNative());
-
-                // search all required symbols
-                for (const ComponentSymbolVariant& symbvar : latestComp.getSymbolVariants()) {
-                    foreach (const Uuid& symbolUuid, symbvar.getAllSymbolUuids()) {
-                        FilePath filepath = workspace.getLibraryDb().getLatestSymbol(symbolUuid);
-                        if (!filepath.isExistingDir()) {
-                            qDebug() << filepath.toStr();
-                            throw RuntimeError(__FILE__, __LINE__,
-                                QString("Missing symbol: %1").arg(symbolUuid.toStr()));
-                        }
-                        // open & copy symbol
-                        Symbol latestSymbol(filepath, true);
-                        FilePath dest = libDir.getPathTo("sym").getPathTo(filepath.getFilename());
-                        if (!dest.isExistingDir()) FileUtils::copyDirRecursively(filepath, dest);
-                        ui->log->addItem(latestSymbol.getFilePath().toNative());
-                    }
-                }
+            projects.append(FilePath(ui->projectfiles->item(i)->text()));
+
+        ProjectLibraryUpdater updater(workspace);
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        QList<ProjectLibraryUpdater::Result> results = updater.update(projects, false);
+        QApplication::restoreOverrideCursor();
+        foreach (const ProjectLibraryUpdater::Result& result, results) {
+            ui->log->addItem(result.project.toNative());
+            foreach (const ProjectLibraryUpdater::Change& change, result.changes) {
+                ui->log->addItem(QString("  %1 %2").arg(
+                    ProjectLibraryUpdater::actionToString(change.action), change.elementDir));
             }
-
-            // devices & packages
-            foreach (DomElement* node, projectDoc->getRoot().getChilds("board")) {
-                FilePath boardFilePath = projectFilepath.getParentDir().getPathTo("boards/" % node->getText<QString>(true));
-                SmartXmlFile boardFile(boardFilePath, false, true);
-                std::unique_ptr<DomDocument> boardDoc = boardFile.parseFileAndBuildDomTree();
-                foreach (DomElement* node, boardDoc->getRoot().getChilds("device")) {
-                    Uuid deviceUuid = node->getAttribute<Uuid>("device", true);
-                    FilePath filepath = workspace.getLibraryDb().getLatestDevice(deviceUuid);
-                    if (!filepath.isExistingDir()) {
-                        qDebug() << filepath.toStr();
-                        throw RuntimeError(__FILE__, __LINE__,
-                            QString("Missing device: %1").arg(deviceUuid.toStr()));
-                    }
-                    // open & copy device
-                    Device latestDevice(filepath, true);
-                    FilePath dest = libDir.getPathTo("dev").getPathTo(filepath.getFilename());
-                    if (!dest.isExistingDir()) FileUtils::copyDirRecursively(filepath, dest);
-                    ui->log->addItem(latestDevice.getFilePath().toNative());
-
-                    // get package
-                    Uuid packUuid = latestDevice.getPackageUuid();
-                    filepath = workspace.getLibraryDb().getLatestPackage(packUuid);
-                    if (!filepath.isExistingDir()) {
-                        qDebug() << filepath.toStr();
-                        throw RuntimeError(__FILE__, __LINE__,
-                            QString("Missing package: %1").arg(packUuid.toStr()));
-                    }
-                    // open & copy package
-                    Package latestPackage(filepath, true);
-                    dest = libDir.getPathTo("pkg").getPathTo(filepath.getFilename());
-                    if (!dest.isExistingDir()) FileUtils::copyDirRecursively(filepath, dest);
-                    ui->log->addItem(latestPackage.getFilePath().toNative());
-                }
+            if (!result.error.isEmpty()) {
+                ui->log->addItem("ERROR: " % result.error);
             }
         }
     }
@@ -0,0 +1,286 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "projectlibraryupdater.h"
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/smartxmlfile.h>
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/domelement.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+using namespace library;
+using namespace workspace;
+
+/*****************************************************************************************
+ *  Class ProjectLibraryUpdater::ProjectJob
+ ****************************************************************************************/
+
+/**
+ * @brief Updates a single project in a thread pool worker
+ *
+ * Exceptions are not propagated to the thread pool, the error message is stored in the
+ * result instead (which must not be accessed until the pool has finished).
+ */
+class ProjectLibraryUpdater::ProjectJob final : public QRunnable
+{
+    public:
+        ProjectJob(ProjectLibraryUpdater& updater, bool dryRun, Result& result) noexcept :
+            mUpdater(updater), mDryRun(dryRun), mResult(result)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            try {
+                mResult.changes = mUpdater.updateProject(mResult.project, mDryRun); // can throw
+            } catch (const Exception& e) {
+                mResult.error = e.getMsg();
+            }
+        }
+
+    private:
+        ProjectLibraryUpdater& mUpdater;
+        bool mDryRun;
+        Result& mResult;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ProjectLibraryUpdater::ProjectLibraryUpdater(const Workspace& workspace) noexcept :
+    mWorkspace(workspace)
+{
+}
+
+ProjectLibraryUpdater::~ProjectLibraryUpdater() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QList<ProjectLibraryUpdater::Result> ProjectLibraryUpdater::update(
+        const QList<FilePath>& projects, bool dryRun) noexcept
+{
+    QVector<Result> results;
+    results.reserve(projects.count());
+    foreach (const FilePath& project, projects) {
+        results.append(Result{project, QList<Change>(), QString()});
+    }
+
+    // The projects are independent of each other, so they can be updated concurrently
+    // (the library database and the library element cache are thread-safe).
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+    for (int i = 0; i < results.count(); ++i) {
+        pool.start(new ProjectJob(*this, dryRun, results[i]));
+    }
+    pool.waitForDone();
+    return results.toList();
+}
+
+QList<ProjectLibraryUpdater::Change> ProjectLibraryUpdater::updateProject(
+        const FilePath& project, bool dryRun)
+{
+    FilePath libDir = project.getParentDir().getPathTo("library");
+    QMap<QString, FilePath> required = getRequiredElements(project); // can throw
+    QStringList existing = getExistingElements(libDir);
+
+    // determine the differences (sorted by the element directory)
+    QMap<QString, Change::Action> actions;
+    for (auto it = required.constBegin(); it != required.constEnd(); ++it) {
+        if (!existing.contains(it.key())) {
+            actions.insert(it.key(), Change::Action::Add);
+        } else if (!isDirEqual(it.value(), libDir.getPathTo(it.key()))) {
+            actions.insert(it.key(), Change::Action::Update);
+        }
+    }
+    foreach (const QString& elementDir, existing) {
+        if (!required.contains(elementDir)) {
+            actions.insert(elementDir, Change::Action::Remove);
+        }
+    }
+
+    QList<Change> changes;
+    for (auto it = actions.constBegin(); it != actions.constEnd(); ++it) {
+        if (!dryRun) {
+            FilePath dest = libDir.getPathTo(it.key());
+            if (it.value() != Change::Action::Add) {
+                FileUtils::removeDirRecursively(dest); // can throw
+            }
+            if (it.value() != Change::Action::Remove) {
+                FileUtils::copyDirRecursively(required.value(it.key()), dest); // can throw
+            }
+        }
+        changes.append(Change{it.value(), it.key()});
+    }
+    return changes;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QString ProjectLibraryUpdater::actionToString(Change::Action action) noexcept
+{
+    switch (action)
+    {
+        case Change::Action::Add:       return QString("add");
+        case Change::Action::Update:    return QString("update");
+        case Change::Action::Remove:    return QString("remove");
+        default: Q_ASSERT(false);       return QString();
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QMap<QString, FilePath> ProjectLibraryUpdater::getRequiredElements(const FilePath& project)
+{
+    const WorkspaceLibraryDb& db = mWorkspace.getLibraryDb();
+    QMap<QString, FilePath> elements; // key: directory relative to the project library
+
+    // components & symbols
+    SmartXmlFile circuitFile(project.getParentDir().getPathTo("core/circuit.xml"), false, true);
+    std::unique_ptr<DomDocument> circuitDoc = circuitFile.parseFileAndBuildDomTree(); // can throw
+    QSet<Uuid> cmpUuids;
+    foreach (DomElement* node, circuitDoc->getRoot().getChilds("component")) {
+        cmpUuids.insert(node->getAttribute<Uuid>("component", true)); // can throw
+    }
+    QHash<Uuid, FilePath> cmpDirs = db.getLatestElements<Component>(cmpUuids); // can throw
+    QSet<Uuid> symUuids;
+    foreach (const Uuid& cmpUuid, cmpUuids) {
+        FilePath cmpDir = requireElement(cmpDirs.value(cmpUuid), "component", cmpUuid); // can throw
+        elements.insert("cmp/" % cmpDir.getFilename(), cmpDir);
+        std::shared_ptr<const Component> component =
+            mWorkspace.getLibraryElementCache().getElement<Component>(cmpDir); // can throw
+        for (const ComponentSymbolVariant& symbvar : component->getSymbolVariants()) {
+            symUuids.unite(symbvar.getAllSymbolUuids());
+        }
+    }
+    QHash<Uuid, FilePath> symDirs = db.getLatestElements<Symbol>(symUuids); // can throw
+    foreach (const Uuid& symUuid, symUuids) {
+        FilePath symDir = requireElement(symDirs.value(symUuid), "symbol", symUuid); // can throw
+        elements.insert("sym/" % symDir.getFilename(), symDir);
+    }
+
+    // devices & packages
+    SmartXmlFile projectFile(project, false, true);
+    std::unique_ptr<DomDocument> projectDoc = projectFile.parseFileAndBuildDomTree(); // can throw
+    QSet<Uuid> devUuids;
+    foreach (DomElement* boardNode, projectDoc->getRoot().getChilds("board")) {
+        FilePath boardFp = project.getParentDir().getPathTo("boards/" % boardNode->getText<QString>(true));
+        SmartXmlFile boardFile(boardFp, false, true);
+        std::unique_ptr<DomDocument> boardDoc = boardFile.parseFileAndBuildDomTree(); // can throw
+        foreach (DomElement* node, boardDoc->getRoot().getChilds("device")) {
+            devUuids.insert(node->getAttribute<Uuid>("device", true)); // can throw
+        }
+    }
+    QHash<Uuid, FilePath> devDirs = db.getLatestElements<Device>(devUuids); // can throw
+    foreach (const Uuid& devUuid, devUuids) {
+        FilePath devDir = requireElement(devDirs.value(devUuid), "device", devUuid); // can throw
+        elements.insert("dev/" % devDir.getFilename(), devDir);
+    }
+    QSet<Uuid> pkgUuids;
+    foreach (const Uuid& pkgUuid, db.getDeviceMetadata(devDirs.values())) { // can throw
+        pkgUuids.insert(pkgUuid);
+    }
+    QHash<Uuid, FilePath> pkgDirs = db.getLatestElements<Package>(pkgUuids); // can throw
+    foreach (const Uuid& pkgUuid, pkgUuids) {
+        FilePath pkgDir = requireElement(pkgDirs.value(pkgUuid), "package", pkgUuid); // can throw
+        elements.insert("pkg/" % pkgDir.getFilename(), pkgDir);
+    }
+    return elements;
+}
+
+FilePath ProjectLibraryUpdater::requireElement(const FilePath& dir, const QString& type,
+                                               const Uuid& uuid)
+{
+    if (!dir.isExistingDir()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Missing %1: %2")).arg(type, uuid.toStr()));
+    }
+    return dir;
+}
+
+QStringList ProjectLibraryUpdater::getExistingElements(const FilePath& libDir) noexcept
+{
+    QStringList elements;
+    foreach (const QString& type, QStringList{"cmp", "sym", "dev", "pkg"}) {
+        QDir dir(libDir.getPathTo(type).toStr());
+        foreach (const QString& name, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            elements.append(type % "/" % name);
+        }
+    }
+    return elements;
+}
+
+bool ProjectLibraryUpdater::isDirEqual(const FilePath& dir1, const FilePath& dir2) noexcept
+{
+    auto getFiles = [](const FilePath& dir) {
+        QStringList files;
+        QDirIterator it(dir.toStr(), QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            files.append(FilePath(it.next()).toRelative(dir));
+        }
+        files.sort();
+        return files;
+    };
+
+    QStringList files = getFiles(dir1);
+    if (files != getFiles(dir2)) {
+        return false;
+    }
+    try {
+        foreach (const QString& file, files) {
+            if (FileUtils::readFile(dir1.getPathTo(file)) != FileUtils::readFile(dir2.getPathTo(file))) {
+                return false;
+            }
+        }
+    } catch (const Exception&) {
+        return false; // if in doubt, the element is updated
+    }
+    return true;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
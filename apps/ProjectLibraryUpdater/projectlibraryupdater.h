@@ -0,0 +1,148 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROJECTLIBRARYUPDATER_H
+#define PROJECTLIBRARYUPDATER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace library {
+class Component;
+}
+
+namespace workspace {
+class Workspace;
+}
+
+/*****************************************************************************************
+ *  Class ProjectLibraryUpdater
+ ****************************************************************************************/
+
+/**
+ * @brief The ProjectLibraryUpdater class updates the library elements of projects to
+ *        the latest versions available in a workspace
+ *
+ * The projects are processed concurrently in a thread pool. All library elements which
+ * need to be parsed (only components, to get their symbols) are shared between all
+ * projects, so each of them is loaded only once even if it is used in many projects.
+ *
+ * Instead of replacing the whole project library, only the differences are applied:
+ * missing elements are added, elements whose files differ from the latest version are
+ * replaced and elements which are no longer used are removed. In dry-run mode, these
+ * changes are only determined but not applied.
+ */
+class ProjectLibraryUpdater final
+{
+        Q_DECLARE_TR_FUNCTIONS(ProjectLibraryUpdater)
+
+    public:
+
+        // Types
+        struct Change {
+            enum class Action {Add, Update, Remove};
+            Action action;
+            QString elementDir;     ///< relative to the project library, e.g. "cmp/<uuid>"
+        };
+        struct Result {
+            FilePath project;       ///< the *.lpp file
+            QList<Change> changes;  ///< sorted by #Change::elementDir
+            QString error;          ///< empty on success
+        };
+
+        // Constructors / Destructor
+        ProjectLibraryUpdater() = delete;
+        ProjectLibraryUpdater(const ProjectLibraryUpdater& other) = delete;
+        explicit ProjectLibraryUpdater(const workspace::Workspace& workspace) noexcept;
+        ~ProjectLibraryUpdater() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Update the libraries of several projects concurrently
+         *
+         * Errors are not thrown but reported in the results, so a failed project does
+         * not abort updating the others.
+         *
+         * @param projects  The *.lpp files of the projects to update
+         * @param dryRun    If true, the projects are not modified
+         *
+         * @return One result per project (in the same order as the passed projects)
+         */
+        QList<Result> update(const QList<FilePath>& projects, bool dryRun) noexcept;
+
+        /**
+         * @brief Update the library of a single project
+         *
+         * This method is thread-safe.
+         *
+         * @param project   The *.lpp file of the project to update
+         * @param dryRun    If true, the project is not modified
+         *
+         * @return The applied (or in dry-run mode, the required) changes
+         *
+         * @throw Exception if a required library element is missing or the project
+         *                  could not be read or modified
+         */
+        QList<Change> updateProject(const FilePath& project, bool dryRun);
+
+        // Static Methods
+        static QString actionToString(Change::Action action) noexcept;
+
+        // Operator Overloadings
+        ProjectLibraryUpdater& operator=(const ProjectLibraryUpdater& rhs) = delete;
+
+
+    private:
+
+        // Private Types
+        class ProjectJob;
+
+        // Private Methods
+        QMap<QString, FilePath> getRequiredElements(const FilePath& project);
+
+        // Static Methods
+        static FilePath requireElement(const FilePath& dir, const QString& type,
+                                       const Uuid& uuid);
+        static QStringList getExistingElements(const FilePath& libDir) noexcept;
+        static bool isDirEqual(const FilePath& dir1, const FilePath& dir2) noexcept;
+
+
+        // Private Member Variables
+        const workspace::Workspace& mWorkspace;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // PROJECTLIBRARYUPDATER_H
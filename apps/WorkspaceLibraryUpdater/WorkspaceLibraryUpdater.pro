@@ -38,10 +38,12 @@ PRE_TARGETDEPS += \
     $${DESTDIR}/liblibrepcbcommon.a
 
 SOURCES += \
+    libraryelementupdater.cpp \
     main.cpp \
     mainwindow.cpp \
 
 HEADERS += \
+    libraryelementupdater.h \
     mainwindow.h \
 
 FORMS += \
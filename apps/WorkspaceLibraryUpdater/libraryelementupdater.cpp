@@ -0,0 +1,208 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "libraryelementupdater.h"
+#include <librepcb/common/application.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/domelement.h>
+#include <librepcb/library/elements.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+using namespace library;
+
+/*****************************************************************************************
+ *  Class LibraryElementUpdater::ElementJob
+ ****************************************************************************************/
+
+/**
+ * @brief Updates a single library element in a thread pool worker
+ *
+ * Exceptions are not propagated to the thread pool, the error message is stored in the
+ * result instead (which must not be accessed until the pool has finished).
+ */
+class LibraryElementUpdater::ElementJob final : public QRunnable
+{
+    public:
+        ElementJob(UpdateFunction function, bool dryRun, Result& result) noexcept :
+            mFunction(function), mDryRun(dryRun), mResult(result)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            QElapsedTimer timer;
+            timer.start();
+            try {
+                bool changed = mFunction(mResult.directory, mDryRun); // can throw
+                mResult.status = changed ? Result::Status::Changed : Result::Status::Unchanged;
+            } catch (const Exception& e) {
+                mResult.status = Result::Status::Failed;
+                mResult.error = e.getMsg();
+            }
+            mResult.elapsedUs = timer.nsecsElapsed() / 1000;
+        }
+
+    private:
+        UpdateFunction mFunction;
+        bool mDryRun;
+        Result& mResult;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+LibraryElementUpdater::LibraryElementUpdater() noexcept
+{
+}
+
+LibraryElementUpdater::~LibraryElementUpdater() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QList<LibraryElementUpdater::Result> LibraryElementUpdater::update(const FilePath& libDir,
+        const QStringList& types, bool dryRun) noexcept
+{
+    // collect all elements first, so the results can be stored in place
+    QVector<Result> results;
+    QVector<UpdateFunction> functions;
+    auto addElements = [&](const QString& type, const QList<FilePath>& dirs,
+                           UpdateFunction function) {
+        if ((!types.isEmpty()) && (!types.contains(type))) {
+            return;
+        }
+        QList<FilePath> sorted = dirs;
+        std::sort(sorted.begin(), sorted.end(), [](const FilePath& a, const FilePath& b) {
+            return a.toStr() < b.toStr();
+        });
+        foreach (const FilePath& dir, sorted) {
+            results.append(Result{dir, type, Result::Status::Unchanged, 0, QString()});
+            functions.append(function);
+        }
+    };
+    addElements(Library::getShortElementName(), {libDir},
+                &updateElement<Library>);
+    addElements(ComponentCategory::getShortElementName(),
+                Library::searchForElements<ComponentCategory>(libDir),
+                &updateElement<ComponentCategory>);
+    addElements(PackageCategory::getShortElementName(),
+                Library::searchForElements<PackageCategory>(libDir),
+                &updateElement<PackageCategory>);
+    addElements(Symbol::getShortElementName(), Library::searchForElements<Symbol>(libDir),
+                &updateElement<Symbol>);
+    addElements(Package::getShortElementName(), Library::searchForElements<Package>(libDir),
+                &updateElement<Package>);
+    addElements(Component::getShortElementName(),
+                Library::searchForElements<Component>(libDir),
+                &updateElement<Component>);
+    addElements(Device::getShortElementName(), Library::searchForElements<Device>(libDir),
+                &updateElement<Device>);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+    for (int i = 0; i < results.count(); ++i) {
+        if (results.at(i).directory.getBasename() == "00000000-0000-4001-8000-000000000000") {
+            // ignore demo files as they contain documentation which would be removed
+            results[i].status = Result::Status::Ignored;
+            continue;
+        }
+        pool.start(new ElementJob(functions.at(i), dryRun, results[i]));
+    }
+    pool.waitForDone();
+    return results.toList();
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QStringList LibraryElementUpdater::getAllTypes() noexcept
+{
+    return QStringList{Library::getShortElementName(),
+                       ComponentCategory::getShortElementName(),
+                       PackageCategory::getShortElementName(),
+                       Symbol::getShortElementName(),
+                       Package::getShortElementName(),
+                       Component::getShortElementName(),
+                       Device::getShortElementName()};
+}
+
+QString LibraryElementUpdater::statusToString(Result::Status status, bool dryRun) noexcept
+{
+    switch (status)
+    {
+        case Result::Status::Unchanged: return QString("unchanged");
+        case Result::Status::Changed:   return dryRun ? QString("would change") : QString("changed");
+        case Result::Status::Ignored:   return QString("ignored");
+        case Result::Status::Failed:    return QString("ERROR");
+        default: Q_ASSERT(false);       return QString();
+    }
+}
+
+template <typename ElementType>
+bool LibraryElementUpdater::updateElement(const FilePath& dir, bool dryRun)
+{
+    // load (read-only, the files are written below) and serialize the element, which
+    // also validates all attributes
+    ElementType element(dir, true); // can throw
+    QScopedPointer<DomElement> root(element.serializeToDomElement(
+        ElementType::getLongElementName())); // can throw
+    DomDocument doc(*root.take());
+
+    // the same files as written by librepcb::library::LibraryBaseElement::save()
+    QByteArray version = QString("%1\n").arg(qApp->getFileFormatVersion().toStr()).toUtf8();
+    bool xmlChanged = updateFile(dir.getPathTo(ElementType::getLongElementName() % ".xml"),
+                                 doc.toByteArray(), dryRun); // can throw
+    bool versionChanged = updateFile(dir.getPathTo(".librepcb-" % ElementType::getShortElementName()),
+                                     version, dryRun); // can throw
+    return xmlChanged || versionChanged;
+}
+
+bool LibraryElementUpdater::updateFile(const FilePath& filepath, const QByteArray& content,
+                                       bool dryRun)
+{
+    if (filepath.isExistingFile() && (FileUtils::readFile(filepath) == content)) { // can throw
+        return false;
+    }
+    if (!dryRun) {
+        FileUtils::writeFile(filepath, content); // can throw
+    }
+    return true;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,117 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBRARYELEMENTUPDATER_H
+#define LIBRARYELEMENTUPDATER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class LibraryElementUpdater
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryElementUpdater class loads, validates and re-serializes all elements
+ *        of a library to upgrade them to the current file format
+ *
+ * The elements are processed concurrently in a thread pool. Every element is loaded
+ * (read-only) and serialized again, which also validates its attributes. Only files
+ * whose serialized content differs from the existing file are written, so unchanged
+ * elements keep their files (and timestamps) untouched.
+ *
+ * The time needed to process each element is measured to find elements which are slow
+ * to load or save (e.g. huge footprints).
+ */
+class LibraryElementUpdater final
+{
+        Q_DECLARE_TR_FUNCTIONS(LibraryElementUpdater)
+
+    public:
+
+        // Types
+        struct Result {
+            enum class Status {Unchanged, Changed, Ignored, Failed};
+            FilePath directory;     ///< the element directory
+            QString type;           ///< short element name, e.g. "cmp"
+            Status status;
+            qint64 elapsedUs;       ///< processing time in microseconds
+            QString error;          ///< only if Status::Failed
+        };
+
+        // Constructors / Destructor
+        LibraryElementUpdater(const LibraryElementUpdater& other) = delete;
+        LibraryElementUpdater() noexcept;
+        ~LibraryElementUpdater() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Update all elements of a library concurrently
+         *
+         * @param libDir    The library directory
+         * @param types     Short names of the element types to update (e.g. "lib",
+         *                  "cmpcat", "sym"); all types if empty
+         * @param dryRun    If true, nothing is written but the results report which
+         *                  elements would change
+         *
+         * @return The results of all elements (library first, then ordered by type and
+         *         directory)
+         */
+        QList<Result> update(const FilePath& libDir, const QStringList& types,
+                             bool dryRun) noexcept;
+
+        // Static Methods
+        static QStringList getAllTypes() noexcept;
+        static QString statusToString(Result::Status status, bool dryRun) noexcept;
+
+        // Operator Overloadings
+        LibraryElementUpdater& operator=(const LibraryElementUpdater& rhs) = delete;
+
+
+    private:
+
+        // Private Types
+        typedef bool (*UpdateFunction)(const FilePath& dir, bool dryRun);
+        class ElementJob;
+
+        // Static Methods
+        template <typename ElementType>
+        static bool updateElement(const FilePath& dir, bool dryRun);
+        static bool updateFile(const FilePath& filepath, const QByteArray& content,
+                               bool dryRun);
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBRARYELEMENTUPDATER_H
@@ -24,21 +24,140 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/application.h>
+#include "libraryelementupdater.h"
 #include "mainwindow.h"
 
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+using namespace librepcb;
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static int runHeadless(const QStringList& libDirs, const QStringList& types, bool dryRun,
+                       int slowestCount);
+
 /*****************************************************************************************
  *  main()
  ****************************************************************************************/
 
 int main(int argc, char* argv[])
 {
-    librepcb::Application app(argc, argv);
+    // Without libraries on the command line, the GUI is shown. Otherwise no windows
+    // are shown at all, so run without a display unless another platform plugin is
+    // explicitly requested.
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        QByteArray arg(argv[i]);
+        if ((arg == "-t") || (arg == "--type") || (arg == "--slowest")) {
+            ++i; // skip the value of the option
+        } else if (!arg.startsWith("-")) {
+            headless = true;
+        }
+    }
+    if (headless && qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv);
 
     QCoreApplication::setOrganizationName("LibrePCB");
     QCoreApplication::setApplicationName("WorkspaceLibraryUpdater");
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Validate all elements of LibrePCB libraries and save "
+                                     "them in the current file format. Without libraries, "
+                                     "the graphical user interface is shown.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("libraries", "Paths to the library directories.",
+                                 "[libraries...]");
+    QCommandLineOption typeOption(QStringList() << "t" << "type",
+        QString("Element type to update (may be given multiple times): %1. Default: all.")
+        .arg(LibraryElementUpdater::getAllTypes().join(", ")), "type");
+    QCommandLineOption dryRunOption(QStringList() << "n" << "dry-run",
+        "Only report which elements would change, but do not write any files.");
+    QCommandLineOption slowestOption("slowest",
+        "Count of the slowest elements to list at the end. Default: 10.", "count", "10");
+    parser.addOption(typeOption);
+    parser.addOption(dryRunOption);
+    parser.addOption(slowestOption);
+    parser.process(app);
+
+    if (!parser.positionalArguments().isEmpty()) {
+        return runHeadless(parser.positionalArguments(), parser.values(typeOption),
+                           parser.isSet(dryRunOption), parser.value(slowestOption).toInt());
+    }
+
     MainWindow w;
     w.show();
 
     return QApplication::exec();
 }
+
+/*****************************************************************************************
+ *  runHeadless()
+ ****************************************************************************************/
+
+static int runHeadless(const QStringList& libDirs, const QStringList& types, bool dryRun,
+                       int slowestCount)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    foreach (const QString& type, types) {
+        if (!LibraryElementUpdater::getAllTypes().contains(type)) {
+            err << QString("Unknown element type: \"%1\"").arg(type) << endl;
+            return 1;
+        }
+    }
+
+    LibraryElementUpdater updater;
+    QList<LibraryElementUpdater::Result> results;
+    foreach (const QString& libDir, libDirs) {
+        FilePath fp(QFileInfo(libDir).absoluteFilePath());
+        if (!fp.isExistingDir()) {
+            err << QString("Library directory not found: \"%1\"").arg(fp.toNative()) << endl;
+            return 1;
+        }
+        results.append(updater.update(fp, types, dryRun));
+    }
+
+    // per-element report
+    QMap<LibraryElementUpdater::Result::Status, int> counts;
+    foreach (const LibraryElementUpdater::Result& result, results) {
+        counts[result.status]++;
+        QString line = QString("%1 %2 ms %3").arg(
+            LibraryElementUpdater::statusToString(result.status, dryRun), -12)
+            .arg(result.elapsedUs / 1000.0, 9, 'f', 1).arg(result.directory.toNative());
+        if (result.status == LibraryElementUpdater::Result::Status::Failed) {
+            err << line << endl << "  " << result.error << endl;
+        } else {
+            out << line << endl;
+        }
+    }
+
+    // the slowest elements, to find pathological ones
+    QList<LibraryElementUpdater::Result> sorted = results;
+    std::sort(sorted.begin(), sorted.end(), [](const LibraryElementUpdater::Result& a,
+                                               const LibraryElementUpdater::Result& b) {
+        return a.elapsedUs > b.elapsedUs;
+    });
+    if ((slowestCount > 0) && (!sorted.isEmpty())) {
+        out << endl << "Slowest elements:" << endl;
+        for (int i = 0; i < qMin(slowestCount, sorted.count()); ++i) {
+            out << QString("  %1 ms %2").arg(sorted.at(i).elapsedUs / 1000.0, 9, 'f', 1)
+                   .arg(sorted.at(i).directory.toNative()) << endl;
+        }
+    }
+
+    out << endl << QString("%1 elements: %2 %3, %4 unchanged, %5 ignored, %6 errors")
+           .arg(results.count())
+           .arg(counts.value(LibraryElementUpdater::Result::Status::Changed))
+           .arg(dryRun ? "would change" : "changed")
+           .arg(counts.value(LibraryElementUpdater::Result::Status::Unchanged))
+           .arg(counts.value(LibraryElementUpdater::Result::Status::Ignored))
+           .arg(counts.value(LibraryElementUpdater::Result::Status::Failed)) << endl;
+    return (counts.value(LibraryElementUpdater::Result::Status::Failed) > 0) ? 1 : 0;
+}
@@ -2,11 +2,9 @@
 #include <QtWidgets>
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
-#include <librepcb/common/fileio/smartxmlfile.h>
-#include <librepcb/common/fileio/domdocument.h>
-#include <librepcb/common/fileio/domelement.h>
-#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include "libraryelementupdater.h"
 #include <librepcb/library/elements.h>
+#include <librepcb/library/libraryindex.h>
 
 using namespace librepcb;
 using namespace librepcb::library;
@@ -28,6 +26,7 @@ MainWindow::MainWindow(QWidget *parent) :
     ui->cbx_pkg->setChecked(s.value("mainwindow/cbx_pkg", true).toBool());
     ui->cbx_cmp->setChecked(s.value("mainwindow/cbx_cmp", true).toBool());
     ui->cbx_dev->setChecked(s.value("mainwindow/cbx_dev", true).toBool());
+    ui->cbx_index->setChecked(s.value("mainwindow/cbx_index", false).toBool());
 
     if (ui->libDirs->count() > 0) lastDir = ui->libDirs->item(ui->libDirs->count()-1)->text();
 }
@@ -50,6 +49,7 @@ MainWindow::~MainWindow()
     s.setValue("mainwindow/cbx_pkg", ui->cbx_pkg->isChecked());
     s.setValue("mainwindow/cbx_cmp", ui->cbx_cmp->isChecked());
     s.setValue("mainwindow/cbx_dev", ui->cbx_dev->isChecked());
+    s.setValue("mainwindow/cbx_index", ui->cbx_index->isChecked());
 
     delete ui;
 }
@@ -85,58 +85,56 @@ void MainWindow::on_updateBtn_clicked()
     if (ui->libDirs->count() == 0) return;
     ui->log->clear();
 
-    elementCount = 0;
-    ignoreCount = 0;
-    errorCount = 0;
+    QStringList types;
+    if (ui->cbx_lplib->isChecked()) types.append(Library::getShortElementName());
+    if (ui->cbx_cmpcat->isChecked()) types.append(ComponentCategory::getShortElementName());
+    if (ui->cbx_pkgcat->isChecked()) types.append(PackageCategory::getShortElementName());
+    if (ui->cbx_sym->isChecked()) types.append(Symbol::getShortElementName());
+    if (ui->cbx_pkg->isChecked()) types.append(Package::getShortElementName());
+    if (ui->cbx_cmp->isChecked()) types.append(Component::getShortElementName());
+    if (ui->cbx_dev->isChecked()) types.append(Device::getShortElementName());
+    if (types.isEmpty() && (!ui->cbx_index->isChecked())) return;
+
+    int elementCount = 0;
+    int ignoreCount = 0;
+    int errorCount = 0;
+    LibraryElementUpdater updater;
+    QApplication::setOverrideCursor(Qt::WaitCursor);
     for (int i = 0; i < ui->libDirs->count(); i++)
     {
-        QString dirStr = ui->libDirs->item(i)->text();
-
-        try
-        {
-            library::Library lib(FilePath(dirStr), false);
-
-            if (ui->cbx_cmpcat->isChecked()) updateElements<ComponentCategory>(lib);
-            if (ui->cbx_pkgcat->isChecked()) updateElements<PackageCategory>(lib);
-            if (ui->cbx_sym->isChecked()) updateElements<Symbol>(lib);
-            if (ui->cbx_pkg->isChecked()) updateElements<Package>(lib);
-            if (ui->cbx_cmp->isChecked()) updateElements<Component>(lib);
-            if (ui->cbx_dev->isChecked()) updateElements<Device>(lib);
-
-            if (ui->cbx_lplib->isChecked()) {
-                lib.save();
-                elementCount++;
+        FilePath libDir(ui->libDirs->item(i)->text());
+        foreach (const LibraryElementUpdater::Result& result, updater.update(libDir, types, false)) {
+            switch (result.status)
+            {
+                case LibraryElementUpdater::Result::Status::Ignored:
+                    ignoreCount++;
+                    break;
+                case LibraryElementUpdater::Result::Status::Failed:
+                    ui->log->addItem("ERROR: " % result.error);
+                    errorCount++;
+                    break;
+                default:
+                    ui->log->addItem(QString("%1: %2").arg(
+                        LibraryElementUpdater::statusToString(result.status, false),
+                        result.directory.toNative()));
+                    elementCount++;
+                    break;
             }
         }
-        catch (Exception& e)
-        {
-            ui->log->addItem("ERROR: " % e.getMsg());
-            errorCount++;
+        // the index must be generated after updating the elements to get valid hashes
+        if (ui->cbx_index->isChecked()) {
+            try {
+                LibraryIndex::create(libDir).save(); // can throw
+                ui->log->addItem("INDEX GENERATED: " % libDir.toNative());
+            } catch (const Exception& e) {
+                ui->log->addItem("ERROR: " % e.getMsg());
+                errorCount++;
+            }
         }
     }
+    QApplication::restoreOverrideCursor();
 
     ui->log->addItem(QString("FINISHED: %1 updated, %2 ignored, %3 errors")
                      .arg(elementCount).arg(ignoreCount).arg(errorCount));
     ui->log->setCurrentRow(ui->log->count()-1);
 }
-
-template <typename ElementType>
-void MainWindow::updateElements(const library::Library& lib) noexcept
-{
-    foreach (const FilePath& fp, lib.searchForElements<ElementType>()) {
-        if (fp.getBasename() == "00000000-0000-4001-8000-000000000000") {
-            // ignore demo files as they contain documentation which would be removed
-            ignoreCount++;
-            continue;
-        }
-        try {
-            ElementType element(fp, false);
-            element.save();
-            ui->log->addItem(fp.toNative());
-            elementCount++;
-        } catch (const Exception& e) {
-            ui->log->addItem("ERROR: " % e.getMsg());
-            errorCount++;
-        }
-    }
-}
@@ -9,16 +9,6 @@ namespace Ui {
 class MainWindow;
 }
 
-namespace librepcb {
-
-class DomElement;
-
-namespace library {
-class Library;
-}
-
-}
-
 class MainWindow : public QMainWindow
 {
         Q_OBJECT
@@ -37,15 +27,9 @@ class MainWindow : public QMainWindow
 
     private:
 
-        template <typename ElementType>
-        void updateElements(const librepcb::library::Library& lib) noexcept;
-
         // Attributes
         Ui::MainWindow *ui;
         QString lastDir;
-        int elementCount;
-        int ignoreCount;
-        int errorCount;
 };
 
 #endif // MAINWINDOW_H
@@ -2,7 +2,10 @@ TEMPLATE = subdirs
 
 SUBDIRS = \
     librepcb \
+    CamDiff \
+    CamExport \
     EagleImport \
+    ProjectGenerator \
     ProjectLibraryUpdater \
     UuidGenerator \
     WorkspaceLibraryUpdater
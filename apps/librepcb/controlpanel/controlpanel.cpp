@@ -28,6 +28,7 @@
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/project/project.h>
+#include <librepcb/project/projectarchive.h>
 #include <librepcb/workspace/projecttreemodel.h>
 #include <librepcb/workspace/projecttreeitem.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
@@ -37,7 +38,6 @@
 #include <librepcb/projecteditor/projecteditor.h>
 #include <librepcb/projecteditor/newprojectwizard/newprojectwizard.h>
 #include <librepcb/common/application.h>
-#include "../markdown/markdownconverter.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -55,8 +55,7 @@ using namespace workspace;
  ****************************************************************************************/
 
 ControlPanel::ControlPanel(Workspace& workspace) :
-    QMainWindow(nullptr), mWorkspace(workspace), mUi(new Ui::ControlPanel),
-    mLibraryManager(new LibraryManager(mWorkspace, this))
+    QMainWindow(nullptr), mWorkspace(workspace), mUi(new Ui::ControlPanel)
 {
     mUi->setupUi(this);
 
@@ -78,13 +77,12 @@ ControlPanel::ControlPanel(Workspace& workspace) :
     connect(&mWorkspace.getLibraryDb(), &WorkspaceLibraryDb::scanProgressUpdate,
             mUi->statusBar, &StatusBar::setProgressBarPercent, Qt::QueuedConnection);
 
-    // decive if we have to show the warning about a newer workspace file format version
-    Version actualVersion = qApp->getFileFormatVersion();
-    Version highestVersion = Workspace::getHighestFileFormatVersionOfWorkspace(workspace.getPath());
-    mUi->lblWarnForNewerAppVersions->setVisible(highestVersion > actualVersion);
+    // the warning about a newer workspace file format version is shown later, if needed
+    mUi->lblWarnForNewerAppVersions->setVisible(false);
 
     // decide if we have to show the warning about missing workspace libraries
-    if (mWorkspace.getLocalLibraries().isEmpty() && mWorkspace.getRemoteLibraries().isEmpty()) {
+    if (mWorkspace.getLocalLibraryDirectories().isEmpty() &&
+        mWorkspace.getRemoteLibraryDirectories().isEmpty()) {
         mUi->lblWarnForNoLibraries->setVisible(true);
         connect(&mWorkspace, &Workspace::libraryAdded,
                 mUi->lblWarnForNoLibraries, &QLabel::hide);
@@ -101,8 +99,9 @@ ControlPanel::ControlPanel(Workspace& workspace) :
             qApp, &QApplication::aboutQt);
     connect(mUi->actionWorkspace_Settings, &QAction::triggered,
             &mWorkspace.getSettings(), &WorkspaceSettings::showSettingsDialog);
-    connect(mLibraryManager.data(), &LibraryManager::openLibraryEditorTriggered,
-            this, &ControlPanel::openLibraryEditor);
+
+    connect(&mReadmeRenderer, &MarkdownPreviewRenderer::htmlReady,
+            this, &ControlPanel::readmeHtmlReady, Qt::QueuedConnection);
 
     mUi->projectTreeView->setModel(&mWorkspace.getProjectTreeModel());
     mUi->recentProjectsListView->setModel(&mWorkspace.getRecentProjectsModel());
@@ -110,16 +109,13 @@ ControlPanel::ControlPanel(Workspace& workspace) :
 
     loadSettings();
 
-    // parse command line arguments and open all project files
-    foreach (const QString& arg, qApp->arguments())
-    {
-        FilePath filepath(arg);
-        if ((filepath.isExistingFile()) && (filepath.getSuffix() == "lpp"))
-            openProject(filepath);
-    }
-
-    // start scanning the workspace library (asynchronously)
-    mWorkspace.getLibraryDb().startLibraryRescan();
+    // everything which is not needed to show the window is done as soon as the event
+    // loop is running, i.e. after the window has been painted the first time
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+    QTimer::singleShot(0, this, &ControlPanel::initializeDeferred);
+#else
+    QTimer::singleShot(0, this, SLOT(initializeDeferred()));
+#endif
 }
 
 ControlPanel::~ControlPanel()
@@ -187,6 +183,10 @@ void ControlPanel::saveSettings()
                             .toRelative(mWorkspace.getPath()));
             }
         }
+        foreach (const QString& item, mProjectTreeItemsToExpand)
+        {
+            list.append(FilePath(item).toRelative(mWorkspace.getPath()));
+        }
         clientSettings.setValue("expanded_projecttreeview_items", QVariant::fromValue(list));
     }
 
@@ -204,7 +204,8 @@ void ControlPanel::loadSettings()
     mUi->splitter_h->restoreState(clientSettings.value("splitter_h_state").toByteArray());
     mUi->splitter_v->restoreState(clientSettings.value("splitter_v_state").toByteArray());
 
-    // projects treeview (expanded items)
+    // projects treeview (expanded items, they are expanded as soon as they are loaded
+    // because the project tree model loads its items asynchronously)
     ProjectTreeModel* model = dynamic_cast<ProjectTreeModel*>(mUi->projectTreeView->model());
     if (model)
     {
@@ -212,28 +213,63 @@ void ControlPanel::loadSettings()
         foreach (QString item, list)
         {
             FilePath filepath = FilePath::fromRelative(mWorkspace.getPath(), item);
-            QModelIndexList items = model->match(model->index(0, 0), Qt::UserRole,
-                QVariant::fromValue(filepath.toStr()), 1,
-                Qt::MatchFlags(Qt::MatchExactly | Qt::MatchWrap | Qt::MatchRecursive));
-            if (!items.isEmpty())
-                mUi->projectTreeView->setExpanded(items.first(), true);
+            mProjectTreeItemsToExpand.insert(filepath.toStr());
         }
+        connect(model, &QAbstractItemModel::rowsInserted,
+                this, &ControlPanel::expandRestoredProjectTreeItems);
+        if (model->rowCount() > 0)
+            expandRestoredProjectTreeItems(QModelIndex(), 0, model->rowCount() - 1);
     }
 
     clientSettings.endGroup();
 }
 
+void ControlPanel::expandRestoredProjectTreeItems(const QModelIndex& parent, int first,
+                                                  int last) noexcept
+{
+    if (mProjectTreeItemsToExpand.isEmpty()) return;
+    QAbstractItemModel* model = mUi->projectTreeView->model();
+    for (int i = first; i <= last; ++i) {
+        QModelIndex index = model->index(i, 0, parent);
+        if (mProjectTreeItemsToExpand.remove(index.data(Qt::UserRole).toString())) {
+            mUi->projectTreeView->setExpanded(index, true); // fetches the childs
+        }
+    }
+}
+
 void ControlPanel::showProjectReadmeInBrowser(const FilePath& projectFilePath) noexcept
 {
     if (projectFilePath.isValid()) {
         FilePath readmeFilePath = projectFilePath.getParentDir().getPathTo("README.md");
+        if (readmeFilePath == mShownReadmeFilePath) {
+            mReadmeRenderer.requestHtml(readmeFilePath); // check for modifications
+            return;
+        }
+        // show the cached HTML immediately (if any), the worker updates it if outdated
+        QString html;
+        mReadmeRenderer.getCachedHtml(readmeFilePath, html);
+        mShownReadmeFilePath = readmeFilePath;
+        mShownReadmeHtml = html;
         mUi->textBrowser->setSearchPaths(QStringList(projectFilePath.getParentDir().toStr()));
-        mUi->textBrowser->setHtml(MarkdownConverter::convertMarkdownToHtml(readmeFilePath));
+        mUi->textBrowser->setHtml(html);
+        mReadmeRenderer.requestHtml(readmeFilePath);
     } else {
+        mShownReadmeFilePath = FilePath();
+        mShownReadmeHtml.clear();
         mUi->textBrowser->clear();
     }
 }
 
+void ControlPanel::readmeHtmlReady(const QString& readmeFilePath, const QString& html) noexcept
+{
+    // ignore results of READMEs which are no longer shown and avoid resetting the
+    // scroll position if nothing has changed
+    if ((FilePath(readmeFilePath) == mShownReadmeFilePath) && (html != mShownReadmeHtml)) {
+        mShownReadmeHtml = html;
+        mUi->textBrowser->setHtml(html);
+    }
+}
+
 /*****************************************************************************************
  *  Project Management
  ****************************************************************************************/
@@ -246,6 +282,8 @@ ProjectEditor* ControlPanel::openProject(Project& project) noexcept
         if (!editor) {
             editor = new ProjectEditor(mWorkspace, project);
             connect(editor, &ProjectEditor::projectEditorClosed, this, &ControlPanel::projectEditorClosed);
+            connect(editor, &ProjectEditor::reopenRequested, this,
+                    &ControlPanel::projectEditorReopenRequested, Qt::QueuedConnection);
             connect(editor, &ProjectEditor::showControlPanelClicked, this, &ControlPanel::showControlPanel);
             mOpenProjectEditors.insert(project.getFilepath().toUnique().toStr(), editor);
             mWorkspace.setLastRecentlyUsedProject(project.getFilepath());
@@ -272,9 +310,22 @@ ProjectEditor* ControlPanel::openProject(const FilePath& filepath) noexcept
         ProjectEditor* editor = getOpenProject(filepath);
         if (!editor)
         {
-            Project* project = new Project(filepath, false);
+            // show the progress while opening big projects, and allow to cancel it
+            QProgressDialog progressDialog(tr("Open project..."), tr("Cancel"), 0, 100, this);
+            progressDialog.setWindowTitle(tr("Open Project"));
+            progressDialog.setWindowModality(Qt::ApplicationModal); // avoid reentrance
+            progressDialog.setMinimumDuration(500);
+            auto progress = [&progressDialog](int percent, const QString& status){
+                progressDialog.setLabelText(status);
+                progressDialog.setValue(percent); // processes events (modal dialog)
+                return !progressDialog.wasCanceled();
+            };
+            Project* project = new Project(filepath, false, false, progress);
+            progressDialog.reset();
             editor = new ProjectEditor(mWorkspace, *project);
             connect(editor, &ProjectEditor::projectEditorClosed, this, &ControlPanel::projectEditorClosed);
+            connect(editor, &ProjectEditor::reopenRequested, this,
+                    &ControlPanel::projectEditorReopenRequested, Qt::QueuedConnection);
             connect(editor, &ProjectEditor::showControlPanelClicked, this, &ControlPanel::showControlPanel);
             mOpenProjectEditors.insert(filepath.toUnique().toStr(), editor);
             mWorkspace.setLastRecentlyUsedProject(filepath);
@@ -380,6 +431,32 @@ bool ControlPanel::closeAllLibraryEditors(bool askForSave) noexcept
  *  Private Slots
  ****************************************************************************************/
 
+void ControlPanel::initializeDeferred() noexcept
+{
+    // measure the time of each step to make startup regressions visible
+    QElapsedTimer timer;
+    timer.start();
+
+    // start scanning the workspace library (asynchronously)
+    mWorkspace.getLibraryDb().startLibraryRescan();
+    qDebug() << "Control panel startup: Start library rescan took" << timer.restart() << "ms";
+
+    // decide if we have to show the warning about a newer workspace file format version
+    Version actualVersion = qApp->getFileFormatVersion();
+    Version highestVersion = Workspace::getHighestFileFormatVersionOfWorkspace(mWorkspace.getPath());
+    mUi->lblWarnForNewerAppVersions->setVisible(highestVersion > actualVersion);
+    qDebug() << "Control panel startup: Check file format versions took" << timer.restart() << "ms";
+
+    // parse command line arguments and open all project files
+    foreach (const QString& arg, qApp->arguments())
+    {
+        FilePath filepath(arg);
+        if ((filepath.isExistingFile()) && (filepath.getSuffix() == "lpp"))
+            openProject(filepath);
+    }
+    qDebug() << "Control panel startup: Open projects took" << timer.restart() << "ms";
+}
+
 void ControlPanel::projectEditorClosed() noexcept
 {
     ProjectEditor* editor = dynamic_cast<ProjectEditor*>(QObject::sender());
@@ -390,6 +467,18 @@ void ControlPanel::projectEditorClosed() noexcept
     delete project;
 }
 
+void ControlPanel::projectEditorReopenRequested() noexcept
+{
+    ProjectEditor* editor = dynamic_cast<ProjectEditor*>(QObject::sender());
+    Q_ASSERT(editor); if (!editor) return;
+
+    // the editor is destroyed by closing it, so the filepath must be copied first
+    FilePath filepath = editor->getProject().getFilepath();
+    if (closeProject(*editor, false)) {
+        openProject(filepath);
+    }
+}
+
 /*****************************************************************************************
  *  Actions
  ****************************************************************************************/
@@ -437,8 +526,47 @@ void ControlPanel::on_actionOpen_Project_triggered()
     openProject(filepath);
 }
 
+void ControlPanel::on_actionImport_Project_Archive_triggered()
+{
+    QSettings settings; // client settings
+    QString lastArchive = settings.value("controlpanel/last_project_archive",
+                          mWorkspace.getPath().toStr()).toString();
+
+    FilePath zipFile(QFileDialog::getOpenFileName(this, tr("Import Project Archive"),
+                     lastArchive, tr("Zip archives (%1)").arg("*.zip")));
+    if (!zipFile.isValid())
+        return;
+    settings.setValue("controlpanel/last_project_archive", zipFile.toNative());
+
+    FilePath parentDir(QFileDialog::getExistingDirectory(this, tr("Extract Project To"),
+                       mWorkspace.getProjectsPath().toStr()));
+    if (!parentDir.isValid())
+        return;
+
+    FilePath projectFile;
+    try
+    {
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        projectFile = ProjectArchive::importArchive(zipFile, parentDir); // can throw
+        QApplication::restoreOverrideCursor();
+    }
+    catch (Exception& e)
+    {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::critical(this, tr("Could not import project archive"), e.getMsg());
+        return;
+    }
+    openProject(projectFile);
+}
+
 void ControlPanel::on_actionOpen_Library_Manager_triggered()
 {
+    // the library manager opens all libraries, so it is created only when needed
+    if (!mLibraryManager) {
+        mLibraryManager.reset(new LibraryManager(mWorkspace, this));
+        connect(mLibraryManager.data(), &LibraryManager::openLibraryEditorTriggered,
+                this, &ControlPanel::openLibraryEditor);
+    }
     mLibraryManager->show();
     mLibraryManager->raise();
     mLibraryManager->activateWindow();
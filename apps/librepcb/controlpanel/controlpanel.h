@@ -26,14 +26,14 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include "../markdown/markdownpreviewrenderer.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class FilePath;
-
 namespace library {
 class Library;
 
@@ -99,12 +99,15 @@ class ControlPanel final : public QMainWindow
     private slots:
 
         // private slots
+        void initializeDeferred() noexcept;
         void projectEditorClosed() noexcept;
+        void projectEditorReopenRequested() noexcept;
 
         // Actions
         void on_actionAbout_triggered();
         void on_actionNew_Project_triggered();
         void on_actionOpen_Project_triggered();
+        void on_actionImport_Project_Archive_triggered();
         void on_actionOpen_Library_Manager_triggered();
         void on_actionClose_all_open_projects_triggered();
         void on_actionSwitch_Workspace_triggered();
@@ -132,6 +135,8 @@ class ControlPanel final : public QMainWindow
         void saveSettings();
         void loadSettings();
         void showProjectReadmeInBrowser(const FilePath& projectFilePath) noexcept;
+        void expandRestoredProjectTreeItems(const QModelIndex& parent, int first, int last) noexcept;
+        void readmeHtmlReady(const QString& readmeFilePath, const QString& html) noexcept;
 
         // Project Management
 
@@ -214,6 +219,10 @@ class ControlPanel final : public QMainWindow
         QScopedPointer<library::manager::LibraryManager> mLibraryManager;
         QHash<QString, project::editor::ProjectEditor*> mOpenProjectEditors;
         QHash<library::Library*, library::editor::LibraryEditor*> mOpenLibraryEditors;
+        QSet<QString> mProjectTreeItemsToExpand; ///< restored, but not yet loaded items
+        MarkdownPreviewRenderer mReadmeRenderer;
+        FilePath mShownReadmeFilePath;  ///< the README shown in the browser (may be invalid)
+        QString mShownReadmeHtml;       ///< the HTML shown in the browser
 };
 
 /*****************************************************************************************
@@ -91,6 +91,7 @@ SOURCES += \
     firstrunwizard/firstrunwizardpage_workspacepath.cpp \
     main.cpp \
     markdown/markdownconverter.cpp \
+    markdown/markdownpreviewrenderer.cpp \
 
 HEADERS += \
     controlpanel/controlpanel.h \
@@ -98,6 +99,7 @@ HEADERS += \
     firstrunwizard/firstrunwizardpage_welcome.h \
     firstrunwizard/firstrunwizardpage_workspacepath.h \
     markdown/markdownconverter.h \
+    markdown/markdownpreviewrenderer.h \
 
 FORMS += \
     controlpanel/controlpanel.ui \
@@ -43,6 +43,7 @@ using namespace librepcb::application;
  ****************************************************************************************/
 
 static void setApplicationMetadata() noexcept;
+static void logStartupTiming(QElapsedTimer& timer, const QString& step) noexcept;
 static void writeLogHeader() noexcept;
 static void installTranslations() noexcept;
 static void init3rdPartyLibs() noexcept;
@@ -72,8 +73,13 @@ int main(int argc, char* argv[])
     // Write some information about the application instance to the log.
     writeLogHeader();
 
+    // Measure the time of each startup step to make startup regressions visible.
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     // Install translation files. This must be done before any widget is shown.
     installTranslations();
+    logStartupTiming(startupTimer, "Install translations");
 
     // This is to remove the ugly frames around widgets in all status bars...
     // (from http://www.qtcentre.org/threads/1904)
@@ -82,8 +88,9 @@ int main(int argc, char* argv[])
     // Initialize all 3rd party libraries
     init3rdPartyLibs();
 
-    // Start network access manager thread
+    // Start network access manager thread (does not wait until the thread is running)
     QScopedPointer<NetworkAccessManager> networkAccessManager(new NetworkAccessManager());
+    logStartupTiming(startupTimer, "Start network access manager");
 
     // --------------------------------- OPEN WORKSPACE ----------------------------------
 
@@ -119,6 +126,15 @@ static void setApplicationMetadata() noexcept
     Application::setApplicationName("LibrePCB");
 }
 
+/*****************************************************************************************
+ *  logStartupTiming()
+ ****************************************************************************************/
+
+static void logStartupTiming(QElapsedTimer& timer, const QString& step) noexcept
+{
+    qDebug() << "Application startup:" << step << "took" << timer.restart() << "ms";
+}
+
 /*****************************************************************************************
  *  writeLogHeader()
  ****************************************************************************************/
@@ -223,9 +239,16 @@ static int openWorkspace(const FilePath& path) noexcept
 {
     try
     {
+        QElapsedTimer timer;
+        timer.start();
         Workspace ws(path);   // The Workspace constructor can throw an exception
+        logStartupTiming(timer, "Open workspace");
+
+        // Show the control panel as soon as possible, all remaining initialization steps
+        // are done afterwards in the event loop (see ControlPanel::initializeDeferred()).
         ControlPanel p(ws);
         p.show();
+        logStartupTiming(timer, "Show control panel");
 
         return appExec();
     }
@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "markdownpreviewrenderer.h"
+#include "markdownconverter.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace application {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+MarkdownPreviewRenderer::MarkdownPreviewRenderer() noexcept :
+    QThread(nullptr), mAbort(false), mWorkerActive(false), mCache(sMaxCacheCost)
+{
+}
+
+MarkdownPreviewRenderer::~MarkdownPreviewRenderer() noexcept
+{
+    mAbort = true;
+    if (!wait(2000)) {
+        qWarning() << "Could not abort the markdown renderer thread!";
+        terminate();
+        if (!wait(2000)) {
+            qCritical() << "Could not terminate the markdown renderer thread!";
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool MarkdownPreviewRenderer::getCachedHtml(const FilePath& markdownFile,
+                                            QString& html) const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    const CacheEntry* entry = mCache.object(markdownFile.toStr());
+    if (entry) {
+        html = entry->html;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void MarkdownPreviewRenderer::requestHtml(const FilePath& markdownFile) noexcept
+{
+    bool startWorker = false;
+    {
+        QMutexLocker locker(&mMutex);
+        mRequest = markdownFile;
+        if (!mWorkerActive) {
+            mWorkerActive = true;
+            startWorker = true;
+        }
+    }
+    if (startWorker) {
+        wait(); // the previous run() may not have returned yet
+        start(QThread::LowPriority);
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void MarkdownPreviewRenderer::run() noexcept
+{
+    while (!mAbort) {
+        FilePath filepath;
+        {
+            QMutexLocker locker(&mMutex);
+            if (!mRequest.isValid()) {
+                mWorkerActive = false;
+                return;
+            }
+            filepath = mRequest;
+            mRequest = FilePath();
+        }
+
+        QFileInfo info(filepath.toStr());
+        QDateTime lastModified = info.lastModified();
+        qint64 size = info.exists() ? info.size() : -1;
+        QString html;
+        bool cached = false;
+        {
+            QMutexLocker locker(&mMutex);
+            const CacheEntry* entry = mCache.object(filepath.toStr());
+            if (entry && (entry->lastModified == lastModified) && (entry->size == size)) {
+                html = entry->html;
+                cached = true;
+            }
+        }
+        if (!cached) {
+            if (size >= 0) {
+                html = MarkdownConverter::convertMarkdownToHtml(filepath);
+            }
+            QMutexLocker locker(&mMutex);
+            mCache.insert(filepath.toStr(), new CacheEntry{lastModified, size, html},
+                          qMax(html.length(), 1));
+        }
+        emit htmlReady(filepath.toStr(), html);
+    }
+    QMutexLocker locker(&mMutex);
+    mWorkerActive = false;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace application
+} // namespace librepcb
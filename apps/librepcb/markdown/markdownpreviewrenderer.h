@@ -0,0 +1,130 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBREPCB_MARKDOWNPREVIEWRENDERER_H
+#define LIBREPCB_MARKDOWNPREVIEWRENDERER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace application {
+
+/*****************************************************************************************
+ *  Class MarkdownPreviewRenderer
+ ****************************************************************************************/
+
+/**
+ * @brief The MarkdownPreviewRenderer class converts markdown files to HTML in a
+ *        separate thread and caches the results
+ *
+ * Reading the file and rendering it with the librepcb::application::MarkdownConverter is
+ * done in the worker thread, so even large files or slow network shares do not block
+ * the GUI. Only the most recent request is processed, older requests which were not
+ * started yet are discarded (e.g. when arrowing through the project list).
+ *
+ * The rendered HTML is cached with the modification time and the size of the file, so
+ * a file is only rendered again if it was modified. The cached (maybe outdated) HTML can
+ * be shown immediately with #getCachedHtml() while the worker checks for modifications.
+ */
+class MarkdownPreviewRenderer final : public QThread
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        MarkdownPreviewRenderer() noexcept;
+        MarkdownPreviewRenderer(const MarkdownPreviewRenderer& other) = delete;
+        ~MarkdownPreviewRenderer() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the last rendered HTML of a file without accessing the file system
+         *
+         * @param markdownFile  The markdown file
+         * @param html          The cached HTML (output)
+         *
+         * @return True if the file was rendered before (maybe outdated), false otherwise
+         */
+        bool getCachedHtml(const FilePath& markdownFile, QString& html) const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Request to render a markdown file (the result is reported with
+         *        #htmlReady())
+         *
+         * @param markdownFile  The markdown file to render (replaces pending requests)
+         */
+        void requestHtml(const FilePath& markdownFile) noexcept;
+
+        // Operator Overloadings
+        MarkdownPreviewRenderer& operator=(const MarkdownPreviewRenderer& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief A requested file was rendered (or found unmodified in the cache)
+         *
+         * @param markdownFile  The path of the rendered markdown file (FilePath::toStr())
+         * @param html          The HTML (empty if the file does not exist)
+         */
+        void htmlReady(const QString& markdownFile, const QString& html);
+
+
+    private: // Types
+
+        struct CacheEntry {
+            QDateTime lastModified;
+            qint64 size;
+            QString html;
+        };
+
+
+    private: // Methods
+        void run() noexcept override;
+
+
+    private: // Data
+        volatile bool mAbort;
+        mutable QMutex mMutex;
+        FilePath mRequest;          ///< pending request (invalid if there is none)
+        bool mWorkerActive;         ///< whether #run() processes requests
+        QCache<QString, CacheEntry> mCache; ///< key: file path, cost: HTML length
+
+        // Constants
+        static const int sMaxCacheCost = 4 * 1024 * 1024; ///< about 8MB of HTML
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace application
+} // namespace librepcb
+
+#endif // LIBREPCB_MARKDOWNPREVIEWRENDERER_H
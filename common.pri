@@ -48,3 +48,7 @@ QMAKE_CXXFLAGS_DEBUG += -Wextra
 
 # QuaZIP: use as static library
 DEFINES += QUAZIP_STATIC
+
+# Hot path tracing (see libs/librepcb/common/debugtrace.h): uncomment to remove all
+# instrumentation at compile time
+#DEFINES += LIBREPCB_DISABLE_TRACING
@@ -35,12 +35,13 @@ namespace librepcb {
  ****************************************************************************************/
 
 Attribute::Attribute(const Attribute& other) noexcept :
-    mKey(other.mKey), mType(other.mType), mValue(other.mValue), mUnit(other.mUnit)
+    mKey(other.mKey), mType(other.mType), mValue(other.mValue), mUnit(other.mUnit),
+    mSiValue(other.mSiValue)
 {
 }
 
 Attribute::Attribute(const DomElement& domElement) :
-    mKey(), mType(nullptr), mValue(), mUnit(nullptr)
+    mKey(), mType(nullptr), mValue(), mUnit(nullptr), mSiValue(qQNaN())
 {
     mKey = domElement.getAttribute<QString>("key", true);
     mType = &AttributeType::fromString(domElement.getAttribute<QString>("type", true));
@@ -48,13 +49,15 @@ Attribute::Attribute(const DomElement& domElement) :
     mValue = domElement.getText<QString>(false);
 
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
+    mSiValue = mType->toSiValue(mValue, mUnit);
 }
 
 Attribute::Attribute(const QString& key, const AttributeType& type, const QString& value,
                      const AttributeUnit* unit) :
-    mKey(key), mType(&type), mValue(value), mUnit(unit)
+    mKey(key), mType(&type), mValue(value), mUnit(unit), mSiValue(qQNaN())
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
+    mSiValue = mType->toSiValue(mValue, mUnit);
 }
 
 Attribute::~Attribute() noexcept
@@ -93,6 +96,7 @@ void Attribute::setTypeValueUnit(const AttributeType& type, const QString& value
     mType = &type;
     mValue = value;
     mUnit = unit;
+    mSiValue = type.toSiValue(value, unit);
 }
 
 /*****************************************************************************************
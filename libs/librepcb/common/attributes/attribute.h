@@ -66,6 +66,17 @@ class Attribute final : public SerializableObject
         const QString& getValue() const noexcept {return mValue;}
         QString getValueTr(bool showUnit) const noexcept;
 
+        /**
+         * @brief Get the value converted to the SI base unit of its type
+         *
+         * The value is parsed only once when it is set, so it can be used to compare
+         * or sort many attributes (e.g. 4.7kΩ < 10kΩ) without parsing strings.
+         *
+         * @return The value in the SI base unit, or NaN for non-numeric (e.g. string
+         *         or empty) values (see librepcb::AttributeType::toSiValue())
+         */
+        qreal getSiValue() const noexcept {return mSiValue;}
+
         // Setters
         void setKey(const QString& key);
         void setTypeValueUnit(const AttributeType& type, const QString& value,
@@ -91,6 +102,7 @@ class Attribute final : public SerializableObject
         const AttributeType* mType;
         QString mValue;
         const AttributeUnit* mUnit;
+        qreal mSiValue; ///< cached, see #getSiValue()
 };
 
 /*****************************************************************************************
@@ -59,11 +59,9 @@ const AttributeUnit* AttributeType::getUnitFromString(const QString& unit) const
     if (unit.isEmpty() && mAvailableUnits.isEmpty())
         return nullptr;
 
-    foreach (const AttributeUnit* u, mAvailableUnits)
-    {
-        if (u->getName() == unit)
-            return u;
-    }
+    const AttributeUnit* u = mUnitsByName.value(unit, nullptr);
+    if (u)
+        return u;
 
     throw RuntimeError(__FILE__, __LINE__,
         QString(tr("Unknown unit of attribute type \"%1\": \"%2\"")).arg(mTypeName, unit));
@@ -87,6 +85,27 @@ void AttributeType::throwIfValueInvalid(const QString& value) const
     }
 }
 
+qreal AttributeType::toSiValue(const QString& value, const AttributeUnit* unit) const noexcept
+{
+    // values are stored locale independent (see valueFromTr())
+    bool ok = false;
+    qreal v = value.toDouble(&ok);
+    if (!ok)
+        return qQNaN();
+    return unit ? (v * unit->getFactor()) : v;
+}
+
+/*****************************************************************************************
+ *  Protected Methods
+ ****************************************************************************************/
+
+const AttributeUnit* AttributeType::addUnit(AttributeUnit* unit) noexcept
+{
+    mAvailableUnits.append(unit);
+    mUnitsByName.insert(unit->getName(), unit);
+    return unit;
+}
+
 /*****************************************************************************************
  *  Static Methods
  ****************************************************************************************/
@@ -105,11 +124,16 @@ QList<const AttributeType*> AttributeType::getAllTypes() noexcept
 
 const AttributeType& AttributeType::fromString(const QString &type)
 {
-    foreach (const AttributeType* t, getAllTypes())
-    {
-        if (t->getName() == type)
-            return *t;
-    }
+    // the types are singletons, so the lookup table is built only once (thread-safe)
+    static const QHash<QString, const AttributeType*> typesByName = [](){
+        QHash<QString, const AttributeType*> types;
+        foreach (const AttributeType* t, getAllTypes())
+            types.insert(t->getName(), t);
+        return types;
+    }();
+    const AttributeType* t = typesByName.value(type, nullptr);
+    if (t)
+        return *t;
     throw RuntimeError(__FILE__, __LINE__,
                        QString(tr("Invalid attribute type: \"%1\"")).arg(type));
 }
@@ -81,6 +81,19 @@ class AttributeType
         virtual QString valueFromTr(const QString& value) const noexcept = 0;
         virtual QString printableValueTr(const QString& value, const AttributeUnit* unit = nullptr) const noexcept = 0;
 
+        /**
+         * @brief Convert a value to the SI base unit of this type (e.g. ohm or farad)
+         *
+         * This allows to compare and sort values independent of their units.
+         *
+         * @param value     The (untranslated) value
+         * @param unit      The unit of the value (nullptr = SI base unit)
+         *
+         * @return The value in the SI base unit, or NaN if the value is empty or the
+         *         type is not a numeric type
+         */
+        virtual qreal toSiValue(const QString& value, const AttributeUnit* unit) const noexcept;
+
         // Static Methods
         static QList<const AttributeType*> getAllTypes() noexcept;
         static const AttributeType& fromString(const QString& type);
@@ -88,6 +101,15 @@ class AttributeType
 
     protected:
 
+        /**
+         * @brief Add a unit to #mAvailableUnits (in the order to be shown in the GUI)
+         *
+         * @param unit      The unit (takes ownership)
+         *
+         * @return The added unit
+         */
+        const AttributeUnit* addUnit(AttributeUnit* unit) noexcept;
+
         // make some methods inaccessible...
         AttributeType() = delete;
         AttributeType(const AttributeType& other) = delete;
@@ -99,6 +121,7 @@ class AttributeType
         QString mTypeName;
         QString mTypeNameTr;
         QList<const AttributeUnit*> mAvailableUnits;
+        QHash<QString, const AttributeUnit*> mUnitsByName; ///< to look up units quickly
         const AttributeUnit* mDefaultUnit;
 };
 
@@ -32,8 +32,9 @@ namespace librepcb {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-AttributeUnit::AttributeUnit(const QString& name, const QString& symbolTr) noexcept :
-    mName(name), mSymbolTr(symbolTr)
+AttributeUnit::AttributeUnit(const QString& name, const QString& symbolTr,
+                             qreal factor) noexcept :
+    mName(name), mSymbolTr(symbolTr), mFactor(factor)
 {
 }
 
@@ -43,12 +43,13 @@ class AttributeUnit final
     public:
 
         // Constructors / Destructor
-        explicit AttributeUnit(const QString& name, const QString& symbolTr) noexcept;
+        AttributeUnit(const QString& name, const QString& symbolTr, qreal factor) noexcept;
         ~AttributeUnit() noexcept;
 
         // Getters
         const QString& getName() const noexcept {return mName;}
         const QString& getSymbolTr() const noexcept {return mSymbolTr;}
+        qreal getFactor() const noexcept {return mFactor;}
 
 
     private:
@@ -62,6 +63,7 @@ class AttributeUnit final
         // General Attributes
         QString mName;          ///< to convert from/to string, e.g. "millivolt"
         QString mSymbolTr;      ///< e.g. "mV"
+        qreal mFactor;          ///< to convert values to the SI base unit, e.g. 1e-3
 };
 
 /*****************************************************************************************
@@ -36,13 +36,11 @@ namespace librepcb {
 AttrTypeCapacitance::AttrTypeCapacitance() noexcept :
     AttributeType(Type_t::Capacitance, "capacitance", tr("Capacitance"))
 {
-    mDefaultUnit = new AttributeUnit("microfarad", tr("μF"));
-
-    mAvailableUnits.append(new AttributeUnit("picofarad",   tr("pF")));
-    mAvailableUnits.append(new AttributeUnit("nanofarad",   tr("nF")));
-    mAvailableUnits.append(mDefaultUnit);
-    mAvailableUnits.append(new AttributeUnit("millifarad",  tr("mF")));
-    mAvailableUnits.append(new AttributeUnit("farad",       tr("F")));
+    addUnit(new AttributeUnit("picofarad",   tr("pF"), 1e-12));
+    addUnit(new AttributeUnit("nanofarad",   tr("nF"), 1e-9));
+    mDefaultUnit = addUnit(new AttributeUnit("microfarad", tr("μF"), 1e-6));
+    addUnit(new AttributeUnit("millifarad",  tr("mF"), 1e-3));
+    addUnit(new AttributeUnit("farad",       tr("F"), 1));
 }
 
 AttrTypeCapacitance::~AttrTypeCapacitance() noexcept
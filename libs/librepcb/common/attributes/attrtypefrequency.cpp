@@ -36,14 +36,12 @@ namespace librepcb {
 AttrTypeFrequency::AttrTypeFrequency() noexcept :
     AttributeType(Type_t::Frequency, "frequency", tr("Frequency"))
 {
-    mDefaultUnit = new AttributeUnit("hertz", tr("Hz"));
-
-    mAvailableUnits.append(new AttributeUnit("microhertz",   tr("μHz")));
-    mAvailableUnits.append(new AttributeUnit("millihertz",   tr("mHz")));
-    mAvailableUnits.append(mDefaultUnit);
-    mAvailableUnits.append(new AttributeUnit("kilohertz",    tr("kHz")));
-    mAvailableUnits.append(new AttributeUnit("megahertz",    tr("MHz")));
-    mAvailableUnits.append(new AttributeUnit("gigahertz",    tr("GHz")));
+    addUnit(new AttributeUnit("microhertz",   tr("μHz"), 1e-6));
+    addUnit(new AttributeUnit("millihertz",   tr("mHz"), 1e-3));
+    mDefaultUnit = addUnit(new AttributeUnit("hertz", tr("Hz"), 1));
+    addUnit(new AttributeUnit("kilohertz",    tr("kHz"), 1e3));
+    addUnit(new AttributeUnit("megahertz",    tr("MHz"), 1e6));
+    addUnit(new AttributeUnit("gigahertz",    tr("GHz"), 1e9));
 }
 
 AttrTypeFrequency::~AttrTypeFrequency() noexcept
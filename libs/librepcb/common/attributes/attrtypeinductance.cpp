@@ -36,12 +36,10 @@ namespace librepcb {
 AttrTypeInductance::AttrTypeInductance() noexcept :
     AttributeType(Type_t::Inductance, "inductance", tr("Inductance"))
 {
-    mDefaultUnit = new AttributeUnit("millihenry", tr("mH"));
-
-    mAvailableUnits.append(new AttributeUnit("nanohenry",   tr("nH")));
-    mAvailableUnits.append(new AttributeUnit("microhenry",  tr("μH")));
-    mAvailableUnits.append(mDefaultUnit);
-    mAvailableUnits.append(new AttributeUnit("henry",       tr("H")));
+    addUnit(new AttributeUnit("nanohenry",   tr("nH"), 1e-9));
+    addUnit(new AttributeUnit("microhenry",  tr("μH"), 1e-6));
+    mDefaultUnit = addUnit(new AttributeUnit("millihenry", tr("mH"), 1e-3));
+    addUnit(new AttributeUnit("henry",       tr("H"), 1));
 }
 
 AttrTypeInductance::~AttrTypeInductance() noexcept
@@ -36,13 +36,11 @@ namespace librepcb {
 AttrTypeResistance::AttrTypeResistance() noexcept :
     AttributeType(Type_t::Resistance, "resistance", tr("Resistance"))
 {
-    mDefaultUnit = new AttributeUnit("ohm", tr("Ω"));
-
-    mAvailableUnits.append(new AttributeUnit("microohm",   tr("μΩ")));
-    mAvailableUnits.append(new AttributeUnit("milliohm",   tr("mΩ")));
-    mAvailableUnits.append(mDefaultUnit);
-    mAvailableUnits.append(new AttributeUnit("kiloohm",    tr("kΩ")));
-    mAvailableUnits.append(new AttributeUnit("megaohm",    tr("MΩ")));
+    addUnit(new AttributeUnit("microohm",   tr("μΩ"), 1e-6));
+    addUnit(new AttributeUnit("milliohm",   tr("mΩ"), 1e-3));
+    mDefaultUnit = addUnit(new AttributeUnit("ohm", tr("Ω"), 1));
+    addUnit(new AttributeUnit("kiloohm",    tr("kΩ"), 1e3));
+    addUnit(new AttributeUnit("megaohm",    tr("MΩ"), 1e6));
 }
 
 AttrTypeResistance::~AttrTypeResistance() noexcept
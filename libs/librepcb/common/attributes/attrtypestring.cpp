@@ -62,6 +62,13 @@ QString AttrTypeString::printableValueTr(const QString& value, const AttributeUn
     return value;
 }
 
+qreal AttrTypeString::toSiValue(const QString& value, const AttributeUnit* unit) const noexcept
+{
+    Q_UNUSED(value);
+    Q_UNUSED(unit);
+    return qQNaN(); // strings are never compared numerically
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
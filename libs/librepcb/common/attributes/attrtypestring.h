@@ -46,6 +46,7 @@ class AttrTypeString final : public AttributeType
         bool isValueValid(const QString& value) const noexcept;
         QString valueFromTr(const QString& value) const noexcept;
         QString printableValueTr(const QString& value, const AttributeUnit* unit = nullptr) const noexcept;
+        qreal toSiValue(const QString& value, const AttributeUnit* unit) const noexcept;
         static const AttrTypeString& instance() noexcept {static AttrTypeString x; return x;}
 
 
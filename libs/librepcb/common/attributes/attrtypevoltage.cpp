@@ -36,14 +36,12 @@ namespace librepcb {
 AttrTypeVoltage::AttrTypeVoltage() noexcept :
     AttributeType(Type_t::Voltage, "voltage", tr("Voltage"))
 {
-    mDefaultUnit = new AttributeUnit("volt", tr("V"));
-
-    mAvailableUnits.append(new AttributeUnit("nanovolt",    tr("nV")));
-    mAvailableUnits.append(new AttributeUnit("microvolt",   tr("μV")));
-    mAvailableUnits.append(new AttributeUnit("millivolt",   tr("mV")));
-    mAvailableUnits.append(mDefaultUnit);
-    mAvailableUnits.append(new AttributeUnit("kilovolt",    tr("kV")));
-    mAvailableUnits.append(new AttributeUnit("megavolt",    tr("MV")));
+    addUnit(new AttributeUnit("nanovolt",    tr("nV"), 1e-9));
+    addUnit(new AttributeUnit("microvolt",   tr("μV"), 1e-6));
+    addUnit(new AttributeUnit("millivolt",   tr("mV"), 1e-3));
+    mDefaultUnit = addUnit(new AttributeUnit("volt", tr("V"), 1));
+    addUnit(new AttributeUnit("kilovolt",    tr("kV"), 1e3));
+    addUnit(new AttributeUnit("megavolt",    tr("MV"), 1e6));
 }
 
 AttrTypeVoltage::~AttrTypeVoltage() noexcept
@@ -90,6 +90,13 @@ BoardDesignRules::BoardDesignRules(const DomElement& domElement) :
     if (DomElement* e = domElement.getFirstChild("restring_via_max", false)) {
         mRestringViaMax = e->getText<Length>(true);
     }
+    // copper
+    if (DomElement* e = domElement.getFirstChild("min_copper_clearance", false)) {
+        mMinCopperClearance = e->getText<Length>(true);
+    }
+    if (DomElement* e = domElement.getFirstChild("min_copper_width", false)) {
+        mMinCopperWidth = e->getText<Length>(true);
+    }
 }
 
 BoardDesignRules::~BoardDesignRules() noexcept
@@ -121,6 +128,9 @@ void BoardDesignRules::restoreDefaults() noexcept
     mRestringViaRatio = Ratio(250000);              // 25%
     mRestringViaMin = Length(200000);               // 0.2mm
     mRestringViaMax = Length(2000000);              // 2.0mm
+    // copper
+    mMinCopperClearance = Length(200000);           // 0.2mm
+    mMinCopperWidth = Length(150000);               // 0.15mm
 }
 
 void BoardDesignRules::serialize(DomElement& root) const
@@ -146,6 +156,9 @@ void BoardDesignRules::serialize(DomElement& root) const
     root.appendTextChild("restring_via_ratio",                 mRestringViaRatio);
     root.appendTextChild("restring_via_min",                   mRestringViaMin);
     root.appendTextChild("restring_via_max",                   mRestringViaMax);
+    // copper
+    root.appendTextChild("min_copper_clearance",               mMinCopperClearance);
+    root.appendTextChild("min_copper_width",                   mMinCopperWidth);
 }
 
 /*****************************************************************************************
@@ -210,6 +223,9 @@ BoardDesignRules& BoardDesignRules::operator=(const BoardDesignRules& rhs) noexc
     mRestringViaRatio               = rhs.mRestringViaRatio;
     mRestringViaMin                 = rhs.mRestringViaMin;
     mRestringViaMax                 = rhs.mRestringViaMax;
+    // copper
+    mMinCopperClearance             = rhs.mMinCopperClearance;
+    mMinCopperWidth                 = rhs.mMinCopperWidth;
     return *this;
 }
 
@@ -237,6 +253,9 @@ bool BoardDesignRules::checkAttributesValidity() const noexcept
     if (mRestringViaRatio < 0)                              return false;
     if (mRestringViaMin < 0)                                return false;
     if (mRestringViaMax < mRestringViaMin)                  return false;
+    // copper
+    if (mMinCopperClearance < 0)                            return false;
+    if (mMinCopperWidth < 0)                                return false;
     return true;
 }
 
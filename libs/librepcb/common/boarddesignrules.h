@@ -78,6 +78,10 @@ class BoardDesignRules final : public SerializableObject
         const Length& getRestringViaMin() const noexcept {return mRestringViaMin;}
         const Length& getRestringViaMax() const noexcept {return mRestringViaMax;}
 
+        // Getters: Copper
+        const Length& getMinCopperClearance() const noexcept {return mMinCopperClearance;}
+        const Length& getMinCopperWidth() const noexcept {return mMinCopperWidth;}
+
 
         // Setters: General Attributes
         void setName(const QString& name) noexcept {if (!name.isEmpty()) mName = name;}
@@ -102,6 +106,10 @@ class BoardDesignRules final : public SerializableObject
         void setRestringViaMin(const Length& min) noexcept {if (min >= 0) mRestringViaMin = min;}
         void setRestringViaMax(const Length& max) noexcept {if (max >= 0) mRestringViaMax = max;}
 
+        // Setters: Copper
+        void setMinCopperClearance(const Length& min) noexcept {if (min >= 0) mMinCopperClearance = min;}
+        void setMinCopperWidth(const Length& min) noexcept {if (min >= 0) mMinCopperWidth = min;}
+
         // General Methods
         void restoreDefaults() noexcept;
 
@@ -145,6 +153,10 @@ class BoardDesignRules final : public SerializableObject
         Ratio mRestringViaRatio;
         Length mRestringViaMin;
         Length mRestringViaMax;
+
+        // Copper
+        Length mMinCopperClearance;
+        Length mMinCopperWidth;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,138 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "camimage.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CamImage::CamImage() noexcept
+{
+}
+
+CamImage::CamImage(const CamImage& other) noexcept :
+    mObjects(other.mObjects)
+{
+}
+
+CamImage::~CamImage() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QRectF CamImage::getBoundingRect() const noexcept
+{
+    QRectF rect;
+    foreach (const Object& object, mObjects) {
+        if (object.dark) {
+            rect = rect.isNull() ? object.boundingRect : rect.united(object.boundingRect);
+        }
+    }
+    return rect;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void CamImage::addFilledPath(const QPainterPath& path, bool dark) noexcept
+{
+    addObject(path, 0, dark);
+}
+
+void CamImage::addStrokedPath(const QPainterPath& path, qreal width, bool dark) noexcept
+{
+    addObject(path, qMax(width, qreal(1)), dark); // zero width lines are 1nm wide
+}
+
+void CamImage::append(const CamImage& image, const QPointF& offset) noexcept
+{
+    QVector<Object> objects = image.mObjects; // copy, as image may be this object
+    mObjects.reserve(mObjects.count() + objects.count());
+    foreach (const Object& object, objects) {
+        Object copy = object;
+        copy.path.translate(offset);
+        copy.boundingRect.translate(offset);
+        mObjects.append(copy);
+    }
+}
+
+void CamImage::paint(QPainter& painter, const QVector<int>& indices) const noexcept
+{
+    QPen pen(Qt::white, 1, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+    foreach (int index, indices) {
+        const Object& object = mObjects.at(index);
+        QColor color = object.dark ? Qt::white : Qt::black;
+        if (object.strokeWidth > 0) {
+            pen.setColor(color);
+            pen.setWidthF(object.strokeWidth);
+            painter.strokePath(object.path, pen);
+        } else {
+            painter.fillPath(object.path, color);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Operator Overloadings
+ ****************************************************************************************/
+
+CamImage& CamImage::operator=(const CamImage& rhs) noexcept
+{
+    mObjects = rhs.mObjects;
+    return *this;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void CamImage::addObject(const QPainterPath& path, qreal strokeWidth, bool dark) noexcept
+{
+    Object object;
+    object.path = path;
+    object.strokeWidth = strokeWidth;
+    object.dark = dark;
+    object.boundingRect = path.boundingRect();
+    if (strokeWidth > 0) {
+        object.boundingRect.adjust(-strokeWidth / 2, -strokeWidth / 2,
+                                   strokeWidth / 2, strokeWidth / 2);
+    }
+    mObjects.append(object);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,120 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CAMIMAGE_H
+#define LIBREPCB_CAMIMAGE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class CamImage
+ ****************************************************************************************/
+
+/**
+ * @brief The CamImage class represents the image described by a Gerber or Excellon file
+ *
+ * The image is a list of dark and clear objects in drawing order, i.e. later objects
+ * are painted over earlier ones. All coordinates are in nanometers with the Y axis
+ * pointing up (like librepcb::Point), so the image of a file generated by LibrePCB has
+ * the same coordinates as the board.
+ *
+ * @see librepcb::GerberReader, librepcb::ExcellonReader,
+ *      librepcb::CamImageComparator
+ */
+class CamImage final
+{
+    public:
+
+        // Types
+        struct Object {
+            QPainterPath path;      ///< the outline to fill, or the center line to stroke
+            qreal strokeWidth;      ///< 0 = fill the path, >0 = stroke with round caps
+            bool dark;              ///< false = clear (erases earlier objects)
+            QRectF boundingRect;    ///< including the stroke width
+        };
+
+        // Constructors / Destructor
+        CamImage() noexcept;
+        CamImage(const CamImage& other) noexcept;
+        ~CamImage() noexcept;
+
+        // Getters
+        const QVector<Object>& getObjects() const noexcept {return mObjects;}
+        bool isEmpty() const noexcept {return mObjects.isEmpty();}
+
+        /**
+         * @brief Get the bounding rectangle of all dark objects
+         *
+         * @return The bounding rectangle in nanometers (null if there are no dark objects)
+         */
+        QRectF getBoundingRect() const noexcept;
+
+        // General Methods
+        void addFilledPath(const QPainterPath& path, bool dark) noexcept;
+        void addStrokedPath(const QPainterPath& path, qreal width, bool dark) noexcept;
+
+        /**
+         * @brief Append all objects of another image, translated by an offset
+         *
+         * @param image     The image to append (may be this image)
+         * @param offset    The offset in nanometers
+         */
+        void append(const CamImage& image, const QPointF& offset) noexcept;
+
+        /**
+         * @brief Paint some objects with white (dark) and black (clear) color
+         *
+         * The painter's transformation must map nanometers to the device, antialiasing
+         * should be disabled to get reproducible results.
+         *
+         * @param painter   The painter to paint the objects with
+         * @param indices   The indices of the objects to paint (in ascending order)
+         */
+        void paint(QPainter& painter, const QVector<int>& indices) const noexcept;
+
+        // Operator Overloadings
+        CamImage& operator=(const CamImage& rhs) noexcept;
+
+
+    private:
+
+        // Private Methods
+        void addObject(const QPainterPath& path, qreal strokeWidth, bool dark) noexcept;
+
+
+        QVector<Object> mObjects;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CAMIMAGE_H
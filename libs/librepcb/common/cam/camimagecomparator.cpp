@@ -0,0 +1,296 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <numeric>
+#include "camimagecomparator.h"
+#include "../jobscheduler.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class CamImageComparator::TileJob
+ ****************************************************************************************/
+
+/**
+ * @brief Renders and compares one tile of both images in the JobScheduler
+ *
+ * Every job only writes its own #Difference, so no locking is required. The tile is
+ * rendered with a margin of the tolerance, so the dilation at the tile borders takes
+ * the objects of the neighbouring tiles into account.
+ */
+class CamImageComparator::TileJob final : public QRunnable
+{
+    public:
+        TileJob(const CamImage& a, const CamImage& b, const QVector<int>& indicesA,
+                const QVector<int>& indicesB, const Raster& raster, const QRect& tile,
+                int margin, Difference& difference,
+                const JobScheduler::CancellationToken& token) noexcept :
+            mA(a), mB(b), mIndicesA(indicesA), mIndicesB(indicesB), mRaster(raster),
+            mTile(tile), mMargin(margin), mDifference(difference), mToken(token)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            if (mToken.isCanceled()) return;
+            int width = mTile.width() + 2 * mMargin;
+            int height = mTile.height() + 2 * mMargin;
+            int x0 = mTile.x() - mMargin;
+            int y0 = mTile.y() - mMargin;
+            QVector<quint8> a = renderMask(mA, mIndicesA, mRaster, x0, y0, width, height);
+            QVector<quint8> b = renderMask(mB, mIndicesB, mRaster, x0, y0, width, height);
+            QVector<quint8> dilatedA = a;
+            QVector<quint8> dilatedB = b;
+            dilate(dilatedA, width, height, mMargin);
+            dilate(dilatedB, width, height, mMargin);
+
+            qint64 count = 0;
+            QRect bounds;
+            for (int y = mMargin; y < mMargin + mTile.height(); ++y) {
+                int row = y * width;
+                for (int x = mMargin; x < mMargin + mTile.width(); ++x) {
+                    int i = row + x;
+                    if ((a[i] && (!dilatedB[i])) || (b[i] && (!dilatedA[i]))) {
+                        bounds |= QRect(x + x0, y + y0, 1, 1);
+                        ++count;
+                    }
+                }
+            }
+            mDifference.pixels = count;
+            if (count > 0) {
+                qreal s = mRaster.pixelSize;
+                mDifference.rect = QRectF(
+                    QPointF(mRaster.origin.x() + bounds.left() * s,
+                            mRaster.origin.y() - (bounds.bottom() + 1) * s),
+                    QPointF(mRaster.origin.x() + (bounds.right() + 1) * s,
+                            mRaster.origin.y() - bounds.top() * s));
+            }
+        }
+
+    private:
+        const CamImage& mA;
+        const CamImage& mB;
+        const QVector<int>& mIndicesA;
+        const QVector<int>& mIndicesB;
+        Raster mRaster;
+        QRect mTile;
+        int mMargin;
+        Difference& mDifference;
+        JobScheduler::CancellationToken mToken;
+};
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+CamImageComparator::Result CamImageComparator::compare(const CamImage& a,
+                                                       const CamImage& b,
+                                                       const Options& options,
+                                                       JobScheduler& scheduler) noexcept
+{
+    Result result;
+    QRectF area = a.getBoundingRect();
+    QRectF areaB = b.getBoundingRect();
+    area = area.isNull() ? areaB : (areaB.isNull() ? area : area.united(areaB));
+    if (area.isNull()) return result; // both images are empty
+
+    // the raster covers the whole area plus a border of one pixel
+    Raster raster;
+    raster.pixelSize = 1000000 / qMax(options.pixelsPerMm, qreal(0.001));
+    raster.origin = QPointF(area.left() - raster.pixelSize, area.bottom() + raster.pixelSize);
+    raster.width = qCeil(area.width() / raster.pixelSize) + 2;
+    raster.height = qCeil(area.height() / raster.pixelSize) + 2;
+    int margin = qCeil(options.tolerance.toNm() / raster.pixelSize);
+    int tileSize = qMax(options.tileSize, 16);
+    int columns = (raster.width + tileSize - 1) / tileSize;
+    int rows = (raster.height + tileSize - 1) / tileSize;
+    QVector<QVector<int>> tilesA = assignObjectsToTiles(a, raster, tileSize, columns, rows, margin);
+    QVector<QVector<int>> tilesB = assignObjectsToTiles(b, raster, tileSize, columns, rows, margin);
+
+    // compare all tiles in parallel (the vector is never resized while the jobs run)
+    QVector<Difference> differences(columns * rows);
+    {
+        JobScheduler::Group jobs(scheduler, JobScheduler::Priority::Interactive);
+        for (int row = 0; row < rows; ++row) {
+            for (int column = 0; column < columns; ++column) {
+                int i = row * columns + column;
+                differences[i].pixels = 0;
+                if (tilesA.at(i).isEmpty() && tilesB.at(i).isEmpty()) continue;
+                QRect tile(column * tileSize, row * tileSize,
+                           qMin(tileSize, raster.width - column * tileSize),
+                           qMin(tileSize, raster.height - row * tileSize));
+                jobs.start(new TileJob(a, b, tilesA.at(i), tilesB.at(i), raster, tile,
+                                       margin, differences[i], jobs.getCancellationToken()));
+            }
+        }
+        jobs.waitForDone();
+    }
+
+    result.area = QRectF(raster.origin.x(),
+                         raster.origin.y() - raster.height * raster.pixelSize,
+                         raster.width * raster.pixelSize, raster.height * raster.pixelSize);
+    result.pixels = qint64(raster.width) * raster.height;
+    foreach (const Difference& difference, differences) {
+        if (difference.pixels > 0) {
+            result.differentPixels += difference.pixels;
+            result.differences.append(difference);
+        }
+    }
+    return result;
+}
+
+QImage CamImageComparator::renderDifference(const CamImage& a, const CamImage& b,
+                                            const QRectF& rect, qreal pixelsPerMm) noexcept
+{
+    Raster raster;
+    raster.pixelSize = 1000000 / qMax(pixelsPerMm, qreal(0.001));
+    raster.origin = QPointF(rect.left(), rect.bottom());
+    raster.width = qMax(qCeil(rect.width() / raster.pixelSize), 1);
+    raster.height = qMax(qCeil(rect.height() / raster.pixelSize), 1);
+    QVector<int> indicesA(a.getObjects().count());
+    std::iota(indicesA.begin(), indicesA.end(), 0);
+    QVector<int> indicesB(b.getObjects().count());
+    std::iota(indicesB.begin(), indicesB.end(), 0);
+    QVector<quint8> maskA = renderMask(a, indicesA, raster, 0, 0, raster.width, raster.height);
+    QVector<quint8> maskB = renderMask(b, indicesB, raster, 0, 0, raster.width, raster.height);
+
+    QImage image(raster.width, raster.height, QImage::Format_RGB32);
+    for (int y = 0; y < raster.height; ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < raster.width; ++x) {
+            int i = y * raster.width + x;
+            if (maskA[i] && maskB[i]) {
+                line[x] = qRgb(128, 128, 128);
+            } else if (maskA[i]) {
+                line[x] = qRgb(255, 0, 0);
+            } else if (maskB[i]) {
+                line[x] = qRgb(0, 255, 0);
+            } else {
+                line[x] = qRgb(0, 0, 0);
+            }
+        }
+    }
+    return image;
+}
+
+/*****************************************************************************************
+ *  Static Private Methods
+ ****************************************************************************************/
+
+QVector<QVector<int>> CamImageComparator::assignObjectsToTiles(const CamImage& image,
+                                                               const Raster& raster,
+                                                               int tileSize, int columns,
+                                                               int rows, int margin) noexcept
+{
+    QVector<QVector<int>> tiles(columns * rows);
+    const QVector<CamImage::Object>& objects = image.getObjects();
+    qreal s = raster.pixelSize;
+    for (int i = 0; i < objects.count(); ++i) {
+        const QRectF& r = objects.at(i).boundingRect;
+        int x0 = qFloor((r.left() - raster.origin.x()) / s) - margin;
+        int x1 = qCeil((r.right() - raster.origin.x()) / s) + margin;
+        int y0 = qFloor((raster.origin.y() - r.bottom()) / s) - margin;
+        int y1 = qCeil((raster.origin.y() - r.top()) / s) + margin;
+        int column0 = qMax(x0, 0) / tileSize;
+        int column1 = qMin(qMax(x1, 0) / tileSize, columns - 1);
+        int row0 = qMax(y0, 0) / tileSize;
+        int row1 = qMin(qMax(y1, 0) / tileSize, rows - 1);
+        for (int row = row0; row <= row1; ++row) {
+            for (int column = column0; column <= column1; ++column) {
+                tiles[row * columns + column].append(i);
+            }
+        }
+    }
+    return tiles;
+}
+
+QVector<quint8> CamImageComparator::renderMask(const CamImage& image,
+                                               const QVector<int>& indices,
+                                               const Raster& raster, int x, int y,
+                                               int width, int height) noexcept
+{
+    QVector<quint8> mask(width * height, 0);
+    if (indices.isEmpty()) return mask;
+
+    // map nanometers (Y axis up) to the pixels of the requested section (Y axis down)
+    qreal s = raster.pixelSize;
+    qreal left = raster.origin.x() + x * s;
+    qreal top = raster.origin.y() - y * s;
+    QImage pixmap(width, height, QImage::Format_RGB32);
+    pixmap.fill(Qt::black);
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setTransform(QTransform(1 / s, 0, 0, -1 / s, -left / s, top / s));
+    image.paint(painter, indices);
+    painter.end();
+
+    for (int row = 0; row < height; ++row) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(pixmap.constScanLine(row));
+        quint8* out = mask.data() + row * width;
+        for (int column = 0; column < width; ++column) {
+            out[column] = (qBlue(line[column]) > 127) ? 1 : 0;
+        }
+    }
+    return mask;
+}
+
+void CamImageComparator::dilate(QVector<quint8>& mask, int width, int height,
+                                int radius) noexcept
+{
+    if (radius <= 0) return;
+    // a square structuring element is separable into a horizontal and a vertical pass
+    QVector<quint8> buffer(qMax(width, height));
+    for (int y = 0; y < height; ++y) {
+        dilateLine(mask.data() + y * width, width, 1, radius, buffer.data());
+    }
+    for (int x = 0; x < width; ++x) {
+        dilateLine(mask.data() + x, height, width, radius, buffer.data());
+    }
+}
+
+void CamImageComparator::dilateLine(quint8* data, int count, int stride, int radius,
+                                    quint8* buffer) noexcept
+{
+    // set every pixel which has a set pixel within the radius, in linear time
+    int last = -radius - 1; // index of the last set pixel on the left
+    for (int i = 0; i < count; ++i) {
+        if (data[i * stride]) last = i;
+        buffer[i] = (i - last <= radius) ? 1 : 0;
+    }
+    int next = count + radius + 1; // index of the next set pixel on the right
+    for (int i = count - 1; i >= 0; --i) {
+        if (data[i * stride]) next = i;
+        data[i * stride] = (buffer[i] || (next - i <= radius)) ? 1 : 0;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
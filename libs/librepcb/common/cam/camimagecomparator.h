@@ -0,0 +1,153 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CAMIMAGECOMPARATOR_H
+#define LIBREPCB_CAMIMAGECOMPARATOR_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "../units/all_length_units.h"
+#include "camimage.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class JobScheduler;
+
+/*****************************************************************************************
+ *  Class CamImageComparator
+ ****************************************************************************************/
+
+/**
+ * @brief The CamImageComparator class compares two librepcb::CamImage by rasterizing them
+ *
+ * Comparing the rendered images instead of the file contents makes harmless changes
+ * like a different order of objects, other aperture numbers or regions instead of
+ * draws invisible. The area covered by both images is split into square tiles which
+ * are rendered and compared in parallel in a librepcb::JobScheduler. Objects are
+ * assigned to the tiles by their bounding rectangle, so every tile only paints the
+ * objects which touch it.
+ *
+ * A pixel counts as different if it is set in one image, but there is no set pixel
+ * within the tolerance (a square of `2 * tolerance` side length) in the other image.
+ * So rasterization artefacts and small shifts are ignored, while missing or additional
+ * objects are detected as long as they are larger than the tolerance.
+ */
+class CamImageComparator final
+{
+    public:
+
+        // Types
+        struct Options {
+            qreal pixelsPerMm;  ///< rendering resolution
+            Length tolerance;   ///< maximum allowed displacement of edges
+            int tileSize;       ///< width and height of the tiles in pixels
+
+            Options() noexcept : pixelsPerMm(40), tolerance(25000), tileSize(512) {}
+        };
+        struct Difference {
+            QRectF rect;        ///< bounding rectangle of the different pixels [nm]
+            qint64 pixels;      ///< count of different pixels
+        };
+        struct Result {
+            QRectF area;                    ///< the compared area [nm]
+            qint64 pixels;                  ///< count of compared pixels
+            qint64 differentPixels;         ///< count of different pixels
+            QList<Difference> differences;  ///< one entry per tile with differences
+
+            Result() noexcept : pixels(0), differentPixels(0) {}
+            bool isEqual() const noexcept {return differentPixels == 0;}
+        };
+
+        // Constructors / Destructor
+        CamImageComparator() = delete;
+        CamImageComparator(const CamImageComparator& other) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Compare two images
+         *
+         * @param a         The first image
+         * @param b         The second image
+         * @param options   Resolution, tolerance and tile size
+         * @param scheduler The scheduler to render the tiles in parallel
+         *
+         * @return The differences of the images (in tile order, i.e. row by row)
+         */
+        static Result compare(const CamImage& a, const CamImage& b, const Options& options,
+                              JobScheduler& scheduler) noexcept;
+
+        /**
+         * @brief Render both images into one picture to visualize their differences
+         *
+         * Pixels which are set in both images are gray, pixels only set in the first image
+         * are red and pixels only set in the second image are green.
+         *
+         * @param a             The first image
+         * @param b             The second image
+         * @param rect          The area to render [nm]
+         * @param pixelsPerMm   The resolution
+         *
+         * @return The rendered picture
+         */
+        static QImage renderDifference(const CamImage& a, const CamImage& b,
+                                       const QRectF& rect, qreal pixelsPerMm) noexcept;
+
+        // Operator Overloadings
+        CamImageComparator& operator=(const CamImageComparator& rhs) = delete;
+
+
+    private:
+
+        // Types
+        class TileJob;
+        struct Raster {
+            QPointF origin;     ///< top left corner of the first pixel [nm]
+            qreal pixelSize;    ///< [nm]
+            int width;          ///< in pixels
+            int height;         ///< in pixels
+        };
+
+        // Static Private Methods
+        static QVector<QVector<int>> assignObjectsToTiles(const CamImage& image,
+                                                           const Raster& raster,
+                                                           int tileSize, int columns,
+                                                           int rows, int margin) noexcept;
+        static QVector<quint8> renderMask(const CamImage& image, const QVector<int>& indices,
+                                          const Raster& raster, int x, int y, int width,
+                                          int height) noexcept;
+        static void dilate(QVector<quint8>& mask, int width, int height, int radius) noexcept;
+        static void dilateLine(quint8* data, int count, int stride, int radius,
+                               quint8* buffer) noexcept;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CAMIMAGECOMPARATOR_H
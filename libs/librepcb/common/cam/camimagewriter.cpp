@@ -0,0 +1,346 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <limits>
+#include "camimagewriter.h"
+#include "../exceptions.h"
+#include "../fileio/fileutils.h"
+#include "../jobscheduler.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class CamImageWriter::StripJob
+ ****************************************************************************************/
+
+/**
+ * @brief Renders and compresses one strip of the image in the JobScheduler
+ *
+ * Every job only writes its own #Strip, and the writer waits with the given condition
+ * until the next strip to write is finished.
+ */
+class CamImageWriter::StripJob final : public QRunnable
+{
+    public:
+        StripJob(const QVector<Layer>& layers, const QVector<const QVector<int>*>& indices,
+                 const Raster& raster, int y, int height, const Options& options,
+                 Strip& strip, QMutex& mutex, QWaitCondition& condition,
+                 const JobScheduler::CancellationToken& token) noexcept :
+            mLayers(layers), mIndices(indices), mRaster(raster), mY(y), mHeight(height),
+            mOptions(options), mStrip(strip), mMutex(mutex), mCondition(condition),
+            mToken(token)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            if (mToken.isCanceled()) return;
+            QByteArray data = renderStrip(mLayers, mIndices, mRaster, mY, mHeight, mOptions);
+            QMutexLocker locker(&mMutex);
+            mStrip.data = data;
+            mStrip.finished = true;
+            mCondition.wakeAll();
+        }
+
+    private:
+        const QVector<Layer>& mLayers;
+        QVector<const QVector<int>*> mIndices;
+        Raster mRaster;
+        int mY;
+        int mHeight;
+        const Options& mOptions;
+        Strip& mStrip;
+        QMutex& mMutex;
+        QWaitCondition& mCondition;
+        JobScheduler::CancellationToken mToken;
+};
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QSize CamImageWriter::calcImageSize(const QRectF& area, qreal pixelsPerMm) noexcept
+{
+    qreal pixelSize = 1000000 / qMax(pixelsPerMm, qreal(0.001));
+    return QSize(qMax(qCeil(area.width() / pixelSize), 1),
+                 qMax(qCeil(area.height() / pixelSize), 1));
+}
+
+void CamImageWriter::writeTiff(const QVector<Layer>& layers, const QRectF& area,
+                               const Options& options, const FilePath& filepath,
+                               JobScheduler& scheduler)
+{
+    Raster raster;
+    raster.pixelSize = 1000000 / qMax(options.pixelsPerMm, qreal(0.001));
+    raster.origin = QPointF(area.left(), area.bottom());
+    QSize size = calcImageSize(area, options.pixelsPerMm);
+    raster.width = size.width();
+    raster.height = size.height();
+    int rowsPerStrip = qBound(1, options.stripHeight, raster.height);
+    if (qint64(raster.width) * rowsPerStrip * 4 > std::numeric_limits<int>::max()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("The image is too large "
+            "(%1x%2 pixels).")).arg(raster.width).arg(raster.height));
+    }
+    int count = (raster.height + rowsPerStrip - 1) / rowsPerStrip;
+    QVector<QVector<QVector<int>>> layerStrips;
+    foreach (const Layer& layer, layers) {
+        layerStrips.append(assignObjectsToStrips(layer.image, raster, rowsPerStrip));
+    }
+
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    auto write = [&file, &filepath](const QByteArray& data) {
+        if (file.write(data) != data.size()) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+                "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+        }
+    };
+    auto toLittleEndian = [](quint32 value) -> QByteArray {
+        QByteArray data(4, 0);
+        qToLittleEndian(value, reinterpret_cast<uchar*>(data.data()));
+        return data;
+    };
+    write(QByteArray("II\x2A\x00", 4) + toLittleEndian(0)); // can throw
+
+    // Render the strips in parallel, but write them in order. Only strips which are
+    // at most maxPending positions ahead of the next strip to write are started, so
+    // only these need to be kept in memory (the vectors are never resized while the
+    // jobs are running).
+    int maxPending = (options.maxPendingStrips > 0) ? options.maxPendingStrips
+                                                    : 2 * qMax(scheduler.getMaxThreadCount(), 1);
+    QVector<Strip> strips(count);
+    QMutex mutex;
+    QWaitCondition condition;
+    QVector<quint32> stripOffsets(count);
+    QVector<quint32> stripByteCounts(count);
+    qint64 position = 8;
+    {
+        JobScheduler::Group jobs(scheduler, JobScheduler::Priority::Interactive);
+        int started = 0;
+        for (int i = 0; i < count; ++i) {
+            for (; (started < count) && (started < i + maxPending); ++started) {
+                QVector<const QVector<int>*> indices;
+                for (int layer = 0; layer < layers.count(); ++layer) {
+                    indices.append(&layerStrips.at(layer).at(started));
+                }
+                int y = started * rowsPerStrip;
+                strips[started].finished = false;
+                jobs.start(new StripJob(layers, indices, raster, y,
+                                        qMin(rowsPerStrip, raster.height - y), options,
+                                        strips[started], mutex, condition,
+                                        jobs.getCancellationToken()));
+            }
+            QByteArray data;
+            {
+                QMutexLocker locker(&mutex);
+                while (!strips.at(i).finished) {
+                    condition.wait(&mutex);
+                }
+                data = strips.at(i).data;
+                strips[i].data.clear();
+            }
+            if (position + data.size() > std::numeric_limits<quint32>::max()) {
+                throw RuntimeError(__FILE__, __LINE__, QString(tr("The image is too "
+                    "large for a TIFF file (%1x%2 pixels).")).arg(raster.width)
+                    .arg(raster.height));
+            }
+            stripOffsets[i] = position;
+            stripByteCounts[i] = data.size();
+            write(data); // can throw
+            position += data.size();
+        }
+    }
+
+    // the directory must start at a word boundary
+    if (position % 2) {
+        write(QByteArray(1, 0)); // can throw
+        ++position;
+    }
+    QByteArray directory = createDirectory(raster, options, rowsPerStrip, position,
+                                           stripOffsets, stripByteCounts);
+    if (position + directory.size() > std::numeric_limits<quint32>::max()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("The image is too large for "
+            "a TIFF file (%1x%2 pixels).")).arg(raster.width).arg(raster.height));
+    }
+    write(directory); // can throw
+    if (!file.seek(4)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
+    write(toLittleEndian(position)); // can throw
+    if (!file.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
+}
+
+/*****************************************************************************************
+ *  Static Private Methods
+ ****************************************************************************************/
+
+QVector<QVector<int>> CamImageWriter::assignObjectsToStrips(const CamImage& image,
+                                                             const Raster& raster,
+                                                             int stripHeight) noexcept
+{
+    QVector<QVector<int>> strips((raster.height + stripHeight - 1) / stripHeight);
+    const QVector<CamImage::Object>& objects = image.getObjects();
+    qreal s = raster.pixelSize;
+    for (int i = 0; i < objects.count(); ++i) {
+        // one additional pixel for the antialiasing
+        const QRectF& r = objects.at(i).boundingRect;
+        int x0 = qFloor((r.left() - raster.origin.x()) / s) - 1;
+        int x1 = qCeil((r.right() - raster.origin.x()) / s) + 1;
+        int y0 = qFloor((raster.origin.y() - r.bottom()) / s) - 1;
+        int y1 = qCeil((raster.origin.y() - r.top()) / s) + 1;
+        if ((x1 < 0) || (x0 >= raster.width) || (y1 < 0) || (y0 >= raster.height)) {
+            continue; // outside of the rendered area
+        }
+        int first = qMax(y0, 0) / stripHeight;
+        int last = qMin(y1, raster.height - 1) / stripHeight;
+        for (int strip = first; strip <= last; ++strip) {
+            strips[strip].append(i);
+        }
+    }
+    return strips;
+}
+
+QByteArray CamImageWriter::renderStrip(const QVector<Layer>& layers,
+                                       const QVector<const QVector<int>*>& indices,
+                                       const Raster& raster, int y, int height,
+                                       const Options& options) noexcept
+{
+    // map nanometers (Y axis up) to the pixels of the strip (Y axis down)
+    qreal s = raster.pixelSize;
+    qreal left = raster.origin.x();
+    qreal top = raster.origin.y() - y * s;
+    QTransform transform(1 / s, 0, 0, -1 / s, -left / s, top / s);
+
+    QImage pixmap(raster.width, height, QImage::Format_RGB32);
+    pixmap.fill(options.background.rgb());
+    QImage mask(raster.width, height, QImage::Format_RGB32);
+    for (int i = 0; i < layers.count(); ++i) {
+        if (indices.at(i)->isEmpty()) continue;
+        mask.fill(Qt::black);
+        QPainter painter(&mask);
+        painter.setRenderHint(QPainter::Antialiasing, options.antialiasing);
+        painter.setTransform(transform);
+        layers.at(i).image.paint(painter, *indices.at(i));
+        painter.end();
+
+        // the mask (white = covered) is the opacity of the layer color
+        const QColor& color = layers.at(i).color;
+        int red = color.red(), green = color.green(), blue = color.blue();
+        int alpha = color.alpha();
+        for (int row = 0; row < height; ++row) {
+            const QRgb* in = reinterpret_cast<const QRgb*>(mask.constScanLine(row));
+            QRgb* out = reinterpret_cast<QRgb*>(pixmap.scanLine(row));
+            for (int column = 0; column < raster.width; ++column) {
+                int a = qBlue(in[column]) * alpha / 255;
+                if (a == 0) continue;
+                QRgb p = out[column];
+                out[column] = qRgb(qRed(p) + (red - qRed(p)) * a / 255,
+                                   qGreen(p) + (green - qGreen(p)) * a / 255,
+                                   qBlue(p) + (blue - qBlue(p)) * a / 255);
+            }
+        }
+    }
+
+    QByteArray data(raster.width * height * 3, Qt::Uninitialized);
+    uchar* out = reinterpret_cast<uchar*>(data.data());
+    for (int row = 0; row < height; ++row) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(pixmap.constScanLine(row));
+        for (int column = 0; column < raster.width; ++column) {
+            *out++ = qRed(line[column]);
+            *out++ = qGreen(line[column]);
+            *out++ = qBlue(line[column]);
+        }
+    }
+    // TIFF Deflate compression is a zlib stream without qCompress()'s size prefix
+    return qCompress(data, 6).mid(4);
+}
+
+QByteArray CamImageWriter::createDirectory(const Raster& raster, const Options& options,
+                                           int rowsPerStrip, quint32 offset,
+                                           const QVector<quint32>& stripOffsets,
+                                           const QVector<quint32>& stripByteCounts) noexcept
+{
+    enum Type : quint16 {Short = 3, Long = 4, Rational = 5};
+    const int entryCount = 13;
+    quint32 count = stripOffsets.count();
+
+    // values which do not fit into an entry are stored after the directory
+    QByteArray values;
+    QDataStream valueStream(&values, QIODevice::WriteOnly);
+    valueStream.setByteOrder(QDataStream::LittleEndian);
+    quint32 valuesOffset = offset + 2 + entryCount * 12 + 4;
+    auto appendValues = [&](const QVector<quint32>& data) -> quint32 {
+        quint32 position = valuesOffset + values.size();
+        foreach (quint32 value, data) valueStream << value;
+        return position;
+    };
+    quint32 bitsPerSample = appendValues({0x00080008, 0x00000008}); // 3x SHORT 8
+    quint32 pixelsPerCm = qRound(options.pixelsPerMm * 10000);
+    quint32 resolution = appendValues({pixelsPerCm, 1000});
+    quint32 offsets = (count > 1) ? appendValues(stripOffsets) : stripOffsets.first();
+    quint32 byteCounts = (count > 1) ? appendValues(stripByteCounts) : stripByteCounts.first();
+
+    // the entries must be sorted by their tag
+    QByteArray directory;
+    QDataStream stream(&directory, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    auto entry = [&stream](quint16 tag, Type type, quint32 n, quint32 value) {
+        stream << tag << quint16(type) << n << value; // SHORTs are left-justified
+    };
+    stream << quint16(entryCount);
+    entry(256, Long, 1, raster.width);          // ImageWidth
+    entry(257, Long, 1, raster.height);         // ImageLength
+    entry(258, Short, 3, bitsPerSample);        // BitsPerSample
+    entry(259, Short, 1, 8);                    // Compression: Deflate
+    entry(262, Short, 1, 2);                    // PhotometricInterpretation: RGB
+    entry(273, Long, count, offsets);           // StripOffsets
+    entry(277, Short, 1, 3);                    // SamplesPerPixel
+    entry(278, Long, 1, rowsPerStrip);          // RowsPerStrip
+    entry(279, Long, count, byteCounts);        // StripByteCounts
+    entry(282, Rational, 1, resolution);        // XResolution
+    entry(283, Rational, 1, resolution);        // YResolution
+    entry(284, Short, 1, 1);                    // PlanarConfiguration: chunky
+    entry(296, Short, 1, 3);                    // ResolutionUnit: centimeter
+    stream << quint32(0);                       // no further directories
+    Q_ASSERT(directory.size() == 2 + entryCount * 12 + 4);
+    return directory + values;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CAMIMAGEWRITER_H
+#define LIBREPCB_CAMIMAGEWRITER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "../fileio/filepath.h"
+#include "camimage.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class JobScheduler;
+
+/*****************************************************************************************
+ *  Class CamImageWriter
+ ****************************************************************************************/
+
+/**
+ * @brief The CamImageWriter class rasterizes librepcb::CamImage objects into an image file
+ *
+ * The images are painted on top of each other with their own color (e.g. one image per
+ * board layer) and written to a Deflate compressed RGB TIFF file. The image is split
+ * into horizontal strips which are rendered and compressed in parallel in a
+ * librepcb::JobScheduler, and written to the file in order as soon as they are ready.
+ * Only a limited number of strips is rendered ahead of the one written next, so the
+ * memory usage only depends on the width of the image, but not on its height. This
+ * allows to export images at high resolutions which would not fit into a single
+ * QImage.
+ *
+ * @note As the strip offsets are 32 bit values, the compressed file must not exceed
+ *       4 GiB (BigTIFF is not supported).
+ */
+class CamImageWriter final
+{
+        Q_DECLARE_TR_FUNCTIONS(CamImageWriter)
+
+    public:
+
+        // Types
+        struct Layer {
+            CamImage image;     ///< dark objects are painted, clear objects are erased
+            QColor color;       ///< may be transparent to blend with lower layers
+        };
+        struct Options {
+            qreal pixelsPerMm;      ///< rendering resolution
+            QColor background;      ///< color of the pixels not covered by any layer
+            bool antialiasing;      ///< false to get only the layer and background colors
+            int stripHeight;        ///< rows per strip
+            int maxPendingStrips;   ///< rendered strips kept in memory (0 = automatic)
+
+            Options() noexcept : pixelsPerMm(600 / 25.4), background(Qt::white),
+                antialiasing(true), stripHeight(64), maxPendingStrips(0) {}
+        };
+
+        // Constructors / Destructor
+        CamImageWriter() = delete;
+        CamImageWriter(const CamImageWriter& other) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Get the size of the image for an area at a specific resolution
+         *
+         * @param area          The area to render [nm]
+         * @param pixelsPerMm   The resolution
+         *
+         * @return The width and height in pixels
+         */
+        static QSize calcImageSize(const QRectF& area, qreal pixelsPerMm) noexcept;
+
+        /**
+         * @brief Render layers and write them to a TIFF file
+         *
+         * @param layers    The layers to paint, from bottom to top
+         * @param area      The area to render [nm]
+         * @param options   Resolution, colors and strip size
+         * @param filepath  The file to write (overwritten if it exists already)
+         * @param scheduler The scheduler to render the strips in parallel
+         *
+         * @throw Exception if the image is too large or the file could not be written
+         */
+        static void writeTiff(const QVector<Layer>& layers, const QRectF& area,
+                              const Options& options, const FilePath& filepath,
+                              JobScheduler& scheduler);
+
+        // Operator Overloadings
+        CamImageWriter& operator=(const CamImageWriter& rhs) = delete;
+
+
+    private:
+
+        // Types
+        class StripJob;
+        struct Raster {
+            QPointF origin;     ///< top left corner of the first pixel [nm]
+            qreal pixelSize;    ///< [nm]
+            int width;          ///< in pixels
+            int height;         ///< in pixels
+        };
+        struct Strip {
+            QByteArray data;    ///< the compressed pixels
+            bool finished;      ///< whether #data is valid
+        };
+
+        // Static Private Methods
+        static QVector<QVector<int>> assignObjectsToStrips(const CamImage& image,
+                                                            const Raster& raster,
+                                                            int stripHeight) noexcept;
+        static QByteArray renderStrip(const QVector<Layer>& layers,
+                                      const QVector<const QVector<int>*>& indices,
+                                      const Raster& raster, int y, int height,
+                                      const Options& options) noexcept;
+        static QByteArray createDirectory(const Raster& raster, const Options& options,
+                                          int rowsPerStrip, quint32 offset,
+                                          const QVector<quint32>& stripOffsets,
+                                          const QVector<quint32>& stripByteCounts) noexcept;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CAMIMAGEWRITER_H
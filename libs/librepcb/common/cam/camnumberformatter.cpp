@@ -0,0 +1,82 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "camnumberformatter.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+char* CamNumberFormatter::writeInteger(char* out, qint64 value) noexcept
+{
+    return writeFixedPoint(out, value, 0);
+}
+
+char* CamNumberFormatter::writeFixedPoint(char* out, qint64 value, int decimals) noexcept
+{
+    Q_ASSERT((decimals >= 0) && (decimals <= 18));
+
+    // collect the digits in reverse order (unsigned to handle the minimum value too)
+    quint64 magnitude = (value < 0) ? (0 - static_cast<quint64>(value))
+                                    : static_cast<quint64>(value);
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while ((magnitude > 0) || (count <= decimals)); // at least one integer digit
+
+    if (value < 0) {
+        *out++ = '-';
+    }
+    while (count > decimals) {
+        *out++ = digits[--count];
+    }
+    if (decimals > 0) {
+        *out++ = '.';
+        while (count > 0) {
+            *out++ = digits[--count];
+        }
+    }
+    return out;
+}
+
+char* CamNumberFormatter::writeString(char* out, const char* str) noexcept
+{
+    while (*str) {
+        *out++ = *str++;
+    }
+    return out;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,93 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CAMNUMBERFORMATTER_H
+#define LIBREPCB_CAMNUMBERFORMATTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class CamNumberFormatter
+ ****************************************************************************************/
+
+/**
+ * @brief The CamNumberFormatter class formats numbers for CAM files into char buffers
+ *
+ * CAM files (Gerber, Excellon) consist mostly of coordinates, so the formatting of
+ * numbers must be fast. These methods write directly into a caller-provided buffer
+ * (usually on the stack) without any heap allocation. The output is identical to
+ * librepcb::Length::toNmString() and librepcb::Length::toMmString() respectively.
+ *
+ * All methods return a pointer to the character after the last written one (the
+ * output is not null-terminated).
+ */
+class CamNumberFormatter final
+{
+    public:
+
+        // Constructors / Destructor
+        CamNumberFormatter() = delete;
+        CamNumberFormatter(const CamNumberFormatter& other) = delete;
+        ~CamNumberFormatter() = delete;
+
+        /// The maximum count of characters written by #writeInteger()
+        static constexpr int sMaxIntegerLength = 20;
+
+        /// The maximum count of characters written by #writeFixedPoint()
+        static constexpr int sMaxFixedPointLength = 21;
+
+        /**
+         * @brief Write an integer (e.g. "-1500")
+         */
+        static char* writeInteger(char* out, qint64 value) noexcept;
+
+        /**
+         * @brief Write a fixed point number (e.g. value -1500 with 6 decimals: "-0.001500")
+         *
+         * @param out       The buffer to write to
+         * @param value     The value, scaled by 10^decimals
+         * @param decimals  The count of decimals to write (0..18)
+         */
+        static char* writeFixedPoint(char* out, qint64 value, int decimals) noexcept;
+
+        /**
+         * @brief Write a null-terminated string (without the null character)
+         */
+        static char* writeString(char* out, const char* str) noexcept;
+
+        // Operator Overloadings
+        CamNumberFormatter& operator=(const CamNumberFormatter& rhs) = delete;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CAMNUMBERFORMATTER_H
@@ -20,8 +20,11 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <algorithm>
+#include <limits>
 #include <QtCore>
 #include "excellongenerator.h"
+#include "camnumberformatter.h"
 #include "../fileio/smarttextfile.h"
 #include "../application.h"
 
@@ -30,12 +33,78 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Helper Functions
+ ****************************************************************************************/
+
+namespace {
+
+/**
+ * @brief Reorder hits to shorten the travel of the drilling machine
+ *
+ * @param hits      The hits to sort
+ * @param order     The kind of order
+ * @param start     Returns the position where the machine enters a hit
+ * @param end       Returns the position where the machine leaves a hit (differs from
+ *                  the start for slots)
+ */
+template <typename T, typename StartFn, typename EndFn>
+QVector<T> sortHits(const QVector<T>& hits, ExcellonGenerator::HitOrder order,
+                    StartFn start, EndFn end, LengthBase_t bandHeight) noexcept
+{
+    switch (order) {
+        case ExcellonGenerator::HitOrder::NearestNeighbour: {
+            QVector<T> remaining = hits;
+            QVector<T> sorted;
+            sorted.reserve(hits.count());
+            Point current(0, 0);
+            while (!remaining.isEmpty()) {
+                int nearest = 0;
+                qreal nearestDistance = std::numeric_limits<qreal>::infinity();
+                for (int i = 0; i < remaining.count(); ++i) {
+                    Point diff = start(remaining.at(i)) - current;
+                    qreal distance = qreal(diff.getX().toNm()) * qreal(diff.getX().toNm())
+                                   + qreal(diff.getY().toNm()) * qreal(diff.getY().toNm());
+                    if (distance < nearestDistance) {
+                        nearest = i;
+                        nearestDistance = distance;
+                    }
+                }
+                sorted.append(remaining.at(nearest));
+                current = end(remaining.at(nearest));
+                remaining[nearest] = remaining.last();
+                remaining.removeLast();
+            }
+            return sorted;
+        }
+        case ExcellonGenerator::HitOrder::Serpentine: {
+            QVector<T> sorted = hits;
+            auto band = [bandHeight](const Point& p){
+                return qFloor(qreal(p.getY().toNm()) / bandHeight);
+            };
+            std::stable_sort(sorted.begin(), sorted.end(), [&](const T& lhs, const T& rhs){
+                int lhsBand = band(start(lhs)), rhsBand = band(start(rhs));
+                if (lhsBand != rhsBand) return lhsBand < rhsBand;
+                // even bands from left to right, odd bands from right to left
+                bool leftToRight = (lhsBand % 2 == 0);
+                return leftToRight ? (start(lhs).getX() < start(rhs).getX())
+                                   : (start(rhs).getX() < start(lhs).getX());
+            });
+            return sorted;
+        }
+        default:
+            return hits;
+    }
+}
+
+} // namespace
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 ExcellonGenerator::ExcellonGenerator() noexcept :
-    mOutput()
+    mHitOrder(HitOrder::Insertion), mOutput()
 {
 }
 
@@ -47,17 +116,36 @@ ExcellonGenerator::~ExcellonGenerator() noexcept
  *  General Methods
  ****************************************************************************************/
 
-void ExcellonGenerator::drill(const Point& pos, const Length& dia) noexcept
+void ExcellonGenerator::drill(const Point& pos, const Length& dia, bool plated) noexcept
+{
+    mTools[ToolKey{plated, dia}].drills.append(pos);
+}
+
+void ExcellonGenerator::slot(const Point& start, const Point& end, const Length& dia,
+                             bool plated) noexcept
 {
-    mDrillList.insert(dia, pos);
+    mTools[ToolKey{plated, dia}].slots.append(Slot{start, end});
 }
 
-void ExcellonGenerator::generate()
+void ExcellonGenerator::generate(Plating plating)
 {
     mOutput.clear();
-    printHeader();
-    printDrills();
-    printFooter();
+    QTextStream stream(&mOutput);
+    generate(stream, plating);
+}
+
+void ExcellonGenerator::generate(QTextStream& stream, Plating plating) const
+{
+    QList<ToolKey> tools;
+    foreach (const ToolKey& key, mTools.keys()) {
+        if ((plating == Plating::Mixed) || (key.plated == (plating == Plating::Plated))) {
+            tools.append(key);
+        }
+    }
+    printHeader(stream, tools);
+    printHits(stream, tools);
+    printFooter(stream);
+    stream.flush();
 }
 
 void ExcellonGenerator::saveToFile(const FilePath& filepath) const
@@ -70,56 +158,78 @@ void ExcellonGenerator::saveToFile(const FilePath& filepath) const
 void ExcellonGenerator::reset() noexcept
 {
     mOutput.clear();
-    mDrillList.clear();
+    mTools.clear();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-void ExcellonGenerator::printHeader() noexcept
+void ExcellonGenerator::printHeader(QTextStream& stream,
+                                    const QList<ToolKey>& tools) const noexcept
 {
-    mOutput.append("M48\n");        // Beginning of Part Program Header
+    stream << "M48\n";        // Beginning of Part Program Header
 
     // Comments
-    mOutput.append(";DRILL FILE\n");
-    mOutput.append(QString(";Generated by LibrePCB %1\n").arg(qApp->getAppVersion().toPrettyStr(3)));
-    mOutput.append(QString(";Creation Date: %1\n").arg(QDateTime::currentDateTime().toString(Qt::ISODate)));
-    mOutput.append("FMAT,2\n");     // Use Format 2 commands
-    mOutput.append("METRIC,TZ\n");  // Metric Format, Trailing Zeros Mode
-
-    printToolList();
-
-    mOutput.append("%\n");          // Beginning of Pattern
-    mOutput.append("G90\n");        // Absolute Mode
-    mOutput.append("G05\n");        // Drill Mode
-    mOutput.append("M71\n");        // Metric Measuring Mode
+    stream << ";DRILL FILE\n";
+    stream << QString(";Generated by LibrePCB %1\n").arg(qApp->getAppVersion().toPrettyStr(3));
+    stream << QString(";Creation Date: %1\n").arg(QDateTime::currentDateTime().toString(Qt::ISODate));
+    stream << "FMAT,2\n";     // Use Format 2 commands
+    stream << "METRIC,TZ\n";  // Metric Format, Trailing Zeros Mode
+
+    // Tool List (plated tools first, the plating is noted as comment)
+    for (int i = 0; i < tools.count(); ++i) {
+        if ((i == 0) || (tools.at(i).plated != tools.at(i - 1).plated)) {
+            stream << (tools.at(i).plated ? ";TYPE=PLATED\n" : ";TYPE=NON_PLATED\n");
+        }
+        stream << QString("T%1C%2\n").arg(i + 1).arg(tools.at(i).diameter.toMmString());
+    }
+
+    stream << "%\n";          // Beginning of Pattern
+    stream << "G90\n";        // Absolute Mode
+    stream << "G05\n";        // Drill Mode
+    stream << "M71\n";        // Metric Measuring Mode
 }
 
-void ExcellonGenerator::printToolList() noexcept
+void ExcellonGenerator::printHits(QTextStream& stream,
+                                  const QList<ToolKey>& tools) const noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-        Length dia = mDrillList.uniqueKeys().value(i);
-        mOutput.append(QString("T%1C%2\n").arg(i+1).arg(dia.toMmString()));
+    for (int i = 0; i < tools.count(); ++i) {
+        const Tool& tool = *mTools.constFind(tools.at(i));
+        stream << QString("T%1\n").arg(i + 1); // Select Tool
+        auto pos = [](const Point& p){return p;};
+        foreach (const Point& p, sortHits(tool.drills, mHitOrder, pos, pos,
+                                          sSerpentineBandHeightNm)) {
+            printCoordinates(stream, p, "\n");
+        }
+        foreach (const Slot& s, sortHits(tool.slots, mHitOrder,
+                                         [](const Slot& s){return s.start;},
+                                         [](const Slot& s){return s.end;},
+                                         sSerpentineBandHeightNm)) {
+            printCoordinates(stream, s.start, "G85");
+            printCoordinates(stream, s.end, "\n");
+        }
     }
 }
 
-void ExcellonGenerator::printDrills() noexcept
+void ExcellonGenerator::printFooter(QTextStream& stream) const noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-        mOutput.append(QString("T%1\n").arg(i+1)); // Select Tool
-        Length dia = mDrillList.uniqueKeys().value(i);
-        foreach (const Point& pos, mDrillList.values(dia)) {
-            mOutput.append(QString("X%1Y%2\n").arg(pos.getX().toMmString(),
-                                                   pos.getY().toMmString()));
-        }
-    }
+    stream << "T0\n";
+    stream << "M30\n";        // End of Program Rewind
 }
 
-void ExcellonGenerator::printFooter() noexcept
+void ExcellonGenerator::printCoordinates(QTextStream& stream, const Point& pos,
+                                         const char* suffix) noexcept
 {
-    mOutput.append("T0\n");
-    mOutput.append("M30\n");        // End of Program Rewind
+    // formatted without any heap allocation (identical to Length::toMmString())
+    char buffer[2 * (CamNumberFormatter::sMaxFixedPointLength + 1) + 8];
+    char* out = buffer;
+    *out++ = 'X';
+    out = CamNumberFormatter::writeFixedPoint(out, pos.getX().toNm(), 6);
+    *out++ = 'Y';
+    out = CamNumberFormatter::writeFixedPoint(out, pos.getY().toNm(), 6);
+    out = CamNumberFormatter::writeString(out, suffix);
+    stream << QLatin1String(buffer, out - buffer);
 }
 
 /*****************************************************************************************
@@ -40,6 +40,11 @@ namespace librepcb {
 /**
  * @brief The ExcellonGenerator class
  *
+ * The hits are stored in one list per tool (diameter and plating), in the order they
+ * were added. Optionally they are reordered by #setHitOrder() to shorten the travel of
+ * the drilling machine. Plated and non-plated holes can be mixed in the same file, the
+ * tool list then marks the plating of every tool.
+ *
  * @author ubruhin
  * @date 2016-03-31
  */
@@ -49,6 +54,18 @@ class ExcellonGenerator final
 
     public:
 
+        // Types
+
+        /// The order in which the hits of a tool are written
+        enum class HitOrder {
+            Insertion,          ///< keep the order in which the hits were added
+            NearestNeighbour,   ///< always go to the nearest remaining hit (greedy)
+            Serpentine,         ///< horizontal bands, alternating left/right direction
+        };
+
+        /// Which hits to write into the file
+        enum class Plating {Plated, NonPlated, Mixed};
+
         // Constructors / Destructor
         //ExcellonGenerator() = delete;
         ExcellonGenerator(const ExcellonGenerator& other) = delete;
@@ -58,9 +75,28 @@ class ExcellonGenerator final
         // Getters
         const QString& toStr() const noexcept {return mOutput;}
 
+        // Setters
+        void setHitOrder(HitOrder order) noexcept {mHitOrder = order;}
+
         // General Methods
-        void drill(const Point& pos, const Length& dia) noexcept;
-        void generate();
+        void drill(const Point& pos, const Length& dia, bool plated = true) noexcept;
+
+        /**
+         * @brief Add a slot, i.e. a routed hole from one point to another (G85)
+         */
+        void slot(const Point& start, const Point& end, const Length& dia,
+                  bool plated = true) noexcept;
+
+        void generate(Plating plating = Plating::Mixed);
+
+        /**
+         * @brief Write the file directly into a stream (instead of #toStr())
+         *
+         * @param stream    The stream to write to
+         * @param plating   Which hits to write
+         */
+        void generate(QTextStream& stream, Plating plating = Plating::Mixed) const;
+
         void saveToFile(const FilePath& filepath) const;
         void reset() noexcept;
 
@@ -68,17 +104,46 @@ class ExcellonGenerator final
         ExcellonGenerator& operator=(const ExcellonGenerator& rhs) = delete;
 
 
-    private:
+    private: // Types
+
+        struct Slot {
+            Point start;
+            Point end;
+        };
+
+        /// Identifies a tool (key of #mTools)
+        struct ToolKey {
+            bool plated;
+            Length diameter;
+            bool operator<(const ToolKey& rhs) const noexcept {
+                return (plated != rhs.plated) ? plated : (diameter < rhs.diameter);
+            }
+        };
+        struct Tool {
+            QVector<Point> drills;
+            QVector<Slot> slots;
+        };
+
 
-        void printHeader() noexcept;
-        void printToolList() noexcept;
-        void printDrills() noexcept;
-        void printFooter() noexcept;
+    private: // Methods
 
+        void printHeader(QTextStream& stream, const QList<ToolKey>& tools) const noexcept;
+        void printHits(QTextStream& stream, const QList<ToolKey>& tools) const noexcept;
+        void printFooter(QTextStream& stream) const noexcept;
+        static void printCoordinates(QTextStream& stream, const Point& pos,
+                                     const char* suffix) noexcept;
+
+
+    private: // Data
+
+        HitOrder mHitOrder;
+        QMap<ToolKey, Tool> mTools; ///< sorted by plating and diameter (= tool numbers)
 
         // Excellon Data
         QString mOutput;
-        QMultiMap<Length, Point> mDrillList;
+
+        /// The height of the bands of HitOrder::Serpentine
+        static constexpr LengthBase_t sSerpentineBandHeightNm = 5000000;
 };
 
 /*****************************************************************************************
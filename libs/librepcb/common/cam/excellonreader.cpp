@@ -0,0 +1,203 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "excellonreader.h"
+#include "../fileio/filepath.h"
+#include "../fileio/fileutils.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ExcellonReader::ExcellonReader(const QByteArray& content) noexcept :
+    mContent(content), mLineNumber(0), mUnit(25400000), mLeadingZeros(false),
+    mIntegerDigits(2), mDecimalDigits(4), mCurrentTool(0), mEndOfFile(false)
+{
+}
+
+ExcellonReader::~ExcellonReader() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+CamImage ExcellonReader::readFile(const FilePath& filepath)
+{
+    return read(FileUtils::readFile(filepath)); // can throw
+}
+
+CamImage ExcellonReader::read(const QByteArray& content)
+{
+    ExcellonReader reader(content);
+    return reader.parse(); // can throw
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+CamImage ExcellonReader::parse()
+{
+    foreach (const QByteArray& line, mContent.split('\n')) {
+        ++mLineNumber;
+        QByteArray trimmed = line.trimmed().toUpper();
+        if ((!trimmed.isEmpty()) && (!trimmed.startsWith(';'))) {
+            parseLine(trimmed); // can throw
+        }
+        if (mEndOfFile) break;
+    }
+    return mImage;
+}
+
+void ExcellonReader::parseLine(const QByteArray& line)
+{
+    if (line.startsWith("METRIC") || line.startsWith("INCH")) {
+        parseUnit(line);
+    } else if (line == "M71") {
+        mUnit = 1000000;
+    } else if (line == "M72") {
+        mUnit = 25400000;
+    } else if ((line == "M30") || (line == "M00")) {
+        mEndOfFile = true;
+    } else if ((line == "G91") || (line == "ICI") || (line == "ICI,ON")) {
+        throw createError(tr("Incremental coordinates are not supported."));
+    } else if (line.startsWith("G00") || line.startsWith("G01") || line.startsWith("G02") ||
+               line.startsWith("G03") || (line == "M15") || (line == "M16")) {
+        throw createError(tr("Routing commands are not supported."));
+    } else if (line.startsWith('T')) {
+        parseTool(line); // can throw
+    } else if (line.startsWith('X') || line.startsWith('Y')) {
+        parseCoordinates(line); // can throw
+    }
+    // all other commands (M48, %, G90, G05, FMAT, ...) do not affect the image
+}
+
+void ExcellonReader::parseUnit(const QByteArray& line) noexcept
+{
+    QList<QByteArray> tokens = line.split(',');
+    bool metric = tokens.first().startsWith("METRIC");
+    mUnit = metric ? 1000000 : 25400000;
+    mIntegerDigits = metric ? 3 : 2;
+    mDecimalDigits = metric ? 3 : 4;
+    for (int i = 1; i < tokens.count(); ++i) {
+        if (tokens.at(i) == "LZ") {
+            mLeadingZeros = true;
+        } else if (tokens.at(i) == "TZ") {
+            mLeadingZeros = false;
+        } else if (tokens.at(i).contains('.')) {
+            // number format, e.g. "000.000"
+            mIntegerDigits = tokens.at(i).indexOf('.');
+            mDecimalDigits = tokens.at(i).length() - mIntegerDigits - 1;
+        }
+    }
+}
+
+void ExcellonReader::parseTool(const QByteArray& line)
+{
+    static const QRegularExpression regex("^T(\\d+)(?:[A-BD-Z][-+\\d.]*)*(?:C([\\d.]+))?");
+    QRegularExpressionMatch match = regex.match(QString(line));
+    if (!match.hasMatch()) {
+        throw createError(QString(tr("Invalid tool \"%1\".")).arg(QString(line)));
+    }
+    int number = match.captured(1).toInt();
+    if (!match.captured(2).isEmpty()) {
+        mTools.insert(number, match.captured(2).toDouble() * mUnit); // tool definition
+    } else if ((number == 0) || mTools.contains(number)) {
+        mCurrentTool = number; // tool selection
+    } else {
+        throw createError(QString(tr("Undefined tool T%1.")).arg(number));
+    }
+}
+
+void ExcellonReader::parseCoordinates(const QByteArray& line)
+{
+    if (!mTools.contains(mCurrentTool)) {
+        throw createError(tr("No tool selected."));
+    }
+    qreal diameter = mTools.value(mCurrentTool);
+    int slotIndex = line.indexOf("G85");
+    if (slotIndex >= 0) {
+        QPointF start = parsePosition(line.left(slotIndex)); // can throw
+        QPointF end = parsePosition(line.mid(slotIndex + 3)); // can throw
+        QPainterPath path(start);
+        path.lineTo(end);
+        mImage.addStrokedPath(path, diameter, true);
+        mPosition = end;
+    } else {
+        mPosition = parsePosition(line); // can throw
+        QPainterPath path;
+        path.addEllipse(mPosition, diameter / 2, diameter / 2);
+        mImage.addFilledPath(path, true);
+    }
+}
+
+QPointF ExcellonReader::parsePosition(const QByteArray& str) const
+{
+    static const QRegularExpression regex("^(?:X([-+]?[\\d.]+))?(?:Y([-+]?[\\d.]+))?$");
+    QRegularExpressionMatch match = regex.match(QString(str));
+    if (!match.hasMatch()) {
+        throw createError(QString(tr("Invalid coordinates \"%1\".")).arg(QString(str)));
+    }
+    QPointF pos = mPosition;
+    if (!match.captured(1).isEmpty()) pos.setX(parseCoordinate(match.captured(1).toLatin1()));
+    if (!match.captured(2).isEmpty()) pos.setY(parseCoordinate(match.captured(2).toLatin1()));
+    return pos;
+}
+
+qreal ExcellonReader::parseCoordinate(const QByteArray& str) const
+{
+    bool ok = false;
+    qreal value = str.toDouble(&ok);
+    if (!ok) {
+        throw createError(QString(tr("Invalid coordinate \"%1\".")).arg(QString(str)));
+    }
+    if (!str.contains('.')) {
+        int decimals = mDecimalDigits;
+        if (mLeadingZeros) {
+            int digits = str.length() - ((str.startsWith('-') || str.startsWith('+')) ? 1 : 0);
+            decimals -= mIntegerDigits + mDecimalDigits - digits;
+        }
+        value /= qPow(10, decimals);
+    }
+    return value * mUnit;
+}
+
+RuntimeError ExcellonReader::createError(const QString& msg) const noexcept
+{
+    return RuntimeError(__FILE__, __LINE__, QString(tr("Invalid Excellon data in line "
+        "%1: %2")).arg(mLineNumber).arg(msg));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,130 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_EXCELLONREADER_H
+#define LIBREPCB_EXCELLONREADER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../exceptions.h"
+#include "camimage.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+/*****************************************************************************************
+ *  Class ExcellonReader
+ ****************************************************************************************/
+
+/**
+ * @brief The ExcellonReader class parses Excellon drill files into a librepcb::CamImage
+ *
+ * Holes are added as filled circles and slots (G85) as stroked lines with the tool
+ * diameter, both in the same coordinate system as the images of
+ * librepcb::GerberReader. Metric and inch units are supported, with or without decimal
+ * points in the coordinates. Routing commands (G00, M15, ...) and incremental
+ * coordinates are not supported and lead to an exception.
+ */
+class ExcellonReader final
+{
+        Q_DECLARE_TR_FUNCTIONS(ExcellonReader)
+
+    public:
+
+        // Constructors / Destructor
+        ExcellonReader() = delete;
+        ExcellonReader(const ExcellonReader& other) = delete;
+        ~ExcellonReader() noexcept;
+
+        // Static Methods
+
+        /**
+         * @brief Read an Excellon file
+         *
+         * @param filepath  The file to read
+         *
+         * @return The image of the file
+         *
+         * @throw Exception If the file could not be read or is invalid
+         */
+        static CamImage readFile(const FilePath& filepath);
+
+        /**
+         * @brief Parse the content of an Excellon file
+         *
+         * @param content   The file content
+         *
+         * @return The image of the file
+         *
+         * @throw Exception If the content is invalid or uses unsupported commands
+         */
+        static CamImage read(const QByteArray& content);
+
+        // Operator Overloadings
+        ExcellonReader& operator=(const ExcellonReader& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        explicit ExcellonReader(const QByteArray& content) noexcept;
+        CamImage parse();
+        void parseLine(const QByteArray& line);
+        void parseUnit(const QByteArray& line) noexcept;
+        void parseTool(const QByteArray& line);
+        void parseCoordinates(const QByteArray& line);
+        QPointF parsePosition(const QByteArray& str) const;
+        qreal parseCoordinate(const QByteArray& str) const;
+        RuntimeError createError(const QString& msg) const noexcept;
+
+
+        // Input
+        QByteArray mContent;
+        int mLineNumber;
+
+        // Format
+        qreal mUnit;                ///< nanometers per file unit
+        bool mLeadingZeros;         ///< true = trailing zeros are omitted (LZ)
+        int mIntegerDigits;
+        int mDecimalDigits;
+
+        // State
+        QHash<int, qreal> mTools;   ///< key: tool number; value: diameter [nm]
+        int mCurrentTool;           ///< 0 = none
+        QPointF mPosition;
+        bool mEndOfFile;
+
+        // Output
+        CamImage mImage;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_EXCELLONREADER_H
@@ -32,7 +32,8 @@ namespace librepcb {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-GerberApertureList::GerberApertureList() noexcept
+GerberApertureList::GerberApertureList() noexcept :
+    mCurrentApertureFunction(-1)
 {
 }
 
@@ -51,8 +52,21 @@ QString GerberApertureList::generateString() const noexcept
     foreach (const QString& macro, mApertureMacros) {
         str.append(QString("%AM%1*%\n").arg(macro));
     }
-    foreach (int number, mApertures.keys()) {
-        str.append(QString("%ADD%1%2*%\n").arg(number).arg(mApertures.value(number)));
+    int function = -1;
+    for (auto it = mApertures.constBegin(); it != mApertures.constEnd(); ++it) {
+        // the attribute applies to all following aperture definitions
+        if (it.value().function != function) {
+            function = it.value().function;
+            if (function >= 0) {
+                str.append(QString("%TA.AperFunction,%1*%\n").arg(mApertureFunctions.at(function)));
+            } else {
+                str.append("%TD.AperFunction*%\n");
+            }
+        }
+        str.append(QString("%ADD%1%2*%\n").arg(it.key()).arg(generateAperture(it.value())));
+    }
+    if (function >= 0) {
+        str.append("%TD.AperFunction*%\n");
     }
     str.append("G04 --- APERTURE LIST END --- *\n");
     return str;
@@ -64,15 +78,15 @@ QString GerberApertureList::generateString() const noexcept
 
 int GerberApertureList::setCircle(const Length& dia, const Length& hole)
 {
-    return setCurrentAperture(generateCircle(dia, hole));
+    return setCurrentAperture(Aperture{Shape::Circle, dia, Length(0), Angle(0), 0, hole, -1});
 }
 
 int GerberApertureList::setRect(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateRect(w, h, hole));
+        return setCurrentAperture(Aperture{Shape::Rect, w, h, Angle(0), 0, hole, -1});
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateRect(h, w, hole));
+        return setCurrentAperture(Aperture{Shape::Rect, h, w, Angle(0), 0, hole, -1});
     } else {
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
         if (hole > 0) {
@@ -80,16 +94,16 @@ int GerberApertureList::setRect(const Length& w, const Length& h, const Angle& r
         } else {
             addMacro(generateRotatedRectMacro());
         }
-        return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+        return setCurrentAperture(Aperture{Shape::RotatedRect, w, h, rot, 0, hole, -1});
     }
 }
 
 int GerberApertureList::setObround(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateObround(w, h, hole));
+        return setCurrentAperture(Aperture{Shape::Obround, w, h, Angle(0), 0, hole, -1});
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateObround(h, w, hole));
+        return setCurrentAperture(Aperture{Shape::Obround, h, w, Angle(0), 0, hole, -1});
     } else {
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
         if (hole > 0) {
@@ -97,7 +111,7 @@ int GerberApertureList::setObround(const Length& w, const Length& h, const Angle
         } else {
             addMacro(generateRotatedObroundMacro());
         }
-        return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+        return setCurrentAperture(Aperture{Shape::RotatedObround, w, h, rot, 0, hole, -1});
     }
 }
 
@@ -108,26 +122,44 @@ int GerberApertureList::setRegularPolygon(const Length& dia, int n, const Angle&
     }
     // Adjust rotation as its interpretation differs between LibrePCB and Gerber specs
     Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-    return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+    return setCurrentAperture(Aperture{Shape::RegularPolygon, dia, Length(0), grbRot, n, hole, -1});
+}
+
+void GerberApertureList::setApertureFunction(const QString& function) noexcept
+{
+    if (function.isEmpty()) {
+        mCurrentApertureFunction = -1;
+    } else {
+        mCurrentApertureFunction = mApertureFunctions.indexOf(function);
+        if (mCurrentApertureFunction < 0) {
+            mCurrentApertureFunction = mApertureFunctions.count();
+            mApertureFunctions.append(function);
+        }
+    }
 }
 
 void GerberApertureList::reset() noexcept
 {
     //mApertureMacros.clear();
     mApertures.clear();
+    mApertureNumbers.clear();
+    mApertureFunctions.clear();
+    mCurrentApertureFunction = -1;
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept
+int GerberApertureList::setCurrentAperture(Aperture aperture) noexcept
 {
-    int number = mApertures.key(aperture, -1);
+    aperture.function = mCurrentApertureFunction;
+    int number = mApertureNumbers.value(aperture, -1);
     if (number < 0) {
         number = mApertures.count() + 10; // 10 is the number of the first aperture
         Q_ASSERT(!mApertures.contains(number));
         mApertures.insert(number, aperture);
+        mApertureNumbers.insert(aperture, number);
     }
     return number;
 }
@@ -143,6 +175,19 @@ void GerberApertureList::addMacro(const QString& macro) noexcept
  *  Aperture Generator Methods
  ****************************************************************************************/
 
+QString GerberApertureList::generateAperture(const Aperture& a) noexcept
+{
+    switch (a.shape) {
+        case Shape::Circle:         return generateCircle(a.width, a.hole);
+        case Shape::Rect:           return generateRect(a.width, a.height, a.hole);
+        case Shape::Obround:        return generateObround(a.width, a.height, a.hole);
+        case Shape::RegularPolygon: return generateRegularPolygon(a.width, a.vertices, a.rotation, a.hole);
+        case Shape::RotatedRect:    return generateRotatedRect(a.width, a.height, a.rotation, a.hole);
+        case Shape::RotatedObround: return generateRotatedObround(a.width, a.height, a.rotation, a.hole);
+        default:                    Q_ASSERT(false); return QString();
+    }
+}
+
 QString GerberApertureList::generateCircle(const Length& dia, const Length& hole) noexcept
 {
     if (hole > 0) {
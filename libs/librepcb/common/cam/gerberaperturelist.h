@@ -41,6 +41,10 @@ namespace librepcb {
 /**
  * @brief The GerberApertureList class
  *
+ * Apertures are identified by a typed key (shape and dimensions) which is looked up in a
+ * hash table, so setting the current aperture is cheap even for boards with thousands
+ * of flashes. The aperture definition strings are only generated in #generateString().
+ *
  * @author ubruhin
  * @date 2016-03-31
  */
@@ -64,6 +68,16 @@ class GerberApertureList final
         int setRect(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept;
         int setObround(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept;
         int setRegularPolygon(const Length& dia, int n, const Angle& rot, const Length& hole) noexcept;
+
+        /**
+         * @brief Set the X2 aperture function (".AperFunction") of the following apertures
+         *
+         * Apertures with the same shape but different functions get different numbers.
+         *
+         * @param function  The function (e.g. "ViaPad"), or an empty string for none
+         */
+        void setApertureFunction(const QString& function) noexcept;
+
         void reset() noexcept;
 
         // Operator Overloadings
@@ -72,9 +86,34 @@ class GerberApertureList final
 
     private:
 
+        // Types
+        enum class Shape {Circle, Rect, Obround, RegularPolygon, RotatedRect, RotatedObround};
+        struct Aperture {
+            Shape shape;
+            Length width;   ///< width or diameter
+            Length height;  ///< height (unused for circles and polygons)
+            Angle rotation; ///< rotation (only used for polygons and rotated shapes)
+            int vertices;   ///< count of vertices (only used for polygons)
+            Length hole;
+            int function;   ///< index in #mApertureFunctions (-1 = none)
+            bool operator==(const Aperture& rhs) const noexcept {
+                return (shape == rhs.shape) && (width == rhs.width) && (height == rhs.height)
+                    && (rotation == rhs.rotation) && (vertices == rhs.vertices)
+                    && (hole == rhs.hole) && (function == rhs.function);
+            }
+            friend uint qHash(const Aperture& key, uint seed = 0) noexcept {
+                return qHash(qMakePair(qMakePair(static_cast<int>(key.shape) + (key.function << 8),
+                                                 key.vertices),
+                                       qMakePair(qMakePair(key.width.toNm(), key.height.toNm()),
+                                                 qMakePair(key.rotation.toMicroDeg(),
+                                                           key.hole.toNm()))), seed);
+            }
+        };
+
         // Private Methods
-        int setCurrentAperture(const QString& aperture) noexcept;
+        int setCurrentAperture(Aperture aperture) noexcept;
         void addMacro(const QString& macro) noexcept;
+        static QString generateAperture(const Aperture& aperture) noexcept;
 
         // Aperture Generator Methods
         static QString generateCircle(const Length& dia, const Length& hole) noexcept;
@@ -90,7 +129,10 @@ class GerberApertureList final
 
 
         QList<QString> mApertureMacros;
-        QMap<int, QString> mApertures; ///< key: aperture number (>= 10); value: aperture definition
+        QMap<int, Aperture> mApertures; ///< key: aperture number (>= 10); value: aperture
+        QHash<Aperture, int> mApertureNumbers; ///< reverse lookup of #mApertures
+        QStringList mApertureFunctions; ///< all used aperture functions
+        int mCurrentApertureFunction; ///< index in #mApertureFunctions (-1 = none)
 };
 
 /*****************************************************************************************
@@ -23,9 +23,10 @@
 #include <QtCore>
 #include "gerbergenerator.h"
 #include "gerberaperturelist.h"
+#include "camnumberformatter.h"
 #include "../geometry/ellipse.h"
 #include "../geometry/polygon.h"
-#include "../fileio/smarttextfile.h"
+#include "../fileio/fileutils.h"
 #include "../application.h"
 
 /*****************************************************************************************
@@ -40,7 +41,10 @@ namespace librepcb {
 GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
                                  const QString& projRevision) noexcept :
     mProjectId(escapeString(projName)), mProjectUuid(projUuid),
-    mProjectRevision(escapeString(projRevision)), mOutput(), mContent(),
+    mProjectRevision(escapeString(projRevision)), mFileFunction(),
+    mFilePolarity(LayerPolarity::Positive), mStepAndRepeatColumns(1), mStepAndRepeatRows(1),
+    mStepAndRepeatX(0), mStepAndRepeatY(0), mContentBuffer(), mContentSpool(),
+    mContentSpoolInUse(false), mContentSpoolSize(0), mContentSpoolError(),
     mApertureList(new GerberApertureList()), mCurrentApertureNumber(-1),
     mMultiQuadrantArcModeOn(false)
 {
@@ -50,6 +54,26 @@ GerberGenerator::~GerberGenerator() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  File Attributes
+ ****************************************************************************************/
+
+void GerberGenerator::setFileFunction(const QString& function, LayerPolarity polarity) noexcept
+{
+    mFileFunction = function;
+    mFilePolarity = polarity;
+}
+
+void GerberGenerator::setStepAndRepeat(int columns, int rows, const Length& stepX,
+                                       const Length& stepY) noexcept
+{
+    Q_ASSERT((columns >= 1) && (rows >= 1));
+    mStepAndRepeatColumns = qMax(columns, 1);
+    mStepAndRepeatRows = qMax(rows, 1);
+    mStepAndRepeatX = stepX;
+    mStepAndRepeatY = stepY;
+}
+
 /*****************************************************************************************
  *  Plot Methods
  ****************************************************************************************/
@@ -58,12 +82,17 @@ void GerberGenerator::setLayerPolarity(LayerPolarity p) noexcept
 {
     switch (p)
     {
-        case LayerPolarity::Positive: mContent.append("%LPD*%\n"); break;
-        case LayerPolarity::Negative: mContent.append("%LPC*%\n"); break;
+        case LayerPolarity::Positive: appendContent("%LPD*%\n"); break;
+        case LayerPolarity::Negative: appendContent("%LPC*%\n"); break;
         default: qCritical() << "Invalid Layer Polarity:" << static_cast<int>(p); break;
     }
 }
 
+void GerberGenerator::setApertureFunction(const QString& function) noexcept
+{
+    mApertureList->setApertureFunction(function);
+}
+
 void GerberGenerator::drawLine(const Point& start, const Point& end, const Length& width) noexcept
 {
     setCurrentAperture(mApertureList->setCircle(width, Length(0)));
@@ -191,26 +220,42 @@ void GerberGenerator::flashRegularPolygon(const Point& pos, const Length& dia, i
 
 void GerberGenerator::reset() noexcept
 {
-    mOutput.clear();
-    mContent.clear();
+    mContentBuffer.clear();
+    mContentSpool.reset();
+    mContentSpoolInUse = false;
+    mContentSpoolSize = 0;
+    mContentSpoolError.clear();
     mApertureList->reset();
     mCurrentApertureNumber = -1;
 }
 
-void GerberGenerator::generate()
+void GerberGenerator::generate(QIODevice& device)
 {
-    mOutput.clear();
-    printHeader();
-    printApertureList();
-    printContent();
-    printFooter();
+    // The aperture list has to be written before the content, but it is only complete
+    // after all content was added. Thus the content is spooled to a temporary file
+    // and copied to the device after writing the header and the aperture list. The
+    // checksum is calculated on the fly while writing.
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    printHeader(device, hash); // can throw
+    writeString(device, hash, mApertureList->generateString()); // can throw
+    printContent(device, hash); // can throw
+    printFooter(device, hash); // can throw
 }
 
-void GerberGenerator::saveToFile(const FilePath& filepath) const
+void GerberGenerator::saveToFile(const FilePath& filepath)
 {
-    QScopedPointer<SmartTextFile> file(SmartTextFile::create(filepath));
-    file->setContent(mOutput.toLatin1());
-    file->save(true);
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    generate(file); // can throw
+    if (!file.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
 }
 
 /*****************************************************************************************
@@ -220,25 +265,30 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const
 void GerberGenerator::setCurrentAperture(int number) noexcept
 {
     if (number != mCurrentApertureNumber) {
-        mContent.append(QString("D%1*\n").arg(number));
+        char buffer[CamNumberFormatter::sMaxIntegerLength + 8];
+        char* out = buffer;
+        *out++ = 'D';
+        out = CamNumberFormatter::writeInteger(out, number);
+        out = CamNumberFormatter::writeString(out, "*\n");
+        appendContent(buffer, out - buffer);
         mCurrentApertureNumber = number;
     }
 }
 
 void GerberGenerator::setRegionModeOn() noexcept
 {
-    mContent.append("G36*\n");
+    appendContent("G36*\n");
 }
 
 void GerberGenerator::setRegionModeOff() noexcept
 {
-    mContent.append("G37*\n");
+    appendContent("G37*\n");
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOn() noexcept
 {
     if (!mMultiQuadrantArcModeOn) {
-        mContent.append("G75*\n");
+        appendContent("G75*\n");
         mMultiQuadrantArcModeOn = true;
     }
 }
@@ -246,36 +296,34 @@ void GerberGenerator::setMultiQuadrantArcModeOn() noexcept
 void GerberGenerator::setMultiQuadrantArcModeOff() noexcept
 {
     if (mMultiQuadrantArcModeOn) {
-        mContent.append("G74*\n");
+        appendContent("G74*\n");
         mMultiQuadrantArcModeOn = false;
     }
 }
 
 void GerberGenerator::switchToLinearInterpolationModeG01() noexcept
 {
-    mContent.append("G01*\n");
+    appendContent("G01*\n");
 }
 
 void GerberGenerator::switchToCircularCwInterpolationModeG02() noexcept
 {
-    mContent.append("G02*\n");
+    appendContent("G02*\n");
 }
 
 void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept
 {
-    mContent.append("G03*\n");
+    appendContent("G03*\n");
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D02*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendPositionCommand(pos, "D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D01*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendPositionCommand(pos, "D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept
@@ -284,83 +332,212 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start, const Po
     if (!mMultiQuadrantArcModeOn) {
         diff.makeAbs(); // no sign allowed in single quadrant mode!
     }
-    mContent.append(QString("X%1Y%2I%3J%4D01*\n").arg(end.getX().toNmString(),
-                                                      end.getY().toNmString(),
-                                                      diff.getX().toNmString(),
-                                                      diff.getY().toNmString()));
+    char buffer[4 * (CamNumberFormatter::sMaxIntegerLength + 1) + 8];
+    char* out = buffer;
+    *out++ = 'X';
+    out = CamNumberFormatter::writeInteger(out, end.getX().toNm());
+    *out++ = 'Y';
+    out = CamNumberFormatter::writeInteger(out, end.getY().toNm());
+    *out++ = 'I';
+    out = CamNumberFormatter::writeInteger(out, diff.getX().toNm());
+    *out++ = 'J';
+    out = CamNumberFormatter::writeInteger(out, diff.getY().toNm());
+    out = CamNumberFormatter::writeString(out, "D01*\n");
+    appendContent(buffer, out - buffer);
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D03*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendPositionCommand(pos, "D03*\n");
 }
 
-void GerberGenerator::printHeader() noexcept
+void GerberGenerator::appendPositionCommand(const Point& pos, const char* dcode) noexcept
 {
-    mOutput.append("G04 --- HEADER BEGIN --- *\n");
+    // formatted without any heap allocation as this is by far the most frequent command
+    char buffer[2 * (CamNumberFormatter::sMaxIntegerLength + 1) + 8];
+    char* out = buffer;
+    *out++ = 'X';
+    out = CamNumberFormatter::writeInteger(out, pos.getX().toNm());
+    *out++ = 'Y';
+    out = CamNumberFormatter::writeInteger(out, pos.getY().toNm());
+    out = CamNumberFormatter::writeString(out, dcode);
+    appendContent(buffer, out - buffer);
+}
+
+void GerberGenerator::appendContent(const QString& data) noexcept
+{
+    // all commands in the content are plain ASCII, so Latin-1 is equal to UTF-8 here
+    mContentBuffer.append(data.toLatin1());
+    if (mContentBuffer.size() >= 65536) {
+        flushContentBuffer();
+    }
+}
+
+void GerberGenerator::appendContent(const char* data, int size) noexcept
+{
+    mContentBuffer.append(data, (size >= 0) ? size : int(qstrlen(data)));
+    if (mContentBuffer.size() >= 65536) {
+        flushContentBuffer();
+    }
+}
+
+void GerberGenerator::flushContentBuffer() noexcept
+{
+    if (!mContentSpool) {
+        mContentSpool.reset(new QTemporaryFile());
+        mContentSpoolInUse = mContentSpool->open();
+        if (!mContentSpoolInUse) {
+            qWarning() << "Could not create temporary gerber file, keeping it in memory:"
+                       << mContentSpool->errorString();
+        }
+    }
+    if (mContentSpoolInUse && (!mContentBuffer.isEmpty())) {
+        if (mContentSpool->write(mContentBuffer) == mContentBuffer.size()) {
+            mContentSpoolSize += mContentBuffer.size();
+            mContentBuffer.clear();
+        } else {
+            qWarning() << "Could not write temporary gerber file, keeping it in memory:"
+                       << mContentSpool->errorString();
+            stopUsingContentSpool();
+        }
+    }
+}
+
+void GerberGenerator::stopUsingContentSpool() noexcept
+{
+    // move the already spooled content back into memory (without the bytes of a
+    // partially failed write, since only successful writes are counted)
+    QByteArray spooled;
+    if (mContentSpool->seek(0)) {
+        spooled = mContentSpool->read(mContentSpoolSize);
+    }
+    if (spooled.size() == mContentSpoolSize) {
+        mContentBuffer.prepend(spooled);
+    } else {
+        mContentSpoolError = mContentSpool->errorString();
+        qCritical() << "Could not read temporary gerber file:" << mContentSpoolError;
+    }
+    mContentSpool->close();
+    mContentSpoolInUse = false;
+    mContentSpoolSize = 0;
+}
+
+void GerberGenerator::printHeader(QIODevice& device, QCryptographicHash& hash) const
+{
+    QString header("G04 --- HEADER BEGIN --- *\n");
 
     // add some X2 attributes
     QString appVersion = qApp->getAppVersion().toPrettyStr(3);
     QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
-    QString projId = mProjectId.remove(',');
+    QString projId = QString(mProjectId).remove(',');
     QString projUuid = mProjectUuid.toStr();
-    QString projRevision = mProjectRevision.remove(',');
-    mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(appVersion));
-    mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
-    mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(projId, projUuid, projRevision));
-    mOutput.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
-    //mOutput.append("%TF.FilePolarity,Positive*%\n");
+    QString projRevision = QString(mProjectRevision).remove(',');
+    header.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(appVersion));
+    header.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
+    header.append(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(projId, projUuid, projRevision));
+    if (isPanel()) {
+        header.append("%TF.Part,Array*%\n"); // "Array" means "this is a panel"
+    } else {
+        header.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
+    }
+    if (!mFileFunction.isEmpty()) {
+        header.append(QString("%TF.FileFunction,%1*%\n").arg(mFileFunction));
+        header.append(QString("%TF.FilePolarity,%1*%\n").arg(
+            (mFilePolarity == LayerPolarity::Positive) ? "Positive" : "Negative"));
+    }
 
     // coordinate format specification:
     //  - leading zeros omitted
     //  - absolute coordinates
     //  - coordiante format "6.6" --> allows us to directly use LengthBase_t (nanometers)!
-    mOutput.append("%FSLAX66Y66*%\n");
+    header.append("%FSLAX66Y66*%\n");
 
     // set unit to millimeters
-    mOutput.append("%MOMM*%\n");
+    header.append("%MOMM*%\n");
 
     // start linear interpolation mode
-    mOutput.append("G01*\n");
+    header.append("G01*\n");
 
     // use single quadrant arc mode
-    mOutput.append("G74*\n");
-
-    mOutput.append("G04 --- HEADER END --- *\n");
-}
+    header.append("G74*\n");
 
-void GerberGenerator::printApertureList() noexcept
-{
-    mOutput.append(mApertureList->generateString());
+    header.append("G04 --- HEADER END --- *\n");
+    writeString(device, hash, header); // can throw
 }
 
-void GerberGenerator::printContent() noexcept
+void GerberGenerator::printContent(QIODevice& device, QCryptographicHash& hash)
 {
-    mOutput.append("G04 --- BOARD BEGIN --- *\n");
-    mOutput.append(mContent);
-    mOutput.append("G04 --- BOARD END --- *\n");
+    writeString(device, hash, "G04 --- BOARD BEGIN --- *\n"); // can throw
+    if (isPanel()) {
+        writeString(device, hash, QString("%SRX%1Y%2I%3J%4*%\n")
+                    .arg(mStepAndRepeatColumns).arg(mStepAndRepeatRows)
+                    .arg(mStepAndRepeatX.toMmString(), mStepAndRepeatY.toMmString())); // can throw
+    }
+    flushContentBuffer();
+    if (!mContentSpoolError.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not read "
+            "temporary gerber file: %1")).arg(mContentSpoolError));
+    }
+    if (mContentSpoolInUse) {
+        if (!mContentSpool->seek(0)) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not read "
+                "temporary gerber file: %1")).arg(mContentSpool->errorString()));
+        }
+        qint64 remaining = mContentSpoolSize;
+        while (remaining > 0) {
+            QByteArray chunk = mContentSpool->read(qMin(remaining, qint64(65536)));
+            if (chunk.isEmpty()) {
+                throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not read "
+                    "temporary gerber file: %1")).arg(mContentSpool->errorString()));
+            }
+            writeData(device, hash, chunk); // can throw
+            remaining -= chunk.size();
+        }
+    }
+    writeData(device, hash, mContentBuffer); // can throw
+    if (isPanel()) {
+        writeString(device, hash, "%SR*%\n"); // can throw
+    }
+    writeString(device, hash, "G04 --- BOARD END --- *\n"); // can throw
 }
 
-void GerberGenerator::printFooter() noexcept
+void GerberGenerator::printFooter(QIODevice& device, const QCryptographicHash& hash) const
 {
-    // MD5 checksum over content
-    mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
+    // MD5 checksum over content (the footer itself is not part of the checksum)
+    QString checksum = QString(hash.result().toHex());
+    write(device, QString("%TF.MD5,%1*%\n").arg(checksum).toLatin1()); // can throw
 
     // end of file
-    mOutput.append("M02*\n");
+    write(device, "M02*\n"); // can throw
 }
 
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+void GerberGenerator::writeString(QIODevice& device, QCryptographicHash& hash,
+                                  const QString& str)
 {
     // according to the RS-274C standard, linebreaks are not included in the checksum
-    QString data = QString(mOutput).remove(QChar('\n'));
-    return QString(QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+    hash.addData(QString(str).remove(QChar('\n')).toUtf8());
+    write(device, str.toLatin1()); // can throw
 }
 
-/*****************************************************************************************
- *  Static Methods
- ****************************************************************************************/
+void GerberGenerator::writeData(QIODevice& device, QCryptographicHash& hash,
+                                const QByteArray& data)
+{
+    // the data is plain ASCII, so it can be hashed without converting it to UTF-8
+    hash.addData(QByteArray(data).replace('\n', QByteArray()));
+    write(device, data); // can throw
+}
+
+void GerberGenerator::write(QIODevice& device, const QByteArray& data)
+{
+    if (device.write(data) != data.size()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write gerber "
+            "data: %1")).arg(device.errorString()));
+    }
+}
 
 QString GerberGenerator::escapeString(const QString& str) noexcept
 {
@@ -46,7 +46,9 @@ class GerberApertureList;
  * @brief The GerberGenerator class
  *
  * @todo Remove/Escape illegal characters in #mProjectId and #mProjectRevision!
- * @todo Use file/aperture attributes
+ *
+ * Panels are generated with a step and repeat block (see #setStepAndRepeat()), so the
+ * content of the board is contained only once, independent of the count of copies.
  *
  * @author ubruhin
  * @date 2016-01-10
@@ -69,11 +71,38 @@ class GerberGenerator final
                         const QString& projRevision) noexcept;
         ~GerberGenerator() noexcept;
 
-        // Getters
-        const QString& toStr() const noexcept {return mOutput;}
+        // File Attributes
+
+        /**
+         * @brief Set the X2 file function and polarity (".FileFunction", ".FilePolarity")
+         *
+         * @param function  The file function (e.g. "Copper,L1,Top")
+         * @param polarity  Whether the image shows material (e.g. copper) or the
+         *                  absence of material (e.g. solder mask openings)
+         */
+        void setFileFunction(const QString& function, LayerPolarity polarity) noexcept;
+
+        /**
+         * @brief Repeat the whole content as a grid of copies (panel)
+         *
+         * @param columns   Count of copies in X direction (>= 1)
+         * @param rows      Count of copies in Y direction (>= 1)
+         * @param stepX     Distance between the columns
+         * @param stepY     Distance between the rows
+         */
+        void setStepAndRepeat(int columns, int rows, const Length& stepX,
+                              const Length& stepY) noexcept;
 
         // Plot Methods
         void setLayerPolarity(LayerPolarity p) noexcept;
+
+        /**
+         * @brief Set the X2 aperture function of all following draw and flash operations
+         *
+         * @param function  The function (e.g. "SMDPad,CuDef"), or an empty string for none
+         */
+        void setApertureFunction(const QString& function) noexcept;
+
         void drawLine(const Point& start, const Point& end, const Length& width) noexcept;
         void drawEllipseOutline(const Ellipse& ellipse) noexcept;
         void drawEllipseArea(const Ellipse& ellipse) noexcept;
@@ -86,8 +115,19 @@ class GerberGenerator final
 
         // General Methods
         void reset() noexcept;
-        void generate();
-        void saveToFile(const FilePath& filepath) const;
+
+        /**
+         * @brief Write the whole gerber file to a device
+         *
+         * The content is streamed to the device (and the checksum is calculated on
+         * the fly), so the complete file never needs to be kept in memory.
+         *
+         * @param device    An open, writable device
+         *
+         * @throw Exception if writing to the device failed
+         */
+        void generate(QIODevice& device);
+        void saveToFile(const FilePath& filepath);
 
         // Operator Overloadings
         GerberGenerator& operator=(const GerberGenerator& rhs) = delete;
@@ -108,13 +148,20 @@ class GerberGenerator final
         void linearInterpolateToPosition(const Point& pos) noexcept;
         void circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept;
         void flashAtPosition(const Point& pos) noexcept;
-        void printHeader() noexcept;
-        void printApertureList() noexcept;
-        void printContent() noexcept;
-        void printFooter() noexcept;
-        QString calcOutputMd5Checksum() const noexcept;
+        void appendPositionCommand(const Point& pos, const char* dcode) noexcept;
+        void appendContent(const QString& data) noexcept;
+        void appendContent(const char* data, int size = -1) noexcept;
+        void flushContentBuffer() noexcept;
+        void stopUsingContentSpool() noexcept;
+        bool isPanel() const noexcept {return mStepAndRepeatColumns * mStepAndRepeatRows > 1;}
+        void printHeader(QIODevice& device, QCryptographicHash& hash) const;
+        void printContent(QIODevice& device, QCryptographicHash& hash);
+        void printFooter(QIODevice& device, const QCryptographicHash& hash) const;
 
         // Static Methods
+        static void writeString(QIODevice& device, QCryptographicHash& hash, const QString& str);
+        static void writeData(QIODevice& device, QCryptographicHash& hash, const QByteArray& data);
+        static void write(QIODevice& device, const QByteArray& data);
         static QString escapeString(const QString& str) noexcept;
 
 
@@ -122,10 +169,21 @@ class GerberGenerator final
         QString mProjectId;
         Uuid mProjectUuid;
         QString mProjectRevision;
+        QString mFileFunction;
+        LayerPolarity mFilePolarity;
+
+        // Step and Repeat
+        int mStepAndRepeatColumns;
+        int mStepAndRepeatRows;
+        Length mStepAndRepeatX;
+        Length mStepAndRepeatY;
 
         // Gerber Data
-        QString mOutput;
-        QString mContent;
+        QByteArray mContentBuffer; ///< content not yet written to #mContentSpool
+        QScopedPointer<QTemporaryFile> mContentSpool; ///< temporary file for the content
+        bool mContentSpoolInUse;    ///< whether #mContentSpool contains the first content
+        qint64 mContentSpoolSize;   ///< count of bytes successfully written to the spool
+        QString mContentSpoolError; ///< set if spooled content was lost (export fails)
         QScopedPointer<GerberApertureList> mApertureList;
         int mCurrentApertureNumber;
         bool mMultiQuadrantArcModeOn;
@@ -0,0 +1,822 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "gerberreader.h"
+#include "../fileio/filepath.h"
+#include "../fileio/fileutils.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace {
+
+/// Maximum deviation of flattened arcs from the exact arc, in nanometers
+const qreal sArcTolerance = 100;
+
+qreal powerOfTen(int exponent) noexcept
+{
+    static const qreal table[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                  1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+    return ((exponent >= 0) && (exponent <= 18)) ? table[exponent] : qPow(10, exponent);
+}
+
+bool isDigit(char c) noexcept
+{
+    return (c >= '0') && (c <= '9');
+}
+
+int parseInteger(const char*& pos, const char* end) noexcept
+{
+    int value = 0;
+    while ((pos < end) && isDigit(*pos)) {
+        value = value * 10 + (*pos++ - '0');
+    }
+    return value;
+}
+
+/**
+ * @brief Evaluates arithmetic expressions of aperture macros (e.g. "$1x0.5+0.1")
+ */
+class ExpressionParser final
+{
+    public:
+        ExpressionParser(const QByteArray& expr, const QVector<qreal>& vars) noexcept :
+            mExpr(expr), mVars(vars), mPos(0), mOk(true) {}
+
+        qreal evaluate(bool& ok) noexcept
+        {
+            qreal value = parseSum();
+            ok = mOk && (mPos == mExpr.length());
+            return value;
+        }
+
+    private:
+        char peek() const noexcept {return (mPos < mExpr.length()) ? mExpr.at(mPos) : '\0';}
+
+        qreal parseSum() noexcept
+        {
+            qreal value = parseProduct();
+            while ((peek() == '+') || (peek() == '-')) {
+                char op = mExpr.at(mPos++);
+                qreal rhs = parseProduct();
+                value = (op == '+') ? (value + rhs) : (value - rhs);
+            }
+            return value;
+        }
+
+        qreal parseProduct() noexcept
+        {
+            qreal value = parseFactor();
+            while ((peek() == 'x') || (peek() == 'X') || (peek() == '/')) {
+                char op = mExpr.at(mPos++);
+                qreal rhs = parseFactor();
+                value = (op == '/') ? ((rhs != 0) ? (value / rhs) : 0) : (value * rhs);
+            }
+            return value;
+        }
+
+        qreal parseFactor() noexcept
+        {
+            char c = peek();
+            if ((c == '+') || (c == '-')) {
+                ++mPos;
+                qreal value = parseFactor();
+                return (c == '-') ? -value : value;
+            } else if (c == '(') {
+                ++mPos;
+                qreal value = parseSum();
+                if (peek() == ')') ++mPos; else mOk = false;
+                return value;
+            } else if (c == '$') {
+                ++mPos;
+                const char* begin = mExpr.constData() + mPos;
+                const char* pos = begin;
+                int index = parseInteger(pos, mExpr.constData() + mExpr.length());
+                mPos += pos - begin;
+                if (pos == begin) mOk = false;
+                return mVars.value(index - 1, 0); // undefined variables are zero
+            } else {
+                int begin = mPos;
+                while (isDigit(peek()) || (peek() == '.')) ++mPos;
+                bool ok = false;
+                qreal value = mExpr.mid(begin, mPos - begin).toDouble(&ok);
+                if (!ok) mOk = false;
+                return value;
+            }
+        }
+
+        const QByteArray& mExpr;
+        const QVector<qreal>& mVars;
+        int mPos;
+        bool mOk;
+};
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+GerberReader::GerberReader(const QByteArray& content) noexcept :
+    mContent(content), mBlockStart(0), mUnit(0), mIntegerDigits(0), mDecimalDigits(-1),
+    mOmitTrailingZeros(false), mCurrentAperture(-1), mDark(true),
+    mInterpolation(Interpolation::Linear), mMultiQuadrant(false), mRegionMode(false),
+    mEndOfFile(false), mLastOperation(-1), mTraceWidth(0), mRepeatX(0), mRepeatY(0)
+{
+}
+
+GerberReader::~GerberReader() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+CamImage GerberReader::readFile(const FilePath& filepath)
+{
+    return read(FileUtils::readFile(filepath)); // can throw
+}
+
+CamImage GerberReader::read(const QByteArray& content)
+{
+    GerberReader reader(content);
+    return reader.parse(); // can throw
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+CamImage GerberReader::parse()
+{
+    const char* data = mContent.constData();
+    int size = mContent.size();
+    int i = 0;
+    while ((i < size) && (!mEndOfFile)) {
+        char c = data[i];
+        if ((c == ' ') || (c == '\n') || (c == '\r') || (c == '\t')) {
+            ++i;
+            continue;
+        }
+        mBlockStart = i;
+        if (c == '%') {
+            int end = mContent.indexOf('%', i + 1);
+            if (end < 0) throw createError(tr("Unterminated extended command."));
+            parseExtendedCommand(mContent.mid(i + 1, end - i - 1)); // can throw
+            i = end + 1;
+        } else {
+            int end = mContent.indexOf('*', i);
+            if (end < 0) throw createError(tr("Unterminated command."));
+            parseWordCommand(data + i, data + end); // can throw
+            i = end + 1;
+        }
+    }
+    flushTrace();
+    flushContour();
+    flushStepAndRepeat();
+    return mImage;
+}
+
+void GerberReader::parseExtendedCommand(const QByteArray& content)
+{
+    QList<QByteArray> blocks = removeWhitespaces(content).split('*');
+    while ((!blocks.isEmpty()) && (blocks.last().isEmpty())) {
+        blocks.removeLast();
+    }
+    if (blocks.isEmpty()) return;
+    if (blocks.first().startsWith("AM")) {
+        parseApertureMacro(blocks); // can throw
+        return;
+    }
+    foreach (const QByteArray& block, blocks) {
+        QByteArray code = block.left(2);
+        if (code == "FS") {
+            parseFormatSpecification(block); // can throw
+        } else if (code == "MO") {
+            if (block == "MOMM") {
+                mUnit = 1000000;
+            } else if (block == "MOIN") {
+                mUnit = 25400000;
+            } else {
+                throw createError(QString(tr("Invalid unit \"%1\".")).arg(QString(block)));
+            }
+        } else if (code == "AD") {
+            parseApertureDefinition(block); // can throw
+        } else if (code == "LP") {
+            flushTrace();
+            if (block == "LPD") {
+                mDark = true;
+            } else if (block == "LPC") {
+                mDark = false;
+            } else {
+                throw createError(QString(tr("Invalid polarity \"%1\".")).arg(QString(block)));
+            }
+        } else if (code == "SR") {
+            parseStepAndRepeat(block); // can throw
+        } else if (((code == "LM") && (block != "LMN")) ||
+                   ((code == "LR") && (block.mid(2).toDouble() != 0)) ||
+                   ((code == "LS") && (block.mid(2).toDouble() != 1)) ||
+                   ((code == "MI") && (block != "MIA0B0")) ||
+                   ((code == "OF") && (block != "OFA0B0")) ||
+                   ((code == "SF") && (block != "SFA1B1")) ||
+                   ((code == "IR") && (block != "IR0")) ||
+                   ((code == "AS") && (block != "ASAXBY")))
+        {
+            throw createError(QString(tr("Image transformations are not supported "
+                "(\"%1\").")).arg(QString(block)));
+        }
+        // all other commands (attributes, image name, ...) do not affect the image
+    }
+}
+
+void GerberReader::parseFormatSpecification(const QByteArray& block)
+{
+    static const QRegularExpression regex("^FS([LTD]?)([AI])X(\\d)(\\d)Y(\\d)(\\d)$");
+    QRegularExpressionMatch match = regex.match(QString(block));
+    if (!match.hasMatch()) {
+        throw createError(QString(tr("Invalid format \"%1\".")).arg(QString(block)));
+    }
+    if (match.captured(2) == "I") {
+        throw createError(tr("Incremental coordinates are not supported."));
+    }
+    if ((match.captured(3) != match.captured(5)) || (match.captured(4) != match.captured(6))) {
+        throw createError(tr("Different X and Y coordinate formats are not supported."));
+    }
+    mOmitTrailingZeros = (match.captured(1) == "T");
+    mIntegerDigits = match.captured(3).toInt();
+    mDecimalDigits = match.captured(4).toInt();
+}
+
+void GerberReader::parseApertureDefinition(const QByteArray& block)
+{
+    static const QRegularExpression regex("^ADD(\\d+)([^,]+)(?:,(.*))?$");
+    QRegularExpressionMatch match = regex.match(QString(block));
+    if (!match.hasMatch()) {
+        throw createError(QString(tr("Invalid aperture \"%1\".")).arg(QString(block)));
+    }
+    if (mUnit <= 0) {
+        throw createError(tr("Aperture defined before the unit."));
+    }
+    QByteArray name = match.captured(2).toLatin1();
+    QVector<qreal> params;
+    if (!match.captured(3).isEmpty()) {
+        foreach (const QString& param, match.captured(3).split('X')) {
+            bool ok = false;
+            params.append(param.toDouble(&ok));
+            if (!ok) {
+                throw createError(QString(tr("Invalid aperture parameter \"%1\"."))
+                                  .arg(param));
+            }
+        }
+    }
+    Aperture aperture;
+    aperture.circleDiameter = -1;
+    if (mMacros.contains(name)) {
+        aperture.path = createMacroAperture(mMacros.value(name), params); // can throw
+    } else {
+        aperture.path = createStandardAperture(name, params); // can throw
+        if (name == "C") aperture.circleDiameter = params.value(0) * mUnit;
+    }
+    mApertures.insert(match.captured(1).toInt(), aperture);
+}
+
+void GerberReader::parseApertureMacro(const QList<QByteArray>& blocks)
+{
+    mMacros.insert(blocks.first().mid(2), blocks.mid(1));
+}
+
+void GerberReader::parseStepAndRepeat(const QByteArray& block)
+{
+    static const QRegularExpression regex("^SR(?:X(\\d+)Y(\\d+)I([\\d.]+)J([\\d.]+))?$");
+    QRegularExpressionMatch match = regex.match(QString(block));
+    if (!match.hasMatch()) {
+        throw createError(QString(tr("Invalid step & repeat \"%1\".")).arg(QString(block)));
+    }
+    flushTrace();
+    flushContour();
+    flushStepAndRepeat();
+    int x = match.captured(1).toInt();
+    int y = match.captured(2).toInt();
+    if ((x > 1) || (y > 1)) {
+        mRepeatX = x;
+        mRepeatY = qMax(y, 1);
+        mRepeatStep = QPointF(match.captured(3).toDouble(), match.captured(4).toDouble()) * mUnit;
+    }
+}
+
+void GerberReader::parseWordCommand(const char* pos, const char* end)
+{
+    if ((end - pos >= 3) && (qstrncmp(pos, "G04", 3) == 0)) {
+        return; // comment
+    }
+    QPointF coordinate = mPosition;
+    QPointF offset;
+    bool hasCoordinate = false;
+    int operation = -1;
+    while (pos < end) {
+        char letter = *pos++;
+        switch (letter) {
+            case 'X': coordinate.setX(parseCoordinate(pos, end)); hasCoordinate = true; break;
+            case 'Y': coordinate.setY(parseCoordinate(pos, end)); hasCoordinate = true; break;
+            case 'I': offset.setX(parseCoordinate(pos, end)); break;
+            case 'J': offset.setY(parseCoordinate(pos, end)); break;
+            case 'D': {
+                int code = parseInteger(pos, end);
+                if (code >= 10) {
+                    if (!mApertures.contains(code)) {
+                        throw createError(QString(tr("Undefined aperture D%1.")).arg(code));
+                    }
+                    flushTrace();
+                    mCurrentAperture = code;
+                } else {
+                    operation = code;
+                }
+                break;
+            }
+            case 'G': {
+                int code = parseInteger(pos, end);
+                switch (code) {
+                    case 1: mInterpolation = Interpolation::Linear; break;
+                    case 2: mInterpolation = Interpolation::Clockwise; break;
+                    case 3: mInterpolation = Interpolation::CounterClockwise; break;
+                    case 36: flushTrace(); mRegionMode = true; break;
+                    case 37: flushContour(); mRegionMode = false; break;
+                    case 70: mUnit = 25400000; break;
+                    case 71: mUnit = 1000000; break;
+                    case 74: mMultiQuadrant = false; break;
+                    case 75: mMultiQuadrant = true; break;
+                    case 91: throw createError(tr("Incremental coordinates are not supported."));
+                    default: break; // G54, G55, G90, ... do not affect the image
+                }
+                break;
+            }
+            case 'M': {
+                if (parseInteger(pos, end) == 2) mEndOfFile = true;
+                break;
+            }
+            case ' ': case '\n': case '\r': case '\t': break;
+            default: {
+                throw createError(QString(tr("Unexpected character \"%1\"."))
+                                  .arg(QChar(letter)));
+            }
+        }
+    }
+    if ((operation < 0) && hasCoordinate) {
+        operation = mLastOperation; // deprecated, but still used by some CAM tools
+    }
+    switch (operation) {
+        case -1: break;
+        case 1: interpolate(coordinate, offset); break; // can throw
+        case 2: flushTrace(); flushContour(); mPosition = coordinate; break;
+        case 3: mPosition = coordinate; flash(); break; // can throw
+        default: throw createError(QString(tr("Invalid operation D%1.")).arg(operation));
+    }
+    if (operation > 0) mLastOperation = operation;
+}
+
+void GerberReader::interpolate(const QPointF& end, const QPointF& offset)
+{
+    QVector<QPointF> points;
+    if (mInterpolation == Interpolation::Linear) {
+        points.append(end);
+    } else {
+        appendArc(points, mPosition, end, offset);
+    }
+    if (mRegionMode) {
+        if (mContour.isEmpty()) mContour.append(mPosition);
+        mContour += points;
+    } else {
+        const Aperture& aperture = getCurrentAperture(); // can throw
+        if (aperture.circleDiameter >= 0) {
+            if (mTrace.elementCount() > 500) flushTrace(); // keep the objects small
+            if (mTrace.isEmpty()) {
+                mTrace.moveTo(mPosition);
+                mTraceWidth = aperture.circleDiameter;
+            }
+            foreach (const QPointF& point, points) {
+                mTrace.lineTo(point);
+            }
+        } else {
+            QPointF start = mPosition;
+            foreach (const QPointF& point, points) {
+                appendSweptSegment(aperture, start, point);
+                start = point;
+            }
+        }
+    }
+    mPosition = end;
+}
+
+void GerberReader::flash()
+{
+    if (mRegionMode) {
+        throw createError(tr("Flashes are not allowed in regions."));
+    }
+    flushTrace();
+    const Aperture& aperture = getCurrentAperture(); // can throw
+    getTarget().addFilledPath(aperture.path.translated(mPosition), mDark);
+}
+
+void GerberReader::flushTrace() noexcept
+{
+    if (!mTrace.isEmpty()) {
+        getTarget().addStrokedPath(mTrace, mTraceWidth, mDark);
+        mTrace = QPainterPath();
+    }
+}
+
+void GerberReader::flushContour() noexcept
+{
+    if (mContour.count() >= 3) {
+        getTarget().addFilledPath(createPolygon(mContour), mDark);
+    }
+    mContour.clear();
+}
+
+void GerberReader::flushStepAndRepeat() noexcept
+{
+    if (mRepeatX > 0) {
+        for (int x = 0; x < mRepeatX; ++x) {
+            for (int y = 0; y < mRepeatY; ++y) {
+                mImage.append(mRepeatBlock, QPointF(mRepeatStep.x() * x, mRepeatStep.y() * y));
+            }
+        }
+        mRepeatBlock = CamImage();
+        mRepeatX = mRepeatY = 0;
+    }
+}
+
+CamImage& GerberReader::getTarget() noexcept
+{
+    return (mRepeatX > 0) ? mRepeatBlock : mImage;
+}
+
+const GerberReader::Aperture& GerberReader::getCurrentAperture() const
+{
+    auto it = mApertures.find(mCurrentAperture);
+    if (it == mApertures.end()) {
+        throw createError(tr("No aperture selected."));
+    }
+    return *it;
+}
+
+qreal GerberReader::parseCoordinate(const char*& pos, const char* end) const
+{
+    if ((mUnit <= 0) || (mDecimalDigits < 0)) {
+        throw createError(tr("Coordinates before the format and unit specification."));
+    }
+    bool negative = false;
+    if ((pos < end) && ((*pos == '+') || (*pos == '-'))) {
+        negative = (*pos++ == '-');
+    }
+    qint64 value = 0;
+    int digits = 0;
+    int decimals = -1; // -1 = no decimal point
+    while ((pos < end) && (isDigit(*pos) || (*pos == '.'))) {
+        if (*pos == '.') {
+            decimals = 0;
+        } else {
+            value = value * 10 + (*pos - '0');
+            ++digits;
+            if (decimals >= 0) ++decimals;
+        }
+        ++pos;
+    }
+    if (digits == 0) {
+        throw createError(tr("Invalid coordinate."));
+    }
+    if (decimals < 0) {
+        decimals = mDecimalDigits;
+        if (mOmitTrailingZeros) decimals -= mIntegerDigits + mDecimalDigits - digits;
+    }
+    qreal result = value * mUnit / powerOfTen(decimals);
+    return negative ? -result : result;
+}
+
+QPainterPath GerberReader::createStandardAperture(const QByteArray& name,
+                                                  const QVector<qreal>& params) const
+{
+    QPainterPath path;
+    qreal hole = 0;
+    if ((name == "C") && (params.count() >= 1)) {
+        path = createCircle(QPointF(), params.at(0) * mUnit);
+        hole = params.value(1) * mUnit;
+    } else if (((name == "R") || (name == "O")) && (params.count() >= 2)) {
+        qreal w = params.at(0) * mUnit;
+        qreal h = params.at(1) * mUnit;
+        if (name == "R") {
+            path.addRect(-w / 2, -h / 2, w, h);
+        } else {
+            qreal r = qMin(w, h) / 2;
+            path.addRoundedRect(-w / 2, -h / 2, w, h, r, r);
+        }
+        hole = params.value(2) * mUnit;
+    } else if ((name == "P") && (params.count() >= 2)) {
+        path = createRegularPolygon(QPointF(), params.at(0) * mUnit, qRound(params.at(1)),
+                                    params.value(2));
+        hole = params.value(3) * mUnit;
+    } else {
+        throw createError(QString(tr("Invalid or unknown aperture \"%1\".")).arg(QString(name)));
+    }
+    if (hole > 0) {
+        path.setFillRule(Qt::OddEvenFill);
+        path.addPath(createCircle(QPointF(), hole));
+    }
+    return path;
+}
+
+QPainterPath GerberReader::createMacroAperture(const QList<QByteArray>& macro,
+                                               const QVector<qreal>& params) const
+{
+    QVector<qreal> vars = params;
+    QPainterPath path;
+    foreach (const QByteArray& primitive, macro) {
+        if (primitive.startsWith('0') && ((primitive.length() == 1) ||
+                                          (!isDigit(primitive.at(1))))) {
+            continue; // comment
+        }
+        if (primitive.startsWith('$')) {
+            // variable definition, e.g. "$4=$1x0.5"
+            int separator = primitive.indexOf('=');
+            int index = primitive.mid(1, separator - 1).toInt();
+            bool ok = false;
+            qreal value = ExpressionParser(primitive.mid(separator + 1), vars).evaluate(ok);
+            if ((separator < 0) || (index < 1) || (!ok)) {
+                throw createError(QString(tr("Invalid macro variable \"%1\"."))
+                                  .arg(QString(primitive)));
+            }
+            if (vars.count() < index) vars.resize(index);
+            vars[index - 1] = value;
+            continue;
+        }
+        QList<QByteArray> tokens = primitive.split(',');
+        QVector<qreal> mods;
+        for (int i = 1; i < tokens.count(); ++i) {
+            bool ok = false;
+            mods.append(ExpressionParser(tokens.at(i), vars).evaluate(ok));
+            if (!ok) {
+                throw createError(QString(tr("Invalid macro expression \"%1\"."))
+                                  .arg(QString(tokens.at(i))));
+            }
+        }
+        bool exposure = true;
+        QPainterPath shape = createMacroPrimitive(tokens.first().toInt(), mods, exposure); // can throw
+        if (path.isEmpty()) {
+            if (exposure) path = shape;
+        } else if (exposure) {
+            path = path.united(shape);
+        } else {
+            path = path.subtracted(shape);
+        }
+    }
+    return path;
+}
+
+QPainterPath GerberReader::createMacroPrimitive(int code, const QVector<qreal>& mods,
+                                                bool& exposure) const
+{
+    static const QHash<int, int> modifierCounts = {{1, 4}, {4, 5}, {5, 6}, {7, 6},
+                                                   {20, 7}, {21, 6}};
+    if (!modifierCounts.contains(code)) {
+        throw createError(QString(tr("Unsupported macro primitive %1.")).arg(code));
+    }
+    if ((mods.count() < modifierCounts.value(code)) ||
+        ((code == 4) && (mods.count() < 2 + 2 * (qRound(mods.at(1)) + 1) + 1)))
+    {
+        throw createError(QString(tr("Too few modifiers of macro primitive %1.")).arg(code));
+    }
+    exposure = (code == 7) || (mods.at(0) != 0);
+    qreal u = mUnit;
+    QPainterPath path;
+    qreal rotation = 0;
+    switch (code) {
+        case 1: {
+            path = createCircle(QPointF(mods.at(2), mods.at(3)) * u, mods.at(1) * u);
+            rotation = mods.value(4);
+            break;
+        }
+        case 4: {
+            int n = qRound(mods.at(1));
+            QVector<QPointF> points;
+            for (int i = 0; i <= n; ++i) {
+                points.append(QPointF(mods.at(2 + 2 * i), mods.at(3 + 2 * i)) * u);
+            }
+            path = createPolygon(points);
+            rotation = mods.at(2 + 2 * (n + 1));
+            break;
+        }
+        case 5: {
+            path = createRegularPolygon(QPointF(mods.at(2), mods.at(3)) * u, mods.at(4) * u,
+                                        qRound(mods.at(1)), 0);
+            rotation = mods.at(5);
+            break;
+        }
+        case 7: {
+            QPointF center = QPointF(mods.at(0), mods.at(1)) * u;
+            qreal outer = mods.at(2) * u;
+            qreal gap = mods.at(4) * u;
+            path = createCircle(center, outer).subtracted(createCircle(center, mods.at(3) * u));
+            QPainterPath cross;
+            cross.addRect(QRectF(center.x() - outer, center.y() - gap / 2, 2 * outer, gap));
+            cross.addRect(QRectF(center.x() - gap / 2, center.y() - outer, gap, 2 * outer));
+            path = path.subtracted(cross.simplified());
+            rotation = mods.at(5);
+            break;
+        }
+        case 20: {
+            QPointF start = QPointF(mods.at(2), mods.at(3)) * u;
+            QPointF end = QPointF(mods.at(4), mods.at(5)) * u;
+            QLineF normal = QLineF(start, end).normalVector();
+            normal.setLength(mods.at(1) * u / 2);
+            QPointF n(normal.dx(), normal.dy());
+            path = createPolygon({start + n, end + n, end - n, start - n});
+            rotation = mods.at(6);
+            break;
+        }
+        case 21: {
+            qreal w = mods.at(1) * u;
+            qreal h = mods.at(2) * u;
+            path.addRect(QRectF(mods.at(3) * u - w / 2, mods.at(4) * u - h / 2, w, h));
+            rotation = mods.at(5);
+            break;
+        }
+        default: {
+            Q_ASSERT(false);
+            break;
+        }
+    }
+    if (rotation != 0) {
+        QTransform transform;
+        transform.rotate(rotation); // counterclockwise, as the Y axis points up
+        path = transform.map(path);
+    }
+    return path;
+}
+
+void GerberReader::appendArc(QVector<QPointF>& points, const QPointF& start,
+                             const QPointF& end, const QPointF& offset) const
+{
+    bool clockwise = (mInterpolation == Interpolation::Clockwise);
+    auto calcSweep = [&](const QPointF& center, bool fullCircle) {
+        qreal a0 = qAtan2(start.y() - center.y(), start.x() - center.x());
+        qreal a1 = qAtan2(end.y() - center.y(), end.x() - center.x());
+        qreal sweep = clockwise ? (a0 - a1) : (a1 - a0);
+        while (sweep < 0) sweep += 2 * M_PI;
+        while (sweep >= 2 * M_PI) sweep -= 2 * M_PI;
+        if (start == end) sweep = fullCircle ? (2 * M_PI) : 0;
+        return clockwise ? -sweep : sweep;
+    };
+
+    QPointF center = start + offset;
+    if (!mMultiQuadrant) {
+        // the signs of the offset are not specified, use the center which results in
+        // an arc of at most 90 degrees with the smallest radius difference
+        qreal bestError = -1;
+        for (int i = 0; i < 4; ++i) {
+            QPointF c = start + QPointF(((i & 1) ? -1 : 1) * qAbs(offset.x()),
+                                        ((i & 2) ? -1 : 1) * qAbs(offset.y()));
+            if (qAbs(calcSweep(c, false)) > M_PI / 2 + 1e-6) continue;
+            qreal error = qAbs(QLineF(c, start).length() - QLineF(c, end).length());
+            if ((bestError < 0) || (error < bestError)) {
+                center = c;
+                bestError = error;
+            }
+        }
+    }
+
+    qreal sweep = calcSweep(center, mMultiQuadrant);
+    qreal a0 = qAtan2(start.y() - center.y(), start.x() - center.x());
+    qreal r0 = QLineF(center, start).length();
+    qreal r1 = QLineF(center, end).length();
+    qreal r = qMax(r0, r1);
+    if (r > sArcTolerance) {
+        qreal step = 2 * qAcos(1 - sArcTolerance / r);
+        int count = qBound(1, qCeil(qAbs(sweep) / step), 1000);
+        for (int i = 1; i < count; ++i) {
+            qreal angle = a0 + sweep * i / count;
+            qreal radius = r0 + (r1 - r0) * i / count;
+            points.append(center + QPointF(qCos(angle), qSin(angle)) * radius);
+        }
+    }
+    points.append(end);
+}
+
+void GerberReader::appendSweptSegment(const Aperture& aperture, const QPointF& start,
+                                      const QPointF& end) noexcept
+{
+    QPolygonF polygon = aperture.path.toFillPolygon();
+    QVector<QPointF> points;
+    foreach (const QPointF& point, polygon) {
+        points.append(point + start);
+        points.append(point + end);
+    }
+    getTarget().addFilledPath(createPolygon(calcConvexHull(points)), mDark);
+}
+
+RuntimeError GerberReader::createError(const QString& msg) const noexcept
+{
+    int line = mContent.left(mBlockStart).count('\n') + 1;
+    return RuntimeError(__FILE__, __LINE__, QString(tr("Invalid Gerber data in line "
+        "%1: %2")).arg(line).arg(msg));
+}
+
+/*****************************************************************************************
+ *  Static Private Methods
+ ****************************************************************************************/
+
+QByteArray GerberReader::removeWhitespaces(const QByteArray& data) noexcept
+{
+    QByteArray result;
+    result.reserve(data.size());
+    foreach (char c, data) {
+        if ((c != ' ') && (c != '\n') && (c != '\r') && (c != '\t')) {
+            result.append(c);
+        }
+    }
+    return result;
+}
+
+QPainterPath GerberReader::createCircle(const QPointF& center, qreal diameter) noexcept
+{
+    QPainterPath path;
+    path.addEllipse(center, diameter / 2, diameter / 2);
+    return path;
+}
+
+QPainterPath GerberReader::createPolygon(const QVector<QPointF>& points) noexcept
+{
+    QPainterPath path;
+    if (!points.isEmpty()) {
+        path.moveTo(points.first());
+        for (int i = 1; i < points.count(); ++i) {
+            path.lineTo(points.at(i));
+        }
+        path.closeSubpath();
+    }
+    return path;
+}
+
+QPainterPath GerberReader::createRegularPolygon(const QPointF& center, qreal diameter,
+                                                int vertices, qreal rotation) noexcept
+{
+    QVector<QPointF> points;
+    for (int i = 0; i < vertices; ++i) {
+        qreal angle = qDegreesToRadians(rotation) + 2 * M_PI * i / vertices;
+        points.append(center + QPointF(qCos(angle), qSin(angle)) * (diameter / 2));
+    }
+    return createPolygon(points);
+}
+
+QVector<QPointF> GerberReader::calcConvexHull(QVector<QPointF> points) noexcept
+{
+    // Andrew's monotone chain algorithm
+    std::sort(points.begin(), points.end(), [](const QPointF& a, const QPointF& b) {
+        return (a.x() < b.x()) || ((a.x() == b.x()) && (a.y() < b.y()));
+    });
+    auto cross = [](const QPointF& o, const QPointF& a, const QPointF& b) {
+        return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+    };
+    if (points.count() < 3) return points;
+    QVector<QPointF> hull(2 * points.count());
+    int k = 0;
+    for (int i = 0; i < points.count(); ++i) {
+        while ((k >= 2) && (cross(hull[k - 2], hull[k - 1], points[i]) <= 0)) --k;
+        hull[k++] = points[i];
+    }
+    for (int i = points.count() - 2, t = k + 1; i >= 0; --i) {
+        while ((k >= t) && (cross(hull[k - 2], hull[k - 1], points[i]) <= 0)) --k;
+        hull[k++] = points[i];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,187 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_GERBERREADER_H
+#define LIBREPCB_GERBERREADER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "../exceptions.h"
+#include "camimage.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+/*****************************************************************************************
+ *  Class GerberReader
+ ****************************************************************************************/
+
+/**
+ * @brief The GerberReader class parses RS-274X (Gerber) files into a librepcb::CamImage
+ *
+ * The reader supports everything generated by librepcb::GerberGenerator and most of
+ * the commands used by other CAM tools: standard apertures (with holes), aperture
+ * macros with expressions, linear and circular interpolation in both quadrant modes,
+ * regions, polarities and step & repeat blocks. Attributes and comments are ignored.
+ * Image transformations (mirroring, rotation, scaling, offsets) and incremental
+ * coordinates are not supported and lead to an exception.
+ *
+ * Draws with circular apertures are stroked with round caps and joins, draws with
+ * other apertures are approximated by the convex hull of the aperture at the start and
+ * end point of each (flattened) segment. Arcs are flattened with a maximum deviation of
+ * 0.1um.
+ */
+class GerberReader final
+{
+        Q_DECLARE_TR_FUNCTIONS(GerberReader)
+
+    public:
+
+        // Constructors / Destructor
+        GerberReader() = delete;
+        GerberReader(const GerberReader& other) = delete;
+        ~GerberReader() noexcept;
+
+        // Static Methods
+
+        /**
+         * @brief Read a Gerber file
+         *
+         * @param filepath  The file to read
+         *
+         * @return The image of the file
+         *
+         * @throw Exception If the file could not be read or is invalid
+         */
+        static CamImage readFile(const FilePath& filepath);
+
+        /**
+         * @brief Parse the content of a Gerber file
+         *
+         * @param content   The file content
+         *
+         * @return The image of the file
+         *
+         * @throw Exception If the content is invalid or uses unsupported commands
+         */
+        static CamImage read(const QByteArray& content);
+
+        // Operator Overloadings
+        GerberReader& operator=(const GerberReader& rhs) = delete;
+
+
+    private:
+
+        // Types
+        enum class Interpolation {Linear, Clockwise, CounterClockwise};
+        struct Aperture {
+            QPainterPath path;      ///< the flash image, centered at the origin
+            qreal circleDiameter;   ///< diameter of circular apertures, otherwise -1
+        };
+
+        // Private Methods
+        explicit GerberReader(const QByteArray& content) noexcept;
+        CamImage parse();
+        void parseExtendedCommand(const QByteArray& content);
+        void parseFormatSpecification(const QByteArray& block);
+        void parseApertureDefinition(const QByteArray& block);
+        void parseApertureMacro(const QList<QByteArray>& blocks);
+        void parseStepAndRepeat(const QByteArray& block);
+        void parseWordCommand(const char* begin, const char* end);
+        void interpolate(const QPointF& end, const QPointF& offset);
+        void flash();
+        void flushTrace() noexcept;
+        void flushContour() noexcept;
+        void flushStepAndRepeat() noexcept;
+        CamImage& getTarget() noexcept;
+        const Aperture& getCurrentAperture() const;
+        qreal parseCoordinate(const char*& pos, const char* end) const;
+        QPainterPath createStandardAperture(const QByteArray& name,
+                                            const QVector<qreal>& params) const;
+        QPainterPath createMacroAperture(const QList<QByteArray>& macro,
+                                         const QVector<qreal>& params) const;
+        QPainterPath createMacroPrimitive(int code, const QVector<qreal>& mods,
+                                          bool& exposure) const;
+        void appendArc(QVector<QPointF>& points, const QPointF& start, const QPointF& end,
+                       const QPointF& offset) const;
+        void appendSweptSegment(const Aperture& aperture, const QPointF& start,
+                                const QPointF& end) noexcept;
+        RuntimeError createError(const QString& msg) const noexcept;
+
+        // Static Private Methods
+        static QByteArray removeWhitespaces(const QByteArray& data) noexcept;
+        static QPainterPath createCircle(const QPointF& center, qreal diameter) noexcept;
+        static QPainterPath createPolygon(const QVector<QPointF>& points) noexcept;
+        static QPainterPath createRegularPolygon(const QPointF& center, qreal diameter,
+                                                 int vertices, qreal rotation) noexcept;
+        static QVector<QPointF> calcConvexHull(QVector<QPointF> points) noexcept;
+
+
+        // Input
+        QByteArray mContent;
+        int mBlockStart;            ///< offset of the currently parsed block in #mContent
+
+        // Format
+        qreal mUnit;                ///< nanometers per file unit (0 = not yet defined)
+        int mIntegerDigits;
+        int mDecimalDigits;         ///< -1 = format not yet defined
+        bool mOmitTrailingZeros;
+
+        // Graphics State
+        QHash<int, Aperture> mApertures;
+        QHash<QByteArray, QList<QByteArray>> mMacros; ///< key: name; value: primitives
+        int mCurrentAperture;       ///< -1 = none
+        bool mDark;
+        Interpolation mInterpolation;
+        bool mMultiQuadrant;
+        bool mRegionMode;
+        bool mEndOfFile;            ///< M02 reached
+        int mLastOperation;         ///< for coordinates without operation code
+        QPointF mPosition;
+
+        // Objects in progress
+        QVector<QPointF> mContour;  ///< region contour (empty = none)
+        QPainterPath mTrace;        ///< connected draws with a circular aperture
+        qreal mTraceWidth;
+
+        // Step & Repeat
+        int mRepeatX;               ///< 0 = not in a step & repeat block
+        int mRepeatY;
+        QPointF mRepeatStep;
+        CamImage mRepeatBlock;
+
+        // Output
+        CamImage mImage;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GERBERREADER_H
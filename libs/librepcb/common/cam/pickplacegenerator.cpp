@@ -0,0 +1,114 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "pickplacegenerator.h"
+#include "camnumberformatter.h"
+#include "../fileio/fileutils.h"
+#include "../toolbox.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+PickPlaceGenerator::PickPlaceGenerator() noexcept :
+    mParts()
+{
+}
+
+PickPlaceGenerator::~PickPlaceGenerator() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void PickPlaceGenerator::generate(QTextStream& stream) const noexcept
+{
+    // sort only pointers to avoid copying all the strings
+    QVector<const Part*> parts;
+    parts.reserve(mParts.count());
+    for (const Part& part : mParts) {
+        parts.append(&part);
+    }
+    std::stable_sort(parts.begin(), parts.end(), [](const Part* a, const Part* b)
+        {return Toolbox::naturalLessThan(a->designator, b->designator);});
+
+    stream << "Designator,Value,Package,X,Y,Rotation,Side\n";
+    foreach (const Part* part, parts) {
+        printPart(stream, *part);
+    }
+    stream.flush();
+}
+
+void PickPlaceGenerator::saveToFile(const FilePath& filepath) const
+{
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    generate(stream);
+    if ((stream.status() != QTextStream::Ok) || (!file.commit())) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void PickPlaceGenerator::printPart(QTextStream& stream, const Part& part) noexcept
+{
+    stream << Toolbox::toCsvLine({part.designator, part.value, part.package});
+
+    // formatted without any heap allocation (identical to Length::toMmString() and
+    // Angle::toDegString())
+    char buffer[3 * (CamNumberFormatter::sMaxFixedPointLength + 1) + 16];
+    char* out = buffer;
+    *out++ = ',';
+    out = CamNumberFormatter::writeFixedPoint(out, part.position.getX().toNm(), 6);
+    *out++ = ',';
+    out = CamNumberFormatter::writeFixedPoint(out, part.position.getY().toNm(), 6);
+    *out++ = ',';
+    out = CamNumberFormatter::writeFixedPoint(out, part.rotation.mappedTo0_360deg().toMicroDeg(), 6);
+    out = CamNumberFormatter::writeString(out, (part.side == BoardSide::Top) ? ",Top\n" : ",Bottom\n");
+    stream << QLatin1String(buffer, out - buffer);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
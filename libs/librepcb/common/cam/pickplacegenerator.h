@@ -0,0 +1,105 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PICKPLACEGENERATOR_H
+#define LIBREPCB_PICKPLACEGENERATOR_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../exceptions.h"
+#include "../fileio/filepath.h"
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class PickPlaceGenerator
+ ****************************************************************************************/
+
+/**
+ * @brief The PickPlaceGenerator class generates pick-and-place (centroid) CSV files
+ *
+ * Each part is written as one line with its designator, value, package, position (in
+ * millimeters), rotation (in degrees, 0..360) and board side. The lines are sorted by
+ * designator in natural order, so the output is stable and suitable for diffs.
+ *
+ * Like the other CAM generators, the file is streamed to the output device and the
+ * coordinates are formatted without heap allocations (see
+ * librepcb::CamNumberFormatter), so even boards with many thousands of parts are
+ * exported instantly.
+ */
+class PickPlaceGenerator final
+{
+        Q_DECLARE_TR_FUNCTIONS(PickPlaceGenerator)
+
+    public:
+
+        // Types
+        enum class BoardSide {Top, Bottom};
+
+        struct Part {
+            QString designator;
+            QString value;
+            QString package;
+            Point position;
+            Angle rotation;
+            BoardSide side;
+        };
+
+        // Constructors / Destructor
+        PickPlaceGenerator(const PickPlaceGenerator& other) = delete;
+        PickPlaceGenerator() noexcept;
+        ~PickPlaceGenerator() noexcept;
+
+        // Getters
+        const QVector<Part>& getParts() const noexcept {return mParts;}
+
+        // General Methods
+        void addPart(const Part& part) noexcept {mParts.append(part);}
+        void generate(QTextStream& stream) const noexcept;
+        void saveToFile(const FilePath& filepath) const;
+        void reset() noexcept {mParts.clear();}
+
+        // Operator Overloadings
+        PickPlaceGenerator& operator=(const PickPlaceGenerator& rhs) = delete;
+
+
+    private: // Methods
+
+        static void printPart(QTextStream& stream, const Part& part) noexcept;
+
+
+    private: // Data
+
+        QVector<Part> mParts;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_PICKPLACEGENERATOR_H
@@ -39,10 +39,18 @@ SOURCES += \
     attributes/attrtypestring.cpp \
     attributes/attrtypevoltage.cpp \
     boarddesignrules.cpp \
+    cam/camimage.cpp \
+    cam/camimagecomparator.cpp \
+    cam/camimagewriter.cpp \
+    cam/camnumberformatter.cpp \
     cam/excellongenerator.cpp \
+    cam/excellonreader.cpp \
     cam/gerberaperturelist.cpp \
     cam/gerbergenerator.cpp \
+    cam/gerberreader.cpp \
+    cam/pickplacegenerator.cpp \
     debug.cpp \
+    debugtrace.cpp \
     dialogs/boarddesignrulesdialog.cpp \
     dialogs/ellipsepropertiesdialog.cpp \
     dialogs/gridsettingsdialog.cpp \
@@ -52,9 +60,13 @@ SOURCES += \
     exceptions.cpp \
     fileio/directorylock.cpp \
     fileio/domdocument.cpp \
+    fileio/domdocumentcache.cpp \
     fileio/domelement.cpp \
     fileio/filepath.cpp \
     fileio/fileutils.cpp \
+    fileio/mappedfile.cpp \
+    fileio/filewritebatch.cpp \
+    fileio/sharedfilestore.cpp \
     fileio/smartfile.cpp \
     fileio/smarttextfile.cpp \
     fileio/smartversionfile.cpp \
@@ -65,11 +77,14 @@ SOURCES += \
     geometry/cmd/cmdpolygonmove.cpp \
     geometry/cmd/cmdpolygonsegmentedit.cpp \
     geometry/cmd/cmdtextedit.cpp \
+    geometry/compactpolygonlist.cpp \
     geometry/ellipse.cpp \
     geometry/hole.cpp \
     geometry/polygon.cpp \
+    geometry/polygonclipper.cpp \
     geometry/text.cpp \
     graphics/ellipsegraphicsitem.cpp \
+    graphics/framestatistics.cpp \
     graphics/graphicslayer.cpp \
     graphics/graphicsscene.cpp \
     graphics/graphicsview.cpp \
@@ -80,9 +95,14 @@ SOURCES += \
     graphics/primitiveellipsegraphicsitem.cpp \
     graphics/primitivepathgraphicsitem.cpp \
     graphics/primitivetextgraphicsitem.cpp \
+    graphics/sceneshapecache.cpp \
+    graphics/strokefont.cpp \
     graphics/textgraphicsitem.cpp \
+    graphics/textlayoutcache.cpp \
     gridproperties.cpp \
     if_attributeprovider.cpp \
+    jobscheduler.cpp \
+    memoryreport.cpp \
     network/filedownload.cpp \
     network/networkaccessmanager.cpp \
     network/networkrequest.cpp \
@@ -128,10 +148,18 @@ HEADERS += \
     attributes/attrtypestring.h \
     attributes/attrtypevoltage.h \
     boarddesignrules.h \
+    cam/camimage.h \
+    cam/camimagecomparator.h \
+    cam/camimagewriter.h \
+    cam/camnumberformatter.h \
     cam/excellongenerator.h \
+    cam/excellonreader.h \
     cam/gerberaperturelist.h \
     cam/gerbergenerator.h \
+    cam/gerberreader.h \
+    cam/pickplacegenerator.h \
     debug.h \
+    debugtrace.h \
     dialogs/boarddesignrulesdialog.h \
     dialogs/ellipsepropertiesdialog.h \
     dialogs/gridsettingsdialog.h \
@@ -141,15 +169,20 @@ HEADERS += \
     exceptions.h \
     fileio/cmd/cmdlistelementinsert.h \
     fileio/cmd/cmdlistelementremove.h \
+    fileio/cmd/cmdlistelementsinsert.h \
     fileio/cmd/cmdlistelementsswap.h \
     fileio/directorylock.h \
     fileio/domdocument.h \
+    fileio/domdocumentcache.h \
     fileio/domelement.h \
     fileio/filepath.h \
     fileio/fileutils.h \
+    fileio/filewritebatch.h \
+    fileio/mappedfile.h \
     fileio/serializablekeyvaluemap.h \
     fileio/serializableobject.h \
     fileio/serializableobjectlist.h \
+    fileio/sharedfilestore.h \
     fileio/smartfile.h \
     fileio/smarttextfile.h \
     fileio/smartversionfile.h \
@@ -160,11 +193,14 @@ HEADERS += \
     geometry/cmd/cmdpolygonmove.h \
     geometry/cmd/cmdpolygonsegmentedit.h \
     geometry/cmd/cmdtextedit.h \
+    geometry/compactpolygonlist.h \
     geometry/ellipse.h \
     geometry/hole.h \
     geometry/polygon.h \
+    geometry/polygonclipper.h \
     geometry/text.h \
     graphics/ellipsegraphicsitem.h \
+    graphics/framestatistics.h \
     graphics/graphicslayer.h \
     graphics/graphicsscene.h \
     graphics/graphicsview.h \
@@ -176,14 +212,21 @@ HEADERS += \
     graphics/primitiveellipsegraphicsitem.h \
     graphics/primitivepathgraphicsitem.h \
     graphics/primitivetextgraphicsitem.h \
+    graphics/sceneshapecache.h \
+    graphics/strokefont.h \
     graphics/textgraphicsitem.h \
+    graphics/textlayoutcache.h \
     gridproperties.h \
     if_attributeprovider.h \
+    jobscheduler.h \
+    memoryreport.h \
     network/filedownload.h \
     network/networkaccessmanager.h \
     network/networkrequest.h \
     network/networkrequestbase.h \
     network/repository.h \
+    objectpool.h \
+    orderedset.h \
     scopeguard.h \
     scopeguardlist.h \
     signalrole.h \
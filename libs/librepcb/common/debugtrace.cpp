@@ -0,0 +1,166 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "debugtrace.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+DebugTrace::DebugTrace() noexcept :
+    mEnabled(0), mProcessId(QCoreApplication::applicationPid())
+{
+    mTimer.start();
+
+    QString filepath = QString::fromLocal8Bit(qgetenv("LIBREPCB_TRACE_FILE"));
+    if (!filepath.isEmpty()) {
+        setOutputFilePath(FilePath(QFileInfo(filepath).absoluteFilePath()));
+    }
+}
+
+DebugTrace::~DebugTrace() noexcept
+{
+    setOutputFilePath(FilePath());
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+FilePath DebugTrace::getOutputFilePath() const noexcept
+{
+    QMutexLocker lock(&mMutex);
+    return mFilePath;
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void DebugTrace::setOutputFilePath(const FilePath& fp) noexcept
+{
+    QMutexLocker lock(&mMutex);
+    if (fp == mFilePath) {
+        return;
+    }
+
+    mEnabled.store(0);
+    closeFile();
+    mFilePath = fp;
+    if (fp.isValid()) {
+        QDir().mkpath(fp.getParentDir().toStr());
+        mFile.setFileName(fp.toStr());
+        if (mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            mFile.write("[\n");
+            mThreadIds.clear();
+            mEnabled.store(1);
+        } else {
+            qWarning() << "Could not open trace file:" << fp.toNative() << mFile.errorString();
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void DebugTrace::addScope(const char* name, qint64 startUs) noexcept
+{
+    qint64 durationUs = getTimestampUs() - startUs;
+    QMutexLocker lock(&mMutex);
+    if (!mFile.isOpen()) return; // stopped in the meantime
+    writeEvent(QString("{\"name\":\"%1\",\"cat\":\"librepcb\",\"ph\":\"X\",\"ts\":%2,"
+                       "\"dur\":%3,\"pid\":%4,\"tid\":%5}")
+               .arg(QLatin1String(name)).arg(startUs).arg(durationUs).arg(mProcessId)
+               .arg(getThreadId()));
+}
+
+void DebugTrace::addCounter(const char* name, qint64 value) noexcept
+{
+    if (!isEnabled()) return;
+    qint64 timestampUs = getTimestampUs();
+    QMutexLocker lock(&mMutex);
+    if (!mFile.isOpen()) return; // stopped in the meantime
+    writeEvent(QString("{\"name\":\"%1\",\"cat\":\"librepcb\",\"ph\":\"C\",\"ts\":%2,"
+                       "\"pid\":%3,\"tid\":%4,\"args\":{\"value\":%5}}")
+               .arg(QLatin1String(name)).arg(timestampUs).arg(mProcessId)
+               .arg(getThreadId()).arg(value));
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void DebugTrace::closeFile() noexcept
+{
+    if (mFile.isOpen()) {
+        // the closing bracket is optional in the trace event format, so files of crashed
+        // processes can be opened too
+        mFile.write("\n]\n");
+        mFile.close();
+    }
+}
+
+void DebugTrace::writeEvent(const QString& json) noexcept
+{
+    // events are separated by commas, the first one follows directly the opening bracket
+    if (mFile.pos() > 2) {
+        mFile.write(",\n");
+    }
+    mFile.write(json.toUtf8());
+}
+
+int DebugTrace::getThreadId() noexcept
+{
+    Qt::HANDLE handle = QThread::currentThreadId();
+    auto it = mThreadIds.constFind(handle);
+    if (it != mThreadIds.constEnd()) {
+        return it.value();
+    }
+
+    // new thread: give it a name in the viewer
+    int id = mThreadIds.count() + 1;
+    mThreadIds.insert(handle, id);
+    QThread* thread = QThread::currentThread();
+    QString name = thread->objectName();
+    if (QCoreApplication::instance() && (thread == QCoreApplication::instance()->thread())) {
+        name = "Main Thread";
+    } else if (name.isEmpty()) {
+        name = QString("Thread %1").arg(id);
+    }
+    name.remove('"').remove('\\');
+    writeEvent(QString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%1,\"tid\":%2,"
+                       "\"args\":{\"name\":\"%3\"}}").arg(mProcessId).arg(id).arg(name));
+    return id;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,185 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_DEBUGTRACE_H
+#define LIBREPCB_DEBUGTRACE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "fileio/filepath.h"
+
+/*****************************************************************************************
+ *  Macros
+ ****************************************************************************************/
+
+/**
+ * @brief Trace the duration of the current scope (see librepcb::DebugTrace)
+ *
+ * @param name  A string literal (must not contain quotes or backslashes)
+ */
+#define LIBREPCB_TRACE_SCOPE(name) \
+    LIBREPCB_TRACE_SCOPE_IMPL(name, __LINE__)
+
+/**
+ * @brief Trace the current value of a counter (see librepcb::DebugTrace)
+ *
+ * @param name  A string literal (must not contain quotes or backslashes)
+ * @param value The current value (an integer)
+ */
+#define LIBREPCB_TRACE_COUNTER(name, value) \
+    LIBREPCB_TRACE_COUNTER_IMPL(name, value)
+
+#ifdef LIBREPCB_DISABLE_TRACING
+#define LIBREPCB_TRACE_SCOPE_IMPL(name, line)
+#define LIBREPCB_TRACE_COUNTER_IMPL(name, value)
+#else
+#define LIBREPCB_TRACE_SCOPE_IMPL(name, line) \
+    LIBREPCB_TRACE_SCOPE_IMPL2(name, line)
+#define LIBREPCB_TRACE_SCOPE_IMPL2(name, line) \
+    ::librepcb::DebugTrace::Scope librepcbTraceScope##line(name)
+#define LIBREPCB_TRACE_COUNTER_IMPL(name, value) \
+    ::librepcb::DebugTrace::instance().addCounter(name, value)
+#endif
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class DebugTrace
+ ****************************************************************************************/
+
+/**
+ * @brief The DebugTrace class records trace events of hot paths to a JSON file
+ *
+ * While the librepcb::Debug class handles log messages, this class records the durations
+ * of instrumented scopes and the values of counters, with timestamps and thread IDs.
+ * The output file uses the trace event format of Chromium, so it can be opened directly
+ * in "chrome://tracing" or similar viewers.
+ *
+ * Don't use this class directly; instrument code with the macros
+ * #LIBREPCB_TRACE_SCOPE and #LIBREPCB_TRACE_COUNTER instead:
+ *
+ * @code
+ * void Foo::bar()
+ * {
+ *     LIBREPCB_TRACE_SCOPE("Foo::bar");
+ *     ...
+ * }
+ * @endcode
+ *
+ * Recording is disabled by default and costs only one atomic read per instrumented
+ * scope then. It is enabled at startup if the environment variable
+ * "LIBREPCB_TRACE_FILE" contains the path of the output file, or at runtime with
+ * #setOutputFilePath(). Defining "LIBREPCB_DISABLE_TRACING" (see common.pri) removes
+ * all instrumentation at compile time.
+ *
+ * There is only one singleton object of this class, see #instance(). It is thread-safe.
+ */
+class DebugTrace final
+{
+    public:
+
+        /**
+         * @brief Helper to trace the duration of a scope (see #LIBREPCB_TRACE_SCOPE)
+         */
+        class Scope final
+        {
+            public:
+                explicit Scope(const char* name) noexcept :
+                    mName(name), mStartUs(-1)
+                {
+                    DebugTrace& trace = DebugTrace::instance();
+                    if (trace.isEnabled()) mStartUs = trace.getTimestampUs();
+                }
+                ~Scope() noexcept
+                {
+                    if (mStartUs >= 0) DebugTrace::instance().addScope(mName, mStartUs);
+                }
+                Scope(const Scope& other) = delete;
+                Scope& operator=(const Scope& rhs) = delete;
+
+            private:
+                const char* mName;
+                qint64 mStartUs;    ///< -1 if tracing was disabled at construction
+        };
+
+        // Constructors / Destructor
+        DebugTrace(const DebugTrace& other) = delete;
+        ~DebugTrace() noexcept;
+
+        // Getters
+        bool isEnabled() const noexcept {return mEnabled.load() != 0;}
+        FilePath getOutputFilePath() const noexcept;
+
+        /**
+         * @brief Get the time since the creation of the singleton in microseconds
+         */
+        qint64 getTimestampUs() const noexcept {return mTimer.nsecsElapsed() / 1000;}
+
+        // Setters
+
+        /**
+         * @brief Start or stop recording to a file
+         *
+         * @param fp    The file to write the events to (overwritten if it exists already).
+         *              An invalid path stops recording.
+         */
+        void setOutputFilePath(const FilePath& fp) noexcept;
+
+        // General Methods
+        void addScope(const char* name, qint64 startUs) noexcept;
+        void addCounter(const char* name, qint64 value) noexcept;
+
+        // Operator Overloadings
+        DebugTrace& operator=(const DebugTrace& rhs) = delete;
+
+        // Static Methods
+        static DebugTrace& instance() noexcept {static DebugTrace x; return x;}
+
+
+    private:
+
+        // Private Methods
+        DebugTrace() noexcept;
+        void closeFile() noexcept;
+        void writeEvent(const QString& json) noexcept;
+        int getThreadId() noexcept;
+
+
+        // Attributes
+        QAtomicInt mEnabled;
+        QElapsedTimer mTimer;
+        qint64 mProcessId;
+        mutable QMutex mMutex;              ///< protects all following attributes
+        FilePath mFilePath;
+        QFile mFile;
+        QHash<Qt::HANDLE, int> mThreadIds;  ///< small IDs are easier to read in viewers
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_DEBUGTRACE_H
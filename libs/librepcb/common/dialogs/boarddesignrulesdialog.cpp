@@ -96,6 +96,9 @@ void BoardDesignRulesDialog::updateWidgets() noexcept
     mUi->spbxRestringViasRatio->setValue(mDesignRules.getRestringViaRatio().toPercent());
     mUi->spbxRestringViasMin->setValue(mDesignRules.getRestringViaMin().toMm());
     mUi->spbxRestringViasMax->setValue(mDesignRules.getRestringViaMax().toMm());
+    // copper
+    mUi->spbxMinCopperClearance->setValue(mDesignRules.getMinCopperClearance().toMm());
+    mUi->spbxMinCopperWidth->setValue(mDesignRules.getMinCopperWidth().toMm());
 }
 
 void BoardDesignRulesDialog::applyRules() noexcept
@@ -119,6 +122,9 @@ void BoardDesignRulesDialog::applyRules() noexcept
     mDesignRules.setRestringViaRatio(Ratio::fromPercent(mUi->spbxRestringViasRatio->value()));
     mDesignRules.setRestringViaMin(Length::fromMm(mUi->spbxRestringViasMin->value()));
     mDesignRules.setRestringViaMax(Length::fromMm(mUi->spbxRestringViasMax->value()));
+    // copper
+    mDesignRules.setMinCopperClearance(Length::fromMm(mUi->spbxMinCopperClearance->value()));
+    mDesignRules.setMinCopperWidth(Length::fromMm(mUi->spbxMinCopperWidth->value()));
 }
 
 /*****************************************************************************************
@@ -0,0 +1,102 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CMDLISTELEMENTSINSERT
+#define LIBREPCB_CMDLISTELEMENTSINSERT
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../../undocommand.h"
+#include "../serializableobjectlist.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class CmdListElementsInsert
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdListElementsInsert class appends multiple elements to a list at once
+ *
+ * In contrast to a group of librepcb::CmdListElementInsert commands, this needs only
+ * one undo command for any number of elements, which matters when generating thousands
+ * of elements (e.g. pad arrays). The elements are removed from the end of the list in
+ * reverse order on undo, so no other elements need to be moved.
+ */
+template <typename T, typename P>
+class CmdListElementsInsert final : public UndoCommand
+{
+    public:
+
+        // Constructors / Destructor
+        CmdListElementsInsert() = delete;
+        CmdListElementsInsert(const CmdListElementsInsert& other) = delete;
+        CmdListElementsInsert(SerializableObjectList<T, P>& list,
+                              const QVector<std::shared_ptr<T>>& elements) noexcept :
+            UndoCommand(QString(tr("Add %1")).arg(P::tagname)),
+            mList(list), mElements(elements), mIndex(-1) {}
+        ~CmdListElementsInsert() noexcept {}
+
+        // Operator Overloadings
+        CmdListElementsInsert& operator=(const CmdListElementsInsert& rhs) = delete;
+
+
+    private: // Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override {
+            performRedo(); // can throw
+            return !mElements.isEmpty();
+        }
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override {
+            for (int i = mElements.count() - 1; i >= 0; --i) {
+                Q_ASSERT(mList.value(mIndex + i) == mElements.at(i));
+                mList.remove(mIndex + i);
+            }
+        }
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override {
+            mIndex = mList.count();
+            foreach (const std::shared_ptr<T>& element, mElements) {
+                mList.append(element);
+            }
+        }
+
+
+    private: // Data
+        SerializableObjectList<T, P>& mList;
+        QVector<std::shared_ptr<T>> mElements;
+        int mIndex;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CMDLISTELEMENTSINSERT
@@ -30,6 +30,53 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Internal Types
+ ****************************************************************************************/
+namespace {
+
+/// Runs a function in a thread pool worker
+class FunctionRunnable final : public QRunnable
+{
+    public:
+        explicit FunctionRunnable(const std::function<void()>& function) noexcept :
+            mFunction(function) {}
+        void run() noexcept override {mFunction();}
+
+    private:
+        std::function<void()> mFunction;
+};
+
+/// The state of an operation started by DirectoryLock::runWithTimeout()
+struct AsyncOperation
+{
+    QMutex mutex;
+    QWaitCondition finishedCondition;
+    bool finished = false;
+    bool abandoned = false; ///< the caller does not wait anymore (timeout expired)
+    QScopedPointer<Exception> error;
+};
+
+} // namespace
+
+/*****************************************************************************************
+ *  Struct DirectoryLock::Heartbeat
+ ****************************************************************************************/
+
+/**
+ * @brief The lock file content shared between a DirectoryLock and its heartbeat jobs
+ *
+ * The mutex is held while a job updates the lock file, so once #active has been reset,
+ * no job will (re)create the lock file anymore.
+ */
+struct DirectoryLock::Heartbeat
+{
+    QMutex mutex;
+    FilePath lockFilePath;
+    QStringList lines;      ///< the lock file content, without the datetime
+    bool active = true;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -70,35 +117,159 @@ void DirectoryLock::setDirToLock(const FilePath& dir) noexcept
  *  Getters
  ****************************************************************************************/
 
-DirectoryLock::LockStatus DirectoryLock::getStatus() const
+DirectoryLock::LockStatus DirectoryLock::getStatus(int timeout) const
+{
+    // the operation must not reference this object, as it may outlive it on timeout
+    FilePath dirToLock = mDirToLock;
+    FilePath lockFilePath = mLockFilePath;
+    QSharedPointer<LockStatus> status(new LockStatus(LockStatus::Unlocked));
+    runWithTimeout([dirToLock, lockFilePath, status](){
+        *status = readStatus(dirToLock, lockFilePath); // can throw
+    }, nullptr, timeout); // can throw
+    return *status;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void DirectoryLock::tryLock(bool* wasStale, int timeout)
+{
+    LockStatus status = getStatus(timeout); // can throw
+    if (wasStale) {
+        *wasStale = (status == LockStatus::StaleLock);
+    }
+    switch (status)
+    {
+        case LockStatus::Unlocked:
+        case LockStatus::StaleLock:
+            lock(timeout); // can throw
+            break;
+        case LockStatus::Locked:
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("The directory is locked, "
+                "check if it is already opened elsewhere: %1")).arg(mDirToLock.toNative()));
+        default:
+            Q_ASSERT(false);
+            throw LogicError(__FILE__, __LINE__);
+    }
+}
+
+bool DirectoryLock::unlockIfLocked()
+{
+    if (mLockedByThisObject) {
+        unlock(); // can throw
+        return true;
+    } else {
+        return false;
+    }
+}
+
+void DirectoryLock::lock(int timeout)
+{
+    // prepare the content which will be written to the lock file
+    QSharedPointer<Heartbeat> heartbeat(new Heartbeat());
+    heartbeat->lockFilePath = mLockFilePath;
+    heartbeat->lines.append(SystemInfo::getFullUsername());
+    heartbeat->lines.append(SystemInfo::getUsername());
+    heartbeat->lines.append(SystemInfo::getHostname());
+    heartbeat->lines.append(QString::number(QCoreApplication::applicationPid()));
+    heartbeat->lines.append(SystemInfo::getProcessNameByPid(qApp->applicationPid()));
+    QStringList lines = heartbeat->lines;
+    lines.append(QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    QByteArray utf8content = lines.join('\n').toUtf8();
+
+    // create/overwrite lock file (the operation must not reference this object, as it
+    // may outlive it on timeout)
+    FilePath dirToLock = mDirToLock;
+    FilePath lockFilePath = mLockFilePath;
+    runWithTimeout([dirToLock, lockFilePath, utf8content](){
+        // check if the directory to lock does exist
+        if (!dirToLock.isExistingDir()) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr(
+                "The directory \"%1\" does not exist.")).arg(dirToLock.toNative()));
+        }
+        // when the directory is valid, the lock filepath must be valid too
+        Q_ASSERT(lockFilePath.isValid());
+        FileUtils::writeFile(lockFilePath, utf8content); // can throw
+    }, [lockFilePath](){
+        // nobody knows about this lock file, so it must not persist
+        try {
+            FileUtils::removeFile(lockFilePath); // can throw
+        } catch (const Exception& e) {
+            qCritical() << "Could not remove abandoned lock file:" << e.getMsg();
+        }
+    }, timeout); // can throw
+
+    // File Lock successfully created
+    mLockedByThisObject = true;
+
+    // refresh the lock file periodically to show that the lock is still alive
+    if (mHeartbeat) {
+        QMutexLocker locker(&mHeartbeat->mutex);
+        mHeartbeat->active = false; // replaced by the new heartbeat
+    }
+    mHeartbeat = heartbeat;
+    mHeartbeatTimer.reset(new QTimer());
+    QObject::connect(mHeartbeatTimer.data(), &QTimer::timeout, [heartbeat](){
+        QThreadPool::globalInstance()->start(new FunctionRunnable([heartbeat](){
+            updateHeartbeat(*heartbeat);
+        }));
+    });
+    mHeartbeatTimer->start(sHeartbeatInterval);
+}
+
+void DirectoryLock::unlock()
+{
+    // stop the heartbeat (and wait until a running heartbeat job has finished)
+    mHeartbeatTimer.reset();
+    if (mHeartbeat) {
+        QMutexLocker locker(&mHeartbeat->mutex);
+        mHeartbeat->active = false;
+    }
+    mHeartbeat.reset();
+
+    // remove the lock file
+    FileUtils::removeFile(mLockFilePath); // can throw
+
+    // File Lock successfully removed
+    mLockedByThisObject = false;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+DirectoryLock::LockStatus DirectoryLock::readStatus(const FilePath& dirToLock,
+                                                    const FilePath& lockFilePath)
 {
     // check if the directory to lock does exist
-    if (!mDirToLock.isExistingDir()) {
+    if (!dirToLock.isExistingDir()) {
         throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("The directory \"%1\" does not exist.")).arg(mDirToLock.toNative()));
+            QString(tr("The directory \"%1\" does not exist.")).arg(dirToLock.toNative()));
     }
 
     // when the directory is valid, the lock filepath must be valid too
-    Q_ASSERT(mLockFilePath.isValid());
+    Q_ASSERT(lockFilePath.isValid());
 
     // check if the lock file exists
-    if (!mLockFilePath.isExistingFile()) {
+    if (!lockFilePath.isExistingFile()) {
         return LockStatus::Unlocked;
     }
 
     // read the content of the lock file
-    QString content = QString::fromUtf8(FileUtils::readFile(mLockFilePath)); // can throw
+    QString content = QString::fromUtf8(FileUtils::readFile(lockFilePath)); // can throw
     QStringList lines = content.split("\n", QString::KeepEmptyParts);
     // check count of lines
     if (lines.count() < 6) {
         throw RuntimeError(__FILE__, __LINE__, QString(
-            tr("The lock file \"%1\" has too few lines.")).arg(mLockFilePath.toNative()));
+            tr("The lock file \"%1\" has too few lines.")).arg(lockFilePath.toNative()));
     }
     // read lock metadata
     QString lockUser = lines.at(1);
     QString lockHost = lines.at(2);
     qint64 lockPid = lines.at(3).toLongLong();
     QString lockAppName = lines.at(4);
+    QDateTime lockDateTime = QDateTime::fromString(lines.at(5), Qt::ISODate);
 
     // read metadata about this application instance
     QString thisUser = SystemInfo::getUsername();
@@ -106,7 +277,13 @@ DirectoryLock::LockStatus DirectoryLock::getStatus() const
 
     // check if the lock file was created with another computer or user
     if ((lockUser != thisUser) || (lockHost != thisHost)) {
-        return LockStatus::Locked;
+        // the process can not be checked, so only the heartbeat shows if it is alive
+        if (lockDateTime.isValid() && (lockDateTime.msecsTo(QDateTime::currentDateTimeUtc())
+                                       > sStaleLockTimeout)) {
+            return LockStatus::StaleLock; // the heartbeat has stopped a long time ago
+        } else {
+            return LockStatus::Locked;
+        }
     }
 
     // the lock file was created with an application instance on this computer, now check
@@ -123,76 +300,76 @@ DirectoryLock::LockStatus DirectoryLock::getStatus() const
     }
 }
 
-/*****************************************************************************************
- *  General Methods
- ****************************************************************************************/
-
-void DirectoryLock::tryLock(bool* wasStale)
+void DirectoryLock::runWithTimeout(const std::function<void()>& operation,
+                                   const std::function<void()>& onAbandoned,
+                                   int timeout) const
 {
-    LockStatus status = getStatus(); // can throw
-    if (wasStale) {
-        *wasStale = (status == LockStatus::StaleLock);
+    if (timeout < 0) {
+        operation(); // can throw
+        return;
     }
-    switch (status)
-    {
-        case LockStatus::Unlocked:
-        case LockStatus::StaleLock:
-            lock(); // can throw
-            break;
-        case LockStatus::Locked:
-            throw RuntimeError(__FILE__, __LINE__, QString(tr("The directory is locked, "
-                "check if it is already opened elsewhere: %1")).arg(mDirToLock.toNative()));
-        default:
-            Q_ASSERT(false);
-            throw LogicError(__FILE__, __LINE__);
-    }
-}
 
-bool DirectoryLock::unlockIfLocked()
-{
-    if (mLockedByThisObject) {
-        unlock(); // can throw
-        return true;
-    } else {
-        return false;
-    }
-}
+    QSharedPointer<AsyncOperation> state(new AsyncOperation());
+    QThreadPool::globalInstance()->start(new FunctionRunnable([state, operation, onAbandoned](){
+        try {
+            operation(); // can throw
+        } catch (const Exception& e) {
+            state->error.reset(e.clone());
+        }
+        QMutexLocker locker(&state->mutex);
+        state->finished = true;
+        if (state->abandoned) {
+            if ((!state->error) && onAbandoned) {
+                onAbandoned();
+            }
+        } else {
+            state->finishedCondition.wakeAll();
+        }
+    }));
 
-void DirectoryLock::lock()
-{
-    // check if the directory to lock does exist
-    if (!mDirToLock.isExistingDir()) {
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("The directory \"%1\" does not exist.")).arg(mDirToLock.toNative()));
+    QMutexLocker locker(&state->mutex);
+    QElapsedTimer timer;
+    timer.start();
+    while ((!state->finished) && (timer.elapsed() < timeout)) {
+        state->finishedCondition.wait(&state->mutex,
+                                      static_cast<unsigned long>(timeout - timer.elapsed()));
+    }
+    if (!state->finished) {
+        state->abandoned = true;
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Timeout while accessing the "
+            "directory \"%1\". Is the file system available?")).arg(mDirToLock.toNative()));
+    }
+    if (state->error) {
+        state->error->raise();
     }
-
-    // when the directory is valid, the lock filepath must be valid too
-    Q_ASSERT(mLockFilePath.isValid());
-
-    // prepare the content which will be written to the lock file
-    QStringList lines;
-    lines.append(SystemInfo::getFullUsername());
-    lines.append(SystemInfo::getUsername());
-    lines.append(SystemInfo::getHostname());
-    lines.append(QString::number(QCoreApplication::applicationPid()));
-    lines.append(SystemInfo::getProcessNameByPid(qApp->applicationPid()));
-    lines.append(QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
-    QByteArray utf8content = lines.join('\n').toUtf8();
-
-    // create/overwrite lock file
-    FileUtils::writeFile(mLockFilePath, utf8content); // can throw
-
-    // File Lock successfully created
-    mLockedByThisObject = true;
 }
 
-void DirectoryLock::unlock()
+void DirectoryLock::updateHeartbeat(Heartbeat& heartbeat) noexcept
 {
-    // remove the lock file
-    FileUtils::removeFile(mLockFilePath); // can throw
-
-    // File Lock successfully removed
-    mLockedByThisObject = false;
+    // if the previous heartbeat still hangs in the file system (or the lock is being
+    // released), do not block another worker thread
+    if (!heartbeat.mutex.tryLock()) {
+        return;
+    }
+    try {
+        // do not overwrite the lock file if someone else has taken over the lock
+        QString prefix = heartbeat.lines.join('\n') % '\n';
+        if (!heartbeat.active) {
+            // the lock has been released in the meantime
+        } else if (!QString::fromUtf8(FileUtils::readFile(heartbeat.lockFilePath))
+                    .startsWith(prefix)) { // can throw
+            qWarning() << "The lock file was overwritten by someone else:"
+                       << heartbeat.lockFilePath.toNative();
+            heartbeat.active = false;
+        } else {
+            QStringList lines = heartbeat.lines;
+            lines.append(QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+            FileUtils::writeFile(heartbeat.lockFilePath, lines.join('\n').toUtf8()); // can throw
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Could not update the lock file:" << e.getMsg();
+    }
+    heartbeat.mutex.unlock();
 }
 
 /*****************************************************************************************
@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include "filepath.h"
 #include "../exceptions.h"
 
@@ -61,7 +62,8 @@ namespace librepcb {
  *  -# The hostname of the user's computer which holds the lock
  *  -# The process id (PID) of the application instance which holds the lock
  *  -# The process name of the application instance which holds the lock
- *  -# The datetime when the lock file was created/updated (UTC and ISO format!)
+ *  -# The datetime when the lock file was created/updated (UTC and ISO format!). While
+ *     the lock is held, it is updated periodically as a heartbeat (see below).
  *
  * Example:
  * @code
@@ -83,6 +85,16 @@ namespace librepcb {
  * locked directory (e.g. project auto-save), this allows to ask the user whether the
  * backup should be restored or not.
  *
+ * For lock files created by other users or computers, the process can not be checked.
+ * Instead, the datetime of the lock file is refreshed every #sHeartbeatInterval
+ * milliseconds while the lock is held (in a worker thread, as long as the event loop of
+ * the locking thread is running). A lock file which was not refreshed for more than
+ * #sStaleLockTimeout milliseconds is considered as stale.
+ *
+ * On slow or hanging (network) file systems, #getStatus(), #tryLock() and #lock() can be
+ * called with a timeout. The file operations are then executed in a worker thread, and
+ * an exception is thrown if they did not finish in time.
+ *
  *
  * <b>How to use this class:</b>
  *
@@ -228,11 +240,14 @@ class DirectoryLock final
         /**
          * @brief Get the lock status of the specified directory
          *
+         * @param timeout   The maximum time to wait for the file system in milliseconds,
+         *                  or -1 to wait forever
+         *
          * @return  The current lock status (see #LockStatus)
          *
-         * @throw   Exception on error (e.g. invalid filepath, no access rights, ...)
+         * @throw   Exception on error (e.g. invalid filepath, no access rights, timeout...)
          */
-        LockStatus getStatus() const;
+        LockStatus getStatus(int timeout = -1) const;
 
 
         // General Methods
@@ -249,10 +264,11 @@ class DirectoryLock final
          *
          * @param wasStale  This variable will be set to true if there was a stale lock,
          *                  and to false if not (if a valid pointer was passed).
+         * @param timeout   See #getStatus() and #lock()
          *
          * @throw   Exception on error (e.g. already locked, no access rights, ...)
          */
-        void tryLock(bool* wasStale = nullptr);
+        void tryLock(bool* wasStale = nullptr, int timeout = -1);
 
         /**
          * @brief Unlock the specified directory if it was locked by this object
@@ -273,9 +289,13 @@ class DirectoryLock final
          *          if it was created by another application instance! So: Always check
          *          the lock status first with #getStatus(), or use #tryLock() instead!
          *
-         * @throw   Exception on error (e.g. invalid filepath, no access rights, ...)
+         * @param timeout   The maximum time to wait for the file system in milliseconds,
+         *                  or -1 to wait forever. If the lock file is written after the
+         *                  timeout has expired, it is removed again.
+         *
+         * @throw   Exception on error (e.g. invalid filepath, no access rights, timeout...)
          */
-        void lock();
+        void lock(int timeout = -1);
 
         /**
          * @brief Unlock the specified directory (remove the lock file)
@@ -293,6 +313,46 @@ class DirectoryLock final
         DirectoryLock& operator=(const DirectoryLock& rhs) = delete;
 
 
+        // Constants
+        static const int sDefaultTimeout = 10 * 1000;           ///< in milliseconds
+        static const int sHeartbeatInterval = 60 * 1000;       ///< in milliseconds
+        static const qint64 sStaleLockTimeout = 15 * 60 * 1000; ///< in milliseconds
+
+
+    private: // Types
+        struct Heartbeat;
+
+
+    private: // Methods
+
+        /**
+         * @brief Read the lock status (see #getStatus())
+         *
+         * This is static to allow running it in a worker thread which may outlive the
+         * DirectoryLock object in case of a timeout.
+         */
+        static LockStatus readStatus(const FilePath& dirToLock, const FilePath& lockFilePath);
+
+        /**
+         * @brief Run a file operation in a worker thread and wait until it has finished
+         *
+         * @param operation     The operation to run (must not reference this object)
+         * @param onAbandoned   Called in the worker thread when the operation has
+         *                      finished after the timeout has expired (may be nullptr)
+         * @param timeout       The timeout in milliseconds (-1 runs the operation in
+         *                      the calling thread)
+         *
+         * @throw Exception     If the operation has thrown or the timeout has expired
+         */
+        void runWithTimeout(const std::function<void()>& operation,
+                            const std::function<void()>& onAbandoned, int timeout) const;
+
+        /**
+         * @brief Refresh the datetime of the lock file (called in a worker thread)
+         */
+        static void updateHeartbeat(Heartbeat& heartbeat) noexcept;
+
+
     private: // Data
 
         /**
@@ -322,6 +382,16 @@ class DirectoryLock final
          * true, the destructor will call #unlock() to remove the file lock.
          */
         bool mLockedByThisObject;
+
+        /**
+         * @brief The state shared with the heartbeat jobs (only while locked)
+         */
+        QSharedPointer<Heartbeat> mHeartbeat;
+
+        /**
+         * @brief The timer which triggers the heartbeat jobs (only while locked)
+         */
+        QScopedPointer<QTimer> mHeartbeatTimer;
 };
 
 /*****************************************************************************************
@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "domdocument.h"
 #include "domelement.h"
+#include "mappedfile.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -42,27 +43,20 @@ DomDocument::DomDocument(DomElement& root) noexcept :
 DomDocument::DomDocument(const QByteArray& fileContent, const FilePath& filepath) :
     mFilePath(filepath), mRootElement(nullptr)
 {
-    QDomDocument doc;
-    doc.implementation().setInvalidDataPolicy(QDomImplementation::ReturnNullNode);
-
-    QString errMsg;
-    int errLine;
-    int errColumn;
-    if (!doc.setContent(fileContent, &errMsg, &errLine, &errColumn)) {
-        qDebug() << "line:" << fileContent.split('\n').at(errLine-1);
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("Error while parsing file \"%1\": %2 [%3:%4]"))
-            .arg(filepath.toNative(), errMsg).arg(errLine).arg(errColumn));
-    }
+    QXmlStreamReader reader(fileContent);
+    parse(reader, &fileContent); // can throw
+}
 
-    // check if the root node exists
-    QDomElement root = doc.documentElement();
-    if (root.isNull()) {
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("No root node found in \"%1\"!")).arg(mFilePath.toNative()));
-    }
+DomDocument::DomDocument(const MappedFile& file) :
+    DomDocument(file.getContent(), file.getFilePath())
+{
+}
 
-    mRootElement.reset(DomElement::fromQDomElement(root, this));
+DomDocument::DomDocument(QIODevice& device, const FilePath& filepath) :
+    mFilePath(filepath), mRootElement(nullptr)
+{
+    QXmlStreamReader reader(&device);
+    parse(reader, nullptr); // can throw
 }
 
 DomDocument::~DomDocument() noexcept
@@ -92,9 +86,7 @@ QByteArray DomDocument::toByteArray() const
 {
     QByteArray data;
     QXmlStreamWriter writer(&data);
-    writer.setAutoFormatting(true);
-    writer.setAutoFormattingIndent(1); // indent only 1 space to save disk space
-    writer.setCodec("UTF-8");
+    setupXmlStreamWriter(writer);
     writer.writeStartDocument("1.0", true);
     mRootElement->writeToQXmlStreamWriter(writer);
     writer.writeEndDocument();
@@ -102,6 +94,81 @@ QByteArray DomDocument::toByteArray() const
     return data;
 }
 
+QByteArray DomDocument::toBinary() const noexcept
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream << sBinaryMagic << sBinaryFormatVersion;
+    QHash<QString, quint32> names;
+    mRootElement->writeToDataStream(stream, names);
+    return data;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+std::unique_ptr<DomDocument> DomDocument::fromBinary(const QByteArray& data,
+                                                     const FilePath& filepath)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_2);
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if ((magic != sBinaryMagic) || (version != sBinaryFormatVersion)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Unsupported binary format of \"%1\".")).arg(filepath.toNative()));
+    }
+    QScopedPointer<DomElement> root(DomElement::fromDataStream(stream));
+    if ((stream.status() != QDataStream::Ok) || (!stream.atEnd())) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Corrupt binary data of \"%1\".")).arg(filepath.toNative()));
+    }
+    std::unique_ptr<DomDocument> doc(new DomDocument(*root.take()));
+    doc->mFilePath = filepath;
+    return doc;
+}
+
+void DomDocument::setupXmlStreamWriter(QXmlStreamWriter& writer) noexcept
+{
+    writer.setAutoFormatting(true);
+    writer.setAutoFormattingIndent(1); // indent only 1 space to save disk space
+    writer.setCodec("UTF-8");
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void DomDocument::parse(QXmlStreamReader& reader, const QByteArray* fileContent)
+{
+    // build the DOM tree in a single pass, without an intermediate QDomDocument
+    if (reader.readNextStartElement()) {
+        mRootElement.reset(DomElement::fromQXmlStreamReader(reader, this));
+        while (!reader.atEnd()) {
+            reader.readNext(); // check the rest of the document for errors
+        }
+    }
+
+    if (reader.hasError()) {
+        int errLine = reader.lineNumber();
+        if (fileContent) {
+            qDebug() << "line:" << fileContent->split('\n').value(errLine-1);
+        }
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Error while parsing file \"%1\": %2 [%3:%4]"))
+            .arg(mFilePath.toNative(), reader.errorString()).arg(errLine)
+            .arg(reader.columnNumber()));
+    }
+
+    // check if the root node exists
+    if (!mRootElement) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("No root node found in \"%1\"!")).arg(mFilePath.toNative()));
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
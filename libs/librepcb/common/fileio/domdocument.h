@@ -27,6 +27,7 @@
 #include <QDomDocument>
 #include "../exceptions.h"
 #include "filepath.h"
+#include <memory>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -34,6 +35,7 @@
 namespace librepcb {
 
 class DomElement;
+class MappedFile;
 
 /*****************************************************************************************
  *  Class DomDocument
@@ -74,6 +76,31 @@ class DomDocument final
          */
         explicit DomDocument(const QByteArray& fileContent, const FilePath& filepath);
 
+        /**
+         * @brief Constructor to create the whole DOM tree from a memory mapped file
+         *
+         * The mapped content is parsed directly, without copying it. The DOM tree does
+         * not reference the content, so the file may be closed after construction.
+         *
+         * @param file              The opened file to load
+         *
+         * @throw Exception         If parsing the file has failed.
+         */
+        explicit DomDocument(const MappedFile& file);
+
+        /**
+         * @brief Constructor to create the whole DOM tree from a device
+         *
+         * The content is read incrementally while parsing, so this can be used to parse
+         * a stream which is decompressed on the fly.
+         *
+         * @param device            The opened (readable) device to load
+         * @param filepath          The filepath of the file (needed for the exceptions)
+         *
+         * @throw Exception         If parsing the file has failed.
+         */
+        explicit DomDocument(QIODevice& device, const FilePath& filepath);
+
         /**
          * @brief Destructor (destroys the whole DOM tree)
          */
@@ -116,16 +143,67 @@ class DomDocument final
          */
         QByteArray toByteArray() const;
 
+        /**
+         * @brief Export the whole DOM tree in a compact binary format
+         *
+         * The binary format is much faster to load than XML (see #fromBinary()), but it
+         * is only intended for caches since it may change with every application version.
+         *
+         * @return The binary representation of the DOM tree
+         */
+        QByteArray toBinary() const noexcept;
+
+
+        // Static Methods
+
+        /**
+         * @brief Create the whole DOM tree from data created by #toBinary()
+         *
+         * @param data          The binary data to load
+         * @param filepath      The filepath of the original file (needed for exceptions)
+         *
+         * @return The created DOM document
+         *
+         * @throw Exception     If the data is invalid or from another format version.
+         */
+        static std::unique_ptr<DomDocument> fromBinary(const QByteArray& data,
+                                                       const FilePath& filepath);
+
+        /**
+         * @brief Apply the formatting options used for all XML files to a stream writer
+         *
+         * @param writer    The writer to configure
+         */
+        static void setupXmlStreamWriter(QXmlStreamWriter& writer) noexcept;
+
 
         // Operator Overloadings
         DomDocument& operator=(const DomDocument& rhs) = delete;
 
 
-    private:
+    private: // Methods
+
+        /**
+         * @brief Build the DOM tree from a XML stream reader
+         *
+         * @param reader            The reader to read the whole document from
+         * @param fileContent       The parsed content to print the erroneous line on
+         *                          errors (optional)
+         *
+         * @throw Exception         If parsing the file has failed.
+         */
+        void parse(QXmlStreamReader& reader, const QByteArray* fileContent);
+
+
+    private: // Data
 
         // General
         FilePath mFilePath;                         ///< the filepath from the constructor
         QScopedPointer<DomElement> mRootElement; ///< the root DOM element
+
+        // Constants
+        static const quint32 sBinaryMagic = 0x4C504442;    ///< "LPDB"
+        static const quint32 sBinaryFormatVersion = 1;    ///< see #toBinary()
 };
 
 /*****************************************************************************************
@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "domdocumentcache.h"
+#include "domdocument.h"
+#include "fileutils.h"
+#include "mappedfile.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+DomDocumentCache::DomDocumentCache(const FilePath& directory) noexcept :
+    mDirectory(directory)
+{
+}
+
+DomDocumentCache::~DomDocumentCache() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+std::unique_ptr<DomDocument> DomDocumentCache::load(const FilePath& filepath,
+                                                    const QByteArray& hash) noexcept
+{
+    QString fileName = getEntryFileName(hash);
+    FilePath entryFilePath = mDirectory.getPathTo(fileName);
+    if (!entryFilePath.isExistingFile()) {
+        return nullptr;
+    }
+    try {
+        MappedFile file(entryFilePath); // can throw
+        std::unique_ptr<DomDocument> doc =
+            DomDocument::fromBinary(file.getContent(), filepath); // can throw
+        QMutexLocker locker(&mMutex);
+        mUsedEntries.insert(fileName);
+        return doc;
+    } catch (const Exception& e) {
+        // the entry will be overwritten after parsing the XML file
+        qWarning() << "Invalid DOM cache entry:" << entryFilePath.toNative() << e.getMsg();
+        return nullptr;
+    }
+}
+
+void DomDocumentCache::store(const QByteArray& hash, const DomDocument& document) noexcept
+{
+    QString fileName = getEntryFileName(hash);
+    try {
+        FileUtils::writeFile(mDirectory.getPathTo(fileName), document.toBinary()); // can throw
+        QMutexLocker locker(&mMutex);
+        mUsedEntries.insert(fileName);
+    } catch (const Exception& e) {
+        qWarning() << "Could not write DOM cache entry:" << e.getMsg();
+    }
+}
+
+void DomDocumentCache::removeUnusedEntries() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    QDir dir(mDirectory.toStr());
+    foreach (const QString& fileName, dir.entryList(QStringList("*.bin"), QDir::Files)) {
+        if (!mUsedEntries.contains(fileName)) {
+            try {
+                FileUtils::removeFile(mDirectory.getPathTo(fileName)); // can throw
+            } catch (const Exception& e) {
+                qWarning() << "Could not remove DOM cache entry:" << e.getMsg();
+            }
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QString DomDocumentCache::getEntryFileName(const QByteArray& hash) const noexcept
+{
+    return QString::fromLatin1(hash.toHex()) % ".bin";
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,129 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_DOMDOCUMENTCACHE_H
+#define LIBREPCB_DOMDOCUMENTCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <memory>
+#include "filepath.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class DomDocument;
+
+/*****************************************************************************************
+ *  Class DomDocumentCache
+ ****************************************************************************************/
+
+/**
+ * @brief The DomDocumentCache class stores parsed DOM trees in a binary format to load
+ *        them much faster than parsing the original XML files again
+ *
+ * Each entry is a file in the cache directory, named by the hash of the XML file
+ * content it was created from. So a modified XML file never matches an outdated entry,
+ * and the XML files always stay the source of truth. The whole directory can be
+ * deleted at any time, it is rebuilt automatically.
+ *
+ * All errors are ignored (but logged): if an entry cannot be loaded, the XML file just
+ * needs to be parsed, and if an entry cannot be stored, the next load is slower.
+ *
+ * @note #load() and #store() are thread-safe, so the cache can be used by several
+ *       parser threads at the same time.
+ *
+ * @see librepcb::DomDocument::toBinary(), librepcb::SmartXmlFile::parseFileAndBuildDomTree()
+ */
+class DomDocumentCache final
+{
+    public:
+
+        // Constructors / Destructor
+        DomDocumentCache() = delete;
+        DomDocumentCache(const DomDocumentCache& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param directory     The directory of the cache entries (created on demand)
+         */
+        explicit DomDocumentCache(const FilePath& directory) noexcept;
+        ~DomDocumentCache() noexcept;
+
+
+        // Getters
+        const FilePath& getDirectory() const noexcept {return mDirectory;}
+
+
+        // General Methods
+
+        /**
+         * @brief Load a cached DOM tree
+         *
+         * @param filepath      The filepath of the XML file (used for error messages)
+         * @param hash          The hash of the XML file content
+         *
+         * @return The cached DOM tree, or nullptr if there is no (valid) entry
+         */
+        std::unique_ptr<DomDocument> load(const FilePath& filepath,
+                                          const QByteArray& hash) noexcept;
+
+        /**
+         * @brief Store a DOM tree in the cache
+         *
+         * @param hash          The hash of the XML file content the tree was parsed from
+         * @param document      The DOM tree to store
+         */
+        void store(const QByteArray& hash, const DomDocument& document) noexcept;
+
+        /**
+         * @brief Remove all entries which were neither loaded nor stored by this object
+         *
+         * Call this after all files have been loaded, to remove the entries of outdated
+         * file contents.
+         */
+        void removeUnusedEntries() noexcept;
+
+
+        // Operator Overloadings
+        DomDocumentCache& operator=(const DomDocumentCache& rhs) = delete;
+
+
+    private: // Methods
+        QString getEntryFileName(const QByteArray& hash) const noexcept;
+
+
+    private: // Data
+        FilePath mDirectory;
+        QMutex mMutex;
+        QSet<QString> mUsedEntries; ///< file names of all loaded or stored entries
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_DOMDOCUMENTCACHE_H
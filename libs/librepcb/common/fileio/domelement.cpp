@@ -20,6 +20,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <algorithm>
 #include <QtCore>
 #include "domelement.h"
 #include "domdocument.h"
@@ -39,24 +40,64 @@ DomElement::DomElement(const QString& name, const QString& text) noexcept :
     Q_ASSERT(isValidTagName(mName) == true);
 }
 
-DomElement::DomElement(QDomElement domElement, DomElement* parent, DomDocument* doc) noexcept :
-    mDocument(doc), mParent(parent), mName(domElement.tagName()), mText()
+DomElement::DomElement(QXmlStreamReader& reader, NameTable& names, DomElement* parent,
+                       DomDocument* doc) noexcept :
+    mDocument(doc), mParent(parent), mName(internName(names, reader.name())), mText()
 {
+    Q_ASSERT(reader.isStartElement());
     Q_ASSERT(isValidTagName(mName) == true);
 
-    QDomNamedNodeMap map = domElement.attributes();
-    for (int i = 0; i < map.count(); i++)
-        mAttributes.insert(map.item(i).nodeName(), map.item(i).nodeValue());
+    QXmlStreamAttributes attributes = reader.attributes();
+    mAttributes.reserve(attributes.count());
+    foreach (const QXmlStreamAttribute& attribute, attributes) {
+        setAttributeString(internName(names, attribute.name()),
+                           attribute.value().toString());
+    }
 
-    QDomElement child = domElement.firstChildElement();
-    while (!child.isNull())
+    // whitespace-only text is ignored, like QDomDocument did before
+    QString text;
+    while (!reader.atEnd())
     {
-        mChilds.append(new DomElement(child, this));
-        child = child.nextSiblingElement();
+        switch (reader.readNext())
+        {
+            case QXmlStreamReader::StartElement:
+                mChilds.append(new DomElement(reader, names, this));
+                break;
+            case QXmlStreamReader::Characters:
+                if (!reader.isWhitespace()) text.append(reader.text());
+                break;
+            case QXmlStreamReader::EndElement:
+                if (mChilds.isEmpty())
+                    mText = text;
+                return;
+            default:
+                break;
+        }
     }
+    // reaching this point means a parse error, which is handled by the caller
+}
 
-    if (mChilds.isEmpty())
-        mText = domElement.text();
+DomElement::DomElement(QDataStream& stream, QVector<QString>& names, DomElement* parent,
+                       DomDocument* doc) noexcept :
+    mDocument(doc), mParent(parent), mName(readName(stream, names)), mText()
+{
+    quint32 attributeCount = 0;
+    stream >> attributeCount;
+    for (quint32 i = 0; (i < attributeCount) && (stream.status() == QDataStream::Ok); ++i) {
+        QString name = readName(stream, names);
+        QString value;
+        stream >> value;
+        mAttributes.append(Attribute(name, value)); // already sorted by name
+    }
+
+    quint32 childCount = 0;
+    stream >> childCount;
+    if (childCount == 0) {
+        stream >> mText;
+    }
+    for (quint32 i = 0; (i < childCount) && (stream.status() == QDataStream::Ok); ++i) {
+        mChilds.append(new DomElement(stream, names, this));
+    }
 }
 
 DomElement::~DomElement() noexcept
@@ -100,7 +141,7 @@ FilePath DomElement::getDocFilePath() const noexcept
 
 bool DomElement::hasAttribute(const QString& name) const noexcept
 {
-    return mAttributes.contains(name);
+    return findAttribute(name) >= 0;
 }
 
 /*****************************************************************************************
@@ -270,14 +311,14 @@ DomElement* DomElement::getNextSibling(const QString& name, bool throwIfNotFound
 }
 
 /*****************************************************************************************
- *  QDomElement Converter Methods
+ *  Conversion Methods
  ****************************************************************************************/
 
 void DomElement::writeToQXmlStreamWriter(QXmlStreamWriter& writer) const noexcept
 {
     writer.writeStartElement(mName);
-    foreach (const QString& key, mAttributes.keys()) {
-        writer.writeAttribute(key, mAttributes[key]);
+    foreach (const Attribute& attribute, mAttributes) {
+        writer.writeAttribute(attribute.first, attribute.second);
     }
     if (hasChilds()) {
         foreach (DomElement* child, mChilds) {
@@ -289,15 +330,109 @@ void DomElement::writeToQXmlStreamWriter(QXmlStreamWriter& writer) const noexcep
     writer.writeEndElement();
 }
 
-DomElement* DomElement::fromQDomElement(QDomElement domElement, DomDocument* doc) noexcept
+DomElement* DomElement::fromQXmlStreamReader(QXmlStreamReader& reader, DomDocument* doc) noexcept
 {
-    return new DomElement(domElement, nullptr, doc);
+    NameTable names;
+    return new DomElement(reader, names, nullptr, doc);
+}
+
+void DomElement::writeToDataStream(QDataStream& stream,
+                                   QHash<QString, quint32>& names) const noexcept
+{
+    writeName(stream, names, mName);
+    stream << static_cast<quint32>(mAttributes.count());
+    foreach (const Attribute& attribute, mAttributes) {
+        writeName(stream, names, attribute.first);
+        stream << attribute.second;
+    }
+    stream << static_cast<quint32>(mChilds.count());
+    if (mChilds.isEmpty()) {
+        stream << mText; // a null text is restored as null
+    }
+    foreach (const DomElement* child, mChilds) {
+        child->writeToDataStream(stream, names);
+    }
+}
+
+DomElement* DomElement::fromDataStream(QDataStream& stream, DomDocument* doc) noexcept
+{
+    QVector<QString> names;
+    return new DomElement(stream, names, nullptr, doc);
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void DomElement::writeName(QDataStream& stream, QHash<QString, quint32>& names,
+                           const QString& name) noexcept
+{
+    QHash<QString, quint32>::const_iterator it = names.constFind(name);
+    if (it != names.constEnd()) {
+        stream << it.value();
+    } else {
+        // a new name is written with the next free index, followed by the name itself
+        quint32 index = names.count();
+        names.insert(name, index);
+        stream << index << name;
+    }
+}
+
+QString DomElement::readName(QDataStream& stream, QVector<QString>& names) noexcept
+{
+    quint32 index = 0;
+    stream >> index;
+    if (stream.status() != QDataStream::Ok) {
+        return QString();
+    } else if (index < static_cast<quint32>(names.count())) {
+        return names.at(index);
+    } else if (index == static_cast<quint32>(names.count())) {
+        QString name;
+        stream >> name;
+        names.append(name);
+        return name;
+    } else {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return QString();
+    }
+}
+
+QString DomElement::internName(NameTable& names, const QStringRef& name) noexcept
+{
+    QString str = name.toString();
+    NameTable::const_iterator it = names.constFind(str);
+    if (it != names.constEnd()) {
+        return it.value();
+    }
+    names.insert(str, str);
+    return str;
+}
+
+int DomElement::findAttribute(const QString& name) const noexcept
+{
+    // the attributes are sorted by name, so a binary search can be used
+    QVector<Attribute>::const_iterator it = std::lower_bound(mAttributes.constBegin(),
+        mAttributes.constEnd(), name,
+        [](const Attribute& a, const QString& n) {return a.first < n;});
+    if ((it != mAttributes.constEnd()) && (it->first == name)) {
+        return it - mAttributes.constBegin();
+    } else {
+        return -1;
+    }
+}
+
+void DomElement::setAttributeString(const QString& name, const QString& value) noexcept
+{
+    QVector<Attribute>::iterator it = std::lower_bound(mAttributes.begin(),
+        mAttributes.end(), name,
+        [](const Attribute& a, const QString& n) {return a.first < n;});
+    if ((it != mAttributes.end()) && (it->first == name)) {
+        it->second = value;
+    } else {
+        mAttributes.insert(it, Attribute(name, value));
+    }
+}
+
 bool DomElement::isValidTagName(const QString& name) noexcept
 {
     bool valid = !name.isEmpty();
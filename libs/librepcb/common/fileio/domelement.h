@@ -25,7 +25,6 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
-#include <QDomElement>
 #include "../exceptions.h"
 #include "filepath.h"
 
@@ -199,7 +198,7 @@ class DomElement final
          */
         template <typename T>
         void setAttribute(const QString& name, const T& value) noexcept {
-            mAttributes.insert(name, objectToString(value));
+            setAttributeString(name, objectToString(value));
         }
 
         /**
@@ -230,11 +229,12 @@ class DomElement final
          */
         template <typename T>
         T getAttribute(const QString& name, bool throwIfEmpty, const T& defaultValue = T()) const {
-            if (!mAttributes.contains(name)) {
+            int index = findAttribute(name);
+            if (index < 0) {
                 throw FileParseError(__FILE__, __LINE__, getDocFilePath(), -1, -1, QString(),
                     QString(tr("Attribute \"%1\" not found in node \"%2\".")).arg(name, mName));
             }
-            QString value = mAttributes.value(name);
+            const QString& value = mAttributes.at(index).second;
             try {
                 return stringToObject<T>(value, throwIfEmpty, defaultValue);
             } catch (const Exception& e) {
@@ -456,19 +456,55 @@ class DomElement final
         void writeToQXmlStreamWriter(QXmlStreamWriter& writer) const noexcept;
 
         /**
-         * @brief Construct a DomElement object from a QDomElement object (recursively)
+         * @brief Construct a DomElement object from a QXmlStreamReader (recursively)
          *
-         * @param domElement    The QDomElement to copy
+         * @param reader        The QXmlStreamReader which must be positioned at the start
+         *                      element to read. After returning, the reader is
+         *                      positioned at the corresponding end element (or at an
+         *                      error, which must be checked by the caller).
          * @param doc           The DOM Document of the newly created DomElement (only
          *                      needed for the root element)
          *
          * @return The created DomElement (the caller takes the ownership!)
          */
-        static DomElement* fromQDomElement(QDomElement domElement, DomDocument* doc = nullptr) noexcept;
+        static DomElement* fromQXmlStreamReader(QXmlStreamReader& reader,
+                                                DomDocument* doc = nullptr) noexcept;
+
+        /**
+         * @brief Serialize this DomElement into a compact binary stream (recursively)
+         *
+         * Tag and attribute names are written only once and then referenced by an index.
+         *
+         * @param stream        The stream to write into
+         * @param names         The indices of all names already written to the stream
+         *                      (must be empty for the root element)
+         */
+        void writeToDataStream(QDataStream& stream,
+                               QHash<QString, quint32>& names) const noexcept;
+
+        /**
+         * @brief Construct a DomElement object from a binary stream (recursively)
+         *
+         * @param stream        The stream written by #writeToDataStream(). If it is
+         *                      invalid, its status is set to QDataStream::ReadCorruptData
+         *                      (or QDataStream::ReadPastEnd), which must be checked by
+         *                      the caller.
+         * @param doc           The DOM Document of the newly created DomElement (only
+         *                      needed for the root element)
+         *
+         * @return The created DomElement (the caller takes the ownership!)
+         */
+        static DomElement* fromDataStream(QDataStream& stream,
+                                          DomDocument* doc = nullptr) noexcept;
 
 
     private:
 
+        // Types
+        typedef QPair<QString, QString> Attribute; ///< (name, value)
+        typedef QHash<QString, QString> NameTable; ///< see #internName()
+
+
         // make some methods inaccessible...
         DomElement() = delete;
         DomElement(const DomElement& other) = delete;
@@ -478,15 +514,77 @@ class DomElement final
         // Private Methods
 
         /**
-         * @brief Private constructor to create a DomElement from a QDomElement
+         * @brief Private constructor to create a DomElement from a QXmlStreamReader
+         *
+         * @param reader        The QXmlStreamReader, positioned at the start element
+         * @param parent        The parent of the newly created DomElement
+         * @param doc           The DOM Document of the newly created DomElement (only
+         *                      needed for the root element)
+         */
+        explicit DomElement(QXmlStreamReader& reader, NameTable& names,
+                            DomElement* parent = nullptr, DomDocument* doc = nullptr) noexcept;
+
+        /**
+         * @brief Private constructor to create a DomElement from a binary stream
          *
-         * @param domElement    The QDomElement to copy
+         * @param stream        The stream, positioned at the element to read
+         * @param names         The names read from the stream so far
          * @param parent        The parent of the newly created DomElement
          * @param doc           The DOM Document of the newly created DomElement (only
          *                      needed for the root element)
          */
-        explicit DomElement(QDomElement domElement, DomElement* parent = nullptr,
-                               DomDocument* doc = nullptr) noexcept;
+        explicit DomElement(QDataStream& stream, QVector<QString>& names,
+                            DomElement* parent = nullptr, DomDocument* doc = nullptr) noexcept;
+
+        /**
+         * @brief Get the shared instance of a tag or attribute name read from a file
+         *
+         * All elements of a parsed document share the same QString data for equal
+         * names, so the few dozen distinct names are stored only once per file.
+         *
+         * @param names     The name table of the document being parsed
+         * @param name      The name read from the file
+         *
+         * @return The interned name
+         */
+        static QString internName(NameTable& names, const QStringRef& name) noexcept;
+
+        /**
+         * @brief Write a tag or attribute name to a binary stream
+         *
+         * @param stream    The stream to write into
+         * @param names     The indices of all names already written to the stream
+         * @param name      The name to write (only its index if already written)
+         */
+        static void writeName(QDataStream& stream, QHash<QString, quint32>& names,
+                              const QString& name) noexcept;
+
+        /**
+         * @brief Read a tag or attribute name written by #writeName()
+         *
+         * @param stream    The stream to read from (on error, its status is set)
+         * @param names     The names read from the stream so far
+         *
+         * @return The name (shared by all elements of the document)
+         */
+        static QString readName(QDataStream& stream, QVector<QString>& names) noexcept;
+
+        /**
+         * @brief Get the index of an attribute in #mAttributes
+         *
+         * @param name  The attribute name
+         *
+         * @return The index of the attribute, or -1 if it does not exist
+         */
+        int findAttribute(const QString& name) const noexcept;
+
+        /**
+         * @brief Set or add an attribute, keeping #mAttributes sorted by name
+         *
+         * @param name      The attribute name
+         * @param value     The attribute value
+         */
+        void setAttributeString(const QString& name, const QString& value) noexcept;
 
         /**
          * @brief Check if a QString represents a valid tag name for elements and attributes
@@ -539,7 +637,7 @@ class DomElement final
         QString mName;              ///< the tag name of this element
         QString mText;              ///< the text of this element (only if there are no childs)
         QList<DomElement*> mChilds;      ///< all child elements (only if there is no text)
-        QMap<QString, QString> mAttributes; ///< all attributes of this element (key, value) in alphabetical order
+        QVector<Attribute> mAttributes; ///< all attributes of this element (flat, sorted by name)
 };
 
 /*****************************************************************************************
@@ -33,22 +33,19 @@ namespace librepcb {
  ****************************************************************************************/
 
 FilePath::FilePath() noexcept :
-    mIsValid(false), mFileInfo()
+    mData()
 {
-    mFileInfo.setCaching(false);
 }
 
 FilePath::FilePath(const QString& filepath) noexcept :
-    mIsValid(false), mFileInfo()
+    mData()
 {
-    mFileInfo.setCaching(false);
     FilePath::setPath(filepath);
 }
 
 FilePath::FilePath(const FilePath& other) noexcept :
-    mIsValid(other.mIsValid), mFileInfo(other.mFileInfo)
+    mData(other.mData)
 {
-    mFileInfo.setCaching(false);
 }
 
 /*****************************************************************************************
@@ -57,9 +54,26 @@ FilePath::FilePath(const FilePath& other) noexcept :
 
 bool FilePath::setPath(const QString& filepath) noexcept
 {
-    mFileInfo.setFile(makeWellFormatted(filepath));
-    mIsValid = mFileInfo.isAbsolute(); // check if the filepath is absolute
-    return mIsValid;
+    QString path = makeWellFormatted(filepath);
+    if (!QFileInfo(path).isAbsolute()) { // check if the filepath is absolute
+        mData.reset();
+        return false;
+    }
+
+    Data* data = new Data();
+    data->path = path;
+    data->hash = qHash(path, 0);
+    data->filenameIndex = path.lastIndexOf(QLatin1Char('/')) + 1;
+#ifdef Q_OS_WIN
+    if ((data->filenameIndex == 0) && (path.length() == 2) && (path.at(1) == QLatin1Char(':'))) {
+        data->filenameIndex = 2; // the drive root (e.g. "C:") has no filename
+    }
+#endif
+    data->firstDotIndex = path.indexOf(QLatin1Char('.'), data->filenameIndex);
+    data->lastDotIndex = path.lastIndexOf(QLatin1Char('.'));
+    if (data->lastDotIndex < data->filenameIndex) data->lastDotIndex = -1;
+    mData = data;
+    return true;
 }
 
 /*****************************************************************************************
@@ -68,18 +82,20 @@ bool FilePath::setPath(const QString& filepath) noexcept
 
 bool FilePath::isExistingFile() const noexcept
 {
-    if (!mIsValid)
+    if (!isValid())
         return false;
 
-    return (mFileInfo.isFile() && mFileInfo.exists());
+    QFileInfo info(mData->path);
+    return (info.isFile() && info.exists());
 }
 
 bool FilePath::isExistingDir() const noexcept
 {
-    if (!mIsValid)
+    if (!isValid())
         return false;
 
-    return (mFileInfo.isDir() && mFileInfo.exists());
+    QFileInfo info(mData->path);
+    return (info.isDir() && info.exists());
 }
 
 bool FilePath::isEmptyDir() const noexcept
@@ -87,48 +103,57 @@ bool FilePath::isEmptyDir() const noexcept
     if (!isExistingDir())
         return false;
 
-    QDir dir(mFileInfo.filePath());
+    QDir dir(mData->path);
     dir.setFilter(QDir::AllEntries | QDir::NoDotAndDotDot);
     return (dir.count() == 0);
 }
 
 bool FilePath::isRoot() const noexcept
 {
+    if (!isValid())
+        return false;
+
     // do not use QFileInfo::isRoot() because it's not the same as QDir::isRoot()!
-    QDir dir(mFileInfo.filePath());
-    return mIsValid && dir.isRoot();
+    QDir dir(mData->path);
+    return dir.isRoot();
 }
 
 bool FilePath::isLocatedInDir(const FilePath& dir) const noexcept
 {
-    if ((!mIsValid) || (!dir.mIsValid))
+    if ((!isValid()) || (!dir.isValid()))
         return false;
 
-    return toStr().startsWith(dir.toStr() % "/", Qt::CaseInsensitive);
+    // same as toStr().startsWith(dir.toStr() % "/"), but without temporary strings
+    const QString& path = mData->path;
+    const QString& dirPath = dir.mData->path;
+    int dirLength = dirPath.endsWith(QLatin1Char('/')) ? dirPath.length() - 1 : dirPath.length();
+    return (path.length() > dirLength + 1)
+        && (path.at(dirLength) == QLatin1Char('/'))
+        && (path.leftRef(dirLength).compare(dirPath.leftRef(dirLength), Qt::CaseInsensitive) == 0);
 }
 
 QString FilePath::toStr() const noexcept
 {
-    if (!mIsValid)
+    if (!isValid())
         return QString();
 
-    return mFileInfo.filePath();
+    return mData->path;
 }
 
 QString FilePath::toNative() const noexcept
 {
-    if (!mIsValid)
+    if (!isValid())
         return QString();
 
-    return QDir::toNativeSeparators(mFileInfo.filePath());
+    return QDir::toNativeSeparators(mData->path);
 }
 
 FilePath FilePath::toUnique() const noexcept
 {
-    if (!mIsValid)
+    if (!isValid())
         return FilePath();
 
-    FilePath unique(mFileInfo.canonicalFilePath());
+    FilePath unique(QFileInfo(mData->path).canonicalFilePath());
 
     if (!unique.isValid())
         unique = *this;
@@ -138,64 +163,107 @@ FilePath FilePath::toUnique() const noexcept
 
 QString FilePath::toRelative(const FilePath& base) const noexcept
 {
-    if ((!mIsValid) || (!base.mIsValid))
+    if ((!isValid()) || (!base.isValid()))
         return QString();
 
-    QDir baseDir(base.mFileInfo.filePath());
-    return makeWellFormatted(baseDir.relativeFilePath(mFileInfo.filePath()));
+    // fast path: this filepath is equal to the base or located inside of it
+    const QString& path = mData->path;
+    const QString& basePath = base.mData->path;
+    if (*this == base) {
+        return QString("");
+    } else if (basePath.endsWith(QLatin1Char('/'))) { // base is the UNIX root
+        if (path.startsWith(basePath)) {
+            return path.mid(basePath.length());
+        }
+    } else if ((path.length() > basePath.length() + 1)
+               && (path.at(basePath.length()) == QLatin1Char('/'))
+               && (path.startsWith(basePath))) {
+        return path.mid(basePath.length() + 1);
+    }
+
+    QDir baseDir(basePath);
+    return makeWellFormatted(baseDir.relativeFilePath(path));
 }
 
 QString FilePath::getBasename() const noexcept
 {
-    if (mIsValid)
-        return mFileInfo.baseName();
-    else
+    if (!isValid())
         return QString();
+
+    int end = (mData->firstDotIndex >= 0) ? mData->firstDotIndex : mData->path.length();
+    return mData->path.mid(mData->filenameIndex, end - mData->filenameIndex);
 }
 
 QString FilePath::getCompleteBasename() const noexcept
 {
-    if (mIsValid)
-        return mFileInfo.completeBaseName();
-    else
+    if (!isValid())
         return QString();
+
+    int end = (mData->lastDotIndex >= 0) ? mData->lastDotIndex : mData->path.length();
+    return mData->path.mid(mData->filenameIndex, end - mData->filenameIndex);
 }
 
 QString FilePath::getSuffix() const noexcept
 {
-    if (mIsValid)
-        return mFileInfo.suffix();
-    else
+    if ((!isValid()) || (mData->lastDotIndex < 0))
         return QString();
+
+    return mData->path.mid(mData->lastDotIndex + 1);
 }
 
 QString FilePath::getCompleteSuffix() const noexcept
 {
-    if (mIsValid)
-        return mFileInfo.completeSuffix();
-    else
+    if ((!isValid()) || (mData->firstDotIndex < 0))
         return QString();
+
+    return mData->path.mid(mData->firstDotIndex + 1);
 }
 
 QString FilePath::getFilename() const noexcept
 {
-    if (mIsValid)
-        return mFileInfo.fileName();
-    else
+    if (!isValid())
         return QString();
+
+    return mData->path.mid(mData->filenameIndex);
 }
 
 FilePath FilePath::getParentDir() const noexcept
 {
-    if ((!mIsValid) || (isRoot()))
+    if ((!isValid()) || (isRoot()))
         return FilePath();
 
-    return FilePath(mFileInfo.dir().path());
+    // keep the slash if the parent is the UNIX root
+    return FilePath(mData->path.left(qMax(mData->filenameIndex - 1, 1)));
 }
 
 FilePath FilePath::getPathTo(const QString& filename) const noexcept
 {
-    return FilePath(mFileInfo.filePath() % QLatin1Char('/') % filename);
+    if (!isValid())
+        return FilePath();
+
+    // fast path: appending a plain filename to a well-formatted path keeps it
+    // well-formatted, so the path only needs to be cleaned in the other cases
+    if ((!filename.isEmpty()) && (filename != ".") && (filename != "..")
+        && (!filename.contains(QLatin1Char('/'))) && (!filename.contains(QLatin1Char('\\'))))
+    {
+        const QString& path = mData->path;
+        FilePath fp;
+        Data* data = new Data();
+        if (path.endsWith(QLatin1Char('/'))) {
+            data->path = path % filename;
+        } else {
+            data->path = path % QLatin1Char('/') % filename;
+        }
+        data->hash = qHash(data->path, 0);
+        data->filenameIndex = data->path.length() - filename.length();
+        data->firstDotIndex = data->path.indexOf(QLatin1Char('.'), data->filenameIndex);
+        data->lastDotIndex = data->path.lastIndexOf(QLatin1Char('.'));
+        if (data->lastDotIndex < data->filenameIndex) data->lastDotIndex = -1;
+        fp.mData = data;
+        return fp;
+    }
+
+    return FilePath(mData->path % QLatin1Char('/') % filename);
 }
 
 /*****************************************************************************************
@@ -204,18 +272,19 @@ FilePath FilePath::getPathTo(const QString& filename) const noexcept
 
 FilePath& FilePath::operator=(const FilePath& rhs) noexcept
 {
-    mFileInfo = rhs.mFileInfo;
-    mIsValid = rhs.mIsValid;
+    mData = rhs.mData;
     return *this;
 }
 
 bool FilePath::operator==(const FilePath& rhs) const noexcept
 {
-    if (mIsValid != rhs.mIsValid)
+    if (mData == rhs.mData)
+        return true; // same shared data or both invalid
+    if ((!mData) || (!rhs.mData))
         return false;
-    if (mFileInfo.filePath() != rhs.mFileInfo.filePath())
+    if (mData->hash != rhs.mData->hash)
         return false;
-    return true;
+    return (mData->path == rhs.mData->path);
 }
 
 bool FilePath::operator!=(const FilePath& rhs) const noexcept
@@ -229,10 +298,10 @@ bool FilePath::operator!=(const FilePath& rhs) const noexcept
 
 FilePath FilePath::fromRelative(const FilePath& base, const QString& relative) noexcept
 {
-    if (!base.mIsValid)
+    if (!base.isValid())
         return FilePath();
 
-    return FilePath(base.mFileInfo.filePath() % QLatin1Char('/') % relative);
+    return base.getPathTo(relative);
 }
 
 FilePath FilePath::getTempPath() noexcept
@@ -181,7 +181,7 @@ class FilePath final
          *
          * @return true if the filepath is valid, false if not
          */
-        bool isValid() const noexcept {return mIsValid;}
+        bool isValid() const noexcept {return mData.constData() != nullptr;}
 
         /**
          * @brief Check if the specified filepath is an existing file
@@ -407,7 +407,8 @@ class FilePath final
         /**
          * @brief The "==" operator to compare two FilePath objects
          *
-         * @note This method compares the return values of #toStr() of both objects.
+         * @note This method compares the return values of #toStr() of both objects. As
+         *       the hash of the filepath is cached, comparing different paths is cheap.
          *
          * @return true if both filepaths are identical, false otherwise
          */
@@ -427,6 +428,13 @@ class FilePath final
 
         // Private Methods
 
+        /**
+         * @brief Get the cached hash of the well-formatted filepath
+         *
+         * @return The same as qHash(toStr(), 0), but without recalculating it
+         */
+        uint getHash() const noexcept {return mData ? mData->hash : 0;}
+
         /**
          * @brief Make a filepath well-formatted (except making it absolute!)
          *
@@ -438,17 +446,37 @@ class FilePath final
         static QString makeWellFormatted(const QString& filepath) noexcept;
 
 
+        // Types
+
+        /**
+         * @brief The implicitly shared data of a valid #FilePath object
+         *
+         * All components which are often needed (hash, filename, suffix, ...) are
+         * determined once in #setPath() so that the getters only need to extract
+         * substrings and copies of a #FilePath only increment a reference counter.
+         */
+        struct Data : public QSharedData {
+            QString path;       ///< the absolute and well-formatted filepath
+            uint hash;          ///< qHash(path, 0)
+            int filenameIndex;  ///< index of the first character of the filename
+            int firstDotIndex;  ///< index of the first '.' in the filename (or -1)
+            int lastDotIndex;   ///< index of the last '.' in the filename (or -1)
+        };
+
+
         // Attributes
 
-        bool mIsValid;
-        QFileInfo mFileInfo; ///< the absolute and well-formatted filepath in a QFileInfo
+        /// The shared data, or nullptr if the filepath is invalid
+        QExplicitlySharedDataPointer<const Data> mData;
+
+        friend uint qHash(const FilePath& key, uint seed) noexcept;
 };
 
 // Non-Member Functions
 QDataStream& operator<<(QDataStream& stream, const FilePath& filepath);
 QDebug& operator<<(QDebug& stream, const FilePath& filepath);
 inline uint qHash(const FilePath& key, uint seed) noexcept {
-    return qHash(key.toStr(), seed);
+    return key.getHash() ^ seed;
 }
 
 /*****************************************************************************************
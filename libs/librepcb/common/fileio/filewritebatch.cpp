@@ -0,0 +1,368 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "filewritebatch.h"
+#include "fileutils.h"
+
+#if defined(Q_OS_UNIX) // Mac OS X / Linux / UNIX
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64) // Windows
+#include <Windows.h>
+#include <io.h>
+#else
+#error "Unknown operating system!"
+#endif
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+FileWriteBatch* FileWriteBatch::sActiveBatch = nullptr;
+
+/*****************************************************************************************
+ *  Platform Specific Helpers
+ ****************************************************************************************/
+
+static bool syncFileToDisk(QFile& file) noexcept
+{
+    if (!file.flush()) return false;
+#if defined(Q_OS_UNIX) // Mac OS X / Linux / UNIX
+    return ::fsync(file.handle()) == 0;
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64) // Windows
+    HANDLE handle = reinterpret_cast<HANDLE>(::_get_osfhandle(file.handle()));
+    return ::FlushFileBuffers(handle) != 0;
+#endif
+}
+
+static bool replaceFile(const FilePath& source, const FilePath& destination) noexcept
+{
+#if defined(Q_OS_UNIX) // Mac OS X / Linux / UNIX
+    return ::rename(QFile::encodeName(source.toStr()).constData(),
+                    QFile::encodeName(destination.toStr()).constData()) == 0;
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64) // Windows
+    return ::MoveFileExW(reinterpret_cast<const wchar_t*>(source.toNative().utf16()),
+                         reinterpret_cast<const wchar_t*>(destination.toNative().utf16()),
+                         MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#endif
+}
+
+static bool createHardLink(const FilePath& target, const FilePath& link) noexcept
+{
+#if defined(Q_OS_UNIX) // Mac OS X / Linux / UNIX
+    return ::link(QFile::encodeName(target.toStr()).constData(),
+                  QFile::encodeName(link.toStr()).constData()) == 0;
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64) // Windows
+    return ::CreateHardLinkW(reinterpret_cast<const wchar_t*>(link.toNative().utf16()),
+                             reinterpret_cast<const wchar_t*>(target.toNative().utf16()),
+                             nullptr) != 0;
+#endif
+}
+
+static void syncDirectoryToDisk(const FilePath& dir) noexcept
+{
+#if defined(Q_OS_UNIX) // Mac OS X / Linux / UNIX
+    // make the renamed directory entries persistent
+    int fd = ::open(QFile::encodeName(dir.toStr()).constData(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    Q_UNUSED(dir); // MOVEFILE_WRITE_THROUGH already flushed the rename
+#endif
+}
+
+/*****************************************************************************************
+ *  Class FileWriteBatch::Collector
+ ****************************************************************************************/
+
+FileWriteBatch::Collector::Collector(FileWriteBatch& batch) noexcept :
+    mPreviousBatch(sActiveBatch)
+{
+    sActiveBatch = &batch;
+}
+
+FileWriteBatch::Collector::~Collector() noexcept
+{
+    sActiveBatch = mPreviousBatch;
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+FileWriteBatch::FileWriteBatch() noexcept :
+    mCollectUnmodifiedFiles(false)
+{
+}
+
+FileWriteBatch::~FileWriteBatch() noexcept
+{
+    Q_ASSERT(sActiveBatch != this);
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QList<FilePath> FileWriteBatch::getModifiedFiles() const noexcept
+{
+    QList<FilePath> files;
+    for (const Entry& entry : mEntries) {
+        if (entry.remove) {
+            if (entry.filepath.isExistingFile() || entry.filepath.isExistingDir()) {
+                files.append(entry.filepath);
+            }
+            continue;
+        }
+        QFile file(entry.filepath.toStr());
+        if ((file.size() != entry.content.size()) || (!file.open(QIODevice::ReadOnly))
+            || (file.readAll() != entry.content)) {
+            files.append(entry.filepath);
+        }
+    }
+    return files;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void FileWriteBatch::append(const FilePath& filepath, const QByteArray& content,
+                            const std::function<void()>& onWritten) noexcept
+{
+    mEntries.append(Entry{filepath, content, onWritten, false, false});
+}
+
+void FileWriteBatch::appendRemoval(const FilePath& filepath) noexcept
+{
+    mEntries.append(Entry{filepath, QByteArray(), nullptr, true, false});
+}
+
+QStringList FileWriteBatch::writeAll() noexcept
+{
+    QStringList errors;
+    for (Entry& entry : mEntries) {
+        if (entry.remove) continue;
+        try {
+            FileUtils::writeFile(entry.filepath, entry.content); // can throw
+            entry.written = true;
+        } catch (const Exception& e) {
+            errors.append(e.getMsg());
+        }
+    }
+    for (Entry& entry : mEntries) {
+        if (!entry.remove) continue;
+        try {
+            if (entry.filepath.isExistingDir()) {
+                FileUtils::removeDirRecursively(entry.filepath); // can throw
+            } else if (entry.filepath.isExistingFile()) {
+                FileUtils::removeFile(entry.filepath); // can throw
+            }
+            entry.written = true;
+        } catch (const Exception& e) {
+            errors.append(e.getMsg());
+        }
+    }
+    return errors;
+}
+
+void FileWriteBatch::commit()
+{
+    QList<FilePath> tmpFiles;
+    auto removeTmpFiles = [&tmpFiles]() {
+        foreach (const FilePath& fp, tmpFiles) {
+            QFile::remove(fp.toStr());
+        }
+    };
+
+    // step 1: write all files to temporary files and flush them to disk
+    for (const Entry& entry : mEntries) {
+        if (entry.remove) continue;
+        FilePath tmpFp = getTemporaryFilePath(entry.filepath);
+        QFile file(tmpFp.toStr());
+        try {
+            FileUtils::makePath(entry.filepath.getParentDir()); // can throw
+        } catch (const Exception&) {
+            removeTmpFiles();
+            throw;
+        }
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            removeTmpFiles();
+            throw RuntimeError(__FILE__, __LINE__,
+                QString(tr("Could not open or create file \"%1\": %2"))
+                .arg(tmpFp.toNative(), file.errorString()));
+        }
+        tmpFiles.append(tmpFp);
+        if ((file.write(entry.content) != entry.content.size()) || (!syncFileToDisk(file))) {
+            QString error = file.errorString();
+            file.close();
+            removeTmpFiles();
+            throw RuntimeError(__FILE__, __LINE__,
+                QString(tr("Could not write file \"%1\": %2"))
+                .arg(tmpFp.toNative(), error));
+        }
+    }
+
+    // step 2: move all temporary files into place and move the files to remove away,
+    // while keeping a backup of every replaced or removed file to allow a rollback
+    QSet<QString> modifiedDirs;
+    QList<Entry*> processed;    // in the order they were processed
+    QSet<Entry*> backups;       // entries whose original file was backed up
+    auto rollback = [&](const QString& error) {
+        removeTmpFiles();
+        QStringList errors(error);
+        if (!restoreBackups(processed, backups, errors)) {
+            errors.prepend(tr("Some files could not be restored from their backups:"));
+        }
+        throw RuntimeError(__FILE__, __LINE__, errors.join("\n"));
+    };
+    for (Entry& entry : mEntries) {
+        if (entry.remove) continue;
+        FilePath tmpFp = getTemporaryFilePath(entry.filepath);
+        if (entry.filepath.isExistingFile()) {
+            FilePath backupFp = getBackupFilePath(entry.filepath);
+            QFile::remove(backupFp.toStr()); // remove stale backup of a crashed commit
+            // Keep the old file under the backup name without copying its content. A
+            // hard link keeps the original in place until it is replaced atomically.
+            // If the file system does not support hard links, the original is moved
+            // away instead, and the temporary file takes its place right afterwards.
+            if ((!createHardLink(entry.filepath, backupFp))
+                && (!replaceFile(entry.filepath, backupFp))) {
+                rollback(QString(tr("Could not create backup of file \"%1\"."))
+                         .arg(entry.filepath.toNative()));
+            }
+            backups.insert(&entry);
+        }
+        processed.append(&entry);
+        if (!replaceFile(tmpFp, entry.filepath)) {
+            rollback(QString(tr("Could not rename file \"%1\" to \"%2\"."))
+                     .arg(tmpFp.toNative(), entry.filepath.toNative()));
+        }
+        tmpFiles.removeOne(tmpFp);
+        modifiedDirs.insert(entry.filepath.getParentDir().toStr());
+        entry.written = true;
+    }
+    for (Entry& entry : mEntries) {
+        if (!entry.remove) continue;
+        if (entry.filepath.isExistingFile() || entry.filepath.isExistingDir()) {
+            FilePath backupFp = getBackupFilePath(entry.filepath);
+            if (backupFp.isExistingDir()) {
+                QDir(backupFp.toStr()).removeRecursively(); // stale backup
+            } else {
+                QFile::remove(backupFp.toStr()); // stale backup
+            }
+            processed.append(&entry);
+            if (!QDir().rename(entry.filepath.toStr(), backupFp.toStr())) {
+                rollback(QString(tr("Could not remove \"%1\"."))
+                         .arg(entry.filepath.toNative()));
+            }
+            backups.insert(&entry);
+            modifiedDirs.insert(entry.filepath.getParentDir().toStr());
+        }
+        entry.written = true;
+    }
+
+    // step 3: the transaction succeeded, so the backups are no longer needed
+    foreach (Entry* entry, backups) {
+        FilePath backupFp = getBackupFilePath(entry->filepath);
+        bool removed = backupFp.isExistingDir() ? QDir(backupFp.toStr()).removeRecursively()
+                                                : QFile::remove(backupFp.toStr());
+        if (!removed) {
+            qWarning() << "Could not remove backup:" << backupFp.toNative();
+        }
+    }
+
+    // step 4: sync each modified directory only once
+    foreach (const QString& dir, modifiedDirs) {
+        syncDirectoryToDisk(FilePath(dir));
+    }
+}
+
+void FileWriteBatch::notifyWritten() noexcept
+{
+    foreach (const Entry& entry, mEntries) {
+        if (entry.written && entry.onWritten) {
+            entry.onWritten();
+        }
+    }
+    mEntries.clear();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+FilePath FileWriteBatch::getTemporaryFilePath(const FilePath& filepath) noexcept
+{
+    return FilePath(filepath.toStr() % ".tmp~");
+}
+
+FilePath FileWriteBatch::getBackupFilePath(const FilePath& filepath) noexcept
+{
+    return FilePath(filepath.toStr() % ".bak~");
+}
+
+bool FileWriteBatch::restoreBackups(const QList<Entry*>& entries,
+                                    const QSet<Entry*>& backups, QStringList& errors) noexcept
+{
+    bool success = true;
+    for (int i = entries.count() - 1; i >= 0; --i) {
+        Entry* entry = entries.at(i);
+        FilePath backupFp = getBackupFilePath(entry->filepath);
+        bool restored = true;
+        if (!backups.contains(entry)) {
+            // the file did not exist before (or its backup failed before replacing it)
+            if (entry->written) restored = QFile::remove(entry->filepath.toStr());
+        } else if (entry->remove) {
+            restored = QDir().rename(backupFp.toStr(), entry->filepath.toStr());
+        } else if (entry->written) {
+            restored = replaceFile(backupFp, entry->filepath);
+        } else if (entry->filepath.isExistingFile()) {
+            QFile::remove(backupFp.toStr()); // the file was not replaced yet
+        } else {
+            restored = replaceFile(backupFp, entry->filepath); // the file was moved away
+        }
+        if (restored) {
+            entry->written = false;
+        } else {
+            errors.append(QString(tr("Backup of \"%1\": \"%2\""))
+                          .arg(entry->filepath.toNative(), backupFp.toNative()));
+            success = false;
+        }
+    }
+    return success;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
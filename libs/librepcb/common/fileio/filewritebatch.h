@@ -0,0 +1,206 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_FILEWRITEBATCH_H
+#define LIBREPCB_FILEWRITEBATCH_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <functional>
+#include "filepath.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class FileWriteBatch
+ ****************************************************************************************/
+
+/**
+ * @brief The FileWriteBatch class collects file contents to write them later, possibly
+ *        in another thread
+ *
+ * While a #FileWriteBatch::Collector object exists, all #SmartFile objects append
+ * their content (or the removal of their file) to the batch instead of modifying the
+ * file system. The collected files can then be written with #writeAll() or #commit()
+ * from any thread, since the batch contains only copies of the data and no references
+ * to the model. Afterwards, #notifyWritten() must be called from the thread which
+ * filled the batch to inform the #SmartFile objects about the files which were written
+ * successfully.
+ *
+ * @note The collecting mechanism must only be used from the main thread.
+ */
+class FileWriteBatch final
+{
+        Q_DECLARE_TR_FUNCTIONS(FileWriteBatch)
+
+    public:
+
+        /**
+         * @brief Redirects all #SmartFile writes into a batch as long as it exists
+         */
+        class Collector final
+        {
+            public:
+                explicit Collector(FileWriteBatch& batch) noexcept;
+                ~Collector() noexcept;
+            private:
+                FileWriteBatch* mPreviousBatch;
+        };
+
+        // Constructors / Destructor
+        FileWriteBatch() noexcept;
+        FileWriteBatch(const FileWriteBatch& other) = delete;
+        ~FileWriteBatch() noexcept;
+
+        // Getters
+        int getCount() const noexcept {return mEntries.count();}
+        bool isEmpty() const noexcept {return mEntries.isEmpty();}
+        bool isCollectingUnmodifiedFiles() const noexcept {return mCollectUnmodifiedFiles;}
+
+        /**
+         * @brief Get all collected files which would modify the file system
+         *
+         * This compares the collected contents with the files on the disk, e.g. to find
+         * out which files were modified by another application since the last save.
+         *
+         * @return The files whose content differs (or which do not exist yet), and the
+         *         files to remove which still exist
+         */
+        QList<FilePath> getModifiedFiles() const noexcept;
+
+        // Setters
+
+        /**
+         * @brief Collect also files which are known to be up to date
+         *
+         * Normally #SmartFile objects do not append files whose content has not changed
+         * since they were loaded or written. This is not wanted if the batch is used to
+         * compare the content with the disk (see #getModifiedFiles()).
+         *
+         * @param collect   If true, all files are appended to the batch
+         */
+        void setCollectUnmodifiedFiles(bool collect) noexcept {mCollectUnmodifiedFiles = collect;}
+
+        // General Methods
+
+        /**
+         * @brief Append a file to write
+         *
+         * @param filepath      The file to write (parent directories are created)
+         * @param content       The content to write
+         * @param onWritten     Optional callback which is invoked by #notifyWritten() if
+         *                      the file was written successfully
+         */
+        void append(const FilePath& filepath, const QByteArray& content,
+                    const std::function<void()>& onWritten = nullptr) noexcept;
+
+        /**
+         * @brief Append a file or directory to remove (after all files were written)
+         *
+         * @param filepath      The file or directory (removed recursively) to remove,
+         *                      ignored if it does not exist
+         */
+        void appendRemoval(const FilePath& filepath) noexcept;
+
+        /**
+         * @brief Write all collected files one by one (may be called from any thread)
+         *
+         * Files which could not be written are skipped, the others are written anyway.
+         *
+         * @return The error messages of all files which could not be written
+         */
+        QStringList writeAll() noexcept;
+
+        /**
+         * @brief Write all collected files as a transaction (may be called from any thread)
+         *
+         * First all files are written to temporary files next to their destination and
+         * flushed to disk. Only if this succeeded for every file, the temporary files
+         * are renamed to their destination, each replacing the old file atomically. Every
+         * replaced file is kept as a backup (as a hard link, so its content is not
+         * copied; moved away if hard links are not supported), and files or directories to
+         * remove are moved to a backup location. If any of these steps fails, all
+         * already replaced or removed files are restored from their backups, so the
+         * batch is either applied completely or not at all. The backups are removed
+         * after everything succeeded.
+         *
+         * @note If the application crashes while renaming, some files may already be
+         *       replaced. Their backups (with the suffix ".bak~") are left behind then.
+         *       Modifications of the file system which were not collected by the batch
+         *       (e.g. copied directories) are not part of the transaction.
+         *
+         * @throw Exception If not all files could be written. Files which could not be
+         *                  restored are mentioned in the message. Only the files which
+         *                  remain written are reported by #notifyWritten().
+         */
+        void commit();
+
+        /**
+         * @brief Invoke the callbacks of all successfully written files and clear the batch
+         */
+        void notifyWritten() noexcept;
+
+        // Static Methods
+
+        /**
+         * @brief Get the batch of the currently active #Collector
+         *
+         * @return The active batch, or nullptr if files should be written immediately
+         */
+        static FileWriteBatch* getActive() noexcept {return sActiveBatch;}
+
+        // Operator Overloadings
+        FileWriteBatch& operator=(const FileWriteBatch& rhs) = delete;
+
+
+    private: // Types & Methods
+
+        struct Entry {
+            FilePath filepath;
+            QByteArray content;
+            std::function<void()> onWritten;
+            bool remove;
+            bool written;
+        };
+
+        static FilePath getTemporaryFilePath(const FilePath& filepath) noexcept;
+        static FilePath getBackupFilePath(const FilePath& filepath) noexcept;
+        static bool restoreBackups(const QList<Entry*>& entries,
+                                   const QSet<Entry*>& backups, QStringList& errors) noexcept;
+
+
+    private: // Data
+
+        QList<Entry> mEntries;
+        bool mCollectUnmodifiedFiles; ///< see #setCollectUnmodifiedFiles()
+        static FileWriteBatch* sActiveBatch;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_FILEWRITEBATCH_H
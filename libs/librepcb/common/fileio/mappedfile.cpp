@@ -0,0 +1,74 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <limits>
+#include "mappedfile.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+MappedFile::MappedFile(const FilePath& filepath) :
+    mFilePath(filepath), mFile(filepath.toStr()), mMappedData(nullptr), mContent()
+{
+    if (!filepath.isExistingFile()) {
+        throw LogicError(__FILE__, __LINE__,
+            QString(tr("The file \"%1\" does not exist."))
+            .arg(filepath.toNative()));
+    }
+    if (!mFile.open(QIODevice::ReadOnly)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Cannot "
+            "open file \"%1\": %2")).arg(filepath.toNative(), mFile.errorString()));
+    }
+    qint64 size = mFile.size();
+    if ((size > 0) && (size <= std::numeric_limits<int>::max())) {
+        mMappedData = mFile.map(0, size);
+    }
+    if (mMappedData) {
+        // no copy, the QByteArray just references the mapped memory
+        mContent = QByteArray::fromRawData(reinterpret_cast<const char*>(mMappedData),
+                                           static_cast<int>(size));
+    } else {
+        mContent = mFile.readAll();
+    }
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    // the content must not reference the mapped memory anymore after unmapping it
+    mContent.clear();
+    if (mMappedData) {
+        mFile.unmap(mMappedData);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,97 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_MAPPEDFILE_H
+#define LIBREPCB_MAPPEDFILE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../exceptions.h"
+#include "filepath.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class MappedFile
+ ****************************************************************************************/
+
+/**
+ * @brief The MappedFile class provides read-only access to the content of a file by
+ *        mapping it into memory
+ *
+ * In contrast to FileUtils::readFile(), the content is not copied into a new buffer.
+ * #getContent() returns a QByteArray which directly references the mapped memory, so
+ * it can be passed to parsers (e.g. DomDocument) without any copy. If the file cannot
+ * be mapped (e.g. empty files or unsupported file systems), the content is read into
+ * memory as a fallback.
+ *
+ * @warning The QByteArray returned by #getContent() is only valid as long as the
+ *          MappedFile object exists! Make a deep copy if the content must be kept
+ *          longer. Also keep the object only as long as needed since (at least on
+ *          Windows) a mapped file cannot be replaced.
+ */
+class MappedFile final
+{
+        Q_DECLARE_TR_FUNCTIONS(MappedFile)
+
+    public:
+
+        // Constructors / Destructor
+        MappedFile() = delete;
+        MappedFile(const MappedFile& other) = delete;
+
+        /**
+         * @brief Open and map a file
+         *
+         * @param filepath      The file to read
+         *
+         * @throws Exception    If the file does not exist or cannot be opened.
+         */
+        explicit MappedFile(const FilePath& filepath);
+        ~MappedFile() noexcept;
+
+        // Getters
+        const FilePath& getFilePath() const noexcept {return mFilePath;}
+        bool isMapped() const noexcept {return mMappedData != nullptr;}
+        const QByteArray& getContent() const noexcept {return mContent;}
+
+        // Operator Overloadings
+        MappedFile& operator=(const MappedFile& rhs) = delete;
+
+
+    private: // Data
+
+        FilePath mFilePath;
+        QFile mFile;
+        uchar* mMappedData; ///< nullptr if the content was read instead of mapped
+        QByteArray mContent;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_MAPPEDFILE_H
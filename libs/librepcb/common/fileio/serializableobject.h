@@ -85,6 +85,52 @@ class SerializableObject
          */
         virtual void serialize(DomElement& root) const = 0;
 
+        /**
+         * @brief Serialize the object directly into a QXmlStreamWriter
+         *
+         * The default implementation builds the DOM element of the whole object with
+         * #serializeToDomElement() and writes it into the stream. Classes with big child
+         * containers override this method to write their childs one after another, so
+         * only the DOM tree of one child exists at a time. The written XML must be
+         * identical to the serialized DOM element.
+         *
+         * @param writer        The target stream writer
+         * @param name          The name of the element to write
+         *
+         * @throw Exception     This method throws an exception if an error occurs.
+         */
+        virtual void serializeToXmlStream(QXmlStreamWriter& writer, const QString& name) const {
+            QScopedPointer<DomElement> root(serializeToDomElement(name)); // can throw
+            root->writeToQXmlStreamWriter(writer);
+        }
+
+        template <typename T>
+        static void serializeTextChild(DomElement& root, const QString& name, const T& value)
+        {
+            root.appendTextChild(name, value);
+        }
+
+        template <typename T>
+        static void serializeTextChild(QXmlStreamWriter& writer, const QString& name,
+            const T& value)
+        {
+            DomElement child(name);
+            child.setText(value);
+            child.writeToQXmlStreamWriter(writer);
+        }
+
+        static void serializeChild(DomElement& root, const SerializableObject& object,
+            const QString& name)
+        {
+            root.appendChild(object.serializeToDomElement(name)); // can throw
+        }
+
+        static void serializeChild(QXmlStreamWriter& writer, const SerializableObject& object,
+            const QString& name)
+        {
+            object.serializeToXmlStream(writer, name); // can throw
+        }
+
         template <typename T>
         static void serializeObjectContainer(DomElement& root, const T& container,
             const QString& itemName)
@@ -102,6 +148,24 @@ class SerializableObject
                 root.appendChild(pointer->serializeToDomElement(itemName)); // can throw
             }
         }
+
+        template <typename T>
+        static void serializeObjectContainer(QXmlStreamWriter& writer, const T& container,
+            const QString& itemName)
+        {
+            for (const auto& object : container) {
+                object.serializeToXmlStream(writer, itemName); // can throw
+            }
+        }
+
+        template <typename T>
+        static void serializePointerContainer(QXmlStreamWriter& writer, const T& container,
+            const QString& itemName)
+        {
+            for (const auto& pointer : container) {
+                pointer->serializeToXmlStream(writer, itemName); // can throw
+            }
+        }
 };
 
 // Make sure that the SerializableObject class does not contain any data (except the vptr).
@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <memory>
+#include <utility>
 #include <QtCore>
 #include "serializableobject.h"
 #include "../uuid.h"
@@ -33,6 +34,70 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Class SerializableObjectListIndex
+ ****************************************************************************************/
+
+/**
+ * @brief Placeholder key type for elements without UUID or name
+ */
+struct SerializableObjectListNoKey {};
+
+/**
+ * @brief The SerializableObjectListIndex class maps keys to element indices of a
+ *        librepcb::SerializableObjectList
+ *
+ * The index is updated by the list whenever an element is inserted or removed, so
+ * lookups never modify it and can be done concurrently on a const list. The key of
+ * every element is stored as it was when the element was inserted.
+ *
+ * @tparam K  The key type (librepcb::Uuid or QString)
+ */
+template <typename K>
+class SerializableObjectListIndex final
+{
+    public:
+        int find(const K& key) const noexcept {
+            int index = -1; // smallest index with this key, if there are duplicates
+            for (auto it = mHash.constFind(key); (it != mHash.constEnd()) && (it.key() == key); ++it) {
+                if ((index < 0) || (it.value() < index)) index = it.value();
+            }
+            return index;
+        }
+        void insert(int index, const K& key) noexcept {
+            if (index < mKeys.count()) {
+                for (auto it = mHash.begin(); it != mHash.end(); ++it) {
+                    if (it.value() >= index) ++it.value();
+                }
+            }
+            mKeys.insert(index, key);
+            mHash.insert(key, index);
+        }
+        void remove(int index) noexcept {
+            mHash.remove(mKeys.takeAt(index), index);
+            if (index < mKeys.count()) {
+                for (auto it = mHash.begin(); it != mHash.end(); ++it) {
+                    if (it.value() > index) --it.value();
+                }
+            }
+        }
+        void clear() noexcept {mHash.clear(); mKeys.clear();}
+
+    private:
+        QMultiHash<K, int> mHash;
+        QList<K> mKeys; ///< keys of all elements, in the order of the list
+};
+
+template <>
+class SerializableObjectListIndex<SerializableObjectListNoKey> final
+{
+    public:
+        int find(const SerializableObjectListNoKey&) const noexcept {return -1;}
+        void insert(int, const SerializableObjectListNoKey&) noexcept {}
+        void remove(int) noexcept {}
+        void clear() noexcept {}
+};
+
 /*****************************************************************************************
  *  Class SerializableObjectList
  ****************************************************************************************/
@@ -118,11 +183,13 @@ class SerializableObjectList : public SerializableObject
         }
         SerializableObjectList(SerializableObjectList<T, P>&& other, IF_Observer* observer = nullptr) noexcept {
             mObjects = other.mObjects; // copy all pointers (NOT the objects!)
+            rebuildIndices();
             other.clear(); // remove all other's elements with notifying its observers
             if (observer) registerObserver(observer);
         }
         SerializableObjectList(std::initializer_list<std::shared_ptr<T>> elements, IF_Observer* observer = nullptr) noexcept {
             mObjects = elements;
+            rebuildIndices();
             if (observer) registerObserver(observer);
         }
         SerializableObjectList(std::initializer_list<T> elements, IF_Observer* observer = nullptr) noexcept {
@@ -155,12 +222,10 @@ class SerializableObjectList : public SerializableObject
             return -1;
         }
         int indexOf(const Uuid& key) const noexcept {
-            for (int i = 0; i < count(); ++i) {if (mObjects[i]->getUuid() == key) {return i;}}
-            return -1;
+            return indexOfKey(key, mUuidIndex, [](const T& obj) {return Uuid(obj.getUuid());});
         }
         int indexOf(const QString& name) const noexcept {
-            for (int i = 0; i < count(); ++i) {if (mObjects[i]->getName() == name) {return i;}}
-            return -1;
+            return indexOfKey(name, mNameIndex, [](const T& obj) {return QString(obj.getName());});
         }
         bool contains(int index) const noexcept {
             return index >= 0 && index < mObjects.count();
@@ -243,6 +308,8 @@ class SerializableObjectList : public SerializableObject
             Q_ASSERT(obj);
             qBound(0, index, count());
             mObjects.insert(index, obj);
+            mUuidIndex.insert(index, uuidOf(*obj, 0));
+            mNameIndex.insert(index, nameOf(*obj, 0));
             notifyObjectAdded(index, obj);
             return index;
         }
@@ -252,6 +319,8 @@ class SerializableObjectList : public SerializableObject
         std::shared_ptr<T> take(int index) noexcept {
             Q_ASSERT(contains(index));
             std::shared_ptr<T> obj = mObjects.takeAt(index);
+            mUuidIndex.remove(index);
+            mNameIndex.remove(index);
             notifyObjectRemoved(index, obj);
             return std::move(obj);
         }
@@ -292,6 +361,7 @@ class SerializableObjectList : public SerializableObject
             qSort(copiedList.mObjects.begin(), copiedList.mObjects.end(),
                   [](const std::shared_ptr<T>& ptr1, const std::shared_ptr<T>& ptr2)
                     {return ptr1->getUuid() < ptr2->getUuid();});
+            copiedList.rebuildIndices();
             return copiedList;
         }
         SerializableObjectList<T, P> sortedByName() const noexcept {
@@ -300,6 +370,7 @@ class SerializableObjectList : public SerializableObject
             qSort(copiedList.mObjects.begin(), copiedList.mObjects.end(),
                   [](const std::shared_ptr<T>& ptr1, const std::shared_ptr<T>& ptr2)
                     {return ptr1->getName() < ptr2->getName();});
+            copiedList.rebuildIndices();
             return copiedList;
         }
 
@@ -346,6 +417,57 @@ class SerializableObjectList : public SerializableObject
 
 
     protected: // Methods
+
+        /**
+         * @brief Lookup the index of an element by its UUID or name
+         *
+         * The indices are kept in #mUuidIndex and #mNameIndex, which are updated on
+         * every insertion and removal. Lookups only read them, so a const list can be
+         * shared between threads.
+         *
+         * The UUID or name of an element may be reassigned without notifying the list
+         * (e.g. by the assignment operator of the element), so the index is only used
+         * as a hint: A hit is verified, and if the key is not found or the element has
+         * another key by now, the list is searched linearly. So lookups of existing
+         * elements are O(1), but lookups of non-existent elements are still O(n).
+         */
+        template <typename K, typename I, typename F>
+        int indexOfKey(const K& key, const I& index, F getKey) const noexcept {
+            int hit = index.find(key);
+            if ((hit >= 0) && (hit < mObjects.count()) && (getKey(*mObjects[hit]) == key)) {
+                return hit;
+            }
+            for (int i = 0; i < mObjects.count(); ++i) {
+                if (getKey(*mObjects[i]) == key) return i;
+            }
+            return -1;
+        }
+        void rebuildIndices() noexcept {
+            mUuidIndex.clear();
+            mNameIndex.clear();
+            for (int i = 0; i < mObjects.count(); ++i) {
+                mUuidIndex.insert(i, uuidOf(*mObjects[i], 0));
+                mNameIndex.insert(i, nameOf(*mObjects[i], 0));
+            }
+        }
+
+        // Key Getters (the second overload is used if `T` has no UUID or name)
+        template <typename U>
+        static auto uuidOf(const U& obj, int) noexcept -> decltype(Uuid(obj.getUuid())) {
+            return Uuid(obj.getUuid());
+        }
+        template <typename U>
+        static SerializableObjectListNoKey uuidOf(const U&, long) noexcept {
+            return SerializableObjectListNoKey();
+        }
+        template <typename U>
+        static auto nameOf(const U& obj, int) noexcept -> decltype(QString(obj.getName())) {
+            return QString(obj.getName());
+        }
+        template <typename U>
+        static SerializableObjectListNoKey nameOf(const U&, long) noexcept {
+            return SerializableObjectListNoKey();
+        }
         void notifyObjectAdded(int index, const std::shared_ptr<T>& obj) noexcept {
             foreach (IF_Observer* observer, mObservers) {
                 observer->listObjectAdded(*this, index, obj);
@@ -371,6 +493,10 @@ class SerializableObjectList : public SerializableObject
     protected: // Data
         QVector<std::shared_ptr<T>> mObjects;
         QList<IF_Observer*> mObservers;
+
+        // Lookup Indices (see #indexOfKey())
+        SerializableObjectListIndex<decltype(uuidOf(std::declval<const T&>(), 0))> mUuidIndex;
+        SerializableObjectListIndex<decltype(nameOf(std::declval<const T&>(), 0))> mNameIndex;
 };
 
 } // namespace librepcb
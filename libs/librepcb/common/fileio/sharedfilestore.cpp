@@ -0,0 +1,155 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "sharedfilestore.h"
+
+#if defined(Q_OS_UNIX) // Mac OS X / Linux / UNIX
+#include <cstdio>
+#include <unistd.h>
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64) // Windows
+#include <Windows.h>
+#else
+#error "Unknown operating system!"
+#endif
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Platform Specific Helpers
+ ****************************************************************************************/
+
+static bool replaceFile(const FilePath& source, const FilePath& destination) noexcept
+{
+#if defined(Q_OS_UNIX) // Mac OS X / Linux / UNIX
+    return ::rename(QFile::encodeName(source.toStr()).constData(),
+                    QFile::encodeName(destination.toStr()).constData()) == 0;
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64) // Windows
+    return ::MoveFileExW(reinterpret_cast<const wchar_t*>(source.toNative().utf16()),
+                         reinterpret_cast<const wchar_t*>(destination.toNative().utf16()),
+                         MOVEFILE_REPLACE_EXISTING) != 0;
+#endif
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+SharedFileStore::SharedFileStore(const FilePath& directory) noexcept :
+    mDirectory(directory)
+{
+}
+
+SharedFileStore::~SharedFileStore() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+qint64 SharedFileStore::shareDirectory(const FilePath& dir) noexcept
+{
+    qint64 sharedBytes = 0;
+    QDirIterator it(dir.toStr(), QDir::Files | QDir::Hidden | QDir::NoSymLinks,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        sharedBytes += shareFile(FilePath(it.next()));
+    }
+    return sharedBytes;
+}
+
+bool SharedFileStore::createHardLink(const FilePath& target, const FilePath& link) noexcept
+{
+#if defined(Q_OS_UNIX) // Mac OS X / Linux / UNIX
+    return ::link(QFile::encodeName(target.toStr()).constData(),
+                  QFile::encodeName(link.toStr()).constData()) == 0;
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64) // Windows
+    return ::CreateHardLinkW(reinterpret_cast<const wchar_t*>(link.toNative().utf16()),
+                             reinterpret_cast<const wchar_t*>(target.toNative().utf16()),
+                             nullptr) != 0;
+#endif
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+qint64 SharedFileStore::shareFile(const FilePath& file) noexcept
+{
+    qint64 size = 0;
+    QByteArray hash = calcFileHash(file, size);
+    if (hash.isEmpty()) {
+        return 0; // file not readable, just keep it
+    }
+
+    QMutexLocker locker(&mMutex);
+    QString hashStr = QString::fromLatin1(hash.toHex());
+    FilePath storedFile = mDirectory.getPathTo(hashStr.left(2)).getPathTo(hashStr);
+    if (!storedFile.isExistingFile()) {
+        // new content: the file itself becomes the stored copy
+        if (QDir().mkpath(storedFile.getParentDir().toStr())) {
+            createHardLink(file, storedFile);
+        }
+        return 0;
+    }
+    if (QFileInfo(storedFile.toStr()).size() != size) {
+        qWarning() << "Corrupt file in shared file store:" << storedFile.toNative();
+        return 0;
+    }
+
+    // replace the file atomically by a link to the stored copy
+    FilePath tmpFile(file.toStr() % ".~shared");
+    QFile::remove(tmpFile.toStr());
+    if (!createHardLink(storedFile, tmpFile)) {
+        return 0; // e.g. not on the same file system
+    }
+    if (!replaceFile(tmpFile, file)) {
+        QFile::remove(tmpFile.toStr());
+        return 0;
+    }
+    return size;
+}
+
+QByteArray SharedFileStore::calcFileHash(const FilePath& file, qint64& size) noexcept
+{
+    QFile f(file.toStr());
+    if (!f.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&f)) {
+        return QByteArray();
+    }
+    size = f.size();
+    return hash.result();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
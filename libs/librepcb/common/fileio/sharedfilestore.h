@@ -0,0 +1,114 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_SHAREDFILESTORE_H
+#define LIBREPCB_SHAREDFILESTORE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "filepath.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class SharedFileStore
+ ****************************************************************************************/
+
+/**
+ * @brief The SharedFileStore class stores identical files only once on the disk
+ *
+ * The store is a directory which contains one hard link for every distinct file
+ * content, named by the SHA-256 hash of the content. Files added with
+ * #shareDirectory() are replaced by hard links to the file in the store, so e.g. the
+ * same library element copied into hundreds of projects occupies the disk space only
+ * once.
+ *
+ * This is safe as long as files are never modified in place: LibrePCB always writes
+ * files to a temporary file which then replaces the original file (see
+ * librepcb::FileUtils::writeFile()), which breaks the hard link of the written file
+ * and leaves all other links untouched.
+ *
+ * If hard links are not supported (e.g. the shared files are on another file system
+ * than the store), the files are simply kept as they are.
+ *
+ * @note Files in the store are never removed, even if no other link to them exists
+ *       anymore. Deleting the whole store directory is always safe though.
+ */
+class SharedFileStore final
+{
+    public:
+
+        // Constructors / Destructor
+        SharedFileStore() = delete;
+        SharedFileStore(const SharedFileStore& other) = delete;
+        explicit SharedFileStore(const FilePath& directory) noexcept;
+        ~SharedFileStore() noexcept;
+
+        // Getters
+        const FilePath& getDirectory() const noexcept {return mDirectory;}
+
+        // General Methods
+
+        /**
+         * @brief Replace all files of a directory (recursively) by links into the store
+         *
+         * @param dir   The directory to share (e.g. a library element)
+         *
+         * @return The count of bytes which are not stored on the disk twice anymore
+         *         (zero if the files were not yet contained in the store)
+         */
+        qint64 shareDirectory(const FilePath& dir) noexcept;
+
+        /**
+         * @brief Create a hard link to an existing file
+         *
+         * @param target    The existing file
+         * @param link      The link to create (must not exist)
+         *
+         * @return true on success, false if the link could not be created
+         */
+        static bool createHardLink(const FilePath& target, const FilePath& link) noexcept;
+
+        // Operator Overloadings
+        SharedFileStore& operator=(const SharedFileStore& rhs) = delete;
+
+
+    private: // Methods
+        qint64 shareFile(const FilePath& file) noexcept;
+        static QByteArray calcFileHash(const FilePath& file, qint64& size) noexcept;
+
+
+    private: // Data
+        FilePath mDirectory;
+        QMutex mMutex; ///< files can be shared from multiple threads
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_SHAREDFILESTORE_H
@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "smartfile.h"
 #include "fileutils.h"
+#include "filewritebatch.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -89,7 +90,9 @@ void SmartFile::removeFile(bool original)
     }
 
     FilePath filepath(original ? mFilePath : mTmpFilePath);
-    if (filepath.isExistingFile()) {
+    if (FileWriteBatch* batch = FileWriteBatch::getActive()) {
+        batch->appendRemoval(filepath);
+    } else if (filepath.isExistingFile()) {
         FileUtils::removeFile(filepath);
     }
 }
@@ -116,6 +119,17 @@ void SmartFile::updateMembersAfterSaving(bool toOriginal) noexcept
         mIsCreated = false;
 }
 
+void SmartFile::writeFile(const FilePath& filepath, const QByteArray& content,
+                          const std::function<void()>& onWritten)
+{
+    if (FileWriteBatch* batch = FileWriteBatch::getActive()) {
+        batch->append(filepath, content, onWritten);
+    } else {
+        FileUtils::writeFile(filepath, content); // can throw
+        if (onWritten) onWritten();
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
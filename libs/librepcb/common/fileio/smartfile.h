@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include "../exceptions.h"
 #include "filepath.h"
 
@@ -131,6 +132,8 @@ class SmartFile
         /**
          * @brief Remove the file from the file system
          *
+         * If a #FileWriteBatch is active, the file is removed when the batch is written.
+         *
          * @param original  Specifies whether the original or the backup file should be removed.
          *
          * @throw Exception If an error occurs, an exception will be thrown
@@ -176,6 +179,22 @@ class SmartFile
          */
         void updateMembersAfterSaving(bool toOriginal) noexcept;
 
+        /**
+         * @brief Write the content of the file
+         *
+         * The file is written immediately, except if a #FileWriteBatch is active. In that
+         * case the content is appended to the batch and written later.
+         *
+         * @param filepath      The filepath returned by #prepareSaveAndReturnFilePath()
+         * @param content       The content to write
+         * @param onWritten     Optional callback which is invoked after the file was
+         *                      written successfully
+         *
+         * @throw Exception If an error occurs
+         */
+        void writeFile(const FilePath& filepath, const QByteArray& content,
+                       const std::function<void()>& onWritten = nullptr);
+
 
         // General Attributes
 
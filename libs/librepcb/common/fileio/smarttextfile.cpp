@@ -55,7 +55,7 @@ SmartTextFile::~SmartTextFile() noexcept
 void SmartTextFile::save(bool toOriginal)
 {
     const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal);
-    FileUtils::writeFile(filepath, mContent);
+    writeFile(filepath, mContent); // can throw
     updateMembersAfterSaving(toOriginal);
 }
 
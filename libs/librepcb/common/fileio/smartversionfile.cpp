@@ -65,7 +65,7 @@ void SmartVersionFile::save(bool toOriginal)
 {
     if (mVersion.isValid()) {
         const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal);
-        FileUtils::writeFile(filepath, QString("%1\n").arg(mVersion.toStr()).toUtf8());
+        writeFile(filepath, QString("%1\n").arg(mVersion.toStr()).toUtf8()); // can throw
         updateMembersAfterSaving(toOriginal);
     } else {
         qDebug() << mVersion.toStr();
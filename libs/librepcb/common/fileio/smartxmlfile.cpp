@@ -21,22 +21,56 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <quazip/quaziodevice.h>
 #include "smartxmlfile.h"
 #include "fileutils.h"
+#include "mappedfile.h"
 #include "domdocument.h"
+#include "domdocumentcache.h"
 #include "domelement.h"
+#include "serializableobject.h"
+#include "filewritebatch.h"
 
 /*****************************************************************************************
  *  Namespace
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Class HashingDevice
+ ****************************************************************************************/
+
+/**
+ * @brief Write-only device which forwards all data to another device while hashing it
+ */
+class HashingDevice final : public QIODevice
+{
+    public:
+        HashingDevice(QIODevice& target, QCryptographicHash& hash) noexcept :
+            QIODevice(), mTarget(target), mHash(hash) {open(QIODevice::WriteOnly);}
+
+    protected:
+        qint64 readData(char* data, qint64 maxSize) override {
+            Q_UNUSED(data); Q_UNUSED(maxSize); return -1;
+        }
+        qint64 writeData(const char* data, qint64 maxSize) override {
+            mHash.addData(data, maxSize);
+            return mTarget.write(data, maxSize);
+        }
+
+    private:
+        QIODevice& mTarget;
+        QCryptographicHash& mHash;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 SmartXmlFile::SmartXmlFile(const FilePath& filepath, bool restore, bool readOnly, bool create) :
-    SmartFile(filepath, restore, readOnly, create)
+    SmartFile(filepath, restore, readOnly, create),
+    mOriginalFileState{QByteArray(), 0, QDateTime()},
+    mBackupFileState{QByteArray(), 0, QDateTime()}, mCompressed(false)
 {
 }
 
@@ -48,19 +82,162 @@ SmartXmlFile::~SmartXmlFile() noexcept
  *  General Methods
  ****************************************************************************************/
 
-std::unique_ptr<DomDocument> SmartXmlFile::parseFileAndBuildDomTree() const
+std::unique_ptr<DomDocument> SmartXmlFile::parseFileAndBuildDomTree(
+        DomDocumentCache* cache) const
 {
-    return std::unique_ptr<DomDocument>(
-        new DomDocument(FileUtils::readFile(mOpenedFilePath), mOpenedFilePath));
+    MappedFile file(mOpenedFilePath); // can throw
+    QByteArray hash = QCryptographicHash::hash(file.getContent(), QCryptographicHash::Md5);
+    rememberFileState(mOpenedFilePath == mFilePath, hash);
+    if (cache) {
+        std::unique_ptr<DomDocument> doc = cache->load(mOpenedFilePath, hash);
+        if (doc) {
+            return doc;
+        }
+    }
+    std::unique_ptr<DomDocument> doc;
+    mCompressed = isCompressedContent(file.getContent());
+    if (mCompressed) {
+        // inflate while parsing, without building the decompressed content in memory
+        QBuffer buffer;
+        buffer.setData(file.getContent());
+        buffer.open(QIODevice::ReadOnly);
+        QuaZIODevice device(&buffer);
+        device.open(QIODevice::ReadOnly);
+        doc.reset(new DomDocument(device, mOpenedFilePath)); // can throw
+    } else {
+        doc.reset(new DomDocument(file)); // can throw
+    }
+    if (cache) {
+        cache->store(hash, *doc);
+    }
+    return doc;
 }
 
 void SmartXmlFile::save(const DomDocument& domDocument, bool toOriginal)
 {
+    if (mCompressed) {
+        QByteArray content;
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::WriteOnly);
+        QuaZIODevice device(&buffer);
+        device.open(QIODevice::WriteOnly);
+        device.write(domDocument.toByteArray()); // can throw (serializing)
+        device.close(); // flush the compressed data
+        saveContent(content, toOriginal); // can throw
+    } else {
+        saveContent(domDocument.toByteArray(), toOriginal); // can throw
+    }
+}
+
+void SmartXmlFile::save(const SerializableObject& object, const QString& rootName,
+                        bool toOriginal)
+{
+    if (FileWriteBatch::getActive()) {
+        // the file will be written later, so the content needs to be kept in memory
+        QByteArray content;
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::WriteOnly);
+        QuaZIODevice compressor(&buffer);
+        QIODevice* device = &buffer;
+        if (mCompressed) {
+            compressor.open(QIODevice::WriteOnly);
+            device = &compressor;
+        }
+        QXmlStreamWriter writer(device);
+        DomDocument::setupXmlStreamWriter(writer);
+        writer.writeStartDocument("1.0", true);
+        object.serializeToXmlStream(writer, rootName); // can throw
+        writer.writeEndDocument();
+        if (writer.hasError()) throw LogicError(__FILE__, __LINE__);
+        compressor.close(); // flush the compressed data (does nothing if not opened)
+        saveContent(content, toOriginal); // can throw
+        return;
+    }
+
     const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal);
-    FileUtils::writeFile(filepath, domDocument.toByteArray());
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    HashingDevice hashingDevice(file, hash); // hashes the content written to the file
+    QuaZIODevice compressor(&hashingDevice);
+    QIODevice* device = &hashingDevice;
+    if (mCompressed) {
+        compressor.open(QIODevice::WriteOnly);
+        device = &compressor;
+    }
+    QXmlStreamWriter writer(device);
+    DomDocument::setupXmlStreamWriter(writer);
+    writer.writeStartDocument("1.0", true);
+    object.serializeToXmlStream(writer, rootName); // can throw
+    writer.writeEndDocument();
+    compressor.close(); // flush the compressed data (does nothing if not opened)
+    if (writer.hasError()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
+    if (isFileUpToDate(toOriginal, hash.result())) {
+        file.cancelWriting(); // keep the existing file untouched
+    } else if (file.commit()) {
+        rememberFileState(toOriginal, hash.result());
+    } else {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
     updateMembersAfterSaving(toOriginal);
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void SmartXmlFile::saveContent(const QByteArray& content, bool toOriginal)
+{
+    const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal);
+    QByteArray hash = QCryptographicHash::hash(content, QCryptographicHash::Md5);
+    FileWriteBatch* batch = FileWriteBatch::getActive();
+    if ((batch && batch->isCollectingUnmodifiedFiles()) ||
+        (!isFileUpToDate(toOriginal, hash))) {
+        // the hash is only updated once the file is really written
+        writeFile(filepath, content, [this, toOriginal, hash]() {
+            rememberFileState(toOriginal, hash);
+        }); // can throw
+    }
+    updateMembersAfterSaving(toOriginal);
+}
+
+bool SmartXmlFile::isFileUpToDate(bool toOriginal, const QByteArray& hash) const noexcept
+{
+    const FileState& state = toOriginal ? mOriginalFileState : mBackupFileState;
+    if (state.hash.isEmpty() || (state.hash != hash)) {
+        return false;
+    }
+    // the file may have been modified on disk in the meantime (e.g. by git)
+    QFileInfo info((toOriginal ? mFilePath : mTmpFilePath).toStr());
+    return info.isFile() && (info.size() == state.size) &&
+           (info.lastModified() == state.modified);
+}
+
+void SmartXmlFile::rememberFileState(bool toOriginal, const QByteArray& hash) const noexcept
+{
+    FileState& state = toOriginal ? mOriginalFileState : mBackupFileState;
+    QFileInfo info((toOriginal ? mFilePath : mTmpFilePath).toStr());
+    state.hash = info.isFile() ? hash : QByteArray();
+    state.size = info.size();
+    state.modified = info.lastModified();
+}
+
+bool SmartXmlFile::isCompressedContent(const QByteArray& content) noexcept
+{
+    // zlib header: compression method "deflate" with a checksum over the first two bytes
+    return (content.size() >= 2) && ((content.at(0) & 0x0F) == 8)
+        && ((((quint8)content.at(0) << 8) | (quint8)content.at(1)) % 31 == 0);
+}
+
 /*****************************************************************************************
  *  Static Methods
  ****************************************************************************************/
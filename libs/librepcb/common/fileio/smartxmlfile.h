@@ -33,6 +33,8 @@
 namespace librepcb {
 
 class DomDocument;
+class DomDocumentCache;
+class SerializableObject;
 
 /*****************************************************************************************
  *  Class SmartXmlFile
@@ -45,6 +47,16 @@ class DomDocument;
  * With #parseFileAndBuildDomTree() the XML file can be parsed and a DOM tree is created.
  * With #save() the DOM tree can be saved back to the XML file.
  *
+ * The class remembers a hash of the content of the original and of the backup file
+ * (loaded or last written), together with the size and modification time of the file.
+ * If #save() generates exactly the same content again and the file was not modified on
+ * disk in the meantime (e.g. by git), the existing file is left untouched, so only
+ * really modified files are rewritten.
+ *
+ * Optionally the files are written zlib-compressed (see #setCompressed()). Compressed
+ * files are detected automatically when parsing and are decompressed on the fly while
+ * parsing, i.e. neither a decompressed copy on disk nor in memory is needed.
+ *
  * @note See class #SmartFile for more information.
  *
  * @author ubruhin
@@ -82,15 +94,42 @@ class SmartXmlFile final : public SmartFile
         ~SmartXmlFile() noexcept;
 
 
+        // Getters
+
+        /**
+         * @brief Check whether the file is written compressed
+         *
+         * @return true if the file was compressed when it was parsed, or if compression
+         *         was enabled with #setCompressed()
+         */
+        bool isCompressed() const noexcept {return mCompressed;}
+
+
+        // Setters
+
+        /**
+         * @brief Set whether the file shall be written compressed by #save()
+         *
+         * @param compressed    If true, the content is written zlib-compressed.
+         *                      Otherwise it is written as plain XML.
+         */
+        void setCompressed(bool compressed) noexcept {mCompressed = compressed;}
+
+
         // General Methods
 
         /**
          * @brief Open and parse the XML file and build the whole DOM tree
          *
+         * @param cache     If not nullptr, the DOM tree is loaded from this cache if the
+         *                  file content has not changed since it was stored. Otherwise
+         *                  the file is parsed and the DOM tree is stored in the cache.
+         *
          * @return  A pointer to the created DOM tree. The caller takes the ownership of
          *          the DOM document.
          */
-        std::unique_ptr<DomDocument> parseFileAndBuildDomTree() const;
+        std::unique_ptr<DomDocument> parseFileAndBuildDomTree(
+                DomDocumentCache* cache = nullptr) const;
 
         /**
          * @brief Write the XML DOM tree to the file system
@@ -103,6 +142,23 @@ class SmartXmlFile final : public SmartFile
          */
         void save(const DomDocument& domDocument, bool toOriginal);
 
+        /**
+         * @brief Serialize an object and stream it directly into the file
+         *
+         * In contrast to #save(const DomDocument&, bool), neither the whole DOM tree
+         * nor the whole file content needs to be built in memory. The written file is
+         * identical to the one written by saving the object's DOM document.
+         *
+         * @param object        The object to serialize (see
+         *                      librepcb::SerializableObject::serializeToXmlStream())
+         * @param rootName      The name of the root element
+         * @param toOriginal    Specifies whether the original or the backup file should
+         *                      be overwritten/created.
+         *
+         * @throw Exception If an error occurs
+         */
+        void save(const SerializableObject& object, const QString& rootName, bool toOriginal);
+
 
         // Operator Overloadings
         SmartXmlFile& operator=(const SmartXmlFile& rhs) = delete;
@@ -140,6 +196,62 @@ class SmartXmlFile final : public SmartFile
          */
         SmartXmlFile(const FilePath& filepath, bool restore, bool readOnly, bool create);
 
+        /**
+         * @brief Write already serialized content to the original or backup file
+         *
+         * @param content       The file content
+         * @param toOriginal    Whether the original or the backup file should be written
+         *
+         * @throw Exception If an error occurs
+         */
+        void saveContent(const QByteArray& content, bool toOriginal);
+
+        /**
+         * @brief Check whether a file already contains the content with the given hash
+         *
+         * @param toOriginal    Whether the original or the backup file is meant
+         * @param hash          The hash of the content to be saved
+         *
+         * @retval true     If the file exists, has the same content and was not modified
+         *                  on disk since its hash was remembered
+         * @retval false    If the file needs to be written
+         */
+        bool isFileUpToDate(bool toOriginal, const QByteArray& hash) const noexcept;
+
+        /**
+         * @brief Remember the hash, size and modification time of a loaded/written file
+         *
+         * @param toOriginal    Whether the original or the backup file is meant
+         * @param hash          The hash of the content of the file
+         */
+        void rememberFileState(bool toOriginal, const QByteArray& hash) const noexcept;
+
+        /**
+         * @brief Check whether some file content is zlib-compressed
+         *
+         * @param content   The file content (plain XML always starts with '<' or a BOM)
+         *
+         * @return true if the content starts with a valid zlib header
+         */
+        static bool isCompressedContent(const QByteArray& content) noexcept;
+
+
+    private: // Types
+
+        /// The known state of a file on disk (used to detect external modifications)
+        struct FileState {
+            QByteArray hash;    ///< MD5 of the content, empty if unknown
+            qint64 size;        ///< file size when the hash was remembered
+            QDateTime modified; ///< modification time when the hash was remembered
+        };
+
+
+    private: // Data
+
+        mutable FileState mOriginalFileState; ///< state of the original file, if known
+        mutable FileState mBackupFileState;   ///< state of the backup file, if known
+        mutable bool mCompressed;             ///< see #isCompressed()
+
 };
 
 /*****************************************************************************************
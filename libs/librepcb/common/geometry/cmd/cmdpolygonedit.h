@@ -51,6 +51,9 @@ class CmdPolygonEdit final : public UndoCommand
         explicit CmdPolygonEdit(Polygon& polygon) noexcept;
         ~CmdPolygonEdit() noexcept;
 
+        // Getters
+        const Point& getNewStartPos() const noexcept {return mNewStartPos;}
+
         // Setters
         void setLayerName(const QString& name, bool immediate) noexcept;
         void setLineWidth(const Length& width, bool immediate) noexcept;
@@ -68,9 +68,18 @@ void CmdPolygonMove::setDeltaToStartPos(const Point& deltaPos, bool immediate) n
 void CmdPolygonMove::rotate(const Angle& angle, const Point& center, bool immediate) noexcept
 {
     Q_ASSERT(!wasEverExecuted());
-    mPolygonEditCmd->rotate(angle, center, immediate);
-    foreach (CmdPolygonSegmentEdit* cmd, mSegmentEditCmds) { Q_ASSERT(cmd);
-        cmd->rotate(angle, center, immediate);
+
+    // rotate all vertices in one batch (calculates the sine and cosine only once)
+    QVector<Point> vertices;
+    vertices.reserve(mSegmentEditCmds.count() + 1);
+    vertices.append(mPolygonEditCmd->getNewStartPos());
+    foreach (const CmdPolygonSegmentEdit* cmd, mSegmentEditCmds) { Q_ASSERT(cmd);
+        vertices.append(cmd->getNewEndPos());
+    }
+    Point::rotateAll(vertices, angle, center);
+    mPolygonEditCmd->setStartPos(vertices.first(), immediate);
+    for (int i = 0; i < mSegmentEditCmds.count(); ++i) {
+        mSegmentEditCmds.at(i)->setEndPos(vertices.at(i + 1), immediate);
     }
 }
 
@@ -51,6 +51,9 @@ class CmdPolygonSegmentEdit final : public UndoCommand
         explicit CmdPolygonSegmentEdit(PolygonSegment& segment) noexcept;
         ~CmdPolygonSegmentEdit() noexcept;
 
+        // Getters
+        const Point& getNewEndPos() const noexcept {return mNewEndPos;}
+
         // Setters
         void setEndPos(const Point& pos, bool immediate) noexcept;
         void setDeltaToStartPos(const Point& deltaPos, bool immediate) noexcept;
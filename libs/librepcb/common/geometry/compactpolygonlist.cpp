@@ -0,0 +1,215 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "compactpolygonlist.h"
+#include <limits>
+#include "../exceptions.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CompactPolygonList::CompactPolygonList() noexcept
+{
+}
+
+CompactPolygonList::CompactPolygonList(const PolygonList& polygons)
+{
+    int vertexCount = 0;
+    for (const Polygon& polygon : polygons) {
+        vertexCount += polygon.getSegments().count() + 1;
+    }
+    mPolygons.reserve(polygons.count());
+    mVertices.reserve(vertexCount);
+    for (const Polygon& polygon : polygons) {
+        int layerIndex = mLayerNames.indexOf(polygon.getLayerName());
+        if (layerIndex < 0) {
+            layerIndex = mLayerNames.count();
+            mLayerNames.append(polygon.getLayerName());
+        }
+        Item item;
+        item.firstVertex = mVertices.count();
+        item.vertexCount = polygon.getSegments().count() + 1;
+        item.lineWidth = toInt32(polygon.getLineWidth()); // can throw
+        item.layerIndex = layerIndex;
+        item.filled = polygon.isFilled();
+        item.grabArea = polygon.isGrabArea();
+        mPolygons.append(item);
+        mVertices.append(Vertex{toInt32(polygon.getStartPos().getX()),
+                                toInt32(polygon.getStartPos().getY()), 0}); // can throw
+        for (const PolygonSegment& segment : polygon.getSegments()) {
+            mVertices.append(Vertex{toInt32(segment.getEndPos().getX()),
+                                    toInt32(segment.getEndPos().getY()),
+                                    segment.getAngle().toMicroDeg()}); // can throw
+        }
+    }
+}
+
+CompactPolygonList::~CompactPolygonList() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+const QString& CompactPolygonList::getLayerName(int index) const noexcept
+{
+    return mLayerNames.at(mPolygons.at(index).layerIndex);
+}
+
+Length CompactPolygonList::getLineWidth(int index) const noexcept
+{
+    return Length(mPolygons.at(index).lineWidth);
+}
+
+bool CompactPolygonList::isFilled(int index) const noexcept
+{
+    return mPolygons.at(index).filled;
+}
+
+bool CompactPolygonList::isGrabArea(int index) const noexcept
+{
+    return mPolygons.at(index).grabArea;
+}
+
+int CompactPolygonList::getVertexCount(int index) const noexcept
+{
+    return mPolygons.at(index).vertexCount;
+}
+
+Point CompactPolygonList::getVertex(int index, int vertex) const noexcept
+{
+    Q_ASSERT((vertex >= 0) && (vertex < mPolygons.at(index).vertexCount));
+    const Vertex& v = mVertices.at(mPolygons.at(index).firstVertex + vertex);
+    return Point(Length(v.x), Length(v.y));
+}
+
+Angle CompactPolygonList::getAngle(int index, int vertex) const noexcept
+{
+    Q_ASSERT((vertex >= 0) && (vertex < mPolygons.at(index).vertexCount));
+    return Angle(mVertices.at(mPolygons.at(index).firstVertex + vertex).angle);
+}
+
+qint64 CompactPolygonList::getMemoryUsage() const noexcept
+{
+    qint64 size = sizeof(CompactPolygonList);
+    size += mPolygons.capacity() * sizeof(Item);
+    size += mVertices.capacity() * sizeof(Vertex);
+    foreach (const QString& name, mLayerNames) {
+        size += sizeof(QString) + name.size() * sizeof(QChar);
+    }
+    return size;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QPainterPath CompactPolygonList::toQPainterPathPx(int index) const noexcept
+{
+    // same algorithm as Polygon::toQPainterPathPx()
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+    Point lastPos = getVertex(index, 0);
+    path.moveTo(lastPos.toPxQPointF());
+    for (int i = 1; i < getVertexCount(index); ++i) {
+        Point endPos = getVertex(index, i);
+        Angle angle = getAngle(index, i);
+        if (angle == 0) {
+            path.lineTo(endPos.toPxQPointF());
+        } else {
+            // all lengths in pixels
+            QPointF start = lastPos.toPxQPointF();
+            QPointF center = PolygonSegment(endPos, angle).calcArcCenter(lastPos).toPxQPointF();
+            qreal r = qSqrt((start.x()-center.x())*(start.x()-center.x()) +
+                            (start.y()-center.y())*(start.y()-center.y()));
+            QRectF rect(center.x()-r, center.y()-r, 2*r, 2*r);
+            qreal startAngleDeg = -qRadiansToDegrees(qAtan2(start.y()-center.y(),
+                                                            start.x()-center.x()));
+            path.arcTo(rect, startAngleDeg, angle.toDeg());
+        }
+        lastPos = endPos;
+    }
+    return path;
+}
+
+PolygonList CompactPolygonList::toPolygonList() const noexcept
+{
+    PolygonList list;
+    for (int i = 0; i < mPolygons.count(); ++i) {
+        std::shared_ptr<Polygon> polygon = std::make_shared<Polygon>(getLayerName(i),
+            getLineWidth(i), isFilled(i), isGrabArea(i), getVertex(i, 0));
+        for (int k = 1; k < getVertexCount(i); ++k) {
+            polygon->getSegments().append(std::make_shared<PolygonSegment>(
+                getVertex(i, k), getAngle(i, k)));
+        }
+        list.append(polygon);
+    }
+    return list;
+}
+
+/*****************************************************************************************
+ *  Operator Overloadings
+ ****************************************************************************************/
+
+bool CompactPolygonList::operator==(const CompactPolygonList& rhs) const noexcept
+{
+    if (mPolygons.count() != rhs.mPolygons.count()) return false;
+    if (mVertices != rhs.mVertices) return false;
+    for (int i = 0; i < mPolygons.count(); ++i) {
+        // the layer indices may differ, but the layer names must be equal
+        const Item& a = mPolygons.at(i);
+        const Item& b = rhs.mPolygons.at(i);
+        if ((a.firstVertex != b.firstVertex) || (a.vertexCount != b.vertexCount)) return false;
+        if ((a.lineWidth != b.lineWidth) || (a.filled != b.filled)) return false;
+        if (a.grabArea != b.grabArea) return false;
+        if (getLayerName(i) != rhs.getLayerName(i)) return false;
+    }
+    return true;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+qint32 CompactPolygonList::toInt32(const Length& length)
+{
+    LengthBase_t nm = length.toNm();
+    if ((nm < std::numeric_limits<qint32>::min()) || (nm > std::numeric_limits<qint32>::max())) {
+        throw RangeError(__FILE__, __LINE__, QString(tr("The coordinate %1mm is too large "
+            "for the compact polygon representation.")).arg(length.toMmString()));
+    }
+    return static_cast<qint32>(nm);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,161 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_COMPACTPOLYGONLIST_H
+#define LIBREPCB_COMPACTPOLYGONLIST_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "polygon.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class CompactPolygonList
+ ****************************************************************************************/
+
+/**
+ * @brief The CompactPolygonList class is an immutable, memory efficient representation
+ *        of a librepcb::PolygonList
+ *
+ * Instead of one librepcb::Polygon object per polygon and one librepcb::PolygonSegment
+ * object per vertex (each with 64-bit coordinates and observer pointers), all vertices
+ * are stored in one contiguous array with 32-bit coordinates relative to the origin
+ * of the library element. This is enough for elements up to about two meters, but
+ * needs only 12 bytes per vertex.
+ *
+ * It is used for read-only library elements kept in memory (see
+ * librepcb::library::Footprint::compactPolygons()). Editable polygons can be created
+ * again with #toPolygonList() whenever required.
+ */
+class CompactPolygonList final
+{
+        Q_DECLARE_TR_FUNCTIONS(CompactPolygonList)
+
+    public:
+
+        // Constructors / Destructor
+        CompactPolygonList() noexcept;
+        CompactPolygonList(const CompactPolygonList& other) = default;
+
+        /**
+         * @brief Create the compact representation of a polygon list
+         *
+         * @param polygons  The polygons to copy
+         *
+         * @throw RangeError If a coordinate or line width does not fit into 32 bits
+         */
+        explicit CompactPolygonList(const PolygonList& polygons);
+        ~CompactPolygonList() noexcept;
+
+        // Getters
+        int count() const noexcept {return mPolygons.count();}
+        bool isEmpty() const noexcept {return mPolygons.isEmpty();}
+        const QString& getLayerName(int index) const noexcept;
+        Length getLineWidth(int index) const noexcept;
+        bool isFilled(int index) const noexcept;
+        bool isGrabArea(int index) const noexcept;
+
+        /**
+         * @brief Get the count of vertices of a polygon (the start point included)
+         */
+        int getVertexCount(int index) const noexcept;
+        Point getVertex(int index, int vertex) const noexcept;
+
+        /**
+         * @brief Get the angle of the segment ending at a vertex (0 for the start point)
+         */
+        Angle getAngle(int index, int vertex) const noexcept;
+
+        /**
+         * @brief Get the approximate count of bytes used by this object
+         */
+        qint64 getMemoryUsage() const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Build the path of a polygon (like librepcb::Polygon::toQPainterPathPx())
+         *
+         * @note In contrast to librepcb::Polygon, the path is not cached.
+         */
+        QPainterPath toQPainterPathPx(int index) const noexcept;
+
+        /**
+         * @brief Create editable polygons from the compact representation
+         */
+        PolygonList toPolygonList() const noexcept;
+
+        // Operator Overloadings
+        bool operator==(const CompactPolygonList& rhs) const noexcept;
+        bool operator!=(const CompactPolygonList& rhs) const noexcept {return !(*this == rhs);}
+        CompactPolygonList& operator=(const CompactPolygonList& rhs) = default;
+
+
+    private: // Types
+
+        struct Vertex {
+            qint32 x;       ///< nanometers
+            qint32 y;       ///< nanometers
+            qint32 angle;   ///< microdegrees of the segment ending at this vertex
+
+            bool operator==(const Vertex& rhs) const noexcept {
+                return (x == rhs.x) && (y == rhs.y) && (angle == rhs.angle);
+            }
+        };
+
+        struct Item {
+            qint32 firstVertex;
+            qint32 vertexCount;
+            qint32 lineWidth;   ///< nanometers
+            quint16 layerIndex; ///< index in #mLayerNames
+            bool filled;
+            bool grabArea;
+
+            bool operator==(const Item& rhs) const noexcept {
+                return (firstVertex == rhs.firstVertex) && (vertexCount == rhs.vertexCount)
+                    && (lineWidth == rhs.lineWidth) && (layerIndex == rhs.layerIndex)
+                    && (filled == rhs.filled) && (grabArea == rhs.grabArea);
+            }
+        };
+
+
+    private: // Methods
+        static qint32 toInt32(const Length& length);
+
+
+    private: // Data
+        QVector<Item> mPolygons;
+        QVector<Vertex> mVertices;
+        QStringList mLayerNames;    ///< only a few distinct layers per element
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_COMPACTPOLYGONLIST_H
@@ -33,11 +33,12 @@ namespace librepcb {
  ****************************************************************************************/
 
 PolygonSegment::PolygonSegment(const PolygonSegment& other) noexcept :
-    mEndPos(other.mEndPos), mAngle(other.mAngle)
+    mEndPos(other.mEndPos), mAngle(other.mAngle), mObserver(nullptr)
 {
 }
 
-PolygonSegment::PolygonSegment(const DomElement& domElement)
+PolygonSegment::PolygonSegment(const DomElement& domElement) :
+    mObserver(nullptr)
 {
     mEndPos.setX(domElement.getAttribute<Length>("end_x", true));
     mEndPos.setY(domElement.getAttribute<Length>("end_y", true));
@@ -51,19 +52,19 @@ Point PolygonSegment::calcArcCenter(const Point& startPos) const noexcept
         return (startPos + mEndPos) / 2;
     } else {
         // http://math.stackexchange.com/questions/27535/how-to-find-center-of-an-arc-given-start-point-end-point-radius-and-arc-direc
+        // The signed distance of the center from the chord's midpoint is d/2*cot(angle/2),
+        // which is calculated from the (tabulated) full angle to avoid qSin()/qSqrt().
         qreal x0 = startPos.getX().toMm();
         qreal y0 = startPos.getY().toMm();
         qreal x1 = mEndPos.getX().toMm();
         qreal y1 = mEndPos.getY().toMm();
-        qreal angle = mAngle.mappedTo180deg().toRad();
-        qreal angleSgn = (angle >= 0) ? 1 : -1;
-        qreal d = qSqrt((x1 - x0)*(x1 - x0) + (y1 - y0)*(y1 - y0));
-        qreal r = d / (2 * qSin(angle / 2));
-        qreal h = qSqrt(r*r - d*d/4);
-        qreal u = (x1 - x0) / d;
-        qreal v = (y1 - y0) / d;
-        qreal a = ((x0 + x1) / 2) - h * v * angleSgn;
-        qreal b = ((y0 + y1) / 2) + h * u * angleSgn;
+        Angle angle = mAngle.mappedTo180deg();
+        qreal sin, cos;
+        angle.sinCos(sin, cos);
+        // cot(a/2) = (1+cos(a))/sin(a) = sin(a)/(1-cos(a)), use the numerically stable one
+        qreal cotHalf = (cos >= 0) ? ((1 + cos) / sin) : (sin / (1 - cos));
+        qreal a = ((x0 + x1) / 2) - cotHalf * (y1 - y0) / 2;
+        qreal b = ((y0 + y1) / 2) + cotHalf * (x1 - x0) / 2;
         return Point::fromMm(a, b);
     }
 }
@@ -72,8 +73,8 @@ void PolygonSegment::setEndPos(const Point& pos) noexcept
 {
     if (pos == mEndPos) return;
     mEndPos = pos;
-    foreach (IF_PolygonSegmentObserver* object, mObservers) {
-        object->polygonSegmentEndPosChanged(*this, mEndPos);
+    if (mObserver) {
+        mObserver->polygonSegmentEndPosChanged(*this, mEndPos);
     }
 }
 
@@ -81,19 +82,21 @@ void PolygonSegment::setAngle(const Angle& angle) noexcept
 {
     if (angle == mAngle) return;
     mAngle = angle;
-    foreach (IF_PolygonSegmentObserver* object, mObservers) {
-        object->polygonSegmentAngleChanged(*this, mAngle);
+    if (mObserver) {
+        mObserver->polygonSegmentAngleChanged(*this, mAngle);
     }
 }
 
 void PolygonSegment::registerObserver(IF_PolygonSegmentObserver& object) const noexcept
 {
-    mObservers.insert(&object);
+    mObserver = &object;
 }
 
 void PolygonSegment::unregisterObserver(IF_PolygonSegmentObserver& object) const noexcept
 {
-    mObservers.remove(&object);
+    if (mObserver == &object) {
+        mObserver = nullptr;
+    }
 }
 
 void PolygonSegment::serialize(DomElement& root) const
@@ -207,23 +210,14 @@ const QPainterPath& Polygon::toQPainterPathPx() const noexcept
             if (segment.getAngle() == 0) {
                 mPainterPathPx.lineTo(segment.getEndPos().toPxQPointF());
             } else {
-                // TODO: this is very provisional and may contain bugs...
                 // all lengths in pixels
-                qreal x1 = lastPos.toPxQPointF().x();
-                qreal y1 = lastPos.toPxQPointF().y();
-                qreal x2 = segment.getEndPos().toPxQPointF().x();
-                qreal y2 = segment.getEndPos().toPxQPointF().y();
-                qreal x3 = (x1+x2)/qreal(2);
-                qreal y3 = (y1+y2)/qreal(2);
-                qreal dx = x2-x1;
-                qreal dy = y2-y1;
-                qreal q = qSqrt(dx*dx + dy*dy);
-                qreal r = qAbs(q / (qreal(2) * qSin(segment.getAngle().toRad()/qreal(2))));
-                qreal rh = r * qCos(segment.getAngle().mappedTo180deg().toRad()/qreal(2));
-                qreal hx = -dy * rh / q;
-                qreal hy = dx * rh / q;
-                qreal cx = x3 + hx * (segment.getAngle().mappedTo180deg() > 0 ? -1 : 1);
-                qreal cy = y3 + hy * (segment.getAngle().mappedTo180deg() > 0 ? -1 : 1);
+                QPointF start = lastPos.toPxQPointF();
+                QPointF center = segment.calcArcCenter(lastPos).toPxQPointF();
+                qreal x1 = start.x();
+                qreal y1 = start.y();
+                qreal cx = center.x();
+                qreal cy = center.y();
+                qreal r = qSqrt((x1-cx)*(x1-cx) + (y1-cy)*(y1-cy));
                 QRectF rect(cx-r, cy-r, 2*r, 2*r);
                 qreal startAngleDeg = -qRadiansToDegrees(qAtan2(y1-cy, x1-cx));
                 mPainterPathPx.arcTo(rect, startAngleDeg, segment.getAngle().toDeg());
@@ -234,6 +228,34 @@ const QPainterPath& Polygon::toQPainterPathPx() const noexcept
     return mPainterPathPx;
 }
 
+const QVector<Point>& Polygon::toFlattenedPoints(const Length& tolerance) const noexcept
+{
+    if (mFlattenedPoints.isEmpty() || (tolerance != mFlattenedTolerance)) {
+        mFlattenedPoints.clear();
+        mFlattenedTolerance = tolerance;
+        Point last = mStartPos;
+        mFlattenedPoints.append(last);
+        for (const PolygonSegment& segment : mSegments) {
+            const Angle& angle = segment.getAngle();
+            if (angle != 0) {
+                // the deviation of a chord over the angle phi is r * (1 - cos(phi / 2))
+                Point center = segment.calcArcCenter(last);
+                qreal radius = (last - center).getLength().toNm();
+                qreal tol = qMax(tolerance.toNm(), LengthBase_t(1));
+                qreal maxStep = (tol < radius) ? 2 * qAcos(1 - tol / radius) : M_PI / 2;
+                int count = qBound(1, qCeil(qAbs(angle.toRad()) / maxStep), 3600);
+                for (int k = 1; k < count; ++k) {
+                    Angle step(qint32(qint64(angle.toMicroDeg()) * k / count));
+                    mFlattenedPoints.append(last.rotated(step, center));
+                }
+            }
+            mFlattenedPoints.append(segment.getEndPos());
+            last = segment.getEndPos();
+        }
+    }
+    return mFlattenedPoints;
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -278,7 +300,7 @@ void Polygon::setStartPos(const Point& pos) noexcept
 {
     if (pos == mStartPos) return;
     mStartPos = pos;
-    mPainterPathPx = QPainterPath(); // invalidate painter path
+    invalidateCachedPaths();
     foreach (IF_PolygonObserver* object, mObservers) {
         object->polygonStartPosChanged(mStartPos);
     }
@@ -304,9 +326,18 @@ Polygon Polygon::translated(const Point& offset) const noexcept
 
 Polygon& Polygon::rotate(const Angle& angle, const Point& center) noexcept
 {
-    setStartPos(mStartPos.rotated(angle, center));
+    // rotate all vertices in one batch (calculates the sine and cosine only once)
+    QVector<Point> vertices;
+    vertices.reserve(mSegments.count() + 1);
+    vertices.append(mStartPos);
+    for (const PolygonSegment& segment : mSegments) {
+        vertices.append(segment.getEndPos());
+    }
+    Point::rotateAll(vertices, angle, center);
+    setStartPos(vertices.first());
+    int i = 1;
     for (PolygonSegment& segment : mSegments) {
-        segment.setEndPos(segment.getEndPos().rotated(angle, center));
+        segment.setEndPos(vertices.at(i++));
     }
     return *this;
 }
@@ -378,6 +409,8 @@ Polygon& Polygon::operator=(const Polygon& rhs) noexcept
     mStartPos = rhs.mStartPos;
     mSegments = rhs.mSegments;
     mPainterPathPx = rhs.mPainterPathPx;
+    mFlattenedPoints = rhs.mFlattenedPoints;
+    mFlattenedTolerance = rhs.mFlattenedTolerance;
     return *this;
 }
 
@@ -442,7 +475,7 @@ void Polygon::listObjectAdded(const PolygonSegmentList& list, int newIndex,
 {
     Q_ASSERT(&list == &mSegments);
     ptr->registerObserver(*this);
-    mPainterPathPx = QPainterPath(); // invalidate painter path
+    invalidateCachedPaths();
     foreach (IF_PolygonObserver* object, mObservers) {
         object->polygonSegmentAdded(newIndex);
     }
@@ -453,7 +486,7 @@ void Polygon::listObjectRemoved(const PolygonSegmentList& list, int oldIndex,
 {
     Q_ASSERT(&list == &mSegments);
     ptr->unregisterObserver(*this);
-    mPainterPathPx = QPainterPath(); // invalidate painter path
+    invalidateCachedPaths();
     foreach (IF_PolygonObserver* object, mObservers) {
         object->polygonSegmentRemoved(oldIndex);
     }
@@ -461,7 +494,7 @@ void Polygon::listObjectRemoved(const PolygonSegmentList& list, int oldIndex,
 
 void Polygon::polygonSegmentEndPosChanged(const PolygonSegment& segment, const Point& newEndPos) noexcept
 {
-    mPainterPathPx = QPainterPath(); // invalidate painter path
+    invalidateCachedPaths();
     int index = mSegments.indexOf(&segment); Q_ASSERT(index >= 0);
     foreach (IF_PolygonObserver* object, mObservers) {
         object->polygonSegmentEndPosChanged(index, newEndPos);
@@ -470,7 +503,7 @@ void Polygon::polygonSegmentEndPosChanged(const PolygonSegment& segment, const P
 
 void Polygon::polygonSegmentAngleChanged(const PolygonSegment& segment, const Angle& newAngle) noexcept
 {
-    mPainterPathPx = QPainterPath(); // invalidate painter path
+    invalidateCachedPaths();
     int index = mSegments.indexOf(&segment); Q_ASSERT(index >= 0);
     foreach (IF_PolygonObserver* object, mObservers) {
         object->polygonSegmentAngleChanged(index, newAngle);
@@ -484,6 +517,12 @@ bool Polygon::checkAttributesValidity() const noexcept
     return true;
 }
 
+void Polygon::invalidateCachedPaths() const noexcept
+{
+    mPainterPathPx = QPainterPath();
+    mFlattenedPoints.clear();
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
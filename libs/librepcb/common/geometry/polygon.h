@@ -77,7 +77,7 @@ class PolygonSegment final : public SerializableObject
         PolygonSegment() = delete;
         PolygonSegment(const PolygonSegment& other) noexcept;
         PolygonSegment(const Point& endPos, const Angle& angle) noexcept :
-            mEndPos(endPos), mAngle(angle) {}
+            mEndPos(endPos), mAngle(angle), mObserver(nullptr) {}
         explicit PolygonSegment(const DomElement& domElement);
         ~PolygonSegment() noexcept {}
 
@@ -91,6 +91,14 @@ class PolygonSegment final : public SerializableObject
         void setAngle(const Angle& angle) noexcept;
 
         // General Methods
+
+        /**
+         * @brief Register the observer of this segment
+         *
+         * A segment can only have one observer at a time (the librepcb::Polygon which
+         * contains it), so registering an observer replaces the previous one. This
+         * avoids allocating an observer container for every single segment.
+         */
         void registerObserver(IF_PolygonSegmentObserver& object) const noexcept;
         void unregisterObserver(IF_PolygonSegmentObserver& object) const noexcept;
 
@@ -108,7 +116,7 @@ class PolygonSegment final : public SerializableObject
         Angle mAngle;
 
         // Misc
-        mutable QSet<IF_PolygonSegmentObserver*> mObservers; ///< A list of all observer objects
+        mutable IF_PolygonSegmentObserver* mObserver; ///< The observer object (may be nullptr)
 };
 
 /*****************************************************************************************
@@ -187,6 +195,20 @@ class Polygon final : public SerializableObject, private PolygonSegmentList::IF_
         Point calcCenter() const noexcept;
         const QPainterPath& toQPainterPathPx() const noexcept;
 
+        /**
+         * @brief Get the vertices of the polygon with all arcs approximated by lines
+         *
+         * The result is cached until the polygon is modified or another tolerance is
+         * requested, so all users of the same polygon (rendering, copper pours, DRC,
+         * ...) should use the same tolerance to share the cached vertices.
+         *
+         * @param tolerance     Maximum deviation of the lines from the exact arcs
+         *
+         * @return The start point, the interpolated arc points and all segment end
+         *         points (closed polygons contain the start point twice)
+         */
+        const QVector<Point>& toFlattenedPoints(const Length& tolerance) const noexcept;
+
         // Setters
         void setLayerName(const QString& name) noexcept;
         void setLineWidth(const Length& width) noexcept;
@@ -233,6 +255,7 @@ class Polygon final : public SerializableObject, private PolygonSegmentList::IF_
         void polygonSegmentEndPosChanged(const PolygonSegment& segment, const Point& newEndPos) noexcept override;
         void polygonSegmentAngleChanged(const PolygonSegment& segment, const Angle& newAngle) noexcept override;
         bool checkAttributesValidity() const noexcept;
+        void invalidateCachedPaths() const noexcept;
 
 
     private: // Data
@@ -248,6 +271,8 @@ class Polygon final : public SerializableObject, private PolygonSegmentList::IF_
 
         // Cached Attributes
         mutable QPainterPath mPainterPathPx;
+        mutable QVector<Point> mFlattenedPoints; ///< empty if not yet calculated
+        mutable Length mFlattenedTolerance;  ///< the tolerance of #mFlattenedPoints
 };
 
 /*****************************************************************************************
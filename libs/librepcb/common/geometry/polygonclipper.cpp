@@ -0,0 +1,753 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include <cmath>
+#include "polygonclipper.h"
+#include "polygon.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Internal Types and Helpers
+ ****************************************************************************************/
+namespace {
+
+struct IntPoint {
+    qint64 x;
+    qint64 y;
+};
+
+inline bool operator==(const IntPoint& a, const IntPoint& b) noexcept {
+    return (a.x == b.x) && (a.y == b.y);
+}
+
+inline bool operator!=(const IntPoint& a, const IntPoint& b) noexcept {
+    return !(a == b);
+}
+
+inline bool operator<(const IntPoint& a, const IntPoint& b) noexcept {
+    return (a.x < b.x) || ((a.x == b.x) && (a.y < b.y));
+}
+
+inline uint qHash(const IntPoint& p, uint seed = 0) noexcept {
+    return ::qHash(qMakePair(p.x, p.y), seed);
+}
+
+inline IntPoint toIntPoint(const Point& p) noexcept {
+    return IntPoint{p.getX().toNm(), p.getY().toNm()};
+}
+
+inline Point toPoint(const IntPoint& p) noexcept {
+    return Point(Length(p.x), Length(p.y));
+}
+
+/// A signed 128 bit integer (two's complement), only used to compare products exactly
+struct Int128 {
+    qint64 hi;
+    quint64 lo;
+};
+
+Int128 multiply(qint64 a, qint64 b) noexcept
+{
+    bool negative = (a < 0) != (b < 0);
+    quint64 ua = (a < 0) ? (quint64(0) - quint64(a)) : quint64(a);
+    quint64 ub = (b < 0) ? (quint64(0) - quint64(b)) : quint64(b);
+    quint64 a0 = ua & 0xFFFFFFFFu, a1 = ua >> 32;
+    quint64 b0 = ub & 0xFFFFFFFFu, b1 = ub >> 32;
+    quint64 p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    quint64 mid = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+    quint64 lo = (p00 & 0xFFFFFFFFu) | (mid << 32);
+    quint64 hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    if (negative) {
+        lo = ~lo + 1;
+        hi = ~hi + ((lo == 0) ? 1 : 0);
+    }
+    return Int128{qint64(hi), lo};
+}
+
+int compare(const Int128& a, const Int128& b) noexcept
+{
+    if (a.hi != b.hi) return (a.hi < b.hi) ? -1 : 1;
+    if (a.lo != b.lo) return (a.lo < b.lo) ? -1 : 1;
+    return 0;
+}
+
+/// Exact sign of (ax * by - ay * bx)
+int crossSign(qint64 ax, qint64 ay, qint64 bx, qint64 by) noexcept
+{
+    return compare(multiply(ax, by), multiply(ay, bx));
+}
+
+/// Exact orientation of c relative to a->b: >0 = left, <0 = right, 0 = collinear
+int orientation(const IntPoint& a, const IntPoint& b, const IntPoint& c) noexcept
+{
+    return crossSign(b.x - a.x, b.y - a.y, c.x - a.x, c.y - a.y);
+}
+
+/// Direction vector from a to b
+inline IntPoint getDirection(const IntPoint& a, const IntPoint& b) noexcept {
+    return IntPoint{b.x - a.x, b.y - a.y};
+}
+
+/// Whether direction d1 comes before d2 in counter-clockwise order, starting at +x
+bool isBefore(const IntPoint& d1, const IntPoint& d2) noexcept
+{
+    bool lower1 = (d1.y < 0) || ((d1.y == 0) && (d1.x < 0));
+    bool lower2 = (d2.y < 0) || ((d2.y == 0) && (d2.x < 0));
+    if (lower1 != lower2) return lower2;
+    return crossSign(d1.x, d1.y, d2.x, d2.y) > 0;
+}
+
+/// A straight piece of the outlines of both operands
+struct Segment {
+    IntPoint a;
+    IntPoint b;
+    int windings[2];    ///< sum of all edges of each operand on this piece (+1 = a->b)
+};
+
+/**
+ * @brief A uniform grid over the bounding rects of items with the members "a" and "b"
+ */
+template <typename T>
+class Grid final
+{
+    public:
+        explicit Grid(const QVector<T>& items) noexcept
+        {
+            qint64 left = std::numeric_limits<qint64>::max(), right = std::numeric_limits<qint64>::min();
+            qint64 bottom = left, top = right;
+            for (const T& item : items) {
+                left = qMin(left, qMin(item.a.x, item.b.x));
+                right = qMax(right, qMax(item.a.x, item.b.x));
+                bottom = qMin(bottom, qMin(item.a.y, item.b.y));
+                top = qMax(top, qMax(item.a.y, item.b.y));
+            }
+            // about two items per cell
+            mCount = qBound(1, qCeil(qSqrt(items.count() / 2.0)), 2048);
+            mLeft = left;
+            mBottom = bottom;
+            mCellWidth = qMax(qreal(right - left) / mCount, qreal(1));
+            mCellHeight = qMax(qreal(top - bottom) / mCount, qreal(1));
+            mCells.resize(mCount * mCount);
+            for (int i = 0; i < items.count(); ++i) {
+                const T& item = items.at(i);
+                int c0 = getColumn(qMin(item.a.x, item.b.x));
+                int c1 = getColumn(qMax(item.a.x, item.b.x));
+                int r0 = getRow(qMin(item.a.y, item.b.y));
+                int r1 = getRow(qMax(item.a.y, item.b.y));
+                for (int r = r0; r <= r1; ++r) {
+                    for (int c = c0; c <= c1; ++c) {
+                        mCells[r * mCount + c].append(i);
+                    }
+                }
+            }
+        }
+
+        int getCount() const noexcept {return mCount;}
+        int getColumn(qreal x) const noexcept {
+            return qBound(0, int((x - mLeft) / mCellWidth), mCount - 1);
+        }
+        int getRow(qreal y) const noexcept {
+            return qBound(0, int((y - mBottom) / mCellHeight), mCount - 1);
+        }
+        const QVector<int>& getCell(int column, int row) const noexcept {
+            return mCells.at(row * mCount + column);
+        }
+
+    private:
+        int mCount;             ///< count of columns and rows
+        qreal mLeft;
+        qreal mBottom;
+        qreal mCellWidth;
+        qreal mCellHeight;
+        QVector<QVector<int>> mCells;
+};
+
+/// The center of the pixel which contains a point, i.e. rounding half up
+inline qint64 roundToPixel(long double value) noexcept {
+    return qint64(std::floor(value + 0.5L));
+}
+
+/// Intersection point of two properly crossing segments, rounded to the nanometer grid
+IntPoint calcIntersection(const Segment& e1, const Segment& e2) noexcept
+{
+    long double d1x = e1.b.x - e1.a.x, d1y = e1.b.y - e1.a.y;
+    long double d2x = e2.b.x - e2.a.x, d2y = e2.b.y - e2.a.y;
+    long double denominator = d1x * d2y - d1y * d2x;
+    long double t = ((long double)(e2.a.x - e1.a.x) * d2y
+                   - (long double)(e2.a.y - e1.a.y) * d2x) / denominator;
+    return IntPoint{roundToPixel(e1.a.x + t * d1x), roundToPixel(e1.a.y + t * d1y)};
+}
+
+/// Whether two segments cross each other in a single point which is no end point
+bool isProperCrossing(const Segment& s1, const Segment& s2) noexcept
+{
+    return (orientation(s1.a, s1.b, s2.a) * orientation(s1.a, s1.b, s2.b) < 0)
+        && (orientation(s2.a, s2.b, s1.a) * orientation(s2.a, s2.b, s1.b) < 0);
+}
+
+/// A bound "num / den" (with den > 0) of the parameter of a point on a segment
+struct Bound {
+    qint64 num;
+    qint64 den;
+    bool open;
+};
+
+void restrictLower(Bound& lower, const Bound& bound) noexcept
+{
+    int cmp = crossSign(bound.num, lower.num, bound.den, lower.den);
+    if ((cmp > 0) || ((cmp == 0) && bound.open)) lower = bound;
+}
+
+void restrictUpper(Bound& upper, const Bound& bound) noexcept
+{
+    int cmp = crossSign(bound.num, upper.num, bound.den, upper.den);
+    if ((cmp < 0) || ((cmp == 0) && bound.open)) upper = bound;
+}
+
+/// Restrict the parameter range of "p + t * d" to the half-open interval [min, max)
+bool restrictRange(qint64 p, qint64 d, qint64 min, qint64 max, Bound& lower,
+                   Bound& upper) noexcept
+{
+    if (d > 0) {
+        restrictLower(lower, Bound{min - p, d, false});
+        restrictUpper(upper, Bound{max - p, d, true});
+    } else if (d < 0) {
+        restrictLower(lower, Bound{p - max, -d, true});
+        restrictUpper(upper, Bound{p - min, -d, false});
+    } else {
+        return (p >= min) && (p < max);
+    }
+    return true;
+}
+
+/**
+ * @brief Whether a segment passes through the "pixel" of a point
+ *
+ * The pixel is the half-open square [x-0.5, x+0.5) x [y-0.5, y+0.5), so every point of
+ * the plane belongs to exactly one pixel (see #roundToPixel()).
+ */
+bool passesThrough(const Segment& segment, const IntPoint& pixel) noexcept
+{
+    if ((qMax(segment.a.x, segment.b.x) * 2 < pixel.x * 2 - 1)
+        || (qMin(segment.a.x, segment.b.x) * 2 >= pixel.x * 2 + 1)
+        || (qMax(segment.a.y, segment.b.y) * 2 < pixel.y * 2 - 1)
+        || (qMin(segment.a.y, segment.b.y) * 2 >= pixel.y * 2 + 1)) {
+        return false; // fast path
+    }
+    // clip the segment parameter range exactly (doubled coordinates)
+    Bound lower{0, 1, false}, upper{1, 1, false};
+    if ((!restrictRange(segment.a.x * 2, (segment.b.x - segment.a.x) * 2, pixel.x * 2 - 1,
+                        pixel.x * 2 + 1, lower, upper))
+        || (!restrictRange(segment.a.y * 2, (segment.b.y - segment.a.y) * 2, pixel.y * 2 - 1,
+                           pixel.y * 2 + 1, lower, upper))) {
+        return false;
+    }
+    int cmp = crossSign(lower.num, upper.num, lower.den, upper.den);
+    return (cmp < 0) || ((cmp == 0) && (!lower.open) && (!upper.open));
+}
+
+/// Split segments at the given points and merge identical pieces (with #a < #b)
+QVector<Segment> splitAndMerge(const QVector<Segment>& segments,
+                               QVector<QVector<IntPoint>>& splits) noexcept
+{
+    QVector<Segment> result;
+    QHash<QPair<IntPoint, IntPoint>, int> indices;
+    for (int i = 0; i < segments.count(); ++i) {
+        const Segment& segment = segments.at(i);
+        QVector<IntPoint>& points = splits[i];
+        long double dx = segment.b.x - segment.a.x, dy = segment.b.y - segment.a.y;
+        std::sort(points.begin(), points.end(), [&](const IntPoint& p1, const IntPoint& p2) {
+            return (p1.x - segment.a.x) * dx + (p1.y - segment.a.y) * dy
+                 < (p2.x - segment.a.x) * dx + (p2.y - segment.a.y) * dy;
+        });
+        points.prepend(segment.a);
+        points.append(segment.b);
+        for (int k = 0; k + 1 < points.count(); ++k) {
+            IntPoint u = points.at(k), v = points.at(k + 1);
+            if (u == v) continue;
+            int direction = (u < v) ? 1 : -1;
+            if (direction < 0) std::swap(u, v);
+            QPair<IntPoint, IntPoint> key(u, v);
+            int index = indices.value(key, -1);
+            if (index < 0) {
+                index = result.count();
+                indices.insert(key, index);
+                result.append(Segment{u, v, {0, 0}});
+            }
+            result[index].windings[0] += direction * segment.windings[0];
+            result[index].windings[1] += direction * segment.windings[1];
+        }
+    }
+    // segments whose edges cancel each other out do not separate anything
+    result.erase(std::remove_if(result.begin(), result.end(), [](const Segment& s) {
+        return (s.windings[0] == 0) && (s.windings[1] == 0);
+    }), result.end());
+    return result;
+}
+
+/**
+ * @brief Snap rounding: split segments at every "hot pixel" they pass through
+ *
+ * Hot pixels are all end points and the (rounded) intersection points of crossing
+ * segments. Routing every segment through all hot pixels it touches removes all
+ * crossings, even though the intersection points had to be rounded to the nanometer
+ * grid. As the rerouted pieces may touch other hot pixels, this is repeated until
+ * nothing changes anymore (iterated snap rounding, typically one or two iterations).
+ */
+bool snapRound(QVector<Segment>& segments) noexcept
+{
+    Grid<Segment> grid(segments);
+    QVector<IntPoint> pixels;
+    pixels.reserve(segments.count() * 2);
+    for (const Segment& segment : segments) {
+        pixels << segment.a << segment.b;
+    }
+    for (int row = 0; row < grid.getCount(); ++row) {
+        for (int column = 0; column < grid.getCount(); ++column) {
+            const QVector<int>& cell = grid.getCell(column, row);
+            for (int i = 0; i < cell.count(); ++i) {
+                const Segment& s1 = segments.at(cell.at(i));
+                for (int k = i + 1; k < cell.count(); ++k) {
+                    const Segment& s2 = segments.at(cell.at(k));
+                    qint64 left = qMax(qMin(s1.a.x, s1.b.x), qMin(s2.a.x, s2.b.x));
+                    qint64 right = qMin(qMax(s1.a.x, s1.b.x), qMax(s2.a.x, s2.b.x));
+                    qint64 bottom = qMax(qMin(s1.a.y, s1.b.y), qMin(s2.a.y, s2.b.y));
+                    qint64 top = qMin(qMax(s1.a.y, s1.b.y), qMax(s2.a.y, s2.b.y));
+                    if ((left > right) || (bottom > top)) continue; // bounds disjoint
+                    if ((grid.getColumn(left) != column) || (grid.getRow(bottom) != row)) {
+                        continue; // handled by another cell
+                    }
+                    if (isProperCrossing(s1, s2)) {
+                        pixels.append(calcIntersection(s1, s2));
+                    }
+                }
+            }
+        }
+    }
+    std::sort(pixels.begin(), pixels.end());
+    pixels.erase(std::unique(pixels.begin(), pixels.end()), pixels.end());
+
+    QVector<QVector<IntPoint>> splits(segments.count());
+    QVector<int> visited(segments.count(), -1);
+    bool changed = false;
+    for (int i = 0; i < pixels.count(); ++i) {
+        const IntPoint& pixel = pixels.at(i);
+        for (int row = grid.getRow(pixel.y - 0.5); row <= grid.getRow(pixel.y + 0.5); ++row) {
+            for (int column = grid.getColumn(pixel.x - 0.5);
+                 column <= grid.getColumn(pixel.x + 0.5); ++column) {
+                for (int index : grid.getCell(column, row)) {
+                    if (visited.at(index) == i) continue;
+                    visited[index] = i;
+                    const Segment& segment = segments.at(index);
+                    if ((pixel != segment.a) && (pixel != segment.b)
+                        && passesThrough(segment, pixel)) {
+                        splits[index].append(pixel);
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+    segments = splitAndMerge(segments, splits);
+    return changed;
+}
+
+/**
+ * @brief Ray casting contribution of a segment to the winding numbers at a point
+ *
+ * The ray goes from the point in +x direction. All coordinates of the point are doubled
+ * (so midpoints of segments are integers). If "rotated" is true, all coordinates are
+ * rotated by -90° first, i.e. the ray goes in +y direction.
+ */
+void addCrossing(const Segment& segment, IntPoint m2, bool rotated, int windings[2]) noexcept
+{
+    IntPoint a = segment.a, b = segment.b;
+    if (rotated) {
+        a = IntPoint{a.y, -a.x};
+        b = IntPoint{b.y, -b.x};
+        m2 = IntPoint{m2.y, -m2.x};
+    }
+    int direction = 0;
+    if ((2 * a.y <= m2.y) && (m2.y < 2 * b.y)) {
+        // upward, counts if the point is left of the segment
+        if (crossSign(b.x - a.x, b.y - a.y, m2.x - 2 * a.x, m2.y - 2 * a.y) > 0) direction = 1;
+    } else if ((2 * b.y <= m2.y) && (m2.y < 2 * a.y)) {
+        // downward, counts if the point is right of the segment
+        if (crossSign(b.x - a.x, b.y - a.y, m2.x - 2 * a.x, m2.y - 2 * a.y) < 0) direction = -1;
+    }
+    windings[0] += direction * segment.windings[0];
+    windings[1] += direction * segment.windings[1];
+}
+
+bool isInside(PolygonClipper::Operation operation, const int windings[2]) noexcept
+{
+    bool a = (windings[0] != 0), b = (windings[1] != 0);
+    switch (operation) {
+        case PolygonClipper::Operation::Union:          return a || b;
+        case PolygonClipper::Operation::Intersection:   return a && b;
+        case PolygonClipper::Operation::Difference:     return a && (!b);
+        case PolygonClipper::Operation::Xor:            return a != b;
+        default:                                        return false;
+    }
+}
+
+/// Remove duplicate and collinear points of a closed outline
+QVector<IntPoint> cleanUp(QVector<IntPoint> ring) noexcept
+{
+    bool changed = true;
+    while (changed && (ring.count() >= 3)) {
+        changed = false;
+        QVector<IntPoint> result;
+        result.reserve(ring.count());
+        for (int i = 0; i < ring.count(); ++i) {
+            const IntPoint& prev = result.isEmpty() ? ring.last() : result.last();
+            const IntPoint& next = ring.at((i + 1) % ring.count());
+            if ((ring.at(i) == prev) || (orientation(prev, ring.at(i), next) == 0)) {
+                changed = true; // skip this point
+            } else {
+                result.append(ring.at(i));
+            }
+        }
+        ring = result;
+    }
+    return (ring.count() >= 3) ? ring : QVector<IntPoint>();
+}
+
+/**
+ * @brief Create a counter-clockwise circular sector which contains the exact sector
+ *
+ * The arc is approximated by straight lines between vertices on a slightly larger
+ * radius, with a maximum angle of "maxStep" between two vertices.
+ */
+QVector<Point> createWedge(const Point& center, qreal radius, qreal startAngle,
+                           qreal sweepAngle, qreal maxStep) noexcept
+{
+    int count = qMax(1, qCeil(sweepAngle / maxStep));
+    qreal step = sweepAngle / count;
+    qreal outerRadius = radius / qCos(step / 2) + 1; // +1nm for the rounding
+    QVector<Point> wedge;
+    wedge.reserve(count + 2);
+    wedge.append(center);
+    for (int i = 0; i <= count; ++i) {
+        qreal angle = startAngle + step * i;
+        wedge.append(center + Point(Length(qRound64(outerRadius * qCos(angle))),
+                                    Length(qRound64(outerRadius * qSin(angle)))));
+    }
+    return wedge;
+}
+
+} // namespace
+
+/*****************************************************************************************
+ *  Boolean Operations
+ ****************************************************************************************/
+
+PolygonClipper::Paths PolygonClipper::execute(Operation operation, const Paths& subject,
+                                              const Paths& clip) noexcept
+{
+    // collect all edges of both operands
+    QVector<Segment> segments;
+    for (int operand = 0; operand < 2; ++operand) {
+        for (const Path& path : (operand == 0) ? subject : clip) {
+            for (int i = 0; i < path.count(); ++i) {
+                IntPoint a = toIntPoint(path.at(i));
+                IntPoint b = toIntPoint(path.at((i + 1) % path.count()));
+                if (a != b) segments.append(Segment{a, b, {1 - operand, operand}});
+            }
+        }
+    }
+
+    // split all edges at their intersections with other edges
+    QVector<QVector<IntPoint>> splits(segments.count());
+    segments = splitAndMerge(segments, splits);
+    for (int i = 0; i < 16; ++i) {
+        if (!snapRound(segments)) break;
+    }
+    if (segments.isEmpty()) {
+        return Paths();
+    }
+
+    // build the arrangement of all segments: half-edge 2*i is segment i from a to b, and
+    // half-edge 2*i+1 from b to a; the outgoing half-edges of every vertex are sorted
+    // counter-clockwise
+    auto getStart = [&](int he) {return (he % 2 == 0) ? segments.at(he / 2).a : segments.at(he / 2).b;};
+    auto getEnd = [&](int he) {return (he % 2 == 0) ? segments.at(he / 2).b : segments.at(he / 2).a;};
+    QVector<int> origins(2 * segments.count());
+    QVector<int> positions(2 * segments.count());
+    QVector<QVector<int>> outgoing;
+    {
+        QHash<IntPoint, int> vertices;
+        for (int he = 0; he < origins.count(); ++he) {
+            int vertex = vertices.value(getStart(he), -1);
+            if (vertex < 0) {
+                vertex = outgoing.count();
+                vertices.insert(getStart(he), vertex);
+                outgoing.append(QVector<int>());
+            }
+            origins[he] = vertex;
+            outgoing[vertex].append(he);
+        }
+        for (QVector<int>& list : outgoing) {
+            std::sort(list.begin(), list.end(), [&](int he1, int he2) {
+                return isBefore(getDirection(getStart(he1), getEnd(he1)),
+                                getDirection(getStart(he2), getEnd(he2)));
+            });
+            for (int i = 0; i < list.count(); ++i) {
+                positions[list.at(i)] = i;
+            }
+        }
+    }
+    // the next half-edge of the same face (i.e. the face on the left side of "he")
+    auto getNext = [&](int he) {
+        const QVector<int>& list = outgoing.at(origins.at(he ^ 1));
+        return list.at((positions.at(he ^ 1) + list.count() - 1) % list.count());
+    };
+
+    // determine the winding numbers on the left side of every half-edge: by ray casting
+    // for one segment of every connected component, and by propagation along the faces
+    // and across the segments for all other half-edges
+    QVector<int> windings(2 * origins.count(), 0);
+    QVector<bool> known(origins.count(), false);
+    {
+        Grid<Segment> grid(segments);
+        QVector<int> visited(segments.count(), -1);
+        QVector<int> stack;
+        for (int i = 0; i < segments.count(); ++i) {
+            if (known.at(2 * i)) continue;
+            const Segment& segment = segments.at(i);
+            IntPoint m2{segment.a.x + segment.b.x, segment.a.y + segment.b.y};
+            bool rotated = (segment.a.y == segment.b.y); // horizontal -> ray in +y direction
+            int ray[2] = {0, 0};
+            int column = grid.getColumn(m2.x / 2.0), row = grid.getRow(m2.y / 2.0);
+            while ((column < grid.getCount()) && (row < grid.getCount())) {
+                for (int index : grid.getCell(column, row)) {
+                    if ((index == i) || (visited.at(index) == i)) continue;
+                    visited[index] = i;
+                    addCrossing(segments.at(index), m2, rotated, ray);
+                }
+                if (rotated) ++row; else ++column;
+            }
+            // the ray casting resulted in the winding numbers on the +x (resp. +y) side
+            bool upward = (!rotated) && (segment.b.y > segment.a.y);
+            for (int k = 0; k < 2; ++k) {
+                int left = upward ? (ray[k] + segment.windings[k]) : ray[k];
+                windings[4 * i + k] = left;
+                windings[4 * i + 2 + k] = left - segment.windings[k];
+            }
+            known[2 * i] = known[2 * i + 1] = true;
+            stack << (2 * i) << (2 * i + 1);
+            while (!stack.isEmpty()) {
+                int he = stack.takeLast();
+                int next = getNext(he);
+                if (!known.at(next)) {
+                    windings[2 * next] = windings.at(2 * he);
+                    windings[2 * next + 1] = windings.at(2 * he + 1);
+                    known[next] = true;
+                    stack.append(next);
+                }
+                int twin = he ^ 1;
+                if (!known.at(twin)) {
+                    int sign = (he % 2 == 0) ? 1 : -1;
+                    windings[2 * twin] = windings.at(2 * he) - sign * segments.at(he / 2).windings[0];
+                    windings[2 * twin + 1] = windings.at(2 * he + 1) - sign * segments.at(he / 2).windings[1];
+                    known[twin] = true;
+                    stack.append(twin);
+                }
+            }
+        }
+    }
+
+    // keep only the half-edges which have the result on the left but not on the right
+    QVector<bool> isBorder(origins.count(), false);
+    for (int he = 0; he < origins.count(); ++he) {
+        isBorder[he] = isInside(operation, &windings.at(2 * he))
+                   && (!isInside(operation, &windings.at(2 * (he ^ 1))));
+    }
+
+    // link the border half-edges to closed outlines: at every vertex, continue with the
+    // first border half-edge clockwise from the reverse of the current one, which keeps
+    // touching outlines separated
+    Paths result;
+    QVector<bool> used(origins.count(), false);
+    for (int first = 0; first < origins.count(); ++first) {
+        if ((!isBorder.at(first)) || used.at(first)) continue;
+        QVector<IntPoint> ring;
+        int current = first;
+        while ((current >= 0) && (!used.at(current))) {
+            used[current] = true;
+            ring.append(getStart(current));
+            const QVector<int>& list = outgoing.at(origins.at(current ^ 1));
+            int position = positions.at(current ^ 1);
+            current = -1;
+            for (int i = 1; i < list.count(); ++i) {
+                int candidate = list.at((position + list.count() - i) % list.count());
+                if (isBorder.at(candidate)) {
+                    current = candidate;
+                    break;
+                }
+            }
+        }
+        ring = cleanUp(ring);
+        if (!ring.isEmpty()) {
+            Path path;
+            path.reserve(ring.count());
+            for (const IntPoint& p : ring) path.append(toPoint(p));
+            result.append(path);
+        }
+    }
+    return result;
+}
+
+PolygonClipper::Paths PolygonClipper::offset(const Paths& paths, const Length& delta,
+                                             const Length& tolerance) noexcept
+{
+    // normalize the outlines first (interior on the left side, no collinear points)
+    Paths normalized = unite(paths);
+    if (delta == 0) {
+        return normalized;
+    }
+
+    // the band around all edges: a rectangle along every edge and a circular wedge at
+    // every vertex where the band of the two adjacent edges leaves a gap on the relevant
+    // side (all counter-clockwise, so they are united by the non-zero winding rule)
+    const bool grow = (delta > 0);
+    const qreal r = qAbs(delta.toNm());
+    const qreal tol = qMax(tolerance.toNm(), LengthBase_t(1));
+    const qreal maxStep = qMin(2 * qAcos(r / (r + tol)), M_PI / 2);
+    Paths band;
+    for (const Path& path : normalized) {
+        for (int i = 0; i < path.count(); ++i) {
+            const Point& prev = path.at((i + path.count() - 1) % path.count());
+            const Point& a = path.at(i);
+            const Point& b = path.at((i + 1) % path.count());
+            qreal dx = (b - a).getX().toNm(), dy = (b - a).getY().toNm();
+            qreal length = qSqrt(dx * dx + dy * dy);
+            Point normal(Length(qRound64(-dy * r / length)), Length(qRound64(dx * r / length)));
+            band.append(Path{a + normal, a - normal, b - normal, b + normal});
+
+            qreal angleIn = qAtan2((a - prev).getY().toNm(), (a - prev).getX().toNm());
+            qreal angleOut = qAtan2(dy, dx);
+            qreal turn = angleOut - angleIn;
+            if (turn > M_PI) turn -= 2 * M_PI;
+            if (turn <= -M_PI) turn += 2 * M_PI;
+            if (grow && (turn > 0)) {
+                // convex vertex: gap between the right normals
+                band.append(createWedge(a, r, angleIn - M_PI / 2, turn, maxStep));
+            } else if ((!grow) && (turn < 0)) {
+                // concave vertex: gap between the left normals
+                band.append(createWedge(a, r, angleOut + M_PI / 2, -turn, maxStep));
+            }
+        }
+    }
+    return grow ? unite(normalized, band) : subtract(normalized, band);
+}
+
+/*****************************************************************************************
+ *  Conversions
+ ****************************************************************************************/
+
+PolygonClipper::Path PolygonClipper::fromPolygon(const Polygon& polygon,
+                                                 const Length& tolerance) noexcept
+{
+    Path path = polygon.toFlattenedPoints(tolerance); // cached by the polygon
+    if ((path.count() > 1) && (path.first() == path.last())) {
+        path.removeLast();
+    }
+    return path;
+}
+
+PolygonClipper::Path PolygonClipper::createCircle(const Point& center, const Length& radius,
+                                                  const Length& tolerance) noexcept
+{
+    if (radius <= 0) {
+        return Path();
+    }
+    // the vertices are on a slightly larger circle so that the edges do not cut the
+    // circle, with a maximum deviation of the tolerance
+    qreal r = radius.toNm();
+    qreal tol = qMax(tolerance.toNm(), LengthBase_t(1));
+    int count = qBound(8, qCeil(M_PI / qAcos(r / (r + tol))), 4096);
+    qreal outerRadius = r / qCos(M_PI / count) + 1; // +1nm for the rounding
+    Path path;
+    path.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        qreal angle = 2 * M_PI * i / count;
+        path.append(center + Point(Length(qRound64(outerRadius * qCos(angle))),
+                                   Length(qRound64(outerRadius * qSin(angle)))));
+    }
+    return path;
+}
+
+QList<Polygon> PolygonClipper::toPolygons(const Paths& paths, const QString& layerName,
+                                          const Length& lineWidth, bool fill,
+                                          bool isGrabArea) noexcept
+{
+    QList<Polygon> polygons;
+    for (const Path& path : paths) {
+        if (path.count() < 3) continue;
+        Polygon polygon(layerName, lineWidth, fill, isGrabArea, path.first());
+        for (int i = 1; i <= path.count(); ++i) {
+            polygon.getSegments().append(std::make_shared<PolygonSegment>(
+                path.at(i % path.count()), Angle::deg0()));
+        }
+        polygons.append(polygon);
+    }
+    return polygons;
+}
+
+/*****************************************************************************************
+ *  Helpers
+ ****************************************************************************************/
+
+qreal PolygonClipper::calcArea(const Path& path) noexcept
+{
+    long double area = 0;
+    for (int i = 0; i < path.count(); ++i) {
+        const Point& a = path.at(i);
+        const Point& b = path.at((i + 1) % path.count());
+        area += (long double)a.getX().toNm() * b.getY().toNm()
+              - (long double)b.getX().toNm() * a.getY().toNm();
+    }
+    return qreal(area / 2);
+}
+
+qreal PolygonClipper::calcArea(const Paths& paths) noexcept
+{
+    qreal area = 0;
+    for (const Path& path : paths) {
+        area += calcArea(path);
+    }
+    return area;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_POLYGONCLIPPER_H
+#define LIBREPCB_POLYGONCLIPPER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class Polygon;
+
+/*****************************************************************************************
+ *  Class PolygonClipper
+ ****************************************************************************************/
+
+/**
+ * @brief The PolygonClipper class provides boolean operations and offsetting of polygons
+ *
+ * All calculations are done on integer nanometer coordinates (librepcb::Point), so the
+ * results do not depend on floating point rounding:
+ *  - All orientation tests are exact (128 bit intermediate results).
+ *  - Only the intersection points of crossing edges are rounded to the nearest
+ *    nanometer, so results may deviate from the exact solution by about 1nm.
+ *
+ * Areas are represented as #Paths, i.e. a list of closed outlines which are filled with
+ * the non-zero winding rule. Outlines returned by this class are counter-clockwise for
+ * filled areas and clockwise for holes, so they can be passed to further operations.
+ * Arcs of librepcb::Polygon are approximated by straight lines with a maximum deviation
+ * of a given tolerance (see #fromPolygon()).
+ *
+ * Algorithm: All edges of both operands are split at their intersections with snap
+ * rounding, so the split edges do not cross each other even though the intersection
+ * points are rounded (a uniform grid limits the intersection tests to nearby edges).
+ * Then the winding numbers of both operands on both sides of every split edge are
+ * determined by one ray casting per connected component and propagation along the
+ * faces, and only the edges which separate the inside from the outside of the result
+ * are linked to the resulting outlines. The runtime is about O(n * sqrt(n)) for n edges
+ * in typical PCB geometry.
+ *
+ * @note Coordinates must be within +/-2^60 nanometers (far more than any board needs).
+ */
+class PolygonClipper final
+{
+        Q_DECLARE_TR_FUNCTIONS(PolygonClipper)
+
+    public:
+
+        // Types
+        typedef QVector<Point> Path;    ///< a closed outline (the last point is connected to the first)
+        typedef QVector<Path> Paths;    ///< outlines filled with the non-zero winding rule
+        enum class Operation {Union, Intersection, Difference, Xor};
+
+        // Constructors / Destructor
+        PolygonClipper() = delete;
+        PolygonClipper(const PolygonClipper& other) = delete;
+
+
+        // Boolean Operations
+
+        /**
+         * @brief Execute a boolean operation on two areas
+         *
+         * @param operation     The operation to execute
+         * @param subject       The first operand
+         * @param clip          The second operand
+         *
+         * @return The resulting area (outlines counter-clockwise, holes clockwise)
+         */
+        static Paths execute(Operation operation, const Paths& subject,
+                             const Paths& clip) noexcept;
+        static Paths unite(const Paths& subject, const Paths& clip = Paths()) noexcept {
+            return execute(Operation::Union, subject, clip);
+        }
+        static Paths intersect(const Paths& subject, const Paths& clip) noexcept {
+            return execute(Operation::Intersection, subject, clip);
+        }
+        static Paths subtract(const Paths& subject, const Paths& clip) noexcept {
+            return execute(Operation::Difference, subject, clip);
+        }
+
+        /**
+         * @brief Grow or shrink an area by a specific distance
+         *
+         * Convex corners get rounded when growing (and concave corners when shrinking).
+         * The rounded corners are approximated so that the result always contains the
+         * exact result (when growing) resp. is contained in it (when shrinking), which
+         * is the conservative choice for clearances.
+         *
+         * @param paths         The area to grow or shrink
+         * @param delta         Positive values grow, negative values shrink the area
+         * @param tolerance     Maximum deviation of the approximated arcs
+         *
+         * @return The resulting area (outlines counter-clockwise, holes clockwise)
+         */
+        static Paths offset(const Paths& paths, const Length& delta,
+                            const Length& tolerance) noexcept;
+
+
+        // Conversions
+
+        /**
+         * @brief Convert a librepcb::Polygon to an outline
+         *
+         * @param polygon       The polygon to convert (open polygons get closed)
+         * @param tolerance     Maximum deviation of the approximated arc segments
+         *
+         * @return The outline without the duplicate closing point
+         */
+        static Path fromPolygon(const Polygon& polygon, const Length& tolerance) noexcept;
+
+        /**
+         * @brief Create a polygonal approximation of a circle which contains the circle
+         */
+        static Path createCircle(const Point& center, const Length& radius,
+                                 const Length& tolerance) noexcept;
+
+        /**
+         * @brief Convert outlines to closed librepcb::Polygon objects
+         */
+        static QList<Polygon> toPolygons(const Paths& paths, const QString& layerName,
+                                         const Length& lineWidth, bool fill,
+                                         bool isGrabArea) noexcept;
+
+
+        // Helpers
+
+        /**
+         * @brief Calculate the signed area of an outline in square nanometers
+         *
+         * @return Positive value for counter-clockwise, negative for clockwise outlines
+         */
+        static qreal calcArea(const Path& path) noexcept;
+        static qreal calcArea(const Paths& paths) noexcept;
+
+
+        // Operator Overloadings
+        PolygonClipper& operator=(const PolygonClipper& rhs) = delete;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_POLYGONCLIPPER_H
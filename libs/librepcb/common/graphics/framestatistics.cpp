@@ -0,0 +1,163 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "framestatistics.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class EventHandlerTimer
+ ****************************************************************************************/
+
+FrameStatistics::EventHandlerTimer::EventHandlerTimer(const char* name) noexcept :
+    mName(name)
+{
+    if (FrameStatistics::instance().isEnabled()) {
+        mTimer.start();
+    }
+}
+
+FrameStatistics::EventHandlerTimer::~EventHandlerTimer() noexcept
+{
+    if (mTimer.isValid()) {
+        FrameStatistics::instance().addEventHandlerTime(QString(mName),
+                                                        mTimer.nsecsElapsed() / 1000000.0);
+    }
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+FrameStatistics::FrameStatistics() noexcept :
+    mOverlayEnabled(false), mPendingFrame{QDateTime(), 0, 0, 0, 0, {}},
+    mLastFrame{QDateTime(), 0, 0, 0, 0, {}}
+{
+}
+
+FrameStatistics::~FrameStatistics() noexcept
+{
+    mCsvFile.close();
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void FrameStatistics::setOverlayEnabled(bool enabled) noexcept
+{
+    mOverlayEnabled = enabled;
+}
+
+void FrameStatistics::setCsvFilePath(const FilePath& fp) noexcept
+{
+    if (fp == mCsvFilePath) return;
+    mCsvFile.close();
+    mCsvFilePath = fp;
+    if (!mCsvFilePath.isValid()) return;
+
+    bool writeHeader = !mCsvFilePath.isExistingFile();
+    mCsvFile.setFileName(mCsvFilePath.toStr());
+    if (!mCsvFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "Could not open frame statistics file:" << mCsvFilePath.toNative()
+                   << mCsvFile.errorString();
+        return;
+    }
+    if (writeHeader) {
+        mCsvFile.write("timestamp,paint_time_ms,painted_items,index_rebuilds,"
+                       "event_handler_time_ms,event_handlers\n");
+    }
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void FrameStatistics::addFrame(qreal paintTimeMs, int paintedItems) noexcept
+{
+    mPendingFrame.timestamp = QDateTime::currentDateTime();
+    mPendingFrame.paintTimeMs = paintTimeMs;
+    mPendingFrame.paintedItems = paintedItems;
+    mLastFrame = mPendingFrame;
+    mPendingFrame = Frame{QDateTime(), 0, 0, 0, 0, {}};
+    if (mCsvFile.isOpen()) {
+        writeCsvRow(mLastFrame);
+    }
+}
+
+void FrameStatistics::addIndexRebuild() noexcept
+{
+    if (isEnabled()) {
+        mPendingFrame.indexRebuilds++;
+    }
+}
+
+void FrameStatistics::addEventHandlerTime(const QString& name, qreal timeMs) noexcept
+{
+    // strip the namespaces from class names
+    QString shortName = name.section("::", -1);
+    mPendingFrame.eventHandlerTimeMs += timeMs;
+    mPendingFrame.eventHandlerTimesMs[shortName] += timeMs;
+}
+
+QString FrameStatistics::getLastFrameSummary() const noexcept
+{
+    QString summary = QString("Paint: %1 ms\nItems: %2\nIndex rebuilds: %3\n"
+                              "Event handlers: %4 ms")
+        .arg(mLastFrame.paintTimeMs, 0, 'f', 2).arg(mLastFrame.paintedItems)
+        .arg(mLastFrame.indexRebuilds).arg(mLastFrame.eventHandlerTimeMs, 0, 'f', 2);
+    for (auto it = mLastFrame.eventHandlerTimesMs.constBegin();
+         it != mLastFrame.eventHandlerTimesMs.constEnd(); ++it) {
+        summary += QString("\n  %1: %2 ms").arg(it.key()).arg(it.value(), 0, 'f', 2);
+    }
+    return summary;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void FrameStatistics::writeCsvRow(const Frame& frame) noexcept
+{
+    QStringList handlers;
+    for (auto it = frame.eventHandlerTimesMs.constBegin();
+         it != frame.eventHandlerTimesMs.constEnd(); ++it) {
+        handlers.append(QString("%1=%2").arg(it.key()).arg(it.value(), 0, 'f', 3));
+    }
+    QString row = QString("%1,%2,%3,%4,%5,\"%6\"\n")
+        .arg(frame.timestamp.toString("yyyy-MM-ddTHH:mm:ss.zzz"))
+        .arg(frame.paintTimeMs, 0, 'f', 3).arg(frame.paintedItems)
+        .arg(frame.indexRebuilds).arg(frame.eventHandlerTimeMs, 0, 'f', 3)
+        .arg(handlers.join(";"));
+    mCsvFile.write(row.toUtf8());
+    mCsvFile.flush();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
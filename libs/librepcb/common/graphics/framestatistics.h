@@ -0,0 +1,146 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_FRAMESTATISTICS_H
+#define LIBREPCB_FRAMESTATISTICS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../fileio/filepath.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class FrameStatistics
+ ****************************************************************************************/
+
+/**
+ * @brief The FrameStatistics class collects rendering statistics of all graphics views
+ *
+ * This is a debugging tool to quantify rendering performance (e.g. to compare different
+ * versions). When enabled, every librepcb::GraphicsView reports the time needed to paint
+ * a frame and the number of painted items. In addition, the number of scene index
+ * rebuilds and the time spent in event handlers (e.g. the states of the editor FSMs)
+ * since the last frame are accumulated and assigned to the next frame.
+ *
+ * The statistics of the last frame can be shown as an overlay in the graphics views,
+ * and all frames can be recorded to a CSV file.
+ *
+ * There is only one singleton object of this class, see #instance(). It must only be
+ * used from the GUI thread.
+ */
+class FrameStatistics final
+{
+    public:
+
+        /**
+         * @brief The statistics of one painted frame
+         */
+        struct Frame {
+            QDateTime timestamp;
+            qreal paintTimeMs;      ///< time needed to paint the frame
+            int paintedItems;       ///< number of items in the exposed area
+            int indexRebuilds;      ///< number of scene index rebuilds since last frame
+            qreal eventHandlerTimeMs; ///< total time in event handlers since last frame
+            QMap<QString, qreal> eventHandlerTimesMs; ///< the same, per event handler
+        };
+
+        /**
+         * @brief Helper to measure the time spent in an event handler
+         *
+         * The time between construction and destruction is added to the event handler
+         * with the given name. If the statistics are disabled, nothing is measured.
+         */
+        class EventHandlerTimer final
+        {
+            public:
+                explicit EventHandlerTimer(const char* name) noexcept;
+                ~EventHandlerTimer() noexcept;
+                EventHandlerTimer(const EventHandlerTimer& other) = delete;
+                EventHandlerTimer& operator=(const EventHandlerTimer& rhs) = delete;
+
+            private:
+                const char* mName;
+                QElapsedTimer mTimer;
+        };
+
+        // Constructors / Destructor
+        FrameStatistics(const FrameStatistics& other) = delete;
+        ~FrameStatistics() noexcept;
+
+        // Getters
+        bool isEnabled() const noexcept {return mOverlayEnabled || mCsvFile.isOpen();}
+        bool isOverlayEnabled() const noexcept {return mOverlayEnabled;}
+        const FilePath& getCsvFilePath() const noexcept {return mCsvFilePath;}
+        const Frame& getLastFrame() const noexcept {return mLastFrame;}
+
+        // Setters
+        void setOverlayEnabled(bool enabled) noexcept;
+
+        /**
+         * @brief Start or stop recording to a CSV file
+         *
+         * @param fp    The file to append the frames to (an invalid path stops recording)
+         */
+        void setCsvFilePath(const FilePath& fp) noexcept;
+
+        // General Methods
+        void addFrame(qreal paintTimeMs, int paintedItems) noexcept;
+        void addIndexRebuild() noexcept;
+        void addEventHandlerTime(const QString& name, qreal timeMs) noexcept;
+
+        /**
+         * @brief Format the statistics of the last frame for the overlay
+         */
+        QString getLastFrameSummary() const noexcept;
+
+        // Operator Overloadings
+        FrameStatistics& operator=(const FrameStatistics& rhs) = delete;
+
+        // Static Methods
+        static FrameStatistics& instance() noexcept {static FrameStatistics x; return x;}
+
+
+    private:
+
+        // Private Methods
+        FrameStatistics() noexcept;
+        void writeCsvRow(const Frame& frame) noexcept;
+
+
+        // Attributes
+        bool mOverlayEnabled;
+        FilePath mCsvFilePath;
+        QFile mCsvFile;
+        Frame mPendingFrame;    ///< accumulates the counters until the next frame
+        Frame mLastFrame;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_FRAMESTATISTICS_H
@@ -36,12 +36,14 @@ namespace librepcb {
 GraphicsLayer::GraphicsLayer(const GraphicsLayer& other) noexcept :
     QObject(nullptr), mName(other.mName), mNameTr(other.mNameTr), mColor(other.mColor),
     mColorHighlighted(other.mColorHighlighted), mIsVisible(other.mIsVisible),
-    mIsEnabled(other.mIsEnabled)
+    mIsEnabled(other.mIsEnabled), mFlags(other.mFlags),
+    mInnerLayerNumber(other.mInnerLayerNumber), mMirroredName(other.mMirroredName)
 {
 }
 
 GraphicsLayer::GraphicsLayer(const QString& name) noexcept :
-    QObject(nullptr), mName(name), mIsEnabled(true)
+    QObject(nullptr), mName(name), mIsEnabled(true), mFlags(getFlags(name)),
+    mInnerLayerNumber(getInnerLayerNumber(name)), mMirroredName(getMirroredLayerName(name))
 {
     getDefaultValues(mName, mNameTr, mColor, mColorHighlighted, mIsVisible);
 }
@@ -143,11 +145,11 @@ QString GraphicsLayer::getInnerLayerName(int number) noexcept
 
 int GraphicsLayer::getInnerLayerNumber(const QString& name) noexcept
 {
-    QString number = name;
-    number.remove("in");
-    number.remove("_cu");
+    if ((!name.startsWith("in")) || (!name.endsWith("_cu"))) {
+        return -1;
+    }
     bool ok = false;
-    int result = number.toInt(&ok);
+    int result = name.midRef(2, name.length() - 5).toInt(&ok);
     return ok ? result : -1;
 }
 
@@ -247,6 +249,7 @@ void GraphicsLayer::getDefaultValues(const QString& name, QString& nameTr, QColo
         h.insert(sSymbolPinNumbers,         {tr("Pin Numbers"),                 QColor(64, 64, 64, 255),    Qt::gray,                   true});
         // board asymmetric
         h.insert(sBoardSheetFrames,         {tr("Sheet Frames"),                Qt::lightGray,              Qt::white,                  true});
+        h.insert(sBoardAirWires,            {tr("Airwires"),                    Qt::yellow,                 Qt::darkYellow,             true});
         h.insert(sBoardOutlines,            {tr("Board Outlines"),              QColor(255, 255, 255, 180), QColor(255, 255, 255, 220), true});
         h.insert(sBoardMillingPth,          {tr("Milling (PTH)"),               Qt::cyan,                   Qt::blue,                   true});
         h.insert(sBoardDrillsNpth,          {tr("Drills (NPTH)"),               QColor(255, 255, 255, 150), QColor(255, 255, 255, 220), true});
@@ -298,6 +301,20 @@ void GraphicsLayer::getDefaultValues(const QString& name, QString& nameTr, QColo
     visible = item.visible;
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+int GraphicsLayer::getFlags(const QString& name) noexcept
+{
+    int flags = 0;
+    if (isTopLayer(name))       {flags |= TopLayer;}
+    if (isBottomLayer(name))    {flags |= BottomLayer;}
+    if (isInnerLayer(name))     {flags |= InnerLayer;}
+    if (isCopperLayer(name))    {flags |= CopperLayer;}
+    return flags;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -79,6 +79,7 @@ class GraphicsLayer : public QObject
         //static constexpr const char* sBoardSelection          = "brd_selection";          ///< Primary: outline    | Secondary: area
         //static constexpr const char* sBoardReferences         = "brd_references";         ///< origin crosses of footprints, holes, ...
         static constexpr const char* sBoardSheetFrames        = "brd_sheet_frames";       ///< e.g. A4 sheet frame + text boxes
+        static constexpr const char* sBoardAirWires           = "brd_airwires";           ///< unrouted connections (ratsnest)
         static constexpr const char* sBoardOutlines           = "brd_outlines";           ///< incl. non-plated through hole milling
         static constexpr const char* sBoardMillingPth         = "brd_milling_pth";        ///< plated through hole milling
         static constexpr const char* sBoardDrillsNpth         = "brd_drills_npth";        ///< non-plated through hole drills
@@ -144,12 +145,12 @@ class GraphicsLayer : public QObject
         bool getVisible() const noexcept {return mIsVisible;}
         bool isEnabled() const noexcept {return mIsEnabled;}
         bool isVisible() const noexcept {return mIsEnabled && mIsVisible;}
-        bool isTopLayer() const noexcept {return isTopLayer(mName);}
-        bool isBottomLayer() const noexcept {return isBottomLayer(mName);}
-        bool isInnerLayer() const noexcept {return isInnerLayer(mName);}
-        bool isCopperLayer() const noexcept {return isCopperLayer(mName);}
-        int getInnerLayerNumber() const noexcept {return getInnerLayerNumber(mName);}
-        QString getMirroredLayerName() const noexcept {return getMirroredLayerName(mName);}
+        bool isTopLayer() const noexcept {return mFlags & TopLayer;}
+        bool isBottomLayer() const noexcept {return mFlags & BottomLayer;}
+        bool isInnerLayer() const noexcept {return mFlags & InnerLayer;}
+        bool isCopperLayer() const noexcept {return mFlags & CopperLayer;}
+        int getInnerLayerNumber() const noexcept {return mInnerLayerNumber;}
+        const QString& getMirroredLayerName() const noexcept {return mMirroredName;}
         QString getGrabAreaLayerName() const noexcept {return getGrabAreaLayerName(mName);}
 
         // Setters
@@ -185,6 +186,21 @@ class GraphicsLayer : public QObject
         void attributesChanged();
 
 
+    private: // Types
+
+        /// Properties derived from the layer name, see #mFlags
+        enum Flag {
+            TopLayer    = 1 << 0,
+            BottomLayer = 1 << 1,
+            InnerLayer  = 1 << 2,
+            CopperLayer = 1 << 3,
+        };
+
+
+    private: // Methods
+        static int getFlags(const QString& name) noexcept;
+
+
     protected: // Data
         QString mName;              ///< Unique name which is used for serialization
         QString mNameTr;            ///< Layer name (translated into the user's language)
@@ -193,6 +209,11 @@ class GraphicsLayer : public QObject
         bool mIsVisible;            ///< Visibility of graphics items on that layer
         bool mIsEnabled;            ///< Visibility/availability of the layer itself
         mutable QSet<IF_GraphicsLayerObserver*> mObservers; ///< A list of all observer objects
+
+        // Derived from #mName, so the getters don't need to parse it on every call
+        int mFlags;                 ///< Combination of #Flag values
+        int mInnerLayerNumber;      ///< see #getInnerLayerNumber(const QString&)
+        QString mMirroredName;      ///< see #getMirroredLayerName(const QString&)
 };
 
 /*****************************************************************************************
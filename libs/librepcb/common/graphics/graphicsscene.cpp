@@ -23,6 +23,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include "graphicsscene.h"
+#include "../memoryreport.h"
 #include "../units/point.h"
 
 /*****************************************************************************************
@@ -35,7 +36,8 @@ namespace librepcb {
  ****************************************************************************************/
 
 GraphicsScene::GraphicsScene() noexcept :
-    QGraphicsScene(nullptr), mSelectionRectItem(nullptr)
+    QGraphicsScene(nullptr), mSelectionRectItem(nullptr), mLevelOfDetail{8, 4, 20},
+    mBulkUpdateDepth(0), mItemIndexMethodBeforeBulkUpdate(BspTreeIndex)
 {
     /*QBrush selectBrush = QGuiApplication::palette().highlight();
     QColor selectColor = selectBrush.color();
@@ -55,6 +57,17 @@ GraphicsScene::~GraphicsScene() noexcept
     delete mSelectionRectItem;  mSelectionRectItem = nullptr;
 }
 
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void GraphicsScene::setLevelOfDetail(const LevelOfDetail& lod) noexcept
+{
+    mLevelOfDetail = lod;
+    invalidateCachedItems();
+    update();
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -75,6 +88,43 @@ void GraphicsScene::setSelectionRect(const Point& p1, const Point& p2) noexcept
     mSelectionRectItem->setRect(rectPx);
 }
 
+void GraphicsScene::invalidateCachedItems() noexcept
+{
+    foreach (QGraphicsItem* item, items()) {
+        if (item->cacheMode() != QGraphicsItem::NoCache) {
+            item->update();
+        }
+    }
+}
+
+void GraphicsScene::addToMemoryReport(MemoryReport& parent) const noexcept
+{
+    QList<QGraphicsItem*> allItems = items();
+    qint64 bytes = 0;
+    foreach (const QGraphicsItem* item, allItems) {
+        // most items keep their shape as a cached painter path
+        bytes += sizeof(QGraphicsItem)
+               + item->shape().elementCount() * sizeof(QPainterPath::Element);
+    }
+    parent.addChild("Graphics items", bytes, allItems.count());
+}
+
+void GraphicsScene::beginBulkUpdate() noexcept
+{
+    if (mBulkUpdateDepth++ == 0) {
+        mItemIndexMethodBeforeBulkUpdate = itemIndexMethod();
+        setItemIndexMethod(NoIndex);
+    }
+}
+
+void GraphicsScene::endBulkUpdate() noexcept
+{
+    Q_ASSERT(mBulkUpdateDepth > 0);
+    if (--mBulkUpdateDepth == 0) {
+        setItemIndexMethod(mItemIndexMethodBeforeBulkUpdate); // rebuilds the index
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -31,6 +31,7 @@
  ****************************************************************************************/
 namespace librepcb {
 
+class MemoryReport;
 class Point;
 
 /*****************************************************************************************
@@ -46,19 +47,66 @@ class GraphicsScene final : public QGraphicsScene
 
     public:
 
+        /**
+         * @brief Thresholds (in pixels on the screen) for level-of-detail rendering
+         *
+         * Graphics items may use these values to skip or simplify drawing of elements
+         * which are too small to be recognized at the current zoom level anyway.
+         */
+        struct LevelOfDetail {
+            qreal minTextSize;      ///< smaller texts are not drawn at all
+            qreal minPadSize;       ///< smaller pads/vias are drawn as filled rects,
+                                    ///< thinner traces as cosmetic lines
+            qreal minFootprintSize; ///< smaller footprints are drawn as outlines
+        };
+
         // Constructors / Destructor
         explicit GraphicsScene() noexcept;
         ~GraphicsScene() noexcept;
 
+        // Getters
+        const LevelOfDetail& getLevelOfDetail() const noexcept {return mLevelOfDetail;}
+
+        // Setters
+        void setLevelOfDetail(const LevelOfDetail& lod) noexcept;
+
         // General Methods
         void addItem(QGraphicsItem& item) noexcept;
         void removeItem(QGraphicsItem& item) noexcept;
         void setSelectionRect(const Point& p1, const Point& p2) noexcept;
 
+        /**
+         * @brief Force all items with an enabled cache (see QGraphicsItem::setCacheMode())
+         *        to repaint their cache
+         *
+         * Needs to be called when some global properties which affect the appearance of
+         * items have changed (e.g. the visibility of layers).
+         */
+        void invalidateCachedItems() noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of all items (incl. their cached
+         *        shapes) to a report
+         */
+        void addToMemoryReport(MemoryReport& parent) const noexcept;
+
+        /**
+         * @brief Start adding/removing many items at once
+         *
+         * Until the matching #endBulkUpdate() is called, the BSP tree index of the scene
+         * is disabled, so it is not updated for every single added or removed item but
+         * rebuilt only once at the end. Calls can be nested.
+         */
+        void beginBulkUpdate() noexcept;
+        void endBulkUpdate() noexcept;
+
 
     private:
 
         QGraphicsRectItem* mSelectionRectItem;
+        LevelOfDetail mLevelOfDetail;
+        int mBulkUpdateDepth;
+        ItemIndexMethod mItemIndexMethodBeforeBulkUpdate;
 };
 
 /*****************************************************************************************
@@ -26,6 +26,8 @@
 #include "graphicsview.h"
 #include "graphicsscene.h"
 #include "if_graphicsvieweventhandler.h"
+#include "framestatistics.h"
+#include "../debugtrace.h"
 #include "../gridproperties.h"
 
 /*****************************************************************************************
@@ -40,16 +42,25 @@ namespace librepcb {
 GraphicsView::GraphicsView(QWidget* parent, IF_GraphicsViewEventHandler* eventHandler) noexcept :
     QGraphicsView(parent), mEventHandlerObject(eventHandler), mScene(nullptr),
     mZoomAnimation(nullptr), mGridProperties(new GridProperties()), mOriginCrossVisible(true),
-    mUseOpenGl(false), mPanningActive(false)
+    mGridPatternScaleFactor(-1), mUseOpenGl(false), mPanningActive(false)
 {
     setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
     setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+    setCacheMode(QGraphicsView::CacheBackground); // grid is only redrawn on zoom/resize
     setOptimizationFlags(QGraphicsView::DontSavePainterState);
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
     setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
     setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
     setSceneRect(-2000, -2000, 4000, 4000);
 
+    // deliver at most one mouse move per frame of the primary screen
+    QScreen* screen = QGuiApplication::primaryScreen();
+    qreal refreshRate = screen ? screen->refreshRate() : 0;
+    mMouseMoveIntervalMs = (refreshRate > 0) ? qFloor(1000 / refreshRate) : 16;
+    mPendingMouseMoveTimer.setSingleShot(true);
+    connect(&mPendingMouseMoveTimer, &QTimer::timeout,
+            this, &GraphicsView::flushPendingMouseMoveEvent);
+
     mZoomAnimation = new QVariantAnimation();
     connect(mZoomAnimation, &QVariantAnimation::valueChanged,
             this, &GraphicsView::zoomAnimationValueChanged);
@@ -78,10 +89,21 @@ void GraphicsView::setUseOpenGl(bool useOpenGl) noexcept
 {
     if (useOpenGl != mUseOpenGl)
     {
-        if (useOpenGl)
+        if (useOpenGl) {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+            // QGLWidget is deprecated since Qt 5.4, QOpenGLWidget is its replacement
+            QSurfaceFormat format;
+            format.setSamples(4);
+            format.setAlphaBufferSize(8);
+            QOpenGLWidget* glWidget = new QOpenGLWidget();
+            glWidget->setFormat(format);
+            setViewport(glWidget);
+#else
             setViewport(new QGLWidget(QGLFormat(QGL::DoubleBuffer | QGL::AlphaChannel | QGL::SampleBuffers)));
-        else
+#endif
+        } else {
             setViewport(nullptr);
+        }
         mUseOpenGl = useOpenGl;
     }
 }
@@ -89,14 +111,22 @@ void GraphicsView::setUseOpenGl(bool useOpenGl) noexcept
 void GraphicsView::setGridProperties(const GridProperties& properties) noexcept
 {
     *mGridProperties = properties;
+    mGridPatternScaleFactor = -1; // invalidate the prerendered grid
+    resetCachedContent();
     setBackgroundBrush(backgroundBrush()); // this will repaint the background
 }
 
 void GraphicsView::setScene(GraphicsScene* scene) noexcept
 {
     if (mScene) mScene->removeEventFilter(this);
+    disconnect(mSceneRectChangedConnection);
     mScene = scene;
-    if (mScene) mScene->installEventFilter(this);
+    if (mScene) {
+        mScene->installEventFilter(this);
+        // the scene index is rebuilt whenever the scene rect grows
+        mSceneRectChangedConnection = connect(mScene, &QGraphicsScene::sceneRectChanged, this,
+            [](){FrameStatistics::instance().addIndexRebuild();});
+    }
     QGraphicsView::setScene(mScene);
 }
 
@@ -113,6 +143,8 @@ void GraphicsView::setOriginCrossVisible(bool visible) noexcept
 
 void GraphicsView::setEventHandlerObject(IF_GraphicsViewEventHandler* eventHandler) noexcept
 {
+    mPendingMouseMoveTimer.stop();
+    mPendingMouseMoveEvent.reset();
     mEventHandlerObject = eventHandler;
 }
 
@@ -203,6 +235,7 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event)
     switch (event->type())
     {
         case QEvent::GraphicsSceneMousePress: {
+            flushPendingMouseMoveEvent();
             QGraphicsSceneMouseEvent* e = dynamic_cast<QGraphicsSceneMouseEvent*>(event); Q_ASSERT(e);
             if (e->button() == Qt::MiddleButton) {
                 mCursorBeforePanning = cursor();
@@ -213,6 +246,7 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event)
             return true;
         }
         case QEvent::GraphicsSceneMouseRelease: {
+            flushPendingMouseMoveEvent();
             QGraphicsSceneMouseEvent* e = dynamic_cast<QGraphicsSceneMouseEvent*>(event); Q_ASSERT(e);
             if (e->button() == Qt::MiddleButton) {
                 setCursor(mCursorBeforePanning);
@@ -230,11 +264,20 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event)
                 verticalScrollBar()->setValue(verticalScrollBar()->value() - diff.y());
                 mPanningActive = false;
             }
-            emit cursorScenePositionChanged(Point::fromPx(e->scenePos()));
-            // no break here!
+            setPendingMouseMoveEvent(*e);
+            if (mLastMouseMoveTimer.isValid() &&
+                (mLastMouseMoveTimer.elapsed() < mMouseMoveIntervalMs)) {
+                if (!mPendingMouseMoveTimer.isActive()) {
+                    mPendingMouseMoveTimer.start(mMouseMoveIntervalMs - mLastMouseMoveTimer.elapsed());
+                }
+            } else {
+                flushPendingMouseMoveEvent();
+            }
+            return true;
         }
         case QEvent::GraphicsSceneMouseDoubleClick:
         case QEvent::GraphicsSceneContextMenu: {
+            flushPendingMouseMoveEvent();
             if (mEventHandlerObject) {
                 mEventHandlerObject->graphicsViewEventHandler(event);
             }
@@ -242,6 +285,7 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event)
         }
         case QEvent::GraphicsSceneWheel: {
             if (!underMouse()) break;
+            flushPendingMouseMoveEvent();
             if (mEventHandlerObject) {
                 if (!mEventHandlerObject->graphicsViewEventHandler(event)) {
                     handleMouseWheelEvent(dynamic_cast<QGraphicsSceneWheelEvent*>(event));
@@ -259,6 +303,8 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event)
 
 void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect)
 {
+    LIBREPCB_TRACE_SCOPE("GraphicsView::drawBackground");
+
     QPen gridPen(Qt::gray);
     gridPen.setCosmetic(true);
 
@@ -272,9 +318,18 @@ void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect)
     painter->setPen(gridPen);
     painter->setBrush(Qt::NoBrush);
     qreal gridIntervalPixels = mGridProperties->getInterval().toPx();
-    qreal scaleFactor = width() / rect.width();
+    // note: "rect" may be only a part of the view since the background is cached
+    qreal scaleFactor = qAbs(transform().m11());
     if (gridIntervalPixels * scaleFactor >= (qreal)5)
     {
+        // dense grids are drawn with a prerendered pattern (instead of thousands of
+        // lines or dots), only coarse grids with a few lines are drawn directly
+        const QBrush& pattern = getGridPatternBrush(gridIntervalPixels, scaleFactor);
+        if (pattern.style() != Qt::NoBrush) {
+            painter->fillRect(rect, pattern);
+            return;
+        }
+
         qreal left, right, top, bottom;
         left = qFloor(rect.left() / gridIntervalPixels) * gridIntervalPixels;
         right = rect.right();
@@ -310,6 +365,22 @@ void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect)
     }
 }
 
+void GraphicsView::paintEvent(QPaintEvent* event)
+{
+    LIBREPCB_TRACE_SCOPE("GraphicsView::paintEvent");
+    FrameStatistics& statistics = FrameStatistics::instance();
+    if (!statistics.isEnabled()) {
+        QGraphicsView::paintEvent(event);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QGraphicsView::paintEvent(event);
+    qreal paintTimeMs = timer.nsecsElapsed() / 1000000.0;
+    statistics.addFrame(paintTimeMs, items(event->rect()).count());
+}
+
 void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect)
 {
     Q_UNUSED(rect);
@@ -324,6 +395,112 @@ void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect)
         painter->drawLine(QLineF(-len, 0.0, len, 0.0));
         painter->drawLine(QLineF(0.0, -len, 0.0, len));
     }
+
+    if (FrameStatistics::instance().isOverlayEnabled())
+    {
+        // draw the statistics of the last frame in the top left corner of the viewport
+        painter->save();
+        painter->resetTransform();
+        QFont font = painter->font();
+        font.setStyleHint(QFont::Monospace);
+        font.setFamily("Monospace");
+        font.setPixelSize(12);
+        painter->setFont(font);
+        QString text = FrameStatistics::instance().getLastFrameSummary();
+        QRectF textRect = painter->boundingRect(QRectF(10, 10, 0, 0),
+                                                Qt::AlignLeft | Qt::AlignTop, text);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(QColor(0, 0, 0, 160));
+        painter->drawRect(textRect.adjusted(-5, -5, 5, 5));
+        painter->setPen(Qt::white);
+        painter->drawText(textRect, Qt::AlignLeft | Qt::AlignTop, text);
+        painter->restore();
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+const QBrush& GraphicsView::getGridPatternBrush(qreal intervalPx, qreal scaleFactor) noexcept
+{
+    if (scaleFactor == mGridPatternScaleFactor) {
+        return mGridPatternBrush;
+    }
+    mGridPatternScaleFactor = scaleFactor;
+    mGridPatternBrush = QBrush();
+
+    // one tile of the pattern contains exactly one grid interval
+    int size = qRound(intervalPx * scaleFactor * devicePixelRatio());
+    if ((size < 2) || (size > sMaxGridPatternSize)) {
+        return mGridPatternBrush;
+    }
+    QPixmap tile(size, size);
+    tile.fill(Qt::transparent);
+    QPainter painter(&tile);
+    switch (mGridProperties->getType())
+    {
+        case GridProperties::Type_t::Lines: {
+            QColor color(Qt::gray);
+            color.setAlphaF(0.5);
+            painter.fillRect(0, 0, size, 1, color);
+            painter.fillRect(0, 0, 1, size, color);
+            break;
+        }
+        case GridProperties::Type_t::Dots: {
+            // the dot is located at the corners, so it's split over all four of them
+            for (int x = 0; x <= size; x += size) {
+                for (int y = 0; y <= size; y += size) {
+                    painter.fillRect(x - 1, y - 1, 2, 2, Qt::gray);
+                }
+            }
+            break;
+        }
+        default:
+            return mGridPatternBrush;
+    }
+    painter.end();
+
+    // scale the tile to the grid interval in scene coordinates, and since the brush
+    // origin is the scene origin, the pattern is aligned to the grid
+    mGridPatternBrush.setTexture(tile);
+    mGridPatternBrush.setTransform(QTransform::fromScale(intervalPx / size, intervalPx / size));
+    return mGridPatternBrush;
+}
+
+void GraphicsView::setPendingMouseMoveEvent(const QGraphicsSceneMouseEvent& event) noexcept
+{
+    // the "last" positions are those of the last *delivered* move
+    QGraphicsSceneMouseEvent* e = new QGraphicsSceneMouseEvent(QEvent::GraphicsSceneMouseMove);
+    const QGraphicsSceneMouseEvent& first = mPendingMouseMoveEvent ? *mPendingMouseMoveEvent : event;
+    e->setLastPos(first.lastPos());
+    e->setLastScenePos(first.lastScenePos());
+    e->setLastScreenPos(first.lastScreenPos());
+    e->setWidget(event.widget());
+    e->setPos(event.pos());
+    e->setScenePos(event.scenePos());
+    e->setScreenPos(event.screenPos());
+    for (Qt::MouseButton button : {Qt::LeftButton, Qt::RightButton, Qt::MiddleButton}) {
+        e->setButtonDownPos(button, event.buttonDownPos(button));
+        e->setButtonDownScenePos(button, event.buttonDownScenePos(button));
+        e->setButtonDownScreenPos(button, event.buttonDownScreenPos(button));
+    }
+    e->setButtons(event.buttons());
+    e->setButton(event.button());
+    e->setModifiers(event.modifiers());
+    mPendingMouseMoveEvent.reset(e);
+}
+
+void GraphicsView::flushPendingMouseMoveEvent() noexcept
+{
+    mPendingMouseMoveTimer.stop();
+    if (!mPendingMouseMoveEvent) return;
+    QScopedPointer<QGraphicsSceneMouseEvent> e(mPendingMouseMoveEvent.take());
+    mLastMouseMoveTimer.start();
+    emit cursorScenePositionChanged(Point::fromPx(e->scenePos()));
+    if (mEventHandlerObject) {
+        mEventHandlerObject->graphicsViewEventHandler(e.data());
+    }
 }
 
 /*****************************************************************************************
@@ -105,9 +105,15 @@ class GraphicsView final : public QGraphicsView
 
         // Inherited Methods
         bool eventFilter(QObject* obj, QEvent* event);
+        void paintEvent(QPaintEvent* event);
         void drawBackground(QPainter* painter, const QRectF& rect);
         void drawForeground(QPainter* painter, const QRectF& rect);
 
+        // Private Methods
+        const QBrush& getGridPatternBrush(qreal intervalPx, qreal scaleFactor) noexcept;
+        void setPendingMouseMoveEvent(const QGraphicsSceneMouseEvent& event) noexcept;
+        void flushPendingMouseMoveEvent() noexcept;
+
 
         // General Attributes
         IF_GraphicsViewEventHandler* mEventHandlerObject;
@@ -115,12 +121,25 @@ class GraphicsView final : public QGraphicsView
         QVariantAnimation* mZoomAnimation;
         GridProperties* mGridProperties;
         bool mOriginCrossVisible;
+        QBrush mGridPatternBrush; ///< prerendered grid, see #getGridPatternBrush()
+        qreal mGridPatternScaleFactor; ///< the zoom factor of #mGridPatternBrush (-1 = invalid)
         bool mUseOpenGl;
         volatile bool mPanningActive;
         QCursor mCursorBeforePanning;
 
+        // Mouse Move Coalescing
+        // High-rate mice generate many more move events than frames can be painted, so
+        // each move is kept as pending event and at most one of them per frame is
+        // passed to the event handler. Other events flush the pending move first.
+        QScopedPointer<QGraphicsSceneMouseEvent> mPendingMouseMoveEvent;
+        QTimer mPendingMouseMoveTimer;      ///< delivers the pending move if no more follow
+        QElapsedTimer mLastMouseMoveTimer;  ///< time since the last delivered move
+        int mMouseMoveIntervalMs;           ///< min. time between two delivered moves
+        QMetaObject::Connection mSceneRectChangedConnection; ///< for FrameStatistics
+
         // Static Variables
         static constexpr qreal sZoomStepFactor = 1.3;
+        static constexpr int sMaxGridPatternSize = 256; ///< in device pixels
 };
 
 /*****************************************************************************************
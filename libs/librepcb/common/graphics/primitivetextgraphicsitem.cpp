@@ -35,7 +35,7 @@ namespace librepcb {
 
 PrimitiveTextGraphicsItem::PrimitiveTextGraphicsItem(QGraphicsItem* parent) noexcept :
     QGraphicsItem(parent), mLayer(nullptr), mAlignment(HAlign::left(), VAlign::bottom()),
-    mTextFlags(0)
+    mBrush(Qt::SolidPattern), mBrushHighlighted(Qt::SolidPattern), mTextFlags(0)
 {
     mFont.setStyleStrategy(QFont::StyleStrategy(QFont::OpenGLCompatible | QFont::PreferQuality));
     mFont.setStyleHint(QFont::SansSerif);
@@ -112,8 +112,8 @@ void PrimitiveTextGraphicsItem::setLayer(const GraphicsLayer* layer) noexcept
     mLayer = layer;
     if (mLayer) {
         mLayer->registerObserver(*this);
-        mPen.setColor(mLayer->getColor(false));
-        mPenHighlighted.setColor(mLayer->getColor(true));
+        mBrush.setColor(mLayer->getColor(false));
+        mBrushHighlighted.setColor(mLayer->getColor(true));
         setVisible(mLayer->isVisible());
         update();
     } else {
@@ -129,7 +129,7 @@ void PrimitiveTextGraphicsItem::layerColorChanged(const GraphicsLayer& layer, co
 {
     Q_UNUSED(layer);
     Q_ASSERT(&layer == mLayer);
-    mPen.setColor(newColor);
+    mBrush.setColor(newColor);
     update();
 }
 
@@ -137,7 +137,7 @@ void PrimitiveTextGraphicsItem::layerHighlightColorChanged(const GraphicsLayer&
 {
     Q_UNUSED(layer);
     Q_ASSERT(&layer == mLayer);
-    mPenHighlighted.setColor(newColor);
+    mBrushHighlighted.setColor(newColor);
     update();
 }
 
@@ -160,11 +160,11 @@ void PrimitiveTextGraphicsItem::layerEnabledChanged(const GraphicsLayer& layer,
 void PrimitiveTextGraphicsItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) noexcept
 {
     Q_UNUSED(widget);
-    painter->setFont(mFont);
+    // the cached glyph runs are drawn with the pen, like QPainter::drawText()
     if (option->state.testFlag(QStyle::State_Selected)) {
-        painter->setPen(mPenHighlighted);
+        painter->setPen(QPen(mBrushHighlighted, 0));
     } else {
-        painter->setPen(mPen);
+        painter->setPen(QPen(mBrush, 0));
     }
 
     if (mapToScene(0, 1).y() < mapToScene(0, 0).y()) {
@@ -173,10 +173,10 @@ void PrimitiveTextGraphicsItem::paint(QPainter* painter, const QStyleOptionGraph
         //painter->save();
         painter->rotate(180);
         painter->translate(-mBoundingRect.topLeft() - mBoundingRect.bottomRight());
-        painter->drawText(QRectF(), mTextFlags, mText);
+        TextLayoutCache::draw(*painter, mLayout);
         //painter->restore();
     } else {
-        painter->drawText(QRectF(), mTextFlags, mText);
+        TextLayoutCache::draw(*painter, mLayout);
     }
 }
 
@@ -188,8 +188,8 @@ void PrimitiveTextGraphicsItem::updateBoundingRectAndShape() noexcept
 {
     prepareGeometryChange();
     mTextFlags = Qt::TextDontClip | mAlignment.toQtAlign();
-    QFontMetricsF fm(mFont);
-    mBoundingRect = fm.boundingRect(QRectF(), mTextFlags, mText);
+    mLayout = TextLayoutCache::get(mFont, mText, mTextFlags);
+    mBoundingRect = mLayout.boundingRect;
     mShape = QPainterPath();
     mShape.addRect(mBoundingRect);
     update();
@@ -27,6 +27,7 @@
 #include <QtWidgets>
 #include "../alignment.h"
 #include "../graphics/graphicslayer.h"
+#include "../graphics/textlayoutcache.h"
 #include "../units/all_length_units.h"
 
 /*****************************************************************************************
@@ -92,9 +93,10 @@ class PrimitiveTextGraphicsItem : public QGraphicsItem, public IF_GraphicsLayerO
         QString mText;
         Alignment mAlignment;
         QFont mFont;
-        QPen mPen;
-        QPen mPenHighlighted;
+        QBrush mBrush;
+        QBrush mBrushHighlighted;
         int mTextFlags;
+        TextLayoutCache::Layout mLayout;
         QRectF mBoundingRect;
         QPainterPath mShape;
 };
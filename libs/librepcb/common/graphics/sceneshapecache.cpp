@@ -0,0 +1,71 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "sceneshapecache.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+const QPainterPath& SceneShapeCache::getSceneShape(const QGraphicsItem& item) noexcept
+{
+    update(item);
+    return mSceneShape;
+}
+
+const QRectF& SceneShapeCache::getSceneBoundingRect(const QGraphicsItem& item) noexcept
+{
+    update(item);
+    return mSceneBoundingRect;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void SceneShapeCache::update(const QGraphicsItem& item) noexcept
+{
+    QPainterPath shape = item.shape();
+    QTransform transform = item.sceneTransform();
+    if (mValid && (transform == mSceneTransform) && (shape == mItemShape)) {
+        return; // shapes with the same data are compared without looking at the elements
+    }
+    mItemShape = shape;
+    mSceneTransform = transform;
+    mSceneShape = transform.map(shape);
+    mSceneBoundingRect = mSceneShape.boundingRect();
+    mValid = true;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,101 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_SCENESHAPECACHE_H
+#define LIBREPCB_SCENESHAPECACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class SceneShapeCache
+ ****************************************************************************************/
+
+/**
+ * @brief The SceneShapeCache class caches the shape of a graphics item in scene
+ *        coordinates
+ *
+ * Mapping the shape of an item to the scene creates a new QPainterPath on every call,
+ * which is expensive if it's done for every item on every mouse event (e.g. to find
+ * the items under the cursor). This cache keeps the mapped shape until the shape or
+ * the scene transform of the item changes. Since the cached path is implicitly shared,
+ * also its bounding rect (used by QPainterPath::contains() and
+ * QPainterPath::intersects() to reject far away positions quickly) is calculated only
+ * once.
+ *
+ * No explicit invalidation is needed: the shape returned by QGraphicsItem::shape() is
+ * compared with the cached one, which is cheap since unmodified paths share their data.
+ */
+class SceneShapeCache final
+{
+    public:
+
+        // Constructors / Destructor
+        SceneShapeCache() noexcept = default;
+        SceneShapeCache(const SceneShapeCache& other) = delete;
+        ~SceneShapeCache() noexcept = default;
+
+        // General Methods
+
+        /**
+         * @brief Get the shape of an item in scene coordinates
+         *
+         * @param item      The graphics item (must always be the same item)
+         *
+         * @return The same as item.sceneTransform().map(item.shape())
+         */
+        const QPainterPath& getSceneShape(const QGraphicsItem& item) noexcept;
+
+        /**
+         * @brief Get the bounding rect of #getSceneShape()
+         */
+        const QRectF& getSceneBoundingRect(const QGraphicsItem& item) noexcept;
+
+        // Operator Overloadings
+        SceneShapeCache& operator=(const SceneShapeCache& rhs) = delete;
+
+
+    private: // Methods
+        void update(const QGraphicsItem& item) noexcept;
+
+
+    private: // Data
+        bool mValid = false;
+        QPainterPath mItemShape;        ///< the shape in item coordinates
+        QTransform mSceneTransform;     ///< the scene transform of the item
+        QPainterPath mSceneShape;       ///< the shape in scene coordinates
+        QRectF mSceneBoundingRect;      ///< the bounding rect of #mSceneShape
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_SCENESHAPECACHE_H
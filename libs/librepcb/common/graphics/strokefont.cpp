@@ -0,0 +1,310 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "strokefont.h"
+#include "../memoryreport.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace {
+
+/*****************************************************************************************
+ *  Glyph Data
+ ****************************************************************************************/
+
+// grid units of the glyph definitions
+const qreal sCapHeight = 6;
+const qreal sLineSpacing = 10;
+const qreal sLetterSpacing = 2;
+
+/**
+ * Glyph definitions: the width in grid units and the strokes as polylines, separated
+ * by ';'. Each point is given as "x,y" with the baseline at y=0.
+ */
+struct GlyphData {
+    ushort unicode;
+    qreal width;
+    const char* strokes;
+};
+
+const GlyphData sGlyphData[] = {
+    // punctuation and symbols
+    {' ',  2, ""},
+    {'!',  0, "0,6 0,2;0,0 0,0.5"},
+    {'"',  2, "0,6 0,4;2,6 2,4"},
+    {'#',  4, "1,0 1,6;3,0 3,6;0,2 4,2;0,4 4,4"},
+    {'$',  4, "4,5 3,6 1,6 0,5 0,4 1,3 3,3 4,2 4,1 3,0 1,0 0,1;2,7 2,-1"},
+    {'%',  4, "0,0 4,6;0,6 0,5 1,5 1,6 0,6;3,0 3,1 4,1 4,0 3,0"},
+    {'&',  4, "4,0 1,4 1,5 2,6 3,5 3,4 0,2 0,1 1,0 2,0 4,2"},
+    {'\'', 0, "0,6 0,4"},
+    {'(',  2, "2,7 0,5 0,1 2,-1"},
+    {')',  2, "0,7 2,5 2,1 0,-1"},
+    {'*',  4, "2,1 2,5;0,2 4,4;0,4 4,2"},
+    {'+',  4, "0,3 4,3;2,1 2,5"},
+    {',',  1, "1,0.5 1,0 0,-1"},
+    {'-',  3, "0,3 3,3"},
+    {'.',  0, "0,0 0,0.5"},
+    {'/',  4, "0,0 4,6"},
+    {':',  0, "0,0 0,0.5;0,3.5 0,4"},
+    {';',  1, "1,3.5 1,4;1,0.5 1,0 0,-1"},
+    {'<',  4, "4,5 0,3 4,1"},
+    {'=',  4, "0,2 4,2;0,4 4,4"},
+    {'>',  4, "0,5 4,3 0,1"},
+    {'?',  4, "0,5 1,6 3,6 4,5 4,4 2,3 2,2;2,0 2,0.5"},
+    {'@',  4, "3,2 3,4 1,4 1,2 4,2 4,5 3,6 1,6 0,5 0,1 1,0 4,0"},
+    {'[',  2, "2,7 0,7 0,-1 2,-1"},
+    {'\\', 4, "0,6 4,0"},
+    {']',  2, "0,7 2,7 2,-1 0,-1"},
+    {'^',  4, "0,4 2,6 4,4"},
+    {'_',  4, "0,-1 4,-1"},
+    {'`',  1, "0,6 1,5"},
+    {'{',  2, "2,7 1,6 1,4 0,3 1,2 1,0 2,-1"},
+    {'|',  0, "0,7 0,-1"},
+    {'}',  2, "0,7 1,6 1,4 2,3 1,2 1,0 0,-1"},
+    {'~',  4, "0,3 1,4 3,2 4,3"},
+    // digits
+    {'0',  4, "1,0 0,1 0,5 1,6 3,6 4,5 4,1 3,0 1,0;1,1 3,5"},
+    {'1',  3, "1,5 2,6 2,0;1,0 3,0"},
+    {'2',  4, "0,5 1,6 3,6 4,5 4,4 0,0 4,0"},
+    {'3',  4, "0,5 1,6 3,6 4,5 4,4 3,3 1,3;3,3 4,2 4,1 3,0 1,0 0,1"},
+    {'4',  4, "3,0 3,6 0,2 4,2"},
+    {'5',  4, "4,6 0,6 0,4 3,4 4,3 4,1 3,0 1,0 0,1"},
+    {'6',  4, "4,5 3,6 1,6 0,5 0,1 1,0 3,0 4,1 4,2 3,3 1,3 0,2"},
+    {'7',  4, "0,6 4,6 1,0"},
+    {'8',  4, "1,3 0,4 0,5 1,6 3,6 4,5 4,4 3,3 1,3 0,2 0,1 1,0 3,0 4,1 4,2 3,3"},
+    {'9',  4, "0,1 1,0 3,0 4,1 4,5 3,6 1,6 0,5 0,4 1,3 3,3 4,4"},
+    // uppercase letters
+    {'A',  4, "0,0 2,6 4,0;1,3 3,3"},
+    {'B',  4, "0,0 0,6 3,6 4,5 4,4 3,3 0,3;3,3 4,2 4,1 3,0 0,0"},
+    {'C',  4, "4,5 3,6 1,6 0,5 0,1 1,0 3,0 4,1"},
+    {'D',  4, "0,0 0,6 2,6 4,4 4,2 2,0 0,0"},
+    {'E',  4, "4,6 0,6 0,0 4,0;0,3 3,3"},
+    {'F',  4, "4,6 0,6 0,0;0,3 3,3"},
+    {'G',  4, "4,5 3,6 1,6 0,5 0,1 1,0 3,0 4,1 4,3 2,3"},
+    {'H',  4, "0,0 0,6;4,0 4,6;0,3 4,3"},
+    {'I',  2, "0,6 2,6;1,6 1,0;0,0 2,0"},
+    {'J',  3, "1,6 3,6;3,6 3,1 2,0 1,0 0,1"},
+    {'K',  4, "0,0 0,6;4,6 0,2;1,3 4,0"},
+    {'L',  4, "0,6 0,0 4,0"},
+    {'M',  4, "0,0 0,6 2,3 4,6 4,0"},
+    {'N',  4, "0,0 0,6 4,0 4,6"},
+    {'O',  4, "1,0 0,1 0,5 1,6 3,6 4,5 4,1 3,0 1,0"},
+    {'P',  4, "0,0 0,6 3,6 4,5 4,4 3,3 0,3"},
+    {'Q',  4, "1,0 0,1 0,5 1,6 3,6 4,5 4,1 3,0 1,0;2,2 4,0"},
+    {'R',  4, "0,0 0,6 3,6 4,5 4,4 3,3 0,3;2,3 4,0"},
+    {'S',  4, "4,5 3,6 1,6 0,5 0,4 1,3 3,3 4,2 4,1 3,0 1,0 0,1"},
+    {'T',  4, "0,6 4,6;2,6 2,0"},
+    {'U',  4, "0,6 0,1 1,0 3,0 4,1 4,6"},
+    {'V',  4, "0,6 2,0 4,6"},
+    {'W',  4, "0,6 1,0 2,4 3,0 4,6"},
+    {'X',  4, "0,0 4,6;0,6 4,0"},
+    {'Y',  4, "0,6 2,3 4,6;2,3 2,0"},
+    {'Z',  4, "0,6 4,6 0,0 4,0"},
+    // lowercase letters
+    {'a',  4, "1,4 3,4 4,3 4,0;4,1 3,0 1,0 0,1 1,2 4,2"},
+    {'b',  4, "0,6 0,0;0,3 1,4 3,4 4,3 4,1 3,0 1,0 0,1"},
+    {'c',  4, "4,3 3,4 1,4 0,3 0,1 1,0 3,0 4,1"},
+    {'d',  4, "4,6 4,0;4,3 3,4 1,4 0,3 0,1 1,0 3,0 4,1"},
+    {'e',  4, "0,2 4,2 4,3 3,4 1,4 0,3 0,1 1,0 3,0"},
+    {'f',  3, "3,6 2,6 1,5 1,0;0,4 3,4"},
+    {'g',  4, "4,3 3,4 1,4 0,3 0,1 1,0 3,0 4,1;4,4 4,-1 3,-2 1,-2"},
+    {'h',  4, "0,6 0,0;0,3 1,4 3,4 4,3 4,0"},
+    {'i',  0, "0,4 0,0;0,6 0,5.5"},
+    {'j',  2, "2,4 2,-1 1,-2 0,-2;2,6 2,5.5"},
+    {'k',  3, "0,6 0,0;3,4 0,1;1,2 3,0"},
+    {'l',  1, "0,6 0,1 1,0"},
+    {'m',  4, "0,0 0,4;0,3 1,4 2,3 2,0;2,3 3,4 4,3 4,0"},
+    {'n',  4, "0,0 0,4;0,3 1,4 3,4 4,3 4,0"},
+    {'o',  4, "1,0 0,1 0,3 1,4 3,4 4,3 4,1 3,0 1,0"},
+    {'p',  4, "0,4 0,-2;0,3 1,4 3,4 4,3 4,1 3,0 1,0 0,1"},
+    {'q',  4, "4,4 4,-2;4,3 3,4 1,4 0,3 0,1 1,0 3,0 4,1"},
+    {'r',  3, "0,0 0,4;0,2 2,4 3,4"},
+    {'s',  4, "4,3 3,4 1,4 0,3 1,2 3,2 4,1 3,0 1,0 0,1"},
+    {'t',  3, "1,6 1,1 2,0 3,0;0,4 3,4"},
+    {'u',  4, "0,4 0,1 1,0 3,0 4,1;4,4 4,0"},
+    {'v',  4, "0,4 2,0 4,4"},
+    {'w',  4, "0,4 1,0 2,3 3,0 4,4"},
+    {'x',  4, "0,0 4,4;0,4 4,0"},
+    {'y',  4, "0,4 2,0;4,4 1,-2 0,-2"},
+    {'z',  4, "0,4 4,4 0,0 4,0"},
+    // special characters often used in values
+    {0x00B0, 2, "0.5,6 1.5,6 2,5.5 2,4.5 1.5,4 0.5,4 0,4.5 0,5.5 0.5,6"},   // degree
+    {0x00B1, 4, "0,3.5 4,3.5;2,1.5 2,5.5;0,0 4,0"},                         // plus-minus
+    {0x00B5, 4, "0,-2 0,4;0,1 1,0 3,0 4,1;4,4 4,0"},                        // micro
+    {0x03A9, 4, "0,0 1.5,0 1.5,1 0,2.5 0,4.5 1.5,6 2.5,6 4,4.5 4,2.5 2.5,1 2.5,0 4,0"}, // ohm
+};
+
+// used for characters without a glyph
+const GlyphData sReplacementGlyph = {0, 4, "0,0 0,6 4,6 4,0 0,0"};
+
+/*****************************************************************************************
+ *  Class Glyph
+ ****************************************************************************************/
+
+struct Glyph {
+    qreal width;
+    QVector<QPolygonF> strokes; ///< in grid units
+};
+
+Glyph parseGlyph(const GlyphData& data) noexcept
+{
+    Glyph glyph;
+    glyph.width = data.width;
+    foreach (const QString& stroke, QString(data.strokes).split(';', QString::SkipEmptyParts)) {
+        QPolygonF polyline;
+        foreach (const QString& point, stroke.split(' ', QString::SkipEmptyParts)) {
+            QStringList coordinates = point.split(',');
+            Q_ASSERT(coordinates.count() == 2);
+            polyline.append(QPointF(coordinates.value(0).toDouble(),
+                                    coordinates.value(1).toDouble()));
+        }
+        glyph.strokes.append(polyline);
+    }
+    return glyph;
+}
+
+/**
+ * The parsed glyphs, created on first use (the initialization of function-local
+ * statics is thread-safe).
+ */
+const Glyph& getGlyph(QChar c) noexcept
+{
+    static const QHash<ushort, Glyph> glyphs = [](){
+        QHash<ushort, Glyph> hash;
+        for (const GlyphData& data : sGlyphData) {
+            hash.insert(data.unicode, parseGlyph(data));
+        }
+        return hash;
+    }();
+    static const Glyph replacement = parseGlyph(sReplacementGlyph);
+    auto it = glyphs.constFind(c.unicode());
+    return (it != glyphs.constEnd()) ? it.value() : replacement;
+}
+
+qreal getLineWidth(const QString& line) noexcept
+{
+    qreal width = 0;
+    for (int i = 0; i < line.length(); ++i) {
+        width += getGlyph(line.at(i)).width;
+        if (i > 0) width += sLetterSpacing;
+    }
+    return width;
+}
+
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+QMutex sMutex;
+QCache<QString, StrokeFont::Layout> sCache(10000); // max. number of layouts
+
+} // namespace
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+StrokeFont::Layout StrokeFont::get(const QString& text, const Length& height,
+                                   const Alignment& align) noexcept
+{
+    QString key = height.toNmString() % '|' % QString::number(align.toQtAlign())
+                  % '|' % text;
+
+    {
+        QMutexLocker locker(&sMutex);
+        if (const Layout* layout = sCache.object(key)) {
+            return *layout;
+        }
+    }
+
+    // vertical position of the first baseline (in grid units)
+    QStringList lines = text.split('\n');
+    qreal blockHeight = sCapHeight + (lines.count() - 1) * sLineSpacing;
+    qreal baseline = -sCapHeight;
+    if (align.getV() == VAlign::bottom()) {
+        baseline = blockHeight - sCapHeight;
+    } else if (align.getV() == VAlign::center()) {
+        baseline = blockHeight / 2 - sCapHeight;
+    }
+
+    // place the glyphs of each line and convert them to nanometers
+    qreal scale = height.toNm() / sCapHeight;
+    Layout layout;
+    foreach (const QString& line, lines) {
+        qreal x = 0;
+        if (align.getH() == HAlign::right()) {
+            x = -getLineWidth(line);
+        } else if (align.getH() == HAlign::center()) {
+            x = -getLineWidth(line) / 2;
+        }
+        for (const QChar& c : line) {
+            const Glyph& glyph = getGlyph(c);
+            foreach (const QPolygonF& polyline, glyph.strokes) {
+                QVector<Point> stroke;
+                stroke.reserve(polyline.count());
+                foreach (const QPointF& p, polyline) {
+                    stroke.append(Point(Length(qRound64((x + p.x()) * scale)),
+                                        Length(qRound64((baseline + p.y()) * scale))));
+                }
+                layout.path.moveTo(stroke.first().toPxQPointF());
+                for (int i = 1; i < stroke.count(); ++i) {
+                    layout.path.lineTo(stroke.at(i).toPxQPointF());
+                }
+                layout.strokes.append(stroke);
+            }
+            x += glyph.width + sLetterSpacing;
+        }
+        baseline -= sLineSpacing;
+    }
+    qreal margin = getStrokeWidth(height).toPx() / 2;
+    layout.boundingRect = layout.path.boundingRect().adjusted(-margin, -margin, margin, margin);
+
+    QMutexLocker locker(&sMutex);
+    sCache.insert(key, new Layout(layout));
+    return layout;
+}
+
+void StrokeFont::addToMemoryReport(MemoryReport& parent) noexcept
+{
+    QMutexLocker locker(&sMutex);
+    qint64 bytes = 0;
+    foreach (const QString& key, sCache.keys()) {
+        const Layout* layout = sCache.object(key);
+        bytes += MemoryReport::getStringSize(key) + sizeof(Layout)
+               + layout->path.elementCount() * sizeof(QPainterPath::Element);
+        foreach (const QVector<Point>& stroke, layout->strokes) {
+            bytes += sizeof(stroke) + stroke.count() * sizeof(Point);
+        }
+    }
+    parent.addChild("Stroke font layout cache", bytes, sCache.count());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
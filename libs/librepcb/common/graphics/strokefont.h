@@ -0,0 +1,112 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_STROKEFONT_H
+#define LIBREPCB_STROKEFONT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "../units/all_length_units.h"
+#include "../alignment.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class MemoryReport;
+
+/*****************************************************************************************
+ *  Class StrokeFont
+ ****************************************************************************************/
+
+/**
+ * @brief The StrokeFont class lays out texts with a built-in single-line (stroke) font
+ *
+ * Texts on boards (e.g. designators on the silkscreen) must look the same on the screen
+ * and in the Gerber files, which is not possible with the system fonts (they are not
+ * available in the CAM output and differ between platforms). This font consists only of
+ * polylines which are drawn with a round pen of #getStrokeWidth(), so the same layout
+ * can be painted on the screen and exported as Gerber lines.
+ *
+ * The glyphs are designed on a grid with a cap height of 6 units (x-height 4, descender
+ * 2), so the text height corresponds to the height of capital letters. Characters
+ * without a glyph are drawn as boxes.
+ *
+ * Layouts are cached per text, height and alignment, so boards with thousands of
+ * (often identical) texts lay out each of them only once.
+ */
+class StrokeFont final
+{
+    public:
+
+        /**
+         * @brief A laid out text
+         *
+         * All coordinates are relative to the anchor position of the text (as defined
+         * by the alignment), without rotation.
+         */
+        struct Layout {
+            QVector<QVector<Point>> strokes; ///< polylines of all glyphs
+            QPainterPath path;               ///< same as #strokes, in pixels
+            QRectF boundingRect;             ///< of #path in pixels, incl. stroke width
+        };
+
+        // Constructors / Destructor
+        StrokeFont() = delete;
+        StrokeFont(const StrokeFont& other) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Get the layout of a text (cached, thread-safe)
+         *
+         * @param text      The text to lay out (may contain newlines)
+         * @param height    The height of capital letters
+         * @param align     The alignment relative to the anchor position
+         *
+         * @return A (cheap) copy of the cached layout
+         */
+        static Layout get(const QString& text, const Length& height,
+                          const Alignment& align) noexcept;
+
+        /**
+         * @brief Get the pen width to draw the strokes of a text with the given height
+         */
+        static Length getStrokeWidth(const Length& height) noexcept {return height * 3 / 20;}
+
+        /**
+         * @brief Add the approximate memory usage of all cached layouts to a report
+         */
+        static void addToMemoryReport(MemoryReport& parent) noexcept;
+
+        // Operator Overloadings
+        StrokeFont& operator=(const StrokeFont& rhs) = delete;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_STROKEFONT_H
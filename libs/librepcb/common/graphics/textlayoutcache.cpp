@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "textlayoutcache.h"
+#include "../memoryreport.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+static QMutex sMutex;
+static QCache<QString, TextLayoutCache::Layout> sCache(10000); // max. number of layouts
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+TextLayoutCache::Layout TextLayoutCache::get(const QFont& font, const QString& text,
+                                             int flags) noexcept
+{
+    QString key = font.key() % '|' % QString::number(flags) % '|' % text;
+
+    {
+        QMutexLocker locker(&sMutex);
+        if (const Layout* layout = sCache.object(key)) {
+            return *layout;
+        }
+    }
+
+    // lay out each line within the bounding rect, like QPainter::drawText() does
+    QFontMetricsF metrics(font);
+    Layout layout;
+    layout.boundingRect = metrics.boundingRect(QRectF(), flags, text);
+    qreal baseline = layout.boundingRect.top() + metrics.ascent();
+    foreach (const QString& line, text.split('\n')) {
+        qreal width = metrics.width(line);
+        qreal x = layout.boundingRect.left();
+        if (flags & Qt::AlignRight) {
+            x = layout.boundingRect.right() - width;
+        } else if (flags & Qt::AlignHCenter) {
+            x = layout.boundingRect.center().x() - width / 2;
+        }
+        QTextLayout textLayout(line, font);
+        textLayout.beginLayout();
+        QTextLine textLine = textLayout.createLine();
+        if (textLine.isValid()) {
+            textLine.setNumColumns(line.length()); // no line wrapping
+            textLine.setPosition(QPointF(x, baseline - textLine.ascent()));
+        }
+        textLayout.endLayout();
+        layout.glyphRuns.append(textLayout.glyphRuns());
+        baseline += metrics.lineSpacing();
+    }
+
+    QMutexLocker locker(&sMutex);
+    sCache.insert(key, new Layout(layout));
+    return layout;
+}
+
+void TextLayoutCache::draw(QPainter& painter, const Layout& layout,
+                           const QPointF& offset) noexcept
+{
+    foreach (const QGlyphRun& run, layout.glyphRuns) {
+        painter.drawGlyphRun(offset, run);
+    }
+}
+
+void TextLayoutCache::addToMemoryReport(MemoryReport& parent) noexcept
+{
+    QMutexLocker locker(&sMutex);
+    qint64 bytes = 0;
+    foreach (const QString& key, sCache.keys()) {
+        const Layout* layout = sCache.object(key);
+        bytes += MemoryReport::getStringSize(key) + sizeof(Layout);
+        foreach (const QGlyphRun& run, layout->glyphRuns) {
+            bytes += sizeof(QGlyphRun) + run.glyphIndexes().count()
+                     * (sizeof(quint32) + sizeof(QPointF));
+        }
+    }
+    parent.addChild("Text layout cache", bytes, sCache.count());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_TEXTLAYOUTCACHE_H
+#define LIBREPCB_TEXTLAYOUTCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class MemoryReport;
+
+/*****************************************************************************************
+ *  Class TextLayoutCache
+ ****************************************************************************************/
+
+/**
+ * @brief The TextLayoutCache class provides laid out texts as glyph runs, shared
+ *        between all graphics items
+ *
+ * Laying out a text (font metrics, shaping, alignment) on every paint is expensive,
+ * especially for schematics and boards with thousands of (often identical) texts. With
+ * this cache, each distinct combination of font, text and alignment flags is laid out
+ * only once. The resulting QGlyphRun objects are implicitly shared, so identical items
+ * use the same glyph indices and positions without copying them.
+ *
+ * The glyph runs are positioned exactly like QPainter::drawText(QRectF(), flags, text)
+ * would draw them. Draw them with #draw(), which uses the pen of the painter (like
+ * QPainter::drawText()). In contrast to glyph outlines, glyph runs are rendered by the
+ * font engine, so the texts keep their hinting and glyph cache.
+ */
+class TextLayoutCache final
+{
+    public:
+
+        /**
+         * @brief A laid out text
+         */
+        struct Layout {
+            QRectF boundingRect;        ///< same as QFontMetricsF::boundingRect(QRectF(), ...)
+            QList<QGlyphRun> glyphRuns; ///< glyphs of all lines
+        };
+
+        // Constructors / Destructor
+        TextLayoutCache() = delete;
+        TextLayoutCache(const TextLayoutCache& other) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Get the layout of a text (cached, thread-safe)
+         *
+         * @param font      The font to use
+         * @param text      The text to lay out (may contain newlines)
+         * @param flags     The alignment flags as used for QPainter::drawText()
+         *
+         * @return A (cheap) copy of the cached layout
+         */
+        static Layout get(const QFont& font, const QString& text, int flags) noexcept;
+
+        /**
+         * @brief Draw a laid out text with the current pen of a painter
+         *
+         * @param painter   The painter to draw with
+         * @param layout    The layout to draw
+         * @param offset    The offset to draw the layout at
+         */
+        static void draw(QPainter& painter, const Layout& layout,
+                         const QPointF& offset = QPointF()) noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of all cached layouts to a report
+         */
+        static void addToMemoryReport(MemoryReport& parent) noexcept;
+
+        // Operator Overloadings
+        TextLayoutCache& operator=(const TextLayoutCache& rhs) = delete;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_TEXTLAYOUTCACHE_H
@@ -28,35 +28,102 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Types
+ ****************************************************************************************/
+
+struct IF_AttributeProvider::Token {
+    QString text;       ///< the literal text, or the whole variable (e.g. "${CMP::NAME}")
+    QString varNS;      ///< only for variables: the namespace (e.g. "CMP")
+    QString varName;    ///< only for variables: the name (e.g. "NAME")
+    bool isVariable;
+};
+
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+/// Maximum nesting of variables within attribute values (deeper nestings are recursions)
+static const int sMaxRecursionDepth = 10;
+
 /*****************************************************************************************
  *  Class IF_AttributeProvider
  ****************************************************************************************/
 
 int IF_AttributeProvider::replaceVariablesWithAttributes(QString& rawText, bool passToParents) const noexcept
 {
+    return replaceVariablesWithAttributes(rawText, passToParents, 0);
+}
+
+int IF_AttributeProvider::replaceVariablesWithAttributes(QString& rawText, bool passToParents,
+                                                         int depth) const noexcept
+{
+    if (!rawText.contains(QLatin1String("${"))) {
+        return 0; // most texts are static, no need to look them up in the cache
+    }
+
     int count = 0;
-    int startPos = 0;
-    int length = 0;
-    QString varNS;
-    QString varName;
+    QString result;
     QString varValue;
-    while (searchVariableInText(rawText, startPos, startPos, length, varNS, varName))
+    foreach (const Token& token, compileText(rawText))
     {
-        if (getAttributeValue(varNS, varName, passToParents, varValue))
+        if (!token.isVariable) {
+            result += token.text;
+            continue;
+        }
+        if (getAttributeValue(token.varNS, token.varName, passToParents, varValue))
         {
-            // avoid endless recursion
-            QString complete = rawText.mid(startPos, length);
-            varValue.replace(complete, QCoreApplication::translate("IF_AttributeProvider",
-                                                                   "[RECURSION REMOVED]"));
-            rawText.replace(startPos, length, varValue);
+            if (varValue.contains(QLatin1String("${"))) {
+                // avoid endless recursion
+                varValue.replace(token.text, QCoreApplication::translate("IF_AttributeProvider",
+                                                                         "[RECURSION REMOVED]"));
+                if (depth < sMaxRecursionDepth) {
+                    replaceVariablesWithAttributes(varValue, passToParents, depth + 1);
+                }
+            }
+            result += varValue;
         }
-        else
-            rawText.remove(startPos, length);
         count++;
     }
+    rawText = result;
     return count;
 }
 
+QVector<IF_AttributeProvider::Token> IF_AttributeProvider::compileText(const QString& text) noexcept
+{
+    static QMutex sMutex;
+    static QCache<QString, QVector<Token>> sCompiledTexts(10000); // max. number of texts
+
+    {
+        QMutexLocker locker(&sMutex);
+        if (const QVector<Token>* tokens = sCompiledTexts.object(text)) {
+            return *tokens;
+        }
+    }
+
+    QVector<Token> tokens;
+    int startPos = 0;
+    int pos = 0;
+    int length = 0;
+    QString varNS;
+    QString varName;
+    while (searchVariableInText(text, startPos, pos, length, varNS, varName))
+    {
+        if (pos > startPos) {
+            tokens.append(Token{text.mid(startPos, pos - startPos), QString(), QString(), false});
+        }
+        tokens.append(Token{text.mid(pos, length), varNS, varName, true});
+        startPos = pos + length;
+    }
+    if (startPos < text.length()) {
+        tokens.append(Token{text.mid(startPos), QString(), QString(), false});
+    }
+
+    QMutexLocker locker(&sMutex);
+    sCompiledTexts.insert(text, new QVector<Token>(tokens));
+    return tokens;
+}
+
 bool IF_AttributeProvider::searchVariableInText(const QString& text, int startPos, int& pos,
                                                 int& length, QString& varNS, QString& varName) noexcept
 {
@@ -90,6 +90,10 @@ class IF_AttributeProvider
          *                          #project#ComponentInstance).
          *
          * @return The count of replaced variables in the text
+         *
+         * @note    The positions of the variables of a text are parsed only once and then
+         *          cached (for all attribute providers), so calling this method
+         *          repeatedly for the same text only costs the lookup of the values.
          */
         int replaceVariablesWithAttributes(QString& rawText, bool passToParents) const noexcept;
 
@@ -128,8 +132,29 @@ class IF_AttributeProvider
         IF_AttributeProvider& operator=(const IF_AttributeProvider& rhs);
 
 
+        // Types
+        struct Token;
+
         // Private Methods
 
+        /**
+         * @brief Replace all variables in a text and in the values of its variables
+         *
+         * @param rawText           See #replaceVariablesWithAttributes()
+         * @param passToParents     See #replaceVariablesWithAttributes()
+         * @param depth             The count of values containing this text (to stop
+         *                          indirect recursions like "${A}" --> "${B}" --> "${A}")
+         *
+         * @return The count of replaced variables in the text (without their values)
+         */
+        int replaceVariablesWithAttributes(QString& rawText, bool passToParents,
+                                           int depth) const noexcept;
+
+        /**
+         * @brief Split a text into literal and variable tokens (cached, thread-safe)
+         */
+        static QVector<Token> compileText(const QString& text) noexcept;
+
         /**
          * @brief Search the next variable ("${NS::KEY}") in a given text
          *
@@ -0,0 +1,202 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "jobscheduler.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class JobScheduler::Runner
+ ****************************************************************************************/
+
+/**
+ * @brief Runs the next queued job of a group in the thread pool
+ *
+ * The jobs themselves are kept in the queue of their group until a thread is available,
+ * so they can still be removed by JobScheduler::Group::clear(). If the queue is empty
+ * when the runner is started, it does nothing.
+ */
+class JobScheduler::Runner final : public QRunnable
+{
+    public:
+        explicit Runner(Group& group) noexcept : QRunnable(), mGroup(group) {}
+
+        void run() override {
+            QRunnable* job = nullptr;
+            {
+                QMutexLocker locker(&mGroup.mMutex);
+                mGroup.mWaitingRunners--;
+                if (mGroup.mQueuedJobs.isEmpty()) {
+                    mGroup.mDoneCondition.wakeAll();
+                    return;
+                }
+                job = mGroup.mQueuedJobs.dequeue();
+                mGroup.mRunningJobs++;
+            }
+            job->run();
+            if (job->autoDelete()) {
+                delete job;
+            }
+            mGroup.jobFinished();
+        }
+
+    private:
+        Group& mGroup;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+JobScheduler::JobScheduler(int maxThreadCount) noexcept :
+    QObject(nullptr), mThreadPool(), mPendingJobCount(0)
+{
+    mThreadPool.setMaxThreadCount(qMax(maxThreadCount, 1));
+}
+
+JobScheduler::~JobScheduler() noexcept
+{
+    // all groups are already destroyed, so only (empty) runners can be left
+    mThreadPool.waitForDone();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void JobScheduler::addPendingJobs(int count) noexcept
+{
+    int newCount = mPendingJobCount.fetchAndAddOrdered(count) + count;
+    emit pendingJobCountChanged(newCount);
+}
+
+/*****************************************************************************************
+ *  Class JobScheduler::Group
+ ****************************************************************************************/
+
+JobScheduler::Group::Group(JobScheduler& scheduler, Priority priority,
+                           int maxConcurrentJobs) noexcept :
+    mScheduler(scheduler), mPriority(priority), mMaxConcurrentJobs(maxConcurrentJobs),
+    mMutex(), mDoneCondition(), mQueuedJobs(), mWaitingRunners(0), mRunningJobs(0),
+    mCancellationToken()
+{
+}
+
+JobScheduler::Group::~Group() noexcept
+{
+    cancel();
+    waitForDone(); // runners must not access the group after it is destroyed
+}
+
+int JobScheduler::Group::getPendingJobCount() const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mQueuedJobs.count() + mRunningJobs;
+}
+
+JobScheduler::CancellationToken JobScheduler::Group::getCancellationToken() const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mCancellationToken;
+}
+
+void JobScheduler::Group::start(QRunnable* job) noexcept
+{
+    Q_ASSERT(job);
+    QMutexLocker locker(&mMutex);
+    mQueuedJobs.enqueue(job);
+    mScheduler.addPendingJobs(1);
+    startRunners();
+}
+
+void JobScheduler::Group::clear() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    if (mQueuedJobs.isEmpty()) return;
+    mScheduler.addPendingJobs(-mQueuedJobs.count());
+    foreach (QRunnable* job, mQueuedJobs) {
+        if (job->autoDelete()) {
+            delete job;
+        }
+    }
+    mQueuedJobs.clear();
+    mDoneCondition.wakeAll();
+}
+
+void JobScheduler::Group::cancel() noexcept
+{
+    clear();
+    QMutexLocker locker(&mMutex);
+    mCancellationToken.cancel();
+    mCancellationToken = CancellationToken();
+}
+
+bool JobScheduler::Group::waitForDone(int msecs) noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+    QMutexLocker locker(&mMutex);
+    while ((!mQueuedJobs.isEmpty()) || (mWaitingRunners > 0) || (mRunningJobs > 0)) {
+        if (msecs < 0) {
+            mDoneCondition.wait(&mMutex);
+        } else {
+            qint64 remaining = msecs - timer.elapsed();
+            if ((remaining <= 0) || (!mDoneCondition.wait(&mMutex, remaining))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void JobScheduler::Group::startRunners() noexcept
+{
+    while ((mWaitingRunners < mQueuedJobs.count()) && ((mMaxConcurrentJobs <= 0) ||
+           (mWaitingRunners + mRunningJobs < mMaxConcurrentJobs)))
+    {
+        mWaitingRunners++;
+        mScheduler.mThreadPool.start(new Runner(*this), static_cast<int>(mPriority));
+    }
+}
+
+void JobScheduler::Group::jobFinished() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    mRunningJobs--;
+    mScheduler.addPendingJobs(-1);
+    startRunners();
+    mDoneCondition.wakeAll();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,230 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_JOBSCHEDULER_H
+#define LIBREPCB_JOBSCHEDULER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class JobScheduler
+ ****************************************************************************************/
+
+/**
+ * @brief The JobScheduler class runs background jobs on a shared thread pool
+ *
+ * Instead of creating their own threads, subsystems with background work (thumbnails,
+ * metadata caches, autosave, ...) create a #JobScheduler::Group and start their jobs
+ * in it. All groups share one pool with as many threads as there are CPU cores, and
+ * queued jobs of a higher #Priority are started before jobs of a lower priority.
+ *
+ * A group provides the same clear/wait semantics as an own QThreadPool, but only for
+ * its own jobs, and it can limit the number of its concurrently running jobs (e.g. to
+ * 1 if the jobs must not run in parallel). Running jobs are never interrupted, but they
+ * can poll the #CancellationToken of their group to stop early.
+ *
+ * The scheduler must outlive all of its groups.
+ */
+class JobScheduler final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+
+        /// The priority of a group's jobs, higher priorities are started first
+        enum class Priority {
+            Background = 0,     ///< e.g. autosave, results are not shown immediately
+            Visible = 1,        ///< results are shown in the GUI as soon as available
+            Interactive = 2,    ///< the user is waiting for the results
+        };
+
+        /**
+         * @brief A copyable flag to tell running jobs that they should stop early
+         */
+        class CancellationToken final
+        {
+            public:
+                CancellationToken() noexcept : mCanceled(new QAtomicInt(0)) {}
+                CancellationToken(const CancellationToken& other) = default;
+                bool isCanceled() const noexcept {return mCanceled->load() != 0;}
+                void cancel() noexcept {mCanceled->store(1);}
+                CancellationToken& operator=(const CancellationToken& rhs) = default;
+
+            private:
+                QSharedPointer<QAtomicInt> mCanceled;
+        };
+
+        class Group;
+
+        // Constructors / Destructor
+        JobScheduler(const JobScheduler& other) = delete;
+        explicit JobScheduler(int maxThreadCount = QThread::idealThreadCount()) noexcept;
+        ~JobScheduler() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the number of queued and running jobs of all groups
+         */
+        int getPendingJobCount() const noexcept {return mPendingJobCount.load();}
+
+        int getMaxThreadCount() const noexcept {return mThreadPool.maxThreadCount();}
+
+        // Operator Overloadings
+        JobScheduler& operator=(const JobScheduler& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief Emitted when the number of queued and running jobs has changed
+         *
+         * @note This signal is emitted from arbitrary threads, so only connect it with a
+         *       queued (or automatic) connection.
+         */
+        void pendingJobCountChanged(int count);
+
+
+    private: // Types
+        class Runner;
+
+
+    private: // Methods
+        void addPendingJobs(int count) noexcept;
+
+
+    private: // Data
+        QThreadPool mThreadPool;
+        QAtomicInt mPendingJobCount;
+};
+
+/*****************************************************************************************
+ *  Class JobScheduler::Group
+ ****************************************************************************************/
+
+/**
+ * @brief A set of jobs of one subsystem, started in a JobScheduler
+ *
+ * The destructor cancels all jobs of the group and waits until the running ones are
+ * finished, so the jobs can safely access the object which owns the group.
+ */
+class JobScheduler::Group final
+{
+    public:
+
+        // Constructors / Destructor
+        Group() = delete;
+        Group(const Group& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param scheduler         The scheduler to run the jobs
+         * @param priority          The priority of all jobs of this group
+         * @param maxConcurrentJobs The maximum count of jobs of this group running at
+         *                          the same time (0 = unlimited). Use 1 to run the jobs
+         *                          one after another in the order they were started.
+         */
+        Group(JobScheduler& scheduler, Priority priority, int maxConcurrentJobs = 0) noexcept;
+        ~Group() noexcept;
+
+        // Getters
+        Priority getPriority() const noexcept {return mPriority;}
+        int getPendingJobCount() const noexcept;
+
+        /**
+         * @brief Get the token which will be canceled by the next call to #cancel()
+         *
+         * Pass it to jobs which take long enough that it is worth to stop them early.
+         */
+        CancellationToken getCancellationToken() const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Start a job
+         *
+         * @param job   The job to run in the scheduler's thread pool. Like with
+         *              QThreadPool::start(), it is deleted after running if
+         *              QRunnable::autoDelete() is true.
+         */
+        void start(QRunnable* job) noexcept;
+
+        /**
+         * @brief Remove all jobs of this group which are not yet started
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Remove all queued jobs and cancel the token of the running jobs
+         *
+         * Jobs started afterwards get a new (not canceled) token.
+         */
+        void cancel() noexcept;
+
+        /**
+         * @brief Wait until all jobs of this group are finished
+         *
+         * @param msecs     Timeout in milliseconds (-1 = wait forever)
+         *
+         * @retval true     If all jobs are finished
+         * @retval false    If the timeout has expired
+         */
+        bool waitForDone(int msecs = -1) noexcept;
+
+        // Operator Overloadings
+        Group& operator=(const Group& rhs) = delete;
+
+
+    private: // Methods
+        void startRunners() noexcept; // mMutex must be locked
+        void jobFinished() noexcept;
+
+
+    private: // Data
+        JobScheduler& mScheduler;
+        Priority mPriority;
+        int mMaxConcurrentJobs;
+        mutable QMutex mMutex;
+        QWaitCondition mDoneCondition;
+        QQueue<QRunnable*> mQueuedJobs;     ///< not yet taken by a runner
+        int mWaitingRunners;                ///< runners started in the thread pool
+        int mRunningJobs;                   ///< jobs taken by a runner
+        CancellationToken mCancellationToken;
+
+        friend class JobScheduler::Runner;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_JOBSCHEDULER_H
@@ -0,0 +1,140 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "memoryreport.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+static int sNextProviderId = 1;
+static QMap<int, MemoryReport::Provider> sProviders; ///< ordered by registration
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+MemoryReport::MemoryReport(const QString& name, qint64 bytes, int count) noexcept :
+    mName(name), mBytes(bytes), mCount(count)
+{
+}
+
+MemoryReport::~MemoryReport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 MemoryReport::getTotalBytes() const noexcept
+{
+    qint64 bytes = mBytes;
+    foreach (const auto& child, mChildren) {
+        bytes += child->getTotalBytes();
+    }
+    return bytes;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+MemoryReport& MemoryReport::addChild(const QString& name, qint64 bytes, int count) noexcept
+{
+    mChildren.append(std::make_shared<MemoryReport>(name, bytes, count));
+    return *mChildren.last();
+}
+
+QString MemoryReport::toString() const noexcept
+{
+    QStringList lines;
+    appendLines(lines, 0);
+    return lines.join("\n");
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QString MemoryReport::formatBytes(qint64 bytes) noexcept
+{
+    if (bytes >= 1024 * 1024) {
+        return QString("%1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+    } else if (bytes >= 1024) {
+        return QString("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+    } else {
+        return QString("%1 B").arg(bytes);
+    }
+}
+
+int MemoryReport::registerProvider(const Provider& provider) noexcept
+{
+    Q_ASSERT((!qApp) || (QThread::currentThread() == qApp->thread()));
+    int id = sNextProviderId++;
+    sProviders.insert(id, provider);
+    return id;
+}
+
+void MemoryReport::unregisterProvider(int id) noexcept
+{
+    Q_ASSERT((!qApp) || (QThread::currentThread() == qApp->thread()));
+    sProviders.remove(id);
+}
+
+MemoryReport MemoryReport::createApplicationReport() noexcept
+{
+    Q_ASSERT((!qApp) || (QThread::currentThread() == qApp->thread()));
+    MemoryReport report("Total");
+    foreach (const Provider& provider, sProviders) {
+        provider(report);
+    }
+    return report;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void MemoryReport::appendLines(QStringList& lines, int level) const noexcept
+{
+    QString line = QString(level * 2, ' ') % mName % ": " % formatBytes(getTotalBytes());
+    if (mCount >= 0) {
+        line += QString(" (%1x)").arg(mCount);
+    }
+    lines.append(line);
+    foreach (const auto& child, mChildren) {
+        child->appendLines(lines, level + 1);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
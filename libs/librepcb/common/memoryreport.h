@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_MEMORYREPORT_H
+#define LIBREPCB_MEMORYREPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QPainterPath>
+#include <functional>
+#include <memory>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class MemoryReport
+ ****************************************************************************************/
+
+/**
+ * @brief The MemoryReport class is a tree of approximate memory usages
+ *
+ * Subsystems which may allocate a lot of memory (projects, boards, undo stacks, caches,
+ * ...) add a child node with their approximate memory usage to a given report, and
+ * their own subsystems as children of that node. The numbers are estimations based on
+ * object sizes and element counts, intended to find out which subsystem is responsible
+ * for a high memory usage, not to account every single byte.
+ *
+ * Objects which exist independently of each other (e.g. the workspace and the opened
+ * projects) register a provider with #registerProvider(), then
+ * #createApplicationReport() collects the reports of all of them. The provider
+ * registry must only be used from the main thread.
+ */
+class MemoryReport final
+{
+    public:
+
+        // Types
+        typedef std::function<void(MemoryReport& report)> Provider;
+
+        // Constructors / Destructor
+        MemoryReport() = delete;
+        MemoryReport(const MemoryReport& other) = default;
+        explicit MemoryReport(const QString& name, qint64 bytes = 0, int count = -1) noexcept;
+        ~MemoryReport() noexcept;
+
+        // Getters
+        const QString& getName() const noexcept {return mName;}
+        qint64 getOwnBytes() const noexcept {return mBytes;}
+        qint64 getTotalBytes() const noexcept;
+        int getCount() const noexcept {return mCount;}
+        const QList<std::shared_ptr<MemoryReport>>& getChildren() const noexcept {return mChildren;}
+
+        // General Methods
+        void addBytes(qint64 bytes) noexcept {mBytes += bytes;}
+
+        /**
+         * @brief Add a child node
+         *
+         * @param name      The name of the subsystem or object type
+         * @param bytes     The memory used by the subsystem itself (without children)
+         * @param count     The count of objects, or -1 if not applicable
+         *
+         * @return The new child, to add more bytes or children to it
+         */
+        MemoryReport& addChild(const QString& name, qint64 bytes = 0, int count = -1) noexcept;
+
+        /**
+         * @brief Add a child node for a count of objects of the same type
+         */
+        template <typename T>
+        MemoryReport& addObjects(const QString& name, int count) noexcept {
+            return addChild(name, static_cast<qint64>(count) * sizeof(T), count);
+        }
+
+        /**
+         * @brief Format the report as indented text, one line per node
+         */
+        QString toString() const noexcept;
+
+        // Operator Overloadings
+        MemoryReport& operator=(const MemoryReport& rhs) = default;
+
+        // Static Methods
+        static qint64 getStringSize(const QString& str) noexcept {
+            return sizeof(QString) + str.capacity() * sizeof(QChar);
+        }
+        static qint64 getPathSize(const QPainterPath& path) noexcept {
+            return sizeof(QPainterPath) + path.elementCount() * sizeof(QPainterPath::Element);
+        }
+        static QString formatBytes(qint64 bytes) noexcept;
+
+        /**
+         * @brief Register a provider for #createApplicationReport()
+         *
+         * @param provider  Adds the report of its subsystem to the given report
+         *
+         * @return An ID to pass to #unregisterProvider() (must be done before the
+         *         objects used by the provider are destroyed)
+         */
+        static int registerProvider(const Provider& provider) noexcept;
+        static void unregisterProvider(int id) noexcept;
+
+        /**
+         * @brief Create a report with the reports of all registered providers
+         */
+        static MemoryReport createApplicationReport() noexcept;
+
+
+    private:
+
+        // Private Methods
+        void appendLines(QStringList& lines, int level) const noexcept;
+
+
+        // Attributes
+        QString mName;
+        qint64 mBytes;      ///< without children
+        int mCount;         ///< -1 if not applicable
+        QList<std::shared_ptr<MemoryReport>> mChildren;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_MEMORYREPORT_H
@@ -84,6 +84,10 @@ void FileDownload::prepareRequest()
         }
     }
 
+    // the file is written to the destination anyway, so don't fill the HTTP cache with
+    // (possibly huge) downloads
+    mRequest.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+
     // open temporary destination file
     mFile.reset(new QSaveFile(mDestination.toStr(), this));
     if (!mFile->open(QIODevice::WriteOnly)) {
@@ -91,6 +95,11 @@ void FileDownload::prepareRequest()
             QString("Could not open file \"%1\": %2")
             .arg(mDestination.toNative(), mFile->errorString()));
     }
+
+    // the checksum is calculated on the fly (also restarted on redirects)
+    if (!mExpectedChecksum.isEmpty()) {
+        mHash.reset(new QCryptographicHash(mHashAlgorithm));
+    }
 }
 
 void FileDownload::finalizeRequest()
@@ -115,15 +124,8 @@ void FileDownload::finalizeRequest()
     // verify checksum of downloaded file
     if (!mExpectedChecksum.isEmpty()) {
         emit progressState(tr("Verify checksum..."));
-        QFile file(mDestination.toStr());
-        if (!file.open(QFile::ReadOnly)) {
-            throw RuntimeError(__FILE__, __LINE__,
-                QString(tr("Error while readback file \"%1\": %2"))
-                .arg(mDestination.toNative(), file.errorString()));
-        }
-        QCryptographicHash hash(mHashAlgorithm);
-        hash.addData(&file);
-        QString result = hash.result().toHex();
+        Q_ASSERT(mHash);
+        QString result = mHash->result().toHex();
         QString expected = mExpectedChecksum.toHex();
         if (result != expected) {
             qDebug() << "expected" << expected << "but got" << result;
@@ -160,7 +162,18 @@ void FileDownload::emitSuccessfullyFinishedSignals() noexcept
 
 void FileDownload::fetchNewData() noexcept
 {
-    mFile->write(mReply->readAll());
+    QByteArray data = mReply->readAll();
+    mFile->write(data);
+    if (mHash) {
+        mHash->addData(data);
+    }
+}
+
+qint64 FileDownload::getResumableSize() const noexcept
+{
+    // the received data is appended to the file, so an interrupted download can be
+    // resumed at the current file position
+    return mFile ? mFile->pos() : -1;
 }
 
 /*****************************************************************************************
@@ -72,6 +72,8 @@ class FileDownload final : public NetworkRequestBase
          *
          * If set, the checksum of the downloaded file will be compared with this
          * checksum. If they differ, the file gets removed and an error will be reported.
+         * The checksum is calculated while receiving the data, so the file doesn't need
+         * to be read again after downloading it.
          *
          * @param algorithm     The checksum algorithm to be used
          * @param checksum      The expected checksum of the file to download
@@ -87,6 +89,10 @@ class FileDownload final : public NetworkRequestBase
          *
          * @note The downloaded ZIP file will be removed after extracting it.
          *
+         * @warning The extraction is done in the network access manager thread, so it
+         *          blocks all other network requests in the meantime. For large files,
+         *          consider extracting them in another thread after downloading.
+         *
          * @param dir           Destination directory (may or may not exist)
          */
         void setZipExtractionDirectory(const FilePath& dir) noexcept;
@@ -121,6 +127,7 @@ class FileDownload final : public NetworkRequestBase
         void finalizeRequest() override;
         void emitSuccessfullyFinishedSignals() noexcept override;
         void fetchNewData() noexcept override;
+        qint64 getResumableSize() const noexcept override;
 
 
     private: // Data
@@ -129,6 +136,7 @@ class FileDownload final : public NetworkRequestBase
         QScopedPointer<QSaveFile> mFile;
         QCryptographicHash::Algorithm mHashAlgorithm;
         QByteArray mExpectedChecksum;
+        QScopedPointer<QCryptographicHash> mHash; ///< checksum of the received data
         FilePath mExtractZipToDir;
 
 };
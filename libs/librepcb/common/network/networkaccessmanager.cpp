@@ -40,7 +40,7 @@ NetworkAccessManager* NetworkAccessManager::sInstance = nullptr;
  ****************************************************************************************/
 
 NetworkAccessManager::NetworkAccessManager() noexcept :
-    QThread(nullptr), mThreadStartSemaphore(0), mManager(nullptr)
+    QThread(nullptr), mManager(nullptr)
 {
     // This thread must only be started once, and from within the main application thread!
     Q_ASSERT(QThread::currentThread() == qApp->thread());
@@ -51,9 +51,10 @@ NetworkAccessManager::NetworkAccessManager() noexcept :
     connect(qApp, &QCoreApplication::aboutToQuit,
             this, &NetworkAccessManager::stop, Qt::DirectConnection);
 
-    // start the thread and wait until the thread is started successfully
+    // Start the thread without waiting for it, to not delay the application startup.
+    // Requests are queued events which are processed as soon as the event loop runs,
+    // i.e. after mManager has been created.
     start();
-    mThreadStartSemaphore.acquire();
 }
 
 NetworkAccessManager::~NetworkAccessManager() noexcept
@@ -97,7 +98,17 @@ void NetworkAccessManager::run() noexcept
     Q_ASSERT(QThread::currentThread() == this);
     qDebug() << "Started network access manager thread.";
     mManager = new QNetworkAccessManager();
-    mThreadStartSemaphore.release();
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheDir.isEmpty()) {
+        // responses like the library list are revalidated with conditional requests
+        // instead of downloading them again every time
+        QNetworkDiskCache* cache = new QNetworkDiskCache(mManager);
+        cache->setCacheDirectory(cacheDir % "/network");
+        cache->setMaximumCacheSize(sMaxCacheSize);
+        mManager->setCache(cache); // takes ownership
+    } else {
+        qWarning() << "No cache location available, network responses are not cached.";
+    }
     try {
         exec(); // event loop (blocking)
     } catch (...) {
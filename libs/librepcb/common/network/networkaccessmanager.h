@@ -47,7 +47,11 @@ namespace librepcb {
  * After the singleton was created, you can get it with the static method #instance().
  * But for executing network requests, you don't need to access this object directly.
  * You only need the classes librepcb::NetworkRequest and librepcb::FileDownload instead.
-
+ *
+ * Responses are cached in the cache location of the application (see
+ * QStandardPaths::CacheLocation) with a QNetworkDiskCache, according to their HTTP
+ * caching headers.
+ *
  * @see librepcb::NetworkRequestBase, librepcb::NetworkRequest, librepcb::FileDownload
  *
  * @author ubruhin
@@ -82,9 +86,11 @@ class NetworkAccessManager final : public QThread
 
     private: // Data
 
-        QSemaphore mThreadStartSemaphore;
         QNetworkAccessManager* mManager;
         static NetworkAccessManager* sInstance;
+
+        // Constants
+        static const qint64 sMaxCacheSize = 50 * 1024 * 1024; ///< HTTP disk cache size
 };
 
 } // namespace librepcb
@@ -35,7 +35,8 @@ namespace librepcb {
 
 NetworkRequestBase::NetworkRequestBase(const QUrl& url) noexcept :
     mUrl(url), mExpectedContentSize(-1), mStarted(false), mAborted(false),
-    mErrored(false), mFinished(false)
+    mErrored(false), mFinished(false), mResumeOffset(-1), mResumeConfirmed(false),
+    mResumeAttempts(0)
 {
     Q_ASSERT(QThread::currentThread() != NetworkAccessManager::instance());
 
@@ -126,6 +127,24 @@ void NetworkRequestBase::executeRequest() noexcept
         return;
     }
 
+    // request the whole content (i.e. don't resume a previous request)
+    mResumeOffset = -1;
+    mRequest.setRawHeader("Range", QByteArray()); // remove header
+    mRequest.setRawHeader("If-Range", QByteArray()); // remove header
+    sendRequest();
+}
+
+void NetworkRequestBase::sendRequest() noexcept
+{
+    Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
+
+    // get network access manager object
+    NetworkAccessManager* nam = NetworkAccessManager::instance();
+    if (!nam) {
+        finalize(tr("Network access manager is not running."));
+        return;
+    }
+
     // start request
     mRequest.setUrl(mUrl);
     mReply.reset(nam->get(mRequest));
@@ -150,12 +169,33 @@ void NetworkRequestBase::executeRequest() noexcept
 void NetworkRequestBase::replyReadyReadSlot() noexcept
 {
     Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
+    if ((mResumeOffset >= 0) && (!mResumeConfirmed)) {
+        // if the server sends the whole content instead of the requested range (e.g.
+        // because the content was modified), start again from scratch
+        int status = mReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status != 206) {
+            qDebug() << "Server does not resume the request, restart it:" << mUrl.toString();
+            try {
+                prepareRequest(); // can throw
+            } catch (const Exception& e) {
+                mErrored = true;
+                mReply->abort();
+                finalize(e.getMsg());
+                return;
+            }
+            mResumeOffset = -1;
+        }
+        mResumeConfirmed = true;
+    }
     fetchNewData();
 }
 
 void NetworkRequestBase::replyErrorSlot(QNetworkReply::NetworkError code) noexcept
 {
     Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
+    if (resumeRequest(code)) {
+        return;
+    }
     mErrored = true;
     finalize(QString(tr("%1 (%2)")).arg(mReply->errorString()).arg(code));
 }
@@ -175,6 +215,10 @@ void NetworkRequestBase::replyDownloadProgressSlot(qint64 bytesReceived, qint64
     if (mAborted || mErrored || mFinished) return;
     if (mReply->attribute(QNetworkRequest::RedirectionTargetAttribute).isValid()) return;
 
+    if (mResumeOffset > 0) {
+        bytesReceived += mResumeOffset;
+        if (bytesTotal > 0) bytesTotal += mResumeOffset;
+    }
     qint64 estimatedTotal = (bytesTotal > 0) ? bytesTotal : mExpectedContentSize;
     if (estimatedTotal < bytesReceived) {estimatedTotal = bytesReceived + 10e6;}
     int estimatedPercent = (100 * bytesReceived) / qMax(estimatedTotal, qint64(1));
@@ -226,6 +270,10 @@ void NetworkRequestBase::replyFinishedSlot() noexcept
         return;
     }
 
+    if (mReply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+        qDebug() << "Request served from cache:" << mUrl.toString();
+    }
+
     // finalize download
     try {
         finalizeRequest(); // can throw
@@ -238,6 +286,47 @@ void NetworkRequestBase::replyFinishedSlot() noexcept
     finalize();
 }
 
+bool NetworkRequestBase::resumeRequest(QNetworkReply::NetworkError code) noexcept
+{
+    Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
+
+    // only temporary errors are worth to retry
+    switch (code) {
+        case QNetworkReply::RemoteHostClosedError:
+        case QNetworkReply::TimeoutError:
+        case QNetworkReply::TemporaryNetworkFailureError:
+        case QNetworkReply::NetworkSessionFailedError:
+        case QNetworkReply::UnknownNetworkError:
+            break;
+        default:
+            return false;
+    }
+    if (mAborted || mFinished || (mResumeAttempts >= sMaxResumeAttempts)) {
+        return false;
+    }
+
+    // a range request is only safe if the server can tell whether the content was
+    // modified in the meantime
+    qint64 offset = getResumableSize();
+    QByteArray validator = mReply->rawHeader("ETag");
+    if (validator.isEmpty()) validator = mReply->rawHeader("Last-Modified");
+    if ((offset <= 0) || validator.isEmpty()) {
+        return false;
+    }
+
+    mResumeAttempts++;
+    qDebug() << "Resume interrupted request at" << offset << "bytes:" << mUrl.toString();
+    emit progressState(tr("Connection lost, resume request..."));
+    mReply->disconnect(this); // ignore the finished() signal of the interrupted reply
+    mReply.take()->deleteLater();
+    mResumeOffset = offset;
+    mResumeConfirmed = false;
+    mRequest.setRawHeader("Range", QByteArray("bytes=") + QByteArray::number(offset) + "-");
+    mRequest.setRawHeader("If-Range", validator);
+    sendRequest();
+    return true;
+}
+
 void NetworkRequestBase::finalize(const QString& errorMsg) noexcept
 {
     Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
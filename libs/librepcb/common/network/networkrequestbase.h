@@ -44,6 +44,13 @@ namespace librepcb {
  * signals of that class to track the progress of the request. Then you need to call
  * #start() to start the request processing.
  *
+ * Responses are cached by the librepcb::NetworkAccessManager according to their HTTP
+ * headers, and cached responses are revalidated with conditional requests (ETag,
+ * If-Modified-Since). If a request is interrupted by a temporary network error after
+ * some data was received, it is resumed with a HTTP range request (up to
+ * #sMaxResumeAttempts times) if the derived class supports it (see
+ * #getResumableSize()) and the server provides a validator (ETag or Last-Modified).
+ *
  * @note    You need to ensure that an instance of librepcb::NetworkAccessManager exists
  *          while starting a new network request. Otherwise the request will fail. Read
  *          the documentation of librepcb::NetworkAccessManager for more information.
@@ -181,10 +188,20 @@ class NetworkRequestBase : public QObject
         virtual void emitSuccessfullyFinishedSignals() noexcept = 0;
         virtual void fetchNewData() noexcept = 0;
 
+        /**
+         * @brief Get the number of received bytes which don't need to be requested again
+         *
+         * @return The size of the already received content, or -1 if the request
+         *         can't be resumed (default)
+         */
+        virtual qint64 getResumableSize() const noexcept {return -1;}
+
 
     private: // Methods
 
         void executeRequest() noexcept;
+        void sendRequest() noexcept;
+        bool resumeRequest(QNetworkReply::NetworkError code) noexcept;
         void replyReadyReadSlot() noexcept;
         void replyErrorSlot(QNetworkReply::NetworkError code) noexcept;
         void replySslErrorsSlot(const QList<QSslError>& errors) noexcept;
@@ -208,6 +225,12 @@ class NetworkRequestBase : public QObject
         bool mAborted;
         bool mErrored;
         bool mFinished;
+        qint64 mResumeOffset; ///< offset of the current (resumed) request, -1 if not resumed
+        bool mResumeConfirmed; ///< whether the server responded with partial content
+        int mResumeAttempts;
+
+        // Constants
+        static const int sMaxResumeAttempts = 5;
 };
 
 /*****************************************************************************************
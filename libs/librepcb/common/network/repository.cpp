@@ -34,17 +34,20 @@ namespace librepcb {
  ****************************************************************************************/
 
 Repository::Repository(const Repository& other) noexcept :
-    QObject(nullptr), mUrl(other.mUrl)
+    QObject(nullptr), mUrl(other.mUrl), mLibraryListRequestId(0), mPendingLibraryListPages(0),
+    mLibraryListErrored(false)
 {
 }
 
 Repository::Repository(const QUrl& url) noexcept :
-    QObject(nullptr), mUrl(url)
+    QObject(nullptr), mUrl(url), mLibraryListRequestId(0), mPendingLibraryListPages(0),
+    mLibraryListErrored(false)
 {
 }
 
 Repository::Repository(const DomElement& domElement) :
-    QObject(nullptr), mUrl()
+    QObject(nullptr), mUrl(), mLibraryListRequestId(0), mPendingLibraryListPages(0),
+    mLibraryListErrored(false)
 {
     mUrl = domElement.getAttribute<QUrl>("url", true); // can throw
 }
@@ -61,6 +64,7 @@ bool Repository::setUrl(const QUrl& url) noexcept
 {
     if (url.isValid()) {
         mUrl = url;
+        mCachedLibraryList = QJsonArray();
         return true;
     } else {
         return false;
@@ -71,9 +75,19 @@ bool Repository::setUrl(const QUrl& url) noexcept
  *  General Methods
  ****************************************************************************************/
 
-void Repository::requestLibraryList() const noexcept
+void Repository::requestLibraryList() noexcept
 {
-    requestLibraryList(QUrl(mUrl.toString() % "/api/v1/libraries"));
+    mLibraryListRequestId++; // responses of a still running request will be ignored
+    mPendingLibraryListPages = 0;
+    mLibraryListErrored = false;
+    mReceivedLibraryList = QJsonArray();
+
+    if ((!mCachedLibraryList.isEmpty()) && (mCachedLibraryListTimestamp.secsTo(
+            QDateTime::currentDateTimeUtc()) < sLibraryListCacheLifetimeSeconds)) {
+        emit libraryListReceived(mCachedLibraryList);
+    } else {
+        requestLibraryListPage(QUrl(mUrl.toString() % "/api/v1/libraries"), true, true);
+    }
 }
 
 void Repository::serialize(DomElement& root) const
@@ -87,42 +101,138 @@ void Repository::serialize(DomElement& root) const
  *  Private Methods
  ****************************************************************************************/
 
-void Repository::requestLibraryList(const QUrl& url) const noexcept
+void Repository::requestLibraryListPage(const QUrl& url, bool isFirstPage,
+                                        bool followNextPage) noexcept
 {
+    int requestId = mLibraryListRequestId;
     NetworkRequest* request = new NetworkRequest(url);
     request->setHeaderField("Accept", "application/json;charset=UTF-8");
     request->setHeaderField("Accept-Charset", "UTF-8");
     connect(request, &NetworkRequest::errored,
-            this, &Repository::errorWhileFetchingLibraryList, Qt::QueuedConnection);
+            this, [this, requestId](const QString& errorMsg){
+                libraryListPageErrored(requestId, errorMsg);}, Qt::QueuedConnection);
     connect(request, &NetworkRequest::dataReceived,
-            this, &Repository::requestedDataReceived, Qt::QueuedConnection);
+            this, [this, requestId, isFirstPage, followNextPage](const QByteArray& data){
+                libraryListPageReceived(requestId, isFirstPage, followNextPage, data);},
+            Qt::QueuedConnection);
+    mPendingLibraryListPages++;
     request->start();
 }
 
-void Repository::requestedDataReceived(const QByteArray& data) noexcept
+void Repository::libraryListPageReceived(int requestId, bool isFirstPage,
+                                         bool followNextPage, const QByteArray& data) noexcept
 {
+    if (requestId != mLibraryListRequestId) return; // outdated request
+
     QJsonDocument doc = QJsonDocument::fromJson(data);
     if (doc.isNull() || doc.isEmpty() || (!doc.isObject())) {
-        emit errorWhileFetchingLibraryList(tr("Received JSON object is not valid."));
+        libraryListPageErrored(requestId, tr("Received JSON object is not valid."));
         return;
     }
+    QJsonValue reposVal = doc.object().value("results");
+    if ((reposVal.isNull()) || (!reposVal.isArray())) {
+        libraryListPageErrored(requestId, tr("Received JSON object does not contain "
+                                             "any results."));
+        return;
+    }
+    QJsonArray libs = reposVal.toArray();
+
+    // request the following pages before processing this one
     QJsonValue nextResultsLink = doc.object().value("next");
-    if (nextResultsLink.isString()) {
+    if (followNextPage && nextResultsLink.isString()) {
         QUrl url = QUrl(nextResultsLink.toString());
-        if (url.isValid()) {
-            qDebug() << "Request more results from repository:" << url.toString();
-            requestLibraryList(url);
-        } else {
+        QUrlQuery query(url);
+        bool pageValid = false;
+        int nextPage = query.queryItemValue("page").toInt(&pageValid);
+        int count = doc.object().value("count").toInt(-1);
+        if (!url.isValid()) {
             qWarning() << "Invalid URL in received JSON object:" << nextResultsLink.toString();
+        } else if (isFirstPage && pageValid && (nextPage == 2) && (count > 0) && (!libs.isEmpty())) {
+            // the total count is known, so request all remaining pages concurrently
+            int pages = (count + libs.count() - 1) / libs.count();
+            qDebug() << "Request" << pages - 1 << "more pages from repository:" << mUrl.toString();
+            for (int page = 2; page <= pages; ++page) {
+                query.removeAllQueryItems("page");
+                query.addQueryItem("page", QString::number(page));
+                url.setQuery(query);
+                requestLibraryListPage(url, false, false);
+            }
+        } else {
+            qDebug() << "Request more results from repository:" << url.toString();
+            requestLibraryListPage(url, false, true);
         }
     }
-    QJsonValue reposVal = doc.object().value("results");
-    if ((reposVal.isNull()) || (!reposVal.isArray())) {
-        emit errorWhileFetchingLibraryList(tr("Received JSON object does not contain "
-                                              "any results."));
-        return;
+
+    foreach (const QJsonValue& lib, libs) {
+        mReceivedLibraryList.append(lib);
+    }
+    emit libraryListReceived(libs);
+    libraryListPageFinished();
+}
+
+void Repository::libraryListPageErrored(int requestId, const QString& errorMsg) noexcept
+{
+    if (requestId != mLibraryListRequestId) return; // outdated request
+    mLibraryListErrored = true;
+    emit errorWhileFetchingLibraryList(errorMsg);
+    libraryListPageFinished();
+}
+
+void Repository::libraryListPageFinished() noexcept
+{
+    Q_ASSERT(mPendingLibraryListPages > 0);
+    mPendingLibraryListPages--;
+    if ((mPendingLibraryListPages == 0) && (!mLibraryListErrored)) {
+        // all pages received, cache the combined list
+        mCachedLibraryList = mReceivedLibraryList;
+        mCachedLibraryListTimestamp = QDateTime::currentDateTimeUtc();
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+Repository::LibraryManifest Repository::parseLibraryManifest(const QByteArray& json)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(json);
+    if (doc.isNull() || (!doc.isObject())) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Received JSON object is not valid."));
+    }
+    QJsonObject obj = doc.object();
+    QJsonValue elementsVal = obj.value("elements");
+    if (!elementsVal.isArray()) {
+        throw RuntimeError(__FILE__, __LINE__,
+                           tr("Received library manifest does not contain any elements."));
+    }
+
+    LibraryManifest manifest;
+    manifest.metadataZipUrl = QUrl(obj.value("metadata_zip_url").toString());
+    manifest.metadataZipSha256 = QByteArray::fromHex(
+        obj.value("metadata_zip_sha256").toString().toUtf8());
+    if (!manifest.metadataZipUrl.isValid()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("Received library manifest does not contain the library metadata."));
+    }
+    QStringList validTypes = {"cmpcat", "pkgcat", "sym", "pkg", "cmp", "dev"};
+    foreach (const QJsonValue& value, elementsVal.toArray()) {
+        QJsonObject elementObj = value.toObject();
+        LibraryManifestElement element;
+        element.type = elementObj.value("type").toString();
+        element.uuid = Uuid(elementObj.value("uuid").toString());
+        element.version = Version(elementObj.value("version").toString());
+        element.zipUrl = QUrl(elementObj.value("zip_url").toString());
+        element.zipSha256 = QByteArray::fromHex(
+            elementObj.value("zip_sha256").toString().toUtf8());
+        if ((!validTypes.contains(element.type)) || element.uuid.isNull()
+            || (!element.version.isValid()) || (!element.zipUrl.isValid())) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid element in "
+                "received library manifest: %1")).arg(QString(QJsonDocument(elementObj)
+                .toJson(QJsonDocument::Compact))));
+        }
+        manifest.elements.append(element);
     }
-    emit libraryListReceived(reposVal.toArray());
+    return manifest;
 }
 
 bool Repository::checkAttributesValidity() const noexcept
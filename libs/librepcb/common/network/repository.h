@@ -25,6 +25,8 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "../fileio/serializableobject.h"
+#include "../uuid.h"
+#include "../version.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -38,6 +40,22 @@ namespace librepcb {
 /**
  * @brief The Repository class provides access to a LibrePCB API server
  *
+ * Besides the list of libraries, a server may provide a manifest for every library
+ * (URL in the field "manifest_url" of the library list entries). The manifest lists all
+ * elements of the library, so updating an installed library only requires to download
+ * the elements which were added or modified (see #parseLibraryManifest()):
+ *
+ * @code
+ * {
+ *   "metadata_zip_url": "...",     // ZIP with the files of the library root directory
+ *   "metadata_zip_sha256": "...",
+ *   "elements": [
+ *     {"type": "sym", "uuid": "...", "version": "0.1", "zip_url": "...", "zip_sha256": "..."},
+ *     ...
+ *   ]
+ * }
+ * @endcode
+ *
  * @author ubruhin
  * @date 2016-08-10
  */
@@ -47,6 +65,24 @@ class Repository final : public QObject, public SerializableObject
 
     public:
 
+        // Types
+
+        /// An element entry of a library manifest
+        struct LibraryManifestElement {
+            QString type;           ///< element type directory name, e.g. "sym"
+            Uuid uuid;
+            Version version;
+            QUrl zipUrl;            ///< ZIP file containing the element directory
+            QByteArray zipSha256;   ///< SHA-256 of the ZIP file (may be empty)
+        };
+
+        /// The manifest of a library (see class description)
+        struct LibraryManifest {
+            QUrl metadataZipUrl;
+            QByteArray metadataZipSha256;
+            QList<LibraryManifestElement> elements;
+        };
+
         // Constructors / Destructor
         Repository() = delete;
         explicit Repository(const Repository& other) noexcept;
@@ -62,7 +98,17 @@ class Repository final : public QObject, public SerializableObject
         bool setUrl(const QUrl& url) noexcept;
 
         // General Methods
-        void requestLibraryList() const noexcept;
+
+        /**
+         * @brief Request the list of libraries from the server
+         *
+         * The list is emitted page by page with #libraryListReceived() as soon as each
+         * page arrives. If the server provides the total count of libraries, all the
+         * following pages are requested concurrently once the first page is received.
+         * The combined list is cached for a few minutes, so subsequent requests are
+         * answered immediately (and synchronously) without any network access.
+         */
+        void requestLibraryList() noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
@@ -70,6 +116,19 @@ class Repository final : public QObject, public SerializableObject
         // Operators
         Repository& operator=(const Repository& rhs) = delete;
 
+        // Static Methods
+
+        /**
+         * @brief Parse a library manifest received from an API server
+         *
+         * @param json      The received JSON document
+         *
+         * @return The parsed manifest
+         *
+         * @throw RuntimeError If the manifest is invalid.
+         */
+        static LibraryManifest parseLibraryManifest(const QByteArray& json);
+
 
     signals:
 
@@ -79,14 +138,27 @@ class Repository final : public QObject, public SerializableObject
 
     private: // Methods
 
-        void requestLibraryList(const QUrl& url) const noexcept;
-        void requestedDataReceived(const QByteArray& data) noexcept;
+        void requestLibraryListPage(const QUrl& url, bool isFirstPage,
+                                    bool followNextPage) noexcept;
+        void libraryListPageReceived(int requestId, bool isFirstPage, bool followNextPage,
+                                     const QByteArray& data) noexcept;
+        void libraryListPageErrored(int requestId, const QString& errorMsg) noexcept;
+        void libraryListPageFinished() noexcept;
         bool checkAttributesValidity() const noexcept;
 
 
     private: // Data
 
         QUrl mUrl;
+
+        // Library list requests
+        int mLibraryListRequestId;      ///< to ignore responses of outdated requests
+        int mPendingLibraryListPages;
+        bool mLibraryListErrored;
+        QJsonArray mReceivedLibraryList;
+        QJsonArray mCachedLibraryList;
+        QDateTime mCachedLibraryListTimestamp;
+        static constexpr int sLibraryListCacheLifetimeSeconds = 300;
 };
 
 /*****************************************************************************************
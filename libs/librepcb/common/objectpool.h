@@ -0,0 +1,259 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_OBJECTPOOL_H
+#define LIBREPCB_OBJECTPOOL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <new>
+#include <type_traits>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class ObjectPool
+ ****************************************************************************************/
+
+/**
+ * @brief A pool of memory blocks for objects of the same type, with one free list per
+ *        thread
+ *
+ * The memory is allocated in chunks of @p BlocksPerChunk objects, and deallocated blocks
+ * are reused for the next allocation instead of being returned to the heap. The chunks
+ * are never released, so the pool only grows up to the maximum count of objects which
+ * existed at the same time. This avoids heap fragmentation for types which are created
+ * and destroyed at a high rate (e.g. while drawing traces in the board editor).
+ *
+ * Each thread allocates from and deallocates to its own free list, so allocations
+ * don't need a lock. Only when the free list of a thread is empty, a mutex is locked to
+ * take over the blocks released by other threads or to allocate a new chunk. When a
+ * thread exits, its free list is released to the other threads. Objects may be deleted
+ * in another thread than they were created in; their block then moves to the free
+ * list of the deleting thread.
+ *
+ * Usually not used directly, but by deriving from librepcb::PooledObject.
+ *
+ * @tparam T                The type of the objects
+ * @tparam BlocksPerChunk   How many objects are allocated at once
+ */
+template <typename T, int BlocksPerChunk = 128>
+class ObjectPool final
+{
+    public:
+
+        // Constructors / Destructor
+        ObjectPool() = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Allocate memory for one object
+         *
+         * @param size      The requested size, if it does not equal sizeof(T) (e.g. for
+         *                  a derived class), the global operator new is used instead
+         *
+         * @return The uninitialized memory
+         *
+         * @throw std::bad_alloc If no memory could be allocated
+         */
+        static void* allocate(std::size_t size) {
+            if (size != sizeof(T)) return ::operator new(size);
+            Block*& freeList = localFreeList();
+            if (!freeList) {
+                if (threadExited()) {
+                    // called during destruction of static objects, don't refill the
+                    // free list of this thread anymore
+                    Block* block = takeSharedBlocks(); // can throw
+                    releaseBlocks(block->next);
+                    shared().usedCount.ref();
+                    return block;
+                }
+                freeList = takeSharedBlocks(); // can throw
+                registerThreadExit();
+            }
+            Block* block = freeList;
+            freeList = block->next;
+            shared().usedCount.ref();
+            return block;
+        }
+
+        /**
+         * @brief Return the memory of an object to the pool
+         *
+         * @param ptr       Memory returned by #allocate() (may be nullptr)
+         * @param size      The same size as passed to #allocate()
+         */
+        static void deallocate(void* ptr, std::size_t size) noexcept {
+            if (!ptr) return;
+            if (size != sizeof(T)) {::operator delete(ptr); return;}
+            Block* block = static_cast<Block*>(ptr);
+            shared().usedCount.deref();
+            if (threadExited()) {
+                block->next = nullptr;
+                releaseBlocks(block);
+                return;
+            }
+            Block*& freeList = localFreeList();
+            if (!freeList) registerThreadExit();
+            block->next = freeList;
+            freeList = block;
+        }
+
+        /**
+         * @brief Get the count of objects which could exist without allocating memory
+         */
+        static int getCapacity() noexcept {
+            return shared().chunkCount.load() * BlocksPerChunk;
+        }
+
+        /**
+         * @brief Get the count of currently allocated objects (of all threads)
+         */
+        static int getUsedCount() noexcept {
+            return shared().usedCount.load();
+        }
+
+
+    private: // Types
+
+        union Block {
+            Block* next;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        };
+
+        /// Blocks which are not owned by any thread, and the statistics of all threads
+        struct Shared {
+            QMutex mutex;
+            Block* freeList = nullptr;  ///< protected by #mutex
+            QAtomicInt chunkCount;
+            QAtomicInt usedCount;
+        };
+
+        /// Releases the free list of a thread when the thread exits
+        struct ThreadExitGuard {
+            ~ThreadExitGuard() noexcept {
+                threadExited() = true;
+                releaseBlocks(localFreeList());
+                localFreeList() = nullptr;
+            }
+        };
+
+
+    private: // Methods
+
+        /// The shared state is never destroyed, so objects can be deleted at any time
+        static Shared& shared() noexcept {
+            static Shared* s = new Shared();
+            return *s;
+        }
+
+        /// Trivial type, so it is still accessible after the thread exit guard ran
+        static Block*& localFreeList() noexcept {
+            thread_local Block* freeList = nullptr;
+            return freeList;
+        }
+
+        /// Trivial type, so it is still accessible after the thread exit guard ran
+        static bool& threadExited() noexcept {
+            thread_local bool exited = false;
+            return exited;
+        }
+
+        static void registerThreadExit() noexcept {
+            thread_local ThreadExitGuard guard; // constructed on the first call only
+            Q_UNUSED(guard);
+        }
+
+        /// Take all shared free blocks, or allocate a new chunk if there are none
+        static Block* takeSharedBlocks() {
+            Shared& s = shared();
+            QMutexLocker locker(&s.mutex);
+            if (Block* blocks = s.freeList) {
+                s.freeList = nullptr;
+                return blocks;
+            }
+            void* memory = ::operator new(BlocksPerChunk * sizeof(Block)); // can throw
+            Block* chunk = static_cast<Block*>(memory);
+            for (int i = 0; i < BlocksPerChunk; ++i) {
+                chunk[i].next = (i < BlocksPerChunk - 1) ? &chunk[i + 1] : nullptr;
+            }
+            s.chunkCount.ref();
+            return chunk;
+        }
+
+        /// Give a list of free blocks to the other threads
+        static void releaseBlocks(Block* blocks) noexcept {
+            if (!blocks) return;
+            Block* last = blocks;
+            while (last->next) last = last->next;
+            Shared& s = shared();
+            QMutexLocker locker(&s.mutex);
+            last->next = s.freeList;
+            s.freeList = blocks;
+        }
+};
+
+/*****************************************************************************************
+ *  Class PooledObject
+ ****************************************************************************************/
+
+/**
+ * @brief Base class to allocate objects of a class in a librepcb::ObjectPool
+ *
+ * Example: `class Foo final : public Bar, public PooledObject<Foo>`
+ *
+ * The class has no data members, so deriving from it does not increase the object size.
+ *
+ * @tparam T    The derived class
+ */
+template <typename T>
+class PooledObject
+{
+    public:
+
+        // Operator Overloadings
+        static void* operator new(std::size_t size) {
+            return ObjectPool<T>::allocate(size);
+        }
+        static void operator delete(void* ptr, std::size_t size) noexcept {
+            ObjectPool<T>::deallocate(ptr, size);
+        }
+
+
+    protected:
+
+        // Constructors / Destructor
+        PooledObject() noexcept {}
+        ~PooledObject() noexcept {}
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_OBJECTPOOL_H
@@ -0,0 +1,135 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_ORDEREDSET_H
+#define LIBREPCB_ORDEREDSET_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class OrderedSet
+ ****************************************************************************************/
+
+/**
+ * @brief A set which remembers the insertion order of its elements
+ *
+ * In contrast to a QList, #contains() and #remove() do not need to scan all elements
+ * (they take O(log n) instead of O(n)), and in contrast to a QSet, the elements are
+ * always iterated in the order they were inserted (which keeps ERC messages, air wires
+ * and so on deterministic).
+ *
+ * #toList() returns a cached QList of all elements, which is only rebuilt after the set
+ * was modified.
+ *
+ * @tparam T    The element type (must be usable as a QHash key, e.g. pointers)
+ */
+template <typename T>
+class OrderedSet final
+{
+    public:
+
+        // Constructors / Destructor
+        OrderedSet() noexcept : mNextSequenceNumber(0), mListValid(true) {}
+        OrderedSet(const OrderedSet<T>& other) = default;
+        ~OrderedSet() noexcept {}
+
+        // Getters
+        bool isEmpty() const noexcept {return mSequenceNumbers.isEmpty();}
+        int count() const noexcept {return mSequenceNumbers.count();}
+        bool contains(const T& value) const noexcept {return mSequenceNumbers.contains(value);}
+
+        /**
+         * @brief Get all elements in the order of their insertion
+         */
+        const QList<T>& toList() const noexcept {
+            if (!mListValid) {
+                mList = mElements.values();
+                mListValid = true;
+            }
+            return mList;
+        }
+
+        // General Methods
+
+        /**
+         * @brief Append an element to the end of the set
+         *
+         * @retval true     If the element was added
+         * @retval false    If the set already contains the element (nothing changed)
+         */
+        bool insert(const T& value) noexcept {
+            if (contains(value)) return false;
+            quint64 number = mNextSequenceNumber++;
+            mSequenceNumbers.insert(value, number);
+            mElements.insert(number, value);
+            mListValid = false;
+            return true;
+        }
+
+        /**
+         * @brief Remove an element from the set
+         *
+         * @retval true     If the element was removed
+         * @retval false    If the set does not contain the element (nothing changed)
+         */
+        bool remove(const T& value) noexcept {
+            auto it = mSequenceNumbers.find(value);
+            if (it == mSequenceNumbers.end()) return false;
+            mElements.remove(it.value());
+            mSequenceNumbers.erase(it);
+            mListValid = false;
+            return true;
+        }
+
+        void clear() noexcept {
+            mSequenceNumbers.clear();
+            mElements.clear();
+            mList.clear();
+            mListValid = true;
+        }
+
+        // Operator Overloadings
+        OrderedSet<T>& operator=(const OrderedSet<T>& rhs) = default;
+
+
+    private: // Data
+        quint64 mNextSequenceNumber;
+        QHash<T, quint64> mSequenceNumbers;  ///< the sequence number of every element
+        QMap<quint64, T> mElements;          ///< all elements, sorted by sequence number
+
+        // Cached Attributes
+        mutable QList<T> mList;
+        mutable bool mListValid;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_ORDEREDSET_H
@@ -29,6 +29,16 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Query Statistics
+ ****************************************************************************************/
+
+// shared by all connections, which may be used from different threads
+static QAtomicInt sQueryStatisticsEnabled(0);
+static QAtomicInt sSlowQueryMs(20);
+static QMutex sQueryStatisticsMutex;
+static QHash<QString, SQLiteDatabase::QueryStatistics> sQueryStatistics;
+
 /*****************************************************************************************
  *  Class TransactionScopeGuard
  ****************************************************************************************/
@@ -60,12 +70,13 @@ SQLiteDatabase::TransactionScopeGuard::~TransactionScopeGuard() noexcept
  *  Constructors / Destructor
  ****************************************************************************************/
 
-SQLiteDatabase::SQLiteDatabase(const FilePath& filepath) :
+SQLiteDatabase::SQLiteDatabase(const FilePath& filepath, bool readOnly) :
     QObject(nullptr)//, mNestedTransactionCount(0)
 {
     // create database (use random UUID as connection name)
     mDb = QSqlDatabase::addDatabase("QSQLITE", Uuid::createRandom().toStr());
     mDb.setDatabaseName(filepath.toStr());
+    if (readOnly) mDb.setConnectOptions("QSQLITE_OPEN_READONLY");
 
     // check if database is valid
     if (!mDb.isValid()) {
@@ -81,7 +92,10 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath) :
 
     // set SQLite options
     exec("PRAGMA foreign_keys = ON"); // can throw
-    enableSqliteWriteAheadLogging(); // can throw
+    if (!readOnly) {
+        // the journal mode is persistent, i.e. also used by read-only connections
+        enableSqliteWriteAheadLogging(); // can throw
+    }
 
     // check if all required features are available
     Q_ASSERT(mDb.driver() && mDb.driver()->hasFeature(QSqlDriver::Transactions));
@@ -92,6 +106,7 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath) :
 
 SQLiteDatabase::~SQLiteDatabase() noexcept
 {
+    clearQueryCache(); // release all prepared statements before closing the database
     mDb.close();
 }
 
@@ -162,6 +177,22 @@ QSqlQuery SQLiteDatabase::prepareQuery(const QString& query) const
     return q;
 }
 
+QSqlQuery& SQLiteDatabase::getCachedQuery(const QString& query)
+{
+    auto it = mQueryCache.find(query);
+    if (it == mQueryCache.end()) {
+        it = mQueryCache.insert(query, prepareQuery(query)); // can throw
+    } else {
+        it.value().finish(); // reset the statement, e.g. if a SELECT was not fully read
+    }
+    return it.value();
+}
+
+void SQLiteDatabase::clearQueryCache() noexcept
+{
+    mQueryCache.clear();
+}
+
 int SQLiteDatabase::insert(QSqlQuery& query)
 {
     exec(query); // can throw
@@ -178,7 +209,12 @@ int SQLiteDatabase::insert(QSqlQuery& query)
 
 void SQLiteDatabase::exec(QSqlQuery& query)
 {
-    if (!query.exec()) {
+    QElapsedTimer timer;
+    bool recordStatistics = isQueryStatisticsEnabled();
+    if (recordStatistics) timer.start();
+    bool success = query.exec();
+    if (recordStatistics) recordQueryStatistics(query, timer.nsecsElapsed());
+    if (!success) {
         qDebug() << query.lastError().databaseText();
         qDebug() << query.lastError().driverText();
         throw RuntimeError(__FILE__, __LINE__,
@@ -192,6 +228,65 @@ void SQLiteDatabase::exec(const QString& query)
     exec(q);
 }
 
+void SQLiteDatabase::execBatch(QSqlQuery& query)
+{
+    QElapsedTimer timer;
+    bool recordStatistics = isQueryStatisticsEnabled();
+    if (recordStatistics) timer.start();
+    bool success = query.execBatch();
+    if (recordStatistics) recordQueryStatistics(query, timer.nsecsElapsed());
+    if (!success) {
+        qDebug() << query.lastError().databaseText();
+        qDebug() << query.lastError().driverText();
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Error while executing SQL query: %1")).arg(query.lastQuery()));
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+void SQLiteDatabase::setQueryStatisticsEnabled(bool enabled, int slowQueryMs) noexcept
+{
+    sSlowQueryMs.store(slowQueryMs);
+    sQueryStatisticsEnabled.store(enabled ? 1 : 0);
+}
+
+bool SQLiteDatabase::isQueryStatisticsEnabled() noexcept
+{
+    return sQueryStatisticsEnabled.load() != 0;
+}
+
+QList<SQLiteDatabase::QueryStatistics> SQLiteDatabase::getQueryStatistics() noexcept
+{
+    QList<QueryStatistics> statistics;
+    {
+        QMutexLocker locker(&sQueryStatisticsMutex);
+        statistics = sQueryStatistics.values();
+    }
+    std::sort(statistics.begin(), statistics.end(),
+        [](const QueryStatistics& a, const QueryStatistics& b){return a.totalNs > b.totalNs;});
+    return statistics;
+}
+
+QString SQLiteDatabase::getQueryStatisticsReport() noexcept
+{
+    QStringList lines;
+    foreach (const QueryStatistics& s, getQueryStatistics()) {
+        lines.append(QString("%1 ms total, %2 ms max, %3x: %4")
+            .arg(s.totalNs / 1000000.0, 0, 'f', 3).arg(s.maxNs / 1000000.0, 0, 'f', 3)
+            .arg(s.count).arg(s.query.simplified()));
+    }
+    return lines.join("\n");
+}
+
+void SQLiteDatabase::clearQueryStatistics() noexcept
+{
+    QMutexLocker locker(&sQueryStatisticsMutex);
+    sQueryStatistics.clear();
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -222,6 +317,53 @@ QHash<QString, QString> SQLiteDatabase::getSqliteCompileOptions()
     return options;
 }
 
+void SQLiteDatabase::recordQueryStatistics(const QSqlQuery& query, qint64 ns) noexcept
+{
+    QString sql = query.lastQuery();
+    {
+        QMutexLocker locker(&sQueryStatisticsMutex);
+        auto it = sQueryStatistics.find(sql);
+        if (it == sQueryStatistics.end()) {
+            it = sQueryStatistics.insert(sql, QueryStatistics{sql, 0, 0, 0});
+        }
+        it->count++;
+        it->totalNs += ns;
+        it->maxNs = qMax(it->maxNs, ns);
+    }
+
+    if (ns >= static_cast<qint64>(sSlowQueryMs.load()) * 1000000) {
+        qWarning().nospace() << "Slow SQL query (" << (ns / 1000000) << " ms): "
+                             << sql.simplified();
+        foreach (const QString& line, getQueryPlan(query)) {
+            qWarning() << "  Query plan:" << line;
+        }
+    }
+}
+
+QStringList SQLiteDatabase::getQueryPlan(const QSqlQuery& query) noexcept
+{
+    // executed directly (not with exec()) to not record statistics of it
+    QStringList lines;
+    QSqlQuery explain(mDb);
+    if (!explain.prepare("EXPLAIN QUERY PLAN " % query.lastQuery())) {
+        return lines; // e.g. PRAGMA statements can't be explained
+    }
+    for (int i = 0; i < query.boundValues().count(); ++i) {
+        QVariant value = query.boundValue(i);
+        if (value.type() == QVariant::List) {
+            value = value.toList().value(0); // see execBatch()
+        }
+        explain.bindValue(i, value);
+    }
+    if (explain.exec()) {
+        int detailColumn = explain.record().indexOf("detail");
+        while (explain.next() && (detailColumn >= 0)) {
+            lines.append(explain.value(detailColumn).toString());
+        }
+    }
+    return lines;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -64,11 +64,36 @@ class SQLiteDatabase final : public QObject
                 bool mIsCommited;
         };
 
+        /**
+         * @brief Execution statistics of a single SQL statement
+         *
+         * @see #getQueryStatistics()
+         */
+        struct QueryStatistics {
+            QString query;      ///< the SQL query string (without bound values)
+            int count;          ///< how often the query was executed
+            qint64 totalNs;     ///< cumulative execution duration [ns]
+            qint64 maxNs;       ///< longest execution duration [ns]
+        };
+
 
         // Constructors / Destructor
         SQLiteDatabase() = delete;
         SQLiteDatabase(const SQLiteDatabase& other) = delete;
-        SQLiteDatabase(const FilePath& filepath);
+
+        /**
+         * @brief Open a database
+         *
+         * @param filepath  The database file (created if it does not exist, except for
+         *                  read-only connections)
+         * @param readOnly  If true, the connection is opened in read-only mode. This is
+         *                  useful to query the database from worker threads while another
+         *                  connection is writing to it (requires Write-Ahead Logging to be
+         *                  enabled by the writing connection).
+         *
+         * @throw Exception If the database could not be opened.
+         */
+        SQLiteDatabase(const FilePath& filepath, bool readOnly = false);
         ~SQLiteDatabase() noexcept;
 
 
@@ -81,15 +106,83 @@ class SQLiteDatabase final : public QObject
 
         // General Methods
         QSqlQuery prepareQuery(const QString& query) const;
+
+        /**
+         * @brief Get a prepared query from the statement cache
+         *
+         * The query is prepared only on the first call with a particular query string.
+         * Subsequent calls return the same, already prepared query object, so only the
+         * values need to be bound again before executing it. This avoids the overhead of
+         * preparing the same statement again and again (e.g. for many inserts).
+         *
+         * @param query     The SQL query string
+         *
+         * @return A reference to the cached query (valid until #clearQueryCache() is
+         *         called or this object is destroyed)
+         *
+         * @throw Exception If the query could not be prepared.
+         */
+        QSqlQuery& getCachedQuery(const QString& query);
+
+        /**
+         * @brief Remove all queries from the statement cache (see #getCachedQuery())
+         */
+        void clearQueryCache() noexcept;
+
         int insert(QSqlQuery& query);
         void exec(QSqlQuery& query);
         void exec(const QString& query);
 
+        /**
+         * @brief Execute a query once for every element of the bound value lists
+         *
+         * This allows to insert a lot of rows with a single prepared statement. All
+         * bound values have to be a QVariantList of the same length.
+         *
+         * @param query     The prepared query with QVariantList values bound
+         *
+         * @throw Exception If the query could not be executed.
+         *
+         * @see QSqlQuery::execBatch()
+         */
+        void execBatch(QSqlQuery& query);
+
 
         // Operator Overloadings
         SQLiteDatabase& operator=(const SQLiteDatabase& rhs) = delete;
 
 
+        // Static Methods
+
+        /**
+         * @brief Enable or disable recording of query statistics (disabled by default)
+         *
+         * If enabled, #exec(), #insert() and #execBatch() measure the execution
+         * duration of every query of all database connections. Queries which take
+         * longer than the slow query threshold are logged together with their
+         * "EXPLAIN QUERY PLAN" output, which is useful to find missing indexes.
+         *
+         * @param enabled       Whether statistics should be recorded or not
+         * @param slowQueryMs   The threshold for logging slow queries [ms]
+         */
+        static void setQueryStatisticsEnabled(bool enabled, int slowQueryMs = 20) noexcept;
+        static bool isQueryStatisticsEnabled() noexcept;
+
+        /**
+         * @brief Get the recorded statistics of all queries
+         *
+         * @return The statistics, sorted by cumulative duration (longest first)
+         */
+        static QList<QueryStatistics> getQueryStatistics() noexcept;
+
+        /**
+         * @brief Format the recorded statistics as text, one line per query
+         */
+        static QString getQueryStatisticsReport() noexcept;
+
+        static void clearQueryStatistics() noexcept;
+
+
     private: // Methods
 
         /**
@@ -112,10 +205,20 @@ class SQLiteDatabase final : public QObject
          */
         QHash<QString, QString> getSqliteCompileOptions();
 
+        /**
+         * @brief Add a measured execution to the query statistics
+         *
+         * If the duration exceeds the slow query threshold, the query is logged
+         * together with its query plan.
+         */
+        void recordQueryStatistics(const QSqlQuery& query, qint64 ns) noexcept;
+        QStringList getQueryPlan(const QSqlQuery& query) noexcept;
+
 
     private: // Data
 
         QSqlDatabase mDb;
+        QHash<QString, QSqlQuery> mQueryCache; ///< see #getCachedQuery()
         //int mNestedTransactionCount;
 };
 
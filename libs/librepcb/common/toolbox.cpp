@@ -51,6 +51,54 @@ QPainterPath Toolbox::shapeFromPath(const QPainterPath &path, const QPen &pen) n
     }
 }
 
+bool Toolbox::naturalLessThan(const QString& a, const QString& b) noexcept
+{
+    int i = 0, j = 0;
+    while ((i < a.length()) && (j < b.length())) {
+        if (a.at(i).isDigit() && b.at(j).isDigit()) {
+            // skip leading zeros, then the longer number is the greater one
+            while ((i < a.length() - 1) && (a.at(i) == '0') && a.at(i + 1).isDigit()) ++i;
+            while ((j < b.length() - 1) && (b.at(j) == '0') && b.at(j + 1).isDigit()) ++j;
+            int startA = i, startB = j;
+            while ((i < a.length()) && a.at(i).isDigit()) ++i;
+            while ((j < b.length()) && b.at(j).isDigit()) ++j;
+            if ((i - startA) != (j - startB)) {
+                return (i - startA) < (j - startB);
+            }
+            int result = a.midRef(startA, i - startA).compare(b.midRef(startB, j - startB));
+            if (result != 0) {
+                return result < 0;
+            }
+        } else {
+            QChar charA = a.at(i).toLower(), charB = b.at(j).toLower();
+            if (charA != charB) {
+                return charA < charB;
+            }
+            ++i;
+            ++j;
+        }
+    }
+    if ((a.length() - i) != (b.length() - j)) {
+        return (a.length() - i) < (b.length() - j);
+    }
+    return a < b; // equal in natural order (e.g. "r01" and "R1"), but use a stable order
+}
+
+QString Toolbox::toCsvLine(const QStringList& fields) noexcept
+{
+    QStringList escaped;
+    foreach (QString field, fields) {
+        if (field.contains(',') || field.contains('"') || field.contains('\n') ||
+            field.contains('\r'))
+        {
+            field.replace('"', QStringLiteral("\"\""));
+            field = QChar('"') % field % QChar('"');
+        }
+        escaped.append(field);
+    }
+    return escaped.join(',');
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -74,6 +74,26 @@ class Toolbox final
         }
 
         static QPainterPath shapeFromPath(const QPainterPath &path, const QPen &pen) noexcept;
+
+        /**
+         * @brief Compare two strings in "natural" order
+         *
+         * Sequences of digits are compared by their numeric value and all other
+         * characters case insensitive, so "R2" is sorted before "R10". Intended to sort
+         * component names, net names and pad names for humans.
+         *
+         * @retval true     If a is sorted before b
+         * @retval false    If a is sorted after b or both are equal
+         */
+        static bool naturalLessThan(const QString& a, const QString& b) noexcept;
+
+        /**
+         * @brief Convert a list of fields to a line of a CSV file (RFC 4180)
+         *
+         * Fields containing commas, quotes or line breaks are quoted. The returned line
+         * does not contain a trailing line break.
+         */
+        static QString toCsvLine(const QStringList& fields) noexcept;
 };
 
 /*****************************************************************************************
@@ -81,6 +81,19 @@ class UndoCommand
          */
         bool isCurrentlyExecuted() const noexcept {return mRedoCount > mUndoCount;}
 
+        /**
+         * @brief Get the approximate count of bytes allocated by this command
+         *
+         * This is used by librepcb::UndoStack to limit the memory usage of the undo
+         * history (see librepcb::UndoStack::setMemoryLimit()). Commands which keep large
+         * amounts of data should reimplement this method.
+         *
+         * @return The estimated memory usage in bytes
+         */
+        virtual qint64 getApproximateMemoryUsage() const noexcept {
+            return sizeof(UndoCommand) + mText.capacity() * sizeof(QChar);
+        }
+
 
         // General Methods
 
@@ -102,6 +115,24 @@ class UndoCommand
          */
         virtual void redo() final;
 
+        /**
+         * @brief Try to merge a newly executed command into this command
+         *
+         * librepcb::UndoStack calls this method on its topmost command after another
+         * command was executed, to avoid flooding the history with many small steps (e.g.
+         * when moving the same items several times in a row). The default implementation
+         * never merges.
+         *
+         * @param other     The command which was just executed on top of this one. Both
+         *                  commands are currently executed.
+         *
+         * @retval true     If the other command was merged into this one. Then this
+         *                  command has taken the ownership of @p other and #undo() and
+         *                  #redo() will also revert/apply the changes of @p other.
+         * @retval false    If the commands cannot be merged (nothing was changed)
+         */
+        virtual bool mergeWith(UndoCommand* other) noexcept {Q_UNUSED(other); return false;}
+
         // Operator Overloadings
         UndoCommand& operator=(const UndoCommand& rhs) = delete;
 
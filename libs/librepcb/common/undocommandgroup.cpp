@@ -46,6 +46,19 @@ UndoCommandGroup::~UndoCommandGroup() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 UndoCommandGroup::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    foreach (const UndoCommand* cmd, mChilds) {
+        size += cmd->getApproximateMemoryUsage();
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -127,6 +140,13 @@ void UndoCommandGroup::execNewChildCmd(UndoCommand* cmd)
     }
 }
 
+void UndoCommandGroup::appendExecutedChild(UndoCommand* cmd) noexcept
+{
+    Q_ASSERT(cmd && (!mChilds.contains(cmd)));
+    Q_ASSERT(cmd->isCurrentlyExecuted() && isCurrentlyExecuted());
+    mChilds.append(cmd);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
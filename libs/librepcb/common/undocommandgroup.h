@@ -57,6 +57,9 @@ class UndoCommandGroup : public UndoCommand
         // Getters
         int getChildCount() const noexcept {return mChilds.count();}
 
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
         // General Methods
 
         /**
@@ -94,6 +97,15 @@ class UndoCommandGroup : public UndoCommand
          */
         void execNewChildCmd(UndoCommand* cmd);
 
+        /**
+         * @brief Helper method for derived classes to take over an already executed
+         *        command as the last child (used to implement #mergeWith())
+         *
+         * @param cmd       The command to add (must be currently executed, just like this
+         *                  command group)
+         */
+        void appendExecutedChild(UndoCommand* cmd) noexcept;
+
 
     private:
 
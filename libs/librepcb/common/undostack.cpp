@@ -23,6 +23,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include "undostack.h"
+#include "debugtrace.h"
 #include "undocommand.h"
 #include "undocommandgroup.h"
 
@@ -75,7 +76,10 @@ void UndoStackTransaction::commit()
  ****************************************************************************************/
 
 UndoStack::UndoStack() noexcept :
-    QObject(nullptr), mCurrentIndex(0), mCleanIndex(0), mActiveCommandGroup(nullptr)
+    QObject(nullptr), mCurrentIndex(0), mCleanIndex(0), mActiveCommandGroup(nullptr),
+    mMemoryLimit(0), mMemoryUsage(0),
+    mEmittedUndoText(getUndoText()), mEmittedRedoText(getRedoText()),
+    mEmittedCanUndo(false), mEmittedCanRedo(false), mEmittedClean(true)
 {
 }
 
@@ -124,6 +128,11 @@ bool UndoStack::isCommandGroupActive() const noexcept
     return (mActiveCommandGroup != nullptr);
 }
 
+qint64 UndoStack::getApproximateMemoryUsage() const noexcept
+{
+    return mMemoryUsage;
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -134,7 +143,14 @@ void UndoStack::setClean() noexcept
 
     mCleanIndex = mCurrentIndex;
 
-    emit cleanChanged(true);
+    // emit signals
+    emitChangedSignals();
+}
+
+void UndoStack::setMemoryLimit(qint64 bytes) noexcept
+{
+    mMemoryLimit = qMax(bytes, qint64(0));
+    enforceMemoryLimit();
 }
 
 /*****************************************************************************************
@@ -143,6 +159,7 @@ void UndoStack::setClean() noexcept
 
 void UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd)
 {
+    LIBREPCB_TRACE_SCOPE("UndoStack::execCmd");
     // make sure "cmd" is deleted when going out of scope (e.g. because of an exception)
     QScopedPointer<UndoCommand> cmdScopeGuard(cmd);
 
@@ -162,20 +179,29 @@ void UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd)
         // delete all commands above the current index (make redoing them impossible)
         // --> in reverse order (from top to bottom)!
         while (mCurrentIndex < mCommands.count()) {
-            delete mCommands.takeLast();
+            deleteCommand(false);
         }
         Q_ASSERT(mCurrentIndex == mCommands.count());
 
-        // add command to the command stack
-        mCommands.append(cmdScopeGuard.take()); // move ownership of "cmd" to "mCommands"
-        mCurrentIndex++;
+        // merge the command into the topmost one if possible, otherwise add it to the
+        // command stack
+        if ((!forceKeepCmd) && (mCurrentIndex > 0) && (mCleanIndex != mCurrentIndex)
+            && (mCommands.last()->mergeWith(cmd)))
+        {
+            cmdScopeGuard.take(); // ownership was moved to the topmost command
+            updateMemoryUsageOfLastCommand();
+        } else {
+            appendCommand(cmdScopeGuard.take()); // move ownership of "cmd" to "mCommands"
+            mCurrentIndex++;
+        }
+
+        // release memory of old commands if required
+        if (!isCommandGroupActive()) {
+            enforceMemoryLimit();
+        }
 
         // emit signals
-        emit undoTextChanged(QString(tr("Undo: %1")).arg(cmd->getText()));
-        emit redoTextChanged(tr("Redo"));
-        emit canUndoChanged(true);
-        emit canRedoChanged(false);
-        emit cleanChanged(false);
+        emitChangedSignals();
         emit stateModified();
     } else {
         // the command has done nothing, so we will just discard it
@@ -196,7 +222,7 @@ void UndoStack::beginCmdGroup(const QString& text)
     mActiveCommandGroup = cmd;
 
     // emit signals
-    emit canUndoChanged(false);
+    emitChangedSignals();
 }
 
 void UndoStack::appendToCmdGroup(UndoCommand* cmd)
@@ -236,8 +262,12 @@ void UndoStack::commitCmdGroup()
     // currently active command group
     mActiveCommandGroup = nullptr;
 
+    // release memory of old commands if required
+    updateMemoryUsageOfLastCommand();
+    enforceMemoryLimit();
+
     // emit signals
-    emit canUndoChanged(canUndo());
+    emitChangedSignals();
     emit commandGroupEnded();
 }
 
@@ -254,18 +284,14 @@ void UndoStack::abortCmdGroup()
         mActiveCommandGroup->undo(); // can throw (but should usually not)
         mActiveCommandGroup = nullptr;
         mCurrentIndex--;
-        delete mCommands.takeLast(); // delete and remove the aborted command group from the stack
+        deleteCommand(false); // delete and remove the aborted command group from the stack
     } catch (Exception& e) {
         qCritical() << "UndoCommand::undo() has thrown an exception:" << e.getMsg();
         throw;
     }
 
     // emit signals
-    emit undoTextChanged(getUndoText());
-    emit redoTextChanged(tr("Redo"));
-    emit canUndoChanged(canUndo());
-    emit canRedoChanged(false);
-    emit cleanChanged(isClean());
+    emitChangedSignals();
     emit commandGroupAborted(); // this is important!
     emit stateModified();
 }
@@ -285,11 +311,7 @@ void UndoStack::undo()
     }
 
     // emit signals
-    emit undoTextChanged(getUndoText());
-    emit redoTextChanged(getRedoText());
-    emit canUndoChanged(canUndo());
-    emit canRedoChanged(canRedo());
-    emit cleanChanged(isClean());
+    emitChangedSignals();
     emit stateModified();
 }
 
@@ -308,11 +330,7 @@ void UndoStack::redo()
     }
 
     // emit signals
-    emit undoTextChanged(getUndoText());
-    emit redoTextChanged(getRedoText());
-    emit canUndoChanged(canUndo());
-    emit canRedoChanged(canRedo());
-    emit cleanChanged(isClean());
+    emitChangedSignals();
     emit stateModified();
 }
 
@@ -332,19 +350,101 @@ void UndoStack::clear() noexcept
 
     // delete all commands in the stack from top to bottom (newest first, oldest last)!
     while (!mCommands.isEmpty()) {
-        delete mCommands.takeLast();
+        deleteCommand(false);
     }
+    Q_ASSERT(mMemoryUsage == 0);
 
     mCurrentIndex = 0;
     mCleanIndex = 0;
     mActiveCommandGroup = nullptr;
 
     // emit signals
-    emit undoTextChanged(tr("Undo"));
-    emit redoTextChanged(tr("Redo"));
-    emit canUndoChanged(false);
-    emit canRedoChanged(false);
-    emit cleanChanged(true);
+    emitChangedSignals();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void UndoStack::enforceMemoryLimit() noexcept
+{
+    if ((mMemoryLimit <= 0) || isCommandGroupActive()) {
+        return;
+    }
+
+    int removedCount = 0;
+    // always keep the most recent command, and of course all redoable commands
+    while ((mMemoryUsage > mMemoryLimit) && (mCurrentIndex > 1)) {
+        deleteCommand(true);
+        mCurrentIndex--;
+        if (mCleanIndex > 0) {
+            mCleanIndex--;
+        } else {
+            mCleanIndex = -1; // the clean state is no longer reachable
+        }
+        removedCount++;
+    }
+
+    if (removedCount > 0) {
+        qWarning() << "Undo stack memory limit reached," << removedCount
+                   << "old command(s) removed from the undo history.";
+        emitChangedSignals();
+    }
+}
+
+void UndoStack::appendCommand(UndoCommand* cmd) noexcept
+{
+    qint64 size = cmd->getApproximateMemoryUsage();
+    mCommands.append(cmd);
+    mCommandMemoryUsages.append(size);
+    mMemoryUsage += size;
+}
+
+void UndoStack::deleteCommand(bool first) noexcept
+{
+    delete (first ? mCommands.takeFirst() : mCommands.takeLast());
+    mMemoryUsage -= (first ? mCommandMemoryUsages.takeFirst()
+                           : mCommandMemoryUsages.takeLast());
+}
+
+void UndoStack::updateMemoryUsageOfLastCommand() noexcept
+{
+    qint64 size = mCommands.last()->getApproximateMemoryUsage();
+    mMemoryUsage += size - mCommandMemoryUsages.last();
+    mCommandMemoryUsages.last() = size;
+}
+
+void UndoStack::emitChangedSignals() noexcept
+{
+    QString undoText = getUndoText();
+    if (undoText != mEmittedUndoText) {
+        mEmittedUndoText = undoText;
+        emit undoTextChanged(undoText);
+    }
+
+    QString redoText = getRedoText();
+    if (redoText != mEmittedRedoText) {
+        mEmittedRedoText = redoText;
+        emit redoTextChanged(redoText);
+    }
+
+    bool undoAllowed = isUndoAllowed();
+    if (undoAllowed != mEmittedCanUndo) {
+        mEmittedCanUndo = undoAllowed;
+        emit canUndoChanged(undoAllowed);
+    }
+
+    bool redoAllowed = canRedo();
+    if (redoAllowed != mEmittedCanRedo) {
+        mEmittedCanRedo = redoAllowed;
+        emit canRedoChanged(redoAllowed);
+    }
+
+    bool clean = isClean();
+    if (clean != mEmittedClean) {
+        mEmittedClean = clean;
+        emit cleanChanged(clean);
+    }
 }
 
 /*****************************************************************************************
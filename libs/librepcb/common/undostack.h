@@ -174,6 +174,20 @@ class UndoStack final : public QObject
          */
         bool isCommandGroupActive() const noexcept;
 
+        /**
+         * @brief Get the memory limit of the stack (see #setMemoryLimit())
+         *
+         * @return The memory limit in bytes (0 = unlimited)
+         */
+        qint64 getMemoryLimit() const noexcept {return mMemoryLimit;}
+
+        /**
+         * @brief Get the approximate memory usage of all commands in the stack
+         *
+         * @return The sum of UndoCommand#getApproximateMemoryUsage() of all commands
+         */
+        qint64 getApproximateMemoryUsage() const noexcept;
+
 
         // Setters
 
@@ -182,6 +196,17 @@ class UndoStack final : public QObject
          */
         void setClean() noexcept;
 
+        /**
+         * @brief Set the memory budget of the undo history
+         *
+         * If the commands in the stack need more memory than the limit, the oldest
+         * commands are deleted (with a warning) until the limit is satisfied again, so
+         * they can no longer be undone. The most recent command is always kept.
+         *
+         * @param bytes     The approximate memory limit in bytes (0 = unlimited)
+         */
+        void setMemoryLimit(qint64 bytes) noexcept;
+
 
         // General Methods
 
@@ -196,6 +221,10 @@ class UndoStack final : public QObject
          *                  UndoCommand object after passing it to this method.
          * @param forceKeepCmd  Only for internal use!
          *
+         * If the command on top of the stack accepts to merge the new command (see
+         * UndoCommand#mergeWith()), no new entry is added to the stack. This never
+         * happens if the top of the stack is the clean state (see #setClean()).
+         *
          * @throw Exception If the command is not executed successfully, this method
          *                  throws an exception and tries to keep the state of the stack
          *                  consistend (as the passed command did never exist).
@@ -292,6 +321,39 @@ class UndoStack final : public QObject
 
     private:
 
+        /**
+         * @brief Emit all signals whose value has changed since they were emitted the
+         *        last time (avoids flooding the UI with redundant updates)
+         */
+        void emitChangedSignals() noexcept;
+
+        /**
+         * @brief Check whether undo is possible from the user's point of view (not while
+         *        a command group is active)
+         */
+        bool isUndoAllowed() const noexcept {return canUndo() && (!isCommandGroupActive());}
+
+        /**
+         * @brief Delete the oldest commands until the memory limit is satisfied
+         */
+        void enforceMemoryLimit() noexcept;
+
+        /**
+         * @brief Append a command to #mCommands and add its size to #mMemoryUsage
+         */
+        void appendCommand(UndoCommand* cmd) noexcept;
+
+        /**
+         * @brief Remove the first or last command from #mCommands and delete it
+         */
+        void deleteCommand(bool first) noexcept;
+
+        /**
+         * @brief Measure the topmost command again after it has grown (merge, group)
+         */
+        void updateMemoryUsageOfLastCommand() noexcept;
+
+
         /**
          * @brief This list holds all commands of the undo stack
          *
@@ -321,6 +383,32 @@ class UndoStack final : public QObject
          * or #abortCmdGroup(). Otherwise, the variable contains the nullptr.
          */
         UndoCommandGroup* mActiveCommandGroup;
+
+        /**
+         * @brief The memory budget for all commands [bytes] (0 = unlimited)
+         */
+        qint64 mMemoryLimit;
+
+        /**
+         * @brief The memory usage of each command in #mCommands (same indices) when it
+         *        was measured the last time [bytes]
+         */
+        QList<qint64> mCommandMemoryUsages;
+
+        /**
+         * @brief The sum of #mCommandMemoryUsages, kept up to date to avoid iterating
+         *        over the whole history after each command [bytes]
+         */
+        qint64 mMemoryUsage;
+
+        /**
+         * @brief The values which were emitted the last time by #emitChangedSignals()
+         */
+        QString mEmittedUndoText;
+        QString mEmittedRedoText;
+        bool mEmittedCanUndo;
+        bool mEmittedCanRedo;
+        bool mEmittedClean;
 };
 
 /*****************************************************************************************
@@ -77,6 +77,40 @@ Angle& Angle::mapTo180deg() noexcept
     return *this;
 }
 
+void Angle::sinCos(qreal& sin, qreal& cos) const noexcept
+{
+    // sine of 0°, 15°, 30°, ..., 90° (the cosine is the same table in reverse order)
+    static const qreal table[7] = {
+        0.0,
+        0.258819045102520762,   // (sqrt(6) - sqrt(2)) / 4
+        0.5,
+        0.707106781186547524,   // sqrt(2) / 2
+        0.866025403784438647,   // sqrt(3) / 2
+        0.965925826289068287,   // (sqrt(6) + sqrt(2)) / 4
+        1.0,
+    };
+
+    qint32 microdegrees = mappedTo0_360deg().toMicroDeg();
+    int quadrant = microdegrees / 90000000;
+    qint32 remainder = microdegrees % 90000000;
+    qreal s, c;
+    if (remainder % 15000000 == 0) {
+        int index = remainder / 15000000;
+        s = table[index];
+        c = table[6 - index];
+    } else {
+        qreal rad = (qreal)remainder * (qreal)M_PI / 180e6;
+        s = qSin(rad);
+        c = qCos(rad);
+    }
+    switch (quadrant) {
+        case 0:  sin =  s; cos =  c; break;
+        case 1:  sin =  c; cos = -s; break;
+        case 2:  sin = -s; cos = -c; break;
+        default: sin = -c; cos =  s; break;
+    }
+}
+
 // Static Methods
 
 Angle Angle::fromDeg(qreal degrees) noexcept
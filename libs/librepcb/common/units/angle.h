@@ -189,6 +189,19 @@ class Angle
          */
         qreal toRad() const noexcept {return (qreal)mMicrodegrees * (qreal)M_PI / 180e6;}
 
+        /**
+         * @brief Get the sine and the cosine of the angle at once
+         *
+         * Multiples of 15 degrees are looked up in a table, so they are exact (e.g.
+         * sin(90°) is exactly 1 and cos(90°) is exactly 0, which is not the case with
+         * qSin(toRad())). All other angles are reduced to the first quadrant before
+         * calculating the values, so the results are symmetric for all quadrants.
+         *
+         * @param sin   The sine of the angle (output)
+         * @param cos   The cosine of the angle (output)
+         */
+        void sinCos(qreal& sin, qreal& cos) const noexcept;
+
         /**
          * @brief Serialize this object into a string
          *
@@ -131,22 +131,120 @@ void Length::setLengthFromFloat(qreal nanometers)
 
 LengthBase_t Length::mapNmToGrid(LengthBase_t nanometers, const Length& gridInterval) noexcept
 {
-    if (gridInterval.mNanometers != 0)
-        return qRound((qreal)nanometers / gridInterval.mNanometers) * gridInterval.mNanometers;
-    else
+    // integer arithmetic, this is exact for the whole range of LengthBase_t
+    LengthBase_t interval = qAbs(gridInterval.mNanometers);
+    if (interval == 0) {
         return nanometers;
+    }
+    LengthBase_t count = nanometers / interval;
+    LengthBase_t remainder = nanometers % interval;
+    if (remainder < 0) { // floor division, so the remainder is in [0, interval)
+        remainder += interval;
+        --count;
+    }
+    if (remainder >= interval - remainder) {
+        ++count; // round half up, like qRound()
+    }
+    return count * interval;
 }
 
 LengthBase_t Length::mmStringToNm(const QString& millimeters)
 {
-    bool ok;
-    qreal nm = qRound(QLocale::c().toDouble(millimeters, &ok) * 1e6);
-    if (!ok)
-    {
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("Invalid length string: \"%1\"")).arg(millimeters));
+    return mmStringToNm(millimeters.constData(), millimeters.size()); // can throw
+}
+
+LengthBase_t Length::mmStringToNm(const QChar* millimeters, int size)
+{
+    // The digits are collected in an integer and then shifted by the position of the
+    // decimal point and the exponent. This is exact and much faster than converting the
+    // string with QLocale to a floating point number.
+    const QChar* it = millimeters;
+    const QChar* end = millimeters + size;
+    auto isDigit = [&](){return (it != end) && (it->unicode() >= '0') && (it->unicode() <= '9');};
+    auto invalidString = [&](){return RuntimeError(__FILE__, __LINE__,
+        QString(tr("Invalid length string: \"%1\"")).arg(QString(millimeters, size)));};
+    auto rangeError = [&](){return RangeError(__FILE__, __LINE__, QString(millimeters, size),
+        std::numeric_limits<LengthBase_t>::min() / 1000000,
+        std::numeric_limits<LengthBase_t>::max() / 1000000);};
+
+    // leading and trailing whitespace is ignored (like QLocale::toDouble() does)
+    while ((it != end) && it->isSpace()) ++it;
+    while ((end != it) && (end - 1)->isSpace()) --end;
+
+    // sign
+    bool negative = false;
+    if ((it != end) && ((*it == '-') || (*it == '+'))) {
+        negative = (*it == '-');
+        ++it;
+    }
+
+    // digits with an optional decimal point
+    quint64 magnitude = 0;
+    int exponent = 6; // millimeters --> nanometers
+    bool hasDigits = false;
+    bool isFraction = false;
+    for (; (it != end) && (isDigit() || ((*it == '.') && (!isFraction))); ++it) {
+        if (*it == '.') {
+            isFraction = true;
+            continue;
+        }
+        hasDigits = true;
+        if (magnitude <= (std::numeric_limits<quint64>::max() - 9) / 10) {
+            magnitude = magnitude * 10 + (it->unicode() - '0');
+            if (isFraction) --exponent;
+        } else if (!isFraction) {
+            throw rangeError();
+        } // else: fraction digits far below one nanometer are ignored
+    }
+    if (!hasDigits) {
+        throw invalidString();
+    }
+
+    // optional exponent
+    if ((it != end) && ((*it == 'e') || (*it == 'E'))) {
+        ++it;
+        bool negativeExponent = false;
+        if ((it != end) && ((*it == '-') || (*it == '+'))) {
+            negativeExponent = (*it == '-');
+            ++it;
+        }
+        if (!isDigit()) {
+            throw invalidString();
+        }
+        int value = 0;
+        for (; isDigit(); ++it) {
+            if (value < 10000) value = value * 10 + (it->unicode() - '0');
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (it != end) {
+        throw invalidString();
+    }
+
+    // shift to nanometers, digits behind the nanometers are rounded half away from zero
+    quint64 limit = static_cast<quint64>(std::numeric_limits<LengthBase_t>::max());
+    if (negative) ++limit;
+    if (exponent < 0) {
+        if (exponent < -20) {
+            magnitude = 0; // even the largest integer is below half a nanometer
+        } else {
+            quint64 roundingDigit = 0;
+            for (int i = exponent; i < 0; ++i) {
+                roundingDigit = magnitude % 10;
+                magnitude /= 10;
+            }
+            if (roundingDigit >= 5) ++magnitude;
+        }
+    } else {
+        for (int i = 0; (i < exponent) && (magnitude > 0); ++i) {
+            if (magnitude > limit / 10) throw rangeError();
+            magnitude *= 10;
+        }
+    }
+    if (magnitude > limit) {
+        throw rangeError();
     }
-    return nm;
+    return negative ? static_cast<LengthBase_t>(0 - magnitude) : static_cast<LengthBase_t>(magnitude);
 }
 
 /*****************************************************************************************
@@ -513,8 +513,9 @@ class Length
          *
          * @return  The length which is mapped to the grid (always a multiple of gridInterval)
          *
-         * @todo    does this work correctly with large 64bit integers?!
-         *          and maybe there is a better, integer-based method for this purpose?
+         * @note    The calculation is done with integers only, so it is exact also for
+         *          large 64bit values. Values exactly between two grid points are
+         *          rounded up (towards positive infinity).
          */
         static LengthBase_t mapNmToGrid(LengthBase_t nanometers, const Length& gridInterval) noexcept;
 
@@ -523,17 +524,28 @@ class Length
          *
          * This is a helper function for Length(const QString&) and setLengthMm().
          *
-         * @param millimeters   A QString which contains a floating point number with maximum
-         *                      six decimals after the decimal point. The locale of the string
-         *                      have to be "C"! Example: QString("-1234.56") for -1234.56mm
+         * @param millimeters   A QString which contains a decimal number (optionally with
+         *                      an exponent). The locale of the string have to be "C"!
+         *                      Example: QString("-1234.56") for -1234.56mm. Decimals behind
+         *                      the nanometers are rounded half away from zero.
          *
          * @return The length in nanometers
          *
-         * @todo    don't use double for this purpose!
-         *          and throw an exception if a range error occurs (under-/overflow)!
+         * @throws RuntimeError if the string is not a valid number
+         * @throws RangeError   if the length does not fit into #LengthBase_t
          */
         static LengthBase_t mmStringToNm(const QString& millimeters);
 
+        /**
+         * @copydoc mmStringToNm(const QString&)
+         *
+         * @param size  The count of characters in @p millimeters
+         *
+         * @note This overload works directly on UTF-16 characters (e.g. a substring of
+         *       a larger string), no temporary strings are allocated.
+         */
+        static LengthBase_t mmStringToNm(const QChar* millimeters, int size);
+
 
         // Private Member Variables
         LengthBase_t mNanometers;  ///< the length in nanometers
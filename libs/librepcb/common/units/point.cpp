@@ -72,57 +72,102 @@ Point Point::rotated(const Angle& angle, const Point& center) const noexcept
 
 Point& Point::rotate(const Angle& angle, const Point& center) noexcept
 {
-    Length dx = mX - center.getX();
-    Length dy = mY - center.getY();
-    Angle angle0_360 = angle.mappedTo0_360deg();
+    rotateAll(this, 1, angle, center);
+    return *this;
+}
+
+Point Point::mirrored(Qt::Orientation orientation, const Point& center) const noexcept
+{
+    Point p(*this);
+    p.mirror(orientation, center);
+    return p;
+}
+
+Point& Point::mirror(Qt::Orientation orientation, const Point& center) noexcept
+{
+    mirrorAll(this, 1, orientation, center);
+    return *this;
+}
+
+// Static Methods
+
+void Point::rotateAll(Point* points, int count, const Angle& angle, const Point& center) noexcept
+{
+    const LengthBase_t cx = center.mX.toNm();
+    const LengthBase_t cy = center.mY.toNm();
+    const Angle angle0_360 = angle.mappedTo0_360deg();
 
     // if angle is a multiple of 90 degrees, rotating can be done without loosing accuracy
     if (angle0_360 == Angle::deg90())
     {
-        setX(center.getX() - dy);
-        setY(center.getY() + dx);
+        for (Point* p = points; p < points + count; ++p) {
+            LengthBase_t dx = p->mX.toNm() - cx;
+            LengthBase_t dy = p->mY.toNm() - cy;
+            p->mX = Length(cx - dy);
+            p->mY = Length(cy + dx);
+        }
     }
     else if (angle0_360 == Angle::deg180())
     {
-        setX(center.getX() - dx);
-        setY(center.getY() - dy);
+        for (Point* p = points; p < points + count; ++p) {
+            LengthBase_t dx = p->mX.toNm() - cx;
+            LengthBase_t dy = p->mY.toNm() - cy;
+            p->mX = Length(cx - dx);
+            p->mY = Length(cy - dy);
+        }
     }
     else if (angle0_360 == Angle::deg270())
     {
-        setX(center.getX() + dy);
-        setY(center.getY() - dx);
+        for (Point* p = points; p < points + count; ++p) {
+            LengthBase_t dx = p->mX.toNm() - cx;
+            LengthBase_t dy = p->mY.toNm() - cy;
+            p->mX = Length(cx + dy);
+            p->mY = Length(cy - dx);
+        }
     }
     else if (angle != Angle::deg0())
     {
         // angle is not a multiple of 90 degrees --> we must use floating point arithmetic
-        qreal sin = qSin(angle.toRad());
-        qreal cos = qCos(angle.toRad());
-        setX(Length(center.getX().toNm() + cos * dx.toNm() - sin * dy.toNm()));
-        setY(Length(center.getY().toNm() + sin * dx.toNm() + cos * dy.toNm()));
+        // (the values are truncated towards zero when converting back to integers)
+        qreal sin, cos;
+        angle.sinCos(sin, cos);
+        for (Point* p = points; p < points + count; ++p) {
+            LengthBase_t dx = p->mX.toNm() - cx;
+            LengthBase_t dy = p->mY.toNm() - cy;
+            p->mX = Length(static_cast<LengthBase_t>(cx + cos * dx - sin * dy));
+            p->mY = Length(static_cast<LengthBase_t>(cy + sin * dx + cos * dy));
+        }
     } // else: angle == 0°, nothing to do...
-
-    return *this;
-}
-
-Point Point::mirrored(Qt::Orientation orientation, const Point& center) const noexcept
-{
-    Point p(*this);
-    p.mirror(orientation, center);
-    return p;
 }
 
-Point& Point::mirror(Qt::Orientation orientation, const Point& center) noexcept
+void Point::mirrorAll(Point* points, int count, Qt::Orientation orientation,
+                      const Point& center) noexcept
 {
+    const Length cx = center.mX; // the center may be one of the points
+    const Length cy = center.mY;
     switch (orientation)
     {
-        case Qt::Horizontal:    mX += Length(2) * (center.getX() - mX); break;
-        case Qt::Vertical:      mY += Length(2) * (center.getY() - mY); break;
+        case Qt::Horizontal:
+            for (Point* p = points; p < points + count; ++p) {
+                p->mX += Length(2) * (cx - p->mX);
+            }
+            break;
+        case Qt::Vertical:
+            for (Point* p = points; p < points + count; ++p) {
+                p->mY += Length(2) * (cy - p->mY);
+            }
+            break;
         default: Q_ASSERT(false);
     }
-    return *this;
 }
 
-// Static Methods
+void Point::translateAll(Point* points, int count, const Point& offset) noexcept
+{
+    const Point delta = offset; // the offset may be one of the points
+    for (Point* p = points; p < points + count; ++p) {
+        *p += delta;
+    }
+}
 
 Point Point::fromMm(qreal millimetersX, qreal millimetersY, const Length& gridInterval)
 {
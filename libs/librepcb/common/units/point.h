@@ -367,6 +367,49 @@ class Point
         static Point fromPx(qreal pixelsX, qreal pixelsY,           const Length& gridInterval = Length(0));
         static Point fromPx(const QPointF& pixels,                  const Length& gridInterval = Length(0));
 
+        /**
+         * @brief Rotate many points at once by the same angle around the same center
+         *
+         * The sine and cosine are calculated only once for all points, and the angle is
+         * checked only once for multiples of 90 degrees. The results are exactly the same
+         * as calling #rotate() for every single point.
+         *
+         * @param points    The points to rotate (a contiguous array)
+         * @param count     The count of points in the array
+         * @param angle     The angle to rotate (CCW)
+         * @param center    The center of the rotation
+         */
+        static void rotateAll(Point* points, int count, const Angle& angle,
+                              const Point& center = Point(0, 0)) noexcept;
+        static void rotateAll(QVector<Point>& points, const Angle& angle,
+                              const Point& center = Point(0, 0)) noexcept
+        {rotateAll(points.data(), points.count(), angle, center);}
+
+        /**
+         * @brief Mirror many points at once around the same center
+         *
+         * @copydetails mirror()
+         *
+         * @param points    The points to mirror (a contiguous array)
+         * @param count     The count of points in the array
+         */
+        static void mirrorAll(Point* points, int count, Qt::Orientation orientation,
+                              const Point& center = Point(0, 0)) noexcept;
+        static void mirrorAll(QVector<Point>& points, Qt::Orientation orientation,
+                              const Point& center = Point(0, 0)) noexcept
+        {mirrorAll(points.data(), points.count(), orientation, center);}
+
+        /**
+         * @brief Translate many points at once by the same offset
+         *
+         * @param points    The points to translate (a contiguous array)
+         * @param count     The count of points in the array
+         * @param offset    The offset to add to every point
+         */
+        static void translateAll(Point* points, int count, const Point& offset) noexcept;
+        static void translateAll(QVector<Point>& points, const Point& offset) noexcept
+        {translateAll(points.data(), points.count(), offset);}
+
         // Operators
         Point&  operator=(const Point& rhs)        {mX = rhs.mX;  mY = rhs.mY;  return *this;}
         Point&  operator+=(const Point& rhs)       {mX += rhs.mX; mY += rhs.mY; return *this;}
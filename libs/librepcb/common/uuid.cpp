@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <random>
 #include "uuid.h"
 
 /*****************************************************************************************
@@ -29,65 +30,72 @@
 namespace librepcb {
 
 /*****************************************************************************************
- *  Setters
+ *  Deterministic UUIDs (see Uuid::setDeterministicSeed())
  ****************************************************************************************/
 
-bool Uuid::setUuid(const QString& uuid) noexcept
-{
-    mUuid = QString(); // make UUID invalid
-    QString lowercaseUuid = uuid.toLower();
-    if (lowercaseUuid.length() != 36)       return false; // do NOT accept '{' and '}'
-    QUuid quuid(lowercaseUuid);
-    if (quuid.isNull())                     return false;
-    if (quuid.variant() != QUuid::DCE)      return false;
-    if (quuid.version() != QUuid::Random)   return false;
-    mUuid = lowercaseUuid;
-    return true;
-}
+static QAtomicInt sDeterministic(0);
+static QMutex sDeterministicMutex;
+static std::mt19937_64 sDeterministicGenerator;
 
 /*****************************************************************************************
- *  Operators
+ *  Getters
  ****************************************************************************************/
 
-Uuid& Uuid::operator=(const Uuid& rhs) noexcept
-{
-    mUuid = rhs.mUuid;
-    return *this;
-}
-
-bool Uuid::operator==(const Uuid& rhs) const noexcept
+QString Uuid::toStr() const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid == rhs.mUuid);
-}
+    if (isNull()) {
+        return QString();
+    }
 
-bool Uuid::operator!=(const Uuid& rhs) const noexcept
-{
-    return !(*this == rhs);
+    static const char hexDigits[] = "0123456789abcdef";
+    QString str(36, QChar('-'));
+    QChar* data = str.data();
+    int pos = 0;
+    for (int i = 0; i < 32; ++i) {
+        if ((pos == 8) || (pos == 13) || (pos == 18) || (pos == 23)) {
+            ++pos; // skip dash
+        }
+        quint64 value = (i < 16) ? mHigh : mLow;
+        int shift = 60 - 4 * (i % 16);
+        data[pos++] = QLatin1Char(hexDigits[(value >> shift) & 0xF]);
+    }
+    return str;
 }
 
-bool Uuid::operator<(const Uuid& rhs) const noexcept
-{
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid < rhs.mUuid);
-}
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
 
-bool Uuid::operator>(const Uuid& rhs) const noexcept
+bool Uuid::setUuid(const QString& uuid) noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid > rhs.mUuid);
-}
+    mHigh = mLow = 0; // make UUID invalid
+    if (uuid.length() != 36) return false; // do NOT accept '{' and '}'
+
+    quint64 high = 0, low = 0;
+    int digits = 0;
+    for (int pos = 0; pos < 36; ++pos) {
+        ushort c = uuid.at(pos).unicode();
+        if ((pos == 8) || (pos == 13) || (pos == 18) || (pos == 23)) {
+            if (c != '-') return false;
+            continue;
+        }
+        int nibble;
+        if ((c >= '0') && (c <= '9'))       nibble = c - '0';
+        else if ((c >= 'a') && (c <= 'f'))  nibble = c - 'a' + 10;
+        else if ((c >= 'A') && (c <= 'F'))  nibble = c - 'A' + 10;
+        else return false;
+        quint64& value = (digits < 16) ? high : low;
+        value = (value << 4) | quint64(nibble);
+        ++digits;
+    }
 
-bool Uuid::operator<=(const Uuid& rhs) const noexcept
-{
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid <= rhs.mUuid);
-}
+    // only accept DCE variant (bits "10x") and version 4 (random)
+    if (((high >> 12) & 0xF) != 4)  return false;
+    if (((low >> 62) & 0x3) != 2)   return false;
 
-bool Uuid::operator>=(const Uuid& rhs) const noexcept
-{
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid >= rhs.mUuid);
+    mHigh = high;
+    mLow = low;
+    return true;
 }
 
 /*****************************************************************************************
@@ -96,6 +104,14 @@ bool Uuid::operator>=(const Uuid& rhs) const noexcept
 
 Uuid Uuid::createRandom() noexcept
 {
+    if (sDeterministic.load()) {
+        QMutexLocker locker(&sDeterministicMutex);
+        Uuid uuid;
+        uuid.mHigh = (sDeterministicGenerator() & ~quint64(0xF000)) | quint64(0x4000); // version 4
+        uuid.mLow = (sDeterministicGenerator() >> 2) | (quint64(2) << 62); // DCE variant
+        return uuid;
+    }
+
     Uuid uuid(QUuid::createUuid().toString().remove("{").remove("}"));
     if (uuid.isNull()) {
         qCritical() << "Could not generate a valid random UUID!";
@@ -103,6 +119,13 @@ Uuid Uuid::createRandom() noexcept
     return uuid;
 }
 
+void Uuid::setDeterministicSeed(quint64 seed) noexcept
+{
+    QMutexLocker locker(&sDeterministicMutex);
+    sDeterministicGenerator.seed(seed);
+    sDeterministic.store((seed != 0) ? 1 : 0);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -44,6 +44,11 @@ namespace librepcb {
  *
  * A valid UUID looks like this: "d79d354b-62bd-4866-996a-78941c575e78"
  *
+ * Internally the UUID is stored as two 64-bit integers (16 bytes, big endian), so
+ * copying, comparing and hashing is cheap and does not require any heap allocation. The
+ * string representation is only created on demand (e.g. for serialization). The sort
+ * order is the same as the sort order of the string representations.
+ *
  * @see https://de.wikipedia.org/wiki/Universally_Unique_Identifier
  * @see https://tools.ietf.org/html/rfc4122
  *
@@ -61,21 +66,21 @@ class Uuid final
         /**
          * @brief Default constructor (creates a NULL #Uuid object)
          */
-        Uuid() noexcept : mUuid() {}
+        Uuid() noexcept : mHigh(0), mLow(0) {}
 
         /**
          * @brief Constructor which creates a #Uuid object from a string
          *
          * @param uuid      The uuid as a string (without braces)
          */
-        explicit Uuid(const QString& uuid) noexcept : mUuid() {setUuid(uuid);}
+        explicit Uuid(const QString& uuid) noexcept : mHigh(0), mLow(0) {setUuid(uuid);}
 
         /**
          * @brief Copy constructor
          *
          * @param other     Another #Uuid object
          */
-        Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+        Uuid(const Uuid& other) noexcept : mHigh(other.mHigh), mLow(other.mLow) {}
 
         /**
          * @brief Destructor
@@ -90,14 +95,21 @@ class Uuid final
          *
          * @return true if NULL/invalid UUID, false if valid UUID
          */
-        bool isNull() const noexcept {return mUuid.isEmpty();}
+        bool isNull() const noexcept {return (mHigh == 0) && (mLow == 0);}
 
         /**
          * @brief Get the UUID as a string (without braces)
          *
-         * @return The UUID as a string
+         * @return The UUID as a string (lowercase), or a null QString if #isNull()
+         */
+        QString toStr() const noexcept;
+
+        /**
+         * @brief Get a hash value of the UUID (used by #qHash())
+         *
+         * @return A hash value which is calculated from the binary representation
          */
-        QString toStr() const noexcept {return mUuid;}
+        uint hash() const noexcept {return uint(mHigh ^ (mHigh >> 32) ^ mLow ^ (mLow >> 32));}
 
         /**
          * @brief Serialize this object into a string
@@ -130,13 +142,23 @@ class Uuid final
          * @return  If at least one of both objects is invalid, false will be returned
          *          (except #operator!=() which would return true in this case)!
          */
-        Uuid& operator=(const Uuid& rhs) noexcept;
-        bool operator==(const Uuid& rhs) const noexcept;
-        bool operator!=(const Uuid& rhs) const noexcept;
-        bool operator<(const Uuid& rhs) const noexcept;
-        bool operator>(const Uuid& rhs) const noexcept;
-        bool operator<=(const Uuid& rhs) const noexcept;
-        bool operator>=(const Uuid& rhs) const noexcept;
+        Uuid& operator=(const Uuid& rhs) noexcept {mHigh = rhs.mHigh; mLow = rhs.mLow; return *this;}
+        bool operator==(const Uuid& rhs) const noexcept {
+            return (!isNull()) && (!rhs.isNull()) && (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
+        }
+        bool operator!=(const Uuid& rhs) const noexcept {return !(*this == rhs);}
+        bool operator<(const Uuid& rhs) const noexcept {
+            return (!isNull()) && (!rhs.isNull()) && (compare(rhs) < 0);
+        }
+        bool operator>(const Uuid& rhs) const noexcept {
+            return (!isNull()) && (!rhs.isNull()) && (compare(rhs) > 0);
+        }
+        bool operator<=(const Uuid& rhs) const noexcept {
+            return (!isNull()) && (!rhs.isNull()) && (compare(rhs) <= 0);
+        }
+        bool operator>=(const Uuid& rhs) const noexcept {
+            return (!isNull()) && (!rhs.isNull()) && (compare(rhs) >= 0);
+        }
         //@}
 
 
@@ -167,11 +189,31 @@ class Uuid final
          */
         static Uuid createRandom() noexcept;
 
+        /**
+         * @brief Make #createRandom() return a reproducible sequence of UUIDs
+         *
+         * This is only intended for tools and tests which need reproducible output (e.g.
+         * generated projects for benchmarks). The sequence only depends on the seed, so
+         * it is the same on all platforms.
+         *
+         * @param seed      The seed of the sequence, or 0 to create random UUIDs again
+         */
+        static void setDeterministicSeed(quint64 seed) noexcept;
+
 
     private:
 
+        // Private Methods
+        int compare(const Uuid& rhs) const noexcept {
+            if (mHigh != rhs.mHigh) return (mHigh < rhs.mHigh) ? -1 : 1;
+            if (mLow != rhs.mLow)   return (mLow < rhs.mLow) ? -1 : 1;
+            return 0;
+        }
+
+
         // Private Attributes
-        QString mUuid;
+        quint64 mHigh;  ///< first 8 bytes of the UUID (0 if NULL)
+        quint64 mLow;   ///< last 8 bytes of the UUID (0 if NULL)
 };
 
 /*****************************************************************************************
@@ -180,7 +222,7 @@ class Uuid final
 
 inline uint qHash(const Uuid& key, uint seed)
 {
-    return qHash(key.toStr(), seed);
+    return key.hash() ^ seed;
 }
 
 inline QDataStream& operator<<(QDataStream& stream, const Uuid& uuid)
@@ -34,6 +34,7 @@ namespace librepcb {
 
 Version::Version() noexcept
 {
+    mPacked.fill(0);
 }
 
 Version::Version(const QString& version) noexcept
@@ -42,7 +43,7 @@ Version::Version(const QString& version) noexcept
 }
 
 Version::Version(const Version& other) noexcept :
-    mNumbers(other.mNumbers)
+    mNumbers(other.mNumbers), mPacked(other.mPacked)
 {
 
 }
@@ -106,6 +107,20 @@ QString Version::toComparableStr() const noexcept
     return str;
 }
 
+QByteArray Version::toComparableBlob() const noexcept
+{
+    QByteArray blob;
+    if (isValid()) {
+        blob.reserve(static_cast<int>(mPacked.size() * sizeof(quint64)));
+        for (quint64 word : mPacked) {
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                blob.append(static_cast<char>((word >> shift) & 0xFF));
+            }
+        }
+    }
+    return blob;
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -113,6 +128,7 @@ QString Version::toComparableStr() const noexcept
 bool Version::setVersion(const QString& version) noexcept
 {
     mNumbers.clear();
+    mPacked.fill(0);
     QStringList numbers = version.split('.', QString::KeepEmptyParts, Qt::CaseSensitive);
     foreach (const QString& numberStr, numbers)
     {
@@ -136,6 +152,11 @@ bool Version::setVersion(const QString& version) noexcept
         mNumbers.clear();
         return false;
     }
+    // pack numbers for fast comparisons
+    for (int i = 0; i < mNumbers.count(); i++)
+    {
+        mPacked[i / 3] |= quint64(mNumbers.at(i)) << (17 * (2 - (i % 3)));
+    }
     return (mNumbers.count() > 0);
 }
 
@@ -146,6 +167,7 @@ bool Version::setVersion(const QString& version) noexcept
 Version& Version::operator=(const Version& rhs) noexcept
 {
     mNumbers = rhs.mNumbers;
+    mPacked = rhs.mPacked;
     return *this;
 }
 
@@ -206,17 +228,14 @@ bool Version::operator!=(const Version& rhs) const noexcept
 int Version::compare(const Version& other) const noexcept
 {
     if (mNumbers.isEmpty() || other.mNumbers.isEmpty()) return 0;
-    if (mNumbers == other.mNumbers) return 0;
 
-    for (int i = 0; i < qMax(mNumbers.count(), other.mNumbers.count()); i++)
+    // missing numbers are zero and trailing zeros are removed, so comparing the packed
+    // representations is equivalent to comparing the number lists
+    for (std::size_t i = 0; i < mPacked.size(); i++)
     {
-        if (i >= mNumbers.count()) return -1;
-        if (i >= other.mNumbers.count()) return 1;
-        if (mNumbers[i] < other.mNumbers[i]) return -1;
-        if (mNumbers[i] > other.mNumbers[i]) return 1;
+        if (mPacked[i] < other.mPacked[i]) return -1;
+        if (mPacked[i] > other.mPacked[i]) return 1;
     }
-
-    Q_ASSERT_X(false, "Version::compare", "this line should never be reached!");
     return 0;
 }
 
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <array>
 #include <QtCore>
 #include "exceptions.h"
 
@@ -151,6 +152,18 @@ class Version final
          */
         QString toComparableStr() const noexcept;
 
+        /**
+         * @brief Get the version as a comparable binary blob (32 bytes)
+         *
+         * This is the packed representation of the version (see #mPacked) in big-endian
+         * byte order, so comparing two blobs bytewise (e.g. SQLite BLOB columns with
+         * `ORDER BY`) gives the same result as comparing the versions. The blob is
+         * shorter and faster to compare than #toComparableStr().
+         *
+         * @return The version as a comparable blob (empty blob = invalid version)
+         */
+        QByteArray toComparableBlob() const noexcept;
+
         /**
          * @brief Serialize this object into a string
          *
@@ -241,6 +254,16 @@ class Version final
          * number count >= 1: version valid
          */
         QList<int> mNumbers;
+
+        /**
+         * @brief Packed fixed-width representation of #mNumbers for fast comparisons
+         *
+         * Each number needs 17 bits (max. 99999), so three numbers are packed into one
+         * 64 bit word, with the major version number in the most significant bits of the
+         * first word. Missing numbers are zero, so the words can be compared like an
+         * ordinary array of integers. All words are zero for invalid versions.
+         */
+        std::array<quint64, 4> mPacked;
 };
 
 /*****************************************************************************************
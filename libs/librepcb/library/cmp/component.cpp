@@ -96,6 +96,24 @@ std::shared_ptr<const ComponentSymbolVariantItem> Component::getSymbVarItem(
     return mSymbolVariants.get(symbVar)->getSymbolItems().get(item); // can throw
 }
 
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+qint64 Component::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = LibraryElement::getApproximateMemoryUsage();
+    size += mSignals.count() * sizeof(ComponentSignal);
+    for (const ComponentSymbolVariant& variant : mSymbolVariants) {
+        size += sizeof(ComponentSymbolVariant);
+        for (const ComponentSymbolVariantItem& item : variant.getSymbolItems()) {
+            size += sizeof(ComponentSymbolVariantItem)
+                  + item.getPinSignalMap().count() * sizeof(ComponentPinSignalMapItem);
+        }
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
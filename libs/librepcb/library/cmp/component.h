@@ -114,6 +114,11 @@ class Component final : public LibraryElement
         std::shared_ptr<const ComponentSymbolVariantItem> getSymbVarItem(const Uuid& symbVar,
                                                                          const Uuid& item) const;
 
+        // General Methods
+
+        /// @copydoc librepcb::library::LibraryBaseElement::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
         // Operator Overloadings
         Component& operator=(const Component& rhs) = delete;
 
@@ -77,6 +77,16 @@ void Device::setPackageUuid(const Uuid& uuid) noexcept
     emit packageUuidChanged(mPackageUuid);
 }
 
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+qint64 Device::getApproximateMemoryUsage() const noexcept
+{
+    return LibraryElement::getApproximateMemoryUsage()
+         + mPadSignalMap.count() * sizeof(DevicePadSignalMapItem);
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -72,6 +72,11 @@ class Device final : public LibraryElement
         void setComponentUuid(const Uuid& uuid) noexcept;
         void setPackageUuid(const Uuid& uuid) noexcept;
 
+        // General Methods
+
+        /// @copydoc librepcb::library::LibraryBaseElement::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
         // Operator Overloadings
         Device& operator=(const Device& rhs) = delete;
 
@@ -89,7 +89,7 @@ Library::~Library() noexcept
 template <typename ElementType>
 FilePath Library::getElementsDirectory() const noexcept
 {
-    return mDirectory.getPathTo(ElementType::getShortElementName());
+    return getElementsDirectory<ElementType>(mDirectory);
 }
 
 // explicit template instantiations
@@ -151,9 +151,41 @@ void Library::removeDependency(const Uuid& uuid) noexcept
 
 template <typename ElementType>
 QList<FilePath> Library::searchForElements() const noexcept
+{
+    return searchForElements<ElementType>(mDirectory);
+}
+
+// explicit template instantiations
+template QList<FilePath> Library::searchForElements<ComponentCategory>() const noexcept;
+template QList<FilePath> Library::searchForElements<PackageCategory>() const noexcept;
+template QList<FilePath> Library::searchForElements<Symbol>() const noexcept;
+template QList<FilePath> Library::searchForElements<Package>() const noexcept;
+template QList<FilePath> Library::searchForElements<Component>() const noexcept;
+template QList<FilePath> Library::searchForElements<Device>() const noexcept;
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+template <typename ElementType>
+FilePath Library::getElementsDirectory(const FilePath& libDir) noexcept
+{
+    return libDir.getPathTo(ElementType::getShortElementName());
+}
+
+// explicit template instantiations
+template FilePath Library::getElementsDirectory<ComponentCategory>(const FilePath&) noexcept;
+template FilePath Library::getElementsDirectory<PackageCategory>(const FilePath&) noexcept;
+template FilePath Library::getElementsDirectory<Symbol>(const FilePath&) noexcept;
+template FilePath Library::getElementsDirectory<Package>(const FilePath&) noexcept;
+template FilePath Library::getElementsDirectory<Component>(const FilePath&) noexcept;
+template FilePath Library::getElementsDirectory<Device>(const FilePath&) noexcept;
+
+template <typename ElementType>
+QList<FilePath> Library::searchForElements(const FilePath& libDir) noexcept
 {
     QList<FilePath> list;
-    FilePath subDirFilePath = getElementsDirectory<ElementType>();
+    FilePath subDirFilePath = getElementsDirectory<ElementType>(libDir);
     QDir subDir(subDirFilePath.toStr());
     foreach (const QString& dirname, subDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
         FilePath elementFilePath = subDirFilePath.getPathTo(dirname);
@@ -173,12 +205,12 @@ QList<FilePath> Library::searchForElements() const noexcept
 }
 
 // explicit template instantiations
-template QList<FilePath> Library::searchForElements<ComponentCategory>() const noexcept;
-template QList<FilePath> Library::searchForElements<PackageCategory>() const noexcept;
-template QList<FilePath> Library::searchForElements<Symbol>() const noexcept;
-template QList<FilePath> Library::searchForElements<Package>() const noexcept;
-template QList<FilePath> Library::searchForElements<Component>() const noexcept;
-template QList<FilePath> Library::searchForElements<Device>() const noexcept;
+template QList<FilePath> Library::searchForElements<ComponentCategory>(const FilePath&) noexcept;
+template QList<FilePath> Library::searchForElements<PackageCategory>(const FilePath&) noexcept;
+template QList<FilePath> Library::searchForElements<Symbol>(const FilePath&) noexcept;
+template QList<FilePath> Library::searchForElements<Package>(const FilePath&) noexcept;
+template QList<FilePath> Library::searchForElements<Component>(const FilePath&) noexcept;
+template QList<FilePath> Library::searchForElements<Device>(const FilePath&) noexcept;
 
 /*****************************************************************************************
  *  Private Methods
@@ -85,6 +85,15 @@ class Library final : public LibraryBaseElement
         static QString getShortElementName() noexcept {return QStringLiteral("lib");}
         static QString getLongElementName() noexcept {return QStringLiteral("library");}
 
+        /**
+         * @brief Variants of #getElementsDirectory() and #searchForElements() which do
+         *        not need an opened library (e.g. to scan libraries without parsing them)
+         */
+        template <typename ElementType>
+        static FilePath getElementsDirectory(const FilePath& libDir) noexcept;
+        template <typename ElementType>
+        static QList<FilePath> searchForElements(const FilePath& libDir) noexcept;
+
 
     private: // Methods
 
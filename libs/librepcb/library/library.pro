@@ -38,6 +38,8 @@ SOURCES += \
     dev/devicepadsignalmap.cpp \
     library.cpp \
     librarybaseelement.cpp \
+    libraryelementcache.cpp \
+    libraryindex.cpp \
     libraryelement.cpp \
     pkg/cmd/cmdfootprintedit.cpp \
     pkg/cmd/cmdfootprintpadedit.cpp \
@@ -77,6 +79,8 @@ HEADERS += \
     elements.h \
     library.h \
     librarybaseelement.h \
+    libraryelementcache.h \
+    libraryindex.h \
     libraryelement.h \
     pkg/cmd/cmdfootprintedit.h \
     pkg/cmd/cmdfootprintpadedit.h \
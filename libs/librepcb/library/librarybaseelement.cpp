@@ -22,11 +22,14 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "librarybaseelement.h"
+#include "libraryelementcache.h"
 #include <librepcb/common/fileio/smartversionfile.h>
 #include <librepcb/common/fileio/smartxmlfile.h>
 #include <librepcb/common/fileio/domdocument.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/filewritebatch.h>
 #include <librepcb/common/application.h>
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -97,8 +100,7 @@ LibraryBaseElement::LibraryBaseElement(const FilePath& elementDirectory,
 
     // open main XML file
     FilePath xmlFilePath = mDirectory.getPathTo(mLongElementName % ".xml");
-    SmartXmlFile xmlFile(xmlFilePath, false, true);
-    mLoadingXmlFileDocument = xmlFile.parseFileAndBuildDomTree();
+    mLoadingXmlFileDocument = LibraryElementCache::getDocument(xmlFilePath); // can throw
     const DomElement& root = mLoadingXmlFileDocument->getRoot(mLongElementName);
 
     // read attributes
@@ -197,13 +199,24 @@ void LibraryBaseElement::moveIntoParentDirectory(const FilePath& parentDir)
     moveTo(elemDir);
 }
 
+qint64 LibraryBaseElement::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = sizeof(LibraryBaseElement) + MemoryReport::getStringSize(mAuthor);
+    foreach (const QString& locale, getAllAvailableLocales()) {
+        size += MemoryReport::getStringSize(mNames.value(locale))
+              + MemoryReport::getStringSize(mDescriptions.value(locale))
+              + MemoryReport::getStringSize(mKeywords.value(locale));
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Protected Methods
  ****************************************************************************************/
 
 void LibraryBaseElement::cleanupAfterLoadingElementFromFile() noexcept
 {
-    mLoadingXmlFileDocument.reset(); // destroy the whole XML DOM tree
+    mLoadingXmlFileDocument.reset(); // release the XML DOM tree (it may stay cached)
 }
 
 void LibraryBaseElement::copyTo(const FilePath& destination, bool removeSource)
@@ -223,7 +236,8 @@ void LibraryBaseElement::copyTo(const FilePath& destination, bool removeSource)
                 .arg(mDirectory.toNative(), destination.toNative()));
         }
 
-        // copy current directory to destination
+        // copy current directory to destination (note: this is done immediately, even
+        // if a FileWriteBatch is active, since the element files are saved into it)
         FileUtils::copyDirRecursively(mDirectory, destination);
 
         // memorize the current directory
@@ -235,9 +249,14 @@ void LibraryBaseElement::copyTo(const FilePath& destination, bool removeSource)
         mOpenedReadOnly = false;
         save();
 
-        // remove source directory if required
+        // remove source directory if required (if a FileWriteBatch is active, this
+        // is part of its transaction and is reverted if the batch fails)
         if (removeSource) {
-            FileUtils::removeDirRecursively(sourceDir);
+            if (FileWriteBatch* batch = FileWriteBatch::getActive()) {
+                batch->appendRemoval(sourceDir);
+            } else {
+                FileUtils::removeDirRecursively(sourceDir);
+            }
         }
     } else {
         // no copy action required, just save the element
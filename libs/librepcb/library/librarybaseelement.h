@@ -99,6 +99,16 @@ class LibraryBaseElement : public QObject, public SerializableObject
         virtual void moveTo(const FilePath& destination);
         virtual void moveIntoParentDirectory(const FilePath& parentDir);
 
+        /**
+         * @brief Get the approximate count of bytes allocated by this element
+         *
+         * Used for memory reports (see librepcb::MemoryReport). Element types with
+         * geometry or lists of items reimplement this method to add them.
+         *
+         * @return The estimated memory usage in bytes
+         */
+        virtual qint64 getApproximateMemoryUsage() const noexcept;
+
         // Operator Overloadings
         LibraryBaseElement& operator=(const LibraryBaseElement& rhs) = delete;
 
@@ -129,7 +139,7 @@ class LibraryBaseElement : public QObject, public SerializableObject
 
         // Members required for loading elements from file
         Version mLoadingElementFileVersion;
-        std::unique_ptr<DomDocument> mLoadingXmlFileDocument;
+        std::shared_ptr<const DomDocument> mLoadingXmlFileDocument; ///< see LibraryElementCache
 
         // General Library Element Attributes
         Uuid mUuid;
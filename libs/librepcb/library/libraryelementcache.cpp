@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "libraryelementcache.h"
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/mappedfile.h>
+#include <librepcb/common/memoryreport.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+typedef std::shared_ptr<const DomDocument> CachedDocument;
+
+static QMutex sMutex;
+static bool sEnabled = true;
+
+// the key is the content hash followed by the file path, the cost of an entry is the
+// size of its file content
+static QCache<QByteArray, CachedDocument> sCache(64 * 1024 * 1024);
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+std::shared_ptr<const DomDocument> LibraryElementCache::getDocument(const FilePath& filepath)
+{
+    if (!filepath.isExistingFile()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("The file \"%1\" does not exist!")).arg(filepath.toNative()));
+    }
+    MappedFile file(filepath); // can throw
+    QByteArray key = QCryptographicHash::hash(file.getContent(), QCryptographicHash::Md5)
+                   + filepath.toStr().toUtf8();
+
+    {
+        QMutexLocker locker(&sMutex);
+        if (!sEnabled) {
+            locker.unlock();
+            return std::make_shared<const DomDocument>(file); // can throw
+        }
+        if (const CachedDocument* doc = sCache.object(key)) {
+            return *doc;
+        }
+    }
+
+    // parse without holding the lock, so other files can be loaded in parallel
+    CachedDocument doc = std::make_shared<const DomDocument>(file); // can throw
+
+    QMutexLocker locker(&sMutex);
+    if (sEnabled) {
+        sCache.insert(key, new CachedDocument(doc), file.getContent().size());
+    }
+    return doc;
+}
+
+void LibraryElementCache::setEnabled(bool enabled) noexcept
+{
+    QMutexLocker locker(&sMutex);
+    sEnabled = enabled;
+    if (!enabled) {
+        sCache.clear();
+    }
+}
+
+void LibraryElementCache::clear() noexcept
+{
+    QMutexLocker locker(&sMutex);
+    sCache.clear();
+}
+
+void LibraryElementCache::addToMemoryReport(MemoryReport& parent) noexcept
+{
+    QMutexLocker locker(&sMutex);
+    parent.addChild("Library element DOM cache", sCache.totalCost(), sCache.count());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace library
+} // namespace librepcb
@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
+#define LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <memory>
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class DomDocument;
+class FilePath;
+class MemoryReport;
+
+namespace library {
+
+/*****************************************************************************************
+ *  Class LibraryElementCache
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryElementCache class caches the parsed XML files of library elements
+ *
+ * The cache is shared by all library elements of the application (workspace library and
+ * all opened projects), so opening a project which uses the same library elements as
+ * a previously opened project does not need to parse their XML files again.
+ *
+ * Entries are keyed by the file path and the hash of the file content, so an entry is
+ * never used for a modified file. The path is part of the key because the documents
+ * contain their file path (e.g. for error messages), so identical copies of a file
+ * (e.g. a workspace library element and its copy in a project library) must not share
+ * one document. The cached documents are read-only and can be used by several threads
+ * at the same time.
+ *
+ * @note All methods are thread-safe.
+ */
+class LibraryElementCache final
+{
+        Q_DECLARE_TR_FUNCTIONS(LibraryElementCache)
+
+    public:
+
+        // Constructors / Destructor
+        LibraryElementCache() = delete;
+        LibraryElementCache(const LibraryElementCache& other) = delete;
+        ~LibraryElementCache() = delete;
+
+        /**
+         * @brief Read and parse an XML file, or get it from the cache
+         *
+         * @param filepath      The XML file to load
+         *
+         * @return The parsed (read-only) DOM document
+         *
+         * @throw Exception     If the file could not be read or parsed.
+         */
+        static std::shared_ptr<const DomDocument> getDocument(const FilePath& filepath);
+
+        /**
+         * @brief Enable or disable the cache (enabled by default)
+         *
+         * Disabling the cache also removes all cached documents.
+         *
+         * @param enabled   Whether parsed documents should be cached
+         */
+        static void setEnabled(bool enabled) noexcept;
+
+        /**
+         * @brief Remove all cached documents
+         */
+        static void clear() noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of the cached documents to a report
+         *
+         * The size of a parsed document is approximated by the size of its file.
+         */
+        static void addToMemoryReport(MemoryReport& parent) noexcept;
+
+
+        // Operator Overloadings
+        LibraryElementCache& operator=(const LibraryElementCache& rhs) = delete;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
@@ -0,0 +1,242 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "libraryindex.h"
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include "elements.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+LibraryIndex::LibraryIndex(const FilePath& libDir) :
+    mLibraryDirectory(libDir)
+{
+    FilePath fp = getFilePath(libDir);
+    DomDocument doc(FileUtils::readFile(fp), fp); // can throw
+    const DomElement& root = doc.getRoot("library_index"); // can throw
+    mLibraryUuid = root.getFirstChild("library", true)->getText<Uuid>(true);
+    mLibraryVersion = root.getFirstChild("version", true)->getText<Version>(true);
+    foreach (const DomElement* node, root.getChilds("element")) {
+        Entry entry = loadEntry(*node); // can throw
+        mEntries.insert(entry.path, entry);
+    }
+}
+
+LibraryIndex::LibraryIndex(const FilePath& libDir, const Uuid& uuid,
+                           const Version& version) noexcept :
+    mLibraryDirectory(libDir), mLibraryUuid(uuid), mLibraryVersion(version)
+{
+}
+
+LibraryIndex::~LibraryIndex() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+const LibraryIndex::Entry* LibraryIndex::getEntry(const FilePath& elementDir) const noexcept
+{
+    auto it = mEntries.find(elementDir.toRelative(mLibraryDirectory));
+    return (it != mEntries.end()) ? &it.value() : nullptr;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void LibraryIndex::save() const
+{
+    QScopedPointer<DomElement> root(serializeToDomElement("library_index")); // can throw
+    DomDocument doc(*root.take());
+    FileUtils::writeFile(getFilePath(mLibraryDirectory), doc.toByteArray()); // can throw
+}
+
+void LibraryIndex::serialize(DomElement& root) const
+{
+    root.appendTextChild("library", mLibraryUuid);
+    root.appendTextChild("version", mLibraryVersion);
+    QStringList paths = mEntries.keys();
+    paths.sort(); // keep the file stable for version control systems
+    foreach (const QString& path, paths) {
+        const Entry& entry = mEntries[path];
+        DomElement* node = root.appendChild("element");
+        node->setAttribute("type", entry.type);
+        node->setAttribute("path", entry.path);
+        node->setAttribute("hash", entry.hash);
+        node->appendTextChild("uuid", entry.uuid);
+        node->appendTextChild("version", entry.version);
+        entry.names.serialize(*node);
+        entry.descriptions.serialize(*node);
+        entry.keywords.serialize(*node);
+        if ((entry.type == ComponentCategory::getShortElementName()) ||
+            (entry.type == PackageCategory::getShortElementName())) {
+            node->appendTextChild("parent", entry.parentUuid);
+        }
+        QList<Uuid> categories = entry.categories.toList();
+        std::sort(categories.begin(), categories.end());
+        foreach (const Uuid& category, categories) {
+            node->appendTextChild("category", category);
+        }
+        entry.attributes.serialize(*node);
+        QList<Uuid> symbols = entry.symbols.toList();
+        std::sort(symbols.begin(), symbols.end());
+        foreach (const Uuid& symbol, symbols) {
+            node->appendTextChild("symbol", symbol);
+        }
+        if (entry.type == Device::getShortElementName()) {
+            node->appendTextChild("component", entry.componentUuid);
+            node->appendTextChild("package", entry.packageUuid);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+LibraryIndex LibraryIndex::create(const FilePath& libDir)
+{
+    Library lib(libDir, true); // can throw
+    LibraryIndex index(libDir, lib.getUuid(), lib.getVersion());
+    index.addElements<ComponentCategory>(); // can throw
+    index.addElements<PackageCategory>(); // can throw
+    index.addElements<Symbol>(); // can throw
+    index.addElements<Package>(); // can throw
+    index.addElements<Component>(); // can throw
+    index.addElements<Device>(); // can throw
+    return index;
+}
+
+QString LibraryIndex::calcDirectoryHash(const FilePath& dir) noexcept
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    QDir qdir(dir.toStr());
+    foreach (const QFileInfo& info, qdir.entryInfoList(QDir::Files | QDir::Hidden, QDir::Name)) {
+        QFile file(info.absoluteFilePath());
+        hash.addData(info.fileName().toUtf8());
+        if (file.open(QIODevice::ReadOnly)) {
+            hash.addData(&file);
+        }
+    }
+    return QString(hash.result().toHex());
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+template <typename ElementType>
+void LibraryIndex::addElements()
+{
+    foreach (const FilePath& dir, Library::searchForElements<ElementType>(mLibraryDirectory)) {
+        ElementType element(dir, true); // can throw
+        Entry entry;
+        entry.type = ElementType::getShortElementName();
+        addEntry(element, entry);
+        setEntryDetails(entry, element);
+        mEntries.insert(entry.path, entry);
+    }
+}
+
+void LibraryIndex::addEntry(const LibraryBaseElement& element, Entry& entry) noexcept
+{
+    entry.path = element.getFilePath().toRelative(mLibraryDirectory);
+    entry.hash = calcDirectoryHash(element.getFilePath());
+    entry.uuid = element.getUuid();
+    entry.version = element.getVersion();
+    entry.names = element.getNames();
+    entry.descriptions = element.getDescriptions();
+    entry.keywords = element.getKeywords();
+}
+
+void LibraryIndex::setEntryDetails(Entry& entry, const LibraryCategory& element) noexcept
+{
+    entry.parentUuid = element.getParentUuid();
+}
+
+void LibraryIndex::setEntryDetails(Entry& entry, const LibraryElement& element) noexcept
+{
+    entry.categories = element.getCategories();
+}
+
+void LibraryIndex::setEntryDetails(Entry& entry, const Component& element) noexcept
+{
+    setEntryDetails(entry, static_cast<const LibraryElement&>(element));
+    entry.attributes = element.getAttributes();
+    for (const ComponentSymbolVariant& variant : element.getSymbolVariants()) {
+        entry.symbols.unite(variant.getAllSymbolUuids());
+    }
+}
+
+void LibraryIndex::setEntryDetails(Entry& entry, const Device& element) noexcept
+{
+    setEntryDetails(entry, static_cast<const LibraryElement&>(element));
+    entry.componentUuid = element.getComponentUuid();
+    entry.packageUuid = element.getPackageUuid();
+}
+
+LibraryIndex::Entry LibraryIndex::loadEntry(const DomElement& node)
+{
+    Entry entry;
+    entry.type = node.getAttribute<QString>("type", true);
+    entry.path = node.getAttribute<QString>("path", true);
+    entry.hash = node.getAttribute<QString>("hash", true);
+    entry.uuid = node.getFirstChild("uuid", true)->getText<Uuid>(true);
+    entry.version = node.getFirstChild("version", true)->getText<Version>(true);
+    entry.names.loadFromDomElement(node); // can throw
+    entry.descriptions.loadFromDomElement(node); // can throw
+    entry.keywords.loadFromDomElement(node); // can throw
+    if (const DomElement* parent = node.getFirstChild("parent", false)) {
+        entry.parentUuid = parent->getText<Uuid>(false);
+    }
+    foreach (const DomElement* category, node.getChilds("category")) {
+        entry.categories.insert(category->getText<Uuid>(true));
+    }
+    entry.attributes.loadFromDomElement(node); // can throw
+    foreach (const DomElement* symbol, node.getChilds("symbol")) {
+        entry.symbols.insert(symbol->getText<Uuid>(true));
+    }
+    if (entry.type == Device::getShortElementName()) {
+        entry.componentUuid = node.getFirstChild("component", true)->getText<Uuid>(true);
+        entry.packageUuid = node.getFirstChild("package", true)->getText<Uuid>(true);
+    }
+    return entry;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace library
+} // namespace librepcb
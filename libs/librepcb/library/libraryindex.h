@@ -0,0 +1,186 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_LIBRARY_LIBRARYINDEX_H
+#define LIBREPCB_LIBRARY_LIBRARYINDEX_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/attributes/attribute.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/serializablekeyvaluemap.h>
+#include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/version.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+
+class LibraryBaseElement;
+class LibraryCategory;
+class LibraryElement;
+class Component;
+class Device;
+
+/*****************************************************************************************
+ *  Class LibraryIndex
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryIndex class represents the index manifest of a library
+ *
+ * The index (file "library_index.xml" in the library directory) contains the metadata
+ * of all elements of a library which is needed by the workspace library database: UUID,
+ * version, translations, categories, the parent category of categories, the attributes
+ * and symbols of components and the component and package of devices. So the workspace library
+ * scanner can add the elements of a library to the database without parsing the files
+ * of every element. This is especially useful for remote libraries, which are read-only
+ * and identical on every workstation, so the index only needs to be generated once
+ * (see #create()) and is shipped together with the library.
+ *
+ * Every entry contains the content hash of its element directory (see
+ * #calcDirectoryHash()). An entry must only be used if the hash still matches the
+ * element directory, otherwise the element has to be parsed as usual.
+ */
+class LibraryIndex final : public SerializableObject
+{
+        Q_DECLARE_TR_FUNCTIONS(LibraryIndex)
+
+    public:
+
+        // Types
+        struct Entry {
+            QString type;       ///< short element name, e.g. "cmp"
+            QString path;       ///< element directory, relative to the library directory
+            QString hash;       ///< see #calcDirectoryHash()
+            Uuid uuid;
+            Version version;
+            LocalizedNameMap names;
+            LocalizedDescriptionMap descriptions;
+            LocalizedKeywordsMap keywords;
+            Uuid parentUuid;            ///< only for categories (may be null)
+            QSet<Uuid> categories;      ///< not for categories
+            AttributeList attributes;   ///< only for components
+            QSet<Uuid> symbols;         ///< only for components
+            Uuid componentUuid;         ///< only for devices
+            Uuid packageUuid;           ///< only for devices
+        };
+
+        // Constructors / Destructor
+        LibraryIndex() = delete;
+        LibraryIndex(const LibraryIndex& other) = default;
+
+        /**
+         * @brief Load the index of a library
+         *
+         * @param libDir    The library directory
+         *
+         * @throw Exception If the index does not exist or could not be loaded
+         */
+        explicit LibraryIndex(const FilePath& libDir);
+        ~LibraryIndex() noexcept;
+
+        // Getters
+        const Uuid& getLibraryUuid() const noexcept {return mLibraryUuid;}
+        const Version& getLibraryVersion() const noexcept {return mLibraryVersion;}
+        const QHash<QString, Entry>& getEntries() const noexcept {return mEntries;}
+
+        /**
+         * @brief Get the entry of an element directory
+         *
+         * @param elementDir    The element directory
+         *
+         * @return The entry, or nullptr if the element is not contained in the index
+         */
+        const Entry* getEntry(const FilePath& elementDir) const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Write the index into the library directory
+         *
+         * @throw Exception If the file could not be written
+         */
+        void save() const;
+
+        /// @copydoc librepcb::SerializableObject::serialize()
+        void serialize(DomElement& root) const override;
+
+        // Operator Overloadings
+        LibraryIndex& operator=(const LibraryIndex& rhs) = default;
+
+        // Static Methods
+
+        /**
+         * @brief Generate the index of a library by parsing all of its elements
+         *
+         * @param libDir    The library directory
+         *
+         * @return The generated index (not saved yet, see #save())
+         *
+         * @throw Exception If the library or one of its elements could not be opened
+         */
+        static LibraryIndex create(const FilePath& libDir);
+
+        static FilePath getFilePath(const FilePath& libDir) noexcept {
+            return libDir.getPathTo("library_index.xml");
+        }
+
+        /**
+         * @brief Calculate the content hash of the files in a directory (not recursive)
+         */
+        static QString calcDirectoryHash(const FilePath& dir) noexcept;
+
+
+    private: // Methods
+
+        LibraryIndex(const FilePath& libDir, const Uuid& uuid, const Version& version) noexcept;
+        template <typename ElementType>
+        void addElements();
+        void addEntry(const LibraryBaseElement& element, Entry& entry) noexcept;
+        static void setEntryDetails(Entry& entry, const LibraryCategory& element) noexcept;
+        static void setEntryDetails(Entry& entry, const LibraryElement& element) noexcept;
+        static void setEntryDetails(Entry& entry, const Component& element) noexcept;
+        static void setEntryDetails(Entry& entry, const Device& element) noexcept;
+        static Entry loadEntry(const DomElement& node);
+
+
+    private: // Data
+
+        FilePath mLibraryDirectory;
+        Uuid mLibraryUuid;
+        Version mLibraryVersion;
+        QHash<QString, Entry> mEntries; ///< key: element directory relative to the library
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_LIBRARYINDEX_H
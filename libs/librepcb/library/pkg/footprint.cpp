@@ -91,13 +91,35 @@ void Footprint::unregisterGraphicsItem(FootprintGraphicsItem& item) noexcept
     mRegisteredGraphicsItem = nullptr;
 }
 
+CompactPolygonList Footprint::toCompactPolygons() const
+{
+    return mCompactPolygons ? *mCompactPolygons : CompactPolygonList(mPolygons); // can throw
+}
+
+void Footprint::compactPolygons() noexcept
+{
+    Q_ASSERT(!mRegisteredGraphicsItem);
+    if (mCompactPolygons) return;
+    try {
+        mCompactPolygons.reset(new CompactPolygonList(mPolygons)); // can throw
+        mPolygons.clear();
+    } catch (const Exception& e) {
+        qWarning() << "Keeping editable polygons of footprint" << mUuid.toStr() << ":"
+                   << e.getMsg();
+    }
+}
+
 void Footprint::serialize(DomElement& root) const
 {
     root.setAttribute("uuid", mUuid);
     mNames.serialize(root);
     mDescriptions.serialize(root);
     mPads.serialize(root);
-    mPolygons.serialize(root);
+    if (mCompactPolygons) {
+        mCompactPolygons->toPolygonList().serialize(root);
+    } else {
+        mPolygons.serialize(root);
+    }
     mEllipses.serialize(root);
     mTexts.serialize(root);
     mHoles.serialize(root);
@@ -113,7 +135,15 @@ bool Footprint::operator==(const Footprint& rhs) const noexcept
     if (mNames != rhs.mNames)                   return false;
     if (mDescriptions != rhs.mDescriptions)     return false;
     if (mPads != rhs.mPads)                     return false;
-    if (mPolygons != rhs.mPolygons)             return false;
+    if (mCompactPolygons || rhs.mCompactPolygons) {
+        try {
+            if (toCompactPolygons() != rhs.toCompactPolygons()) return false; // can throw
+        } catch (const Exception&) {
+            return false; // only one of them fits into the compact representation
+        }
+    } else if (mPolygons != rhs.mPolygons) {
+        return false;
+    }
     if (mEllipses != rhs.mEllipses)             return false;
     if (mTexts != rhs.mTexts)                   return false;
     if (mHoles != rhs.mHoles)                   return false;
@@ -126,7 +156,8 @@ Footprint& Footprint::operator=(const Footprint& rhs) noexcept
     mNames = rhs.mNames;
     mDescriptions = rhs.mDescriptions;
     mPads = rhs.mPads;
-    mPolygons = rhs.mPolygons;
+    mPolygons = rhs.mCompactPolygons ? rhs.mCompactPolygons->toPolygonList() : rhs.mPolygons;
+    mCompactPolygons.reset(); // copies are always editable
     mEllipses = rhs.mEllipses;
     mTexts = rhs.mTexts;
     mHoles = rhs.mHoles;
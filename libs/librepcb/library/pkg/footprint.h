@@ -30,6 +30,7 @@
 #include <librepcb/common/fileio/cmd/cmdlistelementremove.h>
 #include <librepcb/common/fileio/cmd/cmdlistelementsswap.h>
 #include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/compactpolygonlist.h>
 #include <librepcb/common/geometry/ellipse.h>
 #include <librepcb/common/geometry/text.h>
 #include <librepcb/common/geometry/hole.h>
@@ -84,6 +85,22 @@ class Footprint final : public SerializableObject, private FootprintPadList::IF_
         FootprintPadList& getPads() noexcept {return mPads;}
         const PolygonList& getPolygons() const noexcept {return mPolygons;}
         PolygonList& getPolygons() noexcept {return mPolygons;}
+
+        /**
+         * @brief Get the compact polygons (only available after #compactPolygons())
+         *
+         * @return The compact polygons, or nullptr if the editable polygons are available
+         */
+        const CompactPolygonList* getCompactPolygons() const noexcept {return mCompactPolygons.data();}
+
+        /**
+         * @brief Get the polygons in the compact representation (for read-only access)
+         *
+         * @return The compact polygons (created from #getPolygons() if required)
+         *
+         * @throw RangeError If the polygons are too large for the compact representation
+         */
+        CompactPolygonList toCompactPolygons() const;
         const EllipseList& getEllipses() const noexcept {return mEllipses;}
         EllipseList& getEllipses() noexcept {return mEllipses;}
         const TextList& getTexts() const noexcept {return mTexts;}
@@ -95,6 +112,20 @@ class Footprint final : public SerializableObject, private FootprintPadList::IF_
         void registerGraphicsItem(FootprintGraphicsItem& item) noexcept;
         void unregisterGraphicsItem(FootprintGraphicsItem& item) noexcept;
 
+        /**
+         * @brief Replace the editable polygons by the memory efficient compact polygons
+         *
+         * This is used for read-only library elements which are kept in memory (e.g. by
+         * librepcb::workspace::WorkspaceLibraryElementCache). Afterwards #getPolygons()
+         * is empty and read-only users have to use #getCompactPolygons() instead.
+         * Serialization and comparison still work as before, and copies of the footprint
+         * get editable polygons again. If the polygons are too large for the compact
+         * representation, they are kept unchanged.
+         *
+         * @warning Must not be called while a graphics item is registered.
+         */
+        void compactPolygons() noexcept;
+
 
         // General Methods
 
@@ -136,6 +167,7 @@ class Footprint final : public SerializableObject, private FootprintPadList::IF_
         LocalizedDescriptionMap mDescriptions;
         FootprintPadList mPads;
         PolygonList mPolygons;
+        QSharedPointer<const CompactPolygonList> mCompactPolygons; ///< see #compactPolygons()
         EllipseList mEllipses;
         TextList mTexts;
         HoleList mHoles;
@@ -104,50 +104,23 @@ int FootprintGraphicsItem::getItemsAtPosition(const Point& pos,
     QList<QSharedPointer<TextGraphicsItem> >* texts,
     QList<QSharedPointer<HoleGraphicsItem> >* holes) noexcept
 {
+    // the candidates are ordered top most first, so the lists are ordered the same way
     int count = 0;
-    if (pads) {
-        foreach (const QSharedPointer<FootprintPadGraphicsItem>& item, mPadGraphicsItems) {
-            QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-            if (item->shape().contains(mappedPos)) {
-                pads->append(item);
-                ++count;
-            }
+    foreach (QGraphicsItem* item, getChildItemsAt(pos.toPxQPointF())) {
+        QPointF mappedPos = mapToItem(item, pos.toPxQPointF());
+        if (!item->shape().contains(mappedPos)) {
+            continue;
         }
-    }
-    if (ellipses) {
-        foreach (const QSharedPointer<EllipseGraphicsItem>& item, mEllipseGraphicsItems) {
-            QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-            if (item->shape().contains(mappedPos)) {
-                ellipses->append(item);
-                ++count;
-            }
-        }
-    }
-    if (polygons) {
-        foreach (const QSharedPointer<PolygonGraphicsItem>& item, mPolygonGraphicsItems) {
-            QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-            if (item->shape().contains(mappedPos)) {
-                polygons->append(item);
-                ++count;
-            }
-        }
-    }
-    if (texts) {
-        foreach (const QSharedPointer<TextGraphicsItem>& item, mTextGraphicsItems) {
-            QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-            if (item->shape().contains(mappedPos)) {
-                texts->append(item);
-                ++count;
-            }
-        }
-    }
-    if (holes) {
-        foreach (const QSharedPointer<HoleGraphicsItem>& item, mHoleGraphicsItems) {
-            QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-            if (item->shape().contains(mappedPos)) {
-                holes->append(item);
-                ++count;
-            }
+        if (FootprintPadGraphicsItem* i = dynamic_cast<FootprintPadGraphicsItem*>(item)) {
+            if (pads) {pads->append(mPadGraphicsItems.value(&i->getPad())); ++count;}
+        } else if (EllipseGraphicsItem* i = dynamic_cast<EllipseGraphicsItem*>(item)) {
+            if (ellipses) {ellipses->append(mEllipseGraphicsItems.value(&i->getEllipse())); ++count;}
+        } else if (PolygonGraphicsItem* i = dynamic_cast<PolygonGraphicsItem*>(item)) {
+            if (polygons) {polygons->append(mPolygonGraphicsItems.value(&i->getPolygon())); ++count;}
+        } else if (TextGraphicsItem* i = dynamic_cast<TextGraphicsItem*>(item)) {
+            if (texts) {texts->append(mTextGraphicsItems.value(&i->getText())); ++count;}
+        } else if (HoleGraphicsItem* i = dynamic_cast<HoleGraphicsItem*>(item)) {
+            if (holes) {holes->append(mHoleGraphicsItems.value(&i->getHole())); ++count;}
         }
     }
     return count;
@@ -291,25 +264,21 @@ void FootprintGraphicsItem::setSelectionRect(const QRectF rect) noexcept
 {
     QPainterPath path;
     path.addRect(rect);
-    foreach (const QSharedPointer<FootprintPadGraphicsItem>& item, mPadGraphicsItems) {
-        QPainterPath mappedPath = mapToItem(item.data(), path);
-        item->setSelected(item->shape().intersects(mappedPath));
-    }
-    foreach (const QSharedPointer<EllipseGraphicsItem>& item, mEllipseGraphicsItems) {
-        QPainterPath mappedPath = mapToItem(item.data(), path);
-        item->setSelected(item->shape().intersects(mappedPath));
-    }
-    foreach (const QSharedPointer<PolygonGraphicsItem>& item, mPolygonGraphicsItems) {
-        QPainterPath mappedPath = mapToItem(item.data(), path);
-        item->setSelected(item->shape().intersects(mappedPath));
-    }
-    foreach (const QSharedPointer<TextGraphicsItem>& item, mTextGraphicsItems) {
-        QPainterPath mappedPath = mapToItem(item.data(), path);
-        item->setSelected(item->shape().intersects(mappedPath));
+
+    // only the items near the rect need to be checked for intersection, all others
+    // just need to be deselected if they were selected before
+    QSet<QGraphicsItem*> selectedItems;
+    foreach (QGraphicsItem* item, getChildItemsIn(rect.normalized())) {
+        QPainterPath mappedPath = mapToItem(item, path);
+        if (item->shape().intersects(mappedPath)) {
+            setChildItemSelected(*item, true);
+            selectedItems.insert(item);
+        }
     }
-    foreach (const QSharedPointer<HoleGraphicsItem>& item, mHoleGraphicsItems) {
-        QPainterPath mappedPath = mapToItem(item.data(), path);
-        item->setSelected(item->shape().intersects(mappedPath));
+    foreach (QGraphicsItem* item, childItems()) {
+        if (item->isSelected() && (!selectedItems.contains(item))) {
+            setChildItemSelected(*item, false);
+        }
     }
 }
 
@@ -324,6 +293,54 @@ void FootprintGraphicsItem::paint(QPainter* painter, const QStyleOptionGraphicsI
     Q_UNUSED(widget);
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QList<QGraphicsItem*> FootprintGraphicsItem::getChildItemsAt(const QPointF& pos) const noexcept
+{
+    if (!scene()) return childItems();
+    return mapToChildItems(scene()->items(mapToScene(pos), Qt::IntersectsItemBoundingRect,
+                                          Qt::DescendingOrder));
+}
+
+QList<QGraphicsItem*> FootprintGraphicsItem::getChildItemsIn(const QRectF& rect) const noexcept
+{
+    if (!scene()) return childItems();
+    return mapToChildItems(scene()->items(mapToScene(rect), Qt::IntersectsItemBoundingRect,
+                                          Qt::DescendingOrder));
+}
+
+QList<QGraphicsItem*> FootprintGraphicsItem::mapToChildItems(
+        const QList<QGraphicsItem*>& sceneItems) const noexcept
+{
+    // The candidates are found by the spatial index (BSP tree) of the scene instead of
+    // checking all child items. The scene also contains the children of our child items
+    // (e.g. the outline of a pad), thus they are mapped to our direct children.
+    QList<QGraphicsItem*> items;
+    QSet<QGraphicsItem*> visited;
+    foreach (QGraphicsItem* item, sceneItems) {
+        while (item && (item->parentItem() != this)) {
+            item = item->parentItem();
+        }
+        if (item && (!visited.contains(item))) {
+            visited.insert(item);
+            items.append(item);
+        }
+    }
+    return items;
+}
+
+void FootprintGraphicsItem::setChildItemSelected(QGraphicsItem& item, bool selected) noexcept
+{
+    // the pad graphics item needs to forward the selection to its children
+    if (FootprintPadGraphicsItem* pad = dynamic_cast<FootprintPadGraphicsItem*>(&item)) {
+        pad->setSelected(selected);
+    } else {
+        item.setSelected(selected);
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -115,6 +115,13 @@ class FootprintGraphicsItem final : public QGraphicsItem
         FootprintGraphicsItem& operator=(const FootprintGraphicsItem& rhs) = delete;
 
 
+    private: // Methods
+        QList<QGraphicsItem*> getChildItemsAt(const QPointF& pos) const noexcept;
+        QList<QGraphicsItem*> getChildItemsIn(const QRectF& rect) const noexcept;
+        QList<QGraphicsItem*> mapToChildItems(const QList<QGraphicsItem*>& sceneItems) const noexcept;
+        static void setChildItemSelected(QGraphicsItem& item, bool selected) noexcept;
+
+
     private: // Data
         Footprint& mFootprint;
         const IF_GraphicsLayerProvider& mLayerProvider;
@@ -28,6 +28,7 @@
 #include <librepcb/common/fileio/serializableobjectlist.h>
 #include <librepcb/common/fileio/cmd/cmdlistelementinsert.h>
 #include <librepcb/common/fileio/cmd/cmdlistelementremove.h>
+#include <librepcb/common/fileio/cmd/cmdlistelementsinsert.h>
 #include <librepcb/common/fileio/cmd/cmdlistelementsswap.h>
 #include <librepcb/common/units/all_length_units.h>
 #include <librepcb/common/uuid.h>
@@ -133,6 +134,7 @@ class FootprintPad final : public SerializableObject
 struct FootprintPadListNameProvider {static constexpr const char* tagname = "pad";};
 using FootprintPadList = SerializableObjectList<FootprintPad, FootprintPadListNameProvider>;
 using CmdFootprintPadInsert = CmdListElementInsert<FootprintPad, FootprintPadListNameProvider>;
+using CmdFootprintPadsInsert = CmdListElementsInsert<FootprintPad, FootprintPadListNameProvider>;
 using CmdFootprintPadRemove = CmdListElementRemove<FootprintPad, FootprintPadListNameProvider>;
 using CmdFootprintPadsSwap = CmdListElementsSwap<FootprintPad, FootprintPadListNameProvider>;
 
@@ -107,6 +107,16 @@ void FootprintPreviewGraphicsItem::updateCacheAndRepaint() noexcept
         mBoundingRect = mBoundingRect.united(polygonPath.boundingRect().adjusted(-w, -w, w, w));
         if (polygon.isGrabArea()) mShape = mShape.united(polygonPath);
     }
+    mCompactPolygonPaths.clear();
+    if (const CompactPolygonList* polygons = mFootprint.getCompactPolygons()) {
+        for (int i = 0; i < polygons->count(); ++i) {
+            QPainterPath polygonPath = polygons->toQPainterPathPx(i);
+            qreal w = polygons->getLineWidth(i).toPx() / 2;
+            mBoundingRect = mBoundingRect.united(polygonPath.boundingRect().adjusted(-w, -w, w, w));
+            if (polygons->isGrabArea(i)) mShape = mShape.united(polygonPath);
+            mCompactPolygonPaths.append(polygonPath);
+        }
+    }
 
     // texts
     mCachedTextProperties.clear();
@@ -212,6 +222,25 @@ void FootprintPreviewGraphicsItem::paint(QPainter* painter, const QStyleOptionGr
         // draw polygon
         painter->drawPath(polygon.toQPainterPathPx());
     }
+    if (const CompactPolygonList* polygons = mFootprint.getCompactPolygons()) {
+        for (int i = 0; i < polygons->count() && i < mCompactPolygonPaths.count(); ++i) {
+            layer = mLayerProvider.getLayer(polygons->getLayerName(i));
+            if (layer) {
+                painter->setPen(QPen(layer->getColor(selected), polygons->getLineWidth(i).toPx(),
+                                     Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+            } else {
+                painter->setPen(Qt::NoPen);
+            }
+            if (polygons->isFilled(i))
+                layer = mLayerProvider.getLayer(polygons->getLayerName(i));
+            else if (polygons->isGrabArea(i))
+                layer = mLayerProvider.getLayer(GraphicsLayer::sTopGrabAreas);
+            else
+                layer = nullptr;
+            painter->setBrush(layer ? QBrush(layer->getColor(selected), Qt::SolidPattern) : Qt::NoBrush);
+            painter->drawPath(mCompactPolygonPaths.at(i));
+        }
+    }
 
     // draw all ellipses
     for (const Ellipse& ellipse : mFootprint.getEllipses()) {
@@ -123,6 +123,7 @@ class FootprintPreviewGraphicsItem final : public QGraphicsItem, public IF_Attri
         QRectF mBoundingRect;
         QPainterPath mShape;
         QHash<const Text*, CachedTextProperties_t> mCachedTextProperties;
+        QVector<QPainterPath> mCompactPolygonPaths; ///< paths of compact polygons (if any)
 };
 
 /*****************************************************************************************
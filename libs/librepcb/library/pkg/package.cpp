@@ -56,6 +56,36 @@ Package::~Package() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+qint64 Package::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = LibraryElement::getApproximateMemoryUsage();
+    size += mPads.count() * sizeof(PackagePad);
+    for (const Footprint& footprint : mFootprints) {
+        size += sizeof(Footprint) + footprint.getPads().count() * sizeof(FootprintPad);
+        for (const Polygon& polygon : footprint.getPolygons()) {
+            size += sizeof(Polygon) + polygon.getSegments().count() * sizeof(PolygonSegment);
+        }
+        if (footprint.getCompactPolygons()) {
+            size += footprint.getCompactPolygons()->getMemoryUsage();
+        }
+        size += footprint.getEllipses().count() * sizeof(Ellipse);
+        size += footprint.getTexts().count() * sizeof(Text);
+        size += footprint.getHoles().count() * sizeof(Hole);
+    }
+    return size;
+}
+
+void Package::compactPolygons() noexcept
+{
+    for (Footprint& footprint : mFootprints) {
+        footprint.compactPolygons();
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
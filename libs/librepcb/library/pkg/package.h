@@ -73,6 +73,18 @@ class Package final : public LibraryElement
         FootprintList& getFootprints() noexcept {return mFootprints;}
         const FootprintList& getFootprints() const noexcept {return mFootprints;}
 
+        // General Methods
+
+        /// @copydoc librepcb::library::LibraryBaseElement::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
+        /**
+         * @brief Compact the polygons of all footprints
+         *
+         * @see librepcb::library::Footprint::compactPolygons()
+         */
+        void compactPolygons() noexcept;
+
         // Operator Overloadings
         Package& operator=(const Package& rhs) = delete;
 
@@ -27,6 +27,7 @@
 #include <librepcb/common/fileio/serializableobjectlist.h>
 #include <librepcb/common/fileio/cmd/cmdlistelementinsert.h>
 #include <librepcb/common/fileio/cmd/cmdlistelementremove.h>
+#include <librepcb/common/fileio/cmd/cmdlistelementsinsert.h>
 #include <librepcb/common/fileio/cmd/cmdlistelementsswap.h>
 
 /*****************************************************************************************
@@ -93,6 +94,7 @@ class PackagePad final : public SerializableObject
 struct PackagePadListNameProvider {static constexpr const char* tagname = "pad";};
 using PackagePadList = SerializableObjectList<PackagePad, PackagePadListNameProvider>;
 using CmdPackagePadInsert = CmdListElementInsert<PackagePad, PackagePadListNameProvider>;
+using CmdPackagePadsInsert = CmdListElementsInsert<PackagePad, PackagePadListNameProvider>;
 using CmdPackagePadRemove = CmdListElementRemove<PackagePad, PackagePadListNameProvider>;
 using CmdPackagePadsSwap = CmdListElementsSwap<PackagePad, PackagePadListNameProvider>;
 
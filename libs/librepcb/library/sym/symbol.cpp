@@ -80,6 +80,39 @@ void Symbol::unregisterGraphicsItem(SymbolGraphicsItem& item) noexcept
     mRegisteredGraphicsItem = nullptr;
 }
 
+CompactPolygonList Symbol::toCompactPolygons() const
+{
+    return mCompactPolygons ? *mCompactPolygons : CompactPolygonList(mPolygons); // can throw
+}
+
+void Symbol::compactPolygons() noexcept
+{
+    Q_ASSERT(!mRegisteredGraphicsItem);
+    if (mCompactPolygons) return;
+    try {
+        mCompactPolygons.reset(new CompactPolygonList(mPolygons)); // can throw
+        mPolygons.clear();
+    } catch (const Exception& e) {
+        qWarning() << "Keeping editable polygons of symbol" << getUuid().toStr() << ":"
+                   << e.getMsg();
+    }
+}
+
+qint64 Symbol::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = LibraryElement::getApproximateMemoryUsage();
+    size += mPins.count() * sizeof(SymbolPin);
+    for (const Polygon& polygon : mPolygons) {
+        size += sizeof(Polygon) + polygon.getSegments().count() * sizeof(PolygonSegment);
+    }
+    if (mCompactPolygons) {
+        size += mCompactPolygons->getMemoryUsage();
+    }
+    size += mEllipses.count() * sizeof(Ellipse);
+    size += mTexts.count() * sizeof(Text);
+    return size;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -152,7 +185,11 @@ void Symbol::serialize(DomElement& root) const
 {
     LibraryElement::serialize(root);
     mPins.serialize(root);
-    mPolygons.serialize(root);
+    if (mCompactPolygons) {
+        mCompactPolygons->toPolygonList().serialize(root);
+    } else {
+        mPolygons.serialize(root);
+    }
     mEllipses.serialize(root);
     mTexts.serialize(root);
 }
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/compactpolygonlist.h>
 #include <librepcb/common/geometry/ellipse.h>
 #include <librepcb/common/geometry/text.h>
 #include "../libraryelement.h"
@@ -73,6 +74,22 @@ class Symbol final : public LibraryElement, private SymbolPinList::IF_Observer,
         const SymbolPinList& getPins() const noexcept {return mPins;}
         PolygonList& getPolygons() noexcept {return mPolygons;}
         const PolygonList& getPolygons() const noexcept {return mPolygons;}
+
+        /**
+         * @brief Get the compact polygons (only available after #compactPolygons())
+         *
+         * @return The compact polygons, or nullptr if the editable polygons are available
+         */
+        const CompactPolygonList* getCompactPolygons() const noexcept {return mCompactPolygons.data();}
+
+        /**
+         * @brief Get the polygons in the compact representation (for read-only access)
+         *
+         * @return The compact polygons (created from #getPolygons() if required)
+         *
+         * @throw RangeError If the polygons are too large for the compact representation
+         */
+        CompactPolygonList toCompactPolygons() const;
         EllipseList& getEllipses() noexcept {return mEllipses;}
         const EllipseList& getEllipses() const noexcept {return mEllipses;}
         TextList& getTexts() noexcept {return mTexts;}
@@ -82,6 +99,16 @@ class Symbol final : public LibraryElement, private SymbolPinList::IF_Observer,
         void registerGraphicsItem(SymbolGraphicsItem& item) noexcept;
         void unregisterGraphicsItem(SymbolGraphicsItem& item) noexcept;
 
+        /**
+         * @brief Replace the editable polygons by the memory efficient compact polygons
+         *
+         * @see librepcb::library::Footprint::compactPolygons()
+         */
+        void compactPolygons() noexcept;
+
+        /// @copydoc librepcb::library::LibraryBaseElement::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
         // Operator Overloadings
         Symbol& operator=(const Symbol& rhs) = delete;
 
@@ -115,6 +142,7 @@ class Symbol final : public LibraryElement, private SymbolPinList::IF_Observer,
     private: // Data
         SymbolPinList mPins;
         PolygonList mPolygons;
+        QSharedPointer<const CompactPolygonList> mCompactPolygons; ///< see #compactPolygons()
         EllipseList mEllipses;
         TextList mTexts;
 
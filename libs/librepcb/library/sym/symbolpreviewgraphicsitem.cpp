@@ -120,6 +120,16 @@ void SymbolPreviewGraphicsItem::updateCacheAndRepaint() noexcept
         mBoundingRect = mBoundingRect.united(polygonPath.boundingRect().adjusted(-w, -w, w, w));
         if (polygon.isGrabArea()) mShape = mShape.united(polygonPath);
     }
+    mCompactPolygonPaths.clear();
+    if (const CompactPolygonList* polygons = mSymbol.getCompactPolygons()) {
+        for (int i = 0; i < polygons->count(); ++i) {
+            QPainterPath polygonPath = polygons->toQPainterPathPx(i);
+            qreal w = polygons->getLineWidth(i).toPx() / 2;
+            mBoundingRect = mBoundingRect.united(polygonPath.boundingRect().adjusted(-w, -w, w, w));
+            if (polygons->isGrabArea(i)) mShape = mShape.united(polygonPath);
+            mCompactPolygonPaths.append(polygonPath);
+        }
+    }
 
     // texts
     mCachedTextProperties.clear();
@@ -224,6 +234,25 @@ void SymbolPreviewGraphicsItem::paint(QPainter* painter, const QStyleOptionGraph
         // draw polygon
         painter->drawPath(polygon.toQPainterPathPx());
     }
+    if (const CompactPolygonList* polygons = mSymbol.getCompactPolygons()) {
+        for (int i = 0; i < polygons->count() && i < mCompactPolygonPaths.count(); ++i) {
+            layer = mLayerProvider.getLayer(polygons->getLayerName(i));
+            if (layer) {
+                painter->setPen(QPen(layer->getColor(selected), polygons->getLineWidth(i).toPx(),
+                                     Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+            } else {
+                painter->setPen(Qt::NoPen);
+            }
+            if (polygons->isFilled(i))
+                layer = mLayerProvider.getLayer(polygons->getLayerName(i));
+            else if (polygons->isGrabArea(i))
+                layer = mLayerProvider.getLayer(GraphicsLayer::sSymbolGrabAreas);
+            else
+                layer = nullptr;
+            painter->setBrush(layer ? QBrush(layer->getColor(selected), Qt::SolidPattern) : Qt::NoBrush);
+            painter->drawPath(mCompactPolygonPaths.at(i));
+        }
+    }
 
     // draw all ellipses
     for (const Ellipse& ellipse : mSymbol.getEllipses()) {
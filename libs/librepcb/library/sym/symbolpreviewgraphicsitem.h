@@ -121,6 +121,7 @@ class SymbolPreviewGraphicsItem final : public QGraphicsItem, public IF_Attribut
         QRectF mBoundingRect;
         QPainterPath mShape;
         QHash<const Text*, CachedTextProperties_t> mCachedTextProperties;
+        QVector<QPainterPath> mCompactPolygonPaths; ///< paths of compact polygons (if any)
 };
 
 /*****************************************************************************************
@@ -39,9 +39,9 @@ namespace editor {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-ComponentEditorWidget::ComponentEditorWidget(const Context& context, const FilePath& fp,
-                                             QWidget* parent) :
-    EditorWidgetBase(context, fp, parent), mUi(new Ui::ComponentEditorWidget)
+ComponentEditorWidget::ComponentEditorWidget(const Context& context,
+        std::unique_ptr<Component> component, QWidget* parent) :
+    EditorWidgetBase(context, component->getFilePath(), parent), mUi(new Ui::ComponentEditorWidget)
 {
     mUi->setupUi(this);
     setWindowIcon(QIcon(":/img/library/component.png"));
@@ -53,8 +53,8 @@ ComponentEditorWidget::ComponentEditorWidget(const Context& context, const FileP
     mUi->formLayout->getWidgetPosition(mUi->lblCategories, &row, &role);
     mUi->formLayout->setWidget(row, QFormLayout::FieldRole, mCategoriesEditorWidget.data());
 
-    // load component
-    mComponent.reset(new Component(fp, false)); // can throw
+    // take over the loaded component
+    mComponent.reset(component.release());
     setWindowTitle(mComponent->getNames().value(getLibLocaleOrder()));
     mUi->lblUuid->setText(QString("<a href=\"%1\">%2</a>").arg(
         mComponent->getFilePath().toQUrl().toString(), mComponent->getUuid().toStr()));
@@ -180,6 +180,44 @@ bool ComponentEditorWidget::isInterfaceBroken() const noexcept
     return false;
 }
 
+std::function<QStringList()> ComponentEditorWidget::prepareChecks() const noexcept
+{
+    QString name = mUi->edtName->text();
+    QString version = mUi->edtVersion->text();
+    QList<QPair<Uuid, QString>> signalNames;
+    for (const ComponentSignal& signal : mComponent->getSignals()) {
+        signalNames.append(qMakePair(signal.getUuid(), signal.getName()));
+    }
+    // the signals which are connected to at least one pin, for each symbol variant
+    QList<QPair<QString, QSet<Uuid>>> variants;
+    for (const ComponentSymbolVariant& variant : mComponent->getSymbolVariants()) {
+        QSet<Uuid> connectedSignals;
+        for (const ComponentSymbolVariantItem& item : variant.getSymbolItems()) {
+            for (const ComponentPinSignalMapItem& map : item.getPinSignalMap()) {
+                connectedSignals.insert(map.getSignalUuid());
+            }
+        }
+        variants.append(qMakePair(variant.getNames().value(getLibLocaleOrder()),
+                                  connectedSignals));
+    }
+    return [name, version, signalNames, variants]() {
+        QStringList messages = checkNameAndVersion(name, version);
+        if (variants.isEmpty()) {
+            messages.append(tr("The component has no symbol variant."));
+        }
+        for (const QPair<QString, QSet<Uuid>>& variant : variants) {
+            for (const QPair<Uuid, QString>& signal : signalNames) {
+                if (!variant.second.contains(signal.first)) {
+                    messages.append(tr("The signal \"%1\" is not connected to any pin in "
+                                       "the symbol variant \"%2\".")
+                                    .arg(signal.second, variant.first));
+                }
+            }
+        }
+        return messages;
+    };
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
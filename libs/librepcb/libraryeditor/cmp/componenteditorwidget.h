@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/exceptions.h>
@@ -68,7 +69,7 @@ class ComponentEditorWidget final : public EditorWidgetBase,
         // Constructors / Destructor
         ComponentEditorWidget() = delete;
         ComponentEditorWidget(const ComponentEditorWidget& other) = delete;
-        ComponentEditorWidget(const Context& context, const FilePath& fp,
+        ComponentEditorWidget(const Context& context, std::unique_ptr<Component> component,
                               QWidget* parent = nullptr);
         ~ComponentEditorWidget() noexcept;
 
@@ -84,6 +85,7 @@ class ComponentEditorWidget final : public EditorWidgetBase,
         bool openComponentSymbolVariantEditor(ComponentSymbolVariant& variant) noexcept override;
         void memorizeComponentInterface() noexcept;
         bool isInterfaceBroken() const noexcept override;
+        std::function<QStringList()> prepareChecks() const noexcept override;
 
 
     private: // Data
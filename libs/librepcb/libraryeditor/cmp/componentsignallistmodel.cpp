@@ -0,0 +1,409 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "componentsignallistmodel.h"
+#include <librepcb/common/undostack.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/library/cmp/cmd/cmdcomponentsignaledit.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ComponentSignalListModel::ComponentSignalListModel(QWidget* parent) noexcept :
+    QAbstractTableModel(parent), mUndoStack(nullptr), mSignalList(nullptr),
+    mNewIsRequired(false), mNewIsNegated(false), mNewIsClock(false)
+{
+}
+
+ComponentSignalListModel::~ComponentSignalListModel() noexcept
+{
+    setReferences(nullptr, nullptr);
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool ComponentSignalListModel::isNewSignalRow(int row) const noexcept
+{
+    return mSignalList && (row == mSignalList->count());
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void ComponentSignalListModel::setReferences(UndoStack* undoStack,
+                                             ComponentSignalList* list) noexcept
+{
+    beginResetModel();
+    if (mSignalList) {
+        mSignalList->unregisterObserver(this);
+        for (const ComponentSignal& signal : *mSignalList) {
+            disconnect(&signal, &ComponentSignal::edited,
+                       this, &ComponentSignalListModel::signalEdited);
+        }
+    }
+    mUndoStack = undoStack;
+    mSignalList = list;
+    if (mSignalList) {
+        mSignalList->registerObserver(this);
+        for (const ComponentSignal& signal : *mSignalList) {
+            connect(&signal, &ComponentSignal::edited,
+                    this, &ComponentSignalListModel::signalEdited);
+        }
+    }
+    endResetModel();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void ComponentSignalListModel::addSignal() noexcept
+{
+    if (!mSignalList) return;
+    try {
+        throwIfNameEmptyOrExists(mNewName); // can throw
+        std::shared_ptr<ComponentSignal> signal(new ComponentSignal(Uuid::createRandom(), mNewName));
+        signal->setIsRequired(mNewIsRequired);
+        signal->setIsNegated(mNewIsNegated);
+        signal->setIsClock(mNewIsClock);
+        signal->setForcedNetName(mNewForcedNetName);
+        if (mUndoStack) {
+            mUndoStack->execCmd(new CmdComponentSignalInsert(*mSignalList, signal)); // can throw
+        } else {
+            mSignalList->append(signal);
+        }
+
+        // reset the row for adding a new signal (which is the last row)
+        mNewName.clear();
+        mNewForcedNetName.clear();
+        int row = mSignalList->count();
+        emit dataChanged(index(row, 0), index(row, _COLUMN_COUNT - 1));
+    } catch (const Exception& e) {
+        QMessageBox::critical(getParentWidget(), tr("Could not add signal"), e.getMsg());
+    }
+}
+
+void ComponentSignalListModel::removeSignal(int row) noexcept
+{
+    if ((!mSignalList) || (row < 0) || (row >= mSignalList->count())) return;
+    try {
+        if (mUndoStack) {
+            const ComponentSignal* signal = mSignalList->at(row).get();
+            mUndoStack->execCmd(new CmdComponentSignalRemove(*mSignalList, signal)); // can throw
+        } else {
+            mSignalList->remove(row);
+        }
+    } catch (const Exception& e) {
+        QMessageBox::critical(getParentWidget(), tr("Could not remove signal"), e.getMsg());
+    }
+}
+
+/*****************************************************************************************
+ *  Inherited from QAbstractItemModel
+ ****************************************************************************************/
+
+int ComponentSignalListModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || (!mSignalList)) return 0;
+    return mSignalList->count() + 1; // the last row is used to add new signals
+}
+
+int ComponentSignalListModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : _COLUMN_COUNT;
+}
+
+QVariant ComponentSignalListModel::data(const QModelIndex& index, int role) const
+{
+    if ((!index.isValid()) || (!mSignalList)) return QVariant();
+    std::shared_ptr<const ComponentSignal> signal = mSignalList->value(index.row());
+    bool isNewRow = (!signal);
+
+    switch (index.column()) {
+        case COLUMN_NAME: {
+            if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
+                return isNewRow ? mNewName : signal->getName();
+            }
+            break;
+        }
+        case COLUMN_ISREQUIRED:
+        case COLUMN_ISNEGATED:
+        case COLUMN_ISCLOCK: {
+            if (role == Qt::CheckStateRole) {
+                bool checked;
+                if (index.column() == COLUMN_ISREQUIRED) {
+                    checked = isNewRow ? mNewIsRequired : signal->isRequired();
+                } else if (index.column() == COLUMN_ISNEGATED) {
+                    checked = isNewRow ? mNewIsNegated : signal->isNegated();
+                } else {
+                    checked = isNewRow ? mNewIsClock : signal->isClock();
+                }
+                return checked ? Qt::Checked : Qt::Unchecked;
+            }
+            break;
+        }
+        case COLUMN_FORCEDNETNAME: {
+            if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
+                return isNewRow ? mNewForcedNetName : signal->getForcedNetName();
+            }
+            break;
+        }
+        case COLUMN_ACTIONS: {
+            if (role == Qt::DecorationRole) {
+                return QIcon(isNewRow ? ":/img/actions/add.png" : ":/img/actions/minus.png");
+            } else if (role == Qt::ToolTipRole) {
+                return isNewRow ? tr("Add signal") : tr("Remove signal");
+            }
+            break;
+        }
+        default: break;
+    }
+    return QVariant();
+}
+
+QVariant ComponentSignalListModel::headerData(int section, Qt::Orientation orientation,
+                                              int role) const
+{
+    if (orientation == Qt::Horizontal) {
+        if (role == Qt::DisplayRole) {
+            switch (section) {
+                case COLUMN_NAME:           return tr("Name");
+                case COLUMN_ISREQUIRED:     return tr("Required");
+                case COLUMN_ISNEGATED:      return tr("Negated");
+                case COLUMN_ISCLOCK:        return tr("Clock");
+                case COLUMN_FORCEDNETNAME:  return tr("Forced Net");
+                default:                    return QVariant();
+            }
+        }
+    } else if (mSignalList) {
+        std::shared_ptr<const ComponentSignal> signal = mSignalList->value(section);
+        if (role == Qt::DisplayRole) {
+            return signal ? QString(signal->getUuid().toStr().left(13) % "...")
+                          : tr("Add new signal:");
+        } else if ((role == Qt::ToolTipRole) && signal) {
+            return signal->getUuid().toStr();
+        } else if (role == Qt::FontRole) {
+            QFont font;
+            font.setStyleHint(QFont::Monospace); // ensure that the column width is fixed
+            font.setFamily("Monospace");
+            return font;
+        }
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags ComponentSignalListModel::flags(const QModelIndex& index) const
+{
+    Qt::ItemFlags f = QAbstractTableModel::flags(index);
+    switch (index.column()) {
+        case COLUMN_NAME:
+        case COLUMN_FORCEDNETNAME:  return f | Qt::ItemIsEditable;
+        case COLUMN_ISREQUIRED:
+        case COLUMN_ISNEGATED:
+        case COLUMN_ISCLOCK:        return f | Qt::ItemIsUserCheckable;
+        default:                    return f;
+    }
+}
+
+bool ComponentSignalListModel::setData(const QModelIndex& index, const QVariant& value,
+                                       int role)
+{
+    if ((!index.isValid()) || (!mSignalList)) return false;
+    std::shared_ptr<ComponentSignal> signal = mSignalList->value(index.row());
+    bool result = false;
+
+    if ((index.column() == COLUMN_NAME) && (role == Qt::EditRole)) {
+        if (signal) {
+            result = setName(*signal, cleanName(value.toString()));
+        } else {
+            mNewName = cleanName(value.toString());
+            result = true;
+        }
+    } else if ((index.column() == COLUMN_FORCEDNETNAME) && (role == Qt::EditRole)) {
+        if (signal) {
+            result = setForcedNetName(*signal, cleanName(value.toString()));
+        } else {
+            mNewForcedNetName = cleanName(value.toString());
+            result = true;
+        }
+    } else if (role == Qt::CheckStateRole) {
+        bool checked = (value.toInt() == Qt::Checked);
+        if (signal) {
+            setFlag(*signal, index.column(), checked);
+        } else if (index.column() == COLUMN_ISREQUIRED) {
+            mNewIsRequired = checked;
+        } else if (index.column() == COLUMN_ISNEGATED) {
+            mNewIsNegated = checked;
+        } else if (index.column() == COLUMN_ISCLOCK) {
+            mNewIsClock = checked;
+        }
+        result = true;
+    }
+
+    // modified signals are notified by signalEdited()
+    if (result && (!signal)) {
+        emit dataChanged(index, index);
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void ComponentSignalListModel::signalEdited() noexcept
+{
+    const ComponentSignal* signal = qobject_cast<const ComponentSignal*>(sender());
+    int row = (signal && mSignalList) ? mSignalList->indexOf(signal->getUuid()) : -1;
+    if (row >= 0) {
+        emit dataChanged(index(row, 0), index(row, _COLUMN_COUNT - 1));
+        emit headerDataChanged(Qt::Vertical, row, row);
+    }
+}
+
+bool ComponentSignalListModel::setName(ComponentSignal& signal, const QString& name) noexcept
+{
+    if (signal.getName() == name) return true;
+    try {
+        throwIfNameEmptyOrExists(name); // can throw
+        QScopedPointer<CmdComponentSignalEdit> cmd(new CmdComponentSignalEdit(signal));
+        cmd->setName(name);
+        execCmd(cmd.take()); // can throw
+        return true;
+    } catch (const Exception& e) {
+        QMessageBox::critical(getParentWidget(), tr("Could not edit signal"), e.getMsg());
+        return false;
+    }
+}
+
+void ComponentSignalListModel::setFlag(ComponentSignal& signal, int column, bool value) noexcept
+{
+    try {
+        QScopedPointer<CmdComponentSignalEdit> cmd(new CmdComponentSignalEdit(signal));
+        if ((column == COLUMN_ISREQUIRED) && (signal.isRequired() != value)) {
+            cmd->setIsRequired(value);
+        } else if ((column == COLUMN_ISNEGATED) && (signal.isNegated() != value)) {
+            cmd->setIsNegated(value);
+        } else if ((column == COLUMN_ISCLOCK) && (signal.isClock() != value)) {
+            cmd->setIsClock(value);
+        } else {
+            return;
+        }
+        execCmd(cmd.take()); // can throw
+    } catch (const Exception& e) {
+        QMessageBox::critical(getParentWidget(), tr("Could not edit signal"), e.getMsg());
+    }
+}
+
+bool ComponentSignalListModel::setForcedNetName(ComponentSignal& signal,
+                                                const QString& name) noexcept
+{
+    if (signal.getForcedNetName() == name) return true;
+    try {
+        QScopedPointer<CmdComponentSignalEdit> cmd(new CmdComponentSignalEdit(signal));
+        cmd->setForcedNetName(name);
+        execCmd(cmd.take()); // can throw
+        return true;
+    } catch (const Exception& e) {
+        QMessageBox::critical(getParentWidget(), tr("Could not edit signal"), e.getMsg());
+        return false;
+    }
+}
+
+void ComponentSignalListModel::execCmd(UndoCommand* cmd)
+{
+    if (mUndoStack) {
+        mUndoStack->execCmd(cmd); // can throw
+    } else {
+        QScopedPointer<UndoCommand> guardedCmd(cmd);
+        guardedCmd->execute(); // can throw
+    }
+}
+
+void ComponentSignalListModel::throwIfNameEmptyOrExists(const QString& name) const
+{
+    if (name.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, tr("The name must not be empty."));
+    }
+    if (mSignalList->contains(name)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("There is already a signal with the name \"%1\".")).arg(name));
+    }
+}
+
+QString ComponentSignalListModel::cleanName(const QString& name) noexcept
+{
+    // TODO: it's ugly to use a method from FilePath...
+    return FilePath::cleanFileName(name, FilePath::ReplaceSpaces | FilePath::KeepCase);
+}
+
+QWidget* ComponentSignalListModel::getParentWidget() const noexcept
+{
+    return qobject_cast<QWidget*>(QObject::parent());
+}
+
+/*****************************************************************************************
+ *  Observer Methods
+ ****************************************************************************************/
+
+void ComponentSignalListModel::listObjectAdded(const ComponentSignalList& list,
+    int newIndex, const std::shared_ptr<ComponentSignal>& ptr) noexcept
+{
+    Q_ASSERT(&list == mSignalList); Q_UNUSED(list);
+    connect(ptr.get(), &ComponentSignal::edited,
+            this, &ComponentSignalListModel::signalEdited);
+    // the element is already inserted, but the additional row for new signals makes
+    // sure the row count is still valid for beginInsertRows()
+    beginInsertRows(QModelIndex(), newIndex, newIndex);
+    endInsertRows();
+}
+
+void ComponentSignalListModel::listObjectRemoved(const ComponentSignalList& list,
+    int oldIndex, const std::shared_ptr<ComponentSignal>& ptr) noexcept
+{
+    Q_ASSERT(&list == mSignalList); Q_UNUSED(list);
+    disconnect(ptr.get(), &ComponentSignal::edited,
+               this, &ComponentSignalListModel::signalEdited);
+    beginRemoveRows(QModelIndex(), oldIndex, oldIndex);
+    endRemoveRows();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
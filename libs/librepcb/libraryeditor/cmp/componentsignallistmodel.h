@@ -0,0 +1,138 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_EDITOR_COMPONENTSIGNALLISTMODEL_H
+#define LIBREPCB_LIBRARY_EDITOR_COMPONENTSIGNALLISTMODEL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcb/library/cmp/componentsignal.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class UndoStack;
+class UndoCommand;
+
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Class ComponentSignalListModel
+ ****************************************************************************************/
+
+/**
+ * @brief The ComponentSignalListModel class is a table model for a
+ *        librepcb::library::ComponentSignalList
+ *
+ * The model reads directly from the list and is updated by its observer methods, so
+ * views only need to create widgets for the visible rows (even for components with
+ * thousands of signals). The last row is a special row to add a new signal.
+ */
+class ComponentSignalListModel final : public QAbstractTableModel,
+                                       private ComponentSignalList::IF_Observer
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        enum Column {
+            COLUMN_NAME = 0,
+            COLUMN_ISREQUIRED,
+            COLUMN_ISNEGATED,
+            COLUMN_ISCLOCK,
+            COLUMN_FORCEDNETNAME,
+            COLUMN_ACTIONS,
+            _COLUMN_COUNT
+        };
+
+        // Constructors / Destructor
+        ComponentSignalListModel() = delete;
+        ComponentSignalListModel(const ComponentSignalListModel& other) = delete;
+        explicit ComponentSignalListModel(QWidget* parent) noexcept;
+        ~ComponentSignalListModel() noexcept;
+
+        // Getters
+        bool isNewSignalRow(int row) const noexcept;
+
+        // Setters
+        void setReferences(UndoStack* undoStack, ComponentSignalList* list) noexcept;
+
+        // General Methods
+        void addSignal() noexcept;
+        void removeSignal(int row) noexcept;
+
+        // Inherited from QAbstractItemModel
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant headerData(int section, Qt::Orientation orientation,
+                            int role = Qt::DisplayRole) const override;
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        bool setData(const QModelIndex& index, const QVariant& value,
+                     int role = Qt::EditRole) override;
+
+        // Operator Overloadings
+        ComponentSignalListModel& operator=(const ComponentSignalListModel& rhs) = delete;
+
+
+    private: // Methods
+        void signalEdited() noexcept;
+        bool setName(ComponentSignal& signal, const QString& name) noexcept;
+        void setFlag(ComponentSignal& signal, int column, bool value) noexcept;
+        bool setForcedNetName(ComponentSignal& signal, const QString& name) noexcept;
+        void execCmd(UndoCommand* cmd);
+        void throwIfNameEmptyOrExists(const QString& name) const;
+        static QString cleanName(const QString& name) noexcept;
+        QWidget* getParentWidget() const noexcept;
+
+        // Observer Methods
+        void listObjectAdded(const ComponentSignalList& list, int newIndex,
+                             const std::shared_ptr<ComponentSignal>& ptr) noexcept override;
+        void listObjectRemoved(const ComponentSignalList& list, int oldIndex,
+                               const std::shared_ptr<ComponentSignal>& ptr) noexcept override;
+
+
+    private: // Data
+        UndoStack* mUndoStack;
+        ComponentSignalList* mSignalList;
+
+        // attributes of the signal to add (see #addSignal())
+        QString mNewName;
+        bool mNewIsRequired;
+        bool mNewIsNegated;
+        bool mNewIsClock;
+        QString mNewForcedNetName;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_EDITOR_COMPONENTSIGNALLISTMODEL_H
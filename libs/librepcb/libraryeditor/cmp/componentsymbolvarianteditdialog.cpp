@@ -27,10 +27,11 @@
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/cmp/componentsymbolvariant.h>
 #include <librepcb/library/sym/symbol.h>
-#include <librepcb/library/sym/symbolgraphicsitem.h>
+#include <librepcb/library/sym/symbolpreviewgraphicsitem.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -99,12 +100,13 @@ void ComponentSymbolVariantEditDialog::updateGraphicsItems() noexcept
     for (const ComponentSymbolVariantItem& item : mSymbVar.getSymbolItems()) {
         try {
             FilePath fp = mWorkspace.getLibraryDb().getLatestSymbol(item.getSymbolUuid()); // can throw
-            std::shared_ptr<Symbol> sym = std::make_shared<Symbol>(fp, true); // can throw
+            std::shared_ptr<const Symbol> sym =
+                mWorkspace.getLibraryElementCache().getElement<Symbol>(fp); // can throw
             mSymbols.append(sym);
-            std::shared_ptr<SymbolGraphicsItem> graphicsItem =
-                std::make_shared<SymbolGraphicsItem>(*sym, mLayerProvider);
-            graphicsItem->setPosition(item.getSymbolPosition());
-            graphicsItem->setRotation(item.getSymbolRotation());
+            std::shared_ptr<SymbolPreviewGraphicsItem> graphicsItem =
+                std::make_shared<SymbolPreviewGraphicsItem>(mLayerProvider, QStringList(), *sym);
+            graphicsItem->setPos(item.getSymbolPosition().toPxQPointF());
+            graphicsItem->setRotation(-item.getSymbolRotation().toDeg());
             mGraphicsScene->addItem(*graphicsItem);
             mGraphicsItems.append(graphicsItem);
         } catch (const Exception& e) {
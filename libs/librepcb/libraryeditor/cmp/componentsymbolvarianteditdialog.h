@@ -44,7 +44,7 @@ namespace library {
 
 class Component;
 class Symbol;
-class SymbolGraphicsItem;
+class SymbolPreviewGraphicsItem;
 
 namespace editor {
 
@@ -95,8 +95,8 @@ class ComponentSymbolVariantEditDialog final : public QDialog
         QScopedPointer<Ui::ComponentSymbolVariantEditDialog> mUi;
         QScopedPointer<GraphicsScene> mGraphicsScene;
 
-        QList<std::shared_ptr<Symbol>> mSymbols;
-        QList<std::shared_ptr<SymbolGraphicsItem>> mGraphicsItems;
+        QList<std::shared_ptr<const Symbol>> mSymbols;
+        QList<std::shared_ptr<SymbolPreviewGraphicsItem>> mGraphicsItems;
 };
 
 /*****************************************************************************************
@@ -32,7 +32,6 @@
  ****************************************************************************************/
 namespace librepcb {
 
-class CenteredCheckBox;
 class IF_GraphicsLayerProvider;
 
 namespace workspace {
@@ -42,6 +41,8 @@ class Workspace;
 namespace library {
 namespace editor {
 
+class ComponentSymbolVariantItemListModel;
+
 /*****************************************************************************************
  *  Class ComponentSymbolVariantItemListEditorWidget
  ****************************************************************************************/
@@ -49,6 +50,9 @@ namespace editor {
 /**
  * @brief The ComponentSymbolVariantItemListEditorWidget class
  *
+ * The items are shown in a QTableView backed by a ComponentSymbolVariantItemListModel.
+ * Double-click a symbol cell to choose another symbol.
+ *
  * @author ubruhin
  * @date 2017-03-19
  */
@@ -56,20 +60,6 @@ class ComponentSymbolVariantItemListEditorWidget final : public QWidget
 {
         Q_OBJECT
 
-    private: // Types
-        enum Column {
-            COLUMN_NUMBER = 0,
-            COLUMN_SYMBOL,
-            COLUMN_SUFFIX,
-            COLUMN_ISREQUIRED,
-            COLUMN_POS_X,
-            COLUMN_POS_Y,
-            COLUMN_ROTATION,
-            COLUMN_BUTTONS,
-            _COLUMN_COUNT
-        };
-
-
     public:
         // Constructors / Destructor
         explicit ComponentSymbolVariantItemListEditorWidget(QWidget* parent = nullptr) noexcept;
@@ -92,51 +82,15 @@ class ComponentSymbolVariantItemListEditorWidget final : public QWidget
 
 
     private: // Slots
-        void currentCellChanged(int currentRow, int currentColumn,
-                                int previousRow, int previousColumn) noexcept;
-        void tableCellChanged(int row, int column) noexcept;
-        void isRequiredChanged(bool checked) noexcept;
-        void btnChooseSymbolClicked() noexcept;
-        void btnAddRemoveClicked() noexcept;
-        void btnUpClicked() noexcept;
-        void btnDownClicked() noexcept;
-
-
-    private: // Methods
-        void updateTable(Uuid selected = Uuid()) noexcept;
-        void setTableRowContent(int row, int number, const Uuid& uuid, const Uuid& symbol,
-                                const QString& suffix, bool required, const Point& pos,
-                                const Angle& rot) noexcept;
-        void addItem(const Uuid& symbol, const QString& suffix, bool required,
-                     const Point& pos, const Angle& rot) noexcept;
-        void removeItem(const Uuid& uuid) noexcept;
-        void moveItemUp(int index) noexcept;
-        void moveItemDown(int index) noexcept;
-        void setSymbolUuid(const Uuid& uuid, const Uuid& symbol) noexcept;
-        void setIsRequired(const Uuid& uuid, bool required) noexcept;
-        void setSuffix(const Uuid& uuid, const QString& suffix) noexcept;
-        void setPosX(const Uuid& uuid, const Length& x) noexcept;
-        void setPosY(const Uuid& uuid, const Length& y) noexcept;
-        void setRotation(const Uuid& uuid, const Angle& rot) noexcept;
-        int getRowOfTableCellWidget(QObject* obj) const noexcept;
-        Uuid getUuidOfRow(int row) const noexcept;
-
-        // row index <-> item index conversion methods
-        int newItemRow() const noexcept {return mItems->count();}
-        int indexToRow(int index) const noexcept {return index;}
-        int rowToIndex(int row) const noexcept {return row;}
-        bool isExistingItemRow(int row) const noexcept {return row >= 0 && row < mItems->count();}
-        bool isNewItemRow(int row) const noexcept {return row == newItemRow();}
+        void viewClicked(const QModelIndex& index) noexcept;
+        void viewDoubleClicked(const QModelIndex& index) noexcept;
 
 
     private: // Data
-        QTableWidget* mTable;
+        QTableView* mView;
+        ComponentSymbolVariantItemListModel* mModel;
         const workspace::Workspace* mWorkspace;
         const IF_GraphicsLayerProvider* mLayerProvider;
-        ComponentSymbolVariantItemList* mItems;
-        Uuid mSelectedItem;
-        QLabel* mNewSymbolLabel;
-        CenteredCheckBox* mNewRequiredCheckbox;
 };
 
 /*****************************************************************************************
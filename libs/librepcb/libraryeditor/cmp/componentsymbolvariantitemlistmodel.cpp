@@ -0,0 +1,439 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "componentsymbolvariantitemlistmodel.h"
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/settings/workspacesettings.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ComponentSymbolVariantItemListModel::ComponentSymbolVariantItemListModel(QWidget* parent) noexcept :
+    QAbstractTableModel(parent), mWorkspace(nullptr), mItems(nullptr), mNewIsRequired(true)
+{
+}
+
+ComponentSymbolVariantItemListModel::~ComponentSymbolVariantItemListModel() noexcept
+{
+    setReferences(nullptr, nullptr);
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool ComponentSymbolVariantItemListModel::isNewItemRow(int row) const noexcept
+{
+    return mItems && (row == mItems->count());
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void ComponentSymbolVariantItemListModel::setReferences(const workspace::Workspace* ws,
+    ComponentSymbolVariantItemList* items) noexcept
+{
+    beginResetModel();
+    if (mItems) mItems->unregisterObserver(this);
+    mWorkspace = ws;
+    mItems = items;
+    mSymbolNames.clear();
+    if (mItems) mItems->registerObserver(this);
+    endResetModel();
+}
+
+void ComponentSymbolVariantItemListModel::setSymbol(int row, const Uuid& symbol) noexcept
+{
+    if ((!mItems) || (!mWorkspace)) return;
+    std::shared_ptr<ComponentSymbolVariantItem> item = mItems->value(row);
+    try {
+        if (item) {
+            createPinSignalMap(*item, symbol); // can throw
+            item->setSymbolUuid(symbol);
+            emit edited();
+        } else {
+            mNewSymbolUuid = symbol;
+        }
+        emit dataChanged(index(row, COLUMN_SYMBOL), index(row, COLUMN_SYMBOL));
+    } catch (const Exception& e) {
+        QMessageBox::critical(getParentWidget(), tr("Could not change symbol"), e.getMsg());
+    }
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int ComponentSymbolVariantItemListModel::triggerAction(const QModelIndex& index) noexcept
+{
+    if ((!index.isValid()) || (!mItems)) return -1;
+    int row = index.row();
+    bool isNewRow = isNewItemRow(row);
+    switch (index.column()) {
+        case COLUMN_MOVE_UP: {
+            if (isNewRow || (row <= 0)) return -1;
+            mItems->swap(row, row - 1);
+            emit edited();
+            return row - 1;
+        }
+        case COLUMN_MOVE_DOWN: {
+            if (isNewRow || (row >= mItems->count() - 1)) return -1;
+            mItems->swap(row, row + 1);
+            emit edited();
+            return row + 1;
+        }
+        case COLUMN_ADD_REMOVE: {
+            if (isNewRow) {
+                try {
+                    return addItem(); // can throw
+                } catch (const Exception& e) {
+                    QMessageBox::critical(getParentWidget(), tr("Could not add symbol"), e.getMsg());
+                    return -1;
+                }
+            } else {
+                mItems->remove(row);
+                emit edited();
+                return -1;
+            }
+        }
+        default:
+            return -1;
+    }
+}
+
+/*****************************************************************************************
+ *  Inherited from QAbstractItemModel
+ ****************************************************************************************/
+
+int ComponentSymbolVariantItemListModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || (!mItems)) return 0;
+    return mItems->count() + 1; // the last row is used to add new items
+}
+
+int ComponentSymbolVariantItemListModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : _COLUMN_COUNT;
+}
+
+QVariant ComponentSymbolVariantItemListModel::data(const QModelIndex& index, int role) const
+{
+    if ((!index.isValid()) || (!mItems)) return QVariant();
+    std::shared_ptr<const ComponentSymbolVariantItem> item = mItems->value(index.row());
+    bool isNewRow = (!item);
+    bool isText = (role == Qt::DisplayRole) || (role == Qt::EditRole);
+
+    switch (index.column()) {
+        case COLUMN_NUMBER: {
+            if (role == Qt::DisplayRole) {
+                return index.row() + 1;
+            } else if (role == Qt::TextAlignmentRole) {
+                return Qt::AlignCenter;
+            }
+            break;
+        }
+        case COLUMN_SYMBOL: {
+            Uuid symbol = isNewRow ? mNewSymbolUuid : item->getSymbolUuid();
+            if (symbol.isNull()) {
+                if (role == Qt::ToolTipRole) return tr("Double-click to choose a symbol");
+                break;
+            }
+            const QPair<QString, QString>& nameAndError = getSymbolNameAndError(symbol);
+            if (role == Qt::DisplayRole) {
+                return nameAndError.second.isEmpty() ? nameAndError.first : symbol.toStr();
+            } else if (role == Qt::ToolTipRole) {
+                return nameAndError.second.isEmpty() ? symbol.toStr() : nameAndError.second;
+            } else if ((role == Qt::ForegroundRole) && (!nameAndError.second.isEmpty())) {
+                return QBrush(Qt::red);
+            }
+            break;
+        }
+        case COLUMN_SUFFIX: {
+            if (isText) {
+                return isNewRow ? mNewSuffix : item->getSuffix();
+            } else if (role == Qt::TextAlignmentRole) {
+                return Qt::AlignCenter;
+            }
+            break;
+        }
+        case COLUMN_ISREQUIRED: {
+            if (role == Qt::CheckStateRole) {
+                bool required = isNewRow ? mNewIsRequired : item->isRequired();
+                return required ? Qt::Checked : Qt::Unchecked;
+            }
+            break;
+        }
+        case COLUMN_POS_X: {
+            if (isText) {
+                return (isNewRow ? mNewPosition : item->getSymbolPosition()).getX().toMmString();
+            }
+            break;
+        }
+        case COLUMN_POS_Y: {
+            if (isText) {
+                return (isNewRow ? mNewPosition : item->getSymbolPosition()).getY().toMmString();
+            }
+            break;
+        }
+        case COLUMN_ROTATION: {
+            if (isText) {
+                return (isNewRow ? mNewRotation : item->getSymbolRotation()).toDegString();
+            }
+            break;
+        }
+        case COLUMN_MOVE_UP: {
+            if ((role == Qt::DecorationRole) && (!isNewRow) && (index.row() > 0)) {
+                return QIcon(":/img/actions/up.png");
+            }
+            break;
+        }
+        case COLUMN_MOVE_DOWN: {
+            if ((role == Qt::DecorationRole) && (!isNewRow) &&
+                (index.row() < mItems->count() - 1)) {
+                return QIcon(":/img/actions/down.png");
+            }
+            break;
+        }
+        case COLUMN_ADD_REMOVE: {
+            if (role == Qt::DecorationRole) {
+                return QIcon(isNewRow ? ":/img/actions/add.png" : ":/img/actions/minus.png");
+            } else if (role == Qt::ToolTipRole) {
+                return isNewRow ? tr("Add symbol") : tr("Remove symbol");
+            }
+            break;
+        }
+        default: break;
+    }
+    return QVariant();
+}
+
+QVariant ComponentSymbolVariantItemListModel::headerData(int section,
+    Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal) {
+        if (role == Qt::DisplayRole) {
+            switch (section) {
+                case COLUMN_NUMBER:     return tr("#");
+                case COLUMN_SYMBOL:     return tr("Symbol");
+                case COLUMN_SUFFIX:     return tr("Suffix");
+                case COLUMN_ISREQUIRED: return tr("Required");
+                case COLUMN_POS_X:      return tr("Position X");
+                case COLUMN_POS_Y:      return tr("Position Y");
+                case COLUMN_ROTATION:   return tr("Rotation");
+                default:                return QVariant();
+            }
+        }
+    } else if (mItems) {
+        std::shared_ptr<const ComponentSymbolVariantItem> item = mItems->value(section);
+        if (role == Qt::DisplayRole) {
+            return item ? QString(item->getUuid().toStr().left(13) % "...")
+                        : tr("Add new symbol:");
+        } else if ((role == Qt::ToolTipRole) && item) {
+            return item->getUuid().toStr();
+        } else if (role == Qt::FontRole) {
+            QFont font;
+            font.setStyleHint(QFont::Monospace); // ensure that the column width is fixed
+            font.setFamily("Monospace");
+            return font;
+        }
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags ComponentSymbolVariantItemListModel::flags(const QModelIndex& index) const
+{
+    Qt::ItemFlags f = QAbstractTableModel::flags(index);
+    switch (index.column()) {
+        case COLUMN_SUFFIX:
+        case COLUMN_POS_X:
+        case COLUMN_POS_Y:
+        case COLUMN_ROTATION:   return f | Qt::ItemIsEditable;
+        case COLUMN_ISREQUIRED: return f | Qt::ItemIsUserCheckable;
+        default:                return f;
+    }
+}
+
+bool ComponentSymbolVariantItemListModel::setData(const QModelIndex& index,
+                                                  const QVariant& value, int role)
+{
+    if ((!index.isValid()) || (!mItems)) return false;
+    bool isCheckState = (index.column() == COLUMN_ISREQUIRED) && (role == Qt::CheckStateRole);
+    if ((!isCheckState) && (role != Qt::EditRole)) return false;
+
+    std::shared_ptr<ComponentSymbolVariantItem> item = mItems->value(index.row());
+    try {
+        if (item) {
+            setItemData(*item, index.column(), value); // can throw
+            emit edited();
+        } else {
+            switch (index.column()) {
+                case COLUMN_SUFFIX:     mNewSuffix = value.toString().trimmed().toUpper(); break;
+                case COLUMN_ISREQUIRED: mNewIsRequired = (value.toInt() == Qt::Checked); break;
+                case COLUMN_POS_X:      mNewPosition.setX(Length::fromMm(value.toString().trimmed())); break; // can throw
+                case COLUMN_POS_Y:      mNewPosition.setY(Length::fromMm(value.toString().trimmed())); break; // can throw
+                case COLUMN_ROTATION:   mNewRotation = Angle::fromDeg(value.toString().trimmed()); break; // can throw
+                default:                return false;
+            }
+        }
+        emit dataChanged(index, index);
+        return true;
+    } catch (const Exception& e) {
+        QMessageBox::warning(getParentWidget(), tr("Error"), e.getMsg());
+        return false;
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+int ComponentSymbolVariantItemListModel::addItem()
+{
+    if (mNewSymbolUuid.isNull()) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Invalid symbol."));
+    }
+    std::shared_ptr<ComponentSymbolVariantItem> item(new ComponentSymbolVariantItem(
+        Uuid::createRandom(), mNewSymbolUuid, mNewIsRequired, mNewSuffix));
+    createPinSignalMap(*item, mNewSymbolUuid); // can throw
+    item->setSymbolPosition(mNewPosition);
+    item->setSymbolRotation(mNewRotation);
+    mItems->append(item);
+    emit edited();
+    return mItems->count() - 1;
+}
+
+void ComponentSymbolVariantItemListModel::setItemData(ComponentSymbolVariantItem& item,
+                                                      int column, const QVariant& value)
+{
+    switch (column) {
+        case COLUMN_SUFFIX: {
+            item.setSuffix(value.toString().trimmed().toUpper());
+            break;
+        }
+        case COLUMN_ISREQUIRED: {
+            item.setIsRequired(value.toInt() == Qt::Checked);
+            break;
+        }
+        case COLUMN_POS_X: {
+            Point pos = item.getSymbolPosition();
+            pos.setX(Length::fromMm(value.toString().trimmed())); // can throw
+            item.setSymbolPosition(pos);
+            break;
+        }
+        case COLUMN_POS_Y: {
+            Point pos = item.getSymbolPosition();
+            pos.setY(Length::fromMm(value.toString().trimmed())); // can throw
+            item.setSymbolPosition(pos);
+            break;
+        }
+        case COLUMN_ROTATION: {
+            item.setSymbolRotation(Angle::fromDeg(value.toString().trimmed())); // can throw
+            break;
+        }
+        default: {
+            throw LogicError(__FILE__, __LINE__);
+        }
+    }
+}
+
+void ComponentSymbolVariantItemListModel::createPinSignalMap(ComponentSymbolVariantItem& item,
+                                                             const Uuid& symbol)
+{
+    FilePath fp = mWorkspace->getLibraryDb().getLatestSymbol(symbol); // can throw
+    Symbol sym(fp, true); // can throw
+    item.getPinSignalMap() = ComponentPinSignalMapHelpers::create(sym.getPins().getUuidSet());
+}
+
+const QPair<QString, QString>& ComponentSymbolVariantItemListModel::getSymbolNameAndError(
+        const Uuid& symbol) const noexcept
+{
+    auto it = mSymbolNames.find(symbol);
+    if (it == mSymbolNames.end()) {
+        QPair<QString, QString> nameAndError;
+        try {
+            if (!mWorkspace) throw LogicError(__FILE__, __LINE__);
+            const QStringList lo = mWorkspace->getSettings().getLibLocaleOrder().getLocaleOrder();
+            FilePath symFp = mWorkspace->getLibraryDb().getLatestSymbol(symbol); // can throw
+            mWorkspace->getLibraryDb().getElementTranslations<Symbol>(symFp, lo, &nameAndError.first); // can throw
+        } catch (const Exception& e) {
+            nameAndError.second = e.getMsg();
+        }
+        it = mSymbolNames.insert(symbol, nameAndError);
+    }
+    return it.value();
+}
+
+QWidget* ComponentSymbolVariantItemListModel::getParentWidget() const noexcept
+{
+    return qobject_cast<QWidget*>(QObject::parent());
+}
+
+/*****************************************************************************************
+ *  Observer Methods
+ ****************************************************************************************/
+
+void ComponentSymbolVariantItemListModel::listObjectAdded(
+    const ComponentSymbolVariantItemList& list, int newIndex,
+    const std::shared_ptr<ComponentSymbolVariantItem>& ptr) noexcept
+{
+    Q_ASSERT(&list == mItems); Q_UNUSED(list); Q_UNUSED(ptr);
+    // the element is already inserted, but the additional row for new items makes sure
+    // the row count is still valid for beginInsertRows()
+    beginInsertRows(QModelIndex(), newIndex, newIndex);
+    endInsertRows();
+    // the numbers and move buttons of all following rows have changed
+    emit dataChanged(index(qMax(newIndex - 1, 0), 0),
+                     index(mItems->count(), _COLUMN_COUNT - 1));
+}
+
+void ComponentSymbolVariantItemListModel::listObjectRemoved(
+    const ComponentSymbolVariantItemList& list, int oldIndex,
+    const std::shared_ptr<ComponentSymbolVariantItem>& ptr) noexcept
+{
+    Q_ASSERT(&list == mItems); Q_UNUSED(list); Q_UNUSED(ptr);
+    beginRemoveRows(QModelIndex(), oldIndex, oldIndex);
+    endRemoveRows();
+    emit dataChanged(index(qMax(oldIndex - 1, 0), 0),
+                     index(mItems->count(), _COLUMN_COUNT - 1));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
@@ -0,0 +1,157 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_EDITOR_COMPONENTSYMBOLVARIANTITEMLISTMODEL_H
+#define LIBREPCB_LIBRARY_EDITOR_COMPONENTSYMBOLVARIANTITEMLISTMODEL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcb/library/cmp/componentsymbolvariantitem.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace workspace {
+class Workspace;
+}
+
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Class ComponentSymbolVariantItemListModel
+ ****************************************************************************************/
+
+/**
+ * @brief The ComponentSymbolVariantItemListModel class is a table model for a
+ *        librepcb::library::ComponentSymbolVariantItemList
+ *
+ * The model reads directly from the list and is updated by its observer methods. The
+ * names of the symbols are looked up in the workspace library database only once per
+ * symbol. The last row is a special row to add a new item.
+ */
+class ComponentSymbolVariantItemListModel final : public QAbstractTableModel,
+                                                  private ComponentSymbolVariantItemList::IF_Observer
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        enum Column {
+            COLUMN_NUMBER = 0,
+            COLUMN_SYMBOL,
+            COLUMN_SUFFIX,
+            COLUMN_ISREQUIRED,
+            COLUMN_POS_X,
+            COLUMN_POS_Y,
+            COLUMN_ROTATION,
+            COLUMN_MOVE_UP,
+            COLUMN_MOVE_DOWN,
+            COLUMN_ADD_REMOVE,
+            _COLUMN_COUNT
+        };
+
+        // Constructors / Destructor
+        ComponentSymbolVariantItemListModel() = delete;
+        ComponentSymbolVariantItemListModel(const ComponentSymbolVariantItemListModel& other) = delete;
+        explicit ComponentSymbolVariantItemListModel(QWidget* parent) noexcept;
+        ~ComponentSymbolVariantItemListModel() noexcept;
+
+        // Getters
+        bool isNewItemRow(int row) const noexcept;
+
+        // Setters
+        void setReferences(const workspace::Workspace* ws,
+                           ComponentSymbolVariantItemList* items) noexcept;
+        void setSymbol(int row, const Uuid& symbol) noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Execute the action of a cell in the #COLUMN_MOVE_UP, #COLUMN_MOVE_DOWN
+         *        or #COLUMN_ADD_REMOVE column
+         *
+         * @param index     The clicked cell
+         *
+         * @return The row to select afterwards (-1 to keep the current selection)
+         */
+        int triggerAction(const QModelIndex& index) noexcept;
+
+        // Inherited from QAbstractItemModel
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant headerData(int section, Qt::Orientation orientation,
+                            int role = Qt::DisplayRole) const override;
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        bool setData(const QModelIndex& index, const QVariant& value,
+                     int role = Qt::EditRole) override;
+
+        // Operator Overloadings
+        ComponentSymbolVariantItemListModel& operator=(const ComponentSymbolVariantItemListModel& rhs) = delete;
+
+
+    signals:
+        void edited();
+
+
+    private: // Methods
+        int addItem();
+        void setItemData(ComponentSymbolVariantItem& item, int column, const QVariant& value);
+        void createPinSignalMap(ComponentSymbolVariantItem& item, const Uuid& symbol);
+        const QPair<QString, QString>& getSymbolNameAndError(const Uuid& symbol) const noexcept;
+        QWidget* getParentWidget() const noexcept;
+
+        // Observer Methods
+        void listObjectAdded(const ComponentSymbolVariantItemList& list, int newIndex,
+            const std::shared_ptr<ComponentSymbolVariantItem>& ptr) noexcept override;
+        void listObjectRemoved(const ComponentSymbolVariantItemList& list, int oldIndex,
+            const std::shared_ptr<ComponentSymbolVariantItem>& ptr) noexcept override;
+
+
+    private: // Data
+        const workspace::Workspace* mWorkspace;
+        ComponentSymbolVariantItemList* mItems;
+
+        /// Cache of the symbol names (first) or lookup errors (second)
+        mutable QHash<Uuid, QPair<QString, QString>> mSymbolNames;
+
+        // attributes of the item to add (see #addItem())
+        Uuid mNewSymbolUuid;
+        QString mNewSuffix;
+        bool mNewIsRequired;
+        Point mNewPosition;
+        Angle mNewRotation;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_EDITOR_COMPONENTSYMBOLVARIANTITEMLISTMODEL_H
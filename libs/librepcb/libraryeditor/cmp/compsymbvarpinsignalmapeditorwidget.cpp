@@ -27,6 +27,7 @@
 #include <librepcb/library/sym/symbol.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include "cmpsigpindisplaytypecombobox.h"
 
@@ -161,15 +162,15 @@ void CompSymbVarPinSignalMapEditorWidget::updateTable(Uuid selItem, Uuid selPin)
     int row = 0;
     for (int i = 0; i < mSymbolVariant->getSymbolItems().count(); ++i) {
         const ComponentSymbolVariantItem& item = *mSymbolVariant->getSymbolItems().at(i);
-        QScopedPointer<Symbol> symbol;
+        std::shared_ptr<const Symbol> symbol;
         try {
             FilePath fp = mWorkspace->getLibraryDb().getLatestSymbol(item.getSymbolUuid()); // can throw
-            symbol.reset(new Symbol(fp, true)); // can throw
+            symbol = mWorkspace->getLibraryElementCache().getElement<Symbol>(fp); // can throw
         } catch (const Exception& e) {
             // what could we do here?
         }
         for (const ComponentPinSignalMapItem& mapItem : item.getPinSignalMap()) {
-            setTableRowContent(row, item, mapItem, i + 1, symbol.data());
+            setTableRowContent(row, item, mapItem, i + 1, symbol.get());
             if (item.getUuid() == selItem && mapItem.getPinUuid() == selPin) {
                 selectedRow = row;
             }
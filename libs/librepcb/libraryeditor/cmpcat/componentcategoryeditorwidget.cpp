@@ -41,8 +41,8 @@ namespace editor {
  ****************************************************************************************/
 
 ComponentCategoryEditorWidget::ComponentCategoryEditorWidget(const Context& context,
-        const FilePath& fp, QWidget* parent) :
-    EditorWidgetBase(context, fp, parent), mUi(new Ui::ComponentCategoryEditorWidget)
+        std::unique_ptr<ComponentCategory> category, QWidget* parent) :
+    EditorWidgetBase(context, category->getFilePath(), parent), mUi(new Ui::ComponentCategoryEditorWidget)
 {
     mUi->setupUi(this);
     setWindowIcon(QIcon(":/img/places/folder.png"));
@@ -53,7 +53,7 @@ ComponentCategoryEditorWidget::ComponentCategoryEditorWidget(const Context& cont
     connect(mUi->edtParent, &QLineEdit::textChanged,
             this, &ComponentCategoryEditorWidget::edtParentTextChanged);
 
-    mCategory.reset(new ComponentCategory(fp, false)); // can throw
+    mCategory.reset(category.release());
     setWindowTitle(mCategory->getNames().value(getLibLocaleOrder()));
     mUi->lblUuid->setText(QString("<a href=\"%1\">%2</a>").arg(
         mCategory->getFilePath().toQUrl().toString(), mCategory->getUuid().toStr()));
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/exceptions.h>
@@ -62,7 +63,7 @@ class ComponentCategoryEditorWidget final : public EditorWidgetBase
         // Constructors / Destructor
         ComponentCategoryEditorWidget() = delete;
         ComponentCategoryEditorWidget(const ComponentCategoryEditorWidget& other) = delete;
-        ComponentCategoryEditorWidget(const Context& context, const FilePath& fp,
+        ComponentCategoryEditorWidget(const Context& context, std::unique_ptr<ComponentCategory> category,
                                       QWidget* parent = nullptr);
         ~ComponentCategoryEditorWidget() noexcept;
 
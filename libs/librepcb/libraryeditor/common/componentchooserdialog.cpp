@@ -24,6 +24,7 @@
 #include <QtWidgets>
 #include "componentchooserdialog.h"
 #include "ui_componentchooserdialog.h"
+#include "libraryelementlistpopulator.h"
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/sym/symbol.h>
@@ -31,6 +32,7 @@
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
 
 /*****************************************************************************************
@@ -62,6 +64,9 @@ ComponentChooserDialog::ComponentChooserDialog(const workspace::Workspace& ws,
             this, &ComponentChooserDialog::listComponents_currentItemChanged);
     connect(mUi->listComponents, &QListWidget::itemDoubleClicked,
             this, &ComponentChooserDialog::listComponents_itemDoubleClicked);
+    connect(mUi->edtSearch, &QLineEdit::textChanged,
+            this, &ComponentChooserDialog::edtSearch_textChanged);
+    mListPopulator.reset(new LibraryElementListPopulator<Component>(mWorkspace, *mUi->listComponents));
 
     setSelectedComponent(Uuid());
 }
@@ -105,24 +110,22 @@ void ComponentChooserDialog::setSelectedCategory(const Uuid& uuid) noexcept
 {
     if ((uuid == mSelectedCategoryUuid) && (!uuid.isNull())) return;
 
-    setSelectedComponent(Uuid());
-    mUi->listComponents->clear();
-
     mSelectedCategoryUuid = uuid;
+    if (!mUi->edtSearch->text().isEmpty()) {
+        mUi->edtSearch->clear(); // shows the elements of the selected category
+    } else {
+        edtSearch_textChanged(QString());
+    }
+}
+
+void ComponentChooserDialog::edtSearch_textChanged(const QString& text) noexcept
+{
+    setSelectedComponent(Uuid());
     try {
-        QSet<Uuid> components = mWorkspace.getLibraryDb().getComponentsByCategory(uuid); // can throw
-        foreach (const Uuid& uuid, components) {
-            try {
-                FilePath fp = mWorkspace.getLibraryDb().getLatestComponent(uuid); // can throw
-                QString name;
-                mWorkspace.getLibraryDb().getElementTranslations<Component>(fp, localeOrder(),
-                                                                            &name); // can throw
-                QListWidgetItem* item = new QListWidgetItem(name);
-                item->setData(Qt::UserRole, uuid.toStr());
-                mUi->listComponents->addItem(item);
-            } catch (const Exception& e) {
-                continue; // should we do something here?
-            }
+        if (text.trimmed().isEmpty()) {
+            mListPopulator->showCategory(mSelectedCategoryUuid); // can throw
+        } else {
+            mListPopulator->showSearchResults(text); // can throw
         }
     } catch (const Exception& e) {
         QMessageBox::critical(this, tr("Could not load components"), e.getMsg());
@@ -161,18 +164,19 @@ void ComponentChooserDialog::updatePreview() noexcept
 
     if (mComponentFilePath.isValid() && mLayerProvider) {
         try {
-            mComponent.reset(new Component(mComponentFilePath, true)); // can throw
+            mComponent = mWorkspace.getLibraryElementCache().getElement<Component>(mComponentFilePath); // can throw
             if (mComponent && mComponent->getSymbolVariants().count() > 0) {
                 const ComponentSymbolVariant& symbVar = *mComponent->getSymbolVariants().first();
                 for (const ComponentSymbolVariantItem& item : symbVar.getSymbolItems()) {
                     try {
                         FilePath fp = mWorkspace.getLibraryDb().getLatestSymbol(item.getSymbolUuid()); // can throw
-                        std::shared_ptr<Symbol> sym = std::make_shared<Symbol>(fp, true); // can throw
+                        std::shared_ptr<const Symbol> sym =
+                            mWorkspace.getLibraryElementCache().getElement<Symbol>(fp); // can throw
                         mSymbols.append(sym);
                         std::shared_ptr<SymbolPreviewGraphicsItem> graphicsItem =
                             std::make_shared<SymbolPreviewGraphicsItem>(
                                     *mLayerProvider, QStringList(), *sym,
-                                    mComponent.data(), symbVar.getUuid(), item.getUuid());
+                                    mComponent.get(), symbVar.getUuid(), item.getUuid());
                         graphicsItem->setPos(item.getSymbolPosition().toPxQPointF());
                         graphicsItem->setRotation(-item.getSymbolRotation().toDeg());
                         mGraphicsScene->addItem(*graphicsItem);
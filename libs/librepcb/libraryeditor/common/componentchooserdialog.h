@@ -49,6 +49,9 @@ class SymbolPreviewGraphicsItem;
 
 namespace editor {
 
+template <typename ElementType>
+class LibraryElementListPopulator;
+
 namespace Ui {
 class ComponentChooserDialog;
 }
@@ -91,6 +94,7 @@ class ComponentChooserDialog final : public QDialog
                                                QListWidgetItem* previous) noexcept;
         void listComponents_itemDoubleClicked(QListWidgetItem* item) noexcept;
         void setSelectedCategory(const Uuid& uuid) noexcept;
+        void edtSearch_textChanged(const QString& text) noexcept;
         void setSelectedComponent(const Uuid& uuid) noexcept;
         void updatePreview() noexcept;
         void accept() noexcept override;
@@ -102,14 +106,15 @@ class ComponentChooserDialog final : public QDialog
         const IF_GraphicsLayerProvider* mLayerProvider;
         QScopedPointer<Ui::ComponentChooserDialog> mUi;
         QScopedPointer<QAbstractItemModel> mCategoryTreeModel;
+        QScopedPointer<LibraryElementListPopulator<Component>> mListPopulator;
         Uuid mSelectedCategoryUuid;
         Uuid mSelectedComponentUuid;
 
         // preview
         FilePath mComponentFilePath;
-        QScopedPointer<Component> mComponent;
+        std::shared_ptr<const Component> mComponent;
         QScopedPointer<GraphicsScene> mGraphicsScene;
-        QList<std::shared_ptr<Symbol>> mSymbols;
+        QList<std::shared_ptr<const Symbol>> mSymbols;
         QList<std::shared_ptr<SymbolPreviewGraphicsItem>> mSymbolGraphicsItems;
 };
 
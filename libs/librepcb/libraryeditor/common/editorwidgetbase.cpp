@@ -24,6 +24,7 @@
 #include <QtWidgets>
 #include "editorwidgetbase.h"
 #include <librepcb/common/undostack.h>
+#include <librepcb/common/version.h>
 #include <librepcb/common/utils/exclusiveactiongroup.h>
 #include <librepcb/common/utils/undostackactiongroup.h>
 #include <librepcb/common/utils/toolbarproxy.h>
@@ -37,6 +38,31 @@ namespace librepcb {
 namespace library {
 namespace editor {
 
+/*****************************************************************************************
+ *  Class EditorWidgetBase::CheckJob
+ ****************************************************************************************/
+
+/**
+ * @brief Runs the check function returned by #prepareChecks() in a worker thread
+ */
+class EditorWidgetBase::CheckJob final : public QRunnable
+{
+    public:
+        CheckJob(EditorWidgetBase& widget, quint32 revision,
+                 const std::function<QStringList()>& check) noexcept :
+            mWidget(widget), mRevision(revision), mCheck(check) {}
+
+        void run() noexcept override
+        {
+            emit mWidget.checkJobFinished(mRevision, mCheck());
+        }
+
+    private:
+        EditorWidgetBase& mWidget;
+        quint32 mRevision;
+        std::function<QStringList()> mCheck;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -44,7 +70,9 @@ namespace editor {
 EditorWidgetBase::EditorWidgetBase(const Context& context, const FilePath& fp,
                                    QWidget* parent) :
     QWidget(parent), mContext(context), mFilePath(fp), mUndoStackActionGroup(nullptr),
-    mToolsActionGroup(nullptr), mIsDirty(false), mIsInterfaceBroken(false)
+    mToolsActionGroup(nullptr), mIsDirty(false), mIsInterfaceBroken(false),
+    mCheckJobs(context.workspace.getJobScheduler(), JobScheduler::Priority::Background, 1),
+    mCheckRevision(0)
 {
     mUndoStack.reset(new UndoStack());
     connect(mUndoStack.data(), &UndoStack::cleanChanged,
@@ -53,10 +81,20 @@ EditorWidgetBase::EditorWidgetBase(const Context& context, const FilePath& fp,
             this, &EditorWidgetBase::undoStackStateModified);
 
     mCommandToolBarProxy.reset(new ToolBarProxy());
+
+    // the first check runs as soon as the derived editor widget is constructed
+    mCheckTimer.setSingleShot(true);
+    mCheckTimer.setInterval(500);
+    connect(&mCheckTimer, &QTimer::timeout, this, &EditorWidgetBase::startChecks);
+    connect(this, &EditorWidgetBase::checkJobFinished,
+            this, &EditorWidgetBase::checkJobFinishedHandler, Qt::QueuedConnection);
+    mCheckTimer.start(0);
 }
 
 EditorWidgetBase::~EditorWidgetBase() noexcept
 {
+    mCheckJobs.cancel(); // remove all checks which are not yet started
+    mCheckJobs.waitForDone();
 }
 
 /*****************************************************************************************
@@ -106,6 +144,15 @@ void EditorWidgetBase::setCommandToolBar(QToolBar* toolbar) noexcept
     mCommandToolBarProxy->setToolBar(toolbar);
 }
 
+void EditorWidgetBase::setDirty() noexcept
+{
+    if (!mIsDirty) {
+        mIsDirty = true;
+        emit dirtyChanged(true);
+    }
+    scheduleChecks();
+}
+
 /*****************************************************************************************
  *  Public Methods
  ****************************************************************************************/
@@ -118,6 +165,7 @@ bool EditorWidgetBase::save() noexcept
     emit dirtyChanged(false);
     emit interfaceBrokenChanged(false);
     emit elementEdited(mFilePath);
+    scheduleChecks();
     return true;
 }
 
@@ -145,14 +193,6 @@ void EditorWidgetBase::setupInterfaceBrokenWarningWidget(QWidget& widget) noexce
             &widget, &QWidget::setVisible);
 }
 
-void EditorWidgetBase::setDirty() noexcept
-{
-    if (!mIsDirty) {
-        mIsDirty = true;
-        emit dirtyChanged(true);
-    }
-}
-
 void EditorWidgetBase::undoStackStateModified() noexcept
 {
     if (!mContext.elementIsNewlyCreated) {
@@ -162,6 +202,7 @@ void EditorWidgetBase::undoStackStateModified() noexcept
             emit interfaceBrokenChanged(mIsInterfaceBroken);
         }
     }
+    scheduleChecks();
 }
 
 const QStringList& EditorWidgetBase::getLibLocaleOrder() const noexcept
@@ -169,6 +210,24 @@ const QStringList& EditorWidgetBase::getLibLocaleOrder() const noexcept
     return mContext.workspace.getSettings().getLibLocaleOrder().getLocaleOrder();
 }
 
+void EditorWidgetBase::scheduleChecks() noexcept
+{
+    mCheckTimer.start(); // restart with the default delay
+}
+
+QStringList EditorWidgetBase::checkNameAndVersion(const QString& name,
+                                                  const QString& version) noexcept
+{
+    QStringList messages;
+    if (name.trimmed().isEmpty()) {
+        messages.append(tr("The name must not be empty."));
+    }
+    if (!Version(version.trimmed()).isValid()) {
+        messages.append(tr("The version number is invalid."));
+    }
+    return messages;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -184,6 +243,25 @@ void EditorWidgetBase::undoStackCleanChanged(bool clean) noexcept
     emit dirtyChanged(isDirty());
 }
 
+void EditorWidgetBase::startChecks() noexcept
+{
+    std::function<QStringList()> check = prepareChecks();
+    if (check) {
+        // results of older checks which are still running will be discarded
+        mCheckJobs.cancel();
+        mCheckJobs.start(new CheckJob(*this, ++mCheckRevision, check));
+    }
+}
+
+void EditorWidgetBase::checkJobFinishedHandler(quint32 revision,
+                                               const QStringList& messages) noexcept
+{
+    if ((revision == mCheckRevision) && (messages != mCheckMessages)) {
+        mCheckMessages = messages;
+        emit checkMessagesChanged(mCheckMessages);
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -25,7 +25,9 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <functional>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/jobscheduler.h>
 #include <librepcb/common/undostack.h>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/units/all_length_units.h>
@@ -102,7 +104,18 @@ class EditorWidgetBase : public QWidget
         bool isDirty() const noexcept;
         virtual bool hasGraphicalEditor() const noexcept {return false;}
 
+        /**
+         * @brief Get the problems found by the last background check of the element
+         *
+         * The checks run in the workspace's JobScheduler shortly after each modification,
+         * the signal #checkMessagesChanged() is emitted when the result has changed.
+         *
+         * @return The messages of all found problems (empty if there are none)
+         */
+        const QStringList& getCheckMessages() const noexcept {return mCheckMessages;}
+
         // Setters
+        void setDirty() noexcept;
         virtual void setUndoStackActionGroup(UndoStackActionGroup* group) noexcept;
         virtual void setToolsActionGroup(ExclusiveActionGroup* group) noexcept;
         virtual void setCommandToolBar(QToolBar* toolbar) noexcept;
@@ -127,14 +140,44 @@ class EditorWidgetBase : public QWidget
         void setupInterfaceBrokenWarningWidget(QWidget& widget) noexcept;
         virtual bool isInterfaceBroken() const noexcept = 0;
         virtual bool toolChangeRequested(Tool newTool) noexcept {Q_UNUSED(newTool); return false;}
-        void setDirty() noexcept;
         void undoStackStateModified() noexcept;
         const QStringList& getLibLocaleOrder() const noexcept;
 
+        /**
+         * @brief Collect the data to check and return a function which checks it
+         *
+         * This is called in the main thread shortly after the element was modified. The
+         * returned function is then executed in a worker thread, so it must only capture
+         * copies of the data, but no references to the element or to the widgets.
+         *
+         * @return The check function which returns the messages of all found problems
+         *         (nullptr if there is nothing to check)
+         */
+        virtual std::function<QStringList()> prepareChecks() const noexcept {return nullptr;}
+
+        /**
+         * @brief Restart the delay of the background checks (e.g. after a modification)
+         */
+        void scheduleChecks() noexcept;
+
+        /**
+         * @brief Check the name and the version entered in the metadata fields
+         *
+         * @note This method is thread-safe, so it can be used in #prepareChecks().
+         */
+        static QStringList checkNameAndVersion(const QString& name,
+                                               const QString& version) noexcept;
+
+
+    private: // Types
+        class CheckJob;
+
 
     private: // Methods
         void toolActionGroupChangeTriggered(const QVariant& newTool) noexcept;
         void undoStackCleanChanged(bool clean) noexcept;
+        void startChecks() noexcept;
+        void checkJobFinishedHandler(quint32 revision, const QStringList& messages) noexcept;
 
 
     signals:
@@ -142,6 +185,10 @@ class EditorWidgetBase : public QWidget
         void elementEdited(const FilePath& fp);
         void interfaceBrokenChanged(bool broken);
         void cursorPositionChanged(const Point& pos);
+        void checkMessagesChanged(const QStringList& messages);
+
+        /// Emitted from the worker thread when a check is finished (internal use only)
+        void checkJobFinished(quint32 revision, const QStringList& messages);
 
 
     protected: // Data
@@ -153,6 +200,12 @@ class EditorWidgetBase : public QWidget
         QScopedPointer<ToolBarProxy> mCommandToolBarProxy;
         bool mIsDirty;
         bool mIsInterfaceBroken;
+
+    private: // Data
+        JobScheduler::Group mCheckJobs;
+        QTimer mCheckTimer; ///< delays the checks until the modifications have settled
+        quint32 mCheckRevision; ///< incremented for every started check
+        QStringList mCheckMessages;
 };
 
 /*****************************************************************************************
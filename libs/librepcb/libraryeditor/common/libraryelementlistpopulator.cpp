@@ -0,0 +1,214 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "libraryelementlistpopulator.h"
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/settings/workspacesettings.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibrarythumbnails.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace editor {
+
+/// Count of list items which are added at once before returning to the event loop
+static const int LIST_POPULATION_BATCH_SIZE = 100;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+template <typename ElementType>
+LibraryElementListPopulator<ElementType>::LibraryElementListPopulator(
+        const workspace::Workspace& ws, QListWidget& list) noexcept :
+    mWorkspace(ws), mList(list)
+{
+    mBatchTimer.setSingleShot(true);
+    mBatchTimer.setInterval(0);
+    QObject::connect(&mBatchTimer, &QTimer::timeout, [this](){populateNextBatch();});
+}
+
+template <typename ElementType>
+LibraryElementListPopulator<ElementType>::~LibraryElementListPopulator() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+template <typename ElementType>
+void LibraryElementListPopulator<ElementType>::showCategory(const Uuid& category)
+{
+    // sorted by the names precomputed in the database, which are shown in the list
+    setElements(mWorkspace.getLibraryDb().getElementsByCategorySortedByName<ElementType>(
+        category)); // can throw
+}
+
+template <typename ElementType>
+void LibraryElementListPopulator<ElementType>::showSearchResults(const QString& query)
+{
+    setElements(mWorkspace.getLibraryDb().searchElements<ElementType>(
+        query, localeOrder())); // can throw
+}
+
+template <typename ElementType>
+void LibraryElementListPopulator<ElementType>::updateThumbnail(const Uuid& uuid) noexcept
+{
+    QString uuidStr = uuid.toStr();
+    for (int i = 0; i < mList.count(); ++i) {
+        QListWidgetItem* item = mList.item(i);
+        if (item->data(Qt::UserRole).toString() == uuidStr) {
+            item->setIcon(QIcon(QPixmap::fromImage(getThumbnail(uuid))));
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+template <typename ElementType>
+void LibraryElementListPopulator<ElementType>::setElements(
+        const QList<Uuid>& elements) noexcept
+{
+    mBatchTimer.stop();
+    mList.clear();
+    mList.setSortingEnabled(false); // the elements are already sorted
+    mPendingElements = elements;
+    populateNextBatch(); // the first batch immediately to avoid flickering
+}
+
+template <typename ElementType>
+void LibraryElementListPopulator<ElementType>::populateNextBatch() noexcept
+{
+    QHash<FilePath, Uuid> uuids;
+    QList<FilePath> dirs;
+    while ((dirs.count() < LIST_POPULATION_BATCH_SIZE) && (!mPendingElements.isEmpty())) {
+        Uuid uuid = mPendingElements.takeFirst();
+        try {
+            FilePath fp = getLatestElement(uuid); // can throw
+            if (fp.isValid()) {
+                dirs.append(fp);
+                uuids.insert(fp, uuid);
+            }
+        } catch (const Exception& e) {
+            continue; // should we do something here?
+        }
+    }
+
+    try {
+        QHash<FilePath, workspace::WorkspaceLibraryDb::ElementTranslations> translations =
+            mWorkspace.getLibraryDb().getElementTranslations<ElementType>(
+                dirs, localeOrder()); // can throw
+        mList.setUpdatesEnabled(false);
+        foreach (const FilePath& fp, dirs) {
+            if (!translations.contains(fp)) continue;
+            Uuid uuid = uuids.value(fp);
+            QListWidgetItem* item = new QListWidgetItem(translations.value(fp).name);
+            item->setData(Qt::UserRole, uuid.toStr());
+            item->setData(Qt::UserRole + 1, fp.toStr());
+            QImage thumbnail = getThumbnail(uuid);
+            if (!thumbnail.isNull()) {
+                item->setIcon(QIcon(QPixmap::fromImage(thumbnail)));
+            }
+            mList.addItem(item);
+        }
+        mList.setUpdatesEnabled(true);
+    } catch (const Exception& e) {
+        qWarning() << "Could not load library element names:" << e.getMsg();
+    }
+
+    if (!mPendingElements.isEmpty()) {
+        mBatchTimer.start();
+    }
+}
+
+template <typename ElementType>
+const QStringList& LibraryElementListPopulator<ElementType>::localeOrder() const noexcept
+{
+    return mWorkspace.getSettings().getLibLocaleOrder().getLocaleOrder();
+}
+
+/*****************************************************************************************
+ *  Template Specializations
+ ****************************************************************************************/
+
+template <>
+FilePath LibraryElementListPopulator<Symbol>::getLatestElement(const Uuid& uuid) const
+{
+    return mWorkspace.getLibraryDb().getLatestSymbol(uuid);
+}
+
+template <>
+FilePath LibraryElementListPopulator<Package>::getLatestElement(const Uuid& uuid) const
+{
+    return mWorkspace.getLibraryDb().getLatestPackage(uuid);
+}
+
+template <>
+FilePath LibraryElementListPopulator<Component>::getLatestElement(const Uuid& uuid) const
+{
+    return mWorkspace.getLibraryDb().getLatestComponent(uuid);
+}
+
+template <>
+QImage LibraryElementListPopulator<Symbol>::getThumbnail(const Uuid& uuid) const noexcept
+{
+    return mWorkspace.getLibraryThumbnails().getSymbolThumbnail(uuid);
+}
+
+template <>
+QImage LibraryElementListPopulator<Package>::getThumbnail(const Uuid& uuid) const noexcept
+{
+    return mWorkspace.getLibraryThumbnails().getPackageThumbnail(uuid);
+}
+
+template <>
+QImage LibraryElementListPopulator<Component>::getThumbnail(const Uuid& uuid) const noexcept
+{
+    Q_UNUSED(uuid); // there are no thumbnails of components
+    return QImage();
+}
+
+/*****************************************************************************************
+ *  Explicit template instantiations
+ ****************************************************************************************/
+template class LibraryElementListPopulator<library::Symbol>;
+template class LibraryElementListPopulator<library::Package>;
+template class LibraryElementListPopulator<library::Component>;
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
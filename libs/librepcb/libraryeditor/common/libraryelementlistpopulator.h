@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_EDITOR_LIBRARYELEMENTLISTPOPULATOR_H
+#define LIBREPCB_LIBRARY_EDITOR_LIBRARYELEMENTLISTPOPULATOR_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace workspace {
+class Workspace;
+}
+
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Class LibraryElementListPopulator
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryElementListPopulator class fills a QListWidget with the workspace
+ *        library elements of a category or with the results of a full-text search
+ *
+ * The list is filled in batches from the event loop, so even categories or search
+ * results with thousands of elements do not block the GUI. The names of each batch are
+ * fetched from the library database with a single query, and symbols and packages get
+ * their thumbnails (see librepcb::workspace::WorkspaceLibraryThumbnails) as icons.
+ *
+ * Each list item contains the UUID of the element in the data role Qt::UserRole and the
+ * directory of its latest version in the data role Qt::UserRole + 1.
+ *
+ * @tparam ElementType  librepcb::library::Symbol, librepcb::library::Package or
+ *                      librepcb::library::Component
+ */
+template <typename ElementType>
+class LibraryElementListPopulator final
+{
+    public:
+
+        // Constructors / Destructor
+        LibraryElementListPopulator() = delete;
+        LibraryElementListPopulator(const LibraryElementListPopulator& other) = delete;
+        LibraryElementListPopulator(const workspace::Workspace& ws, QListWidget& list) noexcept;
+        ~LibraryElementListPopulator() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Show all elements of a category (sorted by name)
+         *
+         * @param category  The category UUID (null to show elements without category)
+         *
+         * @throw Exception on database errors
+         */
+        void showCategory(const Uuid& category);
+
+        /**
+         * @brief Show all elements matching a search query (sorted by relevance)
+         *
+         * @param query     The search terms (see
+         *                  librepcb::workspace::WorkspaceLibraryDb::searchElements())
+         *
+         * @throw Exception on database errors
+         */
+        void showSearchResults(const QString& query);
+
+        /**
+         * @brief Update the icons of the items of an element after its thumbnail is ready
+         *
+         * @param uuid      The UUID of the element
+         */
+        void updateThumbnail(const Uuid& uuid) noexcept;
+
+        // Operator Overloadings
+        LibraryElementListPopulator& operator=(const LibraryElementListPopulator& rhs) = delete;
+
+
+    private: // Methods
+        void setElements(const QList<Uuid>& elements) noexcept;
+        void populateNextBatch() noexcept;
+        FilePath getLatestElement(const Uuid& uuid) const;
+        QImage getThumbnail(const Uuid& uuid) const noexcept;
+        const QStringList& localeOrder() const noexcept;
+
+
+    private: // Data
+        const workspace::Workspace& mWorkspace;
+        QListWidget& mList;
+        QList<Uuid> mPendingElements; ///< elements which are not added to #mList yet
+        QTimer mBatchTimer;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_EDITOR_LIBRARYELEMENTLISTPOPULATOR_H
@@ -24,12 +24,15 @@
 #include <QtWidgets>
 #include "packagechooserdialog.h"
 #include "ui_packagechooserdialog.h"
+#include "libraryelementlistpopulator.h"
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/library/pkg/footprintpreviewgraphicsitem.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
+#include <librepcb/workspace/library/workspacelibrarythumbnails.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
 
 /*****************************************************************************************
@@ -63,6 +66,14 @@ PackageChooserDialog::PackageChooserDialog(const workspace::Workspace& ws,
             this, &PackageChooserDialog::listPackages_currentItemChanged);
     connect(mUi->listPackages, &QListWidget::itemDoubleClicked,
             this, &PackageChooserDialog::listPackages_itemDoubleClicked);
+    connect(mUi->edtSearch, &QLineEdit::textChanged,
+            this, &PackageChooserDialog::edtSearch_textChanged);
+    mListPopulator.reset(new LibraryElementListPopulator<Package>(mWorkspace, *mUi->listPackages));
+
+    // show the package thumbnails as icons, they are rendered in the background
+    mUi->listPackages->setIconSize(QSize(48, 48));
+    connect(&mWorkspace.getLibraryThumbnails(), &workspace::WorkspaceLibraryThumbnails::thumbnailReady,
+            this, &PackageChooserDialog::updateThumbnail);
 
     setSelectedPackage(Uuid());
 }
@@ -106,24 +117,22 @@ void PackageChooserDialog::setSelectedCategory(const Uuid& uuid) noexcept
 {
     if ((uuid == mSelectedCategoryUuid) && (!uuid.isNull())) return;
 
-    setSelectedPackage(Uuid());
-    mUi->listPackages->clear();
-
     mSelectedCategoryUuid = uuid;
+    if (!mUi->edtSearch->text().isEmpty()) {
+        mUi->edtSearch->clear(); // shows the elements of the selected category
+    } else {
+        edtSearch_textChanged(QString());
+    }
+}
+
+void PackageChooserDialog::edtSearch_textChanged(const QString& text) noexcept
+{
+    setSelectedPackage(Uuid());
     try {
-        QSet<Uuid> packages = mWorkspace.getLibraryDb().getPackagesByCategory(uuid); // can throw
-        foreach (const Uuid& uuid, packages) {
-            try {
-                FilePath fp = mWorkspace.getLibraryDb().getLatestPackage(uuid); // can throw
-                QString name;
-                mWorkspace.getLibraryDb().getElementTranslations<Package>(fp, localeOrder(),
-                                                                          &name); // can throw
-                QListWidgetItem* item = new QListWidgetItem(name);
-                item->setData(Qt::UserRole, uuid.toStr());
-                mUi->listPackages->addItem(item);
-            } catch (const Exception& e) {
-                continue; // should we do something here?
-            }
+        if (text.trimmed().isEmpty()) {
+            mListPopulator->showCategory(mSelectedCategoryUuid); // can throw
+        } else {
+            mListPopulator->showSearchResults(text); // can throw
         }
     } catch (const Exception& e) {
         QMessageBox::critical(this, tr("Could not load packages"), e.getMsg());
@@ -153,6 +162,11 @@ void PackageChooserDialog::setSelectedPackage(const Uuid& uuid) noexcept
     updatePreview();
 }
 
+void PackageChooserDialog::updateThumbnail(const Uuid& uuid) noexcept
+{
+    mListPopulator->updateThumbnail(uuid);
+}
+
 void PackageChooserDialog::updatePreview() noexcept
 {
     mGraphicsItem.reset();
@@ -160,10 +174,10 @@ void PackageChooserDialog::updatePreview() noexcept
 
     if (mPackageFilePath.isValid() && mLayerProvider) {
         try {
-            mPackage.reset(new Package(mPackageFilePath, true)); // can throw
+            mPackage = mWorkspace.getLibraryElementCache().getElement<Package>(mPackageFilePath); // can throw
             if (mPackage->getFootprints().count() > 0) {
                 mGraphicsItem.reset(new FootprintPreviewGraphicsItem(*mLayerProvider,
-                    QStringList(), *mPackage->getFootprints().first(), mPackage.data()));
+                    QStringList(), *mPackage->getFootprints().first(), mPackage.get()));
                 mGraphicsScene->addItem(*mGraphicsItem);
                 mUi->graphicsView->zoomAll();
             }
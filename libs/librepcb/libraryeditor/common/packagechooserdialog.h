@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/uuid.h>
@@ -47,6 +48,9 @@ class FootprintPreviewGraphicsItem;
 
 namespace editor {
 
+template <typename ElementType>
+class LibraryElementListPopulator;
+
 namespace Ui {
 class PackageChooserDialog;
 }
@@ -89,8 +93,10 @@ class PackageChooserDialog final : public QDialog
                                              QListWidgetItem* previous) noexcept;
         void listPackages_itemDoubleClicked(QListWidgetItem* item) noexcept;
         void setSelectedCategory(const Uuid& uuid) noexcept;
+        void edtSearch_textChanged(const QString& text) noexcept;
         void setSelectedPackage(const Uuid& uuid) noexcept;
         void updatePreview() noexcept;
+        void updateThumbnail(const Uuid& uuid) noexcept;
         void accept() noexcept override;
         const QStringList& localeOrder() const noexcept;
 
@@ -100,12 +106,13 @@ class PackageChooserDialog final : public QDialog
         const IF_GraphicsLayerProvider* mLayerProvider;
         QScopedPointer<Ui::PackageChooserDialog> mUi;
         QScopedPointer<QAbstractItemModel> mCategoryTreeModel;
+        QScopedPointer<LibraryElementListPopulator<Package>> mListPopulator;
         Uuid mSelectedCategoryUuid;
         Uuid mSelectedPackageUuid;
 
         // preview
         FilePath mPackageFilePath;
-        QScopedPointer<Package> mPackage;
+        std::shared_ptr<const Package> mPackage;
         QScopedPointer<GraphicsScene> mGraphicsScene;
         QScopedPointer<FootprintPreviewGraphicsItem> mGraphicsItem;
 };
@@ -24,12 +24,15 @@
 #include <QtWidgets>
 #include "symbolchooserdialog.h"
 #include "ui_symbolchooserdialog.h"
+#include "libraryelementlistpopulator.h"
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/library/sym/symbol.h>
-#include <librepcb/library/sym/symbolgraphicsitem.h>
+#include <librepcb/library/sym/symbolpreviewgraphicsitem.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
+#include <librepcb/workspace/library/workspacelibrarythumbnails.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
 
 /*****************************************************************************************
@@ -61,6 +64,14 @@ SymbolChooserDialog::SymbolChooserDialog(const workspace::Workspace& ws,
             this, &SymbolChooserDialog::listSymbols_currentItemChanged);
     connect(mUi->listSymbols, &QListWidget::itemDoubleClicked,
             this, &SymbolChooserDialog::listSymbols_itemDoubleClicked);
+    connect(mUi->edtSearch, &QLineEdit::textChanged,
+            this, &SymbolChooserDialog::edtSearch_textChanged);
+    mListPopulator.reset(new LibraryElementListPopulator<Symbol>(mWorkspace, *mUi->listSymbols));
+
+    // show the symbol thumbnails as icons, they are rendered in the background
+    mUi->listSymbols->setIconSize(QSize(48, 48));
+    connect(&mWorkspace.getLibraryThumbnails(), &workspace::WorkspaceLibraryThumbnails::thumbnailReady,
+            this, &SymbolChooserDialog::updateThumbnail);
 
     setSelectedSymbol(FilePath());
 }
@@ -105,7 +116,7 @@ void SymbolChooserDialog::listSymbols_currentItemChanged(QListWidgetItem* curren
 {
     Q_UNUSED(previous);
     if (current) {
-        setSelectedSymbol(FilePath(current->data(Qt::UserRole).toString()));
+        setSelectedSymbol(FilePath(current->data(Qt::UserRole + 1).toString()));
     } else {
         setSelectedSymbol(FilePath());
     }
@@ -114,7 +125,7 @@ void SymbolChooserDialog::listSymbols_currentItemChanged(QListWidgetItem* curren
 void SymbolChooserDialog::listSymbols_itemDoubleClicked(QListWidgetItem* item) noexcept
 {
     if (item) {
-        setSelectedSymbol(FilePath(item->data(Qt::UserRole).toString()));
+        setSelectedSymbol(FilePath(item->data(Qt::UserRole + 1).toString()));
         accept();
     }
 }
@@ -123,23 +134,22 @@ void SymbolChooserDialog::setSelectedCategory(const Uuid& uuid) noexcept
 {
     if ((uuid == mSelectedCategoryUuid) && (!uuid.isNull())) return;
 
-    setSelectedSymbol(FilePath());
-    mUi->listSymbols->clear();
-
     mSelectedCategoryUuid = uuid;
+    if (!mUi->edtSearch->text().isEmpty()) {
+        mUi->edtSearch->clear(); // shows the elements of the selected category
+    } else {
+        edtSearch_textChanged(QString());
+    }
+}
+
+void SymbolChooserDialog::edtSearch_textChanged(const QString& text) noexcept
+{
+    setSelectedSymbol(FilePath());
     try {
-        QSet<Uuid> symbols = mWorkspace.getLibraryDb().getSymbolsByCategory(uuid); // can throw
-        foreach (const Uuid& symbolUuid, symbols) {
-            try {
-                QString symName;
-                FilePath symFp = mWorkspace.getLibraryDb().getLatestSymbol(symbolUuid); // can throw
-                mWorkspace.getLibraryDb().getElementTranslations<Symbol>(symFp, localeOrder(), &symName); // can throw
-                QListWidgetItem* item = new QListWidgetItem(symName);
-                item->setData(Qt::UserRole, symFp.toStr());
-                mUi->listSymbols->addItem(item);
-            } catch (const Exception& e) {
-                continue; // should we do something here?
-            }
+        if (text.trimmed().isEmpty()) {
+            mListPopulator->showCategory(mSelectedCategoryUuid); // can throw
+        } else {
+            mListPopulator->showSearchResults(text); // can throw
         }
     } catch (const Exception& e) {
         QMessageBox::critical(this, tr("Could not load symbols"), e.getMsg());
@@ -158,11 +168,12 @@ void SymbolChooserDialog::setSelectedSymbol(const FilePath& fp) noexcept
 
     if (fp.isValid()) {
         try {
-            mSelectedSymbol.reset(new Symbol(fp, true)); // can throw
+            mSelectedSymbol = mWorkspace.getLibraryElementCache().getElement<Symbol>(fp); // can throw
             mUi->lblSymbolUuid->setText(mSelectedSymbol->getUuid().toStr());
             mUi->lblSymbolName->setText(mSelectedSymbol->getNames().value(localeOrder()));
             mUi->lblSymbolDescription->setText(mSelectedSymbol->getDescriptions().value(localeOrder()));
-            mGraphicsItem.reset(new SymbolGraphicsItem(*mSelectedSymbol, mLayerProvider));
+            mGraphicsItem.reset(new SymbolPreviewGraphicsItem(mLayerProvider, QStringList(),
+                                                              *mSelectedSymbol));
             mPreviewScene->addItem(*mGraphicsItem);
             mUi->graphicsView->zoomAll();
         } catch (const Exception& e) {
@@ -171,6 +182,11 @@ void SymbolChooserDialog::setSelectedSymbol(const FilePath& fp) noexcept
     }
 }
 
+void SymbolChooserDialog::updateThumbnail(const Uuid& uuid) noexcept
+{
+    mListPopulator->updateThumbnail(uuid);
+}
+
 void SymbolChooserDialog::accept() noexcept
 {
     if (!mSelectedSymbol) {
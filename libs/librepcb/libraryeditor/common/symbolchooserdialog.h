@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/uuid.h>
@@ -43,10 +44,13 @@ class Workspace;
 namespace library {
 
 class Symbol;
-class SymbolGraphicsItem;
+class SymbolPreviewGraphicsItem;
 
 namespace editor {
 
+template <typename ElementType>
+class LibraryElementListPopulator;
+
 namespace Ui {
 class SymbolChooserDialog;
 }
@@ -91,7 +95,9 @@ class SymbolChooserDialog final : public QDialog
                                             QListWidgetItem* previous) noexcept;
         void listSymbols_itemDoubleClicked(QListWidgetItem* item) noexcept;
         void setSelectedCategory(const Uuid& uuid) noexcept;
+        void edtSearch_textChanged(const QString& text) noexcept;
         void setSelectedSymbol(const FilePath& fp) noexcept;
+        void updateThumbnail(const Uuid& uuid) noexcept;
         void accept() noexcept override;
         const QStringList& localeOrder() const noexcept;
 
@@ -101,10 +107,11 @@ class SymbolChooserDialog final : public QDialog
         const IF_GraphicsLayerProvider& mLayerProvider;
         QScopedPointer<Ui::SymbolChooserDialog> mUi;
         QScopedPointer<QAbstractItemModel> mCategoryTreeModel;
+        QScopedPointer<LibraryElementListPopulator<Symbol>> mListPopulator;
         QScopedPointer<GraphicsScene> mPreviewScene;
         Uuid mSelectedCategoryUuid;
-        QScopedPointer<Symbol> mSelectedSymbol;
-        QScopedPointer<SymbolGraphicsItem> mGraphicsItem;
+        std::shared_ptr<const Symbol> mSelectedSymbol;
+        QScopedPointer<SymbolPreviewGraphicsItem> mGraphicsItem;
 };
 
 /*****************************************************************************************
@@ -36,6 +36,7 @@
 #include <librepcb/library/pkg/footprintpreviewgraphicsitem.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
 #include "../common/componentchooserdialog.h"
 #include "../common/packagechooserdialog.h"
 
@@ -50,9 +51,9 @@ namespace editor {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-DeviceEditorWidget::DeviceEditorWidget(const Context& context, const FilePath& fp,
-                                       QWidget* parent) :
-    EditorWidgetBase(context, fp, parent), mUi(new Ui::DeviceEditorWidget)
+DeviceEditorWidget::DeviceEditorWidget(const Context& context,
+        std::unique_ptr<Device> device, QWidget* parent) :
+    EditorWidgetBase(context, device->getFilePath(), parent), mUi(new Ui::DeviceEditorWidget)
 {
     mUi->setupUi(this);
     setWindowIcon(QIcon(":/img/library/device.png"));
@@ -71,7 +72,7 @@ DeviceEditorWidget::DeviceEditorWidget(const Context& context, const FilePath& f
     mUi->formLayout->getWidgetPosition(mUi->lblCategories, &row, &role);
     mUi->formLayout->setWidget(row, QFormLayout::FieldRole, mCategoriesEditorWidget.data());
 
-    mDevice.reset(new Device(fp, false)); // can throw
+    mDevice.reset(device.release());
     setWindowTitle(mDevice->getNames().value(getLibLocaleOrder()));
     mUi->lblUuid->setText(QString("<a href=\"%1\">%2</a>").arg(
         mDevice->getFilePath().toQUrl().toString(), mDevice->getUuid().toStr()));
@@ -262,7 +263,7 @@ void DeviceEditorWidget::updateDeviceComponentUuid(const Uuid& uuid) noexcept
         if (!fp.isValid()) {
             throw RuntimeError(__FILE__, __LINE__, tr("Component not found!"));
         }
-        mComponent.reset(new Component(fp, true)); // can throw
+        mComponent = mContext.workspace.getLibraryElementCache().getElement<Component>(fp); // can throw
         mUi->padSignalMapEditorWidget->setSignalList(mComponent->getSignals());
         mUi->lblComponentName->setText(mComponent->getNames().value(getLibLocaleOrder()));
         mUi->lblComponentName->setStyleSheet("");
@@ -281,12 +282,13 @@ void DeviceEditorWidget::updateComponentPreview() noexcept
         for (const ComponentSymbolVariantItem& item : symbVar.getSymbolItems()) {
             try {
                 FilePath fp = mContext.workspace.getLibraryDb().getLatestSymbol(item.getSymbolUuid()); // can throw
-                std::shared_ptr<Symbol> sym = std::make_shared<Symbol>(fp, true); // can throw
+                std::shared_ptr<const Symbol> sym =
+                    mContext.workspace.getLibraryElementCache().getElement<Symbol>(fp); // can throw
                 mSymbols.append(sym);
                 std::shared_ptr<SymbolPreviewGraphicsItem> graphicsItem =
                     std::make_shared<SymbolPreviewGraphicsItem>(
                             mContext.layerProvider, QStringList(), *sym,
-                            mComponent.data(), symbVar.getUuid(), item.getUuid());
+                            mComponent.get(), symbVar.getUuid(), item.getUuid());
                 graphicsItem->setPos(item.getSymbolPosition().toPxQPointF());
                 graphicsItem->setRotation(-item.getSymbolRotation().toDeg());
                 mComponentGraphicsScene->addItem(*graphicsItem);
@@ -308,7 +310,7 @@ void DeviceEditorWidget::updateDevicePackageUuid(const Uuid& uuid) noexcept
         if (!fp.isValid()) {
             throw RuntimeError(__FILE__, __LINE__, tr("Package not found!"));
         }
-        mPackage.reset(new Package(fp, true)); // can throw
+        mPackage = mContext.workspace.getLibraryElementCache().getElement<Package>(fp); // can throw
         mUi->padSignalMapEditorWidget->setPadList(mPackage->getPads());
         mUi->lblPackageName->setText(mPackage->getNames().value(getLibLocaleOrder()));
         mUi->lblPackageName->setStyleSheet("");
@@ -325,7 +327,7 @@ void DeviceEditorWidget::updatePackagePreview() noexcept
     if (mPackage && mPackage->getFootprints().count() > 0) {
         mFootprintGraphicsItem.reset(new FootprintPreviewGraphicsItem(
             mContext.layerProvider, QStringList(), *mPackage->getFootprints().first(),
-            mPackage.data(), mComponent.data()));
+            mPackage.get(), mComponent.get()));
         mPackageGraphicsScene->addItem(*mFootprintGraphicsItem);
         mUi->viewPackage->zoomAll();
     }
@@ -346,6 +348,42 @@ bool DeviceEditorWidget::isInterfaceBroken() const noexcept
     return false;
 }
 
+std::function<QStringList()> DeviceEditorWidget::prepareChecks() const noexcept
+{
+    QString name = mUi->edtName->text();
+    QString version = mUi->edtVersion->text();
+    bool hasComponent = (mComponent != nullptr);
+    bool hasPackage = (mPackage != nullptr);
+    QList<QPair<Uuid, QString>> pads;
+    if (mPackage) {
+        for (const PackagePad& pad : mPackage->getPads()) {
+            pads.append(qMakePair(pad.getUuid(), pad.getName()));
+        }
+    }
+    QSet<Uuid> connectedPads;
+    for (const DevicePadSignalMapItem& item : mDevice->getPadSignalMap()) {
+        if (!item.getSignalUuid().isNull()) {
+            connectedPads.insert(item.getPadUuid());
+        }
+    }
+    return [name, version, hasComponent, hasPackage, pads, connectedPads]() {
+        QStringList messages = checkNameAndVersion(name, version);
+        if (!hasComponent) {
+            messages.append(tr("The component of the device was not found."));
+        }
+        if (!hasPackage) {
+            messages.append(tr("The package of the device was not found."));
+        }
+        for (const QPair<Uuid, QString>& pad : pads) {
+            if (!connectedPads.contains(pad.first)) {
+                messages.append(tr("The pad \"%1\" is not connected to a signal.")
+                                .arg(pad.second));
+            }
+        }
+        return messages;
+    };
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/exceptions.h>
@@ -72,7 +73,7 @@ class DeviceEditorWidget final : public EditorWidgetBase
         // Constructors / Destructor
         DeviceEditorWidget() = delete;
         DeviceEditorWidget(const DeviceEditorWidget& other) = delete;
-        DeviceEditorWidget(const Context& context, const FilePath& fp,
+        DeviceEditorWidget(const Context& context, std::unique_ptr<Device> device,
                            QWidget* parent = nullptr);
         ~DeviceEditorWidget() noexcept;
 
@@ -96,6 +97,7 @@ class DeviceEditorWidget final : public EditorWidgetBase
         void updatePackagePreview() noexcept;
         void memorizeDeviceInterface() noexcept;
         bool isInterfaceBroken() const noexcept override;
+        std::function<QStringList()> prepareChecks() const noexcept override;
 
 
     private: // Data
@@ -104,13 +106,13 @@ class DeviceEditorWidget final : public EditorWidgetBase
         QScopedPointer<Device> mDevice;
 
         // component
-        QScopedPointer<Component> mComponent;
+        std::shared_ptr<const Component> mComponent;
         QScopedPointer<GraphicsScene> mComponentGraphicsScene;
-        QList<std::shared_ptr<Symbol>> mSymbols;
+        QList<std::shared_ptr<const Symbol>> mSymbols;
         QList<std::shared_ptr<SymbolPreviewGraphicsItem>> mSymbolGraphicsItems;
 
         // package
-        QScopedPointer<Package> mPackage;
+        std::shared_ptr<const Package> mPackage;
         QScopedPointer<GraphicsScene> mPackageGraphicsScene;
         QScopedPointer<FootprintPreviewGraphicsItem> mFootprintGraphicsItem;
 
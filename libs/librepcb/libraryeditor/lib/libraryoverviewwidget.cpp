@@ -169,11 +169,10 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget, const QIc
         // get all library element names
         QList<FilePath> elements = mContext.workspace.getLibraryDb().getLibraryElements
                                    <ElementType>(mLibrary->getFilePath()); // can throw
+        auto translations = mContext.workspace.getLibraryDb().getElementTranslations
+                            <ElementType>(elements, getLibLocaleOrder()); // can throw
         foreach (const FilePath& filepath, elements) {
-            QString name;
-            mContext.workspace.getLibraryDb().getElementTranslations<ElementType>(
-                filepath, getLibLocaleOrder(), &name); // can throw
-            elementNames.insert(filepath, name);
+            elementNames.insert(filepath, translations.value(filepath).name);
         }
     } catch (const Exception& e) {
         listWidget.clear();
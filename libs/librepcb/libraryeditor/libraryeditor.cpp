@@ -26,6 +26,7 @@
 #include "libraryeditor.h"
 #include "ui_libraryeditor.h"
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/filewritebatch.h>
 #include <librepcb/common/utils/undostackactiongroup.h>
 #include <librepcb/common/utils/exclusiveactiongroup.h>
 #include <librepcb/library/library.h>
@@ -48,19 +49,168 @@ namespace librepcb {
 namespace library {
 namespace editor {
 
+/*****************************************************************************************
+ *  Class LibraryEditor::ElementLoaderBase
+ ****************************************************************************************/
+
+/**
+ * @brief Parses a library element in a thread pool worker
+ *
+ * When parsing is done, the library editor is notified in its own thread and creates the
+ * editor widget with #createEditorWidget(). The placeholder tab is tracked with a
+ * QPointer because the user may close it while the element is still loading.
+ */
+class LibraryEditor::ElementLoaderBase : public QRunnable
+{
+    public:
+        ElementLoaderBase(LibraryEditor& editor, const FilePath& directory,
+                          bool isNewElement, QWidget* placeholder) noexcept :
+            mEditor(editor), mMainThread(editor.thread()), mDirectory(directory),
+            mIsNewElement(isNewElement), mPlaceholder(placeholder), mFinished(0)
+        {
+            setAutoDelete(false);
+        }
+
+        virtual ~ElementLoaderBase() noexcept {}
+
+        const FilePath& getDirectory() const noexcept {return mDirectory;}
+        bool isNewElement() const noexcept {return mIsNewElement;}
+        QWidget* getPlaceholder() const noexcept {return mPlaceholder.data();}
+        bool isFinished() const noexcept {return mFinished.loadAcquire() != 0;}
+
+        /**
+         * @brief Create the editor widget for the parsed element
+         *
+         * Must only be called from the main thread after #isFinished() returned true.
+         *
+         * @throw Exception if the element could not be parsed
+         */
+        virtual EditorWidgetBase* createEditorWidget(const EditorWidgetBase::Context& context) = 0;
+
+    protected:
+        void finished() noexcept
+        {
+            // this object may be deleted by the main thread as soon as it is finished
+            LibraryEditor* editor = &mEditor;
+            mFinished.storeRelease(1);
+            QMetaObject::invokeMethod(editor, "elementLoaderFinished", Qt::QueuedConnection);
+        }
+
+        LibraryEditor& mEditor;
+        QThread* mMainThread;
+        FilePath mDirectory;
+        bool mIsNewElement;
+        QPointer<QWidget> mPlaceholder;
+        QAtomicInt mFinished;
+};
+
+/*****************************************************************************************
+ *  Class LibraryEditor::ElementLoader
+ ****************************************************************************************/
+
+template <typename ElementType, typename EditWidgetType>
+class LibraryEditor::ElementLoader final : public LibraryEditor::ElementLoaderBase
+{
+    public:
+        ElementLoader(LibraryEditor& editor, const FilePath& directory, bool isNewElement,
+                      QWidget* placeholder) noexcept :
+            ElementLoaderBase(editor, directory, isNewElement, placeholder) {}
+
+        void run() noexcept override
+        {
+            try {
+                mElement.reset(new ElementType(mDirectory, false)); // can throw
+                mElement->moveToThread(mMainThread);
+            } catch (const Exception& e) {
+                mError.reset(e.clone());
+            }
+            finished();
+        }
+
+        EditorWidgetBase* createEditorWidget(const EditorWidgetBase::Context& context) override
+        {
+            if (mError) mError->raise();
+            return new EditWidgetType(context, std::move(mElement)); // can throw
+        }
+
+    private:
+        std::unique_ptr<ElementType> mElement;
+        QScopedPointer<Exception> mError;
+};
+
+/*****************************************************************************************
+ *  Class LibraryEditor::ElementWriter
+ ****************************************************************************************/
+
+/**
+ * @brief Writes the files of a saved library element in the workspace's JobScheduler
+ *
+ * The files are collected in the main thread while the editor widget saves the element,
+ * and then written as a transaction, so a failed save never leaves a half written
+ * element behind. Like the placeholders of #ElementLoaderBase, the editor widget is
+ * tracked with a QPointer because the user may close it in the meantime.
+ */
+class LibraryEditor::ElementWriter final : public QRunnable
+{
+    public:
+        ElementWriter(LibraryEditor& editor, EditorWidgetBase& widget) noexcept :
+            mEditor(editor), mWidget(&widget), mDirectory(widget.getFilePath()),
+            mFinished(0)
+        {
+            setAutoDelete(false);
+        }
+
+        FileWriteBatch& getBatch() noexcept {return mBatch;}
+        EditorWidgetBase* getWidget() const noexcept {return mWidget.data();}
+        const FilePath& getDirectory() const noexcept {return mDirectory;}
+        bool isFinished() const noexcept {return mFinished.loadAcquire() != 0;}
+
+        /**
+         * @brief Get the error message (must only be called after #isFinished())
+         *
+         * @return The error message, or an empty string if all files were written
+         */
+        const QString& getError() const noexcept {return mError;}
+
+        void run() noexcept override
+        {
+            try {
+                mBatch.commit(); // can throw
+            } catch (const Exception& e) {
+                mError = e.getMsg();
+            }
+            // this object may be deleted by the main thread as soon as it is finished
+            LibraryEditor* editor = &mEditor;
+            mFinished.storeRelease(1);
+            QMetaObject::invokeMethod(editor, "elementWriterFinished", Qt::QueuedConnection);
+        }
+
+    private:
+        LibraryEditor& mEditor;
+        QPointer<EditorWidgetBase> mWidget;
+        FilePath mDirectory;
+        FileWriteBatch mBatch;
+        QString mError;
+        QAtomicInt mFinished;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 LibraryEditor::LibraryEditor(workspace::Workspace& ws, QSharedPointer<Library> lib) :
     QMainWindow(nullptr), mWorkspace(ws), mLibrary(lib), mUi(new Ui::LibraryEditor),
-    mCurrentEditorWidget(nullptr), mLock(lib->getFilePath())
+    mCurrentEditorWidget(nullptr), mLock(lib->getFilePath()),
+    mElementWriterJobs(ws.getJobScheduler(), JobScheduler::Priority::Visible),
+    mLibraryRescanPending(false)
 {
     mUi->setupUi(this);
     connect(mUi->actionNew, &QAction::triggered,
             this, &LibraryEditor::newElementTriggered);
     connect(mUi->actionSave, &QAction::triggered,
             this, &LibraryEditor::saveTriggered);
+    connect(mUi->actionSaveAll, &QAction::triggered,
+            this, &LibraryEditor::saveAllTriggered);
     connect(mUi->actionRemoveElement, &QAction::triggered,
             this, &LibraryEditor::removeElementTriggered);
     connect(mUi->actionUpdateLibraryDb, &QAction::triggered,
@@ -87,7 +237,7 @@ LibraryEditor::LibraryEditor(workspace::Workspace& ws, QSharedPointer<Library> l
             this, &LibraryEditor::tabCloseRequested);
 
     // lock the library directory
-    mLock.tryLock(); // can throw
+    mLock.tryLock(nullptr, DirectoryLock::sDefaultTimeout); // can throw
 
     // set window title
     const QStringList localeOrder = mWorkspace.getSettings().getLibLocaleOrder().getLocaleOrder();
@@ -229,12 +379,18 @@ LibraryEditor::LibraryEditor(workspace::Workspace& ws, QSharedPointer<Library> l
 
 LibraryEditor::~LibraryEditor() noexcept
 {
+    mElementLoaderThreadPool.clear();
+    mElementLoaderThreadPool.waitForDone();
+    mElementLoaders.clear();
+    mElementWriterJobs.waitForDone(); // never discard saved elements
+    mElementWriters.clear();
     setActiveEditorWidget(nullptr);
     for (int i = mUi->tabWidget->count() - 1; i >= 0; --i) {
         QWidget* widget = mUi->tabWidget->widget(i);
         mUi->tabWidget->removeTab(i);
         delete widget;
     }
+    mLayersByName.clear();
     qDeleteAll(mLayers); mLayers.clear();
 }
 
@@ -302,7 +458,21 @@ void LibraryEditor::newElementTriggered() noexcept
 
 void LibraryEditor::saveTriggered() noexcept
 {
-    if (mCurrentEditorWidget) mCurrentEditorWidget->save();
+    if (mCurrentEditorWidget) {
+        saveEditorWidgets({mCurrentEditorWidget});
+    }
+}
+
+void LibraryEditor::saveAllTriggered() noexcept
+{
+    QList<EditorWidgetBase*> widgets;
+    for (int i = 0; i < mUi->tabWidget->count(); ++i) {
+        EditorWidgetBase* widget = dynamic_cast<EditorWidgetBase*>(mUi->tabWidget->widget(i));
+        if (widget && widget->isDirty()) {
+            widgets.append(widget);
+        }
+    }
+    saveEditorWidgets(widgets);
 }
 
 void LibraryEditor::removeElementTriggered() noexcept
@@ -316,6 +486,7 @@ void LibraryEditor::removeElementTriggered() noexcept
         "\"%1\"?\n\nThis cannot be undone!")).arg(mCurrentEditorWidget->windowTitle()),
         QMessageBox::Yes, QMessageBox::Cancel);
     if (ret == QMessageBox::Yes) {
+        waitForElementWriters(); // the files must not be written after removing them
         FilePath elementDir = mCurrentEditorWidget->getFilePath();
         mUi->tabWidget->removeTab(mUi->tabWidget->currentIndex());
         setActiveEditorWidget(nullptr);
@@ -402,28 +573,102 @@ void LibraryEditor::editDeviceTriggered(const FilePath& fp) noexcept
 template <typename ElementType, typename EditWidgetType>
 void LibraryEditor::editLibraryElementTriggered(const FilePath& fp, bool isNewElement) noexcept
 {
-    try {
-        for (int i = 0; i < mUi->tabWidget->count(); i++) {
-            EditorWidgetBase* widget = dynamic_cast<EditorWidgetBase*>(mUi->tabWidget->widget(i));
-            if (widget && (widget->getFilePath() == fp)) {
-                mUi->tabWidget->setCurrentIndex(i);
-                return;
+    for (int i = 0; i < mUi->tabWidget->count(); i++) {
+        EditorWidgetBase* widget = dynamic_cast<EditorWidgetBase*>(mUi->tabWidget->widget(i));
+        if (widget && (widget->getFilePath() == fp)) {
+            mUi->tabWidget->setCurrentIndex(i);
+            return;
+        }
+    }
+    foreach (const std::shared_ptr<ElementLoaderBase>& loader, mElementLoaders) {
+        if (loader->getPlaceholder() && (loader->getDirectory() == fp)) {
+            mUi->tabWidget->setCurrentWidget(loader->getPlaceholder());
+            return;
+        }
+    }
+
+    // parse the element in the background, the tab shows a placeholder until it is done
+    QLabel* placeholder = new QLabel(tr("Loading %1...").arg(fp.toNative()));
+    placeholder->setAlignment(Qt::AlignCenter);
+    placeholder->setEnabled(false);
+    int index = mUi->tabWidget->addTab(placeholder, tr("Loading..."));
+    mUi->tabWidget->setCurrentIndex(index);
+    std::shared_ptr<ElementLoaderBase> loader =
+        std::make_shared<ElementLoader<ElementType, EditWidgetType>>(*this, fp, isNewElement,
+                                                                     placeholder);
+    mElementLoaders.append(loader);
+    mElementLoaderThreadPool.start(loader.get());
+}
+
+void LibraryEditor::elementLoaderFinished() noexcept
+{
+    for (int i = 0; i < mElementLoaders.count(); ) {
+        std::shared_ptr<ElementLoaderBase> loader = mElementLoaders.at(i);
+        if (!loader->isFinished()) {
+            ++i;
+            continue;
+        }
+        mElementLoaders.removeAt(i);
+        QWidget* placeholder = loader->getPlaceholder();
+        if (!placeholder) continue; // the tab was closed while loading
+
+        int index = mUi->tabWidget->indexOf(placeholder);
+        bool isCurrent = (mUi->tabWidget->currentIndex() == index);
+        try {
+            EditorWidgetBase::Context context{mWorkspace, *this, loader->isNewElement()};
+            EditorWidgetBase* widget = loader->createEditorWidget(context); // can throw
+            connect(widget, &QWidget::windowTitleChanged, this, &LibraryEditor::updateTabTitles);
+            connect(widget, &EditorWidgetBase::cursorPositionChanged,
+                    mUi->statusBar, &StatusBar::setAbsoluteCursorPosition);
+            connect(widget, &EditorWidgetBase::dirtyChanged, this, &LibraryEditor::updateTabTitles);
+            connect(widget, &EditorWidgetBase::checkMessagesChanged,
+                    this, &LibraryEditor::updateTabTitles);
+            connect(widget, &EditorWidgetBase::elementEdited,
+                    this, &LibraryEditor::elementEdited);
+            mUi->tabWidget->insertTab(index, widget, widget->windowIcon(), widget->windowTitle());
+            if (isCurrent) {
+                mUi->tabWidget->setCurrentIndex(index);
+            }
+        } catch (const Exception& e) {
+            QMessageBox::critical(this, tr("Failed to open library element"), e.getMsg());
+        }
+        mUi->tabWidget->removeTab(mUi->tabWidget->indexOf(placeholder));
+        delete placeholder;
+    }
+}
+
+void LibraryEditor::elementWriterFinished() noexcept
+{
+    bool anyFinished = false;
+    for (int i = 0; i < mElementWriters.count(); ) {
+        std::shared_ptr<ElementWriter> writer = mElementWriters.at(i);
+        if (!writer->isFinished()) {
+            ++i;
+            continue;
+        }
+        mElementWriters.removeAt(i);
+        anyFinished = true;
+        if (!writer->getError().isEmpty()) {
+            mSaveErrors.insert(writer->getDirectory().toStr(), writer->getError());
+            if (EditorWidgetBase* widget = writer->getWidget()) {
+                widget->setDirty(); // the element needs to be saved again
             }
         }
+    }
 
-        EditorWidgetBase::Context context{mWorkspace, *this, isNewElement};
-        EditWidgetType* widget = new EditWidgetType(context, fp);
-        connect(widget, &QWidget::windowTitleChanged, this, &LibraryEditor::updateTabTitles);
-        connect(widget, &EditorWidgetBase::cursorPositionChanged,
-                mUi->statusBar, &StatusBar::setAbsoluteCursorPosition);
-        connect(widget, &EditorWidgetBase::dirtyChanged, this, &LibraryEditor::updateTabTitles);
-        connect(widget, &EditorWidgetBase::elementEdited,
-                &mWorkspace.getLibraryDb(), &workspace::WorkspaceLibraryDb::startLibraryRescan);
-        int index = mUi->tabWidget->addTab(widget, widget->windowIcon(), widget->windowTitle());
-        mUi->tabWidget->setCurrentIndex(index);
-    } catch (const Exception& e) {
-        QMessageBox::critical(this, tr("Failed to open category"), e.getMsg());
+    if (anyFinished && mElementWriters.isEmpty()) {
+        if (mSaveErrors.isEmpty()) {
+            mUi->statusBar->showMessage(tr("All elements saved."), 2000);
+        } else {
+            mUi->statusBar->showMessage(tr("Failed to save %n element(s).", "",
+                                           mSaveErrors.count()));
+        }
+        if (mLibraryRescanPending) {
+            mLibraryRescanPending = false;
+            mWorkspace.getLibraryDb().startLibraryRescan();
+        }
     }
+    updateTabTitles();
 }
 
 void LibraryEditor::currentTabChanged(int index) noexcept
@@ -435,6 +680,15 @@ bool LibraryEditor::tabCloseRequested(int index) noexcept
 {
     EditorWidgetBase* widget = dynamic_cast<EditorWidgetBase*>(
                                    mUi->tabWidget->widget(index));
+    if (!widget) {
+        // a placeholder of an element which is still loading, the loader discards it
+        delete mUi->tabWidget->widget(index);
+        return true;
+    }
+    if (isElementWriterPending(widget)) {
+        waitForElementWriters(); // to know whether the element was saved successfully
+    }
+    mSaveErrors.remove(widget->getFilePath().toStr());
     if (widget == mCurrentEditorWidget) {
         setActiveEditorWidget(nullptr);
     }
@@ -471,6 +725,17 @@ void LibraryEditor::cursorPositionChanged(const Point& pos) noexcept
         QString("(%1mm | %2mm)").arg(pos.toMmQPointF().x()).arg(pos.toMmQPointF().y()));
 }
 
+void LibraryEditor::elementEdited(const FilePath& fp) noexcept
+{
+    Q_UNUSED(fp);
+    if (FileWriteBatch::getActive()) {
+        // the files are not written yet, so the library would be scanned too early
+        mLibraryRescanPending = true;
+    } else {
+        mWorkspace.getLibraryDb().startLibraryRescan();
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -502,12 +767,27 @@ void LibraryEditor::updateTabTitles() noexcept
         QWidget* widget = mUi->tabWidget->widget(i);
         const EditorWidgetBase* editorWidget = dynamic_cast<EditorWidgetBase*>(widget);
         if (editorWidget) {
+            QString text = editorWidget->windowTitle();
             if (editorWidget->isDirty()) {
-                mUi->tabWidget->setTabText(i, '*' % editorWidget->windowTitle());
-            } else {
-                mUi->tabWidget->setTabText(i, editorWidget->windowTitle());
+                text.prepend('*');
             }
-        } else {
+            if (isElementWriterPending(editorWidget)) {
+                text = tr("%1 (saving...)").arg(text);
+            }
+            QIcon icon = editorWidget->windowIcon();
+            QString toolTip;
+            QString error = mSaveErrors.value(editorWidget->getFilePath().toStr());
+            if (!error.isEmpty()) {
+                icon = QIcon(":/img/status/dialog_error.png");
+                toolTip = tr("Saving failed: %1").arg(error);
+            } else if (!editorWidget->getCheckMessages().isEmpty()) {
+                icon = QIcon(":/img/status/dialog_warning.png");
+                toolTip = editorWidget->getCheckMessages().join('\n');
+            }
+            mUi->tabWidget->setTabText(i, text);
+            mUi->tabWidget->setTabIcon(i, icon);
+            mUi->tabWidget->setTabToolTip(i, toolTip);
+        } else if (!isElementLoaderPlaceholder(widget)) {
             qWarning() << "Tab widget is not a subclass of EditorWidgetBase!";
         }
     }
@@ -524,7 +804,68 @@ void LibraryEditor::closeEvent(QCloseEvent* event) noexcept
 
 void LibraryEditor::addLayer(const QString& name) noexcept
 {
-    mLayers.append(new GraphicsLayer(name));
+    GraphicsLayer* layer = new GraphicsLayer(name);
+    mLayers.append(layer);
+    mLayersByName.insert(name, layer);
+}
+
+bool LibraryEditor::isElementLoaderPlaceholder(const QWidget* widget) const noexcept
+{
+    foreach (const std::shared_ptr<ElementLoaderBase>& loader, mElementLoaders) {
+        if (loader->getPlaceholder() == widget) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LibraryEditor::saveEditorWidgets(const QList<EditorWidgetBase*>& widgets) noexcept
+{
+    foreach (EditorWidgetBase* widget, widgets) {
+        if (isElementWriterPending(widget)) {
+            // writing the same files concurrently would lead in undefined file contents
+            waitForElementWriters();
+        }
+        std::shared_ptr<ElementWriter> writer = std::make_shared<ElementWriter>(*this, *widget);
+        bool success = false;
+        {
+            // the widget serializes the element, but the files are written in the background
+            // (the SmartFile objects of library elements are temporary, so the batch must
+            // not notify them after writing)
+            FileWriteBatch::Collector collector(writer->getBatch());
+            success = widget->save();
+        }
+        if (success) {
+            mSaveErrors.remove(widget->getFilePath().toStr());
+            if (!writer->getBatch().isEmpty()) {
+                mElementWriters.append(writer);
+                mElementWriterJobs.start(writer.get());
+            }
+        }
+    }
+    if (!mElementWriters.isEmpty()) {
+        mUi->statusBar->showMessage(tr("Saving %n element(s)...", "", mElementWriters.count()));
+    } else if (mLibraryRescanPending) {
+        mLibraryRescanPending = false; // there are no files to wait for
+        mWorkspace.getLibraryDb().startLibraryRescan();
+    }
+    updateTabTitles();
+}
+
+bool LibraryEditor::isElementWriterPending(const EditorWidgetBase* widget) const noexcept
+{
+    foreach (const std::shared_ptr<ElementWriter>& writer, mElementWriters) {
+        if (writer->getWidget() == widget) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LibraryEditor::waitForElementWriters() noexcept
+{
+    mElementWriterJobs.waitForDone();
+    elementWriterFinished();
 }
 
 /*****************************************************************************************
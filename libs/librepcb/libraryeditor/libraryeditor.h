@@ -29,6 +29,7 @@
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/fileio/directorylock.h>
+#include <librepcb/common/jobscheduler.h>
 #include <librepcb/common/units/all_length_units.h>
 
 /*****************************************************************************************
@@ -63,6 +64,15 @@ class LibraryEditor;
 /**
  * @brief The LibraryEditor class
  *
+ * Library elements are parsed in a thread pool when they are opened, so the window does
+ * not freeze while loading big elements. Until parsing is done, the tab shows a
+ * placeholder. The editor widget is then built in the main thread.
+ *
+ * Saving works the other way around: the elements are serialized in the main thread,
+ * and the collected files are written in the workspace's JobScheduler, one job per
+ * element. So "Save All" writes the files of many open tabs in parallel, while each
+ * tab shows whether it is still being saved or whether saving has failed.
+ *
  * @author ubruhin
  * @date 2015-06-28
  */
@@ -82,12 +92,7 @@ class LibraryEditor final : public QMainWindow, public IF_GraphicsLayerProvider
          * @copydoc librepcb::IF_GraphicsLayerProvider::getLayer()
          */
         GraphicsLayer* getLayer(const QString& name) const noexcept override {
-            foreach (GraphicsLayer* layer, mLayers) {
-                if (layer->getName() == name) {
-                    return layer;
-                }
-            }
-            return nullptr;
+            return mLayersByName.value(name, nullptr);
         }
 
         /**
@@ -125,9 +130,22 @@ class LibraryEditor final : public QMainWindow, public IF_GraphicsLayerProvider
         LibraryEditor& operator=(const LibraryEditor& rhs) = delete;
 
 
+    private: // Types
+        class ElementLoaderBase;
+        template <typename ElementType, typename EditWidgetType>
+        class ElementLoader;
+        class ElementWriter;
+
+
+    private slots:
+        void elementLoaderFinished() noexcept;
+        void elementWriterFinished() noexcept;
+
+
     private: // GUI Event Handlers
         void newElementTriggered() noexcept;
         void saveTriggered() noexcept;
+        void saveAllTriggered() noexcept;
         void removeElementTriggered() noexcept;
         void rotateCwTriggered() noexcept;
         void rotateCcwTriggered() noexcept;
@@ -148,6 +166,7 @@ class LibraryEditor final : public QMainWindow, public IF_GraphicsLayerProvider
         void currentTabChanged(int index) noexcept;
         bool tabCloseRequested(int index) noexcept;
         void cursorPositionChanged(const Point& pos) noexcept;
+        void elementEdited(const FilePath& fp) noexcept;
 
 
     private: // Methods
@@ -155,6 +174,10 @@ class LibraryEditor final : public QMainWindow, public IF_GraphicsLayerProvider
         void updateTabTitles() noexcept;
         void closeEvent(QCloseEvent* event) noexcept override;
         void addLayer(const QString& name) noexcept;
+        bool isElementLoaderPlaceholder(const QWidget* widget) const noexcept;
+        void saveEditorWidgets(const QList<EditorWidgetBase*>& widgets) noexcept;
+        bool isElementWriterPending(const EditorWidgetBase* widget) const noexcept;
+        void waitForElementWriters() noexcept;
 
 
     private: // Data
@@ -165,8 +188,15 @@ class LibraryEditor final : public QMainWindow, public IF_GraphicsLayerProvider
         QScopedPointer<UndoStackActionGroup> mUndoStackActionGroup;
         QScopedPointer<ExclusiveActionGroup> mToolsActionGroup;
         QList<GraphicsLayer*> mLayers;
+        QHash<QString, GraphicsLayer*> mLayersByName; ///< same layers as #mLayers
         EditorWidgetBase* mCurrentEditorWidget;
         DirectoryLock mLock;
+        QList<std::shared_ptr<ElementLoaderBase>> mElementLoaders; ///< not yet opened elements
+        QThreadPool mElementLoaderThreadPool; ///< parses the elements of #mElementLoaders
+        QList<std::shared_ptr<ElementWriter>> mElementWriters; ///< not yet written elements
+        JobScheduler::Group mElementWriterJobs; ///< writes the files of #mElementWriters
+        QHash<QString, QString> mSaveErrors; ///< key: element directory, value: error message
+        bool mLibraryRescanPending; ///< rescan the library when all files are written
 };
 
 /*****************************************************************************************
@@ -24,8 +24,10 @@ SOURCES += \
     cmp/cmpsigpindisplaytypecombobox.cpp \
     cmp/componenteditorwidget.cpp \
     cmp/componentsignallisteditorwidget.cpp \
+    cmp/componentsignallistmodel.cpp \
     cmp/componentsymbolvarianteditdialog.cpp \
     cmp/componentsymbolvariantitemlisteditorwidget.cpp \
+    cmp/componentsymbolvariantitemlistmodel.cpp \
     cmp/componentsymbolvariantlistwidget.cpp \
     cmp/compsymbvarpinsignalmapeditorwidget.cpp \
     cmpcat/componentcategoryeditorwidget.cpp \
@@ -34,6 +36,7 @@ SOURCES += \
     common/categorytreelabeltextbuilder.cpp \
     common/componentchooserdialog.cpp \
     common/editorwidgetbase.cpp \
+    common/libraryelementlistpopulator.cpp \
     common/packagechooserdialog.cpp \
     common/symbolchooserdialog.cpp \
     dev/deviceeditorwidget.cpp \
@@ -53,7 +56,10 @@ SOURCES += \
     newelementwizard/newelementwizardpage_entermetadata.cpp \
     newelementwizard/newelementwizardpage_packagepads.cpp \
     pkg/dialogs/footprintpadpropertiesdialog.cpp \
+    pkg/dialogs/padarraydialog.cpp \
     pkg/footprintlisteditorwidget.cpp \
+    pkg/footprintlistmodel.cpp \
+    pkg/fsm/cmd/cmdaddpadarray.cpp \
     pkg/fsm/cmd/cmdmoveselectedfootprintitems.cpp \
     pkg/fsm/cmd/cmdremoveselectedfootprintitems.cpp \
     pkg/fsm/cmd/cmdrotateselectedfootprintitems.cpp \
@@ -100,8 +106,10 @@ HEADERS += \
     cmp/cmpsigpindisplaytypecombobox.h \
     cmp/componenteditorwidget.h \
     cmp/componentsignallisteditorwidget.h \
+    cmp/componentsignallistmodel.h \
     cmp/componentsymbolvarianteditdialog.h \
     cmp/componentsymbolvariantitemlisteditorwidget.h \
+    cmp/componentsymbolvariantitemlistmodel.h \
     cmp/componentsymbolvariantlistwidget.h \
     cmp/compsymbvarpinsignalmapeditorwidget.h \
     cmp/if_componentsymbolvarianteditorprovider.h \
@@ -111,6 +119,7 @@ HEADERS += \
     common/categorytreelabeltextbuilder.h \
     common/componentchooserdialog.h \
     common/editorwidgetbase.h \
+    common/libraryelementlistpopulator.h \
     common/packagechooserdialog.h \
     common/symbolchooserdialog.h \
     dev/deviceeditorwidget.h \
@@ -130,7 +139,10 @@ HEADERS += \
     newelementwizard/newelementwizardpage_entermetadata.h \
     newelementwizard/newelementwizardpage_packagepads.h \
     pkg/dialogs/footprintpadpropertiesdialog.h \
+    pkg/dialogs/padarraydialog.h \
     pkg/footprintlisteditorwidget.h \
+    pkg/footprintlistmodel.h \
+    pkg/fsm/cmd/cmdaddpadarray.h \
     pkg/fsm/cmd/cmdmoveselectedfootprintitems.h \
     pkg/fsm/cmd/cmdremoveselectedfootprintitems.h \
     pkg/fsm/cmd/cmdrotateselectedfootprintitems.h \
@@ -197,6 +209,7 @@ FORMS += \
     newelementwizard/newelementwizardpage_entermetadata.ui \
     newelementwizard/newelementwizardpage_packagepads.ui \
     pkg/dialogs/footprintpadpropertiesdialog.ui \
+    pkg/dialogs/padarraydialog.ui \
     pkg/packageeditorwidget.ui \
     pkgcat/packagecategoryeditorwidget.ui \
     sym/dialogs/symbolpinpropertiesdialog.ui \
@@ -22,9 +22,12 @@
  ****************************************************************************************/
 #include "newelementwizardpage_copyfrom.h"
 #include "ui_newelementwizardpage_copyfrom.h"
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/library/elements.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
+#include <librepcb/workspace/library/workspacelibrarythumbnails.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
 
 /*****************************************************************************************
@@ -50,6 +53,14 @@ NewElementWizardPage_CopyFrom::NewElementWizardPage_CopyFrom(NewElementWizardCon
             this, &NewElementWizardPage_CopyFrom::listWidget_currentItemChanged);
     connect(mUi->listWidget, &QListWidget::itemDoubleClicked,
             this, &NewElementWizardPage_CopyFrom::listWidget_itemDoubleClicked);
+    connect(mUi->edtSearch, &QLineEdit::textChanged,
+            this, &NewElementWizardPage_CopyFrom::edtSearch_textChanged);
+
+    // show the thumbnails of symbols and packages, they are rendered in the background
+    mUi->listWidget->setIconSize(QSize(48, 48));
+    connect(&mContext.getWorkspace().getLibraryThumbnails(),
+            &workspace::WorkspaceLibraryThumbnails::thumbnailReady,
+            this, &NewElementWizardPage_CopyFrom::updateThumbnail);
 }
 
 NewElementWizardPage_CopyFrom::~NewElementWizardPage_CopyFrom() noexcept
@@ -63,15 +74,27 @@ NewElementWizardPage_CopyFrom::~NewElementWizardPage_CopyFrom() noexcept
 bool NewElementWizardPage_CopyFrom::validatePage() noexcept
 {
     if (!QWizardPage::validatePage()) return false;
-    if (!mSelectedElement) return false;
-    mContext.mElementName = mSelectedElement->getNames().getDefaultValue();
-    mContext.mElementDescription = mSelectedElement->getDescriptions().getDefaultValue();
-    mContext.mElementKeywords = mSelectedElement->getKeywords().getDefaultValue();
+    if (!mSelectedElementPath.isValid()) return false;
+
+    // the element is loaded only now, so browsing through the list is fast
+    std::shared_ptr<const LibraryBaseElement> selectedElement;
+    try {
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        auto sg = scopeGuard([](){QApplication::restoreOverrideCursor();});
+        selectedElement = loadSelectedElement(); // can throw
+    } catch (const Exception& e) {
+        QMessageBox::critical(this, tr("Could not load element"), e.getMsg());
+        return false;
+    }
+
+    mContext.mElementName = selectedElement->getNames().getDefaultValue();
+    mContext.mElementDescription = selectedElement->getDescriptions().getDefaultValue();
+    mContext.mElementKeywords = selectedElement->getKeywords().getDefaultValue();
     if (mIsCategoryElement) {
-        const LibraryCategory* category = dynamic_cast<LibraryCategory*>(mSelectedElement.data()); Q_ASSERT(category);
+        const LibraryCategory* category = dynamic_cast<const LibraryCategory*>(selectedElement.get()); Q_ASSERT(category);
         mContext.mElementCategoryUuid = category->getParentUuid();
     } else {
-        const LibraryElement* element = dynamic_cast<LibraryElement*>(mSelectedElement.data()); Q_ASSERT(element);
+        const LibraryElement* element = dynamic_cast<const LibraryElement*>(selectedElement.get()); Q_ASSERT(element);
         if (element->getCategories().count() > 0) {
             mContext.mElementCategoryUuid = element->getCategories().values().first();
         } else {
@@ -80,21 +103,22 @@ bool NewElementWizardPage_CopyFrom::validatePage() noexcept
     }
     switch (mContext.mElementType) {
         case NewElementWizardContext::ElementType::Symbol: {
-            const Symbol* symbol = dynamic_cast<Symbol*>(mSelectedElement.data()); Q_ASSERT(symbol);
+            const Symbol* symbol = dynamic_cast<const Symbol*>(selectedElement.get()); Q_ASSERT(symbol);
             mContext.mSymbolPins = symbol->getPins();
-            mContext.mSymbolPolygons = symbol->getPolygons();
+            mContext.mSymbolPolygons = symbol->getCompactPolygons()
+                ? symbol->getCompactPolygons()->toPolygonList() : symbol->getPolygons();
             mContext.mSymbolEllipses = symbol->getEllipses();
             mContext.mSymbolTexts = symbol->getTexts();
             break;
         }
         case NewElementWizardContext::ElementType::Package: {
-            const Package* package = dynamic_cast<Package*>(mSelectedElement.data()); Q_ASSERT(package);
+            const Package* package = dynamic_cast<const Package*>(selectedElement.get()); Q_ASSERT(package);
             mContext.mPackagePads = package->getPads();
             mContext.mPackageFootprints = package->getFootprints();
             break;
         }
         case NewElementWizardContext::ElementType::Component: {
-            const Component* element = dynamic_cast<Component*>(mSelectedElement.data()); Q_ASSERT(element);
+            const Component* element = dynamic_cast<const Component*>(selectedElement.get()); Q_ASSERT(element);
             mContext.mComponentSchematicOnly = element->isSchematicOnly();
             mContext.mComponentAttributes = element->getAttributes();
             mContext.mComponentDefaultValue = element->getDefaultValue();
@@ -104,7 +128,7 @@ bool NewElementWizardPage_CopyFrom::validatePage() noexcept
             break;
         }
         case NewElementWizardContext::ElementType::Device: {
-            const Device* element = dynamic_cast<Device*>(mSelectedElement.data()); Q_ASSERT(element);
+            const Device* element = dynamic_cast<const Device*>(selectedElement.get()); Q_ASSERT(element);
             mContext.mDeviceComponentUuid = element->getComponentUuid();
             mContext.mDevicePackageUuid = element->getPackageUuid();
             mContext.mDevicePadSignalMap = element->getPadSignalMap();
@@ -119,7 +143,7 @@ bool NewElementWizardPage_CopyFrom::validatePage() noexcept
 
 bool NewElementWizardPage_CopyFrom::isComplete() const noexcept
 {
-    return mSelectedElement ? true : false;
+    return mSelectedElementPath.isValid();
 }
 
 int NewElementWizardPage_CopyFrom::nextId() const noexcept
@@ -165,79 +189,75 @@ void NewElementWizardPage_CopyFrom::listWidget_itemDoubleClicked(QListWidgetItem
     }
 }
 
-void NewElementWizardPage_CopyFrom::setSelectedCategory(const Uuid& uuid) noexcept
+void NewElementWizardPage_CopyFrom::edtSearch_textChanged(const QString& text) noexcept
 {
-    if ((uuid == mSelectedCategoryUuid) && (!uuid.isNull())) return;
-
-    setSelectedElement(FilePath());
-    mUi->listWidget->clear();
-    mSelectedCategoryUuid = uuid;
-
+    if (mIsCategoryElement) return;
     try {
-        if (mIsCategoryElement) {
-            setSelectedElement(getCategoryFilePath(uuid)); // can throw
+        if (text.trimmed().isEmpty()) {
+            setElementList(getElementsByCategory(mSelectedCategoryUuid).toList()); // can throw
         } else {
-            QSet<Uuid> elements = getElementsByCategory(uuid); // can throw
-            foreach (const Uuid& elementUuid, elements) {
-                try {
-                    FilePath fp;
-                    QString name;
-                    getElementMetadata(elementUuid, fp, name);
-                    QListWidgetItem* item = new QListWidgetItem(name);
-                    item->setData(Qt::UserRole, fp.toStr());
-                    mUi->listWidget->addItem(item);
-                } catch (const Exception& e) {
-                    continue; // should we do something here?
-                }
-            }
+            setElementList(searchElements(text)); // can throw
         }
     } catch (const Exception& e) {
-        // what could we do here?
+        setElementList(QList<Uuid>());
     }
 }
 
-void NewElementWizardPage_CopyFrom::setSelectedElement(const FilePath& fp) noexcept
+void NewElementWizardPage_CopyFrom::updateThumbnail(const Uuid& uuid) noexcept
 {
-    if (mSelectedElement && (mSelectedElement->getFilePath() == fp)) return;
+    for (int i = 0; i < mUi->listWidget->count(); ++i) {
+        QListWidgetItem* item = mUi->listWidget->item(i);
+        if (item->data(Qt::UserRole + 1).toString() == uuid.toStr()) {
+            item->setIcon(QIcon(QPixmap::fromImage(getElementThumbnail(uuid))));
+        }
+    }
+}
 
-    mSelectedElement.reset();
+void NewElementWizardPage_CopyFrom::setSelectedCategory(const Uuid& uuid) noexcept
+{
+    if ((uuid == mSelectedCategoryUuid) && (!uuid.isNull())) return;
 
-    if (fp.isValid()) {
+    mSelectedCategoryUuid = uuid;
+    if (mIsCategoryElement) {
         try {
-            switch (mContext.mElementType) {
-                case NewElementWizardContext::ElementType::ComponentCategory: {
-                    mSelectedElement.reset(new ComponentCategory(fp, true));
-                    break;
-                }
-                case NewElementWizardContext::ElementType::PackageCategory: {
-                    mSelectedElement.reset(new PackageCategory(fp, true));
-                    break;
-                }
-                case NewElementWizardContext::ElementType::Symbol: {
-                    mSelectedElement.reset(new Symbol(fp, true));
-                    break;
-                }
-                case NewElementWizardContext::ElementType::Component: {
-                    mSelectedElement.reset(new Component(fp, true));
-                    break;
-                }
-                case NewElementWizardContext::ElementType::Device: {
-                    mSelectedElement.reset(new Device(fp, true));
-                    break;
-                }
-                case NewElementWizardContext::ElementType::Package: {
-                    mSelectedElement.reset(new Package(fp, true));
-                    break;
-                }
-                default: {
-                    qCritical() << "Unknown enum value:" << static_cast<int>(mContext.mElementType);
-                    break;
-                }
+            setSelectedElement(getCategoryFilePath(uuid)); // can throw
+        } catch (const Exception& e) {
+            setSelectedElement(FilePath());
+        }
+    } else if (!mUi->edtSearch->text().isEmpty()) {
+        mUi->edtSearch->clear(); // shows the elements of the selected category
+    } else {
+        edtSearch_textChanged(QString());
+    }
+}
+
+void NewElementWizardPage_CopyFrom::setElementList(const QList<Uuid>& elements) noexcept
+{
+    setSelectedElement(FilePath());
+    mUi->listWidget->clear();
+    foreach (const Uuid& elementUuid, elements) {
+        try {
+            FilePath fp;
+            QString name;
+            getElementMetadata(elementUuid, fp, name); // can throw
+            QListWidgetItem* item = new QListWidgetItem(name);
+            item->setData(Qt::UserRole, fp.toStr());
+            item->setData(Qt::UserRole + 1, elementUuid.toStr());
+            QImage thumbnail = getElementThumbnail(elementUuid);
+            if (!thumbnail.isNull()) {
+                item->setIcon(QIcon(QPixmap::fromImage(thumbnail)));
             }
+            mUi->listWidget->addItem(item);
         } catch (const Exception& e) {
-            // what could we do here?
+            continue; // should we do something here?
         }
     }
+}
+
+void NewElementWizardPage_CopyFrom::setSelectedElement(const FilePath& fp) noexcept
+{
+    if (fp == mSelectedElementPath) return;
+    mSelectedElementPath = fp;
     emit completeChanged();
 }
 
@@ -277,6 +297,24 @@ QSet<Uuid> NewElementWizardPage_CopyFrom::getElementsByCategory(const Uuid& cate
     }
 }
 
+QList<Uuid> NewElementWizardPage_CopyFrom::searchElements(const QString& query) const
+{
+    const workspace::WorkspaceLibraryDb& db = mContext.getWorkspace().getLibraryDb();
+    const QStringList& lo = mContext.getLibLocaleOrder();
+    const int limit = 200; // more results are not useful in a list anyway
+    switch (mContext.mElementType) {
+        case NewElementWizardContext::ElementType::Symbol:
+            return db.searchElements<Symbol>(query, lo, limit); // can throw
+        case NewElementWizardContext::ElementType::Component:
+            return db.searchElements<Component>(query, lo, limit); // can throw
+        case NewElementWizardContext::ElementType::Device:
+            return db.searchElements<Device>(query, lo, limit); // can throw
+        case NewElementWizardContext::ElementType::Package:
+            return db.searchElements<Package>(query, lo, limit); // can throw
+        default: throw LogicError(__FILE__, __LINE__);
+    }
+}
+
 void NewElementWizardPage_CopyFrom::getElementMetadata(const Uuid& uuid, FilePath& fp,
                                                        QString& name) const
 {
@@ -305,6 +343,36 @@ void NewElementWizardPage_CopyFrom::getElementMetadata(const Uuid& uuid, FilePat
     }
 }
 
+QImage NewElementWizardPage_CopyFrom::getElementThumbnail(const Uuid& uuid) const noexcept
+{
+    workspace::WorkspaceLibraryThumbnails& thumbnails = mContext.getWorkspace().getLibraryThumbnails();
+    switch (mContext.mElementType) {
+        case NewElementWizardContext::ElementType::Symbol:  return thumbnails.getSymbolThumbnail(uuid);
+        case NewElementWizardContext::ElementType::Package: return thumbnails.getPackageThumbnail(uuid);
+        default:                                            return QImage();
+    }
+}
+
+std::shared_ptr<const LibraryBaseElement> NewElementWizardPage_CopyFrom::loadSelectedElement() const
+{
+    workspace::WorkspaceLibraryElementCache& cache = mContext.getWorkspace().getLibraryElementCache();
+    switch (mContext.mElementType) {
+        case NewElementWizardContext::ElementType::ComponentCategory:
+            return cache.getElement<ComponentCategory>(mSelectedElementPath); // can throw
+        case NewElementWizardContext::ElementType::PackageCategory:
+            return cache.getElement<PackageCategory>(mSelectedElementPath); // can throw
+        case NewElementWizardContext::ElementType::Symbol:
+            return cache.getElement<Symbol>(mSelectedElementPath); // can throw
+        case NewElementWizardContext::ElementType::Component:
+            return cache.getElement<Component>(mSelectedElementPath); // can throw
+        case NewElementWizardContext::ElementType::Device:
+            return cache.getElement<Device>(mSelectedElementPath); // can throw
+        case NewElementWizardContext::ElementType::Package:
+            return cache.getElement<Package>(mSelectedElementPath); // can throw
+        default: throw LogicError(__FILE__, __LINE__);
+    }
+}
+
 void NewElementWizardPage_CopyFrom::initializePage() noexcept
 {
     QWizardPage::initializePage();
@@ -333,6 +401,7 @@ void NewElementWizardPage_CopyFrom::initializePage() noexcept
     }
     mUi->treeView->setExpandsOnDoubleClick(!mIsCategoryElement);
     mUi->listWidget->setVisible(!mIsCategoryElement);
+    mUi->edtSearch->setVisible(!mIsCategoryElement);
 }
 
 void NewElementWizardPage_CopyFrom::cleanupPage() noexcept
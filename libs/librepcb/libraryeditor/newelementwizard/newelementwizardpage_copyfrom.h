@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include "newelementwizardcontext.h"
@@ -48,6 +49,11 @@ class NewElementWizardPage_CopyFrom;
 /**
  * @brief The NewElementWizardPage_CopyFrom class
  *
+ * The element list is filled from the workspace library database (by category, or by a
+ * full-text search over all categories) and shows the cached thumbnails of symbols and
+ * packages. The selected element is only loaded when the page is validated, and it is
+ * taken from the workspace library element cache if available.
+ *
  * @author ubruhin
  * @date 2017-03-23
  *
@@ -84,12 +90,18 @@ class NewElementWizardPage_CopyFrom final : public QWizardPage
         void treeView_doubleClicked(const QModelIndex& item) noexcept;
         void listWidget_currentItemChanged(QListWidgetItem* current, QListWidgetItem* previous) noexcept;
         void listWidget_itemDoubleClicked(QListWidgetItem* item) noexcept;
+        void edtSearch_textChanged(const QString& text) noexcept;
+        void updateThumbnail(const Uuid& uuid) noexcept;
         void setSelectedCategory(const Uuid& uuid) noexcept;
+        void setElementList(const QList<Uuid>& elements) noexcept;
         void setSelectedElement(const FilePath& fp) noexcept;
         void setCategoryTreeModel(QAbstractItemModel* model) noexcept;
         FilePath getCategoryFilePath(const Uuid& category) const;
         QSet<Uuid> getElementsByCategory(const Uuid& category) const;
+        QList<Uuid> searchElements(const QString& query) const;
         void getElementMetadata(const Uuid& uuid, FilePath& fp, QString& name) const;
+        QImage getElementThumbnail(const Uuid& uuid) const noexcept;
+        std::shared_ptr<const LibraryBaseElement> loadSelectedElement() const;
         void initializePage() noexcept override;
         void cleanupPage() noexcept override;
 
@@ -100,7 +112,7 @@ class NewElementWizardPage_CopyFrom final : public QWizardPage
         QScopedPointer<QAbstractItemModel> mCategoryTreeModel;
         bool mIsCategoryElement;
         Uuid mSelectedCategoryUuid;
-        QScopedPointer<LibraryBaseElement> mSelectedElement;
+        FilePath mSelectedElementPath;
 };
 
 /*****************************************************************************************
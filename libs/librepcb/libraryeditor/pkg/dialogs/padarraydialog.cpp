@@ -0,0 +1,195 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "padarraydialog.h"
+#include "ui_padarraydialog.h"
+#include <librepcb/library/pkg/package.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+PadArrayDialog::PadArrayDialog(const Package& package, QWidget* parent) noexcept :
+    QDialog(parent), mPackage(package), mUi(new Ui::PadArrayDialog)
+{
+    mUi->setupUi(this);
+    connect(mUi->buttonBox, &QDialogButtonBox::accepted,
+            this, &PadArrayDialog::buttonBoxAccepted);
+    connect(mUi->buttonBox, &QDialogButtonBox::rejected,
+            this, &PadArrayDialog::reject);
+    connect(mUi->cbxLayout,
+            static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, &PadArrayDialog::updateWidgets);
+    connect(mUi->spbRows,
+            static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            this, &PadArrayDialog::updateWidgets);
+    connect(mUi->spbColumns,
+            static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            this, &PadArrayDialog::updateWidgets);
+    updateWidgets();
+}
+
+PadArrayDialog::~PadArrayDialog() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void PadArrayDialog::buttonBoxAccepted() noexcept
+{
+    try {
+        mPads = generatePads(); // can throw
+        accept();
+    } catch (const Exception& e) {
+        QMessageBox::critical(this, tr("Error"), e.getMsg());
+    }
+}
+
+void PadArrayDialog::updateWidgets() noexcept
+{
+    // row spacing is only used for perimeter arrays, row letters only for grid arrays
+    mUi->spbSpacingX->setEnabled(!isGrid());
+    mUi->spbSpacingY->setEnabled(!isGrid());
+    mUi->cbxNaming->setEnabled(isGrid());
+    mUi->lblPadCount->setText(QString::number(getPadCount()));
+}
+
+bool PadArrayDialog::isGrid() const noexcept
+{
+    return mUi->cbxLayout->currentIndex() == 0;
+}
+
+int PadArrayDialog::getPadCount() const noexcept
+{
+    int rows = mUi->spbRows->value();
+    int columns = mUi->spbColumns->value();
+    return isGrid() ? (rows * columns) : (2 * (rows + columns));
+}
+
+QList<CmdAddPadArray::Pad> PadArrayDialog::generatePads() const
+{
+    int rows = mUi->spbRows->value();
+    int columns = mUi->spbColumns->value();
+    Length pitchX = Length::fromMm(mUi->spbPitchX->value());
+    Length pitchY = Length::fromMm(mUi->spbPitchY->value());
+    Length spacingX = Length::fromMm(mUi->spbSpacingX->value());
+    Length spacingY = Length::fromMm(mUi->spbSpacingY->value());
+
+    QList<CmdAddPadArray::Pad> pads;
+    pads.reserve(getPadCount());
+    if (isGrid()) {
+        // row by row, starting at the top left corner
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < columns; ++c) {
+                Point pos(getOffset(pitchX, c, columns), -getOffset(pitchY, r, rows));
+                pads.append({getPadName(pads.count(), r, c), pos, Angle::deg0()});
+            }
+        }
+    } else {
+        // counterclockwise, starting at the top of the left side
+        Length left = -spacingX / 2, right = spacingX / 2;
+        Length top = spacingY / 2, bottom = -spacingY / 2;
+        for (int i = 0; i < rows; ++i) {
+            Point pos(left, -getOffset(pitchY, i, rows));
+            pads.append({getPadName(pads.count(), -1, -1), pos, Angle::deg0()});
+        }
+        for (int i = 0; i < columns; ++i) {
+            Point pos(getOffset(pitchX, i, columns), bottom);
+            pads.append({getPadName(pads.count(), -1, -1), pos, Angle::deg90()});
+        }
+        for (int i = 0; i < rows; ++i) {
+            Point pos(right, getOffset(pitchY, i, rows));
+            pads.append({getPadName(pads.count(), -1, -1), pos, Angle::deg0()});
+        }
+        for (int i = 0; i < columns; ++i) {
+            Point pos(-getOffset(pitchX, i, columns), top);
+            pads.append({getPadName(pads.count(), -1, -1), pos, Angle::deg90()});
+        }
+    }
+
+    if (pads.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, tr("The array does not contain any pads."));
+    }
+
+    // check names with a hash set, the package may already contain lots of pads
+    QSet<QString> names;
+    names.reserve(mPackage.getPads().count() + pads.count());
+    for (const PackagePad& pad : mPackage.getPads()) {
+        names.insert(pad.getName());
+    }
+    foreach (const CmdAddPadArray::Pad& pad, pads) {
+        if (names.contains(pad.name)) {
+            throw RuntimeError(__FILE__, __LINE__,
+                QString(tr("There is already a pad with the name \"%1\".")).arg(pad.name));
+        }
+        names.insert(pad.name);
+    }
+    return pads;
+}
+
+QString PadArrayDialog::getPadName(int index, int row, int column) const noexcept
+{
+    QString prefix = mUi->edtPrefix->text().trimmed();
+    int first = mUi->spbFirstNumber->value();
+    if (isGrid() && (mUi->cbxNaming->currentIndex() == 1)) {
+        return prefix % getRowLetters(row) % QString::number(column + first);
+    } else {
+        return prefix % QString::number(index + first);
+    }
+}
+
+QString PadArrayDialog::getRowLetters(int row) noexcept
+{
+    // JEDEC row letters: A..Y without I, O, Q, S, X, Z, then AA, AB, ...
+    static const QString letters = "ABCDEFGHJKLMNPRTUVWY";
+    QString name;
+    do {
+        name.prepend(letters.at(row % letters.length()));
+        row = (row / letters.length()) - 1;
+    } while (row >= 0);
+    return name;
+}
+
+Length PadArrayDialog::getOffset(const Length& pitch, int index, int count) noexcept
+{
+    // centered around the origin
+    return (pitch * (2 * index - (count - 1))) / 2;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
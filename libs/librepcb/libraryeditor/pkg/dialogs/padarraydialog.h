@@ -0,0 +1,104 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_EDITOR_PADARRAYDIALOG_H
+#define LIBREPCB_LIBRARY_EDITOR_PADARRAYDIALOG_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "../fsm/cmd/cmdaddpadarray.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+
+class Package;
+
+namespace editor {
+
+namespace Ui {
+class PadArrayDialog;
+}
+
+/*****************************************************************************************
+ *  Class PadArrayDialog
+ ****************************************************************************************/
+
+/**
+ * @brief The PadArrayDialog class lets the user define a grid or perimeter array of pads
+ *
+ * The pads of a grid array (e.g. BGA) are named either numerically in rows or by row
+ * letter and column number (A1, A2, ..., B1, ...) with the letters I, O, Q, S, X and Z
+ * skipped as recommended by JEDEC. The pads of a perimeter array (e.g. QFP, SOIC) are
+ * numbered counterclockwise, starting at the top of the left side.
+ */
+class PadArrayDialog final : public QDialog
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        PadArrayDialog() = delete;
+        PadArrayDialog(const PadArrayDialog& other) = delete;
+        explicit PadArrayDialog(const Package& package, QWidget* parent = nullptr) noexcept;
+        ~PadArrayDialog() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the pads of the array (only valid after the dialog was accepted)
+         */
+        const QList<CmdAddPadArray::Pad>& getPads() const noexcept {return mPads;}
+
+        // Operator Overloadings
+        PadArrayDialog& operator=(const PadArrayDialog& rhs) = delete;
+
+
+    private: // Methods
+        void buttonBoxAccepted() noexcept;
+        void updateWidgets() noexcept;
+        bool isGrid() const noexcept;
+        int getPadCount() const noexcept;
+        QList<CmdAddPadArray::Pad> generatePads() const;
+        QString getPadName(int index, int row, int column) const noexcept;
+        static QString getRowLetters(int row) noexcept;
+        static Length getOffset(const Length& pitch, int index, int count) noexcept;
+
+
+    private: // Data
+        const Package& mPackage;
+        QScopedPointer<Ui::PadArrayDialog> mUi;
+        QList<CmdAddPadArray::Pad> mPads;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_EDITOR_PADARRAYDIALOG_H
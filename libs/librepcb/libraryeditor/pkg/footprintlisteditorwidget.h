@@ -37,6 +37,8 @@ class UndoStack;
 namespace library {
 namespace editor {
 
+class FootprintListModel;
+
 /*****************************************************************************************
  *  Class FootprintListEditorWidget
  ****************************************************************************************/
@@ -47,18 +49,10 @@ namespace editor {
  * @author ubruhin
  * @date 2017-05-27
  */
-class FootprintListEditorWidget final : public QWidget, private FootprintList::IF_Observer
+class FootprintListEditorWidget final : public QWidget
 {
         Q_OBJECT
 
-    private: // Types
-        enum Column {
-            COLUMN_NAME = 0,
-            COLUMN_BUTTONS,
-            _COLUMN_COUNT
-        };
-
-
     public:
         // Constructors / Destructor
         explicit FootprintListEditorWidget(QWidget* parent = nullptr) noexcept;
@@ -77,48 +71,17 @@ class FootprintListEditorWidget final : public QWidget, private FootprintList::I
 
 
     private: // Slots
-        void currentCellChanged(int currentRow, int currentColumn,
-                                int previousRow, int previousColumn) noexcept;
-        void tableCellChanged(int row, int column) noexcept;
-        void btnUpClicked() noexcept;
-        void btnDownClicked() noexcept;
-        void btnCopyClicked() noexcept;
-        void btnAddRemoveClicked() noexcept;
+        void currentRowChanged(const QModelIndex& current, const QModelIndex& previous) noexcept;
+        void viewClicked(const QModelIndex& index) noexcept;
 
 
     private: // Methods
-        void updateTable(Uuid selected = Uuid()) noexcept;
-        void setTableRowContent(int row, const Uuid& uuid, const QString& name) noexcept;
-        void addFootprint(const QString& name) noexcept;
-        void removeFootprint(const Uuid& uuid) noexcept;
-        void moveFootprintUp(int index) noexcept;
-        void moveFootprintDown(int index) noexcept;
-        void copyFootprint(const Uuid& uuid) noexcept;
-        QString setName(const Uuid& uuid, const QString& name) noexcept;
-        int getRowOfTableCellWidget(QObject* obj) const noexcept;
-        Uuid getUuidOfRow(int row) const noexcept;
-        void throwIfNameEmptyOrExists(const QString& name) const;
-        static QString cleanName(const QString& name) noexcept;
-
-        // row index <-> signal index conversion methods
-        int newFootprintRow() const noexcept {return mFootprintList->count();}
-        int indexToRow(int index) const noexcept {return index;}
-        int rowToIndex(int row) const noexcept {return row;}
-        bool isExistingFootprintRow(int row) const noexcept {return row >= 0 && row < mFootprintList->count();}
-        bool isNewFootprintRow(int row) const noexcept {return row == newFootprintRow();}
-
-        // Observer Methods
-        void listObjectAdded(const FootprintList& list,
-                             int newIndex, const std::shared_ptr<Footprint>& ptr) noexcept override;
-        void listObjectRemoved(const FootprintList& list,
-                               int oldIndex, const std::shared_ptr<Footprint>& ptr) noexcept override;
+        void selectRow(int row) noexcept;
 
 
     private: // Data
-        QTableWidget* mTable;
-        FootprintList* mFootprintList;
-        UndoStack* mUndoStack;
-        Uuid mSelectedFootprint;
+        QTableView* mView;
+        FootprintListModel* mModel;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,350 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "footprintlistmodel.h"
+#include <librepcb/common/undostack.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/library/pkg/cmd/cmdfootprintedit.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+FootprintListModel::FootprintListModel(QWidget* parent) noexcept :
+    QAbstractTableModel(parent), mFootprintList(nullptr), mUndoStack(nullptr)
+{
+}
+
+FootprintListModel::~FootprintListModel() noexcept
+{
+    setReferences(nullptr, nullptr);
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool FootprintListModel::isNewFootprintRow(int row) const noexcept
+{
+    return mFootprintList && (row == mFootprintList->count());
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void FootprintListModel::setReferences(FootprintList* list, UndoStack* stack) noexcept
+{
+    beginResetModel();
+    if (mFootprintList) mFootprintList->unregisterObserver(this);
+    if (mUndoStack) {
+        disconnect(mUndoStack, &UndoStack::stateModified,
+                   this, &FootprintListModel::undoStackStateModified);
+    }
+    mFootprintList = list;
+    mUndoStack = stack;
+    if (mFootprintList) mFootprintList->registerObserver(this);
+    if (mUndoStack) {
+        // footprints do not notify about modifications, so refresh the names after
+        // every executed, undone or redone command
+        connect(mUndoStack, &UndoStack::stateModified,
+                this, &FootprintListModel::undoStackStateModified);
+    }
+    endResetModel();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int FootprintListModel::triggerAction(const QModelIndex& index) noexcept
+{
+    if ((!index.isValid()) || (!mFootprintList) || (!mUndoStack)) return -1;
+    bool isNewRow = isNewFootprintRow(index.row());
+    try {
+        switch (index.column()) {
+            case COLUMN_COPY:
+                return isNewRow ? -1 : copyFootprint(index.row()); // can throw
+            case COLUMN_MOVE_UP:
+                return isNewRow ? -1 : moveFootprint(index.row(), -1); // can throw
+            case COLUMN_MOVE_DOWN:
+                return isNewRow ? -1 : moveFootprint(index.row(), 1); // can throw
+            case COLUMN_ADD_REMOVE:
+                if (isNewRow) {
+                    return addFootprint(mNewName); // can throw
+                } else {
+                    removeFootprint(index.row()); // can throw
+                    return -1;
+                }
+            default:
+                return -1;
+        }
+    } catch (const Exception& e) {
+        QMessageBox::critical(getParentWidget(), tr("Error"), e.getMsg());
+        return -1;
+    }
+}
+
+/*****************************************************************************************
+ *  Inherited from QAbstractItemModel
+ ****************************************************************************************/
+
+int FootprintListModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || (!mFootprintList)) return 0;
+    return mFootprintList->count() + 1; // the last row is used to add new footprints
+}
+
+int FootprintListModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : _COLUMN_COUNT;
+}
+
+QVariant FootprintListModel::data(const QModelIndex& index, int role) const
+{
+    if ((!index.isValid()) || (!mFootprintList)) return QVariant();
+    std::shared_ptr<const Footprint> footprint = mFootprintList->value(index.row());
+    bool isNewRow = (!footprint);
+
+    switch (index.column()) {
+        case COLUMN_NAME: {
+            if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
+                return isNewRow ? mNewName : footprint->getNames().getDefaultValue();
+            }
+            break;
+        }
+        case COLUMN_COPY: {
+            if ((role == Qt::DecorationRole) && (!isNewRow)) {
+                return QIcon(":/img/actions/copy.png");
+            } else if ((role == Qt::ToolTipRole) && (!isNewRow)) {
+                return tr("Copy footprint");
+            }
+            break;
+        }
+        case COLUMN_MOVE_UP: {
+            if ((role == Qt::DecorationRole) && (!isNewRow) && (index.row() > 0)) {
+                return QIcon(":/img/actions/up.png");
+            } else if ((role == Qt::ToolTipRole) && (!isNewRow)) {
+                return tr("Move up");
+            }
+            break;
+        }
+        case COLUMN_MOVE_DOWN: {
+            if ((role == Qt::DecorationRole) && (!isNewRow) &&
+                (index.row() < mFootprintList->count() - 1)) {
+                return QIcon(":/img/actions/down.png");
+            } else if ((role == Qt::ToolTipRole) && (!isNewRow)) {
+                return tr("Move down");
+            }
+            break;
+        }
+        case COLUMN_ADD_REMOVE: {
+            if (role == Qt::DecorationRole) {
+                return QIcon(isNewRow ? ":/img/actions/add.png" : ":/img/actions/minus.png");
+            } else if (role == Qt::ToolTipRole) {
+                return isNewRow ? tr("Add footprint") : tr("Remove footprint");
+            }
+            break;
+        }
+        default: break;
+    }
+    return QVariant();
+}
+
+QVariant FootprintListModel::headerData(int section, Qt::Orientation orientation,
+                                        int role) const
+{
+    if (orientation == Qt::Horizontal) {
+        if ((role == Qt::DisplayRole) && (section == COLUMN_NAME)) {
+            return tr("Name");
+        }
+    } else if (mFootprintList) {
+        std::shared_ptr<const Footprint> footprint = mFootprintList->value(section);
+        if (role == Qt::DisplayRole) {
+            return footprint ? QString(footprint->getUuid().toStr().left(13) % "...")
+                             : tr("Add new footprint:");
+        } else if ((role == Qt::ToolTipRole) && footprint) {
+            return footprint->getUuid().toStr();
+        } else if (role == Qt::FontRole) {
+            QFont font;
+            font.setStyleHint(QFont::Monospace); // ensure that the column width is fixed
+            font.setFamily("Monospace");
+            return font;
+        }
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags FootprintListModel::flags(const QModelIndex& index) const
+{
+    Qt::ItemFlags f = QAbstractTableModel::flags(index);
+    return (index.column() == COLUMN_NAME) ? (f | Qt::ItemIsEditable) : f;
+}
+
+bool FootprintListModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if ((!index.isValid()) || (!mFootprintList) || (index.column() != COLUMN_NAME) ||
+        (role != Qt::EditRole)) {
+        return false;
+    }
+    std::shared_ptr<Footprint> footprint = mFootprintList->value(index.row());
+    if (footprint) {
+        return setName(*footprint, cleanName(value.toString()));
+    } else {
+        mNewName = cleanName(value.toString());
+        emit dataChanged(index, index);
+        return true;
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+int FootprintListModel::addFootprint(const QString& name)
+{
+    throwIfNameEmptyOrExists(name); // can throw
+    mUndoStack->execCmd(new CmdFootprintInsert(*mFootprintList,
+        std::make_shared<Footprint>(Uuid::createRandom(), name, ""))); // can throw
+    mNewName.clear();
+    return mFootprintList->count() - 1;
+}
+
+int FootprintListModel::copyFootprint(int row)
+{
+    const Footprint* original = mFootprintList->at(row).get();
+    std::shared_ptr<Footprint> copy(new Footprint(Uuid::createRandom(),
+                                    "Copy of " % original->getNames().getDefaultValue(), "")); // can throw
+    copy->getDescriptions() = original->getDescriptions();
+    copy->getPads() = original->getPads();
+    copy->getPolygons() = original->getPolygons();
+    copy->getEllipses() = original->getEllipses();
+    copy->getTexts() = original->getTexts();
+    copy->getHoles() = original->getHoles();
+    mUndoStack->execCmd(new CmdFootprintInsert(*mFootprintList, copy)); // can throw
+    return mFootprintList->count() - 1;
+}
+
+void FootprintListModel::removeFootprint(int row)
+{
+    const Footprint* footprint = mFootprintList->at(row).get();
+    mUndoStack->execCmd(new CmdFootprintRemove(*mFootprintList, footprint)); // can throw
+}
+
+int FootprintListModel::moveFootprint(int row, int offset)
+{
+    int newRow = row + offset;
+    if ((newRow < 0) || (newRow >= mFootprintList->count())) return -1;
+    mUndoStack->execCmd(new CmdFootprintsSwap(*mFootprintList, row, newRow)); // can throw
+    return newRow;
+}
+
+bool FootprintListModel::setName(Footprint& footprint, const QString& name) noexcept
+{
+    if (footprint.getNames().getDefaultValue() == name) return true;
+    try {
+        throwIfNameEmptyOrExists(name); // can throw
+        QScopedPointer<CmdFootprintEdit> cmd(new CmdFootprintEdit(footprint));
+        cmd->setName(name);
+        mUndoStack->execCmd(cmd.take()); // can throw
+        return true;
+    } catch (const Exception& e) {
+        QMessageBox::critical(getParentWidget(), tr("Invalid name"), e.getMsg());
+        return false;
+    }
+}
+
+void FootprintListModel::undoStackStateModified() noexcept
+{
+    if (mFootprintList && (!mFootprintList->isEmpty())) {
+        emit dataChanged(index(0, COLUMN_NAME),
+                         index(mFootprintList->count() - 1, COLUMN_NAME));
+    }
+}
+
+void FootprintListModel::throwIfNameEmptyOrExists(const QString& name) const
+{
+    if (name.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, tr("The name must not be empty."));
+    }
+    for (const Footprint& footprint : *mFootprintList) {
+        if (footprint.getNames().getDefaultValue() == name) {
+            throw RuntimeError(__FILE__, __LINE__,
+                QString(tr("There is already a footprint with the name \"%1\".")).arg(name));
+        }
+    }
+}
+
+QString FootprintListModel::cleanName(const QString& name) noexcept
+{
+    // TODO: it's ugly to use a method from FilePath...
+    return FilePath::cleanFileName(name, FilePath::ReplaceSpaces | FilePath::KeepCase);
+}
+
+QWidget* FootprintListModel::getParentWidget() const noexcept
+{
+    return qobject_cast<QWidget*>(QObject::parent());
+}
+
+/*****************************************************************************************
+ *  Observer Methods
+ ****************************************************************************************/
+
+void FootprintListModel::listObjectAdded(const FootprintList& list, int newIndex,
+                                         const std::shared_ptr<Footprint>& ptr) noexcept
+{
+    Q_ASSERT(&list == mFootprintList); Q_UNUSED(list); Q_UNUSED(ptr);
+    // the element is already inserted, but the additional row for new footprints makes
+    // sure the row count is still valid for beginInsertRows()
+    beginInsertRows(QModelIndex(), newIndex, newIndex);
+    endInsertRows();
+    // the move buttons of the neighbours may have changed
+    emit dataChanged(index(qMax(newIndex - 1, 0), COLUMN_MOVE_UP),
+                     index(qMin(newIndex + 1, mFootprintList->count()), COLUMN_MOVE_DOWN));
+}
+
+void FootprintListModel::listObjectRemoved(const FootprintList& list, int oldIndex,
+                                           const std::shared_ptr<Footprint>& ptr) noexcept
+{
+    Q_ASSERT(&list == mFootprintList); Q_UNUSED(list); Q_UNUSED(ptr);
+    beginRemoveRows(QModelIndex(), oldIndex, oldIndex);
+    endRemoveRows();
+    emit dataChanged(index(qMax(oldIndex - 1, 0), COLUMN_MOVE_UP),
+                     index(qMin(oldIndex, mFootprintList->count()), COLUMN_MOVE_DOWN));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
@@ -0,0 +1,138 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_EDITOR_FOOTPRINTLISTMODEL_H
+#define LIBREPCB_LIBRARY_EDITOR_FOOTPRINTLISTMODEL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcb/library/pkg/footprint.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class UndoStack;
+
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Class FootprintListModel
+ ****************************************************************************************/
+
+/**
+ * @brief The FootprintListModel class is a table model for a
+ *        librepcb::library::FootprintList
+ *
+ * The model reads directly from the list and is updated by its observer methods. The
+ * last row is a special row to add a new footprint.
+ */
+class FootprintListModel final : public QAbstractTableModel,
+                                 private FootprintList::IF_Observer
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        enum Column {
+            COLUMN_NAME = 0,
+            COLUMN_COPY,
+            COLUMN_MOVE_UP,
+            COLUMN_MOVE_DOWN,
+            COLUMN_ADD_REMOVE,
+            _COLUMN_COUNT
+        };
+
+        // Constructors / Destructor
+        FootprintListModel() = delete;
+        FootprintListModel(const FootprintListModel& other) = delete;
+        explicit FootprintListModel(QWidget* parent) noexcept;
+        ~FootprintListModel() noexcept;
+
+        // Getters
+        bool isNewFootprintRow(int row) const noexcept;
+
+        // Setters
+        void setReferences(FootprintList* list, UndoStack* stack) noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Execute the action of a cell in the #COLUMN_COPY, #COLUMN_MOVE_UP,
+         *        #COLUMN_MOVE_DOWN or #COLUMN_ADD_REMOVE column
+         *
+         * @param index     The clicked cell
+         *
+         * @return The row to select afterwards (-1 to keep the current selection)
+         */
+        int triggerAction(const QModelIndex& index) noexcept;
+
+        // Inherited from QAbstractItemModel
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant headerData(int section, Qt::Orientation orientation,
+                            int role = Qt::DisplayRole) const override;
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        bool setData(const QModelIndex& index, const QVariant& value,
+                     int role = Qt::EditRole) override;
+
+        // Operator Overloadings
+        FootprintListModel& operator=(const FootprintListModel& rhs) = delete;
+
+
+    private: // Methods
+        int addFootprint(const QString& name);
+        int copyFootprint(int row);
+        void removeFootprint(int row);
+        int moveFootprint(int row, int offset);
+        bool setName(Footprint& footprint, const QString& name) noexcept;
+        void undoStackStateModified() noexcept;
+        void throwIfNameEmptyOrExists(const QString& name) const;
+        static QString cleanName(const QString& name) noexcept;
+        QWidget* getParentWidget() const noexcept;
+
+        // Observer Methods
+        void listObjectAdded(const FootprintList& list, int newIndex,
+                             const std::shared_ptr<Footprint>& ptr) noexcept override;
+        void listObjectRemoved(const FootprintList& list, int oldIndex,
+                               const std::shared_ptr<Footprint>& ptr) noexcept override;
+
+
+    private: // Data
+        FootprintList* mFootprintList;
+        UndoStack* mUndoStack;
+        QString mNewName; ///< name of the footprint to add
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_EDITOR_FOOTPRINTLISTMODEL_H
@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdaddpadarray.h"
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/pkg/footprint.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdAddPadArray::CmdAddPadArray(Package& package, Footprint& footprint,
+        GraphicsScene& scene, const FootprintPad& templatePad, const QList<Pad>& pads) noexcept :
+    UndoCommandGroup(tr("Add Pad Array")), mPackage(package), mFootprint(footprint),
+    mScene(scene), mTemplatePad(templatePad), mPads(pads)
+{
+}
+
+CmdAddPadArray::~CmdAddPadArray() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdAddPadArray::performExecute()
+{
+    QVector<std::shared_ptr<PackagePad>> packagePads;
+    QVector<std::shared_ptr<FootprintPad>> footprintPads;
+    packagePads.reserve(mPads.count());
+    footprintPads.reserve(mPads.count());
+    foreach (const Pad& pad, mPads) {
+        std::shared_ptr<PackagePad> packagePad =
+            std::make_shared<PackagePad>(Uuid::createRandom(), pad.name);
+        packagePads.append(packagePad);
+        footprintPads.append(std::make_shared<FootprintPad>(packagePad->getUuid(),
+            pad.position, pad.rotation, mTemplatePad.getShape(), mTemplatePad.getWidth(),
+            mTemplatePad.getHeight(), mTemplatePad.getDrillDiameter(),
+            mTemplatePad.getBoardSide()));
+    }
+    appendChild(new CmdPackagePadsInsert(mPackage.getPads(), packagePads));
+    appendChild(new CmdFootprintPadsInsert(mFootprint.getPads(), footprintPads));
+
+    // execute all child commands
+    mScene.beginBulkUpdate();
+    auto sg = scopeGuard([this](){mScene.endBulkUpdate();});
+    return UndoCommandGroup::performExecute(); // can throw
+}
+
+void CmdAddPadArray::performUndo()
+{
+    mScene.beginBulkUpdate();
+    auto sg = scopeGuard([this](){mScene.endBulkUpdate();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdAddPadArray::performRedo()
+{
+    mScene.beginBulkUpdate();
+    auto sg = scopeGuard([this](){mScene.endBulkUpdate();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
@@ -0,0 +1,108 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_EDITOR_CMDADDPADARRAY_H
+#define LIBREPCB_LIBRARY_EDITOR_CMDADDPADARRAY_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommandgroup.h>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/library/pkg/footprintpad.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class GraphicsScene;
+
+namespace library {
+
+class Package;
+class Footprint;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class CmdAddPadArray
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdAddPadArray class adds a whole array of pads to a package and footprint
+ *
+ * For every pad, a new librepcb::library::PackagePad is added to the package and a
+ * librepcb::library::FootprintPad (with the properties of a template pad) is added to
+ * the footprint. All pads are inserted with only two list commands and while the BSP
+ * index of the graphics scene is suspended, so even arrays with thousands of pads are
+ * added (and undone) quickly.
+ */
+class CmdAddPadArray final : public UndoCommandGroup
+{
+    public:
+
+        // Types
+        struct Pad {
+            QString name;
+            Point position;
+            Angle rotation;
+        };
+
+        // Constructors / Destructor
+        CmdAddPadArray() = delete;
+        CmdAddPadArray(const CmdAddPadArray& other) = delete;
+        CmdAddPadArray(Package& package, Footprint& footprint, GraphicsScene& scene,
+                       const FootprintPad& templatePad, const QList<Pad>& pads) noexcept;
+        ~CmdAddPadArray() noexcept;
+
+        // Operator Overloadings
+        CmdAddPadArray& operator=(const CmdAddPadArray& rhs) = delete;
+
+
+    private: // Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+
+    private: // Data
+        Package& mPackage;
+        Footprint& mFootprint;
+        GraphicsScene& mScene;
+        FootprintPad mTemplatePad;
+        QList<Pad> mPads;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_EDITOR_CMDADDPADARRAY_H
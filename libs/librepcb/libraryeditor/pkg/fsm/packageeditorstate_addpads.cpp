@@ -33,6 +33,8 @@
 #include "../widgets/packagepadcombobox.h"
 #include "../widgets/boardsideselectorwidget.h"
 #include "../widgets/footprintpadshapeselectorwidget.h"
+#include "../dialogs/padarraydialog.h"
+#include "cmd/cmdaddpadarray.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -147,6 +149,14 @@ bool PackageEditorState_AddPads::entry() noexcept
                 this, &PackageEditorState_AddPads::drillDiameterSpinBoxValueChanged);
         mContext.commandToolBar.addWidget(std::move(drillDiameterSpinBox));
     }
+    mContext.commandToolBar.addSeparator();
+
+    // pad array
+    std::unique_ptr<QAction> padArrayAction(new QAction(tr("Add Pad Array..."), nullptr));
+    padArrayAction->setToolTip(tr("Add a grid or perimeter array of pads at once"));
+    connect(padArrayAction.get(), &QAction::triggered,
+            this, &PackageEditorState_AddPads::padArrayActionTriggered);
+    mContext.commandToolBar.addAction(std::move(padArrayAction));
 
     Point pos = mContext.graphicsView.mapGlobalPosToScenePos(QCursor::pos(), true, true);
     return startAddPad(pos);
@@ -278,6 +288,29 @@ bool PackageEditorState_AddPads::abortAddPad() noexcept
     }
 }
 
+void PackageEditorState_AddPads::padArrayActionTriggered() noexcept
+{
+    // the pad attached to the cursor must not be part of the array command
+    if (mCurrentPad && !abortAddPad()) {
+        return;
+    }
+
+    PadArrayDialog dialog(mContext.package, &mContext.editorWidget);
+    if (dialog.exec() == QDialog::Accepted) {
+        try {
+            mContext.undoStack.execCmd(new CmdAddPadArray(mContext.package,
+                *mContext.currentFootprint, mContext.graphicsScene, mLastPad,
+                dialog.getPads())); // can throw
+            mPackagePadComboBox->updatePads();
+        } catch (const Exception& e) {
+            QMessageBox::critical(&mContext.editorWidget, tr("Error"), e.getMsg());
+        }
+    }
+
+    Point pos = mContext.graphicsView.mapGlobalPosToScenePos(QCursor::pos(), true, true);
+    startAddPad(pos);
+}
+
 void PackageEditorState_AddPads::packagePadComboBoxCurrentPadChanged(PackagePad* pad) noexcept
 {
     mLastPad.setPackagePadUuid(pad ? pad->getUuid() : Uuid());
@@ -84,6 +84,7 @@ class PackageEditorState_AddPads : public PackageEditorState
         bool startAddPad(const Point& pos) noexcept;
         bool finishAddPad(const Point& pos) noexcept;
         bool abortAddPad() noexcept;
+        void padArrayActionTriggered() noexcept;
         void packagePadComboBoxCurrentPadChanged(PackagePad* pad) noexcept;
         void boardSideSelectorCurrentSideChanged(FootprintPad::BoardSide side) noexcept;
         void shapeSelectorCurrentShapeChanged(FootprintPad::Shape shape) noexcept;
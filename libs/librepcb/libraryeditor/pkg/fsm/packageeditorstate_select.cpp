@@ -78,6 +78,9 @@ bool PackageEditorState_Select::processGraphicsSceneMouseMoved(QGraphicsSceneMou
         }
         case SubState::MOVING: {
             if (!mCmdMoveSelectedItems) {
+                // The scene index would be rebuilt after every mouse move if many items
+                // are moved (e.g. all pads of a BGA), so disable it while moving.
+                mContext.graphicsScene.beginBulkUpdate();
                 mCmdMoveSelectedItems.reset(new CmdMoveSelectedFootprintItems(mContext, startPos));
             }
             mCmdMoveSelectedItems->setCurrentPosition(currentPos);
@@ -161,6 +164,7 @@ bool PackageEditorState_Select::processGraphicsSceneLeftMouseButtonReleased(QGra
                 } catch (const Exception& e) {
                     QMessageBox::critical(&mContext.editorWidget, tr("Error"), e.getMsg());
                 }
+                mContext.graphicsScene.endBulkUpdate();
             }
             mState = SubState::IDLE;
             return true;
@@ -45,8 +45,8 @@ namespace editor {
  ****************************************************************************************/
 
 PackageEditorWidget::PackageEditorWidget(const Context& context,
-        const FilePath& fp, QWidget* parent) :
-    EditorWidgetBase(context, fp, parent), mUi(new Ui::PackageEditorWidget),
+        std::unique_ptr<Package> package, QWidget* parent) :
+    EditorWidgetBase(context, package->getFilePath(), parent), mUi(new Ui::PackageEditorWidget),
     mGraphicsScene(new GraphicsScene())
 {
     mUi->setupUi(this);
@@ -67,8 +67,8 @@ PackageEditorWidget::PackageEditorWidget(const Context& context,
     mUi->formLayout->getWidgetPosition(mUi->lblCategories, &row, &role);
     mUi->formLayout->setWidget(row, QFormLayout::FieldRole, mCategoriesEditorWidget.data());
 
-    // load package
-    mPackage.reset(new Package(fp, false)); // can throw
+    // take over the loaded package
+    mPackage.reset(package.release());
     setWindowTitle(mPackage->getNames().value(getLibLocaleOrder()));
     mUi->lblUuid->setText(QString("<a href=\"%1\">%2</a>").arg(
         mPackage->getFilePath().toQUrl().toString(), mPackage->getUuid().toStr()));
@@ -314,6 +314,36 @@ bool PackageEditorWidget::isInterfaceBroken() const noexcept
     return false;
 }
 
+std::function<QStringList()> PackageEditorWidget::prepareChecks() const noexcept
+{
+    QString name = mUi->edtName->text();
+    QString version = mUi->edtVersion->text();
+    QList<QPair<Uuid, QString>> pads;
+    for (const PackagePad& pad : mPackage->getPads()) {
+        pads.append(qMakePair(pad.getUuid(), pad.getName()));
+    }
+    QList<QPair<QString, QSet<Uuid>>> footprints;
+    for (const Footprint& footprint : mPackage->getFootprints()) {
+        footprints.append(qMakePair(footprint.getNames().value(getLibLocaleOrder()),
+                                    footprint.getPads().getUuidSet()));
+    }
+    return [name, version, pads, footprints]() {
+        QStringList messages = checkNameAndVersion(name, version);
+        if (footprints.isEmpty()) {
+            messages.append(tr("The package has no footprint."));
+        }
+        for (const QPair<QString, QSet<Uuid>>& footprint : footprints) {
+            for (const QPair<Uuid, QString>& pad : pads) {
+                if (!footprint.second.contains(pad.first)) {
+                    messages.append(tr("The pad \"%1\" is missing in the footprint \"%2\".")
+                                    .arg(pad.second, footprint.first));
+                }
+            }
+        }
+        return messages;
+    };
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
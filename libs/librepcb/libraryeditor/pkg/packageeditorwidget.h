@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/exceptions.h>
@@ -72,7 +73,7 @@ class PackageEditorWidget final : public EditorWidgetBase, public IF_GraphicsVie
         // Constructors / Destructor
         PackageEditorWidget() = delete;
         PackageEditorWidget(const PackageEditorWidget& other) = delete;
-        PackageEditorWidget(const Context& context, const FilePath& fp,
+        PackageEditorWidget(const Context& context, std::unique_ptr<Package> package,
                             QWidget* parent = nullptr);
         ~PackageEditorWidget() noexcept;
 
@@ -105,6 +106,7 @@ class PackageEditorWidget final : public EditorWidgetBase, public IF_GraphicsVie
         void currentFootprintChanged(int index) noexcept;
         void memorizePackageInterface() noexcept;
         bool isInterfaceBroken() const noexcept override;
+        std::function<QStringList()> prepareChecks() const noexcept override;
 
 
     private: // Data
@@ -59,6 +59,13 @@ PackagePadListEditorWidget::PackagePadListEditorWidget(QWidget* parent) noexcept
     connect(mTable, &QTableWidget::cellChanged,
             this, &PackagePadListEditorWidget::tableCellChanged);
 
+    // rebuilding the table is expensive, so do it only once after adding or removing
+    // many pads at once (e.g. a pad array)
+    mTableUpdateTimer.setSingleShot(true);
+    mTableUpdateTimer.setInterval(0);
+    connect(&mTableUpdateTimer, &QTimer::timeout,
+            this, [this](){updateTable(mSelectedPad);});
+
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->setContentsMargins(0, 0, 0, 0);
     layout->addWidget(mTable);
@@ -129,6 +136,7 @@ void PackagePadListEditorWidget::btnAddRemoveClicked() noexcept
 
 void PackagePadListEditorWidget::updateTable(Uuid selected) noexcept
 {
+    mTableUpdateTimer.stop();
     mTable->blockSignals(true);
 
     // remove all rows
@@ -159,6 +167,13 @@ void PackagePadListEditorWidget::updateTable(Uuid selected) noexcept
     mTable->blockSignals(false);
 }
 
+void PackagePadListEditorWidget::scheduleTableUpdate() noexcept
+{
+    // rows must not be accessed until the table is updated, so block its signals
+    mTable->blockSignals(true);
+    mTableUpdateTimer.start();
+}
+
 void PackagePadListEditorWidget::setTableRowContent(int row, const Uuid& uuid,
                                                     const QString& name) noexcept
 {
@@ -296,14 +311,14 @@ void PackagePadListEditorWidget::listObjectAdded(const PackagePadList& list, int
                                                  const std::shared_ptr<PackagePad>& ptr) noexcept
 {
     Q_ASSERT(&list == mPadList); Q_UNUSED(list); Q_UNUSED(newIndex); Q_UNUSED(ptr);
-    updateTable(mSelectedPad);
+    scheduleTableUpdate();
 }
 
 void PackagePadListEditorWidget::listObjectRemoved(const PackagePadList& list, int oldIndex,
                                                    const std::shared_ptr<PackagePad>& ptr) noexcept
 {
     Q_ASSERT(&list == mPadList); Q_UNUSED(list); Q_UNUSED(oldIndex); Q_UNUSED(ptr);
-    updateTable(mSelectedPad);
+    scheduleTableUpdate();
 }
 
 /*****************************************************************************************
@@ -81,6 +81,7 @@ class PackagePadListEditorWidget final : public QWidget, private PackagePadList:
 
     private: // Methods
         void updateTable(Uuid selected = Uuid()) noexcept;
+        void scheduleTableUpdate() noexcept;
         void setTableRowContent(int row, const Uuid& uuid, const QString& name) noexcept;
         void addPad(const QString& name) noexcept;
         void removePad(const Uuid& uuid) noexcept;
@@ -111,6 +112,7 @@ class PackagePadListEditorWidget final : public QWidget, private PackagePadList:
         PackagePadList* mPadList;
         UndoStack* mUndoStack;
         Uuid mSelectedPad;
+        QTimer mTableUpdateTimer; ///< coalesces table updates of many list changes
 };
 
 /*****************************************************************************************
@@ -41,8 +41,8 @@ namespace editor {
  ****************************************************************************************/
 
 PackageCategoryEditorWidget::PackageCategoryEditorWidget(const Context& context,
-        const FilePath& fp, QWidget* parent) :
-    EditorWidgetBase(context, fp, parent), mUi(new Ui::PackageCategoryEditorWidget)
+        std::unique_ptr<PackageCategory> category, QWidget* parent) :
+    EditorWidgetBase(context, category->getFilePath(), parent), mUi(new Ui::PackageCategoryEditorWidget)
 {
     mUi->setupUi(this);
     setWindowIcon(QIcon(":/img/places/folder_green.png"));
@@ -53,7 +53,7 @@ PackageCategoryEditorWidget::PackageCategoryEditorWidget(const Context& context,
     connect(mUi->edtParent, &QLineEdit::textChanged,
             this, &PackageCategoryEditorWidget::edtParentTextChanged);
 
-    mCategory.reset(new PackageCategory(fp, false)); // can throw
+    mCategory.reset(category.release());
     setWindowTitle(mCategory->getNames().value(getLibLocaleOrder()));
     mUi->lblUuid->setText(QString("<a href=\"%1\">%2</a>").arg(
         mCategory->getFilePath().toQUrl().toString(), mCategory->getUuid().toStr()));
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/exceptions.h>
@@ -62,7 +63,7 @@ class PackageCategoryEditorWidget final : public EditorWidgetBase
         // Constructors / Destructor
         PackageCategoryEditorWidget() = delete;
         PackageCategoryEditorWidget(const PackageCategoryEditorWidget& other) = delete;
-        PackageCategoryEditorWidget(const Context& context, const FilePath& fp,
+        PackageCategoryEditorWidget(const Context& context, std::unique_ptr<PackageCategory> category,
                                     QWidget* parent = nullptr);
         ~PackageCategoryEditorWidget() noexcept;
 
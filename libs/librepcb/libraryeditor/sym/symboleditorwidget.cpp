@@ -48,9 +48,9 @@ namespace editor {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-SymbolEditorWidget::SymbolEditorWidget(const Context& context, const FilePath& fp,
-                                       QWidget* parent) :
-    EditorWidgetBase(context, fp, parent), mUi(new Ui::SymbolEditorWidget),
+SymbolEditorWidget::SymbolEditorWidget(const Context& context,
+        std::unique_ptr<Symbol> symbol, QWidget* parent) :
+    EditorWidgetBase(context, symbol->getFilePath(), parent), mUi(new Ui::SymbolEditorWidget),
     mGraphicsScene(new GraphicsScene())
 {
     mUi->setupUi(this);
@@ -68,8 +68,8 @@ SymbolEditorWidget::SymbolEditorWidget(const Context& context, const FilePath& f
     mUi->formLayout->getWidgetPosition(mUi->lblCategories, &row, &role);
     mUi->formLayout->setWidget(row, QFormLayout::FieldRole, mCategoriesEditorWidget.data());
 
-    // load symbol
-    mSymbol.reset(new Symbol(fp, false)); // can throw
+    // take over the loaded symbol
+    mSymbol.reset(symbol.release());
     setWindowTitle(mSymbol->getNames().value(getLibLocaleOrder()));
     mUi->lblUuid->setText(QString("<a href=\"%1\">%2</a>").arg(
         mSymbol->getFilePath().toQUrl().toString(), mSymbol->getUuid().toStr()));
@@ -289,6 +289,36 @@ bool SymbolEditorWidget::isInterfaceBroken() const noexcept
     return mSymbol->getPins().getUuidSet() != mOriginalSymbolPinUuids;
 }
 
+std::function<QStringList()> SymbolEditorWidget::prepareChecks() const noexcept
+{
+    QString name = mUi->edtName->text();
+    QString version = mUi->edtVersion->text();
+    QList<QPair<QString, Point>> pins;
+    for (const SymbolPin& pin : mSymbol->getPins()) {
+        pins.append(qMakePair(pin.getName(), pin.getPosition()));
+    }
+    return [name, version, pins]() {
+        QStringList messages = checkNameAndVersion(name, version);
+        QSet<QString> names;
+        QHash<QPair<qint64, qint64>, QString> positions;
+        for (const QPair<QString, Point>& pin : pins) {
+            if (pin.first.trimmed().isEmpty()) {
+                messages.append(tr("A pin has no name."));
+            } else if (names.contains(pin.first)) {
+                messages.append(tr("The pin name \"%1\" is used multiple times.").arg(pin.first));
+            }
+            names.insert(pin.first);
+            QPair<qint64, qint64> pos(pin.second.getX().toNm(), pin.second.getY().toNm());
+            if (positions.contains(pos)) {
+                messages.append(tr("The pins \"%1\" and \"%2\" are at the same position.")
+                                .arg(positions.value(pos), pin.first));
+            }
+            positions.insert(pos, pin.first);
+        }
+        return messages;
+    };
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/exceptions.h>
@@ -71,7 +72,7 @@ class SymbolEditorWidget final : public EditorWidgetBase, public IF_GraphicsView
         // Constructors / Destructor
         SymbolEditorWidget() = delete;
         SymbolEditorWidget(const SymbolEditorWidget& other) = delete;
-        SymbolEditorWidget(const Context& context, const FilePath& fp,
+        SymbolEditorWidget(const Context& context, std::unique_ptr<Symbol> symbol,
                            QWidget* parent = nullptr);
         ~SymbolEditorWidget() noexcept;
 
@@ -103,6 +104,7 @@ class SymbolEditorWidget final : public EditorWidgetBase, public IF_GraphicsView
         bool graphicsViewEventHandler(QEvent* event) noexcept override;
         bool toolChangeRequested(Tool newTool) noexcept override;
         bool isInterfaceBroken() const noexcept override;
+        std::function<QStringList()> prepareChecks() const noexcept override;
 
 
     private: // Data
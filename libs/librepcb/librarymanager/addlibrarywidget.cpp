@@ -107,8 +107,8 @@ void AddLibraryWidget::currentTabChanged(int index) noexcept
     if (mUi->tabWidget->widget(index) == mUi->tabDownloadFromRepo) {
         // tab "download from repository": request list of libraries
         clearRepositoryLibraryList();
-        QList<const Repository*> repos = mWorkspace.getSettings().getRepositories().getRepositories();
-        foreach (const Repository* repo, repos) { Q_ASSERT(repo);
+        QList<Repository*> repos = mWorkspace.getSettings().getRepositories().getRepositories();
+        foreach (Repository* repo, repos) { Q_ASSERT(repo);
             mLibraryDownloadConnections.append(
                         connect(repo, &Repository::libraryListReceived,
                                 this, &AddLibraryWidget::repositoryLibraryListReceived));
@@ -0,0 +1,287 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "librarydeltaupdate.h"
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/network/filedownload.h>
+#include <librepcb/common/network/networkrequest.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace manager {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+LibraryDeltaUpdate::LibraryDeltaUpdate(const workspace::WorkspaceLibraryDb& db,
+                                       const FilePath& libDir, const QUrl& manifestUrl) noexcept :
+    QObject(nullptr), mLibraryDb(db), mLibDir(libDir), mManifestUrl(manifestUrl),
+    mTempDir(libDir.toStr() % ".delta"), mStarted(false), mFinished(false),
+    mRunningDownloads(0), mTotalDownloads(0), mFinishedDownloads(0)
+{
+}
+
+LibraryDeltaUpdate::~LibraryDeltaUpdate() noexcept
+{
+    emit abortRequested();
+    mFinished = true; // do not emit finished() anymore
+    try {FileUtils::removeDirRecursively(mTempDir);} catch (...) {}
+}
+
+/*****************************************************************************************
+ *  Public Slots
+ ****************************************************************************************/
+
+void LibraryDeltaUpdate::start() noexcept
+{
+    if (mStarted) {
+        qCritical() << "Calling this method multiple times is not allowed!";
+        return;
+    }
+    mStarted = true;
+
+    try {
+        FileUtils::removeDirRecursively(mTempDir); // can throw
+    } catch (const Exception& e) {
+        finish(false, e.getMsg());
+        return;
+    }
+
+    emit progressState(tr("Request library manifest..."));
+    NetworkRequest* request = new NetworkRequest(mManifestUrl);
+    request->setHeaderField("Accept", "application/json;charset=UTF-8");
+    request->setHeaderField("Accept-Charset", "UTF-8");
+    connect(request, &NetworkRequest::errored,
+            this, &LibraryDeltaUpdate::requestErrored, Qt::QueuedConnection);
+    connect(request, &NetworkRequest::dataReceived,
+            this, &LibraryDeltaUpdate::manifestReceived, Qt::QueuedConnection);
+    request->start();
+}
+
+void LibraryDeltaUpdate::abort() noexcept
+{
+    if (mStarted && (!mFinished)) {
+        emit abortRequested();
+        finish(false, QString());
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void LibraryDeltaUpdate::manifestReceived(const QByteArray& data) noexcept
+{
+    if (mFinished) return;
+
+    try {
+        Repository::LibraryManifest manifest = Repository::parseLibraryManifest(data); // can throw
+
+        // compare the manifest with the installed elements
+        QHash<QString, QSet<Uuid>> manifestUuids;
+        foreach (const Repository::LibraryManifestElement& element, manifest.elements) {
+            manifestUuids[element.type].insert(element.uuid);
+            FilePath dest = mLibDir.getPathTo(element.type).getPathTo(element.uuid.toStr());
+            if (dest.isExistingDir() && (getInstalledVersion(element) == element.version)) {
+                continue; // element is up to date
+            }
+            FilePath extractDir = mTempDir.getPathTo(element.type).getPathTo(element.uuid.toStr());
+            mElementsToUpdate.insert(dest, extractDir);
+            mPendingDownloads.append(PendingDownload{element.zipUrl, element.zipSha256,
+                                                     extractDir});
+        }
+        QStringList types = {"cmpcat", "pkgcat", "sym", "pkg", "cmp", "dev"};
+        foreach (const QString& type, types) {
+            QDir dir(mLibDir.getPathTo(type).toStr());
+            foreach (const QString& dirname, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+                Uuid uuid(dirname);
+                if ((!uuid.isNull()) && (!manifestUuids.value(type).contains(uuid))) {
+                    mElementsToRemove.append(mLibDir.getPathTo(type).getPathTo(dirname));
+                }
+            }
+        }
+
+        // the library metadata is small and always downloaded
+        mPendingDownloads.append(PendingDownload{manifest.metadataZipUrl,
+                                                 manifest.metadataZipSha256,
+                                                 mTempDir.getPathTo("metadata")});
+    } catch (const Exception& e) {
+        finish(false, e.getMsg());
+        return;
+    }
+
+    qDebug() << "Library delta update:" << mElementsToUpdate.count() << "added/modified and"
+             << mElementsToRemove.count() << "removed elements in" << mLibDir.toNative();
+    mTotalDownloads = mPendingDownloads.count();
+    startNextDownloads();
+}
+
+void LibraryDeltaUpdate::requestErrored(const QString& errMsg) noexcept
+{
+    if (mFinished) return;
+    emit abortRequested(); // abort all other downloads
+    finish(false, errMsg);
+}
+
+void LibraryDeltaUpdate::downloadSucceeded() noexcept
+{
+    if (mFinished) return;
+    mRunningDownloads--;
+    mFinishedDownloads++;
+    emit progressPercent((100 * mFinishedDownloads) / qMax(mTotalDownloads, 1));
+    if (!mPendingDownloads.isEmpty()) {
+        startNextDownloads();
+    } else if (mRunningDownloads == 0) {
+        try {
+            emit progressState(tr("Update library..."));
+            applyChanges(); // can throw
+            finish(true, QString());
+        } catch (const Exception& e) {
+            finish(false, e.getMsg());
+        }
+    }
+}
+
+void LibraryDeltaUpdate::startNextDownloads() noexcept
+{
+    emit progressState(QString(tr("Download %1 files...")).arg(mTotalDownloads));
+    while ((mRunningDownloads < sMaxConcurrentDownloads) && (!mPendingDownloads.isEmpty())) {
+        PendingDownload pending = mPendingDownloads.takeFirst();
+        FileDownload* download = new FileDownload(pending.url,
+                                                  FilePath(pending.extractDir.toStr() % ".zip"));
+        download->setZipExtractionDirectory(pending.extractDir);
+        if (!pending.sha256.isEmpty()) {
+            download->setExpectedChecksum(QCryptographicHash::Sha256, pending.sha256);
+        }
+        connect(download, &FileDownload::errored,
+                this, &LibraryDeltaUpdate::requestErrored, Qt::QueuedConnection);
+        connect(download, &FileDownload::succeeded,
+                this, &LibraryDeltaUpdate::downloadSucceeded, Qt::QueuedConnection);
+        connect(this, &LibraryDeltaUpdate::abortRequested,
+                download, &FileDownload::abort, Qt::QueuedConnection);
+        mRunningDownloads++;
+        download->start();
+    }
+}
+
+void LibraryDeltaUpdate::applyChanges()
+{
+    // check all downloaded files before modifying the library
+    QHash<FilePath, FilePath> elementDirs; // destination -> extracted element directory
+    for (auto it = mElementsToUpdate.constBegin(); it != mElementsToUpdate.constEnd(); ++it) {
+        QString dotfile = ".librepcb-" % it.key().getParentDir().getFilename();
+        FilePath dir = findExtractedDir(it.value(), dotfile);
+        if (!dir.isValid()) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("The downloaded ZIP file "
+                "does not contain a library element: %1")).arg(it.key().getFilename()));
+        }
+        elementDirs.insert(it.key(), dir);
+    }
+    FilePath metadataDir = findExtractedDir(mTempDir.getPathTo("metadata"), ".librepcb-lib");
+    if (!metadataDir.isValid()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("The downloaded ZIP file does not contain the library metadata."));
+    }
+
+    // update the library
+    for (auto it = elementDirs.constBegin(); it != elementDirs.constEnd(); ++it) {
+        FileUtils::removeDirRecursively(it.key()); // can throw
+        FileUtils::makePath(it.key().getParentDir()); // can throw
+        FileUtils::move(it.value(), it.key()); // can throw
+        mModifiedElementDirs.insert(it.key());
+    }
+    foreach (const FilePath& dir, mElementsToRemove) {
+        FileUtils::removeDirRecursively(dir); // can throw
+        mModifiedElementDirs.insert(dir);
+    }
+    QDir dir(metadataDir.toStr());
+    foreach (const QString& filename, dir.entryList(QDir::Files | QDir::Hidden)) {
+        FilePath dest = mLibDir.getPathTo(filename);
+        FileUtils::removeFile(dest); // can throw
+        FileUtils::copyFile(metadataDir.getPathTo(filename), dest); // can throw
+    }
+}
+
+void LibraryDeltaUpdate::finish(bool success, const QString& errMsg) noexcept
+{
+    if (mFinished) return;
+    mFinished = true;
+    try {FileUtils::removeDirRecursively(mTempDir);} catch (...) {} // clean up
+    emit finished(success, errMsg);
+}
+
+Version LibraryDeltaUpdate::getInstalledVersion(
+    const Repository::LibraryManifestElement& element) const noexcept
+{
+    QMultiMap<Version, FilePath> versions;
+    try {
+        if (element.type == "cmpcat") {
+            versions = mLibraryDb.getComponentCategories(element.uuid); // can throw
+        } else if (element.type == "pkgcat") {
+            versions = mLibraryDb.getPackageCategories(element.uuid); // can throw
+        } else if (element.type == "sym") {
+            versions = mLibraryDb.getSymbols(element.uuid); // can throw
+        } else if (element.type == "pkg") {
+            versions = mLibraryDb.getPackages(element.uuid); // can throw
+        } else if (element.type == "cmp") {
+            versions = mLibraryDb.getComponents(element.uuid); // can throw
+        } else if (element.type == "dev") {
+            versions = mLibraryDb.getDevices(element.uuid); // can throw
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Could not get installed element version:" << e.getMsg();
+    }
+    FilePath dir = mLibDir.getPathTo(element.type).getPathTo(element.uuid.toStr());
+    for (auto it = versions.constBegin(); it != versions.constEnd(); ++it) {
+        if (it.value() == dir) {
+            return it.key();
+        }
+    }
+    return Version(); // not installed -> needs to be downloaded
+}
+
+FilePath LibraryDeltaUpdate::findExtractedDir(const FilePath& dir, const QString& dotfile) noexcept
+{
+    // the ZIP file may contain the files directly or within a single subdirectory
+    if (dir.getPathTo(dotfile).isExistingFile()) {
+        return dir;
+    }
+    QStringList subdirs = QDir(dir.toStr()).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    if ((subdirs.count() == 1) && dir.getPathTo(subdirs.first()).getPathTo(dotfile).isExistingFile()) {
+        return dir.getPathTo(subdirs.first());
+    }
+    return FilePath();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace manager
+} // namespace library
+} // namespace librepcb
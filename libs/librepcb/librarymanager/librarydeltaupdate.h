@@ -0,0 +1,155 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_LIBRARYDELTAUPDATE_H
+#define LIBREPCB_WORKSPACE_LIBRARYDELTAUPDATE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/network/repository.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace workspace {
+class WorkspaceLibraryDb;
+}
+
+namespace library {
+namespace manager {
+
+/*****************************************************************************************
+ *  Class LibraryDeltaUpdate
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryDeltaUpdate class updates an installed library by downloading only
+ *        its added or modified elements
+ *
+ * First the library manifest (see librepcb::Repository) is downloaded and compared with
+ * the element versions of the installed library (taken from the workspace library
+ * database). Then the ZIP files of all added and modified elements, and the library
+ * metadata, are downloaded into a temporary directory. Only if all downloads succeeded,
+ * the elements are moved into the library directory and removed elements are deleted.
+ *
+ * After a successful update, #getModifiedElementDirectories() returns all touched
+ * element directories, which allows a targeted update of the library database (see
+ * librepcb::workspace::WorkspaceLibraryDb::startLibraryUpdate()).
+ *
+ * @note All methods must be called from the main thread.
+ */
+class LibraryDeltaUpdate final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        LibraryDeltaUpdate() = delete;
+        LibraryDeltaUpdate(const LibraryDeltaUpdate& other) = delete;
+        LibraryDeltaUpdate(const workspace::WorkspaceLibraryDb& db, const FilePath& libDir,
+                           const QUrl& manifestUrl) noexcept;
+        ~LibraryDeltaUpdate() noexcept;
+
+        // Getters
+        const FilePath& getLibraryDir() const noexcept {return mLibDir;}
+        const QSet<FilePath>& getModifiedElementDirectories() const noexcept
+        {return mModifiedElementDirs;}
+
+        // Operator Overloadings
+        LibraryDeltaUpdate& operator=(const LibraryDeltaUpdate& rhs) = delete;
+
+
+    public slots:
+
+        /**
+         * @brief Start updating the library
+         */
+        void start() noexcept;
+
+        /**
+         * @brief Abort updating the library (the library is not modified then)
+         */
+        void abort() noexcept;
+
+
+    signals:
+
+        void progressState(const QString& status);
+        void progressPercent(int percent);
+        void finished(bool success, const QString& errMsg);
+        void abortRequested(); // internal signal!
+
+
+    private: // Types
+
+        /// A file to download into the temporary directory
+        struct PendingDownload {
+            QUrl url;
+            QByteArray sha256;
+            FilePath extractDir;
+        };
+
+
+    private: // Methods
+
+        void manifestReceived(const QByteArray& data) noexcept;
+        void requestErrored(const QString& errMsg) noexcept;
+        void downloadSucceeded() noexcept;
+        void startNextDownloads() noexcept;
+        void applyChanges();
+        void finish(bool success, const QString& errMsg) noexcept;
+        Version getInstalledVersion(const Repository::LibraryManifestElement& element) const noexcept;
+        static FilePath findExtractedDir(const FilePath& dir, const QString& dotfile) noexcept;
+
+
+    private: // Data
+
+        const workspace::WorkspaceLibraryDb& mLibraryDb;
+        FilePath mLibDir;
+        QUrl mManifestUrl;
+        FilePath mTempDir;
+        bool mStarted;
+        bool mFinished;
+        QList<PendingDownload> mPendingDownloads;
+        int mRunningDownloads;
+        int mTotalDownloads;
+        int mFinishedDownloads;
+        QHash<FilePath, FilePath> mElementsToUpdate; ///< destination -> extracted dir
+        QList<FilePath> mElementsToRemove;
+        QSet<FilePath> mModifiedElementDirs;
+
+        // Constants
+        static const int sMaxConcurrentDownloads = 8;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace manager
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_WORKSPACE_LIBRARYDELTAUPDATE_H
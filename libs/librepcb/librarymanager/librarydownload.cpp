@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <quazip/JlCompress.h>
 #include "librarydownload.h"
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/network/filedownload.h>
@@ -33,15 +34,61 @@ namespace librepcb {
 namespace library {
 namespace manager {
 
+/*****************************************************************************************
+ *  Class LibraryDownload::ZipExtractor
+ ****************************************************************************************/
+
+/**
+ * @brief Extracts the downloaded ZIP file in a worker thread and removes it afterwards
+ */
+class LibraryDownload::ZipExtractor final : public QRunnable
+{
+    public:
+        explicit ZipExtractor(LibraryDownload& download) noexcept :
+            mDownload(download), mZipFile(download.mZipFile),
+            mDestDir(download.mTempDestDir)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            QString errMsg;
+            QStringList files = JlCompress::extractDir(mZipFile.toStr(), mDestDir.toStr());
+            if (files.isEmpty()) {
+                errMsg = QString(LibraryDownload::tr("Error while extracting the ZIP "
+                                 "file \"%1\".")).arg(mZipFile.toNative());
+            }
+            QFile::remove(mZipFile.toStr());
+            // the download object waits for this worker in its destructor, and the
+            // signal is delivered to the main thread by a queued connection
+            emit mDownload.extractionFinished(errMsg);
+        }
+
+    private:
+        LibraryDownload& mDownload;
+        FilePath mZipFile;
+        FilePath mDestDir;
+};
+
+/*****************************************************************************************
+ *  Static Data
+ ****************************************************************************************/
+
+QList<LibraryDownload*> LibraryDownload::sQueuedDownloads;
+int LibraryDownload::sRunningDownloads = 0;
+int LibraryDownload::sMaxConcurrentDownloads = 4;
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 LibraryDownload::LibraryDownload(const QUrl& urlToZip, const FilePath& destDir) noexcept :
-   QObject(nullptr), mDestDir(destDir), mTempDestDir(destDir.toStr() % ".tmp")
+   QObject(nullptr), mDestDir(destDir), mTempDestDir(destDir.toStr() % ".tmp"),
+   mZipFile(destDir.toStr() % ".zip"), mDownloadRunning(false), mAbortRequested(false)
 {
-    mFileDownload.reset(new FileDownload(urlToZip, FilePath(mDestDir.toStr() % ".zip")));
-    mFileDownload->setZipExtractionDirectory(mTempDestDir);
+    mExtractionPool.setMaxThreadCount(1);
+    mFileDownload.reset(new FileDownload(urlToZip, mZipFile));
     connect(mFileDownload.data(), &FileDownload::progressState,
             this, &LibraryDownload::progressState, Qt::QueuedConnection);
     connect(mFileDownload.data(), &FileDownload::progressPercent,
@@ -54,11 +101,16 @@ LibraryDownload::LibraryDownload(const QUrl& urlToZip, const FilePath& destDir)
             this, &LibraryDownload::downloadSucceeded, Qt::QueuedConnection);
     connect(this, &LibraryDownload::abortRequested,
             mFileDownload.data(), &FileDownload::abort, Qt::QueuedConnection);
+    connect(this, &LibraryDownload::extractionFinished,
+            this, &LibraryDownload::zipFileExtracted, Qt::QueuedConnection);
 }
 
 LibraryDownload::~LibraryDownload() noexcept
 {
-    abort();
+    sQueuedDownloads.removeAll(this);
+    emit abortRequested();
+    mExtractionPool.waitForDone(); // the extractor accesses this object
+    releaseDownloadSlot();
 }
 
 /*****************************************************************************************
@@ -104,30 +156,96 @@ void LibraryDownload::start() noexcept
         }
     }
 
-    mFileDownload.take()->start(); // release ownership of the FileDownload object!
+    if (sRunningDownloads < sMaxConcurrentDownloads) {
+        startDownload();
+    } else {
+        emit progressState(tr("Waiting for other downloads..."));
+        sQueuedDownloads.append(this);
+    }
 }
 
 void LibraryDownload::abort() noexcept
 {
-    emit abortRequested();
+    mAbortRequested = true;
+    if (sQueuedDownloads.removeAll(this) > 0) {
+        emit finished(false, QString()); // not started yet
+    } else {
+        emit abortRequested();
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+void LibraryDownload::setMaxConcurrentDownloads(int count) noexcept
+{
+    sMaxConcurrentDownloads = qMax(count, 1);
+    while ((sRunningDownloads < sMaxConcurrentDownloads) && (!sQueuedDownloads.isEmpty())) {
+        sQueuedDownloads.takeFirst()->startDownload();
+    }
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void LibraryDownload::startDownload() noexcept
+{
+    Q_ASSERT(!mDownloadRunning);
+    mDownloadRunning = true;
+    sRunningDownloads++;
+    mFileDownload.take()->start(); // release ownership of the FileDownload object!
+}
+
+void LibraryDownload::releaseDownloadSlot() noexcept
+{
+    if (mDownloadRunning) {
+        mDownloadRunning = false;
+        sRunningDownloads--;
+        while ((sRunningDownloads < sMaxConcurrentDownloads) && (!sQueuedDownloads.isEmpty())) {
+            sQueuedDownloads.takeFirst()->startDownload();
+        }
+    }
+}
+
 void LibraryDownload::downloadErrored(const QString& errMsg) noexcept
 {
+    releaseDownloadSlot();
     emit LibraryDownload::finished(false, errMsg);
 }
 
 void LibraryDownload::downloadAborted() noexcept
 {
+    releaseDownloadSlot();
     emit LibraryDownload::finished(false, QString());
 }
 
 void LibraryDownload::downloadSucceeded() noexcept
 {
+    // the extraction doesn't need the network anymore, so let the next download start
+    releaseDownloadSlot();
+    if (mAbortRequested) {
+        QFile::remove(mZipFile.toStr());
+        emit finished(false, QString());
+        return;
+    }
+    emit progressState(tr("Extract files..."));
+    mExtractionPool.start(new ZipExtractor(*this));
+}
+
+void LibraryDownload::zipFileExtracted(const QString& errMsg) noexcept
+{
+    if (!errMsg.isNull()) {
+        try {FileUtils::removeDirRecursively(mTempDestDir);} catch (...) {} // clean up
+        emit finished(false, errMsg);
+        return;
+    } else if (mAbortRequested) {
+        try {FileUtils::removeDirRecursively(mTempDestDir);} catch (...) {} // clean up
+        emit finished(false, QString());
+        return;
+    }
+
     // check if directory contains a library
     FilePath libDir = getPathToLibDir();
     if (!libDir.isValid()) {
@@ -43,6 +43,16 @@ namespace manager {
 /**
  * @brief The LibraryDownload class
  *
+ * Downloads a zipped library, extracts it and moves it to the destination directory.
+ *
+ * Several libraries can be downloaded at the same time, but the number of concurrently
+ * running downloads is limited (see #setMaxConcurrentDownloads()). Downloads started
+ * while the limit is reached are queued and started as soon as other downloads have
+ * finished. The ZIP file is extracted in a worker thread, so an extraction neither
+ * blocks the GUI nor other downloads.
+ *
+ * @note All methods must be called from the main thread.
+ *
  * @author ubruhin
  * @date 2016-10-01
  */
@@ -77,6 +87,16 @@ class LibraryDownload final : public QObject
         // Operator Overloadings
         LibraryDownload& operator=(const LibraryDownload& rhs) = delete;
 
+        // Static Methods
+        static int getMaxConcurrentDownloads() noexcept {return sMaxConcurrentDownloads;}
+
+        /**
+         * @brief Set the maximum number of downloads which are running at the same time
+         *
+         * @param count     The new limit (values less than one are treated as one)
+         */
+        static void setMaxConcurrentDownloads(int count) noexcept;
+
 
     public slots:
 
@@ -97,13 +117,22 @@ class LibraryDownload final : public QObject
         void progressPercent(int percent);
         void finished(bool success, const QString& errMsg);
         void abortRequested(); // internal signal!
+        void extractionFinished(const QString& errMsg); // internal signal!
+
+
+    private: // Types
+
+        class ZipExtractor;
 
 
     private: // Methods
 
+        void startDownload() noexcept;
+        void releaseDownloadSlot() noexcept;
         void downloadErrored(const QString& errMsg) noexcept;
         void downloadAborted() noexcept;
         void downloadSucceeded() noexcept;
+        void zipFileExtracted(const QString& errMsg) noexcept;
         FilePath getPathToLibDir() noexcept;
 
 
@@ -112,6 +141,15 @@ class LibraryDownload final : public QObject
         QScopedPointer<FileDownload> mFileDownload;
         FilePath mDestDir;
         FilePath mTempDestDir;
+        FilePath mZipFile;
+        bool mDownloadRunning; ///< whether this download occupies a download slot
+        bool mAbortRequested;
+        QThreadPool mExtractionPool; ///< to extract the ZIP file in a worker thread
+
+        // Download Queue (only accessed from the main thread)
+        static QList<LibraryDownload*> sQueuedDownloads;
+        static int sRunningDownloads;
+        static int sMaxConcurrentDownloads;
 };
 
 /*****************************************************************************************
@@ -18,10 +18,12 @@ QT += core widgets xml sql printsupport network
 CONFIG += staticlib
 
 INCLUDEPATH += \
-    ../../
+    ../../ \
+    ../../quazip
 
 SOURCES += \
     addlibrarywidget.cpp \
+    librarydeltaupdate.cpp \
     librarydownload.cpp \
     libraryinfowidget.cpp \
     librarylistwidgetitem.cpp \
@@ -30,6 +32,7 @@ SOURCES += \
 
 HEADERS += \
     addlibrarywidget.h \
+    librarydeltaupdate.h \
     librarydownload.h \
     libraryinfowidget.h \
     librarylistwidgetitem.h \
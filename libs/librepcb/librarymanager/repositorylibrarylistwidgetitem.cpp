@@ -26,7 +26,9 @@
 #include "ui_repositorylibrarylistwidgetitem.h"
 #include <librepcb/common/network/networkrequest.h>
 #include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
 #include "librarydownload.h"
+#include "librarydeltaupdate.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -81,6 +83,11 @@ RepositoryLibraryListWidgetItem::RepositoryLibraryListWidgetItem(workspace::Work
 
 RepositoryLibraryListWidgetItem::~RepositoryLibraryListWidgetItem() noexcept
 {
+    if (mLibraryDownload || mLibraryDeltaUpdate) {
+        mLibraryDownload.reset();
+        mLibraryDeltaUpdate.reset();
+        mWorkspace.getLibraryDb().resumeLibraryScans();
+    }
 }
 
 /*****************************************************************************************
@@ -135,33 +142,23 @@ void RepositoryLibraryListWidgetItem::updateInstalledStatus() noexcept
 
 void RepositoryLibraryListWidgetItem::startDownloadIfSelected() noexcept
 {
-    if (mUi->cbxDownload->isVisible() && mUi->cbxDownload->isChecked() && (!mLibraryDownload)) {
+    if (mUi->cbxDownload->isVisible() && mUi->cbxDownload->isChecked() && (!mLibraryDownload)
+        && (!mLibraryDeltaUpdate)) {
         mUi->cbxDownload->setVisible(false);
         mUi->prgProgress->setVisible(true);
 
-        // read ZIP metadata from JSON
-        QUrl url = QUrl(mJsonObject.value("zip_url").toString());
-        qint64 zipSize = mJsonObject.value("zip_size").toInt(-1);
-        QByteArray zipSha256 = mJsonObject.value("zip_sha256").toString().toUtf8();
+        // The library database is updated only once after all concurrently running
+        // downloads have finished.
+        mWorkspace.getLibraryDb().suspendLibraryScans();
 
-        // determine destination directory
+        // if the library is already installed, download only the modified elements
         QString libDirName = mUuid.toStr() % ".lplib";
-        FilePath destDir = mWorkspace.getLibrariesPath().getPathTo("remote/" % libDirName);
-
-        // start download
-        mLibraryDownload.reset(new LibraryDownload(url, destDir));
-        if (zipSize > 0) {
-            mLibraryDownload->setExpectedZipFileSize(zipSize);
-        }
-        if (!zipSha256.isEmpty()) {
-            mLibraryDownload->setExpectedChecksum(QCryptographicHash::Sha256,
-                                                  QByteArray::fromHex(zipSha256));
+        QUrl manifestUrl = QUrl(mJsonObject.value("manifest_url").toString());
+        if (mWorkspace.getRemoteLibraryDirectories().contains(libDirName) && manifestUrl.isValid()) {
+            startDeltaUpdate(manifestUrl);
+        } else {
+            startFullDownload();
         }
-        connect(mLibraryDownload.data(), &LibraryDownload::progressPercent,
-                mUi->prgProgress, &QProgressBar::setValue, Qt::QueuedConnection);
-        connect(mLibraryDownload.data(), &LibraryDownload::finished,
-                this, &RepositoryLibraryListWidgetItem::downloadFinished, Qt::QueuedConnection);
-        mLibraryDownload->start();
     }
 }
 
@@ -169,6 +166,45 @@ void RepositoryLibraryListWidgetItem::startDownloadIfSelected() noexcept
  *  Private Methods
  ****************************************************************************************/
 
+void RepositoryLibraryListWidgetItem::startFullDownload() noexcept
+{
+    // read ZIP metadata from JSON
+    QUrl url = QUrl(mJsonObject.value("zip_url").toString());
+    qint64 zipSize = mJsonObject.value("zip_size").toInt(-1);
+    QByteArray zipSha256 = mJsonObject.value("zip_sha256").toString().toUtf8();
+
+    // determine destination directory
+    QString libDirName = mUuid.toStr() % ".lplib";
+    FilePath destDir = mWorkspace.getLibrariesPath().getPathTo("remote/" % libDirName);
+
+    // start download
+    mLibraryDownload.reset(new LibraryDownload(url, destDir));
+    if (zipSize > 0) {
+        mLibraryDownload->setExpectedZipFileSize(zipSize);
+    }
+    if (!zipSha256.isEmpty()) {
+        mLibraryDownload->setExpectedChecksum(QCryptographicHash::Sha256,
+                                              QByteArray::fromHex(zipSha256));
+    }
+    connect(mLibraryDownload.data(), &LibraryDownload::progressPercent,
+            mUi->prgProgress, &QProgressBar::setValue, Qt::QueuedConnection);
+    connect(mLibraryDownload.data(), &LibraryDownload::finished,
+            this, &RepositoryLibraryListWidgetItem::downloadFinished, Qt::QueuedConnection);
+    mLibraryDownload->start();
+}
+
+void RepositoryLibraryListWidgetItem::startDeltaUpdate(const QUrl& manifestUrl) noexcept
+{
+    FilePath libDir = mWorkspace.getLibrariesPath().getPathTo("remote/" % mUuid.toStr() % ".lplib");
+    mLibraryDeltaUpdate.reset(new LibraryDeltaUpdate(mWorkspace.getLibraryDb(), libDir,
+                                                     manifestUrl));
+    connect(mLibraryDeltaUpdate.data(), &LibraryDeltaUpdate::progressPercent,
+            mUi->prgProgress, &QProgressBar::setValue, Qt::QueuedConnection);
+    connect(mLibraryDeltaUpdate.data(), &LibraryDeltaUpdate::finished,
+            this, &RepositoryLibraryListWidgetItem::deltaUpdateFinished, Qt::QueuedConnection);
+    mLibraryDeltaUpdate->start();
+}
+
 void RepositoryLibraryListWidgetItem::downloadFinished(bool success, const QString& errMsg) noexcept
 {
     Q_ASSERT(mLibraryDownload);
@@ -177,7 +213,7 @@ void RepositoryLibraryListWidgetItem::downloadFinished(bool success, const QStri
         try {
             // if the library exists already in the workspace, remove it first
             QString libDirName = mLibraryDownload->getDestinationDir().getFilename();
-            if (mWorkspace.getRemoteLibraries().contains(libDirName)) {
+            if (mWorkspace.getRemoteLibraryDirectories().contains(libDirName)) {
                 mWorkspace.removeRemoteLibrary(libDirName, false); // can throw
             }
 
@@ -193,14 +229,52 @@ void RepositoryLibraryListWidgetItem::downloadFinished(bool success, const QStri
         QMessageBox::critical(this, tr("Download failed"), errMsg);
     }
 
+    // delete download helper
+    mLibraryDownload.reset();
+    downloadStopped(success);
+}
+
+void RepositoryLibraryListWidgetItem::deltaUpdateFinished(bool success,
+                                                          const QString& errMsg) noexcept
+{
+    Q_ASSERT(mLibraryDeltaUpdate);
+
+    if (success) {
+        try {
+            // reload the library metadata and update only the modified elements
+            FilePath libDir = mLibraryDeltaUpdate->getLibraryDir();
+            mWorkspace.reloadRemoteLibrary(libDir.getFilename()); // can throw
+            mWorkspace.getLibraryDb().startLibraryUpdate(
+                {{libDir, mLibraryDeltaUpdate->getModifiedElementDirectories()}});
+
+            // finish
+            emit libraryAdded(libDir, false);
+        } catch (const Exception& e) {
+            QMessageBox::critical(this, tr("Update failed"), e.getMsg());
+        }
+    } else if (!errMsg.isEmpty()) {
+        // e.g. the server does not provide a manifest -> download the whole library
+        qWarning() << "Library delta update failed, download whole library:" << errMsg;
+        mLibraryDeltaUpdate.reset();
+        startFullDownload();
+        return;
+    }
+
+    // delete update helper
+    mLibraryDeltaUpdate.reset();
+    downloadStopped(success);
+}
+
+void RepositoryLibraryListWidgetItem::downloadStopped(bool success) noexcept
+{
     // update widgets
     mUi->cbxDownload->setChecked(!success);
     mUi->cbxDownload->setVisible(true);
     mUi->prgProgress->setVisible(false);
     updateInstalledStatus();
 
-    // delete download helper
-    mLibraryDownload.reset();
+    // all modifications are done, let the library database update
+    mWorkspace.getLibraryDb().resumeLibraryScans();
 }
 
 void RepositoryLibraryListWidgetItem::iconReceived(const QByteArray& data) noexcept
@@ -43,6 +43,7 @@ namespace library {
 namespace manager {
 
 class LibraryDownload;
+class LibraryDeltaUpdate;
 
 namespace Ui {
 class RepositoryLibraryListWidgetItem;
@@ -94,7 +95,11 @@ class RepositoryLibraryListWidgetItem final : public QWidget
 
     private: // Methods
 
+        void startFullDownload() noexcept;
+        void startDeltaUpdate(const QUrl& manifestUrl) noexcept;
         void downloadFinished(bool success, const QString& errMsg) noexcept;
+        void deltaUpdateFinished(bool success, const QString& errMsg) noexcept;
+        void downloadStopped(bool success) noexcept;
         void iconReceived(const QByteArray& data) noexcept;
 
 
@@ -108,6 +113,7 @@ class RepositoryLibraryListWidgetItem final : public QWidget
         QSet<Uuid> mDependencies;
         QScopedPointer<Ui::RepositoryLibraryListWidgetItem> mUi;
         QScopedPointer<LibraryDownload> mLibraryDownload;
+        QScopedPointer<LibraryDeltaUpdate> mLibraryDeltaUpdate;
 };
 
 /*****************************************************************************************
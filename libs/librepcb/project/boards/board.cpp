@@ -28,10 +28,14 @@
 #include <librepcb/common/scopeguardlist.h>
 #include <librepcb/common/boarddesignrules.h>
 #include "../project.h"
+#include "../settings/projectsettings.h"
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/memoryreport.h>
 #include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
 #include "../erc/ercmsg.h"
 #include "../circuit/componentinstance.h"
 #include "items/bi_device.h"
@@ -42,7 +46,14 @@
 #include "items/bi_netline.h"
 #include <librepcb/library/cmp/component.h>
 #include "items/bi_polygon.h"
+#include "graphicsitems/bgi_base.h"
+#include "graphicsitems/bgi_netlinebatch.h"
+#include "boardairwires.h"
+#include "boardcopperpours.h"
+#include "boarddesignrulecheck.h"
 #include "boardlayerstack.h"
+#include "boardnetlinegeometry.h"
+#include "boardnetstatistics.h"
 #include "boardusersettings.h"
 
 /*****************************************************************************************
@@ -51,13 +62,41 @@
 namespace librepcb {
 namespace project {
 
+/*****************************************************************************************
+ *  Hit Testing Helpers
+ ****************************************************************************************/
+
+/**
+ * @brief Sort items (stable) by their index in the list of all items of the board
+ *
+ * The spatial index returns items in stacking order, but the result of hit tests shall
+ * have the same order as if all items of the board were checked one after the other.
+ */
+template <typename T>
+static void sortByBoardOrder(QList<T*>& items, const QList<T*>& boardItems) noexcept
+{
+    if (items.count() < 2) return; // usually there is at most one item at a position
+    QVector<QPair<int, T*>> indexed;
+    indexed.reserve(items.count());
+    foreach (T* item, items) {
+        indexed.append(qMakePair(boardItems.indexOf(item), item));
+    }
+    std::stable_sort(indexed.begin(), indexed.end(),
+        [](const QPair<int, T*>& a, const QPair<int, T*>& b) {return a.first < b.first;});
+    for (int i = 0; i < indexed.count(); ++i) {
+        items[i] = indexed.at(i).second;
+    }
+}
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 Board::Board(const Board& other, const FilePath& filepath, const QString& name) :
     QObject(&other.getProject()), mProject(other.getProject()), mFilePath(filepath),
-    mIsAddedToProject(false)
+    mIsAddedToProject(false), mGraphicsItemsEnabled(!mProject.isModelOnly()),
+    mSelectionRectActive(false), mSelectionCounter(0), mAllAttributesChanged(false),
+    mNetLineUpdateBatchDepth(0)
 {
     try
     {
@@ -134,20 +173,55 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
             mPolygons.append(copy);
         }
 
+        mAirWires.reset(new BoardAirWires(*this));
+        mAirWires->invalidateAll();
+        mCopperPours.reset(new BoardCopperPours(*this));
+        mCopperPours->invalidateAll();
+        mDesignRuleCheck.reset(new BoardDesignRuleCheck(*this));
+        mNetStatistics.reset(new BoardNetStatistics(*this));
+        mNetLineGeometry.reset(new BoardNetLineGeometry());
+
         updateErcMessages();
         updateIcon();
 
-        // emit the "attributesChanged" signal when the project has emited it
-        connect(&mProject, &Project::attributesChanged, this, &Board::attributesChanged);
-
-        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::updateErcMessages);
-        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::updateErcMessages);
+        // emit the "attributesChanged" signal (deferred) when the project has emited it
+        connect(&mProject, &Project::attributesChanged, this, &Board::scheduleAttributesUpdate);
+
+        // cached graphics items need to be repainted when attributes have changed
+        connect(this, &Board::attributesChanged,
+                mGraphicsScene.data(), &GraphicsScene::invalidateCachedItems);
+
+        // layer changes only need a repaint, the items on the layers observe them directly
+        connect(mLayerStack.data(), &BoardLayerStack::layersChanged,
+                this, &Board::layerStackChanged);
+
+        // vias are not connected to the signal to save one connection per via
+        connect(this, &Board::attributesChanged, this, &Board::updateViaGraphicsItems);
+
+        mErcMessagesUpdateTimer.setSingleShot(true);
+        mErcMessagesUpdateTimer.setInterval(100);
+        connect(&mErcMessagesUpdateTimer, &QTimer::timeout, this, &Board::updateChangedErcMessages);
+        mAttributesUpdateTimer.setSingleShot(true);
+        mAttributesUpdateTimer.setInterval(0);
+        connect(&mAttributesUpdateTimer, &QTimer::timeout, this, &Board::updateChangedAttributes);
+        mGraphicsScenePopulationTimer.setInterval(0);
+        connect(&mGraphicsScenePopulationTimer, &QTimer::timeout,
+                this, &Board::populateGraphicsScene);
+        connect(&mProject.getCircuit(), &Circuit::componentAdded,
+                [this](ComponentInstance& cmp){scheduleErcMessagesUpdate(cmp.getUuid());});
+        connect(&mProject.getCircuit(), &Circuit::componentRemoved,
+                [this](ComponentInstance& cmp){scheduleErcMessagesUpdate(cmp.getUuid());});
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
     }
     catch (...)
     {
         // free the allocated memory in the reverse order of their allocation...
+        mNetLineGeometry.reset();
+        mNetStatistics.reset();
+        mDesignRuleCheck.reset();
+        mCopperPours.reset();
+        mAirWires.reset();
         qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
         qDeleteAll(mPolygons);          mPolygons.clear();
         qDeleteAll(mNetLines);          mNetLines.clear();
@@ -164,10 +238,22 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
     }
 }
 
+Board::Board(Project& project, SmartXmlFile* xmlFile, const DomDocument& doc,
+             bool restore, bool readOnly) :
+    Board(project, xmlFile->getFilepath(), restore, readOnly, false, QString(), xmlFile, &doc)
+{
+}
+
 Board::Board(Project& project, const FilePath& filepath, bool restore,
-             bool readOnly, bool create, const QString& newName) :
-    QObject(&project), mProject(project), mFilePath(filepath), mIsAddedToProject(false)
+             bool readOnly, bool create, const QString& newName,
+             SmartXmlFile* xmlFile, const DomDocument* doc) :
+    QObject(&project), mProject(project), mFilePath(filepath), mIsAddedToProject(false),
+    mGraphicsItemsEnabled(create && (!mProject.isModelOnly())), mSelectionRectActive(false),
+    mSelectionCounter(0), mNetLineUpdateBatchDepth(0)
 {
+    // take the ownership of the already opened file (if any) before anything can throw
+    mXmlFile.reset(xmlFile);
+
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
@@ -195,8 +281,12 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
         }
         else
         {
-            mXmlFile.reset(new SmartXmlFile(mFilePath, restore, readOnly));
-            std::unique_ptr<DomDocument> doc = mXmlFile->parseFileAndBuildDomTree();
+            std::unique_ptr<DomDocument> parsedDoc;
+            if (!doc) {
+                mXmlFile.reset(new SmartXmlFile(mFilePath, restore, readOnly));
+                parsedDoc = mXmlFile->parseFileAndBuildDomTree();
+                doc = parsedDoc.get();
+            }
             DomElement& root = doc->getRoot();
 
             // the board seems to be ready to open, so we will create all needed objects
@@ -267,20 +357,55 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
             }
         }
 
+        mAirWires.reset(new BoardAirWires(*this));
+        mAirWires->invalidateAll();
+        mCopperPours.reset(new BoardCopperPours(*this));
+        mCopperPours->invalidateAll();
+        mDesignRuleCheck.reset(new BoardDesignRuleCheck(*this));
+        mNetStatistics.reset(new BoardNetStatistics(*this));
+        mNetLineGeometry.reset(new BoardNetLineGeometry());
+
         updateErcMessages();
         updateIcon();
 
-        // emit the "attributesChanged" signal when the project has emited it
-        connect(&mProject, &Project::attributesChanged, this, &Board::attributesChanged);
-
-        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::updateErcMessages);
-        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::updateErcMessages);
+        // emit the "attributesChanged" signal (deferred) when the project has emited it
+        connect(&mProject, &Project::attributesChanged, this, &Board::scheduleAttributesUpdate);
+
+        // cached graphics items need to be repainted when attributes have changed
+        connect(this, &Board::attributesChanged,
+                mGraphicsScene.data(), &GraphicsScene::invalidateCachedItems);
+
+        // layer changes only need a repaint, the items on the layers observe them directly
+        connect(mLayerStack.data(), &BoardLayerStack::layersChanged,
+                this, &Board::layerStackChanged);
+
+        // vias are not connected to the signal to save one connection per via
+        connect(this, &Board::attributesChanged, this, &Board::updateViaGraphicsItems);
+
+        mErcMessagesUpdateTimer.setSingleShot(true);
+        mErcMessagesUpdateTimer.setInterval(100);
+        connect(&mErcMessagesUpdateTimer, &QTimer::timeout, this, &Board::updateChangedErcMessages);
+        mAttributesUpdateTimer.setSingleShot(true);
+        mAttributesUpdateTimer.setInterval(0);
+        connect(&mAttributesUpdateTimer, &QTimer::timeout, this, &Board::updateChangedAttributes);
+        mGraphicsScenePopulationTimer.setInterval(0);
+        connect(&mGraphicsScenePopulationTimer, &QTimer::timeout,
+                this, &Board::populateGraphicsScene);
+        connect(&mProject.getCircuit(), &Circuit::componentAdded,
+                [this](ComponentInstance& cmp){scheduleErcMessagesUpdate(cmp.getUuid());});
+        connect(&mProject.getCircuit(), &Circuit::componentRemoved,
+                [this](ComponentInstance& cmp){scheduleErcMessagesUpdate(cmp.getUuid());});
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
     }
     catch (...)
     {
         // free the allocated memory in the reverse order of their allocation...
+        mNetLineGeometry.reset();
+        mNetStatistics.reset();
+        mDesignRuleCheck.reset();
+        mCopperPours.reset();
+        mAirWires.reset();
         qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
         qDeleteAll(mPolygons);          mPolygons.clear();
         qDeleteAll(mNetLines);          mNetLines.clear();
@@ -301,6 +426,14 @@ Board::~Board() noexcept
 {
     Q_ASSERT(!mIsAddedToProject);
 
+    mGraphicsScenePopulationTimer.stop();
+    mPendingGraphicsItems.clear();
+
+    mNetLineGeometry.reset();
+    mNetStatistics.reset();
+    mDesignRuleCheck.reset();
+    mCopperPours.reset();
+    mAirWires.reset();
     qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
 
     // delete all items
@@ -309,6 +442,7 @@ Board::~Board() noexcept
     qDeleteAll(mNetPoints);         mNetPoints.clear();
     qDeleteAll(mVias);              mVias.clear();
     qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
+    qDeleteAll(mNetLineBatches);    mNetLineBatches.clear();
 
     mUserSettings.reset();
     mDesignRules.reset();
@@ -330,6 +464,99 @@ bool Board::isEmpty() const noexcept
             mNetLines.isEmpty());
 }
 
+BGI_NetLineBatch& Board::getNetLineBatch(const GraphicsLayer& layer) noexcept
+{
+    BGI_NetLineBatch* batch = mNetLineBatches.value(&layer, nullptr);
+    if (!batch) {
+        batch = new BGI_NetLineBatch(layer);
+        mGraphicsScene->addItem(*batch);
+        mNetLineBatches.insert(&layer, batch);
+    }
+    return *batch;
+}
+
+void Board::beginNetLineUpdateBatch() noexcept
+{
+    ++mNetLineUpdateBatchDepth;
+}
+
+void Board::endNetLineUpdateBatch() noexcept
+{
+    Q_ASSERT(mNetLineUpdateBatchDepth > 0);
+    if (--mNetLineUpdateBatchDepth == 0) {
+        QSet<BI_NetLine*> netlines;
+        netlines.swap(mDeferredNetLineUpdates);
+        foreach (BI_NetLine* netline, netlines) {
+            netline->updateLine();
+        }
+    }
+}
+
+bool Board::deferNetLineUpdate(BI_NetLine& netline) noexcept
+{
+    if (mNetLineUpdateBatchDepth > 0) {
+        mDeferredNetLineUpdates.insert(&netline);
+        return true;
+    } else {
+        return false;
+    }
+}
+
+void Board::scheduleAirWiresRebuild(const NetSignal* netsignal) noexcept
+{
+    // items may report changes while the board is still being constructed
+    if (mAirWires && netsignal) {
+        mAirWires->invalidate(*netsignal);
+    }
+}
+
+void Board::updateNetStatistics(const BI_NetLine& netline) noexcept
+{
+    if (mNetStatistics) {
+        mNetStatistics->update(netline);
+    }
+}
+
+void Board::updateNetStatistics(const BI_Via& via) noexcept
+{
+    if (mNetStatistics) {
+        mNetStatistics->update(via);
+    }
+}
+
+void Board::updateNetLineGeometry(const BI_NetLine& netline) noexcept
+{
+    if (mNetLineGeometry) {
+        mNetLineGeometry->update(netline);
+    }
+}
+
+void Board::scheduleCopperPourRefill(const BI_Polygon& polygon) noexcept
+{
+    if (mCopperPours) {
+        mCopperPours->invalidate(polygon);
+    }
+}
+
+void Board::scheduleCopperPourRefill(const Point& p1, const Point& p2,
+                                     const Length& margin) noexcept
+{
+    if (mCopperPours) {
+        mCopperPours->invalidateArea(p1, p2, margin);
+    }
+}
+
+void Board::updateSelectedItem(BI_Base& item) noexcept
+{
+    if (item.isSelected() && item.isAddedToBoard()) {
+        if (!mSelectedItems.contains(&item)) {
+            mSelectedItems.insert(&item, mSelectionCounter++);
+        }
+    } else {
+        mSelectedItems.remove(&item);
+    }
+}
+
 QList<BI_Base*> Board::getSelectedItems(bool vias,
                                         bool footprintPads,
                                         bool floatingPoints,
@@ -343,89 +570,92 @@ QList<BI_Base*> Board::getSelectedItems(bool vias,
                                         bool attachedLines,
                                         bool attachedLinesFromFootprints) const noexcept
 {
-    // TODO: this method is incredible ugly ;)
+    // sort the selected items by type and selection order
+    QList<BI_Base*> selected = mSelectedItems.keys();
+    std::sort(selected.begin(), selected.end(), [this](BI_Base* a, BI_Base* b){
+        return mSelectedItems.value(a) < mSelectedItems.value(b);
+    });
+    QList<BI_Footprint*> selectedFootprints;
+    QList<BI_FootprintPad*> selectedPads;
+    QList<BI_Via*> selectedVias;
+    QList<BI_NetPoint*> selectedNetPoints;
+    QList<BI_NetLine*> selectedNetLines;
+    foreach (BI_Base* item, selected) {
+        switch (item->getType()) {
+            case BI_Base::Type_t::Footprint:
+                selectedFootprints.append(static_cast<BI_Footprint*>(item)); break;
+            case BI_Base::Type_t::FootprintPad:
+                selectedPads.append(static_cast<BI_FootprintPad*>(item)); break;
+            case BI_Base::Type_t::Via:
+                selectedVias.append(static_cast<BI_Via*>(item)); break;
+            case BI_Base::Type_t::NetPoint:
+                selectedNetPoints.append(static_cast<BI_NetPoint*>(item)); break;
+            case BI_Base::Type_t::NetLine:
+                selectedNetLines.append(static_cast<BI_NetLine*>(item)); break;
+            default:
+                break;
+        }
+    }
 
     QList<BI_Base*> list;
-    foreach (BI_Device* component, mDeviceInstances)
-    {
-        BI_Footprint& footprint = component->getFootprint();
-
-        // footprint
-        if (footprint.isSelected())
-            list.append(&footprint);
-
-        // pads
-        foreach (BI_FootprintPad* pad, footprint.getPads())
-        {
-            // pad
-            if (pad->isSelected() && footprintPads)
-                list.append(pad);
-
+    QSet<BI_Base*> added;
+    auto append = [&list, &added](BI_Base* item){
+        if (!added.contains(item)) {
+            added.insert(item);
+            list.append(item);
+        }
+    };
+    foreach (BI_Footprint* footprint, selectedFootprints) {
+        append(footprint);
+        foreach (BI_FootprintPad* pad, footprint->getPads()) {
+            if (pad->isSelected() && footprintPads) {
+                append(pad);
+            }
             // attached netpoints & netlines
             foreach (BI_NetPoint* attachedNetPoint, pad->getNetPoints()) {
-                if (footprint.isSelected() && attachedPointsFromFootprints && attachedNetPoint)
-                {
-                    if (!list.contains(attachedNetPoint))
-                        list.append(attachedNetPoint);
+                if (attachedPointsFromFootprints) {
+                    append(attachedNetPoint);
                 }
-                if (footprint.isSelected() && attachedLinesFromFootprints && attachedNetPoint)
-                {
-                    foreach (BI_NetLine* attachedNetLine, attachedNetPoint->getLines())
-                    {
-                        if (!list.contains(attachedNetLine))
-                            list.append(attachedNetLine);
+                if (attachedLinesFromFootprints) {
+                    foreach (BI_NetLine* attachedNetLine, attachedNetPoint->getLines()) {
+                        append(attachedNetLine);
                     }
                 }
             }
         }
     }
-    foreach (BI_Via* via, mVias)
-    {
-        if (via->isSelected() && vias) {
-            list.append(via);
+    if (footprintPads) {
+        foreach (BI_FootprintPad* pad, selectedPads) {
+            append(pad); // pads of unselected footprints
         }
     }
-    foreach (BI_NetPoint* netpoint, mNetPoints)
-    {
-        if (netpoint->isSelected())
+    if (vias) {
+        foreach (BI_Via* via, selectedVias) {
+            append(via);
+        }
+    }
+    foreach (BI_NetPoint* netpoint, selectedNetPoints) {
+        if (((!netpoint->isAttached()) && floatingPoints)
+           || (netpoint->isAttached() && attachedPoints))
         {
-            if (((!netpoint->isAttached()) && floatingPoints)
-               || (netpoint->isAttached() && attachedPoints))
-            {
-                if (!list.contains(netpoint))
-                    list.append(netpoint);
-            }
+            append(netpoint);
         }
     }
-    foreach (BI_NetLine* netline, mNetLines)
-    {
-        if (netline->isSelected())
+    foreach (BI_NetLine* netline, selectedNetLines) {
+        // netline
+        if (((!netline->isAttached()) && floatingLines)
+           || (netline->isAttached() && attachedLines))
         {
-            // netline
-            if (((!netline->isAttached()) && floatingLines)
-               || (netline->isAttached() && attachedLines))
-            {
-                if (!list.contains(netline))
-                    list.append(netline);
-            }
-            // netpoints from netlines
-            BI_NetPoint* p1 = &netline->getStartPoint();
-            BI_NetPoint* p2 = &netline->getEndPoint();
-            if ( ((!netline->isAttached()) && (!p1->isAttached()) && floatingPointsFromFloatingLines)
-              || ((!netline->isAttached()) && ( p1->isAttached()) && attachedPointsFromFloatingLines)
-              || (( netline->isAttached()) && (!p1->isAttached()) && floatingPointsFromAttachedLines)
-              || (( netline->isAttached()) && ( p1->isAttached()) && attachedPointsFromAttachedLines))
-            {
-                if (!list.contains(p1))
-                    list.append(p1);
-            }
-            if ( ((!netline->isAttached()) && (!p2->isAttached()) && floatingPointsFromFloatingLines)
-              || ((!netline->isAttached()) && ( p2->isAttached()) && attachedPointsFromFloatingLines)
-              || (( netline->isAttached()) && (!p2->isAttached()) && floatingPointsFromAttachedLines)
-              || (( netline->isAttached()) && ( p2->isAttached()) && attachedPointsFromAttachedLines))
+            append(netline);
+        }
+        // netpoints from netlines
+        for (BI_NetPoint* p : {&netline->getStartPoint(), &netline->getEndPoint()}) {
+            if ( ((!netline->isAttached()) && (!p->isAttached()) && floatingPointsFromFloatingLines)
+              || ((!netline->isAttached()) && ( p->isAttached()) && attachedPointsFromFloatingLines)
+              || (( netline->isAttached()) && (!p->isAttached()) && floatingPointsFromAttachedLines)
+              || (( netline->isAttached()) && ( p->isAttached()) && attachedPointsFromAttachedLines))
             {
-                if (!list.contains(p2))
-                    list.append(p2);
+                append(p);
             }
         }
     }
@@ -436,43 +666,75 @@ QList<BI_Base*> Board::getSelectedItems(bool vias,
 QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
 {
     QPointF scenePosPx = pos.toPxQPointF();
+
+    // collect the hit items, grouped by their type
+    QList<BI_Via*> vias;
+    QList<BI_NetPoint*> netpoints;
+    QList<BI_NetLine*> netlines;
+    QMap<Uuid, BI_Device*> devices; // devices with a hit footprint or pad, same keys as
+                                    // #mDeviceInstances to keep their order
+    QSet<const BI_Base*> hitFootprintsAndPads;
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(scenePosPx)) {
+        if ((!item->isSelectable()) || (!item->getGrabAreaScenePx().contains(scenePosPx))) {
+            continue;
+        }
+        switch (item->getType()) {
+            case BI_Base::Type_t::Via:
+                vias.append(static_cast<BI_Via*>(item));
+                break;
+            case BI_Base::Type_t::NetPoint:
+                netpoints.append(static_cast<BI_NetPoint*>(item));
+                break;
+            case BI_Base::Type_t::NetLine:
+                netlines.append(static_cast<BI_NetLine*>(item));
+                break;
+            case BI_Base::Type_t::Footprint: {
+                BI_Device& device = static_cast<BI_Footprint*>(item)->getDeviceInstance();
+                devices.insert(device.getComponentInstanceUuid(), &device);
+                hitFootprintsAndPads.insert(item);
+                break;
+            }
+            case BI_Base::Type_t::FootprintPad: {
+                BI_Device& device = static_cast<BI_FootprintPad*>(item)->getFootprint()
+                                    .getDeviceInstance();
+                devices.insert(device.getComponentInstanceUuid(), &device);
+                hitFootprintsAndPads.insert(item);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    sortByBoardOrder(vias, mVias);
+    sortByBoardOrder(netpoints, mNetPoints);
+    sortByBoardOrder(netlines, mNetLines);
+
     QList<BI_Base*> list;   // Note: The order of adding the items is very important (the
                             // top most item must appear as the first item in the list)!
     // vias
-    foreach (BI_Via* via, mVias)
-    {
-        if (via->isSelectable() && via->getGrabAreaScenePx().contains(scenePosPx)) {
-            list.append(via);
-        }
+    foreach (BI_Via* via, vias) {
+        list.append(via);
     }
     // netpoints
-    foreach (BI_NetPoint* netpoint, mNetPoints)
-    {
-        if (netpoint->isSelectable() && netpoint->getGrabAreaScenePx().contains(scenePosPx)) {
-            list.append(netpoint);
-        }
+    foreach (BI_NetPoint* netpoint, netpoints) {
+        list.append(netpoint);
     }
     // netlines
-    foreach (BI_NetLine* netline, mNetLines)
-    {
-        if (netline->isSelectable() && netline->getGrabAreaScenePx().contains(scenePosPx)) {
-            list.append(netline);
-        }
+    foreach (BI_NetLine* netline, netlines) {
+        list.append(netline);
     }
     // footprints & pads
-    foreach (BI_Device* device, mDeviceInstances)
-    {
+    foreach (BI_Device* device, devices) {
         BI_Footprint& footprint = device->getFootprint();
-        if (footprint.isSelectable() && footprint.getGrabAreaScenePx().contains(scenePosPx)) {
+        if (hitFootprintsAndPads.contains(&footprint)) {
             if (footprint.getIsMirrored()) {
                 list.append(&footprint);
             } else {
                 list.prepend(&footprint);
             }
         }
-        foreach (BI_FootprintPad* pad, footprint.getPads())
-        {
-            if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(scenePosPx)) {
+        foreach (BI_FootprintPad* pad, footprint.getPads()) {
+            if (hitFootprintsAndPads.contains(pad)) {
                 if (pad->getIsMirrored()) {
                     list.append(pad);
                 } else {
@@ -486,69 +748,121 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
 
 QList<BI_Via*> Board::getViasAtScenePos(const Point& pos, const NetSignal* netsignal) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<BI_Via*> list;
-    foreach (BI_Via* via, mVias)
-    {
-        if (via->isSelectable() && via->getGrabAreaScenePx().contains(pos.toPxQPointF())
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(scenePosPx)) {
+        if (item->getType() != BI_Base::Type_t::Via) continue;
+        BI_Via* via = static_cast<BI_Via*>(item);
+        if (via->isSelectable() && via->getGrabAreaScenePx().contains(scenePosPx)
             && ((!netsignal) || (via->getNetSignal() == netsignal)))
         {
             list.append(via);
         }
     }
+    sortByBoardOrder(list, mVias);
     return list;
 }
 
 QList<BI_NetPoint*> Board::getNetPointsAtScenePos(const Point& pos, const GraphicsLayer* layer,
                                                   const NetSignal* netsignal) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<BI_NetPoint*> list;
-    foreach (BI_NetPoint* netpoint, mNetPoints)
-    {
-        if (netpoint->isSelectable() && netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF())
-            && ((!layer) || (&netpoint->getLayer() == layer))
-            && ((!netsignal) || (&netpoint->getNetSignal() == netsignal)))
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(scenePosPx)) {
+        if (item->getType() != BI_Base::Type_t::NetPoint) continue;
+        BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+        // check the cheap conditions first, the grab area is expensive to calculate
+        if (((!layer) || (&netpoint->getLayer() == layer))
+            && ((!netsignal) || (&netpoint->getNetSignal() == netsignal))
+            && netpoint->isSelectable() && netpoint->getGrabAreaScenePx().contains(scenePosPx))
         {
             list.append(netpoint);
         }
     }
+    sortByBoardOrder(list, mNetPoints);
     return list;
 }
 
 QList<BI_NetLine*> Board::getNetLinesAtScenePos(const Point& pos, const GraphicsLayer* layer,
                                                 const NetSignal* netsignal) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<BI_NetLine*> list;
-    foreach (BI_NetLine* netline, mNetLines)
-    {
-        if (netline->isSelectable() && netline->getGrabAreaScenePx().contains(pos.toPxQPointF())
-            && ((!layer) || (&netline->getLayer() == layer))
-            && ((!netsignal) || (&netline->getNetSignal() == netsignal)))
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(scenePosPx)) {
+        if (item->getType() != BI_Base::Type_t::NetLine) continue;
+        BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+        // check the cheap conditions first, the grab area is expensive to calculate
+        if (((!layer) || (&netline->getLayer() == layer))
+            && ((!netsignal) || (&netline->getNetSignal() == netsignal))
+            && netline->isSelectable() && netline->getGrabAreaScenePx().contains(scenePosPx))
         {
             list.append(netline);
         }
     }
+    sortByBoardOrder(list, mNetLines);
     return list;
 }
 
 QList<BI_FootprintPad*> Board::getPadsAtScenePos(const Point& pos, const GraphicsLayer* layer,
                                                  const NetSignal* netsignal) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<BI_FootprintPad*> list;
-    foreach (BI_Device* device, mDeviceInstances)
-    {
-        foreach (BI_FootprintPad* pad, device->getFootprint().getPads())
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(scenePosPx)) {
+        if (item->getType() != BI_Base::Type_t::FootprintPad) continue;
+        BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+        if (((!layer) || (pad->isOnLayer(layer->getName())))
+            && ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))
+            && pad->isSelectable() && pad->getGrabAreaScenePx().contains(scenePosPx))
         {
-            if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(pos.toPxQPointF())
-                && ((!layer) || (pad->isOnLayer(layer->getName())))
-                && ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal)))
-            {
-                list.append(pad);
-            }
+            list.append(pad);
         }
     }
     return list;
 }
 
+BI_Base* Board::getNearestSnapTarget(const Point& pos, const Length& maxDistance,
+                                     const GraphicsLayer* layer, const NetSignal* netsignal,
+                                     const QSet<const BI_Base*>& ignore) const noexcept
+{
+    QPointF scenePosPx = pos.toPxQPointF();
+    qreal radiusPx = maxDistance.toPx();
+    QRectF sceneRectPx(scenePosPx.x() - radiusPx, scenePosPx.y() - radiusPx,
+                       2 * radiusPx, 2 * radiusPx);
+    BI_Base* nearestItem = nullptr;
+    Length nearestDistance = maxDistance;
+    foreach (BI_Base* item, getItemCandidatesInSceneRect(sceneRectPx)) {
+        if (ignore.contains(item) || (!item->isSelectable())) continue;
+        switch (item->getType()) {
+            case BI_Base::Type_t::FootprintPad: {
+                BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+                if ((layer && (!pad->isOnLayer(layer->getName())))
+                    || (netsignal && (pad->getCompSigInstNetSignal() != netsignal))) continue;
+                break;
+            }
+            case BI_Base::Type_t::Via: {
+                BI_Via* via = static_cast<BI_Via*>(item);
+                if (netsignal && (via->getNetSignal() != netsignal)) continue;
+                break;
+            }
+            case BI_Base::Type_t::NetPoint: {
+                BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+                if ((layer && (&netpoint->getLayer() != layer))
+                    || (netsignal && (&netpoint->getNetSignal() != netsignal))) continue;
+                break;
+            }
+            default:
+                continue;
+        }
+        Length distance = (item->getPosition() - pos).getLength();
+        if ((distance < nearestDistance) || ((!nearestItem) && (distance == nearestDistance))) {
+            nearestItem = item;
+            nearestDistance = distance;
+        }
+    }
+    return nearestItem;
+}
+
 QList<BI_Base*> Board::getAllItems() const noexcept
 {
     QList<BI_Base*> items;
@@ -597,7 +911,7 @@ void Board::addDeviceInstance(BI_Device& instance)
     // add to board
     instance.addToBoard(*mGraphicsScene); // can throw
     mDeviceInstances.insert(instance.getComponentInstanceUuid(), &instance);
-    updateErcMessages();
+    scheduleErcMessagesUpdate(instance.getComponentInstanceUuid());
     emit deviceAdded(instance);
 }
 
@@ -606,10 +920,11 @@ void Board::removeDeviceInstance(BI_Device& instance)
     if ((!mIsAddedToProject) || (!mDeviceInstances.contains(instance.getComponentInstanceUuid()))) {
         throw LogicError(__FILE__, __LINE__);
     }
-    // remove from board
+    // remove from board (with graphics items, so they are removed from the scene too)
+    createPendingGraphicsItems(instance);
     instance.removeFromBoard(*mGraphicsScene); // can throw
     mDeviceInstances.remove(instance.getComponentInstanceUuid());
-    updateErcMessages();
+    scheduleErcMessagesUpdate(instance.getComponentInstanceUuid());
     emit deviceRemoved(instance);
 }
 
@@ -648,10 +963,73 @@ void Board::removeVia(BI_Via& via)
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from board
+    createPendingGraphicsItems(via);
     via.removeFromBoard(*mGraphicsScene); // can throw
     mVias.removeOne(&via);
 }
 
+void Board::addVias(const QList<BI_Via*>& vias)
+{
+    if (!mIsAddedToProject) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    // check all vias before adding any of them
+    QSet<Uuid> uuids;
+    uuids.reserve(mVias.count() + vias.count());
+    foreach (const BI_Via* via, mVias) {
+        uuids.insert(via->getUuid());
+    }
+    foreach (const BI_Via* via, vias) {
+        if ((via->isAddedToBoard()) || (&via->getBoard() != this)) {
+            throw LogicError(__FILE__, __LINE__);
+        }
+        if (uuids.contains(via->getUuid())) {
+            throw RuntimeError(__FILE__, __LINE__,
+                QString(tr("There is already a via with the UUID \"%1\"!"))
+                .arg(via->getUuid().toStr()));
+        }
+        uuids.insert(via->getUuid());
+    }
+    // add to board
+    beginBulkUpdate();
+    auto sg = scopeGuard([this](){endBulkUpdate();});
+    ScopeGuardList sgl(vias.count());
+    foreach (BI_Via* via, vias) {
+        via->addToBoard(*mGraphicsScene); // can throw
+        sgl.add([this, via](){via->removeFromBoard(*mGraphicsScene);});
+    }
+    mVias.append(vias);
+    sgl.dismiss();
+}
+
+void Board::removeVias(const QList<BI_Via*>& vias)
+{
+    QSet<BI_Via*> viasToRemove = vias.toSet();
+    if ((!mIsAddedToProject) || (viasToRemove.count() != vias.count())
+        || (!mVias.toSet().contains(viasToRemove)))
+    {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    // remove from board
+    beginBulkUpdate();
+    auto sg = scopeGuard([this](){endBulkUpdate();});
+    ScopeGuardList sgl(vias.count());
+    foreach (BI_Via* via, vias) {
+        createPendingGraphicsItems(*via);
+        via->removeFromBoard(*mGraphicsScene); // can throw
+        sgl.add([this, via](){via->addToBoard(*mGraphicsScene);});
+    }
+    QList<BI_Via*> remainingVias;
+    remainingVias.reserve(mVias.count() - vias.count());
+    foreach (BI_Via* via, mVias) {
+        if (!viasToRemove.contains(via)) {
+            remainingVias.append(via);
+        }
+    }
+    mVias = remainingVias;
+    sgl.dismiss();
+}
+
 /*****************************************************************************************
  *  NetPoint Methods
  ****************************************************************************************/
@@ -689,6 +1067,7 @@ void Board::removeNetPoint(BI_NetPoint& netpoint)
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from board
+    createPendingGraphicsItems(netpoint);
     netpoint.removeFromBoard(*mGraphicsScene); // can throw
     mNetPoints.removeOne(&netpoint);
 }
@@ -730,8 +1109,10 @@ void Board::removeNetLine(BI_NetLine& netline)
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from board
+    createPendingGraphicsItems(netline);
     netline.removeFromBoard(*mGraphicsScene); // can throw
     mNetLines.removeOne(&netline);
+    mDeferredNetLineUpdates.remove(&netline);
 }
 
 /*****************************************************************************************
@@ -754,6 +1135,7 @@ void Board::removePolygon(BI_Polygon& polygon)
     if ((!mIsAddedToProject) || (!mPolygons.contains(&polygon))) {
         throw LogicError(__FILE__, __LINE__);
     }
+    createPendingGraphicsItems(polygon);
     polygon.removeFromBoard(*mGraphicsScene); // can throw
     mPolygons.removeOne(&polygon);
 }
@@ -805,8 +1187,8 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept
     {
         if (mIsAddedToProject)
         {
-            DomDocument doc(*serializeToDomElement("board"));
-            mXmlFile->save(doc, toOriginal);
+            mXmlFile->setCompressed(mProject.getSettings().getCompressFiles());
+            mXmlFile->save(*this, "board", toOriginal);
         }
         else
         {
@@ -830,44 +1212,130 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept
 void Board::showInView(GraphicsView& view) noexcept
 {
     view.setScene(mGraphicsScene.data());
+    if (!mGraphicsItemsEnabled) {
+        startGraphicsScenePopulation(view);
+    }
+}
+
+void Board::finishGraphicsScenePopulation() noexcept
+{
+    enableGraphicsItems();
+    if (!mPendingGraphicsItems.isEmpty()) {
+        createQueuedGraphicsItems(-1);
+    }
 }
 
 void Board::setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept
 {
     mGraphicsScene->setSelectionRect(p1, p2);
-    if (updateItems)
-    {
-        QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-        foreach (BI_Device* component, mDeviceInstances)
-        {
-            BI_Footprint& footprint = component->getFootprint();
-            bool selectFootprint = footprint.isSelectable() && footprint.getGrabAreaScenePx().intersects(rectPx);
-            footprint.setSelected(selectFootprint);
-            foreach (BI_FootprintPad* pad, footprint.getPads())
-            {
-                bool selectPad = pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-                pad->setSelected(selectFootprint || selectPad);
+    if (!updateItems) {
+        mSelectionRectActive = false;
+        return;
+    }
+
+    // pending items could not be selected (and are not found in the scene)
+    finishGraphicsScenePopulation();
+
+    QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+
+    // Only items within the previous or the current selection rect can change their
+    // selection state, so only these items need to be updated (queried by the spatial
+    // index of the scene). The first time after starting a new selection rect, the
+    // already selected items are updated too because they could have been selected in
+    // any other way.
+    QList<BI_Base*> items;
+    if (mSelectionRectActive) {
+        items = getItemCandidatesInSceneRect(rectPx.united(mSelectionRectPx));
+    } else {
+        items = getItemCandidatesInSceneRect(rectPx);
+        items.append(mSelectedItems.keys());
+    }
+    mSelectionRectPx = rectPx;
+    mSelectionRectActive = true;
+
+    auto setSelected = [](BI_Base& item, bool selected) {
+        if (item.isSelected() != selected) item.setSelected(selected);
+    };
+
+    QSet<BI_Footprint*> footprints;
+    foreach (BI_Base* item, items) {
+        switch (item->getType()) {
+            case BI_Base::Type_t::Footprint: {
+                BI_Footprint* footprint = static_cast<BI_Footprint*>(item);
+                footprints.insert(footprint);
+                break;
             }
+            case BI_Base::Type_t::FootprintPad: {
+                // the selection state of pads depends on their footprint
+                BI_Footprint* footprint = &static_cast<BI_FootprintPad*>(item)->getFootprint();
+                footprints.insert(footprint);
+                break;
+            }
+            case BI_Base::Type_t::Via:
+            case BI_Base::Type_t::NetPoint:
+            case BI_Base::Type_t::NetLine:
+                setSelected(*item, item->isSelectable()
+                            && item->getGrabAreaScenePx().intersects(rectPx));
+                break;
+            default:
+                break;
+        }
+    }
+    foreach (BI_Footprint* footprint, footprints) {
+        bool selectFootprint = footprint->isSelectable() && footprint->getGrabAreaScenePx().intersects(rectPx);
+        setSelected(*footprint, selectFootprint);
+        foreach (BI_FootprintPad* pad, footprint->getPads())
+        {
+            bool selectPad = pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
+            setSelected(*pad, selectFootprint || selectPad);
         }
-        foreach (BI_Via* via, mVias)
-            via->setSelected(via->isSelectable() && via->getGrabAreaScenePx().intersects(rectPx));
-        foreach (BI_NetPoint* netpoint, mNetPoints)
-            netpoint->setSelected(netpoint->isSelectable() && netpoint->getGrabAreaScenePx().intersects(rectPx));
-        foreach (BI_NetLine* netline, mNetLines)
-            netline->setSelected(netline->isSelectable() && netline->getGrabAreaScenePx().intersects(rectPx));
     }
 }
 
 void Board::clearSelection() const noexcept
 {
-    foreach (BI_Device* device, mDeviceInstances)
-        device->getFootprint().setSelected(false);
-    foreach (BI_Via* via, mVias)
-        via->setSelected(false);
-    foreach (BI_NetPoint* netpoint, mNetPoints)
-        netpoint->setSelected(false);
-    foreach (BI_NetLine* netline, mNetLines)
-        netline->setSelected(false);
+    mSelectionRectActive = false;
+    foreach (BI_Base* item, mSelectedItems.keys()) { // copy, modified by setSelected()
+        item->setSelected(false);
+    }
+}
+
+void Board::beginBulkUpdate() noexcept
+{
+    mGraphicsScene->beginBulkUpdate();
+    mProject.getCircuit().beginBulkUpdate();
+}
+
+void Board::endBulkUpdate() noexcept
+{
+    mProject.getCircuit().endBulkUpdate();
+    mGraphicsScene->endBulkUpdate();
+}
+
+void Board::addToMemoryReport(MemoryReport& parent) const noexcept
+{
+    MemoryReport& report = parent.addChild(QString("Board \"%1\"").arg(mName), sizeof(Board));
+    int pads = 0;
+    foreach (const BI_Device* device, mDeviceInstances) {
+        pads += device->getFootprint().getPads().count();
+    }
+    MemoryReport& devices = report.addChild("Devices", mDeviceInstances.count() *
+        (sizeof(BI_Device) + sizeof(BI_Footprint)), mDeviceInstances.count());
+    devices.addObjects<BI_FootprintPad>("Pads", pads);
+    report.addObjects<BI_Via>("Vias", mVias.count());
+    report.addObjects<BI_NetPoint>("Net points", mNetPoints.count());
+    report.addObjects<BI_NetLine>("Net lines", mNetLines.count());
+    qint64 polygonBytes = 0;
+    foreach (const BI_Polygon* polygon, mPolygons) {
+        polygonBytes += sizeof(BI_Polygon) + sizeof(Polygon)
+            + polygon->getPolygon().getSegments().count() * sizeof(PolygonSegment);
+    }
+    report.addChild("Polygons", polygonBytes, mPolygons.count());
+    report.addChild("Net line geometry", mNetLineGeometry->getCount() *
+        (4 * sizeof(LengthBase_t) + sizeof(LengthBase_t) + 3 * sizeof(void*)),
+        mNetLineGeometry->getCount());
+    mCopperPours->addToMemoryReport(report);
+    mGraphicsScene->addToMemoryReport(report);
 }
 
 /*****************************************************************************************
@@ -877,20 +1345,207 @@ void Board::clearSelection() const noexcept
 bool Board::getAttributeValue(const QString& attrNS, const QString& attrKey,
                               bool passToParents, QString& value) const noexcept
 {
-    // TODO
-    Q_UNUSED(attrNS);
-    Q_UNUSED(attrKey);
-    Q_UNUSED(passToParents);
-    Q_UNUSED(value);
-    return false;
+    if (attrNS == QLatin1String("NET"))
+    {
+        // the key has the form "<netname>::<property>", e.g. "GND::LENGTH"
+        int separator = attrKey.lastIndexOf(QLatin1String("::"));
+        NetSignal* netsignal = (separator > 0) ?
+            mProject.getCircuit().getNetSignalByName(attrKey.left(separator)) : nullptr;
+        if (netsignal && mNetStatistics) {
+            QString property = attrKey.mid(separator + 2);
+            BoardNetStatistics::Statistics stats = mNetStatistics->getStatistics(netsignal->getUuid());
+            if (property == QLatin1String("LENGTH"))
+                return value = QString::number(stats.length.toMm()) % QStringLiteral("mm"), true;
+            else if (property == QLatin1String("TRACES"))
+                return value = QString::number(stats.netLineCount), true;
+            else if (property == QLatin1String("VIAS"))
+                return value = QString::number(stats.viaCount), true;
+        }
+    }
+
+    if ((attrNS != QLatin1String("NET")) && (passToParents))
+        return mProject.getAttributeValue(attrNS, attrKey, passToParents, value);
+    else
+        return false;
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+QList<BI_Base*> Board::getItemCandidatesInSceneRect(const QRectF& sceneRectPx) const noexcept
+{
+    QList<BI_Base*> items;
+    foreach (QGraphicsItem* graphicsItem, mGraphicsScene->items(sceneRectPx,
+             Qt::IntersectsItemBoundingRect, Qt::DescendingOrder))
+    {
+        BGI_Base* boardGraphicsItem = dynamic_cast<BGI_Base*>(graphicsItem);
+        if (boardGraphicsItem) {
+            items.append(&boardGraphicsItem->getBoardItem());
+        }
+    }
+    return items;
+}
+
+QList<BI_Base*> Board::getItemCandidatesAtScenePos(const QPointF& scenePosPx) const noexcept
+{
+    // The BSP tree of the graphics scene is used as spatial index, so only the items
+    // whose bounding rect contains the position need to be checked (much cheaper than
+    // calculating the grab area of every single item of the board).
+    QList<BI_Base*> items;
+    foreach (QGraphicsItem* graphicsItem, mGraphicsScene->items(scenePosPx,
+             Qt::IntersectsItemBoundingRect, Qt::DescendingOrder))
+    {
+        BGI_Base* boardGraphicsItem = dynamic_cast<BGI_Base*>(graphicsItem);
+        if (boardGraphicsItem) {
+            items.append(&boardGraphicsItem->getBoardItem());
+        }
+    }
+    return items;
+}
+
+void Board::startGraphicsScenePopulation(GraphicsView& view) noexcept
+{
+    Q_ASSERT(!mGraphicsItemsEnabled);
+
+    // New items get their graphics items immediately from now on, only the existing
+    // items are queued. The queue is sorted on the first time slice since the visible
+    // rect of the view is usually restored after showing the scene.
+    mGraphicsItemsEnabled = true;
+    foreach (BI_Device* device, mDeviceInstances) {
+        mPendingGraphicsItems.insert(&device->getFootprint());
+        foreach (BI_FootprintPad* pad, device->getFootprint().getPads())
+            mPendingGraphicsItems.insert(pad);
+    }
+    foreach (BI_Via* via, mVias)
+        mPendingGraphicsItems.insert(via);
+    foreach (BI_NetPoint* netpoint, mNetPoints)
+        mPendingGraphicsItems.insert(netpoint);
+    foreach (BI_NetLine* netline, mNetLines)
+        mPendingGraphicsItems.insert(netline);
+    foreach (BI_Polygon* polygon, mPolygons)
+        mPendingGraphicsItems.insert(polygon);
+    mPendingGraphicsItemsQueue.clear();
+    mGraphicsScenePopulationView = &view;
+
+    // the BSP tree index is built only once at the end of the population
+    mGraphicsScene->beginBulkUpdate();
+    mGraphicsScenePopulationTimer.start();
+}
+
+void Board::populateGraphicsScene() noexcept
+{
+    createQueuedGraphicsItems(sGraphicsScenePopulationSliceMs);
+}
+
+void Board::createQueuedGraphicsItems(int maxMs) noexcept
+{
+    if (mPendingGraphicsItems.isEmpty()) {
+        mGraphicsScenePopulationTimer.stop();
+        return;
+    }
+
+    if (mPendingGraphicsItemsQueue.isEmpty()) {
+        QRectF visibleRectPx;
+        if (mGraphicsScenePopulationView) {
+            visibleRectPx = mGraphicsScenePopulationView->getVisibleSceneRect();
+        }
+        QList<QPair<int, BI_Base*>> items;
+        items.reserve(mPendingGraphicsItems.count());
+        foreach (BI_Base* item, mPendingGraphicsItems) {
+            items.append(qMakePair(getGraphicsItemPriority(*item, visibleRectPx), item));
+        }
+        std::stable_sort(items.begin(), items.end(),
+            [](const QPair<int, BI_Base*>& a, const QPair<int, BI_Base*>& b) {
+                return a.first < b.first;
+            });
+        mPendingGraphicsItemsQueue.reserve(items.count());
+        typedef QPair<int, BI_Base*> PriorityAndItem;
+        foreach (const PriorityAndItem& pair, items) {
+            mPendingGraphicsItemsQueue.append(pair.second);
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int index = 0;
+    while ((index < mPendingGraphicsItemsQueue.count()) &&
+           ((maxMs < 0) || (timer.elapsed() < maxMs))) {
+        BI_Base* item = mPendingGraphicsItemsQueue.at(index++);
+        // items which were removed in the meantime are no longer pending
+        if (mPendingGraphicsItems.remove(item)) {
+            item->createGraphicsItems(*mGraphicsScene);
+        }
+    }
+    mPendingGraphicsItemsQueue.erase(mPendingGraphicsItemsQueue.begin(),
+                                     mPendingGraphicsItemsQueue.begin() + index);
+
+    if (mPendingGraphicsItems.isEmpty()) {
+        mGraphicsScenePopulationTimer.stop();
+        mPendingGraphicsItemsQueue.clear();
+        mGraphicsScenePopulationView.clear();
+        mGraphicsScene->endBulkUpdate(); // builds the BSP tree index
+        updateIcon();
+    }
+}
+
+int Board::getGraphicsItemPriority(const BI_Base& item, const QRectF& visibleRectPx) const noexcept
+{
+    // 0: board outlines (needed for "zoom all"), 1: visible copper, 2: other visible
+    // items, 3: invisible copper, 4: other invisible items
+    switch (item.getType()) {
+        case BI_Base::Type_t::Polygon: {
+            const Polygon& polygon = static_cast<const BI_Polygon&>(item).getPolygon();
+            if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
+                return 0;
+            }
+            return polygon.toQPainterPathPx().boundingRect().intersects(visibleRectPx) ? 2 : 4;
+        }
+        case BI_Base::Type_t::Footprint:
+            return visibleRectPx.contains(item.getPosition().toPxQPointF()) ? 2 : 4;
+        default: // pads, vias, netpoints and netlines
+            return visibleRectPx.contains(item.getPosition().toPxQPointF()) ? 1 : 3;
+    }
+}
+
+void Board::createPendingGraphicsItems(BI_Base& item) noexcept
+{
+    if (mPendingGraphicsItems.remove(&item)) {
+        item.createGraphicsItems(*mGraphicsScene);
+    }
+}
+
+void Board::createPendingGraphicsItems(BI_Device& device) noexcept
+{
+    if (mPendingGraphicsItems.isEmpty()) return;
+    foreach (BI_FootprintPad* pad, device.getFootprint().getPads())
+        createPendingGraphicsItems(*pad);
+    createPendingGraphicsItems(device.getFootprint());
+}
+
+void Board::enableGraphicsItems() noexcept
+{
+    if (mGraphicsItemsEnabled) return;
+
+    // create the graphics items which were skipped while loading the board
+    mGraphicsItemsEnabled = true;
+    foreach (BI_Device* device, mDeviceInstances)
+        device->createGraphicsItems(*mGraphicsScene);
+    foreach (BI_Via* via, mVias)
+        via->createGraphicsItems(*mGraphicsScene);
+    foreach (BI_NetPoint* netpoint, mNetPoints)
+        netpoint->createGraphicsItems(*mGraphicsScene);
+    foreach (BI_NetLine* netline, mNetLines)
+        netline->createGraphicsItems(*mGraphicsScene);
+    foreach (BI_Polygon* polygon, mPolygons)
+        polygon->createGraphicsItems(*mGraphicsScene);
+    updateIcon();
+}
+
 void Board::updateIcon() noexcept
 {
+    if (!mGraphicsItemsEnabled) return; // the scene is empty until shown in a view
+
     QRectF source = mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
     QRect target(0, 0, 297, 210); // DIN A4 format :-)
 
@@ -909,18 +1564,31 @@ bool Board::checkAttributesValidity() const noexcept
 }
 
 void Board::serialize(DomElement& root) const
+{
+    serializeChilds(root);
+}
+
+void Board::serializeToXmlStream(QXmlStreamWriter& writer, const QString& name) const
+{
+    writer.writeStartElement(name);
+    serializeChilds(writer); // can throw
+    writer.writeEndElement();
+}
+
+template <typename T>
+void Board::serializeChilds(T& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
     // metadata
-    root.appendTextChild("uuid", mUuid);
-    root.appendTextChild("name", mName);
+    serializeTextChild(root, "uuid", mUuid);
+    serializeTextChild(root, "name", mName);
     // grid properties
-    root.appendChild(mGridProperties->serializeToDomElement("grid"));
+    serializeChild(root, *mGridProperties, "grid");
     // layer stack
-    root.appendChild(mLayerStack->serializeToDomElement("layers"));
+    serializeChild(root, *mLayerStack, "layers");
     // design rules
-    root.appendChild(mDesignRules->serializeToDomElement("design_rules"));
+    serializeChild(root, *mDesignRules, "design_rules");
     // devices
     serializePointerContainer(root, mDeviceInstances, "device");
     // vias
@@ -936,37 +1604,120 @@ void Board::serialize(DomElement& root) const
 void Board::updateErcMessages() noexcept
 {
     // type: UnplacedComponent (ComponentInstances without DeviceInstance)
+    mErcMessagesUpdateTimer.stop();
+    mErcMsgChangedComponentInstances.clear();
     if (mIsAddedToProject)
     {
-        const QMap<Uuid, ComponentInstance*>& componentInstances = mProject.getCircuit().getComponentInstances();
-        foreach (const ComponentInstance* component, componentInstances)
-        {
-            if (component->getLibComponent().isSchematicOnly()) continue;
-            BI_Device* device = mDeviceInstances.value(component->getUuid());
-            ErcMsg* ercMsg = mErcMsgListUnplacedComponentInstances.value(component->getUuid());
-            if ((!device) && (!ercMsg))
-            {
-                ErcMsg* ercMsg = new ErcMsg(mProject, *this, QString("%1/%2").arg(mUuid.toStr(),
-                    component->getUuid().toStr()), "UnplacedComponent", ErcMsg::ErcMsgType_t::BoardError,
-                    QString("Unplaced Component: %1 (Board: %2)").arg(component->getName(), mName));
-                ercMsg->setVisible(true);
-                mErcMsgListUnplacedComponentInstances.insert(component->getUuid(), ercMsg);
-            }
-            else if ((device) && (ercMsg))
-            {
-                delete mErcMsgListUnplacedComponentInstances.take(component->getUuid());
-            }
+        foreach (const Uuid& uuid, mProject.getCircuit().getComponentInstances().keys()) {
+            updateErcMessageOfComponent(uuid);
         }
         foreach (const Uuid& uuid, mErcMsgListUnplacedComponentInstances.keys()) {
-            if (!componentInstances.contains(uuid))
-                delete mErcMsgListUnplacedComponentInstances.take(uuid);
+            updateErcMessageOfComponent(uuid); // removed components
         }
     }
     else
     {
         qDeleteAll(mErcMsgListUnplacedComponentInstances);
         mErcMsgListUnplacedComponentInstances.clear();
+        // the results of the last design rule check are obsolete too
+        if (mDesignRuleCheck) mDesignRuleCheck->clear();
+    }
+}
+
+void Board::updateChangedErcMessages() noexcept
+{
+    // only the components which were added to/removed from the circuit or this board
+    // since the last update need to be checked
+    if (mIsAddedToProject) {
+        foreach (const Uuid& uuid, mErcMsgChangedComponentInstances) {
+            updateErcMessageOfComponent(uuid);
+        }
+    }
+    mErcMsgChangedComponentInstances.clear();
+}
+
+void Board::updateErcMessageOfComponent(const Uuid& componentUuid) noexcept
+{
+    const ComponentInstance* component = mProject.getCircuit().getComponentInstanceByUuid(componentUuid);
+    bool unplaced = component && (!component->getLibComponent().isSchematicOnly())
+                    && (!mDeviceInstances.contains(componentUuid));
+    ErcMsg* ercMsg = mErcMsgListUnplacedComponentInstances.value(componentUuid);
+    if (unplaced && (!ercMsg))
+    {
+        ercMsg = new ErcMsg(mProject, *this, QString("%1/%2").arg(mUuid.toStr(),
+            component->getUuid().toStr()), "UnplacedComponent", ErcMsg::ErcMsgType_t::BoardError,
+            QString("Unplaced Component: %1 (Board: %2)").arg(component->getName(), mName));
+        ercMsg->setVisible(true);
+        mErcMsgListUnplacedComponentInstances.insert(componentUuid, ercMsg);
+    }
+    else if ((!unplaced) && (ercMsg))
+    {
+        delete mErcMsgListUnplacedComponentInstances.take(componentUuid);
+    }
+}
+
+void Board::scheduleErcMessagesUpdate(const Uuid& componentUuid) noexcept
+{
+    mErcMsgChangedComponentInstances.insert(componentUuid);
+    // the timer is not restarted, so bursts of changes are delayed by at most one interval
+    if (!mErcMessagesUpdateTimer.isActive()) {
+        mErcMessagesUpdateTimer.start();
+    }
+}
+
+void Board::scheduleDeviceAttributesUpdate(const Uuid& componentUuid) noexcept
+{
+    mAttributesChangedComponents.insert(componentUuid);
+    if (!mAttributesUpdateTimer.isActive()) {
+        mAttributesUpdateTimer.start();
+    }
+}
+
+void Board::updateViaGraphicsItems() noexcept
+{
+    foreach (BI_Via* via, mVias) {
+        via->boardAttributesChanged();
+    }
+}
+
+void Board::layerStackChanged() noexcept
+{
+    // the items read the layer attributes while painting, so there is no need to update
+    // their geometry (which would re-index the whole scene)
+    mGraphicsScene->invalidateCachedItems();
+    mGraphicsScene->update();
+}
+
+void Board::scheduleAttributesUpdate() noexcept
+{
+    mAllAttributesChanged = true;
+    if (!mAttributesUpdateTimer.isActive()) {
+        mAttributesUpdateTimer.start();
+    }
+}
+
+void Board::updateChangedAttributes() noexcept
+{
+    // all changes made in one event loop iteration (e.g. by one undo command) lead to
+    // only one update of each affected item, no matter how many attributes changed
+    if (mAllAttributesChanged) {
+        emit attributesChanged(); // updates all devices anyway
+    } else {
+        foreach (const Uuid& uuid, mAttributesChangedComponents) {
+            BI_Device* device = getDeviceInstanceByComponentUuid(uuid);
+            if (device) emit device->attributesChanged();
+        }
+    }
+    foreach (const Uuid& uuid, mAttributesChangedComponents) {
+        ErcMsg* ercMsg = mErcMsgListUnplacedComponentInstances.value(uuid);
+        const ComponentInstance* component = mProject.getCircuit().getComponentInstanceByUuid(uuid);
+        if (ercMsg && component) {
+            ercMsg->setMsg(QString("Unplaced Component: %1 (Board: %2)")
+                           .arg(component->getName(), mName));
+        }
     }
+    mAllAttributesChanged = false;
+    mAttributesChangedComponents.clear();
 }
 
 /*****************************************************************************************
@@ -42,8 +42,10 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class SmartXmlFile;
+class DomDocument;
 class GraphicsLayer;
 class BoardDesignRules;
+class MemoryReport;
 
 namespace project {
 
@@ -57,6 +59,12 @@ class BI_NetPoint;
 class BI_NetLine;
 class BI_Polygon;
 class BoardLayerStack;
+class BGI_NetLineBatch;
+class BoardAirWires;
+class BoardCopperPours;
+class BoardDesignRuleCheck;
+class BoardNetLineGeometry;
+class BoardNetStatistics;
 class BoardUserSettings;
 
 /*****************************************************************************************
@@ -94,6 +102,7 @@ class Board final : public QObject, public IF_AttributeProvider,
             ZValue_FootprintPadsTop,    ///< Z value for #project#BI_FootprintPad items
             ZValue_FootprintsTop,       ///< Z value for #project#BI_Footprint items
             ZValue_Vias,                ///< Z value for #project#BI_Via items
+            ZValue_AirWires,            ///< Z value for #project#BGI_AirWires items
         };
 
         // Constructors / Destructor
@@ -102,16 +111,165 @@ class Board final : public QObject, public IF_AttributeProvider,
         Board(const Board& other, const FilePath& filepath, const QString& name);
         Board(Project& project, const FilePath& filepath, bool restore, bool readOnly) :
             Board(project, filepath, restore, readOnly, false, QString()) {}
+
+        /**
+         * @brief Constructor to load a board from an already opened and parsed file
+         *
+         * @param project   The project of the board
+         * @param xmlFile   The opened board file (the board takes the ownership, even if
+         *                  the constructor throws)
+         * @param doc       The DOM document parsed from xmlFile
+         * @param restore   See SmartFile#SmartFile()
+         * @param readOnly  See SmartFile#SmartFile()
+         */
+        Board(Project& project, SmartXmlFile* xmlFile, const DomDocument& doc, bool restore,
+              bool readOnly);
         ~Board() noexcept;
 
         // Getters: General
         Project& getProject() const noexcept {return mProject;}
         const FilePath& getFilePath() const noexcept {return mFilePath;}
         const GridProperties& getGridProperties() const noexcept {return *mGridProperties;}
+        GraphicsScene& getGraphicsScene() const noexcept {return *mGraphicsScene;}
+        bool areGraphicsItemsEnabled() const noexcept {return mGraphicsItemsEnabled;}
         BoardLayerStack& getLayerStack() noexcept {return *mLayerStack;}
+        const BoardLayerStack& getLayerStack() const noexcept {return *mLayerStack;}
         BoardDesignRules& getDesignRules() noexcept {return *mDesignRules;}
         const BoardDesignRules& getDesignRules() const noexcept {return *mDesignRules;}
         bool isEmpty() const noexcept;
+        bool isAddedToProject() const noexcept {return mIsAddedToProject;}
+
+        /**
+         * @brief Get the graphics item which paints all netlines of a specific layer
+         *
+         * The item is created and added to the graphics scene on first use.
+         *
+         * @param layer     The copper layer
+         *
+         * @return The batch item of the layer (owned by the board)
+         */
+        BGI_NetLineBatch& getNetLineBatch(const GraphicsLayer& layer) noexcept;
+
+        /**
+         * @brief Defer the updates of moved netlines until #endNetLineUpdateBatch()
+         *
+         * When many items are moved at once, both ends of most netlines are moved and
+         * each of these moves rebuilds the graphics item and the net statistics of the
+         * line. Between these calls, the netlines are only collected and then updated
+         * once at the end. The calls may be nested.
+         */
+        void beginNetLineUpdateBatch() noexcept;
+
+        /**
+         * @brief Update all netlines collected since #beginNetLineUpdateBatch()
+         */
+        void endNetLineUpdateBatch() noexcept;
+
+        /**
+         * @brief Collect a netline to update while a batch is active
+         *
+         * @param netline   The netline whose geometry has changed
+         *
+         * @return True if the update is deferred, false if it has to be done right now
+         */
+        bool deferNetLineUpdate(BI_NetLine& netline) noexcept;
+
+        /**
+         * @brief Get the airwires (ratsnest) of this board
+         *
+         * @note The airwires are recalculated asynchronously, see
+         *       librepcb::project::BoardAirWires::isUpToDate()
+         */
+        BoardAirWires& getAirWires() const noexcept {return *mAirWires;}
+
+        /**
+         * @brief Mark the airwires of a net signal as outdated
+         *
+         * Called by the board items whenever their connectivity or position has changed.
+         *
+         * @param netsignal     The affected net signal (nullptr is ignored)
+         */
+        void scheduleAirWiresRebuild(const NetSignal* netsignal) noexcept;
+
+        /**
+         * @brief Get the filled areas of the copper pours of this board
+         *
+         * @note The fills are recalculated asynchronously, see
+         *       librepcb::project::BoardCopperPours::isUpToDate()
+         */
+        BoardCopperPours& getCopperPours() const noexcept {return *mCopperPours;}
+
+        /**
+         * @brief Mark the fill of a copper pour as outdated
+         *
+         * @param polygon       The polygon whose outline, layer or net signal has changed
+         */
+        void scheduleCopperPourRefill(const BI_Polygon& polygon) noexcept;
+
+        /**
+         * @brief Mark the fills of all copper pours around some copper as outdated
+         *
+         * Called by the board items before and after they were added, removed, moved or
+         * resized, so only the copper pours in the affected region are refilled.
+         *
+         * @param p1        One end of the affected copper
+         * @param p2        The other end of the affected copper (may be equal to p1)
+         * @param margin    The distance of the copper's outline from the line p1-p2
+         */
+        void scheduleCopperPourRefill(const Point& p1, const Point& p2,
+                                      const Length& margin) noexcept;
+
+        /**
+         * @brief Get the design rule check of this board (holds the last results)
+         */
+        BoardDesignRuleCheck& getDesignRuleCheck() const noexcept {return *mDesignRuleCheck;}
+
+        /**
+         * @brief Get the routed length, via count and layer usage of all net signals
+         */
+        BoardNetStatistics& getNetStatistics() const noexcept {return *mNetStatistics;}
+
+        /**
+         * @brief Update the net statistics after a netline or via has changed
+         *
+         * Called by the board items whenever they were added, removed or their length
+         * or net signal has changed.
+         */
+        void updateNetStatistics(const BI_NetLine& netline) noexcept;
+        void updateNetStatistics(const BI_Via& via) noexcept;
+
+        /**
+         * @brief Get a flat copy of the geometry of all netlines (for fast scanning)
+         */
+        const BoardNetLineGeometry& getNetLineGeometry() const noexcept {return *mNetLineGeometry;}
+
+        /**
+         * @brief Update the netline geometry arrays after a netline has changed
+         *
+         * Called by netlines whenever they were added, removed or their position or
+         * width has changed.
+         */
+        void updateNetLineGeometry(const BI_NetLine& netline) noexcept;
+
+        /**
+         * @brief Update the set of selected items after an item was (de)selected
+         *
+         * Called by the board items whenever their selection state has changed or they
+         * were added to or removed from the board (only items which are selected and
+         * added to the board are in the set). This way #getSelectedItems(),
+         * #clearSelection() and #setSelectionRect() only need to process the selected
+         * items instead of all items of the board.
+         */
+        void updateSelectedItem(BI_Base& item) noexcept;
+
+        /**
+         * @brief Get the selected items and the items attached to them
+         *
+         * Only the selected items (see #updateSelectedItem()) and the netpoints/netlines
+         * directly attached to them are processed, so the complexity does not depend on
+         * the size of the board. The footprints, vias, netpoints and netlines are
+         * returned in this order, each of them in the order they were selected.
+         */
         QList<BI_Base*> getSelectedItems(bool vias,
                                          bool footprintPads,
                                          bool floatingPoints,
@@ -132,8 +290,37 @@ class Board final : public QObject, public IF_AttributeProvider,
                                                  const NetSignal* netsignal) const noexcept;
         QList<BI_FootprintPad*> getPadsAtScenePos(const Point& pos, const GraphicsLayer* layer,
                                                   const NetSignal* netsignal) const noexcept;
+
+        /**
+         * @brief Get the nearest pad, via or netpoint to snap a trace to
+         *
+         * Only the items around the position are checked (using the spatial index of
+         * the graphics scene), so this is cheap enough to be called on mouse moves.
+         *
+         * @param pos           The position to search around
+         * @param maxDistance   The maximum distance between the position and the target
+         * @param layer         Only pads and netpoints on this layer (nullptr = all)
+         * @param netsignal     Only items of this net signal (nullptr = all)
+         * @param ignore        Items to skip (e.g. the netpoints currently being moved)
+         *
+         * @return The nearest pad, via or netpoint, or nullptr if there is none in range
+         */
+        BI_Base* getNearestSnapTarget(const Point& pos, const Length& maxDistance,
+                                      const GraphicsLayer* layer, const NetSignal* netsignal,
+                                      const QSet<const BI_Base*>& ignore) const noexcept;
         QList<BI_Base*> getAllItems() const noexcept;
 
+        /**
+         * @brief Get all items whose bounding rect intersects a rect (fast, uses the
+         *        spatial index of the graphics scene)
+         *
+         * @param sceneRectPx   The rect in scene pixel coordinates
+         *
+         * @return All candidates (may contain items which do not exactly intersect the
+         *         rect, and only items with graphics items in the scene are found)
+         */
+        QList<BI_Base*> getItemCandidatesInSceneRect(const QRectF& sceneRectPx) const noexcept;
+
         // Setters: General
         void setGridProperties(const GridProperties& grid) noexcept;
 
@@ -148,13 +335,48 @@ class Board final : public QObject, public IF_AttributeProvider,
         void addDeviceInstance(BI_Device& instance);
         void removeDeviceInstance(BI_Device& instance);
 
+        /**
+         * @brief Schedule an update of a device after its component has changed
+         *
+         * The component instances are shared by all boards of the project, so a single
+         * change (e.g. renaming a component) has to update the devices of every board.
+         * To keep editing responsive, the updates are collected and applied only once
+         * per event loop iteration, with one pass over the affected items per board.
+         *
+         * @param componentUuid     The UUID of the changed component instance
+         */
+        void scheduleDeviceAttributesUpdate(const Uuid& componentUuid) noexcept;
+
         // Via Methods
         const QList<BI_Via*>& getVias() const noexcept {return mVias;}
         BI_Via* getViaByUuid(const Uuid& uuid) const noexcept;
         void addVia(BI_Via& via);
         void removeVia(BI_Via& via);
 
+        /**
+         * @brief Add many vias at once (e.g. for via stitching)
+         *
+         * Same as calling #addVia() for every via, but the UUIDs are checked only once
+         * and the scene index and ERC updates are deferred until all vias are added (see
+         * #beginBulkUpdate()). If one of the vias cannot be added, none of them is added.
+         *
+         * @param vias  The vias to add (must not be added to the board yet)
+         *
+         * @throw Exception on error
+         */
+        void addVias(const QList<BI_Via*>& vias);
+
+        /**
+         * @brief Remove many vias at once (the counterpart of #addVias())
+         *
+         * @param vias  The vias to remove (must be added to this board)
+         *
+         * @throw Exception on error
+         */
+        void removeVias(const QList<BI_Via*>& vias);
+
         // NetPoint Methods
+        const QList<BI_NetPoint*>& getNetPoints() const noexcept {return mNetPoints;}
         BI_NetPoint* getNetPointByUuid(const Uuid& uuid) const noexcept;
         void addNetPoint(BI_NetPoint& netpoint);
         void removeNetPoint(BI_NetPoint& netpoint);
@@ -174,12 +396,49 @@ class Board final : public QObject, public IF_AttributeProvider,
         void addToProject();
         void removeFromProject();
         bool save(bool toOriginal, QStringList& errors) noexcept;
+
+        /**
+         * @brief Show the board in a view
+         *
+         * When the board is shown for the first time, its graphics items are created
+         * progressively in short time slices from the event loop, so the editor stays
+         * responsive even for huge boards. The board outlines are created first, then
+         * the copper items within the visible rect of the view, and then all other
+         * items. The BSP tree index of the scene is built only once at the end.
+         *
+         * @param view  The view to show the scene in
+         */
         void showInView(GraphicsView& view) noexcept;
+
+        /**
+         * @brief Create all graphics items which are not yet created immediately
+         *
+         * Call this before operations which need the complete scene (e.g. rendering the
+         * whole board), see #showInView().
+         */
+        void finishGraphicsScenePopulation() noexcept;
+
         void saveViewSceneRect(const QRectF& rect) noexcept {mViewRect = rect;}
         const QRectF& restoreViewSceneRect() const noexcept {return mViewRect;}
         void setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept;
         void clearSelection() const noexcept;
 
+        /**
+         * @brief Start adding/removing many items at once (e.g. in a large command group)
+         *
+         * Until the matching #endBulkUpdate() is called, the index of the graphics scene
+         * and the ERC messages of the circuit are updated only once at the end instead of
+         * after every single item. Calls can be nested. This is only worth for many items
+         * since the scene index is completely rebuilt at the end.
+         */
+        void beginBulkUpdate() noexcept;
+        void endBulkUpdate() noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of this board (items, caches and graphics) to a report
+         */
+        void addToMemoryReport(MemoryReport& parent) const noexcept;
+
         // Helper Methods
         bool getAttributeValue(const QString& attrNS, const QString& attrKey,
                                bool passToParents, QString& value) const noexcept override;
@@ -206,20 +465,56 @@ class Board final : public QObject, public IF_AttributeProvider,
     private:
 
         Board(Project& project, const FilePath& filepath, bool restore,
-              bool readOnly, bool create, const QString& newName);
+              bool readOnly, bool create, const QString& newName,
+              SmartXmlFile* xmlFile = nullptr, const DomDocument* doc = nullptr);
+        QList<BI_Base*> getItemCandidatesAtScenePos(const QPointF& scenePosPx) const noexcept;
+        void enableGraphicsItems() noexcept;
+        void startGraphicsScenePopulation(GraphicsView& view) noexcept;
+        void populateGraphicsScene() noexcept;
+        void createQueuedGraphicsItems(int maxMs) noexcept;
+        int getGraphicsItemPriority(const BI_Base& item, const QRectF& visibleRectPx) const noexcept;
+        void createPendingGraphicsItems(BI_Base& item) noexcept;
+        void createPendingGraphicsItems(BI_Device& device) noexcept;
         void updateIcon() noexcept;
         bool checkAttributesValidity() const noexcept;
         void updateErcMessages() noexcept;
+        void updateChangedErcMessages() noexcept;
+        void updateErcMessageOfComponent(const Uuid& componentUuid) noexcept;
+        void scheduleErcMessagesUpdate(const Uuid& componentUuid) noexcept;
+        void scheduleAttributesUpdate() noexcept;
+        void updateChangedAttributes() noexcept;
+        void updateViaGraphicsItems() noexcept;
+        void layerStackChanged() noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
 
+        /// @copydoc librepcb::SerializableObject::serializeToXmlStream()
+        void serializeToXmlStream(QXmlStreamWriter& writer, const QString& name) const override;
+
+        /**
+         * @brief Serialize all childs into a DomElement or a QXmlStreamWriter
+         *
+         * Used by both #serialize() and #serializeToXmlStream() to get identical output.
+         */
+        template <typename T>
+        void serializeChilds(T& root) const;
+
 
         // General
         Project& mProject; ///< A reference to the Project object (from the ctor)
         FilePath mFilePath; ///< the filepath of the schematic *.xml file (from the ctor)
         QScopedPointer<SmartXmlFile> mXmlFile;
         bool mIsAddedToProject;
+        bool mGraphicsItemsEnabled; ///< false until shown in a view (see #showInView())
+        QTimer mGraphicsScenePopulationTimer; ///< creates the pending graphics items
+        QPointer<GraphicsView> mGraphicsScenePopulationView; ///< to prioritize visible items
+        QSet<BI_Base*> mPendingGraphicsItems; ///< items without graphics items yet
+        QList<BI_Base*> mPendingGraphicsItemsQueue; ///< creation order, may contain removed items
+        QTimer mErcMessagesUpdateTimer; ///< to update the ERC messages only once after many changes
+        QTimer mAttributesUpdateTimer; ///< see #scheduleDeviceAttributesUpdate()
+        bool mAllAttributesChanged; ///< the project attributes have changed (update all items)
+        QSet<Uuid> mAttributesChangedComponents; ///< to be updated by the timer
 
         QScopedPointer<GraphicsScene> mGraphicsScene;
         QScopedPointer<BoardLayerStack> mLayerStack;
@@ -227,6 +522,10 @@ class Board final : public QObject, public IF_AttributeProvider,
         QScopedPointer<BoardDesignRules> mDesignRules;
         QScopedPointer<BoardUserSettings> mUserSettings;
         QRectF mViewRect;
+        mutable bool mSelectionRectActive; ///< see #setSelectionRect()
+        QRectF mSelectionRectPx; ///< the last rect passed to #setSelectionRect()
+        QHash<BI_Base*, quint64> mSelectedItems; ///< see #updateSelectedItem()
+        quint64 mSelectionCounter; ///< the selection order of #mSelectedItems
 
         // Attributes
         Uuid mUuid;
@@ -239,9 +538,21 @@ class Board final : public QObject, public IF_AttributeProvider,
         QList<BI_NetPoint*> mNetPoints;
         QList<BI_NetLine*> mNetLines;
         QList<BI_Polygon*> mPolygons;
+        QHash<const GraphicsLayer*, BGI_NetLineBatch*> mNetLineBatches;
+        int mNetLineUpdateBatchDepth; ///< see #beginNetLineUpdateBatch()
+        QSet<BI_NetLine*> mDeferredNetLineUpdates; ///< see #deferNetLineUpdate()
+        QScopedPointer<BoardAirWires> mAirWires;
+        QScopedPointer<BoardCopperPours> mCopperPours;
+        QScopedPointer<BoardDesignRuleCheck> mDesignRuleCheck;
+        QScopedPointer<BoardNetStatistics> mNetStatistics;
+        QScopedPointer<BoardNetLineGeometry> mNetLineGeometry;
 
         // ERC messages
         QHash<Uuid, ErcMsg*> mErcMsgListUnplacedComponentInstances;
+        QSet<Uuid> mErcMsgChangedComponentInstances; ///< to be updated by the timer
+
+        // Constants
+        static const int sGraphicsScenePopulationSliceMs = 15; ///< keeps the GUI responsive
 };
 
 /*****************************************************************************************
@@ -0,0 +1,318 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <limits>
+#include "boardairwires.h"
+#include "board.h"
+#include "boardlayerstack.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "graphicsitems/bgi_airwires.h"
+#include "../project.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentsignalinstance.h"
+#include <librepcb/common/graphics/graphicsscene.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardAirWires::BoardAirWires(Board& board) noexcept :
+    QObject(&board), mBoard(board)
+{
+    GraphicsLayer* layer = mBoard.getLayerStack().getLayer(GraphicsLayer::sBoardAirWires);
+    Q_ASSERT(layer);
+    if (layer) {
+        mGraphicsItem.reset(new BGI_AirWires(*layer));
+        mBoard.getGraphicsScene().addItem(*mGraphicsItem);
+    }
+
+    // a zero interval merges all invalidations of one event (e.g. a mouse move)
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(0);
+    connect(&mUpdateTimer, &QTimer::timeout, this, &BoardAirWires::update);
+}
+
+BoardAirWires::~BoardAirWires() noexcept
+{
+    if (mGraphicsItem) {
+        mBoard.getGraphicsScene().removeItem(*mGraphicsItem);
+    }
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QVector<BoardAirWires::AirWire> BoardAirWires::getAirWires(const NetSignal& netsignal) const noexcept
+{
+    return mAirWires.value(netsignal.getUuid());
+}
+
+int BoardAirWires::getAirWiresCount() const noexcept
+{
+    int count = 0;
+    foreach (const QVector<AirWire>& airwires, mAirWires) {
+        count += airwires.count();
+    }
+    return count;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardAirWires::invalidate(const NetSignal& netsignal) noexcept
+{
+    mDirtyNetSignals.insert(netsignal.getUuid());
+    if (!mUpdateTimer.isActive()) {
+        mUpdateTimer.start();
+    }
+}
+
+void BoardAirWires::invalidateAll() noexcept
+{
+    foreach (const Uuid& uuid, mAirWires.keys()) {
+        mDirtyNetSignals.insert(uuid);
+    }
+    foreach (const NetSignal* netsignal, mBoard.getProject().getCircuit().getNetSignals()) {
+        mDirtyNetSignals.insert(netsignal->getUuid());
+    }
+    if (!mUpdateTimer.isActive()) {
+        mUpdateTimer.start();
+    }
+}
+
+QList<BI_Base*> BoardAirWires::getConnectedItems(BI_Base& item) noexcept
+{
+    const NetSignal* netsignal = nullptr;
+    switch (item.getType()) {
+        case BI_Base::Type_t::NetLine:
+            netsignal = &static_cast<BI_NetLine&>(item).getNetSignal(); break;
+        case BI_Base::Type_t::NetPoint:
+            netsignal = &static_cast<BI_NetPoint&>(item).getNetSignal(); break;
+        case BI_Base::Type_t::Via:
+            netsignal = static_cast<BI_Via&>(item).getNetSignal(); break;
+        case BI_Base::Type_t::FootprintPad:
+            netsignal = static_cast<BI_FootprintPad&>(item).getCompSigInstNetSignal(); break;
+        default:
+            return QList<BI_Base*>();
+    }
+    if (!netsignal) {
+        return QList<BI_Base*>{&item}; // unconnected via or pad
+    }
+
+    // make sure the cached islands of this net signal are up to date
+    if (mDirtyNetSignals.remove(netsignal->getUuid())) {
+        rebuildNetSignal(netsignal->getUuid());
+    }
+    const NetIslands& netIslands = mIslands[netsignal->getUuid()];
+    int island = netIslands.islandOfItem.value(&item, -1);
+    if (island < 0) {
+        return QList<BI_Base*>{&item};
+    }
+    return netIslands.islands.at(island);
+}
+
+void BoardAirWires::update() noexcept
+{
+    mUpdateTimer.stop();
+    foreach (const Uuid& uuid, mDirtyNetSignals) {
+        rebuildNetSignal(uuid);
+    }
+    mDirtyNetSignals.clear();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardAirWires::rebuildNetSignal(const Uuid& uuid) noexcept
+{
+    // the net signal may have been removed from the circuit in the meantime
+    NetSignal* netsignal = mBoard.getProject().getCircuit().getNetSignalByUuid(uuid);
+    QVector<AirWire> airwires;
+    NetIslands islands;
+    if (netsignal) {
+        airwires = calcAirWires(*netsignal, islands);
+    }
+
+    if (islands.islands.isEmpty()) {
+        mIslands.remove(uuid);
+    } else {
+        mIslands.insert(uuid, islands);
+    }
+
+    if (airwires.isEmpty()) {
+        mAirWires.remove(uuid);
+    } else {
+        mAirWires.insert(uuid, airwires);
+    }
+
+    if (mGraphicsItem) {
+        QVector<QLineF> lines;
+        lines.reserve(airwires.count());
+        foreach (const AirWire& airwire, airwires) {
+            lines.append(QLineF(airwire.first.toPxQPointF(), airwire.second.toPxQPointF()));
+        }
+        mGraphicsItem->setAirWires(uuid, lines);
+    }
+}
+
+QVector<BoardAirWires::AirWire> BoardAirWires::calcAirWires(const NetSignal& netsignal,
+    NetIslands& islands) const noexcept
+{
+    // collect all nodes of this net signal on this board (netpoints which are attached
+    // to a pad or via share the node of that pad or via)
+    QVector<Point> positions;
+    QHash<const BI_Base*, int> indices;
+    QList<QPair<BI_Base*, int>> members; // all items with their node index
+    auto addNode = [&](BI_Base* item, const Point& pos) {
+        indices.insert(item, positions.count());
+        members.append(qMakePair(item, positions.count()));
+        positions.append(pos);
+    };
+    foreach (const ComponentSignalInstance* signal, netsignal.getComponentSignals()) {
+        foreach (BI_FootprintPad* pad, signal->getRegisteredFootprintPads()) {
+            if (&pad->getBoard() == &mBoard) addNode(pad, pad->getPosition());
+        }
+    }
+    foreach (BI_Via* via, netsignal.getBoardVias()) {
+        if (&via->getBoard() == &mBoard) addNode(via, via->getPosition());
+    }
+    foreach (BI_NetPoint* netpoint, netsignal.getBoardNetPoints()) {
+        if (&netpoint->getBoard() != &mBoard) continue;
+        const BI_Base* attached = netpoint->isAttachedToPad()
+            ? static_cast<const BI_Base*>(netpoint->getFootprintPad())
+            : static_cast<const BI_Base*>(netpoint->getVia());
+        if (attached && indices.contains(attached)) {
+            indices.insert(netpoint, indices.value(attached));
+            members.append(qMakePair(static_cast<BI_Base*>(netpoint), indices.value(attached)));
+        } else {
+            addNode(netpoint, netpoint->getPosition());
+        }
+    }
+    const int count = positions.count();
+
+    // union-find over all netlines to get the connected islands
+    QVector<int> parents(count);
+    for (int i = 0; i < count; ++i) parents[i] = i;
+    auto find = [&](int i) {
+        while (parents[i] != i) {
+            parents[i] = parents[parents[i]]; // path halving
+            i = parents[i];
+        }
+        return i;
+    };
+    foreach (const BI_NetPoint* netpoint, netsignal.getBoardNetPoints()) {
+        if (&netpoint->getBoard() != &mBoard) continue;
+        foreach (const BI_NetLine* netline, netpoint->getLines()) {
+            if (&netline->getStartPoint() != netpoint) continue; // visit every line once
+            int a = indices.value(&netline->getStartPoint(), -1);
+            int b = indices.value(&netline->getEndPoint(), -1);
+            if ((a < 0) || (b < 0)) continue; // the other netpoint is not registered
+            a = find(a);
+            b = find(b);
+            if (a != b) parents[a] = b;
+        }
+    }
+    QVector<int> roots(count);
+    for (int i = 0; i < count; ++i) roots[i] = find(i);
+
+    // cache the islands (netlines belong to the island of their start point)
+    QHash<int, int> islandOfRoot;
+    auto addMember = [&](BI_Base* item, int node) {
+        int root = roots[node];
+        if (!islandOfRoot.contains(root)) {
+            islandOfRoot.insert(root, islands.islands.count());
+            islands.islands.append(QList<BI_Base*>());
+        }
+        int island = islandOfRoot.value(root);
+        islands.islandOfItem.insert(item, island);
+        islands.islands[island].append(item);
+    };
+    for (const auto& member : members) {
+        addMember(member.first, member.second);
+    }
+    foreach (const BI_NetPoint* netpoint, netsignal.getBoardNetPoints()) {
+        if (&netpoint->getBoard() != &mBoard) continue;
+        int node = indices.value(netpoint, -1);
+        if (node < 0) continue;
+        foreach (BI_NetLine* netline, netpoint->getLines()) {
+            if (&netline->getStartPoint() == netpoint) addMember(netline, node);
+        }
+    }
+    if (count < 2) {
+        return QVector<AirWire>();
+    }
+
+    // Prim's algorithm on the complete graph, where edges within an island are free,
+    // so every tree edge between two different islands is exactly one airwire
+    QVector<AirWire> airwires;
+    QVector<qreal> distances(count, std::numeric_limits<qreal>::max());
+    QVector<int> nearest(count, -1);
+    QVector<bool> inTree(count, false);
+    int current = 0;
+    for (int added = 1; added < count; ++added) {
+        inTree[current] = true;
+        int next = -1;
+        for (int i = 0; i < count; ++i) {
+            if (inTree[i]) continue;
+            qreal distance = 0;
+            if (roots[i] != roots[current]) {
+                qreal dx = positions[i].getX().toMm() - positions[current].getX().toMm();
+                qreal dy = positions[i].getY().toMm() - positions[current].getY().toMm();
+                distance = dx * dx + dy * dy;
+            }
+            if (distance < distances[i]) {
+                distances[i] = distance;
+                nearest[i] = current;
+            }
+            if ((next < 0) || (distances[i] < distances[next])) {
+                next = i;
+            }
+        }
+        Q_ASSERT(next >= 0);
+        if (roots[next] != roots[nearest[next]]) {
+            airwires.append(AirWire(positions[nearest[next]], positions[next]));
+        }
+        current = next;
+    }
+    return airwires;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
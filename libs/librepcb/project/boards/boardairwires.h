@@ -0,0 +1,136 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDAIRWIRES_H
+#define LIBREPCB_PROJECT_BOARDAIRWIRES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Base;
+class NetSignal;
+class BGI_AirWires;
+
+/*****************************************************************************************
+ *  Class BoardAirWires
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardAirWires class calculates the airwires (ratsnest) of a board
+ *
+ * For each net signal, all footprint pads, vias and netpoints of the board are grouped
+ * into connected islands (union-find over the netlines and the pad/via attachments).
+ * Then a minimum spanning tree (Prim) over all these items connects the islands, and
+ * every edge of the tree between two different islands is an airwire.
+ *
+ * The calculation is incremental: board items call
+ * librepcb::project::Board::scheduleAirWiresRebuild() whenever they are added, removed
+ * or moved, which only marks their net signal as dirty. The dirty net signals are
+ * recalculated once when control returns to the event loop, so moving many items at
+ * once (e.g. with librepcb::project::CmdMoveSelectedBoardItems) only costs one
+ * calculation per affected net signal and mouse move event, independent of the total
+ * count of net signals on the board.
+ *
+ * The islands of every net signal are cached as well, so querying all copper items
+ * which are physically connected to a specific item (see #getConnectedItems()) does not
+ * need to walk through the netpoints and netlines again.
+ */
+class BoardAirWires final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        typedef QPair<Point, Point> AirWire;
+
+        // Constructors / Destructor
+        BoardAirWires() = delete;
+        BoardAirWires(const BoardAirWires& other) = delete;
+        explicit BoardAirWires(Board& board) noexcept;
+        ~BoardAirWires() noexcept;
+
+        // Getters
+        QVector<AirWire> getAirWires(const NetSignal& netsignal) const noexcept;
+        int getAirWiresCount() const noexcept;
+        bool isUpToDate() const noexcept {return mDirtyNetSignals.isEmpty();}
+
+        /**
+         * @brief Get all copper items which are physically connected to a specific item
+         *
+         * @param item      A netline, netpoint, via or footprint pad of the board
+         *
+         * @return All netlines, netpoints, vias and footprint pads of the copper island
+         *         the item belongs to (including the item itself)
+         */
+        QList<BI_Base*> getConnectedItems(BI_Base& item) noexcept;
+
+        // General Methods
+        void invalidate(const NetSignal& netsignal) noexcept;
+        void invalidateAll() noexcept;
+        void update() noexcept;
+
+        // Operator Overloadings
+        BoardAirWires& operator=(const BoardAirWires& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct NetIslands {
+            QHash<const BI_Base*, int> islandOfItem;
+            QVector<QList<BI_Base*>> islands;
+        };
+
+        // Private Methods
+        void rebuildNetSignal(const Uuid& uuid) noexcept;
+        QVector<AirWire> calcAirWires(const NetSignal& netsignal,
+                                      NetIslands& islands) const noexcept;
+
+
+        // General
+        Board& mBoard;
+        QScopedPointer<BGI_AirWires> mGraphicsItem;
+        QTimer mUpdateTimer; ///< to recalculate all dirty net signals at once
+
+        // Cached Attributes
+        QSet<Uuid> mDirtyNetSignals;
+        QHash<Uuid, QVector<AirWire>> mAirWires;
+        QHash<Uuid, NetIslands> mIslands;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDAIRWIRES_H
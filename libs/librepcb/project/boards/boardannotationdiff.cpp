@@ -0,0 +1,314 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardannotationdiff.h"
+#include <librepcb/common/gridproperties.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include "board.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_via.h"
+#include "../project.h"
+#include "../library/projectlibrary.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentinstance.h"
+#include "../circuit/componentsignalinstance.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+BoardAnnotationDiff::State BoardAnnotationDiff::createState(const Board& board) noexcept
+{
+    State state;
+    const Circuit& circuit = board.getProject().getCircuit();
+
+    // count how often each library device is used for a library component on the board
+    QHash<Uuid, QHash<Uuid, int>> usedDevices; // component -> (device -> count)
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+        Device d;
+        d.componentUuid = device->getComponentInstanceUuid();
+        d.libDeviceUuid = device->getLibDevice().getUuid();
+        d.libComponentUuid = device->getLibDevice().getComponentUuid();
+        state.devices.append(d);
+        usedDevices[d.libComponentUuid][d.libDeviceUuid]++;
+    }
+
+    foreach (const ComponentInstance* component, circuit.getComponentInstances()) {
+        Component c;
+        c.uuid = component->getUuid();
+        c.name = component->getName();
+        c.libComponentUuid = component->getLibComponent().getUuid();
+        c.schematicOnly = component->getLibComponent().isSchematicOnly();
+        foreach (const ComponentSignalInstance* signal, component->getSignalInstances()) {
+            NetSignal* netsignal = signal->getNetSignal();
+            c.signalNetSignals.insert(signal->getCompSignal().getUuid(),
+                                      netsignal ? netsignal->getUuid() : Uuid());
+        }
+        QHash<Uuid, int> used = usedDevices.value(c.libComponentUuid);
+        c.deviceCandidates = used.keys();
+        std::sort(c.deviceCandidates.begin(), c.deviceCandidates.end(),
+            [&used](const Uuid& a, const Uuid& b){
+                return (used.value(a) != used.value(b)) ? (used.value(a) > used.value(b)) : (a < b);
+            });
+        QList<Uuid> libraryDevices = board.getProject().getLibrary().getDevicesOfComponent(
+                                         c.libComponentUuid).keys();
+        std::sort(libraryDevices.begin(), libraryDevices.end());
+        foreach (const Uuid& uuid, libraryDevices) {
+            if (!c.deviceCandidates.contains(uuid)) {
+                c.deviceCandidates.append(uuid);
+            }
+        }
+        state.components.append(c);
+    }
+
+    foreach (const BI_NetPoint* netpoint, board.getNetPoints()) {
+        NetPoint p;
+        p.uuid = netpoint->getUuid();
+        p.netSignalUuid = netpoint->getNetSignal().getUuid();
+        if (const BI_FootprintPad* pad = netpoint->getFootprintPad()) {
+            p.padComponentUuid = pad->getFootprint().getComponentInstanceUuid();
+            if (const ComponentSignalInstance* signal = pad->getComponentSignalInstance()) {
+                p.padSignalUuid = signal->getCompSignal().getUuid();
+            }
+        }
+        if (const BI_Via* via = netpoint->getVia()) {
+            p.viaUuid = via->getUuid();
+        }
+        state.netPoints.append(p);
+    }
+
+    foreach (const BI_NetLine* netline, board.getNetLines()) {
+        state.netLines.append(NetLine{netline->getStartPoint().getUuid(),
+                                      netline->getEndPoint().getUuid()});
+    }
+
+    foreach (const BI_Via* via, board.getVias()) {
+        NetSignal* netsignal = via->getNetSignal();
+        state.vias.append(Via{via->getUuid(), netsignal ? netsignal->getUuid() : Uuid()});
+    }
+
+    foreach (const NetSignal* netsignal, circuit.getNetSignals()) {
+        state.netSignalNames.insert(netsignal->getUuid(), netsignal->getName());
+    }
+
+    // place new devices below the existing ones
+    if (!board.getDeviceInstances().isEmpty()) {
+        Length minX = board.getDeviceInstances().first()->getPosition().getX();
+        Length minY = board.getDeviceInstances().first()->getPosition().getY();
+        foreach (const BI_Device* device, board.getDeviceInstances()) {
+            minX = qMin(minX, device->getPosition().getX());
+            minY = qMin(minY, device->getPosition().getY());
+        }
+        state.placementPosition = Point(minX, minY - Length::fromMm(10));
+    }
+    state.gridInterval = board.getGridProperties().getInterval();
+    return state;
+}
+
+BoardAnnotationDiff::Result BoardAnnotationDiff::calculate(const State& state) noexcept
+{
+    Result result;
+    calculateDevices(state, result);
+    calculateNetSignals(state, result);
+    return result;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardAnnotationDiff::calculateDevices(const State& state, Result& result) noexcept
+{
+    QHash<Uuid, const Component*> components;
+    foreach (const Component& component, state.components) {
+        components.insert(component.uuid, &component);
+    }
+
+    // remove or replace existing devices
+    QSet<Uuid> devices;
+    foreach (const Device& device, state.devices) {
+        devices.insert(device.componentUuid);
+        const Component* component = components.value(device.componentUuid);
+        if ((!component) || (component->schematicOnly)) {
+            result.removedDevices.append(device.componentUuid);
+        } else if (device.libComponentUuid != component->libComponentUuid) {
+            if (component->deviceCandidates.isEmpty()) {
+                result.warnings.append(tr("No device found for the changed component "
+                                          "\"%1\".").arg(component->name));
+            } else {
+                result.replacedDevices.append(DeviceReplacement{component->uuid,
+                    component->deviceCandidates.first()});
+            }
+        }
+    }
+
+    // add missing devices in rows, sorted by name
+    QList<const Component*> missing;
+    foreach (const Component& component, state.components) {
+        if ((!component.schematicOnly) && (!devices.contains(component.uuid))) {
+            missing.append(&component);
+        }
+    }
+    std::sort(missing.begin(), missing.end(), [](const Component* a, const Component* b){
+        return QString::localeAwareCompare(a->name, b->name) < 0;
+    });
+    const int columns = 10;
+    const Length spacing = Length::fromMm(10);
+    int index = 0;
+    foreach (const Component* component, missing) {
+        if (component->deviceCandidates.isEmpty()) {
+            result.warnings.append(tr("No device found for the component \"%1\".")
+                                   .arg(component->name));
+            continue;
+        }
+        Point pos = state.placementPosition +
+                    Point(spacing * (index % columns), -spacing * (index / columns));
+        if (state.gridInterval > 0) {
+            pos = pos.mappedToGrid(state.gridInterval);
+        }
+        result.addedDevices.append(DeviceAddition{component->uuid,
+            component->deviceCandidates.first(), pos});
+        ++index;
+    }
+}
+
+void BoardAnnotationDiff::calculateNetSignals(const State& state, Result& result) noexcept
+{
+    QHash<Uuid, const Component*> components;
+    foreach (const Component& component, state.components) {
+        components.insert(component.uuid, &component);
+    }
+    QSet<Uuid> removedComponents = result.removedDevices.toSet();
+    QHash<Uuid, Uuid> viaNetSignals;
+    foreach (const Via& via, state.vias) {
+        viaNetSignals.insert(via.uuid, via.netSignalUuid);
+    }
+
+    // group all netpoints which are connected by netlines or vias (union-find)
+    QHash<Uuid, int> indices;
+    QVector<int> parents(state.netPoints.count());
+    for (int i = 0; i < state.netPoints.count(); ++i) {
+        indices.insert(state.netPoints.at(i).uuid, i);
+        parents[i] = i;
+    }
+    auto find = [&parents](int i){
+        while (parents.at(i) != i) {
+            parents[i] = parents.at(parents.at(i)); // path halving
+            i = parents.at(i);
+        }
+        return i;
+    };
+    auto unite = [&](int a, int b){parents[find(a)] = find(b);};
+    foreach (const NetLine& netline, state.netLines) {
+        int start = indices.value(netline.startPointUuid, -1);
+        int end = indices.value(netline.endPointUuid, -1);
+        if ((start >= 0) && (end >= 0)) {
+            unite(start, end);
+        }
+    }
+    QHash<Uuid, int> viaNetPoints;
+    for (int i = 0; i < state.netPoints.count(); ++i) {
+        const Uuid& via = state.netPoints.at(i).viaUuid;
+        if (via.isNull()) continue;
+        if (viaNetPoints.contains(via)) {
+            unite(i, viaNetPoints.value(via));
+        } else {
+            viaNetPoints.insert(via, i);
+        }
+    }
+    QMap<int, QList<int>> groups; // sorted to get deterministic results
+    for (int i = 0; i < state.netPoints.count(); ++i) {
+        groups[find(i)].append(i);
+    }
+
+    // determine the net signal of each group by its pads
+    foreach (const QList<int>& group, groups) {
+        QSet<Uuid> netsignals;
+        bool unconnectedPads = false;
+        foreach (int i, group) {
+            const NetPoint& netpoint = state.netPoints.at(i);
+            if (netpoint.padComponentUuid.isNull()) continue;
+            if (removedComponents.contains(netpoint.padComponentUuid)) continue;
+            const Component* component = components.value(netpoint.padComponentUuid);
+            Uuid netsignal = component ?
+                component->signalNetSignals.value(netpoint.padSignalUuid) : Uuid();
+            if (netsignal.isNull()) {
+                unconnectedPads = true;
+            } else {
+                netsignals.insert(netsignal);
+            }
+        }
+        if (netsignals.count() > 1) {
+            QStringList names;
+            foreach (const Uuid& uuid, netsignals) {
+                names.append(getNetSignalName(state, uuid));
+            }
+            names.sort();
+            result.warnings.append(tr("Traces connect pads of different net signals: %1")
+                                   .arg(names.join(", ")));
+        } else if ((netsignals.count() == 1) && unconnectedPads) {
+            result.warnings.append(tr("Traces of the net signal \"%1\" are connected to "
+                "unconnected pads.").arg(getNetSignalName(state, *netsignals.begin())));
+        } else if (netsignals.count() == 1) {
+            const Uuid& netsignal = *netsignals.begin();
+            QSet<Uuid> vias;
+            foreach (int i, group) {
+                const NetPoint& netpoint = state.netPoints.at(i);
+                if (netpoint.netSignalUuid != netsignal) {
+                    result.netPointChanges.append(NetSignalChange{netpoint.uuid, netsignal});
+                }
+                if ((!netpoint.viaUuid.isNull()) && (!vias.contains(netpoint.viaUuid))) {
+                    vias.insert(netpoint.viaUuid);
+                    const Uuid& viaNetSignal = viaNetSignals.value(netpoint.viaUuid);
+                    if ((!viaNetSignal.isNull()) && (viaNetSignal != netsignal)) {
+                        result.viaChanges.append(NetSignalChange{netpoint.viaUuid, netsignal});
+                    }
+                }
+            }
+        }
+    }
+}
+
+QString BoardAnnotationDiff::getNetSignalName(const State& state, const Uuid& uuid) noexcept
+{
+    return state.netSignalNames.value(uuid, uuid.toStr());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,202 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDANNOTATIONDIFF_H
+#define LIBREPCB_PROJECT_BOARDANNOTATIONDIFF_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+/*****************************************************************************************
+ *  Class BoardAnnotationDiff
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardAnnotationDiff class calculates the board operations required to
+ *        bring a board in sync with the circuit (forward annotation)
+ *
+ * The calculation is split into two steps:
+ *
+ *  1. #createState() copies everything needed from the circuit and the board into a
+ *     plain #State object. This must be done in the main thread, but is cheap.
+ *  2. #calculate() compares the circuit with the board and returns the minimal set of
+ *     operations as a #Result. It only works on the #State, so it can be run in a
+ *     worker thread while the user keeps editing the project.
+ *
+ * The result contains devices to add, remove or replace (if the library component of
+ * a component instance was changed) and netpoints/vias to move to another net signal
+ * (if the net signals of the connected pads were changed). Traces connecting pads of
+ * different net signals are not modified, but reported as warnings. The result can be
+ * applied with librepcb::project::editor::CmdApplyBoardAnnotationDiff.
+ */
+class BoardAnnotationDiff final
+{
+        Q_DECLARE_TR_FUNCTIONS(BoardAnnotationDiff)
+
+    public:
+
+        // Types
+
+        /// A component instance of the circuit
+        struct Component {
+            Uuid uuid;
+            QString name;
+            Uuid libComponentUuid;
+            bool schematicOnly;
+            QHash<Uuid, Uuid> signalNetSignals; ///< component signal -> net (null = none)
+            QList<Uuid> deviceCandidates;       ///< compatible devices, preferred first
+        };
+
+        /// A device instance of the board
+        struct Device {
+            Uuid componentUuid;
+            Uuid libDeviceUuid;
+            Uuid libComponentUuid;  ///< the component of the library device
+        };
+
+        /// A netpoint of the board
+        struct NetPoint {
+            Uuid uuid;
+            Uuid netSignalUuid;
+            Uuid padComponentUuid;  ///< component of the attached pad (null if none)
+            Uuid padSignalUuid;     ///< component signal of the attached pad (may be null)
+            Uuid viaUuid;           ///< attached via (null if none)
+        };
+
+        /// A netline of the board
+        struct NetLine {
+            Uuid startPointUuid;
+            Uuid endPointUuid;
+        };
+
+        /// A via of the board
+        struct Via {
+            Uuid uuid;
+            Uuid netSignalUuid;     ///< null if the via is not connected to a net
+        };
+
+        /// Everything #calculate() needs to know about the circuit and the board
+        struct State {
+            QList<Component> components;
+            QList<Device> devices;
+            QList<NetPoint> netPoints;
+            QList<NetLine> netLines;
+            QList<Via> vias;
+            QHash<Uuid, QString> netSignalNames;
+            Point placementPosition;    ///< where to place the first added device
+            Length gridInterval;
+        };
+
+        struct DeviceAddition {
+            Uuid componentUuid;
+            Uuid libDeviceUuid;
+            Point position;
+        };
+
+        struct DeviceReplacement {
+            Uuid componentUuid;
+            Uuid libDeviceUuid;     ///< the new library device
+        };
+
+        struct NetSignalChange {
+            Uuid itemUuid;          ///< netpoint or via
+            Uuid netSignalUuid;     ///< the new net signal
+        };
+
+        /// The operations to apply to the board
+        struct Result {
+            QList<DeviceAddition> addedDevices;
+            QList<Uuid> removedDevices;         ///< component UUIDs of the devices
+            QList<DeviceReplacement> replacedDevices;
+            QList<NetSignalChange> netPointChanges;
+            QList<NetSignalChange> viaChanges;
+            QStringList warnings;               ///< conflicts which need manual work
+
+            bool isEmpty() const noexcept {
+                return addedDevices.isEmpty() && removedDevices.isEmpty() &&
+                       replacedDevices.isEmpty() && netPointChanges.isEmpty() &&
+                       viaChanges.isEmpty();
+            }
+        };
+
+
+        // Constructors / Destructor
+        BoardAnnotationDiff() = delete;
+        BoardAnnotationDiff(const BoardAnnotationDiff& other) = delete;
+        ~BoardAnnotationDiff() = delete;
+
+
+        // General Methods
+
+        /**
+         * @brief Copy the current state of the circuit and a board
+         *
+         * The device candidates of each component contain the devices already used for
+         * the same library component on the board first, followed by the other devices
+         * of the project library. Callers may append more candidates (e.g. from the
+         * workspace library) before passing the state to #calculate().
+         *
+         * @param board     The board to compare with the circuit
+         *
+         * @return The state (does not reference any project object)
+         */
+        static State createState(const Board& board) noexcept;
+
+        /**
+         * @brief Calculate the operations to bring the board in sync with the circuit
+         *
+         * @note This method is thread-safe.
+         *
+         * @param state     See #createState()
+         *
+         * @return The operations to apply
+         */
+        static Result calculate(const State& state) noexcept;
+
+
+        // Operator Overloadings
+        BoardAnnotationDiff& operator=(const BoardAnnotationDiff& rhs) = delete;
+
+
+    private: // Methods
+        static void calculateDevices(const State& state, Result& result) noexcept;
+        static void calculateNetSignals(const State& state, Result& result) noexcept;
+        static QString getNetSignalName(const State& state, const Uuid& uuid) noexcept;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDANNOTATIONDIFF_H
@@ -0,0 +1,406 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include <limits>
+#include "boardcopperpours.h"
+#include "board.h"
+#include "boarditemgeometry.h"
+#include "boardlayerstack.h"
+#include "boardnetlinegeometry.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_polygon.h"
+#include "../circuit/netsignal.h"
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/polygonclipper.h>
+#include <librepcb/common/memoryreport.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Struct BoardCopperPours::Job
+ ****************************************************************************************/
+
+/**
+ * @brief All input data to fill one copper pour, and its result
+ *
+ * Contains only copies, so it can be processed in a worker thread.
+ */
+struct BoardCopperPours::Job {
+    const BI_Polygon* polygon;                  ///< only used as key, never dereferenced
+    quint64 revision;
+    PolygonClipper::Path area;                  ///< the outline of the pour
+    QVector<BoardItemGeometry> obstacles;       ///< only those near the pour
+    Length clearance;
+    Fill result;
+};
+
+/*****************************************************************************************
+ *  Geometry Helpers
+ ****************************************************************************************/
+
+/// Maximum deviation of the polygonal approximation of arcs in the pour outlines
+static const Length sArcTolerance(5000);
+
+static QRectF calcBounds(const QVector<Point>& points, const Length& radius) noexcept
+{
+    qreal left = std::numeric_limits<qreal>::max(), right = -left;
+    qreal bottom = left, top = -left;
+    for (const Point& p : points) {
+        left = qMin(left, qreal(p.getX().toNm()));      right = qMax(right, qreal(p.getX().toNm()));
+        bottom = qMin(bottom, qreal(p.getY().toNm()));  top = qMax(top, qreal(p.getY().toNm()));
+    }
+    qreal r = radius.toNm();
+    return QRectF(QPointF(left, bottom), QPointF(right, top)).adjusted(-r, -r, r, r);
+}
+
+/**
+ * @brief Check if a point is inside of an outline (crossing number test)
+ */
+static bool containsPoint(const PolygonClipper::Path& path, const Point& point) noexcept
+{
+    bool inside = false;
+    const qreal x = point.getX().toNm(), y = point.getY().toNm();
+    for (int i = 0, j = path.count() - 1; i < path.count(); j = i++) {
+        const qreal xi = path.at(i).getX().toNm(), yi = path.at(i).getY().toNm();
+        const qreal xj = path.at(j).getX().toNm(), yj = path.at(j).getY().toNm();
+        if (((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi) + xi)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+/*****************************************************************************************
+ *  Class BoardCopperPours::Filler
+ ****************************************************************************************/
+
+/**
+ * @brief Fills a single copper pour in a worker thread
+ */
+class BoardCopperPours::Filler final : public QRunnable
+{
+    public:
+        Filler(BoardCopperPours& pours, const std::shared_ptr<Job>& job) noexcept :
+            mPours(pours), mJob(job)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            // all obstacle outlines are counter-clockwise, so the non-zero winding rule
+            // unites them without an extra boolean operation
+            PolygonClipper::Paths obstacles;
+            obstacles.reserve(mJob->obstacles.count());
+            for (const BoardItemGeometry& obstacle : mJob->obstacles) {
+                const PolygonClipper::Path& outline = obstacle.getOutline(mJob->clearance,
+                                                                          sArcTolerance);
+                if (outline.count() >= 3) {
+                    obstacles.append(outline);
+                }
+            }
+            PolygonClipper::Paths copper = PolygonClipper::subtract({mJob->area}, obstacles);
+
+            // determine the nesting level of all contours and close them
+            for (const PolygonClipper::Path& path : copper) {
+                if (path.count() < 3) continue; // degenerated
+                Contour contour;
+                contour.points = path;
+                contour.points.append(path.first());
+                contour.depth = 0;
+                for (const PolygonClipper::Path& other : copper) {
+                    if ((&other != &path) && containsPoint(other, path.first())) {
+                        ++contour.depth;
+                    }
+                }
+                mJob->result.append(contour);
+            }
+            std::stable_sort(mJob->result.begin(), mJob->result.end(),
+                [](const Contour& a, const Contour& b){return a.depth < b.depth;});
+
+            QMutexLocker locker(&mPours.mFinishedJobsMutex);
+            mPours.mFinishedJobs.append(mJob);
+            locker.unlock();
+            emit mPours.jobFinished();
+        }
+
+    private:
+        BoardCopperPours& mPours;
+        std::shared_ptr<Job> mJob;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardCopperPours::BoardCopperPours(Board& board) noexcept :
+    QObject(&board), mBoard(board), mNextRevision(0)
+{
+    mThreadPool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+    connect(this, &BoardCopperPours::jobFinished,
+            this, &BoardCopperPours::applyFinishedJobs, Qt::QueuedConnection);
+
+    // a zero interval merges all invalidations of one event (e.g. a mouse move)
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(0);
+    connect(&mUpdateTimer, &QTimer::timeout, this, &BoardCopperPours::startJobs);
+}
+
+BoardCopperPours::~BoardCopperPours() noexcept
+{
+    mThreadPool.clear(); // remove all jobs which are not yet started
+    mThreadPool.waitForDone();
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+BoardCopperPours::Fill BoardCopperPours::getFill(const BI_Polygon& polygon) const noexcept
+{
+    return mFills.value(&polygon).fill;
+}
+
+QPainterPath BoardCopperPours::getFillPx(const BI_Polygon& polygon) const noexcept
+{
+    return mFills.value(&polygon).pathPx;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardCopperPours::invalidate(const BI_Polygon& polygon) noexcept
+{
+    mBounds.remove(&polygon); // the outline might have changed
+    mDirtyPolygons.insert(&polygon);
+    scheduleUpdate();
+}
+
+void BoardCopperPours::invalidateArea(const Point& p1, const Point& p2,
+                                      const Length& margin) noexcept
+{
+    // the affected area must be grown by the clearance of the pours
+    QRectF area = calcBounds({p1, p2}, margin + mBoard.getDesignRules().getMinCopperClearance());
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        if ((!polygon->isCopperPour()) || mDirtyPolygons.contains(polygon)) continue;
+        if (getBounds(*polygon).intersects(area)) {
+            mDirtyPolygons.insert(polygon);
+            scheduleUpdate();
+        }
+    }
+}
+
+void BoardCopperPours::invalidateAll() noexcept
+{
+    mBounds.clear();
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        mDirtyPolygons.insert(polygon);
+    }
+    foreach (const BI_Polygon* polygon, mFills.keys()) {
+        mDirtyPolygons.insert(polygon); // maybe removed from the board in the meantime
+    }
+    scheduleUpdate();
+}
+
+void BoardCopperPours::addToMemoryReport(MemoryReport& parent) const noexcept
+{
+    qint64 bytes = 0;
+    foreach (const CachedFill& cached, mFills) {
+        bytes += sizeof(CachedFill)
+               + cached.pathPx.elementCount() * sizeof(QPainterPath::Element);
+        foreach (const Contour& contour, cached.fill) {
+            bytes += sizeof(Contour) + contour.points.capacity() * sizeof(Point);
+        }
+    }
+    parent.addChild("Copper pour fills", bytes, mFills.count());
+}
+
+void BoardCopperPours::update() noexcept
+{
+    startJobs();
+    mThreadPool.waitForDone();
+    applyFinishedJobs();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+std::shared_ptr<BoardCopperPours::Job> BoardCopperPours::createJob(const BI_Polygon& polygon) noexcept
+{
+    const QString& layerName = polygon.getPolygon().getLayerName();
+    const NetSignal* netsignal = polygon.getNetSignal();
+
+    std::shared_ptr<Job> job(new Job());
+    job->polygon = &polygon;
+    job->revision = mNextRevision++;
+    job->area = PolygonClipper::fromPolygon(polygon.getPolygon(), sArcTolerance);
+    job->clearance = mBoard.getDesignRules().getMinCopperClearance();
+    QRectF area = getBounds(polygon).adjusted(-job->clearance.toNm(), -job->clearance.toNm(),
+                                              job->clearance.toNm(), job->clearance.toNm());
+    auto addObstacle = [&](const BoardItemGeometry& geometry) {
+        if ((!geometry.isEmpty())
+            && calcBounds(geometry.getPoints(), geometry.getRadius()).intersects(area)) {
+            job->obstacles.append(geometry); // copy, the cached outline is not thread safe
+        }
+    };
+
+    // traces of other net signals (scanned in the flat geometry arrays of the board)
+    const BoardNetLineGeometry& netlines = mBoard.getNetLineGeometry();
+    const GraphicsLayer* layer = mBoard.getLayerStack().getLayer(layerName);
+    for (int i = 0; i < netlines.getCount(); ++i) {
+        if ((netlines.getLayers().at(i) != layer)
+            || (netlines.getNetSignals().at(i) == netsignal)) {
+            continue;
+        }
+        addObstacle(BoardItemGeometry::line(
+            Point(Length(netlines.getX1().at(i)), Length(netlines.getY1().at(i))),
+            Point(Length(netlines.getX2().at(i)), Length(netlines.getY2().at(i))),
+            Length(netlines.getWidths().at(i))));
+    }
+
+    // vias of other net signals (vias are on all copper layers)
+    foreach (const BI_Via* via, mBoard.getVias()) {
+        if (via->getNetSignal() && (via->getNetSignal() == netsignal)) continue;
+        addObstacle(via->getGeometry());
+    }
+
+    // pads of other net signals
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            if ((!pad->isOnLayer(layerName))
+                || (pad->getCompSigInstNetSignal() && (pad->getCompSigInstNetSignal() == netsignal))) {
+                continue;
+            }
+            addObstacle(pad->getGeometry());
+        }
+    }
+    return job;
+}
+
+QRectF BoardCopperPours::getBounds(const BI_Polygon& polygon) noexcept
+{
+    auto it = mBounds.find(&polygon);
+    if (it == mBounds.end()) {
+        // toFlattenedPoints() is cached by the polygon
+        it = mBounds.insert(&polygon, calcBounds(
+            polygon.getPolygon().toFlattenedPoints(sArcTolerance), Length(0)));
+    }
+    return it.value();
+}
+
+void BoardCopperPours::scheduleUpdate() noexcept
+{
+    if (!mUpdateTimer.isActive()) {
+        mUpdateTimer.start();
+    }
+}
+
+void BoardCopperPours::startJobs() noexcept
+{
+    mUpdateTimer.stop();
+    if (mDirtyPolygons.isEmpty()) {
+        return;
+    }
+
+    // start a job for every dirty pour (polygons which are no longer a copper pour or
+    // which were removed from the board just lose their fill)
+    QList<BI_Polygon*> changedPolygons;
+    foreach (BI_Polygon* polygon, mBoard.getPolygons()) {
+        if (!mDirtyPolygons.remove(polygon)) continue;
+        if (polygon->isCopperPour() && polygon->isAddedToBoard()) {
+            std::shared_ptr<Job> job = createJob(*polygon);
+            mPendingRevisions.insert(polygon, job->revision); // outdates running jobs
+            mThreadPool.start(new Filler(*this, job));
+        } else {
+            mPendingRevisions.remove(polygon);
+            if (mFills.remove(polygon) > 0) {
+                changedPolygons.append(polygon);
+            }
+        }
+    }
+    foreach (const BI_Polygon* polygon, mDirtyPolygons) {
+        mPendingRevisions.remove(polygon);
+        mFills.remove(polygon);
+        mBounds.remove(polygon);
+    }
+    mDirtyPolygons.clear();
+    foreach (BI_Polygon* polygon, changedPolygons) {
+        polygon->updateCopperPourFill();
+    }
+}
+
+void BoardCopperPours::applyFinishedJobs() noexcept
+{
+    QMutexLocker locker(&mFinishedJobsMutex);
+    QList<std::shared_ptr<Job>> jobs = mFinishedJobs;
+    mFinishedJobs.clear();
+    locker.unlock();
+
+    foreach (const std::shared_ptr<Job>& job, jobs) {
+        // discard results of jobs which were outdated by a later refill of the same pour,
+        // or whose pour was removed in the meantime
+        auto it = mPendingRevisions.find(job->polygon);
+        if ((it == mPendingRevisions.end()) || (it.value() != job->revision)) continue;
+        mPendingRevisions.erase(it);
+
+        CachedFill cache;
+        cache.fill = job->result;
+        cache.pathPx.setFillRule(Qt::OddEvenFill);
+        foreach (const Contour& contour, job->result) {
+            QPolygonF polygon;
+            polygon.reserve(contour.points.count());
+            foreach (const Point& point, contour.points) {
+                polygon.append(point.toPxQPointF());
+            }
+            cache.pathPx.addPolygon(polygon);
+        }
+        mFills.insert(job->polygon, cache);
+        foreach (BI_Polygon* polygon, mBoard.getPolygons()) {
+            if (polygon == job->polygon) {
+                polygon->updateCopperPourFill();
+                break;
+            }
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
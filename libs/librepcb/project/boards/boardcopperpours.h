@@ -0,0 +1,167 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDCOPPERPOURS_H
+#define LIBREPCB_PROJECT_BOARDCOPPERPOURS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <memory>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class MemoryReport;
+
+namespace project {
+
+class Board;
+class BI_Polygon;
+
+/*****************************************************************************************
+ *  Class BoardCopperPours
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardCopperPours class calculates the filled areas of all copper pours
+ *
+ * A copper pour is a closed librepcb::project::BI_Polygon on a copper layer which is
+ * assigned to a net signal (see librepcb::project::BI_Polygon::isCopperPour()). Its fill
+ * is the area inside the polygon minus all copper of other net signals on the same
+ * layer, grown by the minimum copper clearance of the board's design rules. Copper of
+ * the pour's own net signal is connected directly (no thermal reliefs).
+ *
+ * The fills are cached per polygon. Board items call
+ * librepcb::project::Board::scheduleCopperPourRefill() before and after they change,
+ * which only marks the pours whose (cached) bounding rect overlaps the changed copper as
+ * dirty. When control returns to the event loop, the input data of all dirty pours is
+ * copied and the pours are filled concurrently in a thread pool, without blocking the
+ * GUI. The old fill of a pour is shown until its new fill is available, and results
+ * which are outdated by a later refill of the same pour are discarded. Exports which
+ * need the current fills call #update(), which waits for all pending refills.
+ *
+ * All geometry is calculated with librepcb::PolygonClipper on integer nanometer
+ * coordinates, so the rendering and the Gerber export use exactly the same fill.
+ */
+class BoardCopperPours final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+
+        /// A closed outline of a fill (the first and the last point are equal)
+        struct Contour {
+            QVector<Point> points;
+            int depth;  ///< nesting level: even = copper, odd = hole
+        };
+
+        /// All contours of a fill, sorted by their depth (outer contours first)
+        typedef QVector<Contour> Fill;
+
+        // Constructors / Destructor
+        BoardCopperPours() = delete;
+        BoardCopperPours(const BoardCopperPours& other) = delete;
+        explicit BoardCopperPours(Board& board) noexcept;
+        ~BoardCopperPours() noexcept;
+
+        // Getters
+        Fill getFill(const BI_Polygon& polygon) const noexcept;
+        QPainterPath getFillPx(const BI_Polygon& polygon) const noexcept;
+        bool isUpToDate() const noexcept {
+            return mDirtyPolygons.isEmpty() && mPendingRevisions.isEmpty();
+        }
+
+        // General Methods
+        void invalidate(const BI_Polygon& polygon) noexcept;
+        void invalidateArea(const Point& p1, const Point& p2, const Length& margin) noexcept;
+        void invalidateAll() noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of the cached fills to a report
+         */
+        void addToMemoryReport(MemoryReport& parent) const noexcept;
+
+        /**
+         * @brief Refill all dirty copper pours (blocks until all of them are filled)
+         *
+         * Only needed if the current fills are required immediately (e.g. for exports),
+         * otherwise the fills are updated asynchronously.
+         */
+        void update() noexcept;
+
+        // Operator Overloadings
+        BoardCopperPours& operator=(const BoardCopperPours& rhs) = delete;
+
+
+    signals:
+
+        /// Emitted from the worker thread when a job is finished (internal use only)
+        void jobFinished();
+
+
+    private:
+
+        // Types
+        struct Job;
+        class Filler;
+        struct CachedFill {
+            Fill fill;
+            QPainterPath pathPx;
+        };
+
+        // Private Methods
+        std::shared_ptr<Job> createJob(const BI_Polygon& polygon) noexcept;
+        QRectF getBounds(const BI_Polygon& polygon) noexcept;
+        void scheduleUpdate() noexcept;
+        void startJobs() noexcept;
+        void applyFinishedJobs() noexcept;
+
+
+        // General
+        Board& mBoard;
+        QTimer mUpdateTimer; ///< to refill all dirty copper pours at once
+        QThreadPool mThreadPool;
+        quint64 mNextRevision;
+        QHash<const BI_Polygon*, quint64> mPendingRevisions; ///< value: revision of the last started job
+        QMutex mFinishedJobsMutex;
+        QList<std::shared_ptr<Job>> mFinishedJobs; ///< protected by #mFinishedJobsMutex
+
+        // Cached Attributes
+        QSet<const BI_Polygon*> mDirtyPolygons;
+        QHash<const BI_Polygon*, CachedFill> mFills;
+        QHash<const BI_Polygon*, QRectF> mBounds; ///< in nanometers
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDCOPPERPOURS_H
@@ -0,0 +1,626 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <limits>
+#include "boarddesignrulecheck.h"
+#include "board.h"
+#include "boardairwires.h"
+#include "boardlayerstack.h"
+#include "boardnetlinegeometry.h"
+#include "boardruletable.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "../project.h"
+#include "../erc/ercmsg.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentinstance.h"
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprintpad.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Struct BoardDesignRuleCheck::CopperShape
+ ****************************************************************************************/
+
+/**
+ * @brief A thread safe copy of the copper area of a single board item on one layer
+ *
+ * The area is the convex polygon #points (1 point = circle, 2 points = capsule) grown by
+ * #radius. All coordinates are in nanometers.
+ */
+struct BoardDesignRuleCheck::CopperShape {
+    QVector<QPointF> points;
+    qreal radius;
+    QRectF bounds;      ///< bounding rect including the radius
+    QString netKey;     ///< shapes with the same (non-empty) key are allowed to touch
+    int netClassId;     ///< see librepcb::project::BoardRuleTable
+    QString itemKey;    ///< stable identifier of the board item
+    QString name;       ///< human readable name of the board item
+};
+
+/*****************************************************************************************
+ *  Struct BoardDesignRuleCheck::Tiling
+ ****************************************************************************************/
+
+/**
+ * @brief A uniform grid of #count x #count tiles over the area of one layer
+ *
+ * Positions outside of the area belong to the nearest tile on the border.
+ */
+struct BoardDesignRuleCheck::Tiling {
+    QRectF area;
+    int count;
+    qreal width;
+    qreal height;
+
+    int getTileAt(const QPointF& pos) const noexcept {
+        int x = qBound(0, int((pos.x() - area.left()) / width), count - 1);
+        int y = qBound(0, int((pos.y() - area.top()) / height), count - 1);
+        return y * count + x;
+    }
+};
+
+/*****************************************************************************************
+ *  Geometry Helpers
+ ****************************************************************************************/
+
+static qreal cross(const QPointF& o, const QPointF& a, const QPointF& b) noexcept
+{
+    return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
+
+static qreal pointToSegmentDistance(const QPointF& p, const QPointF& a, const QPointF& b) noexcept
+{
+    QPointF ab = b - a;
+    qreal len2 = QPointF::dotProduct(ab, ab);
+    qreal t = (len2 > 0) ? qBound(qreal(0), QPointF::dotProduct(p - a, ab) / len2, qreal(1)) : 0;
+    QPointF d = p - (a + t * ab);
+    return qSqrt(QPointF::dotProduct(d, d));
+}
+
+static bool segmentsIntersect(const QPointF& a, const QPointF& b,
+                              const QPointF& c, const QPointF& d) noexcept
+{
+    qreal d1 = cross(c, d, a);
+    qreal d2 = cross(c, d, b);
+    qreal d3 = cross(a, b, c);
+    qreal d4 = cross(a, b, d);
+    return (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+            ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)));
+}
+
+static qreal segmentToSegmentDistance(const QPointF& a, const QPointF& b,
+                                      const QPointF& c, const QPointF& d) noexcept
+{
+    if (segmentsIntersect(a, b, c, d)) {
+        return 0;
+    }
+    return qMin(qMin(pointToSegmentDistance(a, c, d), pointToSegmentDistance(b, c, d)),
+                qMin(pointToSegmentDistance(c, a, b), pointToSegmentDistance(d, a, b)));
+}
+
+static bool polygonContains(const QVector<QPointF>& polygon, const QPointF& p) noexcept
+{
+    if (polygon.count() < 3) {
+        return false;
+    }
+    bool positive = false, negative = false;
+    for (int i = 0; i < polygon.count(); ++i) {
+        qreal c = cross(polygon.at(i), polygon.at((i + 1) % polygon.count()), p);
+        if (c > 0) positive = true;
+        if (c < 0) negative = true;
+    }
+    return !(positive && negative);
+}
+
+/**
+ * @brief Get the distance between the outlines of two copper shapes (0 if they overlap)
+ */
+static qreal shapeDistance(const QVector<QPointF>& a, qreal ra,
+                           const QVector<QPointF>& b, qreal rb) noexcept
+{
+    if (polygonContains(a, b.first()) || polygonContains(b, a.first())) {
+        return 0;
+    }
+    qreal distance = std::numeric_limits<qreal>::max();
+    int edgesA = (a.count() > 2) ? a.count() : 1;
+    int edgesB = (b.count() > 2) ? b.count() : 1;
+    for (int i = 0; i < edgesA; ++i) {
+        const QPointF& a1 = a.at(i);
+        const QPointF& a2 = a.at((i + 1) % a.count());
+        for (int k = 0; k < edgesB; ++k) {
+            const QPointF& b1 = b.at(k);
+            const QPointF& b2 = b.at((k + 1) % b.count());
+            distance = qMin(distance, segmentToSegmentDistance(a1, a2, b1, b2));
+        }
+    }
+    return qMax(qreal(0), distance - ra - rb);
+}
+
+static QPointF toNmPoint(const Point& p) noexcept
+{
+    return QPointF(p.getX().toNm(), p.getY().toNm());
+}
+
+static Point fromNmPoint(const QPointF& p) noexcept
+{
+    return Point(Length(qRound64(p.x())), Length(qRound64(p.y())));
+}
+
+static QVector<QPointF> toNmPoints(const QVector<Point>& points) noexcept
+{
+    QVector<QPointF> result;
+    result.reserve(points.count());
+    for (const Point& p : points) {
+        result.append(toNmPoint(p));
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  Class BoardDesignRuleCheck::TileChecker
+ ****************************************************************************************/
+
+/**
+ * @brief Checks the clearances between all shapes of a single tile in a worker thread
+ *
+ * Shapes which overlap several tiles are contained in all of them, so a pair of shapes
+ * is only reported by the tile which contains the top left corner of their (grown)
+ * bounding rect intersection.
+ */
+class BoardDesignRuleCheck::TileChecker final : public QRunnable
+{
+    public:
+        TileChecker(const QVector<CopperShape>& shapes, const Tiling& tiling, int tile,
+                    const QVector<int>& indices, const BoardRuleTable& rules,
+                    QList<QPair<int, int>>& result) noexcept :
+            mShapes(shapes), mTiling(tiling), mTile(tile), mIndices(indices),
+            mRules(rules), mResult(result)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            qreal margin = mRules.getMaxClearance().toNm() / 2;
+            for (int i = 0; i < mIndices.count(); ++i) {
+                const CopperShape& a = mShapes.at(mIndices.at(i));
+                QRectF boundsA = a.bounds.adjusted(-margin, -margin, margin, margin);
+                for (int k = i + 1; k < mIndices.count(); ++k) {
+                    const CopperShape& b = mShapes.at(mIndices.at(k));
+                    QRectF boundsB = b.bounds.adjusted(-margin, -margin, margin, margin);
+                    if (!boundsA.intersects(boundsB)) continue;
+                    if (mTiling.getTileAt((boundsA & boundsB).topLeft()) != mTile) {
+                        continue; // reported by another tile
+                    }
+                    qreal clearance = mRules.getClearance(a.netClassId, b.netClassId).toNm();
+                    if (isClearanceViolated(a, b, clearance)) {
+                        mResult.append(qMakePair(mIndices.at(i), mIndices.at(k)));
+                    }
+                }
+            }
+        }
+
+    private:
+        const QVector<CopperShape>& mShapes;
+        const Tiling& mTiling;
+        int mTile;
+        QVector<int> mIndices;
+        const BoardRuleTable& mRules;
+        QList<QPair<int, int>>& mResult;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardDesignRuleCheck::BoardDesignRuleCheck(Board& board) noexcept :
+    QObject(&board), mBoard(board)
+{
+}
+
+BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept
+{
+    clear();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardDesignRuleCheck::execute() noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+    checkMinWidth();
+    checkAnnularRings();
+    checkClearances();
+    checkUnconnected();
+    updateErcMessages();
+
+    qDebug() << "Design rule check of board" << mBoard.getName() << "found"
+             << mViolations.count() << "violations in" << timer.elapsed() << "ms.";
+}
+
+void BoardDesignRuleCheck::clear() noexcept
+{
+    qDeleteAll(mErcMsgs);
+    mErcMsgs.clear();
+    mViolations.clear();
+}
+
+QList<BoardDesignRuleCheck::Violation> BoardDesignRuleCheck::checkClearances(
+        const QList<const BI_NetLine*>& netlines) const noexcept
+{
+    QList<Violation> violations;
+    BoardRuleTable rules(mBoard);
+    const qreal maxClearance = rules.getMaxClearance().toNm();
+    if (maxClearance <= 0) {
+        return violations;
+    }
+
+    QSet<QString> reported;
+    foreach (const BI_NetLine* netline, netlines) {
+        CopperShape shape = getCopperShape(*netline, rules);
+        const QString& layerName = netline->getLayer().getName();
+
+        // get the neighbourhood from the spatial index of the graphics scene
+        QRectF area = shape.bounds.adjusted(-maxClearance, -maxClearance,
+                                            maxClearance, maxClearance);
+        QRectF areaPx(fromNmPoint(area.topLeft()).toPxQPointF(),
+                      fromNmPoint(area.bottomRight()).toPxQPointF());
+        foreach (const BI_Base* item, mBoard.getItemCandidatesInSceneRect(areaPx.normalized())) {
+            CopperShape other;
+            switch (item->getType()) {
+                case BI_Base::Type_t::NetLine: {
+                    const BI_NetLine* line = static_cast<const BI_NetLine*>(item);
+                    if (line->getLayer().getName() != layerName) continue;
+                    other = getCopperShape(*line, rules);
+                    break;
+                }
+                case BI_Base::Type_t::Via:
+                    other = getCopperShape(*static_cast<const BI_Via*>(item), rules);
+                    break;
+                case BI_Base::Type_t::FootprintPad: {
+                    const BI_FootprintPad* pad = static_cast<const BI_FootprintPad*>(item);
+                    if (!pad->isOnLayer(layerName)) continue;
+                    other = getCopperShape(*pad, rules);
+                    break;
+                }
+                default:
+                    continue;
+            }
+            qreal clearance = rules.getClearance(shape.netClassId, other.netClassId).toNm();
+            if (isClearanceViolated(shape, other, clearance)) {
+                Violation violation = createClearanceViolation(shape, other, layerName, clearance);
+                if (!reported.contains(violation.key)) {
+                    reported.insert(violation.key);
+                    violations.append(violation);
+                }
+            }
+        }
+    }
+    return violations;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardDesignRuleCheck::checkMinWidth() noexcept
+{
+    const Length& minWidth = mBoard.getDesignRules().getMinCopperWidth();
+    const BoardNetLineGeometry& netlines = mBoard.getNetLineGeometry();
+    for (int i = 0; i < netlines.getCount(); ++i) {
+        // only scan the flat width array, the netline is needed only for violations
+        if (netlines.getWidths().at(i) < minWidth.toNm()) {
+            const BI_NetLine* netline = netlines.getNetLines().at(i);
+            Point pos = (netline->getStartPoint().getPosition() +
+                         netline->getEndPoint().getPosition()) / 2;
+            mViolations.append(Violation{ViolationType::MinWidth,
+                QString("netline/%1").arg(netline->getUuid().toStr()),
+                netline->getLayer().getName(), pos,
+                QString(tr("Trace width of net \"%1\" is %2mm (min. %3mm)"))
+                .arg(netline->getNetSignal().getName()).arg(netline->getWidth().toMm())
+                .arg(minWidth.toMm())});
+        }
+    }
+}
+
+void BoardDesignRuleCheck::checkAnnularRings() noexcept
+{
+    const BoardDesignRules& rules = mBoard.getDesignRules();
+    foreach (const BI_Via* via, mBoard.getVias()) {
+        Length restring = (via->getSize() - via->getDrillDiameter()) / 2;
+        if (restring < rules.getRestringViaMin()) {
+            mViolations.append(Violation{ViolationType::AnnularRing,
+                QString("via/%1").arg(via->getUuid().toStr()), QString(),
+                via->getPosition(),
+                QString(tr("Annular ring of via is %1mm (min. %2mm)"))
+                .arg(restring.toMm()).arg(rules.getRestringViaMin().toMm())});
+        }
+    }
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            const library::FootprintPad& libPad = pad->getLibPad();
+            if (libPad.getBoardSide() != library::FootprintPad::BoardSide::THT) continue;
+            Length size = qMin(libPad.getWidth(), libPad.getHeight());
+            Length restring = (size - libPad.getDrillDiameter()) / 2;
+            if (restring < rules.getRestringPadMin()) {
+                mViolations.append(Violation{ViolationType::AnnularRing,
+                    QString("pad/%1/%2").arg(device->getComponentInstanceUuid().toStr(),
+                                             pad->getLibPadUuid().toStr()), QString(),
+                    pad->getPosition(),
+                    QString(tr("Annular ring of pad \"%1:%2\" is %3mm (min. %4mm)"))
+                    .arg(device->getComponentInstance().getName(), pad->getDisplayText())
+                    .arg(restring.toMm()).arg(rules.getRestringPadMin().toMm())});
+            }
+        }
+    }
+}
+
+void BoardDesignRuleCheck::checkUnconnected() noexcept
+{
+    BoardAirWires& airWires = mBoard.getAirWires();
+    airWires.update(); // make sure all airwires are up to date
+    foreach (const NetSignal* netsignal, mBoard.getProject().getCircuit().getNetSignals()) {
+        QVector<BoardAirWires::AirWire> connections = airWires.getAirWires(*netsignal);
+        if (connections.isEmpty()) continue;
+        mViolations.append(Violation{ViolationType::Unconnected,
+            QString("net/%1").arg(netsignal->getUuid().toStr()), QString(),
+            connections.first().first,
+            QString(tr("Net \"%1\" has %2 unrouted connection(s)"))
+            .arg(netsignal->getName()).arg(connections.count())});
+    }
+}
+
+void BoardDesignRuleCheck::checkClearances() noexcept
+{
+    BoardRuleTable rules(mBoard);
+    const qreal clearance = rules.getMaxClearance().toNm(); // for the tiling margins
+    if (clearance <= 0) {
+        return;
+    }
+
+    // collect the shapes of all layers (must be done in this thread)
+    QList<QString> layerNames;
+    QList<QVector<CopperShape>> layerShapes;
+    foreach (const GraphicsLayer* layer, mBoard.getLayerStack().getAllLayers()) {
+        if ((!layer->isCopperLayer()) || (!layer->isEnabled())) continue;
+        layerNames.append(layer->getName());
+        layerShapes.append(getCopperShapes(layer->getName(), rules));
+    }
+
+    // split every layer into a grid of tiles with roughly constant item count
+    struct Job {int layer; int tile; QVector<int> indices;};
+    QVector<Tiling> tilings(layerShapes.count());
+    QVector<Job> jobs;
+    for (int l = 0; l < layerShapes.count(); ++l) {
+        const QVector<CopperShape>& shapes = layerShapes.at(l);
+        Tiling& tiling = tilings[l];
+        foreach (const CopperShape& shape, shapes) tiling.area |= shape.bounds;
+        tiling.count = qBound(1, qCeil(qSqrt(shapes.count() / 32.0)), 256);
+        tiling.width = qMax(tiling.area.width() / tiling.count, qreal(1));
+        tiling.height = qMax(tiling.area.height() / tiling.count, qreal(1));
+        QVector<QVector<int>> tileShapes(tiling.count * tiling.count);
+        for (int i = 0; i < shapes.count(); ++i) {
+            QRectF r = shapes.at(i).bounds.adjusted(-clearance / 2, -clearance / 2,
+                                                    clearance / 2, clearance / 2);
+            int first = tiling.getTileAt(r.topLeft());
+            int last = tiling.getTileAt(r.bottomRight());
+            for (int y = first / tiling.count; y <= last / tiling.count; ++y) {
+                for (int x = first % tiling.count; x <= last % tiling.count; ++x) {
+                    tileShapes[y * tiling.count + x].append(i);
+                }
+            }
+        }
+        for (int i = 0; i < tileShapes.count(); ++i) {
+            if (tileShapes.at(i).count() >= 2) {
+                jobs.append(Job{l, i, tileShapes.at(i)});
+            }
+        }
+    }
+
+    // check all tiles concurrently
+    QVector<QList<QPair<int, int>>> results(jobs.count());
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+    for (int i = 0; i < jobs.count(); ++i) {
+        const Job& job = jobs.at(i);
+        pool.start(new TileChecker(layerShapes.at(job.layer), tilings.at(job.layer),
+                                   job.tile, job.indices, rules, results[i]));
+    }
+    pool.waitForDone();
+
+    // convert the results to violations (in a deterministic order)
+    for (int i = 0; i < jobs.count(); ++i) {
+        const QVector<CopperShape>& shapes = layerShapes.at(jobs.at(i).layer);
+        const QString& layerName = layerNames.at(jobs.at(i).layer);
+        for (const QPair<int, int>& pair : results.at(i)) {
+            const CopperShape& a = shapes.at(pair.first);
+            const CopperShape& b = shapes.at(pair.second);
+            mViolations.append(createClearanceViolation(a, b, layerName,
+                rules.getClearance(a.netClassId, b.netClassId).toNm()));
+        }
+    }
+}
+
+QVector<BoardDesignRuleCheck::CopperShape> BoardDesignRuleCheck::getCopperShapes(
+        const QString& layerName, const BoardRuleTable& rules) const noexcept
+{
+    QVector<CopperShape> shapes;
+    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
+        if (netline->getLayer().getName() == layerName) {
+            shapes.append(getCopperShape(*netline, rules));
+        }
+    }
+    foreach (const BI_Via* via, mBoard.getVias()) {
+        shapes.append(getCopperShape(*via, rules)); // vias are on all copper layers
+    }
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            if (pad->isOnLayer(layerName)) {
+                shapes.append(getCopperShape(*pad, rules));
+            }
+        }
+    }
+    return shapes;
+}
+
+BoardDesignRuleCheck::CopperShape BoardDesignRuleCheck::getCopperShape(
+        const BI_NetLine& netline, const BoardRuleTable& rules) noexcept
+{
+    CopperShape shape;
+    shape.points = toNmPoints(netline.getGeometry().getPoints());
+    shape.radius = netline.getGeometry().getRadius().toNm();
+    shape.netKey = netline.getNetSignal().getUuid().toStr();
+    shape.netClassId = rules.getNetClassId(&netline.getNetSignal());
+    shape.itemKey = QString("netline/%1").arg(netline.getUuid().toStr());
+    shape.name = QString(tr("trace of net \"%1\"")).arg(netline.getNetSignal().getName());
+    updateBounds(shape, QPointF());
+    return shape;
+}
+
+BoardDesignRuleCheck::CopperShape BoardDesignRuleCheck::getCopperShape(
+        const BI_Via& via, const BoardRuleTable& rules) noexcept
+{
+    CopperShape shape;
+    shape.points = toNmPoints(via.getGeometry().getPoints());
+    shape.radius = via.getGeometry().getRadius().toNm();
+    shape.itemKey = QString("via/%1").arg(via.getUuid().toStr());
+    shape.netClassId = rules.getNetClassId(via.getNetSignal());
+    if (via.getNetSignal()) {
+        shape.netKey = via.getNetSignal()->getUuid().toStr();
+        shape.name = QString(tr("via of net \"%1\"")).arg(via.getNetSignal()->getName());
+    } else {
+        shape.netKey = shape.itemKey; // unconnected vias collide with everything
+        shape.name = tr("unconnected via");
+    }
+    updateBounds(shape, QPointF());
+    return shape;
+}
+
+BoardDesignRuleCheck::CopperShape BoardDesignRuleCheck::getCopperShape(
+        const BI_FootprintPad& pad, const BoardRuleTable& rules) noexcept
+{
+    const BI_Device& device = pad.getFootprint().getDeviceInstance();
+    CopperShape shape;
+    shape.points = toNmPoints(pad.getGeometry().getPoints());
+    shape.radius = pad.getGeometry().getRadius().toNm();
+    shape.itemKey = QString("pad/%1/%2").arg(device.getComponentInstanceUuid().toStr(),
+                                             pad.getLibPadUuid().toStr());
+    shape.netKey = pad.getCompSigInstNetSignal()
+        ? pad.getCompSigInstNetSignal()->getUuid().toStr() : shape.itemKey;
+    shape.netClassId = rules.getNetClassId(pad.getCompSigInstNetSignal());
+    shape.name = QString(tr("pad \"%1:%2\"")).arg(device.getComponentInstance().getName(),
+                                                 pad.getDisplayText());
+    updateBounds(shape, QPointF());
+    return shape;
+}
+
+void BoardDesignRuleCheck::updateBounds(CopperShape& shape, const QPointF& offset) noexcept
+{
+    qreal left = std::numeric_limits<qreal>::max(), right = -left;
+    qreal top = left, bottom = -left;
+    for (QPointF& p : shape.points) {
+        p += offset;
+        left = qMin(left, p.x());   right = qMax(right, p.x());
+        top = qMin(top, p.y());     bottom = qMax(bottom, p.y());
+    }
+    // (QRectF::operator|() would ignore zero-sized rects of single points)
+    shape.bounds = QRectF(QPointF(left, top), QPointF(right, bottom))
+                   .adjusted(-shape.radius, -shape.radius, shape.radius, shape.radius);
+}
+
+bool BoardDesignRuleCheck::isClearanceViolated(const CopperShape& a, const CopperShape& b,
+                                               qreal clearance) noexcept
+{
+    if ((!a.netKey.isEmpty()) && (a.netKey == b.netKey)) {
+        return false; // copper of the same net signal may touch
+    }
+    qreal margin = clearance / 2;
+    if (!a.bounds.adjusted(-margin, -margin, margin, margin).intersects(
+         b.bounds.adjusted(-margin, -margin, margin, margin))) {
+        return false;
+    }
+    return (shapeDistance(a.points, a.radius, b.points, b.radius) < clearance);
+}
+
+BoardDesignRuleCheck::Violation BoardDesignRuleCheck::createClearanceViolation(
+        const CopperShape& a, const CopperShape& b, const QString& layerName,
+        qreal clearance) noexcept
+{
+    QRectF r = a.bounds.adjusted(-clearance, -clearance, clearance, clearance) & b.bounds;
+    QStringList keys = {a.itemKey, b.itemKey};
+    keys.sort(); // independent of the order of the shapes
+    return Violation{ViolationType::Clearance,
+        QString("clearance/%1/%2").arg(layerName, keys.join("/")), layerName,
+        fromNmPoint(r.center()),
+        QString(tr("Clearance violation between %1 and %2 on layer \"%3\""))
+        .arg(a.name, b.name, layerName)};
+}
+
+void BoardDesignRuleCheck::updateErcMessages() noexcept
+{
+    qDeleteAll(mErcMsgs);
+    mErcMsgs.clear();
+    if (!mBoard.isAddedToProject()) {
+        return;
+    }
+    foreach (const Violation& violation, mViolations) {
+        QString msgKey;
+        ErcMsg::ErcMsgType_t type = ErcMsg::ErcMsgType_t::BoardError;
+        switch (violation.type) {
+            case ViolationType::Clearance:      msgKey = "Clearance"; break;
+            case ViolationType::MinWidth:       msgKey = "MinWidth"; break;
+            case ViolationType::AnnularRing:    msgKey = "AnnularRing"; break;
+            case ViolationType::Unconnected:    msgKey = "Unconnected";
+                                                type = ErcMsg::ErcMsgType_t::BoardWarning; break;
+        }
+        ErcMsg* msg = new ErcMsg(mBoard.getProject(), *this,
+            QString("%1/%2").arg(mBoard.getUuid().toStr(), violation.key), msgKey, type,
+            QString("%1 (Board: %2)").arg(violation.message, mBoard.getName()));
+        msg->setVisible(true);
+        mErcMsgs.append(msg);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
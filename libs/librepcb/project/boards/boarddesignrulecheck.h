@@ -0,0 +1,173 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+#define LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+#include "../erc/if_ercmsgprovider.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_NetLine;
+class BI_Via;
+class BI_FootprintPad;
+class BoardRuleTable;
+class ErcMsg;
+
+/*****************************************************************************************
+ *  Class BoardDesignRuleCheck
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardDesignRuleCheck class checks a board against its
+ *        librepcb::BoardDesignRules
+ *
+ * The following checks are done:
+ *  - Clearance between copper items (traces, vias, pads) of different net signals,
+ *    resolved per pair of net classes (see librepcb::project::BoardRuleTable)
+ *  - Minimum trace width
+ *  - Minimum annular ring (restring) of vias and THT pads
+ *  - Unrouted connections (see librepcb::project::BoardAirWires)
+ *
+ * For the clearance check, the copper geometry of the board is first copied into plain
+ * shapes (in the calling thread). Then every copper layer is partitioned into spatial
+ * tiles, and each tile is checked concurrently in a thread pool. Only the shapes of the
+ * same tile are compared against each other, so the runtime grows roughly linear with
+ * the count of items on the board.
+ *
+ * Every violation is also added as a librepcb::project::ErcMsg to the project (if the
+ * board is added to the project), so it appears in the ERC messages dock.
+ *
+ * @note This class does not require a GUI, so it can be used from command line tools.
+ */
+class BoardDesignRuleCheck final : public QObject, public IF_ErcMsgProvider
+{
+        Q_OBJECT
+        DECLARE_ERC_MSG_CLASS_NAME(BoardDesignRuleCheck)
+
+    public:
+
+        // Types
+        enum class ViolationType {Clearance, MinWidth, AnnularRing, Unconnected};
+        struct Violation {
+            ViolationType type;
+            QString key;        ///< a stable identifier of the violating item(s)
+            QString layerName;  ///< empty if the violation is not layer specific
+            Point position;     ///< approximate location of the violation
+            QString message;    ///< human readable description
+        };
+
+        // Constructors / Destructor
+        BoardDesignRuleCheck() = delete;
+        BoardDesignRuleCheck(const BoardDesignRuleCheck& other) = delete;
+        explicit BoardDesignRuleCheck(Board& board) noexcept;
+        ~BoardDesignRuleCheck() noexcept;
+
+        // Getters
+        const QList<Violation>& getViolations() const noexcept {return mViolations;}
+
+        // General Methods
+
+        /**
+         * @brief Run all checks (blocks until all of them are finished)
+         *
+         * The board must not be modified while the check is running, which is ensured
+         * by blocking the caller.
+         */
+        void execute() noexcept;
+
+        /**
+         * @brief Remove all violations and their ERC messages
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Check the clearances of some traces against the copper around them
+         *
+         * This is the incremental counterpart of #execute() for interactive tools (e.g.
+         * while drawing traces). Only the given netlines are checked, and their
+         * neighbours are looked up in the spatial index of the board's graphics scene,
+         * so the runtime does not depend on the size of the board. The returned
+         * violations are neither stored nor reported as ERC messages.
+         *
+         * @param netlines  The netlines to check
+         *
+         * @return All clearance violations of the given netlines
+         */
+        QList<Violation> checkClearances(const QList<const BI_NetLine*>& netlines) const noexcept;
+
+        // Operator Overloadings
+        BoardDesignRuleCheck& operator=(const BoardDesignRuleCheck& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct CopperShape;
+        struct Tiling;
+        class TileChecker;
+
+        // Private Methods
+        void checkMinWidth() noexcept;
+        void checkAnnularRings() noexcept;
+        void checkUnconnected() noexcept;
+        void checkClearances() noexcept;
+        QVector<CopperShape> getCopperShapes(const QString& layerName,
+                                             const BoardRuleTable& rules) const noexcept;
+        static CopperShape getCopperShape(const BI_NetLine& netline,
+                                          const BoardRuleTable& rules) noexcept;
+        static CopperShape getCopperShape(const BI_Via& via,
+                                          const BoardRuleTable& rules) noexcept;
+        static CopperShape getCopperShape(const BI_FootprintPad& pad,
+                                          const BoardRuleTable& rules) noexcept;
+        static void updateBounds(CopperShape& shape, const QPointF& offset) noexcept;
+        static bool isClearanceViolated(const CopperShape& a, const CopperShape& b,
+                                        qreal clearance) noexcept;
+        static Violation createClearanceViolation(const CopperShape& a, const CopperShape& b,
+                                                  const QString& layerName,
+                                                  qreal clearance) noexcept;
+        void updateErcMessages() noexcept;
+
+
+        // General
+        Board& mBoard;
+
+        // Results
+        QList<Violation> mViolations;
+        QList<ErcMsg*> mErcMsgs;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
@@ -22,15 +22,28 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "boardgerberexport.h"
+#include <librepcb/common/application.h>
+#include <librepcb/common/debugtrace.h>
 #include <librepcb/common/cam/gerbergenerator.h>
 #include <librepcb/common/cam/excellongenerator.h>
+#include <librepcb/common/cam/excellonreader.h>
+#include <librepcb/common/cam/gerberreader.h>
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/graphics/strokefont.h>
 #include <librepcb/common/boarddesignrules.h>
 #include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/polygonclipper.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/library/pkg/package.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 #include "../project.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
 #include "board.h"
+#include "boardcopperpours.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
 #include "items/bi_footprintpad.h"
@@ -45,12 +58,85 @@
 namespace librepcb {
 namespace project {
 
+/*****************************************************************************************
+ *  Geometry Helpers (for merged copper regions)
+ ****************************************************************************************/
+
+/// Maximum deviation of the polygonal approximation of arcs (round pads, trace ends)
+static const Length sMergeTolerance(5000);
+
+/**
+ * @brief Append an outline counter-clockwise, so all outlines add to the winding number
+ */
+static void appendOutline(PolygonClipper::Paths& paths, PolygonClipper::Path path) noexcept
+{
+    if (PolygonClipper::calcArea(path) < 0) {
+        std::reverse(path.begin(), path.end());
+    }
+    paths.append(path);
+}
+
+/**
+ * @brief Even-odd point in polygon test
+ */
+static bool containsPoint(const PolygonClipper::Path& path, const Point& point) noexcept
+{
+    qreal x = point.getX().toNm(), y = point.getY().toNm();
+    bool inside = false;
+    for (int i = 0, j = path.count() - 1; i < path.count(); j = i++) {
+        qreal xi = path.at(i).getX().toNm(), yi = path.at(i).getY().toNm();
+        qreal xj = path.at(j).getX().toNm(), yj = path.at(j).getY().toNm();
+        if (((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi) + xi)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+/*****************************************************************************************
+ *  Class BoardGerberExport::LayerExporter
+ ****************************************************************************************/
+
+/**
+ * @brief Exports a single output file in a thread pool worker
+ *
+ * Exceptions are not propagated to the thread pool, the error message is stored in the
+ * given string instead (which must not be accessed until the pool has finished).
+ */
+class BoardGerberExport::LayerExporter final : public QRunnable
+{
+    public:
+        LayerExporter(const BoardGerberExport& exporter, ExportFunction function,
+                      const FilePath& filepath, QString& error) noexcept :
+            mExporter(exporter), mFunction(function), mFilePath(filepath), mError(error)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            LIBREPCB_TRACE_SCOPE("BoardGerberExport::LayerExporter::run");
+            try {
+                (mExporter.*mFunction)(mFilePath); // can throw
+            } catch (const Exception& e) {
+                mError = e.getMsg();
+            }
+        }
+
+    private:
+        const BoardGerberExport& mExporter;
+        ExportFunction mFunction;
+        FilePath mFilePath;
+        QString& mError;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 BoardGerberExport::BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept :
-    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir)
+    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir),
+    mPanel{1, 1, Length(0), Length(0)}, mMergeCopperRegions(false)
 {
 }
 
@@ -62,120 +148,308 @@ BoardGerberExport::~BoardGerberExport() noexcept
  *  General Methods
  ****************************************************************************************/
 
-void BoardGerberExport::exportAllLayers() const
+QString BoardGerberExport::calcInputChecksum() const
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.writeStartElement("gerber_export");
+
+    // the generated files also depend on the exporter itself and the project metadata
+    writer.writeTextElement("app_version", qApp->getAppVersion().toStr());
+    writer.writeTextElement("project", mProject.getName() % "," % mProject.getVersion());
+    writer.writeTextElement("panel", QString("%1,%2,%3,%4").arg(mPanel.columns)
+                            .arg(mPanel.rows).arg(mPanel.stepX.toNmString(),
+                                                  mPanel.stepY.toNmString()));
+    writer.writeTextElement("merge_copper", mMergeCopperRegions ? "true" : "false");
+
+    // board items, layer stack and design rules
+    mBoard.serializeToXmlStream(writer, "board"); // can throw
+
+    // the board only refers to the footprints, so their geometry is added separately
+    // (sorted by UUID to get the same checksum independent of the device order)
+    QMap<Uuid, const library::Package*> packages;
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        packages.insert(device->getLibPackage().getUuid(), &device->getLibPackage());
+    }
+    foreach (const library::Package* package, packages) {
+        package->serializeToXmlStream(writer, "package"); // can throw
+    }
+
+    writer.writeEndElement();
+    return QString(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+}
+
+bool BoardGerberExport::exportAllLayers(bool force) const
 {
-    exportDrillsPTH();
-    exportLayerBoardOutlines();
-    exportLayerTopCopper();
-    exportLayerTopSolderMask();
-    exportLayerTopSilkscreen();
-    exportLayerBottomCopper();
-    exportLayerBottomSolderMask();
-    exportLayerBottomSilkscreen();
+    LIBREPCB_TRACE_SCOPE("BoardGerberExport::exportAllLayers");
+    QList<QPair<QString, ExportFunction>> exports;
+    exports.append(qMakePair(QString("DRILLS-PTH.drl"), &BoardGerberExport::exportDrillsPTH));
+    exports.append(qMakePair(QString("OUTLINES.gbr"), &BoardGerberExport::exportLayerBoardOutlines));
+    exports.append(qMakePair(QString("COPPER-TOP.gbr"), &BoardGerberExport::exportLayerTopCopper));
+    exports.append(qMakePair(QString("SOLDERMASK-TOP.gbr"), &BoardGerberExport::exportLayerTopSolderMask));
+    exports.append(qMakePair(QString("SILKSCREEN-TOP.gbr"), &BoardGerberExport::exportLayerTopSilkscreen));
+    exports.append(qMakePair(QString("COPPER-BOTTOM.gbr"), &BoardGerberExport::exportLayerBottomCopper));
+    exports.append(qMakePair(QString("SOLDERMASK-BOTTOM.gbr"), &BoardGerberExport::exportLayerBottomSolderMask));
+    exports.append(qMakePair(QString("SILKSCREEN-BOTTOM.gbr"), &BoardGerberExport::exportLayerBottomSilkscreen));
+
+    // skip the export if all files exist and were generated from the same input
+    QString checksum = calcInputChecksum(); // can throw
+    FilePath checksumFilePath = getOutputFilePath("INPUT.sha256");
+    if ((!force) && checksumFilePath.isExistingFile()) {
+        bool upToDate = (FileUtils::readFile(checksumFilePath).trimmed() == checksum); // can throw
+        for (int i = 0; i < exports.count(); ++i) {
+            upToDate = upToDate && getOutputFilePath(exports.at(i).first).isExistingFile();
+        }
+        if (upToDate) {
+            return false;
+        }
+    }
+
+    // create the output directory here to avoid races between the exporters
+    FileUtils::makePath(mOutputDirectory); // can throw
+
+    // the checksum must not be valid anymore if the export fails
+    if (checksumFilePath.isExistingFile()) {
+        FileUtils::removeFile(checksumFilePath); // can throw
+    }
+
+    // the exporters only read the cached fills of the copper pours
+    mBoard.getCopperPours().update();
+
+    // All layers are independent and only read from the board, so they are exported
+    // concurrently. The board must not be modified in the meantime, which is ensured
+    // by blocking the caller until all exports are finished.
+    QVector<QString> errors(exports.count());
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+    for (int i = 0; i < exports.count(); ++i) {
+        pool.start(new LayerExporter(*this, exports.at(i).second,
+                                     getOutputFilePath(exports.at(i).first), errors[i]));
+    }
+    pool.waitForDone();
+
+    // report all failed layers at once
+    QStringList messages;
+    for (int i = 0; i < exports.count(); ++i) {
+        if (!errors.at(i).isNull()) {
+            messages.append(QString("%1: %2").arg(exports.at(i).first, errors.at(i)));
+        }
+    }
+    if (!messages.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Failed to export %1 of %2 files:\n\n%3"))
+            .arg(messages.count()).arg(exports.count()).arg(messages.join("\n")));
+    }
+
+    FileUtils::writeFile(checksumFilePath, checksum.toLatin1()); // can throw
+    return true;
+}
+
+bool BoardGerberExport::exportPanel(int columns, int rows, const Length& spacing, bool force)
+{
+    if ((columns < 1) || (rows < 1)) {
+        throw LogicError(__FILE__, __LINE__, QString(tr("Invalid panel size: %1x%2"))
+                         .arg(columns).arg(rows));
+    }
+
+    // the copies are placed next to each other, separated by the spacing
+    QRectF outlineRectPx;
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+            outlineRectPx |= polygon->getPolygon().toQPainterPathPx().boundingRect();
+        }
+    }
+    if (outlineRectPx.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("A panel can only be exported if the board has an outline."));
+    }
+
+    mPanel = Panel{columns, rows, Length::fromPx(outlineRectPx.width()) + spacing,
+                   Length::fromPx(outlineRectPx.height()) + spacing};
+    auto resetPanel = scopeGuard([this](){mPanel = Panel{1, 1, Length(0), Length(0)};});
+    return exportAllLayers(force); // can throw
+}
+
+CamImage BoardGerberExport::getLayerImage(const QString& layerName) const
+{
+    GerberGenerator gen(mProject.getName() % " - " % mBoard.getName(),
+                        mBoard.getUuid(), mProject.getVersion());
+    initGenerator(gen, "Other,Image");
+    drawLayer(gen, layerName); // can throw
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    gen.generate(buffer); // can throw
+    return GerberReader::read(buffer.data()); // can throw
+}
+
+CamImage BoardGerberExport::getDrillImage() const
+{
+    ExcellonGenerator gen;
+    drawDrills(gen);
+    QByteArray content;
+    {
+        QTextStream stream(&content, QIODevice::WriteOnly);
+        gen.generate(stream);
+    }
+    return ExcellonReader::read(content); // can throw
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-void BoardGerberExport::exportDrillsPTH() const
+void BoardGerberExport::exportDrillsPTH(const FilePath& filepath) const
 {
     ExcellonGenerator gen;
+    gen.setHitOrder(ExcellonGenerator::HitOrder::NearestNeighbour);
+    drawDrills(gen);
+    gen.generate();
+    gen.saveToFile(filepath); // can throw
+}
 
-    // footprint holes and pads
+void BoardGerberExport::drawDrills(ExcellonGenerator& gen) const
+{
+    QVector<Point> offsets = getPanelOffsets();
+    auto drill = [&gen, &offsets](const Point& pos, const Length& dia, bool plated){
+        foreach (const Point& offset, offsets) {
+            gen.drill(pos + offset, dia, plated);
+        }
+    };
+
+    // footprint holes (non-plated) and pads
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
         const BI_Footprint& footprint = device->getFootprint();
         for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
-            gen.drill(footprint.mapToScene(hole.getPosition()), hole.getDiameter());
+            drill(footprint.mapToScene(hole.getPosition()), hole.getDiameter(), false);
         }
         foreach (const BI_FootprintPad* pad, footprint.getPads()) {
             const library::FootprintPad& libPad = pad->getLibPad();
             if (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT) {
-                gen.drill(pad->getPosition(), libPad.getDrillDiameter());
+                drill(pad->getPosition(), libPad.getDrillDiameter(), true);
             }
         }
     }
 
     // vias
     foreach (const BI_Via* via, mBoard.getVias()) {
-        gen.drill(via->getPosition(), via->getDrillDiameter());
+        drill(via->getPosition(), via->getDrillDiameter(), true);
     }
-
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("DRILLS-PTH.drl"));
 }
 
-void BoardGerberExport::exportLayerBoardOutlines() const
+void BoardGerberExport::exportLayerBoardOutlines(const FilePath& filepath) const
 {
     GerberGenerator gen(mProject.getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getVersion());
+    initGenerator(gen, "Profile,NP");
     drawLayer(gen, GraphicsLayer::sBoardOutlines);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("OUTLINES.gbr"));
+    gen.saveToFile(filepath); // can throw
 }
 
-void BoardGerberExport::exportLayerTopCopper() const
+void BoardGerberExport::exportLayerTopCopper(const FilePath& filepath) const
 {
     GerberGenerator gen(mProject.getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getVersion());
+    initGenerator(gen, "Copper,L1,Top");
     drawLayer(gen, GraphicsLayer::sTopCopper);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("COPPER-TOP.gbr"));
+    gen.saveToFile(filepath); // can throw
 }
 
-void BoardGerberExport::exportLayerTopSolderMask() const
+void BoardGerberExport::exportLayerTopSolderMask(const FilePath& filepath) const
 {
     GerberGenerator gen(mProject.getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getVersion());
+    initGenerator(gen, "Soldermask,Top", true);
     drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SOLDERMASK-TOP.gbr"));
+    gen.saveToFile(filepath); // can throw
 }
 
-void BoardGerberExport::exportLayerTopSilkscreen() const
+void BoardGerberExport::exportLayerTopSilkscreen(const FilePath& filepath) const
 {
     GerberGenerator gen(mProject.getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getVersion());
+    initGenerator(gen, "Legend,Top");
     drawLayer(gen, GraphicsLayer::sTopPlacement);
     drawLayer(gen, GraphicsLayer::sTopNames);
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SILKSCREEN-TOP.gbr"));
+    gen.saveToFile(filepath); // can throw
 }
 
-void BoardGerberExport::exportLayerBottomCopper() const
+void BoardGerberExport::exportLayerBottomCopper(const FilePath& filepath) const
 {
     GerberGenerator gen(mProject.getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getVersion());
+    initGenerator(gen, "Copper,L2,Bot");
     drawLayer(gen, GraphicsLayer::sBotCopper);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("COPPER-BOTTOM.gbr"));
+    gen.saveToFile(filepath); // can throw
 }
 
-void BoardGerberExport::exportLayerBottomSolderMask() const
+void BoardGerberExport::exportLayerBottomSolderMask(const FilePath& filepath) const
 {
     GerberGenerator gen(mProject.getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getVersion());
+    initGenerator(gen, "Soldermask,Bot", true);
     drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SOLDERMASK-BOTTOM.gbr"));
+    gen.saveToFile(filepath); // can throw
 }
 
-void BoardGerberExport::exportLayerBottomSilkscreen() const
+void BoardGerberExport::exportLayerBottomSilkscreen(const FilePath& filepath) const
 {
     GerberGenerator gen(mProject.getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getVersion());
+    initGenerator(gen, "Legend,Bot");
     drawLayer(gen, GraphicsLayer::sBotPlacement);
     drawLayer(gen, GraphicsLayer::sBotNames);
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SILKSCREEN-BOTTOM.gbr"));
+    gen.saveToFile(filepath); // can throw
+}
+
+void BoardGerberExport::initGenerator(GerberGenerator& gen, const QString& fileFunction,
+                                      bool negative) const noexcept
+{
+    gen.setFileFunction(fileFunction, negative ? GerberGenerator::LayerPolarity::Negative
+                                               : GerberGenerator::LayerPolarity::Positive);
+    gen.setStepAndRepeat(mPanel.columns, mPanel.rows, mPanel.stepX, mPanel.stepY);
+}
+
+QVector<Point> BoardGerberExport::getPanelOffsets() const noexcept
+{
+    QVector<Point> offsets;
+    for (int row = 0; row < mPanel.rows; ++row) {
+        for (int column = 0; column < mPanel.columns; ++column) {
+            offsets.append(Point(mPanel.stepX * column, mPanel.stepY * row));
+        }
+    }
+    return offsets;
 }
 
 void BoardGerberExport::drawLayer(GerberGenerator& gen, const QString& layerName) const
 {
+    // X2 aperture functions are only specified for copper layers and the outlines
+    bool isCopperLayer = GraphicsLayer::isCopperLayer(layerName);
+    bool mergeCopper = isCopperLayer && mMergeCopperRegions;
+
+    // draw copper pours first because their holes are drawn with clear polarity, which
+    // would also erase everything drawn before
+    bool copperPoursDrawn = false;
+    gen.setApertureFunction(isCopperLayer ? "Conductor" : QString());
+    if (mergeCopper) {
+        drawMergedCopper(gen, layerName); // incl. pads, vias and traces
+        copperPoursDrawn = true;
+    } else {
+        foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+            Q_ASSERT(polygon);
+            if ((layerName == polygon->getPolygon().getLayerName()) && polygon->isCopperPour()) {
+                drawCopperPour(gen, *polygon);
+                copperPoursDrawn = true;
+            }
+        }
+    }
+    if (copperPoursDrawn) {
+        gen.setLayerPolarity(GerberGenerator::LayerPolarity::Positive);
+    }
+
     // draw footprints incl. pads
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
         Q_ASSERT(device);
@@ -189,9 +463,10 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen, const QString& layerName
     }
 
     // draw traces
+    gen.setApertureFunction(isCopperLayer ? "Conductor" : QString());
     foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
         Q_ASSERT(netline);
-        if (netline->getLayer().getName() == layerName) {
+        if ((netline->getLayer().getName() == layerName) && (!mergeCopper)) {
             gen.drawLine(netline->getStartPoint().getPosition(),
                          netline->getEndPoint().getPosition(),
                          netline->getWidth());
@@ -199,6 +474,9 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen, const QString& layerName
     }
 
     // draw polygons
+    if (layerName == GraphicsLayer::sBoardOutlines) {
+        gen.setApertureFunction("Profile");
+    }
     foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
         Q_ASSERT(polygon);
         if (layerName == polygon->getPolygon().getLayerName()) {
@@ -209,12 +487,132 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen, const QString& layerName
     }
 }
 
+void BoardGerberExport::drawCopperPour(GerberGenerator& gen, const BI_Polygon& polygon) const
+{
+    const QString& layerName = polygon.getPolygon().getLayerName();
+    foreach (const BoardCopperPours::Contour& contour, mBoard.getCopperPours().getFill(polygon)) {
+        gen.setLayerPolarity((contour.depth % 2) ? GerberGenerator::LayerPolarity::Negative
+                                                 : GerberGenerator::LayerPolarity::Positive);
+        Polygon area(layerName, Length(0), true, false, contour.points.first());
+        for (int i = 1; i < contour.points.count(); ++i) {
+            area.getSegments().append(std::make_shared<PolygonSegment>(contour.points.at(i),
+                                                                       Angle::deg0()));
+        }
+        gen.drawPolygonArea(area);
+    }
+}
+
+void BoardGerberExport::drawMergedCopper(GerberGenerator& gen, const QString& layerName) const
+{
+    // collect the copper areas of all items on this layer, grouped by net signal
+    // (items without net signal are collected together as they are merged anyway
+    // wherever they overlap)
+    QHash<const NetSignal*, PolygonClipper::Paths> areas;
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        if ((layerName != polygon->getPolygon().getLayerName()) || (!polygon->isCopperPour())) {
+            continue;
+        }
+        PolygonClipper::Paths& paths = areas[polygon->getNetSignal()];
+        foreach (const BoardCopperPours::Contour& contour, mBoard.getCopperPours().getFill(*polygon)) {
+            PolygonClipper::Path path = contour.points;
+            path.removeLast(); // the closing point
+            if (PolygonClipper::calcArea(path) < 0) {
+                std::reverse(path.begin(), path.end());
+            }
+            if (contour.depth % 2) {
+                std::reverse(path.begin(), path.end()); // holes clockwise
+            }
+            paths.append(path);
+        }
+    }
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            if (!pad->isOnLayer(layerName)) {
+                continue;
+            }
+            appendOutline(areas[pad->getCompSigInstNetSignal()],
+                          pad->getGeometry().getOutline(Length(0), sMergeTolerance));
+        }
+    }
+    foreach (const BI_Via* via, mBoard.getVias()) {
+        if (via->isOnLayer(layerName)) {
+            appendOutline(areas[via->getNetSignal()],
+                          via->getGeometry().getOutline(Length(0), sMergeTolerance));
+        }
+    }
+    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
+        if (netline->getLayer().getName() == layerName) {
+            appendOutline(areas[&netline->getNetSignal()],
+                          netline->getGeometry().getOutline(Length(0), sMergeTolerance));
+        }
+    }
+
+    // unite the areas of each net signal (in a deterministic order)
+    struct Contour {
+        PolygonClipper::Path path;
+        Point min;
+        Point max;
+        bool hole;
+        int depth;
+    };
+    QVector<Contour> contours;
+    QList<const NetSignal*> netsignals;
+    netsignals.append(nullptr);
+    foreach (const NetSignal* netsignal, mProject.getCircuit().getNetSignals()) {
+        netsignals.append(netsignal);
+    }
+    foreach (const NetSignal* netsignal, netsignals) {
+        if (!areas.contains(netsignal)) {
+            continue;
+        }
+        for (const PolygonClipper::Path& path : PolygonClipper::unite(areas.value(netsignal))) {
+            Contour contour{path, path.first(), path.first(),
+                            PolygonClipper::calcArea(path) < 0, 0};
+            for (const Point& p : path) {
+                contour.min = Point(qMin(contour.min.getX(), p.getX()),
+                                    qMin(contour.min.getY(), p.getY()));
+                contour.max = Point(qMax(contour.max.getX(), p.getX()),
+                                    qMax(contour.max.getY(), p.getY()));
+            }
+            contours.append(contour);
+        }
+    }
+
+    // Holes are drawn with clear polarity, so they must be drawn before all contours
+    // inside of them (e.g. pads of other nets within a hole of a copper pour). So the
+    // contours are sorted by their nesting level over all net signals.
+    for (Contour& contour : contours) {
+        const Point& p = contour.path.first();
+        for (const Contour& other : contours) {
+            if ((&other != &contour)
+                && (p.getX() >= other.min.getX()) && (p.getX() <= other.max.getX())
+                && (p.getY() >= other.min.getY()) && (p.getY() <= other.max.getY())
+                && containsPoint(other.path, p))
+            {
+                ++contour.depth;
+            }
+        }
+    }
+    std::stable_sort(contours.begin(), contours.end(),
+        [](const Contour& a, const Contour& b){return a.depth < b.depth;});
+
+    foreach (const Contour& contour, contours) {
+        gen.setLayerPolarity(contour.hole ? GerberGenerator::LayerPolarity::Negative
+                                          : GerberGenerator::LayerPolarity::Positive);
+        for (const Polygon& area : PolygonClipper::toPolygons({contour.path}, layerName,
+                                                              Length(0), true, false)) {
+            gen.drawPolygonArea(area);
+        }
+    }
+}
+
 void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via, const QString& layerName) const
 {
-    bool drawCopper = via.isOnLayer(layerName);
+    bool drawCopper = via.isOnLayer(layerName) && (!mMergeCopperRegions);
     bool drawStopMask = (layerName == GraphicsLayer::sTopStopMask || layerName == GraphicsLayer::sBotStopMask)
                         && mBoard.getDesignRules().doesViaRequireStopMask(via.getDrillDiameter());
     if (drawCopper || drawStopMask) {
+        gen.setApertureFunction(drawCopper ? "ViaPad" : QString());
         Length outerDiameter = via.getSize();
         if (drawStopMask) {
             outerDiameter += mBoard.getDesignRules().calcStopMaskClearance(via.getSize()) * 2;
@@ -248,10 +646,13 @@ void BoardGerberExport::drawFootprint(GerberGenerator& gen, const BI_Footprint&
     foreach (const BI_FootprintPad* pad, footprint.getPads()) {
         drawFootprintPad(gen, *pad, layerName);
     }
+    gen.setApertureFunction(QString());
+
+    // the layer name as seen from the (possibly mirrored) library footprint
+    QString layer = footprint.getIsMirrored() ? GraphicsLayer::getMirroredLayerName(layerName) : layerName;
 
     // draw polygons
     for (const Polygon& polygon : footprint.getLibFootprint().getPolygons()) {
-        QString layer = footprint.getIsMirrored() ? GraphicsLayer::getMirroredLayerName(layerName) : layerName;
         if (layer == polygon.getLayerName()) {
             Angle rot = footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation();
             Polygon p = polygon.rotated(rot).translate(footprint.getPosition());
@@ -265,7 +666,6 @@ void BoardGerberExport::drawFootprint(GerberGenerator& gen, const BI_Footprint&
 
     // draw ellipses
     for (const Ellipse& ellipse : footprint.getLibFootprint().getEllipses()) {
-        QString layer = footprint.getIsMirrored() ? GraphicsLayer::getMirroredLayerName(layerName) : layerName;
         if (layer == ellipse.getLayerName()) {
             Angle rot = footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation();
             Ellipse e = ellipse.rotated(rot).translate(footprint.getPosition());
@@ -277,7 +677,28 @@ void BoardGerberExport::drawFootprint(GerberGenerator& gen, const BI_Footprint&
         }
     }
 
-    // TODO: draw texts
+    // draw texts (with the same stroke font layout as shown in the board editor)
+    for (const Text& text : footprint.getLibFootprint().getTexts()) {
+        if (layer == text.getLayerName()) {
+            QString displayText = text.getText();
+            footprint.replaceVariablesWithAttributes(displayText, true);
+            Angle absAngle = text.getRotation() + footprint.getRotation();
+            absAngle.mapTo180deg();
+            bool rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
+            Angle rot = rotate180 ? (text.getRotation() + Angle::deg180()) : text.getRotation();
+            StrokeFont::Layout l = StrokeFont::get(displayText, text.getHeight(), rotate180 ?
+                                                   text.getAlign().mirrored() : text.getAlign());
+            Length width = calcWidthOfLayer(StrokeFont::getStrokeWidth(text.getHeight()), layer);
+            foreach (const QVector<Point>& stroke, l.strokes) {
+                Point last = footprint.mapToScene(stroke.first().rotated(rot) + text.getPosition());
+                for (int i = 1; i < stroke.count(); ++i) {
+                    Point p = footprint.mapToScene(stroke.at(i).rotated(rot) + text.getPosition());
+                    gen.drawLine(last, p, width);
+                    last = p;
+                }
+            }
+        }
+    }
 
     // draw holes
     for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
@@ -287,7 +708,7 @@ void BoardGerberExport::drawFootprint(GerberGenerator& gen, const BI_Footprint&
 
 void BoardGerberExport::drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad, const QString& layerName) const
 {
-    bool isOnCopperLayer = pad.isOnLayer(layerName);
+    bool isOnCopperLayer = pad.isOnLayer(layerName) && (!mMergeCopperRegions);
     bool isOnSolderMaskTop = pad.isOnLayer(GraphicsLayer::sTopCopper) && (layerName == GraphicsLayer::sTopStopMask);
     bool isOnSolderMaskBottom = pad.isOnLayer(GraphicsLayer::sBotCopper) && (layerName == GraphicsLayer::sBotStopMask);
     if (!isOnCopperLayer && !isOnSolderMaskTop && !isOnSolderMaskBottom) {
@@ -296,6 +717,12 @@ void BoardGerberExport::drawFootprintPad(GerberGenerator& gen, const BI_Footprin
 
     Angle rot = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
     const library::FootprintPad& libPad = pad.getLibPad();
+    if (isOnCopperLayer) {
+        bool tht = (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT);
+        gen.setApertureFunction(tht ? "ComponentPad" : "SMDPad,CuDef");
+    } else {
+        gen.setApertureFunction(QString());
+    }
     Length width = libPad.getWidth();
     Length height = libPad.getHeight();
     if (isOnSolderMaskTop || isOnSolderMaskBottom) {
@@ -27,6 +27,7 @@
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/cam/camimage.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -36,6 +37,7 @@ namespace librepcb {
 class Polygon;
 class Ellipse;
 class GerberGenerator;
+class ExcellonGenerator;
 
 namespace project {
 
@@ -44,6 +46,7 @@ class Board;
 class BI_Via;
 class BI_Footprint;
 class BI_FootprintPad;
+class BI_Polygon;
 
 /*****************************************************************************************
  *  Class BoardGerberExport
@@ -67,8 +70,104 @@ class BoardGerberExport final : public QObject
         BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept;
         ~BoardGerberExport() noexcept;
 
+        // Setters
+
+        /**
+         * @brief Merge the copper of each net signal into unified regions
+         *
+         * If enabled, all traces, pads, vias and copper pours of the same net signal on
+         * a copper layer are united with librepcb::PolygonClipper and emitted as
+         * regions (holes with clear polarity) instead of drawing every item on its
+         * own. This takes considerably more time to export, but avoids the overlapping
+         * objects which make the files large and slow to render in some viewers.
+         *
+         * @note Merged pads are no longer flashed, so they lose their X2 aperture
+         *       functions ("SMDPad", "ComponentPad" and "ViaPad" become "Conductor").
+         *
+         * @param merge     Whether to merge the copper (disabled by default)
+         */
+        void setMergeCopperRegions(bool merge) noexcept {mMergeCopperRegions = merge;}
+
         // General Methods
-        void exportAllLayers() const;
+
+        /**
+         * @brief Calculate a checksum over everything the exported files depend on
+         *
+         * This includes the board with its layers and design rules, the geometry of all
+         * used library packages, the panel settings and the application version.
+         *
+         * @return The SHA-256 checksum as hex string
+         *
+         * @throw Exception if the board could not be serialized
+         */
+        QString calcInputChecksum() const;
+
+        /**
+         * @brief Export all gerber and drill files
+         *
+         * The files are exported concurrently. If some of them could not be exported,
+         * all other files are still exported and an exception containing the errors of
+         * all failed files is thrown afterwards.
+         *
+         * After a successful export, the checksum of the inputs (see
+         * #calcInputChecksum()) is stored in an additional file in the output directory.
+         * If it is unchanged and all files exist, the next export can be skipped.
+         *
+         * @param force     If false, nothing is exported if the existing files are up
+         *                  to date
+         *
+         * @retval true     If the files were exported
+         * @retval false    If the export was skipped
+         *
+         * @throw Exception if at least one file could not be exported
+         */
+        bool exportAllLayers(bool force = true) const;
+
+        /**
+         * @brief Export all gerber and drill files for a panel (a grid of board copies)
+         *
+         * The gerber files contain the board only once, the copies are created with step
+         * and repeat blocks. So their size does not depend on the count of copies. As
+         * there is no widely supported equivalent in Excellon, the drill file contains
+         * the hits of all copies.
+         *
+         * @param columns   Count of copies in X direction (>= 1)
+         * @param rows      Count of copies in Y direction (>= 1)
+         * @param spacing   Distance between the board outlines of adjacent copies
+         * @param force     See #exportAllLayers()
+         *
+         * @return See #exportAllLayers()
+         *
+         * @throw Exception if at least one file could not be exported
+         */
+        bool exportPanel(int columns, int rows, const Length& spacing, bool force = true);
+
+        /**
+         * @brief Get the image of a board layer with the geometry of the gerber files
+         *
+         * The layer is drawn exactly like in the gerber files and read back with
+         * librepcb::GerberReader, e.g. to render it with librepcb::CamImageWriter. Any
+         * board layer can be drawn, not only the layers exported to gerber files.
+         *
+         * @note The fills of the copper pours are not updated, so call
+         *       librepcb::project::BoardCopperPours::update() before if necessary.
+         *
+         * @param layerName     The name of the layer to draw
+         *
+         * @return The image in board coordinates
+         *
+         * @throw Exception if the layer could not be drawn
+         */
+        CamImage getLayerImage(const QString& layerName) const;
+
+        /**
+         * @brief Get the image of all holes with the geometry of the drill file
+         *
+         * @return The image in board coordinates
+         *
+         * @throw Exception if the holes could not be drawn
+         */
+        CamImage getDrillImage() const;
 
         // Operator Overloadings
         BoardGerberExport& operator=(const BoardGerberExport& rhs) = delete;
@@ -76,17 +175,33 @@ class BoardGerberExport final : public QObject
 
     private:
 
-        // Private Methods
-        void exportDrillsPTH() const;
-        void exportLayerBoardOutlines() const;
-        void exportLayerTopCopper() const;
-        void exportLayerTopSolderMask() const;
-        void exportLayerTopSilkscreen() const;
-        void exportLayerBottomCopper() const;
-        void exportLayerBottomSolderMask() const;
-        void exportLayerBottomSilkscreen() const;
+        // Private Types
+        typedef void (BoardGerberExport::*ExportFunction)(const FilePath&) const;
+        class LayerExporter;
+        struct Panel {
+            int columns;
+            int rows;
+            Length stepX;
+            Length stepY;
+        };
 
+        // Private Methods
+        void exportDrillsPTH(const FilePath& filepath) const;
+        void drawDrills(ExcellonGenerator& gen) const;
+        void exportLayerBoardOutlines(const FilePath& filepath) const;
+        void exportLayerTopCopper(const FilePath& filepath) const;
+        void exportLayerTopSolderMask(const FilePath& filepath) const;
+        void exportLayerTopSilkscreen(const FilePath& filepath) const;
+        void exportLayerBottomCopper(const FilePath& filepath) const;
+        void exportLayerBottomSolderMask(const FilePath& filepath) const;
+        void exportLayerBottomSilkscreen(const FilePath& filepath) const;
+
+        void initGenerator(GerberGenerator& gen, const QString& fileFunction,
+                           bool negative = false) const noexcept;
+        QVector<Point> getPanelOffsets() const noexcept;
         void drawLayer(GerberGenerator& gen, const QString& layerName) const;
+        void drawCopperPour(GerberGenerator& gen, const BI_Polygon& polygon) const;
+        void drawMergedCopper(GerberGenerator& gen, const QString& layerName) const;
         void drawVia(GerberGenerator& gen, const BI_Via& via, const QString& layerName) const;
         void drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint, const QString& layerName) const;
         void drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad, const QString& layerName) const;
@@ -101,6 +216,8 @@ class BoardGerberExport final : public QObject
         const Project& mProject;
         const Board& mBoard;
         FilePath mOutputDirectory;
+        Panel mPanel; ///< the board copies to export (1x1 if not exporting a panel)
+        bool mMergeCopperRegions; ///< see #setMergeCopperRegions()
 };
 
 /*****************************************************************************************
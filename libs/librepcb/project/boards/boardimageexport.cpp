@@ -0,0 +1,159 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include "boardimageexport.h"
+#include <librepcb/common/debugtrace.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include "board.h"
+#include "boardcopperpours.h"
+#include "boardgerberexport.h"
+#include "boardlayerstack.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardImageExport::BoardImageExport(const Board& board, JobScheduler& scheduler) noexcept :
+    mBoard(board), mScheduler(scheduler), mOptions(), mMargin(1000000)
+{
+}
+
+BoardImageExport::~BoardImageExport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardImageExport::exportImage(const QStringList& layerNames,
+                                   const FilePath& filepath) const
+{
+    LIBREPCB_TRACE_SCOPE("BoardImageExport::exportImage");
+    QStringList names = layerNames;
+    std::stable_sort(names.begin(), names.end(), [](const QString& a, const QString& b) {
+        return getPaintOrder(a) < getPaintOrder(b);
+    });
+    CamImage drills;
+    QRectF area;
+    QHash<QString, CamImage> images = createLayerImages(names, drills, area); // can throw
+    QVector<CamImageWriter::Layer> layers;
+    foreach (const QString& name, names) {
+        layers.append(createLayer(name, images.value(name)));
+    }
+    layers.append(CamImageWriter::Layer{drills, mOptions.background});
+    CamImageWriter::writeTiff(layers, area, mOptions, filepath, mScheduler); // can throw
+}
+
+QList<FilePath> BoardImageExport::exportLayerImages(const QStringList& layerNames,
+                                                    const FilePath& outputDir) const
+{
+    LIBREPCB_TRACE_SCOPE("BoardImageExport::exportLayerImages");
+    CamImage drills;
+    QRectF area;
+    QHash<QString, CamImage> images = createLayerImages(layerNames, drills, area); // can throw
+    QList<FilePath> files;
+    foreach (const QString& name, layerNames) {
+        QVector<CamImageWriter::Layer> layers;
+        layers.append(createLayer(name, images.value(name)));
+        layers.append(CamImageWriter::Layer{drills, mOptions.background});
+        FilePath filepath = outputDir.getPathTo(name % ".tiff");
+        CamImageWriter::writeTiff(layers, area, mOptions, filepath, mScheduler); // can throw
+        files.append(filepath);
+    }
+    return files;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QHash<QString, CamImage> BoardImageExport::createLayerImages(const QStringList& layerNames,
+                                                             CamImage& drills,
+                                                             QRectF& area) const
+{
+    // the gerber export only reads the cached fills of the copper pours
+    mBoard.getCopperPours().update();
+    BoardGerberExport gerberExport(mBoard, FilePath());
+    QHash<QString, CamImage> images;
+    foreach (const QString& name, layerNames) {
+        if (!images.contains(name)) {
+            images.insert(name, gerberExport.getLayerImage(name)); // can throw
+        }
+    }
+    drills = gerberExport.getDrillImage(); // can throw
+
+    // all images of the board get the same area, including the board outline
+    area = gerberExport.getLayerImage(GraphicsLayer::sBoardOutlines).getBoundingRect(); // can throw
+    foreach (const CamImage& image, images) {
+        QRectF rect = image.getBoundingRect();
+        if (!rect.isNull()) {
+            area = area.isNull() ? rect : area.united(rect);
+        }
+    }
+    if (area.isNull()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("The selected layers of the board are empty."));
+    }
+    qreal margin = mMargin.toNm();
+    area.adjust(-margin, -margin, margin, margin);
+    return images;
+}
+
+CamImageWriter::Layer BoardImageExport::createLayer(const QString& layerName,
+                                                    const CamImage& image) const noexcept
+{
+    const GraphicsLayer* layer = mBoard.getLayerStack().getLayer(layerName);
+    return CamImageWriter::Layer{image, layer ? layer->getColor() : QColor(Qt::black)};
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+int BoardImageExport::getPaintOrder(const QString& layerName) noexcept
+{
+    if (GraphicsLayer::isBottomLayer(layerName)) {
+        return 0;
+    } else if (GraphicsLayer::isInnerLayer(layerName)) {
+        return 1;
+    } else if (GraphicsLayer::isTopLayer(layerName)) {
+        return 2;
+    } else {
+        return 3;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,139 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDIMAGEEXPORT_H
+#define LIBREPCB_PROJECT_BOARDIMAGEEXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/cam/camimagewriter.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class JobScheduler;
+
+namespace project {
+
+class Board;
+
+/*****************************************************************************************
+ *  Class BoardImageExport
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardImageExport class exports board layers as high resolution images
+ *
+ * The layers are drawn with the geometry of the gerber files (see
+ * librepcb::project::BoardGerberExport::getLayerImage()) in the colors of the board's
+ * layers, and the holes are drawn on top in the background color. The images are
+ * written with librepcb::CamImageWriter in parallel rendered strips, so even very high
+ * resolutions of large boards only need a few megabytes of memory.
+ *
+ * All images of a board have the same size and origin (the area of all given layers
+ * and the board outline, plus a margin), so images of single layers can be stacked in
+ * other applications, e.g. for assembly drawings.
+ */
+class BoardImageExport final
+{
+        Q_DECLARE_TR_FUNCTIONS(BoardImageExport)
+
+    public:
+
+        // Constructors / Destructor
+        BoardImageExport() = delete;
+        BoardImageExport(const BoardImageExport& other) = delete;
+        BoardImageExport(const Board& board, JobScheduler& scheduler) noexcept;
+        ~BoardImageExport() noexcept;
+
+        // Getters
+        const CamImageWriter::Options& getOptions() const noexcept {return mOptions;}
+        const Length& getMargin() const noexcept {return mMargin;}
+
+        // Setters
+        void setOptions(const CamImageWriter::Options& options) noexcept {mOptions = options;}
+        void setMargin(const Length& margin) noexcept {mMargin = margin;}
+
+        // General Methods
+
+        /**
+         * @brief Export several layers painted on top of each other into one image
+         *
+         * The layers are painted from the bottom side to the top side of the board,
+         * followed by the layers which are not specific to a side (e.g. the outline).
+         *
+         * @param layerNames    The layers to export
+         * @param filepath      The TIFF file to write
+         *
+         * @throw Exception if the layers could not be drawn or the file not be written
+         */
+        void exportImage(const QStringList& layerNames, const FilePath& filepath) const;
+
+        /**
+         * @brief Export every layer into its own image
+         *
+         * @param layerNames    The layers to export
+         * @param outputDir     The directory to write the images to, the files are
+         *                      named like the layers (e.g. "top_placement.tiff")
+         *
+         * @return The written files, in the order of the layers
+         *
+         * @throw Exception if a layer could not be drawn or a file not be written
+         */
+        QList<FilePath> exportLayerImages(const QStringList& layerNames,
+                                          const FilePath& outputDir) const;
+
+        // Operator Overloadings
+        BoardImageExport& operator=(const BoardImageExport& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        QHash<QString, CamImage> createLayerImages(const QStringList& layerNames,
+                                                   CamImage& drills, QRectF& area) const;
+        CamImageWriter::Layer createLayer(const QString& layerName,
+                                          const CamImage& image) const noexcept;
+
+        // Static Methods
+        static int getPaintOrder(const QString& layerName) noexcept;
+
+
+        // Private Member Variables
+        const Board& mBoard;
+        JobScheduler& mScheduler;
+        CamImageWriter::Options mOptions;
+        Length mMargin;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDIMAGEEXPORT_H
@@ -0,0 +1,684 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardipc2581export.h"
+#include <librepcb/common/application.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/footprintpad.h>
+#include "../project.h"
+#include "../settings/projectsettings.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentinstance.h"
+#include "board.h"
+#include "boardlayerstack.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_polygon.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardIpc2581Export::BoardIpc2581Export(const Board& board) noexcept :
+    mProject(board.getProject()), mBoard(board)
+{
+}
+
+BoardIpc2581Export::~BoardIpc2581Export() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardIpc2581Export::exportToFile(const FilePath& filepath) const
+{
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not open file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+    }
+    generate(file); // can throw
+    if (!file.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write file \"%1\": %2"))
+                           .arg(filepath.toNative(), file.errorString()));
+    }
+}
+
+void BoardIpc2581Export::generate(QIODevice& device) const
+{
+    // The dictionaries must be written before the features which reference them, so
+    // only the (few) distinct pad shapes and trace widths are collected in advance.
+    QMap<QString, Primitive> primitives;
+    QMap<QString, Length> lineWidths;
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        for (const library::FootprintPad& libPad : device->getLibFootprint().getPads()) {
+            Primitive primitive = getPadPrimitive(libPad);
+            primitives.insert(getPrimitiveId(primitive), primitive);
+        }
+    }
+    foreach (const BI_Via* via, mBoard.getVias()) {
+        Primitive primitive = getViaPrimitive(*via);
+        primitives.insert(getPrimitiveId(primitive), primitive);
+    }
+    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
+        lineWidths.insert(getLineDescId(netline->getWidth()), netline->getWidth());
+    }
+
+    QXmlStreamWriter xml(&device);
+    xml.setAutoFormatting(true);
+    xml.setAutoFormattingIndent(1);
+    xml.writeStartDocument();
+    xml.writeStartElement("IPC-2581");
+    xml.writeDefaultNamespace("http://webstds.ipc.org/2581");
+    xml.writeAttribute("revision", "B");
+    writeContent(xml, primitives, lineWidths);
+    writeLogisticHeader(xml);
+    writeHistoryRecord(xml);
+    xml.writeStartElement("Ecad");
+    xml.writeAttribute("name", mBoard.getName());
+    xml.writeEmptyElement("CadHeader");
+    xml.writeAttribute("units", "MILLIMETER");
+    xml.writeStartElement("CadData");
+    writeLayers(xml);
+    xml.writeStartElement("Step");
+    xml.writeAttribute("name", mBoard.getName());
+    xml.writeEmptyElement("Datum");
+    xml.writeAttribute("x", Length(0).toMmString());
+    xml.writeAttribute("y", Length(0).toMmString());
+    writeProfile(xml);
+    writePackages(xml);
+    writeComponents(xml);
+    writeLogicalNets(xml);
+    foreach (const QString& layerName, getCopperLayerNames()) {
+        writeCopperLayerFeatures(xml, layerName);
+    }
+    writeDrillLayerFeatures(xml);
+    xml.writeEndElement(); // Step
+    xml.writeEndElement(); // CadData
+    xml.writeEndElement(); // Ecad
+    xml.writeEndElement(); // IPC-2581
+    xml.writeEndDocument();
+
+    if (xml.hasError()) {
+        throw RuntimeError(__FILE__, __LINE__, tr("Failed to write the IPC-2581 data."));
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardIpc2581Export::writeContent(QXmlStreamWriter& xml,
+                                      const QMap<QString, Primitive>& primitives,
+                                      const QMap<QString, Length>& lineWidths) const
+{
+    xml.writeStartElement("Content");
+    xml.writeAttribute("roleRef", "Owner");
+    xml.writeEmptyElement("FunctionMode");
+    xml.writeAttribute("mode", "FABRICATION");
+    xml.writeEmptyElement("StepRef");
+    xml.writeAttribute("name", mBoard.getName());
+    foreach (const QString& layerName, getCopperLayerNames()) {
+        xml.writeEmptyElement("LayerRef");
+        xml.writeAttribute("name", getIpcLayerName(layerName));
+    }
+    xml.writeEmptyElement("LayerRef");
+    xml.writeAttribute("name", "DRILL");
+    xml.writeStartElement("DictionaryStandard");
+    xml.writeAttribute("units", "MILLIMETER");
+    for (auto it = primitives.constBegin(); it != primitives.constEnd(); ++it) {
+        xml.writeStartElement("EntryStandard");
+        xml.writeAttribute("id", it.key());
+        writePrimitive(xml, it.value());
+        xml.writeEndElement(); // EntryStandard
+    }
+    xml.writeEndElement(); // DictionaryStandard
+    xml.writeStartElement("DictionaryLineDesc");
+    xml.writeAttribute("units", "MILLIMETER");
+    for (auto it = lineWidths.constBegin(); it != lineWidths.constEnd(); ++it) {
+        xml.writeStartElement("EntryLineDesc");
+        xml.writeAttribute("id", it.key());
+        xml.writeEmptyElement("LineDesc");
+        xml.writeAttribute("lineEnd", "ROUND");
+        xml.writeAttribute("lineWidth", it.value().toMmString());
+        xml.writeEndElement(); // EntryLineDesc
+    }
+    xml.writeEndElement(); // DictionaryLineDesc
+    xml.writeEndElement(); // Content
+}
+
+void BoardIpc2581Export::writeLogisticHeader(QXmlStreamWriter& xml) const
+{
+    QString author = mProject.getAuthor().isEmpty() ? QString("Unknown") : mProject.getAuthor();
+    xml.writeStartElement("LogisticHeader");
+    xml.writeEmptyElement("Role");
+    xml.writeAttribute("id", "Owner");
+    xml.writeAttribute("roleFunction", "OWNER");
+    xml.writeEmptyElement("Enterprise");
+    xml.writeAttribute("id", author);
+    xml.writeAttribute("code", "NONE");
+    xml.writeEmptyElement("Person");
+    xml.writeAttribute("name", author);
+    xml.writeAttribute("enterpriseRef", author);
+    xml.writeAttribute("roleRef", "Owner");
+    xml.writeEndElement(); // LogisticHeader
+}
+
+void BoardIpc2581Export::writeHistoryRecord(QXmlStreamWriter& xml) const
+{
+    xml.writeStartElement("HistoryRecord");
+    xml.writeAttribute("number", "1");
+    xml.writeAttribute("origination", mProject.getCreated().toUTC().toString(Qt::ISODate));
+    xml.writeAttribute("software", "LibrePCB");
+    xml.writeAttribute("lastChange", mProject.getLastModified().toUTC().toString(Qt::ISODate));
+    xml.writeStartElement("FileRevision");
+    xml.writeAttribute("fileRevisionId", mProject.getVersion());
+    xml.writeAttribute("comment", mProject.getName());
+    xml.writeEmptyElement("SoftwarePackage");
+    xml.writeAttribute("name", "LibrePCB");
+    xml.writeAttribute("revision", qApp->getAppVersion().toStr());
+    xml.writeAttribute("vendor", "LibrePCB");
+    xml.writeEndElement(); // FileRevision
+    xml.writeEndElement(); // HistoryRecord
+}
+
+void BoardIpc2581Export::writeLayers(QXmlStreamWriter& xml) const
+{
+    QStringList layerNames = getCopperLayerNames();
+    foreach (const QString& layerName, layerNames) {
+        xml.writeEmptyElement("Layer");
+        xml.writeAttribute("name", getIpcLayerName(layerName));
+        xml.writeAttribute("layerFunction", "CONDUCTOR");
+        if (layerName == GraphicsLayer::sTopCopper) {
+            xml.writeAttribute("side", "TOP");
+        } else if (layerName == GraphicsLayer::sBotCopper) {
+            xml.writeAttribute("side", "BOTTOM");
+        } else {
+            xml.writeAttribute("side", "INTERNAL");
+        }
+        xml.writeAttribute("polarity", "POSITIVE");
+    }
+    xml.writeStartElement("Layer");
+    xml.writeAttribute("name", "DRILL");
+    xml.writeAttribute("layerFunction", "DRILL");
+    xml.writeAttribute("side", "ALL");
+    xml.writeAttribute("polarity", "POSITIVE");
+    xml.writeEmptyElement("Span");
+    xml.writeAttribute("fromLayer", getIpcLayerName(layerNames.first()));
+    xml.writeAttribute("toLayer", getIpcLayerName(layerNames.last()));
+    xml.writeEndElement(); // Layer
+
+    // LibrePCB does not know the layer thicknesses yet, so the stackup only defines the
+    // order of the copper layers
+    xml.writeStartElement("Stackup");
+    xml.writeAttribute("name", "Stackup");
+    xml.writeAttribute("whereMeasured", "METAL");
+    xml.writeStartElement("StackupGroup");
+    xml.writeAttribute("name", "Group");
+    for (int i = 0; i < layerNames.count(); ++i) {
+        xml.writeEmptyElement("StackupLayer");
+        xml.writeAttribute("layerOrGroupRef", getIpcLayerName(layerNames.at(i)));
+        xml.writeAttribute("sequence", QString::number(i + 1));
+    }
+    xml.writeEndElement(); // StackupGroup
+    xml.writeEndElement(); // Stackup
+}
+
+void BoardIpc2581Export::writeProfile(QXmlStreamWriter& xml) const
+{
+    // the outline with the largest extent is the board profile, all others are cutouts
+    QList<const Polygon*> outlines;
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        if ((polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines)
+            && (polygon->getPolygon().isClosed()))
+        {
+            outlines.append(&polygon->getPolygon());
+        }
+    }
+    if (outlines.isEmpty()) {
+        return;
+    }
+    int profileIndex = 0;
+    qreal profileArea = 0;
+    for (int i = 0; i < outlines.count(); ++i) {
+        QRectF rect = outlines.at(i)->toQPainterPathPx().boundingRect();
+        if (rect.width() * rect.height() > profileArea) {
+            profileArea = rect.width() * rect.height();
+            profileIndex = i;
+        }
+    }
+    xml.writeStartElement("Profile");
+    writePolygon(xml, "Polygon", *outlines.at(profileIndex));
+    for (int i = 0; i < outlines.count(); ++i) {
+        if (i != profileIndex) {
+            writePolygon(xml, "Cutout", *outlines.at(i));
+        }
+    }
+    xml.writeEndElement(); // Profile
+}
+
+void BoardIpc2581Export::writePackages(QXmlStreamWriter& xml) const
+{
+    QSet<QString> writtenPackages;
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        QString packageRef = getPackageRef(*device);
+        if (writtenPackages.contains(packageRef)) {
+            continue;
+        }
+        writtenPackages.insert(packageRef);
+        xml.writeStartElement("Package");
+        xml.writeAttribute("name", packageRef);
+        xml.writeAttribute("type", "OTHER");
+        for (const library::FootprintPad& libPad : device->getLibFootprint().getPads()) {
+            std::shared_ptr<const library::PackagePad> pkgPad =
+                device->getLibPackage().getPads().find(libPad.getPackagePadUuid());
+            xml.writeStartElement("Pin");
+            xml.writeAttribute("number", pkgPad ? pkgPad->getName() : libPad.getUuid().toStr());
+            if (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT) {
+                xml.writeAttribute("type", "THRU");
+            } else {
+                xml.writeAttribute("type", "SURFACE");
+            }
+            xml.writeAttribute("electricalType", "ELECTRICAL");
+            writeXform(xml, libPad.getRotation(), false);
+            writeLocation(xml, libPad.getPosition());
+            xml.writeEmptyElement("StandardPrimitiveRef");
+            xml.writeAttribute("id", getPrimitiveId(getPadPrimitive(libPad)));
+            xml.writeEndElement(); // Pin
+        }
+        xml.writeEndElement(); // Package
+    }
+}
+
+void BoardIpc2581Export::writeComponents(QXmlStreamWriter& xml) const
+{
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        const ComponentInstance& cmp = device->getComponentInstance();
+        bool tht = false;
+        for (const library::FootprintPad& libPad : device->getLibFootprint().getPads()) {
+            if (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT) {
+                tht = true;
+            }
+        }
+        xml.writeStartElement("Component");
+        xml.writeAttribute("refDes", cmp.getName());
+        xml.writeAttribute("packageRef", getPackageRef(*device));
+        xml.writeAttribute("part", cmp.getValue(true));
+        xml.writeAttribute("layerRef", device->getIsMirrored() ? "BOTTOM" : "TOP");
+        xml.writeAttribute("mountType", tht ? "THMT" : "SMT");
+        writeXform(xml, device->getRotation(), device->getIsMirrored());
+        writeLocation(xml, device->getPosition());
+        xml.writeEndElement(); // Component
+    }
+}
+
+void BoardIpc2581Export::writeLogicalNets(QXmlStreamWriter& xml) const
+{
+    // collect the pads of all nets in a single pass over the board
+    QHash<const NetSignal*, QList<const BI_FootprintPad*>> netPads;
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        const BI_Footprint& footprint = device->getFootprint();
+        for (const library::FootprintPad& libPad : device->getLibFootprint().getPads()) {
+            const BI_FootprintPad* pad = footprint.getPad(libPad.getUuid());
+            if (pad && pad->getCompSigInstNetSignal()) {
+                netPads[pad->getCompSigInstNetSignal()].append(pad);
+            }
+        }
+    }
+    foreach (const NetSignal* netsignal, mProject.getCircuit().getNetSignals()) {
+        xml.writeStartElement("LogicalNet");
+        xml.writeAttribute("name", netsignal->getName());
+        foreach (const BI_FootprintPad* pad, netPads.value(netsignal)) {
+            writePinRef(xml, *pad);
+        }
+        xml.writeEndElement(); // LogicalNet
+    }
+}
+
+void BoardIpc2581Export::writeCopperLayerFeatures(QXmlStreamWriter& xml,
+                                                  const QString& layerName) const
+{
+    xml.writeStartElement("LayerFeature");
+    xml.writeAttribute("layerRef", getIpcLayerName(layerName));
+
+    // traces
+    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
+        if (netline->getLayer().getName() != layerName) {
+            continue;
+        }
+        const Point& start = netline->getStartPoint().getPosition();
+        const Point& end = netline->getEndPoint().getPosition();
+        xml.writeStartElement("Set");
+        xml.writeAttribute("net", netline->getNetSignal().getName());
+        xml.writeStartElement("Features");
+        writeLocation(xml, Point(0, 0));
+        xml.writeStartElement("Line");
+        xml.writeAttribute("startX", start.getX().toMmString());
+        xml.writeAttribute("startY", start.getY().toMmString());
+        xml.writeAttribute("endX", end.getX().toMmString());
+        xml.writeAttribute("endY", end.getY().toMmString());
+        xml.writeEmptyElement("LineDescRef");
+        xml.writeAttribute("id", getLineDescId(netline->getWidth()));
+        xml.writeEndElement(); // Line
+        xml.writeEndElement(); // Features
+        xml.writeEndElement(); // Set
+    }
+
+    // footprint pads
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        const BI_Footprint& footprint = device->getFootprint();
+        for (const library::FootprintPad& libPad : device->getLibFootprint().getPads()) {
+            const BI_FootprintPad* pad = footprint.getPad(libPad.getUuid());
+            if ((!pad) || (!pad->isOnLayer(layerName))) {
+                continue;
+            }
+            xml.writeStartElement("Set");
+            if (pad->getCompSigInstNetSignal()) {
+                xml.writeAttribute("net", pad->getCompSigInstNetSignal()->getName());
+            }
+            xml.writeStartElement("Pad");
+            writeXform(xml, pad->getIsMirrored() ? -pad->getRotation() : pad->getRotation(), false);
+            writeLocation(xml, pad->getPosition());
+            xml.writeEmptyElement("StandardPrimitiveRef");
+            xml.writeAttribute("id", getPrimitiveId(getPadPrimitive(libPad)));
+            writePinRef(xml, *pad);
+            xml.writeEndElement(); // Pad
+            xml.writeEndElement(); // Set
+        }
+    }
+
+    // vias
+    foreach (const BI_Via* via, mBoard.getVias()) {
+        if (!via->isOnLayer(layerName)) {
+            continue;
+        }
+        xml.writeStartElement("Set");
+        if (via->getNetSignal()) {
+            xml.writeAttribute("net", via->getNetSignal()->getName());
+        }
+        xml.writeAttribute("padUsage", "VIA");
+        xml.writeStartElement("Pad");
+        writeLocation(xml, via->getPosition());
+        xml.writeEmptyElement("StandardPrimitiveRef");
+        xml.writeAttribute("id", getPrimitiveId(getViaPrimitive(*via)));
+        xml.writeEndElement(); // Pad
+        xml.writeEndElement(); // Set
+    }
+
+    xml.writeEndElement(); // LayerFeature
+}
+
+void BoardIpc2581Export::writeDrillLayerFeatures(QXmlStreamWriter& xml) const
+{
+    int number = 0;
+    auto writeHole = [&](const Point& pos, const Length& dia, const QString& plating,
+                         const NetSignal* netsignal) {
+        xml.writeStartElement("Set");
+        if (netsignal) {
+            xml.writeAttribute("net", netsignal->getName());
+        }
+        xml.writeEmptyElement("Hole");
+        xml.writeAttribute("name", QString("H%1").arg(++number));
+        xml.writeAttribute("diameter", dia.toMmString());
+        xml.writeAttribute("platingStatus", plating);
+        xml.writeAttribute("plusTol", Length(0).toMmString());
+        xml.writeAttribute("minusTol", Length(0).toMmString());
+        xml.writeAttribute("x", pos.getX().toMmString());
+        xml.writeAttribute("y", pos.getY().toMmString());
+        xml.writeEndElement(); // Set
+    };
+
+    xml.writeStartElement("LayerFeature");
+    xml.writeAttribute("layerRef", "DRILL");
+    foreach (const BI_Via* via, mBoard.getVias()) {
+        writeHole(via->getPosition(), via->getDrillDiameter(), "VIA", via->getNetSignal());
+    }
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        const BI_Footprint& footprint = device->getFootprint();
+        for (const library::FootprintPad& libPad : device->getLibFootprint().getPads()) {
+            const BI_FootprintPad* pad = footprint.getPad(libPad.getUuid());
+            if (pad && (libPad.getBoardSide() == library::FootprintPad::BoardSide::THT)) {
+                writeHole(pad->getPosition(), libPad.getDrillDiameter(), "PLATED",
+                          pad->getCompSigInstNetSignal());
+            }
+        }
+        for (const Hole& hole : device->getLibFootprint().getHoles()) {
+            writeHole(footprint.mapToScene(hole.getPosition()), hole.getDiameter(),
+                      "NONPLATED", nullptr);
+        }
+    }
+    xml.writeEndElement(); // LayerFeature
+}
+
+QStringList BoardIpc2581Export::getCopperLayerNames() const noexcept
+{
+    QStringList names;
+    names.append(GraphicsLayer::sTopCopper);
+    for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
+        names.append(GraphicsLayer::getInnerLayerName(i));
+    }
+    names.append(GraphicsLayer::sBotCopper);
+    return names;
+}
+
+QString BoardIpc2581Export::getPackageRef(const BI_Device& device) const noexcept
+{
+    // package names are not unique, but the footprint UUID is
+    QString name = device.getLibPackage().getNames().value(
+                       mProject.getSettings().getLocaleOrder());
+    return QString("%1_%2").arg(name, device.getLibFootprint().getUuid().toStr());
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QString BoardIpc2581Export::getIpcLayerName(const QString& layerName) noexcept
+{
+    if (layerName == GraphicsLayer::sTopCopper) {
+        return "TOP";
+    } else if (layerName == GraphicsLayer::sBotCopper) {
+        return "BOTTOM";
+    } else {
+        // "in1_cu" -> "IN1"
+        return layerName.section('_', 0, 0).toUpper();
+    }
+}
+
+BoardIpc2581Export::Primitive BoardIpc2581Export::getPadPrimitive(
+        const library::FootprintPad& pad) noexcept
+{
+    switch (pad.getShape())
+    {
+        case library::FootprintPad::Shape::ROUND: {
+            if (pad.getWidth() == pad.getHeight()) {
+                return Primitive{Primitive::Type::Circle, pad.getWidth(), pad.getWidth()};
+            } else {
+                return Primitive{Primitive::Type::Oval, pad.getWidth(), pad.getHeight()};
+            }
+        }
+        case library::FootprintPad::Shape::OCTAGON: {
+            // same as in the Gerber export, only the width is taken into account
+            return Primitive{Primitive::Type::Octagon, pad.getWidth(), pad.getWidth()};
+        }
+        case library::FootprintPad::Shape::RECT:
+        default: {
+            return Primitive{Primitive::Type::Rect, pad.getWidth(), pad.getHeight()};
+        }
+    }
+}
+
+BoardIpc2581Export::Primitive BoardIpc2581Export::getViaPrimitive(const BI_Via& via) noexcept
+{
+    switch (via.getShape())
+    {
+        case BI_Via::Shape::Square:
+            return Primitive{Primitive::Type::Rect, via.getSize(), via.getSize()};
+        case BI_Via::Shape::Octagon:
+            return Primitive{Primitive::Type::Octagon, via.getSize(), via.getSize()};
+        case BI_Via::Shape::Round:
+        default:
+            return Primitive{Primitive::Type::Circle, via.getSize(), via.getSize()};
+    }
+}
+
+QString BoardIpc2581Export::getPrimitiveId(const Primitive& primitive) noexcept
+{
+    switch (primitive.type)
+    {
+        case Primitive::Type::Circle:
+            return QString("CIRCLE_%1").arg(primitive.width.toMmString());
+        case Primitive::Type::Oval:
+            return QString("OVAL_%1x%2").arg(primitive.width.toMmString(),
+                                             primitive.height.toMmString());
+        case Primitive::Type::Octagon:
+            return QString("OCTAGON_%1").arg(primitive.width.toMmString());
+        case Primitive::Type::Rect:
+        default:
+            return QString("RECT_%1x%2").arg(primitive.width.toMmString(),
+                                             primitive.height.toMmString());
+    }
+}
+
+QString BoardIpc2581Export::getLineDescId(const Length& width) noexcept
+{
+    return QString("ROUND_%1").arg(width.toMmString());
+}
+
+void BoardIpc2581Export::writePrimitive(QXmlStreamWriter& xml, const Primitive& primitive)
+{
+    switch (primitive.type)
+    {
+        case Primitive::Type::Circle: {
+            xml.writeEmptyElement("Circle");
+            xml.writeAttribute("diameter", primitive.width.toMmString());
+            break;
+        }
+        case Primitive::Type::Oval: {
+            xml.writeEmptyElement("Oval");
+            xml.writeAttribute("width", primitive.width.toMmString());
+            xml.writeAttribute("height", primitive.height.toMmString());
+            break;
+        }
+        case Primitive::Type::Octagon: {
+            // a regular octagon is a square with all four corners chamfered
+            Length chamfer = Length::fromMm(primitive.width.toMm() / (2.0 + qSqrt(2.0)));
+            xml.writeEmptyElement("RectCham");
+            xml.writeAttribute("width", primitive.width.toMmString());
+            xml.writeAttribute("height", primitive.height.toMmString());
+            xml.writeAttribute("chamfer", chamfer.toMmString());
+            xml.writeAttribute("upperRight", "true");
+            xml.writeAttribute("upperLeft", "true");
+            xml.writeAttribute("lowerRight", "true");
+            xml.writeAttribute("lowerLeft", "true");
+            break;
+        }
+        case Primitive::Type::Rect:
+        default: {
+            xml.writeEmptyElement("RectCenter");
+            xml.writeAttribute("width", primitive.width.toMmString());
+            xml.writeAttribute("height", primitive.height.toMmString());
+            break;
+        }
+    }
+}
+
+void BoardIpc2581Export::writePolygon(QXmlStreamWriter& xml, const QString& name,
+                                      const Polygon& polygon)
+{
+    xml.writeStartElement(name);
+    xml.writeEmptyElement("PolyBegin");
+    xml.writeAttribute("x", polygon.getStartPos().getX().toMmString());
+    xml.writeAttribute("y", polygon.getStartPos().getY().toMmString());
+    for (int i = 0; i < polygon.getSegments().count(); ++i) {
+        const PolygonSegment& segment = *polygon.getSegments().value(i);
+        if (segment.getAngle() == 0) {
+            xml.writeEmptyElement("PolyStepSegment");
+        } else {
+            Point center = polygon.calcCenterOfArcSegment(i);
+            xml.writeEmptyElement("PolyStepCurve");
+            xml.writeAttribute("centerX", center.getX().toMmString());
+            xml.writeAttribute("centerY", center.getY().toMmString());
+            xml.writeAttribute("clockwise", (segment.getAngle() < 0) ? "true" : "false");
+        }
+        xml.writeAttribute("x", segment.getEndPos().getX().toMmString());
+        xml.writeAttribute("y", segment.getEndPos().getY().toMmString());
+    }
+    xml.writeEndElement();
+}
+
+void BoardIpc2581Export::writeXform(QXmlStreamWriter& xml, const Angle& rotation, bool mirror)
+{
+    if ((rotation == 0) && (!mirror)) {
+        return;
+    }
+    xml.writeEmptyElement("Xform");
+    xml.writeAttribute("rotation", rotation.mappedTo0_360deg().toDegString());
+    if (mirror) {
+        xml.writeAttribute("mirror", "true");
+    }
+}
+
+void BoardIpc2581Export::writeLocation(QXmlStreamWriter& xml, const Point& pos)
+{
+    xml.writeEmptyElement("Location");
+    xml.writeAttribute("x", pos.getX().toMmString());
+    xml.writeAttribute("y", pos.getY().toMmString());
+}
+
+void BoardIpc2581Export::writePinRef(QXmlStreamWriter& xml, const BI_FootprintPad& pad)
+{
+    std::shared_ptr<const library::PackagePad> pkgPad =
+        pad.getFootprint().getDeviceInstance().getLibPackage().getPads().find(pad.getLibPadUuid());
+    xml.writeEmptyElement("PinRef");
+    xml.writeAttribute("componentRef",
+                       pad.getFootprint().getDeviceInstance().getComponentInstance().getName());
+    xml.writeAttribute("pin", pkgPad ? pkgPad->getName() : pad.getLibPadUuid().toStr());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,158 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDIPC2581EXPORT_H
+#define LIBREPCB_PROJECT_BOARDIPC2581EXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class Polygon;
+
+namespace library {
+class FootprintPad;
+}
+
+namespace project {
+
+class Project;
+class Board;
+class BI_Device;
+class BI_FootprintPad;
+class BI_Via;
+
+/*****************************************************************************************
+ *  Class BoardIpc2581Export
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardIpc2581Export class exports a board as IPC-2581 (revision B) file
+ *
+ * In contrast to Gerber and Excellon files, IPC-2581 contains the whole board in a
+ * single structured file: the layer stack, the board outline, the packages and
+ * components, the nets and all copper features (traces, pads, vias) with their net.
+ *
+ * The XML is written with a QXmlStreamWriter directly into the file while walking
+ * through the board, so the memory usage does not depend on the size of the board
+ * (only the distinct pad shapes and trace widths are collected in advance because
+ * they need to be defined at the beginning of the file).
+ *
+ * @note Solder mask, silkscreen and copper pours are not exported yet.
+ */
+class BoardIpc2581Export final
+{
+        Q_DECLARE_TR_FUNCTIONS(BoardIpc2581Export)
+
+    public:
+
+        // Constructors / Destructor
+        BoardIpc2581Export() = delete;
+        BoardIpc2581Export(const BoardIpc2581Export& other) = delete;
+        explicit BoardIpc2581Export(const Board& board) noexcept;
+        ~BoardIpc2581Export() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Write the IPC-2581 file
+         *
+         * @param filepath  The file to write (parent directories are created if needed)
+         *
+         * @throw Exception if the file could not be written
+         */
+        void exportToFile(const FilePath& filepath) const;
+
+        /**
+         * @brief Write the IPC-2581 XML into an open device
+         *
+         * @param device    An open, writable device
+         *
+         * @throw Exception if the board contains unsupported elements
+         */
+        void generate(QIODevice& device) const;
+
+        // Operator Overloadings
+        BoardIpc2581Export& operator=(const BoardIpc2581Export& rhs) = delete;
+
+
+    private:
+
+        // Types
+
+        /// A pad shape which is referenced by pads, pins and vias (without rotation)
+        struct Primitive {
+            enum class Type {Circle, Oval, Rect, Octagon};
+            Type type;
+            Length width;
+            Length height;
+        };
+
+        // Private Methods
+        void writeContent(QXmlStreamWriter& xml, const QMap<QString, Primitive>& primitives,
+                          const QMap<QString, Length>& lineWidths) const;
+        void writeLogisticHeader(QXmlStreamWriter& xml) const;
+        void writeHistoryRecord(QXmlStreamWriter& xml) const;
+        void writeLayers(QXmlStreamWriter& xml) const;
+        void writeProfile(QXmlStreamWriter& xml) const;
+        void writePackages(QXmlStreamWriter& xml) const;
+        void writeComponents(QXmlStreamWriter& xml) const;
+        void writeLogicalNets(QXmlStreamWriter& xml) const;
+        void writeCopperLayerFeatures(QXmlStreamWriter& xml, const QString& layerName) const;
+        void writeDrillLayerFeatures(QXmlStreamWriter& xml) const;
+        QStringList getCopperLayerNames() const noexcept;
+        QString getPackageRef(const BI_Device& device) const noexcept;
+
+        // Static Methods
+        static QString getIpcLayerName(const QString& layerName) noexcept;
+        static Primitive getPadPrimitive(const library::FootprintPad& pad) noexcept;
+        static Primitive getViaPrimitive(const BI_Via& via) noexcept;
+        static QString getPrimitiveId(const Primitive& primitive) noexcept;
+        static QString getLineDescId(const Length& width) noexcept;
+        static void writePrimitive(QXmlStreamWriter& xml, const Primitive& primitive);
+        static void writePolygon(QXmlStreamWriter& xml, const QString& name,
+                                 const Polygon& polygon);
+        static void writeXform(QXmlStreamWriter& xml, const Angle& rotation, bool mirror);
+        static void writeLocation(QXmlStreamWriter& xml, const Point& pos);
+        static void writePinRef(QXmlStreamWriter& xml, const BI_FootprintPad& pad);
+
+
+        // Private Member Variables
+        const Project& mProject;
+        const Board& mBoard;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDIPC2581EXPORT_H
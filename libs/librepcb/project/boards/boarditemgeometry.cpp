@@ -0,0 +1,225 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boarditemgeometry.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardItemGeometry::BoardItemGeometry() noexcept :
+    mPoints(), mRadius(0), mCachedClearance(-1), mCachedTolerance(-1)
+{
+}
+
+BoardItemGeometry::BoardItemGeometry(const QVector<Point>& points,
+                                     const Length& radius) noexcept :
+    mPoints(points), mRadius(radius), mCachedClearance(-1), mCachedTolerance(-1)
+{
+    if ((mPoints.count() >= 3) && (PolygonClipper::calcArea(mPoints) < 0)) {
+        std::reverse(mPoints.begin(), mPoints.end());
+    }
+}
+
+BoardItemGeometry::~BoardItemGeometry() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+BoardItemGeometry BoardItemGeometry::translated(const Point& offset) const noexcept
+{
+    QVector<Point> points = mPoints;
+    for (Point& p : points) {
+        p += offset;
+    }
+    return BoardItemGeometry(points, mRadius);
+}
+
+const PolygonClipper::Path& BoardItemGeometry::getOutline(const Length& clearance,
+    const Length& tolerance) const noexcept
+{
+    if ((clearance != mCachedClearance) || (tolerance != mCachedTolerance)) {
+        mCachedOutline = calcOutline(clearance, tolerance);
+        mCachedClearance = clearance;
+        mCachedTolerance = tolerance;
+    }
+    return mCachedOutline;
+}
+
+QPainterPath BoardItemGeometry::toQPainterPathPx(const Length& clearance) const noexcept
+{
+    QPainterPath path;
+    Length radius = mRadius + clearance;
+    if ((mPoints.count() == 1) && (radius > 0)) {
+        path.addEllipse(mPoints.first().toPxQPointF(), radius.toPx(), radius.toPx());
+    } else if (!mPoints.isEmpty()) {
+        // a tolerance of 1um is not visible at all, even at the highest zoom level
+        QPolygonF polygon;
+        foreach (const Point& p, (radius > 0) ? calcOutline(clearance, Length(1000)) : mPoints) {
+            polygon.append(p.toPxQPointF());
+        }
+        if (polygon.count() >= 3) {
+            path.addPolygon(polygon);
+            path.closeSubpath();
+        }
+    }
+    return path;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+BoardItemGeometry BoardItemGeometry::line(const Point& p1, const Point& p2,
+                                          const Length& width) noexcept
+{
+    if (p1 == p2) {
+        return BoardItemGeometry({p1}, width / 2);
+    } else {
+        return BoardItemGeometry({p1, p2}, width / 2);
+    }
+}
+
+BoardItemGeometry BoardItemGeometry::circle(const Point& center,
+                                            const Length& diameter) noexcept
+{
+    return BoardItemGeometry({center}, diameter / 2);
+}
+
+BoardItemGeometry BoardItemGeometry::obround(const Point& center, const Length& width,
+    const Length& height, const Angle& rotation, bool mirror) noexcept
+{
+    // a line with round ends along the longer side
+    Length l = (width - height).abs() / 2;
+    if (l == 0) {
+        return circle(center, width);
+    }
+    Point offset = (width > height) ? Point(l, Length(0)) : Point(Length(0), l);
+    return BoardItemGeometry(transformed({-offset, offset}, center, rotation, mirror),
+                             qMin(width, height) / 2);
+}
+
+BoardItemGeometry BoardItemGeometry::rect(const Point& center, const Length& width,
+    const Length& height, const Angle& rotation, bool mirror) noexcept
+{
+    Length w = width / 2, h = height / 2;
+    QVector<Point> points{Point(-w, -h), Point(w, -h), Point(w, h), Point(-w, h)};
+    return BoardItemGeometry(transformed(points, center, rotation, mirror), Length(0));
+}
+
+BoardItemGeometry BoardItemGeometry::octagon(const Point& center, const Length& width,
+    const Length& height, const Angle& rotation, bool mirror) noexcept
+{
+    Length w = width / 2, h = height / 2;
+    Length size = qMin(width, height);
+    Length c(qRound64((size.toNm() - size.toNm() / (1 + M_SQRT2)) / 2));
+    QVector<Point> points{Point(-w + c, -h), Point(w - c, -h), Point(w, -h + c),
+                          Point(w, h - c), Point(w - c, h), Point(-w + c, h),
+                          Point(-w, h - c), Point(-w, -h + c)};
+    return BoardItemGeometry(transformed(points, center, rotation, mirror), Length(0));
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+PolygonClipper::Path BoardItemGeometry::calcOutline(const Length& clearance,
+    const Length& tolerance) const noexcept
+{
+    Length radius = mRadius + clearance;
+    if (mPoints.isEmpty() || (radius < 0)) {
+        return PolygonClipper::Path();
+    } else if (mPoints.count() == 1) {
+        return PolygonClipper::createCircle(mPoints.first(), radius, tolerance);
+    } else if (radius == 0) {
+        // lines without width have no area
+        return (mPoints.count() >= 3) ? mPoints : PolygonClipper::Path();
+    }
+
+    // Replace every vertex of the (convex, counter-clockwise) skeleton by an arc around
+    // it, from the normal of its incoming edge to the normal of its outgoing edge. The
+    // arcs are approximated by edges which are tangent to the circle (like
+    // librepcb::PolygonClipper::createCircle()), so the outline contains the exact area.
+    // A line is handled as a polygon with two vertices: its edges run in both directions,
+    // so every end gets a half circle.
+    qreal r = radius.toNm();
+    qreal tol = qMax(tolerance.toNm(), LengthBase_t(1));
+    qreal maxStep = qMin(2 * qAcos(r / (r + tol)), M_PI / 4);
+    PolygonClipper::Path outline;
+    int count = mPoints.count();
+    for (int i = 0; i < count; ++i) {
+        const Point& prev = mPoints.at((i + count - 1) % count);
+        const Point& current = mPoints.at(i);
+        const Point& next = mPoints.at((i + 1) % count);
+        Point in = current - prev;
+        Point out = next - current;
+        // outward normals of counter-clockwise edges (dx, dy) are (dy, -dx)
+        qreal startAngle = qAtan2(-in.getX().toNm(), in.getY().toNm());
+        qreal endAngle = qAtan2(-out.getX().toNm(), out.getY().toNm());
+        qreal sweep = endAngle - startAngle;
+        while (sweep < 0) sweep += 2 * M_PI;
+        auto vertex = [&](qreal angle, qreal distance) {
+            return current + Point(Length(qRound64(distance * qCos(angle))),
+                                   Length(qRound64(distance * qSin(angle))));
+        };
+        outline.append(vertex(startAngle, r + 1)); // +1nm for the rounding
+        int segments = qCeil(sweep / maxStep);
+        if (segments > 0) {
+            qreal step = sweep / segments;
+            qreal outerRadius = r / qCos(step / 2) + 1;
+            for (int k = 0; k < segments; ++k) {
+                outline.append(vertex(startAngle + step / 2 + k * step, outerRadius));
+            }
+            outline.append(vertex(endAngle, r + 1));
+        }
+    }
+    return outline;
+}
+
+QVector<Point> BoardItemGeometry::transformed(QVector<Point> points, const Point& center,
+                                              const Angle& rotation, bool mirror) noexcept
+{
+    for (Point& p : points) {
+        p.rotate(rotation);
+        if (mirror) p.mirror(Qt::Horizontal);
+        p += center;
+    }
+    return points;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDITEMGEOMETRY_H
+#define LIBREPCB_PROJECT_BOARDITEMGEOMETRY_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcb/common/geometry/polygonclipper.h>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Class BoardItemGeometry
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardItemGeometry class describes the copper area of a pad, via or trace
+ *
+ * The area is represented in nanometers (scene coordinates) as a convex "skeleton"
+ * which is grown by a radius:
+ *  - One point: A circle with the radius (round vias and pads).
+ *  - Two points: A line with round ends (traces and obround pads).
+ *  - Three or more points: A convex polygon with its corners rounded by the radius
+ *    (usually zero, e.g. for rectangular or octagonal pads).
+ *
+ * This representation does not depend on any graphics items, so it can be used by
+ * headless algorithms (e.g. the design rule check, copper pours or CAM exports) and by
+ * the graphics items alike. An area grown by a clearance is simply the same skeleton
+ * with a larger radius, its polygonal outline is created by #getOutline().
+ *
+ * The board items keep their geometry up to date (e.g.
+ * librepcb::project::BI_Via::getGeometry()), and the outline of the last requested
+ * clearance is cached. The cache is not synchronized, so the geometry of board items
+ * must only be used from the main thread (copy it to pass it to worker threads).
+ */
+class BoardItemGeometry final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardItemGeometry() noexcept;
+        BoardItemGeometry(const BoardItemGeometry& other) = default;
+        BoardItemGeometry(const QVector<Point>& points, const Length& radius) noexcept;
+        ~BoardItemGeometry() noexcept;
+
+        // Getters
+        bool isEmpty() const noexcept {return mPoints.isEmpty();}
+        const QVector<Point>& getPoints() const noexcept {return mPoints;}
+        const Length& getRadius() const noexcept {return mRadius;}
+
+        // General Methods
+
+        /**
+         * @brief Get the same geometry moved by an offset
+         */
+        BoardItemGeometry translated(const Point& offset) const noexcept;
+
+        /**
+         * @brief Get the outline of the area grown by a clearance
+         *
+         * The rounded corners are approximated so that the outline always contains the
+         * exact area, i.e. it is the conservative choice for clearances.
+         *
+         * @param clearance     The distance to grow the area (must not be negative)
+         * @param tolerance     Maximum deviation of the approximated arcs
+         *
+         * @return A counter-clockwise outline (empty if the area is empty)
+         */
+        const PolygonClipper::Path& getOutline(const Length& clearance,
+                                               const Length& tolerance = Length(5000)) const noexcept;
+
+        /**
+         * @brief Get the area grown by a clearance as a QPainterPath in pixels
+         */
+        QPainterPath toQPainterPathPx(const Length& clearance = Length(0)) const noexcept;
+
+        // Operator Overloadings
+        BoardItemGeometry& operator=(const BoardItemGeometry& rhs) = default;
+        bool operator==(const BoardItemGeometry& rhs) const noexcept {
+            return (mPoints == rhs.mPoints) && (mRadius == rhs.mRadius);
+        }
+        bool operator!=(const BoardItemGeometry& rhs) const noexcept {return !(*this == rhs);}
+
+        // Static Methods
+        static BoardItemGeometry line(const Point& p1, const Point& p2,
+                                      const Length& width) noexcept;
+        static BoardItemGeometry circle(const Point& center, const Length& diameter) noexcept;
+
+        /**
+         * @brief Create a pad shape
+         *
+         * The shape is rotated first and then mirrored horizontally (if requested)
+         * around its center, like the footprint pads of a mirrored device.
+         *
+         * @param center    The position of the pad
+         * @param width     The width of the pad (before the rotation)
+         * @param height    The height of the pad (before the rotation)
+         * @param rotation  The rotation of the pad
+         * @param mirror    Whether to mirror the shape horizontally
+         */
+        static BoardItemGeometry obround(const Point& center, const Length& width,
+                                         const Length& height, const Angle& rotation,
+                                         bool mirror) noexcept;
+        static BoardItemGeometry rect(const Point& center, const Length& width,
+                                      const Length& height, const Angle& rotation,
+                                      bool mirror) noexcept;
+
+        /**
+         * @brief Create an octagon whose straight edges touch the bounding rectangle
+         *
+         * (the corners are cut at 45 degrees, with the same cut size for all corners
+         * if width and height are different)
+         */
+        static BoardItemGeometry octagon(const Point& center, const Length& width,
+                                         const Length& height, const Angle& rotation,
+                                         bool mirror) noexcept;
+
+
+    private: // Methods
+
+        PolygonClipper::Path calcOutline(const Length& clearance,
+                                         const Length& tolerance) const noexcept;
+        static QVector<Point> transformed(QVector<Point> points, const Point& center,
+                                          const Angle& rotation, bool mirror) noexcept;
+
+
+    private: // Data
+
+        QVector<Point> mPoints; ///< the skeleton, convex polygons counter-clockwise
+        Length mRadius;
+
+        // Cached outline (see #getOutline())
+        mutable Length mCachedClearance; ///< -1 if nothing cached yet
+        mutable Length mCachedTolerance;
+        mutable PolygonClipper::Path mCachedOutline;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDITEMGEOMETRY_H
@@ -41,10 +41,6 @@ BoardLayerStack::BoardLayerStack(Board& board, const BoardLayerStack& other) :
     foreach (const GraphicsLayer* layer, other.mLayers) {
         addLayer(new GraphicsLayer(*layer));
     }
-
-    connect(&mBoard, &Board::attributesChanged,
-            this, &BoardLayerStack::boardAttributesChanged,
-            Qt::QueuedConnection);
 }
 
 BoardLayerStack::BoardLayerStack(Board& board, const DomElement& domElement) :
@@ -53,10 +49,6 @@ BoardLayerStack::BoardLayerStack(Board& board, const DomElement& domElement) :
     addAllLayers();
 
     setInnerLayerCount(domElement.getAttribute<uint>("inner", true));
-
-    connect(&mBoard, &Board::attributesChanged,
-            this, &BoardLayerStack::boardAttributesChanged,
-            Qt::QueuedConnection);
 }
 
 BoardLayerStack::BoardLayerStack(Board& board) :
@@ -65,14 +57,11 @@ BoardLayerStack::BoardLayerStack(Board& board) :
     addAllLayers();
 
     setInnerLayerCount(0);
-
-    connect(&mBoard, &Board::attributesChanged,
-            this, &BoardLayerStack::boardAttributesChanged,
-            Qt::QueuedConnection);
 }
 
 BoardLayerStack::~BoardLayerStack() noexcept
 {
+    mLayersByName.clear();
     qDeleteAll(mLayers); mLayers.clear();
 }
 
@@ -82,14 +71,24 @@ BoardLayerStack::~BoardLayerStack() noexcept
 
 void BoardLayerStack::setInnerLayerCount(int count) noexcept
 {
-    if ((count >= 0) && (count != mInnerLayerCount)) {
-        mInnerLayerCount = count;
-        for (GraphicsLayer* layer : mLayers) {
-            if (layer->isInnerLayer() && layer->isCopperLayer()) {
-                layer->setEnabled(layer->getInnerLayerNumber() <= mInnerLayerCount);
-            }
+    if ((count < 0) || (count == mInnerLayerCount)) {
+        return;
+    }
+
+    if (mInnerLayerCount < 0) {
+        // initialization: all layers have just been created (enabled)
+        for (int i = 1; i <= GraphicsLayer::getInnerLayerCount(); ++i) {
+            GraphicsLayer* layer = getLayer(GraphicsLayer::getInnerLayerName(i));
+            if (layer) layer->setEnabled(i <= count);
+        }
+    } else {
+        // only the added or removed layers (and the items on them) are affected
+        for (int i = qMin(count, mInnerLayerCount) + 1; i <= qMax(count, mInnerLayerCount); ++i) {
+            GraphicsLayer* layer = getLayer(GraphicsLayer::getInnerLayerName(i));
+            if (layer) layer->setEnabled(i <= count);
         }
     }
+    mInnerLayerCount = count;
 }
 
 /*****************************************************************************************
@@ -108,14 +107,16 @@ void BoardLayerStack::serialize(DomElement& root) const
 void BoardLayerStack::layerAttributesChanged() noexcept
 {
     if (!mLayersChanged) {
-        emit mBoard.attributesChanged();
+        // coalesce the changes of all layers which are modified at once
         mLayersChanged = true;
+        QMetaObject::invokeMethod(this, "emitLayersChanged", Qt::QueuedConnection);
     }
 }
 
-void BoardLayerStack::boardAttributesChanged() noexcept
+void BoardLayerStack::emitLayersChanged() noexcept
 {
     mLayersChanged = false;
+    emit layersChanged();
 }
 
 /*****************************************************************************************
@@ -126,6 +127,7 @@ void BoardLayerStack::addAllLayers() noexcept
 {
     // asymmetric board layers
     addLayer(GraphicsLayer::sBoardSheetFrames);
+    addLayer(GraphicsLayer::sBoardAirWires);
     addLayer(GraphicsLayer::sBoardOutlines);
     addLayer(GraphicsLayer::sBoardMillingPth);
     addLayer(GraphicsLayer::sBoardDrillsNpth);
@@ -188,6 +190,7 @@ void BoardLayerStack::addLayer(GraphicsLayer* layer) noexcept
             this, &BoardLayerStack::layerAttributesChanged,
             Qt::QueuedConnection);
     mLayers.append(layer);
+    mLayersByName.insert(layer->getName(), layer);
 }
 
 /*****************************************************************************************
@@ -42,6 +42,11 @@ class Board;
 
 /**
  * @brief The BoardLayerStack class provides and manages all available layers of a board
+ *
+ * All inner copper layers exist for the whole lifetime of the layer stack, the inner
+ * layer count only enables or disables them. So changing the layer stack never creates
+ * or destroys layers. Every layer notifies only its own observers (i.e. the items on
+ * this layer), and changes of the layers do not touch any other board items.
  */
 class BoardLayerStack final : public QObject, public SerializableObject,
                               public IF_GraphicsLayerProvider
@@ -67,15 +72,18 @@ class BoardLayerStack final : public QObject, public SerializableObject,
 
         /// @copydoc IF_BoardLayerProvider#getLayer()
         GraphicsLayer* getLayer(const QString& name) const noexcept override {
-            foreach (GraphicsLayer* layer, mLayers) {
-                if (layer->getName() == name) {
-                    return layer;
-                }
-            }
-            return nullptr;
+            return mLayersByName.value(name, nullptr);
         }
 
         // Setters
+
+        /**
+         * @brief Set the count of enabled inner copper layers
+         *
+         * Only the layers between the old and the new count are enabled or disabled.
+         *
+         * @param count     The new inner layer count (negative values are ignored)
+         */
         void setInnerLayerCount(int count) noexcept;
 
         // General Methods
@@ -87,9 +95,20 @@ class BoardLayerStack final : public QObject, public SerializableObject,
         BoardLayerStack& operator=(const BoardLayerStack& rhs) = delete;
 
 
+    signals:
+
+        /**
+         * @brief The inner layer count or the attributes of any layer have changed
+         *
+         * This signal is deferred and emitted only once for many modifications, so it
+         * can be used to update views which show all layers (e.g. a list of the layers).
+         */
+        void layersChanged();
+
+
     private slots:
         void layerAttributesChanged() noexcept;
-        void boardAttributesChanged() noexcept;
+        void emitLayersChanged() noexcept;
 
 
     private:
@@ -101,7 +120,8 @@ class BoardLayerStack final : public QObject, public SerializableObject,
         // General
         Board& mBoard; ///< A reference to the Board object (from the ctor)
         QList<GraphicsLayer*> mLayers;
-        bool mLayersChanged;
+        QHash<QString, GraphicsLayer*> mLayersByName; ///< same layers as #mLayers
+        bool mLayersChanged; ///< #layersChanged() is about to be emitted
 
         // Settings
         int mInnerLayerCount;
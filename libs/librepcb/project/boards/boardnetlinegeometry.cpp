@@ -0,0 +1,120 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardnetlinegeometry.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardNetLineGeometry::BoardNetLineGeometry() noexcept
+{
+}
+
+BoardNetLineGeometry::~BoardNetLineGeometry() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardNetLineGeometry::update(const BI_NetLine& netline) noexcept
+{
+    int index = mIndices.value(&netline, -1);
+    if (netline.isAddedToBoard()) {
+        if (index < 0) {
+            index = mNetLines.count();
+            mIndices.insert(&netline, index);
+            mNetLines.append(&netline);
+            mX1.append(0);
+            mY1.append(0);
+            mX2.append(0);
+            mY2.append(0);
+            mWidths.append(0);
+            mLayers.append(nullptr);
+            mNetSignals.append(nullptr);
+        }
+        set(index, netline);
+    } else if (index >= 0) {
+        removeAt(index);
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardNetLineGeometry::set(int index, const BI_NetLine& netline) noexcept
+{
+    const Point& p1 = netline.getStartPoint().getPosition();
+    const Point& p2 = netline.getEndPoint().getPosition();
+    mX1[index] = p1.getX().toNm();
+    mY1[index] = p1.getY().toNm();
+    mX2[index] = p2.getX().toNm();
+    mY2[index] = p2.getY().toNm();
+    mWidths[index] = netline.getWidth().toNm();
+    mLayers[index] = &netline.getLayer();
+    mNetSignals[index] = &netline.getNetSignal();
+}
+
+void BoardNetLineGeometry::removeAt(int index) noexcept
+{
+    // move the last element to the removed index to keep the arrays contiguous
+    int last = mNetLines.count() - 1;
+    mIndices.remove(mNetLines.at(index));
+    if (index != last) {
+        mNetLines[index] = mNetLines.at(last);
+        mX1[index] = mX1.at(last);
+        mY1[index] = mY1.at(last);
+        mX2[index] = mX2.at(last);
+        mY2[index] = mY2.at(last);
+        mWidths[index] = mWidths.at(last);
+        mLayers[index] = mLayers.at(last);
+        mNetSignals[index] = mNetSignals.at(last);
+        mIndices.insert(mNetLines.at(index), index);
+    }
+    mNetLines.removeLast();
+    mX1.removeLast();
+    mY1.removeLast();
+    mX2.removeLast();
+    mY2.removeLast();
+    mWidths.removeLast();
+    mLayers.removeLast();
+    mNetSignals.removeLast();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
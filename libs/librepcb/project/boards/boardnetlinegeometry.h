@@ -0,0 +1,125 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDNETLINEGEOMETRY_H
+#define LIBREPCB_PROJECT_BOARDNETLINEGEOMETRY_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class GraphicsLayer;
+
+namespace project {
+
+class BI_NetLine;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BoardNetLineGeometry
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardNetLineGeometry class keeps a flat copy of the geometry of all netlines
+ *        which are added to a board
+ *
+ * The geometry is stored as a "structure of arrays": the start and end coordinates, the
+ * width, the layer and the net signal of the netline at index `i` are stored at index `i`
+ * of separate, contiguous arrays. Algorithms which scan all traces of a board (e.g. the
+ * design rule check or the copper pour obstacles) can iterate over these arrays instead
+ * of following the pointers from every netline to its netpoints.
+ *
+ * The arrays are kept up to date incrementally: netlines call
+ * librepcb::project::Board::updateNetLineGeometry() whenever they are added to or removed
+ * from the board, or their geometry has changed.
+ *
+ * @note The order of the netlines in the arrays is not stable, removing a netline moves
+ *       the last netline to its index. Use #getNetLines() to map an index to its netline.
+ */
+class BoardNetLineGeometry final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardNetLineGeometry() noexcept;
+        BoardNetLineGeometry(const BoardNetLineGeometry& other) = delete;
+        ~BoardNetLineGeometry() noexcept;
+
+        // Getters
+        int getCount() const noexcept {return mNetLines.count();}
+        const QVector<const BI_NetLine*>& getNetLines() const noexcept {return mNetLines;}
+        const QVector<LengthBase_t>& getX1() const noexcept {return mX1;}
+        const QVector<LengthBase_t>& getY1() const noexcept {return mY1;}
+        const QVector<LengthBase_t>& getX2() const noexcept {return mX2;}
+        const QVector<LengthBase_t>& getY2() const noexcept {return mY2;}
+        const QVector<LengthBase_t>& getWidths() const noexcept {return mWidths;}
+        const QVector<const GraphicsLayer*>& getLayers() const noexcept {return mLayers;}
+        const QVector<const NetSignal*>& getNetSignals() const noexcept {return mNetSignals;}
+
+        // General Methods
+
+        /**
+         * @brief Add, update or remove the geometry of a netline
+         *
+         * If the netline is added to the board, its geometry is inserted or updated,
+         * otherwise it is removed (if it was inserted before).
+         *
+         * @param netline   The netline which was added, removed or modified
+         */
+        void update(const BI_NetLine& netline) noexcept;
+
+        // Operator Overloadings
+        BoardNetLineGeometry& operator=(const BoardNetLineGeometry& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        void set(int index, const BI_NetLine& netline) noexcept;
+        void removeAt(int index) noexcept;
+
+
+        QHash<const BI_NetLine*, int> mIndices; ///< the array index of every netline
+
+        // Arrays (all with the same size)
+        QVector<const BI_NetLine*> mNetLines;
+        QVector<LengthBase_t> mX1;
+        QVector<LengthBase_t> mY1;
+        QVector<LengthBase_t> mX2;
+        QVector<LengthBase_t> mY2;
+        QVector<LengthBase_t> mWidths;
+        QVector<const GraphicsLayer*> mLayers;
+        QVector<const NetSignal*> mNetSignals;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDNETLINEGEOMETRY_H
@@ -0,0 +1,141 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardnetstatistics.h"
+#include "board.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_via.h"
+#include "../circuit/netsignal.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardNetStatistics::BoardNetStatistics(Board& board) noexcept :
+    QObject(&board), mBoard(board)
+{
+    mChangedTimer.setSingleShot(true);
+    mChangedTimer.setInterval(0);
+    connect(&mChangedTimer, &QTimer::timeout, this, &BoardNetStatistics::statisticsChanged);
+}
+
+BoardNetStatistics::~BoardNetStatistics() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+BoardNetStatistics::Statistics BoardNetStatistics::getStatistics(
+        const Uuid& netsignal) const noexcept
+{
+    return mStatistics.value(netsignal, Statistics{Length(0), 0, 0, {}});
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardNetStatistics::update(const BI_NetLine& netline) noexcept
+{
+    auto it = mNetLines.find(&netline);
+    if (it != mNetLines.end()) {
+        add(it.value(), -1);
+        mNetLines.erase(it);
+    }
+    if (netline.isAddedToBoard()) {
+        Contribution contribution{netline.getNetSignal().getUuid(),
+                                  netline.getLayer().getName(), netline.getLength()};
+        add(contribution, 1);
+        mNetLines.insert(&netline, contribution);
+    }
+    scheduleStatisticsChanged();
+}
+
+void BoardNetStatistics::update(const BI_Via& via) noexcept
+{
+    auto it = mVias.find(&via);
+    if (it != mVias.end()) {
+        add(it.value(), -1);
+        mVias.erase(it);
+    }
+    if (via.isAddedToBoard() && via.getNetSignal()) {
+        Contribution contribution{via.getNetSignal()->getUuid(), QString(), Length(0)};
+        add(contribution, 1);
+        mVias.insert(&via, contribution);
+    }
+    scheduleStatisticsChanged();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardNetStatistics::add(const Contribution& contribution, int sign) noexcept
+{
+    auto it = mStatistics.find(contribution.netsignal);
+    if (it == mStatistics.end()) {
+        it = mStatistics.insert(contribution.netsignal, Statistics{Length(0), 0, 0, {}});
+    }
+    Statistics& statistics = it.value();
+    if (contribution.layerName.isEmpty()) {
+        statistics.viaCount += sign;
+    } else {
+        statistics.netLineCount += sign;
+        statistics.length += contribution.length * sign;
+        Length& layerLength = statistics.layerLengths[contribution.layerName];
+        layerLength += contribution.length * sign;
+        if (layerLength == 0) {
+            statistics.layerLengths.remove(contribution.layerName);
+        }
+    }
+
+    // forget net signals without copper (they may be removed from the circuit)
+    if ((statistics.netLineCount == 0) && (statistics.viaCount == 0)) {
+        mStatistics.erase(it);
+    }
+}
+
+void BoardNetStatistics::scheduleStatisticsChanged() noexcept
+{
+    if (!mChangedTimer.isActive()) {
+        mChangedTimer.start();
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
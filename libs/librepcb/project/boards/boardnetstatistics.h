@@ -0,0 +1,137 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDNETSTATISTICS_H
+#define LIBREPCB_PROJECT_BOARDNETSTATISTICS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_NetLine;
+class BI_Via;
+
+/*****************************************************************************************
+ *  Class BoardNetStatistics
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardNetStatistics class provides the routed length, the via count and the
+ *        layer usage of every net signal of a board
+ *
+ * The statistics are accumulated incrementally: board items call
+ * librepcb::project::Board::updateNetStatistics() whenever they are added, removed or
+ * their geometry has changed. For every netline and via, the last contribution (net
+ * signal, layer and length) is remembered, so a change only subtracts the old and adds
+ * the new contribution instead of scanning all netlines of the board. Thus querying the
+ * statistics (e.g. for the attribute "${NET::GND::LENGTH}") is cheap in any case.
+ *
+ * The signal #statisticsChanged() is emitted only once when control returns to the
+ * event loop, even if many items were changed (e.g. while moving a footprint).
+ */
+class BoardNetStatistics final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        struct Statistics {
+            Length length;                      ///< total length of all traces
+            int netLineCount;                   ///< count of traces
+            int viaCount;                       ///< count of vias
+            QMap<QString, Length> layerLengths; ///< trace length per copper layer name
+        };
+
+        // Constructors / Destructor
+        BoardNetStatistics() = delete;
+        BoardNetStatistics(const BoardNetStatistics& other) = delete;
+        explicit BoardNetStatistics(Board& board) noexcept;
+        ~BoardNetStatistics() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the statistics of a net signal (all zero if it has no copper)
+         */
+        Statistics getStatistics(const Uuid& netsignal) const noexcept;
+
+        /**
+         * @brief Get the UUIDs of all net signals which have traces or vias on the board
+         */
+        QList<Uuid> getNetSignals() const noexcept {return mStatistics.keys();}
+
+        // General Methods
+        void update(const BI_NetLine& netline) noexcept;
+        void update(const BI_Via& via) noexcept;
+
+        // Operator Overloadings
+        BoardNetStatistics& operator=(const BoardNetStatistics& rhs) = delete;
+
+
+    signals:
+
+        void statisticsChanged();
+
+
+    private:
+
+        // Types
+
+        /// The part of the statistics which is caused by a single netline or via
+        struct Contribution {
+            Uuid netsignal;
+            QString layerName;  ///< empty for vias
+            Length length;      ///< zero for vias
+        };
+
+        // Private Methods
+        void add(const Contribution& contribution, int sign) noexcept;
+        void scheduleStatisticsChanged() noexcept;
+
+
+        // General
+        Board& mBoard;
+        QTimer mChangedTimer; ///< to emit #statisticsChanged() only once after many changes
+
+        // Accumulated Attributes
+        QHash<const BI_NetLine*, Contribution> mNetLines;
+        QHash<const BI_Via*, Contribution> mVias;
+        QHash<Uuid, Statistics> mStatistics;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDNETSTATISTICS_H
@@ -0,0 +1,82 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardpickplaceexport.h"
+#include <librepcb/common/cam/pickplacegenerator.h>
+#include <librepcb/library/pkg/package.h>
+#include "../project.h"
+#include "../settings/projectsettings.h"
+#include "../circuit/componentinstance.h"
+#include "board.h"
+#include "items/bi_device.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardPickPlaceExport::BoardPickPlaceExport(const Board& board) noexcept :
+    mBoard(board)
+{
+}
+
+BoardPickPlaceExport::~BoardPickPlaceExport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardPickPlaceExport::addParts(PickPlaceGenerator& gen) const noexcept
+{
+    QStringList localeOrder = mBoard.getProject().getSettings().getLocaleOrder();
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        const ComponentInstance& cmp = device->getComponentInstance();
+        gen.addPart(PickPlaceGenerator::Part{cmp.getName(), cmp.getValue(true),
+            device->getLibPackage().getNames().value(localeOrder),
+            device->getPosition(), device->getRotation(),
+            device->getIsMirrored() ? PickPlaceGenerator::BoardSide::Bottom
+                                    : PickPlaceGenerator::BoardSide::Top});
+    }
+}
+
+void BoardPickPlaceExport::exportToFile(const FilePath& filepath) const
+{
+    PickPlaceGenerator gen;
+    addParts(gen);
+    gen.saveToFile(filepath); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,95 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDPICKPLACEEXPORT_H
+#define LIBREPCB_PROJECT_BOARDPICKPLACEEXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class PickPlaceGenerator;
+
+namespace project {
+
+class Board;
+
+/*****************************************************************************************
+ *  Class BoardPickPlaceExport
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardPickPlaceExport class exports the pick-and-place file of a board
+ *
+ * All devices of the board are exported with the position and rotation of their
+ * footprint. Mirrored devices are placed on the bottom side. See
+ * librepcb::PickPlaceGenerator for the file format.
+ */
+class BoardPickPlaceExport final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardPickPlaceExport() = delete;
+        BoardPickPlaceExport(const BoardPickPlaceExport& other) = delete;
+        explicit BoardPickPlaceExport(const Board& board) noexcept;
+        ~BoardPickPlaceExport() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Fill a generator with all parts of the board
+         */
+        void addParts(PickPlaceGenerator& gen) const noexcept;
+
+        /**
+         * @brief Write the pick-and-place CSV file
+         *
+         * @param filepath  The file to write (parent directories are created if needed)
+         *
+         * @throw Exception if the file could not be written
+         */
+        void exportToFile(const FilePath& filepath) const;
+
+        // Operator Overloadings
+        BoardPickPlaceExport& operator=(const BoardPickPlaceExport& rhs) = delete;
+
+
+    private:
+
+        const Board& mBoard;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDPICKPLACEEXPORT_H
@@ -0,0 +1,98 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardruletable.h"
+#include "board.h"
+#include "../project.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netclass.h"
+#include "../circuit/netsignal.h"
+#include <librepcb/common/boarddesignrules.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+constexpr int BoardRuleTable::NoNetClass;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardRuleTable::BoardRuleTable(const Board& board) noexcept :
+    mNetClassCount(1)
+{
+    const BoardDesignRules& designRules = board.getDesignRules();
+    QVector<Length> clearances;
+
+    // ID 0: copper without net signal
+    mRules.append(Rules{Length(0), Length(0), Length(0)});
+    clearances.append(designRules.getMinCopperClearance());
+
+    // all net classes (in a deterministic order)
+    foreach (const NetClass* netclass, board.getProject().getCircuit().getNetClasses()) {
+        mNetClassIds.insert(netclass, mNetClassCount++);
+        mRules.append(Rules{netclass->getTraceWidth(), netclass->getViaSize(),
+                            netclass->getViaDrillDiameter()});
+        clearances.append(qMax(netclass->getClearance(),
+                               designRules.getMinCopperClearance()));
+    }
+
+    // the clearance between two net classes is the larger one of both
+    mClearances.resize(mNetClassCount * mNetClassCount);
+    mMaxClearance = 0;
+    for (int a = 0; a < mNetClassCount; ++a) {
+        for (int b = 0; b < mNetClassCount; ++b) {
+            mClearances[a * mNetClassCount + b] = qMax(clearances.at(a), clearances.at(b));
+        }
+        mMaxClearance = qMax(mMaxClearance, clearances.at(a));
+    }
+}
+
+BoardRuleTable::~BoardRuleTable() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+int BoardRuleTable::getNetClassId(const NetClass* netclass) const noexcept
+{
+    return mNetClassIds.value(netclass, NoNetClass);
+}
+
+int BoardRuleTable::getNetClassId(const NetSignal* netsignal) const noexcept
+{
+    return netsignal ? getNetClassId(&netsignal->getNetClass()) : NoNetClass;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
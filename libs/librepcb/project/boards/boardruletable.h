@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDRULETABLE_H
+#define LIBREPCB_PROJECT_BOARDRULETABLE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/length.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetClass;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BoardRuleTable
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardRuleTable class contains the design rules of a board resolved for
+ *        all net classes
+ *
+ * The rules of a board (librepcb::BoardDesignRules) can be overridden by the net
+ * classes of the circuit (see librepcb::project::NetClass). This table compiles both
+ * into dense arrays indexed by a net class ID, so tools which query rules very often
+ * (e.g. the DRC for every pair of copper items) don't need to care about the
+ * overriding logic and only do an array access per query:
+ *
+ * @code
+ * BoardRuleTable rules(board);
+ * int a = rules.getNetClassId(netSignalA);  // once per item
+ * int b = rules.getNetClassId(netSignalB);
+ * Length clearance = rules.getClearance(a, b);  // O(1)
+ * @endcode
+ *
+ * The ID #NoNetClass is used for copper without net signal (it gets the rules of the
+ * board).
+ *
+ * @note The table is a snapshot, it has to be recreated if the rules or the net classes
+ *       have been modified. Creating it is cheap since there are only a few net classes.
+ *       The design rules have no layer specific settings, so all layers resolve to the
+ *       same rules.
+ */
+class BoardRuleTable final
+{
+    public:
+
+        // Types
+        struct Rules {
+            Length traceWidth;          ///< default trace width (0 = not defined)
+            Length viaSize;             ///< default via size (0 = not defined)
+            Length viaDrillDiameter;    ///< default via drill diameter (0 = not defined)
+        };
+
+        // Constructors / Destructor
+        BoardRuleTable() = delete;
+        BoardRuleTable(const BoardRuleTable& other) = default;
+        explicit BoardRuleTable(const Board& board) noexcept;
+        ~BoardRuleTable() noexcept;
+
+        // Getters
+        int getNetClassCount() const noexcept {return mNetClassCount;}
+        int getNetClassId(const NetClass* netclass) const noexcept;
+        int getNetClassId(const NetSignal* netsignal) const noexcept;
+        const Rules& getRules(int netClassId) const noexcept {return mRules.at(netClassId);}
+
+        /**
+         * @brief Get the min. clearance between copper of two net classes
+         *
+         * This is the maximum of the board's min. clearance and the clearances of both
+         * net classes.
+         */
+        const Length& getClearance(int netClassIdA, int netClassIdB) const noexcept {
+            return mClearances.at(netClassIdA * mNetClassCount + netClassIdB);
+        }
+
+        /**
+         * @brief Get the largest clearance of all net class pairs
+         *
+         * This is useful to determine the neighbourhood in which other items need to be
+         * checked.
+         */
+        const Length& getMaxClearance() const noexcept {return mMaxClearance;}
+
+        // Operator Overloadings
+        BoardRuleTable& operator=(const BoardRuleTable& rhs) = default;
+
+        // Static Variables
+        static constexpr int NoNetClass = 0;
+
+
+    private: // Data
+        int mNetClassCount;                     ///< including #NoNetClass
+        QHash<const NetClass*, int> mNetClassIds;
+        QVector<Rules> mRules;                  ///< indexed by net class ID
+        QVector<Length> mClearances;            ///< [a * mNetClassCount + b]
+        Length mMaxClearance;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDRULETABLE_H
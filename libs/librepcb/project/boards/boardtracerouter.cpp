@@ -0,0 +1,563 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include <limits>
+#include "boardtracerouter.h"
+#include "board.h"
+#include "boardcopperpours.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_polygon.h"
+#include "../circuit/netsignal.h"
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/polygonclipper.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprintpad.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Struct BoardTraceRouter::Intersection
+ ****************************************************************************************/
+
+/**
+ * @brief An intersection of a segment with an edge of a ring
+ */
+struct BoardTraceRouter::Intersection {
+    qreal t;    ///< position on the segment (0 = start, 1 = end)
+    int ring;   ///< index of the ring
+    int edge;   ///< index of the edge (from point #edge to point #edge + 1)
+};
+
+/*****************************************************************************************
+ *  Geometry Helpers
+ ****************************************************************************************/
+
+static const qreal TOLERANCE_NM = 1;            ///< for comparisons of positions
+static const qreal SAFETY_MARGIN_NM = 1000;     ///< detours keep this distance to the clearance
+static const int MAX_WALKAROUNDS = 32;          ///< maximum count of detours per segment
+static const int MAX_OBSTACLES = 1000;          ///< more obstacles are too slow to unite
+
+static QPointF toNmPoint(const Point& p) noexcept
+{
+    return QPointF(p.getX().toNm(), p.getY().toNm());
+}
+
+static Point fromNmPoint(const QPointF& p) noexcept
+{
+    return Point(Length(qRound64(p.x())), Length(qRound64(p.y())));
+}
+
+static qreal cross(const QPointF& a, const QPointF& b) noexcept
+{
+    return a.x() * b.y() - a.y() * b.x();
+}
+
+static qreal length(const QPointF& v) noexcept
+{
+    return qSqrt(QPointF::dotProduct(v, v));
+}
+
+static int getWindingNumber(const QPointF& p, const QVector<QPointF>& ring) noexcept
+{
+    int winding = 0;
+    for (int i = 0; i < ring.count(); ++i) {
+        const QPointF& a = ring.at(i);
+        const QPointF& b = ring.at((i + 1) % ring.count());
+        if (a.y() <= p.y()) {
+            if ((b.y() > p.y()) && (cross(b - a, p - a) > 0)) ++winding;
+        } else {
+            if ((b.y() <= p.y()) && (cross(b - a, p - a) < 0)) --winding;
+        }
+    }
+    return winding;
+}
+
+static qreal getPathLength(const QVector<QPointF>& path) noexcept
+{
+    qreal len = 0;
+    for (int i = 1; i < path.count(); ++i) {
+        len += length(path.at(i) - path.at(i - 1));
+    }
+    return len;
+}
+
+/**
+ * @brief Get the outline of a rectangular or octagonal pad/via (relative to its center)
+ */
+static QVector<QPointF> getOutline(qreal width, qreal height, bool octagon) noexcept
+{
+    qreal w = width / 2, h = height / 2;
+    if (!octagon) {
+        return QVector<QPointF>{{-w, -h}, {w, -h}, {w, h}, {-w, h}};
+    }
+    qreal c = (qMin(width, height) - qMin(width, height) / (1 + M_SQRT2)) / 2;
+    return QVector<QPointF>{{-w + c, -h}, {w - c, -h}, {w, -h + c}, {w, h - c},
+                            {w - c, h}, {-w + c, h}, {-w, h - c}, {-w, -h + c}};
+}
+
+/**
+ * @brief Get the convex hull of some points (counter-clockwise, monotone chain)
+ */
+static QVector<QPointF> getConvexHull(QVector<QPointF> points) noexcept
+{
+    std::sort(points.begin(), points.end(), [](const QPointF& a, const QPointF& b) {
+        return (a.x() < b.x()) || ((a.x() == b.x()) && (a.y() < b.y()));
+    });
+    if (points.count() < 3) {
+        return points;
+    }
+    QVector<QPointF> hull(2 * points.count());
+    int k = 0;
+    for (int i = 0; i < points.count(); ++i) { // lower hull
+        while ((k >= 2) && (cross(hull[k-1] - hull[k-2], points[i] - hull[k-2]) <= 0)) --k;
+        hull[k++] = points[i];
+    }
+    for (int i = points.count() - 2, lower = k + 1; i >= 0; --i) { // upper hull
+        while ((k >= lower) && (cross(hull[k-1] - hull[k-2], points[i] - hull[k-2]) <= 0)) --k;
+        hull[k++] = points[i];
+    }
+    hull.resize(k - 1); // the last point is the same as the first one
+    return hull;
+}
+
+/**
+ * @brief Get the convex polygon (1 point = circle, 2 points = capsule) grown by an
+ *        octagon which contains the circle of the given radius
+ */
+static QVector<QPointF> getOctagonalHull(const QVector<QPointF>& points, qreal radius) noexcept
+{
+    qreal r = radius / qCos(M_PI / 8);
+    QVector<QPointF> vertices;
+    foreach (const QPointF& p, points) {
+        for (int i = 0; i < 8; ++i) {
+            qreal angle = M_PI / 8 + i * M_PI / 4; // edges parallel to the axes/diagonals
+            vertices.append(p + QPointF(r * qCos(angle), r * qSin(angle)));
+        }
+    }
+    return getConvexHull(vertices);
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardTraceRouter::BoardTraceRouter(const Board& board, const NetSignal& netsignal,
+                                   const QString& layerName, const Length& width) noexcept :
+    mBoard(board), mNetSignal(netsignal), mLayerName(layerName), mWidth(width),
+    mTimeLimitMs(5), mAvoidCopperPours(true)
+{
+}
+
+BoardTraceRouter::~BoardTraceRouter() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BoardTraceRouter::setAvoidCopperPours(bool avoid) noexcept
+{
+    if (avoid != mAvoidCopperPours) {
+        mAvoidCopperPours = avoid;
+        invalidateCache();
+    }
+}
+
+void BoardTraceRouter::invalidateCache() noexcept
+{
+    mCachedArea = QRectF();
+    mCachedRings.clear();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QVector<Point> BoardTraceRouter::route(const QVector<Point>& path) noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if ((path.count() < 2) || (!updateKeepoutArea(path, timer))) {
+        return QVector<Point>();
+    }
+
+    QVector<QPointF> result = {toNmPoint(path.first())};
+    for (int i = 1; i < path.count(); ++i) {
+        if (!walkAround(toNmPoint(path.at(i - 1)), toNmPoint(path.at(i)), mCachedRings,
+                        timer, result)) {
+            return QVector<Point>();
+        }
+    }
+
+    QVector<Point> points;
+    foreach (const QPointF& p, result) {
+        Point point = fromNmPoint(p);
+        if (points.isEmpty() || (point != points.last())) {
+            points.append(point);
+        }
+    }
+    points.last() = path.last(); // avoid any rounding of the end point
+    return points;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool BoardTraceRouter::updateKeepoutArea(const QVector<Point>& path,
+                                         const QElapsedTimer& timer) noexcept
+{
+    // the bounding rect of the path, grown by enough space for the detours
+    qreal left = std::numeric_limits<qreal>::max(), right = -left;
+    qreal top = left, bottom = -left;
+    foreach (const Point& point, path) {
+        QPointF p = toNmPoint(point);
+        left = qMin(left, p.x());   right = qMax(right, p.x());
+        top = qMin(top, p.y());     bottom = qMax(bottom, p.y());
+    }
+    QRectF area(QPointF(left, top), QPointF(right, bottom));
+    qreal margin = qMin(qMax(area.width(), area.height()) / 2, qreal(5000000))
+                 + mBoard.getDesignRules().getMinCopperClearance().toNm() + mWidth.toNm();
+    area.adjust(-margin, -margin, margin, margin);
+    if ((!mCachedArea.isNull()) && mCachedArea.contains(area)) {
+        return true; // the cached keepout area covers the whole path
+    }
+
+    // Cache a larger area, so the following mouse moves do not need to rebuild it. If
+    // the path just grew a bit, the new area also covers the previous one.
+    QRectF cacheArea = area.adjusted(-area.width() / 2, -area.height() / 2,
+                                     area.width() / 2, area.height() / 2);
+    if (!mCachedArea.isNull()) {
+        QRectF united = cacheArea.united(mCachedArea);
+        if (united.width() * united.height() <= 2 * cacheArea.width() * cacheArea.height()) {
+            cacheArea = united;
+        }
+    }
+    invalidateCache();
+
+    PolygonClipper::Paths obstacles;
+    if ((!getObstacles(cacheArea, timer, obstacles)) || timer.hasExpired(mTimeLimitMs)) {
+        return false;
+    }
+
+    // unite overlapping obstacles, otherwise a detour around one of them could hit
+    // another one
+    foreach (const PolygonClipper::Path& p, PolygonClipper::unite(obstacles)) {
+        Ring ring;
+        foreach (const Point& point, p) {
+            ring.append(toNmPoint(point));
+        }
+        mCachedRings.append(ring);
+    }
+    mCachedArea = cacheArea;
+
+    // the result is cached even if the time limit is exceeded now, so the next call
+    // can use it
+    return !timer.hasExpired(mTimeLimitMs);
+}
+
+bool BoardTraceRouter::getObstacles(const QRectF& area, const QElapsedTimer& timer,
+                                    PolygonClipper::Paths& obstacles) const noexcept
+{
+    qreal growth = mBoard.getDesignRules().getMinCopperClearance().toNm()
+                 + mWidth.toNm() / 2 + SAFETY_MARGIN_NM;
+    auto appendHull = [&](const QVector<QPointF>& points, qreal radius) {
+        PolygonClipper::Path path;
+        foreach (const QPointF& point, getOctagonalHull(points, radius)) {
+            path.append(fromNmPoint(point));
+        }
+        obstacles.append(path);
+    };
+
+    QRectF areaPx(fromNmPoint(area.topLeft()).toPxQPointF(),
+                  fromNmPoint(area.bottomRight()).toPxQPointF());
+    foreach (const BI_Base* item, mBoard.getItemCandidatesInSceneRect(areaPx.normalized())) {
+        if (timer.hasExpired(mTimeLimitMs)) {
+            return false;
+        }
+        switch (item->getType()) {
+            case BI_Base::Type_t::NetLine: {
+                const BI_NetLine* netline = static_cast<const BI_NetLine*>(item);
+                if ((netline->getLayer().getName() != mLayerName)
+                    || (&netline->getNetSignal() == &mNetSignal)) {
+                    continue;
+                }
+                appendHull({toNmPoint(netline->getStartPoint().getPosition()),
+                            toNmPoint(netline->getEndPoint().getPosition())},
+                           netline->getWidth().toNm() / 2 + growth);
+                break;
+            }
+            case BI_Base::Type_t::Via: {
+                const BI_Via* via = static_cast<const BI_Via*>(item);
+                if ((!via->isOnLayer(mLayerName)) || (via->getNetSignal() == &mNetSignal)) {
+                    continue;
+                }
+                QPointF pos = toNmPoint(via->getPosition());
+                qreal size = via->getSize().toNm();
+                if (via->getShape() == BI_Via::Shape::Round) {
+                    appendHull({pos}, size / 2 + growth);
+                } else {
+                    QVector<QPointF> points = getOutline(size, size,
+                        via->getShape() == BI_Via::Shape::Octagon);
+                    for (QPointF& p : points) p += pos;
+                    appendHull(points, growth);
+                }
+                break;
+            }
+            case BI_Base::Type_t::FootprintPad: {
+                const BI_FootprintPad* pad = static_cast<const BI_FootprintPad*>(item);
+                if ((!pad->isOnLayer(mLayerName))
+                    || (pad->getCompSigInstNetSignal() == &mNetSignal)) {
+                    continue;
+                }
+                const library::FootprintPad& libPad = pad->getLibPad();
+                qreal width = libPad.getWidth().toNm();
+                qreal height = libPad.getHeight().toNm();
+                QVector<QPointF> points;
+                qreal radius = 0;
+                if (libPad.getShape() == library::FootprintPad::Shape::ROUND) {
+                    // an obround, i.e. a capsule along the longer side
+                    qreal l = qAbs(width - height) / 2;
+                    points = (width > height) ? QVector<QPointF>{{-l, 0}, {l, 0}}
+                                              : QVector<QPointF>{{0, -l}, {0, l}};
+                    radius = qMin(width, height) / 2;
+                } else {
+                    points = getOutline(width, height,
+                        libPad.getShape() == library::FootprintPad::Shape::OCTAGON);
+                }
+                for (QPointF& p : points) {
+                    Point rotated = fromNmPoint(p).rotated(pad->getRotation());
+                    if (pad->getIsMirrored()) rotated.mirror(Qt::Horizontal);
+                    p = toNmPoint(rotated + pad->getPosition());
+                }
+                appendHull(points, radius + growth);
+                break;
+            }
+            default:
+                continue;
+        }
+        if (obstacles.count() > MAX_OBSTACLES) {
+            return false;
+        }
+    }
+
+    // board polygons and copper pours of other net signals, clipped to the area first
+    // so that large polygons do not slow down the offset
+    const Point p1 = fromNmPoint(area.topLeft()), p2 = fromNmPoint(area.bottomRight());
+    const PolygonClipper::Paths clipArea = {{p1, Point(p2.getX(), p1.getY()),
+                                             p2, Point(p1.getX(), p2.getY())}};
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        if (timer.hasExpired(mTimeLimitMs)) {
+            return false;
+        }
+        if ((polygon->getPolygon().getLayerName() != mLayerName)
+            || (polygon->getNetSignal() == &mNetSignal)) {
+            continue;
+        }
+        PolygonClipper::Paths copper;
+        if (polygon->isCopperPour()) {
+            if (!mAvoidCopperPours) continue;
+            foreach (const BoardCopperPours::Contour& contour,
+                     mBoard.getCopperPours().getFill(*polygon)) {
+                // the contours are closed, the clipper does not need the last point
+                copper.append(contour.points.mid(0, contour.points.count() - 1));
+            }
+        } else {
+            // the outline, drawn with the line width of the polygon
+            const Polygon& p = polygon->getPolygon();
+            const QVector<Point>& points = p.toFlattenedPoints(Length(5000)); // cached
+            for (int i = 1; i < points.count(); ++i) {
+                appendHull({toNmPoint(points.at(i - 1)), toNmPoint(points.at(i))},
+                           p.getLineWidth().toNm() / 2 + growth);
+            }
+            if (p.isFilled()) {
+                copper.append(PolygonClipper::fromPolygon(p, Length(5000)));
+            }
+        }
+        copper = PolygonClipper::intersect(copper, clipArea);
+        if (!copper.isEmpty()) {
+            obstacles += PolygonClipper::offset(copper, Length(qRound64(growth)), Length(5000));
+        }
+        if (obstacles.count() > MAX_OBSTACLES) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BoardTraceRouter::walkAround(const QPointF& start, const QPointF& end,
+                                  const QVector<Ring>& rings, const QElapsedTimer& timer,
+                                  QVector<QPointF>& result) const noexcept
+{
+    QPointF a = start;
+    for (int i = 0; i < MAX_WALKAROUNDS; ++i) {
+        if (timer.hasExpired(mTimeLimitMs)) {
+            return false;
+        }
+        QPointF direction = end - a;
+        qreal len = length(direction);
+        if (len <= TOLERANCE_NM) {
+            result.append(end);
+            return true;
+        }
+
+        // find the first part of the segment which lies within the keepout area
+        QVector<Intersection> intersections = getIntersections(a, end, rings);
+        qreal tEntry = -1, tPrevious = 0;
+        QPointF inside;
+        for (int k = 0; k <= intersections.count(); ++k) {
+            qreal tNext = (k < intersections.count()) ? intersections.at(k).t : 1;
+            if ((tNext - tPrevious) * len > TOLERANCE_NM) {
+                QPointF middle = a + direction * ((tPrevious + tNext) / 2);
+                if (isInside(middle, rings)) {
+                    tEntry = tPrevious;
+                    inside = middle;
+                    break;
+                }
+            }
+            tPrevious = tNext;
+        }
+        if (tEntry < 0) {
+            result.append(end); // no obstacle hit
+            return true;
+        }
+
+        // determine the ring which is crossed at the entry point
+        QPointF before = a + direction * (tEntry - 2 * TOLERANCE_NM / len);
+        int entry = -1;
+        for (int k = 0; k < intersections.count(); ++k) {
+            if (qAbs(intersections.at(k).t - tEntry) * len > 2 * TOLERANCE_NM) continue;
+            const Ring& ring = rings.at(intersections.at(k).ring);
+            if (entry < 0) entry = k;
+            if (getWindingNumber(before, ring) != getWindingNumber(inside, ring)) {
+                entry = k;
+                break;
+            }
+        }
+        if (entry < 0) {
+            return false; // the start point lies within the keepout area
+        }
+
+        // the segment leaves the ring the last time at the exit point
+        int exit = entry;
+        for (int k = entry + 1; k < intersections.count(); ++k) {
+            if (intersections.at(k).ring == intersections.at(entry).ring) {
+                exit = k; // sorted by t
+            }
+        }
+        if ((intersections.at(exit).t - intersections.at(entry).t) * len <= TOLERANCE_NM) {
+            return false; // the end point is enclosed by the ring
+        }
+
+        // walk along the ring in both directions and take the shorter way
+        const Intersection& entryIntersection = intersections.at(entry);
+        const Intersection& exitIntersection = intersections.at(exit);
+        const Ring& ring = rings.at(entryIntersection.ring);
+        int n = ring.count();
+        QPointF entryPos = a + direction * entryIntersection.t;
+        QPointF exitPos = a + direction * exitIntersection.t;
+        QVector<QPointF> forward = {entryPos};
+        for (int k = entryIntersection.edge; k != exitIntersection.edge; k = (k + 1) % n) {
+            forward.append(ring.at((k + 1) % n));
+        }
+        forward.append(exitPos);
+        QVector<QPointF> backward = {entryPos};
+        for (int k = entryIntersection.edge; ; k = (k + n - 1) % n) {
+            backward.append(ring.at(k));
+            if (k == (exitIntersection.edge + 1) % n) break;
+        }
+        backward.append(exitPos);
+        result += (getPathLength(forward) <= getPathLength(backward)) ? forward : backward;
+        a = exitPos;
+    }
+    return false;
+}
+
+QVector<BoardTraceRouter::Intersection> BoardTraceRouter::getIntersections(
+        const QPointF& start, const QPointF& end, const QVector<Ring>& rings) noexcept
+{
+    QVector<Intersection> intersections;
+    QPointF ab = end - start;
+    qreal lenAb = length(ab);
+    for (int r = 0; r < rings.count(); ++r) {
+        const Ring& ring = rings.at(r);
+        for (int i = 0; i < ring.count(); ++i) {
+            const QPointF& c = ring.at(i);
+            QPointF cd = ring.at((i + 1) % ring.count()) - c;
+            qreal lenCd = length(cd);
+            qreal denominator = cross(ab, cd);
+            if (qAbs(denominator) <= 1e-12 * lenAb * lenCd) {
+                continue; // parallel, i.e. the segment does not cross the edge
+            }
+            qreal t = cross(c - start, cd) / denominator;
+            qreal u = cross(c - start, ab) / denominator;
+            if ((t * lenAb < -TOLERANCE_NM) || ((t - 1) * lenAb > TOLERANCE_NM)
+                || (u * lenCd < -TOLERANCE_NM) || ((u - 1) * lenCd > TOLERANCE_NM)) {
+                continue;
+            }
+            intersections.append(Intersection{qBound(qreal(0), t, qreal(1)), r, i});
+        }
+    }
+    std::sort(intersections.begin(), intersections.end(),
+              [](const Intersection& a, const Intersection& b) {return a.t < b.t;});
+    return intersections;
+}
+
+bool BoardTraceRouter::isInside(const QPointF& p, const QVector<Ring>& rings) noexcept
+{
+    int winding = 0;
+    foreach (const Ring& ring, rings) {
+        // points on the outline are allowed (that's where the detours are)
+        for (int i = 0; i < ring.count(); ++i) {
+            const QPointF& a = ring.at(i);
+            QPointF ab = ring.at((i + 1) % ring.count()) - a;
+            qreal len2 = QPointF::dotProduct(ab, ab);
+            qreal t = (len2 > 0) ? qBound(qreal(0), QPointF::dotProduct(p - a, ab) / len2, qreal(1)) : 0;
+            if (length(p - (a + t * ab)) <= TOLERANCE_NM) {
+                return false;
+            }
+        }
+        winding += getWindingNumber(p, ring);
+    }
+    return (winding != 0);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
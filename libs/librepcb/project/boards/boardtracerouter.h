@@ -0,0 +1,158 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDTRACEROUTER_H
+#define LIBREPCB_PROJECT_BOARDTRACEROUTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/geometry/polygonclipper.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BoardTraceRouter
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardTraceRouter class finds a way for a new trace around existing copper
+ *
+ * This is the routing core of the interactive trace tool: It gets the path which the
+ * trace would take without any obstacles (e.g. according the current wire mode) and
+ * walks around all copper of other net signals which would be hit by it.
+ *
+ * The obstacles (traces, vias and pads of other net signals on the layer of the trace)
+ * are looked up in the spatial index of the board's graphics scene, so the runtime does
+ * not depend on the size of the board. Each obstacle is grown by the minimum copper
+ * clearance plus half of the trace width to an octagonal hull. Board polygons on the
+ * layer which do not belong to the net signal of the trace and the current fills of the
+ * copper pours of other net signals (see #setAvoidCopperPours()) are grown by the same
+ * distance with librepcb::PolygonClipper::offset(). All of them are united with
+ * librepcb::PolygonClipper. Then every segment of the path which enters the united area
+ * is replaced by the shorter way along the outline between the point where the segment
+ * enters the area and the point where it leaves the area the last time. As most hulls
+ * are octagons, the detours mostly consist of 45° segments.
+ *
+ * The united keepout area is cached for an area somewhat larger than the path, so a
+ * router object should be kept for a whole drawing gesture (the net signal, layer and
+ * width of the trace must not change). Only if the path leaves the cached area, the
+ * keepout area is built again. The copper of the board is expected not to change
+ * during the gesture, except for traces of the routed net signal itself (which are
+ * ignored anyway), otherwise #invalidateCache() must be called.
+ *
+ * The routing is aborted if it takes longer than the time limit (see #setTimeLimit()),
+ * so the caller can fall back to the unmodified path and stays interactive even on
+ * crowded boards. The time limit also applies to building the keepout area.
+ *
+ * @note Existing traces are never moved (no push and shove), and the start and end
+ *       points of the path are never modified. If one of them lies within the clearance
+ *       of another net signal, no way can be found.
+ */
+class BoardTraceRouter final
+{
+        Q_DECLARE_TR_FUNCTIONS(BoardTraceRouter)
+
+    public:
+
+        // Constructors / Destructor
+        BoardTraceRouter() = delete;
+        BoardTraceRouter(const BoardTraceRouter& other) = delete;
+        BoardTraceRouter(const Board& board, const NetSignal& netsignal,
+                         const QString& layerName, const Length& width) noexcept;
+        ~BoardTraceRouter() noexcept;
+
+        // Getters
+        int getTimeLimit() const noexcept {return mTimeLimitMs;}
+        bool getAvoidCopperPours() const noexcept {return mAvoidCopperPours;}
+
+        // Setters
+        void setTimeLimit(int ms) noexcept {mTimeLimitMs = ms;}
+        void setAvoidCopperPours(bool avoid) noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Discard the cached keepout area (required after modifying the board)
+         */
+        void invalidateCache() noexcept;
+
+        /**
+         * @brief Find a way around all obstacles for a trace
+         *
+         * @param path      The preferred path of the trace (at least two points)
+         *
+         * @return  The path around all obstacles (the first and the last point are the
+         *          same as in the given path), or an empty vector if there is no such
+         *          path or the time limit was exceeded
+         */
+        QVector<Point> route(const QVector<Point>& path) noexcept;
+
+        // Operator Overloadings
+        BoardTraceRouter& operator=(const BoardTraceRouter& rhs) = delete;
+
+
+    private:
+
+        // Types
+        typedef QVector<QPointF> Ring; ///< a closed outline in nanometers
+        struct Intersection;
+
+        // Private Methods
+        bool updateKeepoutArea(const QVector<Point>& path, const QElapsedTimer& timer) noexcept;
+        bool getObstacles(const QRectF& area, const QElapsedTimer& timer,
+                          PolygonClipper::Paths& obstacles) const noexcept;
+        bool walkAround(const QPointF& start, const QPointF& end, const QVector<Ring>& rings,
+                        const QElapsedTimer& timer, QVector<QPointF>& result) const noexcept;
+        static QVector<Intersection> getIntersections(const QPointF& start, const QPointF& end,
+                                                      const QVector<Ring>& rings) noexcept;
+        static bool isInside(const QPointF& p, const QVector<Ring>& rings) noexcept;
+
+
+        // General
+        const Board& mBoard;
+        const NetSignal& mNetSignal;
+        QString mLayerName;
+        Length mWidth;
+        int mTimeLimitMs;
+        bool mAvoidCopperPours;
+
+        // Cached Attributes
+        QRectF mCachedArea;         ///< in nanometers, null if nothing is cached
+        QVector<Ring> mCachedRings; ///< the keepout area within #mCachedArea
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDTRACEROUTER_H
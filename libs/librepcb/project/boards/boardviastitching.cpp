@@ -0,0 +1,319 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <limits>
+#include "boardviastitching.h"
+#include "board.h"
+#include "boarditemgeometry.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netline.h"
+#include "items/bi_polygon.h"
+#include "items/bi_via.h"
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Struct BoardViaStitching::Grid
+ ****************************************************************************************/
+
+/**
+ * @brief The grid points of the stitched area (in nanometers)
+ */
+struct BoardViaStitching::Grid {
+    qreal pitch;
+    qint64 firstX;          ///< index of the first column (relative to the origin)
+    qint64 firstY;          ///< index of the first row (relative to the origin)
+    int columns;
+    int rows;
+    QVector<bool> blocked;  ///< row by row
+
+    QPointF getPoint(int column, int row) const noexcept {
+        return QPointF((firstX + column) * pitch, (firstY + row) * pitch);
+    }
+};
+
+/*****************************************************************************************
+ *  Geometry Helpers
+ ****************************************************************************************/
+
+/// Maximum deviation of the polygonal approximation of arcs in the board outlines
+static const Length sArcTolerance(5000);
+
+/// Areas with more grid points are not stitched (it would take too long)
+static const qint64 MAX_GRID_POINTS = 4000000;
+
+static QPointF toNmPoint(const Point& p) noexcept
+{
+    return QPointF(p.getX().toNm(), p.getY().toNm());
+}
+
+static Point fromNmPoint(const QPointF& p) noexcept
+{
+    return Point(Length(qRound64(p.x())), Length(qRound64(p.y())));
+}
+
+static qreal cross(const QPointF& o, const QPointF& a, const QPointF& b) noexcept
+{
+    return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
+
+static qreal pointToSegmentDistance(const QPointF& p, const QPointF& a, const QPointF& b) noexcept
+{
+    QPointF ab = b - a;
+    qreal len2 = QPointF::dotProduct(ab, ab);
+    qreal t = (len2 > 0) ? qBound(qreal(0), QPointF::dotProduct(p - a, ab) / len2, qreal(1)) : 0;
+    QPointF d = p - (a + t * ab);
+    return qSqrt(QPointF::dotProduct(d, d));
+}
+
+/**
+ * @brief Get the distance between a point and the skeleton of a librepcb::project::BoardItemGeometry
+ *        (0 if the point lies within a convex skeleton)
+ */
+static qreal skeletonDistance(const QPointF& p, const QVector<QPointF>& skeleton) noexcept
+{
+    if (skeleton.count() == 1) {
+        return pointToSegmentDistance(p, skeleton.first(), skeleton.first());
+    }
+    bool positive = false, negative = false;
+    qreal distance = std::numeric_limits<qreal>::max();
+    int edges = (skeleton.count() > 2) ? skeleton.count() : 1;
+    for (int i = 0; i < edges; ++i) {
+        const QPointF& a = skeleton.at(i);
+        const QPointF& b = skeleton.at((i + 1) % skeleton.count());
+        qreal c = cross(a, b, p);
+        if (c > 0) positive = true;
+        if (c < 0) negative = true;
+        distance = qMin(distance, pointToSegmentDistance(p, a, b));
+    }
+    bool inside = (skeleton.count() > 2) && (!(positive && negative));
+    return inside ? 0 : distance;
+}
+
+/**
+ * @brief Check whether a point lies within an (arbitrary) closed outline (even-odd rule)
+ */
+static bool outlineContains(const QVector<QPointF>& outline, const QPointF& p) noexcept
+{
+    bool inside = false;
+    for (int i = 0, k = outline.count() - 1; i < outline.count(); k = i++) {
+        const QPointF& a = outline.at(i);
+        const QPointF& b = outline.at(k);
+        if (((a.y() > p.y()) != (b.y() > p.y())) &&
+            (p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x())) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+static qreal outlineDistance(const QVector<QPointF>& outline, const QPointF& p) noexcept
+{
+    qreal distance = std::numeric_limits<qreal>::max();
+    for (int i = 0, k = outline.count() - 1; i < outline.count(); k = i++) {
+        distance = qMin(distance, pointToSegmentDistance(p, outline.at(k), outline.at(i)));
+    }
+    return distance;
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardViaStitching::BoardViaStitching(const Board& board, const NetSignal& netsignal,
+                                     const Length& viaSize) noexcept :
+    mBoard(board), mNetSignal(netsignal), mViaSize(viaSize),
+    mPitch(0), mClearance(board.getDesignRules().getMinCopperClearance())
+{
+    setPitch(mPitch);
+}
+
+BoardViaStitching::~BoardViaStitching() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BoardViaStitching::setPitch(const Length& pitch) noexcept
+{
+    mPitch = qMax(pitch, mViaSize + mClearance);
+}
+
+void BoardViaStitching::setClearance(const Length& clearance) noexcept
+{
+    mClearance = qMax(clearance, Length(0));
+    setPitch(mPitch);
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QVector<Point> BoardViaStitching::calculate(const QVector<Point>& outline) const noexcept
+{
+    QVector<QPointF> outlineNm;
+    outlineNm.reserve(outline.count());
+    for (const Point& p : outline) {
+        outlineNm.append(toNmPoint(p));
+    }
+    if ((outlineNm.count() < 3) || (mPitch <= 0)) {
+        return QVector<Point>();
+    }
+
+    // the grid points within the bounding rect of the outline (aligned to the origin)
+    QRectF bounds = QPolygonF(outlineNm).boundingRect();
+    Grid grid;
+    grid.pitch = mPitch.toNm();
+    grid.firstX = qCeil(bounds.left() / grid.pitch);
+    grid.firstY = qCeil(bounds.top() / grid.pitch);
+    qint64 columns = qFloor(bounds.right() / grid.pitch) - grid.firstX + 1;
+    qint64 rows = qFloor(bounds.bottom() / grid.pitch) - grid.firstY + 1;
+    if ((columns <= 0) || (rows <= 0)) {
+        return QVector<Point>();
+    } else if (columns * rows > MAX_GRID_POINTS) {
+        qWarning() << "Via stitching area is too large:" << columns << "x" << rows;
+        return QVector<Point>();
+    }
+    grid.columns = columns;
+    grid.rows = rows;
+    grid.blocked.fill(false, grid.columns * grid.rows);
+    blockObstacles(grid);
+
+    // keep the vias which completely fit into the outline
+    qreal margin = mViaSize.toNm() / 2 + mClearance.toNm();
+    QVector<Point> positions;
+    for (int row = 0; row < grid.rows; ++row) {
+        for (int column = 0; column < grid.columns; ++column) {
+            if (grid.blocked.at(row * grid.columns + column)) continue;
+            QPointF p = grid.getPoint(column, row);
+            if (outlineContains(outlineNm, p) && (outlineDistance(outlineNm, p) >= margin)) {
+                positions.append(fromNmPoint(p));
+            }
+        }
+    }
+    return positions;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QVector<Point> BoardViaStitching::getRectOutline(const Point& p1, const Point& p2) noexcept
+{
+    return QVector<Point>{p1, Point(p2.getX(), p1.getY()), p2, Point(p1.getX(), p2.getY())};
+}
+
+QVector<QVector<Point>> BoardViaStitching::getBoardOutlines(const Board& board) noexcept
+{
+    QVector<QVector<Point>> outlines;
+    foreach (const BI_Polygon* polygon, board.getPolygons()) {
+        if ((polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines)
+            && polygon->getPolygon().isClosed()) {
+            outlines.append(polygon->getPolygon().toFlattenedPoints(sArcTolerance));
+        }
+    }
+    return outlines;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardViaStitching::blockObstacles(Grid& grid) const noexcept
+{
+    qreal viaRadius = mViaSize.toNm() / 2;
+    qreal clearance = mClearance.toNm();
+    QRectF areaNm(grid.getPoint(0, 0), grid.getPoint(grid.columns - 1, grid.rows - 1));
+    areaNm.adjust(-viaRadius - clearance, -viaRadius - clearance,
+                  viaRadius + clearance, viaRadius + clearance);
+    QRectF areaPx(fromNmPoint(areaNm.topLeft()).toPxQPointF(),
+                  fromNmPoint(areaNm.bottomRight()).toPxQPointF());
+
+    // block all grid points which are too close to the skeleton of an obstacle
+    auto block = [&](const BoardItemGeometry& geometry) {
+        if (geometry.isEmpty()) return;
+        QVector<QPointF> skeleton;
+        skeleton.reserve(geometry.getPoints().count());
+        for (const Point& p : geometry.getPoints()) {
+            skeleton.append(toNmPoint(p));
+        }
+        qreal minDistance = geometry.getRadius().toNm() + clearance + viaRadius;
+        QRectF rect = QPolygonF(skeleton).boundingRect().adjusted(
+            -minDistance, -minDistance, minDistance, minDistance);
+        int firstColumn = qMax(qint64(0), qint64(qCeil(rect.left() / grid.pitch)) - grid.firstX);
+        int lastColumn = qMin(qint64(grid.columns - 1),
+                              qint64(qFloor(rect.right() / grid.pitch)) - grid.firstX);
+        int firstRow = qMax(qint64(0), qint64(qCeil(rect.top() / grid.pitch)) - grid.firstY);
+        int lastRow = qMin(qint64(grid.rows - 1),
+                           qint64(qFloor(rect.bottom() / grid.pitch)) - grid.firstY);
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                int index = row * grid.columns + column;
+                if ((!grid.blocked.at(index)) &&
+                    (skeletonDistance(grid.getPoint(column, row), skeleton) < minDistance)) {
+                    grid.blocked[index] = true;
+                }
+            }
+        }
+    };
+
+    foreach (const BI_Base* item, mBoard.getItemCandidatesInSceneRect(areaPx.normalized())) {
+        switch (item->getType()) {
+            case BI_Base::Type_t::NetLine: {
+                // traces of the same net signal may be hit by the new vias
+                const BI_NetLine* netline = static_cast<const BI_NetLine*>(item);
+                if (&netline->getNetSignal() != &mNetSignal) {
+                    block(netline->getGeometry());
+                }
+                break;
+            }
+            case BI_Base::Type_t::Via: {
+                // even vias of the same net signal, to keep the drills apart
+                block(static_cast<const BI_Via*>(item)->getGeometry());
+                break;
+            }
+            case BI_Base::Type_t::FootprintPad: {
+                // even pads of the same net signal, vias in pads would steal the solder
+                block(static_cast<const BI_FootprintPad*>(item)->getGeometry());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
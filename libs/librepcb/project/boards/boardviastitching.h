@@ -0,0 +1,147 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDVIASTITCHING_H
+#define LIBREPCB_PROJECT_BOARDVIASTITCHING_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BoardViaStitching
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardViaStitching class calculates the positions of a via array which
+ *        fills an area of a board (e.g. to stitch the ground planes of all layers)
+ *
+ * The vias are placed on a square grid of the given pitch within a closed outline
+ * (e.g. a rectangle or the board outline). The grid is aligned to the origin of the
+ * board, so the vias of several stitched areas line up. Grid points are skipped if the
+ * via would not completely fit into the outline, or if it would violate the clearance
+ * to an existing via or to a trace or pad of another net signal. The vias go through
+ * all copper layers, so obstacles on all layers are considered.
+ *
+ * The obstacles are looked up in the spatial index of the board's graphics scene, and
+ * each obstacle only checks the grid points within its own (grown) bounding rect, so
+ * the runtime is roughly proportional to the count of grid points plus obstacles.
+ *
+ * @note Copper pours are not considered as obstacles since they are refilled
+ *       around the new vias anyway.
+ */
+class BoardViaStitching final
+{
+        Q_DECLARE_TR_FUNCTIONS(BoardViaStitching)
+
+    public:
+
+        // Constructors / Destructor
+        BoardViaStitching() = delete;
+        BoardViaStitching(const BoardViaStitching& other) = delete;
+        BoardViaStitching(const Board& board, const NetSignal& netsignal,
+                          const Length& viaSize) noexcept;
+        ~BoardViaStitching() noexcept;
+
+        // Getters
+        const Length& getPitch() const noexcept {return mPitch;}
+        const Length& getClearance() const noexcept {return mClearance;}
+
+        // Setters
+
+        /**
+         * @brief Set the distance between two neighbouring grid points
+         *
+         * The pitch is never smaller than the via size plus the clearance, so the new
+         * vias never violate the clearance among themselves.
+         */
+        void setPitch(const Length& pitch) noexcept;
+
+        /**
+         * @brief Set the clearance to other copper (default: minimum copper clearance
+         *        of the board's design rules)
+         */
+        void setClearance(const Length& clearance) noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Calculate the via positions within an area
+         *
+         * @param outline   The closed outline of the area (at least three points, the
+         *                  last point is implicitly connected to the first one; arcs
+         *                  must already be flattened)
+         *
+         * @return The positions of all vias to add (sorted by rows)
+         */
+        QVector<Point> calculate(const QVector<Point>& outline) const noexcept;
+
+        // Operator Overloadings
+        BoardViaStitching& operator=(const BoardViaStitching& rhs) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Get the outline of a rectangle (from two opposite corners)
+         */
+        static QVector<Point> getRectOutline(const Point& p1, const Point& p2) noexcept;
+
+        /**
+         * @brief Get the flattened outlines of the board (one per closed polygon on the
+         *        board outlines layer)
+         */
+        static QVector<QVector<Point>> getBoardOutlines(const Board& board) noexcept;
+
+
+    private:
+
+        // Types
+        struct Grid;
+
+        // Private Methods
+        void blockObstacles(Grid& grid) const noexcept;
+
+
+        // General
+        const Board& mBoard;
+        const NetSignal& mNetSignal;
+        Length mViaSize;
+        Length mPitch;
+        Length mClearance;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDVIASTITCHING_H
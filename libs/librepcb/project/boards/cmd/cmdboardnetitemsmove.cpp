@@ -0,0 +1,116 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdboardnetitemsmove.h"
+#include <librepcb/common/scopeguardlist.h>
+#include "../../circuit/circuit.h"
+#include "../../circuit/netsignal.h"
+#include "../items/bi_netpoint.h"
+#include "../items/bi_via.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdBoardNetItemsMove::CmdBoardNetItemsMove(const QList<BI_NetPoint*>& netpoints,
+        const QList<BI_Via*>& vias, NetSignal& netsignal) noexcept :
+    UndoCommand(tr("Move traces to net signal")), mNetPoints(netpoints), mVias(vias),
+    mNetSignal(netsignal)
+{
+}
+
+CmdBoardNetItemsMove::~CmdBoardNetItemsMove() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdBoardNetItemsMove::performExecute()
+{
+    foreach (BI_NetPoint* netpoint, mNetPoints) {
+        mOldNetPointNetSignals.append(&netpoint->getNetSignal());
+    }
+    foreach (BI_Via* via, mVias) {
+        if (!via->getNetSignal()) {
+            throw LogicError(__FILE__, __LINE__, tr("Cannot move an unconnected via."));
+        }
+        mOldViaNetSignals.append(via->getNetSignal());
+    }
+
+    performRedo(); // can throw
+
+    return (!mNetPoints.isEmpty()) || (!mVias.isEmpty());
+}
+
+void CmdBoardNetItemsMove::performUndo()
+{
+    moveItems(false); // can throw
+}
+
+void CmdBoardNetItemsMove::performRedo()
+{
+    moveItems(true); // can throw
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void CmdBoardNetItemsMove::moveItems(bool toNewNetSignal)
+{
+    Circuit& circuit = mNetSignal.getCircuit();
+    circuit.beginBulkUpdate(); // update the ERC messages only once
+    auto sg = scopeGuard([&](){circuit.endBulkUpdate();});
+
+    ScopeGuardList sgl;
+    for (int i = 0; i < mNetPoints.count(); ++i) {
+        BI_NetPoint* netpoint = mNetPoints.at(i);
+        NetSignal& oldNetSignal = netpoint->getNetSignal();
+        netpoint->moveToNetSignal(toNewNetSignal ? mNetSignal
+                                                 : *mOldNetPointNetSignals.at(i)); // can throw
+        sgl.add([netpoint, &oldNetSignal](){netpoint->moveToNetSignal(oldNetSignal);});
+    }
+    for (int i = 0; i < mVias.count(); ++i) {
+        BI_Via* via = mVias.at(i);
+        NetSignal* oldNetSignal = via->getNetSignal();
+        via->moveToNetSignal(toNewNetSignal ? mNetSignal
+                                            : *mOldViaNetSignals.at(i)); // can throw
+        sgl.add([via, oldNetSignal](){via->moveToNetSignal(*oldNetSignal);});
+    }
+    sgl.dismiss();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,97 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CMDBOARDNETITEMSMOVE_H
+#define LIBREPCB_PROJECT_CMDBOARDNETITEMSMOVE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommand.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class NetSignal;
+class BI_NetPoint;
+class BI_Via;
+
+/*****************************************************************************************
+ *  Class CmdBoardNetItemsMove
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdBoardNetItemsMove class moves some netpoints and vias of a board to
+ *        another net signal
+ *
+ * In contrast to librepcb::project::CmdNetSignalMoveItems, only the given items are
+ * moved (e.g. a single trace segment which is connected to pads of another net after
+ * the circuit was modified). The items may belong to different net signals, each of
+ * them is moved back to its original net signal on undo.
+ */
+class CmdBoardNetItemsMove final : public UndoCommand
+{
+    public:
+
+        // Constructors / Destructor
+        CmdBoardNetItemsMove(const QList<BI_NetPoint*>& netpoints,
+                             const QList<BI_Via*>& vias, NetSignal& netsignal) noexcept;
+        ~CmdBoardNetItemsMove() noexcept;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+        void moveItems(bool toNewNetSignal);
+
+
+        // Private Member Variables
+
+        // Attributes from the constructor
+        QList<BI_NetPoint*> mNetPoints;
+        QList<BI_Via*> mVias;
+        NetSignal& mNetSignal;
+
+        // Original net signals (same order as the items)
+        QList<NetSignal*> mOldNetPointNetSignals;
+        QList<NetSignal*> mOldViaNetSignals;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDBOARDNETITEMSMOVE_H
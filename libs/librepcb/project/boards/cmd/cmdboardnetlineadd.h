@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/undocommand.h>
+#include <librepcb/common/objectpool.h>
 #include <librepcb/common/units/length.h>
 
 /*****************************************************************************************
@@ -44,7 +45,8 @@ class BI_NetLine;
 /**
  * @brief The CmdBoardNetLineAdd class
  */
-class CmdBoardNetLineAdd final : public UndoCommand
+class CmdBoardNetLineAdd final : public UndoCommand,
+                                 public PooledObject<CmdBoardNetLineAdd>
 {
     public:
 
@@ -24,6 +24,8 @@
 #include "cmdboardnetlineremove.h"
 #include "../board.h"
 #include "../items/bi_netline.h"
+#include "../graphicsitems/bgi_netline.h"
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -37,7 +39,7 @@ namespace project {
 
 CmdBoardNetLineRemove::CmdBoardNetLineRemove(BI_NetLine& netline) noexcept :
     UndoCommand(tr("Remove board trace")),
-    mBoard(netline.getBoard()), mNetLine(netline)
+    mBoard(netline.getBoard()), mNetLine(netline), mRemovedItemMemoryUsage(0)
 {
 }
 
@@ -45,12 +47,30 @@ CmdBoardNetLineRemove::~CmdBoardNetLineRemove() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdBoardNetLineRemove::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    if (isCurrentlyExecuted()) {
+        // the removed trace (inclusive its graphics item) is kept alive by this command
+        size += mRemovedItemMemoryUsage;
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
 bool CmdBoardNetLineRemove::performExecute()
 {
+    // the removed trace is not modified anymore, so calculate its size only once
+    mRemovedItemMemoryUsage = sizeof(BI_NetLine) + sizeof(BGI_NetLine)
+                            + MemoryReport::getPathSize(mNetLine.getGrabAreaScenePx());
+
     performRedo(); // can throw
 
     return true;
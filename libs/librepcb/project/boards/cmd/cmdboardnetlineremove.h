@@ -50,6 +50,11 @@ class CmdBoardNetLineRemove final : public UndoCommand
         explicit CmdBoardNetLineRemove(BI_NetLine& netline) noexcept;
         ~CmdBoardNetLineRemove() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
 
     private:
 
@@ -69,6 +74,7 @@ class CmdBoardNetLineRemove final : public UndoCommand
 
         Board& mBoard;
         BI_NetLine& mNetLine;
+        qint64 mRemovedItemMemoryUsage; ///< calculated once on execution
 };
 
 /*****************************************************************************************
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/undocommand.h>
+#include <librepcb/common/objectpool.h>
 #include <librepcb/common/units/point.h>
 
 /*****************************************************************************************
@@ -49,7 +50,8 @@ class BI_Via;
 /**
  * @brief The CmdBoardNetPointAdd class
  */
-class CmdBoardNetPointAdd final : public UndoCommand
+class CmdBoardNetPointAdd final : public UndoCommand,
+                                  public PooledObject<CmdBoardNetPointAdd>
 {
     public:
 
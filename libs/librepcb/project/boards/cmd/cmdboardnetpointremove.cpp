@@ -24,6 +24,8 @@
 #include "cmdboardnetpointremove.h"
 #include "../board.h"
 #include "../items/bi_netpoint.h"
+#include "../graphicsitems/bgi_netpoint.h"
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -37,7 +39,7 @@ namespace project {
 
 CmdBoardNetPointRemove::CmdBoardNetPointRemove(BI_NetPoint& netpoint) noexcept :
     UndoCommand(tr("Remove netpoint")),
-    mBoard(netpoint.getBoard()), mNetPoint(netpoint)
+    mBoard(netpoint.getBoard()), mNetPoint(netpoint), mRemovedItemMemoryUsage(0)
 {
 }
 
@@ -45,12 +47,30 @@ CmdBoardNetPointRemove::~CmdBoardNetPointRemove() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdBoardNetPointRemove::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    if (isCurrentlyExecuted()) {
+        // the removed netpoint (inclusive its graphics item) is kept alive by this command
+        size += mRemovedItemMemoryUsage;
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
 bool CmdBoardNetPointRemove::performExecute()
 {
+    // the removed netpoint is not modified anymore, so calculate its size only once
+    mRemovedItemMemoryUsage = sizeof(BI_NetPoint) + sizeof(BGI_NetPoint)
+                            + MemoryReport::getPathSize(mNetPoint.getGrabAreaScenePx());
+
     performRedo(); // can throw
 
     return true;
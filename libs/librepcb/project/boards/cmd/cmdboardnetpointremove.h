@@ -50,6 +50,11 @@ class CmdBoardNetPointRemove final : public UndoCommand
         explicit CmdBoardNetPointRemove(BI_NetPoint& netpoint) noexcept;
         ~CmdBoardNetPointRemove() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
 
     private:
 
@@ -69,6 +74,7 @@ class CmdBoardNetPointRemove final : public UndoCommand
 
         Board& mBoard;
         BI_NetPoint& mNetPoint;
+        qint64 mRemovedItemMemoryUsage; ///< calculated once on execution
 };
 
 /*****************************************************************************************
@@ -24,6 +24,8 @@
 #include "cmdboardviaremove.h"
 #include "../board.h"
 #include "../items/bi_via.h"
+#include "../graphicsitems/bgi_via.h"
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -37,7 +39,7 @@ namespace project {
 
 CmdBoardViaRemove::CmdBoardViaRemove(BI_Via& via) noexcept :
     UndoCommand(tr("Remove via")),
-    mBoard(via.getBoard()), mVia(via)
+    mBoard(via.getBoard()), mVia(via), mRemovedItemMemoryUsage(0)
 {
 }
 
@@ -45,12 +47,30 @@ CmdBoardViaRemove::~CmdBoardViaRemove() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdBoardViaRemove::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    if (isCurrentlyExecuted()) {
+        // the removed via (inclusive its graphics item) is kept alive by this command
+        size += mRemovedItemMemoryUsage;
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
 bool CmdBoardViaRemove::performExecute()
 {
+    // the removed via is not modified anymore, so calculate its size only once
+    mRemovedItemMemoryUsage = sizeof(BI_Via) + sizeof(BGI_Via)
+                            + MemoryReport::getPathSize(mVia.getGrabAreaScenePx());
+
     performRedo(); // can throw
 
     return true;
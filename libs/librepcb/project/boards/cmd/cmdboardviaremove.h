@@ -50,6 +50,11 @@ class CmdBoardViaRemove final : public UndoCommand
         explicit CmdBoardViaRemove(BI_Via& via) noexcept;
         ~CmdBoardViaRemove() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
 
     private:
 
@@ -69,6 +74,7 @@ class CmdBoardViaRemove final : public UndoCommand
 
         Board& mBoard;
         BI_Via& mVia;
+        qint64 mRemovedItemMemoryUsage; ///< calculated once on execution
 };
 
 /*****************************************************************************************
@@ -0,0 +1,86 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdboardviasadd.h"
+#include "../board.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdBoardViasAdd::CmdBoardViasAdd(Board& board, const QVector<Point>& positions,
+        BI_Via::Shape shape, const Length& size, const Length& drillDiameter,
+        NetSignal* netsignal) noexcept :
+    UndoCommand(tr("Add vias")),
+    mBoard(board), mPositions(positions), mShape(shape), mSize(size),
+    mDrillDiameter(drillDiameter), mNetSignal(netsignal)
+{
+}
+
+CmdBoardViasAdd::~CmdBoardViasAdd() noexcept
+{
+    if (!isCurrentlyExecuted()) {
+        qDeleteAll(mVias);
+    }
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdBoardViasAdd::performExecute()
+{
+    // create all vias (they are deleted in the destructor if adding fails)
+    mVias.reserve(mPositions.count());
+    foreach (const Point& position, mPositions) {
+        mVias.append(new BI_Via(mBoard, position, mShape, mSize, mDrillDiameter,
+                                mNetSignal)); // can throw
+    }
+
+    performRedo(); // can throw
+
+    return (!mVias.isEmpty());
+}
+
+void CmdBoardViasAdd::performUndo()
+{
+    mBoard.removeVias(mVias); // can throw
+}
+
+void CmdBoardViasAdd::performRedo()
+{
+    mBoard.addVias(mVias); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
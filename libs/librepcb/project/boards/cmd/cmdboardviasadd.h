@@ -0,0 +1,99 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CMDBOARDVIASADD_H
+#define LIBREPCB_PROJECT_CMDBOARDVIASADD_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommand.h>
+#include <librepcb/common/units/point.h>
+#include "../items/bi_via.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class CmdBoardViasAdd
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdBoardViasAdd class adds many vias of the same kind to a board at once
+ *
+ * In contrast to a group of librepcb::project::CmdBoardViaAdd commands, all vias are
+ * added with librepcb::project::Board::addVias(), i.e. in one bulk update of the board.
+ */
+class CmdBoardViasAdd final : public UndoCommand
+{
+    public:
+
+        // Constructors / Destructor
+        CmdBoardViasAdd(Board& board, const QVector<Point>& positions, BI_Via::Shape shape,
+                        const Length& size, const Length& drillDiameter,
+                        NetSignal* netsignal) noexcept;
+        ~CmdBoardViasAdd() noexcept;
+
+        // Getters
+        const QList<BI_Via*>& getVias() const noexcept {return mVias;}
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+
+        // Private Member Variables
+
+        // Attributes from the constructor
+        Board& mBoard;
+        QVector<Point> mPositions;
+        BI_Via::Shape mShape;
+        Length mSize;
+        Length mDrillDiameter;
+        NetSignal* mNetSignal;
+
+        /// @brief The created vias
+        QList<BI_Via*> mVias;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDBOARDVIASADD_H
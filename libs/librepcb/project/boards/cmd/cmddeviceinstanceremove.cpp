@@ -23,7 +23,12 @@
 #include <QtCore>
 #include "cmddeviceinstanceremove.h"
 #include "../items/bi_device.h"
+#include "../items/bi_footprint.h"
+#include "../items/bi_footprintpad.h"
+#include "../graphicsitems/bgi_footprint.h"
+#include "../graphicsitems/bgi_footprintpad.h"
 #include "../board.h"
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -37,7 +42,7 @@ namespace project {
 
 CmdDeviceInstanceRemove::CmdDeviceInstanceRemove(Board& board, BI_Device& dev) noexcept :
     UndoCommand(tr("Remove device instance")),
-    mBoard(board), mDevice(dev)
+    mBoard(board), mDevice(dev), mRemovedItemMemoryUsage(0)
 {
 }
 
@@ -45,12 +50,36 @@ CmdDeviceInstanceRemove::~CmdDeviceInstanceRemove() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdDeviceInstanceRemove::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    if (isCurrentlyExecuted()) {
+        // the removed device (inclusive its footprint, pads and their graphics items) is
+        // kept alive by this command
+        size += mRemovedItemMemoryUsage;
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
 bool CmdDeviceInstanceRemove::performExecute()
 {
+    // the removed device is not modified anymore, so calculate its size only once
+    const BI_Footprint& footprint = mDevice.getFootprint();
+    mRemovedItemMemoryUsage = sizeof(BI_Device) + sizeof(BI_Footprint) + sizeof(BGI_Footprint)
+                            + MemoryReport::getPathSize(footprint.getGrabAreaScenePx());
+    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+        mRemovedItemMemoryUsage += sizeof(BI_FootprintPad) + sizeof(BGI_FootprintPad)
+                                 + MemoryReport::getPathSize(pad->getGrabAreaScenePx());
+    }
+
     performRedo(); // can throw
 
     return true;
@@ -50,6 +50,11 @@ class CmdDeviceInstanceRemove final : public UndoCommand
         CmdDeviceInstanceRemove(Board& board, BI_Device& dev) noexcept;
         ~CmdDeviceInstanceRemove() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
 
     private:
 
@@ -70,6 +75,7 @@ class CmdDeviceInstanceRemove final : public UndoCommand
         // Attributes from the constructor
         Board& mBoard;
         BI_Device& mDevice;
+        qint64 mRemovedItemMemoryUsage; ///< calculated once on execution
 };
 
 /*****************************************************************************************
@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bgi_airwires.h"
+#include "../board.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BGI_AirWires::BGI_AirWires(const GraphicsLayer& layer) noexcept :
+    QGraphicsItem(), mLayer(layer), mBoundingRectValid(true)
+{
+    setZValue(Board::ZValue_AirWires);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+    setVisible(mLayer.isVisible());
+    mLayer.registerObserver(*this);
+}
+
+BGI_AirWires::~BGI_AirWires() noexcept
+{
+    mLayer.unregisterObserver(*this);
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BGI_AirWires::setAirWires(const Uuid& netsignal, const QVector<QLineF>& lines) noexcept
+{
+    if (lines.isEmpty() && (!mLines.contains(netsignal))) {
+        return; // nothing to do (the common case for completely routed nets)
+    }
+    prepareGeometryChange();
+    if (lines.isEmpty()) {
+        mLines.remove(netsignal);
+    } else {
+        mLines.insert(netsignal, lines);
+    }
+    mBoundingRectValid = false;
+}
+
+void BGI_AirWires::clear() noexcept
+{
+    prepareGeometryChange();
+    mLines.clear();
+    mBoundingRectValid = false;
+}
+
+/*****************************************************************************************
+ *  Inherited from IF_GraphicsLayerObserver
+ ****************************************************************************************/
+
+void BGI_AirWires::layerColorChanged(const GraphicsLayer& layer, const QColor& newColor) noexcept
+{
+    Q_UNUSED(layer);
+    Q_UNUSED(newColor);
+    Q_ASSERT(&layer == &mLayer);
+    update();
+}
+
+void BGI_AirWires::layerHighlightColorChanged(const GraphicsLayer& layer, const QColor& newColor) noexcept
+{
+    layerColorChanged(layer, newColor);
+}
+
+void BGI_AirWires::layerVisibleChanged(const GraphicsLayer& layer, bool newVisible) noexcept
+{
+    Q_UNUSED(layer);
+    Q_UNUSED(newVisible);
+    Q_ASSERT(&layer == &mLayer);
+    setVisible(mLayer.isVisible());
+}
+
+void BGI_AirWires::layerEnabledChanged(const GraphicsLayer& layer, bool newEnabled) noexcept
+{
+    layerVisibleChanged(layer, newEnabled);
+}
+
+/*****************************************************************************************
+ *  Inherited from QGraphicsItem
+ ****************************************************************************************/
+
+QRectF BGI_AirWires::boundingRect() const
+{
+    if (!mBoundingRectValid) {
+        mBoundingRect = QRectF();
+        foreach (const QVector<QLineF>& lines, mLines) {
+            foreach (const QLineF& line, lines) {
+                mBoundingRect |= QRectF(line.p1(), line.p2()).normalized();
+            }
+        }
+        // add some margin as the cosmetic pen is drawn outside exact zero-width rects
+        mBoundingRect.adjust(-1, -1, 1, 1);
+        mBoundingRectValid = true;
+    }
+    return mBoundingRect;
+}
+
+void BGI_AirWires::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+
+    // collect all exposed lines
+    QVector<QLineF> exposed;
+    foreach (const QVector<QLineF>& lines, mLines) {
+        foreach (const QLineF& line, lines) {
+            QRectF rect = QRectF(line.p1(), line.p2()).normalized().adjusted(-1, -1, 1, 1);
+            if (option->exposedRect.intersects(rect)) {
+                exposed.append(line);
+            }
+        }
+    }
+
+    // airwires are always drawn with a cosmetic pen and a single call
+    painter->setPen(QPen(mLayer.getColor(false), 0));
+    painter->drawLines(exposed);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
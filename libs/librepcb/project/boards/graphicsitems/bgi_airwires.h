@@ -0,0 +1,98 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BGI_AIRWIRES_H
+#define LIBREPCB_PROJECT_BGI_AIRWIRES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Class BGI_AirWires
+ ****************************************************************************************/
+
+/**
+ * @brief The BGI_AirWires class draws all airwires (unrouted connections) of a board
+ *
+ * There is only one such item per board (owned by librepcb::project::BoardAirWires).
+ * The airwires are stored per net signal, so when a single net signal has changed,
+ * only its lines get replaced.
+ *
+ * @note This item is not derived from librepcb::project::BGI_Base, so airwires are
+ *       not selectable.
+ */
+class BGI_AirWires final : public QGraphicsItem, public IF_GraphicsLayerObserver
+{
+    public:
+
+        // Constructors / Destructor
+        explicit BGI_AirWires(const GraphicsLayer& layer) noexcept;
+        ~BGI_AirWires() noexcept;
+
+        // General Methods
+        void setAirWires(const Uuid& netsignal, const QVector<QLineF>& lines) noexcept;
+        void clear() noexcept;
+
+        // Inherited from IF_GraphicsLayerObserver
+        void layerColorChanged(const GraphicsLayer& layer, const QColor& newColor) noexcept override;
+        void layerHighlightColorChanged(const GraphicsLayer& layer, const QColor& newColor) noexcept override;
+        void layerVisibleChanged(const GraphicsLayer& layer, bool newVisible) noexcept override;
+        void layerEnabledChanged(const GraphicsLayer& layer, bool newEnabled) noexcept override;
+
+        // Inherited from QGraphicsItem
+        QRectF boundingRect() const;
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+
+
+    private:
+
+        // make some methods inaccessible...
+        BGI_AirWires() = delete;
+        BGI_AirWires(const BGI_AirWires& other) = delete;
+        BGI_AirWires& operator=(const BGI_AirWires& rhs) = delete;
+
+
+        // Attributes
+        const GraphicsLayer& mLayer;
+        QHash<Uuid, QVector<QLineF>> mLines;
+
+        // Cached Attributes
+        mutable QRectF mBoundingRect;
+        mutable bool mBoundingRectValid;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BGI_AIRWIRES_H
@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QPrinter>
 #include "bgi_base.h"
 #include <librepcb/common/graphics/graphicslayer.h>
 #include "../board.h"
@@ -35,7 +36,8 @@ namespace project {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-BGI_Base::BGI_Base() noexcept
+BGI_Base::BGI_Base(BI_Base& item) noexcept :
+    QGraphicsItem(), mBoardItem(item)
 {
 
 }
@@ -46,9 +48,24 @@ BGI_Base::~BGI_Base() noexcept
 }
 
 /*****************************************************************************************
- *  Protected Methods
+ *  Static Methods
  ****************************************************************************************/
 
+GraphicsScene::LevelOfDetail BGI_Base::getLevelOfDetail(const QGraphicsItem& item,
+                                                      const QPainter& painter,
+                                                      const QWidget* widget) noexcept
+{
+    // The widget is only passed if the item is painted for a view, also when painting
+    // into the device coordinate cache (then the paint device is a pixmap). Renderings
+    // with QGraphicsScene::render() have no widget.
+    const GraphicsScene* graphicsScene = qobject_cast<const GraphicsScene*>(item.scene());
+    if (graphicsScene && widget && (!dynamic_cast<QPrinter*>(painter.device()))) {
+        return graphicsScene->getLevelOfDetail();
+    } else {
+        return GraphicsScene::LevelOfDetail{0, 0, 0};
+    }
+}
+
 qreal BGI_Base::getZValueOfCopperLayer(const QString& name) noexcept
 {
     if (GraphicsLayer::isTopLayer(name)) {
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <librepcb/common/graphics/graphicsscene.h>
 #include "../board.h"
 
 /*****************************************************************************************
@@ -33,6 +34,8 @@
 namespace librepcb {
 namespace project {
 
+class BI_Base;
+
 /*****************************************************************************************
  *  Class BGI_Base
  ****************************************************************************************/
@@ -45,11 +48,36 @@ class BGI_Base : public QGraphicsItem
     public:
 
         // Constructors / Destructor
-        explicit BGI_Base() noexcept;
+        explicit BGI_Base(BI_Base& item) noexcept;
         virtual ~BGI_Base() noexcept;
 
+        // Getters
+
+        /**
+         * @brief Get the board item which is represented by this graphics item
+         *
+         * This allows to find board items through the spatial index of the graphics
+         * scene (see librepcb::project::Board::getItemsAtScenePos()).
+         */
+        BI_Base& getBoardItem() const noexcept {return mBoardItem;}
 
-    protected:
+        // Static Methods
+
+        /**
+         * @brief Get the level-of-detail thresholds to use for painting
+         *
+         * @param item      The item to paint
+         * @param painter   The painter used to paint the item
+         * @param widget    The widget passed to QGraphicsItem::paint()
+         *
+         * @return The thresholds of the scene the item belongs to, if the item is
+         *         painted for a view (directly or into its device coordinate cache).
+         *         For offscreen renderings (e.g. printing, image exports or the board
+         *         icon), all thresholds are zero, so everything is drawn.
+         */
+        static GraphicsScene::LevelOfDetail getLevelOfDetail(const QGraphicsItem& item,
+                                                             const QPainter& painter,
+                                                             const QWidget* widget) noexcept;
 
         static qreal getZValueOfCopperLayer(const QString& name) noexcept;
 
@@ -57,9 +85,11 @@ class BGI_Base : public QGraphicsItem
     private:
 
         // make some methods inaccessible...
-        //BGI_Base() = delete;
+        BGI_Base() = delete;
         BGI_Base(const BGI_Base& other) = delete;
         BGI_Base& operator=(const BGI_Base& rhs) = delete;
+
+        BI_Base& mBoardItem;
 };
 
 /*****************************************************************************************
@@ -42,11 +42,10 @@ namespace project {
  ****************************************************************************************/
 
 BGI_Footprint::BGI_Footprint(BI_Footprint& footprint) noexcept :
-    BGI_Base(), mFootprint(footprint), mLibFootprint(footprint.getLibFootprint())
+    BGI_Base(footprint), mFootprint(footprint), mLibFootprint(footprint.getLibFootprint())
 {
-    mFont.setStyleStrategy(QFont::StyleStrategy(QFont::OpenGLCompatible | QFont::PreferQuality));
-    mFont.setStyleHint(QFont::SansSerif);
-    mFont.setFamily("Nimbus Sans L");
+    // paint into a cached pixmap which is reused for panning until the item changes
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 
     updateCacheAndRepaint();
 }
@@ -74,97 +73,69 @@ void BGI_Footprint::updateCacheAndRepaint() noexcept
     GraphicsLayer* layer = nullptr;
     prepareGeometryChange();
 
-    mBoundingRect = QRectF();
-    mShape = QPainterPath();
-
     // set Z value
     if (mFootprint.getIsMirrored())
         setZValue(Board::ZValue_FootprintsBottom);
     else
         setZValue(Board::ZValue_FootprintsTop);
 
-    // cross rect
-    layer = getLayer(GraphicsLayer::sTopReferences);
-    if (layer) {
-        if (layer->isVisible()) {
-            qreal width = Length(700000).toPx();
-            QRectF crossRect(-width, -width, 2*width, 2*width);
-            mBoundingRect = mBoundingRect.united(crossRect);
-            mShape.addRect(crossRect);
-        }
-    }
-
-    // polygons
-    for (const Polygon& polygon : mLibFootprint.getPolygons()) {
-        layer = getLayer(polygon.getLayerName());
-        if (!layer) continue;
-        if (!layer->isVisible()) continue;
-
-        QPainterPath polygonPath = polygon.toQPainterPathPx();
-        qreal w = polygon.getLineWidth().toPx() / 2;
-        mBoundingRect = mBoundingRect.united(polygonPath.boundingRect().adjusted(-w, -w, w, w));
-        if (!polygon.isGrabArea()) continue;
-        layer = getLayer(GraphicsLayer::sTopGrabAreas);
-        if (!layer) continue;
-        if (!layer->isVisible()) continue;
-        mShape = mShape.united(polygonPath);
-    }
-
-    // texts
-    mCachedTextProperties.clear();
+    // cross rect and polygons (shared with all instances of the library footprint, the
+    // position, rotation and mirroring is applied by the transformation of the item)
+    mSharedGeometry = getSharedGeometry();
+    mBoundingRect = mSharedGeometry->boundingRect;
+    mOutlineRect = mSharedGeometry->outlineRect;
+    mShape = mSharedGeometry->shape;
+
+    // texts (only laid out again if the displayed text or its orientation has changed,
+    // e.g. not when the item was just moved)
+    QHash<const Text*, CachedTextProperties_t> oldTextProperties;
+    oldTextProperties.swap(mCachedTextProperties);
     for (const Text& text : mLibFootprint.getTexts()) {
         layer = getLayer(text.getLayerName());
         if (!layer) continue;
         if (!layer->isVisible()) continue;
 
-        // create static text properties
-        CachedTextProperties_t props;
-
         // get the text to display
-        props.text = text.getText();
-        mFootprint.replaceVariablesWithAttributes(props.text, true);
-
-        // calculate font metrics
-        props.fontPixelSize = qCeil(text.getHeight().toPx());
-        mFont.setPixelSize(props.fontPixelSize);
-        QFontMetricsF metrics(mFont);
-        props.scaleFactor = text.getHeight().toPx() / metrics.height();
-        props.textRect = metrics.boundingRect(QRectF(), text.getAlign().toQtAlign() |
-                                              Qt::TextDontClip, props.text);
-        QRectF scaledTextRect = QRectF(props.textRect.topLeft() * props.scaleFactor,
-                                       props.textRect.bottomRight() * props.scaleFactor);
+        QString displayText = text.getText();
+        mFootprint.replaceVariablesWithAttributes(displayText, true);
 
         // check rotation
         Angle absAngle = text.getRotation() + mFootprint.getRotation();
         absAngle.mapTo180deg();
-        props.rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
+        bool rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
 
-        // calculate text position
-        scaledTextRect.translate(text.getPosition().toPxQPointF());
+        // reuse the cached properties if nothing relevant has changed
+        auto oldProps = oldTextProperties.constFind(&text);
+        if ((oldProps != oldTextProperties.constEnd()) && (oldProps->text == displayText)
+            && (oldProps->rotate180 == rotate180))
+        {
+            mBoundingRect = mBoundingRect.united(oldProps->boundingRect);
+            mCachedTextProperties.insert(&text, oldProps.value());
+            continue;
+        }
 
-        // text alignment
-        if (props.rotate180)
-            props.flags = text.getAlign().mirrored().toQtAlign();
-        else
-            props.flags = text.getAlign().toQtAlign();
+        // create static text properties
+        CachedTextProperties_t props;
+        props.text = displayText;
+        props.rotate180 = rotate180;
+
+        // lay out the text only once (shared with all identical texts), upside down
+        // texts are rotated by 180° with mirrored alignment to keep them readable
+        props.layout = StrokeFont::get(props.text, text.getHeight(), rotate180 ?
+                                       text.getAlign().mirrored() : text.getAlign());
+        props.transform.translate(text.getPosition().toPxQPointF().x(),
+                                  text.getPosition().toPxQPointF().y());
+        props.transform.rotate(-text.getRotation().toDeg());
+        if (props.rotate180) props.transform.rotate(180);
 
         // calculate text bounding rect
-        mBoundingRect = mBoundingRect.united(scaledTextRect);
-        props.textRect = QRectF(scaledTextRect.topLeft() / props.scaleFactor,
-                                scaledTextRect.bottomRight() / props.scaleFactor);
-        if (props.rotate180)
-        {
-            props.textRect = QRectF(-props.textRect.x(), -props.textRect.y(),
-                                    -props.textRect.width(), -props.textRect.height()).normalized();
-        }
+        props.boundingRect = props.transform.mapRect(props.layout.boundingRect);
+        mBoundingRect = mBoundingRect.united(props.boundingRect);
 
         // save properties
         mCachedTextProperties.insert(&text, props);
     }
 
-    if (!mShape.isEmpty())
-        mShape.setFillRule(Qt::WindingFill);
-
     setVisible(!mBoundingRect.isEmpty());
 
     update();
@@ -176,12 +147,22 @@ void BGI_Footprint::updateCacheAndRepaint() noexcept
 
 void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(widget);
-
     const GraphicsLayer* layer = 0;
     const bool selected = mFootprint.isSelected();
     const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
     const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const GraphicsScene::LevelOfDetail thresholds = getLevelOfDetail(*this, *painter, widget);
+
+    // draw only a simplified outline if the footprint is too small on the screen
+    if (lod * qMax(mOutlineRect.width(), mOutlineRect.height()) < thresholds.minFootprintSize) {
+        layer = getLayer(GraphicsLayer::sTopPlacement);
+        if (layer && layer->isVisible() && (!mOutlineRect.isEmpty())) {
+            painter->setPen(QPen(layer->getColor(selected), 0));
+            painter->setBrush(Qt::NoBrush);
+            painter->drawRect(mOutlineRect);
+        }
+        return;
+    }
 
     // draw all polygons
     for (const Polygon& polygon : mLibFootprint.getPolygons()) {
@@ -258,29 +239,18 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
         if (!layer) continue;
         if (!layer->isVisible()) continue;
 
-        // get cached text properties
-        const CachedTextProperties_t& props = mCachedTextProperties.value(&text);
-        mFont.setPixelSize(props.fontPixelSize);
+        // skip texts which are too small to be readable anyway
+        if (lod * text.getHeight().toPx() < thresholds.minTextSize) continue;
 
-        // draw text or rect
+        // draw the cached text layout (same strokes as in the Gerber export)
+        const CachedTextProperties_t& props = mCachedTextProperties.value(&text);
         painter->save();
-        painter->translate(text.getPosition().toPxQPointF());
-        painter->rotate(-text.getRotation().toDeg());
-        painter->translate(-text.getPosition().toPxQPointF());
-        painter->scale(props.scaleFactor, props.scaleFactor);
-        if (props.rotate180) painter->rotate(180);
-        if ((deviceIsPrinter) || (lod * text.getHeight().toPx() > 8))
-        {
-            // draw text
-            painter->setPen(QPen(layer->getColor(selected), 0));
-            painter->setFont(mFont);
-            painter->drawText(props.textRect, props.flags, props.text);
-        }
-        else
-        {
-            // fill rect
-            painter->fillRect(props.textRect, QBrush(layer->getColor(selected), Qt::Dense5Pattern));
-        }
+        painter->setTransform(props.transform, true);
+        painter->setPen(QPen(layer->getColor(selected),
+                             StrokeFont::getStrokeWidth(text.getHeight()).toPx(),
+                             Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawPath(props.layout.path);
 #ifdef QT_DEBUG
         layer = getLayer(GraphicsLayer::sDebugGraphicsItemsTextsBoundingRects);
         if (layer) {
@@ -288,7 +258,7 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
                 // draw text bounding rect
                 painter->setPen(QPen(layer->getColor(selected), 0));
                 painter->setBrush(Qt::NoBrush);
-                painter->drawRect(props.textRect);
+                painter->drawRect(props.layout.boundingRect);
             }
         }
 #endif
@@ -345,6 +315,68 @@ GraphicsLayer* BGI_Footprint::getLayer(QString name) const noexcept
     return mFootprint.getDeviceInstance().getBoard().getLayerStack().getLayer(name);
 }
 
+std::shared_ptr<const BGI_Footprint::SharedGeometry_t> BGI_Footprint::getSharedGeometry() const noexcept
+{
+    // The geometry depends on the visibility of the layers, so they are part of the key.
+    // Entries are only referenced weakly, i.e. they are released together with the
+    // last graphics item which uses them.
+    static QHash<QPair<const library::Footprint*, QBitArray>,
+                 std::weak_ptr<const SharedGeometry_t>> sCache;
+
+    const PolygonList& polygons = mLibFootprint.getPolygons();
+    QBitArray visibility(polygons.count() + 2);
+    GraphicsLayer* layer = getLayer(GraphicsLayer::sTopReferences);
+    visibility.setBit(0, layer && layer->isVisible());
+    layer = getLayer(GraphicsLayer::sTopGrabAreas);
+    visibility.setBit(1, layer && layer->isVisible());
+    for (int i = 0; i < polygons.count(); ++i) {
+        layer = getLayer(polygons[i]->getLayerName());
+        visibility.setBit(i + 2, layer && layer->isVisible());
+    }
+    QPair<const library::Footprint*, QBitArray> key(&mLibFootprint, visibility);
+    if (std::shared_ptr<const SharedGeometry_t> geometry = sCache.value(key).lock()) {
+        return geometry;
+    }
+
+    std::shared_ptr<SharedGeometry_t> geometry = std::make_shared<SharedGeometry_t>();
+
+    // cross rect
+    if (visibility.testBit(0)) {
+        qreal width = Length(700000).toPx();
+        QRectF crossRect(-width, -width, 2*width, 2*width);
+        geometry->boundingRect = geometry->boundingRect.united(crossRect);
+        geometry->shape.addRect(crossRect);
+    }
+
+    // polygons
+    for (int i = 0; i < polygons.count(); ++i) {
+        if (!visibility.testBit(i + 2)) continue;
+        const Polygon& polygon = *polygons[i];
+        QPainterPath polygonPath = polygon.toQPainterPathPx();
+        qreal w = polygon.getLineWidth().toPx() / 2;
+        geometry->boundingRect = geometry->boundingRect.united(
+            polygonPath.boundingRect().adjusted(-w, -w, w, w));
+        geometry->outlineRect = geometry->outlineRect.united(polygonPath.boundingRect());
+        if (polygon.isGrabArea() && visibility.testBit(1)) {
+            geometry->shape = geometry->shape.united(polygonPath);
+        }
+    }
+
+    if (!geometry->shape.isEmpty())
+        geometry->shape.setFillRule(Qt::WindingFill);
+
+    // remove expired entries before adding the new one
+    for (auto it = sCache.begin(); it != sCache.end();) {
+        if (it.value().expired()) {
+            it = sCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    sCache.insert(key, geometry);
+    return geometry;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -23,8 +23,10 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
+#include <librepcb/common/graphics/strokefont.h>
 #include "bgi_base.h"
 
 /*****************************************************************************************
@@ -80,30 +82,41 @@ class BGI_Footprint final : public BGI_Base
         BGI_Footprint(const BGI_Footprint& other) = delete;
         BGI_Footprint& operator=(const BGI_Footprint& rhs) = delete;
 
-        // Private Methods
-        GraphicsLayer* getLayer(QString name) const noexcept;
-
-
         // Types
 
+        /**
+         * @brief Geometry which only depends on the library footprint and the visible
+         *        layers, shared between all instances of the same library footprint
+         */
+        struct SharedGeometry_t {
+            QRectF boundingRect; ///< origin cross and polygons (incl. line width)
+            QRectF outlineRect;  ///< bounding rect of all polygons (for level-of-detail)
+            QPainterPath shape;  ///< origin cross and grab area polygons
+        };
+
         struct CachedTextProperties_t {
             QString text;
-            int fontPixelSize;
-            qreal scaleFactor;
             bool rotate180;
-            int flags;
-            QRectF textRect;    // not scaled
+            StrokeFont::Layout layout;  // shared with all identical texts
+            QTransform transform;       // from the layout to item coordinates
+            QRectF boundingRect;        // part of the bounding rect of the item
         };
 
 
+        // Private Methods
+        GraphicsLayer* getLayer(QString name) const noexcept;
+        std::shared_ptr<const SharedGeometry_t> getSharedGeometry() const noexcept;
+
+
         // General Attributes
         BI_Footprint& mFootprint;
         const library::Footprint& mLibFootprint;
-        QFont mFont;
 
         // Cached Attributes
         QRectF mBoundingRect;
+        QRectF mOutlineRect; ///< bounding rect of all polygons (for level-of-detail)
         QPainterPath mShape;
+        std::shared_ptr<const SharedGeometry_t> mSharedGeometry;
         QHash<const Text*, CachedTextProperties_t> mCachedTextProperties;
 };
 
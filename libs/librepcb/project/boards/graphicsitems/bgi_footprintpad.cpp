@@ -47,10 +47,13 @@ namespace project {
  ****************************************************************************************/
 
 BGI_FootprintPad::BGI_FootprintPad(BI_FootprintPad& pad) noexcept :
-    BGI_Base(), mPad(pad), mLibPad(pad.getLibPad()), mPadLayer(nullptr),
+    BGI_Base(pad), mPad(pad), mLibPad(pad.getLibPad()), mPadLayer(nullptr),
     mTopStopMaskLayer(nullptr), mBottomStopMaskLayer(nullptr),
     mTopCreamMaskLayer(nullptr), mBottomCreamMaskLayer(nullptr)
 {
+    // paint into a cached pixmap which is reused for panning until the item changes
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
     setToolTip(mPad.getDisplayText());
 
     mFont.setStyleStrategy(QFont::StyleStrategy(QFont::OpenGLCompatible | QFont::PreferQuality));
@@ -130,14 +133,21 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept
 
 void BGI_FootprintPad::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
-    Q_UNUSED(widget);
-    //const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
-    //const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const GraphicsScene::LevelOfDetail thresholds = getLevelOfDetail(*this, *painter, widget);
 
     const NetSignal* netsignal = mPad.getCompSigInstNetSignal();
     bool highlight = mPad.isSelected() || (netsignal && netsignal->isHighlighted());
 
+    // draw only a filled rect (without masks and text) if the pad is very small
+    QRectF padRect = mLibPad.getBoundingRectPx();
+    if (lod * qMax(padRect.width(), padRect.height()) < thresholds.minPadSize) {
+        if (mPadLayer && mPadLayer->isVisible()) {
+            painter->fillRect(padRect, mPadLayer->getColor(highlight));
+        }
+        return;
+    }
+
     if (mBottomCreamMaskLayer && mBottomCreamMaskLayer->isVisible()) {
         // draw bottom cream mask
         painter->setPen(Qt::NoPen);
@@ -158,9 +168,11 @@ void BGI_FootprintPad::paint(QPainter* painter, const QStyleOptionGraphicsItem*
         painter->setBrush(mPadLayer->getColor(highlight));
         painter->drawPath(mLibPad.toQPainterPathPx());
         // draw pad text
-        painter->setFont(mFont);
-        painter->setPen(mPadLayer->getColor(highlight).lighter(150));
-        painter->drawText(mLibPad.getBoundingRectPx(), Qt::AlignCenter, mPad.getDisplayText());
+        if (lod * mFont.pixelSize() >= thresholds.minTextSize) {
+            painter->setFont(mFont);
+            painter->setPen(mPadLayer->getColor(highlight).lighter(150));
+            painter->drawText(padRect, Qt::AlignCenter, mPad.getDisplayText());
+        }
     }
 
     if (mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
@@ -24,6 +24,7 @@
 #include <QtWidgets>
 #include <QPrinter>
 #include "bgi_netline.h"
+#include "bgi_netlinebatch.h"
 #include "../items/bi_netline.h"
 #include "../items/bi_netpoint.h"
 #include "../board.h"
@@ -42,13 +43,14 @@ namespace project {
  ****************************************************************************************/
 
 BGI_NetLine::BGI_NetLine(BI_NetLine& netline) noexcept :
-    BGI_Base(), mNetLine(netline), mLayer(nullptr)
+    BGI_Base(netline), mNetLine(netline), mLayer(nullptr), mBatch(nullptr)
 {
     updateCacheAndRepaint();
 }
 
 BGI_NetLine::~BGI_NetLine() noexcept
 {
+    if (mBatch) mBatch->removeLine(*this);
 }
 
 /*****************************************************************************************
@@ -87,6 +89,7 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept
     Length width = (mNetLine.getWidth() > Length(100000) ? mNetLine.getWidth() : Length(100000));
     ps.setWidth(width.toPx());
     mShape = ps.createStroke(mShape);
+    updateBatch();
     update();
 }
 
@@ -96,16 +99,21 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept
 
 void BGI_NetLine::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
-    Q_UNUSED(widget);
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const GraphicsScene::LevelOfDetail thresholds = getLevelOfDetail(*this, *painter, widget);
 
     bool highlight = mNetLine.isSelected() || mNetLine.getNetSignal().isHighlighted();
 
-    // draw line
-    if (mLayer->isVisible())
+    // draw line (as a cheap cosmetic line without caps if it is very thin on the screen),
+    // but only if it is highlighted or not drawn by the batch item of its layer
+    if (mLayer->isVisible() && (highlight || (!mBatch)))
     {
-        QPen pen(mLayer->getColor(highlight), mNetLine.getWidth().toPx(), Qt::SolidLine, Qt::RoundCap);
-        painter->setPen(pen);
+        qreal width = mNetLine.getWidth().toPx();
+        if (lod * width < thresholds.minPadSize) {
+            painter->setPen(QPen(mLayer->getColor(highlight), 0));
+        } else {
+            painter->setPen(QPen(mLayer->getColor(highlight), width, Qt::SolidLine, Qt::RoundCap));
+        }
         painter->drawLine(mLineF);
     }
 
@@ -121,6 +129,14 @@ void BGI_NetLine::paint(QPainter* painter, const QStyleOptionGraphicsItem* optio
 #endif
 }
 
+QVariant BGI_NetLine::itemChange(GraphicsItemChange change, const QVariant& value)
+{
+    if (change == ItemSceneHasChanged) {
+        updateBatch();
+    }
+    return BGI_Base::itemChange(change, value);
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -130,6 +146,24 @@ GraphicsLayer* BGI_NetLine::getLayer(const QString& name) const noexcept
     return mNetLine.getBoard().getLayerStack().getLayer(name);
 }
 
+void BGI_NetLine::updateBatch() noexcept
+{
+    BGI_NetLineBatch* batch = nullptr;
+    if (scene() && mLayer) {
+        batch = &mNetLine.getBoard().getNetLineBatch(*mLayer);
+    }
+    if (mBatch && (mBatch != batch)) {
+        mBatch->removeLine(*this);
+    }
+    if (batch != mBatch) {
+        setParentItem(batch); // the batch item controls the visibility of its children
+    }
+    mBatch = batch;
+    if (mBatch) {
+        mBatch->setLine(*this, mLineF, mNetLine.getWidth().toPx());
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
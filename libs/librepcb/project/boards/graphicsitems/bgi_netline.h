@@ -37,6 +37,7 @@ class GraphicsLayer;
 namespace project {
 
 class BI_NetLine;
+class BGI_NetLineBatch;
 
 /*****************************************************************************************
  *  Class BGI_NetLine
@@ -63,6 +64,7 @@ class BGI_NetLine final : public BGI_Base
         QRectF boundingRect() const {return mBoundingRect;}
         QPainterPath shape() const {return mShape;}
         void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+        QVariant itemChange(GraphicsItemChange change, const QVariant& value);
 
 
     private:
@@ -74,10 +76,12 @@ class BGI_NetLine final : public BGI_Base
 
         // Private Methods
         GraphicsLayer* getLayer(const QString& name) const noexcept;
+        void updateBatch() noexcept;
 
         // Attributes
         BI_NetLine& mNetLine;
         GraphicsLayer* mLayer;
+        BGI_NetLineBatch* mBatch; ///< draws the line while not highlighted (if in a scene)
 
         // Cached Attributes
         QLineF mLineF;
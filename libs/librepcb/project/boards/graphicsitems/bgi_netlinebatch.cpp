@@ -0,0 +1,227 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bgi_netlinebatch.h"
+#include "bgi_base.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BGI_NetLineBatch::BGI_NetLineBatch(const GraphicsLayer& layer) noexcept :
+    QGraphicsItem(), mLayer(layer)
+{
+    // draw just below the netline items of the same layer to keep highlighted lines on top
+    setZValue(BGI_Base::getZValueOfCopperLayer(mLayer.getName()) - 0.001);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+    setVisible(mLayer.isVisible());
+    mLayer.registerObserver(*this);
+}
+
+BGI_NetLineBatch::~BGI_NetLineBatch() noexcept
+{
+    // the netline items are children of this item, so they must already be gone
+    Q_ASSERT(mLines.isEmpty());
+    Q_ASSERT(childItems().isEmpty());
+    mLayer.unregisterObserver(*this);
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BGI_NetLineBatch::setLine(const BGI_NetLine& item, const QLineF& line, qreal width) noexcept
+{
+    qreal r = width / 2;
+    QRectF rect = QRectF(line.p1(), line.p2()).normalized().adjusted(-r, -r, r, r);
+    QRectF dirtyRect = rect;
+    auto it = mLines.find(&item);
+    if (it != mLines.end()) {
+        if ((it->line == line) && (it->width == width)) return;
+        dirtyRect |= it->rect;
+        removeFromGrid(item, it->rect);
+        *it = Entry{line, width, rect};
+    } else {
+        mLines.insert(&item, Entry{line, width, rect});
+    }
+    addToGrid(item, rect);
+    if (!mBoundingRect.contains(rect)) {
+        prepareGeometryChange();
+        mBoundingRect |= rect;
+    }
+    update(dirtyRect);
+}
+
+void BGI_NetLineBatch::removeLine(const BGI_NetLine& item) noexcept
+{
+    auto it = mLines.find(&item);
+    if (it != mLines.end()) {
+        QRectF rect = it->rect;
+        removeFromGrid(item, rect);
+        mLines.erase(it);
+        if (mLines.isEmpty()) {
+            prepareGeometryChange();
+            mBoundingRect = QRectF();
+        } else {
+            update(rect);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Inherited from IF_GraphicsLayerObserver
+ ****************************************************************************************/
+
+void BGI_NetLineBatch::layerColorChanged(const GraphicsLayer& layer, const QColor& newColor) noexcept
+{
+    Q_UNUSED(layer);
+    Q_UNUSED(newColor);
+    Q_ASSERT(&layer == &mLayer);
+    update(); // the bounding rect contains all child items as well
+}
+
+void BGI_NetLineBatch::layerHighlightColorChanged(const GraphicsLayer& layer, const QColor& newColor) noexcept
+{
+    layerColorChanged(layer, newColor);
+}
+
+void BGI_NetLineBatch::layerVisibleChanged(const GraphicsLayer& layer, bool newVisible) noexcept
+{
+    Q_UNUSED(layer);
+    Q_UNUSED(newVisible);
+    Q_ASSERT(&layer == &mLayer);
+    setVisible(mLayer.isVisible()); // hides or shows all child items too
+}
+
+void BGI_NetLineBatch::layerEnabledChanged(const GraphicsLayer& layer, bool newEnabled) noexcept
+{
+    layerVisibleChanged(layer, newEnabled);
+}
+
+/*****************************************************************************************
+ *  Inherited from QGraphicsItem
+ ****************************************************************************************/
+
+QRectF BGI_NetLineBatch::boundingRect() const
+{
+    return mBoundingRect;
+}
+
+void BGI_NetLineBatch::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const GraphicsScene::LevelOfDetail thresholds =
+        BGI_Base::getLevelOfDetail(*this, *painter, widget);
+
+    // collect the candidates from the grid cells touching the exposed rect
+    const QRectF& exposedRect = option->exposedRect;
+    QSet<const BGI_NetLine*> candidates = mLargeLines;
+    QRect cells = getCells(exposedRect);
+    if (qint64(cells.width()) * cells.height() < mGrid.count()) {
+        for (int x = cells.left(); x <= cells.right(); ++x) {
+            for (int y = cells.top(); y <= cells.bottom(); ++y) {
+                auto it = mGrid.constFind(getCellKey(x, y));
+                if (it != mGrid.constEnd()) candidates.unite(*it);
+            }
+        }
+    } else {
+        // the exposed rect covers more cells than there are occupied ones
+        for (auto it = mGrid.constBegin(); it != mGrid.constEnd(); ++it) {
+            candidates.unite(it.value());
+        }
+    }
+
+    // collect all exposed lines, grouped by their width
+    QMap<qreal, QVector<QLineF>> lines;
+    foreach (const BGI_NetLine* item, candidates) {
+        const Entry& entry = mLines[item];
+        if (exposedRect.intersects(entry.rect)) {
+            // very thin lines on the screen are drawn as cheap cosmetic lines
+            qreal width = (lod * entry.width < thresholds.minPadSize) ? 0 : entry.width;
+            lines[width].append(entry.line);
+        }
+    }
+
+    // draw them with one call per width
+    for (auto it = lines.constBegin(); it != lines.constEnd(); ++it) {
+        painter->setPen(QPen(mLayer.getColor(false), it.key(), Qt::SolidLine, Qt::RoundCap));
+        painter->drawLines(it.value());
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QRect BGI_NetLineBatch::getCells(const QRectF& rect) const noexcept
+{
+    return QRect(QPoint(qFloor(rect.left() / sCellSize), qFloor(rect.top() / sCellSize)),
+                 QPoint(qFloor(rect.right() / sCellSize), qFloor(rect.bottom() / sCellSize)));
+}
+
+void BGI_NetLineBatch::addToGrid(const BGI_NetLine& item, const QRectF& rect) noexcept
+{
+    QRect cells = getCells(rect);
+    if (qint64(cells.width()) * cells.height() > sMaxCellsPerLine) {
+        mLargeLines.insert(&item);
+        return;
+    }
+    for (int x = cells.left(); x <= cells.right(); ++x) {
+        for (int y = cells.top(); y <= cells.bottom(); ++y) {
+            mGrid[getCellKey(x, y)].insert(&item);
+        }
+    }
+}
+
+void BGI_NetLineBatch::removeFromGrid(const BGI_NetLine& item, const QRectF& rect) noexcept
+{
+    if (mLargeLines.remove(&item)) return;
+    QRect cells = getCells(rect);
+    for (int x = cells.left(); x <= cells.right(); ++x) {
+        for (int y = cells.top(); y <= cells.bottom(); ++y) {
+            auto it = mGrid.find(getCellKey(x, y));
+            if (it == mGrid.end()) continue;
+            it->remove(&item);
+            if (it->isEmpty()) mGrid.erase(it);
+        }
+    }
+}
+
+quint64 BGI_NetLineBatch::getCellKey(int x, int y) noexcept
+{
+    return (quint64(quint32(x)) << 32) | quint32(y);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
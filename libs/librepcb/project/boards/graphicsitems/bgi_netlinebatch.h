@@ -0,0 +1,130 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BGI_NETLINEBATCH_H
+#define LIBREPCB_PROJECT_BGI_NETLINEBATCH_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcb/common/graphics/graphicslayer.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class BGI_NetLine;
+
+/*****************************************************************************************
+ *  Class BGI_NetLineBatch
+ ****************************************************************************************/
+
+/**
+ * @brief The BGI_NetLineBatch class draws all netlines of one layer at once
+ *
+ * Painting thousands of netlines with one paint() call per item is dominated by the
+ * per-item overhead of QGraphicsView (painter state save/restore, transformations,
+ * pen setup). So the lines are registered at one batch item per layer and drawn with
+ * a single QPainter::drawLines() call per line width. To keep moving a single line and
+ * repainting a small region cheap, the bounding rect of every line is cached and the
+ * lines are sorted into a coarse grid: only the changed region is repainted, and
+ * paint() only looks at the lines in the grid cells touching the exposed rect. The
+ * bounding rect of the whole batch only grows, so prepareGeometryChange() is only
+ * needed when a line leaves it. The librepcb::project::BGI_NetLine
+ * items stay in the scene for the spatial index (selection, hit testing) and only
+ * paint the line themselves while being highlighted.
+ *
+ * In addition, the batch item is the parent item of all these netline items. So when
+ * the visibility or color of the layer changes, only this item observes the layer and
+ * hides itself (and thereby all its children) or repaints itself once, instead of
+ * notifying every single netline item on that layer.
+ *
+ * @note This item is not derived from librepcb::project::BGI_Base, so it is ignored
+ *       by librepcb::project::Board::getItemsAtScenePos() and similar methods.
+ */
+class BGI_NetLineBatch final : public QGraphicsItem, public IF_GraphicsLayerObserver
+{
+    public:
+
+        // Constructors / Destructor
+        explicit BGI_NetLineBatch(const GraphicsLayer& layer) noexcept;
+        ~BGI_NetLineBatch() noexcept;
+
+        // Getters
+        const GraphicsLayer& getLayer() const noexcept {return mLayer;}
+
+        // General Methods
+        void setLine(const BGI_NetLine& item, const QLineF& line, qreal width) noexcept;
+        void removeLine(const BGI_NetLine& item) noexcept;
+
+        // Inherited from IF_GraphicsLayerObserver
+        void layerColorChanged(const GraphicsLayer& layer, const QColor& newColor) noexcept override;
+        void layerHighlightColorChanged(const GraphicsLayer& layer, const QColor& newColor) noexcept override;
+        void layerVisibleChanged(const GraphicsLayer& layer, bool newVisible) noexcept override;
+        void layerEnabledChanged(const GraphicsLayer& layer, bool newEnabled) noexcept override;
+
+        // Inherited from QGraphicsItem
+        QRectF boundingRect() const;
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+
+
+    private:
+
+        // make some methods inaccessible...
+        BGI_NetLineBatch() = delete;
+        BGI_NetLineBatch(const BGI_NetLineBatch& other) = delete;
+        BGI_NetLineBatch& operator=(const BGI_NetLineBatch& rhs) = delete;
+
+        // Types
+        struct Entry {
+            QLineF line;
+            qreal width;
+            QRectF rect;    ///< bounding rect of the line including its width
+        };
+
+        // Private Methods
+        QRect getCells(const QRectF& rect) const noexcept;
+        void addToGrid(const BGI_NetLine& item, const QRectF& rect) noexcept;
+        void removeFromGrid(const BGI_NetLine& item, const QRectF& rect) noexcept;
+        static quint64 getCellKey(int x, int y) noexcept;
+
+        // Attributes
+        const GraphicsLayer& mLayer;
+        QHash<const BGI_NetLine*, Entry> mLines;
+        QHash<quint64, QSet<const BGI_NetLine*>> mGrid;     ///< lines per grid cell
+        QSet<const BGI_NetLine*> mLargeLines;   ///< lines which cover too many cells
+        QRectF mBoundingRect;                   ///< only grows, see class description
+
+        // Static Attributes
+        static constexpr qreal sCellSize = 50;              ///< in pixels (~17.6mm)
+        static constexpr int sMaxCellsPerLine = 16;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BGI_NETLINEBATCH_H
@@ -41,7 +41,7 @@ namespace project {
  ****************************************************************************************/
 
 BGI_NetPoint::BGI_NetPoint(BI_NetPoint& netpoint) noexcept :
-    BGI_Base(), mNetPoint(netpoint)
+    BGI_Base(netpoint), mNetPoint(netpoint)
 {
     updateCacheAndRepaint();
 }
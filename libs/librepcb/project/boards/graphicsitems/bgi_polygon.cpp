@@ -26,6 +26,7 @@
 #include "bgi_polygon.h"
 #include "../items/bi_polygon.h"
 #include "../board.h"
+#include "../boardcopperpours.h"
 #include "../../project.h"
 #include <librepcb/common/geometry/polygon.h>
 #include "../boardlayerstack.h"
@@ -41,7 +42,7 @@ namespace project {
  ****************************************************************************************/
 
 BGI_Polygon::BGI_Polygon(BI_Polygon& polygon) noexcept :
-    BGI_Base(), mBiPolygon(polygon), mPolygon(polygon.getPolygon()), mLayer(nullptr)
+    BGI_Base(polygon), mBiPolygon(polygon), mPolygon(polygon.getPolygon()), mLayer(nullptr)
 {
     updateCacheAndRepaint();
 }
@@ -67,7 +68,12 @@ void BGI_Polygon::updateCacheAndRepaint() noexcept
 {
     prepareGeometryChange();
 
-    setZValue(Board::ZValue_Default);
+    if (mBiPolygon.isCopperPour()) {
+        // below the traces of the same layer
+        setZValue(getZValueOfCopperLayer(mPolygon.getLayerName()) - 0.002);
+    } else {
+        setZValue(Board::ZValue_Default);
+    }
 
     mLayer = getLayer(mPolygon.getLayerName());
 
@@ -91,6 +97,13 @@ void BGI_Polygon::paint(QPainter* painter, const QStyleOptionGraphicsItem* optio
     //const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
     Q_UNUSED(option);
 
+    if (mLayer && mLayer->isVisible() && mBiPolygon.isCopperPour()) {
+        // draw the filled area of the copper pour
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(mLayer->getColor(selected));
+        painter->drawPath(mBiPolygon.getBoard().getCopperPours().getFillPx(mBiPolygon));
+    }
+
     if (mLayer && mLayer->isVisible()) {
         // draw polygon outline
         painter->setPen(QPen(mLayer->getColor(selected), mPolygon.getLineWidth().toPx(),
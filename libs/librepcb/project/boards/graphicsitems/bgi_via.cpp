@@ -42,9 +42,12 @@ namespace project {
  ****************************************************************************************/
 
 BGI_Via::BGI_Via(BI_Via& via) noexcept :
-    BGI_Base(), mVia(via), mViaLayer(nullptr), mTopStopMaskLayer(nullptr),
+    BGI_Base(via), mVia(via), mViaLayer(nullptr), mTopStopMaskLayer(nullptr),
     mBottomStopMaskLayer(nullptr)
 {
+    // paint into a cached pixmap which is reused for panning until the item changes
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
     setZValue(Board::ZValue_Vias);
 
     mFont.setStyleStrategy(QFont::StyleStrategy(QFont::OpenGLCompatible | QFont::PreferQuality));
@@ -102,12 +105,21 @@ void BGI_Via::updateCacheAndRepaint() noexcept
 
 void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
-    Q_UNUSED(option);
-    Q_UNUSED(widget);
+    const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
+    const GraphicsScene::LevelOfDetail thresholds = getLevelOfDetail(*this, *painter, widget);
 
     NetSignal* netsignal = mVia.getNetSignal();
     bool highlight = mVia.isSelected() || (netsignal && netsignal->isHighlighted());
 
+    // draw only a filled rect (without masks and text) if the via is very small
+    qreal size = mVia.getSize().toPx();
+    if (lod * size < thresholds.minPadSize) {
+        if (mViaLayer && mViaLayer->isVisible()) {
+            painter->fillRect(QRectF(-size/2, -size/2, size, size), mViaLayer->getColor(highlight));
+        }
+        return;
+    }
+
     if (mDrawStopMask && mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible()) {
         // draw bottom stop mask
         painter->setPen(Qt::NoPen);
@@ -122,7 +134,7 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, Q
         painter->drawPath(mVia.toQPainterPathPx(Length(0), true));
 
         // draw netsignal name
-        if (netsignal) {
+        if (netsignal && (lod * mFont.pixelSize() >= thresholds.minTextSize)) {
             painter->setFont(mFont);
             painter->setPen(mViaLayer->getColor(highlight).lighter(150));
             painter->drawText(mBoundingRect, Qt::AlignCenter, netsignal->getName());
@@ -38,7 +38,7 @@ namespace project {
  ****************************************************************************************/
 
 BI_Base::BI_Base(Board& board) noexcept :
-    QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false)
+    mBoard(board), mIsAddedToBoard(false), mIsSelected(false)
 {
 }
 
@@ -67,7 +67,9 @@ Circuit& BI_Base::getCircuit() const noexcept
 
 void BI_Base::setSelected(bool selected) noexcept
 {
+    if (selected == mIsSelected) return;
     mIsSelected = selected;
+    if (mIsAddedToBoard) mBoard.updateSelectedItem(*this);
 }
 
 /*****************************************************************************************
@@ -78,26 +80,41 @@ void BI_Base::addToBoard() noexcept
 {
     Q_ASSERT(!mIsAddedToBoard);
     mIsAddedToBoard = true;
+    if (mIsSelected) mBoard.updateSelectedItem(*this);
 }
 
 void BI_Base::removeFromBoard() noexcept
 {
     Q_ASSERT(mIsAddedToBoard);
     mIsAddedToBoard = false;
+    if (mIsSelected) mBoard.updateSelectedItem(*this);
 }
 
-void BI_Base::addToBoard(GraphicsScene& scene, BGI_Base& item) noexcept
+void BI_Base::addToBoard(GraphicsScene& scene, BGI_Base* item) noexcept
 {
     Q_ASSERT(!mIsAddedToBoard);
-    scene.addItem(item);
+    if (item) scene.addItem(*item);
     mIsAddedToBoard = true;
+    if (mIsSelected) mBoard.updateSelectedItem(*this);
 }
 
-void BI_Base::removeFromBoard(GraphicsScene& scene, BGI_Base& item) noexcept
+void BI_Base::removeFromBoard(GraphicsScene& scene, BGI_Base* item) noexcept
 {
     Q_ASSERT(mIsAddedToBoard);
-    scene.removeItem(item);
+    if (item) scene.removeItem(*item);
     mIsAddedToBoard = false;
+    if (mIsSelected) mBoard.updateSelectedItem(*this);
+}
+
+void BI_Base::addGraphicsItemToScene(GraphicsScene& scene, BGI_Base& item) const noexcept
+{
+    // used for graphics items which are created after adding the item to the board
+    if (mIsAddedToBoard) scene.addItem(item);
+}
+
+bool BI_Base::areGraphicsItemsEnabled() const noexcept
+{
+    return mBoard.areGraphicsItemsEnabled();
 }
 
 /*****************************************************************************************
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/graphics/sceneshapecache.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -48,10 +49,8 @@ class BGI_Base;
 /**
  * @brief The Board Item Base (BI_Base) class
  */
-class BI_Base : public QObject
+class BI_Base
 {
-        Q_OBJECT
-
     public:
 
         // Types
@@ -90,6 +89,17 @@ class BI_Base : public QObject
         virtual void addToBoard(GraphicsScene& scene) = 0;
         virtual void removeFromBoard(GraphicsScene& scene) = 0;
 
+        /**
+         * @brief Create the graphics item(s) of this item (if not already done)
+         *
+         * Graphics items are only created if the board has graphics items enabled (see
+         * librepcb#project#Board#areGraphicsItemsEnabled()). If the item is already
+         * added to the board, the created graphics item(s) are added to the scene too.
+         *
+         * @param scene     The graphics scene of the board
+         */
+        virtual void createGraphicsItems(GraphicsScene& scene) noexcept = 0;
+
         // Operator Overloadings
         BI_Base& operator=(const BI_Base& rhs) = delete;
 
@@ -99,8 +109,20 @@ class BI_Base : public QObject
         // General Methods
         void addToBoard() noexcept;
         void removeFromBoard() noexcept;
-        void addToBoard(GraphicsScene& scene, BGI_Base& item) noexcept;
-        void removeFromBoard(GraphicsScene& scene, BGI_Base& item) noexcept;
+        void addToBoard(GraphicsScene& scene, BGI_Base* item) noexcept;
+        void removeFromBoard(GraphicsScene& scene, BGI_Base* item) noexcept;
+        void addGraphicsItemToScene(GraphicsScene& scene, BGI_Base& item) const noexcept;
+        bool areGraphicsItemsEnabled() const noexcept;
+
+        /**
+         * @brief Get the shape of a graphics item in scene coordinates
+         *
+         * This is the cached implementation of #getGrabAreaScenePx(), see
+         * librepcb::SceneShapeCache. It must always be called with the same item.
+         */
+        const QPainterPath& getSceneShapeOfItem(const QGraphicsItem& item) const noexcept {
+            return mSceneShapeCache.getSceneShape(item);
+        }
 
 
     protected:
@@ -113,6 +135,7 @@ class BI_Base : public QObject
         // General Attributes
         bool mIsAddedToBoard;
         bool mIsSelected;
+        mutable SceneShapeCache mSceneShapeCache; ///< see #getSceneShapeOfItem()
 };
 
 /*****************************************************************************************
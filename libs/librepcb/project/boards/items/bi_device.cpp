@@ -43,6 +43,7 @@ namespace project {
  ****************************************************************************************/
 
 BI_Device::BI_Device(Board& board, const BI_Device& other) :
+    QObject(&board),
     BI_Base(board), mCompInstance(other.mCompInstance), mLibDevice(other.mLibDevice),
     mLibPackage(other.mLibPackage), mLibFootprint(other.mLibFootprint),
     mPosition(other.mPosition), mRotation(other.mRotation), mIsMirrored(other.mIsMirrored)
@@ -53,6 +54,7 @@ BI_Device::BI_Device(Board& board, const BI_Device& other) :
 }
 
 BI_Device::BI_Device(Board& board, const DomElement& domElement) :
+    QObject(&board),
     BI_Base(board), mCompInstance(nullptr), mLibDevice(nullptr), mLibPackage(nullptr),
     mLibFootprint(nullptr)
 {
@@ -84,6 +86,7 @@ BI_Device::BI_Device(Board& board, const DomElement& domElement) :
 
 BI_Device::BI_Device(Board& board, ComponentInstance& compInstance, const Uuid& deviceUuid,
         const Uuid& footprintUuid, const Point& position, const Angle& rotation, bool mirror) :
+    QObject(&board),
     BI_Base(board), mCompInstance(&compInstance), mLibDevice(nullptr), mLibPackage(nullptr),
     mLibFootprint(nullptr), mPosition(position), mRotation(rotation), mIsMirrored(mirror)
 {
@@ -141,6 +144,10 @@ void BI_Device::init()
     // emit the "attributesChanged" signal when the board has emited it
     connect(&mBoard, &Board::attributesChanged, this, &BI_Device::attributesChanged);
 
+    // the component may be shared with other boards, so all of them are updated deferred
+    connect(mCompInstance, &ComponentInstance::attributesChanged, this,
+            [this](){mBoard.scheduleDeviceAttributesUpdate(mCompInstance->getUuid());});
+
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 }
 
@@ -275,6 +282,11 @@ void BI_Device::setSelected(bool selected) noexcept
     mFootprint->setSelected(selected);
 }
 
+void BI_Device::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    mFootprint->createGraphicsItems(scene);
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
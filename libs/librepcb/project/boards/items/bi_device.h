@@ -56,7 +56,7 @@ class BI_Footprint;
 /**
  * @brief The BI_Device class
  */
-class BI_Device final : public BI_Base, public IF_AttributeProvider,
+class BI_Device final : public QObject, public BI_Base, public IF_AttributeProvider,
                         public IF_ErcMsgProvider, public SerializableObject
 {
         Q_OBJECT
@@ -107,6 +107,7 @@ class BI_Device final : public BI_Base, public IF_AttributeProvider,
         bool getIsMirrored() const noexcept override {return mIsMirrored;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         BI_Device& operator=(const BI_Device& rhs);
@@ -45,6 +45,7 @@ namespace project {
  ****************************************************************************************/
 
 BI_Footprint::BI_Footprint(BI_Device& device, const BI_Footprint& other) :
+    QObject(&device.getBoard()),
     BI_Base(device.getBoard()), mDevice(device)
 {
     Q_UNUSED(other);
@@ -52,6 +53,7 @@ BI_Footprint::BI_Footprint(BI_Device& device, const BI_Footprint& other) :
 }
 
 BI_Footprint::BI_Footprint(BI_Device& device, const DomElement& domElement) :
+    QObject(&device.getBoard()),
     BI_Base(device.getBoard()), mDevice(device)
 {
     Q_UNUSED(domElement);
@@ -59,6 +61,7 @@ BI_Footprint::BI_Footprint(BI_Device& device, const DomElement& domElement) :
 }
 
 BI_Footprint::BI_Footprint(BI_Device& device) :
+    QObject(&device.getBoard()),
     BI_Base(device.getBoard()), mDevice(device)
 {
     init();
@@ -66,9 +69,9 @@ BI_Footprint::BI_Footprint(BI_Device& device) :
 
 void BI_Footprint::init()
 {
-    mGraphicsItem.reset(new BGI_Footprint(*this));
-    mGraphicsItem->setPos(mDevice.getPosition().toPxQPointF());
-    updateGraphicsItemTransform();
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
 
     const library::Device& libDev = mDevice.getLibDevice();
     for (const library::FootprintPad& libPad : getLibFootprint().getPads()) {
@@ -146,7 +149,7 @@ void BI_Footprint::addToBoard(GraphicsScene& scene)
         pad->addToBoard(scene); // can throw
         sgl.add([pad, &scene](){pad->removeFromBoard(scene);});
     }
-    BI_Base::addToBoard(scene, *mGraphicsItem);
+    BI_Base::addToBoard(scene, mGraphicsItem.data());
     sgl.dismiss();
 }
 
@@ -160,7 +163,7 @@ void BI_Footprint::removeFromBoard(GraphicsScene& scene)
         pad->removeFromBoard(scene); // can throw
         sgl.add([pad, &scene](){pad->addToBoard(scene);});
     }
-    BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    BI_Base::removeFromBoard(scene, mGraphicsItem.data());
     sgl.dismiss();
 }
 
@@ -216,67 +219,102 @@ bool BI_Footprint::getIsMirrored() const noexcept
 
 QPainterPath BI_Footprint::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 bool BI_Footprint::isSelectable() const noexcept
 {
-    return mGraphicsItem->isSelectable();
+    return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Footprint::setSelected(bool selected) noexcept
 {
     BI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
     foreach (BI_FootprintPad* pad, mPads)
         pad->setSelected(selected);
 }
 
+void BI_Footprint::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
+    foreach (BI_FootprintPad* pad, mPads) {
+        pad->createGraphicsItems(scene);
+    }
+}
+
 /*****************************************************************************************
  *  Private Slots
  ****************************************************************************************/
 
 void BI_Footprint::deviceInstanceAttributesChanged()
 {
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
     emit attributesChanged();
 }
 
 void BI_Footprint::deviceInstanceMoved(const Point& pos)
 {
-    mGraphicsItem->setPos(pos.toPxQPointF());
-    mGraphicsItem->updateCacheAndRepaint();
-    foreach (BI_FootprintPad* pad, mPads) {
-        pad->updatePosition();
+    if (mGraphicsItem) {
+        mGraphicsItem->setPos(pos.toPxQPointF());
+        mGraphicsItem->updateCacheAndRepaint();
     }
+    updatePadPositions();
 }
 
 void BI_Footprint::deviceInstanceRotated(const Angle& rot)
 {
     Q_UNUSED(rot);
     updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
-    foreach (BI_FootprintPad* pad, mPads) {
-        pad->updatePosition();
-    }
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+    updatePadPositions();
 }
 
 void BI_Footprint::deviceInstanceMirrored(bool mirrored)
 {
     Q_UNUSED(mirrored);
     updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
-    foreach (BI_FootprintPad* pad, mPads) {
-        pad->updatePosition();
-    }
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+    updatePadPositions();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void BI_Footprint::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new BGI_Footprint(*this));
+    mGraphicsItem->setPos(mDevice.getPosition().toPxQPointF());
+    updateGraphicsItemTransform();
+}
+
+void BI_Footprint::updatePadPositions() noexcept
+{
+    // transform all pad positions in one batch, equivalent to mapToScene() per pad
+    QList<BI_FootprintPad*> pads = mPads.values();
+    QVector<Point> positions;
+    positions.reserve(pads.count());
+    foreach (const BI_FootprintPad* pad, pads) {
+        positions.append(mDevice.getPosition() + pad->getLibPad().getPosition());
+    }
+    Point::rotateAll(positions, mDevice.getRotation(), mDevice.getPosition());
+    if (mDevice.getIsMirrored()) {
+        Point::mirrorAll(positions, Qt::Horizontal, mDevice.getPosition());
+    }
+    for (int i = 0; i < pads.count(); ++i) {
+        pads.at(i)->updatePosition(positions.at(i));
+    }
+}
+
 void BI_Footprint::updateGraphicsItemTransform() noexcept
 {
+    if (!mGraphicsItem) return;
     QTransform t;
     if (mDevice.getIsMirrored()) t.scale(qreal(-1), qreal(1));
     t.rotate(-mDevice.getRotation().toDeg());
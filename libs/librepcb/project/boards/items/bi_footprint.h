@@ -54,7 +54,7 @@ class BI_FootprintPad;
  * @author ubruhin
  * @date 2015-05-24
  */
-class BI_Footprint final : public BI_Base, public SerializableObject,
+class BI_Footprint final : public QObject, public BI_Base, public SerializableObject,
                            public IF_AttributeProvider
 {
         Q_OBJECT
@@ -97,6 +97,7 @@ class BI_Footprint final : public BI_Base, public SerializableObject,
         bool getIsMirrored() const noexcept override;
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         BI_Footprint& operator=(const BI_Footprint& rhs) = delete;
@@ -119,6 +120,8 @@ class BI_Footprint final : public BI_Base, public SerializableObject,
     private:
 
         void init();
+        void initGraphicsItem() noexcept;
+        void updatePadPositions() noexcept;
         void updateGraphicsItemTransform() noexcept;
         bool checkAttributesValidity() const noexcept;
 
@@ -52,6 +52,7 @@ namespace project {
  ****************************************************************************************/
 
 BI_FootprintPad::BI_FootprintPad(BI_Footprint& footprint, const Uuid& padUuid) :
+    QObject(&footprint.getBoard()),
     BI_Base(footprint.getBoard()), mFootprint(footprint), mFootprintPad(nullptr),
     mPackagePad(nullptr), mComponentSignalInstance(nullptr)
 {
@@ -60,7 +61,9 @@ BI_FootprintPad::BI_FootprintPad(BI_Footprint& footprint, const Uuid& padUuid) :
     Uuid cmpSignalUuid = mFootprint.getDeviceInstance().getLibDevice().getPadSignalMap().get(padUuid)->getSignalUuid(); // can throw
     mComponentSignalInstance = mFootprint.getDeviceInstance().getComponentInstance().getSignalInstance(cmpSignalUuid);
 
-    mGraphicsItem.reset(new BGI_FootprintPad(*this));
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
     updatePosition();
 
     // connect to the "attributes changed" signal of the footprint
@@ -133,9 +136,11 @@ void BI_FootprintPad::addToBoard(GraphicsScene& scene)
     }
     if (getCompSigInstNetSignal()) {
         mHighlightChangedConnection = connect(getCompSigInstNetSignal(), &NetSignal::highlightedChanged,
-                                              [this](){mGraphicsItem->update();});
+                                              [this](){if (mGraphicsItem) mGraphicsItem->update();});
     }
-    BI_Base::addToBoard(scene, *mGraphicsItem);
+    BI_Base::addToBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(getCompSigInstNetSignal());
+    scheduleCopperPourRefill();
 }
 
 void BI_FootprintPad::removeFromBoard(GraphicsScene& scene)
@@ -149,7 +154,9 @@ void BI_FootprintPad::removeFromBoard(GraphicsScene& scene)
     if (getCompSigInstNetSignal()) {
         disconnect(mHighlightChangedConnection);
     }
-    BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    BI_Base::removeFromBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(getCompSigInstNetSignal());
+    scheduleCopperPourRefill();
 }
 
 void BI_FootprintPad::registerNetPoint(BI_NetPoint& netpoint)
@@ -181,14 +188,44 @@ void BI_FootprintPad::unregisterNetPoint(BI_NetPoint& netpoint)
 
 void BI_FootprintPad::updatePosition() noexcept
 {
-    mPosition = mFootprint.mapToScene(mFootprintPad->getPosition());
+    updatePosition(mFootprint.mapToScene(mFootprintPad->getPosition()));
+}
+
+void BI_FootprintPad::updatePosition(const Point& scenePos) noexcept
+{
+    scheduleCopperPourRefill(); // the old area
+    mPosition = scenePos;
     mRotation = mFootprint.getRotation() + mFootprintPad->getRotation();
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
-    updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
+    updateGeometry();
+    if (mGraphicsItem) {
+        mGraphicsItem->setPos(mPosition.toPxQPointF());
+        updateGraphicsItemTransform();
+        mGraphicsItem->updateCacheAndRepaint();
+    }
     foreach (BI_NetPoint* netpoint, mRegisteredNetPoints) {
         netpoint->setPosition(mPosition);
     }
+    mBoard.scheduleAirWiresRebuild(getCompSigInstNetSignal());
+    scheduleCopperPourRefill(); // the new area
+}
+
+void BI_FootprintPad::netSignalMoved() noexcept
+{
+    if (!isAddedToBoard()) return;
+    disconnect(mHighlightChangedConnection);
+    if (getCompSigInstNetSignal()) {
+        mHighlightChangedConnection = connect(getCompSigInstNetSignal(), &NetSignal::highlightedChanged,
+                                              [this](){if (mGraphicsItem) mGraphicsItem->update();});
+    }
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void BI_FootprintPad::scheduleCopperPourRefill() const noexcept
+{
+    if (isAddedToBoard()) {
+        mBoard.scheduleCopperPourRefill(mPosition, mPosition,
+            qMax(mFootprintPad->getWidth(), mFootprintPad->getHeight()));
+    }
 }
 
 /*****************************************************************************************
@@ -202,18 +239,30 @@ bool BI_FootprintPad::getIsMirrored() const noexcept
 
 QPainterPath BI_FootprintPad::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 bool BI_FootprintPad::isSelectable() const noexcept
 {
-    return mFootprint.isSelectable() && mGraphicsItem->isSelectable();
+    return mFootprint.isSelectable() && mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_FootprintPad::setSelected(bool selected) noexcept
 {
     BI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void BI_FootprintPad::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->setPos(mPosition.toPxQPointF());
+        updateGraphicsItemTransform();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
 }
 
 /*****************************************************************************************
@@ -222,13 +271,18 @@ void BI_FootprintPad::setSelected(bool selected) noexcept
 
 void BI_FootprintPad::footprintAttributesChanged()
 {
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void BI_FootprintPad::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new BGI_FootprintPad(*this));
+}
+
 void BI_FootprintPad::updateGraphicsItemTransform() noexcept
 {
     QTransform t;
@@ -237,6 +291,29 @@ void BI_FootprintPad::updateGraphicsItemTransform() noexcept
     mGraphicsItem->setTransform(t);
 }
 
+void BI_FootprintPad::updateGeometry() noexcept
+{
+    const Length& width = mFootprintPad->getWidth();
+    const Length& height = mFootprintPad->getHeight();
+    bool mirror = getIsMirrored();
+    switch (mFootprintPad->getShape())
+    {
+        case library::FootprintPad::Shape::ROUND:
+            mGeometry = BoardItemGeometry::obround(mPosition, width, height, mRotation, mirror);
+            break;
+        case library::FootprintPad::Shape::RECT:
+            mGeometry = BoardItemGeometry::rect(mPosition, width, height, mRotation, mirror);
+            break;
+        case library::FootprintPad::Shape::OCTAGON:
+            mGeometry = BoardItemGeometry::octagon(mPosition, width, height, mRotation, mirror);
+            break;
+        default:
+            Q_ASSERT(false);
+            mGeometry = BoardItemGeometry();
+            break;
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "bi_base.h"
 #include "../graphicsitems/bgi_footprintpad.h"
+#include "../boarditemgeometry.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -51,7 +52,7 @@ class ComponentSignalInstance;
 /**
  * @brief The BI_FootprintPad class
  */
-class BI_FootprintPad final : public BI_Base
+class BI_FootprintPad final : public QObject, public BI_Base
 {
         Q_OBJECT
 
@@ -77,6 +78,7 @@ class BI_FootprintPad final : public BI_Base
         NetSignal* getCompSigInstNetSignal() const noexcept;
         bool isUsed() const noexcept {return (mRegisteredNetPoints.count() > 0);}
         bool isSelectable() const noexcept override;
+        const BoardItemGeometry& getGeometry() const noexcept {return mGeometry;}
 
         // General Methods
         void addToBoard(GraphicsScene& scene) override;
@@ -84,6 +86,11 @@ class BI_FootprintPad final : public BI_Base
         void registerNetPoint(BI_NetPoint& netpoint);
         void unregisterNetPoint(BI_NetPoint& netpoint);
         void updatePosition() noexcept;
+        void updatePosition(const Point& scenePos) noexcept;
+        void scheduleCopperPourRefill() const noexcept;
+
+        /// Update the connections to the net signal after it was changed by the owner
+        void netSignalMoved() noexcept;
 
 
         // Inherited from BI_Base
@@ -92,6 +99,7 @@ class BI_FootprintPad final : public BI_Base
         bool getIsMirrored() const noexcept override;
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         BI_FootprintPad& operator=(const BI_FootprintPad& rhs) = delete;
@@ -104,7 +112,9 @@ class BI_FootprintPad final : public BI_Base
 
     private:
 
+        void initGraphicsItem() noexcept;
         void updateGraphicsItemTransform() noexcept;
+        void updateGeometry() noexcept;
 
 
         // General
@@ -117,6 +127,7 @@ class BI_FootprintPad final : public BI_Base
         // Misc
         Point mPosition;
         Angle mRotation;
+        BoardItemGeometry mGeometry; ///< the copper area in scene coordinates
         QMap<QString, BI_NetPoint*> mRegisteredNetPoints; ///< key: layer name
         QScopedPointer<BGI_FootprintPad> mGraphicsItem;
 };
@@ -108,7 +108,9 @@ void BI_NetLine::init()
             tr("BI_NetLine: both endpoints are the same."));
     }
 
-    mGraphicsItem.reset(new BGI_NetLine(*this));
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
     updateLine();
 
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -129,6 +131,21 @@ GraphicsLayer& BI_NetLine::getLayer() const noexcept
     return mStartPoint->getLayer();
 }
 
+Length BI_NetLine::getLength() const noexcept
+{
+    return (mEndPoint->getPosition() - mStartPoint->getPosition()).getLength();
+}
+
+const BoardItemGeometry& BI_NetLine::getGeometry() const noexcept
+{
+    BoardItemGeometry geometry = BoardItemGeometry::line(mStartPoint->getPosition(),
+                                                         mEndPoint->getPosition(), mWidth);
+    if (geometry != mGeometry) {
+        mGeometry = geometry;
+    }
+    return mGeometry;
+}
+
 NetSignal& BI_NetLine::getNetSignal() const noexcept
 {
     Q_ASSERT(&mStartPoint->getNetSignal() == &mEndPoint->getNetSignal());
@@ -158,8 +175,13 @@ void BI_NetLine::setWidth(const Length& width) noexcept
 {
     Q_ASSERT(width >= 0);
     if ((width != mWidth) && (width >= 0)) {
+        if (isAddedToBoard()) scheduleCopperPourRefill();
         mWidth = width;
-        mGraphicsItem->updateCacheAndRepaint();
+        if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+        if (isAddedToBoard()) {
+            mBoard.updateNetLineGeometry(*this);
+            scheduleCopperPourRefill();
+        }
     }
 }
 
@@ -178,9 +200,11 @@ void BI_NetLine::addToBoard(GraphicsScene& scene)
     mStartPoint->registerNetLine(*this); // can throw
     auto sg = scopeGuard([&](){mStartPoint->unregisterNetLine(*this);});
     mEndPoint->registerNetLine(*this); // can throw
-    mHighlightChangedConnection = connect(&getNetSignal(), &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
-    BI_Base::addToBoard(scene, *mGraphicsItem);
+    BI_Base::addToBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(&getNetSignal());
+    mBoard.updateNetStatistics(*this);
+    mBoard.updateNetLineGeometry(*this);
+    scheduleCopperPourRefill();
     sg.dismiss();
 }
 
@@ -195,15 +219,42 @@ void BI_NetLine::removeFromBoard(GraphicsScene& scene)
     mStartPoint->unregisterNetLine(*this); // can throw
     auto sg = scopeGuard([&](){mEndPoint->registerNetLine(*this);});
     mEndPoint->unregisterNetLine(*this); // can throw
-    disconnect(mHighlightChangedConnection);
-    BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    BI_Base::removeFromBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(&getNetSignal());
+    mBoard.updateNetStatistics(*this);
+    mBoard.updateNetLineGeometry(*this);
+    scheduleCopperPourRefill();
     sg.dismiss();
 }
 
 void BI_NetLine::updateLine() noexcept
 {
+    if (mBoard.deferNetLineUpdate(*this)) return; // updated at the end of the batch
     mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+    if (isAddedToBoard()) {
+        mBoard.updateNetStatistics(*this);
+        mBoard.updateNetLineGeometry(*this);
+    }
+}
+
+void BI_NetLine::netSignalMoved() noexcept
+{
+    if (!isAddedToBoard()) return;
+    mBoard.updateNetStatistics(*this);
+    scheduleCopperPourRefill();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void BI_NetLine::scheduleCopperPourRefill() const noexcept
+{
+    mBoard.scheduleCopperPourRefill(mStartPoint->getPosition(), mEndPoint->getPosition(),
+                                    mWidth / 2);
+}
+
+void BI_NetLine::netSignalHighlightChanged() noexcept
+{
+    if (mGraphicsItem) mGraphicsItem->update();
 }
 
 void BI_NetLine::serialize(DomElement& root) const
@@ -222,24 +273,39 @@ void BI_NetLine::serialize(DomElement& root) const
 
 QPainterPath BI_NetLine::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->shape();
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 bool BI_NetLine::isSelectable() const noexcept
 {
-    return mGraphicsItem->isSelectable();
+    return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_NetLine::setSelected(bool selected) noexcept
 {
     BI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void BI_NetLine::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void BI_NetLine::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new BGI_NetLine(*this));
+}
+
 bool BI_NetLine::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())         return false;
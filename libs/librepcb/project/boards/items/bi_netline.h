@@ -27,7 +27,9 @@
 #include "bi_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/uuid.h>
+#include <librepcb/common/objectpool.h>
 #include "../graphicsitems/bgi_netline.h"
+#include "../boarditemgeometry.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -48,9 +50,10 @@ class BI_NetPoint;
 /**
  * @brief The BI_NetLine class
  */
-class BI_NetLine final : public BI_Base, public SerializableObject
+class BI_NetLine final : public BI_Base, public SerializableObject,
+                         public PooledObject<BI_NetLine>
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(BI_NetLine)
 
     public:
 
@@ -71,11 +74,21 @@ class BI_NetLine final : public BI_Base, public SerializableObject
         BI_NetPoint& getEndPoint() const noexcept {return *mEndPoint;}
         NetSignal& getNetSignal() const noexcept;
         GraphicsLayer& getLayer() const noexcept;
+        Length getLength() const noexcept;
         bool isAttached() const noexcept;
         bool isAttachedToFootprint() const noexcept;
         bool isAttachedToVia() const noexcept;
         bool isSelectable() const noexcept override;
 
+        /**
+         * @brief Get the copper area in scene coordinates
+         *
+         * The geometry is recreated only if the netpoints or the width have changed,
+         * so its cached outline (see librepcb::project::BoardItemGeometry::getOutline())
+         * is kept otherwise.
+         */
+        const BoardItemGeometry& getGeometry() const noexcept;
+
         // Setters
         void setWidth(const Length& width) noexcept;
 
@@ -83,6 +96,14 @@ class BI_NetLine final : public BI_Base, public SerializableObject
         void addToBoard(GraphicsScene& scene) override;
         void removeFromBoard(GraphicsScene& scene) override;
         void updateLine() noexcept;
+        void scheduleCopperPourRefill() const noexcept;
+
+        /// Update statistics and graphics after the net signal was changed by the owner
+        void netSignalMoved() noexcept;
+
+        /// Repaint after the highlight state of the net signal has changed (called by
+        /// librepcb::project::NetSignal::setHighlighted())
+        void netSignalHighlightChanged() noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
@@ -94,6 +115,7 @@ class BI_NetLine final : public BI_Base, public SerializableObject
         bool getIsMirrored() const noexcept override {return false;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         BI_NetLine& operator=(const BI_NetLine& rhs) = delete;
@@ -102,19 +124,22 @@ class BI_NetLine final : public BI_Base, public SerializableObject
     private:
 
         void init();
+        void initGraphicsItem() noexcept;
         bool checkAttributesValidity() const noexcept;
 
 
         // General
         QScopedPointer<BGI_NetLine> mGraphicsItem;
         Point mPosition; ///< the center of startpoint and endpoint
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         Uuid mUuid;
         BI_NetPoint* mStartPoint;
         BI_NetPoint* mEndPoint;
         Length mWidth;
+
+        // Cached Attributes
+        mutable BoardItemGeometry mGeometry; ///< see #getGeometry()
 };
 
 /*****************************************************************************************
@@ -161,8 +161,9 @@ void BI_NetPoint::init()
     }
 
     // create the graphics item
-    mGraphicsItem.reset(new BGI_NetPoint(*this));
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
 
     // create ERC messages
     mErcMsgDeadNetPoint.reset(new ErcMsg(mBoard.getProject(), *this,
@@ -223,8 +224,31 @@ void BI_NetPoint::setNetSignal(NetSignal& netsignal)
         auto sg = scopeGuard([&](){mNetSignal->registerBoardNetPoint(*this);});
         netsignal.registerBoardNetPoint(*this); // can throw
         sg.dismiss();
+        mBoard.scheduleAirWiresRebuild(mNetSignal);
+        mBoard.scheduleAirWiresRebuild(&netsignal);
+    }
+    mNetSignal = &netsignal;
+}
+
+void BI_NetPoint::moveToNetSignal(NetSignal& netsignal)
+{
+    if ((!isAddedToBoard()) || (netsignal.getCircuit() != getCircuit())) {
+        throw LogicError(__FILE__, __LINE__);
     }
+    if (&netsignal == mNetSignal) {
+        return;
+    }
+    mNetSignal->unregisterBoardNetPoint(*this); // can throw
+    auto sg = scopeGuard([&](){mNetSignal->registerBoardNetPoint(*this);});
+    netsignal.registerBoardNetPoint(*this); // can throw
+    sg.dismiss();
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
+    mBoard.scheduleAirWiresRebuild(&netsignal);
     mNetSignal = &netsignal;
+    foreach (BI_NetLine* netline, mRegisteredLines) {
+        netline->netSignalMoved(); // both points are moved, so this may be called twice
+    }
+    if (mGraphicsItem) mGraphicsItem->update();
 }
 
 void BI_NetPoint::setPadToAttach(BI_FootprintPad* pad)
@@ -254,7 +278,7 @@ void BI_NetPoint::setPadToAttach(BI_FootprintPad* pad)
         sgl.dismiss();
     }
     mFootprintPad = pad;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 void BI_NetPoint::setViaToAttach(BI_Via* via)
@@ -282,15 +306,22 @@ void BI_NetPoint::setViaToAttach(BI_Via* via)
         sgl.dismiss();
     }
     mVia = via;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 void BI_NetPoint::setPosition(const Point& position) noexcept
 {
     if (position != mPosition) {
+        foreach (const BI_NetLine* netline, mRegisteredLines) {
+            netline->scheduleCopperPourRefill(); // the old area
+        }
         mPosition = position;
-        mGraphicsItem->setPos(mPosition.toPxQPointF());
+        if (mGraphicsItem) mGraphicsItem->setPos(mPosition.toPxQPointF());
         updateLines();
+        foreach (const BI_NetLine* netline, mRegisteredLines) {
+            netline->scheduleCopperPourRefill(); // the new area
+        }
+        mBoard.scheduleAirWiresRebuild(mNetSignal);
     }
 }
 
@@ -321,10 +352,9 @@ void BI_NetPoint::addToBoard(GraphicsScene& scene)
         mVia->registerNetPoint(*this); // can throw
         sgl.add([&](){mVia->unregisterNetPoint(*this);});
     }
-    mHighlightChangedConnection = connect(mNetSignal, &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
     mErcMsgDeadNetPoint->setVisible(true);
-    BI_Base::addToBoard(scene, *mGraphicsItem);
+    BI_Base::addToBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
     sgl.dismiss();
 }
 
@@ -351,9 +381,9 @@ void BI_NetPoint::removeFromBoard(GraphicsScene& scene)
     }
     mNetSignal->unregisterBoardNetPoint(*this); // can throw
     sgl.add([&](){mNetSignal->registerBoardNetPoint(*this);});
-    disconnect(mHighlightChangedConnection);
     mErcMsgDeadNetPoint->setVisible(false);
-    BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    BI_Base::removeFromBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
     sgl.dismiss();
 }
 
@@ -366,7 +396,7 @@ void BI_NetPoint::registerNetLine(BI_NetLine& netline)
     }
     mRegisteredLines.append(&netline);
     netline.updateLine();
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
     mErcMsgDeadNetPoint->setVisible(mRegisteredLines.isEmpty());
 }
 
@@ -377,7 +407,7 @@ void BI_NetPoint::unregisterNetLine(BI_NetLine& netline)
     }
     mRegisteredLines.removeOne(&netline);
     netline.updateLine();
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
     mErcMsgDeadNetPoint->setVisible(mRegisteredLines.isEmpty());
 }
 
@@ -388,6 +418,11 @@ void BI_NetPoint::updateLines() const noexcept
     }
 }
 
+void BI_NetPoint::netSignalHighlightChanged() noexcept
+{
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
 void BI_NetPoint::serialize(DomElement& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -415,24 +450,40 @@ void BI_NetPoint::serialize(DomElement& root) const
 
 QPainterPath BI_NetPoint::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 bool BI_NetPoint::isSelectable() const noexcept
 {
-    return mGraphicsItem->isSelectable();
+    return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_NetPoint::setSelected(bool selected) noexcept
 {
     BI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void BI_NetPoint::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void BI_NetPoint::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new BGI_NetPoint(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+}
+
 bool BI_NetPoint::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                             return false;
@@ -27,6 +27,7 @@
 #include "bi_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/uuid.h>
+#include <librepcb/common/objectpool.h>
 #include "../../erc/if_ercmsgprovider.h"
 #include "../graphicsitems/bgi_netpoint.h"
 
@@ -56,9 +57,9 @@ class ErcMsg;
  * @brief The BI_NetPoint class
  */
 class BI_NetPoint final : public BI_Base, public SerializableObject,
-                          public IF_ErcMsgProvider
+                          public IF_ErcMsgProvider, public PooledObject<BI_NetPoint>
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(BI_NetPoint)
         DECLARE_ERC_MSG_CLASS_NAME(BI_NetPoint)
 
     public:
@@ -106,6 +107,21 @@ class BI_NetPoint final : public BI_Base, public SerializableObject,
         void unregisterNetLine(BI_NetLine& netline);
         void updateLines() const noexcept;
 
+        /**
+         * @brief Move the item to another net signal, even if it is used
+         *
+         * In contrast to #setNetSignal(), the attached items are not checked, so the
+         * caller has to move all items of the net signal at once (see
+         * librepcb::project::CmdNetSignalMoveItems).
+         *
+         * @throw Exception If the item is not added or on registration errors
+         */
+        void moveToNetSignal(NetSignal& netsignal);
+
+
+        /// Repaint after the highlight state of the net signal has changed (called by
+        /// librepcb::project::NetSignal::setHighlighted())
+        void netSignalHighlightChanged() noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
@@ -117,6 +133,7 @@ class BI_NetPoint final : public BI_Base, public SerializableObject,
         bool getIsMirrored() const noexcept override {return false;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         BI_NetPoint& operator=(const BI_NetPoint& rhs) = delete;
@@ -127,12 +144,12 @@ class BI_NetPoint final : public BI_Base, public SerializableObject,
     private:
 
         void init();
+        void initGraphicsItem() noexcept;
         bool checkAttributesValidity() const noexcept;
 
 
         // General
         QScopedPointer<BGI_NetPoint> mGraphicsItem;
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         Uuid mUuid;
@@ -24,7 +24,11 @@
 #include "bi_polygon.h"
 #include "../board.h"
 #include "../../project.h"
+#include "../../circuit/circuit.h"
+#include "../../circuit/netsignal.h"
+#include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/scopeguardlist.h>
 #include <librepcb/common/geometry/polygon.h>
 #include "../graphicsitems/bgi_polygon.h"
 
@@ -39,22 +43,33 @@ namespace project {
  ****************************************************************************************/
 
 BI_Polygon::BI_Polygon(Board& board, const BI_Polygon& other) :
-    BI_Base(board)
+    QObject(&board),
+    BI_Base(board), mNetSignal(other.mNetSignal)
 {
     mPolygon.reset(new Polygon(*other.mPolygon));
     init();
 }
 
 BI_Polygon::BI_Polygon(Board& board, const DomElement& domElement) :
-    BI_Base(board)
+    QObject(&board),
+    BI_Base(board), mNetSignal(nullptr)
 {
     mPolygon.reset(new Polygon(domElement));
+    Uuid netSignalUuid = domElement.getAttribute<Uuid>("netsignal", false);
+    if (!netSignalUuid.isNull()) {
+        mNetSignal = mBoard.getProject().getCircuit().getNetSignalByUuid(netSignalUuid);
+        if(!mNetSignal) {
+            throw RuntimeError(__FILE__, __LINE__,
+                QString(tr("Invalid net signal UUID: \"%1\"")).arg(netSignalUuid.toStr()));
+        }
+    }
     init();
 }
 
 BI_Polygon::BI_Polygon(Board& board, const QString& layerName, const Length& lineWidth, bool fill,
                        bool isGrabArea, const Point& startPos) :
-    BI_Base(board)
+    QObject(&board),
+    BI_Base(board), mNetSignal(nullptr)
 {
     mPolygon.reset(new Polygon(layerName, lineWidth, fill, isGrabArea, startPos));
     init();
@@ -62,20 +77,62 @@ BI_Polygon::BI_Polygon(Board& board, const QString& layerName, const Length& lin
 
 void BI_Polygon::init()
 {
-    mGraphicsItem.reset(new BGI_Polygon(*this));
-    mGraphicsItem->setPos(getPosition().toPxQPointF());
-    mGraphicsItem->setRotation(Angle::deg0().toDeg());
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
 
     // connect to the "attributes changed" signal of the board
     connect(&mBoard, &Board::attributesChanged, this, &BI_Polygon::boardAttributesChanged);
+
+    // refill the copper pour whenever the outline is modified
+    mPolygon->registerObserver(*this);
 }
 
 BI_Polygon::~BI_Polygon() noexcept
 {
+    mPolygon->unregisterObserver(*this);
     mGraphicsItem.reset();
     mPolygon.reset();
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool BI_Polygon::isCopperPour() const noexcept
+{
+    return mNetSignal && mPolygon->isClosed()
+        && GraphicsLayer::isCopperLayer(mPolygon->getLayerName());
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BI_Polygon::setNetSignal(NetSignal* netsignal)
+{
+    if (netsignal == mNetSignal) {
+        return;
+    }
+    if (netsignal && (netsignal->getCircuit() != getCircuit())) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    if (isAddedToBoard()) {
+        ScopeGuardList sgl;
+        if (mNetSignal) {
+            mNetSignal->unregisterBoardPolygon(*this); // can throw
+            sgl.add([&](){mNetSignal->registerBoardPolygon(*this);});
+        }
+        if (netsignal) {
+            netsignal->registerBoardPolygon(*this); // can throw
+            sgl.add([&](){netsignal->unregisterBoardPolygon(*this);});
+        }
+        sgl.dismiss();
+    }
+    mNetSignal = netsignal;
+    mBoard.scheduleCopperPourRefill(*this);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -85,7 +142,11 @@ void BI_Polygon::addToBoard(GraphicsScene& scene)
     if (isAddedToBoard()) {
         throw LogicError(__FILE__, __LINE__);
     }
-    BI_Base::addToBoard(scene, *mGraphicsItem);
+    if (mNetSignal) {
+        mNetSignal->registerBoardPolygon(*this); // can throw
+    }
+    BI_Base::addToBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleCopperPourRefill(*this);
 }
 
 void BI_Polygon::removeFromBoard(GraphicsScene& scene)
@@ -93,12 +154,24 @@ void BI_Polygon::removeFromBoard(GraphicsScene& scene)
     if (!isAddedToBoard()) {
         throw LogicError(__FILE__, __LINE__);
     }
-    BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    if (mNetSignal) {
+        mNetSignal->unregisterBoardPolygon(*this); // can throw
+    }
+    BI_Base::removeFromBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleCopperPourRefill(*this);
+}
+
+void BI_Polygon::updateCopperPourFill() noexcept
+{
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 void BI_Polygon::serialize(DomElement& root) const
 {
     mPolygon->serialize(root);
+    if (mNetSignal) {
+        root.setAttribute("netsignal", mNetSignal->getUuid());
+    }
 }
 
 bool BI_Polygon::getAttributeValue(const QString& attrNS, const QString& attrKey,
@@ -117,18 +190,28 @@ bool BI_Polygon::getAttributeValue(const QString& attrNS, const QString& attrKey
 
 QPainterPath BI_Polygon::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 bool BI_Polygon::isSelectable() const noexcept
 {
-    return mGraphicsItem->isSelectable();
+    return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Polygon::setSelected(bool selected) noexcept
 {
     BI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void BI_Polygon::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
 }
 
 /*****************************************************************************************
@@ -137,7 +220,75 @@ void BI_Polygon::setSelected(bool selected) noexcept
 
 void BI_Polygon::boardAttributesChanged()
 {
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BI_Polygon::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new BGI_Polygon(*this));
+    mGraphicsItem->setPos(getPosition().toPxQPointF());
+    mGraphicsItem->setRotation(Angle::deg0().toDeg());
+}
+
+/*****************************************************************************************
+ *  Inherited from IF_PolygonObserver
+ ****************************************************************************************/
+
+void BI_Polygon::polygonLayerNameChanged(const QString& newLayerName) noexcept
+{
+    Q_UNUSED(newLayerName);
+    mBoard.scheduleCopperPourRefill(*this);
+}
+
+void BI_Polygon::polygonLineWidthChanged(const Length& newLineWidth) noexcept
+{
+    Q_UNUSED(newLineWidth);
+}
+
+void BI_Polygon::polygonIsFilledChanged(bool newIsFilled) noexcept
+{
+    Q_UNUSED(newIsFilled);
+}
+
+void BI_Polygon::polygonIsGrabAreaChanged(bool newIsGrabArea) noexcept
+{
+    Q_UNUSED(newIsGrabArea);
+}
+
+void BI_Polygon::polygonStartPosChanged(const Point& newStartPos) noexcept
+{
+    Q_UNUSED(newStartPos);
+    mBoard.scheduleCopperPourRefill(*this);
+}
+
+void BI_Polygon::polygonSegmentAdded(int newSegmentIndex) noexcept
+{
+    Q_UNUSED(newSegmentIndex);
+    mBoard.scheduleCopperPourRefill(*this);
+}
+
+void BI_Polygon::polygonSegmentRemoved(int oldSegmentIndex) noexcept
+{
+    Q_UNUSED(oldSegmentIndex);
+    mBoard.scheduleCopperPourRefill(*this);
+}
+
+void BI_Polygon::polygonSegmentEndPosChanged(int segmentIndex, const Point& newEndPos) noexcept
+{
+    Q_UNUSED(segmentIndex);
+    Q_UNUSED(newEndPos);
+    mBoard.scheduleCopperPourRefill(*this);
+}
+
+void BI_Polygon::polygonSegmentAngleChanged(int segmentIndex, const Angle& newAngle) noexcept
+{
+    Q_UNUSED(segmentIndex);
+    Q_UNUSED(newAngle);
+    mBoard.scheduleCopperPourRefill(*this);
 }
 
 /*****************************************************************************************
@@ -27,18 +27,17 @@
 #include "bi_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/if_attributeprovider.h>
+#include <librepcb/common/geometry/polygon.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
-
-class Polygon;
-
 namespace project {
 
 class Project;
 class Board;
+class NetSignal;
 class BGI_Polygon;
 
 /*****************************************************************************************
@@ -48,11 +47,14 @@ class BGI_Polygon;
 /**
  * @brief The BI_Polygon class
  *
+ * A closed polygon on a copper layer which is assigned to a net signal is a copper pour.
+ * Its filled area is calculated by librepcb::project::BoardCopperPours.
+ *
  * @author ubruhin
  * @date 2016-01-12
  */
-class BI_Polygon final : public BI_Base, public SerializableObject,
-                         public IF_AttributeProvider
+class BI_Polygon final : public QObject, public BI_Base, public SerializableObject,
+                         public IF_AttributeProvider, private IF_PolygonObserver
 {
         Q_OBJECT
 
@@ -69,11 +71,17 @@ class BI_Polygon final : public BI_Base, public SerializableObject,
 
         // Getters
         const Polygon& getPolygon() const noexcept {return *mPolygon;}
+        NetSignal* getNetSignal() const noexcept {return mNetSignal;}
+        bool isCopperPour() const noexcept;
         bool isSelectable() const noexcept override;
 
+        // Setters
+        void setNetSignal(NetSignal* netsignal);
+
         // General Methods
         void addToBoard(GraphicsScene& scene) override;
         void removeFromBoard(GraphicsScene& scene) override;
+        void updateCopperPourFill() noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
@@ -87,6 +95,7 @@ class BI_Polygon final : public BI_Base, public SerializableObject,
         bool getIsMirrored() const noexcept override {return false;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         BI_Polygon& operator=(const BI_Polygon& rhs) = delete;
@@ -105,11 +114,24 @@ class BI_Polygon final : public BI_Base, public SerializableObject,
 
     private:
         void init();
+        void initGraphicsItem() noexcept;
+
+        // Inherited from IF_PolygonObserver
+        void polygonLayerNameChanged(const QString& newLayerName) noexcept override;
+        void polygonLineWidthChanged(const Length& newLineWidth) noexcept override;
+        void polygonIsFilledChanged(bool newIsFilled) noexcept override;
+        void polygonIsGrabAreaChanged(bool newIsGrabArea) noexcept override;
+        void polygonStartPosChanged(const Point& newStartPos) noexcept override;
+        void polygonSegmentAdded(int newSegmentIndex) noexcept override;
+        void polygonSegmentRemoved(int oldSegmentIndex) noexcept override;
+        void polygonSegmentEndPosChanged(int segmentIndex, const Point& newEndPos) noexcept override;
+        void polygonSegmentAngleChanged(int segmentIndex, const Angle& newAngle) noexcept override;
 
 
         // General
         QScopedPointer<Polygon> mPolygon;
         QScopedPointer<BGI_Polygon> mGraphicsItem;
+        NetSignal* mNetSignal; ///< only used for copper pours
 };
 
 /*****************************************************************************************
@@ -92,13 +92,12 @@ BI_Via::BI_Via(Board& board, const Point& position, Shape shape, const Length& s
 
 void BI_Via::init()
 {
-    // create the graphics item
-    mGraphicsItem.reset(new BGI_Via(*this));
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    updateGeometry();
 
-    // connect to the "attributes changed" signal of the board
-    connect(&mBoard, &Board::attributesChanged,
-            this, &BI_Via::boardAttributesChanged);
+    // create the graphics item
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
 
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 }
@@ -119,37 +118,8 @@ bool BI_Via::isOnLayer(const QString& layerName) const noexcept
 
 QPainterPath BI_Via::toQPainterPathPx(const Length& clearance, bool hole) const noexcept
 {
-    QPainterPath p;
+    QPainterPath p = mGeometry.translated(-mPosition).toQPainterPathPx(clearance);
     p.setFillRule(Qt::OddEvenFill); // important to subtract the hole!
-    switch (mShape)
-    {
-        case Shape::Round: {
-            qreal dia = (mSize + clearance*2).toPx();
-            p.addEllipse(-dia/2, -dia/2, dia, dia);
-            break;
-        }
-        case Shape::Square: {
-            qreal size = (mSize + clearance*2).toPx();
-            p.addRect(-size/2, -size/2, size, size);
-            break;
-        }
-        case Shape::Octagon: {
-            qreal r = (mSize/2 + clearance).toPx();
-            qreal a = r * (2 - qSqrt(2));
-            QPolygonF octagon;
-            octagon.append(QPointF(r, r-a));
-            octagon.append(QPointF(r-a, r));
-            octagon.append(QPointF(a-r, r));
-            octagon.append(QPointF(-r, r-a));
-            octagon.append(QPointF(-r, a-r));
-            octagon.append(QPointF(a-r, -r));
-            octagon.append(QPointF(r-a, -r));
-            octagon.append(QPointF(r, a-r));
-            p.addPolygon(octagon);
-            break;
-        }
-        default: Q_ASSERT(false); break;
-    }
     if (hole) {
         // remove hole
         p.addEllipse(QPointF(0, 0), mDrillDiameter.toPx()/2, mDrillDiameter.toPx()/2);
@@ -181,16 +151,46 @@ void BI_Via::setNetSignal(NetSignal* netsignal)
         }
         sgl.dismiss();
     }
+    if (isAddedToBoard()) {
+        mBoard.scheduleAirWiresRebuild(mNetSignal);
+        mBoard.scheduleAirWiresRebuild(netsignal);
+        scheduleCopperPourRefill();
+    }
     mNetSignal = netsignal;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+    if (isAddedToBoard()) mBoard.updateNetStatistics(*this);
+}
+
+void BI_Via::moveToNetSignal(NetSignal& netsignal)
+{
+    if ((!isAddedToBoard()) || (!mNetSignal) || (netsignal.getCircuit() != getCircuit())) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    if (&netsignal == mNetSignal) {
+        return;
+    }
+    mNetSignal->unregisterBoardVia(*this); // can throw
+    auto sg = scopeGuard([&](){mNetSignal->registerBoardVia(*this);});
+    netsignal.registerBoardVia(*this); // can throw
+    sg.dismiss();
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
+    mBoard.scheduleAirWiresRebuild(&netsignal);
+    scheduleCopperPourRefill();
+    mNetSignal = &netsignal;
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+    mBoard.updateNetStatistics(*this);
 }
 
 void BI_Via::setPosition(const Point& position) noexcept
 {
     if (position != mPosition) {
+        scheduleCopperPourRefill(); // the old area
         mPosition = position;
-        mGraphicsItem->setPos(mPosition.toPxQPointF());
+        updateGeometry();
+        if (mGraphicsItem) mGraphicsItem->setPos(mPosition.toPxQPointF());
         updateNetPoints();
+        mBoard.scheduleAirWiresRebuild(mNetSignal);
+        scheduleCopperPourRefill(); // the new area
     }
 }
 
@@ -198,15 +198,20 @@ void BI_Via::setShape(Shape shape) noexcept
 {
     if (shape != mShape) {
         mShape = shape;
-        mGraphicsItem->updateCacheAndRepaint();
+        updateGeometry();
+        if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+        scheduleCopperPourRefill();
     }
 }
 
 void BI_Via::setSize(const Length& size) noexcept
 {
     if (size != mSize) {
+        scheduleCopperPourRefill(); // the old area
         mSize = size;
-        mGraphicsItem->updateCacheAndRepaint();
+        updateGeometry();
+        if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+        scheduleCopperPourRefill(); // the new area
     }
 }
 
@@ -214,7 +219,7 @@ void BI_Via::setDrillDiameter(const Length& diameter) noexcept
 {
     if (diameter != mDrillDiameter) {
         mDrillDiameter = diameter;
-        mGraphicsItem->updateCacheAndRepaint();
+        if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
     }
 }
 
@@ -229,10 +234,12 @@ void BI_Via::addToBoard(GraphicsScene& scene)
     }
     if (mNetSignal) {
         mNetSignal->registerBoardVia(*this); // can throw
-        mHighlightChangedConnection = connect(mNetSignal, &NetSignal::highlightedChanged,
-                                              [this](){mGraphicsItem->update();});
     }
-    BI_Base::addToBoard(scene, *mGraphicsItem);
+    BI_Base::addToBoard(scene, mGraphicsItem.data());
+    boardAttributesChanged(); // board attributes may have changed while removed
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
+    mBoard.updateNetStatistics(*this);
+    scheduleCopperPourRefill();
 }
 
 void BI_Via::removeFromBoard(GraphicsScene& scene)
@@ -242,9 +249,11 @@ void BI_Via::removeFromBoard(GraphicsScene& scene)
     }
     if (mNetSignal) {
         mNetSignal->unregisterBoardVia(*this); // can throw
-        disconnect(mHighlightChangedConnection);
     }
-    BI_Base::removeFromBoard(scene, *mGraphicsItem);
+    BI_Base::removeFromBoard(scene, mGraphicsItem.data());
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
+    mBoard.updateNetStatistics(*this);
+    scheduleCopperPourRefill();
 }
 
 void BI_Via::registerNetPoint(BI_NetPoint& netpoint)
@@ -256,7 +265,7 @@ void BI_Via::registerNetPoint(BI_NetPoint& netpoint)
     }
     mRegisteredNetPoints.insert(netpoint.getLayer().getName(), &netpoint);
     netpoint.updateLines();
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 void BI_Via::unregisterNetPoint(BI_NetPoint& netpoint)
@@ -266,7 +275,7 @@ void BI_Via::unregisterNetPoint(BI_NetPoint& netpoint)
     }
     mRegisteredNetPoints.remove(netpoint.getLayer().getName());
     netpoint.updateLines();
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 void BI_Via::updateNetPoints() const noexcept
@@ -276,6 +285,14 @@ void BI_Via::updateNetPoints() const noexcept
     }
 }
 
+void BI_Via::scheduleCopperPourRefill() const noexcept
+{
+    // the size is an upper bound of the half diagonal of square vias
+    if (isAddedToBoard()) {
+        mBoard.scheduleCopperPourRefill(mPosition, mPosition, mSize);
+    }
+}
+
 void BI_Via::serialize(DomElement& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -301,27 +318,68 @@ void BI_Via::serialize(DomElement& root) const
 
 QPainterPath BI_Via::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 bool BI_Via::isSelectable() const noexcept
 {
-    return mGraphicsItem->isSelectable();
+    return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Via::setSelected(bool selected) noexcept
 {
     BI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void BI_Via::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
+}
+
+void BI_Via::boardAttributesChanged() noexcept
+{
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+}
+
+void BI_Via::netSignalHighlightChanged() noexcept
+{
+    if (mGraphicsItem) mGraphicsItem->update();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-void BI_Via::boardAttributesChanged()
+void BI_Via::initGraphicsItem() noexcept
 {
-    mGraphicsItem->updateCacheAndRepaint();
+    mGraphicsItem.reset(new BGI_Via(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+}
+
+void BI_Via::updateGeometry() noexcept
+{
+    switch (mShape)
+    {
+        case Shape::Round:
+            mGeometry = BoardItemGeometry::circle(mPosition, mSize);
+            break;
+        case Shape::Square:
+            mGeometry = BoardItemGeometry::rect(mPosition, mSize, mSize, Angle::deg0(), false);
+            break;
+        case Shape::Octagon:
+            mGeometry = BoardItemGeometry::octagon(mPosition, mSize, mSize, Angle::deg0(), false);
+            break;
+        default:
+            Q_ASSERT(false);
+            mGeometry = BoardItemGeometry();
+            break;
+    }
 }
 
 bool BI_Via::checkAttributesValidity() const noexcept
@@ -28,6 +28,7 @@
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/uuid.h>
 #include "../graphicsitems/bgi_via.h"
+#include "../boarditemgeometry.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -53,7 +54,7 @@ class ErcMsg;
  */
 class BI_Via final : public BI_Base, public SerializableObject
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(BI_Via)
 
     public:
 
@@ -80,6 +81,7 @@ class BI_Via final : public BI_Base, public SerializableObject
         bool isUsed() const noexcept {return (mRegisteredNetPoints.count() > 0);}
         bool isOnLayer(const QString& layerName) const noexcept;
         QPainterPath toQPainterPathPx(const Length& clearance, bool hole) const noexcept;
+        const BoardItemGeometry& getGeometry() const noexcept {return mGeometry;}
         bool isSelectable() const noexcept override;
 
         // Setters
@@ -95,6 +97,31 @@ class BI_Via final : public BI_Base, public SerializableObject
         void registerNetPoint(BI_NetPoint& netpoint);
         void unregisterNetPoint(BI_NetPoint& netpoint);
         void updateNetPoints() const noexcept;
+        void scheduleCopperPourRefill() const noexcept;
+
+        /**
+         * @brief Move the item to another net signal, even if it is used
+         *
+         * In contrast to #setNetSignal(), the attached items are not checked, so the
+         * caller has to move all items of the net signal at once (see
+         * librepcb::project::CmdNetSignalMoveItems).
+         *
+         * @throw Exception If the item is not added or on registration errors
+         */
+        void moveToNetSignal(NetSignal& netsignal);
+
+        /**
+         * @brief Update the graphics item after attributes of the board have changed
+         *
+         * Called by the board for all its vias when it emits
+         * librepcb::project::Board::attributesChanged() (e.g. after the design rules
+         * or the layer stack were modified).
+         */
+        void boardAttributesChanged() noexcept;
+
+        /// Repaint after the highlight state of the net signal has changed (called by
+        /// librepcb::project::NetSignal::setHighlighted())
+        void netSignalHighlightChanged() noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
@@ -106,6 +133,7 @@ class BI_Via final : public BI_Base, public SerializableObject
         bool getIsMirrored() const noexcept override {return false;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         BI_Via& operator=(const BI_Via& rhs) = delete;
@@ -116,13 +144,14 @@ class BI_Via final : public BI_Base, public SerializableObject
     private:
 
         void init();
-        void boardAttributesChanged();
+        void initGraphicsItem() noexcept;
+        void updateGeometry() noexcept;
         bool checkAttributesValidity() const noexcept;
 
 
         // General
         QScopedPointer<BGI_Via> mGraphicsItem;
-        QMetaObject::Connection mHighlightChangedConnection;
+        BoardItemGeometry mGeometry; ///< the copper area in scene coordinates
 
         // Attributes
         Uuid mUuid;
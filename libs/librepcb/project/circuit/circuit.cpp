@@ -44,7 +44,8 @@ namespace project {
 
 Circuit::Circuit(Project& project, bool restore, bool readOnly, bool create) :
     QObject(&project), mProject(project),
-    mXmlFilepath(project.getPath().getPathTo("core/circuit.xml")), mXmlFile(nullptr)
+    mXmlFilepath(project.getPath().getPathTo("core/circuit.xml")), mXmlFile(nullptr),
+    mBulkUpdateDepth(0)
 {
     qDebug() << "load circuit...";
     Q_ASSERT(!(create && (restore || readOnly)));
@@ -193,11 +194,14 @@ void Circuit::setNetClassName(NetClass& netclass, const QString& newName)
 
 QString Circuit::generateAutoNetSignalName() const noexcept
 {
+    const QString prefix = QStringLiteral("N#");
     QString name;
-    int i = 1;
-    do {
-        name = QString("N#%1").arg(i++);
-    } while (getNetSignalByName(name));
+    int& i = getNextAutoNameNumber(mNextNetSignalNumbers, prefix);
+    while (true) {
+        name = prefix % QString::number(i);
+        if (!getNetSignalByName(name)) break;
+        ++i;
+    }
     return name;
 }
 
@@ -208,12 +212,7 @@ NetSignal* Circuit::getNetSignalByUuid(const Uuid& uuid) const noexcept
 
 NetSignal* Circuit::getNetSignalByName(const QString& name) const noexcept
 {
-    foreach (NetSignal* netsignal, mNetSignals) {
-        if (netsignal->getName() == name) {
-            return netsignal;
-        }
-    }
-    return nullptr;
+    return mNetSignalsByName.value(name, nullptr);
 }
 
 void Circuit::addNetSignal(NetSignal& netsignal)
@@ -236,6 +235,7 @@ void Circuit::addNetSignal(NetSignal& netsignal)
     // add netsignal to circuit
     netsignal.addToCircuit(); // can throw
     mNetSignals.insert(netsignal.getUuid(), &netsignal);
+    mNetSignalsByName.insert(netsignal.getName(), &netsignal);
     emit netSignalAdded(netsignal);
 }
 
@@ -248,6 +248,8 @@ void Circuit::removeNetSignal(NetSignal& netsignal)
     // remove netsignal from circuit
     netsignal.removeFromCircuit(); // can throw
     mNetSignals.remove(netsignal.getUuid());
+    mNetSignalsByName.remove(netsignal.getName());
+    releaseAutoNameNumber(mNextNetSignalNumbers, netsignal.getName());
     emit netSignalRemoved(netsignal);
 }
 
@@ -259,12 +261,16 @@ void Circuit::setNetSignalName(NetSignal& netsignal, const QString& newName,
         throw LogicError(__FILE__, __LINE__);
     }
     // check if there is no netsignal with the same name in the list
-    if (getNetSignalByName(newName)) {
+    if ((newName != netsignal.getName()) && getNetSignalByName(newName)) {
         throw RuntimeError(__FILE__, __LINE__,
             QString(tr("There is already a net signal with the name \"%1\"!")).arg(newName));
     }
     // apply the new name
+    QString oldName = netsignal.getName();
     netsignal.setName(newName, isAutoName); // can throw
+    mNetSignalsByName.remove(oldName);
+    mNetSignalsByName.insert(newName, &netsignal);
+    releaseAutoNameNumber(mNextNetSignalNumbers, oldName);
 }
 
 void Circuit::setHighlightedNetSignal(NetSignal* signal) noexcept
@@ -280,11 +286,14 @@ void Circuit::setHighlightedNetSignal(NetSignal* signal) noexcept
 
 QString Circuit::generateAutoComponentInstanceName(const QString& cmpPrefix) const noexcept
 {
+    const QString prefix = cmpPrefix.isEmpty() ? QStringLiteral("?") : cmpPrefix;
     QString name;
-    int i = 1;
-    do {
-        name = QString("%1%2").arg(cmpPrefix.isEmpty() ? "?" : cmpPrefix).arg(i++);
-    } while (getComponentInstanceByName(name));
+    int& i = getNextAutoNameNumber(mNextComponentInstanceNumbers, prefix);
+    while (true) {
+        name = prefix % QString::number(i);
+        if (!getComponentInstanceByName(name)) break;
+        ++i;
+    }
     return name;
 }
 
@@ -295,12 +304,7 @@ ComponentInstance* Circuit::getComponentInstanceByUuid(const Uuid& uuid) const n
 
 ComponentInstance* Circuit::getComponentInstanceByName(const QString& name) const noexcept
 {
-    foreach (ComponentInstance* compInstance, mComponentInstances)
-    {
-        if (compInstance->getName() == name)
-            return compInstance;
-    }
-    return nullptr;
+    return mComponentInstancesByName.value(name, nullptr);
 }
 
 void Circuit::addComponentInstance(ComponentInstance& cmp)
@@ -323,6 +327,7 @@ void Circuit::addComponentInstance(ComponentInstance& cmp)
     // add to circuit
     cmp.addToCircuit(); // can throw
     mComponentInstances.insert(cmp.getUuid(), &cmp);
+    mComponentInstancesByName.insert(cmp.getName(), &cmp);
     emit componentAdded(cmp);
 }
 
@@ -335,6 +340,8 @@ void Circuit::removeComponentInstance(ComponentInstance& cmp)
     // remove from circuit
     cmp.removeFromCircuit(); // can throw
     mComponentInstances.remove(cmp.getUuid());
+    mComponentInstancesByName.remove(cmp.getName());
+    releaseAutoNameNumber(mNextComponentInstanceNumbers, cmp.getName());
     emit componentRemoved(cmp);
 }
 
@@ -350,7 +357,51 @@ void Circuit::setComponentInstanceName(ComponentInstance& cmp, const QString& ne
             QString(tr("There is already a component with the name \"%1\"!")).arg(newName));
     }
     // apply the new name
+    QString oldName = cmp.getName();
     cmp.setName(newName); // can throw
+    mComponentInstancesByName.remove(oldName);
+    mComponentInstancesByName.insert(newName, &cmp);
+    releaseAutoNameNumber(mNextComponentInstanceNumbers, oldName);
+}
+
+/*****************************************************************************************
+ *  Bulk Updates
+ ****************************************************************************************/
+
+void Circuit::beginBulkUpdate() noexcept
+{
+    mBulkUpdateDepth++;
+}
+
+void Circuit::endBulkUpdate() noexcept
+{
+    Q_ASSERT(mBulkUpdateDepth > 0);
+    if (--mBulkUpdateDepth > 0) return;
+
+    // process all pending updates (the net signals may have been deleted in the meantime)
+    foreach (const QPointer<NetSignal>& netsignal, mPendingErcUpdates) {
+        if (netsignal) netsignal->updateErcMessages();
+    }
+    mPendingErcUpdates.clear();
+
+    // notify all modified components (this re-substitutes the texts of their symbols
+    // and footprints, and updates the ERC messages of their signals)
+    foreach (const QPointer<ComponentInstance>& cmp, mPendingAttributeChanges) {
+        if (cmp) emit cmp->attributesChanged();
+    }
+    mPendingAttributeChanges.clear();
+}
+
+void Circuit::scheduleErcMessagesUpdate(NetSignal& netsignal) noexcept
+{
+    Q_ASSERT(isBulkUpdateActive());
+    mPendingErcUpdates.insert(&netsignal, QPointer<NetSignal>(&netsignal));
+}
+
+void Circuit::scheduleAttributesChanged(ComponentInstance& cmp) noexcept
+{
+    Q_ASSERT(isBulkUpdateActive());
+    mPendingAttributeChanges.insert(&cmp, QPointer<ComponentInstance>(&cmp));
 }
 
 /*****************************************************************************************
@@ -364,8 +415,8 @@ bool Circuit::save(bool toOriginal, QStringList& errors) noexcept
     // Save "core/circuit.xml"
     try
     {
-        DomDocument doc(*serializeToDomElement("circuit"));
-        mXmlFile->save(doc, toOriginal);
+        mXmlFile->setCompressed(mProject.getSettings().getCompressFiles());
+        mXmlFile->save(*this, "circuit", toOriginal);
     }
     catch (Exception& e)
     {
@@ -381,6 +432,44 @@ bool Circuit::save(bool toOriginal, QStringList& errors) noexcept
  ****************************************************************************************/
 
 void Circuit::serialize(DomElement& root) const
+{
+    serializeChilds(root);
+}
+
+void Circuit::serializeToXmlStream(QXmlStreamWriter& writer, const QString& name) const
+{
+    writer.writeStartElement(name);
+    serializeChilds(writer); // can throw
+    writer.writeEndElement();
+}
+
+int& Circuit::getNextAutoNameNumber(QHash<QString, int>& counters,
+                                    const QString& prefix) noexcept
+{
+    auto it = counters.find(prefix);
+    if (it == counters.end()) {
+        it = counters.insert(prefix, 1);
+    }
+    return it.value();
+}
+
+void Circuit::releaseAutoNameNumber(QHash<QString, int>& counters,
+                                    const QString& name) noexcept
+{
+    // The prefix may end with digits too (e.g. "U1" + "3"), so the name is compared with
+    // all known prefixes instead of splitting it. There are only a few of them.
+    for (auto it = counters.begin(); it != counters.end(); ++it) {
+        if (!name.startsWith(it.key())) continue;
+        bool ok = false;
+        int number = name.mid(it.key().length()).toInt(&ok);
+        if (ok && (number >= 1) && (number < it.value())) {
+            it.value() = number; // may be used again by the next generated name
+        }
+    }
+}
+
+template <typename T>
+void Circuit::serializeChilds(T& root) const
 {
     serializePointerContainer(root, mNetClasses, "netclass");
     serializePointerContainer(root, mNetSignals, "netsignal");
@@ -110,6 +110,24 @@ class Circuit final : public QObject, public SerializableObject
         void removeComponentInstance(ComponentInstance& cmp);
         void setComponentInstanceName(ComponentInstance& cmp, const QString& newName);
 
+        // Bulk Updates
+
+        /**
+         * @brief Start a bulk update (e.g. while executing a large command group)
+         *
+         * Until the matching #endBulkUpdate() is called, net signals do not update their
+         * ERC messages after every single (un)registered item, but only once at the end.
+         * Similarly, component instances emit ComponentInstance#attributesChanged() only
+         * once at the end, no matter how often their name, value or attributes changed.
+         * Calls can be nested, the pending updates are processed by the outermost
+         * #endBulkUpdate().
+         */
+        void beginBulkUpdate() noexcept;
+        void endBulkUpdate() noexcept;
+        bool isBulkUpdateActive() const noexcept {return (mBulkUpdateDepth > 0);}
+        void scheduleErcMessagesUpdate(NetSignal& netsignal) noexcept;
+        void scheduleAttributesChanged(ComponentInstance& cmp) noexcept;
+
         // General Methods
         bool save(bool toOriginal, QStringList& errors) noexcept;
 
@@ -133,6 +151,32 @@ class Circuit final : public QObject, public SerializableObject
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
 
+        /// @copydoc librepcb::SerializableObject::serializeToXmlStream()
+        void serializeToXmlStream(QXmlStreamWriter& writer, const QString& name) const override;
+
+        /**
+         * @brief Serialize all childs into a DomElement or a QXmlStreamWriter
+         *
+         * Used by both #serialize() and #serializeToXmlStream() to get identical output.
+         */
+        template <typename T>
+        void serializeChilds(T& root) const;
+
+        /**
+         * @brief Get the counter to start searching a free auto name with a prefix
+         *
+         * All numbers below the counter are known to be in use, so the generated names
+         * are the same as when searching from 1 (but without testing all used names).
+         */
+        static int& getNextAutoNameNumber(QHash<QString, int>& counters,
+                                          const QString& prefix) noexcept;
+
+        /**
+         * @brief Reset the counter of a prefix after a name was removed or renamed
+         */
+        static void releaseAutoNameNumber(QHash<QString, int>& counters,
+                                          const QString& name) noexcept;
+
 
         // General
         Project& mProject; ///< A reference to the Project object (from the ctor)
@@ -144,6 +188,17 @@ class Circuit final : public QObject, public SerializableObject
         QMap<Uuid, NetClass*> mNetClasses;
         QMap<Uuid, NetSignal*> mNetSignals;
         QMap<Uuid, ComponentInstance*> mComponentInstances;
+
+        // Indexes
+        QHash<QString, NetSignal*> mNetSignalsByName;
+        QHash<QString, ComponentInstance*> mComponentInstancesByName;
+        mutable QHash<QString, int> mNextNetSignalNumbers;         ///< key: prefix ("N#")
+        mutable QHash<QString, int> mNextComponentInstanceNumbers; ///< key: prefix (e.g. "R")
+
+        // Bulk Updates
+        int mBulkUpdateDepth;
+        QHash<NetSignal*, QPointer<NetSignal>> mPendingErcUpdates; ///< updated at the end
+        QHash<ComponentInstance*, QPointer<ComponentInstance>> mPendingAttributeChanges; ///< notified at the end
 };
 
 /*****************************************************************************************
@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "circuitbomexport.h"
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/toolbox.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CircuitBomExport::CircuitBomExport(const CircuitSnapshot& snapshot) noexcept :
+    mSnapshot(snapshot)
+{
+}
+
+CircuitBomExport::~CircuitBomExport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QList<CircuitBomExport::Row> CircuitBomExport::getRows() const noexcept
+{
+    // group all components by the properties which are relevant for purchasing
+    QList<Row> rows;
+    QHash<QString, int> rowIndices;
+    foreach (const CircuitSnapshot::Component& cmp, mSnapshot.getComponents()) {
+        if (cmp.schematicOnly) continue;
+        QString key = QStringList{cmp.value, cmp.libComponentName, cmp.libDeviceName,
+                                  cmp.libPackageName}.join(QChar(0x1F)); // unit separator
+        auto it = rowIndices.find(key);
+        if (it == rowIndices.end()) {
+            it = rowIndices.insert(key, rows.count());
+            rows.append(Row{QStringList(), cmp.value, cmp.libComponentName,
+                            cmp.libDeviceName, cmp.libPackageName});
+        }
+        rows[it.value()].designators.append(cmp.name);
+    }
+
+    for (Row& row : rows) {
+        std::sort(row.designators.begin(), row.designators.end(), &Toolbox::naturalLessThan);
+    }
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b)
+        {return Toolbox::naturalLessThan(a.designators.first(), b.designators.first());});
+    return rows;
+}
+
+QByteArray CircuitBomExport::generateCsv() const noexcept
+{
+    QString csv = Toolbox::toCsvLine({"Quantity", "Designators", "Value", "Component",
+                                      "Device", "Package"}) % "\n";
+    foreach (const Row& row, getRows()) {
+        csv += Toolbox::toCsvLine({QString::number(row.designators.count()),
+                                   row.designators.join(", "), row.value,
+                                   row.libComponentName, row.libDeviceName,
+                                   row.libPackageName}) % "\n";
+    }
+    return csv.toUtf8();
+}
+
+void CircuitBomExport::exportToFile(const FilePath& filepath) const
+{
+    FileUtils::writeFile(filepath, generateCsv()); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
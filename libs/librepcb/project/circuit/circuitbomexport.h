@@ -0,0 +1,102 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CIRCUITBOMEXPORT_H
+#define LIBREPCB_PROJECT_CIRCUITBOMEXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include "circuitsnapshot.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Class CircuitBomExport
+ ****************************************************************************************/
+
+/**
+ * @brief The CircuitBomExport class generates a bill of materials from a
+ *        librepcb::project::CircuitSnapshot
+ *
+ * All components with the same value, library component, device and package are merged
+ * into a single row which lists their designators (e.g. "C1, C2, C5"). Schematic-only
+ * components (e.g. frames) are omitted. The designators and rows are sorted in natural
+ * order, so the output is stable and suitable for diffs.
+ *
+ * Since only the snapshot is accessed, the export can be run in any thread.
+ */
+class CircuitBomExport final
+{
+        Q_DECLARE_TR_FUNCTIONS(CircuitBomExport)
+
+    public:
+
+        // Types
+        struct Row {
+            QStringList designators;
+            QString value;
+            QString libComponentName;
+            QString libDeviceName;
+            QString libPackageName;
+        };
+
+        // Constructors / Destructor
+        CircuitBomExport() = delete;
+        CircuitBomExport(const CircuitBomExport& other) = delete;
+        explicit CircuitBomExport(const CircuitSnapshot& snapshot) noexcept;
+        ~CircuitBomExport() noexcept;
+
+        // General Methods
+        QList<Row> getRows() const noexcept;
+        QByteArray generateCsv() const noexcept;
+
+        /**
+         * @brief Write the bill of materials as CSV file
+         *
+         * @param filepath  The file to write (parent directories are created if needed)
+         *
+         * @throw Exception if the file could not be written
+         */
+        void exportToFile(const FilePath& filepath) const;
+
+        // Operator Overloadings
+        CircuitBomExport& operator=(const CircuitBomExport& rhs) = delete;
+
+
+    private:
+
+        CircuitSnapshot mSnapshot;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CIRCUITBOMEXPORT_H
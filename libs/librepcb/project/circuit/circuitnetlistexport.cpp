@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "circuitnetlistexport.h"
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/toolbox.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CircuitNetlistExport::CircuitNetlistExport(const CircuitSnapshot& snapshot) noexcept :
+    mSnapshot(snapshot)
+{
+}
+
+CircuitNetlistExport::~CircuitNetlistExport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QList<CircuitNetlistExport::Row> CircuitNetlistExport::getRows() const noexcept
+{
+    QList<Row> rows;
+    foreach (const CircuitSnapshot::Net& net, mSnapshot.getNets()) {
+        QSet<QString> nodes;
+        foreach (const CircuitSnapshot::Pin& pin, net.pins) {
+            if (pin.padNames.isEmpty()) {
+                nodes.insert(pin.componentName % "-" % pin.signalName);
+            } else {
+                foreach (const QString& padName, pin.padNames) {
+                    nodes.insert(pin.componentName % "-" % padName);
+                }
+            }
+        }
+        if (nodes.isEmpty()) continue;
+        Row row{net.name, net.netClassName, nodes.toList()};
+        std::sort(row.nodes.begin(), row.nodes.end(), &Toolbox::naturalLessThan);
+        rows.append(row);
+    }
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b)
+        {return Toolbox::naturalLessThan(a.netName, b.netName);});
+    return rows;
+}
+
+QByteArray CircuitNetlistExport::generateCsv() const noexcept
+{
+    QString csv = Toolbox::toCsvLine({"Net", "Net Class", "Nodes"}) % "\n";
+    foreach (const Row& row, getRows()) {
+        csv += Toolbox::toCsvLine({row.netName, row.netClassName, row.nodes.join(' ')}) % "\n";
+    }
+    return csv.toUtf8();
+}
+
+void CircuitNetlistExport::exportToFile(const FilePath& filepath) const
+{
+    FileUtils::writeFile(filepath, generateCsv()); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,101 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CIRCUITNETLISTEXPORT_H
+#define LIBREPCB_PROJECT_CIRCUITNETLISTEXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include "circuitsnapshot.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Class CircuitNetlistExport
+ ****************************************************************************************/
+
+/**
+ * @brief The CircuitNetlistExport class generates a netlist from a
+ *        librepcb::project::CircuitSnapshot
+ *
+ * The netlist contains one row per net signal with at least one connected component
+ * signal. Each row lists all nodes of the net in the form "<component>-<pad>" (or
+ * "<component>-<signal>" if the snapshot does not contain a board or the signal is not
+ * connected to any pad). Duplicate nodes are removed and both rows and nodes are sorted
+ * in natural order, so the output is stable and suitable for diffs.
+ *
+ * Since only the snapshot is accessed, the export can be run in any thread.
+ */
+class CircuitNetlistExport final
+{
+        Q_DECLARE_TR_FUNCTIONS(CircuitNetlistExport)
+
+    public:
+
+        // Types
+        struct Row {
+            QString netName;
+            QString netClassName;
+            QStringList nodes;
+        };
+
+        // Constructors / Destructor
+        CircuitNetlistExport() = delete;
+        CircuitNetlistExport(const CircuitNetlistExport& other) = delete;
+        explicit CircuitNetlistExport(const CircuitSnapshot& snapshot) noexcept;
+        ~CircuitNetlistExport() noexcept;
+
+        // General Methods
+        QList<Row> getRows() const noexcept;
+        QByteArray generateCsv() const noexcept;
+
+        /**
+         * @brief Write the netlist as CSV file
+         *
+         * @param filepath  The file to write (parent directories are created if needed)
+         *
+         * @throw Exception if the file could not be written
+         */
+        void exportToFile(const FilePath& filepath) const;
+
+        // Operator Overloadings
+        CircuitNetlistExport& operator=(const CircuitNetlistExport& rhs) = delete;
+
+
+    private:
+
+        CircuitSnapshot mSnapshot;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CIRCUITNETLISTEXPORT_H
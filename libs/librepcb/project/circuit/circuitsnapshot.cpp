@@ -0,0 +1,105 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "circuitsnapshot.h"
+#include "circuit.h"
+#include "componentinstance.h"
+#include "componentsignalinstance.h"
+#include "netclass.h"
+#include "netsignal.h"
+#include "../project.h"
+#include "../settings/projectsettings.h"
+#include "../boards/board.h"
+#include "../boards/items/bi_device.h"
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CircuitSnapshot::CircuitSnapshot(const Circuit& circuit, const Board* board) noexcept
+{
+    QStringList localeOrder = circuit.getProject().getSettings().getLocaleOrder();
+
+    // pad names of the board, key: component UUID and component signal UUID
+    QHash<QPair<Uuid, Uuid>, QStringList> padNames;
+    if (board) {
+        mBoardName = board->getName();
+        foreach (const BI_Device* device, board->getDeviceInstances()) {
+            Uuid cmpUuid = device->getComponentInstanceUuid();
+            const library::Package& package = device->getLibPackage();
+            for (const library::DevicePadSignalMapItem& item : device->getLibDevice().getPadSignalMap()) {
+                std::shared_ptr<const library::PackagePad> pad = package.getPads().find(item.getPadUuid());
+                if (pad && (!item.getSignalUuid().isNull())) {
+                    padNames[qMakePair(cmpUuid, item.getSignalUuid())].append(pad->getName());
+                }
+            }
+        }
+    }
+
+    foreach (const ComponentInstance* cmp, circuit.getComponentInstances()) {
+        Component component;
+        component.uuid = cmp->getUuid();
+        component.name = cmp->getName();
+        component.value = cmp->getValue(true);
+        component.libComponentName = cmp->getLibComponent().getNames().value(localeOrder);
+        component.schematicOnly = cmp->getLibComponent().isSchematicOnly();
+        const BI_Device* device = board ? board->getDeviceInstanceByComponentUuid(cmp->getUuid()) : nullptr;
+        if (device) {
+            component.libDeviceName = device->getLibDevice().getNames().value(localeOrder);
+            component.libPackageName = device->getLibPackage().getNames().value(localeOrder);
+        }
+        mComponents.append(component);
+    }
+
+    foreach (const NetSignal* netsignal, circuit.getNetSignals()) {
+        Net net;
+        net.uuid = netsignal->getUuid();
+        net.name = netsignal->getName();
+        net.netClassName = netsignal->getNetClass().getName();
+        foreach (const ComponentSignalInstance* signal, netsignal->getComponentSignals()) {
+            const ComponentInstance& cmp = signal->getComponentInstance();
+            Pin pin;
+            pin.componentName = cmp.getName();
+            pin.signalName = signal->getCompSignal().getName();
+            pin.padNames = padNames.value(qMakePair(cmp.getUuid(), signal->getCompSignal().getUuid()));
+            net.pins.append(pin);
+        }
+        mNets.append(net);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
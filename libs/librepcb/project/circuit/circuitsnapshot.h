@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CIRCUITSNAPSHOT_H
+#define LIBREPCB_PROJECT_CIRCUITSNAPSHOT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Circuit;
+class Board;
+
+/*****************************************************************************************
+ *  Class CircuitSnapshot
+ ****************************************************************************************/
+
+/**
+ * @brief The CircuitSnapshot class is a read-only copy of the components and the
+ *        connections of a librepcb::project::Circuit
+ *
+ * The circuit itself (and all objects it contains) may only be accessed from the thread
+ * it lives in, i.e. usually the GUI thread. A snapshot instead contains only plain values
+ * (names, UUIDs and lists of them), so it can be passed to and read from any other thread
+ * once it was created. Copying a snapshot is cheap since all members are implicitly
+ * shared.
+ *
+ * If a board is given, the devices and pads of that board are added to the snapshot as
+ * well (e.g. for a BOM or a netlist with pad names).
+ *
+ * @see librepcb::project::CircuitNetlistExport, librepcb::project::CircuitBomExport
+ */
+class CircuitSnapshot final
+{
+    public:
+
+        // Types
+        struct Component {
+            Uuid uuid;
+            QString name;               ///< e.g. "R42"
+            QString value;              ///< with all attributes substituted
+            QString libComponentName;
+            QString libDeviceName;      ///< empty if there is no device on the board
+            QString libPackageName;     ///< empty if there is no device on the board
+            bool schematicOnly;         ///< e.g. schematic frames
+        };
+        struct Pin {
+            QString componentName;
+            QString signalName;
+            QStringList padNames;       ///< the connected pads of the board (if any)
+        };
+        struct Net {
+            Uuid uuid;
+            QString name;
+            QString netClassName;
+            QList<Pin> pins;
+        };
+
+        // Constructors / Destructor
+        CircuitSnapshot() noexcept {}
+        CircuitSnapshot(const CircuitSnapshot& other) = default;
+
+        /**
+         * @brief Create a snapshot of the current state of a circuit
+         *
+         * @warning This constructor must be called in the thread of the circuit!
+         *
+         * @param circuit   The circuit to copy
+         * @param board     The board to take the devices and pads from (optional)
+         */
+        explicit CircuitSnapshot(const Circuit& circuit, const Board* board = nullptr) noexcept;
+        ~CircuitSnapshot() noexcept {}
+
+        // Getters
+        const QString& getBoardName() const noexcept {return mBoardName;}
+        const QList<Component>& getComponents() const noexcept {return mComponents;}
+        const QList<Net>& getNets() const noexcept {return mNets;}
+
+        // Operator Overloadings
+        CircuitSnapshot& operator=(const CircuitSnapshot& rhs) = default;
+
+
+    private:
+
+        QString mBoardName;         ///< empty if no board was given
+        QList<Component> mComponents;
+        QList<Net> mNets;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CIRCUITSNAPSHOT_H
@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdcomponentinstancesedit.h"
+#include "../circuit.h"
+#include "../componentinstance.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdComponentInstancesEdit::CmdComponentInstancesEdit(Circuit& circuit) noexcept :
+    UndoCommand(tr("Edit Components")), mCircuit(circuit)
+{
+}
+
+CmdComponentInstancesEdit::~CmdComponentInstancesEdit() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void CmdComponentInstancesEdit::setValue(ComponentInstance& cmp, const QString& value) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    getEntry(cmp).newValue = value;
+}
+
+void CmdComponentInstancesEdit::setAttributes(ComponentInstance& cmp,
+                                              const AttributeList& attributes) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    getEntry(cmp).newAttributes = attributes;
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdComponentInstancesEdit::performExecute()
+{
+    // remove entries without modifications to keep the undo stack small
+    for (int i = mEntries.count() - 1; i >= 0; --i) {
+        const Entry& entry = mEntries.at(i);
+        if ((entry.newValue == entry.oldValue) &&
+            (entry.newAttributes == entry.oldAttributes)) {
+            mEntries.removeAt(i);
+        }
+    }
+    mEntryIndices.clear();
+
+    performRedo();
+    return !mEntries.isEmpty();
+}
+
+void CmdComponentInstancesEdit::performUndo()
+{
+    apply(false);
+}
+
+void CmdComponentInstancesEdit::performRedo()
+{
+    apply(true);
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+CmdComponentInstancesEdit::Entry& CmdComponentInstancesEdit::getEntry(
+        ComponentInstance& cmp) noexcept
+{
+    int index = mEntryIndices.value(&cmp, -1);
+    if (index < 0) {
+        index = mEntries.count();
+        mEntries.append(Entry{&cmp, cmp.getValue(), cmp.getValue(),
+                              cmp.getAttributes(), cmp.getAttributes()});
+        mEntryIndices.insert(&cmp, index);
+    }
+    return mEntries[index];
+}
+
+void CmdComponentInstancesEdit::apply(bool redo) noexcept
+{
+    // the text substitution is done only once per component at the end of the bulk update
+    mCircuit.beginBulkUpdate();
+    for (const Entry& entry : mEntries) {
+        entry.component->setValue(redo ? entry.newValue : entry.oldValue);
+        entry.component->setAttributes(redo ? entry.newAttributes : entry.oldAttributes);
+    }
+    mCircuit.endBulkUpdate();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
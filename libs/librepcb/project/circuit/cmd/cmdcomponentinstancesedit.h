@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_CMDCOMPONENTINSTANCESEDIT_H
+#define LIBREPCB_PROJECT_CMDCOMPONENTINSTANCESEDIT_H
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommand.h>
+#include <librepcb/common/attributes/attribute.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Circuit;
+class ComponentInstance;
+
+/*****************************************************************************************
+ *  Class CmdComponentInstancesEdit
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdComponentInstancesEdit class edits values and attributes of many
+ *        component instances at once
+ *
+ * In contrast to a command group of #project#CmdComponentInstanceEdit, all
+ * modifications are applied within a single bulk update of the circuit (see
+ * #project#Circuit#beginBulkUpdate()). So the texts of the symbols and footprints are
+ * re-substituted only once per component, after all modifications are applied.
+ */
+class CmdComponentInstancesEdit final : public UndoCommand
+{
+    public:
+
+        // Constructors / Destructor
+        explicit CmdComponentInstancesEdit(Circuit& circuit) noexcept;
+        ~CmdComponentInstancesEdit() noexcept;
+
+        // Setters
+        void setValue(ComponentInstance& cmp, const QString& value) noexcept;
+        void setAttributes(ComponentInstance& cmp, const AttributeList& attributes) noexcept;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+        struct Entry {
+            ComponentInstance* component;
+            QString oldValue;
+            QString newValue;
+            AttributeList oldAttributes;
+            AttributeList newAttributes;
+        };
+
+        Entry& getEntry(ComponentInstance& cmp) noexcept;
+        void apply(bool redo) noexcept;
+
+
+        // Private Member Variables
+
+        // Attributes from the constructor
+        Circuit& mCircuit;
+
+        // Misc
+        QList<Entry> mEntries; ///< in the order of the first modification
+        QHash<ComponentInstance*, int> mEntryIndices; ///< only valid before execution
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDCOMPONENTINSTANCESEDIT_H
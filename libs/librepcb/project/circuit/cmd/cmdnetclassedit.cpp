@@ -37,7 +37,12 @@ namespace project {
 
 CmdNetClassEdit::CmdNetClassEdit(Circuit& circuit, NetClass& netclass) noexcept :
     UndoCommand(tr("Edit netclass")), mCircuit(circuit), mNetClass(netclass),
-    mOldName(netclass.getName()), mNewName(mOldName)
+    mOldName(netclass.getName()), mNewName(mOldName),
+    mOldTraceWidth(netclass.getTraceWidth()), mNewTraceWidth(mOldTraceWidth),
+    mOldClearance(netclass.getClearance()), mNewClearance(mOldClearance),
+    mOldViaSize(netclass.getViaSize()), mNewViaSize(mOldViaSize),
+    mOldViaDrillDiameter(netclass.getViaDrillDiameter()),
+    mNewViaDrillDiameter(mOldViaDrillDiameter)
 {
 }
 
@@ -55,6 +60,30 @@ void CmdNetClassEdit::setName(const QString& name) noexcept
     mNewName = name;
 }
 
+void CmdNetClassEdit::setTraceWidth(const Length& width) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewTraceWidth = width;
+}
+
+void CmdNetClassEdit::setClearance(const Length& clearance) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewClearance = clearance;
+}
+
+void CmdNetClassEdit::setViaSize(const Length& size) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewViaSize = size;
+}
+
+void CmdNetClassEdit::setViaDrillDiameter(const Length& dia) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewViaDrillDiameter = dia;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
@@ -68,12 +97,24 @@ bool CmdNetClassEdit::performExecute()
 
 void CmdNetClassEdit::performUndo()
 {
-    mCircuit.setNetClassName(mNetClass, mOldName); // can throw
+    if (mOldName != mNetClass.getName()) {
+        mCircuit.setNetClassName(mNetClass, mOldName); // can throw
+    }
+    mNetClass.setTraceWidth(mOldTraceWidth);
+    mNetClass.setClearance(mOldClearance);
+    mNetClass.setViaSize(mOldViaSize);
+    mNetClass.setViaDrillDiameter(mOldViaDrillDiameter);
 }
 
 void CmdNetClassEdit::performRedo()
 {
-    mCircuit.setNetClassName(mNetClass, mNewName); // can throw
+    if (mNewName != mNetClass.getName()) {
+        mCircuit.setNetClassName(mNetClass, mNewName); // can throw
+    }
+    mNetClass.setTraceWidth(mNewTraceWidth);
+    mNetClass.setClearance(mNewClearance);
+    mNetClass.setViaSize(mNewViaSize);
+    mNetClass.setViaDrillDiameter(mNewViaDrillDiameter);
 }
 
 /*****************************************************************************************
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/undocommand.h>
+#include <librepcb/common/units/length.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -52,6 +53,10 @@ class CmdNetClassEdit final : public UndoCommand
 
         // Setters
         void setName(const QString& name) noexcept;
+        void setTraceWidth(const Length& width) noexcept;
+        void setClearance(const Length& clearance) noexcept;
+        void setViaSize(const Length& size) noexcept;
+        void setViaDrillDiameter(const Length& dia) noexcept;
 
 
     private:
@@ -77,6 +82,14 @@ class CmdNetClassEdit final : public UndoCommand
         // General Attributes
         QString mOldName;
         QString mNewName;
+        Length mOldTraceWidth;
+        Length mNewTraceWidth;
+        Length mOldClearance;
+        Length mNewClearance;
+        Length mOldViaSize;
+        Length mNewViaSize;
+        Length mOldViaDrillDiameter;
+        Length mNewViaDrillDiameter;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,130 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdnetsignalmoveitems.h"
+#include <librepcb/common/scopeguardlist.h>
+#include "../circuit.h"
+#include "../netsignal.h"
+#include "../componentsignalinstance.h"
+#include "../../schematics/items/si_netpoint.h"
+#include "../../schematics/items/si_netlabel.h"
+#include "../../boards/items/bi_netpoint.h"
+#include "../../boards/items/bi_via.h"
+#include "../../boards/items/bi_polygon.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdNetSignalMoveItems::CmdNetSignalMoveItems(NetSignal& from, NetSignal& to) noexcept :
+    UndoCommand(tr("Move net signal items")), mFrom(from), mTo(to)
+{
+}
+
+CmdNetSignalMoveItems::~CmdNetSignalMoveItems() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdNetSignalMoveItems::performExecute()
+{
+    if (&mFrom == &mTo) {
+        return false;
+    }
+    mComponentSignals = mFrom.getComponentSignals();
+    mSchematicNetPoints = mFrom.getSchematicNetPoints();
+    mSchematicNetLabels = mFrom.getSchematicNetLabels();
+    mBoardNetPoints = mFrom.getBoardNetPoints();
+    mBoardVias = mFrom.getBoardVias();
+    mBoardPolygons = mFrom.getBoardPolygons();
+
+    performRedo(); // can throw
+
+    return true;
+}
+
+void CmdNetSignalMoveItems::performUndo()
+{
+    moveItems(mFrom); // can throw
+}
+
+void CmdNetSignalMoveItems::performRedo()
+{
+    moveItems(mTo); // can throw
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void CmdNetSignalMoveItems::moveItems(NetSignal& netsignal)
+{
+    NetSignal& other = (&netsignal == &mTo) ? mFrom : mTo;
+    Circuit& circuit = netsignal.getCircuit();
+    circuit.beginBulkUpdate(); // update the ERC messages only once
+    auto sg = scopeGuard([&](){circuit.endBulkUpdate();});
+
+    ScopeGuardList sgl;
+    foreach (ComponentSignalInstance* signal, mComponentSignals) {
+        signal->moveToNetSignal(netsignal); // can throw
+        sgl.add([signal, &other](){signal->moveToNetSignal(other);});
+    }
+    foreach (SI_NetPoint* netpoint, mSchematicNetPoints) {
+        netpoint->moveToNetSignal(netsignal); // can throw
+        sgl.add([netpoint, &other](){netpoint->moveToNetSignal(other);});
+    }
+    foreach (SI_NetLabel* netlabel, mSchematicNetLabels) {
+        netlabel->setNetSignal(netsignal);
+        sgl.add([netlabel, &other](){netlabel->setNetSignal(other);});
+    }
+    foreach (BI_NetPoint* netpoint, mBoardNetPoints) {
+        netpoint->moveToNetSignal(netsignal); // can throw
+        sgl.add([netpoint, &other](){netpoint->moveToNetSignal(other);});
+    }
+    foreach (BI_Via* via, mBoardVias) {
+        via->moveToNetSignal(netsignal); // can throw
+        sgl.add([via, &other](){via->moveToNetSignal(other);});
+    }
+    foreach (BI_Polygon* polygon, mBoardPolygons) {
+        polygon->setNetSignal(&netsignal); // can throw
+        sgl.add([polygon, &other](){polygon->setNetSignal(&other);});
+    }
+    sgl.dismiss();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
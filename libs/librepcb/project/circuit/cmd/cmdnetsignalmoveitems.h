@@ -0,0 +1,106 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_CMDNETSIGNALMOVEITEMS_H
+#define LIBREPCB_PROJECT_CMDNETSIGNALMOVEITEMS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommand.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class NetSignal;
+class ComponentSignalInstance;
+class SI_NetPoint;
+class SI_NetLabel;
+class BI_NetPoint;
+class BI_Via;
+class BI_Polygon;
+
+/*****************************************************************************************
+ *  Class CmdNetSignalMoveItems
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdNetSignalMoveItems class moves all items of a net signal to another one
+ *
+ * All component signals, netpoints, netlabels, vias and copper pours of the source net signal are
+ * re-registered at the destination net signal in one pass, without removing them from
+ * (and re-adding them to) their schematics and boards. Connected items (netlines, pins
+ * and pads) are only informed to update their connections. Airwires, copper pours and
+ * ERC messages are updated deferred, so every board and schematic is updated only once.
+ *
+ * Afterwards the source net signal is unused and can be removed.
+ */
+class CmdNetSignalMoveItems final : public UndoCommand
+{
+    public:
+
+        // Constructors / Destructor
+        CmdNetSignalMoveItems(NetSignal& from, NetSignal& to) noexcept;
+        ~CmdNetSignalMoveItems() noexcept;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+        void moveItems(NetSignal& netsignal);
+
+
+        // Private Member Variables
+
+        // Attributes from the constructor
+        NetSignal& mFrom;
+        NetSignal& mTo;
+
+        // Moved Items
+        QList<ComponentSignalInstance*> mComponentSignals;
+        QList<SI_NetPoint*> mSchematicNetPoints;
+        QList<SI_NetLabel*> mSchematicNetLabels;
+        QList<BI_NetPoint*> mBoardNetPoints;
+        QList<BI_Via*> mBoardVias;
+        QList<BI_Polygon*> mBoardPolygons;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDNETSIGNALMOVEITEMS_H
@@ -208,7 +208,7 @@ void ComponentInstance::setName(const QString& name)
         }
         mName = name;
         updateErcMessages();
-        emit attributesChanged();
+        notifyAttributesChanged();
     }
 }
 
@@ -216,7 +216,7 @@ void ComponentInstance::setValue(const QString& value) noexcept
 {
     if (value != mValue) {
         mValue = value;
-        emit attributesChanged();
+        notifyAttributesChanged();
     }
 }
 
@@ -224,7 +224,7 @@ void ComponentInstance::setAttributes(const AttributeList& attributes) noexcept
 {
     if (attributes != *mAttributes) {
         *mAttributes = attributes;
-        emit attributesChanged();
+        notifyAttributesChanged();
     }
 }
 
@@ -390,6 +390,16 @@ void ComponentInstance::updateErcMessages() noexcept
     mErcMsgUnplacedOptionalSymbols->setVisible((mIsAddedToCircuit) && (optional > 0));
 }
 
+void ComponentInstance::notifyAttributesChanged() noexcept
+{
+    // during bulk updates, the (expensive) text substitution is done only once at the end
+    if (mCircuit.isBulkUpdateActive()) {
+        mCircuit.scheduleAttributesChanged(*this);
+    } else {
+        emit attributesChanged();
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
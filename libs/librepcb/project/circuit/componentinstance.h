@@ -82,11 +82,31 @@ class ComponentInstance : public QObject, public IF_AttributeProvider,
         const library::Component& getLibComponent() const noexcept {return *mLibComponent;}
         const library::ComponentSymbolVariant& getSymbolVariant() const noexcept {return *mCompSymbVar;}
         ComponentSignalInstance* getSignalInstance(const Uuid& signalUuid) const noexcept {return mSignals.value(signalUuid);}
+        const QMap<Uuid, ComponentSignalInstance*>& getSignalInstances() const noexcept {return mSignals;}
         const AttributeList& getAttributes() const noexcept {return *mAttributes;}
 
         // Getters: General
         Circuit& getCircuit() const noexcept {return mCircuit;}
         int getPlacedSymbolsCount() const noexcept {return mRegisteredSymbols.count();}
+
+        /**
+         * @brief Get all placed symbols of this component (see #mRegisteredSymbols)
+         *
+         * This is the cross-reference between the circuit and the schematics which is
+         * maintained by #registerSymbol() and #unregisterSymbol(), so it can be used to
+         * find the symbols of a component without scanning all schematics.
+         *
+         * @return All registered symbols (all of them are in the same schematic)
+         */
+        const QHash<Uuid, SI_Symbol*>& getRegisteredSymbols() const noexcept {return mRegisteredSymbols;}
+
+        /**
+         * @brief Get all placed devices of this component (see #mRegisteredDevices)
+         *
+         * @return All registered devices (at most one per board)
+         */
+        const QList<BI_Device*>& getRegisteredDevices() const noexcept {return mRegisteredDevices;}
+
         int getUnplacedSymbolsCount() const noexcept;
         int getUnplacedRequiredSymbolsCount() const noexcept;
         int getUnplacedOptionalSymbolsCount() const noexcept;
@@ -153,6 +173,7 @@ class ComponentInstance : public QObject, public IF_AttributeProvider,
         void init();
         bool checkAttributesValidity() const noexcept;
         void updateErcMessages() noexcept;
+        void notifyAttributesChanged() noexcept;
 
 
         // General
@@ -32,6 +32,7 @@
 #include "../project.h"
 #include "../settings/projectsettings.h"
 #include "../schematics/items/si_symbolpin.h"
+#include "../boards/board.h"
 #include "../boards/items/bi_footprintpad.h"
 
 /*****************************************************************************************
@@ -177,11 +178,50 @@ void ComponentSignalInstance::setNetSignal(NetSignal* netsignal)
                       disconnect(netsignal, &NetSignal::nameChanged,
                       this, &ComponentSignalInstance::netSignalNameChanged);});
     }
+    foreach (BI_FootprintPad* pad, mRegisteredFootprintPads) {
+        pad->getBoard().scheduleAirWiresRebuild(mNetSignal);
+        pad->getBoard().scheduleAirWiresRebuild(netsignal);
+        pad->scheduleCopperPourRefill();
+    }
     mNetSignal = netsignal;
+    foreach (SI_SymbolPin* pin, mRegisteredSymbolPins) {
+        pin->netSignalMoved();
+    }
     updateErcMessages();
     sgl.dismiss();
 }
 
+void ComponentSignalInstance::moveToNetSignal(NetSignal& netsignal)
+{
+    if ((!mIsAddedToCircuit) || (!mNetSignal) || (netsignal.getCircuit() != mCircuit)) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    if (&netsignal == mNetSignal) {
+        return;
+    }
+    mNetSignal->unregisterComponentSignal(*this); // can throw
+    auto sg = scopeGuard([&](){mNetSignal->registerComponentSignal(*this);});
+    netsignal.registerComponentSignal(*this); // can throw
+    sg.dismiss();
+    disconnect(mNetSignal, &NetSignal::nameChanged,
+               this, &ComponentSignalInstance::netSignalNameChanged);
+    connect(&netsignal, &NetSignal::nameChanged,
+            this, &ComponentSignalInstance::netSignalNameChanged);
+    foreach (BI_FootprintPad* pad, mRegisteredFootprintPads) {
+        pad->getBoard().scheduleAirWiresRebuild(mNetSignal);
+        pad->getBoard().scheduleAirWiresRebuild(&netsignal);
+        pad->scheduleCopperPourRefill();
+    }
+    mNetSignal = &netsignal;
+    foreach (SI_SymbolPin* pin, mRegisteredSymbolPins) {
+        pin->netSignalMoved();
+    }
+    foreach (BI_FootprintPad* pad, mRegisteredFootprintPads) {
+        pad->netSignalMoved();
+    }
+    updateErcMessages();
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -276,6 +316,9 @@ bool ComponentSignalInstance::checkAttributesValidity() const noexcept
 void ComponentSignalInstance::netSignalNameChanged(const QString& newName) noexcept
 {
     Q_UNUSED(newName);
+    foreach (SI_SymbolPin* pin, mRegisteredSymbolPins) {
+        pin->netSignalRenamed();
+    }
     updateErcMessages();
 }
 
@@ -75,6 +75,7 @@ class ComponentSignalInstance final : public QObject, public IF_ErcMsgProvider,
 
         // Getters
         Circuit& getCircuit() const noexcept {return mCircuit;}
+        ComponentInstance& getComponentInstance() const noexcept {return mComponentInstance;}
         const library::ComponentSignal& getCompSignal() const noexcept {return *mComponentSignal;}
         NetSignal* getNetSignal() const noexcept {return mNetSignal;}
         bool isNetSignalNameForced() const noexcept;
@@ -100,6 +101,17 @@ class ComponentSignalInstance final : public QObject, public IF_ErcMsgProvider,
          */
         void setNetSignal(NetSignal* netsignal);
 
+        /**
+         * @brief Move the signal to another net signal, even if its pins/pads are used
+         *
+         * In contrast to #setNetSignal(), the attached items are not checked, so the
+         * caller has to move all items of the net signal at once (see
+         * librepcb::project::CmdNetSignalMoveItems).
+         *
+         * @throw Exception If the signal is not added or not connected to a net signal
+         */
+        void moveToNetSignal(NetSignal& netsignal);
+
 
         // General Methods
         void addToCircuit();
@@ -33,6 +33,17 @@
 namespace librepcb {
 namespace project {
 
+/**
+ * @brief Read an optional design rule (older projects don't contain the rules)
+ */
+static Length getRuleAttribute(const DomElement& domElement, const QString& name)
+{
+    if (!domElement.hasAttribute(name)) {
+        return Length(0);
+    }
+    return domElement.getAttribute<Length>(name, false, Length(0)); // can throw
+}
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -42,13 +53,18 @@ NetClass::NetClass(Circuit& circuit, const DomElement& domElement) :
 {
     mUuid = domElement.getAttribute<Uuid>("uuid", true);
     mName = domElement.getAttribute<QString>("name", true);
+    mTraceWidth = getRuleAttribute(domElement, "trace_width"); // can throw
+    mClearance = getRuleAttribute(domElement, "clearance"); // can throw
+    mViaSize = getRuleAttribute(domElement, "via_size"); // can throw
+    mViaDrillDiameter = getRuleAttribute(domElement, "via_drill"); // can throw
 
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 }
 
 NetClass::NetClass(Circuit& circuit, const QString& name) :
     QObject(&circuit), mCircuit(circuit), mIsAddedToCircuit(false),
-    mUuid(Uuid::createRandom()), mName(name)
+    mUuid(Uuid::createRandom()), mName(name), mTraceWidth(0), mClearance(0), mViaSize(0),
+    mViaDrillDiameter(0)
 {
     if (mName.isEmpty()) {
         throw RuntimeError(__FILE__, __LINE__,
@@ -134,6 +150,10 @@ void NetClass::serialize(DomElement& root) const
 
     root.setAttribute("uuid", mUuid);
     root.setAttribute("name", mName);
+    root.setAttribute("trace_width", mTraceWidth);
+    root.setAttribute("clearance", mClearance);
+    root.setAttribute("via_size", mViaSize);
+    root.setAttribute("via_drill", mViaDrillDiameter);
 }
 
 /*****************************************************************************************
@@ -144,6 +164,10 @@ bool NetClass::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())     return false;
     if (mName.isEmpty())    return false;
+    if (mTraceWidth < 0)    return false;
+    if (mClearance < 0)     return false;
+    if (mViaSize < 0)       return false;
+    if (mViaDrillDiameter < 0) return false;
     return true;
 }
 
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "../erc/if_ercmsgprovider.h"
 #include <librepcb/common/uuid.h>
+#include <librepcb/common/units/length.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/exceptions.h>
 
@@ -45,6 +46,11 @@ class ErcMsg;
 
 /**
  * @brief The NetClass class
+ *
+ * Besides the name, a net class can override some design rules for all of its net
+ * signals (trace width, clearance and via dimensions). A length of zero means that the
+ * net class does not override the rule, i.e. the board's librepcb::BoardDesignRules
+ * apply. Use librepcb::project::BoardRuleTable to get the resolved rules of a board.
  */
 class NetClass final : public QObject, public IF_ErcMsgProvider,
                        public SerializableObject
@@ -65,11 +71,19 @@ class NetClass final : public QObject, public IF_ErcMsgProvider,
         Circuit& getCircuit() const noexcept {return mCircuit;}
         const Uuid& getUuid() const noexcept {return mUuid;}
         const QString& getName() const noexcept {return mName;}
+        const Length& getTraceWidth() const noexcept {return mTraceWidth;}
+        const Length& getClearance() const noexcept {return mClearance;}
+        const Length& getViaSize() const noexcept {return mViaSize;}
+        const Length& getViaDrillDiameter() const noexcept {return mViaDrillDiameter;}
         int getNetSignalCount() const noexcept {return mRegisteredNetSignals.count();}
         bool isUsed() const noexcept {return (getNetSignalCount() > 0);}
 
         // Setters
         void setName(const QString& name);
+        void setTraceWidth(const Length& width) noexcept {if (width >= 0) mTraceWidth = width;}
+        void setClearance(const Length& clearance) noexcept {if (clearance >= 0) mClearance = clearance;}
+        void setViaSize(const Length& size) noexcept {if (size >= 0) mViaSize = size;}
+        void setViaDrillDiameter(const Length& dia) noexcept {if (dia >= 0) mViaDrillDiameter = dia;}
 
         // General Methods
         void addToCircuit();
@@ -97,6 +111,12 @@ class NetClass final : public QObject, public IF_ErcMsgProvider,
         Uuid mUuid;
         QString mName;
 
+        // Design Rules (zero = use the rules of the board)
+        Length mTraceWidth;         ///< default width of new traces
+        Length mClearance;          ///< min. copper clearance to other net signals
+        Length mViaSize;            ///< default outer diameter of new vias
+        Length mViaDrillDiameter;   ///< default drill diameter of new vias
+
         // Registered Elements
         /// @brief all registered netsignals
         QHash<Uuid, NetSignal*> mRegisteredNetSignals;
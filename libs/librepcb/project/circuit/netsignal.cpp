@@ -29,8 +29,11 @@
 #include "componentsignalinstance.h"
 #include "../schematics/items/si_netlabel.h"
 #include "../schematics/items/si_netpoint.h"
+#include "../schematics/items/si_netline.h"
 #include "../boards/items/bi_netpoint.h"
+#include "../boards/items/bi_netline.h"
 #include "../boards/items/bi_via.h"
+#include "../boards/items/bi_polygon.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -85,6 +88,7 @@ int NetSignal::getRegisteredElementsCount() const noexcept
     count += mRegisteredSchematicNetLabels.count();
     count += mRegisteredBoardNetPoints.count();
     count += mRegisteredBoardVias.count();
+    count += mRegisteredBoardPolygons.count();
     return count;
 }
 
@@ -95,7 +99,7 @@ bool NetSignal::isUsed() const noexcept
 
 bool NetSignal::isNameForced() const noexcept
 {
-    foreach (const ComponentSignalInstance* cmp, mRegisteredComponentSignals) {
+    foreach (const ComponentSignalInstance* cmp, mRegisteredComponentSignals.toList()) {
         if (cmp->isNetSignalNameForced()) {
             return true;
         }
@@ -126,6 +130,22 @@ void NetSignal::setHighlighted(bool hl) noexcept
 {
     if (hl != mIsHighlighted) {
         mIsHighlighted = hl;
+        // the items are not connected to the signal to save one connection per item
+        foreach (SI_NetPoint* netpoint, mRegisteredSchematicNetPoints.toList()) {
+            netpoint->netSignalHighlightChanged();
+            foreach (SI_NetLine* netline, netpoint->getLines()) {
+                netline->netSignalHighlightChanged();
+            }
+        }
+        foreach (BI_NetPoint* netpoint, mRegisteredBoardNetPoints.toList()) {
+            netpoint->netSignalHighlightChanged();
+            foreach (BI_NetLine* netline, netpoint->getLines()) {
+                netline->netSignalHighlightChanged();
+            }
+        }
+        foreach (BI_Via* via, mRegisteredBoardVias.toList()) {
+            via->netSignalHighlightChanged();
+        }
         emit highlightedChanged(mIsHighlighted);
     }
 }
@@ -166,7 +186,7 @@ void NetSignal::registerComponentSignal(ComponentSignalInstance& signal)
     {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredComponentSignals.append(&signal);
+    mRegisteredComponentSignals.insert(&signal);
     updateErcMessages();
 }
 
@@ -175,7 +195,7 @@ void NetSignal::unregisterComponentSignal(ComponentSignalInstance& signal)
     if ((!mIsAddedToCircuit) || (!mRegisteredComponentSignals.contains(&signal))) {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredComponentSignals.removeOne(&signal);
+    mRegisteredComponentSignals.remove(&signal);
     updateErcMessages();
 }
 
@@ -186,7 +206,7 @@ void NetSignal::registerSchematicNetPoint(SI_NetPoint& netpoint)
     {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredSchematicNetPoints.append(&netpoint);
+    mRegisteredSchematicNetPoints.insert(&netpoint);
     updateErcMessages();
 }
 
@@ -195,7 +215,7 @@ void NetSignal::unregisterSchematicNetPoint(SI_NetPoint& netpoint)
     if ((!mIsAddedToCircuit) || (!mRegisteredSchematicNetPoints.contains(&netpoint))) {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredSchematicNetPoints.removeOne(&netpoint);
+    mRegisteredSchematicNetPoints.remove(&netpoint);
     updateErcMessages();
 }
 
@@ -206,7 +226,7 @@ void NetSignal::registerSchematicNetLabel(SI_NetLabel& netlabel)
     {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredSchematicNetLabels.append(&netlabel);
+    mRegisteredSchematicNetLabels.insert(&netlabel);
     updateErcMessages();
 }
 
@@ -215,7 +235,7 @@ void NetSignal::unregisterSchematicNetLabel(SI_NetLabel& netlabel)
     if ((!mIsAddedToCircuit) || (!mRegisteredSchematicNetLabels.contains(&netlabel))) {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredSchematicNetLabels.removeOne(&netlabel);
+    mRegisteredSchematicNetLabels.remove(&netlabel);
     updateErcMessages();
 }
 
@@ -226,7 +246,7 @@ void NetSignal::registerBoardNetPoint(BI_NetPoint& netpoint)
     {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredBoardNetPoints.append(&netpoint);
+    mRegisteredBoardNetPoints.insert(&netpoint);
     updateErcMessages();
 }
 
@@ -235,7 +255,7 @@ void NetSignal::unregisterBoardNetPoint(BI_NetPoint& netpoint)
     if ((!mIsAddedToCircuit) || (!mRegisteredBoardNetPoints.contains(&netpoint))) {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredBoardNetPoints.removeOne(&netpoint);
+    mRegisteredBoardNetPoints.remove(&netpoint);
     updateErcMessages();
 }
 
@@ -246,7 +266,7 @@ void NetSignal::registerBoardVia(BI_Via& via)
     {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredBoardVias.append(&via);
+    mRegisteredBoardVias.insert(&via);
     updateErcMessages();
 }
 
@@ -255,34 +275,37 @@ void NetSignal::unregisterBoardVia(BI_Via& via)
     if ((!mIsAddedToCircuit) || (!mRegisteredBoardVias.contains(&via))) {
         throw LogicError(__FILE__, __LINE__);
     }
-    mRegisteredBoardVias.removeOne(&via);
+    mRegisteredBoardVias.remove(&via);
     updateErcMessages();
 }
 
-void NetSignal::serialize(DomElement& root) const
+void NetSignal::registerBoardPolygon(BI_Polygon& polygon)
 {
-    if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
-
-    root.setAttribute("uuid", mUuid);
-    root.setAttribute("name", mName);
-    root.setAttribute("auto_name", mHasAutoName);
-    root.setAttribute("netclass", mNetClass->getUuid());
+    if ((!mIsAddedToCircuit) || (mRegisteredBoardPolygons.contains(&polygon))
+        || (polygon.getCircuit() != mCircuit))
+    {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    mRegisteredBoardPolygons.insert(&polygon);
+    updateErcMessages();
 }
 
-/*****************************************************************************************
- *  Private Methods
- ****************************************************************************************/
-
-bool NetSignal::checkAttributesValidity() const noexcept
+void NetSignal::unregisterBoardPolygon(BI_Polygon& polygon)
 {
-    if (mUuid.isNull())         return false;
-    if (mName.isEmpty())        return false;
-    if (mNetClass == nullptr)   return false;
-    return true;
+    if ((!mIsAddedToCircuit) || (!mRegisteredBoardPolygons.contains(&polygon))) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    mRegisteredBoardPolygons.remove(&polygon);
+    updateErcMessages();
 }
 
 void NetSignal::updateErcMessages() noexcept
 {
+    if (mCircuit.isBulkUpdateActive()) {
+        mCircuit.scheduleErcMessagesUpdate(*this);
+        return;
+    }
+
     if (mIsAddedToCircuit && (!isUsed())) {
         if (!mErcMsgUnusedNetSignal) {
             mErcMsgUnusedNetSignal.reset(new ErcMsg(mCircuit.getProject(), *this,
@@ -309,6 +332,28 @@ void NetSignal::updateErcMessages() noexcept
     }
 }
 
+void NetSignal::serialize(DomElement& root) const
+{
+    if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
+
+    root.setAttribute("uuid", mUuid);
+    root.setAttribute("name", mName);
+    root.setAttribute("auto_name", mHasAutoName);
+    root.setAttribute("netclass", mNetClass->getUuid());
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool NetSignal::checkAttributesValidity() const noexcept
+{
+    if (mUuid.isNull())         return false;
+    if (mName.isEmpty())        return false;
+    if (mNetClass == nullptr)   return false;
+    return true;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
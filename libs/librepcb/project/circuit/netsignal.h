@@ -28,6 +28,7 @@
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/orderedset.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -42,6 +43,7 @@ class SI_NetPoint;
 class SI_NetLabel;
 class BI_NetPoint;
 class BI_Via;
+class BI_Polygon;
 class ErcMsg;
 
 /*****************************************************************************************
@@ -75,11 +77,12 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public Seriali
 
         // Getters: General
         Circuit& getCircuit() const noexcept {return mCircuit;}
-        const QList<ComponentSignalInstance*>& getComponentSignals() const noexcept {return mRegisteredComponentSignals;}
-        const QList<SI_NetPoint*>& getSchematicNetPoints() const noexcept {return mRegisteredSchematicNetPoints;}
-        const QList<SI_NetLabel*>& getSchematicNetLabels() const noexcept {return mRegisteredSchematicNetLabels;}
-        const QList<BI_NetPoint*>& getBoardNetPoints() const noexcept {return mRegisteredBoardNetPoints;}
-        const QList<BI_Via*>& getBoardVias() const noexcept {return mRegisteredBoardVias;}
+        QList<ComponentSignalInstance*> getComponentSignals() const noexcept {return mRegisteredComponentSignals.toList();}
+        QList<SI_NetPoint*> getSchematicNetPoints() const noexcept {return mRegisteredSchematicNetPoints.toList();}
+        QList<SI_NetLabel*> getSchematicNetLabels() const noexcept {return mRegisteredSchematicNetLabels.toList();}
+        QList<BI_NetPoint*> getBoardNetPoints() const noexcept {return mRegisteredBoardNetPoints.toList();}
+        QList<BI_Via*> getBoardVias() const noexcept {return mRegisteredBoardVias.toList();}
+        QList<BI_Polygon*> getBoardPolygons() const noexcept {return mRegisteredBoardPolygons.toList();}
         int getRegisteredElementsCount() const noexcept;
         bool isUsed() const noexcept;
         bool isNameForced() const noexcept;
@@ -101,6 +104,17 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public Seriali
         void unregisterBoardNetPoint(BI_NetPoint& netpoint);
         void registerBoardVia(BI_Via& via);
         void unregisterBoardVia(BI_Via& via);
+        void registerBoardPolygon(BI_Polygon& polygon);
+        void unregisterBoardPolygon(BI_Polygon& polygon);
+
+        /**
+         * @brief Update the ERC messages of this net signal
+         *
+         * If a bulk update of the circuit is active (see
+         * librepcb::project::Circuit::beginBulkUpdate()), the update is postponed until
+         * the bulk update has ended.
+         */
+        void updateErcMessages() noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
@@ -117,7 +131,6 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public Seriali
 
     private:
         bool checkAttributesValidity() const noexcept;
-        void updateErcMessages() noexcept;
 
 
         // General
@@ -131,12 +144,13 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public Seriali
         bool mHasAutoName;
         NetClass* mNetClass;
 
-        // Registered Elements of this NetSignal
-        QList<ComponentSignalInstance*> mRegisteredComponentSignals;
-        QList<SI_NetPoint*> mRegisteredSchematicNetPoints;
-        QList<SI_NetLabel*> mRegisteredSchematicNetLabels;
-        QList<BI_NetPoint*> mRegisteredBoardNetPoints;
-        QList<BI_Via*> mRegisteredBoardVias;
+        // Registered Elements of this NetSignal (sets for fast (un)registering of many items)
+        OrderedSet<ComponentSignalInstance*> mRegisteredComponentSignals;
+        OrderedSet<SI_NetPoint*> mRegisteredSchematicNetPoints;
+        OrderedSet<SI_NetLabel*> mRegisteredSchematicNetLabels;
+        OrderedSet<BI_NetPoint*> mRegisteredBoardNetPoints;
+        OrderedSet<BI_Via*> mRegisteredBoardVias;
+        OrderedSet<BI_Polygon*> mRegisteredBoardPolygons;
 
         // ERC Messages
         /// @brief the ERC message for unused netsignals
@@ -48,6 +48,10 @@ ErcMsgList::ErcMsgList(Project& project, bool restore, bool readOnly, bool creat
     } else {
         mXmlFile.reset(new SmartXmlFile(mXmlFilepath, restore, readOnly));
     }
+
+    mEmitTimer.setSingleShot(true);
+    mEmitTimer.setInterval(50);
+    connect(&mEmitTimer, &QTimer::timeout, this, &ErcMsgList::emitPendingChanges);
 }
 
 ErcMsgList::~ErcMsgList() noexcept
@@ -65,7 +69,13 @@ void ErcMsgList::add(ErcMsg* ercMsg) noexcept
     Q_ASSERT(!mItems.contains(ercMsg));
     Q_ASSERT(!ercMsg->isIgnored());
     mItems.append(ercMsg);
-    emit ercMsgAdded(ercMsg);
+    if (mPendingRemoved.removeOne(ercMsg)) {
+        // removed and added again (or a new message at the same address)
+        if (!mPendingChanged.contains(ercMsg)) mPendingChanged.append(ercMsg);
+    } else {
+        mPendingAdded.append(ercMsg);
+    }
+    if (!mEmitTimer.isActive()) mEmitTimer.start();
 }
 
 void ErcMsgList::remove(ErcMsg* ercMsg) noexcept
@@ -74,7 +84,11 @@ void ErcMsgList::remove(ErcMsg* ercMsg) noexcept
     Q_ASSERT(mItems.contains(ercMsg));
     Q_ASSERT(!ercMsg->isIgnored());
     mItems.removeOne(ercMsg);
-    emit ercMsgRemoved(ercMsg);
+    mPendingChanged.removeOne(ercMsg);
+    if (!mPendingAdded.removeOne(ercMsg)) {
+        mPendingRemoved.append(ercMsg); // was already reported as added
+    }
+    if (!mEmitTimer.isActive()) mEmitTimer.start();
 }
 
 void ErcMsgList::update(ErcMsg* ercMsg) noexcept
@@ -82,7 +96,10 @@ void ErcMsgList::update(ErcMsg* ercMsg) noexcept
     Q_ASSERT(ercMsg);
     Q_ASSERT(mItems.contains(ercMsg));
     Q_ASSERT(ercMsg->isVisible());
-    emit ercMsgChanged(ercMsg);
+    if ((!mPendingAdded.contains(ercMsg)) && (!mPendingChanged.contains(ercMsg))) {
+        mPendingChanged.append(ercMsg);
+    }
+    if (!mEmitTimer.isActive()) mEmitTimer.start();
 }
 
 void ErcMsgList::restoreIgnoreState()
@@ -128,6 +145,21 @@ bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void ErcMsgList::emitPendingChanges() noexcept
+{
+    QList<ErcMsg*> added, removed, changed;
+    added.swap(mPendingAdded);
+    removed.swap(mPendingRemoved);
+    changed.swap(mPendingChanged);
+    if ((!added.isEmpty()) || (!removed.isEmpty()) || (!changed.isEmpty())) {
+        emit ercMsgsChanged(added, removed, changed);
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -75,9 +75,25 @@ class ErcMsgList final : public QObject, public SerializableObject
 
     signals:
 
-        void ercMsgAdded(ErcMsg* ercMsg);
-        void ercMsgRemoved(ErcMsg* ercMsg);
-        void ercMsgChanged(ErcMsg* ercMsg);
+        /**
+         * @brief The list of ERC messages has changed
+         *
+         * To keep editing fast, the changes are not reported immediately but collected
+         * and emitted with a short delay as one batch. Messages which were added and
+         * removed again in the meantime are not reported at all.
+         *
+         * @param added     Messages which were added since the last emit
+         * @param removed   Messages which were removed since the last emit. They may
+         *                  already be deleted, so only use the pointers as keys!
+         * @param changed   Messages whose text or ignore state has changed
+         */
+        void ercMsgsChanged(const QList<ErcMsg*>& added, const QList<ErcMsg*>& removed,
+                            const QList<ErcMsg*>& changed);
+
+
+    private slots:
+
+        void emitPendingChanges() noexcept;
 
 
     private: // Methods
@@ -95,6 +111,10 @@ class ErcMsgList final : public QObject, public SerializableObject
 
         // Misc
         QList<ErcMsg*> mItems; ///< contains all visible ERC messages
+        QList<ErcMsg*> mPendingAdded; ///< not yet emitted, see #ercMsgsChanged()
+        QList<ErcMsg*> mPendingRemoved; ///< not yet emitted, see #ercMsgsChanged()
+        QList<ErcMsg*> mPendingChanged; ///< not yet emitted, see #ercMsgsChanged()
+        QTimer mEmitTimer;
 };
 
 /*****************************************************************************************
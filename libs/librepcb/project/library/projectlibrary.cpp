@@ -25,12 +25,14 @@
 #include "projectlibrary.h"
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sharedfilestore.h>
 #include "../project.h"
 #include <librepcb/library/sym/symbol.h>
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/dev/device.h>
 #include <librepcb/common/application.h>
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -40,13 +42,57 @@ namespace project {
 
 using namespace library;
 
+/*****************************************************************************************
+ *  Class ProjectLibrary::ElementLoader
+ ****************************************************************************************/
+
+/**
+ * @brief Loads a single library element in a thread pool worker
+ *
+ * Exceptions are not propagated to the thread pool, they are stored and rethrown by
+ * #takeElement() instead (which must not be called until the pool has finished).
+ */
+template <typename ElementType>
+class ProjectLibrary::ElementLoader final : public QRunnable
+{
+    public:
+        explicit ElementLoader(const FilePath& directory) noexcept :
+            mDirectory(directory), mMainThread(QThread::currentThread())
+        {
+            setAutoDelete(false);
+        }
+
+        void run() noexcept override
+        {
+            try {
+                mElement.reset(new ElementType(mDirectory, false)); // can throw
+                mElement->moveToThread(mMainThread);
+            } catch (const Exception& e) {
+                mError.reset(e.clone());
+            }
+        }
+
+        ElementType* takeElement()
+        {
+            if (mError) mError->raise();
+            return mElement.take();
+        }
+
+    private:
+        FilePath mDirectory;
+        QThread* mMainThread;
+        QScopedPointer<ElementType> mElement;
+        QScopedPointer<Exception> mError;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 ProjectLibrary::ProjectLibrary(Project& project, bool restore, bool readOnly) :
     QObject(&project), mProject(project),
-    mLibraryPath(project.getPath().getPathTo("library"))
+    mLibraryPath(project.getPath().getPathTo("library")), mSharedFileStore(nullptr),
+    mDeviceIndexesBuilt(false)
 {
     qDebug() << "load project library...";
 
@@ -74,6 +120,7 @@ ProjectLibrary::ProjectLibrary(Project& project, bool restore, bool readOnly) :
         throw; // ...and rethrow the exception
     }
 
+    mSyncDateTime = QDateTime::currentDateTime();
     qDebug() << "project library successfully loaded!";
 }
 
@@ -122,13 +169,14 @@ Device* ProjectLibrary::getDevice(const Uuid& uuid) const noexcept
 
 QHash<Uuid, library::Device*> ProjectLibrary::getDevicesOfComponent(const Uuid& compUuid) const noexcept
 {
-    QHash<Uuid, library::Device*> list;
-    foreach (library::Device* device, mDevices)
-    {
-        if (device->getComponentUuid() == compUuid)
-            list.insert(device->getUuid(), device);
-    }
-    return list;
+    buildDeviceIndexes();
+    return getIndexedDevices(mDevicesByComponent, compUuid);
+}
+
+QHash<Uuid, library::Device*> ProjectLibrary::getDevicesOfPackage(const Uuid& pkgUuid) const noexcept
+{
+    buildDeviceIndexes();
+    return getIndexedDevices(mDevicesByPackage, pkgUuid);
 }
 
 /*****************************************************************************************
@@ -153,6 +201,7 @@ void ProjectLibrary::addComponent(library::Component& c)
 void ProjectLibrary::addDevice(library::Device& d)
 {
     addElement<Device>(d, mDevices, mAddedDevices, mRemovedDevices);
+    addDeviceToIndexes(d);
 }
 
 void ProjectLibrary::removeSymbol(library::Symbol& s)
@@ -173,6 +222,7 @@ void ProjectLibrary::removeComponent(library::Component& c)
 void ProjectLibrary::removeDevice(library::Device& d)
 {
     removeElement<Device>(d, mDevices, mAddedDevices, mRemovedDevices);
+    removeDeviceFromIndexes(d);
 }
 
 
@@ -180,27 +230,105 @@ void ProjectLibrary::removeDevice(library::Device& d)
  *  General Methods
  ****************************************************************************************/
 
+void ProjectLibrary::addToMemoryReport(MemoryReport& parent) const noexcept
+{
+    MemoryReport& report = parent.addChild("Library", sizeof(ProjectLibrary));
+    addElementsToMemoryReport(report, "Symbols", mSymbols);
+    addElementsToMemoryReport(report, "Packages", mPackages);
+    addElementsToMemoryReport(report, "Components", mComponents);
+    addElementsToMemoryReport(report, "Devices", mDevices);
+}
+
 bool ProjectLibrary::save(bool toOriginal, QStringList& errors) noexcept
 {
     bool success = true;
 
     // Save all elements
-    if (!saveElements<Symbol>(toOriginal, errors, mLibraryPath.getPathTo("sym"), mSymbols, mAddedSymbols, mRemovedSymbols))
+    if (!saveElements<Symbol>(toOriginal, errors, mLibraryPath.getPathTo("sym"), mAddedSymbols, mRemovedSymbols))
         success = false;
-    if (!saveElements<Package>(toOriginal, errors, mLibraryPath.getPathTo("pkg"), mPackages, mAddedPackages, mRemovedPackages))
+    if (!saveElements<Package>(toOriginal, errors, mLibraryPath.getPathTo("pkg"), mAddedPackages, mRemovedPackages))
         success = false;
-    if (!saveElements<Component>(toOriginal, errors, mLibraryPath.getPathTo("cmp"), mComponents, mAddedComponents, mRemovedComponents))
+    if (!saveElements<Component>(toOriginal, errors, mLibraryPath.getPathTo("cmp"), mAddedComponents, mRemovedComponents))
         success = false;
-    if (!saveElements<Device>(toOriginal, errors, mLibraryPath.getPathTo("dev"), mDevices, mAddedDevices, mRemovedDevices))
+    if (!saveElements<Device>(toOriginal, errors, mLibraryPath.getPathTo("dev"), mAddedDevices, mRemovedDevices))
         success = false;
 
+    // Share identical elements with other projects
+    if (toOriginal && mSharedFileStore) {
+        shareElements(mSymbols);
+        shareElements(mPackages);
+        shareElements(mComponents);
+        shareElements(mDevices);
+    }
+
+    if (toOriginal && success) {
+        mSyncDateTime = QDateTime::currentDateTime();
+    }
     return success;
 }
 
+bool ProjectLibrary::isModifiedOnDisk() const noexcept
+{
+    if ((!mAddedSymbols.isEmpty()) || (!mAddedPackages.isEmpty()) ||
+        (!mAddedComponents.isEmpty()) || (!mAddedDevices.isEmpty()) ||
+        (!mRemovedSymbols.isEmpty()) || (!mRemovedPackages.isEmpty()) ||
+        (!mRemovedComponents.isEmpty()) || (!mRemovedDevices.isEmpty())) {
+        return true;
+    }
+    // directories are included since their modification time changes if entries are
+    // added or removed
+    if (QFileInfo(mLibraryPath.toStr()).lastModified() > mSyncDateTime) {
+        return true;
+    }
+    QDirIterator it(mLibraryPath.toStr(), QDir::AllEntries | QDir::Hidden |
+                    QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        if (it.fileInfo().lastModified() > mSyncDateTime) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void ProjectLibrary::buildDeviceIndexes() const noexcept
+{
+    if (mDeviceIndexesBuilt) return;
+    foreach (library::Device* device, mDevices) {
+        mDevicesByComponent.insert(device->getComponentUuid(), device);
+        mDevicesByPackage.insert(device->getPackageUuid(), device);
+    }
+    mDeviceIndexesBuilt = true;
+}
+
+void ProjectLibrary::addDeviceToIndexes(library::Device& device) noexcept
+{
+    if (!mDeviceIndexesBuilt) return; // will be added when building the indexes
+    mDevicesByComponent.insert(device.getComponentUuid(), &device);
+    mDevicesByPackage.insert(device.getPackageUuid(), &device);
+}
+
+void ProjectLibrary::removeDeviceFromIndexes(library::Device& device) noexcept
+{
+    if (!mDeviceIndexesBuilt) return;
+    mDevicesByComponent.remove(device.getComponentUuid(), &device);
+    mDevicesByPackage.remove(device.getPackageUuid(), &device);
+}
+
+QHash<Uuid, library::Device*> ProjectLibrary::getIndexedDevices(
+    const QMultiHash<Uuid, library::Device*>& index, const Uuid& uuid) noexcept
+{
+    QHash<Uuid, library::Device*> list;
+    for (auto it = index.constFind(uuid); (it != index.constEnd()) && (it.key() == uuid); ++it) {
+        list.insert(it.value()->getUuid(), it.value());
+    }
+    return list;
+}
+
 template <typename ElementType>
 void ProjectLibrary::loadElements(const FilePath& directory, const QString& type,
                                   QHash<Uuid, ElementType*>& elementList)
@@ -210,6 +338,8 @@ void ProjectLibrary::loadElements(const FilePath& directory, const QString& type
     // search all subdirectories which have a valid UUID as directory name
     dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Readable);
     dir.setNameFilters(QStringList() << QString("*.%1").arg(directory.getBasename()));
+    std::vector<std::unique_ptr<ElementLoader<ElementType>>> loaders;
+    QThreadPool pool;
     foreach (const QString& dirname, dir.entryList())
     {
         FilePath subdirPath(directory.getPathTo(dirname));
@@ -225,16 +355,25 @@ void ProjectLibrary::loadElements(const FilePath& directory, const QString& type
             continue;
         }
 
-        // load the library element --> an exception will be thrown on error
-        ElementType* element = new ElementType(subdirPath, false);
+        // load the library element in parallel with all the others
+        loaders.emplace_back(new ElementLoader<ElementType>(subdirPath));
+        pool.start(loaders.back().get());
+    }
+    pool.waitForDone();
+
+    for (const auto& loader : loaders)
+    {
+        // an exception will be thrown if loading the element has failed
+        QScopedPointer<ElementType> element(loader->takeElement());
 
         if (elementList.contains(element->getUuid())) {
             throw RuntimeError(__FILE__, __LINE__,
                 QString(tr("There are multiple library elements with the same "
-                "UUID in the directory \"%1\"")).arg(subdirPath.toNative()));
+                "UUID in the directory \"%1\"")).arg(element->getFilePath().toNative()));
         }
 
-        elementList.insert(element->getUuid(), element);
+        Uuid uuid = element->getUuid();
+        elementList.insert(uuid, element.take());
     }
 
     qDebug() << "successfully loaded" << elementList.count() << qPrintable(type);
@@ -275,7 +414,6 @@ void ProjectLibrary::removeElement(ElementType& element,
 
 template <typename ElementType>
 bool ProjectLibrary::saveElements(bool toOriginal, QStringList& errors, const FilePath& parentDir,
-                                  QHash<Uuid, ElementType*>& elementList,
                                   QList<ElementType*>& addedElementsList,
                                   QList<ElementType*>& removedElementsList) noexcept
 {
@@ -295,12 +433,15 @@ bool ProjectLibrary::saveElements(bool toOriginal, QStringList& errors, const Fi
         }
     }
 
-    foreach (ElementType* element, elementList) {
+    // Elements are never modified in the project library, so only the elements added
+    // since the last save need to be moved into the library directory. All others are
+    // already there and are not touched at all. Note: foreach() iterates over a copy.
+    foreach (ElementType* element, addedElementsList) {
         try {
             if (element->getFilePath().getParentDir().getParentDir() != mLibraryPath) {
                 element->moveIntoParentDirectory(parentDir);
             }
-            if (toOriginal && addedElementsList.contains(element))
+            if (toOriginal)
                 addedElementsList.removeOne(element);
         }
         catch (Exception& e) {
@@ -312,6 +453,23 @@ bool ProjectLibrary::saveElements(bool toOriginal, QStringList& errors, const Fi
     return success;
 }
 
+template <typename ElementType>
+void ProjectLibrary::shareElements(const QHash<Uuid, ElementType*>& elementList) noexcept
+{
+    qint64 sharedBytes = 0;
+    foreach (const ElementType* element, elementList) {
+        const FilePath& dir = element->getFilePath();
+        if ((!mSharedElementDirs.contains(dir)) &&
+            (dir.getParentDir().getParentDir() == mLibraryPath)) {
+            sharedBytes += mSharedFileStore->shareDirectory(dir);
+            mSharedElementDirs.insert(dir);
+        }
+    }
+    if (sharedBytes > 0) {
+        qDebug() << "Project library:" << sharedBytes << "bytes shared with other projects";
+    }
+}
+
 template <typename ElementType>
 void ProjectLibrary::cleanupElements(QList<ElementType*>& addedElementsList,
                                      QList<ElementType*>& removedElementsList) noexcept
@@ -328,6 +486,17 @@ void ProjectLibrary::cleanupElements(QList<ElementType*>& addedElementsList,
     qDeleteAll(removedElementsList);        removedElementsList.clear();
 }
 
+template <typename ElementType>
+void ProjectLibrary::addElementsToMemoryReport(MemoryReport& parent, const QString& name,
+    const QHash<Uuid, ElementType*>& elementList) noexcept
+{
+    qint64 bytes = 0;
+    foreach (const ElementType* element, elementList) {
+        bytes += element->getApproximateMemoryUsage();
+    }
+    parent.addChild(name, bytes, elementList.count());
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -33,6 +33,9 @@
  ****************************************************************************************/
 namespace librepcb {
 
+class MemoryReport;
+class SharedFileStore;
+
 namespace library {
 class Symbol;
 class Package;
@@ -76,6 +79,7 @@ class ProjectLibrary final : public QObject
 
         // Getters: Special Queries
         QHash<Uuid, library::Device*> getDevicesOfComponent(const Uuid& compUuid) const noexcept;
+        QHash<Uuid, library::Device*> getDevicesOfPackage(const Uuid& pkgUuid) const noexcept;
 
 
         // Add/Remove Methods
@@ -89,12 +93,47 @@ class ProjectLibrary final : public QObject
         void removeDevice(library::Device& d);
 
 
+        // Setters
+
+        /**
+         * @brief Share the files of all elements with other projects
+         *
+         * If set, the files of all elements are replaced by hard links into the store
+         * when saving to the original files (see librepcb::SharedFileStore). Every
+         * element is shared only once, i.e. the first save shares all elements and
+         * subsequent saves only the newly added ones.
+         *
+         * @param store     The store (must outlive this object), or nullptr to disable
+         */
+        void setSharedFileStore(SharedFileStore* store) noexcept {mSharedFileStore = store;}
+
         // General Methods
         bool save(bool toOriginal, QStringList& errors) noexcept;
 
+        /**
+         * @brief Check whether the library differs from the files on the disk
+         *
+         * This is the case if elements were added or removed in the project since the
+         * last save, or if files of the library directory were added, removed or modified
+         * since they were loaded or saved (e.g. by checking out another git branch). The
+         * latter is detected by the modification times, so no files need to be read.
+         *
+         * @return true if the library would need to be reloaded to match the disk
+         */
+        bool isModifiedOnDisk() const noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of all library elements to a report
+         */
+        void addToMemoryReport(MemoryReport& parent) const noexcept;
+
 
     private:
 
+        // Types
+        template <typename ElementType>
+        class ElementLoader;
+
         // make some methods inaccessible...
         ProjectLibrary();
         ProjectLibrary(const ProjectLibrary& other);
@@ -116,16 +155,28 @@ class ProjectLibrary final : public QObject
                            QList<ElementType*>& removedElementsList);
         template <typename ElementType>
         bool saveElements(bool toOriginal, QStringList& errors, const FilePath& parentDir,
-                          QHash<Uuid, ElementType*>& elementList,
                           QList<ElementType*>& addedElementsList,
                           QList<ElementType*>& removedElementsList) noexcept;
         template <typename ElementType>
+        void shareElements(const QHash<Uuid, ElementType*>& elementList) noexcept;
+        template <typename ElementType>
         void cleanupElements(QList<ElementType*>& addedElementsList,
                              QList<ElementType*>& removedElementsList) noexcept;
+        void buildDeviceIndexes() const noexcept;
+        void addDeviceToIndexes(library::Device& device) noexcept;
+        void removeDeviceFromIndexes(library::Device& device) noexcept;
+        static QHash<Uuid, library::Device*> getIndexedDevices(
+            const QMultiHash<Uuid, library::Device*>& index, const Uuid& uuid) noexcept;
+        template <typename ElementType>
+        static void addElementsToMemoryReport(MemoryReport& parent, const QString& name,
+                                              const QHash<Uuid, ElementType*>& elementList) noexcept;
 
         // General
         Project& mProject; ///< a reference to the Project object (from the ctor)
         FilePath mLibraryPath; ///< the "library" directory of the project
+        SharedFileStore* mSharedFileStore; ///< see #setSharedFileStore() (may be nullptr)
+        QSet<FilePath> mSharedElementDirs; ///< elements already added to #mSharedFileStore
+        QDateTime mSyncDateTime; ///< time of the last load or save (see #isModifiedOnDisk())
 
         // The Library Elements
         QHash<Uuid, library::Symbol*> mSymbols;
@@ -133,6 +184,11 @@ class ProjectLibrary final : public QObject
         QHash<Uuid, library::Component*> mComponents;
         QHash<Uuid, library::Device*> mDevices;
 
+        // Reverse Indexes (built on first use, see #buildDeviceIndexes())
+        mutable bool mDeviceIndexesBuilt;
+        mutable QMultiHash<Uuid, library::Device*> mDevicesByComponent;
+        mutable QMultiHash<Uuid, library::Device*> mDevicesByPackage;
+
         // Added Library Elements
         QList<library::Symbol*> mAddedSymbols;
         QList<library::Package*> mAddedPackages;
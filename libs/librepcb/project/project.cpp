@@ -23,22 +23,31 @@
 #include <QtCore>
 #include <QPrinter>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/debugtrace.h>
 #include <librepcb/common/fileio/directorylock.h>
 #include <librepcb/common/fileio/smarttextfile.h>
 #include <librepcb/common/fileio/smartxmlfile.h>
 #include <librepcb/common/fileio/smartversionfile.h>
 #include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/domdocumentcache.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/filewritebatch.h>
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/common/memoryreport.h>
 #include <librepcb/common/systeminfo.h>
 #include "project.h"
+#include "projectjournal.h"
 #include "library/projectlibrary.h"
 #include "circuit/circuit.h"
+#include "circuit/componentinstance.h"
+#include "circuit/netsignal.h"
 #include "schematics/schematic.h"
 #include "erc/ercmsglist.h"
 #include "settings/projectsettings.h"
 #include "boards/board.h"
 #include <librepcb/common/application.h>
 #include "schematics/schematiclayerprovider.h"
+#include "schematics/schematicpdfexport.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -46,15 +55,67 @@
 namespace librepcb {
 namespace project {
 
+/*****************************************************************************************
+ *  Class Project::XmlFileParser
+ ****************************************************************************************/
+
+/**
+ * @brief Opens and parses a schematic or board file in a thread pool worker
+ *
+ * Exceptions are not propagated to the thread pool, they are stored and rethrown by
+ * #rethrowError() instead (which must not be called until the pool has finished).
+ * After parsing (successful or not), the shared counter of finished parsers is
+ * incremented to allow reporting the progress. If a DOM cache is passed, unmodified
+ * files are loaded from the cache instead of parsing them.
+ */
+class Project::XmlFileParser final : public QRunnable
+{
+    public:
+        XmlFileParser(const FilePath& filepath, bool restore, bool readOnly,
+                      DomDocumentCache* cache, QAtomicInt& finishedCounter) noexcept :
+            mFilePath(filepath), mRestore(restore), mReadOnly(readOnly), mCache(cache),
+            mFinishedCounter(finishedCounter)
+        {
+            setAutoDelete(false);
+        }
+
+        void run() noexcept override
+        {
+            try {
+                mXmlFile.reset(new SmartXmlFile(mFilePath, mRestore, mReadOnly)); // can throw
+                mDocument = mXmlFile->parseFileAndBuildDomTree(mCache); // can throw
+            } catch (const Exception& e) {
+                mError.reset(e.clone());
+            }
+            mFinishedCounter.ref();
+        }
+
+        void rethrowError() const {if (mError) mError->raise();}
+        SmartXmlFile* takeXmlFile() noexcept {return mXmlFile.take();}
+        const DomDocument& getDocument() const noexcept {return *mDocument;}
+
+    private:
+        FilePath mFilePath;
+        bool mRestore;
+        bool mReadOnly;
+        DomDocumentCache* mCache;
+        QAtomicInt& mFinishedCounter;
+        QScopedPointer<SmartXmlFile> mXmlFile;
+        std::unique_ptr<DomDocument> mDocument;
+        QScopedPointer<Exception> mError;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
-Project::Project(const FilePath& filepath, bool create, bool readOnly) :
+Project::Project(const FilePath& filepath, bool create, bool readOnly, bool modelOnly,
+                 const ProgressCallback& progress) :
     QObject(nullptr), IF_AttributeProvider(), mPath(filepath.getParentDir()),
     mFilepath(filepath), mLock(filepath.getParentDir()), mIsRestored(false),
-    mIsReadOnly(readOnly)
+    mIsReadOnly(readOnly), mIsModelOnly(modelOnly)
 {
+    LIBREPCB_TRACE_SCOPE("Project::Project");
     qDebug() << (create ? "create project:" : "open project:") << filepath.toNative();
 
     // Check if the file extension is correct
@@ -95,7 +156,7 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
     // Check if the project is locked (already open or application was crashed). In case
     // of a crash, the user can decide if the last backup should be restored. If the
     // project should be opened, the lock file will be created/updated here.
-    switch (mLock.getStatus()) // can throw
+    switch (mLock.getStatus(DirectoryLock::sDefaultTimeout)) // can throw
     {
         case DirectoryLock::LockStatus::Unlocked: {
             // nothing to do here (the project will be locked later)
@@ -143,7 +204,16 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
 
     // the project can be opened by this application, so we will lock the whole project
     if (!mIsReadOnly) {
-        mLock.lock(); // can throw
+        mLock.lock(DirectoryLock::sDefaultTimeout); // can throw
+    }
+
+    // the crashed session may have journaled modifications made after its last autosave
+    if (mIsRestored) {
+        try {
+            ProjectJournal::replay(mPath); // can throw
+        } catch (const Exception& e) {
+            qWarning() << "Could not replay the project journal:" << e.getMsg();
+        }
     }
 
     // check if the combination of "create", "mIsRestored" and "mIsReadOnly" is valid
@@ -157,8 +227,17 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
     // This is done by a try/catch block. In the catch-block, all allocated memory will
     // be freed. Then the exception is rethrown to leave the constructor.
 
+    // report the progress and throw if the user has canceled opening the project
+    auto reportProgress = [&progress](int percent, const QString& status){
+        if (progress && (!progress(percent, status))) {
+            throw UserCanceled(__FILE__, __LINE__);
+        }
+    };
+
     try
     {
+        reportProgress(0, tr("Open project file..."));
+
         // try to create/open the version file
         FilePath versionFilePath = mPath.getPathTo(".librepcb-project");
         if (create) {
@@ -197,36 +276,92 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
         }
 
         // Create all needed objects
+        reportProgress(5, tr("Load project library..."));
         mProjectSettings.reset(new ProjectSettings(*this, mIsRestored, mIsReadOnly, create));
         mProjectLibrary.reset(new ProjectLibrary(*this, mIsRestored, mIsReadOnly));
         mErcMsgList.reset(new ErcMsgList(*this, mIsRestored, mIsReadOnly, create));
+        reportProgress(15, tr("Load circuit..."));
         mCircuit.reset(new Circuit(*this, mIsRestored, mIsReadOnly, create));
 
         // Load all schematic layers
         mSchematicLayerProvider.reset(new SchematicLayerProvider(*this));
 
         if (!create) {
-            // Load all schematics
+            // Open and parse all schematic and board files in parallel
+            QList<FilePath> schematicFiles;
             foreach (const DomElement* node, root->getChilds("schematic")) {
-                FilePath fp = FilePath::fromRelative(mPath.getPathTo("schematics"), node->getText<QString>(true));
-                Schematic* schematic = new Schematic(*this, fp, mIsRestored, mIsReadOnly);
+                schematicFiles.append(FilePath::fromRelative(mPath.getPathTo("schematics"),
+                                                             node->getText<QString>(true)));
+            }
+            QList<FilePath> boardFiles;
+            foreach (const DomElement* node, root->getChilds("board")) {
+                boardFiles.append(FilePath::fromRelative(mPath.getPathTo("boards"),
+                                                         node->getText<QString>(true)));
+            }
+            // the binary DOM cache avoids parsing unmodified files again (it is not
+            // written in read-only mode to not modify the project directory)
+            std::unique_ptr<DomDocumentCache> cache;
+            if (!mIsReadOnly) {
+                cache.reset(new DomDocumentCache(mPath.getPathTo(".librepcb-cache")));
+            }
+            int fileCount = schematicFiles.count() + boardFiles.count();
+            QAtomicInt parsersFinished(0);
+            std::vector<std::unique_ptr<XmlFileParser>> parsers;
+            QThreadPool pool;
+            foreach (const FilePath& fp, schematicFiles + boardFiles) {
+                parsers.emplace_back(new XmlFileParser(fp, mIsRestored, mIsReadOnly,
+                                                       cache.get(), parsersFinished));
+                pool.start(parsers.back().get());
+            }
+            // parsing takes 25..60%, building the schematics and boards 60..100%
+            while (!pool.waitForDone(50)) {
+                int finished = parsersFinished.load();
+                try {
+                    reportProgress(25 + (35 * finished) / fileCount,
+                                   tr("Parse file %1 of %2...").arg(finished + 1).arg(fileCount));
+                } catch (...) {
+                    pool.clear(); // do not start the remaining parsers
+                    pool.waitForDone();
+                    throw;
+                }
+            }
+
+            // Build all schematics (sequentially, as they get linked into the circuit)
+            for (int i = 0; i < schematicFiles.count(); ++i) {
+                reportProgress(60 + (40 * i) / fileCount,
+                               tr("Load schematic %1 of %2...").arg(i + 1)
+                               .arg(schematicFiles.count()));
+                XmlFileParser& parser = *parsers.at(i);
+                parser.rethrowError(); // can throw
+                Schematic* schematic = new Schematic(*this, parser.takeXmlFile(),
+                    parser.getDocument(), mIsRestored, mIsReadOnly);
                 addSchematic(*schematic);
             }
             qDebug() << mSchematics.count() << "schematics successfully loaded!";
 
-            // Load all boards
-            foreach (const DomElement* node, root->getChilds("board")) {
-                FilePath fp = FilePath::fromRelative(mPath.getPathTo("boards"), node->getText<QString>(true));
-                Board* board = new Board(*this, fp, mIsRestored, mIsReadOnly);
+            // Build all boards
+            for (int i = 0; i < boardFiles.count(); ++i) {
+                reportProgress(60 + (40 * (schematicFiles.count() + i)) / fileCount,
+                               tr("Load board %1 of %2...").arg(i + 1).arg(boardFiles.count()));
+                XmlFileParser& parser = *parsers.at(schematicFiles.count() + i);
+                parser.rethrowError(); // can throw
+                Board* board = new Board(*this, parser.takeXmlFile(), parser.getDocument(),
+                                         mIsRestored, mIsReadOnly);
                 addBoard(*board);
             }
             qDebug() << mBoards.count() << "boards successfully loaded!";
+
+            // remove the cache entries of outdated file contents
+            if (cache) {
+                cache->removeUnusedEntries();
+            }
         }
 
         // at this point, the whole circuit with all schematics and boards is successfully
         // loaded, so the ERC list now contains all the correct ERC messages.
         // So we can now restore the ignore state of each ERC message from the XML file.
         mErcMsgList->restoreIgnoreState(); // can throw
+        reportProgress(100, tr("Project loaded."));
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
@@ -403,18 +538,8 @@ void Project::removeSchematic(Schematic& schematic, bool deleteSchematic)
 
 void Project::exportSchematicsAsPdf(const FilePath& filepath)
 {
-    QPrinter printer(QPrinter::HighResolution);
-    printer.setPaperSize(QPrinter::A4);
-    printer.setOrientation(QPrinter::Landscape);
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setCreator(QString("LibrePCB %1").arg(qApp->applicationVersion()));
-    printer.setOutputFileName(filepath.toStr());
-
-    QList<int> pages;
-    for (int i = 0; i < mSchematics.count(); i++)
-        pages.append(i);
-
-    printSchematicPages(printer, pages);
+    SchematicPdfExport pdfExport(mSchematics, QString("LibrePCB %1").arg(qApp->applicationVersion()));
+    pdfExport.exportToFile(filepath); // can throw
 
     QDesktopServices::openUrl(QUrl::fromLocalFile(filepath.toStr()));
 }
@@ -546,6 +671,170 @@ void Project::save(bool toOriginal)
     Q_ASSERT(errors.isEmpty());
 }
 
+bool Project::reloadModifiedFiles()
+{
+    if (mIsReadOnly || mIsRestored || mProjectLibrary->isModifiedOnDisk()) {
+        return false;
+    }
+
+    // collect the content the files would have if the project was saved now (the
+    // library is compared differently, and the ERC messages are restored anyway)
+    FileWriteBatch batch;
+    batch.setCollectUnmodifiedFiles(true); // compare all files, not only modified ones
+    {
+        FileWriteBatch::Collector collector(batch);
+        QStringList errors;
+        DomDocument doc(*serializeToDomElement("project")); // can throw
+        mXmlFile->save(doc, true); // can throw
+        bool success = mProjectSettings->save(true, errors);
+        success = mCircuit->save(true, errors) && success;
+        foreach (Schematic* schematic, mRemovedSchematics + mSchematics) {
+            success = schematic->save(true, errors) && success;
+        }
+        foreach (Board* board, mRemovedBoards + mBoards) {
+            success = board->save(true, errors) && success;
+        }
+        if (!success) {
+            throw RuntimeError(__FILE__, __LINE__, errors.join("\n"));
+        }
+    }
+
+    // determine the modified files (user settings are not versioned, so they are kept)
+    const FilePath schematicsDir = mPath.getPathTo("schematics");
+    const FilePath boardsDir = mPath.getPathTo("boards");
+    QSet<QString> modifiedFiles;
+    bool projectFileModified = false;
+    foreach (const FilePath& filepath, batch.getModifiedFiles()) {
+        if (filepath == mFilepath) {
+            projectFileModified = true;
+        } else if (filepath.isLocatedInDir(schematicsDir) || filepath.isLocatedInDir(boardsDir)) {
+            modifiedFiles.insert(filepath.toStr());
+        } else if (!filepath.isLocatedInDir(mPath.getPathTo("user"))) {
+            return false; // e.g. the circuit was modified
+        }
+    }
+    if (modifiedFiles.isEmpty() && (!projectFileModified)) {
+        mErcMsgList->restoreIgnoreState(); // can throw
+        return true; // nothing else to do
+    }
+
+    // get the schematics and boards which the project should contain now
+    QList<FilePath> schematicFiles;
+    QList<FilePath> boardFiles;
+    foreach (const Schematic* schematic, mSchematics) {
+        schematicFiles.append(schematic->getFilePath());
+    }
+    foreach (const Board* board, mBoards) {
+        boardFiles.append(board->getFilePath());
+    }
+    if (projectFileModified) {
+        auto takeFiles = [](DomElement& root, const QString& name, const FilePath& dir) {
+            QList<FilePath> files;
+            foreach (DomElement* child, root.getChilds(name)) {
+                files.append(FilePath::fromRelative(dir, child->getText<QString>(true)));
+                root.removeChild(child, true);
+            }
+            return files;
+        };
+        DomDocument newDoc(FileUtils::readFile(mFilepath), mFilepath); // can throw
+        DomDocument oldDoc(*serializeToDomElement("project")); // can throw
+        schematicFiles = takeFiles(newDoc.getRoot("project"), "schematic", schematicsDir);
+        boardFiles = takeFiles(newDoc.getRoot("project"), "board", boardsDir);
+        takeFiles(oldDoc.getRoot(), "schematic", schematicsDir);
+        takeFiles(oldDoc.getRoot(), "board", boardsDir);
+        if (newDoc.toByteArray() != oldDoc.toByteArray()) {
+            return false; // the metadata of the project was modified
+        }
+    }
+
+    // load all new or modified schematics and boards before modifying the project, and
+    // keep the other ones (their order must not change as they are not moved)
+    QList<Schematic*> keptSchematics, newSchematics; // new: nullptr for kept ones
+    QList<Board*> keptBoards, newBoards;
+    auto deleteGuard = scopeGuard([&](){qDeleteAll(newBoards); qDeleteAll(newSchematics);});
+    foreach (const FilePath& filepath, schematicFiles) {
+        Schematic* schematic = nullptr;
+        foreach (Schematic* s, mSchematics) {
+            if (s->getFilePath() == filepath) schematic = s;
+        }
+        if (schematic && (!modifiedFiles.contains(filepath.toStr()))) {
+            keptSchematics.append(schematic);
+            newSchematics.append(nullptr);
+        } else {
+            newSchematics.append(new Schematic(*this, filepath, false, false)); // can throw
+        }
+    }
+    foreach (const FilePath& filepath, boardFiles) {
+        Board* board = nullptr;
+        foreach (Board* b, mBoards) {
+            if (b->getFilePath() == filepath) board = b;
+        }
+        if (board && (!modifiedFiles.contains(filepath.toStr()))) {
+            keptBoards.append(board);
+            newBoards.append(nullptr);
+        } else {
+            newBoards.append(new Board(*this, filepath, false, false)); // can throw
+        }
+    }
+    QList<Schematic*> remainingSchematics;
+    foreach (Schematic* schematic, mSchematics) {
+        if (keptSchematics.contains(schematic)) remainingSchematics.append(schematic);
+    }
+    QList<Board*> remainingBoards;
+    foreach (Board* board, mBoards) {
+        if (keptBoards.contains(board)) remainingBoards.append(board);
+    }
+    if ((remainingSchematics != keptSchematics) || (remainingBoards != keptBoards)) {
+        return false; // the order of unmodified schematics or boards has changed
+    }
+
+    // replace the objects
+    foreach (Schematic* schematic, mSchematics) {
+        if (!keptSchematics.contains(schematic)) {
+            removeSchematic(*schematic, true); // can throw
+        }
+    }
+    foreach (Board* board, mBoards) {
+        if (!keptBoards.contains(board)) {
+            removeBoard(*board, true); // can throw
+        }
+    }
+    for (int i = 0; i < newSchematics.count(); ++i) {
+        if (newSchematics.at(i)) {
+            addSchematic(*newSchematics.at(i), i); // can throw
+            newSchematics[i] = nullptr;
+        }
+    }
+    for (int i = 0; i < newBoards.count(); ++i) {
+        if (newBoards.at(i)) {
+            addBoard(*newBoards.at(i), i); // can throw
+            newBoards[i] = nullptr;
+        }
+    }
+    deleteGuard.dismiss();
+
+    // restore the ignore state of the ERC messages (also of the new schematics and boards)
+    mErcMsgList->restoreIgnoreState(); // can throw
+    return true;
+}
+
+void Project::addToMemoryReport(MemoryReport& parent) const noexcept
+{
+    MemoryReport& report = parent.addChild(QString("Project \"%1\"").arg(getName()),
+                                           sizeof(Project));
+    MemoryReport& circuit = report.addChild("Circuit", sizeof(Circuit));
+    circuit.addObjects<NetSignal>("Net signals", mCircuit->getNetSignals().count());
+    circuit.addObjects<ComponentInstance>("Component instances",
+                                          mCircuit->getComponentInstances().count());
+    mProjectLibrary->addToMemoryReport(report);
+    foreach (const Schematic* schematic, mSchematics) {
+        schematic->addToMemoryReport(report);
+    }
+    foreach (const Board* board, mBoards) {
+        board->addToMemoryReport(report);
+    }
+}
+
 /*****************************************************************************************
  *  Helper Methods
  ****************************************************************************************/
@@ -623,6 +912,7 @@ void Project::serialize(DomElement& root) const
 
 bool Project::save(bool toOriginal, QStringList& errors) noexcept
 {
+    LIBREPCB_TRACE_SCOPE("Project::save");
     bool success = true;
 
     if (mIsReadOnly)
@@ -723,7 +1013,7 @@ void Project::printSchematicPages(QPrinter& printer, QList<int>& pages)
             throw RuntimeError(__FILE__, __LINE__,
                 QString(tr("No schematic page with the index %1 found.")).arg(pages[i]));
         }
-        schematic->clearSelection();
+        schematic->prepareRendering();
         schematic->renderToQPainter(painter);
 
         if (i != pages.count() - 1)
@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <functional>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/if_attributeprovider.h>
 #include <librepcb/common/exceptions.h>
@@ -42,6 +43,7 @@ namespace librepcb {
 class SmartTextFile;
 class SmartXmlFile;
 class SmartVersionFile;
+class MemoryReport;
 
 namespace project {
 
@@ -82,6 +84,23 @@ class Project final : public QObject, public IF_AttributeProvider, public Serial
 
     public:
 
+        // Types
+
+        /**
+         * @brief Callback to report the progress while opening a project
+         *
+         * It is called from the thread which opens the project, so it may process events
+         * to keep the GUI responsive (e.g. by updating a QProgressDialog).
+         *
+         * @param percent   The overall progress [0..100]
+         * @param status    A translated description of the current step
+         *
+         * @retval true     Continue opening the project
+         * @retval false    Cancel opening the project (throws librepcb::UserCanceled)
+         */
+        typedef std::function<bool(int percent, const QString& status)> ProgressCallback;
+
+
         // Constructors / Destructor
         Project() = delete;
         Project(const Project& other) = delete;
@@ -91,11 +110,17 @@ class Project final : public QObject, public IF_AttributeProvider, public Serial
          *
          * @param filepath      The filepath to the an existing *.lpp project file
          * @param readOnly      It true, the project will be opened in read-only mode
+         * @param modelOnly     If true, the project will be opened in model-only mode
+         *                      (see #isModelOnly())
+         * @param progress      An optional callback to report the progress and to
+         *                      cancel opening the project
          *
          * @throw Exception     If the project could not be opened successfully
+         * @throw UserCanceled  If opening the project was canceled by the progress callback
          */
-        Project(const FilePath& filepath, bool readOnly) :
-            Project(filepath, false, readOnly) {}
+        Project(const FilePath& filepath, bool readOnly, bool modelOnly = false,
+                const ProgressCallback& progress = nullptr) :
+            Project(filepath, false, readOnly, modelOnly, progress) {}
 
         /**
          * @brief The destructor will close the whole project (without saving!)
@@ -126,6 +151,21 @@ class Project final : public QObject, public IF_AttributeProvider, public Serial
          */
         bool isReadOnly() const noexcept {return mIsReadOnly;}
 
+        /**
+         * @brief Check whether this project was opened in model-only mode or not
+         *
+         * In model-only mode, no graphics items are created while loading the project.
+         * They are created lazily for each board as soon as it is shown the first time
+         * (see librepcb#project#Board#showInView()). This is useful for non-interactive
+         * use cases like exporting fabrication data.
+         *
+         * @note The graphics items of schematics are always created lazily (see
+         *       librepcb#project#Schematic#showInView()), independent of this mode.
+         *
+         * @return See #mIsModelOnly
+         */
+        bool isModelOnly() const noexcept {return mIsModelOnly;}
+
         /**
          * @brief Check whether this project restored from temporary files or not
          *
@@ -450,6 +490,37 @@ class Project final : public QObject, public IF_AttributeProvider, public Serial
          */
         void save(bool toOriginal);
 
+        /**
+         * @brief Reload the schematics and boards which were modified on the harddisc
+         *
+         * This is used after the files of the project were modified by another
+         * application, e.g. by checking out another git branch. The content of every file
+         * (as it would be written by #save()) is compared with the file on the harddisc,
+         * and only the schematics and boards whose files differ (or which were added or
+         * removed in the project file) are replaced by newly loaded objects. All other
+         * schematics and boards are kept, including their graphics items.
+         *
+         * If other files differ too (e.g. the circuit, the library or the metadata of the
+         * project), nothing is reloaded since all objects would be affected.
+         *
+         * @warning Unsaved modifications of the reloaded schematics and boards are lost,
+         *          and undo commands which refer to them must not be executed anymore!
+         *
+         * @retval true     If the project matches the harddisc now
+         * @retval false    If the whole project needs to be reopened (nothing changed)
+         *
+         * @throw Exception If a modified file could not be loaded. If the files were
+         *                  loaded successfully, but replacing an object failed, the
+         *                  project may be left partially reloaded and must be reopened.
+         */
+        bool reloadModifiedFiles();
+
+        /**
+         * @brief Add the approximate memory usage of the whole project (circuit,
+         *        library, schematics and boards) to a report
+         */
+        void addToMemoryReport(MemoryReport& parent) const noexcept;
+
 
         // Helper Methods
 
@@ -467,7 +538,7 @@ class Project final : public QObject, public IF_AttributeProvider, public Serial
         // Static Methods
 
         static Project* create(const FilePath& filepath)
-        {return new Project(filepath, true, false);}
+        {return new Project(filepath, true, false, false, nullptr);}
 
         static bool isValidProjectDirectory(const FilePath& dir) noexcept;
         static Version getProjectFileFormatVersion(const FilePath& dir);
@@ -509,6 +580,10 @@ class Project final : public QObject, public IF_AttributeProvider, public Serial
 
     private:
 
+        // Types
+        class XmlFileParser;
+
+
         // Private Methods
 
         /**
@@ -518,10 +593,13 @@ class Project final : public QObject, public IF_AttributeProvider, public Serial
          * @param create        True if the specified project does not exist already and
          *                      must be created.
          * @param readOnly      If true, the project will be opened in read-only mode
+         * @param modelOnly     If true, the project will be opened in model-only mode
+         * @param progress      An optional callback to report the progress
          *
          * @throw Exception     If the project could not be created/opened successfully
          */
-        explicit Project(const FilePath& filepath, bool create, bool readOnly);
+        explicit Project(const FilePath& filepath, bool create, bool readOnly, bool modelOnly,
+                         const ProgressCallback& progress);
 
         bool checkAttributesValidity() const noexcept;
 
@@ -559,6 +637,7 @@ class Project final : public QObject, public IF_AttributeProvider, public Serial
         DirectoryLock mLock; ///< Lock for the whole project directory (see @ref doc_project_lock)
         bool mIsRestored; ///< the constructor will set this to true if the project was restored
         bool mIsReadOnly; ///< the constructor will set this to true if the project was opened in read only mode
+        bool mIsModelOnly; ///< if true, graphics items are only created when needed
 
         // Attributes
         QString mName;              ///< the name of the project
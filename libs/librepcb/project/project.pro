@@ -18,16 +18,31 @@ QT += core widgets xml sql printsupport
 CONFIG += staticlib
 
 INCLUDEPATH += \
-    ../../
+    ../../ \
+    ../../quazip
 
 SOURCES += \
     boards/board.cpp \
+    boards/boardairwires.cpp \
+    boards/boardannotationdiff.cpp \
+    boards/boardcopperpours.cpp \
+    boards/boarddesignrulecheck.cpp \
     boards/boardgerberexport.cpp \
+    boards/boardimageexport.cpp \
+    boards/boardipc2581export.cpp \
+    boards/boarditemgeometry.cpp \
     boards/boardlayerstack.cpp \
+    boards/boardnetlinegeometry.cpp \
+    boards/boardnetstatistics.cpp \
+    boards/boardpickplaceexport.cpp \
+    boards/boardruletable.cpp \
+    boards/boardtracerouter.cpp \
     boards/boardusersettings.cpp \
+    boards/boardviastitching.cpp \
     boards/cmd/cmdboardadd.cpp \
     boards/cmd/cmdboarddesignrulesmodify.cpp \
     boards/cmd/cmdboardlayerstackedit.cpp \
+    boards/cmd/cmdboardnetitemsmove.cpp \
     boards/cmd/cmdboardnetlineadd.cpp \
     boards/cmd/cmdboardnetlineremove.cpp \
     boards/cmd/cmdboardnetpointadd.cpp \
@@ -36,13 +51,16 @@ SOURCES += \
     boards/cmd/cmdboardviaadd.cpp \
     boards/cmd/cmdboardviaedit.cpp \
     boards/cmd/cmdboardviaremove.cpp \
+    boards/cmd/cmdboardviasadd.cpp \
     boards/cmd/cmddeviceinstanceadd.cpp \
     boards/cmd/cmddeviceinstanceedit.cpp \
     boards/cmd/cmddeviceinstanceremove.cpp \
+    boards/graphicsitems/bgi_airwires.cpp \
     boards/graphicsitems/bgi_base.cpp \
     boards/graphicsitems/bgi_footprint.cpp \
     boards/graphicsitems/bgi_footprintpad.cpp \
     boards/graphicsitems/bgi_netline.cpp \
+    boards/graphicsitems/bgi_netlinebatch.cpp \
     boards/graphicsitems/bgi_netpoint.cpp \
     boards/graphicsitems/bgi_polygon.cpp \
     boards/graphicsitems/bgi_via.cpp \
@@ -55,8 +73,12 @@ SOURCES += \
     boards/items/bi_polygon.cpp \
     boards/items/bi_via.cpp \
     circuit/circuit.cpp \
+    circuit/circuitbomexport.cpp \
+    circuit/circuitnetlistexport.cpp \
+    circuit/circuitsnapshot.cpp \
     circuit/cmd/cmdcomponentinstanceadd.cpp \
     circuit/cmd/cmdcomponentinstanceedit.cpp \
+    circuit/cmd/cmdcomponentinstancesedit.cpp \
     circuit/cmd/cmdcomponentinstanceremove.cpp \
     circuit/cmd/cmdcompsiginstsetnetsignal.cpp \
     circuit/cmd/cmdnetclassadd.cpp \
@@ -64,6 +86,7 @@ SOURCES += \
     circuit/cmd/cmdnetclassremove.cpp \
     circuit/cmd/cmdnetsignaladd.cpp \
     circuit/cmd/cmdnetsignaledit.cpp \
+    circuit/cmd/cmdnetsignalmoveitems.cpp \
     circuit/cmd/cmdnetsignalremove.cpp \
     circuit/componentinstance.cpp \
     circuit/componentsignalinstance.cpp \
@@ -75,6 +98,9 @@ SOURCES += \
     library/cmd/cmdprojectlibraryaddelement.cpp \
     library/projectlibrary.cpp \
     project.cpp \
+    projectarchive.cpp \
+    projectjournal.cpp \
+    projectsnapshot.cpp \
     schematics/cmd/cmdschematicadd.cpp \
     schematics/cmd/cmdschematicnetlabeladd.cpp \
     schematics/cmd/cmdschematicnetlabeledit.cpp \
@@ -86,6 +112,7 @@ SOURCES += \
     schematics/cmd/cmdschematicnetpointremove.cpp \
     schematics/cmd/cmdschematicremove.cpp \
     schematics/cmd/cmdsymbolinstanceadd.cpp \
+    schematics/cmd/cmdsymbolinstancesadd.cpp \
     schematics/cmd/cmdsymbolinstanceedit.cpp \
     schematics/cmd/cmdsymbolinstanceremove.cpp \
     schematics/graphicsitems/sgi_base.cpp \
@@ -102,17 +129,32 @@ SOURCES += \
     schematics/items/si_symbolpin.cpp \
     schematics/schematic.cpp \
     schematics/schematiclayerprovider.cpp \
+    schematics/schematicpdfexport.cpp \
     settings/cmd/cmdprojectsettingschange.cpp \
     settings/projectsettings.cpp \
 
 HEADERS += \
     boards/board.h \
+    boards/boardairwires.h \
+    boards/boardannotationdiff.h \
+    boards/boardcopperpours.h \
+    boards/boarddesignrulecheck.h \
     boards/boardgerberexport.h \
+    boards/boardimageexport.h \
+    boards/boardipc2581export.h \
+    boards/boarditemgeometry.h \
     boards/boardlayerstack.h \
+    boards/boardnetlinegeometry.h \
+    boards/boardnetstatistics.h \
+    boards/boardpickplaceexport.h \
+    boards/boardruletable.h \
+    boards/boardtracerouter.h \
     boards/boardusersettings.h \
+    boards/boardviastitching.h \
     boards/cmd/cmdboardadd.h \
     boards/cmd/cmdboarddesignrulesmodify.h \
     boards/cmd/cmdboardlayerstackedit.h \
+    boards/cmd/cmdboardnetitemsmove.h \
     boards/cmd/cmdboardnetlineadd.h \
     boards/cmd/cmdboardnetlineremove.h \
     boards/cmd/cmdboardnetpointadd.h \
@@ -121,13 +163,16 @@ HEADERS += \
     boards/cmd/cmdboardviaadd.h \
     boards/cmd/cmdboardviaedit.h \
     boards/cmd/cmdboardviaremove.h \
+    boards/cmd/cmdboardviasadd.h \
     boards/cmd/cmddeviceinstanceadd.h \
     boards/cmd/cmddeviceinstanceedit.h \
     boards/cmd/cmddeviceinstanceremove.h \
+    boards/graphicsitems/bgi_airwires.h \
     boards/graphicsitems/bgi_base.h \
     boards/graphicsitems/bgi_footprint.h \
     boards/graphicsitems/bgi_footprintpad.h \
     boards/graphicsitems/bgi_netline.h \
+    boards/graphicsitems/bgi_netlinebatch.h \
     boards/graphicsitems/bgi_netpoint.h \
     boards/graphicsitems/bgi_polygon.h \
     boards/graphicsitems/bgi_via.h \
@@ -140,8 +185,12 @@ HEADERS += \
     boards/items/bi_polygon.h \
     boards/items/bi_via.h \
     circuit/circuit.h \
+    circuit/circuitbomexport.h \
+    circuit/circuitnetlistexport.h \
+    circuit/circuitsnapshot.h \
     circuit/cmd/cmdcomponentinstanceadd.h \
     circuit/cmd/cmdcomponentinstanceedit.h \
+    circuit/cmd/cmdcomponentinstancesedit.h \
     circuit/cmd/cmdcomponentinstanceremove.h \
     circuit/cmd/cmdcompsiginstsetnetsignal.h \
     circuit/cmd/cmdnetclassadd.h \
@@ -149,6 +198,7 @@ HEADERS += \
     circuit/cmd/cmdnetclassremove.h \
     circuit/cmd/cmdnetsignaladd.h \
     circuit/cmd/cmdnetsignaledit.h \
+    circuit/cmd/cmdnetsignalmoveitems.h \
     circuit/cmd/cmdnetsignalremove.h \
     circuit/componentinstance.h \
     circuit/componentsignalinstance.h \
@@ -161,6 +211,9 @@ HEADERS += \
     library/cmd/cmdprojectlibraryaddelement.h \
     library/projectlibrary.h \
     project.h \
+    projectarchive.h \
+    projectjournal.h \
+    projectsnapshot.h \
     schematics/cmd/cmdschematicadd.h \
     schematics/cmd/cmdschematicnetlabeladd.h \
     schematics/cmd/cmdschematicnetlabeledit.h \
@@ -172,6 +225,7 @@ HEADERS += \
     schematics/cmd/cmdschematicnetpointremove.h \
     schematics/cmd/cmdschematicremove.h \
     schematics/cmd/cmdsymbolinstanceadd.h \
+    schematics/cmd/cmdsymbolinstancesadd.h \
     schematics/cmd/cmdsymbolinstanceedit.h \
     schematics/cmd/cmdsymbolinstanceremove.h \
     schematics/graphicsitems/sgi_base.h \
@@ -188,6 +242,7 @@ HEADERS += \
     schematics/items/si_symbolpin.h \
     schematics/schematic.h \
     schematics/schematiclayerprovider.h \
+    schematics/schematicpdfexport.h \
     settings/cmd/cmdprojectsettingschange.h \
     settings/projectsettings.h \
 
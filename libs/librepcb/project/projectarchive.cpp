@@ -0,0 +1,293 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+#include <quazip/quazipnewinfo.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/jobscheduler.h>
+#include <librepcb/common/scopeguard.h>
+#include "projectarchive.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Struct ProjectArchive::Entry
+ ****************************************************************************************/
+
+/**
+ * @brief A file to be exported, compressed by a #CompressJob
+ */
+struct ProjectArchive::Entry
+{
+    QString name;           ///< the path within the archive
+    FilePath filepath;      ///< the file to compress
+    QByteArray data;        ///< the raw deflate stream of the file content
+    quint32 crc;            ///< CRC-32 of the file content
+    qint64 size;            ///< size of the file content
+    QString error;          ///< the error message if the file could not be compressed
+};
+
+/*****************************************************************************************
+ *  Class ProjectArchive::CompressJob
+ ****************************************************************************************/
+
+/**
+ * @brief Reads and compresses one file of the project in the JobScheduler
+ *
+ * Every job only accesses its own #Entry, so no locking is required.
+ */
+class ProjectArchive::CompressJob final : public QRunnable
+{
+    public:
+        CompressJob(Entry& entry, const JobScheduler::CancellationToken& token) noexcept :
+            mEntry(entry), mToken(token)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            if (mToken.isCanceled()) return;
+            try
+            {
+                QByteArray content = FileUtils::readFile(mEntry.filepath); // can throw
+                mEntry.size = content.size();
+                mEntry.crc = crc32(0L, reinterpret_cast<const Bytef*>(content.constData()),
+                                   content.size());
+
+                // raw deflate stream (without zlib header), as stored in zip files
+                z_stream stream;
+                memset(&stream, 0, sizeof(stream));
+                if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS,
+                                 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                {
+                    throw RuntimeError(__FILE__, __LINE__, tr("Failed to initialize zlib."));
+                }
+                mEntry.data.resize(deflateBound(&stream, content.size()));
+                stream.next_in = reinterpret_cast<Bytef*>(content.data());
+                stream.avail_in = content.size();
+                stream.next_out = reinterpret_cast<Bytef*>(mEntry.data.data());
+                stream.avail_out = mEntry.data.size();
+                int result = deflate(&stream, Z_FINISH);
+                mEntry.data.resize(stream.total_out);
+                deflateEnd(&stream);
+                if (result != Z_STREAM_END) {
+                    throw RuntimeError(__FILE__, __LINE__, QString(tr("Failed to compress "
+                        "file \"%1\".")).arg(mEntry.filepath.toNative()));
+                }
+            }
+            catch (const Exception& e)
+            {
+                mEntry.error = e.getMsg();
+            }
+        }
+
+    private:
+        Entry& mEntry;
+        JobScheduler::CancellationToken mToken;
+};
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+void ProjectArchive::exportProject(const FilePath& projectDir, const FilePath& zipFile,
+                                   JobScheduler& scheduler, bool excludeRegenerable)
+{
+    if (!projectDir.isExistingDir()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("The directory \"%1\" does "
+            "not exist.")).arg(projectDir.toNative()));
+    }
+
+    // collect all files (the whole list is built first, so the vector is never resized
+    // while the jobs access its entries)
+    QString dirName = projectDir.getFilename();
+    QVector<Entry> entries;
+    QDirIterator it(projectDir.toStr(), QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        FilePath filepath(it.next());
+        QString relativePath = filepath.toRelative(projectDir);
+        if (isExcludedFile(relativePath, excludeRegenerable)) continue;
+        Entry entry;
+        entry.name = dirName % "/" % relativePath;
+        entry.filepath = filepath;
+        entry.crc = 0;
+        entry.size = 0;
+        entries.append(entry);
+    }
+
+    // compress all files in parallel
+    {
+        JobScheduler::Group jobs(scheduler, JobScheduler::Priority::Interactive);
+        for (Entry& entry : entries) {
+            jobs.start(new CompressJob(entry, jobs.getCancellationToken()));
+        }
+        jobs.waitForDone();
+    }
+    foreach (const Entry& entry, entries) {
+        if (!entry.error.isEmpty()) {
+            throw RuntimeError(__FILE__, __LINE__, entry.error);
+        }
+    }
+
+    // write the already compressed files to the archive
+    FileUtils::makePath(zipFile.getParentDir()); // can throw
+    QuaZip zip(zipFile.toStr());
+    zip.setFileNameCodec("UTF-8");
+    if (!zip.open(QuaZip::mdCreate)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not create the archive "
+            "\"%1\".")).arg(zipFile.toNative()));
+    }
+    auto removeGuard = scopeGuard([&](){
+        zip.close();
+        QFile::remove(zipFile.toStr());
+    });
+    foreach (const Entry& entry, entries) {
+        QuaZipNewInfo info(entry.name, entry.filepath.toStr()); // takes the file's date
+        info.uncompressedSize = entry.size;
+        QuaZipFile file(&zip);
+        bool success = file.open(QIODevice::WriteOnly, info, nullptr, entry.crc,
+                                 Z_DEFLATED, Z_DEFAULT_COMPRESSION, true);
+        success = success && (file.write(entry.data) == entry.data.size());
+        file.close();
+        if ((!success) || (file.getZipError() != ZIP_OK)) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write \"%1\" to "
+                "the archive \"%2\".")).arg(entry.name, zipFile.toNative()));
+        }
+    }
+    zip.close();
+    removeGuard.dismiss();
+    if (zip.getZipError() != ZIP_OK) {
+        QFile::remove(zipFile.toStr());
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write the archive "
+            "\"%1\".")).arg(zipFile.toNative()));
+    }
+}
+
+FilePath ProjectArchive::importArchive(const FilePath& zipFile, const FilePath& parentDir)
+{
+    QuaZip zip(zipFile.toStr());
+    zip.setFileNameCodec("UTF-8");
+    if (!zip.open(QuaZip::mdUnzip)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not open the archive "
+            "\"%1\".")).arg(zipFile.toNative()));
+    }
+
+    // check the names of all entries before extracting anything
+    QStringList names = zip.getFileNameList();
+    QString dirName = names.value(0).section('/', 0, 0);
+    QString projectFileName;
+    foreach (const QString& name, names) {
+        QStringList segments = name.split('/');
+        if (dirName.isEmpty() || (segments.count() < 2) || (segments.first() != dirName)
+            || segments.contains("..") || name.contains('\\'))
+        {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("The archive \"%1\" does "
+                "not contain a valid project.")).arg(zipFile.toNative()));
+        }
+        if ((segments.count() == 2) && segments.last().endsWith(".lpp")
+            && (projectFileName.isEmpty() || (segments.last() == dirName % ".lpp")))
+        {
+            projectFileName = segments.last();
+        }
+    }
+    if (projectFileName.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("The archive \"%1\" does not "
+            "contain a project file.")).arg(zipFile.toNative()));
+    }
+    FilePath projectDir = parentDir.getPathTo(dirName);
+    if (projectDir.isExistingDir() || projectDir.isExistingFile()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("The directory \"%1\" already "
+            "exists.")).arg(projectDir.toNative()));
+    }
+
+    // extract all entries, chunk by chunk
+    auto removeGuard = scopeGuard([&](){
+        try {
+            FileUtils::removeDirRecursively(projectDir);
+        } catch (const Exception& e) {
+            qWarning() << "Could not remove the extracted files:" << e.getMsg();
+        }
+    });
+    for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile()) {
+        QString name = zip.getCurrentFileName();
+        FilePath filepath = parentDir.getPathTo(name);
+        if (!filepath.isLocatedInDir(projectDir)) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Invalid file \"%1\" in "
+                "the archive.")).arg(name));
+        }
+        if (name.endsWith('/')) {
+            FileUtils::makePath(filepath); // can throw
+            continue;
+        }
+        FileUtils::makePath(filepath.getParentDir()); // can throw
+        QuaZipFile source(&zip);
+        QSaveFile dest(filepath.toStr());
+        if ((!source.open(QIODevice::ReadOnly)) || (!dest.open(QIODevice::WriteOnly))) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not extract \"%1\": "
+                "%2")).arg(name, dest.errorString()));
+        }
+        char buffer[65536];
+        qint64 count;
+        while ((count = source.read(buffer, sizeof(buffer))) > 0) {
+            if (dest.write(buffer, count) != count) break;
+        }
+        source.close(); // checks the CRC
+        if ((count != 0) || (source.getZipError() != UNZ_OK) || (!dest.commit())) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not extract \"%1\": "
+                "%2")).arg(name, dest.errorString()));
+        }
+    }
+    if (zip.getZipError() != UNZ_OK) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not read the archive "
+            "\"%1\".")).arg(zipFile.toNative()));
+    }
+    removeGuard.dismiss();
+    return projectDir.getPathTo(projectFileName);
+}
+
+bool ProjectArchive::isExcludedFile(const QString& relativePath,
+                                    bool excludeRegenerable) noexcept
+{
+    if (relativePath == ".lock") {
+        return true; // the directory lock belongs to the running application
+    }
+    if (excludeRegenerable) {
+        return relativePath.endsWith('~') || relativePath.startsWith(".librepcb-cache/");
+    }
+    return false;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,126 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_PROJECTARCHIVE_H
+#define LIBREPCB_PROJECT_PROJECTARCHIVE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class JobScheduler;
+
+namespace project {
+
+/*****************************************************************************************
+ *  Class ProjectArchive
+ ****************************************************************************************/
+
+/**
+ * @brief The ProjectArchive class exports project directories to zip files and imports
+ *        them again
+ *
+ * The archive contains the whole project directory as a top level directory, so it can
+ * also be extracted with any other zip tool. The directory lock is never archived.
+ *
+ * When exporting, the files are read and compressed in parallel in a JobScheduler and
+ * then written to the archive as already compressed (raw) entries. When importing, the
+ * entries are decompressed and written to the destination files chunk by chunk.
+ */
+class ProjectArchive final
+{
+        Q_DECLARE_TR_FUNCTIONS(ProjectArchive)
+
+    public:
+
+        // Constructors / Destructor
+        ProjectArchive() = delete;
+        ProjectArchive(const ProjectArchive& other) = delete;
+
+
+        // Static Methods
+
+        /**
+         * @brief Export a project directory to a zip file
+         *
+         * @param projectDir        The project directory to export
+         * @param zipFile           The zip file to create (an existing file is replaced)
+         * @param scheduler         The scheduler to compress the files in parallel
+         * @param excludeRegenerable    If true, files which are not needed to open the
+         *                              project are excluded, i.e. the "~" backup files
+         *                              and the ".librepcb-cache" directory.
+         *
+         * @throw Exception If a file could not be read or the archive not be written
+         */
+        static void exportProject(const FilePath& projectDir, const FilePath& zipFile,
+                                  JobScheduler& scheduler, bool excludeRegenerable);
+
+        /**
+         * @brief Extract a project archive
+         *
+         * @param zipFile           The zip file created by #exportProject()
+         * @param parentDir         The directory to extract the project directory into
+         *
+         * @return The project file (*.lpp) of the extracted project
+         *
+         * @throw Exception If the archive is invalid, if the project directory already
+         *                  exists or if the files could not be written. Already extracted
+         *                  files are removed in this case.
+         */
+        static FilePath importArchive(const FilePath& zipFile, const FilePath& parentDir);
+
+        /**
+         * @brief Check whether a file of a project directory shall not be exported
+         *
+         * @param relativePath      The path relative to the project directory
+         * @param excludeRegenerable    See #exportProject()
+         *
+         * @return true if the file is excluded from the archive
+         */
+        static bool isExcludedFile(const QString& relativePath,
+                                   bool excludeRegenerable) noexcept;
+
+
+        // Operator Overloadings
+        ProjectArchive& operator=(const ProjectArchive& rhs) = delete;
+
+
+    private: // Types
+
+        class CompressJob;
+        struct Entry;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_PROJECTARCHIVE_H
@@ -0,0 +1,196 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "projectjournal.h"
+#include "projectsnapshot.h"
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ProjectJournal::ProjectJournal(const FilePath& projectDir) noexcept :
+    mProjectDir(projectDir), mFilePath(getFilePath(projectDir))
+{
+}
+
+ProjectJournal::~ProjectJournal() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 ProjectJournal::getSize() const noexcept
+{
+    return QFileInfo(mFilePath.toStr()).size();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int ProjectJournal::append(const ProjectSnapshot& snapshot)
+{
+    QList<ProjectSnapshot::Document> documents;
+    documents.append(snapshot.getCircuit());
+    documents.append(snapshot.getSchematics());
+    documents.append(snapshot.getBoards());
+
+    QByteArray records;
+    QDataStream stream(&records, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+    QHash<FilePath, QByteArray> hashes;
+    foreach (const ProjectSnapshot::Document& doc, documents) {
+        if (doc.dom.isNull()) continue;
+        if ((!doc.hash.isEmpty()) && (mJournaledHashes.value(doc.filepath) == doc.hash)) {
+            continue; // not modified since the last record
+        }
+        QByteArray data = qCompress(doc.dom->toByteArray()); // can throw
+        stream << sRecordMagic << doc.filepath.toRelative(mProjectDir) << data
+               << qChecksum(data.constData(), static_cast<uint>(data.size()));
+        hashes.insert(doc.filepath, doc.hash);
+    }
+    if (hashes.isEmpty()) {
+        return 0;
+    }
+
+    QFile file(mFilePath.toStr());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(mFilePath.toNative(), file.errorString()));
+    }
+    if ((file.write(records) != records.size()) || (!file.flush())) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not write to file \"%1\": %2"))
+            .arg(mFilePath.toNative(), file.errorString()));
+    }
+
+    for (auto it = hashes.constBegin(); it != hashes.constEnd(); ++it) {
+        mJournaledHashes.insert(it.key(), it.value());
+    }
+    return hashes.count();
+}
+
+void ProjectJournal::discard(qint64 size)
+{
+    if ((size <= 0) || (!mFilePath.isExistingFile())) {
+        return;
+    }
+
+    QByteArray data = FileUtils::readFile(mFilePath); // can throw
+    if (size >= data.size()) {
+        FileUtils::removeFile(mFilePath); // can throw
+    } else {
+        FileUtils::writeFile(mFilePath, data.mid(size)); // can throw
+    }
+}
+
+void ProjectJournal::clear()
+{
+    // the next record must contain all documents again
+    mJournaledHashes.clear();
+    if (mFilePath.isExistingFile()) {
+        FileUtils::removeFile(mFilePath); // can throw
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+FilePath ProjectJournal::getFilePath(const FilePath& projectDir) noexcept
+{
+    return projectDir.getPathTo(".journal~");
+}
+
+int ProjectJournal::replay(const FilePath& projectDir)
+{
+    FilePath journalFilePath = getFilePath(projectDir);
+    if (!journalFilePath.isExistingFile()) {
+        return 0;
+    }
+
+    QHash<QString, QByteArray> documents =
+        readRecords(FileUtils::readFile(journalFilePath)); // can throw
+    int count = 0;
+    for (auto it = documents.constBegin(); it != documents.constEnd(); ++it) {
+        FilePath filepath = FilePath::fromRelative(projectDir, it.key());
+        if ((!filepath.isValid()) || (!filepath.isLocatedInDir(projectDir))) {
+            qWarning() << "Ignoring invalid file path in project journal:" << it.key();
+            continue;
+        }
+        FileUtils::writeFile(FilePath(filepath.toStr() % '~'), it.value()); // can throw
+        ++count;
+    }
+    qDebug() << "Restored" << count << "documents from the project journal.";
+    return count;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QHash<QString, QByteArray> ProjectJournal::readRecords(const QByteArray& data) noexcept
+{
+    QHash<QString, QByteArray> documents; // the latest record of every file wins
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_2);
+    while (!stream.atEnd()) {
+        quint32 magic = 0;
+        QString relPath;
+        QByteArray compressed;
+        quint16 checksum = 0;
+        stream >> magic >> relPath >> compressed >> checksum;
+        if ((stream.status() != QDataStream::Ok) || (magic != sRecordMagic) ||
+            (checksum != qChecksum(compressed.constData(),
+                                   static_cast<uint>(compressed.size())))) {
+            qWarning() << "Ignoring the incomplete end of the project journal.";
+            break;
+        }
+        QByteArray content = qUncompress(compressed);
+        if (content.isEmpty()) {
+            qWarning() << "Ignoring the corrupt end of the project journal.";
+            break;
+        }
+        documents.insert(relPath, content);
+    }
+    return documents;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,164 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_PROJECTJOURNAL_H
+#define LIBREPCB_PROJECT_PROJECTJOURNAL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class ProjectSnapshot;
+
+/*****************************************************************************************
+ *  Class ProjectJournal
+ ****************************************************************************************/
+
+/**
+ * @brief An append-only journal of modified documents to restore a project after a crash
+ *
+ * After every committed modification of a project, the documents of the circuit, the
+ * schematics and the boards which have changed since the last record are appended to
+ * the journal file (see #append()). This is much cheaper than writing all backup files
+ * (`*~`) of the project, so it can be done after every edit instead of periodically.
+ *
+ * When a project is restored after a crash, #replay() writes the latest journaled
+ * version of every document to its backup file before the project is opened, so the
+ * restored project contains all modifications up to the last edit. Modifications of
+ * other files (e.g. the project settings) are still only contained in the periodic
+ * autosave, which also allows to #discard() the records it contains.
+ *
+ * Incomplete records at the end of the file (e.g. from a crash while appending) are
+ * ignored.
+ */
+class ProjectJournal final
+{
+        Q_DECLARE_TR_FUNCTIONS(ProjectJournal)
+
+    public:
+
+        // Constructors / Destructor
+        ProjectJournal() = delete;
+        ProjectJournal(const ProjectJournal& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * An existing journal file is kept, new records are appended to it.
+         *
+         * @param projectDir    The directory of the project
+         */
+        explicit ProjectJournal(const FilePath& projectDir) noexcept;
+        ~ProjectJournal() noexcept;
+
+        // Getters
+        const FilePath& getFilePath() const noexcept {return mFilePath;}
+
+        /**
+         * @brief Get the current size of the journal file in bytes (0 if not existing)
+         */
+        qint64 getSize() const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Append all documents which have changed since the last call
+         *
+         * The first call appends all documents of the snapshot.
+         *
+         * @param snapshot  The current state of the project
+         *
+         * @return The count of appended documents
+         *
+         * @throw Exception If the journal file could not be written
+         */
+        int append(const ProjectSnapshot& snapshot);
+
+        /**
+         * @brief Remove the records at the beginning of the journal file
+         *
+         * This is used after an autosave, which contains all these records.
+         *
+         * @param size      The size of the journal at the time the autosave was
+         *                  serialized (see #getSize())
+         *
+         * @throw Exception If the journal file could not be written
+         */
+        void discard(qint64 size);
+
+        /**
+         * @brief Remove the journal file (e.g. after the project was saved)
+         *
+         * @throw Exception If the journal file could not be removed
+         */
+        void clear();
+
+        // Operator Overloadings
+        ProjectJournal& operator=(const ProjectJournal& rhs) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Get the path of the journal file of a project
+         */
+        static FilePath getFilePath(const FilePath& projectDir) noexcept;
+
+        /**
+         * @brief Write the latest journaled version of every document to its backup file
+         *
+         * @param projectDir    The directory of the project to restore
+         *
+         * @return The count of restored documents (0 if there is no journal)
+         *
+         * @throw Exception If the journal could not be read or a backup file could not
+         *                  be written
+         */
+        static int replay(const FilePath& projectDir);
+
+
+    private: // Methods
+        static QHash<QString, QByteArray> readRecords(const QByteArray& data) noexcept;
+
+
+    private: // Data
+        FilePath mProjectDir;
+        FilePath mFilePath;
+        QHash<FilePath, QByteArray> mJournaledHashes; ///< documents contained in the journal
+
+        static const quint32 sRecordMagic = 0x4C504A52; ///< "LPJR"
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_PROJECTJOURNAL_H
@@ -0,0 +1,88 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "projectsnapshot.h"
+#include "project.h"
+#include "circuit/circuit.h"
+#include "schematics/schematic.h"
+#include "boards/board.h"
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/domelement.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ProjectSnapshot::ProjectSnapshot(const Project& project, const ProjectSnapshot& previous)
+{
+    QList<Document> previousCircuit;
+    if (!previous.isEmpty()) {
+        previousCircuit.append(previous.mCircuit);
+    }
+    mCircuit = createDocument(project.getCircuit(), "circuit", Uuid(), QString(),
+                              project.getPath().getPathTo("core/circuit.xml"),
+                              previousCircuit); // can throw
+    foreach (const Schematic* schematic, project.getSchematics()) {
+        mSchematics.append(createDocument(*schematic, "schematic", schematic->getUuid(),
+                                          schematic->getName(), schematic->getFilePath(),
+                                          previous.mSchematics)); // can throw
+    }
+    foreach (const Board* board, project.getBoards()) {
+        mBoards.append(createDocument(*board, "board", board->getUuid(), board->getName(),
+                                      board->getFilePath(), previous.mBoards)); // can throw
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+ProjectSnapshot::Document ProjectSnapshot::createDocument(const SerializableObject& object,
+    const QString& rootName, const Uuid& uuid, const QString& name, const FilePath& filepath,
+    const QList<Document>& previous)
+{
+    QSharedPointer<DomDocument> dom(new DomDocument(
+        *object.serializeToDomElement(rootName))); // can throw
+    QByteArray hash = QCryptographicHash::hash(dom->toBinary(), QCryptographicHash::Md5);
+
+    // share the document with the previous snapshot if it was not modified
+    foreach (const Document& doc, previous) {
+        if ((doc.uuid == uuid) && (doc.hash == hash)) {
+            return Document{uuid, name, filepath, doc.dom, hash};
+        }
+    }
+    return Document{uuid, name, filepath, dom, hash};
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,130 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_PROJECTSNAPSHOT_H
+#define LIBREPCB_PROJECT_PROJECTSNAPSHOT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class DomDocument;
+class SerializableObject;
+
+namespace project {
+
+class Project;
+
+/*****************************************************************************************
+ *  Class ProjectSnapshot
+ ****************************************************************************************/
+
+/**
+ * @brief The ProjectSnapshot class is a read-only copy of the circuit, the schematics
+ *        and the boards of a librepcb::project::Project
+ *
+ * The project itself may only be accessed from the thread it lives in, i.e. usually the
+ * GUI thread. A snapshot instead contains the serialized DOM trees of the circuit, the
+ * schematics and the boards (i.e. exactly what would be written to the files), which
+ * are never modified after the snapshot was created. So it can be passed to and read
+ * from any other thread without locking, while the user keeps editing the project.
+ * Copying a snapshot is cheap since all documents are shared.
+ *
+ * When a new snapshot is created from a previous one, all documents whose content did
+ * not change are taken from the previous snapshot, so consecutive snapshots share the
+ * unmodified documents instead of keeping copies of them.
+ *
+ * @see librepcb::project::editor::ProjectEditor::getSnapshot(),
+ *      librepcb::project::CircuitSnapshot
+ */
+class ProjectSnapshot final
+{
+    public:
+
+        // Types
+
+        /// A serialized object (circuit, schematic or board)
+        struct Document {
+            Uuid uuid;              ///< the UUID of the schematic or board (null for the circuit)
+            QString name;           ///< the name of the schematic or board
+            FilePath filepath;      ///< the file the object is saved to
+            QSharedPointer<const DomDocument> dom;
+            QByteArray hash;        ///< hash of the content, to find unmodified documents
+        };
+
+        // Constructors / Destructor
+        ProjectSnapshot() noexcept {}
+        ProjectSnapshot(const ProjectSnapshot& other) = default;
+
+        /**
+         * @brief Create a snapshot of the current state of a project
+         *
+         * @warning This constructor must be called in the thread of the project!
+         *
+         * @param project   The project to copy
+         * @param previous  A previous snapshot of the same project (may be empty). All
+         *                  unmodified documents are shared with this snapshot.
+         *
+         * @throw Exception If the project could not be serialized
+         */
+        ProjectSnapshot(const Project& project, const ProjectSnapshot& previous);
+        ~ProjectSnapshot() noexcept {}
+
+        // Getters
+        bool isEmpty() const noexcept {return mCircuit.dom.isNull();}
+        const Document& getCircuit() const noexcept {return mCircuit;}
+        const QList<Document>& getSchematics() const noexcept {return mSchematics;}
+        const QList<Document>& getBoards() const noexcept {return mBoards;}
+
+        // Operator Overloadings
+        ProjectSnapshot& operator=(const ProjectSnapshot& rhs) = default;
+
+
+    private:
+
+        /**
+         * @brief Serialize an object, or take its document of the previous snapshot if
+         *        its content is still the same
+         */
+        static Document createDocument(const SerializableObject& object,
+                                       const QString& rootName, const Uuid& uuid,
+                                       const QString& name, const FilePath& filepath,
+                                       const QList<Document>& previous);
+
+        Document mCircuit;
+        QList<Document> mSchematics;
+        QList<Document> mBoards;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_PROJECTSNAPSHOT_H
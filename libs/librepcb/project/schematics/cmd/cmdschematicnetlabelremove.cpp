@@ -24,6 +24,8 @@
 #include "cmdschematicnetlabelremove.h"
 #include "../schematic.h"
 #include "../items/si_netlabel.h"
+#include "../graphicsitems/sgi_netlabel.h"
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -38,7 +40,7 @@ namespace project {
 CmdSchematicNetLabelRemove::CmdSchematicNetLabelRemove(Schematic& schematic,
                                                        SI_NetLabel& netlabel) noexcept :
     UndoCommand(tr("Remove netlabel")),
-    mSchematic(schematic), mNetLabel(netlabel)
+    mSchematic(schematic), mNetLabel(netlabel), mRemovedItemMemoryUsage(0)
 {
 }
 
@@ -46,12 +48,30 @@ CmdSchematicNetLabelRemove::~CmdSchematicNetLabelRemove() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdSchematicNetLabelRemove::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    if (isCurrentlyExecuted()) {
+        // the removed netlabel (inclusive its graphics item) is kept alive by this command
+        size += mRemovedItemMemoryUsage;
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
 bool CmdSchematicNetLabelRemove::performExecute()
 {
+    // the removed netlabel is not modified anymore, so calculate its size only once
+    mRemovedItemMemoryUsage = sizeof(SI_NetLabel) + sizeof(SGI_NetLabel)
+                            + MemoryReport::getPathSize(mNetLabel.getGrabAreaScenePx());
+
     performRedo(); // can throw
 
     return true;
@@ -50,6 +50,11 @@ class CmdSchematicNetLabelRemove final : public UndoCommand
         CmdSchematicNetLabelRemove(Schematic& schematic, SI_NetLabel& netlabel) noexcept;
         ~CmdSchematicNetLabelRemove() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
 
     private:
 
@@ -69,6 +74,7 @@ class CmdSchematicNetLabelRemove final : public UndoCommand
 
         Schematic& mSchematic;
         SI_NetLabel& mNetLabel;
+        qint64 mRemovedItemMemoryUsage; ///< calculated once on execution
 };
 
 /*****************************************************************************************
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/undocommand.h>
+#include <librepcb/common/objectpool.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -43,7 +44,8 @@ class SI_NetLine;
 /**
  * @brief The CmdSchematicNetLineAdd class
  */
-class CmdSchematicNetLineAdd final : public UndoCommand
+class CmdSchematicNetLineAdd final : public UndoCommand,
+                                     public PooledObject<CmdSchematicNetLineAdd>
 {
     public:
 
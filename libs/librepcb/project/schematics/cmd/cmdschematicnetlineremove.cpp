@@ -24,6 +24,8 @@
 #include "cmdschematicnetlineremove.h"
 #include "../schematic.h"
 #include "../items/si_netline.h"
+#include "../graphicsitems/sgi_netline.h"
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -37,7 +39,7 @@ namespace project {
 
 CmdSchematicNetLineRemove::CmdSchematicNetLineRemove(SI_NetLine& netline) noexcept :
     UndoCommand(tr("Remove netline")),
-    mSchematic(netline.getSchematic()), mNetLine(netline)
+    mSchematic(netline.getSchematic()), mNetLine(netline), mRemovedItemMemoryUsage(0)
 {
 }
 
@@ -45,12 +47,30 @@ CmdSchematicNetLineRemove::~CmdSchematicNetLineRemove() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdSchematicNetLineRemove::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    if (isCurrentlyExecuted()) {
+        // the removed netline (inclusive its graphics item) is kept alive by this command
+        size += mRemovedItemMemoryUsage;
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
 bool CmdSchematicNetLineRemove::performExecute()
 {
+    // the removed netline is not modified anymore, so calculate its size only once
+    mRemovedItemMemoryUsage = sizeof(SI_NetLine) + sizeof(SGI_NetLine)
+                            + MemoryReport::getPathSize(mNetLine.getGrabAreaScenePx());
+
     performRedo(); // can throw
 
     return true;
@@ -50,6 +50,11 @@ class CmdSchematicNetLineRemove final : public UndoCommand
         explicit CmdSchematicNetLineRemove(SI_NetLine& netline) noexcept;
         ~CmdSchematicNetLineRemove() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
 
     private:
 
@@ -69,6 +74,7 @@ class CmdSchematicNetLineRemove final : public UndoCommand
 
         Schematic& mSchematic;
         SI_NetLine& mNetLine;
+        qint64 mRemovedItemMemoryUsage; ///< calculated once on execution
 };
 
 /*****************************************************************************************
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/undocommand.h>
+#include <librepcb/common/objectpool.h>
 #include <librepcb/common/units/point.h>
 
 /*****************************************************************************************
@@ -45,7 +46,8 @@ class SI_NetPoint;
 /**
  * @brief The CmdSchematicNetPointAdd class
  */
-class CmdSchematicNetPointAdd final : public UndoCommand
+class CmdSchematicNetPointAdd final : public UndoCommand,
+                                      public PooledObject<CmdSchematicNetPointAdd>
 {
     public:
 
@@ -24,6 +24,8 @@
 #include "cmdschematicnetpointremove.h"
 #include "../schematic.h"
 #include "../items/si_netpoint.h"
+#include "../graphicsitems/sgi_netpoint.h"
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -37,7 +39,7 @@ namespace project {
 
 CmdSchematicNetPointRemove::CmdSchematicNetPointRemove(SI_NetPoint& netpoint) noexcept :
     UndoCommand(tr("Remove netpoint")),
-    mSchematic(netpoint.getSchematic()), mNetPoint(netpoint)
+    mSchematic(netpoint.getSchematic()), mNetPoint(netpoint), mRemovedItemMemoryUsage(0)
 {
 }
 
@@ -45,12 +47,30 @@ CmdSchematicNetPointRemove::~CmdSchematicNetPointRemove() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdSchematicNetPointRemove::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    if (isCurrentlyExecuted()) {
+        // the removed netpoint (inclusive its graphics item) is kept alive by this command
+        size += mRemovedItemMemoryUsage;
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
 bool CmdSchematicNetPointRemove::performExecute()
 {
+    // the removed netpoint is not modified anymore, so calculate its size only once
+    mRemovedItemMemoryUsage = sizeof(SI_NetPoint) + sizeof(SGI_NetPoint)
+                            + MemoryReport::getPathSize(mNetPoint.getGrabAreaScenePx());
+
     performRedo(); // can throw
 
     return true;
@@ -50,6 +50,11 @@ class CmdSchematicNetPointRemove final : public UndoCommand
         explicit CmdSchematicNetPointRemove(SI_NetPoint& netpoint) noexcept;
         ~CmdSchematicNetPointRemove() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
 
     private:
 
@@ -69,6 +74,7 @@ class CmdSchematicNetPointRemove final : public UndoCommand
 
         Schematic& mSchematic;
         SI_NetPoint& mNetPoint;
+        qint64 mRemovedItemMemoryUsage; ///< calculated once on execution
 };
 
 /*****************************************************************************************
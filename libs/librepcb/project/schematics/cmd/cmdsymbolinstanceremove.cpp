@@ -24,6 +24,10 @@
 #include "cmdsymbolinstanceremove.h"
 #include "../schematic.h"
 #include "../items/si_symbol.h"
+#include "../items/si_symbolpin.h"
+#include "../graphicsitems/sgi_symbol.h"
+#include "../graphicsitems/sgi_symbolpin.h"
+#include <librepcb/common/memoryreport.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -37,7 +41,7 @@ namespace project {
 
 CmdSymbolInstanceRemove::CmdSymbolInstanceRemove(Schematic& schematic, SI_Symbol& symbol) noexcept :
     UndoCommand(tr("Remove symbol")),
-    mSchematic(schematic), mSymbol(symbol)
+    mSchematic(schematic), mSymbol(symbol), mRemovedItemMemoryUsage(0)
 {
 }
 
@@ -45,12 +49,35 @@ CmdSymbolInstanceRemove::~CmdSymbolInstanceRemove() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+qint64 CmdSymbolInstanceRemove::getApproximateMemoryUsage() const noexcept
+{
+    qint64 size = UndoCommand::getApproximateMemoryUsage();
+    if (isCurrentlyExecuted()) {
+        // the removed symbol (inclusive its pins and their graphics items) is kept alive
+        // by this command
+        size += mRemovedItemMemoryUsage;
+    }
+    return size;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
 bool CmdSymbolInstanceRemove::performExecute()
 {
+    // the removed symbol is not modified anymore, so calculate its size only once
+    mRemovedItemMemoryUsage = sizeof(SI_Symbol) + sizeof(SGI_Symbol)
+                            + MemoryReport::getPathSize(mSymbol.getGrabAreaScenePx());
+    foreach (const SI_SymbolPin* pin, mSymbol.getPins()) {
+        mRemovedItemMemoryUsage += sizeof(SI_SymbolPin) + sizeof(SGI_SymbolPin)
+                                 + MemoryReport::getPathSize(pin->getGrabAreaScenePx());
+    }
+
     performRedo(); // can throw
 
     return true;
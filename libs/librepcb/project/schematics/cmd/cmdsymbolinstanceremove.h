@@ -50,6 +50,11 @@ class CmdSymbolInstanceRemove final : public UndoCommand
         CmdSymbolInstanceRemove(Schematic& schematic, SI_Symbol& symbol) noexcept;
         ~CmdSymbolInstanceRemove() noexcept;
 
+        // Getters
+
+        /// @copydoc UndoCommand::getApproximateMemoryUsage()
+        qint64 getApproximateMemoryUsage() const noexcept override;
+
 
     private:
 
@@ -69,6 +74,7 @@ class CmdSymbolInstanceRemove final : public UndoCommand
 
         Schematic& mSchematic;
         SI_Symbol& mSymbol;
+        qint64 mRemovedItemMemoryUsage; ///< calculated once on execution
 };
 
 /*****************************************************************************************
@@ -0,0 +1,86 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdsymbolinstancesadd.h"
+#include "../items/si_symbol.h"
+#include "../schematic.h"
+#include "../../circuit/componentinstance.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdSymbolInstancesAdd::CmdSymbolInstancesAdd(Schematic& schematic,
+                                             const QList<Item>& items) noexcept :
+    UndoCommand(tr("Add symbol instances")),
+    mSchematic(schematic), mItems(items)
+{
+}
+
+CmdSymbolInstancesAdd::~CmdSymbolInstancesAdd() noexcept
+{
+    if (!isCurrentlyExecuted()) {
+        qDeleteAll(mSymbolInstances);
+    }
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdSymbolInstancesAdd::performExecute()
+{
+    // create all symbol instances (they are deleted in the destructor if adding fails)
+    mSymbolInstances.reserve(mItems.count());
+    foreach (const Item& item, mItems) {
+        mSymbolInstances.append(new SI_Symbol(mSchematic, *item.component, item.symbolItem,
+                                              item.position, item.rotation)); // can throw
+    }
+
+    performRedo(); // can throw
+
+    return (!mSymbolInstances.isEmpty());
+}
+
+void CmdSymbolInstancesAdd::performUndo()
+{
+    mSchematic.removeSymbols(mSymbolInstances); // can throw
+}
+
+void CmdSymbolInstancesAdd::performRedo()
+{
+    mSchematic.addSymbols(mSymbolInstances); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
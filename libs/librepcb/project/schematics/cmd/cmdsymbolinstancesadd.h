@@ -0,0 +1,103 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CMDSYMBOLINSTANCESADD_H
+#define LIBREPCB_PROJECT_CMDSYMBOLINSTANCESADD_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/undocommand.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Schematic;
+class ComponentInstance;
+class SI_Symbol;
+
+/*****************************************************************************************
+ *  Class CmdSymbolInstancesAdd
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdSymbolInstancesAdd class adds many symbol instances to a schematic at once
+ *
+ * In contrast to a group of librepcb::project::CmdSymbolInstanceAdd commands, all
+ * symbols are added with librepcb::project::Schematic::addSymbols(), i.e. in one bulk
+ * update of the schematic.
+ */
+class CmdSymbolInstancesAdd final : public UndoCommand
+{
+    public:
+
+        // Types
+        struct Item {
+            ComponentInstance* component;
+            Uuid symbolItem;
+            Point position;
+            Angle rotation;
+        };
+
+        // Constructors / Destructor
+        CmdSymbolInstancesAdd(Schematic& schematic, const QList<Item>& items) noexcept;
+        ~CmdSymbolInstancesAdd() noexcept;
+
+        // Getters
+        const QList<SI_Symbol*>& getSymbolInstances() const noexcept {return mSymbolInstances;}
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+
+        // Private Member Variables
+
+        // Attributes from the constructor
+        Schematic& mSchematic;
+        QList<Item> mItems;
+
+        /// @brief The created symbol instances
+        QList<SI_Symbol*> mSymbolInstances;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDSYMBOLINSTANCESADD_H
@@ -33,7 +33,8 @@ namespace project {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-SGI_Base::SGI_Base() noexcept
+SGI_Base::SGI_Base(SI_Base& item) noexcept :
+    QGraphicsItem(), mSchematicItem(item)
 {
 
 }
@@ -43,6 +44,21 @@ SGI_Base::~SGI_Base() noexcept
 
 }
 
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+bool SGI_Base::isPrinting(const QPainter& painter) noexcept
+{
+    switch (painter.device()->devType()) {
+        case QInternal::Printer:
+        case QInternal::Picture:
+            return true;
+        default:
+            return false;
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -33,6 +33,8 @@
 namespace librepcb {
 namespace project {
 
+class SI_Base;
+
 /*****************************************************************************************
  *  Class SGI_Base
  ****************************************************************************************/
@@ -45,16 +47,38 @@ class SGI_Base : public QGraphicsItem
     public:
 
         // Constructors / Destructor
-        explicit SGI_Base() noexcept;
+        explicit SGI_Base(SI_Base& item) noexcept;
         virtual ~SGI_Base() noexcept;
 
+        // Getters
+
+        /**
+         * @brief Get the schematic item which is represented by this graphics item
+         *
+         * This allows to find schematic items through the spatial index of the graphics
+         * scene (see librepcb::project::Schematic::setSelectionRect()).
+         */
+        SI_Base& getSchematicItem() const noexcept {return mSchematicItem;}
+
+        // Static Methods
+
+        /**
+         * @brief Check whether a painter paints a printout instead of the screen
+         *
+         * Besides printers, this is also true for QPicture recordings which are used
+         * for the PDF export (see librepcb::project::SchematicPdfExport).
+         */
+        static bool isPrinting(const QPainter& painter) noexcept;
+
 
     private:
 
         // make some methods inaccessible...
-        //SGI_Base() = delete;
+        SGI_Base() = delete;
         SGI_Base(const SGI_Base& other) = delete;
         SGI_Base& operator=(const SGI_Base& rhs) = delete;
+
+        SI_Base& mSchematicItem;
 };
 
 /*****************************************************************************************
@@ -22,7 +22,6 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
-#include <QPrinter>
 #include "sgi_netlabel.h"
 #include "../items/si_netlabel.h"
 #include "../schematic.h"
@@ -43,7 +42,7 @@ QVector<QLineF> SGI_NetLabel::sOriginCrossLines;
  ****************************************************************************************/
 
 SGI_NetLabel::SGI_NetLabel(SI_NetLabel& netlabel) noexcept :
-    SGI_Base(), mNetLabel(netlabel)
+    SGI_Base(netlabel), mNetLabel(netlabel)
 {
     setZValue(Schematic::ZValue_NetLabels);
 
@@ -101,7 +100,7 @@ void SGI_NetLabel::updateCacheAndRepaint() noexcept
 void SGI_NetLabel::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
     Q_UNUSED(widget);
-    bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
+    bool deviceIsPrinter = isPrinting(*painter);
     const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
 
     bool highlight = mNetLabel.isSelected() || mNetLabel.getNetSignal().isHighlighted();
@@ -42,7 +42,7 @@ namespace project {
  ****************************************************************************************/
 
 SGI_NetLine::SGI_NetLine(SI_NetLine& netline) noexcept :
-    SGI_Base(), mNetLine(netline), mLayer(nullptr)
+    SGI_Base(netline), mNetLine(netline), mLayer(nullptr)
 {
     setZValue(Schematic::ZValue_NetLines);
 
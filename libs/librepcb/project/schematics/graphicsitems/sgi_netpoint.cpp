@@ -22,7 +22,6 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
-#include <QPrinter>
 #include "sgi_netpoint.h"
 #include "../items/si_netpoint.h"
 #include "../schematic.h"
@@ -43,7 +42,7 @@ QRectF SGI_NetPoint::sBoundingRect;
  ****************************************************************************************/
 
 SGI_NetPoint::SGI_NetPoint(SI_NetPoint& netpoint) noexcept :
-    SGI_Base(), mNetPoint(netpoint), mLayer(nullptr)
+    SGI_Base(netpoint), mNetPoint(netpoint), mLayer(nullptr)
 {
     setZValue(Schematic::ZValue_VisibleNetPoints);
 
@@ -85,7 +84,7 @@ void SGI_NetPoint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opti
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
-    const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
+    const bool deviceIsPrinter = isPrinting(*painter);
     bool highlight = mNetPoint.isSelected() || mNetPoint.getNetSignal().isHighlighted();
 
     if (mLayer->isVisible() && mIsVisibleJunction) {
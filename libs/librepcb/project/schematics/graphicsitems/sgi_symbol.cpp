@@ -22,7 +22,6 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
-#include <QPrinter>
 #include "sgi_symbol.h"
 #include "../items/si_symbol.h"
 #include "../schematic.h"
@@ -43,7 +42,7 @@ namespace project {
  ****************************************************************************************/
 
 SGI_Symbol::SGI_Symbol(SI_Symbol& symbol) noexcept :
-    SGI_Base(), mSymbol(symbol), mLibSymbol(symbol.getLibSymbol())
+    SGI_Base(symbol), mSymbol(symbol), mLibSymbol(symbol.getLibSymbol())
 {
     setZValue(Schematic::ZValue_Symbols);
 
@@ -66,32 +65,40 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept
 {
     prepareGeometryChange();
 
-    mBoundingRect = QRectF();
-    mShape = QPainterPath();
-    mShape.setFillRule(Qt::WindingFill);
+    // cross rect and polygons (shared with all instances of the library symbol, the
+    // position and rotation is applied by the transformation of the item)
+    mSharedGeometry = getSharedGeometry();
+    mBoundingRect = mSharedGeometry->boundingRect;
+    mShape = mSharedGeometry->shape;
 
-    // cross rect
-    QRectF crossRect(-4, -4, 8, 8);
-    mBoundingRect = mBoundingRect.united(crossRect);
-    mShape.addRect(crossRect);
+    // texts (only laid out again if the displayed text or its orientation has changed,
+    // e.g. not when the item was just moved)
+    QHash<const Text*, CachedTextProperties_t> oldTextProperties;
+    oldTextProperties.swap(mCachedTextProperties);
+    for (const Text& text : mLibSymbol.getTexts()) {
+        // get the text to display
+        QString displayText = text.getText();
+        mSymbol.replaceVariablesWithAttributes(displayText, true);
 
-    // polygons
-    for (const Polygon& polygon : mLibSymbol.getPolygons()) {
-        QPainterPath polygonPath = polygon.toQPainterPathPx();
-        qreal w = polygon.getLineWidth().toPx() / 2;
-        mBoundingRect = mBoundingRect.united(polygonPath.boundingRect().adjusted(-w, -w, w, w));
-        if (polygon.isGrabArea()) mShape = mShape.united(polygonPath);
-    }
+        // check rotation
+        Angle absAngle = text.getRotation() + mSymbol.getRotation();
+        absAngle.mapTo180deg();
+        bool rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
+
+        // reuse the cached properties if nothing relevant has changed
+        auto oldProps = oldTextProperties.constFind(&text);
+        if ((oldProps != oldTextProperties.constEnd()) && (oldProps->text == displayText)
+            && (oldProps->rotate180 == rotate180))
+        {
+            mBoundingRect = mBoundingRect.united(oldProps->boundingRect);
+            mCachedTextProperties.insert(&text, oldProps.value());
+            continue;
+        }
 
-    // texts
-    mCachedTextProperties.clear();
-    for (const Text& text : mLibSymbol.getTexts()) {
         // create static text properties
         CachedTextProperties_t props;
-
-        // get the text to display
-        props.text = text.getText();
-        mSymbol.replaceVariablesWithAttributes(props.text, true);
+        props.text = displayText;
+        props.rotate180 = rotate180;
 
         // calculate font metrics
         props.fontPixelSize = qCeil(text.getHeight().toPx());
@@ -103,11 +110,6 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept
         QRectF scaledTextRect = QRectF(props.textRect.topLeft() * props.scaleFactor,
                                        props.textRect.bottomRight() * props.scaleFactor);
 
-        // check rotation
-        Angle absAngle = text.getRotation() + mSymbol.getRotation();
-        absAngle.mapTo180deg();
-        props.rotate180 = (absAngle <= -Angle::deg90() || absAngle > Angle::deg90());
-
         // calculate text position
         scaledTextRect.translate(text.getPosition().toPxQPointF());
 
@@ -118,6 +120,7 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept
             props.flags = text.getAlign().toQtAlign();
 
         // calculate text bounding rect
+        props.boundingRect = scaledTextRect;
         mBoundingRect = mBoundingRect.united(scaledTextRect);
         props.textRect = QRectF(scaledTextRect.topLeft() / props.scaleFactor,
                                 scaledTextRect.bottomRight() / props.scaleFactor);
@@ -127,6 +130,10 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept
                                     -props.textRect.width(), -props.textRect.height()).normalized();
         }
 
+        // lay out the text only once (shared with all identical texts)
+        props.layout = TextLayoutCache::get(mFont, props.text, props.flags);
+        props.layoutOffset = props.textRect.topLeft() - props.layout.boundingRect.topLeft();
+
         // save properties
         mCachedTextProperties.insert(&text, props);
     }
@@ -144,7 +151,7 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
 
     const GraphicsLayer* layer = 0;
     const bool selected = mSymbol.isSelected();
-    const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
+    const bool deviceIsPrinter = isPrinting(*painter);
     const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
 
     // draw all polygons
@@ -213,10 +220,9 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
         if (props.rotate180) painter->rotate(180);
         if ((deviceIsPrinter) || (lod * text.getHeight().toPx() > 8))
         {
-            // draw text
+            // draw the cached text layout
             painter->setPen(QPen(layer->getColor(selected), 0));
-            painter->setFont(mFont);
-            painter->drawText(props.textRect, props.flags, props.text);
+            TextLayoutCache::draw(*painter, props.layout, props.layoutOffset);
         }
         else
         {
@@ -282,6 +288,45 @@ GraphicsLayer* SGI_Symbol::getLayer(const QString& name) const noexcept
     return mSymbol.getSchematic().getProject().getLayers().getLayer(name);
 }
 
+std::shared_ptr<const SGI_Symbol::SharedGeometry_t> SGI_Symbol::getSharedGeometry() const noexcept
+{
+    // Entries are only referenced weakly, i.e. they are released together with the
+    // last graphics item which uses them.
+    static QHash<const library::Symbol*, std::weak_ptr<const SharedGeometry_t>> sCache;
+
+    if (std::shared_ptr<const SharedGeometry_t> geometry = sCache.value(&mLibSymbol).lock()) {
+        return geometry;
+    }
+
+    std::shared_ptr<SharedGeometry_t> geometry = std::make_shared<SharedGeometry_t>();
+    geometry->shape.setFillRule(Qt::WindingFill);
+
+    // cross rect
+    QRectF crossRect(-4, -4, 8, 8);
+    geometry->boundingRect = geometry->boundingRect.united(crossRect);
+    geometry->shape.addRect(crossRect);
+
+    // polygons
+    for (const Polygon& polygon : mLibSymbol.getPolygons()) {
+        QPainterPath polygonPath = polygon.toQPainterPathPx();
+        qreal w = polygon.getLineWidth().toPx() / 2;
+        geometry->boundingRect = geometry->boundingRect.united(
+            polygonPath.boundingRect().adjusted(-w, -w, w, w));
+        if (polygon.isGrabArea()) geometry->shape = geometry->shape.united(polygonPath);
+    }
+
+    // remove expired entries before adding the new one
+    for (auto it = sCache.begin(); it != sCache.end();) {
+        if (it.value().expired()) {
+            it = sCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    sCache.insert(&mLibSymbol, geometry);
+    return geometry;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -23,8 +23,10 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
+#include <librepcb/common/graphics/textlayoutcache.h>
 #include "sgi_base.h"
 
 /*****************************************************************************************
@@ -78,12 +80,17 @@ class SGI_Symbol final : public SGI_Base
         SGI_Symbol(const SGI_Symbol& other) = delete;
         SGI_Symbol& operator=(const SGI_Symbol& rhs) = delete;
 
-        // Private Methods
-        GraphicsLayer* getLayer(const QString& name) const noexcept;
-
-
         // Types
 
+        /**
+         * @brief Geometry which only depends on the library symbol, shared between all
+         *        instances of the same library symbol
+         */
+        struct SharedGeometry_t {
+            QRectF boundingRect; ///< origin cross and polygons (incl. line width)
+            QPainterPath shape;  ///< origin cross and grab area polygons
+        };
+
         struct CachedTextProperties_t {
             QString text;
             int fontPixelSize;
@@ -91,9 +98,17 @@ class SGI_Symbol final : public SGI_Base
             bool rotate180;
             int flags;
             QRectF textRect;    // not scaled
+            QRectF boundingRect; // scaled, part of the bounding rect of the item
+            TextLayoutCache::Layout layout;
+            QPointF layoutOffset; // position of the layout within textRect
         };
 
 
+        // Private Methods
+        GraphicsLayer* getLayer(const QString& name) const noexcept;
+        std::shared_ptr<const SharedGeometry_t> getSharedGeometry() const noexcept;
+
+
         // General Attributes
         SI_Symbol& mSymbol;
         const library::Symbol& mLibSymbol;
@@ -102,6 +117,7 @@ class SGI_Symbol final : public SGI_Base
         // Cached Attributes
         QRectF mBoundingRect;
         QPainterPath mShape;
+        std::shared_ptr<const SharedGeometry_t> mSharedGeometry;
         QHash<const Text*, CachedTextProperties_t> mCachedTextProperties;
 };
 
@@ -22,7 +22,6 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
-#include <QPrinter>
 #include "sgi_symbolpin.h"
 #include "../items/si_symbolpin.h"
 #include "../items/si_symbol.h"
@@ -47,7 +46,7 @@ namespace project {
  ****************************************************************************************/
 
 SGI_SymbolPin::SGI_SymbolPin(SI_SymbolPin& pin) noexcept :
-    SGI_Base(), mPin(pin), mLibPin(pin.getLibPin())
+    SGI_Base(pin), mPin(pin), mLibPin(pin.getLibPin())
 {
     setZValue(Schematic::ZValue_Symbols);
     setToolTip(mLibPin.getName());
@@ -117,7 +116,7 @@ void SGI_SymbolPin::updateCacheAndRepaint() noexcept
 void SGI_SymbolPin::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
     Q_UNUSED(widget);
-    const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
+    const bool deviceIsPrinter = isPrinting(*painter);
     const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
 
     const NetSignal* netsignal = mPin.getCompSigInstNetSignal();
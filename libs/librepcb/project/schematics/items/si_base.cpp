@@ -38,8 +38,7 @@ namespace project {
  ****************************************************************************************/
 
 SI_Base::SI_Base(Schematic& schematic) noexcept :
-    QObject(&schematic), mSchematic(schematic),
-    mIsAddedToSchematic(false), mIsSelected(false)
+    mSchematic(schematic), mIsAddedToSchematic(false), mIsSelected(false)
 {
 }
 
@@ -75,20 +74,31 @@ void SI_Base::setSelected(bool selected) noexcept
  *  General Methods
  ****************************************************************************************/
 
-void SI_Base::addToSchematic(GraphicsScene& scene, SGI_Base& item) noexcept
+void SI_Base::addToSchematic(GraphicsScene& scene, SGI_Base* item) noexcept
 {
     Q_ASSERT(!mIsAddedToSchematic);
-    scene.addItem(item);
+    if (item) scene.addItem(*item);
     mIsAddedToSchematic = true;
 }
 
-void SI_Base::removeFromSchematic(GraphicsScene& scene, SGI_Base& item) noexcept
+void SI_Base::removeFromSchematic(GraphicsScene& scene, SGI_Base* item) noexcept
 {
     Q_ASSERT(mIsAddedToSchematic);
-    scene.removeItem(item);
+    if (item) scene.removeItem(*item);
     mIsAddedToSchematic = false;
 }
 
+void SI_Base::addGraphicsItemToScene(GraphicsScene& scene, SGI_Base& item) const noexcept
+{
+    // used for graphics items which are created after adding the item to the schematic
+    if (mIsAddedToSchematic) scene.addItem(item);
+}
+
+bool SI_Base::areGraphicsItemsEnabled() const noexcept
+{
+    return mSchematic.areGraphicsItemsEnabled();
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/graphics/sceneshapecache.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -48,10 +49,8 @@ class SGI_Base;
 /**
  * @brief The Schematic Item Base (SI_Base) class
  */
-class SI_Base : public QObject
+class SI_Base
 {
-        Q_OBJECT
-
     public:
 
         // Types
@@ -86,6 +85,18 @@ class SI_Base : public QObject
         virtual void addToSchematic(GraphicsScene& scene) = 0;
         virtual void removeFromSchematic(GraphicsScene& scene) = 0;
 
+        /**
+         * @brief Create the graphics item(s) of this item (if not already done)
+         *
+         * Graphics items are only created if the schematic has graphics items enabled
+         * (see librepcb#project#Schematic#areGraphicsItemsEnabled()). If the item is
+         * already added to the schematic, the created graphics item(s) are added to the
+         * scene too.
+         *
+         * @param scene     The graphics scene of the schematic
+         */
+        virtual void createGraphicsItems(GraphicsScene& scene) noexcept = 0;
+
         // Operator Overloadings
         SI_Base& operator=(const SI_Base& rhs) = delete;
 
@@ -93,8 +104,20 @@ class SI_Base : public QObject
     protected:
 
         // General Methods
-        void addToSchematic(GraphicsScene& scene, SGI_Base& item) noexcept;
-        void removeFromSchematic(GraphicsScene& scene, SGI_Base& item) noexcept;
+        void addToSchematic(GraphicsScene& scene, SGI_Base* item) noexcept;
+        void removeFromSchematic(GraphicsScene& scene, SGI_Base* item) noexcept;
+        void addGraphicsItemToScene(GraphicsScene& scene, SGI_Base& item) const noexcept;
+        bool areGraphicsItemsEnabled() const noexcept;
+
+        /**
+         * @brief Get the shape of a graphics item in scene coordinates
+         *
+         * This is the cached implementation of #getGrabAreaScenePx(), see
+         * librepcb::SceneShapeCache. It must always be called with the same item.
+         */
+        const QPainterPath& getSceneShapeOfItem(const QGraphicsItem& item) const noexcept {
+            return mSceneShapeCache.getSceneShape(item);
+        }
 
 
     protected:
@@ -107,6 +130,7 @@ class SI_Base : public QObject
         // General Attributes
         bool mIsAddedToSchematic;
         bool mIsSelected;
+        mutable SceneShapeCache mSceneShapeCache; ///< see #getSceneShapeOfItem()
 };
 
 /*****************************************************************************************
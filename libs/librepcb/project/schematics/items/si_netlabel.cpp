@@ -40,6 +40,7 @@ namespace project {
  ****************************************************************************************/
 
 SI_NetLabel::SI_NetLabel(Schematic& schematic, const DomElement& domElement) :
+    QObject(&schematic),
     SI_Base(schematic), mUuid(), mPosition(), mRotation(), mNetSignal(nullptr)
 {
     // read attributes
@@ -58,6 +59,7 @@ SI_NetLabel::SI_NetLabel(Schematic& schematic, const DomElement& domElement) :
 }
 
 SI_NetLabel::SI_NetLabel(Schematic& schematic, NetSignal& netsignal, const Point& position) :
+    QObject(&schematic),
     SI_Base(schematic), mUuid(Uuid::createRandom()), mPosition(position), mRotation(0),
     mNetSignal(&netsignal)
 {
@@ -69,9 +71,9 @@ void SI_NetLabel::init()
     connect(mNetSignal, &NetSignal::nameChanged, this, &SI_NetLabel::netSignalNameChanged);
 
     // create the graphics item
-    mGraphicsItem.reset(new SGI_NetLabel(*this));
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
-    mGraphicsItem->setRotation(-mRotation.toDeg());
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
 
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 }
@@ -100,7 +102,7 @@ void SI_NetLabel::setNetSignal(NetSignal& netsignal) noexcept
         disconnect(mNetSignal, &NetSignal::nameChanged, this, &SI_NetLabel::netSignalNameChanged);
         connect(&netsignal, &NetSignal::nameChanged, this, &SI_NetLabel::netSignalNameChanged);
         mNetSignal = &netsignal;
-        mGraphicsItem->updateCacheAndRepaint();
+        if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
     }
 }
 
@@ -108,7 +110,7 @@ void SI_NetLabel::setPosition(const Point& position) noexcept
 {
     if (position != mPosition) {
         mPosition = position;
-        mGraphicsItem->setPos(mPosition.toPxQPointF());
+        if (mGraphicsItem) mGraphicsItem->setPos(mPosition.toPxQPointF());
     }
 }
 
@@ -116,8 +118,10 @@ void SI_NetLabel::setRotation(const Angle& rotation) noexcept
 {
     if (rotation != mRotation) {
         mRotation = rotation;
-        mGraphicsItem->setRotation(-mRotation.toDeg());
-        mGraphicsItem->updateCacheAndRepaint();
+        if (mGraphicsItem) {
+            mGraphicsItem->setRotation(-mRotation.toDeg());
+            mGraphicsItem->updateCacheAndRepaint();
+        }
     }
 }
 
@@ -132,8 +136,8 @@ void SI_NetLabel::addToSchematic(GraphicsScene& scene)
     }
     mNetSignal->registerSchematicNetLabel(*this); // can throw
     mHighlightChangedConnection = connect(mNetSignal, &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
-    SI_Base::addToSchematic(scene, *mGraphicsItem);
+                                          [this](){if (mGraphicsItem) mGraphicsItem->update();});
+    SI_Base::addToSchematic(scene, mGraphicsItem.data());
 }
 
 void SI_NetLabel::removeFromSchematic(GraphicsScene& scene)
@@ -143,7 +147,7 @@ void SI_NetLabel::removeFromSchematic(GraphicsScene& scene)
     }
     mNetSignal->unregisterSchematicNetLabel(*this); // can throw
     disconnect(mHighlightChangedConnection);
-    SI_Base::removeFromSchematic(scene, *mGraphicsItem);
+    SI_Base::removeFromSchematic(scene, mGraphicsItem.data());
 }
 
 void SI_NetLabel::serialize(DomElement& root) const
@@ -163,13 +167,23 @@ void SI_NetLabel::serialize(DomElement& root) const
 
 QPainterPath SI_NetLabel::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 void SI_NetLabel::setSelected(bool selected) noexcept
 {
     SI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void SI_NetLabel::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
 }
 
 /*****************************************************************************************
@@ -179,13 +193,20 @@ void SI_NetLabel::setSelected(bool selected) noexcept
 void SI_NetLabel::netSignalNameChanged(const QString& newName) noexcept
 {
     Q_UNUSED(newName);
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void SI_NetLabel::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new SGI_NetLabel(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    mGraphicsItem->setRotation(-mRotation.toDeg());
+}
+
 bool SI_NetLabel::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                             return false;
@@ -45,7 +45,7 @@ class NetSignal;
 /**
  * @brief The SI_NetLabel class
  */
-class SI_NetLabel final : public SI_Base, public SerializableObject
+class SI_NetLabel final : public QObject, public SI_Base, public SerializableObject
 {
         Q_OBJECT
 
@@ -80,6 +80,7 @@ class SI_NetLabel final : public SI_Base, public SerializableObject
         const Point& getPosition() const noexcept override {return mPosition;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         SI_NetLabel& operator=(const SI_NetLabel& rhs) = delete;
@@ -93,6 +94,7 @@ class SI_NetLabel final : public SI_Base, public SerializableObject
     private:
 
         void init();
+        void initGraphicsItem() noexcept;
         bool checkAttributesValidity() const noexcept;
 
 
@@ -94,7 +94,9 @@ void SI_NetLine::init()
             tr("SI_NetLine: both endpoints are the same."));
     }
 
-    mGraphicsItem.reset(new SGI_NetLine(*this));
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
     updateLine();
 
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -129,7 +131,7 @@ void SI_NetLine::setWidth(const Length& width) noexcept
     Q_ASSERT(width >= 0);
     if ((width != mWidth) && (width >= 0)) {
         mWidth = width;
-        mGraphicsItem->updateCacheAndRepaint();
+        if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
     }
 }
 
@@ -145,9 +147,7 @@ void SI_NetLine::addToSchematic(GraphicsScene& scene)
     mStartPoint->registerNetLine(*this); // can throw
     auto sg = scopeGuard([&](){mStartPoint->unregisterNetLine(*this);});
     mEndPoint->registerNetLine(*this); // can throw
-    mHighlightChangedConnection = connect(&getNetSignal(), &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
-    SI_Base::addToSchematic(scene, *mGraphicsItem);
+    SI_Base::addToSchematic(scene, mGraphicsItem.data());
     sg.dismiss();
 }
 
@@ -159,15 +159,25 @@ void SI_NetLine::removeFromSchematic(GraphicsScene& scene)
     mEndPoint->unregisterNetLine(*this); // can throw
     auto sg = scopeGuard([&](){mEndPoint->registerNetLine(*this);});
     mStartPoint->unregisterNetLine(*this); // can throw
-    disconnect(mHighlightChangedConnection);
-    SI_Base::removeFromSchematic(scene, *mGraphicsItem);
+    SI_Base::removeFromSchematic(scene, mGraphicsItem.data());
     sg.dismiss();
 }
 
 void SI_NetLine::updateLine() noexcept
 {
     mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+}
+
+void SI_NetLine::netSignalMoved() noexcept
+{
+    if (!isAddedToSchematic()) return;
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void SI_NetLine::netSignalHighlightChanged() noexcept
+{
+    if (mGraphicsItem) mGraphicsItem->update();
 }
 
 void SI_NetLine::serialize(DomElement& root) const
@@ -186,19 +196,34 @@ void SI_NetLine::serialize(DomElement& root) const
 
 QPainterPath SI_NetLine::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->shape();
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 void SI_NetLine::setSelected(bool selected) noexcept
 {
     SI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void SI_NetLine::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void SI_NetLine::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new SGI_NetLine(*this));
+}
+
 bool SI_NetLine::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())         return false;
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "si_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/objectpool.h>
 #include "../graphicsitems/sgi_netline.h"
 
 /*****************************************************************************************
@@ -44,9 +45,10 @@ class SI_NetPoint;
 /**
  * @brief The SI_NetLine class
  */
-class SI_NetLine final : public SI_Base, public SerializableObject
+class SI_NetLine final : public SI_Base, public SerializableObject,
+                         public PooledObject<SI_NetLine>
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(SI_NetLine)
 
     public:
 
@@ -74,6 +76,13 @@ class SI_NetLine final : public SI_Base, public SerializableObject
         void removeFromSchematic(GraphicsScene& scene) override;
         void updateLine() noexcept;
 
+        /// Update the graphics after the net signal was changed by the owner
+        void netSignalMoved() noexcept;
+
+        /// Repaint after the highlight state of the net signal has changed (called by
+        /// librepcb::project::NetSignal::setHighlighted())
+        void netSignalHighlightChanged() noexcept;
+
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
 
@@ -83,6 +92,7 @@ class SI_NetLine final : public SI_Base, public SerializableObject
         const Point& getPosition() const noexcept override {return mPosition;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         SI_NetLine& operator=(const SI_NetLine& rhs) = delete;
@@ -91,13 +101,13 @@ class SI_NetLine final : public SI_Base, public SerializableObject
     private:
 
         void init();
+        void initGraphicsItem() noexcept;
         bool checkAttributesValidity() const noexcept;
 
 
         // General
         QScopedPointer<SGI_NetLine> mGraphicsItem;
         Point mPosition; ///< the center of startpoint and endpoint
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         Uuid mUuid;
@@ -99,8 +99,9 @@ SI_NetPoint::SI_NetPoint(Schematic& schematic, NetSignal& netsignal, SI_SymbolPi
 void SI_NetPoint::init()
 {
     // create the graphics item
-    mGraphicsItem.reset(new SGI_NetPoint(*this));
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
 
     // create ERC messages
     mErcMsgDeadNetPoint.reset(new ErcMsg(mSchematic.getProject(), *this,
@@ -160,6 +161,25 @@ void SI_NetPoint::setNetSignal(NetSignal& netsignal)
     mNetSignal = &netsignal;
 }
 
+void SI_NetPoint::moveToNetSignal(NetSignal& netsignal)
+{
+    if ((!isAddedToSchematic()) || (netsignal.getCircuit() != getCircuit())) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    if (&netsignal == mNetSignal) {
+        return;
+    }
+    mNetSignal->unregisterSchematicNetPoint(*this); // can throw
+    auto sg = scopeGuard([&](){mNetSignal->registerSchematicNetPoint(*this);});
+    netsignal.registerSchematicNetPoint(*this); // can throw
+    sg.dismiss();
+    mNetSignal = &netsignal;
+    foreach (SI_NetLine* netline, mRegisteredLines) {
+        netline->netSignalMoved(); // both points are moved, so this may be called twice
+    }
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
 void SI_NetPoint::setPinToAttach(SI_SymbolPin* pin)
 {
     if (pin == mSymbolPin) {
@@ -187,14 +207,14 @@ void SI_NetPoint::setPinToAttach(SI_SymbolPin* pin)
         sgl.dismiss();
     }
     mSymbolPin = pin;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 void SI_NetPoint::setPosition(const Point& position) noexcept
 {
     if (position != mPosition) {
         mPosition = position;
-        mGraphicsItem->setPos(mPosition.toPxQPointF());
+        if (mGraphicsItem) mGraphicsItem->setPos(mPosition.toPxQPointF());
         updateLines();
     }
 }
@@ -219,10 +239,8 @@ void SI_NetPoint::addToSchematic(GraphicsScene& scene)
         mSymbolPin->registerNetPoint(*this); // can throw
         sgl.add([&](){mSymbolPin->unregisterNetPoint(*this);});
     }
-    mHighlightChangedConnection = connect(mNetSignal, &NetSignal::highlightedChanged,
-                                          [this](){mGraphicsItem->update();});
     mErcMsgDeadNetPoint->setVisible(true);
-    SI_Base::addToSchematic(scene, *mGraphicsItem);
+    SI_Base::addToSchematic(scene, mGraphicsItem.data());
     sgl.dismiss();
 }
 
@@ -242,9 +260,8 @@ void SI_NetPoint::removeFromSchematic(GraphicsScene& scene)
     }
     mNetSignal->unregisterSchematicNetPoint(*this); // can throw
     sgl.add([&](){mNetSignal->registerSchematicNetPoint(*this);});
-    disconnect(mHighlightChangedConnection);
     mErcMsgDeadNetPoint->setVisible(false);
-    SI_Base::removeFromSchematic(scene, *mGraphicsItem);
+    SI_Base::removeFromSchematic(scene, mGraphicsItem.data());
     sgl.dismiss();
 }
 
@@ -257,7 +274,7 @@ void SI_NetPoint::registerNetLine(SI_NetLine& netline)
     }
     mRegisteredLines.append(&netline);
     netline.updateLine();
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
     mErcMsgDeadNetPoint->setVisible(mRegisteredLines.isEmpty());
 }
 
@@ -268,7 +285,7 @@ void SI_NetPoint::unregisterNetLine(SI_NetLine& netline)
     }
     mRegisteredLines.removeOne(&netline);
     netline.updateLine();
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
     mErcMsgDeadNetPoint->setVisible(mRegisteredLines.isEmpty());
 }
 
@@ -279,6 +296,11 @@ void SI_NetPoint::updateLines() const noexcept
     }
 }
 
+void SI_NetPoint::netSignalHighlightChanged() noexcept
+{
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
 void SI_NetPoint::serialize(DomElement& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -301,19 +323,35 @@ void SI_NetPoint::serialize(DomElement& root) const
 
 QPainterPath SI_NetPoint::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 void SI_NetPoint::setSelected(bool selected) noexcept
 {
     SI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void SI_NetPoint::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void SI_NetPoint::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new SGI_NetPoint(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+}
+
 bool SI_NetPoint::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                             return false;
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "si_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/objectpool.h>
 #include "../../erc/if_ercmsgprovider.h"
 #include "../graphicsitems/sgi_netpoint.h"
 
@@ -51,9 +52,9 @@ class ErcMsg;
  * @brief The SI_NetPoint class
  */
 class SI_NetPoint final : public SI_Base, public SerializableObject,
-                          public IF_ErcMsgProvider
+                          public IF_ErcMsgProvider, public PooledObject<SI_NetPoint>
 {
-        Q_OBJECT
+        Q_DECLARE_TR_FUNCTIONS(SI_NetPoint)
         DECLARE_ERC_MSG_CLASS_NAME(SI_NetPoint)
 
     public:
@@ -88,6 +89,21 @@ class SI_NetPoint final : public SI_Base, public SerializableObject,
         void unregisterNetLine(SI_NetLine& netline);
         void updateLines() const noexcept;
 
+        /**
+         * @brief Move the item to another net signal, even if it is used
+         *
+         * In contrast to #setNetSignal(), the attached items are not checked, so the
+         * caller has to move all items of the net signal at once (see
+         * librepcb::project::CmdNetSignalMoveItems).
+         *
+         * @throw Exception If the item is not added or on registration errors
+         */
+        void moveToNetSignal(NetSignal& netsignal);
+
+        /// Repaint after the highlight state of the net signal has changed (called by
+        /// librepcb::project::NetSignal::setHighlighted())
+        void netSignalHighlightChanged() noexcept;
+
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
 
@@ -97,6 +113,7 @@ class SI_NetPoint final : public SI_Base, public SerializableObject,
         const Point& getPosition() const noexcept override {return mPosition;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         SI_NetPoint& operator=(const SI_NetPoint& rhs) = delete;
@@ -107,12 +124,12 @@ class SI_NetPoint final : public SI_Base, public SerializableObject,
     private:
 
         void init();
+        void initGraphicsItem() noexcept;
         bool checkAttributesValidity() const noexcept;
 
 
         // General
         QScopedPointer<SGI_NetPoint> mGraphicsItem;
-        QMetaObject::Connection mHighlightChangedConnection;
 
         // Attributes
         Uuid mUuid;
@@ -44,6 +44,7 @@ namespace project {
  ****************************************************************************************/
 
 SI_Symbol::SI_Symbol(Schematic& schematic, const DomElement& domElement) :
+    QObject(&schematic),
     SI_Base(schematic), mComponentInstance(nullptr), mSymbVarItem(nullptr), mSymbol(nullptr)
 {
     mUuid = domElement.getAttribute<Uuid>("uuid", true);
@@ -63,6 +64,7 @@ SI_Symbol::SI_Symbol(Schematic& schematic, const DomElement& domElement) :
 
 SI_Symbol::SI_Symbol(Schematic& schematic, ComponentInstance& cmpInstance,
                      const Uuid& symbolItem, const Point& position, const Angle& rotation) :
+    QObject(&schematic),
     SI_Base(schematic), mComponentInstance(&cmpInstance), mSymbVarItem(nullptr),
     mSymbol(nullptr), mUuid(Uuid::createRandom()), mPosition(position), mRotation(rotation)
 {
@@ -79,9 +81,9 @@ void SI_Symbol::init(const Uuid& symbVarItemUuid)
             .arg(mSymbVarItem->getSymbolUuid().toStr()));
     }
 
-    mGraphicsItem.reset(new SGI_Symbol(*this));
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
-    mGraphicsItem->setRotation(-mRotation.toDeg());
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
 
     for (const library::SymbolPin& libPin : mSymbol->getPins()) {
         SI_SymbolPin* pin = new SI_SymbolPin(*this, libPin.getUuid()); // can throw
@@ -128,8 +130,10 @@ void SI_Symbol::setPosition(const Point& newPos) noexcept
 {
     if (newPos != mPosition) {
         mPosition = newPos;
-        mGraphicsItem->setPos(newPos.toPxQPointF());
-        mGraphicsItem->updateCacheAndRepaint();
+        if (mGraphicsItem) {
+            mGraphicsItem->setPos(newPos.toPxQPointF());
+            mGraphicsItem->updateCacheAndRepaint();
+        }
         foreach (SI_SymbolPin* pin, mPins) {
             pin->updatePosition();
         }
@@ -140,8 +144,10 @@ void SI_Symbol::setRotation(const Angle& newRotation) noexcept
 {
     if (newRotation != mRotation) {
         mRotation = newRotation;
-        mGraphicsItem->setRotation(-newRotation.toDeg());
-        mGraphicsItem->updateCacheAndRepaint();
+        if (mGraphicsItem) {
+            mGraphicsItem->setRotation(-newRotation.toDeg());
+            mGraphicsItem->updateCacheAndRepaint();
+        }
         foreach (SI_SymbolPin* pin, mPins) {
             pin->updatePosition();
         }
@@ -164,7 +170,7 @@ void SI_Symbol::addToSchematic(GraphicsScene& scene)
         pin->addToSchematic(scene); // can throw
         sgl.add([pin, &scene](){pin->removeFromSchematic(scene);});
     }
-    SI_Base::addToSchematic(scene, *mGraphicsItem);
+    SI_Base::addToSchematic(scene, mGraphicsItem.data());
     sgl.dismiss();
 }
 
@@ -180,7 +186,7 @@ void SI_Symbol::removeFromSchematic(GraphicsScene& scene)
     }
     mComponentInstance->unregisterSymbol(*this); // can throw
     sgl.add([&](){mComponentInstance->registerSymbol(*this);});
-    SI_Base::removeFromSchematic(scene, *mGraphicsItem);
+    SI_Base::removeFromSchematic(scene, mGraphicsItem.data());
     sgl.dismiss();
 }
 
@@ -230,31 +236,51 @@ bool SI_Symbol::getAttributeValue(const QString& attrNS, const QString& attrKey,
 
 QPainterPath SI_Symbol::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 void SI_Symbol::setSelected(bool selected) noexcept
 {
     SI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
     foreach (SI_SymbolPin* pin, mPins) {
         pin->setSelected(selected);
     }
 }
 
+void SI_Symbol::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
+    foreach (SI_SymbolPin* pin, mPins) {
+        pin->createGraphicsItems(scene);
+    }
+}
+
 /*****************************************************************************************
  *  Private Slots
  ****************************************************************************************/
 
 void SI_Symbol::schematicOrComponentAttributesChanged()
 {
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void SI_Symbol::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new SGI_Symbol(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    mGraphicsItem->setRotation(-mRotation.toDeg());
+}
+
 bool SI_Symbol::checkAttributesValidity() const noexcept
 {
     if (mSymbVarItem == nullptr)        return false;
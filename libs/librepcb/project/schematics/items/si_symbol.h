@@ -55,7 +55,7 @@ class SI_SymbolPin;
  * @author ubruhin
  * @date 2014-08-23
  */
-class SI_Symbol final : public SI_Base, public SerializableObject,
+class SI_Symbol final : public QObject, public SI_Base, public SerializableObject,
                         public IF_AttributeProvider
 {
         Q_OBJECT
@@ -103,6 +103,7 @@ class SI_Symbol final : public SI_Base, public SerializableObject,
         const Point& getPosition() const noexcept override {return mPosition;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         SI_Symbol& operator=(const SI_Symbol& rhs) = delete;
@@ -122,6 +123,7 @@ class SI_Symbol final : public SI_Base, public SerializableObject,
     private:
 
         void init(const Uuid& symbVarItemUuid);
+        void initGraphicsItem() noexcept;
         bool checkAttributesValidity() const noexcept;
 
 
@@ -49,6 +49,7 @@ namespace project {
  ****************************************************************************************/
 
 SI_SymbolPin::SI_SymbolPin(SI_Symbol& symbol, const Uuid& pinUuid) :
+    QObject(&symbol.getSchematic()),
     SI_Base(symbol.getSchematic()), mSymbol(symbol), mSymbolPin(nullptr),
     mPinSignalMapItem(nullptr), mComponentSignalInstance(nullptr),
     mRegisteredNetPoint(nullptr)
@@ -58,15 +59,18 @@ SI_SymbolPin::SI_SymbolPin(SI_Symbol& symbol, const Uuid& pinUuid) :
     mPinSignalMapItem = mSymbol.getCompSymbVarItem().getPinSignalMap().get(pinUuid).get(); // can throw
     Uuid cmpSignalUuid = mPinSignalMapItem->getSignalUuid();
     mComponentSignalInstance = mSymbol.getComponentInstance().getSignalInstance(cmpSignalUuid);
+    updateDisplayText();
 
-    mGraphicsItem.reset(new SGI_SymbolPin(*this));
+    if (areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+    }
     updatePosition();
 
     // create ERC messages
     mErcMsgUnconnectedRequiredPin.reset(new ErcMsg(mSchematic.getProject(), *this,
         QString("%1/%2").arg(mSymbol.getUuid().toStr()).arg(mSymbolPin->getUuid().toStr()),
         "UnconnectedRequiredPin", ErcMsg::ErcMsgType_t::SchematicError));
-    updateErcMessages();
+    // the message is invisible and gets its text when the pin is added to the schematic
 }
 
 SI_SymbolPin::~SI_SymbolPin()
@@ -87,23 +91,7 @@ const Uuid& SI_SymbolPin::getLibPinUuid() const noexcept
 QString SI_SymbolPin::getDisplayText(bool returnCmpSignalNameIfEmpty,
                                      bool returnPinNameIfEmpty) const noexcept
 {
-    QString text;
-    library::CmpSigPinDisplayType displayType = mPinSignalMapItem->getDisplayType();
-    if (displayType == library::CmpSigPinDisplayType::pinName()) {
-        text = mSymbolPin->getName();
-    } else  if (displayType == library::CmpSigPinDisplayType::componentSignal()) {
-        if (mComponentSignalInstance) {
-            text = mComponentSignalInstance->getCompSignal().getName();
-        }
-    } else if (displayType == library::CmpSigPinDisplayType::netSignal()) {
-        if (mComponentSignalInstance) {
-            if (mComponentSignalInstance->getNetSignal()) {
-                text = mComponentSignalInstance->getNetSignal()->getName();
-            }
-        }
-    } else if (displayType != library::CmpSigPinDisplayType::none()) {
-        Q_ASSERT(false);
-    }
+    QString text = mDisplayText;
     if (text.isEmpty() && returnCmpSignalNameIfEmpty && mComponentSignalInstance)
         text = mComponentSignalInstance->getCompSignal().getName();
     if (text.isEmpty() && returnPinNameIfEmpty)
@@ -143,9 +131,9 @@ void SI_SymbolPin::addToSchematic(GraphicsScene& scene)
     }
     if (getCompSigInstNetSignal()) {
         mHighlightChangedConnection = connect(getCompSigInstNetSignal(), &NetSignal::highlightedChanged,
-                                              [this](){mGraphicsItem->update();});
+                                              [this](){if (mGraphicsItem) mGraphicsItem->update();});
     }
-    SI_Base::addToSchematic(scene, *mGraphicsItem);
+    SI_Base::addToSchematic(scene, mGraphicsItem.data());
     updateErcMessages();
 }
 
@@ -160,7 +148,7 @@ void SI_SymbolPin::removeFromSchematic(GraphicsScene& scene)
     if (getCompSigInstNetSignal()) {
         disconnect(mHighlightChangedConnection);
     }
-    SI_Base::removeFromSchematic(scene, *mGraphicsItem);
+    SI_Base::removeFromSchematic(scene, mGraphicsItem.data());
     updateErcMessages();
 }
 
@@ -188,13 +176,36 @@ void SI_SymbolPin::unregisterNetPoint(SI_NetPoint& netpoint)
     updateErcMessages();
 }
 
+void SI_SymbolPin::netSignalMoved() noexcept
+{
+    updateDisplayText();
+    if (!isAddedToSchematic()) return;
+    disconnect(mHighlightChangedConnection);
+    if (getCompSigInstNetSignal()) {
+        mHighlightChangedConnection = connect(getCompSigInstNetSignal(), &NetSignal::highlightedChanged,
+                                              [this](){if (mGraphicsItem) mGraphicsItem->update();});
+    }
+    updateErcMessages();
+    if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint(); // the net name may be shown
+}
+
+void SI_SymbolPin::netSignalRenamed() noexcept
+{
+    if (updateDisplayText()) {
+        updateErcMessages();
+        if (mGraphicsItem) mGraphicsItem->updateCacheAndRepaint();
+    }
+}
+
 void SI_SymbolPin::updatePosition() noexcept
 {
     mPosition = mSymbol.mapToScene(mSymbolPin->getPosition());
     mRotation = mSymbol.getRotation() + mSymbolPin->getRotation();
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
-    mGraphicsItem->setRotation(-mRotation.toDeg());
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+        mGraphicsItem->setPos(mPosition.toPxQPointF());
+        mGraphicsItem->setRotation(-mRotation.toDeg());
+        mGraphicsItem->updateCacheAndRepaint();
+    }
     if (mRegisteredNetPoint) {
         mRegisteredNetPoint->setPosition(mPosition);
     }
@@ -206,13 +217,25 @@ void SI_SymbolPin::updatePosition() noexcept
 
 QPainterPath SI_SymbolPin::getGrabAreaScenePx() const noexcept
 {
-    return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+    if (!mGraphicsItem) return QPainterPath();
+    return getSceneShapeOfItem(*mGraphicsItem);
 }
 
 void SI_SymbolPin::setSelected(bool selected) noexcept
 {
     SI_Base::setSelected(selected);
-    mGraphicsItem->update();
+    if (mGraphicsItem) mGraphicsItem->update();
+}
+
+void SI_SymbolPin::createGraphicsItems(GraphicsScene& scene) noexcept
+{
+    if ((!mGraphicsItem) && areGraphicsItemsEnabled()) {
+        initGraphicsItem();
+        mGraphicsItem->setPos(mPosition.toPxQPointF());
+        mGraphicsItem->setRotation(-mRotation.toDeg());
+        mGraphicsItem->updateCacheAndRepaint();
+        addGraphicsItemToScene(scene, *mGraphicsItem);
+    }
 }
 
 /*****************************************************************************************
@@ -229,6 +252,49 @@ void SI_SymbolPin::updateErcMessages() noexcept
                                               && (!mRegisteredNetPoint));
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void SI_SymbolPin::initGraphicsItem() noexcept
+{
+    mGraphicsItem.reset(new SGI_SymbolPin(*this));
+}
+
+/**
+ * @brief Resolve the text to display according to the pin-signal-map display type
+ *
+ * The text is cached because it is needed for every repaint of the pin graphics item,
+ * so it must be updated whenever the component signal or its net signal changes.
+ *
+ * @return true if the text has changed, false if it is still the same
+ */
+bool SI_SymbolPin::updateDisplayText() noexcept
+{
+    QString text;
+    library::CmpSigPinDisplayType displayType = mPinSignalMapItem->getDisplayType();
+    if (displayType == library::CmpSigPinDisplayType::pinName()) {
+        text = mSymbolPin->getName();
+    } else  if (displayType == library::CmpSigPinDisplayType::componentSignal()) {
+        if (mComponentSignalInstance) {
+            text = mComponentSignalInstance->getCompSignal().getName();
+        }
+    } else if (displayType == library::CmpSigPinDisplayType::netSignal()) {
+        if (mComponentSignalInstance) {
+            if (mComponentSignalInstance->getNetSignal()) {
+                text = mComponentSignalInstance->getNetSignal()->getName();
+            }
+        }
+    } else if (displayType != library::CmpSigPinDisplayType::none()) {
+        Q_ASSERT(false);
+    }
+    if (text == mDisplayText) {
+        return false;
+    }
+    mDisplayText = text;
+    return true;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
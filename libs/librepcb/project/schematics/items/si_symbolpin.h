@@ -55,7 +55,7 @@ class ErcMsg;
 /**
  * @brief The SI_SymbolPin class
  */
-class SI_SymbolPin final : public SI_Base, public IF_ErcMsgProvider
+class SI_SymbolPin final : public QObject, public SI_Base, public IF_ErcMsgProvider
 {
         Q_OBJECT
         DECLARE_ERC_MSG_CLASS_NAME(SI_SymbolPin)
@@ -87,11 +87,18 @@ class SI_SymbolPin final : public SI_Base, public IF_ErcMsgProvider
         void unregisterNetPoint(SI_NetPoint& netpoint);
         void updatePosition() noexcept;
 
+        /// Update the connections to the net signal after it was changed by the owner
+        void netSignalMoved() noexcept;
+
+        /// Update the displayed text after the net signal of the owner was renamed
+        void netSignalRenamed() noexcept;
+
         // Inherited from SI_Base
         Type_t getType() const noexcept override {return SI_Base::Type_t::SymbolPin;}
         const Point& getPosition() const noexcept override {return mPosition;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
+        void createGraphicsItems(GraphicsScene& scene) noexcept override;
 
         // Operator Overloadings
         SI_SymbolPin& operator=(const SI_SymbolPin& rhs) = delete;
@@ -104,6 +111,10 @@ class SI_SymbolPin final : public SI_Base, public IF_ErcMsgProvider
 
     private:
 
+        void initGraphicsItem() noexcept;
+        bool updateDisplayText() noexcept;
+
+
         // General
         SI_Symbol& mSymbol;
         const library::SymbolPin* mSymbolPin;
@@ -116,6 +127,7 @@ class SI_SymbolPin final : public SI_Base, public IF_ErcMsgProvider
         Angle mRotation;
         SI_NetPoint* mRegisteredNetPoint;
         QScopedPointer<SGI_SymbolPin> mGraphicsItem;
+        QString mDisplayText; ///< the text according to the display type (see #updateDisplayText())
 
         /// @brief The ERC message for unconnected required pins
         QScopedPointer<ErcMsg> mErcMsgUnconnectedRequiredPin;
@@ -26,15 +26,19 @@
 #include <librepcb/common/fileio/domdocument.h>
 #include <librepcb/common/scopeguardlist.h>
 #include "../project.h"
+#include "../settings/projectsettings.h"
+#include "../circuit/circuit.h"
 #include <librepcb/library/sym/symbolpin.h>
 #include "items/si_symbol.h"
 #include "items/si_symbolpin.h"
 #include "items/si_netpoint.h"
 #include "items/si_netline.h"
 #include "items/si_netlabel.h"
+#include "graphicsitems/sgi_base.h"
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/memoryreport.h>
 #include <librepcb/common/application.h>
 
 /*****************************************************************************************
@@ -47,11 +51,23 @@ namespace project {
  *  Constructors / Destructor
  ****************************************************************************************/
 
+Schematic::Schematic(Project& project, SmartXmlFile* xmlFile, const DomDocument& doc,
+                     bool restore, bool readOnly) :
+    Schematic(project, xmlFile->getFilepath(), restore, readOnly, false, QString(), xmlFile,
+              &doc)
+{
+}
+
 Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
-                     bool readOnly, bool create, const QString& newName):
+                     bool readOnly, bool create, const QString& newName,
+                     SmartXmlFile* xmlFile, const DomDocument* doc):
     QObject(&project), IF_AttributeProvider(), mProject(project), mFilePath(filepath),
-    mIsAddedToProject(false)
+    mIsAddedToProject(false), mGraphicsItemsEnabled(create && (!mProject.isModelOnly())),
+    mSelectionRectActive(false)
 {
+    // take the ownership of the already opened file (if any) before anything can throw
+    mXmlFile.reset(xmlFile);
+
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
@@ -70,8 +86,12 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
         }
         else
         {
-            mXmlFile.reset(new SmartXmlFile(mFilePath, restore, readOnly));
-            std::unique_ptr<DomDocument> doc = mXmlFile->parseFileAndBuildDomTree();
+            std::unique_ptr<DomDocument> parsedDoc;
+            if (!doc) {
+                mXmlFile.reset(new SmartXmlFile(mFilePath, restore, readOnly));
+                parsedDoc = mXmlFile->parseFileAndBuildDomTree();
+                doc = parsedDoc.get();
+            }
             DomElement& root = doc->getRoot();
 
             // the schematic seems to be ready to open, so we will create all needed objects
@@ -188,11 +208,18 @@ QList<SI_Base*> Schematic::getSelectedItems(bool symbolPins,
     // TODO: this method is incredible ugly ;)
 
     QList<SI_Base*> list;
+    QSet<SI_Base*> listedItems; // avoids quadratic runtime for large selections
+    auto addItem = [&](SI_Base* item) {
+        if (!listedItems.contains(item)) {
+            listedItems.insert(item);
+            list.append(item);
+        }
+    };
     foreach (SI_Symbol* symbol, mSymbols)
     {
         // symbol
         if (symbol->isSelected())
-            list.append(symbol);
+            addItem(symbol);
 
         // pins
         foreach (SI_SymbolPin* pin, symbol->getPins())
@@ -205,15 +232,13 @@ QList<SI_Base*> Schematic::getSelectedItems(bool symbolPins,
             SI_NetPoint* attachedNetPoint = pin->getNetPoint();
             if (symbol->isSelected() && attachedPointsFromSymbols && attachedNetPoint)
             {
-                if (!list.contains(attachedNetPoint))
-                    list.append(attachedNetPoint);
+                addItem(attachedNetPoint);
             }
             if (symbol->isSelected() && attachedLinesFromSymbols && attachedNetPoint)
             {
                 foreach (SI_NetLine* attachedNetLine, attachedNetPoint->getLines())
                 {
-                    if (!list.contains(attachedNetLine))
-                        list.append(attachedNetLine);
+                    addItem(attachedNetLine);
                 }
             }
         }
@@ -225,8 +250,7 @@ QList<SI_Base*> Schematic::getSelectedItems(bool symbolPins,
             if (((!netpoint->isAttachedToPin()) && floatingPoints)
                || (netpoint->isAttachedToPin() && attachedPoints))
             {
-                if (!list.contains(netpoint))
-                    list.append(netpoint);
+                addItem(netpoint);
             }
         }
     }
@@ -238,8 +262,7 @@ QList<SI_Base*> Schematic::getSelectedItems(bool symbolPins,
             if (((!netline->isAttachedToSymbol()) && floatingLines)
                || (netline->isAttachedToSymbol() && attachedLines))
             {
-                if (!list.contains(netline))
-                    list.append(netline);
+                addItem(netline);
             }
             // netpoints from netlines
             SI_NetPoint* p1 = &netline->getStartPoint();
@@ -249,16 +272,14 @@ QList<SI_Base*> Schematic::getSelectedItems(bool symbolPins,
               || (( netline->isAttachedToSymbol()) && (!p1->isAttachedToPin()) && floatingPointsFromAttachedLines)
               || (( netline->isAttachedToSymbol()) && ( p1->isAttachedToPin()) && attachedPointsFromAttachedLines))
             {
-                if (!list.contains(p1))
-                    list.append(p1);
+                addItem(p1);
             }
             if ( ((!netline->isAttachedToSymbol()) && (!p2->isAttachedToPin()) && floatingPointsFromFloatingLines)
               || ((!netline->isAttachedToSymbol()) && ( p2->isAttachedToPin()) && attachedPointsFromFloatingLines)
               || (( netline->isAttachedToSymbol()) && (!p2->isAttachedToPin()) && floatingPointsFromAttachedLines)
               || (( netline->isAttachedToSymbol()) && ( p2->isAttachedToPin()) && attachedPointsFromAttachedLines))
             {
-                if (!list.contains(p2))
-                    list.append(p2);
+                addItem(p2);
             }
         }
     }
@@ -274,39 +295,59 @@ QList<SI_Base*> Schematic::getSelectedItems(bool symbolPins,
 QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept
 {
     QPointF scenePosPx = pos.toPxQPointF();
+    QList<SI_Base*> candidates = getItemCandidatesAtScenePos(scenePosPx);
     QList<SI_Base*> list;   // Note: The order of adding the items is very important (the
                             // top most item must appear as the first item in the list)!
     // visible netpoints
-    foreach (SI_NetPoint* netpoint, mNetPoints)
-    {
-        if (!netpoint->isVisibleJunction()) continue;
-        if (netpoint->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(netpoint);
+    foreach (SI_Base* item, candidates) {
+        if ((item->getType() == SI_Base::Type_t::NetPoint)
+            && static_cast<SI_NetPoint*>(item)->isVisibleJunction()
+            && item->getGrabAreaScenePx().contains(scenePosPx))
+        {
+            list.append(item);
+        }
     }
     // hidden netpoints
-    foreach (SI_NetPoint* netpoint, mNetPoints)
-    {
-        if (netpoint->isVisibleJunction()) continue;
-        if (netpoint->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(netpoint);
+    foreach (SI_Base* item, candidates) {
+        if ((item->getType() == SI_Base::Type_t::NetPoint)
+            && (!static_cast<SI_NetPoint*>(item)->isVisibleJunction())
+            && item->getGrabAreaScenePx().contains(scenePosPx))
+        {
+            list.append(item);
+        }
     }
     // netlines
-    foreach (SI_NetLine* netline, mNetLines)
-    {
-        if (netline->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(netline);
+    foreach (SI_Base* item, candidates) {
+        if ((item->getType() == SI_Base::Type_t::NetLine)
+            && item->getGrabAreaScenePx().contains(scenePosPx))
+        {
+            list.append(item);
+        }
     }
     // netlabels
-    foreach (SI_NetLabel* netlabel, mNetLabels)
-    {
-        if (netlabel->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(netlabel);
-    }
-    // symbols & pins
-    foreach (SI_Symbol* symbol, mSymbols)
-    {
-        foreach (SI_SymbolPin* pin, symbol->getPins())
+    foreach (SI_Base* item, candidates) {
+        if ((item->getType() == SI_Base::Type_t::NetLabel)
+            && item->getGrabAreaScenePx().contains(scenePosPx))
         {
+            list.append(item);
+        }
+    }
+    // symbols & pins (pins may be outside of the bounding rect of their symbol, so the
+    // symbols of all candidate pins need to be checked too)
+    QList<SI_Symbol*> symbols;
+    foreach (SI_Base* item, candidates) {
+        SI_Symbol* symbol = nullptr;
+        if (item->getType() == SI_Base::Type_t::Symbol) {
+            symbol = static_cast<SI_Symbol*>(item);
+        } else if (item->getType() == SI_Base::Type_t::SymbolPin) {
+            symbol = &static_cast<SI_SymbolPin*>(item)->getSymbol();
+        }
+        if (symbol && (!symbols.contains(symbol))) {
+            symbols.append(symbol);
+        }
+    }
+    foreach (SI_Symbol* symbol, symbols) {
+        foreach (SI_SymbolPin* pin, symbol->getPins()) {
             if (pin->getGrabAreaScenePx().contains(scenePosPx))
                 list.append(pin);
         }
@@ -318,40 +359,68 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept
 
 QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<SI_NetPoint*> list;
-    foreach (SI_NetPoint* netpoint, mNetPoints)
-    {
-        if (netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-            list.append(netpoint);
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(scenePosPx)) {
+        if ((item->getType() == SI_Base::Type_t::NetPoint)
+            && item->getGrabAreaScenePx().contains(scenePosPx))
+        {
+            list.append(static_cast<SI_NetPoint*>(item));
+        }
     }
     return list;
 }
 
 QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<SI_NetLine*> list;
-    foreach (SI_NetLine* netline, mNetLines)
-    {
-        if (netline->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-            list.append(netline);
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(scenePosPx)) {
+        if ((item->getType() == SI_Base::Type_t::NetLine)
+            && item->getGrabAreaScenePx().contains(scenePosPx))
+        {
+            list.append(static_cast<SI_NetLine*>(item));
+        }
     }
     return list;
 }
 
 QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<SI_SymbolPin*> list;
-    foreach (SI_Symbol* symbol, mSymbols)
-    {
-        foreach (SI_SymbolPin* pin, symbol->getPins())
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(scenePosPx)) {
+        if ((item->getType() == SI_Base::Type_t::SymbolPin)
+            && item->getGrabAreaScenePx().contains(scenePosPx))
         {
-            if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-                list.append(pin);
+            list.append(static_cast<SI_SymbolPin*>(item));
         }
     }
     return list;
 }
 
+SI_Base* Schematic::getNearestSnapTarget(const Point& pos, const Length& maxDistance,
+                                         const QSet<const SI_Base*>& ignore) const noexcept
+{
+    QPointF scenePosPx = pos.toPxQPointF();
+    qreal radiusPx = maxDistance.toPx();
+    QRectF sceneRectPx(scenePosPx.x() - radiusPx, scenePosPx.y() - radiusPx,
+                       2 * radiusPx, 2 * radiusPx);
+    SI_Base* nearestItem = nullptr;
+    Length nearestDistance = maxDistance;
+    foreach (SI_Base* item, getItemCandidatesInSceneRect(sceneRectPx)) {
+        if ((item->getType() != SI_Base::Type_t::SymbolPin)
+            && (item->getType() != SI_Base::Type_t::NetPoint)) continue;
+        if (ignore.contains(item)) continue;
+        Length distance = (item->getPosition() - pos).getLength();
+        if ((distance < nearestDistance) || ((!nearestItem) && (distance == nearestDistance))) {
+            nearestItem = item;
+            nearestDistance = distance;
+        }
+    }
+    return nearestItem;
+}
+
 QList<SI_Base*> Schematic::getAllItems() const noexcept
 {
     QList<SI_Base*> items;
@@ -416,6 +485,67 @@ void Schematic::removeSymbol(SI_Symbol& symbol)
     mSymbols.removeOne(&symbol);
 }
 
+void Schematic::addSymbols(const QList<SI_Symbol*>& symbols)
+{
+    if (!mIsAddedToProject) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    // check all symbols before adding any of them
+    QSet<Uuid> uuids;
+    uuids.reserve(mSymbols.count() + symbols.count());
+    foreach (const SI_Symbol* symbol, mSymbols) {
+        uuids.insert(symbol->getUuid());
+    }
+    foreach (const SI_Symbol* symbol, symbols) {
+        if ((symbol->isAddedToSchematic()) || (&symbol->getSchematic() != this)) {
+            throw LogicError(__FILE__, __LINE__);
+        }
+        if (uuids.contains(symbol->getUuid())) {
+            throw RuntimeError(__FILE__, __LINE__,
+                QString(tr("There is already a symbol with the UUID \"%1\"!"))
+                .arg(symbol->getUuid().toStr()));
+        }
+        uuids.insert(symbol->getUuid());
+    }
+    // add to schematic
+    beginBulkUpdate();
+    auto sg = scopeGuard([this](){endBulkUpdate();});
+    ScopeGuardList sgl(symbols.count());
+    foreach (SI_Symbol* symbol, symbols) {
+        symbol->addToSchematic(*mGraphicsScene); // can throw
+        sgl.add([this, symbol](){symbol->removeFromSchematic(*mGraphicsScene);});
+    }
+    mSymbols.append(symbols);
+    sgl.dismiss();
+}
+
+void Schematic::removeSymbols(const QList<SI_Symbol*>& symbols)
+{
+    QSet<SI_Symbol*> symbolsToRemove = symbols.toSet();
+    if ((!mIsAddedToProject) || (symbolsToRemove.count() != symbols.count())
+        || (!mSymbols.toSet().contains(symbolsToRemove)))
+    {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    // remove from schematic
+    beginBulkUpdate();
+    auto sg = scopeGuard([this](){endBulkUpdate();});
+    ScopeGuardList sgl(symbols.count());
+    foreach (SI_Symbol* symbol, symbols) {
+        symbol->removeFromSchematic(*mGraphicsScene); // can throw
+        sgl.add([this, symbol](){symbol->addToSchematic(*mGraphicsScene);});
+    }
+    QList<SI_Symbol*> remainingSymbols;
+    remainingSymbols.reserve(mSymbols.count() - symbols.count());
+    foreach (SI_Symbol* symbol, mSymbols) {
+        if (!symbolsToRemove.contains(symbol)) {
+            remainingSymbols.append(symbol);
+        }
+    }
+    mSymbols = remainingSymbols;
+    sgl.dismiss();
+}
+
 /*****************************************************************************************
  *  NetPoint Methods
  ****************************************************************************************/
@@ -556,7 +686,6 @@ void Schematic::addToProject()
         sgl.add([this, item](){item->removeFromSchematic(*mGraphicsScene);});
     }
     mIsAddedToProject = true;
-    updateIcon();
     sgl.dismiss();
 }
 
@@ -585,8 +714,8 @@ bool Schematic::save(bool toOriginal, QStringList& errors) noexcept
     {
         if (mIsAddedToProject)
         {
-            DomDocument doc(*serializeToDomElement("schematic"));
-            mXmlFile->save(doc, toOriginal);
+            mXmlFile->setCompressed(mProject.getSettings().getCompressFiles());
+            mXmlFile->save(*this, "schematic", toOriginal);
         }
         else
         {
@@ -604,36 +733,75 @@ bool Schematic::save(bool toOriginal, QStringList& errors) noexcept
 
 void Schematic::showInView(GraphicsView& view) noexcept
 {
+    enableGraphicsItems();
     view.setScene(mGraphicsScene.data());
 }
 
 void Schematic::setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept
 {
     mGraphicsScene->setSelectionRect(p1, p2);
-    if (updateItems)
-    {
-        QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+    if (!updateItems) {
+        mSelectionRectActive = false;
+        return;
+    }
+
+    QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+
+    // Only items within the previous or the current selection rect can change their
+    // selection state, so only these items need to be updated (see Board).
+    QList<SI_Base*> items;
+    if (mSelectionRectActive) {
+        items = getItemCandidatesInSceneRect(rectPx.united(mSelectionRectPx));
+    } else {
         foreach (SI_Symbol* symbol, mSymbols)
-        {
-            bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
-            symbol->setSelected(selectSymbol);
-            foreach (SI_SymbolPin* pin, symbol->getPins())
-            {
-                bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
-                pin->setSelected(selectSymbol || selectPin);
-            }
-        }
+            items.append(symbol);
         foreach (SI_NetPoint* netpoint, mNetPoints)
-            netpoint->setSelected(netpoint->getGrabAreaScenePx().intersects(rectPx));
+            items.append(netpoint);
         foreach (SI_NetLine* netline, mNetLines)
-            netline->setSelected(netline->getGrabAreaScenePx().intersects(rectPx));
+            items.append(netline);
         foreach (SI_NetLabel* netlabel, mNetLabels)
-            netlabel->setSelected(netlabel->getGrabAreaScenePx().intersects(rectPx));
+            items.append(netlabel);
+    }
+    mSelectionRectPx = rectPx;
+    mSelectionRectActive = true;
+
+    auto setSelected = [](SI_Base& item, bool selected) {
+        if (item.isSelected() != selected) item.setSelected(selected);
+    };
+
+    QSet<SI_Symbol*> symbols;
+    foreach (SI_Base* item, items) {
+        switch (item->getType()) {
+            case SI_Base::Type_t::Symbol:
+                symbols.insert(static_cast<SI_Symbol*>(item));
+                break;
+            case SI_Base::Type_t::SymbolPin:
+                // the selection state of pins depends on their symbol
+                symbols.insert(&static_cast<SI_SymbolPin*>(item)->getSymbol());
+                break;
+            case SI_Base::Type_t::NetPoint:
+            case SI_Base::Type_t::NetLine:
+            case SI_Base::Type_t::NetLabel:
+                setSelected(*item, item->getGrabAreaScenePx().intersects(rectPx));
+                break;
+            default:
+                break;
+        }
+    }
+    foreach (SI_Symbol* symbol, symbols) {
+        bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
+        setSelected(*symbol, selectSymbol);
+        foreach (SI_SymbolPin* pin, symbol->getPins())
+        {
+            bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
+            setSelected(*pin, selectSymbol || selectPin);
+        }
     }
 }
 
 void Schematic::clearSelection() const noexcept
 {
+    mSelectionRectActive = false;
     foreach (SI_Symbol* symbol, mSymbols)
         symbol->setSelected(false);
     foreach (SI_NetPoint* netpoint, mNetPoints)
@@ -644,9 +812,44 @@ void Schematic::clearSelection() const noexcept
         netlabel->setSelected(false);
 }
 
-void Schematic::renderToQPainter(QPainter& painter) const noexcept
+void Schematic::beginBulkUpdate() noexcept
+{
+    mGraphicsScene->beginBulkUpdate();
+    mProject.getCircuit().beginBulkUpdate();
+}
+
+void Schematic::endBulkUpdate() noexcept
+{
+    mProject.getCircuit().endBulkUpdate();
+    mGraphicsScene->endBulkUpdate();
+}
+
+void Schematic::addToMemoryReport(MemoryReport& parent) const noexcept
+{
+    MemoryReport& report = parent.addChild(QString("Schematic \"%1\"").arg(mName),
+                                           sizeof(Schematic));
+    int pins = 0;
+    foreach (const SI_Symbol* symbol, mSymbols) {
+        pins += symbol->getPins().count();
+    }
+    MemoryReport& symbols = report.addObjects<SI_Symbol>("Symbols", mSymbols.count());
+    symbols.addObjects<SI_SymbolPin>("Pins", pins);
+    report.addObjects<SI_NetPoint>("Net points", mNetPoints.count());
+    report.addObjects<SI_NetLine>("Net lines", mNetLines.count());
+    report.addObjects<SI_NetLabel>("Net labels", mNetLabels.count());
+    mGraphicsScene->addToMemoryReport(report);
+}
+
+void Schematic::prepareRendering() noexcept
+{
+    enableGraphicsItems();
+    clearSelection();
+    mGraphicsScene->itemsBoundingRect(); // processes all pending index updates
+}
+
+void Schematic::renderToQPainter(QPainter& painter, const QRectF& target) const noexcept
 {
-    mGraphicsScene->render(&painter, QRectF(), mGraphicsScene->itemsBoundingRect(), Qt::KeepAspectRatio);
+    mGraphicsScene->render(&painter, target, mGraphicsScene->itemsBoundingRect(), Qt::KeepAspectRatio);
 }
 
 /*****************************************************************************************
@@ -682,16 +885,52 @@ bool Schematic::getAttributeValue(const QString& attrNS, const QString& attrKey,
  *  Private Methods
  ****************************************************************************************/
 
-void Schematic::updateIcon() noexcept
+QList<SI_Base*> Schematic::getItemCandidatesInSceneRect(const QRectF& sceneRectPx) const noexcept
+{
+    // The BSP tree of the graphics scene is used as spatial index
+    QList<SI_Base*> items;
+    foreach (QGraphicsItem* graphicsItem, mGraphicsScene->items(sceneRectPx,
+             Qt::IntersectsItemBoundingRect, Qt::DescendingOrder))
+    {
+        SGI_Base* schematicGraphicsItem = dynamic_cast<SGI_Base*>(graphicsItem);
+        if (schematicGraphicsItem) {
+            items.append(&schematicGraphicsItem->getSchematicItem());
+        }
+    }
+    return items;
+}
+
+QList<SI_Base*> Schematic::getItemCandidatesAtScenePos(const QPointF& scenePosPx) const noexcept
+{
+    // The BSP tree of the graphics scene is used as spatial index, so only the items
+    // whose bounding rect contains the position need to be checked (much cheaper than
+    // calculating the grab area of every single item of the schematic).
+    QList<SI_Base*> items;
+    foreach (QGraphicsItem* graphicsItem, mGraphicsScene->items(scenePosPx,
+             Qt::IntersectsItemBoundingRect, Qt::DescendingOrder))
+    {
+        SGI_Base* schematicGraphicsItem = dynamic_cast<SGI_Base*>(graphicsItem);
+        if (schematicGraphicsItem) {
+            items.append(&schematicGraphicsItem->getSchematicItem());
+        }
+    }
+    return items;
+}
+
+void Schematic::enableGraphicsItems() noexcept
 {
-    QRectF source = mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
-    QRect target(0, 0, 297, 210); // DIN A4 format :-)
+    if (mGraphicsItemsEnabled) return;
 
-    QPixmap pixmap(target.size());
-    pixmap.fill(Qt::white);
-    QPainter painter(&pixmap);
-    mGraphicsScene->render(&painter, target, source);
-    mIcon = QIcon(pixmap);
+    // create the graphics items which were skipped while loading the schematic
+    mGraphicsItemsEnabled = true;
+    foreach (SI_Symbol* symbol, mSymbols)
+        symbol->createGraphicsItems(*mGraphicsScene);
+    foreach (SI_NetPoint* netpoint, mNetPoints)
+        netpoint->createGraphicsItems(*mGraphicsScene);
+    foreach (SI_NetLine* netline, mNetLines)
+        netline->createGraphicsItems(*mGraphicsScene);
+    foreach (SI_NetLabel* netlabel, mNetLabels)
+        netlabel->createGraphicsItems(*mGraphicsScene);
 }
 
 bool Schematic::checkAttributesValidity() const noexcept
@@ -702,12 +941,25 @@ bool Schematic::checkAttributesValidity() const noexcept
 }
 
 void Schematic::serialize(DomElement& root) const
+{
+    serializeChilds(root);
+}
+
+void Schematic::serializeToXmlStream(QXmlStreamWriter& writer, const QString& name) const
+{
+    writer.writeStartElement(name);
+    serializeChilds(writer); // can throw
+    writer.writeEndElement();
+}
+
+template <typename T>
+void Schematic::serializeChilds(T& root) const
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
-    root.appendTextChild("uuid", mUuid);
-    root.appendTextChild("name", mName);
-    root.appendChild(mGridProperties->serializeToDomElement("grid"));
+    serializeTextChild(root, "uuid", mUuid);
+    serializeTextChild(root, "name", mName);
+    serializeChild(root, *mGridProperties, "grid");
     serializePointerContainer(root, mSymbols, "symbol");
     serializePointerContainer(root, mNetPoints, "netpoint");
     serializePointerContainer(root, mNetLines, "netline");
@@ -41,6 +41,8 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class SmartXmlFile;
+class DomDocument;
+class MemoryReport;
 
 namespace project {
 
@@ -105,12 +107,27 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         Schematic(const Schematic& other) = delete;
         Schematic(Project& project, const FilePath& filepath, bool restore, bool readOnly) :
             Schematic(project, filepath, restore, readOnly, false, QString()) {}
+
+        /**
+         * @brief Constructor to load a schematic from an already opened and parsed file
+         *
+         * @param project   The project of the schematic
+         * @param xmlFile   The opened schematic file (the schematic takes the ownership, even if
+         *                  the constructor throws)
+         * @param doc       The DOM document parsed from xmlFile
+         * @param restore   See SmartFile#SmartFile()
+         * @param readOnly  See SmartFile#SmartFile()
+         */
+        Schematic(Project& project, SmartXmlFile* xmlFile, const DomDocument& doc, bool restore,
+                  bool readOnly);
         ~Schematic() noexcept;
 
         // Getters: General
         Project& getProject() const noexcept {return mProject;}
         const FilePath& getFilePath() const noexcept {return mFilePath;}
         const GridProperties& getGridProperties() const noexcept {return *mGridProperties;}
+        GraphicsScene& getGraphicsScene() const noexcept {return *mGraphicsScene;}
+        bool areGraphicsItemsEnabled() const noexcept {return mGraphicsItemsEnabled;}
         bool isEmpty() const noexcept;
         QList<SI_Base*> getSelectedItems(bool symbolPins,
                                          bool floatingPoints,
@@ -127,6 +144,21 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         QList<SI_NetPoint*> getNetPointsAtScenePos(const Point& pos) const noexcept;
         QList<SI_NetLine*> getNetLinesAtScenePos(const Point& pos) const noexcept;
         QList<SI_SymbolPin*> getPinsAtScenePos(const Point& pos) const noexcept;
+
+        /**
+         * @brief Get the nearest symbol pin or netpoint to snap a wire to
+         *
+         * Only the items around the position are checked (using the spatial index of
+         * the graphics scene), so this is cheap enough to be called on mouse moves.
+         *
+         * @param pos           The position to search around
+         * @param maxDistance   The maximum distance between the position and the target
+         * @param ignore        Items to skip (e.g. the netpoints currently being moved)
+         *
+         * @return The nearest pin or netpoint, or nullptr if there is none in range
+         */
+        SI_Base* getNearestSnapTarget(const Point& pos, const Length& maxDistance,
+                                      const QSet<const SI_Base*>& ignore) const noexcept;
         QList<SI_Base*> getAllItems() const noexcept;
 
         // Setters: General
@@ -135,19 +167,44 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         // Getters: Attributes
         const Uuid& getUuid() const noexcept {return mUuid;}
         const QString& getName() const noexcept {return mName;}
-        const QIcon& getIcon() const noexcept {return mIcon;}
 
         // Symbol Methods
+        const QList<SI_Symbol*>& getSymbols() const noexcept {return mSymbols;}
         SI_Symbol* getSymbolByUuid(const Uuid& uuid) const noexcept;
         void addSymbol(SI_Symbol& symbol);
         void removeSymbol(SI_Symbol& symbol);
 
+        /**
+         * @brief Add many symbols at once (e.g. all gates of a component)
+         *
+         * Same as calling #addSymbol() for every symbol, but the UUIDs are checked only
+         * once and the scene index and ERC updates are deferred until all symbols are
+         * added (see #beginBulkUpdate()). If one of the symbols cannot be added, none of
+         * them is added.
+         *
+         * @param symbols   The symbols to add (must not be added to the schematic yet)
+         *
+         * @throw Exception on error
+         */
+        void addSymbols(const QList<SI_Symbol*>& symbols);
+
+        /**
+         * @brief Remove many symbols at once (the counterpart of #addSymbols())
+         *
+         * @param symbols   The symbols to remove (must be added to this schematic)
+         *
+         * @throw Exception on error
+         */
+        void removeSymbols(const QList<SI_Symbol*>& symbols);
+
         // NetPoint Methods
+        const QList<SI_NetPoint*>& getNetPoints() const noexcept {return mNetPoints;}
         SI_NetPoint* getNetPointByUuid(const Uuid& uuid) const noexcept;
         void addNetPoint(SI_NetPoint& netpoint);
         void removeNetPoint(SI_NetPoint& netpoint);
 
         // NetLine Methods
+        const QList<SI_NetLine*>& getNetLines() const noexcept {return mNetLines;}
         SI_NetLine* getNetLineByUuid(const Uuid& uuid) const noexcept;
         void addNetLine(SI_NetLine& netline);
         void removeNetLine(SI_NetLine& netline);
@@ -166,7 +223,44 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         const QRectF& restoreViewSceneRect() const noexcept {return mViewRect;}
         void setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept;
         void clearSelection() const noexcept;
-        void renderToQPainter(QPainter& painter) const noexcept;
+
+        /**
+         * @brief Start adding/removing many items at once (e.g. in a large command group)
+         *
+         * Until the matching #endBulkUpdate() is called, the index of the graphics scene
+         * and the ERC messages of the circuit are updated only once at the end instead of
+         * after every single item. Calls can be nested. This is only worth for many items
+         * since the scene index is completely rebuilt at the end.
+         */
+        void beginBulkUpdate() noexcept;
+        void endBulkUpdate() noexcept;
+
+        /**
+         * @brief Prepare the graphics scene for #renderToQPainter()
+         *
+         * Creates the graphics items (if not done yet, e.g. in model-only mode), clears
+         * the selection and brings the index of the scene up to date. Must be called in
+         * the GUI thread.
+         */
+        void prepareRendering() noexcept;
+
+        /**
+         * @brief Render the whole schematic into a QPainter
+         *
+         * After #prepareRendering() was called, different schematics may be rendered
+         * concurrently in worker threads as long as they are not modified or shown on
+         * the screen in the meantime.
+         *
+         * @param painter   The painter to render into
+         * @param target    The target area on the paint device (null means the whole
+         *                  device)
+         */
+        void renderToQPainter(QPainter& painter, const QRectF& target = QRectF()) const noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of this schematic (items and graphics) to a report
+         */
+        void addToMemoryReport(MemoryReport& parent) const noexcept;
 
         // Helper Methods
         bool getAttributeValue(const QString& attrNS, const QString& attrKey,
@@ -191,28 +285,44 @@ class Schematic final : public QObject, public IF_AttributeProvider,
     private:
 
         Schematic(Project& project, const FilePath& filepath, bool restore,
-                  bool readOnly, bool create, const QString& newName);
-        void updateIcon() noexcept;
+                  bool readOnly, bool create, const QString& newName,
+                  SmartXmlFile* xmlFile = nullptr, const DomDocument* doc = nullptr);
+        QList<SI_Base*> getItemCandidatesInSceneRect(const QRectF& sceneRectPx) const noexcept;
+        QList<SI_Base*> getItemCandidatesAtScenePos(const QPointF& scenePosPx) const noexcept;
+        void enableGraphicsItems() noexcept;
         bool checkAttributesValidity() const noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(DomElement& root) const override;
 
+        /// @copydoc librepcb::SerializableObject::serializeToXmlStream()
+        void serializeToXmlStream(QXmlStreamWriter& writer, const QString& name) const override;
+
+        /**
+         * @brief Serialize all childs into a DomElement or a QXmlStreamWriter
+         *
+         * Used by both #serialize() and #serializeToXmlStream() to get identical output.
+         */
+        template <typename T>
+        void serializeChilds(T& root) const;
+
 
         // General
         Project& mProject; ///< A reference to the Project object (from the ctor)
         FilePath mFilePath; ///< the filepath of the schematic *.xml file (from the ctor)
         QScopedPointer<SmartXmlFile> mXmlFile;
         bool mIsAddedToProject;
+        bool mGraphicsItemsEnabled; ///< false after loading until shown in a view
 
         QScopedPointer<GraphicsScene> mGraphicsScene;
         QScopedPointer<GridProperties> mGridProperties;
         QRectF mViewRect;
+        mutable bool mSelectionRectActive; ///< see #setSelectionRect()
+        QRectF mSelectionRectPx; ///< the last rect passed to #setSelectionRect()
 
         // Attributes
         Uuid mUuid;
         QString mName;
-        QIcon mIcon;
 
         QList<SI_Symbol*> mSymbols;
         QList<SI_NetPoint*> mNetPoints;
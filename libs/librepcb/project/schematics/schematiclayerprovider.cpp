@@ -64,6 +64,7 @@ SchematicLayerProvider::SchematicLayerProvider(Project& project):
 
 SchematicLayerProvider::~SchematicLayerProvider() noexcept
 {
+    mLayersByName.clear();
     qDeleteAll(mLayers); mLayers.clear();
 }
 
@@ -73,7 +74,9 @@ SchematicLayerProvider::~SchematicLayerProvider() noexcept
 
 void SchematicLayerProvider::addLayer(const QString& name) noexcept
 {
-    mLayers.append(new GraphicsLayer(name));
+    GraphicsLayer* layer = new GraphicsLayer(name);
+    mLayers.append(layer);
+    mLayersByName.insert(name, layer);
 }
 
 /*****************************************************************************************
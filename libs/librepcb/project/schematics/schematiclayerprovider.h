@@ -58,12 +58,7 @@ class SchematicLayerProvider final : public IF_GraphicsLayerProvider
 
         /// @copydoc IF_GraphicsLayerProvider#getLayer()
         GraphicsLayer* getLayer(const QString& name) const noexcept override {
-            foreach (GraphicsLayer* layer, mLayers) {
-                if (layer->getName() == name) {
-                    return layer;
-                }
-            }
-            return nullptr;
+            return mLayersByName.value(name, nullptr);
         }
 
         QList<GraphicsLayer*> getAllLayers() const noexcept override {
@@ -81,6 +76,7 @@ class SchematicLayerProvider final : public IF_GraphicsLayerProvider
     private: // Data
         Project& mProject; ///< A reference to the Project object (from the ctor)
         QList<GraphicsLayer*> mLayers;
+        QHash<QString, GraphicsLayer*> mLayersByName; ///< same layers as #mLayers
 };
 
 /*****************************************************************************************
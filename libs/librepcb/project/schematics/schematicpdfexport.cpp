@@ -0,0 +1,193 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QPdfWriter>
+#include <QPicture>
+#include "schematicpdfexport.h"
+#include "schematic.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Class SchematicPdfExport::PageRecorder
+ ****************************************************************************************/
+
+/**
+ * @brief Renders a single schematic into a QPicture in a thread pool worker
+ */
+class SchematicPdfExport::PageRecorder final : public QRunnable
+{
+    public:
+        PageRecorder(const Schematic& schematic, const QRectF& target,
+                     QPicture& picture) noexcept :
+            mSchematic(schematic), mTarget(target), mPicture(picture)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            QPainter painter(&mPicture);
+            mSchematic.renderToQPainter(painter, mTarget);
+        }
+
+    private:
+        const Schematic& mSchematic;
+        QRectF mTarget;
+        QPicture& mPicture;
+};
+
+/*****************************************************************************************
+ *  Class SchematicPdfExport::PdfWriter
+ ****************************************************************************************/
+
+/**
+ * @brief Writes the recorded pages into the PDF file in a worker thread
+ *
+ * The error message is stored in the given string (which must not be accessed until the
+ * worker has finished).
+ */
+class SchematicPdfExport::PdfWriter final : public QRunnable
+{
+    public:
+        PdfWriter(const QVector<QPicture>& pages, const FilePath& filepath,
+                  const QString& creator, QString& error) noexcept :
+            mPages(pages), mFilePath(filepath), mCreator(creator), mError(error)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            QPdfWriter writer(mFilePath.toStr());
+            writer.setCreator(mCreator);
+            writer.setResolution(sResolutionDpi);
+            writer.setPageSizeMM(QSizeF(sPageWidthMm, sPageHeightMm));
+            writer.setMargins(QPagedPaintDevice::Margins{sPageMarginMm, sPageMarginMm,
+                                                         sPageMarginMm, sPageMarginMm});
+            QPainter painter;
+            if (!painter.begin(&writer)) {
+                mError = QString(tr("Could not write to file \"%1\"."))
+                         .arg(mFilePath.toNative());
+                return;
+            }
+            for (int i = 0; i < mPages.count(); ++i) {
+                if ((i > 0) && (!writer.newPage())) {
+                    mError = tr("Unknown error while printing.");
+                    return;
+                }
+                mPages.at(i).play(&painter);
+            }
+            if (!painter.end()) {
+                mError = QString(tr("Could not write to file \"%1\"."))
+                         .arg(mFilePath.toNative());
+            }
+        }
+
+    private:
+        const QVector<QPicture>& mPages;
+        FilePath mFilePath;
+        QString mCreator;
+        QString& mError;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+SchematicPdfExport::SchematicPdfExport(const QList<Schematic*>& schematics,
+                                       const QString& creator) noexcept :
+    QObject(), mSchematics(schematics), mCreator(creator)
+{
+}
+
+SchematicPdfExport::~SchematicPdfExport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void SchematicPdfExport::exportToFile(const FilePath& filepath)
+{
+    if (mSchematics.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, tr("No schematic pages selected."));
+    }
+
+    // the scenes must be prepared in the GUI thread (this creates graphics items)
+    foreach (Schematic* schematic, mSchematics) {
+        schematic->prepareRendering();
+    }
+
+    // record all pages concurrently, the caller is blocked until all are finished
+    QRectF target = getPageRectPx();
+    QVector<QPicture> pages(mSchematics.count());
+    {
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
+        if (!QFontDatabase::supportsThreadedFontRendering()) {
+            pool.setMaxThreadCount(1); // the fonts are only safe to use in one thread
+        }
+        for (int i = 0; i < mSchematics.count(); ++i) {
+            pool.start(new PageRecorder(*mSchematics.at(i), target, pages[i]));
+        }
+        pool.waitForDone();
+    }
+
+    // write the PDF in a worker thread, but keep the event loop running meanwhile
+    QString error;
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    pool.start(new PdfWriter(pages, filepath, mCreator, error));
+    while (!pool.waitForDone(50)) {
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+    if (!error.isNull()) {
+        throw RuntimeError(__FILE__, __LINE__, error);
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QRectF SchematicPdfExport::getPageRectPx() noexcept
+{
+    // same size as the paint device of the PdfWriter (i.e. without the margins)
+    qreal pxPerMm = sResolutionDpi / 25.4;
+    return QRectF(0, 0, (sPageWidthMm - 2 * sPageMarginMm) * pxPerMm,
+                  (sPageHeightMm - 2 * sPageMarginMm) * pxPerMm);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,112 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_SCHEMATICPDFEXPORT_H
+#define LIBREPCB_PROJECT_SCHEMATICPDFEXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Schematic;
+
+/*****************************************************************************************
+ *  Class SchematicPdfExport
+ ****************************************************************************************/
+
+/**
+ * @brief Export schematic pages into a PDF file (one page per schematic)
+ *
+ * The export is done in two steps:
+ *
+ *  1. All pages are rendered concurrently into QPicture objects (recorded paint
+ *     commands), one page per thread pool worker. Each graphics scene is accessed by
+ *     only one worker, and the caller is blocked in the meantime to ensure that the
+ *     scenes are neither modified nor painted on the screen concurrently.
+ *  2. The recorded pages are written into the PDF file by a single worker thread page
+ *     by page (QPdfWriter writes each page directly to the file). As the pictures are
+ *     independent from the schematics, the event loop of the caller keeps running in
+ *     the meantime (without user input events).
+ */
+class SchematicPdfExport final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        SchematicPdfExport() = delete;
+        SchematicPdfExport(const SchematicPdfExport& other) = delete;
+        SchematicPdfExport(const QList<Schematic*>& schematics, const QString& creator) noexcept;
+        ~SchematicPdfExport() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Write all schematics into a PDF file
+         *
+         * @param filepath  The PDF file to write (will be overwritten if it exists)
+         *
+         * @throw Exception on error
+         */
+        void exportToFile(const FilePath& filepath);
+
+        // Operator Overloadings
+        SchematicPdfExport& operator=(const SchematicPdfExport& rhs) = delete;
+
+
+    private:
+
+        // Private Types
+        class PageRecorder;
+        class PdfWriter;
+
+        // Private Methods
+        static QRectF getPageRectPx() noexcept;
+
+        // Static Variables
+        static constexpr int sResolutionDpi = 1200;
+        static constexpr qreal sPageWidthMm = 297; // DIN A4, landscape
+        static constexpr qreal sPageHeightMm = 210;
+        static constexpr qreal sPageMarginMm = 10;
+
+        // Private Member Variables
+        QList<Schematic*> mSchematics;
+        QString mCreator;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_SCHEMATICPDFEXPORT_H
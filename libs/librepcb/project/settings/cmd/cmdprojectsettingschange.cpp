@@ -38,7 +38,8 @@ CmdProjectSettingsChange::CmdProjectSettingsChange(ProjectSettings& settings) no
     UndoCommand(tr("Change Project Settings")), mSettings(settings),
     mRestoreDefaults(false),
     mLocaleOrderOld(settings.getLocaleOrder()), mLocaleOrderNew(mLocaleOrderOld),
-    mNormOrderOld(settings.getNormOrder()), mNormOrderNew(mNormOrderOld)
+    mNormOrderOld(settings.getNormOrder()), mNormOrderNew(mNormOrderOld),
+    mCompressFilesOld(settings.getCompressFiles()), mCompressFilesNew(mCompressFilesOld)
 {
 }
 
@@ -68,6 +69,12 @@ void CmdProjectSettingsChange::setNormOrder(const QStringList& norms) noexcept
     mNormOrderNew = norms;
 }
 
+void CmdProjectSettingsChange::setCompressFiles(bool compress) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mCompressFilesNew = compress;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
@@ -105,6 +112,7 @@ void CmdProjectSettingsChange::applyNewSettings()
     {
         mSettings.setLocaleOrder(mLocaleOrderNew);
         mSettings.setNormOrder(mNormOrderNew);
+        mSettings.setCompressFiles(mCompressFilesNew);
     }
 }
 
@@ -112,6 +120,7 @@ void CmdProjectSettingsChange::applyOldSettings()
 {
     mSettings.setLocaleOrder(mLocaleOrderOld);
     mSettings.setNormOrder(mNormOrderOld);
+    mSettings.setCompressFiles(mCompressFilesOld);
 }
 
 /*****************************************************************************************
@@ -53,6 +53,7 @@ class CmdProjectSettingsChange final : public UndoCommand
         void restoreDefaults() noexcept;
         void setLocaleOrder(const QStringList& locales) noexcept;
         void setNormOrder(const QStringList& norms) noexcept;
+        void setCompressFiles(bool compress) noexcept;
 
 
     private:
@@ -81,6 +82,8 @@ class CmdProjectSettingsChange final : public UndoCommand
         QStringList mLocaleOrderNew;
         QStringList mNormOrderOld;
         QStringList mNormOrderNew;
+        bool mCompressFilesOld;
+        bool mCompressFilesNew;
 };
 
 /*****************************************************************************************
@@ -70,6 +70,12 @@ ProjectSettings::ProjectSettings(Project& project, bool restore, bool readOnly,
             foreach (const DomElement* node, root.getFirstChild("norm_order", true)->getChilds()) {
                 mNormOrder.append(node->getText<QString>(true));
             }
+
+            // file compression (optional, plain XML files are the default)
+            const DomElement* compressFiles = root.getFirstChild("compress_files", false);
+            if (compressFiles) {
+                mCompressFiles = compressFiles->getText<bool>(true);
+            }
         }
 
         triggerSettingsChanged();
@@ -97,6 +103,7 @@ void ProjectSettings::restoreDefaults() noexcept
 {
     mLocaleOrder.clear();
     mNormOrder.clear();
+    mCompressFiles = false;
 }
 
 void ProjectSettings::triggerSettingsChanged() noexcept
@@ -135,6 +142,7 @@ void ProjectSettings::serialize(DomElement& root) const
     DomElement* norm_order = root.appendChild("norm_order");
     foreach (const QString& norm, mNormOrder)
         norm_order->appendTextChild("norm", norm);
+    root.appendTextChild("compress_files", mCompressFiles);
 }
 
 /*****************************************************************************************
@@ -64,10 +64,12 @@ class ProjectSettings final : public QObject, public SerializableObject
         // Getters: Settings
         QStringList getLocaleOrder() const noexcept {return mLocaleOrder;}
         QStringList getNormOrder() const noexcept {return mNormOrder;}
+        bool getCompressFiles() const noexcept {return mCompressFiles;}
 
         // Setters: Settings
         void setLocaleOrder(const QStringList& locales) noexcept {mLocaleOrder = locales;}
         void setNormOrder(const QStringList& norms) noexcept {mNormOrder = norms;}
+        void setCompressFiles(bool compress) noexcept {mCompressFiles = compress;}
 
         // General Methods
         void restoreDefaults() noexcept;
@@ -105,6 +107,7 @@ class ProjectSettings final : public QObject, public SerializableObject
         // All Settings
         QStringList mLocaleOrder; ///< The list of locales (like "de_CH") in the right order
         QStringList mNormOrder; ///< the list of norms in the right order
+        bool mCompressFiles; ///< write circuit, schematics and boards zlib-compressed
 };
 
 /*****************************************************************************************
@@ -32,20 +32,31 @@
 #include <librepcb/common/utils/undostackactiongroup.h>
 #include <librepcb/common/utils/exclusiveactiongroup.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
+#include <librepcb/project/boards/boardimageexport.h>
+#include <librepcb/project/boards/boardlayerstack.h>
 #include <librepcb/project/circuit/circuit.h>
 #include <librepcb/common/dialogs/gridsettingsdialog.h>
 #include <librepcb/common/dialogs/boarddesignrulesdialog.h>
 #include "../dialogs/projectpropertieseditordialog.h"
 #include <librepcb/project/settings/projectsettings.h>
 #include <librepcb/common/graphics/graphicsview.h>
+#include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/project/boards/cmd/cmdboardadd.h>
 #include <librepcb/project/boards/cmd/cmdboarddesignrulesmodify.h>
+#include "../cmd/cmdcleanupboardtraces.h"
+#include "../cmd/cmdapplyboardannotationdiff.h"
 #include "../docks/ercmsgdock.h"
 #include "unplacedcomponentsdock.h"
 #include "fsm/bes_fsm.h"
 #include "../projecteditor.h"
 #include "boardlayersdock.h"
+#include "netstatisticsdock.h"
 #include "fabricationoutputdialog.h"
 #include "boardlayerstacksetupdialog.h"
 
@@ -56,6 +67,37 @@ namespace librepcb {
 namespace project {
 namespace editor {
 
+/*****************************************************************************************
+ *  Class BoardEditor::AnnotationDiffJob
+ ****************************************************************************************/
+
+/**
+ * @brief Calculates a librepcb::project::BoardAnnotationDiff in the job scheduler
+ *
+ * The editor is notified in its own thread when the result is available.
+ */
+class BoardEditor::AnnotationDiffJob final : public QRunnable
+{
+    public:
+        AnnotationDiffJob(BoardEditor& editor, const BoardAnnotationDiff::State& state,
+                          BoardAnnotationDiff::Result& result) noexcept :
+            mEditor(editor), mState(state), mResult(result)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            mResult = BoardAnnotationDiff::calculate(mState);
+            QMetaObject::invokeMethod(&mEditor, "annotationDiffFinished", Qt::QueuedConnection);
+        }
+
+    private:
+        BoardEditor& mEditor;
+        BoardAnnotationDiff::State mState;
+        BoardAnnotationDiff::Result& mResult;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -65,7 +107,10 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     mUi(new Ui::BoardEditor),
     mGraphicsView(nullptr), mActiveBoardIndex(-1), mBoardListActionGroup(this),
     mErcMsgDock(nullptr), mUnplacedComponentsDock(nullptr), mBoardLayersDock(nullptr),
-    mFsm(nullptr)
+    mNetStatisticsDock(nullptr), mFsm(nullptr), mAnnotationDiffRunning(false),
+    mAnnotationDiffOutdated(false), mAnnotationDiffBoard(nullptr),
+    mAnnotationDiffJobs(projectEditor.getWorkspace().getJobScheduler(),
+                        JobScheduler::Priority::Interactive, 1)
 {
     mUi->setupUi(this);
     mUi->actionProjectSave->setEnabled(!mProject.isReadOnly());
@@ -85,6 +130,8 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     addDockWidget(Qt::RightDockWidgetArea, mUnplacedComponentsDock, Qt::Vertical);
     mBoardLayersDock = new BoardLayersDock(*this);
     addDockWidget(Qt::RightDockWidgetArea, mBoardLayersDock, Qt::Vertical);
+    mNetStatisticsDock = new NetStatisticsDock();
+    addDockWidget(Qt::RightDockWidgetArea, mNetStatisticsDock, Qt::Vertical);
 
     // add graphics view as central widget
     mGraphicsView = new GraphicsView(nullptr, this);
@@ -104,6 +151,10 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
 
     // connect some actions which are created with the Qt Designer
     connect(mUi->actionProjectSave, &QAction::triggered, &mProjectEditor, &ProjectEditor::saveProject);
+    connect(mUi->actionProjectReload, &QAction::triggered,
+            this, [this](){mProjectEditor.reloadFromDisk(this);});
+    connect(mUi->actionExportArchive, &QAction::triggered,
+            this, [this](){mProjectEditor.execExportArchiveDialog(this);});
     connect(mUi->actionQuit, &QAction::triggered, this, &BoardEditor::close);
     connect(mUi->actionAboutQt, &QAction::triggered, qApp, &QApplication::aboutQt);
     connect(mUi->actionZoomIn, &QAction::triggered, mGraphicsView, &GraphicsView::zoomIn);
@@ -115,12 +166,16 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
             &mProjectEditor, &ProjectEditor::showSchematicEditor);
     connect(mUi->actionEditNetClasses, &QAction::triggered,
             [this](){mProjectEditor.execNetClassesEditorDialog(this);});
+    connect(mUi->actionEditComponentAttributes, &QAction::triggered,
+            [this](){mProjectEditor.execBulkAttributeEditorDialog(this);});
     connect(mUi->actionProjectSettings, &QAction::triggered,
             [this](){mProjectEditor.execProjectSettingsDialog(this);});
 
     // connect the undo/redo actions with the UndoStack of the project
     mUndoStackActionGroup.reset(new UndoStackActionGroup(
         *mUi->actionUndo, *mUi->actionRedo, nullptr, &mProjectEditor.getUndoStack(), this));
+    connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified,
+            [this](){mAnnotationDiffOutdated = true;});
 
     // build the whole board editor finite state machine with all its substate objects
     mFsm = new BES_FSM(*this, *mUi, *mGraphicsView, mProjectEditor.getUndoStack());
@@ -198,6 +253,7 @@ BoardEditor::~BoardEditor()
 
     delete mFsm;                    mFsm = nullptr;
     qDeleteAll(mBoardListActions);  mBoardListActions.clear();
+    delete mNetStatisticsDock;      mNetStatisticsDock = nullptr;
     delete mBoardLayersDock;        mBoardLayersDock = nullptr;
     delete mUnplacedComponentsDock; mUnplacedComponentsDock = nullptr;
     delete mErcMsgDock;             mErcMsgDock = nullptr;
@@ -235,7 +291,13 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept
     board = mProject.getBoardByIndex(index);
     if (board)
     {
-        // show scene, restore view scene rect, set grid properties
+        // apply level of detail settings, show scene, restore view scene rect,
+        // set grid properties
+        const workspace::WSI_Appearance& appearance =
+            mProjectEditor.getWorkspace().getSettings().getAppearance();
+        board->getGraphicsScene().setLevelOfDetail(GraphicsScene::LevelOfDetail{
+            qreal(appearance.getLodMinTextSize()), qreal(appearance.getLodMinPadSize()),
+            qreal(appearance.getLodMinFootprintSize())});
         board->showInView(*mGraphicsView);
         mGraphicsView->setVisibleSceneRect(board->restoreViewSceneRect());
         mGraphicsView->setGridProperties(board->getGridProperties());
@@ -253,6 +315,7 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept
     mActiveBoardIndex = index;
     mUnplacedComponentsDock->setBoard(board);
     mBoardLayersDock->setActiveBoard(board);
+    mNetStatisticsDock->setActiveBoard(board);
     mUi->tabBar->setCurrentIndex(index);
     emit activeBoardChanged(oldIndex, index);
     return true;
@@ -270,6 +333,39 @@ void BoardEditor::abortAllCommands() noexcept
     mFsm->processEvent(new BEE_Base(BEE_Base::AbortCommand), true);
 }
 
+bool BoardEditor::showComponentInstance(const ComponentInstance& component) noexcept
+{
+    const QList<BI_Device*>& devices = component.getRegisteredDevices();
+    if (devices.isEmpty()) return false;
+
+    // prefer the device on the active board
+    BI_Device* device = devices.first();
+    foreach (BI_Device* dev, devices) {
+        if (&dev->getBoard() == getActiveBoard()) device = dev;
+    }
+    abortAllCommands();
+    Board& board = device->getBoard();
+    if (!setActiveBoardIndex(mProject.getBoardIndex(board))) return false;
+
+    // select the device
+    board.clearSelection();
+    device->setSelected(true);
+
+    // scroll to the device, but keep the zoom level if it fits into the view
+    QRectF rect = device->getGrabAreaScenePx().boundingRect();
+    QRectF visibleRect = mGraphicsView->getVisibleSceneRect();
+    if (!visibleRect.contains(rect)) {
+        if ((rect.width() < visibleRect.width()) && (rect.height() < visibleRect.height())) {
+            visibleRect.moveCenter(rect.center());
+        } else {
+            visibleRect = rect.adjusted(-rect.width() / 4, -rect.height() / 4,
+                                        rect.width() / 4, rect.height() / 4);
+        }
+        mGraphicsView->setVisibleSceneRect(visibleRect);
+    }
+    return true;
+}
+
 /*****************************************************************************************
  *  Inherited Methods
  ****************************************************************************************/
@@ -402,6 +498,71 @@ void BoardEditor::on_actionExportAsPdf_triggered()
     }
 }
 
+void BoardEditor::on_actionExportAsImage_triggered()
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    // only layers with board items, as shown in the editor
+    QStringList layerNames;
+    foreach (const GraphicsLayer* layer, board->getLayerStack().getAllLayers()) {
+        if (layer->isVisible() && (GraphicsLayer::isCopperLayer(layer->getName()) ||
+            GraphicsLayer::getBoardGeometryElementLayerNames().contains(layer->getName())))
+        {
+            layerNames.append(layer->getName());
+        }
+    }
+    if (layerNames.isEmpty()) {
+        QMessageBox::information(this, tr("Image Export"), tr("There are no visible layers "
+            "to export."));
+        return;
+    }
+
+    QStringList modes;
+    modes << tr("All visible layers in one image") << tr("One image per visible layer");
+    bool ok = false;
+    QString mode = QInputDialog::getItem(this, tr("Image Export"), tr("Export:"), modes, 0,
+                                         false, &ok);
+    if (!ok) return;
+    int dpi = QInputDialog::getInt(this, tr("Image Export"), tr("Resolution [DPI]:"),
+                                   600, 25, 10000, 100, &ok);
+    if (!ok) return;
+
+    BoardImageExport imageExport(*board, mProjectEditor.getWorkspace().getJobScheduler());
+    CamImageWriter::Options options = imageExport.getOptions();
+    options.pixelsPerMm = dpi / 25.4;
+    imageExport.setOptions(options);
+    try
+    {
+        if (mode == modes.first()) {
+            QString filename = QFileDialog::getSaveFileName(this, tr("Image Export"),
+                                                            QDir::homePath(), "*.tiff");
+            if (filename.isEmpty()) return;
+            if (!filename.endsWith(".tiff") && !filename.endsWith(".tif")) {
+                filename.append(".tiff");
+            }
+            QApplication::setOverrideCursor(Qt::WaitCursor);
+            auto cursorGuard = scopeGuard([](){QApplication::restoreOverrideCursor();});
+            imageExport.exportImage(layerNames, FilePath(filename)); // can throw
+            mUi->statusbar->showMessage(tr("Image exported"), 5000);
+        } else {
+            QString dirname = QFileDialog::getExistingDirectory(this, tr("Image Export"),
+                                                                QDir::homePath());
+            if (dirname.isEmpty()) return;
+            QApplication::setOverrideCursor(Qt::WaitCursor);
+            auto cursorGuard = scopeGuard([](){QApplication::restoreOverrideCursor();});
+            QList<FilePath> files = imageExport.exportLayerImages(layerNames,
+                                                                  FilePath(dirname)); // can throw
+            mUi->statusbar->showMessage(QString(tr("%1 image(s) exported"))
+                                        .arg(files.count()), 5000);
+        }
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::warning(this, tr("Error"), e.getMsg());
+    }
+}
+
 void BoardEditor::on_actionGenerateFabricationData_triggered()
 {
     Board* board = getActiveBoard();
@@ -454,6 +615,43 @@ void BoardEditor::on_actionModifyDesignRules_triggered()
     }
 }
 
+void BoardEditor::on_actionRunDesignRuleCheck_triggered()
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    // the violations are listed in the ERC messages dock
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    board->getDesignRuleCheck().execute();
+    QApplication::restoreOverrideCursor();
+    mUi->statusbar->showMessage(QString(tr("Design rule check finished: %1 violation(s)"))
+                                .arg(board->getDesignRuleCheck().getViolations().count()), 5000);
+}
+
+void BoardEditor::on_actionCleanUpTraces_triggered()
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    try {
+        int netLineCount = board->getNetLines().count();
+        int netPointCount = board->getNetPoints().count();
+        mProjectEditor.getUndoStack().execCmd(new CmdCleanUpBoardTraces(*board)); // can throw
+        mUi->statusbar->showMessage(QString(tr("Traces cleaned up: %1 trace(s) and %2 net "
+            "point(s) removed")).arg(netLineCount - board->getNetLines().count())
+            .arg(netPointCount - board->getNetPoints().count()), 5000);
+    } catch (Exception& e) {
+        QMessageBox::critical(this, tr("Error"), e.getMsg());
+    }
+}
+
+void BoardEditor::on_actionUpdateFromSchematic_triggered()
+{
+    Board* board = getActiveBoard();
+    if ((!board) || mAnnotationDiffRunning) return;
+    startAnnotationDiff(*board);
+}
+
 void BoardEditor::on_tabBar_currentChanged(int index)
 {
     setActiveBoardIndex(index);
@@ -464,14 +662,91 @@ void BoardEditor::boardListActionGroupTriggered(QAction* action)
     setActiveBoardIndex(mBoardListActions.indexOf(action));
 }
 
+void BoardEditor::annotationDiffFinished() noexcept
+{
+    mAnnotationDiffRunning = false;
+    mUi->actionUpdateFromSchematic->setEnabled(true);
+    mUi->statusbar->clearMessage();
+    Board* board = mAnnotationDiffBoard;
+    mAnnotationDiffBoard = nullptr;
+    if ((!board) || (board != getActiveBoard())) return; // board has changed
+    if (mAnnotationDiffOutdated) {
+        startAnnotationDiff(*board); // the result may refer to removed items
+        return;
+    }
+    BoardAnnotationDiff::Result diff = mAnnotationDiffResult;
+
+    // let the user review the changes before applying them
+    QMessageBox msgBox(this);
+    msgBox.setWindowTitle(tr("Update Board from Schematic"));
+    if (!diff.warnings.isEmpty()) {
+        msgBox.setDetailedText(diff.warnings.join("\n"));
+    }
+    if (diff.isEmpty()) {
+        msgBox.setIcon(diff.warnings.isEmpty() ? QMessageBox::Information : QMessageBox::Warning);
+        msgBox.setText(diff.warnings.isEmpty() ? tr("The board is up to date.") :
+            tr("The board is up to date, but some conflicts need to be resolved manually "
+               "(see details)."));
+        msgBox.exec();
+        return;
+    }
+    QString text = QString(tr("The following changes will be applied to the board:\n\n"
+        "%1 device(s) added\n%2 device(s) removed\n%3 device(s) replaced\n"
+        "%4 net point(s) and %5 via(s) moved to another net signal"))
+        .arg(diff.addedDevices.count()).arg(diff.removedDevices.count())
+        .arg(diff.replacedDevices.count()).arg(diff.netPointChanges.count())
+        .arg(diff.viaChanges.count());
+    if (!diff.warnings.isEmpty()) {
+        text += "\n\n" + tr("Some conflicts need to be resolved manually (see details).");
+    }
+    msgBox.setIcon(QMessageBox::Question);
+    msgBox.setText(text);
+    msgBox.setStandardButtons(QMessageBox::Apply | QMessageBox::Cancel);
+    if (msgBox.exec() != QMessageBox::Apply) return;
+
+    try {
+        mProjectEditor.getUndoStack().execCmd(new CmdApplyBoardAnnotationDiff(
+            mProjectEditor.getWorkspace(), *board, diff)); // can throw
+        mUi->statusbar->showMessage(tr("Board updated from schematic"), 5000);
+    } catch (Exception& e) {
+        QMessageBox::critical(this, tr("Error"), e.getMsg());
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
 bool BoardEditor::graphicsViewEventHandler(QEvent* event)
 {
-    BEE_RedirectedQEvent* e = new BEE_RedirectedQEvent(BEE_Base::GraphicsViewEvent, event);
-    return mFsm->processEvent(e, true);
+    // this is called very often (e.g. mouse moves), so avoid an allocation per event
+    BEE_RedirectedQEvent e(BEE_Base::GraphicsViewEvent, event);
+    return mFsm->processEvent(&e, false);
+}
+
+void BoardEditor::startAnnotationDiff(Board& board) noexcept
+{
+    // the state must be created here since the project must not be accessed from the
+    // job, the library database is used for components without devices in the project
+    BoardAnnotationDiff::State state = BoardAnnotationDiff::createState(board);
+    for (BoardAnnotationDiff::Component& component : state.components) {
+        if (component.schematicOnly || (!component.deviceCandidates.isEmpty())) continue;
+        try {
+            QList<Uuid> devices = mProjectEditor.getWorkspace().getLibraryDb()
+                .getDevicesOfComponent(component.libComponentUuid).toList(); // can throw
+            std::sort(devices.begin(), devices.end());
+            component.deviceCandidates = devices;
+        } catch (const Exception& e) {
+            qCritical() << "Could not get devices from library database:" << e.getMsg();
+        }
+    }
+
+    mAnnotationDiffRunning = true;
+    mAnnotationDiffOutdated = false;
+    mAnnotationDiffBoard = &board;
+    mUi->actionUpdateFromSchematic->setEnabled(false);
+    mUi->statusbar->showMessage(tr("Comparing board with schematics..."));
+    mAnnotationDiffJobs.start(new AnnotationDiffJob(*this, state, mAnnotationDiffResult));
 }
 
 void BoardEditor::toolActionGroupChangeTriggered(const QVariant& newTool) noexcept
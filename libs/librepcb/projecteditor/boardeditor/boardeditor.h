@@ -26,7 +26,9 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/uuid.h>
+#include <librepcb/common/jobscheduler.h>
 #include <librepcb/common/graphics/if_graphicsvieweventhandler.h>
+#include <librepcb/project/boards/boardannotationdiff.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -50,6 +52,7 @@ class ProjectEditor;
 class ErcMsgDock;
 class UnplacedComponentsDock;
 class BoardLayersDock;
+class NetStatisticsDock;
 class BES_FSM;
 
 namespace Ui {
@@ -85,6 +88,19 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
         // General Methods
         void abortAllCommands() noexcept;
 
+        /**
+         * @brief Show and select the device of a component (e.g. for cross-probing)
+         *
+         * The device on the active board is preferred. If the component is not placed
+         * on the active board, the editor switches to the first board containing it.
+         * The current selection is replaced by the device and the view is scrolled to it.
+         *
+         * @param component     The component to show
+         *
+         * @return false if the component has no devices or the board could not be switched
+         */
+        bool showComponentInstance(const ComponentInstance& component) noexcept;
+
 
     protected:
 
@@ -105,12 +121,17 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
         void on_actionCopyBoard_triggered();
         void on_actionGrid_triggered();
         void on_actionExportAsPdf_triggered();
+        void on_actionExportAsImage_triggered();
         void on_actionGenerateFabricationData_triggered();
         void on_actionProjectProperties_triggered();
         void on_actionLayerStackSetup_triggered();
         void on_actionModifyDesignRules_triggered();
+        void on_actionRunDesignRuleCheck_triggered();
+        void on_actionCleanUpTraces_triggered();
+        void on_actionUpdateFromSchematic_triggered();
         void on_tabBar_currentChanged(int index);
         void boardListActionGroupTriggered(QAction* action);
+        void annotationDiffFinished() noexcept;
 
 
     signals:
@@ -128,6 +149,10 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
         // Private Methods
         bool graphicsViewEventHandler(QEvent* event);
         void toolActionGroupChangeTriggered(const QVariant& newTool) noexcept;
+        void startAnnotationDiff(Board& board) noexcept;
+
+        // Types
+        class AnnotationDiffJob;
 
         // General Attributes
         ProjectEditor& mProjectEditor;
@@ -146,9 +171,17 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
         ErcMsgDock* mErcMsgDock;
         UnplacedComponentsDock* mUnplacedComponentsDock;
         BoardLayersDock* mBoardLayersDock;
+        NetStatisticsDock* mNetStatisticsDock;
 
         // Finite State Machine
         BES_FSM* mFsm;
+
+        // Forward Annotation
+        bool mAnnotationDiffRunning;
+        bool mAnnotationDiffOutdated;     ///< the project was modified during the calculation
+        Board* mAnnotationDiffBoard;
+        BoardAnnotationDiff::Result mAnnotationDiffResult; ///< written by the running job
+        JobScheduler::Group mAnnotationDiffJobs; ///< must be destroyed before the result
 };
 
 /*****************************************************************************************
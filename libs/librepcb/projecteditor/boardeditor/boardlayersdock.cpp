@@ -63,7 +63,8 @@ void BoardLayersDock::setActiveBoard(Board* board)
     mActiveBoard = board;
 
     if (mActiveBoard) {
-        mActiveBoardConnection = connect(mActiveBoard, &Board::attributesChanged,
+        mActiveBoardConnection = connect(&mActiveBoard->getLayerStack(),
+                                         &BoardLayerStack::layersChanged,
                                          this, &BoardLayersDock::updateListWidget);
     }
 
@@ -173,7 +174,7 @@ QList<QString> BoardLayersDock::getCommonLayers() const noexcept
 {
     QList<QString> layers;
     //layers.append(GraphicsLayer::sBoardBackground));
-    //layers.append(GraphicsLayer::sBoardErcAirWires));
+    layers.append(GraphicsLayer::sBoardAirWires);
     layers.append(GraphicsLayer::sBoardOutlines);
     layers.append(GraphicsLayer::sBoardDrillsNpth);
     layers.append(GraphicsLayer::sBoardViasTht);
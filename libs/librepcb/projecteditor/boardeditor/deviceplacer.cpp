@@ -0,0 +1,290 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "deviceplacer.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprint.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+DevicePlacer::DevicePlacer(const QList<Item>& items, const Point& startPos,
+                           const Length& clearance, const Length& gridInterval) noexcept :
+    mItems(items), mStartPos(startPos), mClearance(clearance.toNm() + gridInterval.toNm()),
+    mGridInterval(gridInterval), mMaxNetSize(8), mMaxClusterSize(40)
+{
+}
+
+DevicePlacer::~DevicePlacer() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QHash<Uuid, Point> DevicePlacer::calculatePositions(Length* bottom) const noexcept
+{
+    // pack the devices of each cluster into an approximately square area
+    QList<QList<int>> clusters = buildClusters();
+    QVector<Packing> clusterPackings;
+    QVector<QPair<qint64, qint64>> clusterSizes;
+    qreal totalArea = 0;
+    qint64 maxClusterWidth = 0;
+    foreach (const QList<int>& cluster, clusters) {
+        QVector<QPair<qint64, qint64>> sizes;
+        qreal area = 0;
+        qint64 maxWidth = 0;
+        foreach (int index, cluster) {
+            const Item& item = mItems.at(index);
+            qint64 w = (item.topRight.getX() - item.bottomLeft.getX()).toNm() + mClearance;
+            qint64 h = (item.topRight.getY() - item.bottomLeft.getY()).toNm() + mClearance;
+            sizes.append(qMakePair(w, h));
+            area += qreal(w) * qreal(h);
+            maxWidth = qMax(maxWidth, w);
+        }
+        Packing packing = packRows(sizes, qMax(maxWidth, qint64(qSqrt(area))));
+        clusterSizes.append(qMakePair(packing.width, packing.height));
+        clusterPackings.append(packing);
+        totalArea += qreal(packing.width) * qreal(packing.height);
+        maxClusterWidth = qMax(maxClusterWidth, packing.width);
+    }
+
+    // pack the clusters, sorted by height to waste less space in the rows
+    QVector<int> clusterOrder;
+    for (int i = 0; i < clusters.count(); ++i) clusterOrder.append(i);
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](int a, int b){
+        return clusterSizes.at(a).second > clusterSizes.at(b).second;
+    });
+    QVector<QPair<qint64, qint64>> orderedSizes;
+    foreach (int index, clusterOrder) orderedSizes.append(clusterSizes.at(index));
+    Packing layout = packRows(orderedSizes, qMax(maxClusterWidth, qint64(qSqrt(totalArea * 1.5))));
+
+    // convert the offsets to grid-aligned device positions
+    QHash<Uuid, Point> positions;
+    for (int i = 0; i < clusterOrder.count(); ++i) {
+        const QList<int>& cluster = clusters.at(clusterOrder.at(i));
+        const Packing& packing = clusterPackings.at(clusterOrder.at(i));
+        for (int k = 0; k < cluster.count(); ++k) {
+            const Item& item = mItems.at(cluster.at(k));
+            qint64 left = mStartPos.getX().toNm() + layout.offsets.at(i).first
+                          + packing.offsets.at(k).first + mClearance / 2;
+            qint64 top = mStartPos.getY().toNm() - layout.offsets.at(i).second
+                         - packing.offsets.at(k).second - mClearance / 2;
+            Point pos(Length(left) - item.bottomLeft.getX(), Length(top) - item.topRight.getY());
+            positions.insert(item.component, pos.mappedToGrid(mGridInterval));
+        }
+    }
+    if (bottom) *bottom = mStartPos.getY() - Length(layout.height);
+    return positions;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+void DevicePlacer::getFootprintBoundingBox(const library::Footprint& footprint,
+                                           Point& bottomLeft, Point& topRight) noexcept
+{
+    // prefer the courtyard since it represents the area required to mount the device
+    QRectF courtyardRect, rect;
+    for (const Polygon& polygon : footprint.getPolygons()) {
+        qreal w = polygon.getLineWidth().toPx() / 2;
+        QRectF polygonRect = polygon.toQPainterPathPx().boundingRect().adjusted(-w, -w, w, w);
+        if ((polygon.getLayerName() == GraphicsLayer::sTopCourtyard) ||
+            (polygon.getLayerName() == GraphicsLayer::sBotCourtyard)) {
+            courtyardRect = courtyardRect.united(polygonRect);
+        }
+        rect = rect.united(polygonRect);
+    }
+    if (const CompactPolygonList* polygons = footprint.getCompactPolygons()) {
+        for (int i = 0; i < polygons->count(); ++i) {
+            qreal w = polygons->getLineWidth(i).toPx() / 2;
+            QRectF polygonRect = polygons->toQPainterPathPx(i).boundingRect().adjusted(-w, -w, w, w);
+            if ((polygons->getLayerName(i) == GraphicsLayer::sTopCourtyard) ||
+                (polygons->getLayerName(i) == GraphicsLayer::sBotCourtyard)) {
+                courtyardRect = courtyardRect.united(polygonRect);
+            }
+            rect = rect.united(polygonRect);
+        }
+    }
+    for (const Ellipse& ellipse : footprint.getEllipses()) {
+        // ignore the rotation, the bounding box of the enclosing circle is good enough
+        qreal r = (qMax(ellipse.getRadiusX(), ellipse.getRadiusY()) +
+                   ellipse.getLineWidth() / 2).toPx();
+        QPointF center = ellipse.getCenter().toPxQPointF();
+        rect = rect.united(QRectF(center.x() - r, center.y() - r, 2 * r, 2 * r));
+    }
+    for (const library::FootprintPad& pad : footprint.getPads()) {
+        QTransform t;
+        t.translate(pad.getPosition().toPxQPointF().x(), pad.getPosition().toPxQPointF().y());
+        t.rotate(-pad.getRotation().toDeg());
+        rect = rect.united(t.mapRect(pad.getBoundingRectPx()));
+    }
+    for (const Hole& hole : footprint.getHoles()) {
+        qreal r = hole.getDiameter().toPx() / 2;
+        QPointF center = hole.getPosition().toPxQPointF();
+        rect = rect.united(QRectF(center.x() - r, center.y() - r, 2 * r, 2 * r));
+    }
+    if (!courtyardRect.isEmpty()) {
+        rect = courtyardRect;
+    }
+
+    // note: the y-axis of the scene coordinates points downwards
+    bottomLeft = Point::fromPx(rect.bottomLeft());
+    topRight = Point::fromPx(rect.topRight());
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QList<QList<int>> DevicePlacer::buildClusters() const noexcept
+{
+    // collect the devices of all nets which are relevant for clustering
+    QMap<Uuid, QList<int>> netItems; // QMap to get a deterministic result
+    for (int i = 0; i < mItems.count(); ++i) {
+        foreach (const Uuid& net, mItems.at(i).netSignals) {
+            netItems[net].append(i);
+        }
+    }
+    QList<QList<int>> nets;
+    foreach (const QList<int>& items, netItems) {
+        if ((items.count() > 1) && (items.count() <= mMaxNetSize)) {
+            nets.append(items);
+        }
+    }
+    // merge strongly connected devices (small nets) first
+    std::stable_sort(nets.begin(), nets.end(), [](const QList<int>& a, const QList<int>& b){
+        return a.count() < b.count();
+    });
+
+    // merge the clusters with a union-find structure
+    QVector<int> parent(mItems.count());
+    QVector<int> size(mItems.count(), 1);
+    for (int i = 0; i < parent.count(); ++i) parent[i] = i;
+    auto findRoot = [&parent](int i) {
+        while (parent.at(i) != i) {
+            parent[i] = parent.at(parent.at(i));
+            i = parent.at(i);
+        }
+        return i;
+    };
+    QHash<int, QSet<int>> neighbours;
+    foreach (const QList<int>& items, nets) {
+        for (int i = 1; i < items.count(); ++i) {
+            int a = findRoot(items.first());
+            int b = findRoot(items.at(i));
+            if ((a != b) && (size.at(a) + size.at(b) <= mMaxClusterSize)) {
+                parent[b] = a;
+                size[a] += size.at(b);
+            }
+        }
+        foreach (int a, items) {
+            foreach (int b, items) {
+                if (a != b) neighbours[a].insert(b);
+            }
+        }
+    }
+
+    // list the devices of each cluster in breadth-first order, starting with the device
+    // having the most connections, so connected devices are packed next to each other
+    QMap<int, QList<int>> members;
+    for (int i = 0; i < mItems.count(); ++i) {
+        members[findRoot(i)].append(i);
+    }
+    QList<QList<int>> clusters;
+    foreach (const QList<int>& cluster, members) {
+        int start = cluster.first();
+        foreach (int index, cluster) {
+            if (neighbours.value(index).count() > neighbours.value(start).count()) {
+                start = index;
+            }
+        }
+        QList<int> ordered;
+        QSet<int> visited;
+        ordered.append(start);
+        visited.insert(start);
+        for (int i = 0; i < cluster.count(); ++i) {
+            if (i >= ordered.count()) {
+                // not connected to the previous devices (limited by mMaxNetSize)
+                foreach (int index, cluster) {
+                    if (!visited.contains(index)) {
+                        ordered.append(index);
+                        visited.insert(index);
+                        break;
+                    }
+                }
+            }
+            QList<int> next = neighbours.value(ordered.at(i)).toList();
+            std::sort(next.begin(), next.end());
+            foreach (int index, next) {
+                if ((!visited.contains(index)) && (findRoot(index) == findRoot(start))) {
+                    ordered.append(index);
+                    visited.insert(index);
+                }
+            }
+        }
+        clusters.append(ordered);
+    }
+    return clusters;
+}
+
+DevicePlacer::Packing DevicePlacer::packRows(const QVector<QPair<qint64, qint64>>& sizes,
+                                             qint64 rowWidth) noexcept
+{
+    Packing packing;
+    packing.width = 0;
+    packing.height = 0;
+    qint64 x = 0, y = 0, rowHeight = 0;
+    for (int i = 0; i < sizes.count(); ++i) {
+        if ((x > 0) && (x + sizes.at(i).first > rowWidth)) {
+            // start a new row
+            y += rowHeight;
+            x = 0;
+            rowHeight = 0;
+        }
+        packing.offsets.append(qMakePair(x, y));
+        x += sizes.at(i).first;
+        rowHeight = qMax(rowHeight, sizes.at(i).second);
+        packing.width = qMax(packing.width, x);
+    }
+    packing.height = y + rowHeight;
+    return packing;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,143 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_DEVICEPLACER_H
+#define LIBREPCB_PROJECT_DEVICEPLACER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace library {
+class Footprint;
+}
+
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Class DevicePlacer
+ ****************************************************************************************/
+
+/**
+ * @brief Calculates non-overlapping board positions for a set of devices
+ *
+ * The devices are grouped into clusters of components which are connected by the same
+ * (small) nets, so that connected devices end up next to each other. Nets with many
+ * connections (e.g. supply nets) are ignored for clustering since they would merge
+ * everything into a single cluster. Each cluster is packed row by row, and the clusters
+ * are then packed the same way into an approximately square area whose top left corner
+ * is the given start position.
+ *
+ * The class only works on the plain data passed to the constructor, so
+ * #calculatePositions() may be called from any thread.
+ */
+class DevicePlacer final
+{
+    public:
+
+        /// A device to place, with its footprint bounding box relative to its origin
+        struct Item {
+            Uuid component;         ///< the component instance UUID (used as key)
+            Point bottomLeft;       ///< bounding box of the footprint (lower left corner)
+            Point topRight;         ///< bounding box of the footprint (upper right corner)
+            QSet<Uuid> netSignals;  ///< UUIDs of all nets connected to the device
+        };
+
+        // Constructors / Destructor
+        DevicePlacer() = delete;
+        DevicePlacer(const DevicePlacer& other) = default;
+        DevicePlacer(const QList<Item>& items, const Point& startPos,
+                     const Length& clearance, const Length& gridInterval) noexcept;
+        ~DevicePlacer() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Calculate the positions of all devices
+         *
+         * @param bottom    If not nullptr, the bottom edge of the used area is written
+         *                  to this variable
+         *
+         * @return The (grid-aligned) device positions (key: component instance UUID)
+         */
+        QHash<Uuid, Point> calculatePositions(Length* bottom = nullptr) const noexcept;
+
+        // Operator Overloadings
+        DevicePlacer& operator=(const DevicePlacer& rhs) = delete;
+
+
+        // Static Methods
+
+        /**
+         * @brief Get the bounding box of a footprint relative to its origin
+         *
+         * If the footprint contains courtyard polygons, only these are taken into account.
+         * Otherwise the bounding box of all polygons, ellipses, pads and holes is used.
+         *
+         * @param footprint     The footprint to measure
+         * @param bottomLeft    The lower left corner of the bounding box
+         * @param topRight      The upper right corner of the bounding box
+         */
+        static void getFootprintBoundingBox(const library::Footprint& footprint,
+                                            Point& bottomLeft, Point& topRight) noexcept;
+
+
+    private: // Types
+
+        /// Result of packing a list of rectangles row by row
+        struct Packing {
+            QVector<QPair<qint64, qint64>> offsets; ///< offset (x, y downwards) in nm
+            qint64 width;   ///< total width in nm
+            qint64 height;  ///< total height in nm
+        };
+
+
+    private: // Methods
+        QList<QList<int>> buildClusters() const noexcept;
+        static Packing packRows(const QVector<QPair<qint64, qint64>>& sizes,
+                                qint64 rowWidth) noexcept;
+
+
+    private: // Data
+        QList<Item> mItems;
+        Point mStartPos;
+        qint64 mClearance;      ///< required space between two devices (incl. grid) in nm
+        Length mGridInterval;
+        int mMaxNetSize;        ///< nets with more devices are ignored for clustering
+        int mMaxClusterSize;    ///< maximum count of devices in a cluster
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_DEVICEPLACER_H
@@ -30,6 +30,8 @@
 #include <librepcb/common/undostack.h>
 #include <librepcb/project/boards/cmd/cmdboardviaadd.h>
 #include <librepcb/project/boards/cmd/cmdboardviaedit.h>
+#include <librepcb/project/boards/cmd/cmdboardviasadd.h>
+#include <librepcb/project/boards/boardviastitching.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/circuit/circuit.h>
 #include <librepcb/project/circuit/netsignal.h>
@@ -50,9 +52,11 @@ BES_AddVia::BES_AddVia(BoardEditor& editor, Ui::BoardEditor& editorUi,
     BES_Base(editor, editorUi, editorGraphicsView, undoStack),
     mUndoCmdActive(false), mCurrentVia(nullptr), mCurrentViaShape(BI_Via::Shape::Round),
     mCurrentViaSize(700000), mCurrentViaDrillDiameter(300000), mCurrentViaNetSignal(nullptr),
+    mStitchRectActive(false), mCurrentStitchPitch(2000000),
     // command toolbar actions / widgets:
     mSizeLabel(nullptr), mSizeComboBox(nullptr), mDrillLabel(nullptr),
-    mDrillComboBox(nullptr), mNetSignalLabel(nullptr), mNetSignalComboBox(nullptr)
+    mDrillComboBox(nullptr), mNetSignalLabel(nullptr), mNetSignalComboBox(nullptr),
+    mPitchLabel(nullptr), mPitchComboBox(nullptr), mStitchOutlineAction(nullptr)
 {
 }
 
@@ -173,6 +177,42 @@ bool BES_AddVia::entry(BEE_Base* event) noexcept
             [this](const QString& value)
             {mCurrentViaNetSignal = mEditor.getProject().getCircuit().getNetSignalByName(value);});
 
+    // add the "Pitch:" label to the toolbar
+    mPitchLabel = new QLabel(tr("Stitching Pitch:"));
+    mPitchLabel->setIndent(10);
+    mEditorUi.commandToolbar->addWidget(mPitchLabel);
+
+    // add the stitching pitch combobox to the toolbar
+    mPitchComboBox = new QComboBox();
+    mPitchComboBox->setMinimumContentsLength(6);
+    mPitchComboBox->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    mPitchComboBox->setInsertPolicy(QComboBox::NoInsert);
+    mPitchComboBox->setEditable(true);
+    mPitchComboBox->setToolTip(tr("Drag a rectangle with the shift key pressed "
+                                  "to fill it with vias of the selected signal"));
+    mPitchComboBox->addItem("1");
+    mPitchComboBox->addItem("1.27");
+    mPitchComboBox->addItem("2");
+    mPitchComboBox->addItem("2.54");
+    mPitchComboBox->addItem("5");
+    mPitchComboBox->setCurrentIndex(mPitchComboBox->findText(QString::number(mCurrentStitchPitch.toMm())));
+    mEditorUi.commandToolbar->addWidget(mPitchComboBox);
+    connect(mPitchComboBox, &QComboBox::currentTextChanged,
+            [this](const QString& value)
+            {try{ mCurrentStitchPitch = Length::fromMm(value); } catch (...) {} });
+
+    // add the "stitch board outline" action to the toolbar
+    mStitchOutlineAction = mEditorUi.commandToolbar->addAction(tr("Stitch Board Outline"));
+    mStitchOutlineAction->setToolTip(tr("Fill the whole board with vias of the selected signal"));
+    connect(mStitchOutlineAction, &QAction::triggered,
+            [this](){
+                Board* board = mEditor.getActiveBoard();
+                if (board) {
+                    stitchVias(*board, BoardViaStitching::getBoardOutlines(*board),
+                               mCurrentVia ? mCurrentVia->getPosition() : Point(0, 0));
+                }
+            });
+
     return true;
 }
 
@@ -194,7 +234,17 @@ bool BES_AddVia::exit(BEE_Base* event) noexcept
         }
     }
 
+    if (mStitchRectActive) {
+        if (Board* board = mEditor.getActiveBoard()) {
+            board->setSelectionRect(Point(), Point(), false);
+        }
+        mStitchRectActive = false;
+    }
+
     // Remove actions / widgets from the "command" toolbar
+    delete mStitchOutlineAction;    mStitchOutlineAction = nullptr;
+    delete mPitchComboBox;          mPitchComboBox = nullptr;
+    delete mPitchLabel;             mPitchLabel = nullptr;
     delete mNetSignalComboBox;      mNetSignalComboBox = nullptr;
     delete mNetSignalLabel;         mNetSignalLabel = nullptr;
     delete mDrillComboBox;          mDrillComboBox = nullptr;
@@ -228,6 +278,13 @@ BES_Base::ProcRetVal BES_AddVia::processSceneEvent(BEE_Base* event) noexcept
             {
                 case Qt::LeftButton:
                 {
+                    if ((qevent->type() == QEvent::GraphicsSceneMousePress) &&
+                        (sceneEvent->modifiers() & Qt::ShiftModifier)) {
+                        // start dragging the rectangle to stitch
+                        mStitchRectActive = true;
+                        mStitchRectStartPos = pos;
+                        return ForceStayInState;
+                    }
                     fixVia(pos);
                     addVia(*board);
                     updateVia(*board, pos);
@@ -241,6 +298,21 @@ BES_Base::ProcRetVal BES_AddVia::processSceneEvent(BEE_Base* event) noexcept
             break;
         }
 
+        case QEvent::GraphicsSceneMouseRelease:
+        {
+            QGraphicsSceneMouseEvent* sceneEvent = dynamic_cast<QGraphicsSceneMouseEvent*>(qevent);
+            Q_ASSERT(sceneEvent);
+            if (mStitchRectActive && (sceneEvent->button() == Qt::LeftButton)) {
+                Point pos = Point::fromPx(sceneEvent->scenePos(), board->getGridProperties().getInterval());
+                board->setSelectionRect(Point(), Point(), false);
+                mStitchRectActive = false;
+                stitchVias(*board, {BoardViaStitching::getRectOutline(mStitchRectStartPos, pos)},
+                           pos);
+                return ForceStayInState;
+            }
+            break;
+        }
+
         /*case QEvent::GraphicsSceneMouseRelease:
         {
             QGraphicsSceneMouseEvent* sceneEvent = dynamic_cast<QGraphicsSceneMouseEvent*>(qevent);
@@ -266,6 +338,9 @@ BES_Base::ProcRetVal BES_AddVia::processSceneEvent(BEE_Base* event) noexcept
             QGraphicsSceneMouseEvent* sceneEvent = dynamic_cast<QGraphicsSceneMouseEvent*>(qevent);
             Q_ASSERT(sceneEvent);
             Point pos = Point::fromPx(sceneEvent->scenePos(), board->getGridProperties().getInterval());
+            if (mStitchRectActive) {
+                board->setSelectionRect(mStitchRectStartPos, pos, false);
+            }
             updateVia(*board, pos);
             return ForceStayInState;
         }
@@ -348,6 +423,51 @@ bool BES_AddVia::fixVia(const Point& pos) noexcept
     }
 }
 
+bool BES_AddVia::stitchVias(Board& board, const QVector<QVector<Point>>& outlines,
+                            const Point& pos) noexcept
+{
+    if (!mCurrentViaNetSignal) {
+        QMessageBox::information(&mEditor, tr("Via Stitching"),
+                                 tr("Please choose the signal of the vias first."));
+        return false;
+    }
+
+    bool success = false;
+    try
+    {
+        // remove the via attached to the cursor (it must not be an obstacle), add all
+        // vias in a single command and attach a new via to the cursor again
+        if (mUndoCmdActive) {
+            mEditCmd.reset();
+            mUndoStack.abortCmdGroup(); // can throw
+            mUndoCmdActive = false;
+            mCurrentVia = nullptr;
+        }
+        QVector<Point> positions;
+        BoardViaStitching stitching(board, *mCurrentViaNetSignal, mCurrentViaSize);
+        stitching.setPitch(mCurrentStitchPitch);
+        foreach (const QVector<Point>& outline, outlines) {
+            positions += stitching.calculate(outline);
+        }
+        if (positions.isEmpty()) {
+            mEditorUi.statusbar->showMessage(tr("No space for vias found."), 5000);
+        } else {
+            mUndoStack.execCmd(new CmdBoardViasAdd(board, positions, mCurrentViaShape,
+                mCurrentViaSize, mCurrentViaDrillDiameter, mCurrentViaNetSignal)); // can throw
+            mEditorUi.statusbar->showMessage(tr("%n via(s) added.", "", positions.count()), 5000);
+            success = true;
+        }
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
+    }
+    if ((!mUndoCmdActive) && addVia(board)) {
+        updateVia(board, pos);
+    }
+    return success;
+}
+
 void BES_AddVia::updateShapeActionsCheckedState() noexcept
 {
     foreach (int key, mShapeActions.keys())
@@ -45,6 +45,13 @@ namespace editor {
 
 /**
  * @brief The BES_AddVia class
+ *
+ * Besides placing single vias by clicking, a whole via array can be placed at once
+ * (e.g. for ground stitching): Dragging a rectangle with the shift key pressed fills
+ * the rectangle, and the "stitch board outline" action fills the board outlines. The
+ * positions are calculated by librepcb::project::BoardViaStitching with the current via
+ * settings and pitch, and all vias are added with one
+ * librepcb::project::CmdBoardViasAdd.
  */
 class BES_AddVia final : public BES_Base
 {
@@ -70,6 +77,8 @@ class BES_AddVia final : public BES_Base
         bool addVia(Board& board) noexcept;
         bool updateVia(Board& board, const Point& pos) noexcept;
         bool fixVia(const Point& pos) noexcept;
+        bool stitchVias(Board& board, const QVector<QVector<Point>>& outlines,
+                        const Point& pos) noexcept;
         void updateShapeActionsCheckedState() noexcept;
 
 
@@ -81,6 +90,9 @@ class BES_AddVia final : public BES_Base
         Length mCurrentViaDrillDiameter;
         NetSignal* mCurrentViaNetSignal;
         QScopedPointer<CmdBoardViaEdit> mEditCmd;
+        bool mStitchRectActive; ///< a rectangle to stitch is being dragged
+        Point mStitchRectStartPos;
+        Length mCurrentStitchPitch;
 
         // Widgets for the command toolbar
         QHash<int, QAction*> mShapeActions;
@@ -91,6 +103,9 @@ class BES_AddVia final : public BES_Base
         QComboBox* mDrillComboBox;
         QLabel* mNetSignalLabel;
         QComboBox* mNetSignalComboBox;
+        QLabel* mPitchLabel;
+        QComboBox* mPitchComboBox;
+        QAction* mStitchOutlineAction;
 };
 
 /*****************************************************************************************
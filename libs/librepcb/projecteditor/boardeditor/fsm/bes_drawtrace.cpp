@@ -34,6 +34,11 @@
 #include <librepcb/project/boards/cmd/cmdboardnetpointadd.h>
 #include <librepcb/project/boards/cmd/cmdboardnetlineadd.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boarddesignrulecheck.h>
+#include <librepcb/project/boards/boardtracerouter.h>
+#include <librepcb/project/boards/boardruletable.h>
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/library/pkg/footprintpad.h>
 #include <librepcb/project/boards/items/bi_footprint.h>
 #include <librepcb/project/boards/items/bi_footprintpad.h>
@@ -64,11 +69,10 @@ BES_DrawTrace::BES_DrawTrace(BoardEditor& editor, Ui::BoardEditor& editorUi,
     BES_Base(editor, editorUi, editorGraphicsView, undoStack),
     mSubState(SubState_Idle), mCurrentWireMode(WireMode_HV),
     mCurrentLayerName(GraphicsLayer::sTopCopper), mCurrentWidth(500000),
-    mFixedNetPoint(nullptr), mPositioningNetLine1(nullptr), mPositioningNetPoint1(nullptr),
-    mPositioningNetLine2(nullptr), mPositioningNetPoint2(nullptr),
+    mWalkaround(true), mFixedNetPoint(nullptr), mSnapCacheValid(false),
     // command toolbar actions / widgets:
-    mLayerLabel(nullptr), mLayerComboBox(nullptr), mWidthLabel(nullptr),
-    mWidthComboBox(nullptr)
+    mWalkaroundAction(nullptr), mLayerLabel(nullptr), mLayerComboBox(nullptr),
+    mWidthLabel(nullptr), mWidthComboBox(nullptr)
 {
 }
 
@@ -117,6 +121,15 @@ bool BES_DrawTrace::entry(BEE_Base* event) noexcept
     mActionSeparators.append(mEditorUi.commandToolbar->addSeparator());
     updateWireModeActionsCheckedState();
 
+    // add the walkaround action to the toolbar
+    mWalkaroundAction = mEditorUi.commandToolbar->addAction(tr("Walkaround"));
+    mWalkaroundAction->setToolTip(tr("Route new traces around the copper of other nets"));
+    mWalkaroundAction->setCheckable(true);
+    mWalkaroundAction->setChecked(mWalkaround);
+    connect(mWalkaroundAction, &QAction::toggled,
+            [this](bool checked){mWalkaround = checked; mSnapCacheValid = false;});
+    mActionSeparators.append(mEditorUi.commandToolbar->addSeparator());
+
     // connect the wire mode actions with the slot updateWireModeActionsCheckedState()
     foreach (WireMode mode, mWireModeActions.keys())
     {
@@ -188,6 +201,7 @@ bool BES_DrawTrace::exit(BEE_Base* event) noexcept
     delete mWidthLabel;             mWidthLabel = nullptr;
     delete mLayerComboBox;          mLayerComboBox = nullptr;
     delete mLayerLabel;             mLayerLabel = nullptr;
+    delete mWalkaroundAction;       mWalkaroundAction = nullptr;
     qDeleteAll(mWireModeActions);   mWireModeActions.clear();
     qDeleteAll(mActionSeparators);  mActionSeparators.clear();
 
@@ -230,7 +244,7 @@ BES_Base::ProcRetVal BES_DrawTrace::processIdleSceneEvent(BEE_Base* event) noexc
             {
                 case Qt::LeftButton:
                     // start adding netpoints/netlines
-                    startPositioning(*board, pos);
+                    startPositioning(*board, getSnappedCursorPos(*board, pos));
                     return ForceStayInState;
                 default:
                     break;
@@ -276,7 +290,7 @@ BES_Base::ProcRetVal BES_DrawTrace::processPositioningSceneEvent(BEE_Base* event
             {
                 case Qt::LeftButton:
                     // fix the current point and add a new point + line
-                    addNextNetPoint(*board, pos);
+                    addNextNetPoint(*board, getSnappedCursorPos(*board, pos));
                     return ForceStayInState;
                 case Qt::RightButton:
                     return ForceStayInState;
@@ -298,7 +312,7 @@ BES_Base::ProcRetVal BES_DrawTrace::processPositioningSceneEvent(BEE_Base* event
                         mCurrentWireMode = static_cast<WireMode>(mCurrentWireMode+1);
                         if (mCurrentWireMode == WireMode_COUNT) mCurrentWireMode = static_cast<WireMode>(0);
                         updateWireModeActionsCheckedState();
-                        updateNetpointPositions(pos);
+                        updateNetpointPositions(getSnappedCursorPos(*board, pos));
                         return ForceStayInState;
                     }
                     break;
@@ -313,7 +327,10 @@ BES_Base::ProcRetVal BES_DrawTrace::processPositioningSceneEvent(BEE_Base* event
             QGraphicsSceneMouseEvent* sceneEvent = dynamic_cast<QGraphicsSceneMouseEvent*>(qevent);
             Q_ASSERT(sceneEvent);
             Point pos = Point::fromPx(sceneEvent->scenePos(), board->getGridProperties().getInterval());
-            updateNetpointPositions(pos);
+            if (mSnapCacheValid && (pos == mSnapCacheCursorPos)) {
+                return ForceStayInState; // still in the same grid cell, nothing to update
+            }
+            updateNetpointPositions(getSnappedCursorPos(*board, pos));
             return ForceStayInState;
         }
 
@@ -348,40 +365,23 @@ bool BES_DrawTrace::startPositioning(Board& board, const Point& pos,
             mFixedNetPoint = cmd->getNetPoint();
         }
         Q_ASSERT(mFixedNetPoint);
+        mPositioningNetPoints.clear();
+        mPositioningNetLines.clear();
+        mRouter.reset(); // the board was modified since the last segment was fixed
         NetSignal* netsignal = &mFixedNetPoint->getNetSignal();
         GraphicsLayer* layer = &mFixedNetPoint->getLayer();
 
-        // update the command toolbar
+        // update the command toolbar (use the trace width of the net class, if defined)
         mLayerComboBox->setCurrentIndex(mLayerComboBox->findData(layer->getName()));
+        BoardRuleTable rules(board);
+        Length classWidth = rules.getRules(rules.getNetClassId(netsignal)).traceWidth;
+        if (classWidth > 0) {
+            mWidthComboBox->setCurrentText(QString::number(classWidth.toMm()));
+        }
 
-        // add second netpoint
-        CmdBoardNetPointAdd* cmdNetPointAdd2 = new CmdBoardNetPointAdd(
-            board, *layer, *netsignal, pos);
-        mUndoStack.appendToCmdGroup(cmdNetPointAdd2);
-        mPositioningNetPoint1 = cmdNetPointAdd2->getNetPoint();
-        Q_ASSERT(mPositioningNetPoint1);
-
-        // add first netline
-        CmdBoardNetLineAdd* cmdNetLineAdd1 = new CmdBoardNetLineAdd(
-            board, *mFixedNetPoint, *cmdNetPointAdd2->getNetPoint(), mCurrentWidth);
-        mUndoStack.appendToCmdGroup(cmdNetLineAdd1);
-        mPositioningNetLine1 = cmdNetLineAdd1->getNetLine();
-        Q_ASSERT(mPositioningNetLine1);
-
-        // add third netpoint
-        CmdBoardNetPointAdd* cmdNetPointAdd3 = new CmdBoardNetPointAdd(
-            board, *layer, *netsignal, pos);
-        mUndoStack.appendToCmdGroup(cmdNetPointAdd3);
-        mPositioningNetPoint2 = cmdNetPointAdd3->getNetPoint();
-        Q_ASSERT(mPositioningNetPoint2);
-
-        // add second netline
-        CmdBoardNetLineAdd* cmdNetLineAdd2 = new CmdBoardNetLineAdd(
-            board, *cmdNetPointAdd2->getNetPoint(), *cmdNetPointAdd3->getNetPoint(),
-            mCurrentWidth);
-        mUndoStack.appendToCmdGroup(cmdNetLineAdd2);
-        mPositioningNetLine2 = cmdNetLineAdd2->getNetLine();
-        Q_ASSERT(mPositioningNetLine2);
+        // add the netpoints p1 and p2 and their netlines
+        appendPositioningNetPoint(pos); // can throw
+        appendPositioningNetPoint(pos); // can throw
 
         // properly place the new netpoints/netlines according the current wire mode
         updateNetpointPositions(pos);
@@ -389,6 +389,9 @@ bool BES_DrawTrace::startPositioning(Board& board, const Point& pos,
         // highlight all elements of the current netsignal
         mCircuit.setHighlightedNetSignal(netsignal);
 
+        // the board has changed, so the snap target must be searched again
+        mSnapCacheValid = false;
+
         return true;
     }
     catch (Exception e)
@@ -411,18 +414,27 @@ bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept
         return false;
     } else {
         bool finishCommand = false;
+        BI_NetPoint* last = mPositioningNetPoints.last();
 
         try
         {
-            // remove p1 if p1 == p0 || p1 == p2
-            if (mPositioningNetPoint1->getPosition() == mFixedNetPoint->getPosition()) {
-                mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*mPositioningNetPoint1, *mFixedNetPoint));
-            } else if (mPositioningNetPoint1->getPosition() == mPositioningNetPoint2->getPosition()) {
-                mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*mPositioningNetPoint1, *mPositioningNetPoint2));
+            // remove all netpoints which have the same position as their predecessor
+            BI_NetPoint* previous = mFixedNetPoint;
+            foreach (BI_NetPoint* netpoint, mPositioningNetPoints) {
+                if (netpoint == last) {
+                    break;
+                } else if (netpoint->getPosition() == previous->getPosition()) {
+                    mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*netpoint, *previous));
+                } else {
+                    previous = netpoint;
+                }
+            }
+            if ((previous != mFixedNetPoint) && (previous->getPosition() == last->getPosition())) {
+                mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*previous, *last));
             }
 
-            // combine all board items under "mPositioningNetPoint2" together
-            auto* cmd = new CmdCombineAllItemsUnderBoardNetPoint(*mPositioningNetPoint2);
+            // combine all board items under the last netpoint together
+            auto* cmd = new CmdCombineAllItemsUnderBoardNetPoint(*last);
             mUndoStack.appendToCmdGroup(cmd);
             finishCommand = cmd->hasCombinedSomeItems();
         }
@@ -439,6 +451,7 @@ bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept
         try
         {
             // finish the current command
+            clearClearanceViolations();
             mUndoStack.commitCmdGroup();
             mSubState = SubState_Idle;
 
@@ -448,7 +461,7 @@ bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept
                 abortPositioning(true);
                 return false;
             } else {
-                return startPositioning(board, pos, mPositioningNetPoint2);
+                return startPositioning(board, pos, last);
             }
         }
         catch (Exception e)
@@ -466,13 +479,14 @@ bool BES_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept
 {
     try
     {
+        clearClearanceViolations();
         mCircuit.setHighlightedNetSignal(nullptr);
         mSubState = SubState_Idle;
+        mSnapCacheValid = false;
         mFixedNetPoint = nullptr;
-        mPositioningNetLine1 = nullptr;
-        mPositioningNetLine2 = nullptr;
-        mPositioningNetPoint1 = nullptr;
-        mPositioningNetPoint2 = nullptr;
+        mPositioningNetPoints.clear();
+        mPositioningNetLines.clear();
+        mRouter.reset();
         mUndoStack.abortCmdGroup(); // can throw
         return true;
     }
@@ -483,25 +497,135 @@ bool BES_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept
     }
 }
 
+void BES_DrawTrace::appendPositioningNetPoint(const Point& pos)
+{
+    Board& board = mFixedNetPoint->getBoard();
+    BI_NetPoint* previous = mPositioningNetPoints.isEmpty() ? mFixedNetPoint
+                                                            : mPositioningNetPoints.last();
+
+    CmdBoardNetPointAdd* cmdNetPointAdd = new CmdBoardNetPointAdd(
+        board, mFixedNetPoint->getLayer(), mFixedNetPoint->getNetSignal(), pos);
+    mUndoStack.appendToCmdGroup(cmdNetPointAdd); // can throw
+    Q_ASSERT(cmdNetPointAdd->getNetPoint());
+    mPositioningNetPoints.append(cmdNetPointAdd->getNetPoint());
+
+    CmdBoardNetLineAdd* cmdNetLineAdd = new CmdBoardNetLineAdd(
+        board, *previous, *cmdNetPointAdd->getNetPoint(), mCurrentWidth);
+    mUndoStack.appendToCmdGroup(cmdNetLineAdd); // can throw
+    Q_ASSERT(cmdNetLineAdd->getNetLine());
+    mPositioningNetLines.append(cmdNetLineAdd->getNetLine());
+}
+
+Point BES_DrawTrace::getSnappedCursorPos(Board& board, const Point& cursorPos) noexcept
+{
+    if (mSnapCacheValid && (cursorPos == mSnapCacheCursorPos)) {
+        return mSnapCacheSnappedPos;
+    }
+
+    // snap to the nearest pad, via or netpoint of the same net, even if it is not on the grid
+    const GraphicsLayer* layer = mFixedNetPoint ? &mFixedNetPoint->getLayer()
+                                                : board.getLayerStack().getLayer(mCurrentLayerName);
+    const NetSignal* netsignal = mFixedNetPoint ? &mFixedNetPoint->getNetSignal() : nullptr;
+    QSet<const BI_Base*> ignore;
+    foreach (const BI_NetPoint* netpoint, mPositioningNetPoints) {
+        ignore.insert(netpoint);
+    }
+    BI_Base* target = board.getNearestSnapTarget(cursorPos,
+        board.getGridProperties().getInterval(), layer, netsignal, ignore);
+    mSnapCacheCursorPos = cursorPos;
+    mSnapCacheSnappedPos = target ? target->getPosition() : cursorPos;
+    mSnapCacheValid = true;
+    return mSnapCacheSnappedPos;
+}
+
 void BES_DrawTrace::updateNetpointPositions(const Point& cursorPos) noexcept
 {
-    mPositioningNetPoint1->setPosition(calcMiddlePointPos(mFixedNetPoint->getPosition(),
-                                                          cursorPos, mCurrentWireMode));
-    mPositioningNetPoint2->setPosition(cursorPos);
+    QVector<Point> path = {mFixedNetPoint->getPosition(),
+                           calcMiddlePointPos(mFixedNetPoint->getPosition(), cursorPos,
+                                              mCurrentWireMode),
+                           cursorPos};
+
+    // route around the copper of other nets (keep the path if there is no way around)
+    if (mWalkaround) {
+        if (!mRouter) {
+            mRouter.reset(new BoardTraceRouter(mFixedNetPoint->getBoard(),
+                                               mFixedNetPoint->getNetSignal(),
+                                               mFixedNetPoint->getLayer().getName(),
+                                               mCurrentWidth));
+        }
+        QVector<Point> detour = mRouter->route(path);
+        try {
+            while (mPositioningNetPoints.count() < detour.count() - 1) {
+                appendPositioningNetPoint(cursorPos); // can throw
+            }
+            if (!detour.isEmpty()) path = detour;
+        } catch (const Exception& e) {
+            qWarning() << "Failed to route the trace around obstacles:" << e.getMsg();
+        }
+    }
+
+    // unused netpoints are placed under the cursor and get removed when fixing the trace
+    for (int i = 0; i < mPositioningNetPoints.count(); ++i) {
+        mPositioningNetPoints.at(i)->setPosition(path.at(qMin(i + 1, path.count() - 1)));
+    }
+    updateClearanceViolations();
+}
+
+void BES_DrawTrace::updateClearanceViolations() noexcept
+{
+    Board& board = mFixedNetPoint->getBoard();
+    QList<const BI_NetLine*> netlines;
+    foreach (const BI_NetLine* netline, mPositioningNetLines) {
+        netlines.append(netline);
+    }
+    QList<BoardDesignRuleCheck::Violation> violations =
+        board.getDesignRuleCheck().checkClearances(netlines);
+
+    // mark every violation with a circle of the clearance radius
+    QPainterPath path;
+    qreal radius = board.getDesignRules().getMinCopperClearance().toPx();
+    foreach (const BoardDesignRuleCheck::Violation& violation, violations) {
+        path.addEllipse(violation.position.toPxQPointF(), radius, radius);
+    }
+    if (!mClearanceViolationsItem) {
+        mClearanceViolationsItem.reset(new QGraphicsPathItem());
+        mClearanceViolationsItem->setPen(QPen(Qt::red, 0));
+        mClearanceViolationsItem->setBrush(QColor(255, 0, 0, 80));
+        mClearanceViolationsItem->setZValue(Board::ZValue_AirWires + 1);
+        board.getGraphicsScene().addItem(*mClearanceViolationsItem);
+    }
+    mClearanceViolationsItem->setPath(path);
+
+    if (violations.isEmpty()) {
+        mEditorUi.statusbar->clearMessage();
+    } else {
+        mEditorUi.statusbar->showMessage(violations.first().message);
+    }
+}
+
+void BES_DrawTrace::clearClearanceViolations() noexcept
+{
+    if (mClearanceViolationsItem) {
+        mClearanceViolationsItem.reset(); // also removes it from the scene
+        mEditorUi.statusbar->clearMessage();
+    }
 }
 
 void BES_DrawTrace::layerComboBoxIndexChanged(int index) noexcept
 {
     mCurrentLayerName = mLayerComboBox->itemData(index).toString();
+    mSnapCacheValid = false;
     // TODO: add a via to change the layer of the current netline?
 }
 
 void BES_DrawTrace::wireWidthComboBoxTextChanged(const QString& width) noexcept
 {
     try {mCurrentWidth = Length::fromMm(width);} catch (...) {return;}
+    mRouter.reset(); // the obstacles are grown by the trace width
     if (mSubState != SubState::SubState_PositioningNetPoint) return;
-    if (mPositioningNetLine1) mPositioningNetLine1->setWidth(mCurrentWidth);
-    if (mPositioningNetLine2) mPositioningNetLine2->setWidth(mCurrentWidth);
+    foreach (BI_NetLine* netline, mPositioningNetLines) {
+        netline->setWidth(mCurrentWidth);
+    }
 }
 
 void BES_DrawTrace::updateWireModeActionsCheckedState() noexcept
@@ -35,6 +35,7 @@ namespace project {
 
 class BI_NetPoint;
 class BI_NetLine;
+class BoardTraceRouter;
 
 namespace editor {
 
@@ -97,7 +98,11 @@ class BES_DrawTrace final : public BES_Base
                               BI_NetPoint* fixedPoint = nullptr) noexcept;
         bool addNextNetPoint(Board& board, const Point& pos) noexcept;
         bool abortPositioning(bool showErrMsgBox) noexcept;
+        void appendPositioningNetPoint(const Point& pos);
+        Point getSnappedCursorPos(Board& board, const Point& cursorPos) noexcept;
         void updateNetpointPositions(const Point& cursorPos) noexcept;
+        void updateClearanceViolations() noexcept;
+        void clearClearanceViolations() noexcept;
         void layerComboBoxIndexChanged(int index) noexcept;
         void wireWidthComboBoxTextChanged(const QString& width) noexcept;
         void updateWireModeActionsCheckedState() noexcept;
@@ -109,14 +114,21 @@ class BES_DrawTrace final : public BES_Base
         WireMode mCurrentWireMode; ///< the current wire mode
         QString mCurrentLayerName; ///< the current board layer name
         Length mCurrentWidth; ///< the current wire width
+        bool mWalkaround; ///< whether new traces are routed around obstacles
         BI_NetPoint* mFixedNetPoint; ///< the fixed netpoint (start point of the line)
-        BI_NetLine* mPositioningNetLine1; ///< line between fixed point and p1
-        BI_NetPoint* mPositioningNetPoint1; ///< the first netpoint to place
-        BI_NetLine* mPositioningNetLine2; ///< line between p1 and p2
-        BI_NetPoint* mPositioningNetPoint2; ///< the second netpoint to place
+        QList<BI_NetPoint*> mPositioningNetPoints; ///< p1..pn (pn is under the cursor)
+        QList<BI_NetLine*> mPositioningNetLines; ///< lines between p0 (fixed), p1..pn
+        QScopedPointer<BoardTraceRouter> mRouter; ///< kept while positioning (caches obstacles)
+        QScopedPointer<QGraphicsPathItem> mClearanceViolationsItem; ///< marks violations
+
+        // Snapping (the result is cached as long as the cursor stays in the same grid cell)
+        bool mSnapCacheValid; ///< whether the cached snap position is up to date
+        Point mSnapCacheCursorPos; ///< the cursor position (mapped to the grid)
+        Point mSnapCacheSnappedPos; ///< the position of the snap target (or the cursor)
 
         // Widgets for the command toolbar
         QHash<WireMode, QAction*> mWireModeActions;
+        QAction* mWalkaroundAction;
         QList<QAction*> mActionSeparators;
         QLabel* mLayerLabel;
         QComboBox* mLayerComboBox;
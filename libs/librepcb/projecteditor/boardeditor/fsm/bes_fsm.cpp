@@ -23,6 +23,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <QtEvents>
+#include <librepcb/common/graphics/framestatistics.h>
 #include "bes_fsm.h"
 #include "boardeditorevent.h"
 #include "../boardeditor.h"
@@ -92,8 +93,10 @@ BES_Base::ProcRetVal BES_FSM::process(BEE_Base* event) noexcept
     ProcRetVal retval = PassToParentState;
 
     // let the current state process the event
-    if (mCurrentState != State_NoState)
+    if (mCurrentState != State_NoState) {
+        FrameStatistics::EventHandlerTimer timer(mSubStates[mCurrentState]->metaObject()->className());
         retval = mSubStates[mCurrentState]->process(event);
+    }
 
     switch (retval)
     {
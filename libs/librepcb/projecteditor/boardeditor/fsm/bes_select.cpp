@@ -23,12 +23,16 @@
 #include <QtCore>
 #include "bes_select.h"
 #include "../boardeditor.h"
+#include <librepcb/projecteditor/projecteditor.h>
 #include "ui_boardeditor.h"
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardairwires.h>
 #include <librepcb/project/boards/items/bi_footprint.h>
 #include <librepcb/project/boards/items/bi_footprintpad.h>
 #include <librepcb/project/boards/items/bi_via.h>
 #include <librepcb/common/undostack.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/gridproperties.h>
 #include <librepcb/project/boards/items/bi_device.h>
 #include <librepcb/project/circuit/componentinstance.h>
 #include <librepcb/workspace/workspace.h>
@@ -43,6 +47,7 @@
 #include "../../cmd/cmdflipselectedboarditems.h"
 #include "../../cmd/cmdremoveselectedboarditems.h"
 #include "../../cmd/cmdreplacedevice.h"
+#include "../../cmd/cmdreplacedevices.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -92,6 +97,7 @@ bool BES_Select::entry(BEE_Base* event) noexcept
 bool BES_Select::exit(BEE_Base* event) noexcept
 {
     Q_UNUSED(event);
+    clearCopperHighlight();
     return true;
 }
 
@@ -202,6 +208,8 @@ BES_Base::ProcRetVal BES_Select::processSubStateIdleSceneEvent(BEE_Base* event)
 BES_Base::ProcRetVal BES_Select::proccessIdleSceneLeftClick(QGraphicsSceneMouseEvent* mouseEvent,
                                                             Board& board) noexcept
 {
+    clearCopperHighlight();
+
     // handle items selection
     QList<BI_Base*> items = board.getItemsAtScenePos(Point::fromPx(mouseEvent->scenePos()));
     if (items.isEmpty())
@@ -253,6 +261,8 @@ BES_Base::ProcRetVal BES_Select::proccessIdleSceneRightMouseButtonReleased(
             menu.addSeparator();
             QMenu* aChangeDeviceMenu = menu.addMenu(tr("Change Device"));
             aChangeDeviceMenu->setEnabled(devicesList.count() > 0);
+            QMenu* aChangeAllDevicesMenu = menu.addMenu(tr("Change Device of All Equal Parts"));
+            aChangeAllDevicesMenu->setEnabled(devicesList.count() > 1);
             foreach (const Uuid& deviceUuid, devicesList) {
                 Uuid pkgUuid;
                 QString devName, pkgName;
@@ -263,10 +273,13 @@ BES_Base::ProcRetVal BES_Select::proccessIdleSceneRightMouseButtonReleased(
                 mWorkspace.getLibraryDb().getElementTranslations<library::Package>(pkgFp, localeOrder, &pkgName);
                 QAction* a = aChangeDeviceMenu->addAction(QString("%1 [%2]").arg(devName).arg(pkgName));
                 a->setData(deviceUuid.toStr());
+                QAction* aAll = aChangeAllDevicesMenu->addAction(a->text());
+                aAll->setData(deviceUuid.toStr());
                 if (deviceUuid == devInst.getLibDevice().getUuid()) {
                     a->setCheckable(true);
                     a->setChecked(true);
                     a->setEnabled(false);
+                    aAll->setEnabled(false);
                 }
             }
             QMenu* aChangeFootprintMenu = menu.addMenu(tr("Change Footprint"));
@@ -282,6 +295,9 @@ BES_Base::ProcRetVal BES_Select::proccessIdleSceneRightMouseButtonReleased(
             }
             aChangeFootprintMenu->setEnabled(!aChangeFootprintMenu->isEmpty());
             menu.addSeparator();
+            QAction* aShowInSchematic = menu.addAction(tr("Show in Schematic"));
+            aShowInSchematic->setEnabled(!cmpInst.getRegisteredSymbols().isEmpty());
+            menu.addSeparator();
             QAction* aProperties = menu.addAction(tr("Properties"));
 
             // execute the context menu
@@ -302,6 +318,24 @@ BES_Base::ProcRetVal BES_Select::proccessIdleSceneRightMouseButtonReleased(
             {
                 removeSelectedItems();
             }
+            else if (aChangeAllDevicesMenu->actions().contains(action))
+            {
+                try
+                {
+                    // replace all devices which use the same library device (from the
+                    // same library component) as the clicked one
+                    Uuid oldDeviceUuid = devInst.getLibDevice().getUuid();
+                    CmdReplaceDevices* cmd = new CmdReplaceDevices(mWorkspace, *board,
+                        [oldDeviceUuid](const BI_Device& device){
+                            return (device.getLibDevice().getUuid() == oldDeviceUuid);},
+                        Uuid(action->data().toString()));
+                    mUndoStack.execCmd(cmd);
+                }
+                catch (Exception& e)
+                {
+                    QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
+                }
+            }
             else if (!action->data().toUuid().isNull())
             {
                 try
@@ -325,6 +359,10 @@ BES_Base::ProcRetVal BES_Select::proccessIdleSceneRightMouseButtonReleased(
                     QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
                 }
             }
+            else if (action == aShowInSchematic)
+            {
+                mEditor.getProjectEditor().showComponentInSchematicEditor(cmpInst);
+            }
             else if (action == aProperties)
             {
                 // open the properties editor dialog of the selected item
@@ -333,6 +371,23 @@ BES_Base::ProcRetVal BES_Select::proccessIdleSceneRightMouseButtonReleased(
             }
             return ForceStayInState;
         }
+        case BI_Base::Type_t::NetLine:
+        case BI_Base::Type_t::NetPoint:
+        case BI_Base::Type_t::Via:
+        case BI_Base::Type_t::FootprintPad:
+        {
+            QAction* aSelectConnected = menu.addAction(tr("Select Connected Copper"));
+            QAction* aHighlightConnected = menu.addAction(tr("Highlight Connected Copper"));
+
+            // execute the context menu
+            QAction* action = menu.exec(mouseEvent->screenPos());
+            if (action == aSelectConnected) {
+                selectConnectedCopper(*board, *items.first());
+            } else if (action == aHighlightConnected) {
+                highlightConnectedCopper(*board, *items.first());
+            }
+            return ForceStayInState;
+        }
         default:
             break;
     }
@@ -354,6 +409,10 @@ BES_Base::ProcRetVal BES_Select::proccessIdleSceneDoubleClick(QGraphicsSceneMous
                 dialog.exec();
                 return ForceStayInState;
             }
+            case BI_Base::Type_t::NetLine: {
+                selectConnectedCopper(*board, *items.first());
+                return ForceStayInState;
+            }
             default: {
                 break;
             }
@@ -394,6 +453,7 @@ BES_Base::ProcRetVal BES_Select::processSubStateMovingSceneEvent(BEE_Base* event
                     QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
                 }
                 mSelectedItemsMoveCommand.reset();
+                mMovePreviewItem.reset(); // also removes it from the scene
                 mSubState = SubState_Idle;
             }
             break;
@@ -405,7 +465,12 @@ BES_Base::ProcRetVal BES_Select::processSubStateMovingSceneEvent(BEE_Base* event
             Q_ASSERT(sceneEvent); if (!sceneEvent) break;
             Q_ASSERT(!mSelectedItemsMoveCommand.isNull());
             Point pos = Point::fromPx(sceneEvent->scenePos());
-            mSelectedItemsMoveCommand->setCurrentPosition(pos);
+            updateMovePreview(pos);
+            if (mMoveUpdateTimer.elapsed() >= 100) {
+                // moving the items themselves is expensive, so do it at a limited rate
+                mSelectedItemsMoveCommand->setCurrentPosition(pos);
+                mMoveUpdateTimer.restart();
+            }
             break;
         } // case QEvent::GraphicsSceneMouseMove
 
@@ -428,10 +493,35 @@ bool BES_Select::startMovingSelectedItems(Board& board, const Point& startPos) n
 {
     Q_ASSERT(mSelectedItemsMoveCommand.isNull());
     mSelectedItemsMoveCommand.reset(new CmdMoveSelectedBoardItems(board, startPos));
+
+    // while dragging, only a transient outline of the selected items follows the cursor
+    // immediately, the items themselves (and all connected netlines) are moved at a
+    // limited rate and finally when the mouse button is released
+    QPainterPath path;
+    foreach (const BI_Base* item, board.getSelectedItems(true, false, true, true, true, true,
+                                                    true, true, false, true, true, false)) {
+        path.addPath(item->getGrabAreaScenePx());
+    }
+    mMovePreviewItem.reset(new QGraphicsPathItem(path));
+    mMovePreviewItem->setPen(Qt::NoPen);
+    mMovePreviewItem->setBrush(QColor(255, 255, 255, 100));
+    mMovePreviewItem->setZValue(Board::ZValue_AirWires + 1);
+    board.getGraphicsScene().addItem(*mMovePreviewItem);
+    mMoveStartPos = startPos;
+    mMoveUpdateTimer.start();
+
     mSubState = SubState_Moving;
     return true;
 }
 
+void BES_Select::updateMovePreview(const Point& pos) noexcept
+{
+    Board* board = mEditor.getActiveBoard();
+    if ((!board) || (!mMovePreviewItem)) return;
+    Point delta = (pos - mMoveStartPos).mappedToGrid(board->getGridProperties().getInterval());
+    mMovePreviewItem->setPos(delta.toPxQPointF());
+}
+
 bool BES_Select::rotateSelectedItems(const Angle& angle) noexcept
 {
     Board* board = mEditor.getActiveBoard();
@@ -486,6 +576,37 @@ bool BES_Select::removeSelectedItems() noexcept
     }
 }
 
+void BES_Select::selectConnectedCopper(Board& board, BI_Base& item) noexcept
+{
+    board.clearSelection();
+    foreach (BI_Base* connectedItem, board.getAirWires().getConnectedItems(item)) {
+        connectedItem->setSelected(true);
+    }
+}
+
+void BES_Select::highlightConnectedCopper(Board& board, BI_Base& item) noexcept
+{
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+    foreach (const BI_Base* connectedItem, board.getAirWires().getConnectedItems(item)) {
+        path.addPath(connectedItem->getGrabAreaScenePx());
+    }
+
+    if (!mCopperHighlightItem) {
+        mCopperHighlightItem.reset(new QGraphicsPathItem());
+        mCopperHighlightItem->setPen(Qt::NoPen);
+        mCopperHighlightItem->setBrush(QColor(255, 255, 255, 100));
+        mCopperHighlightItem->setZValue(Board::ZValue_AirWires + 1);
+        board.getGraphicsScene().addItem(*mCopperHighlightItem);
+    }
+    mCopperHighlightItem->setPath(path);
+}
+
+void BES_Select::clearCopperHighlight() noexcept
+{
+    mCopperHighlightItem.reset(); // also removes it from the scene
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
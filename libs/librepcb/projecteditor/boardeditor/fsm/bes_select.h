@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtWidgets>
 #include "bes_base.h"
 
 /*****************************************************************************************
@@ -76,9 +77,13 @@ class BES_Select final : public BES_Base
         ProcRetVal proccessIdleSceneDoubleClick(QGraphicsSceneMouseEvent* mouseEvent,
                                                 Board* board) noexcept;
         bool startMovingSelectedItems(Board& board, const Point& startPos) noexcept;
+        void updateMovePreview(const Point& pos) noexcept;
         bool rotateSelectedItems(const Angle& angle) noexcept;
         bool flipSelectedItems(Qt::Orientation orientation) noexcept;
         bool removeSelectedItems() noexcept;
+        void selectConnectedCopper(Board& board, BI_Base& item) noexcept;
+        void highlightConnectedCopper(Board& board, BI_Base& item) noexcept;
+        void clearCopperHighlight() noexcept;
 
 
         // Types
@@ -92,6 +97,10 @@ class BES_Select final : public BES_Base
         // Attributes
         SubState mSubState;     ///< the current substate
         QScopedPointer<CmdMoveSelectedBoardItems> mSelectedItemsMoveCommand;
+        QScopedPointer<QGraphicsPathItem> mMovePreviewItem; ///< outline of the moved items
+        QElapsedTimer mMoveUpdateTimer; ///< to move the items at a limited rate only
+        Point mMoveStartPos; ///< the cursor position when the moving was started
+        QScopedPointer<QGraphicsPathItem> mCopperHighlightItem; ///< highlighted island
 };
 
 /*****************************************************************************************
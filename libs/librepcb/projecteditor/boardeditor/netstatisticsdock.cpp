@@ -0,0 +1,117 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "netstatisticsdock.h"
+#include "ui_netstatisticsdock.h"
+#include <librepcb/project/project.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardnetstatistics.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+NetStatisticsDock::NetStatisticsDock() noexcept :
+    QDockWidget(nullptr), mUi(new Ui::NetStatisticsDock), mActiveBoard(nullptr)
+{
+    mUi->setupUi(this);
+    mUi->tableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    mUi->tableWidget->horizontalHeader()->setStretchLastSection(true);
+}
+
+NetStatisticsDock::~NetStatisticsDock() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void NetStatisticsDock::setActiveBoard(Board* board)
+{
+    if (mActiveBoard) {
+        disconnect(mActiveBoardConnection);
+    }
+
+    mActiveBoard = board;
+
+    if (mActiveBoard) {
+        mActiveBoardConnection = connect(&mActiveBoard->getNetStatistics(),
+                                         &BoardNetStatistics::statisticsChanged,
+                                         this, &NetStatisticsDock::updateTableWidget);
+    }
+
+    updateTableWidget();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void NetStatisticsDock::updateTableWidget() noexcept
+{
+    mUi->tableWidget->setSortingEnabled(false);
+    mUi->tableWidget->setRowCount(0);
+    if (!mActiveBoard) return;
+
+    const BoardNetStatistics& statistics = mActiveBoard->getNetStatistics();
+    const Circuit& circuit = mActiveBoard->getProject().getCircuit();
+    foreach (const Uuid& uuid, statistics.getNetSignals()) {
+        const NetSignal* netsignal = circuit.getNetSignalByUuid(uuid);
+        if (!netsignal) continue;
+        BoardNetStatistics::Statistics stats = statistics.getStatistics(uuid);
+        QStringList layers;
+        foreach (const QString& layerName, stats.layerLengths.keys()) {
+            layers.append(layerName);
+        }
+        int row = mUi->tableWidget->rowCount();
+        mUi->tableWidget->insertRow(row);
+        QTableWidgetItem* lengthItem = new QTableWidgetItem();
+        lengthItem->setData(Qt::DisplayRole, stats.length.toMm());
+        QTableWidgetItem* viasItem = new QTableWidgetItem();
+        viasItem->setData(Qt::DisplayRole, stats.viaCount);
+        mUi->tableWidget->setItem(row, 0, new QTableWidgetItem(netsignal->getName()));
+        mUi->tableWidget->setItem(row, 1, lengthItem);
+        mUi->tableWidget->setItem(row, 2, viasItem);
+        mUi->tableWidget->setItem(row, 3, new QTableWidgetItem(layers.join(", ")));
+    }
+    mUi->tableWidget->setSortingEnabled(true);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,91 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_NETSTATISTICSDOCK_H
+#define LIBREPCB_PROJECT_NETSTATISTICSDOCK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+namespace editor {
+
+namespace Ui {
+class NetStatisticsDock;
+}
+
+/*****************************************************************************************
+ *  Class NetStatisticsDock
+ ****************************************************************************************/
+
+/**
+ * @brief The NetStatisticsDock class shows the routed length, the via count and the used
+ *        layers of every net signal of a board
+ *
+ * @see librepcb::project::BoardNetStatistics
+ */
+class NetStatisticsDock final : public QDockWidget
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        NetStatisticsDock() noexcept;
+        NetStatisticsDock(const NetStatisticsDock& other) = delete;
+        ~NetStatisticsDock() noexcept;
+
+        // Setters
+        void setActiveBoard(Board* board);
+
+        // Operator Overloadings
+        NetStatisticsDock& operator=(const NetStatisticsDock& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        void updateTableWidget() noexcept;
+
+
+        // General
+        QScopedPointer<Ui::NetStatisticsDock> mUi;
+        Board* mActiveBoard;
+        QMetaObject::Connection mActiveBoardConnection;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_NETSTATISTICSDOCK_H
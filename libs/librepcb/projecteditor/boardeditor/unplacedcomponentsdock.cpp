@@ -25,11 +25,13 @@
 #include "unplacedcomponentsdock.h"
 #include "ui_unplacedcomponentsdock.h"
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_device.h>
 #include <librepcb/project/circuit/circuit.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/settings/projectsettings.h>
 #include <librepcb/project/circuit/componentinstance.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
 #include <librepcb/library/elements.h>
 #include <librepcb/project/library/projectlibrary.h>
 #include <librepcb/common/graphics/graphicsview.h>
@@ -40,7 +42,10 @@
 #include "../projecteditor.h"
 #include <librepcb/library/pkg/footprintpreviewgraphicsitem.h>
 #include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/circuit/componentsignalinstance.h>
+#include <librepcb/project/circuit/netsignal.h>
 #include "../cmd/cmdadddevicetoboard.h"
+#include "deviceplacer.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -49,6 +54,41 @@ namespace librepcb {
 namespace project {
 namespace editor {
 
+/*****************************************************************************************
+ *  Class UnplacedComponentsDock::PlacementWorker
+ ****************************************************************************************/
+
+/**
+ * @brief Calculates the device positions of "Add All" in a thread pool worker
+ *
+ * The worker is owned by the dock, which is notified in its own thread when the
+ * positions are available.
+ */
+class UnplacedComponentsDock::PlacementWorker final : public QRunnable
+{
+    public:
+        PlacementWorker(UnplacedComponentsDock& dock, const DevicePlacer& placer) noexcept :
+            mDock(dock), mPlacer(placer), mPositions(), mBottom()
+        {
+            setAutoDelete(false);
+        }
+
+        void run() noexcept override
+        {
+            mPositions = mPlacer.calculatePositions(&mBottom);
+            QMetaObject::invokeMethod(&mDock, "autoPlacementFinished", Qt::QueuedConnection);
+        }
+
+        const QHash<Uuid, Point>& getPositions() const noexcept {return mPositions;}
+        const Length& getBottom() const noexcept {return mBottom;}
+
+    private:
+        UnplacedComponentsDock& mDock;
+        DevicePlacer mPlacer;
+        QHash<Uuid, Point> mPositions;
+        Length mBottom;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -57,9 +97,10 @@ UnplacedComponentsDock::UnplacedComponentsDock(ProjectEditor& editor) :
     QDockWidget(0), mProjectEditor(editor), mProject(editor.getProject()), mBoard(nullptr),
     mUi(new Ui::UnplacedComponentsDock),
     mFootprintPreviewGraphicsScene(nullptr), mFootprintPreviewGraphicsItem(nullptr),
-    mSelectedComponent(nullptr), mSelectedDevice(nullptr), mSelectedPackage(nullptr),
+    mSelectedComponent(nullptr), mSelectedDevice(), mSelectedPackage(),
     mSelectedFootprintUuid(), mCircuitConnection1(), mCircuitConnection2(),
-    mBoardConnection1(), mBoardConnection2(), mDisableListUpdate(false)
+    mBoardConnection1(), mBoardConnection2(), mDisableListUpdate(false),
+    mPlacementBoard(nullptr)
 {
     mUi->setupUi(this);
     mFootprintPreviewGraphicsScene = new GraphicsScene();
@@ -70,10 +111,15 @@ UnplacedComponentsDock::UnplacedComponentsDock(ProjectEditor& editor) :
     QSettings clientSettings;
     mUi->splitter->restoreState(clientSettings.value("unplaced_components_dock/splitter_state").toByteArray());
 
+    mListUpdateTimer.setSingleShot(true);
+    mListUpdateTimer.setInterval(0);
+    connect(&mListUpdateTimer, &QTimer::timeout,
+            this, &UnplacedComponentsDock::updateComponentsList);
+
     mCircuitConnection1 = connect(&mProject.getCircuit(), &Circuit::componentAdded,
-                                  [this](ComponentInstance& cmp){Q_UNUSED(cmp); updateComponentsList();});
+                                  [this](ComponentInstance& cmp){scheduleComponentsListUpdate(cmp.getUuid());});
     mCircuitConnection2 = connect(&mProject.getCircuit(), &Circuit::componentRemoved,
-                                  [this](ComponentInstance& cmp){Q_UNUSED(cmp); updateComponentsList();});
+                                  [this](ComponentInstance& cmp){scheduleComponentsListUpdate(cmp.getUuid());});
 
     updateComponentsList();
 }
@@ -85,6 +131,7 @@ UnplacedComponentsDock::~UnplacedComponentsDock()
 
     setBoard(nullptr);
     mDisableListUpdate = true;
+    mPlacementThreadPool.waitForDone();
     disconnect(mCircuitConnection1);        mCircuitConnection1 = QMetaObject::Connection();
     disconnect(mCircuitConnection2);        mCircuitConnection2 = QMetaObject::Connection();
     delete mFootprintPreviewGraphicsItem;   mFootprintPreviewGraphicsItem = nullptr;
@@ -100,16 +147,22 @@ void UnplacedComponentsDock::setBoard(Board* board)
 {
     // clean up
     mBoard = nullptr;
+    mPlacementBoard = nullptr; // discard the result of a running placement
     disconnect(mBoardConnection1);  mBoardConnection1 = QMetaObject::Connection();
     disconnect(mBoardConnection2);  mBoardConnection2 = QMetaObject::Connection();
+    mChangedComponents.clear();
+    mChangedComponents.unite(QSet<Uuid>::fromList(mListItems.keys()));
     updateComponentsList();
 
     // load new board
     mBoard = board;
     if (board)
     {
-        mBoardConnection1 = connect(board, &Board::deviceAdded, [this](BI_Device& c){Q_UNUSED(c); updateComponentsList();});
-        mBoardConnection2 = connect(board, &Board::deviceRemoved, [this](BI_Device& c){Q_UNUSED(c); updateComponentsList();});
+        mBoardConnection1 = connect(board, &Board::deviceAdded, [this](BI_Device& c){scheduleComponentsListUpdate(c.getComponentInstanceUuid());});
+        mBoardConnection2 = connect(board, &Board::deviceRemoved, [this](BI_Device& c){scheduleComponentsListUpdate(c.getComponentInstanceUuid());});
+        foreach (const Uuid& uuid, mProject.getCircuit().getComponentInstances().keys()) {
+            mChangedComponents.insert(uuid);
+        }
         mNextPosition = Point::fromMm(0, -20).mappedToGrid(board->getGridProperties().getInterval());
         updateComponentsList();
     }
@@ -135,21 +188,23 @@ void UnplacedComponentsDock::on_lstUnplacedComponents_currentItemChanged(QListWi
 
 void UnplacedComponentsDock::on_cbxSelectedDevice_currentIndexChanged(int index)
 {
+    workspace::Workspace& ws = mProjectEditor.getWorkspace();
     Uuid deviceUuid(mUi->cbxSelectedDevice->itemData(index, Qt::UserRole).toString());
-    FilePath devFp = mProjectEditor.getWorkspace().getLibraryDb().getLatestDevice(deviceUuid);
-    if (devFp.isValid()) {
-        const library::Device* device = new library::Device(devFp, true);
-        FilePath pkgFp = mProjectEditor.getWorkspace().getLibraryDb().getLatestPackage(device->getPackageUuid());
-        if (pkgFp.isValid()) {
-            const library::Package* package = new library::Package(pkgFp, true);
-            setSelectedDeviceAndPackage(device, package);
-        } else {
-            setSelectedDeviceAndPackage(nullptr, nullptr);
+    FilePath devFp = ws.getLibraryDb().getLatestDevice(deviceUuid);
+    try {
+        if (devFp.isValid()) {
+            auto device = ws.getLibraryElementCache().getElement<library::Device>(devFp); // can throw
+            FilePath pkgFp = ws.getLibraryDb().getLatestPackage(device->getPackageUuid());
+            if (pkgFp.isValid()) {
+                auto package = ws.getLibraryElementCache().getElement<library::Package>(pkgFp); // can throw
+                setSelectedDeviceAndPackage(device, package);
+                return;
+            }
         }
+    } catch (const Exception& e) {
+        qCritical() << "Could not load device:" << e.getMsg();
     }
-    else {
-        setSelectedDeviceAndPackage(nullptr, nullptr);
-    }
+    setSelectedDeviceAndPackage(nullptr, nullptr);
 }
 
 void UnplacedComponentsDock::on_cbxSelectedFootprint_currentIndexChanged(int index)
@@ -189,24 +244,83 @@ void UnplacedComponentsDock::on_pushButton_clicked()
 
 void UnplacedComponentsDock::on_btnAddAll_clicked()
 {
-    if (!mBoard) return;
+    if ((!mBoard) || (mPlacementWorker)) return;
 
-    beginUndoCmdGroup();
+    // collect the footprint sizes and nets here since the library elements and the
+    // circuit must not be accessed from the worker thread
+    workspace::Workspace& ws = mProjectEditor.getWorkspace();
+    QList<DevicePlacer::Item> items;
+    mPlacementDevices.clear();
     for (int i = 0; i < mUi->lstUnplacedComponents->count(); i++)
     {
         Uuid componentUuid(mUi->lstUnplacedComponents->item(i)->data(Qt::UserRole).toString());
         Q_ASSERT(componentUuid.isNull() == false);
         ComponentInstance* component = mProject.getCircuit().getComponentInstanceByUuid(componentUuid);
-        if (component)
-        {
-            QList<Uuid> devices = mProjectEditor.getWorkspace().getLibraryDb().
-                getDevicesOfComponent(component->getLibComponent().getUuid()).toList();
-            if (devices.count() > 0)
-                addNextDeviceToCmdGroup(*component, devices.first(), Uuid());
+        if (!component) continue;
+        QSet<Uuid> devices = ws.getLibraryDb().getDevicesOfComponent(
+            component->getLibComponent().getUuid());
+        if (devices.isEmpty()) continue;
+        Uuid deviceUuid = mLastDeviceOfComponent.value(component->getLibComponent().getUuid());
+        if (!devices.contains(deviceUuid)) deviceUuid = devices.toList().first();
+        try {
+            Uuid pkgUuid;
+            FilePath devFp = ws.getLibraryDb().getLatestDevice(deviceUuid);
+            ws.getLibraryDb().getDeviceMetadata(devFp, &pkgUuid); // can throw
+            FilePath pkgFp = ws.getLibraryDb().getLatestPackage(pkgUuid);
+            if (!pkgFp.isValid()) continue;
+            auto package = ws.getLibraryElementCache().getElement<library::Package>(pkgFp); // can throw
+            std::shared_ptr<const library::Footprint> footprint =
+                package->getFootprints().find(mLastFootprintOfDevice.value(deviceUuid));
+            if ((!footprint) && (package->getFootprints().count() > 0)) {
+                footprint = package->getFootprints().first();
+            }
+            if (!footprint) continue;
+            DevicePlacer::Item item;
+            item.component = componentUuid;
+            DevicePlacer::getFootprintBoundingBox(*footprint, item.bottomLeft, item.topRight);
+            foreach (const ComponentSignalInstance* signal, component->getSignalInstances()) {
+                if (signal->getNetSignal()) item.netSignals.insert(signal->getNetSignal()->getUuid());
+            }
+            items.append(item);
+            mPlacementDevices.insert(componentUuid, qMakePair(deviceUuid, footprint->getUuid()));
+        } catch (const Exception& e) {
+            qCritical() << "Could not load device:" << e.getMsg();
         }
     }
+    if (items.isEmpty()) return;
+
+    mPlacementBoard = mBoard;
+    mPlacementWorker.reset(new PlacementWorker(*this, DevicePlacer(items, mNextPosition,
+        Length::fromMm(1), mBoard->getGridProperties().getInterval())));
+    mUi->btnAddAll->setEnabled(false);
+    mPlacementThreadPool.start(mPlacementWorker.data());
+}
+
+void UnplacedComponentsDock::autoPlacementFinished() noexcept
+{
+    QScopedPointer<PlacementWorker> worker(mPlacementWorker.take());
+    mUi->btnAddAll->setEnabled(true);
+    if ((!worker) || (!mBoard) || (mBoard != mPlacementBoard)) return; // board has changed
+    mPlacementBoard = nullptr;
+
+    // add all devices with a single undo command
+    beginUndoCmdGroup();
+    for (auto it = mPlacementDevices.constBegin(); it != mPlacementDevices.constEnd(); ++it) {
+        ComponentInstance* component = mProject.getCircuit().getComponentInstanceByUuid(it.key());
+        if ((!component) || (mBoard->getDeviceInstanceByComponentUuid(it.key()))) continue;
+        if (!worker->getPositions().contains(it.key())) continue;
+        mLastDeviceOfComponent[component->getLibComponent().getUuid()] = it.value().first;
+        mLastFootprintOfDevice[it.value().first] = it.value().second;
+        mCurrentUndoCmdGroup->appendChild(new CmdAddDeviceToBoard(mProjectEditor.getWorkspace(),
+            *mBoard, *component, it.value().first, it.value().second,
+            worker->getPositions().value(it.key())));
+    }
+    mPlacementDevices.clear();
     commitUndoCmdGroup();
 
+    // continue below the placed devices
+    mNextPosition = Point(mNextPosition.getX(), worker->getBottom() - Length::fromMm(10))
+                    .mappedToGrid(mBoard->getGridProperties().getInterval());
     updateComponentsList();
 }
 
@@ -214,40 +328,82 @@ void UnplacedComponentsDock::on_btnAddAll_clicked()
  *  Private Methods
  ****************************************************************************************/
 
+void UnplacedComponentsDock::scheduleComponentsListUpdate(const Uuid& componentUuid) noexcept
+{
+    mChangedComponents.insert(componentUuid);
+    // the timer is not restarted, so bursts of changes lead to only one update
+    if (!mListUpdateTimer.isActive()) {
+        mListUpdateTimer.start();
+    }
+}
+
 void UnplacedComponentsDock::updateComponentsList() noexcept
 {
     if (mDisableListUpdate) return;
+    mListUpdateTimer.stop();
+
+    // only the changed components need to be updated, all other items (and the
+    // selection) are kept
+    QListWidget* list = mUi->lstUnplacedComponents;
+    int selectedIndex = list->currentRow();
+    list->blockSignals(true);
+    foreach (const Uuid& uuid, mChangedComponents) {
+        updateComponentsListItem(uuid);
+    }
+    mChangedComponents.clear();
+    if ((list->count() > 0) && (!list->currentItem())) {
+        list->setCurrentRow(qMin(qMax(selectedIndex, 0), list->count() - 1));
+    }
+    list->blockSignals(false);
+
+    // update the selected component only if it has changed
+    ComponentInstance* component = nullptr;
+    if (mBoard && list->currentItem()) {
+        Uuid cmpUuid(list->currentItem()->data(Qt::UserRole).toString());
+        component = mProject.getCircuit().getComponentInstanceByUuid(cmpUuid);
+    }
+    if ((component != mSelectedComponent) || (!component)) {
+        setSelectedComponentInstance(component);
+    }
 
-    int selectedIndex = mUi->lstUnplacedComponents->currentRow();
-    setSelectedComponentInstance(nullptr);
-    mUi->lstUnplacedComponents->clear();
+    setWindowTitle(QString(tr("Place Devices [%1]")).arg(list->count()));
+}
 
-    if (mBoard)
+void UnplacedComponentsDock::updateComponentsListItem(const Uuid& componentUuid) noexcept
+{
+    ComponentInstance* component = nullptr;
+    if (mBoard) component = mProject.getCircuit().getComponentInstanceByUuid(componentUuid);
+    bool unplaced = component && (!component->getLibComponent().isSchematicOnly())
+                    && (!mBoard->getDeviceInstanceByComponentUuid(componentUuid));
+    QListWidgetItem* item = mListItems.value(componentUuid);
+    if ((!unplaced) && item)
     {
-        const QMap<Uuid, ComponentInstance*> componentsList = mProject.getCircuit().getComponentInstances();
-        const QMap<Uuid, BI_Device*> boardDeviceList = mBoard->getDeviceInstances();
-        foreach (ComponentInstance* component, componentsList)
-        {
-            if (boardDeviceList.contains(component->getUuid())) continue;
-            if (component->getLibComponent().isSchematicOnly()) continue;
-
-            // add component to list
-            int deviceCount = mProjectEditor.getWorkspace().getLibraryDb().getDevicesOfComponent(component->getLibComponent().getUuid()).count();
-            QString name = component->getName();
-            QString value = component->getValue(true).replace("\n", "|");
-            QString compName = component->getLibComponent().getNames().value(mProject.getSettings().getLocaleOrder());
-            QString text = QString("{%1} %2 (%3) [%4]").arg(deviceCount).arg(name, value, compName);
-            QListWidgetItem* item = new QListWidgetItem(text, mUi->lstUnplacedComponents);
-            item->setData(Qt::UserRole, component->getUuid().toStr());
-        }
-
-        if (mUi->lstUnplacedComponents->count() > 0) {
-            int index = qMin(selectedIndex, mUi->lstUnplacedComponents->count()-1);
-            mUi->lstUnplacedComponents->setCurrentRow(index);
+        mListItems.remove(componentUuid);
+        delete item; // removes the item from the list
+    }
+    else if (unplaced && (!item))
+    {
+        // add component to list (sorted by UUID)
+        int deviceCount = mProjectEditor.getWorkspace().getLibraryDb().getDevicesOfComponent(component->getLibComponent().getUuid()).count();
+        QString name = component->getName();
+        QString value = component->getValue(true).replace("\n", "|");
+        QString compName = component->getLibComponent().getNames().value(mProject.getSettings().getLocaleOrder());
+        QString text = QString("{%1} %2 (%3) [%4]").arg(deviceCount).arg(name, value, compName);
+        item = new QListWidgetItem(text);
+        item->setData(Qt::UserRole, componentUuid.toStr());
+        int lower = 0, upper = mUi->lstUnplacedComponents->count();
+        while (lower < upper) {
+            int middle = (lower + upper) / 2;
+            Uuid uuid(mUi->lstUnplacedComponents->item(middle)->data(Qt::UserRole).toString());
+            if (uuid < componentUuid) {
+                lower = middle + 1;
+            } else {
+                upper = middle;
+            }
         }
+        mUi->lstUnplacedComponents->insertItem(lower, item);
+        mListItems.insert(componentUuid, item);
     }
-
-    setWindowTitle(QString(tr("Place Devices [%1]")).arg(mUi->lstUnplacedComponents->count()));
 }
 
 void UnplacedComponentsDock::setSelectedComponentInstance(ComponentInstance* cmp) noexcept
@@ -265,15 +421,17 @@ void UnplacedComponentsDock::setSelectedComponentInstance(ComponentInstance* cmp
             // TODO: use library metadata instead of loading the XML files
             FilePath devFp = mProjectEditor.getWorkspace().getLibraryDb().getLatestDevice(deviceUuid);
             if (!devFp.isValid()) continue;
-            const library::Device device(devFp, true);
+            auto device = mProjectEditor.getWorkspace().getLibraryElementCache()
+                          .getElement<library::Device>(devFp);
 
             Uuid pkgUuid;
             mProjectEditor.getWorkspace().getLibraryDb().getDeviceMetadata(devFp, &pkgUuid);
             FilePath pkgFp = mProjectEditor.getWorkspace().getLibraryDb().getLatestPackage(pkgUuid);
-            const library::Package package(pkgFp, true);
+            auto package = mProjectEditor.getWorkspace().getLibraryElementCache()
+                           .getElement<library::Package>(pkgFp);
 
-            QString devName = device.getNames().value(localeOrder);
-            QString pkgName = package.getNames().value(localeOrder);
+            QString devName = device->getNames().value(localeOrder);
+            QString pkgName = package->getNames().value(localeOrder);
             QString text = QString("%1 [%2]").arg(devName, pkgName);
             mUi->cbxSelectedDevice->addItem(text, deviceUuid.toStr());
         }
@@ -285,13 +443,14 @@ void UnplacedComponentsDock::setSelectedComponentInstance(ComponentInstance* cmp
     }
 }
 
-void UnplacedComponentsDock::setSelectedDeviceAndPackage(const library::Device* device,
-                                                         const library::Package* package) noexcept
+void UnplacedComponentsDock::setSelectedDeviceAndPackage(
+    const std::shared_ptr<const library::Device>& device,
+    const std::shared_ptr<const library::Package>& package) noexcept
 {
     setSelectedFootprintUuid(Uuid());
     mUi->cbxSelectedFootprint->clear();
-    delete mSelectedPackage;    mSelectedPackage = nullptr;
-    delete mSelectedDevice;     mSelectedDevice = nullptr;
+    mSelectedPackage.reset();
+    mSelectedDevice.reset();
 
     if (mBoard && mSelectedComponent && device && package) {
         if (device->getComponentUuid() == mSelectedComponent->getLibComponent().getUuid()) {
@@ -324,7 +483,7 @@ void UnplacedComponentsDock::setSelectedFootprintUuid(const Uuid& uuid) noexcept
         if (fpt) {
             mFootprintPreviewGraphicsItem = new library::FootprintPreviewGraphicsItem(
                 mBoard->getLayerStack(), mProject.getSettings().getLocaleOrder(), *fpt,
-                mSelectedPackage, &mSelectedComponent->getLibComponent(), mSelectedComponent);
+                mSelectedPackage.get(), &mSelectedComponent->getLibComponent(), mSelectedComponent);
             mFootprintPreviewGraphicsScene->addItem(*mFootprintPreviewGraphicsItem);
             mUi->graphicsView->zoomAll();
             mUi->btnAdd->setEnabled(true);
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <memory>
 #include <librepcb/common/units/all_length_units.h>
 #include <librepcb/common/uuid.h>
 
@@ -93,6 +94,12 @@ class UnplacedComponentsDock final : public QDockWidget
         void on_btnAdd_clicked();
         void on_pushButton_clicked();
         void on_btnAddAll_clicked();
+        void autoPlacementFinished() noexcept;
+
+
+    private: // Types
+
+        class PlacementWorker;
 
 
     private:
@@ -103,10 +110,12 @@ class UnplacedComponentsDock final : public QDockWidget
         UnplacedComponentsDock& operator=(const UnplacedComponentsDock& rhs);
 
         // Private Methods
+        void scheduleComponentsListUpdate(const Uuid& componentUuid) noexcept;
         void updateComponentsList() noexcept;
+        void updateComponentsListItem(const Uuid& componentUuid) noexcept;
         void setSelectedComponentInstance(ComponentInstance* cmp) noexcept;
-        void setSelectedDeviceAndPackage(const library::Device* device,
-                                         const library::Package* package) noexcept;
+        void setSelectedDeviceAndPackage(const std::shared_ptr<const library::Device>& device,
+                                         const std::shared_ptr<const library::Package>& package) noexcept;
         void setSelectedFootprintUuid(const Uuid& uuid) noexcept;
         void beginUndoCmdGroup() noexcept;
         void addNextDeviceToCmdGroup(ComponentInstance& cmp, const Uuid& deviceUuid, Uuid footprintUuid) noexcept;
@@ -122,8 +131,8 @@ class UnplacedComponentsDock final : public QDockWidget
         GraphicsScene* mFootprintPreviewGraphicsScene;
         library::FootprintPreviewGraphicsItem* mFootprintPreviewGraphicsItem;
         ComponentInstance* mSelectedComponent;
-        const library::Device* mSelectedDevice;
-        const library::Package* mSelectedPackage;
+        std::shared_ptr<const library::Device> mSelectedDevice;
+        std::shared_ptr<const library::Package> mSelectedPackage;
         Uuid mSelectedFootprintUuid;
         QMetaObject::Connection mCircuitConnection1;
         QMetaObject::Connection mCircuitConnection2;
@@ -131,9 +140,18 @@ class UnplacedComponentsDock final : public QDockWidget
         QMetaObject::Connection mBoardConnection2;
         Point mNextPosition;
         bool mDisableListUpdate;
+        QTimer mListUpdateTimer; ///< to update the list only once after many changes
+        QSet<Uuid> mChangedComponents; ///< components to update with the next list update
+        QHash<Uuid, QListWidgetItem*> mListItems; ///< the list items of all unplaced components
         QHash<Uuid, Uuid> mLastDeviceOfComponent;
         QHash<Uuid, Uuid> mLastFootprintOfDevice;
         QScopedPointer<UndoCommandGroup> mCurrentUndoCmdGroup;
+
+        // Automatic placement ("Add All")
+        QThreadPool mPlacementThreadPool; ///< calculates the positions in the background
+        QScopedPointer<PlacementWorker> mPlacementWorker; ///< the running placement (or nullptr)
+        Board* mPlacementBoard; ///< board of the running placement (nullptr if discarded)
+        QMap<Uuid, QPair<Uuid, Uuid>> mPlacementDevices; ///< component -> (device, footprint)
 };
 
 /*****************************************************************************************
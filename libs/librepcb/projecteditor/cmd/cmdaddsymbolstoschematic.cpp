@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdaddsymbolstoschematic.h"
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/library/projectlibrary.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/library/cmd/cmdprojectlibraryaddelement.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdAddSymbolsToSchematic::CmdAddSymbolsToSchematic(workspace::Workspace& workspace,
+        Schematic& schematic, const QList<CmdSymbolInstancesAdd::Item>& items) noexcept :
+    UndoCommandGroup(tr("Add symbols")),
+    mWorkspace(workspace), mSchematic(schematic), mItems(items),
+    mCmdAddToSchematic(nullptr)
+{
+}
+
+CmdAddSymbolsToSchematic::~CmdAddSymbolsToSchematic() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QList<SI_Symbol*> CmdAddSymbolsToSchematic::getSymbolInstances() const noexcept
+{
+    Q_ASSERT(mCmdAddToSchematic);
+    return mCmdAddToSchematic ? mCmdAddToSchematic->getSymbolInstances() : QList<SI_Symbol*>();
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdAddSymbolsToSchematic::performExecute()
+{
+    // copy all symbols which do not exist in the project's library yet from the
+    // workspace library to the project's library
+    QSet<Uuid> symbolUuids;
+    foreach (const CmdSymbolInstancesAdd::Item& item, mItems) {
+        const library::ComponentSymbolVariantItem& symbVarItem = *item.component->
+            getSymbolVariant().getSymbolItems().get(item.symbolItem); // can throw
+        Uuid symbolUuid = symbVarItem.getSymbolUuid();
+        if (symbolUuids.contains(symbolUuid)) continue;
+        symbolUuids.insert(symbolUuid);
+        if (!mSchematic.getProject().getLibrary().getSymbol(symbolUuid)) {
+            FilePath symFp = mWorkspace.getLibraryDb().getLatestSymbol(symbolUuid);
+            if (!symFp.isValid()) {
+                throw RuntimeError(__FILE__, __LINE__,
+                    QString(tr("The symbol with the UUID \"%1\" does not exist in the "
+                    "workspace library!")).arg(symbolUuid.toStr()));
+            }
+            library::Symbol* sym = new library::Symbol(symFp, true);
+            CmdProjectLibraryAddElement<library::Symbol>* cmdAddToLibrary =
+                new CmdProjectLibraryAddElement<library::Symbol>(mSchematic.getProject().getLibrary(), *sym);
+            appendChild(cmdAddToLibrary); // can throw
+        }
+    }
+
+    // create child command to add all symbol instances to the schematic
+    mCmdAddToSchematic = new CmdSymbolInstancesAdd(mSchematic, mItems);
+    appendChild(mCmdAddToSchematic); // can throw
+
+    // execute all child commands
+    return UndoCommandGroup::performExecute(); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,98 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CMDADDSYMBOLSTOSCHEMATIC_H
+#define LIBREPCB_PROJECT_CMDADDSYMBOLSTOSCHEMATIC_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommandgroup.h>
+#include <librepcb/project/schematics/cmd/cmdsymbolinstancesadd.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace workspace {
+class Workspace;
+}
+
+namespace project {
+
+class Schematic;
+class SI_Symbol;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class CmdAddSymbolsToSchematic
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdAddSymbolsToSchematic class adds many symbols to a schematic at once
+ *
+ * Like librepcb::project::editor::CmdAddSymbolToSchematic, missing symbols are copied
+ * from the workspace library to the project's library (each of them only once). Then
+ * all symbol instances are added with a single
+ * librepcb::project::CmdSymbolInstancesAdd.
+ */
+class CmdAddSymbolsToSchematic final : public UndoCommandGroup
+{
+    public:
+
+        // Constructors / Destructor
+        CmdAddSymbolsToSchematic(workspace::Workspace& workspace, Schematic& schematic,
+                                 const QList<CmdSymbolInstancesAdd::Item>& items) noexcept;
+        ~CmdAddSymbolsToSchematic() noexcept;
+
+        // Getters
+        QList<SI_Symbol*> getSymbolInstances() const noexcept;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+
+        // Private Member Variables
+
+        // Attributes from the constructor
+        workspace::Workspace& mWorkspace;
+        Schematic& mSchematic;
+        QList<CmdSymbolInstancesAdd::Item> mItems;
+
+        // child commands
+        CmdSymbolInstancesAdd* mCmdAddToSchematic;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDADDSYMBOLSTOSCHEMATIC_H
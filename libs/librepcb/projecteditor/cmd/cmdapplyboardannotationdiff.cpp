@@ -0,0 +1,165 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdapplyboardannotationdiff.h"
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/boards/cmd/cmdboardnetitemsmove.h>
+#include "cmdadddevicetoboard.h"
+#include "cmdremovedevicefromboard.h"
+#include "cmdreplacedevices.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdApplyBoardAnnotationDiff::CmdApplyBoardAnnotationDiff(workspace::Workspace& workspace,
+        Board& board, const BoardAnnotationDiff::Result& diff) noexcept :
+    UndoCommandGroup(tr("Update Board from Schematic")), mWorkspace(workspace),
+    mBoard(board), mDiff(diff)
+{
+}
+
+CmdApplyBoardAnnotationDiff::~CmdApplyBoardAnnotationDiff() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdApplyBoardAnnotationDiff::performExecute()
+{
+    // if an error occurs, undo all already executed child commands
+    auto undoScopeGuard = scopeGuard([&](){performUndo();});
+
+    // defer the scene index and ERC updates until all items are processed
+    int itemCount = mDiff.addedDevices.count() + mDiff.removedDevices.count() +
+                    mDiff.replacedDevices.count() + mDiff.netPointChanges.count() +
+                    mDiff.viaChanges.count();
+    bool bulkUpdate = (itemCount >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+
+    Circuit& circuit = mBoard.getProject().getCircuit();
+
+    // remove devices
+    foreach (const Uuid& uuid, mDiff.removedDevices) {
+        if (BI_Device* device = mBoard.getDeviceInstanceByComponentUuid(uuid)) {
+            execNewChildCmd(new CmdRemoveDeviceFromBoard(*device)); // can throw
+        }
+    }
+
+    // replace devices, grouped by the new library device
+    QMap<Uuid, QSet<Uuid>> replacements; // new library device -> components
+    foreach (const BoardAnnotationDiff::DeviceReplacement& r, mDiff.replacedDevices) {
+        replacements[r.libDeviceUuid].insert(r.componentUuid);
+    }
+    for (auto it = replacements.constBegin(); it != replacements.constEnd(); ++it) {
+        QSet<Uuid> components = it.value();
+        execNewChildCmd(new CmdReplaceDevices(mWorkspace, mBoard,
+            [components](const BI_Device& device){
+                return components.contains(device.getComponentInstanceUuid());
+            }, it.key())); // can throw
+    }
+
+    // move traces to their new net signals, grouped by the new net signal
+    QHash<Uuid, BI_NetPoint*> netpoints;
+    foreach (BI_NetPoint* netpoint, mBoard.getNetPoints()) {
+        netpoints.insert(netpoint->getUuid(), netpoint);
+    }
+    QHash<Uuid, BI_Via*> vias;
+    foreach (BI_Via* via, mBoard.getVias()) {
+        vias.insert(via->getUuid(), via);
+    }
+    QMap<Uuid, QPair<QList<BI_NetPoint*>, QList<BI_Via*>>> netItems;
+    foreach (const BoardAnnotationDiff::NetSignalChange& change, mDiff.netPointChanges) {
+        if (BI_NetPoint* netpoint = netpoints.value(change.itemUuid)) {
+            netItems[change.netSignalUuid].first.append(netpoint);
+        }
+    }
+    foreach (const BoardAnnotationDiff::NetSignalChange& change, mDiff.viaChanges) {
+        BI_Via* via = vias.value(change.itemUuid);
+        if (via && via->getNetSignal()) {
+            netItems[change.netSignalUuid].second.append(via);
+        }
+    }
+    for (auto it = netItems.constBegin(); it != netItems.constEnd(); ++it) {
+        if (NetSignal* netsignal = circuit.getNetSignalByUuid(it.key())) {
+            execNewChildCmd(new CmdBoardNetItemsMove(it.value().first, it.value().second,
+                                                     *netsignal)); // can throw
+        }
+    }
+
+    // add missing devices
+    foreach (const BoardAnnotationDiff::DeviceAddition& addition, mDiff.addedDevices) {
+        ComponentInstance* component = circuit.getComponentInstanceByUuid(
+                                           addition.componentUuid);
+        if (component && (!mBoard.getDeviceInstanceByComponentUuid(addition.componentUuid))) {
+            execNewChildCmd(new CmdAddDeviceToBoard(mWorkspace, mBoard, *component,
+                                                    addition.libDeviceUuid, Uuid(),
+                                                    addition.position)); // can throw
+        }
+    }
+
+    undoScopeGuard.dismiss(); // no undo required
+    return (getChildCount() > 0);
+}
+
+void CmdApplyBoardAnnotationDiff::performUndo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdApplyBoardAnnotationDiff::performRedo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CMDAPPLYBOARDANNOTATIONDIFF_H
+#define LIBREPCB_PROJECT_CMDAPPLYBOARDANNOTATIONDIFF_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommandgroup.h>
+#include <librepcb/project/boards/boardannotationdiff.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace workspace {
+class Workspace;
+}
+
+namespace project {
+
+class Board;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class CmdApplyBoardAnnotationDiff
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdApplyBoardAnnotationDiff class applies a
+ *        librepcb::project::BoardAnnotationDiff::Result to a board
+ *
+ * All operations are executed as child commands in a single bulk update of the board,
+ * so the whole forward annotation can be undone at once. The operations are applied in
+ * this order: remove devices, replace devices (one
+ * librepcb::project::editor::CmdReplaceDevices per new library device), move traces to
+ * other net signals and add the missing devices.
+ *
+ * Items are looked up by their UUIDs, so operations referring to items which were
+ * removed since the result was calculated are skipped.
+ */
+class CmdApplyBoardAnnotationDiff final : public UndoCommandGroup
+{
+    public:
+
+        // Constructors / Destructor
+        CmdApplyBoardAnnotationDiff() = delete;
+        CmdApplyBoardAnnotationDiff(const CmdApplyBoardAnnotationDiff& other) = delete;
+        CmdApplyBoardAnnotationDiff(workspace::Workspace& workspace, Board& board,
+                                    const BoardAnnotationDiff::Result& diff) noexcept;
+        ~CmdApplyBoardAnnotationDiff() noexcept;
+
+        // Operator Overloadings
+        CmdApplyBoardAnnotationDiff& operator=(const CmdApplyBoardAnnotationDiff& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+
+        // Private Member Variables
+
+        // Attributes from the constructor
+        workspace::Workspace& mWorkspace;
+        Board& mBoard;
+        BoardAnnotationDiff::Result mDiff;
+
+        /// @copydoc librepcb::project::editor::CmdReplaceDevice::sBulkUpdateMinItems
+        static constexpr int sBulkUpdateMinItems = 100;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDAPPLYBOARDANNOTATIONDIFF_H
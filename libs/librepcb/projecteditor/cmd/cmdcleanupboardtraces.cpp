@@ -0,0 +1,311 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include "cmdcleanupboardtraces.h"
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/project/boards/cmd/cmdboardnetlineremove.h>
+#include <librepcb/project/boards/cmd/cmdboardnetlineadd.h>
+#include <librepcb/project/boards/cmd/cmdboardnetpointremove.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+namespace {
+
+/// The key to find coincident netpoints
+struct NetPointKey {
+    const GraphicsLayer* layer;
+    const NetSignal* netsignal;
+    LengthBase_t x;
+    LengthBase_t y;
+
+    bool operator==(const NetPointKey& rhs) const noexcept {
+        return (layer == rhs.layer) && (netsignal == rhs.netsignal)
+            && (x == rhs.x) && (y == rhs.y);
+    }
+};
+
+uint qHash(const NetPointKey& key, uint seed = 0) noexcept
+{
+    return ::qHash(qMakePair(key.x, key.y), seed) ^ ::qHash(key.layer, seed)
+         ^ ::qHash(key.netsignal, seed + 1);
+}
+
+/// A netline during the cleanup (the netpoints and the width may have been changed)
+struct Line {
+    BI_NetLine* netline;
+    BI_NetPoint* p1;
+    BI_NetPoint* p2;
+    Length width;
+    bool removed;
+};
+
+/// Netlines in the same direction, with their lengths in units of the direction
+typedef QVector<QPair<LengthBase_t, int>> CollinearLines;
+
+LengthBase_t greatestCommonDivisor(LengthBase_t a, LengthBase_t b) noexcept
+{
+    a = qAbs(a);
+    b = qAbs(b);
+    while (b != 0) {
+        LengthBase_t rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdCleanUpBoardTraces::CmdCleanUpBoardTraces(Board& board) noexcept :
+    UndoCommandGroup(tr("Clean Up Traces")), mBoard(board)
+{
+}
+
+CmdCleanUpBoardTraces::~CmdCleanUpBoardTraces() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdCleanUpBoardTraces::performExecute()
+{
+    // if an error occurs, undo all already executed child commands
+    auto undoScopeGuard = scopeGuard([&](){performUndo();});
+
+    // find coincident netpoints and choose the one to keep (prefer attached netpoints)
+    QHash<BI_NetPoint*, BI_NetPoint*> replacements;
+    QHash<NetPointKey, BI_NetPoint*> pointsAtPosition;
+    pointsAtPosition.reserve(mBoard.getNetPoints().count());
+    foreach (BI_NetPoint* netpoint, mBoard.getNetPoints()) {
+        NetPointKey key{&netpoint->getLayer(), &netpoint->getNetSignal(),
+                        netpoint->getPosition().getX().toNm(),
+                        netpoint->getPosition().getY().toNm()};
+        BI_NetPoint* kept = pointsAtPosition.value(key, nullptr);
+        if (!kept) {
+            pointsAtPosition.insert(key, netpoint);
+        } else if (!netpoint->isAttached()) {
+            replacements.insert(netpoint, kept);
+        } else if (!kept->isAttached()) {
+            replacements.insert(kept, netpoint);
+            pointsAtPosition.insert(key, netpoint);
+        } else if ((netpoint->getFootprintPad() == kept->getFootprintPad())
+                   && (netpoint->getVia() == kept->getVia())) {
+            replacements.insert(netpoint, kept);
+        } // else: attached to different pads or vias, so don't touch them
+    }
+    auto resolve = [&](BI_NetPoint* netpoint) -> BI_NetPoint* {
+        while (replacements.contains(netpoint)) {
+            netpoint = replacements.value(netpoint);
+        }
+        return netpoint;
+    };
+
+    // collect all netlines with the resolved netpoints and remove zero-length netlines
+    QVector<Line> lines;
+    lines.reserve(mBoard.getNetLines().count());
+    QHash<BI_NetPoint*, QList<int>> linesAtPoint;
+    foreach (BI_NetLine* netline, mBoard.getNetLines()) {
+        Line line{netline, resolve(&netline->getStartPoint()),
+                  resolve(&netline->getEndPoint()), netline->getWidth(), false};
+        line.removed = (line.p1 == line.p2);
+        if (!line.removed) {
+            linesAtPoint[line.p1].append(lines.count());
+            linesAtPoint[line.p2].append(lines.count());
+        }
+        lines.append(line);
+    }
+    auto removeLine = [&](int index) {
+        Line& line = lines[index];
+        line.removed = true;
+        linesAtPoint[line.p1].removeOne(index);
+        linesAtPoint[line.p2].removeOne(index);
+    };
+
+    // split overlapping collinear netlines which start at the same netpoint into
+    // consecutive segments
+    foreach (BI_NetPoint* netpoint, mBoard.getNetPoints()) {
+        QList<int> indices = linesAtPoint.value(netpoint);
+        if (indices.count() < 2) {
+            continue;
+        }
+        // group the netlines by their exact direction
+        QHash<QPair<LengthBase_t, LengthBase_t>, CollinearLines> directions;
+        foreach (int index, indices) {
+            const Line& line = lines.at(index);
+            BI_NetPoint* other = (line.p1 == netpoint) ? line.p2 : line.p1;
+            Point delta = other->getPosition() - netpoint->getPosition();
+            LengthBase_t dx = delta.getX().toNm(), dy = delta.getY().toNm();
+            LengthBase_t divisor = greatestCommonDivisor(dx, dy);
+            if (divisor == 0) {
+                continue; // coincident netpoints which could not be merged
+            }
+            directions[qMakePair(dx / divisor, dy / divisor)].append(qMakePair(divisor, index));
+        }
+        foreach (CollinearLines group, directions) {
+            if (group.count() < 2) {
+                continue;
+            }
+            std::sort(group.begin(), group.end());
+            // the segment between the ends of two consecutive netlines is covered by
+            // all longer netlines, so it gets the maximum width of them
+            QVector<BI_NetPoint*> ends;
+            QVector<Length> widths(group.count());
+            for (int i = 0; i < group.count(); ++i) {
+                const Line& line = lines.at(group.at(i).second);
+                ends.append((line.p1 == netpoint) ? line.p2 : line.p1);
+            }
+            Length width(0);
+            for (int i = group.count() - 1; i >= 0; --i) {
+                width = qMax(width, lines.at(group.at(i).second).width);
+                widths[i] = width;
+            }
+            lines[group.first().second].width = widths.first();
+            for (int i = 1; i < group.count(); ++i) {
+                int index = group.at(i).second;
+                if (group.at(i).first == group.at(i - 1).first) {
+                    removeLine(index); // duplicate; its width is taken over by the previous
+                    continue;
+                }
+                Line& line = lines[index];
+                linesAtPoint[netpoint].removeOne(index);
+                if (line.p1 == netpoint) {
+                    line.p1 = ends.at(i - 1);
+                } else {
+                    line.p2 = ends.at(i - 1);
+                }
+                linesAtPoint[ends.at(i - 1)].append(index);
+                line.width = widths.at(i);
+            }
+        }
+    }
+
+    // remove duplicated netlines, the remaining netline gets the maximum width
+    QHash<QPair<BI_NetPoint*, BI_NetPoint*>, int> linesBetweenPoints;
+    for (int i = 0; i < lines.count(); ++i) {
+        const Line& line = lines.at(i);
+        if (line.removed) {
+            continue;
+        }
+        QPair<BI_NetPoint*, BI_NetPoint*> key = (line.p1 < line.p2)
+            ? qMakePair(line.p1, line.p2) : qMakePair(line.p2, line.p1);
+        int existing = linesBetweenPoints.value(key, -1);
+        if (existing < 0) {
+            linesBetweenPoints.insert(key, i);
+        } else {
+            lines[existing].width = qMax(lines.at(existing).width, line.width);
+            removeLine(i);
+        }
+    }
+
+    // remove dangling stubs (removing a stub may create a new stub at its other end)
+    auto isStubEnd = [&](BI_NetPoint* netpoint) -> bool {
+        if (replacements.contains(netpoint) || netpoint->isAttached()
+            || (linesAtPoint.value(netpoint).count() != 1)) {
+            return false;
+        }
+        foreach (const BI_Polygon* polygon, netpoint->getNetSignal().getBoardPolygons()) {
+            if ((&polygon->getBoard() == &mBoard) && polygon->isCopperPour()
+                && (polygon->getPolygon().getLayerName() == netpoint->getLayer().getName())) {
+                return false; // probably connected by the copper pour
+            }
+        }
+        return true;
+    };
+    QList<BI_NetPoint*> stubEnds;
+    foreach (BI_NetPoint* netpoint, mBoard.getNetPoints()) {
+        if (isStubEnd(netpoint)) {
+            stubEnds.append(netpoint);
+        }
+    }
+    while (!stubEnds.isEmpty()) {
+        BI_NetPoint* netpoint = stubEnds.takeLast();
+        if (!isStubEnd(netpoint)) {
+            continue; // e.g. the other end of an already removed stub
+        }
+        int index = linesAtPoint.value(netpoint).first();
+        BI_NetPoint* other = (lines.at(index).p1 == netpoint) ? lines.at(index).p2
+                                                              : lines.at(index).p1;
+        removeLine(index);
+        if (isStubEnd(other)) {
+            stubEnds.append(other);
+        }
+    }
+
+    // apply the fixes: remove all modified netlines, add them again with the new
+    // netpoints and width, and finally remove all unused netpoints
+    QVector<int> modifiedLines;
+    for (int i = 0; i < lines.count(); ++i) {
+        const Line& line = lines.at(i);
+        if (line.removed || (line.p1 != &line.netline->getStartPoint())
+            || (line.p2 != &line.netline->getEndPoint())
+            || (line.width != line.netline->getWidth())) {
+            modifiedLines.append(i);
+        }
+    }
+    foreach (int index, modifiedLines) {
+        execNewChildCmd(new CmdBoardNetLineRemove(*lines.at(index).netline)); // can throw
+    }
+    foreach (int index, modifiedLines) {
+        const Line& line = lines.at(index);
+        if (!line.removed) {
+            execNewChildCmd(new CmdBoardNetLineAdd(mBoard, *line.p1, *line.p2,
+                                                   line.width)); // can throw
+        }
+    }
+    foreach (BI_NetPoint* netpoint, mBoard.getNetPoints()) {
+        if (replacements.contains(netpoint)
+            || ((!netpoint->isAttached()) && (!netpoint->isUsed()))) {
+            execNewChildCmd(new CmdBoardNetPointRemove(*netpoint)); // can throw
+        }
+    }
+
+    undoScopeGuard.dismiss(); // no undo required
+    return (getChildCount() > 0);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_CMDCLEANUPBOARDTRACES_H
+#define LIBREPCB_PROJECT_CMDCLEANUPBOARDTRACES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommandgroup.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class CmdCleanUpBoardTraces
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdCleanUpBoardTraces class cleans up the traces of a whole board
+ *
+ * All problems are detected in a single pass over the netpoints and netlines (using
+ * hash tables instead of position scans), and all fixes are applied as child commands
+ * of this command, so they can be undone at once:
+ *  - Coincident netpoints (same position, layer and net signal) are merged. A netpoint
+ *    attached to a pad or via is kept, netpoints attached to different pads or vias
+ *    are not merged.
+ *  - Zero-length netlines are removed.
+ *  - Overlapping collinear netlines starting at the same netpoint are split into
+ *    consecutive segments (each with the maximum width of the covering netlines).
+ *  - Duplicated netlines are removed (the remaining one gets the maximum width).
+ *  - Dangling stubs (netlines ending at an unattached netpoint without other netlines)
+ *    are removed, except for net signals with copper pours on the same layer since
+ *    such traces are probably connected by the pour.
+ *  - Unattached netpoints without netlines are removed.
+ *
+ * Netlines are rewired by removing and re-adding them (like
+ * librepcb::project::editor::CmdCombineBoardNetPoints), so they get new UUIDs.
+ */
+class CmdCleanUpBoardTraces final : public UndoCommandGroup
+{
+    public:
+
+        // Constructors / Destructor
+        explicit CmdCleanUpBoardTraces(Board& board) noexcept;
+        ~CmdCleanUpBoardTraces() noexcept;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+
+        // Attributes from the constructor
+        Board& mBoard;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDCLEANUPBOARDTRACES_H
@@ -0,0 +1,292 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include "cmdcleanupschematicnetlines.h"
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/items/si_netpoint.h>
+#include <librepcb/project/schematics/items/si_netline.h>
+#include <librepcb/project/schematics/items/si_netlabel.h>
+#include <librepcb/project/schematics/cmd/cmdschematicnetlineremove.h>
+#include <librepcb/project/schematics/cmd/cmdschematicnetlineadd.h>
+#include <librepcb/project/schematics/cmd/cmdschematicnetpointremove.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+namespace {
+
+/// The key to find coincident netpoints
+struct NetPointKey {
+    const NetSignal* netsignal;
+    LengthBase_t x;
+    LengthBase_t y;
+
+    bool operator==(const NetPointKey& rhs) const noexcept {
+        return (netsignal == rhs.netsignal) && (x == rhs.x) && (y == rhs.y);
+    }
+};
+
+uint qHash(const NetPointKey& key, uint seed = 0) noexcept
+{
+    return ::qHash(qMakePair(key.x, key.y), seed) ^ ::qHash(key.netsignal, seed);
+}
+
+/// A netline during the cleanup (the netpoints may have been changed)
+struct Line {
+    SI_NetLine* netline;
+    SI_NetPoint* p1;
+    SI_NetPoint* p2;
+    bool removed;
+};
+
+/// Netlines in the same direction, with their lengths in units of the direction
+typedef QVector<QPair<LengthBase_t, int>> CollinearLines;
+
+LengthBase_t greatestCommonDivisor(LengthBase_t a, LengthBase_t b) noexcept
+{
+    a = qAbs(a);
+    b = qAbs(b);
+    while (b != 0) {
+        LengthBase_t rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdCleanUpSchematicNetLines::CmdCleanUpSchematicNetLines(Schematic& schematic) noexcept :
+    UndoCommandGroup(tr("Clean Up Net Lines")), mSchematic(schematic)
+{
+}
+
+CmdCleanUpSchematicNetLines::~CmdCleanUpSchematicNetLines() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdCleanUpSchematicNetLines::performExecute()
+{
+    // if an error occurs, undo all already executed child commands
+    auto undoScopeGuard = scopeGuard([&](){performUndo();});
+
+    // find coincident netpoints and choose the one to keep (prefer attached netpoints)
+    QHash<SI_NetPoint*, SI_NetPoint*> replacements;
+    QHash<NetPointKey, SI_NetPoint*> pointsAtPosition;
+    pointsAtPosition.reserve(mSchematic.getNetPoints().count());
+    foreach (SI_NetPoint* netpoint, mSchematic.getNetPoints()) {
+        NetPointKey key{&netpoint->getNetSignal(),
+                        netpoint->getPosition().getX().toNm(),
+                        netpoint->getPosition().getY().toNm()};
+        SI_NetPoint* kept = pointsAtPosition.value(key, nullptr);
+        if (!kept) {
+            pointsAtPosition.insert(key, netpoint);
+        } else if (!netpoint->isAttachedToPin()) {
+            replacements.insert(netpoint, kept);
+        } else if (!kept->isAttachedToPin()) {
+            replacements.insert(kept, netpoint);
+            pointsAtPosition.insert(key, netpoint);
+        } else if (netpoint->getSymbolPin() == kept->getSymbolPin()) {
+            replacements.insert(netpoint, kept);
+        } // else: attached to different pins, so don't touch them
+    }
+    auto resolve = [&](SI_NetPoint* netpoint) -> SI_NetPoint* {
+        while (replacements.contains(netpoint)) {
+            netpoint = replacements.value(netpoint);
+        }
+        return netpoint;
+    };
+
+    // collect all netlines with the resolved netpoints and remove zero-length netlines
+    QVector<Line> lines;
+    lines.reserve(mSchematic.getNetLines().count());
+    QHash<SI_NetPoint*, QList<int>> linesAtPoint;
+    foreach (SI_NetLine* netline, mSchematic.getNetLines()) {
+        Line line{netline, resolve(&netline->getStartPoint()),
+                  resolve(&netline->getEndPoint()), false};
+        line.removed = (line.p1 == line.p2);
+        if (!line.removed) {
+            linesAtPoint[line.p1].append(lines.count());
+            linesAtPoint[line.p2].append(lines.count());
+        }
+        lines.append(line);
+    }
+    auto removeLine = [&](int index) {
+        Line& line = lines[index];
+        line.removed = true;
+        linesAtPoint[line.p1].removeOne(index);
+        linesAtPoint[line.p2].removeOne(index);
+    };
+
+    // split overlapping collinear netlines which start at the same netpoint into
+    // consecutive segments
+    foreach (SI_NetPoint* netpoint, mSchematic.getNetPoints()) {
+        QList<int> indices = linesAtPoint.value(netpoint);
+        if (indices.count() < 2) {
+            continue;
+        }
+        // group the netlines by their exact direction
+        QHash<QPair<LengthBase_t, LengthBase_t>, CollinearLines> directions;
+        foreach (int index, indices) {
+            const Line& line = lines.at(index);
+            SI_NetPoint* other = (line.p1 == netpoint) ? line.p2 : line.p1;
+            Point delta = other->getPosition() - netpoint->getPosition();
+            LengthBase_t dx = delta.getX().toNm(), dy = delta.getY().toNm();
+            LengthBase_t divisor = greatestCommonDivisor(dx, dy);
+            if (divisor == 0) {
+                continue; // coincident netpoints which could not be merged
+            }
+            directions[qMakePair(dx / divisor, dy / divisor)].append(qMakePair(divisor, index));
+        }
+        foreach (CollinearLines group, directions) {
+            if (group.count() < 2) {
+                continue;
+            }
+            std::sort(group.begin(), group.end());
+            QVector<SI_NetPoint*> ends;
+            for (int i = 0; i < group.count(); ++i) {
+                const Line& line = lines.at(group.at(i).second);
+                ends.append((line.p1 == netpoint) ? line.p2 : line.p1);
+            }
+            for (int i = 1; i < group.count(); ++i) {
+                int index = group.at(i).second;
+                if (group.at(i).first == group.at(i - 1).first) {
+                    removeLine(index); // duplicate
+                    continue;
+                }
+                Line& line = lines[index];
+                linesAtPoint[netpoint].removeOne(index);
+                if (line.p1 == netpoint) {
+                    line.p1 = ends.at(i - 1);
+                } else {
+                    line.p2 = ends.at(i - 1);
+                }
+                linesAtPoint[ends.at(i - 1)].append(index);
+            }
+        }
+    }
+
+    // remove duplicated netlines
+    QHash<QPair<SI_NetPoint*, SI_NetPoint*>, int> linesBetweenPoints;
+    for (int i = 0; i < lines.count(); ++i) {
+        const Line& line = lines.at(i);
+        if (line.removed) {
+            continue;
+        }
+        QPair<SI_NetPoint*, SI_NetPoint*> key = (line.p1 < line.p2)
+            ? qMakePair(line.p1, line.p2) : qMakePair(line.p2, line.p1);
+        int existing = linesBetweenPoints.value(key, -1);
+        if (existing < 0) {
+            linesBetweenPoints.insert(key, i);
+        } else {
+            removeLine(i);
+        }
+    }
+
+    // remove dangling stubs (removing a stub may create a new stub at its other end)
+    auto isStubEnd = [&](SI_NetPoint* netpoint) -> bool {
+        if (replacements.contains(netpoint) || netpoint->isAttachedToPin()
+            || (linesAtPoint.value(netpoint).count() != 1)) {
+            return false;
+        }
+        foreach (const SI_NetLabel* netlabel, netpoint->getNetSignal().getSchematicNetLabels()) {
+            if (&netlabel->getSchematic() == &mSchematic) {
+                return false; // the stub is probably drawn for the net label
+            }
+        }
+        return true;
+    };
+    QList<SI_NetPoint*> stubEnds;
+    foreach (SI_NetPoint* netpoint, mSchematic.getNetPoints()) {
+        if (isStubEnd(netpoint)) {
+            stubEnds.append(netpoint);
+        }
+    }
+    while (!stubEnds.isEmpty()) {
+        SI_NetPoint* netpoint = stubEnds.takeLast();
+        if (!isStubEnd(netpoint)) {
+            continue; // e.g. the other end of an already removed stub
+        }
+        int index = linesAtPoint.value(netpoint).first();
+        SI_NetPoint* other = (lines.at(index).p1 == netpoint) ? lines.at(index).p2
+                                                              : lines.at(index).p1;
+        removeLine(index);
+        if (isStubEnd(other)) {
+            stubEnds.append(other);
+        }
+    }
+
+    // apply the fixes: remove all modified netlines, add them again with the new
+    // netpoints, and finally remove all unused netpoints
+    QVector<int> modifiedLines;
+    for (int i = 0; i < lines.count(); ++i) {
+        const Line& line = lines.at(i);
+        if (line.removed || (line.p1 != &line.netline->getStartPoint())
+            || (line.p2 != &line.netline->getEndPoint())) {
+            modifiedLines.append(i);
+        }
+    }
+    foreach (int index, modifiedLines) {
+        execNewChildCmd(new CmdSchematicNetLineRemove(*lines.at(index).netline)); // can throw
+    }
+    foreach (int index, modifiedLines) {
+        const Line& line = lines.at(index);
+        if (!line.removed) {
+            execNewChildCmd(new CmdSchematicNetLineAdd(mSchematic, *line.p1,
+                                                       *line.p2)); // can throw
+        }
+    }
+    foreach (SI_NetPoint* netpoint, mSchematic.getNetPoints()) {
+        if (replacements.contains(netpoint)
+            || ((!netpoint->isAttachedToPin()) && (!netpoint->isUsed()))) {
+            execNewChildCmd(new CmdSchematicNetPointRemove(*netpoint)); // can throw
+        }
+    }
+
+    undoScopeGuard.dismiss(); // no undo required
+    return (getChildCount() > 0);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,88 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_CMDCLEANUPSCHEMATICNETLINES_H
+#define LIBREPCB_PROJECT_CMDCLEANUPSCHEMATICNETLINES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommandgroup.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Schematic;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class CmdCleanUpSchematicNetLines
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdCleanUpSchematicNetLines class cleans up the netlines of a whole schematic
+ *
+ * This is the schematic counterpart of librepcb::project::editor::CmdCleanUpBoardTraces:
+ *  - Coincident netpoints of the same net signal are merged (a netpoint attached to a
+ *    symbol pin is kept, netpoints attached to different pins are not merged).
+ *  - Zero-length netlines are removed.
+ *  - Overlapping collinear netlines starting at the same netpoint are split into
+ *    consecutive segments.
+ *  - Duplicated netlines are removed.
+ *  - Dangling stubs (netlines ending at an unattached netpoint without other netlines)
+ *    are removed, except for net signals with net labels in the schematic since such
+ *    stubs are often drawn to place the labels.
+ *  - Unattached netpoints without netlines are removed.
+ */
+class CmdCleanUpSchematicNetLines final : public UndoCommandGroup
+{
+    public:
+
+        // Constructors / Destructor
+        explicit CmdCleanUpSchematicNetLines(Schematic& schematic) noexcept;
+        ~CmdCleanUpSchematicNetLines() noexcept;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+
+        // Attributes from the constructor
+        Schematic& mSchematic;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDCLEANUPSCHEMATICNETLINES_H
@@ -66,6 +66,10 @@ CmdFlipSelectedBoardItems::~CmdFlipSelectedBoardItems() noexcept
 
 bool CmdFlipSelectedBoardItems::performExecute()
 {
+    // update the moved netlines only once at the end
+    mBoard.beginNetLineUpdateBatch();
+    auto netLineUpdateGuard = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+
     // if an error occurs, undo all already executed child commands
     auto undoScopeGuard = scopeGuard([&](){performUndo();});
 
@@ -170,6 +174,20 @@ bool CmdFlipSelectedBoardItems::performExecute()
     return (getChildCount() > 0);
 }
 
+void CmdFlipSelectedBoardItems::performUndo()
+{
+    mBoard.beginNetLineUpdateBatch();
+    auto sg = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdFlipSelectedBoardItems::performRedo()
+{
+    mBoard.beginNetLineUpdateBatch();
+    auto sg = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -22,6 +22,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "cmdmoveselectedboarditems.h"
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/common/gridproperties.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/boards/board.h>
@@ -46,12 +47,14 @@ namespace editor {
 
 CmdMoveSelectedBoardItems::CmdMoveSelectedBoardItems(Board& board, const Point& startPos) noexcept :
     UndoCommandGroup(tr("Move Board Elements")),
-    mBoard(board), mStartPos(startPos), mDeltaPos(0, 0)
+    mBoard(board), mStartPos(startPos), mDeltaPos(0, 0),
+    mStartTimestamp(QDateTime::currentMSecsSinceEpoch()), mFinishTimestamp(0)
 {
     // get all selected items
     QList<BI_Base*> items = mBoard.getSelectedItems(true, false, true, false, true, false,
                                                     false, false, false, false, false, false);
 
+    mItems = items.toSet();
     foreach (BI_Base* item, items) {
         switch (item->getType())
         {
@@ -96,7 +99,9 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept
     delta.mapToGrid(mBoard.getGridProperties().getInterval());
 
     if (delta != mDeltaPos) {
-        // move selected elements
+        // move selected elements, but update the connected netlines only once
+        mBoard.beginNetLineUpdateBatch();
+        auto netLineUpdateGuard = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
         foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
             cmd->setDeltaToStartPos(delta, true);
         }
@@ -114,8 +119,28 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
+bool CmdMoveSelectedBoardItems::mergeWith(UndoCommand* other) noexcept
+{
+    CmdMoveSelectedBoardItems* cmd = dynamic_cast<CmdMoveSelectedBoardItems*>(other);
+    if ((!cmd) || (&cmd->mBoard != &mBoard) || (cmd->mItems != mItems)) {
+        return false;
+    }
+    if ((!isCurrentlyExecuted()) || (!cmd->isCurrentlyExecuted())) {
+        return false;
+    }
+    if (cmd->mStartTimestamp - mFinishTimestamp > sMergeIntervalMs) {
+        return false; // not part of the same gesture
+    }
+    mFinishTimestamp = cmd->mFinishTimestamp;
+    appendExecutedChild(cmd); // takes the ownership
+    mDeltaPos += cmd->mDeltaPos;
+    return true;
+}
+
 bool CmdMoveSelectedBoardItems::performExecute()
 {
+    mFinishTimestamp = QDateTime::currentMSecsSinceEpoch();
+
     if (mDeltaPos.isOrigin()) {
         // no movement required --> discard all move commands
         qDeleteAll(mDeviceEditCmds);    mDeviceEditCmds.clear();
@@ -124,6 +149,10 @@ bool CmdMoveSelectedBoardItems::performExecute()
         return false;
     }
 
+    // update the moved netlines only once at the end
+    mBoard.beginNetLineUpdateBatch();
+    auto netLineUpdateGuard = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+
     foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
         appendChild(cmd); // can throw
     }
@@ -138,6 +167,20 @@ bool CmdMoveSelectedBoardItems::performExecute()
     return UndoCommandGroup::performExecute(); // can throw
 }
 
+void CmdMoveSelectedBoardItems::performUndo()
+{
+    mBoard.beginNetLineUpdateBatch();
+    auto sg = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdMoveSelectedBoardItems::performRedo()
+{
+    mBoard.beginNetLineUpdateBatch();
+    auto sg = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
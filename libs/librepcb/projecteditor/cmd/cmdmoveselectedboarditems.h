@@ -34,6 +34,7 @@ namespace librepcb {
 namespace project {
 
 class Board;
+class BI_Base;
 class CmdDeviceInstanceEdit;
 class CmdBoardViaEdit;
 class CmdBoardNetPointEdit;
@@ -58,6 +59,17 @@ class CmdMoveSelectedBoardItems final : public UndoCommandGroup
         // General Methods
         void setCurrentPosition(const Point& pos) noexcept;
 
+        /**
+         * @copydoc UndoCommand::mergeWith()
+         *
+         * Consecutive moves of exactly the same items are merged into one command, but
+         * only if the other move was started within #sMergeIntervalMs after this move
+         * was finished (e.g. when the items are grabbed again immediately to correct
+         * the position). Moves done deliberately one after the other stay separate undo
+         * steps.
+         */
+        bool mergeWith(UndoCommand* other) noexcept override;
+
 
     private:
 
@@ -66,11 +78,21 @@ class CmdMoveSelectedBoardItems final : public UndoCommandGroup
         /// @copydoc UndoCommand::performExecute()
         bool performExecute() override;
 
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
 
         // Private Member Variables
+        static constexpr qint64 sMergeIntervalMs = 500;
         Board& mBoard;
         Point mStartPos;
         Point mDeltaPos;
+        QSet<BI_Base*> mItems;
+        qint64 mStartTimestamp;     ///< creation time in ms since epoch
+        qint64 mFinishTimestamp;    ///< execution time of the last merged move (ms)
 
         // Move commands
         QList<CmdDeviceInstanceEdit*> mDeviceEditCmds;
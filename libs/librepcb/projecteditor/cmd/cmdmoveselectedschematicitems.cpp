@@ -48,12 +48,14 @@ namespace editor {
 CmdMoveSelectedSchematicItems::CmdMoveSelectedSchematicItems(Schematic& schematic,
                                                              const Point& startPos) noexcept :
     UndoCommandGroup(tr("Move Schematic Elements")),
-    mSchematic(schematic), mStartPos(startPos), mDeltaPos(0, 0)
+    mSchematic(schematic), mStartPos(startPos), mDeltaPos(0, 0),
+    mStartTimestamp(QDateTime::currentMSecsSinceEpoch()), mFinishTimestamp(0)
 {
     // get all selected items
     QList<SI_Base*> items = mSchematic.getSelectedItems(false, true, false, true, false, false,
                                                         false, false, false, false, false);
 
+    mItems = items.toSet();
     foreach (SI_Base* item, items) {
         switch (item->getType())
         {
@@ -115,8 +117,28 @@ void CmdMoveSelectedSchematicItems::setCurrentPosition(const Point& pos) noexcep
  *  Inherited from UndoCommand
  ****************************************************************************************/
 
+bool CmdMoveSelectedSchematicItems::mergeWith(UndoCommand* other) noexcept
+{
+    CmdMoveSelectedSchematicItems* cmd = dynamic_cast<CmdMoveSelectedSchematicItems*>(other);
+    if ((!cmd) || (&cmd->mSchematic != &mSchematic) || (cmd->mItems != mItems)) {
+        return false;
+    }
+    if ((!isCurrentlyExecuted()) || (!cmd->isCurrentlyExecuted())) {
+        return false;
+    }
+    if (cmd->mStartTimestamp - mFinishTimestamp > sMergeIntervalMs) {
+        return false; // not part of the same gesture
+    }
+    mFinishTimestamp = cmd->mFinishTimestamp;
+    appendExecutedChild(cmd); // takes the ownership
+    mDeltaPos += cmd->mDeltaPos;
+    return true;
+}
+
 bool CmdMoveSelectedSchematicItems::performExecute()
 {
+    mFinishTimestamp = QDateTime::currentMSecsSinceEpoch();
+
     if (mDeltaPos.isOrigin()) {
         // no movement required --> discard all move commands
         qDeleteAll(mSymbolEditCmds);    mSymbolEditCmds.clear();
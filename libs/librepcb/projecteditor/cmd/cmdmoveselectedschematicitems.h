@@ -34,6 +34,7 @@ namespace librepcb {
 namespace project {
 
 class Schematic;
+class SI_Base;
 class CmdSymbolInstanceEdit;
 class CmdSchematicNetPointEdit;
 class CmdSchematicNetLabelEdit;
@@ -58,6 +59,17 @@ class CmdMoveSelectedSchematicItems final : public UndoCommandGroup
         // General Methods
         void setCurrentPosition(const Point& pos) noexcept;
 
+        /**
+         * @copydoc UndoCommand::mergeWith()
+         *
+         * Consecutive moves of exactly the same items are merged into one command, but
+         * only if the other move was started within #sMergeIntervalMs after this move
+         * was finished (e.g. when the items are grabbed again immediately to correct
+         * the position). Moves done deliberately one after the other stay separate undo
+         * steps.
+         */
+        bool mergeWith(UndoCommand* other) noexcept override;
+
 
     private:
 
@@ -68,9 +80,13 @@ class CmdMoveSelectedSchematicItems final : public UndoCommandGroup
 
 
         // Private Member Variables
+        static constexpr qint64 sMergeIntervalMs = 500;
         Schematic& mSchematic;
         Point mStartPos;
         Point mDeltaPos;
+        QSet<SI_Base*> mItems;
+        qint64 mStartTimestamp;     ///< creation time in ms since epoch
+        qint64 mFinishTimestamp;    ///< execution time of the last merged move (ms)
 
         // Move commands
         QList<CmdSymbolInstanceEdit*> mSymbolEditCmds;
@@ -0,0 +1,226 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdpasteschematicitems.h"
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/circuit/cmd/cmdcomponentinstanceadd.h>
+#include <librepcb/project/circuit/cmd/cmdcomponentinstanceedit.h>
+#include <librepcb/project/circuit/cmd/cmdnetsignaladd.h>
+#include <librepcb/project/circuit/cmd/cmdcompsiginstsetnetsignal.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/items/si_symbol.h>
+#include <librepcb/project/schematics/items/si_symbolpin.h>
+#include <librepcb/project/schematics/items/si_netpoint.h>
+#include <librepcb/project/schematics/items/si_netline.h>
+#include <librepcb/project/schematics/items/si_netlabel.h>
+#include <librepcb/project/schematics/cmd/cmdsymbolinstancesadd.h>
+#include <librepcb/project/schematics/cmd/cmdschematicnetpointadd.h>
+#include <librepcb/project/schematics/cmd/cmdschematicnetlineadd.h>
+#include <librepcb/project/schematics/cmd/cmdschematicnetlabeladd.h>
+#include <librepcb/project/schematics/cmd/cmdschematicnetlabeledit.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdPasteSchematicItems::CmdPasteSchematicItems(Schematic& schematic,
+        const SchematicClipboard::Data& data, const Point& offset) noexcept :
+    UndoCommandGroup(tr("Paste Schematic Elements")), mSchematic(schematic),
+    mData(data), mOffset(offset)
+{
+}
+
+CmdPasteSchematicItems::~CmdPasteSchematicItems() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdPasteSchematicItems::performExecute()
+{
+    // if an error occurs, undo all already executed child commands
+    auto undoScopeGuard = scopeGuard([&](){performUndo();});
+
+    // defer the scene index and ERC updates until all items are added
+    bool bulkUpdate = (mData.getItemCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mSchematic.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mSchematic.endBulkUpdate();});
+
+    Circuit& circuit = mSchematic.getProject().getCircuit();
+    auto invalidData = [](){
+        return RuntimeError(__FILE__, __LINE__, tr("The clipboard content is invalid."));
+    };
+
+    // add the components (with new names)
+    QHash<Uuid, ComponentInstance*> components;
+    foreach (const SchematicClipboard::Data::Component& cmp, mData.components) {
+        CmdComponentInstanceAdd* cmd = new CmdComponentInstanceAdd(circuit,
+            cmp.libComponent, cmp.symbVar);
+        execNewChildCmd(cmd); // can throw
+        ComponentInstance* newCmp = cmd->getComponentInstance(); Q_ASSERT(newCmp);
+        if (newCmp->getValue() != cmp.value) {
+            CmdComponentInstanceEdit* cmdEdit = new CmdComponentInstanceEdit(circuit, *newCmp);
+            cmdEdit->setValue(cmp.value);
+            execNewChildCmd(cmdEdit); // can throw
+        }
+        components.insert(cmp.uuid, newCmp);
+    }
+
+    // add the net signals (named nets are connected to existing nets with the same name)
+    QHash<Uuid, NetSignal*> netsignals;
+    foreach (const SchematicClipboard::Data::NetSignal& ns, mData.netSignals) {
+        NetSignal* netsignal = ns.hasAutoName ? nullptr : circuit.getNetSignalByName(ns.name);
+        if (!netsignal) {
+            NetClass* netclass = circuit.getNetClassByUuid(ns.netClass);
+            if (!netclass) {
+                throw RuntimeError(__FILE__, __LINE__,
+                    QString(tr("The net class with the UUID \"%1\" does not exist in "
+                    "this project.")).arg(ns.netClass.toStr()));
+            }
+            CmdNetSignalAdd* cmd = ns.hasAutoName ? new CmdNetSignalAdd(circuit, *netclass)
+                                                  : new CmdNetSignalAdd(circuit, *netclass, ns.name);
+            execNewChildCmd(cmd); // can throw
+            netsignal = cmd->getNetSignal(); Q_ASSERT(netsignal);
+        }
+        netsignals.insert(ns.uuid, netsignal);
+    }
+
+    // connect the component signals
+    foreach (const SchematicClipboard::Data::SignalConnection& con, mData.signalConnections) {
+        ComponentInstance* cmp = components.value(con.component);
+        ComponentSignalInstance* signal = cmp ? cmp->getSignalInstance(con.signal) : nullptr;
+        NetSignal* netsignal = netsignals.value(con.netSignal);
+        if ((!signal) || (!netsignal)) throw invalidData();
+        execNewChildCmd(new CmdCompSigInstSetNetSignal(*signal, netsignal)); // can throw
+    }
+
+    // add all symbols at once
+    QList<CmdSymbolInstancesAdd::Item> symbolItems;
+    foreach (const SchematicClipboard::Data::Symbol& symbol, mData.symbols) {
+        ComponentInstance* cmp = components.value(symbol.component);
+        if (!cmp) throw invalidData();
+        symbolItems.append(CmdSymbolInstancesAdd::Item{cmp, symbol.symbolItem,
+            symbol.position + mOffset, symbol.rotation});
+    }
+    QHash<Uuid, SI_Symbol*> symbols;
+    if (!symbolItems.isEmpty()) {
+        CmdSymbolInstancesAdd* cmd = new CmdSymbolInstancesAdd(mSchematic, symbolItems);
+        execNewChildCmd(cmd); // can throw
+        Q_ASSERT(cmd->getSymbolInstances().count() == mData.symbols.count());
+        for (int i = 0; i < mData.symbols.count(); ++i) {
+            symbols.insert(mData.symbols.at(i).uuid, cmd->getSymbolInstances().at(i));
+        }
+    }
+
+    // add netpoints
+    QHash<Uuid, SI_NetPoint*> netpoints;
+    foreach (const SchematicClipboard::Data::NetPoint& np, mData.netPoints) {
+        NetSignal* netsignal = netsignals.value(np.netSignal);
+        if (!netsignal) throw invalidData();
+        CmdSchematicNetPointAdd* cmd = nullptr;
+        if (!np.symbol.isNull()) {
+            SI_Symbol* symbol = symbols.value(np.symbol);
+            SI_SymbolPin* pin = symbol ? symbol->getPin(np.pin) : nullptr;
+            if (!pin) throw invalidData();
+            cmd = new CmdSchematicNetPointAdd(mSchematic, *netsignal, *pin);
+        } else {
+            cmd = new CmdSchematicNetPointAdd(mSchematic, *netsignal, np.position + mOffset);
+        }
+        execNewChildCmd(cmd); // can throw
+        netpoints.insert(np.uuid, cmd->getNetPoint());
+    }
+
+    // add netlines
+    QList<SI_NetLine*> netlines;
+    foreach (const SchematicClipboard::Data::NetLine& nl, mData.netLines) {
+        SI_NetPoint* start = netpoints.value(nl.startPoint);
+        SI_NetPoint* end = netpoints.value(nl.endPoint);
+        if ((!start) || (!end)) throw invalidData();
+        CmdSchematicNetLineAdd* cmd = new CmdSchematicNetLineAdd(mSchematic, *start, *end);
+        execNewChildCmd(cmd); // can throw
+        netlines.append(cmd->getNetLine());
+    }
+
+    // add netlabels
+    QList<SI_NetLabel*> netlabels;
+    foreach (const SchematicClipboard::Data::NetLabel& nl, mData.netLabels) {
+        NetSignal* netsignal = netsignals.value(nl.netSignal);
+        if (!netsignal) throw invalidData();
+        CmdSchematicNetLabelAdd* cmd = new CmdSchematicNetLabelAdd(mSchematic, *netsignal,
+                                                                   nl.position + mOffset);
+        execNewChildCmd(cmd); // can throw
+        if (nl.rotation != 0) {
+            CmdSchematicNetLabelEdit* cmdEdit = new CmdSchematicNetLabelEdit(*cmd->getNetLabel());
+            cmdEdit->setRotation(nl.rotation, false);
+            execNewChildCmd(cmdEdit); // can throw
+        }
+        netlabels.append(cmd->getNetLabel());
+    }
+
+    // select only the pasted items, so they can be moved immediately
+    mSchematic.clearSelection();
+    foreach (SI_Symbol* symbol, symbols) symbol->setSelected(true);
+    foreach (SI_NetPoint* netpoint, netpoints) netpoint->setSelected(true);
+    foreach (SI_NetLine* netline, netlines) netline->setSelected(true);
+    foreach (SI_NetLabel* netlabel, netlabels) netlabel->setSelected(true);
+
+    undoScopeGuard.dismiss(); // no undo required
+    return (getChildCount() > 0);
+}
+
+void CmdPasteSchematicItems::performUndo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mSchematic.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mSchematic.endBulkUpdate();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdPasteSchematicItems::performRedo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mSchematic.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mSchematic.endBulkUpdate();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
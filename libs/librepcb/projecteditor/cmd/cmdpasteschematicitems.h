@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CMDPASTESCHEMATICITEMS_H
+#define LIBREPCB_PROJECT_CMDPASTESCHEMATICITEMS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/undocommandgroup.h>
+#include <librepcb/common/units/all_length_units.h>
+#include "../schematiceditor/schematicclipboard.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Schematic;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class CmdPasteSchematicItems
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdPasteSchematicItems class pastes copied items into a schematic
+ *
+ * All items get new UUIDs. Copied components are added as new component instances,
+ * nets with an automatically generated name are replaced by new nets while named nets
+ * are connected to the existing net with the same name (if any). Afterwards, only the
+ * pasted items are selected.
+ */
+class CmdPasteSchematicItems final : public UndoCommandGroup
+{
+    public:
+
+        // Constructors / Destructor
+        CmdPasteSchematicItems(Schematic& schematic, const SchematicClipboard::Data& data,
+                               const Point& offset) noexcept;
+        ~CmdPasteSchematicItems() noexcept;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+
+        // Attributes from the constructor
+        Schematic& mSchematic;
+        SchematicClipboard::Data mData;
+        Point mOffset;
+
+        /// @copydoc CmdRemoveSelectedSchematicItems::sBulkUpdateMinItems
+        static constexpr int sBulkUpdateMinItems = 100;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDPASTESCHEMATICITEMS_H
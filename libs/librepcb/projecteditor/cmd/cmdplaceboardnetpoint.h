@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/undocommandgroup.h>
+#include <librepcb/common/objectpool.h>
 #include <librepcb/common/units/point.h>
 
 /*****************************************************************************************
@@ -49,7 +50,8 @@ namespace editor {
 /**
  * @brief The CmdPlaceBoardNetPoint class
  */
-class CmdPlaceBoardNetPoint final : public UndoCommandGroup
+class CmdPlaceBoardNetPoint final : public UndoCommandGroup,
+                                    public PooledObject<CmdPlaceBoardNetPoint>
 {
     public:
 
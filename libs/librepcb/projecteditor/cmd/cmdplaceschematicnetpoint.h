@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/undocommandgroup.h>
+#include <librepcb/common/objectpool.h>
 #include <librepcb/common/units/point.h>
 
 /*****************************************************************************************
@@ -47,7 +48,8 @@ namespace editor {
 /**
  * @brief The CmdPlaceSchematicNetPoint class
  */
-class CmdPlaceSchematicNetPoint final : public UndoCommandGroup
+class CmdPlaceSchematicNetPoint final : public UndoCommandGroup,
+                                        public PooledObject<CmdPlaceSchematicNetPoint>
 {
     public:
 
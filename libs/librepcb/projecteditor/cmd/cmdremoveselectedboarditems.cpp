@@ -71,6 +71,11 @@ bool CmdRemoveSelectedBoardItems::performExecute()
     // clear selection because these items will be removed now
     mBoard.clearSelection();
 
+    // defer the scene index and ERC updates until all items are processed
+    bool bulkUpdate = (items.count() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+
     // remove all netlines
     foreach (BI_Base* item, items) {
         if (item->getType() == BI_Base::Type_t::NetLine) {
@@ -110,6 +115,22 @@ bool CmdRemoveSelectedBoardItems::performExecute()
     return (getChildCount() > 0);
 }
 
+void CmdRemoveSelectedBoardItems::performUndo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdRemoveSelectedBoardItems::performRedo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
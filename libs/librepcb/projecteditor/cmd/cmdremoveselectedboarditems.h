@@ -59,9 +59,23 @@ class CmdRemoveSelectedBoardItems final : public UndoCommandGroup
         /// @copydoc UndoCommand::performExecute()
         bool performExecute() override;
 
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
 
         // Attributes from the constructor
         Board& mBoard;
+
+        /**
+         * @brief Minimum count of items to perform the changes as a bulk update
+         *
+         * For only a few items, rebuilding the whole scene index at the end (see
+         * librepcb::project::Board::beginBulkUpdate()) would take longer than it saves.
+         */
+        static constexpr int sBulkUpdateMinItems = 100;
 };
 
 /*****************************************************************************************
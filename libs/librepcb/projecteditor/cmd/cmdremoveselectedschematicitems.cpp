@@ -87,6 +87,11 @@ bool CmdRemoveSelectedSchematicItems::performExecute()
     // clear selection because these items will be removed now
     mSchematic.clearSelection();
 
+    // defer the scene index and ERC updates until all items are processed
+    bool bulkUpdate = (items.count() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mSchematic.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mSchematic.endBulkUpdate();});
+
     // remove all netlabels
     foreach (SI_Base* item, items) {
         if (item->getType() == SI_Base::Type_t::NetLabel) {
@@ -146,6 +151,22 @@ bool CmdRemoveSelectedSchematicItems::performExecute()
     return (getChildCount() > 0);
 }
 
+void CmdRemoveSelectedSchematicItems::performUndo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mSchematic.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mSchematic.endBulkUpdate();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdRemoveSelectedSchematicItems::performRedo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mSchematic.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mSchematic.endBulkUpdate();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
 void CmdRemoveSelectedSchematicItems::detachNetPointFromSymbolPin(SI_NetPoint& netpoint)
 {
     SI_SymbolPin* pin = netpoint.getSymbolPin();
@@ -61,12 +61,26 @@ class CmdRemoveSelectedSchematicItems final : public UndoCommandGroup
         /// @copydoc UndoCommand::performExecute()
         bool performExecute() override;
 
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
         void detachNetPointFromSymbolPin(SI_NetPoint& netpoint);
         void disconnectComponentSignalInstance(ComponentSignalInstance& signal);
 
 
         // Attributes from the constructor
         Schematic& mSchematic;
+
+        /**
+         * @brief Minimum count of items to perform the changes as a bulk update
+         *
+         * For only a few items, rebuilding the whole scene index at the end (see
+         * librepcb::project::Schematic::beginBulkUpdate()) would take longer than it saves.
+         */
+        static constexpr int sBulkUpdateMinItems = 100;
 };
 
 /*****************************************************************************************
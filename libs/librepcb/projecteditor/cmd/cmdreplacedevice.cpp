@@ -80,6 +80,11 @@ bool CmdReplaceDevice::performExecute()
         }
     }
 
+    // defer the scene index and ERC updates until all items are processed
+    bool bulkUpdate = (attachedNetPoints.count() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+
     // disconnect all netpoints/netlines
     QList<BI_NetLine*> attachedNetLines;
     foreach (BI_NetPoint* netpoint, attachedNetPoints) {
@@ -128,6 +133,22 @@ bool CmdReplaceDevice::performExecute()
     return (getChildCount() > 0);
 }
 
+void CmdReplaceDevice::performUndo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdReplaceDevice::performRedo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -67,6 +67,12 @@ class CmdReplaceDevice final : public UndoCommandGroup
         /// @copydoc UndoCommand::performExecute()
         bool performExecute() override;
 
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
 
         // Private Member Variables
 
@@ -76,6 +82,14 @@ class CmdReplaceDevice final : public UndoCommandGroup
         BI_Device& mDeviceInstance;
         Uuid mNewDeviceUuid;
         Uuid mNewFootprintUuid;
+
+        /**
+         * @brief Minimum count of items to perform the changes as a bulk update
+         *
+         * For only a few items, rebuilding the whole scene index at the end (see
+         * librepcb::project::Board::beginBulkUpdate()) would take longer than it saves.
+         */
+        static constexpr int sBulkUpdateMinItems = 100;
 };
 
 /*****************************************************************************************
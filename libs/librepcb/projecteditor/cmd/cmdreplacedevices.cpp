@@ -0,0 +1,199 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdreplacedevices.h"
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/cmd/cmddeviceinstanceremove.h>
+#include <librepcb/project/boards/cmd/cmdboardnetlineremove.h>
+#include <librepcb/project/boards/cmd/cmdboardnetlineadd.h>
+#include <librepcb/project/boards/cmd/cmdboardnetpointedit.h>
+#include "cmdadddevicetoboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdReplaceDevices::CmdReplaceDevices(workspace::Workspace& workspace, Board& board,
+        const Filter& filter, const Uuid& newDeviceUuid) noexcept :
+    UndoCommandGroup(tr("Change Devices")), mWorkspace(workspace), mBoard(board),
+    mFilter(filter), mNewDeviceUuid(newDeviceUuid), mReplacedDevicesCount(0)
+{
+}
+
+CmdReplaceDevices::~CmdReplaceDevices() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdReplaceDevices::performExecute()
+{
+    // if an error occurs, undo all already executed child commands
+    auto undoScopeGuard = scopeGuard([&](){performUndo();});
+
+    // determine all devices to replace and the netpoints attached to their pads
+    struct Replacement {
+        BI_Device* device;
+        QList<QPair<BI_NetPoint*, Uuid>> attachedNetPoints; // netpoint, library pad UUID
+    };
+    QList<Replacement> replacements;
+    QList<BI_NetLine*> attachedNetLines;
+    QSet<BI_NetLine*> attachedNetLinesSet;
+    int attachedNetPointsCount = 0;
+    foreach (BI_Device* device, mBoard.getDeviceInstances()) {
+        if ((device->getLibDevice().getUuid() == mNewDeviceUuid) || (!mFilter(*device))) {
+            continue;
+        }
+        Replacement replacement{device, {}};
+        foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            foreach (BI_NetPoint* netpoint, pad->getNetPoints()) {
+                replacement.attachedNetPoints.append(qMakePair(netpoint, pad->getLibPadUuid()));
+                foreach (BI_NetLine* netline, netpoint->getLines()) {
+                    if (!attachedNetLinesSet.contains(netline)) {
+                        attachedNetLinesSet.insert(netline);
+                        attachedNetLines.append(netline);
+                    }
+                }
+            }
+        }
+        attachedNetPointsCount += replacement.attachedNetPoints.count();
+        replacements.append(replacement);
+    }
+
+    // defer the scene index and ERC updates until all items are processed
+    bool bulkUpdate = (replacements.count() + attachedNetPointsCount >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+
+    // disconnect all netpoints/netlines and remove the old devices
+    foreach (BI_NetLine* netline, attachedNetLines) {
+        execNewChildCmd(new CmdBoardNetLineRemove(*netline)); // can throw
+    }
+    foreach (const Replacement& replacement, replacements) {
+        foreach (const auto& attachedNetPoint, replacement.attachedNetPoints) {
+            CmdBoardNetPointEdit* cmd = new CmdBoardNetPointEdit(*attachedNetPoint.first);
+            cmd->setPadToAttach(nullptr);
+            execNewChildCmd(cmd); // can throw
+        }
+        execNewChildCmd(new CmdDeviceInstanceRemove(mBoard, *replacement.device)); // can throw
+    }
+
+    // add the new devices and reconnect all netpoints/netlines
+    foreach (const Replacement& replacement, replacements) {
+        BI_Device& oldDevice = *replacement.device;
+        CmdAddDeviceToBoard* cmd = new CmdAddDeviceToBoard(mWorkspace, mBoard,
+                                                           oldDevice.getComponentInstance(),
+                                                           mNewDeviceUuid, Uuid(),
+                                                           oldDevice.getPosition(),
+                                                           oldDevice.getRotation(),
+                                                           oldDevice.getIsMirrored());
+        execNewChildCmd(cmd); // can throw
+        BI_Device* newDevice = cmd->getDeviceInstance();
+        Q_ASSERT(newDevice);
+        const QHash<Uuid, Uuid>& padMapping = getPadMapping(oldDevice.getLibDevice(),
+                                                            newDevice->getLibDevice());
+        foreach (const auto& attachedNetPoint, replacement.attachedNetPoints) {
+            BI_FootprintPad* newPad = newDevice->getFootprint().getPad(
+                padMapping.value(attachedNetPoint.second));
+            if (!newPad) continue; // the signal is not connected to a pad anymore
+            CmdBoardNetPointEdit* cmd = new CmdBoardNetPointEdit(*attachedNetPoint.first);
+            cmd->setPadToAttach(newPad);
+            execNewChildCmd(cmd); // can throw
+        }
+    }
+    foreach (BI_NetLine* netline, attachedNetLines) {
+        execNewChildCmd(new CmdBoardNetLineAdd(*netline)); // can throw
+    }
+
+    mReplacedDevicesCount = replacements.count();
+    undoScopeGuard.dismiss(); // no undo required
+    return (getChildCount() > 0);
+}
+
+void CmdReplaceDevices::performUndo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdReplaceDevices::performRedo()
+{
+    bool bulkUpdate = (getChildCount() >= sBulkUpdateMinItems);
+    if (bulkUpdate) mBoard.beginBulkUpdate();
+    auto bulkUpdateScopeGuard = scopeGuard([&](){if (bulkUpdate) mBoard.endBulkUpdate();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+const QHash<Uuid, Uuid>& CmdReplaceDevices::getPadMapping(const library::Device& oldDevice,
+        const library::Device& newDevice) noexcept
+{
+    QPair<Uuid, Uuid> key(oldDevice.getUuid(), newDevice.getUuid());
+    auto it = mPadMappings.find(key);
+    if (it == mPadMappings.end()) {
+        // if several pads are connected to the same signal, the first one is used
+        QHash<Uuid, Uuid> newPadsOfSignals;
+        for (const library::DevicePadSignalMapItem& item : newDevice.getPadSignalMap()) {
+            if ((!item.getSignalUuid().isNull()) && (!newPadsOfSignals.contains(item.getSignalUuid()))) {
+                newPadsOfSignals.insert(item.getSignalUuid(), item.getPadUuid());
+            }
+        }
+        QHash<Uuid, Uuid> mapping;
+        for (const library::DevicePadSignalMapItem& item : oldDevice.getPadSignalMap()) {
+            if ((!item.getSignalUuid().isNull()) && newPadsOfSignals.contains(item.getSignalUuid())) {
+                mapping.insert(item.getPadUuid(), newPadsOfSignals.value(item.getSignalUuid()));
+            }
+        }
+        it = mPadMappings.insert(key, mapping);
+    }
+    return it.value();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,140 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_CMDREPLACEDEVICES_H
+#define LIBREPCB_PROJECT_CMDREPLACEDEVICES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <functional>
+#include <librepcb/common/undocommandgroup.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace workspace {
+class Workspace;
+}
+
+namespace library {
+class Device;
+}
+
+namespace project {
+
+class Board;
+class BI_Device;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class CmdReplaceDevices
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdReplaceDevices class replaces many device instances of a board at once
+ *
+ * In contrast to executing a librepcb::project::editor::CmdReplaceDevice for every single
+ * device, the pad mapping between the old and the new device is only determined once per
+ * pair of library devices, and all changes are done in a single bulk update of the board.
+ */
+class CmdReplaceDevices final : public UndoCommandGroup
+{
+    public:
+
+        // Types
+        typedef std::function<bool(const BI_Device&)> Filter;
+
+        // Constructors / Destructor
+        CmdReplaceDevices() = delete;
+        CmdReplaceDevices(const CmdReplaceDevices& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param workspace     The workspace to copy missing library elements from
+         * @param board         The board to replace the devices of
+         * @param filter        Returns true for all device instances to replace
+         * @param newDeviceUuid The library device to use for all matching devices
+         */
+        CmdReplaceDevices(workspace::Workspace& workspace, Board& board,
+                          const Filter& filter, const Uuid& newDeviceUuid) noexcept;
+        ~CmdReplaceDevices() noexcept;
+
+        // Getters
+        int getReplacedDevicesCount() const noexcept {return mReplacedDevicesCount;}
+
+        // Operator Overloadings
+        CmdReplaceDevices& operator=(const CmdReplaceDevices& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() override;
+
+        /// @copydoc UndoCommand::performUndo()
+        void performUndo() override;
+
+        /// @copydoc UndoCommand::performRedo()
+        void performRedo() override;
+
+        /**
+         * @brief Get the mapping from the pads of an old device to the pads of a new one
+         *
+         * Pads are mapped by the component signal they are connected to. The mapping is
+         * calculated only once for each pair of library devices.
+         *
+         * @return Old footprint pad UUID --> new footprint pad UUID
+         */
+        const QHash<Uuid, Uuid>& getPadMapping(const library::Device& oldDevice,
+                                               const library::Device& newDevice) noexcept;
+
+
+        // Private Member Variables
+
+        // Attributes from the constructor
+        workspace::Workspace& mWorkspace;
+        Board& mBoard;
+        Filter mFilter;
+        Uuid mNewDeviceUuid;
+
+        int mReplacedDevicesCount;
+        QHash<QPair<Uuid, Uuid>, QHash<Uuid, Uuid>> mPadMappings; ///< see #getPadMapping()
+
+        /// @copydoc librepcb::project::editor::CmdReplaceDevice::sBulkUpdateMinItems
+        static constexpr int sBulkUpdateMinItems = 100;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDREPLACEDEVICES_H
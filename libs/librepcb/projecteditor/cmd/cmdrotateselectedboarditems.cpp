@@ -22,6 +22,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "cmdrotateselectedboarditems.h"
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/common/gridproperties.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/boards/board.h>
@@ -68,16 +69,24 @@ bool CmdRotateSelectedBoardItems::performExecute()
         return false;
     }
 
-    // find the center of all elements
+    // update the moved netlines only once at the end
+    mBoard.beginNetLineUpdateBatch();
+    auto netLineUpdateGuard = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+
+    // calculate all new positions in one pass over a flat array
+    QVector<Point> positions(items.count());
     Point center = Point(0, 0);
-    foreach (BI_Base* item, items) {
-        center += item->getPosition();
+    for (int i = 0; i < items.count(); ++i) {
+        positions[i] = items.at(i)->getPosition();
+        center += positions.at(i);
     }
     center /= items.count();
     center.mapToGrid(mBoard.getGridProperties().getInterval());
+    Point::rotateAll(positions, mAngle, center);
 
     // rotate all selected elements
-    foreach (BI_Base* item, items) {
+    for (int i = 0; i < items.count(); ++i) {
+        BI_Base* item = items.at(i);
         switch (item->getType())
         {
             case BI_Base::Type_t::Footprint: {
@@ -91,14 +100,14 @@ bool CmdRotateSelectedBoardItems::performExecute()
             case BI_Base::Type_t::Via: {
                 BI_Via* via = dynamic_cast<BI_Via*>(item); Q_ASSERT(via);
                 CmdBoardViaEdit* cmd = new CmdBoardViaEdit(*via);
-                cmd->setPosition(via->getPosition().rotated(mAngle, center), false);
+                cmd->setPosition(positions.at(i), false);
                 appendChild(cmd);
                 break;
             }
             case BI_Base::Type_t::NetPoint: {
                 BI_NetPoint* point = dynamic_cast<BI_NetPoint*>(item); Q_ASSERT(point);
                 CmdBoardNetPointEdit* cmd = new CmdBoardNetPointEdit(*point);
-                cmd->setPosition(point->getPosition().rotated(mAngle, center), false);
+                cmd->setPosition(positions.at(i), false);
                 appendChild(cmd);
                 break;
             }
@@ -113,6 +122,20 @@ bool CmdRotateSelectedBoardItems::performExecute()
     return UndoCommandGroup::performExecute(); // can throw
 }
 
+void CmdRotateSelectedBoardItems::performUndo()
+{
+    mBoard.beginNetLineUpdateBatch();
+    auto sg = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+    UndoCommandGroup::performUndo(); // can throw
+}
+
+void CmdRotateSelectedBoardItems::performRedo()
+{
+    mBoard.beginNetLineUpdateBatch();
+    auto sg = scopeGuard([this](){mBoard.endNetLineUpdateBatch();});
+    UndoCommandGroup::performRedo(); // can throw
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
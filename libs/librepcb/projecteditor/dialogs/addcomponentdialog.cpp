@@ -40,6 +40,8 @@
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/library/cat/componentcategory.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
+#include <librepcb/workspace/library/workspacelibrarythumbnails.h>
 #include <librepcb/common/gridproperties.h>
 
 /*****************************************************************************************
@@ -70,12 +72,18 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace, Project&
     connect(mUi->treeCategories->selectionModel(), &QItemSelectionModel::currentChanged,
             this, &AddComponentDialog::treeCategories_currentItemChanged);
 
+    // show the symbol thumbnails as icons, they are rendered in the background
+    mUi->listComponents->setIconSize(QSize(48, 48));
+    connect(&mWorkspace.getLibraryThumbnails(), &workspace::WorkspaceLibraryThumbnails::thumbnailReady,
+            this, &AddComponentDialog::updateThumbnail);
+
     //setSelectedCategory(Uuid());
 }
 
 AddComponentDialog::~AddComponentDialog() noexcept
 {
     qDeleteAll(mPreviewSymbolGraphicsItems);    mPreviewSymbolGraphicsItems.clear();
+    mPreviewSymbols.clear();
     mSelectedSymbVar = nullptr;
     delete mSelectedComponent;                  mSelectedComponent = nullptr;
     delete mCategoryTreeModel;                  mCategoryTreeModel = nullptr;
@@ -153,6 +161,17 @@ void AddComponentDialog::on_cbxSymbVar_currentIndexChanged(int index)
         setSelectedSymbVar(nullptr);
 }
 
+void AddComponentDialog::updateThumbnail(const Uuid& symbolUuid) noexcept
+{
+    for (int i = 0; i < mUi->listComponents->count(); ++i) {
+        QListWidgetItem* item = mUi->listComponents->item(i);
+        if (item->data(Qt::UserRole + 1).toString() == symbolUuid.toStr()) {
+            QImage thumbnail = mWorkspace.getLibraryThumbnails().getSymbolThumbnail(symbolUuid);
+            item->setIcon(QIcon(QPixmap::fromImage(thumbnail)));
+        }
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -173,10 +192,23 @@ void AddComponentDialog::setSelectedCategory(const Uuid& categoryUuid)
     {
         FilePath cmpFp = mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);
         if (!cmpFp.isValid()) continue;
-        library::Component component(cmpFp, true); // TODO: use library metadata instead of loading the whole component
+        // TODO: use library metadata instead of loading the whole component
+        auto component = mWorkspace.getLibraryElementCache().getElement<library::Component>(cmpFp);
 
-        QListWidgetItem* item = new QListWidgetItem(component.getNames().value(localeOrder));
+        QListWidgetItem* item = new QListWidgetItem(component->getNames().value(localeOrder));
         item->setData(Qt::UserRole, cmpFp.toStr());
+        // use the first symbol of the first symbol variant as icon
+        if ((component->getSymbolVariants().count() > 0) &&
+            (component->getSymbolVariants().first()->getSymbolItems().count() > 0))
+        {
+            Uuid symbolUuid = component->getSymbolVariants().first()->getSymbolItems()
+                              .first()->getSymbolUuid();
+            item->setData(Qt::UserRole + 1, symbolUuid.toStr());
+            QImage thumbnail = mWorkspace.getLibraryThumbnails().getSymbolThumbnail(symbolUuid);
+            if (!thumbnail.isNull()) {
+                item->setIcon(QIcon(QPixmap::fromImage(thumbnail)));
+            }
+        }
         mUi->listComponents->addItem(item);
     }
 }
@@ -220,6 +252,7 @@ void AddComponentDialog::setSelectedSymbVar(const library::ComponentSymbolVarian
     if (symbVar == mSelectedSymbVar) return;
     qDeleteAll(mPreviewSymbolGraphicsItems);
     mPreviewSymbolGraphicsItems.clear();
+    mPreviewSymbols.clear();
     mUi->lblSymbVarUuid->setText(QString("00000000-0000-0000-0000-000000000000"));
     mUi->lblSymbVarNorm->setText(QString("-"));
     mUi->lblSymbVarDescription->setText(QString("-"));
@@ -236,7 +269,8 @@ void AddComponentDialog::setSelectedSymbVar(const library::ComponentSymbolVarian
         for (const library::ComponentSymbolVariantItem& item : symbVar->getSymbolItems()) {
             FilePath symbolFp = mWorkspace.getLibraryDb().getLatestSymbol(item.getSymbolUuid());
             if (!symbolFp.isValid()) continue; // TODO: show warning
-            const library::Symbol* symbol = new library::Symbol(symbolFp, true); // TODO: fix memory leak...
+            auto symbol = mWorkspace.getLibraryElementCache().getElement<library::Symbol>(symbolFp);
+            mPreviewSymbols.append(symbol);
             library::SymbolPreviewGraphicsItem* graphicsItem = new library::SymbolPreviewGraphicsItem(
                 mProject.getLayers(), localeOrder, *symbol, mSelectedComponent, symbVar->getUuid(), item.getUuid());
             graphicsItem->setPos(item.getSymbolPosition().toPxQPointF());
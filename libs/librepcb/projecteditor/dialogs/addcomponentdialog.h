@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <memory>
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/exceptions.h>
@@ -92,6 +93,7 @@ class AddComponentDialog final : public QDialog
         void treeCategories_currentItemChanged(const QModelIndex& current, const QModelIndex& previous);
         void on_listComponents_currentItemChanged(QListWidgetItem *current, QListWidgetItem *previous);
         void on_cbxSymbVar_currentIndexChanged(int index);
+        void updateThumbnail(const Uuid& symbolUuid) noexcept;
 
 
     private:
@@ -116,6 +118,7 @@ class AddComponentDialog final : public QDialog
         const library::Component* mSelectedComponent;
         const library::ComponentSymbolVariant* mSelectedSymbVar;
         QList<library::SymbolPreviewGraphicsItem*> mPreviewSymbolGraphicsItems;
+        QList<std::shared_ptr<const library::Symbol>> mPreviewSymbols;
 };
 
 /*****************************************************************************************
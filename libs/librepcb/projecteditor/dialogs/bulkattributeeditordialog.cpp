@@ -0,0 +1,177 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bulkattributeeditordialog.h"
+#include "ui_bulkattributeeditordialog.h"
+#include "componentinstanceattributesmodel.h"
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/undostack.h>
+#include <librepcb/project/circuit/cmd/cmdcomponentinstancesedit.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BulkAttributeEditorDialog::BulkAttributeEditorDialog(Circuit& circuit, UndoStack& undoStack,
+                                                     QWidget* parent) noexcept :
+    QDialog(parent), mUndoStack(undoStack), mUi(new Ui::BulkAttributeEditorDialog),
+    mModel(new ComponentInstanceAttributesModel(circuit, this))
+{
+    mUi->setupUi(this);
+    mUi->tableView->setModel(mModel.data());
+    mUi->tableView->horizontalHeader()->setSectionResizeMode(
+        ComponentInstanceAttributesModel::COLUMN_NAME, QHeaderView::ResizeToContents);
+    connect(mUi->btnAddAttribute, &QPushButton::clicked,
+            this, &BulkAttributeEditorDialog::btnAddAttributeClicked);
+    connect(mUi->btnSetSelected, &QPushButton::clicked,
+            this, &BulkAttributeEditorDialog::btnSetSelectedClicked);
+    connect(mUi->edtText, &QLineEdit::returnPressed,
+            this, &BulkAttributeEditorDialog::btnSetSelectedClicked);
+    connect(mModel.data(), &ComponentInstanceAttributesModel::dataChanged,
+            this, &BulkAttributeEditorDialog::updateStatus);
+
+    QShortcut* pasteShortcut = new QShortcut(QKeySequence::Paste, mUi->tableView);
+    pasteShortcut->setContext(Qt::WidgetShortcut);
+    connect(pasteShortcut, &QShortcut::activated,
+            this, &BulkAttributeEditorDialog::pasteFromClipboard);
+
+    updateStatus();
+
+    // load the window geometry
+    QSettings clientSettings;
+    restoreGeometry(clientSettings.value("bulk_attribute_editor_dialog/window_geometry").toByteArray());
+}
+
+BulkAttributeEditorDialog::~BulkAttributeEditorDialog() noexcept
+{
+    // save the window geometry
+    QSettings clientSettings;
+    clientSettings.setValue("bulk_attribute_editor_dialog/window_geometry", saveGeometry());
+
+    mUi->tableView->setModel(nullptr);
+}
+
+/*****************************************************************************************
+ *  Inherited from QDialog
+ ****************************************************************************************/
+
+void BulkAttributeEditorDialog::accept()
+{
+    try {
+        // all modifications are applied with one command to re-substitute the texts of
+        // symbols and footprints only once per component (instead of once per cell)
+        CmdComponentInstancesEdit* cmd = mModel->createCommand();
+        if (cmd) mUndoStack.execCmd(cmd); // can throw
+        QDialog::accept();
+    } catch (const Exception& e) {
+        QMessageBox::critical(this, tr("Error"), e.getMsg());
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BulkAttributeEditorDialog::btnAddAttributeClicked() noexcept
+{
+    QString key = QInputDialog::getText(this, tr("Add Attribute"), tr("Key:"));
+    if (key.isEmpty()) return;
+
+    try {
+        int column = mModel->addAttributeColumn(key); // can throw
+        mUi->tableView->scrollTo(mModel->index(0, column));
+        mUi->tableView->selectColumn(column);
+    } catch (const Exception& e) {
+        QMessageBox::critical(this, tr("Could not add attribute"), e.getMsg());
+    }
+}
+
+void BulkAttributeEditorDialog::btnSetSelectedClicked() noexcept
+{
+    try {
+        mModel->setText(mUi->tableView->selectionModel()->selectedIndexes(),
+                        mUi->edtText->text().trimmed()); // can throw
+    } catch (const Exception& e) {
+        QMessageBox::critical(this, tr("Invalid value"), e.getMsg());
+    }
+}
+
+void BulkAttributeEditorDialog::pasteFromClipboard() noexcept
+{
+    QModelIndex start = mUi->tableView->currentIndex();
+    if (!start.isValid()) return;
+
+    // tab separated columns and newline separated rows, as copied from spreadsheets
+    QString text = QApplication::clipboard()->text();
+    if (text.endsWith('\n')) text.chop(1);
+    QStringList lines = text.split('\n');
+    QModelIndexList selection = mUi->tableView->selectionModel()->selectedIndexes();
+    QStringList errors;
+    if ((lines.count() == 1) && (!lines.first().contains('\t')) && (selection.count() > 1)) {
+        // fill all selected cells with the same value
+        try {
+            mModel->setText(selection, lines.first().trimmed()); // can throw
+        } catch (const Exception& e) {
+            errors.append(e.getMsg());
+        }
+    } else {
+        for (int i = 0; i < lines.count(); ++i) {
+            QStringList cells = lines.at(i).split('\t');
+            for (int k = 0; k < cells.count(); ++k) {
+                QModelIndex index = mModel->index(start.row() + i, start.column() + k);
+                if (!index.isValid()) continue;
+                try {
+                    mModel->setText({index}, cells.at(k).trimmed()); // can throw
+                } catch (const Exception& e) {
+                    if (!errors.contains(e.getMsg())) errors.append(e.getMsg());
+                }
+            }
+        }
+    }
+    if (!errors.isEmpty()) {
+        QMessageBox::critical(this, tr("Invalid value"), errors.join("\n"));
+    }
+}
+
+void BulkAttributeEditorDialog::updateStatus() noexcept
+{
+    mUi->lblStatus->setText(tr("%1 components, %2 modified")
+        .arg(mModel->rowCount()).arg(mModel->getModifiedRowsCount()));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
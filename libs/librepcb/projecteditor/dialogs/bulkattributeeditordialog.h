@@ -0,0 +1,102 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BULKATTRIBUTEEDITORDIALOG_H
+#define LIBREPCB_PROJECT_BULKATTRIBUTEEDITORDIALOG_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class UndoStack;
+
+namespace project {
+
+class Circuit;
+
+namespace editor {
+
+class ComponentInstanceAttributesModel;
+
+namespace Ui {
+class BulkAttributeEditorDialog;
+}
+
+/*****************************************************************************************
+ *  Class BulkAttributeEditorDialog
+ ****************************************************************************************/
+
+/**
+ * @brief The BulkAttributeEditorDialog class allows to edit the values and attributes
+ *        of all components of a circuit in a spreadsheet-like table
+ *
+ * Multiple cells can be set at once (e.g. a whole column) and tab separated text can be
+ * pasted from the clipboard. All modifications are applied with one single undo command
+ * (librepcb::project::CmdComponentInstancesEdit) when the dialog is accepted.
+ */
+class BulkAttributeEditorDialog final : public QDialog
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        BulkAttributeEditorDialog() = delete;
+        BulkAttributeEditorDialog(const BulkAttributeEditorDialog& other) = delete;
+        explicit BulkAttributeEditorDialog(Circuit& circuit, UndoStack& undoStack,
+                                           QWidget* parent = nullptr) noexcept;
+        ~BulkAttributeEditorDialog() noexcept;
+
+        // Inherited from QDialog
+        void accept() override;
+
+        // Operator Overloadings
+        BulkAttributeEditorDialog& operator=(const BulkAttributeEditorDialog& rhs) = delete;
+
+
+    private: // Methods
+        void btnAddAttributeClicked() noexcept;
+        void btnSetSelectedClicked() noexcept;
+        void pasteFromClipboard() noexcept;
+        void updateStatus() noexcept;
+
+
+    private: // Data
+        UndoStack& mUndoStack;
+        QScopedPointer<Ui::BulkAttributeEditorDialog> mUi;
+        QScopedPointer<ComponentInstanceAttributesModel> mModel;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BULKATTRIBUTEEDITORDIALOG_H
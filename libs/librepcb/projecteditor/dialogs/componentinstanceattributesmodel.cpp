@@ -0,0 +1,299 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "componentinstanceattributesmodel.h"
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/attributes/attrtypestring.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/circuit/cmd/cmdcomponentinstancesedit.h>
+#include <librepcb/library/cmp/component.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ComponentInstanceAttributesModel::ComponentInstanceAttributesModel(Circuit& circuit,
+                                                                   QObject* parent) noexcept :
+    QAbstractTableModel(parent), mCircuit(circuit), mModifiedRowsCount(0)
+{
+    QSet<QString> keys;
+    mRows.reserve(mCircuit.getComponentInstances().count());
+    foreach (ComponentInstance* cmp, mCircuit.getComponentInstances()) {
+        mRows.append(Row{cmp, cmp->getValue(), cmp->getAttributes(), false});
+        for (const Attribute& attribute : cmp->getAttributes()) {
+            keys.insert(attribute.getKey());
+        }
+    }
+    std::sort(mRows.begin(), mRows.end(), [](const Row& a, const Row& b) {
+        return QString::localeAwareCompare(a.component->getName(),
+                                           b.component->getName()) < 0;
+    });
+    mAttributeKeys = keys.toList();
+    mAttributeKeys.sort();
+}
+
+ComponentInstanceAttributesModel::~ComponentInstanceAttributesModel() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int ComponentInstanceAttributesModel::addAttributeColumn(const QString& key)
+{
+    // TODO: it's ugly to use a method from FilePath (same as AttributeListEditorWidget)...
+    QString cleanedKey = FilePath::cleanFileName(key, FilePath::ReplaceSpaces |
+                                                      FilePath::ToUpperCase);
+    if (cleanedKey.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, tr("The key must not be empty."));
+    }
+    int index = mAttributeKeys.indexOf(cleanedKey);
+    if (index < 0) {
+        index = mAttributeKeys.count();
+        int column = _COLUMN_FIRST_ATTRIBUTE + index;
+        beginInsertColumns(QModelIndex(), column, column);
+        mAttributeKeys.append(cleanedKey);
+        endInsertColumns();
+    }
+    return _COLUMN_FIRST_ATTRIBUTE + index;
+}
+
+int ComponentInstanceAttributesModel::setText(const QModelIndexList& indexes,
+                                              const QString& text)
+{
+    int count = 0;
+    QStringList errors;
+    int firstRow = mRows.count(), lastRow = -1;
+    int firstColumn = columnCount(), lastColumn = -1;
+    foreach (const QModelIndex& index, indexes) {
+        if ((!index.isValid()) || (!(flags(index) & Qt::ItemIsEditable))) continue;
+        try {
+            setCellText(index.row(), index.column(), text); // can throw
+            ++count;
+        } catch (const Exception& e) {
+            if (!errors.contains(e.getMsg())) errors.append(e.getMsg());
+        }
+        firstRow = qMin(firstRow, index.row());
+        lastRow = qMax(lastRow, index.row());
+        firstColumn = qMin(firstColumn, index.column());
+        lastColumn = qMax(lastColumn, index.column());
+    }
+    // emit only one signal for all cells, otherwise the view gets very slow
+    if ((lastRow >= 0) && (lastColumn >= 0)) {
+        emit dataChanged(index(firstRow, firstColumn), index(lastRow, lastColumn));
+        emit headerDataChanged(Qt::Vertical, firstRow, lastRow);
+    }
+    if (!errors.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, errors.join("\n"));
+    }
+    return count;
+}
+
+CmdComponentInstancesEdit* ComponentInstanceAttributesModel::createCommand() const noexcept
+{
+    if (!isModified()) return nullptr;
+    CmdComponentInstancesEdit* cmd = new CmdComponentInstancesEdit(mCircuit);
+    foreach (const Row& row, mRows) {
+        if (row.modified) {
+            cmd->setValue(*row.component, row.value);
+            cmd->setAttributes(*row.component, row.attributes);
+        }
+    }
+    return cmd;
+}
+
+/*****************************************************************************************
+ *  Inherited from QAbstractItemModel
+ ****************************************************************************************/
+
+int ComponentInstanceAttributesModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : mRows.count();
+}
+
+int ComponentInstanceAttributesModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : (_COLUMN_FIRST_ATTRIBUTE + mAttributeKeys.count());
+}
+
+QVariant ComponentInstanceAttributesModel::data(const QModelIndex& index, int role) const
+{
+    if ((!index.isValid()) || (index.row() >= mRows.count())) {
+        return QVariant();
+    }
+
+    const Row& row = mRows.at(index.row());
+    switch (index.column()) {
+        case COLUMN_NAME: {
+            if (role == Qt::DisplayRole) {
+                return row.component->getName();
+            } else if (role == Qt::ToolTipRole) {
+                return row.component->getLibComponent().getNames().getDefaultValue();
+            }
+            break;
+        }
+        case COLUMN_VALUE: {
+            if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
+                return row.value;
+            } else if (role == Qt::FontRole) {
+                QFont font;
+                font.setBold(row.value != row.component->getValue());
+                return font;
+            }
+            break;
+        }
+        default: {
+            QString key = getAttributeKey(index.column());
+            std::shared_ptr<const Attribute> attribute = row.attributes.find(key);
+            if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
+                return attribute ? attribute->getValue() : QString();
+            } else if ((role == Qt::ToolTipRole) && attribute) {
+                return QString("%1 (%2)").arg(attribute->getValueTr(true),
+                                              attribute->getType().getNameTr());
+            } else if (role == Qt::FontRole) {
+                std::shared_ptr<const Attribute> old =
+                    row.component->getAttributes().find(key);
+                bool modified = attribute ? ((!old) || (*attribute != *old)) : bool(old);
+                QFont font;
+                font.setBold(modified);
+                return font;
+            }
+            break;
+        }
+    }
+    return QVariant();
+}
+
+QVariant ComponentInstanceAttributesModel::headerData(int section,
+                                                      Qt::Orientation orientation,
+                                                      int role) const
+{
+    if (orientation == Qt::Horizontal) {
+        if (role == Qt::DisplayRole) {
+            switch (section) {
+                case COLUMN_NAME:   return tr("Name");
+                case COLUMN_VALUE:  return tr("Value");
+                default:            return getAttributeKey(section);
+            }
+        }
+    } else if ((section >= 0) && (section < mRows.count())) {
+        if (role == Qt::DisplayRole) {
+            return mRows.at(section).modified ? QString("*") : QString();
+        } else if (role == Qt::ToolTipRole) {
+            return mRows.at(section).component->getUuid().toStr();
+        }
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags ComponentInstanceAttributesModel::flags(const QModelIndex& index) const
+{
+    Qt::ItemFlags f = QAbstractTableModel::flags(index);
+    return (index.column() == COLUMN_NAME) ? f : (f | Qt::ItemIsEditable);
+}
+
+bool ComponentInstanceAttributesModel::setData(const QModelIndex& index,
+                                               const QVariant& value, int role)
+{
+    if ((!index.isValid()) || (index.row() >= mRows.count()) ||
+        (index.column() == COLUMN_NAME) || (role != Qt::EditRole)) {
+        return false;
+    }
+    try {
+        setCellText(index.row(), index.column(), value.toString()); // can throw
+        emit dataChanged(index, index);
+        emit headerDataChanged(Qt::Vertical, index.row(), index.row());
+        return true;
+    } catch (const Exception& e) {
+        QMessageBox::critical(qobject_cast<QWidget*>(QObject::parent()),
+                              tr("Invalid value"), e.getMsg());
+        return false;
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void ComponentInstanceAttributesModel::setCellText(int row, int column, const QString& text)
+{
+    Row& r = mRows[row];
+    if (column == COLUMN_VALUE) {
+        r.value = text;
+    } else {
+        QString key = getAttributeKey(column);
+        std::shared_ptr<Attribute> attribute = r.attributes.find(key);
+        if (text.isEmpty()) {
+            // an empty cell means that the component does not have this attribute
+            r.attributes.remove(key);
+        } else if (attribute) {
+            if (!attribute->getType().isValueValid(text)) {
+                throw RuntimeError(__FILE__, __LINE__,
+                    QString(tr("The value \"%1\" is invalid for the attribute \"%2\"."))
+                    .arg(text, key));
+            }
+            attribute->setTypeValueUnit(attribute->getType(), text,
+                                        attribute->getUnit()); // can throw
+        } else {
+            const AttributeType& type = AttrTypeString::instance();
+            r.attributes.append(std::make_shared<Attribute>(
+                key, type, text, type.getDefaultUnit())); // can throw
+        }
+    }
+    updateModifiedFlag(r);
+}
+
+void ComponentInstanceAttributesModel::updateModifiedFlag(Row& row) noexcept
+{
+    bool modified = (row.value != row.component->getValue()) ||
+                    (row.attributes != row.component->getAttributes());
+    if (modified != row.modified) {
+        row.modified = modified;
+        mModifiedRowsCount += modified ? 1 : -1;
+    }
+}
+
+QString ComponentInstanceAttributesModel::getAttributeKey(int column) const noexcept
+{
+    return mAttributeKeys.value(column - _COLUMN_FIRST_ATTRIBUTE);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
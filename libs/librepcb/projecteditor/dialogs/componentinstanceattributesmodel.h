@@ -0,0 +1,160 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_COMPONENTINSTANCEATTRIBUTESMODEL_H
+#define LIBREPCB_PROJECT_COMPONENTINSTANCEATTRIBUTESMODEL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcb/common/attributes/attribute.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Circuit;
+class ComponentInstance;
+class CmdComponentInstancesEdit;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class ComponentInstanceAttributesModel
+ ****************************************************************************************/
+
+/**
+ * @brief The ComponentInstanceAttributesModel class is a spreadsheet-like table model
+ *        for the values and attributes of all component instances of a circuit
+ *
+ * Every row represents a component (sorted by name), the columns contain the name
+ * (read-only), the value and one column per attribute key used by any component. An
+ * empty cell means that the component does not have this attribute.
+ *
+ * Modifications are not applied to the circuit immediately, but are collected in the
+ * model. Call #createCommand() to get all of them as one single undo command.
+ */
+class ComponentInstanceAttributesModel final : public QAbstractTableModel
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        enum Column {
+            COLUMN_NAME = 0,
+            COLUMN_VALUE,
+            _COLUMN_FIRST_ATTRIBUTE ///< all following columns are attributes
+        };
+
+        // Constructors / Destructor
+        ComponentInstanceAttributesModel() = delete;
+        ComponentInstanceAttributesModel(const ComponentInstanceAttributesModel& other) = delete;
+        ComponentInstanceAttributesModel(Circuit& circuit, QObject* parent = nullptr) noexcept;
+        ~ComponentInstanceAttributesModel() noexcept;
+
+        // Getters
+        bool isModified() const noexcept {return (mModifiedRowsCount > 0);}
+        int getModifiedRowsCount() const noexcept {return mModifiedRowsCount;}
+
+        // General Methods
+
+        /**
+         * @brief Add a column for a new attribute key
+         *
+         * @param key   The attribute key (must not be empty)
+         *
+         * @return The column of the attribute (also if it already existed)
+         *
+         * @throw Exception If the key is invalid
+         */
+        int addAttributeColumn(const QString& key);
+
+        /**
+         * @brief Set the same text to multiple cells (e.g. all selected cells)
+         *
+         * Cells which cannot be modified (e.g. the name column) are ignored.
+         *
+         * @param indexes   The cells to modify
+         * @param text      The new (translated) value of the cells
+         *
+         * @return The count of modified cells
+         *
+         * @throw Exception If the text is not a valid value for at least one cell (the
+         *                  valid cells are modified anyway)
+         */
+        int setText(const QModelIndexList& indexes, const QString& text);
+
+        /**
+         * @brief Create an undo command for all modifications made in this model
+         *
+         * @return The command (nullptr if there are no modifications)
+         */
+        CmdComponentInstancesEdit* createCommand() const noexcept;
+
+        // Inherited from QAbstractItemModel
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant headerData(int section, Qt::Orientation orientation,
+                            int role = Qt::DisplayRole) const override;
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        bool setData(const QModelIndex& index, const QVariant& value,
+                     int role = Qt::EditRole) override;
+
+        // Operator Overloadings
+        ComponentInstanceAttributesModel& operator=(const ComponentInstanceAttributesModel& rhs) = delete;
+
+
+    private: // Types
+        struct Row {
+            ComponentInstance* component;
+            QString value;
+            AttributeList attributes;
+            bool modified;
+        };
+
+
+    private: // Methods
+        void setCellText(int row, int column, const QString& text);
+        void updateModifiedFlag(Row& row) noexcept;
+        QString getAttributeKey(int column) const noexcept;
+
+
+    private: // Data
+        Circuit& mCircuit;
+        QList<Row> mRows;               ///< sorted by component name
+        QStringList mAttributeKeys;     ///< the keys of the attribute columns
+        int mModifiedRowsCount;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_COMPONENTINSTANCEATTRIBUTESMODEL_H
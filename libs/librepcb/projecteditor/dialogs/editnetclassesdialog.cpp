@@ -58,12 +58,7 @@ EditNetClassesDialog::EditNetClassesDialog(Circuit& circuit, UndoStack& undoStac
     mUi->tableWidget->setRowCount(mCircuit.getNetClasses().count());
     foreach (NetClass* netclass, mCircuit.getNetClasses())
     {
-        QTableWidgetItem* uuid = new QTableWidgetItem(netclass->getUuid().toStr());
-        QTableWidgetItem* name = new QTableWidgetItem(netclass->getName());
-        uuid->setData(Qt::UserRole, qVariantFromValue(static_cast<void*>(netclass)));
-        name->setData(Qt::UserRole, qVariantFromValue(static_cast<void*>(netclass)));
-        mUi->tableWidget->setVerticalHeaderItem(row, uuid);
-        mUi->tableWidget->setItem(row, 0, name);
+        setRow(row, *netclass);
         row++;
     }
 
@@ -114,6 +109,46 @@ void EditNetClassesDialog::on_tableWidget_itemChanged(QTableWidgetItem *item)
             break;
         }
 
+        case 1: // design rules changed (empty = use the rules of the board)
+        case 2:
+        case 3:
+        case 4:
+        {
+            NetClass* netclass = static_cast<NetClass*>(item->data(Qt::UserRole).value<void*>());
+            if (!netclass) break;
+            const Length* oldRule = nullptr;
+            switch (item->column()) {
+                case 1: oldRule = &netclass->getTraceWidth(); break;
+                case 2: oldRule = &netclass->getClearance(); break;
+                case 3: oldRule = &netclass->getViaSize(); break;
+                default: oldRule = &netclass->getViaDrillDiameter(); break;
+            }
+            if (item->text() == ruleToString(*oldRule)) break;
+            try
+            {
+                QString text = item->text().trimmed();
+                Length rule = text.isEmpty() ? Length(0) : Length::fromMm(text); // can throw
+                if (rule < 0) {
+                    throw RuntimeError(__FILE__, __LINE__,
+                        tr("The value must not be negative."));
+                }
+                auto cmd = new CmdNetClassEdit(mCircuit, *netclass);
+                switch (item->column()) {
+                    case 1: cmd->setTraceWidth(rule); break;
+                    case 2: cmd->setClearance(rule); break;
+                    case 3: cmd->setViaSize(rule); break;
+                    default: cmd->setViaDrillDiameter(rule); break;
+                }
+                mUndoStack.appendToCmdGroup(cmd);
+            }
+            catch (Exception& e)
+            {
+                QMessageBox::critical(this, tr("Could not change netclass rule"), e.getMsg());
+            }
+            item->setText(ruleToString(*oldRule));
+            break;
+        }
+
         default:
             break;
     }
@@ -129,11 +164,7 @@ void EditNetClassesDialog::on_btnAdd_clicked()
 
         int row = mUi->tableWidget->rowCount();
         mUi->tableWidget->insertRow(row);
-        QTableWidgetItem* uuid = new QTableWidgetItem(cmd->getNetClass()->getUuid().toStr());
-        QTableWidgetItem* name = new QTableWidgetItem(cmd->getNetClass()->getName());
-        name->setData(Qt::UserRole, qVariantFromValue(static_cast<void*>(cmd->getNetClass())));
-        mUi->tableWidget->setVerticalHeaderItem(row, uuid);
-        mUi->tableWidget->setItem(row, 0, name);
+        setRow(row, *cmd->getNetClass());
     }
     catch (Exception& e)
     {
@@ -161,6 +192,34 @@ void EditNetClassesDialog::on_btnRemove_clicked()
     }
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void EditNetClassesDialog::setRow(int row, NetClass& netclass) noexcept
+{
+    QVariant data = qVariantFromValue(static_cast<void*>(&netclass));
+    QTableWidgetItem* uuid = new QTableWidgetItem(netclass.getUuid().toStr());
+    uuid->setData(Qt::UserRole, data);
+    mUi->tableWidget->setVerticalHeaderItem(row, uuid);
+    QList<QTableWidgetItem*> items = {
+        new QTableWidgetItem(netclass.getName()),
+        new QTableWidgetItem(ruleToString(netclass.getTraceWidth())),
+        new QTableWidgetItem(ruleToString(netclass.getClearance())),
+        new QTableWidgetItem(ruleToString(netclass.getViaSize())),
+        new QTableWidgetItem(ruleToString(netclass.getViaDrillDiameter())),
+    };
+    for (int column = 0; column < items.count(); ++column) {
+        items.at(column)->setData(Qt::UserRole, data);
+        mUi->tableWidget->setItem(row, column, items.at(column));
+    }
+}
+
+QString EditNetClassesDialog::ruleToString(const Length& rule) noexcept
+{
+    return (rule > 0) ? QString::number(rule.toMm()) : QString();
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/units/length.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -37,6 +38,7 @@ class UndoStack;
 namespace project {
 
 class Circuit;
+class NetClass;
 
 namespace editor {
 
@@ -80,6 +82,10 @@ class EditNetClassesDialog final : public QDialog
         EditNetClassesDialog(const EditNetClassesDialog& other);
         EditNetClassesDialog& operator=(const EditNetClassesDialog& rhs);
 
+        // Private Methods
+        void setRow(int row, NetClass& netclass) noexcept;
+        static QString ruleToString(const Length& rule) noexcept;
+
         // General Attributes
         Circuit& mCircuit;
         Ui::EditNetClassesDialog* mUi;
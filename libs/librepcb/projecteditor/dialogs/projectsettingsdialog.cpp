@@ -208,6 +208,9 @@ bool ProjectSettingsDialog::applySettings() noexcept
             norms.append(mUi->lstNormOrder->item(i)->text());
         cmd->setNormOrder(norms);
 
+        // file format
+        cmd->setCompressFiles(mUi->cbxCompressFiles->isChecked());
+
         // execute cmd
         mUndoStack.execCmd(cmd);
         return true;
@@ -251,6 +254,9 @@ void ProjectSettingsDialog::updateGuiFromSettings() noexcept
     // norms
     mUi->lstNormOrder->clear();
     mUi->lstNormOrder->addItems(mSettings.getNormOrder());
+
+    // file format
+    mUi->cbxCompressFiles->setChecked(mSettings.getCompressFiles());
 }
 
 /*****************************************************************************************
@@ -24,10 +24,9 @@
 #include <QtWidgets>
 #include "ercmsgdock.h"
 #include "ui_ercmsgdock.h"
+#include "ercmsglistmodel.h"
 #include <librepcb/project/project.h>
-#include <librepcb/project/circuit/circuit.h>
 #include <librepcb/project/erc/ercmsg.h>
-#include <librepcb/project/erc/ercmsglist.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -41,75 +40,23 @@ namespace editor {
  ****************************************************************************************/
 
 ErcMsgDock::ErcMsgDock(Project& project) :
-    QDockWidget(0), mProject(project), mErcMsgList(project.getErcMsgList()),
-    mUi(new Ui::ErcMsgDock)
+    QDockWidget(0), mProject(project), mUi(new Ui::ErcMsgDock),
+    mModel(new ErcMsgListModel(project.getErcMsgList()))
 {
     mUi->setupUi(this);
+    mUi->treeView->setModel(mModel.data());
 
-    // add top-level items
-    mTopLevelItems.insert(static_cast<int>(ErcMsg::ErcMsgType_t::CircuitError),
-                          new QTreeWidgetItem(mUi->treeWidget));
-    mTopLevelItems.insert(static_cast<int>(ErcMsg::ErcMsgType_t::CircuitWarning),
-                          new QTreeWidgetItem(mUi->treeWidget));
-    mTopLevelItems.insert(static_cast<int>(ErcMsg::ErcMsgType_t::SchematicError),
-                          new QTreeWidgetItem(mUi->treeWidget));
-    mTopLevelItems.insert(static_cast<int>(ErcMsg::ErcMsgType_t::SchematicWarning),
-                          new QTreeWidgetItem(mUi->treeWidget));
-    mTopLevelItems.insert(static_cast<int>(ErcMsg::ErcMsgType_t::BoardError),
-                          new QTreeWidgetItem(mUi->treeWidget));
-    mTopLevelItems.insert(static_cast<int>(ErcMsg::ErcMsgType_t::BoardWarning),
-                          new QTreeWidgetItem(mUi->treeWidget));
-    mTopLevelItems.insert(static_cast<int>(ErcMsg::ErcMsgType_t::_Count),
-                          new QTreeWidgetItem(mUi->treeWidget));
-
-    // check if there is a top level item for each existing ERC message type + one for ignored items
-    Q_ASSERT(mTopLevelItems.count() == static_cast<int>(ErcMsg::ErcMsgType_t::_Count) + 1);
-
-    // set icons
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitError)]->
-            setIcon(0, QIcon(":/img/status/dialog_error.png"));
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitWarning)]->
-            setIcon(0, QIcon(":/img/status/dialog_warning.png"));
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicError)]->
-            setIcon(0, QIcon(":/img/status/dialog_error.png"));
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicWarning)]->
-            setIcon(0, QIcon(":/img/status/dialog_warning.png"));
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::BoardError)]->
-            setIcon(0, QIcon(":/img/status/dialog_error.png"));
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::BoardWarning)]->
-            setIcon(0, QIcon(":/img/status/dialog_warning.png"));
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::_Count)]->
-            setIcon(0, QIcon(":/img/actions/apply.png"));
-
-    // expand top-level items
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitError)]->setExpanded(true);
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitWarning)]->setExpanded(true);
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicError)]->setExpanded(true);
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicWarning)]->setExpanded(true);
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::BoardError)]->setExpanded(true);
-    mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::BoardWarning)]->setExpanded(true);
-
-    // add all already existing ERC messages
-    foreach (ErcMsg* ercMsg, mProject.getErcMsgList().getItems())
-    {
-        QTreeWidgetItem* parent;
-        if (!ercMsg->isIgnored())
-            parent = mTopLevelItems.value(static_cast<int>(ercMsg->getMsgType()), 0);
-        else
-            parent = mTopLevelItems.value(static_cast<int>(ErcMsg::ErcMsgType_t::_Count), 0);
-        Q_ASSERT(parent); if (!parent) continue;
-        QTreeWidgetItem* child = new QTreeWidgetItem(parent, QStringList(ercMsg->getMsg()));
-        child->setData(0, Qt::UserRole, QVariant::fromValue(reinterpret_cast<void*>(ercMsg))); // ugly...
-        child->setToolTip(0, ercMsg->getMsg());
-        mErcMsgItems.insert(ercMsg, child);
+    // expand all categories except the ignored messages (which is the last one)
+    for (int i = 0; i < mModel->rowCount() - 1; ++i) {
+        mUi->treeView->setExpanded(mModel->index(i, 0), true);
     }
 
-    // connect to ErcMsgList signals
-    connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgAdded,    this, &ErcMsgDock::ercMsgAdded);
-    connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgRemoved,  this, &ErcMsgDock::ercMsgRemoved);
-    connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgChanged,  this, &ErcMsgDock::ercMsgChanged);
+    connect(mUi->treeView->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &ErcMsgDock::treeViewSelectionChanged);
+    connect(mModel.data(), &ErcMsgListModel::messageCountsChanged,
+            this, &ErcMsgDock::updateWindowTitle);
 
-    updateTopLevelItemTexts();
+    updateWindowTitle();
 }
 
 ErcMsgDock::~ErcMsgDock()
@@ -117,53 +64,18 @@ ErcMsgDock::~ErcMsgDock()
     delete mUi;         mUi = 0;
 }
 
-/*****************************************************************************************
- *  Public Slots
- ****************************************************************************************/
-
-void ErcMsgDock::ercMsgAdded(ErcMsg* ercMsg) noexcept
-{
-    QTreeWidgetItem* parent;
-    Q_ASSERT(ercMsg);
-    Q_ASSERT(!mErcMsgItems.contains(ercMsg));
-    if (!ercMsg->isIgnored())
-        parent = mTopLevelItems.value(static_cast<int>(ercMsg->getMsgType()), 0);
-    else
-        parent = mTopLevelItems.value(static_cast<int>(ErcMsg::ErcMsgType_t::_Count), 0);
-    Q_ASSERT(parent); if (!parent) return;
-    QTreeWidgetItem* child = new QTreeWidgetItem(parent, QStringList(ercMsg->getMsg()));
-    child->setToolTip(0, ercMsg->getMsg());
-    parent->sortChildren(0, Qt::AscendingOrder);
-    mErcMsgItems.insert(ercMsg, child);
-    updateTopLevelItemTexts();
-}
-
-void ErcMsgDock::ercMsgRemoved(ErcMsg* ercMsg) noexcept
-{
-    Q_ASSERT(ercMsg);
-    Q_ASSERT(mErcMsgItems.contains(ercMsg));
-    delete mErcMsgItems.take(ercMsg);
-    updateTopLevelItemTexts();
-}
-
-void ErcMsgDock::ercMsgChanged(ErcMsg* ercMsg) noexcept
-{
-    ercMsgRemoved(ercMsg);
-    ercMsgAdded(ercMsg);
-}
-
 /*****************************************************************************************
  *  GUI Actions
  ****************************************************************************************/
 
-void ErcMsgDock::on_treeWidget_itemSelectionChanged()
+void ErcMsgDock::treeViewSelectionChanged()
 {
     bool allDisplayed = true;
     bool allIgnored = true;
 
-    foreach (QTreeWidgetItem* item, mUi->treeWidget->selectedItems())
+    foreach (const QModelIndex& index, mUi->treeView->selectionModel()->selectedIndexes())
     {
-        ErcMsg* ercMsg = mErcMsgItems.key(item, nullptr);
+        ErcMsg* ercMsg = mModel->getMessage(index);
         if (!ercMsg)
         {
             allDisplayed = false;
@@ -182,9 +94,9 @@ void ErcMsgDock::on_treeWidget_itemSelectionChanged()
 
 void ErcMsgDock::on_btnIgnore_clicked(bool checked)
 {
-    foreach (QTreeWidgetItem* item, mUi->treeWidget->selectedItems())
+    foreach (const QModelIndex& index, mUi->treeView->selectionModel()->selectedIndexes())
     {
-        ErcMsg* ercMsg = mErcMsgItems.key(item, nullptr);
+        ErcMsg* ercMsg = mModel->getMessage(index);
         if (!ercMsg) continue;
         ercMsg->setIgnored(checked);
         // TODO: set "project modified" flag
@@ -195,32 +107,9 @@ void ErcMsgDock::on_btnIgnore_clicked(bool checked)
  *  Private Methods
  ****************************************************************************************/
 
-void ErcMsgDock::updateTopLevelItemTexts() noexcept
+void ErcMsgDock::updateWindowTitle() noexcept
 {
-    int countOfNonIgnoredErcMessages = 0;
-    QTreeWidgetItem* item;
-    item = mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitError)];
-    item->setText(0, QString(tr("Circuit Errors (%1)")).arg(item->childCount()));
-    countOfNonIgnoredErcMessages += item->childCount();
-    item = mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitWarning)];
-    item->setText(0, QString(tr("Circuit Warnings (%1)")).arg(item->childCount()));
-    countOfNonIgnoredErcMessages += item->childCount();
-    item = mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicError)];
-    item->setText(0, QString(tr("Schematic Errors (%1)")).arg(item->childCount()));
-    countOfNonIgnoredErcMessages += item->childCount();
-    item = mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicWarning)];
-    item->setText(0, QString(tr("Schematic Warnings (%1)")).arg(item->childCount()));
-    countOfNonIgnoredErcMessages += item->childCount();
-    item = mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::BoardError)];
-    item->setText(0, QString(tr("Board Errors (%1)")).arg(item->childCount()));
-    countOfNonIgnoredErcMessages += item->childCount();
-    item = mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::BoardWarning)];
-    item->setText(0, QString(tr("Board Warnings (%1)")).arg(item->childCount()));
-    countOfNonIgnoredErcMessages += item->childCount();
-    item = mTopLevelItems[static_cast<int>(ErcMsg::ErcMsgType_t::_Count)];
-    item->setText(0, QString(tr("Ignored (%1)")).arg(item->childCount()));
-
-    setWindowTitle(QString(tr("ERC [%1]")).arg(countOfNonIgnoredErcMessages));
+    setWindowTitle(QString(tr("ERC [%1]")).arg(mModel->getNonIgnoredCount()));
 }
 
 /*****************************************************************************************
@@ -34,10 +34,11 @@ namespace project {
 
 class Project;
 class ErcMsg;
-class ErcMsgList;
 
 namespace editor {
 
+class ErcMsgListModel;
+
 namespace Ui {
 class ErcMsgDock;
 }
@@ -60,24 +61,17 @@ class ErcMsgDock final : public QDockWidget
         ~ErcMsgDock();
 
 
-    public slots:
-
-        void ercMsgAdded(ErcMsg* ercMsg) noexcept;
-        void ercMsgRemoved(ErcMsg* ercMsg) noexcept;
-        void ercMsgChanged(ErcMsg* ercMsg) noexcept;
-
-
     private slots:
 
         // GUI Actions
-        void on_treeWidget_itemSelectionChanged();
+        void treeViewSelectionChanged();
         void on_btnIgnore_clicked(bool checked);
 
 
     private:
 
         // Private Methods
-        void updateTopLevelItemTexts() noexcept;
+        void updateWindowTitle() noexcept;
 
         // make some methods inaccessible...
         ErcMsgDock();
@@ -86,10 +80,8 @@ class ErcMsgDock final : public QDockWidget
 
         // General
         Project& mProject;
-        ErcMsgList& mErcMsgList;
         Ui::ErcMsgDock* mUi;
-        QHash<int, QTreeWidgetItem*> mTopLevelItems;
-        QHash<ErcMsg*, QTreeWidgetItem*> mErcMsgItems;
+        QScopedPointer<ErcMsgListModel> mModel;
 };
 
 /*****************************************************************************************
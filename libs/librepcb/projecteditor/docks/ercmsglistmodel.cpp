@@ -0,0 +1,246 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <algorithm>
+#include "ercmsglistmodel.h"
+#include <librepcb/project/erc/ercmsg.h>
+#include <librepcb/project/erc/ercmsglist.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ErcMsgListModel::ErcMsgListModel(ErcMsgList& list, QObject* parent) noexcept :
+    QAbstractItemModel(parent)
+{
+    // one category for each existing ERC message type + one for ignored messages
+    int count = static_cast<int>(ErcMsg::ErcMsgType_t::_Count) + 1;
+    mCategories.resize(count);
+    mCategoryTitles.resize(count);
+    mCategoryIcons.resize(count);
+    mCategoryTitles[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitError)] = tr("Circuit Errors (%1)");
+    mCategoryTitles[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitWarning)] = tr("Circuit Warnings (%1)");
+    mCategoryTitles[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicError)] = tr("Schematic Errors (%1)");
+    mCategoryTitles[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicWarning)] = tr("Schematic Warnings (%1)");
+    mCategoryTitles[static_cast<int>(ErcMsg::ErcMsgType_t::BoardError)] = tr("Board Errors (%1)");
+    mCategoryTitles[static_cast<int>(ErcMsg::ErcMsgType_t::BoardWarning)] = tr("Board Warnings (%1)");
+    mCategoryTitles[static_cast<int>(ErcMsg::ErcMsgType_t::_Count)] = tr("Ignored (%1)");
+    mCategoryIcons[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitError)] = QIcon(":/img/status/dialog_error.png");
+    mCategoryIcons[static_cast<int>(ErcMsg::ErcMsgType_t::CircuitWarning)] = QIcon(":/img/status/dialog_warning.png");
+    mCategoryIcons[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicError)] = QIcon(":/img/status/dialog_error.png");
+    mCategoryIcons[static_cast<int>(ErcMsg::ErcMsgType_t::SchematicWarning)] = QIcon(":/img/status/dialog_warning.png");
+    mCategoryIcons[static_cast<int>(ErcMsg::ErcMsgType_t::BoardError)] = QIcon(":/img/status/dialog_error.png");
+    mCategoryIcons[static_cast<int>(ErcMsg::ErcMsgType_t::BoardWarning)] = QIcon(":/img/status/dialog_warning.png");
+    mCategoryIcons[static_cast<int>(ErcMsg::ErcMsgType_t::_Count)] = QIcon(":/img/actions/apply.png");
+
+    // add all already existing ERC messages (sorted once instead of inserted one by one)
+    foreach (ErcMsg* msg, list.getItems()) {
+        int category = getCategory(*msg);
+        mCategories[category].append(Entry{msg->getMsg(), msg});
+        mEntryKeys.insert(msg, qMakePair(category, msg->getMsg()));
+    }
+    for (QList<Entry>& entries : mCategories) {
+        std::sort(entries.begin(), entries.end());
+    }
+
+    connect(&list, &ErcMsgList::ercMsgsChanged, this, &ErcMsgListModel::ercMsgsChanged);
+}
+
+ErcMsgListModel::~ErcMsgListModel() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+ErcMsg* ErcMsgListModel::getMessage(const QModelIndex& index) const noexcept
+{
+    if ((!index.isValid()) || (index.internalId() == 0)) return nullptr;
+    const QList<Entry>& entries = mCategories.at(static_cast<int>(index.internalId()) - 1);
+    return (index.row() < entries.count()) ? entries.at(index.row()).msg : nullptr;
+}
+
+int ErcMsgListModel::getNonIgnoredCount() const noexcept
+{
+    int count = 0;
+    for (int i = 0; i < static_cast<int>(ErcMsg::ErcMsgType_t::_Count); ++i) {
+        count += mCategories.at(i).count();
+    }
+    return count;
+}
+
+/*****************************************************************************************
+ *  Inherited from QAbstractItemModel
+ ****************************************************************************************/
+
+int ErcMsgListModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return 1;
+}
+
+int ErcMsgListModel::rowCount(const QModelIndex& parent) const
+{
+    if (!parent.isValid()) {
+        return mCategories.count();
+    } else if (parent.internalId() == 0) {
+        return mCategories.at(parent.row()).count();
+    } else {
+        return 0; // messages have no children
+    }
+}
+
+QModelIndex ErcMsgListModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent)) {
+        return QModelIndex();
+    } else if (!parent.isValid()) {
+        return createIndex(row, column, quintptr(0));
+    } else {
+        // the internal ID of a message row is the index of its category + 1
+        return createIndex(row, column, quintptr(parent.row() + 1));
+    }
+}
+
+QModelIndex ErcMsgListModel::parent(const QModelIndex& index) const
+{
+    if ((!index.isValid()) || (index.internalId() == 0)) {
+        return QModelIndex();
+    } else {
+        return createIndex(static_cast<int>(index.internalId()) - 1, 0, quintptr(0));
+    }
+}
+
+QVariant ErcMsgListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) return QVariant();
+
+    if (index.internalId() == 0) {
+        switch (role) {
+            case Qt::DisplayRole:
+                return mCategoryTitles.at(index.row()).arg(mCategories.at(index.row()).count());
+            case Qt::DecorationRole:
+                return mCategoryIcons.at(index.row());
+            default:
+                return QVariant();
+        }
+    } else {
+        const QList<Entry>& entries = mCategories.at(static_cast<int>(index.internalId()) - 1);
+        if (index.row() >= entries.count()) return QVariant();
+        switch (role) {
+            case Qt::DisplayRole:
+            case Qt::ToolTipRole:
+                return entries.at(index.row()).text;
+            default:
+                return QVariant();
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void ErcMsgListModel::ercMsgsChanged(const QList<ErcMsg*>& added,
+                                     const QList<ErcMsg*>& removed,
+                                     const QList<ErcMsg*>& changed) noexcept
+{
+    // Note: removed messages may already be deleted, only use them as keys!
+    foreach (ErcMsg* msg, removed) {
+        removeMessage(msg);
+    }
+    foreach (ErcMsg* msg, changed) {
+        removeMessage(msg);
+        insertMessage(msg);
+    }
+    foreach (ErcMsg* msg, added) {
+        // messages which already existed when this model was created may be reported again
+        if (!mEntryKeys.contains(msg)) {
+            insertMessage(msg);
+        }
+    }
+
+    // update the counts in the category rows only once
+    emit dataChanged(index(0, 0), index(mCategories.count() - 1, 0));
+    emit messageCountsChanged();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+int ErcMsgListModel::getCategory(const ErcMsg& msg) const noexcept
+{
+    if (msg.isIgnored()) {
+        return static_cast<int>(ErcMsg::ErcMsgType_t::_Count);
+    } else {
+        return static_cast<int>(msg.getMsgType());
+    }
+}
+
+void ErcMsgListModel::insertMessage(ErcMsg* msg) noexcept
+{
+    Q_ASSERT(msg && (!mEntryKeys.contains(msg)));
+    int category = getCategory(*msg);
+    QList<Entry>& entries = mCategories[category];
+    Entry entry{msg->getMsg(), msg};
+    int row = std::lower_bound(entries.begin(), entries.end(), entry) - entries.begin();
+    beginInsertRows(index(category, 0), row, row);
+    entries.insert(row, entry);
+    mEntryKeys.insert(msg, qMakePair(category, entry.text));
+    endInsertRows();
+}
+
+void ErcMsgListModel::removeMessage(ErcMsg* msg) noexcept
+{
+    auto it = mEntryKeys.find(msg);
+    if (it == mEntryKeys.end()) return;
+    int category = it.value().first;
+    QList<Entry>& entries = mCategories[category];
+    Entry entry{it.value().second, msg};
+    auto entryIt = std::lower_bound(entries.begin(), entries.end(), entry);
+    Q_ASSERT((entryIt != entries.end()) && (entryIt->msg == msg));
+    if ((entryIt == entries.end()) || (entryIt->msg != msg)) return;
+    int row = entryIt - entries.begin();
+    beginRemoveRows(index(category, 0), row, row);
+    entries.removeAt(row);
+    mEntryKeys.erase(it);
+    endRemoveRows();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,135 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_ERCMSGLISTMODEL_H
+#define LIBREPCB_PROJECT_ERCMSGLISTMODEL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <functional>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class ErcMsg;
+class ErcMsgList;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class ErcMsgListModel
+ ****************************************************************************************/
+
+/**
+ * @brief The ErcMsgListModel class provides the messages of an ErcMsgList as a tree
+ *
+ * The top-level rows are the message categories (one per message type and one for all
+ * ignored messages), their children are the messages sorted by their text. The model is
+ * updated incrementally with the batches reported by librepcb::project::ErcMsgList::
+ * ercMsgsChanged(), i.e. only the added, removed and changed rows are touched.
+ */
+class ErcMsgListModel final : public QAbstractItemModel
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        ErcMsgListModel() = delete;
+        ErcMsgListModel(const ErcMsgListModel& other) = delete;
+        explicit ErcMsgListModel(ErcMsgList& list, QObject* parent = nullptr) noexcept;
+        ~ErcMsgListModel() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the message of a message row
+         *
+         * @param index     A model index
+         *
+         * @return The message, or nullptr if the index is not a message row
+         */
+        ErcMsg* getMessage(const QModelIndex& index) const noexcept;
+
+        /**
+         * @brief Get the count of all messages which are not ignored
+         */
+        int getNonIgnoredCount() const noexcept;
+
+        // Inherited from QAbstractItemModel
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex parent(const QModelIndex& index) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+        // Operator Overloadings
+        ErcMsgListModel& operator=(const ErcMsgListModel& rhs) = delete;
+
+
+    signals:
+
+        void messageCountsChanged();
+
+
+    private slots:
+
+        void ercMsgsChanged(const QList<ErcMsg*>& added, const QList<ErcMsg*>& removed,
+                            const QList<ErcMsg*>& changed) noexcept;
+
+
+    private: // Types
+
+        struct Entry {
+            QString text; ///< the message text when the row was inserted (sort key)
+            ErcMsg* msg; ///< may already be deleted when reported as removed
+            bool operator<(const Entry& rhs) const noexcept {
+                return (text < rhs.text) || ((text == rhs.text) && std::less<ErcMsg*>()(msg, rhs.msg));
+            }
+        };
+
+
+    private: // Methods
+        int getCategory(const ErcMsg& msg) const noexcept;
+        void insertMessage(ErcMsg* msg) noexcept;
+        void removeMessage(ErcMsg* msg) noexcept;
+
+
+    private: // Data
+        QVector<QList<Entry>> mCategories; ///< sorted entries of each category
+        QHash<ErcMsg*, QPair<int, QString>> mEntryKeys; ///< message --> category, text
+        QVector<QString> mCategoryTitles; ///< contains "%1" for the count
+        QVector<QIcon> mCategoryIcons;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_ERCMSGLISTMODEL_H
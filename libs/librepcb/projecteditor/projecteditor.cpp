@@ -23,13 +23,21 @@
 #include <QtCore>
 #include "projecteditor.h"
 #include <librepcb/common/undostack.h>
+#include <librepcb/common/memoryreport.h>
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/common/fileio/filewritebatch.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
 #include <librepcb/project/project.h>
+#include <librepcb/project/projectarchive.h>
+#include <librepcb/project/projectjournal.h>
+#include <librepcb/project/library/projectlibrary.h>
 #include "schematiceditor/schematiceditor.h"
 #include "boardeditor/boardeditor.h"
 #include "dialogs/projectsettingsdialog.h"
 #include "dialogs/editnetclassesdialog.h"
+#include "dialogs/bulkattributeeditordialog.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -38,17 +46,61 @@ namespace librepcb {
 namespace project {
 namespace editor {
 
+/*****************************************************************************************
+ *  Class ProjectEditor::AutosaveWriter
+ ****************************************************************************************/
+
+/**
+ * @brief Writes the collected autosave files in the workspace's JobScheduler
+ *
+ * The error messages are stored in the given list (which must not be accessed until the
+ * job has finished). Afterwards, the project editor is notified in its own thread.
+ */
+class ProjectEditor::AutosaveWriter final : public QRunnable
+{
+    public:
+        AutosaveWriter(ProjectEditor& editor, FileWriteBatch& batch,
+                       QStringList& errors) noexcept :
+            mEditor(editor), mBatch(batch), mErrors(errors)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            mErrors = mBatch.writeAll();
+            QMetaObject::invokeMethod(&mEditor, "autosaveFilesWritten", Qt::QueuedConnection);
+        }
+
+    private:
+        ProjectEditor& mEditor;
+        FileWriteBatch& mBatch;
+        QStringList& mErrors;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project) :
-    QObject(nullptr), mWorkspace(workspace), mProject(project), mUndoStack(nullptr),
-    mSchematicEditor(nullptr), mBoardEditor(nullptr)
+    QObject(nullptr), mWorkspace(workspace), mProject(project),
+    mAutosaveJobs(workspace.getJobScheduler(), JobScheduler::Priority::Background, 1),
+    mAutosaveJournalSize(0), mUndoStack(nullptr),
+    mSchematicEditor(nullptr), mBoardEditor(nullptr), mMemoryReportProviderId(0),
+    mSnapshotOutdated(true)
 {
+    // share identical library elements with other projects (if enabled)
+    if (mWorkspace.getSettings().getProjectLibrarySharing().isEnabled()) {
+        mProject.getLibrary().setSharedFileStore(&mWorkspace.getProjectLibraryStore());
+    }
+
     try
     {
         mUndoStack = new UndoStack();
+        mUndoStack->setMemoryLimit(
+            mWorkspace.getSettings().getProjectUndoMemoryLimit().getLimitBytes());
+        connect(mUndoStack, &UndoStack::stateModified,
+                this, [this](){mSnapshotOutdated = true;});
 
         // create the whole schematic/board editor GUI inclusive FSM and so on
         mSchematicEditor = new SchematicEditor(*this, mProject);
@@ -70,13 +122,43 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
         // autosaving is enabled --> start the timer
         connect(&mAutoSaveTimer, &QTimer::timeout, this, &ProjectEditor::autosaveProject);
         mAutoSaveTimer.start(1000 * intervalSecs);
+
+        // in addition, journal the modified documents shortly after every edit (a
+        // journal of a previous session is only relevant if it has been restored)
+        mJournal.reset(new ProjectJournal(mProject.getPath()));
+        if (!mProject.isRestored()) {
+            clearJournal();
+        }
+        mJournalTimer.setSingleShot(true);
+        mJournalTimer.setInterval(500);
+        connect(&mJournalTimer, &QTimer::timeout, this, &ProjectEditor::appendToJournal);
+        auto scheduleJournal = [this](){if (!mJournalTimer.isActive()) mJournalTimer.start();};
+        connect(mUndoStack, &UndoStack::stateModified, this, scheduleJournal);
+        connect(mUndoStack, &UndoStack::commandGroupEnded, this, scheduleJournal);
     }
+
+    // make the memory usage of the project visible in the debug tools
+    mMemoryReportProviderId = MemoryReport::registerProvider([this](MemoryReport& report){
+        MemoryReport& editor = report.addChild(QString("Project Editor \"%1\"")
+            .arg(mProject.getName()), sizeof(ProjectEditor));
+        mProject.addToMemoryReport(editor);
+        editor.addChild("Undo stack", mUndoStack->getApproximateMemoryUsage());
+    });
 }
 
 ProjectEditor::~ProjectEditor() noexcept
 {
-    // stop the autosave timer
+    MemoryReport::unregisterProvider(mMemoryReportProviderId);
+
+    // stop the autosave timer and wait until a running autosave has written its files
     mAutoSaveTimer.stop();
+    mJournalTimer.stop();
+    finishAutosave();
+
+    // like the backup files, the journal is kept until a restored project is saved
+    if (!mProject.isRestored()) {
+        clearJournal();
+    }
 
     // abort all active commands!
     mSchematicEditor->abortAllCommands();
@@ -97,6 +179,19 @@ ProjectEditor::~ProjectEditor() noexcept
     emit projectEditorClosed();
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+const ProjectSnapshot& ProjectEditor::getSnapshot()
+{
+    if (mSnapshotOutdated) {
+        mSnapshot = ProjectSnapshot(mProject, mSnapshot); // can throw
+        mSnapshotOutdated = false;
+    }
+    return mSnapshot;
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -143,6 +238,20 @@ void ProjectEditor::showBoardEditor() noexcept
     mBoardEditor->activateWindow();
 }
 
+void ProjectEditor::showComponentInSchematicEditor(const ComponentInstance& component) noexcept
+{
+    if (mSchematicEditor->showComponentInstance(component)) {
+        showSchematicEditor();
+    }
+}
+
+void ProjectEditor::showComponentInBoardEditor(const ComponentInstance& component) noexcept
+{
+    if (mBoardEditor->showComponentInstance(component)) {
+        showBoardEditor();
+    }
+}
+
 void ProjectEditor::execProjectSettingsDialog(QWidget* parent) noexcept
 {
     ProjectSettingsDialog d(mProject.getSettings(), *mUndoStack, parent);
@@ -155,20 +264,80 @@ void ProjectEditor::execNetClassesEditorDialog(QWidget* parent) noexcept
     d.exec();
 }
 
+void ProjectEditor::execBulkAttributeEditorDialog(QWidget* parent) noexcept
+{
+    BulkAttributeEditorDialog d(mProject.getCircuit(), *mUndoStack, parent);
+    d.exec();
+}
+
+void ProjectEditor::execExportArchiveDialog(QWidget* parent) noexcept
+{
+    if (!mUndoStack->isClean()) {
+        int answer = QMessageBox::question(parent, tr("Export Project Archive"),
+            tr("Unsaved changes are not exported. Do you want to save the project first?"),
+            QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel, QMessageBox::Yes);
+        if (answer == QMessageBox::Cancel) return;
+        if ((answer == QMessageBox::Yes) && (!saveProject())) return;
+    }
+
+    QString defaultFile = mProject.getPath().getParentDir().getPathTo(
+        mProject.getPath().getFilename() % ".zip").toStr();
+    FilePath zipFile(QFileDialog::getSaveFileName(parent, tr("Export Project Archive"),
+        defaultFile, tr("Zip archives (%1)").arg("*.zip")));
+    if (!zipFile.isValid()) return;
+    if (zipFile.getSuffix() != "zip") {
+        zipFile.setPath(zipFile.toStr() % ".zip");
+    }
+
+    try
+    {
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        auto cursorGuard = scopeGuard([](){QApplication::restoreOverrideCursor();});
+        ProjectArchive::exportProject(mProject.getPath(), zipFile,
+                                      mWorkspace.getJobScheduler(), true); // can throw
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::critical(parent, tr("Error"), e.getMsg());
+    }
+}
+
 bool ProjectEditor::saveProject() noexcept
 {
+    // a running autosave must not write the backup files concurrently
+    finishAutosave();
+
+    // write all files of a step as a transaction, so a failed or interrupted save
+    // never leaves a mix of old and new files behind
+    auto saveAtomically = [this](bool toOriginal) {
+        FileWriteBatch batch;
+        {
+            FileWriteBatch::Collector collector(batch);
+            mProject.save(toOriginal); // can throw
+        }
+        try {
+            batch.commit(); // can throw
+        } catch (const Exception&) {
+            batch.notifyWritten();
+            throw;
+        }
+        batch.notifyWritten();
+    };
+
     try
     {
         // step 1: save whole project to temporary files
         qDebug() << "Begin saving the project to temporary files...";
-        mProject.save(false);
+        saveAtomically(false);
 
         // step 2: save whole project to original files
         qDebug() << "Begin saving the project to original files...";
-        mProject.save(true);
+        saveAtomically(true);
 
         // saving was successful --> clean the undo stack
         mUndoStack->setClean();
+        clearJournal();
+        mWorkspace.getLibraryDb().updateProjectIndex(mProject.getFilepath());
         qDebug() << "Project successfully saved";
         return true;
     }
@@ -179,6 +348,40 @@ bool ProjectEditor::saveProject() noexcept
     }
 }
 
+void ProjectEditor::reloadFromDisk(QWidget* parent) noexcept
+{
+    if (!mUndoStack->isClean()) {
+        int answer = QMessageBox::question(parent, tr("Reload Project"),
+            tr("All unsaved changes will be lost. Do you really want to reload the "
+               "project from the harddisc?"), QMessageBox::Yes | QMessageBox::Cancel,
+            QMessageBox::Cancel);
+        if (answer != QMessageBox::Yes) return;
+    }
+
+    // a running autosave must not access the reloaded objects
+    finishAutosave();
+
+    try
+    {
+        // the undo commands may refer to objects which are reloaded
+        if (mUndoStack->isCommandGroupActive()) {
+            mUndoStack->abortCmdGroup(); // can throw
+        }
+        mUndoStack->clear();
+        mSnapshotOutdated = true;
+        clearJournal();
+
+        if (!mProject.reloadModifiedFiles()) { // can throw
+            emit reopenRequested();
+        }
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::critical(parent, tr("Error"), QString(tr("The project could not be "
+            "reloaded, please reopen it:\n\n%1")).arg(e.getMsg()));
+    }
+}
+
 bool ProjectEditor::autosaveProject() noexcept
 {
     if ((!mProject.isRestored()) && (mUndoStack->isClean()))
@@ -196,11 +399,22 @@ bool ProjectEditor::autosaveProject() noexcept
         return false;
     }
 
+    if (mAutosaveBatch)
+        return false; // the previous autosave is still writing its files
+
     try
     {
         qDebug() << "Begin autosaving the project to temporary files...";
-        mProject.save(false);
-        qDebug() << "Project successfully autosaved";
+        QScopedPointer<FileWriteBatch> batch(new FileWriteBatch());
+        {
+            // serialize in this thread, but write the files in the background
+            FileWriteBatch::Collector collector(*batch);
+            mProject.save(false);
+        }
+        mAutosaveBatch.reset(batch.take());
+        mAutosaveErrors.clear();
+        mAutosaveJournalSize = mJournal ? mJournal->getSize() : 0;
+        mAutosaveJobs.start(new AutosaveWriter(*this, *mAutosaveBatch, mAutosaveErrors));
         return true;
     }
     catch (Exception& exc)
@@ -248,6 +462,15 @@ bool ProjectEditor::closeAndDestroy(bool askForSave, QWidget* msgBoxParent) noex
     }
 }
 
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void ProjectEditor::autosaveFilesWritten() noexcept
+{
+    finishAutosave();
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -260,6 +483,54 @@ int ProjectEditor::getCountOfVisibleEditorWindows() const noexcept
     return count;
 }
 
+void ProjectEditor::finishAutosave() noexcept
+{
+    if (!mAutosaveBatch) return; // no autosave running, or already finished
+
+    mAutosaveJobs.waitForDone();
+    mAutosaveBatch->notifyWritten();
+    mAutosaveBatch.reset();
+    if (mAutosaveErrors.isEmpty()) {
+        qDebug() << "Project successfully autosaved";
+        if (mJournal) {
+            try {
+                // the backup files contain the journaled documents now
+                mJournal->discard(mAutosaveJournalSize); // can throw
+            } catch (const Exception& e) {
+                qWarning() << "Could not shrink the project journal:" << e.getMsg();
+            }
+        }
+        emit projectAutosaved(true);
+    } else {
+        qWarning() << "Autosave failed:" << mAutosaveErrors.join("\n");
+        emit projectAutosaved(false);
+    }
+}
+
+void ProjectEditor::appendToJournal() noexcept
+{
+    if (mUndoStack->isCommandGroupActive()) {
+        return; // will be journaled when the command group has ended
+    }
+
+    try {
+        mJournal->append(getSnapshot()); // can throw
+    } catch (const Exception& e) {
+        qWarning() << "Could not append to the project journal:" << e.getMsg();
+    }
+}
+
+void ProjectEditor::clearJournal() noexcept
+{
+    if (!mJournal) return;
+
+    try {
+        mJournal->clear(); // can throw
+    } catch (const Exception& e) {
+        qWarning() << "Could not remove the project journal:" << e.getMsg();
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -28,6 +28,8 @@
 #include <librepcb/common/if_attributeprovider.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/directorylock.h>
+#include <librepcb/common/jobscheduler.h>
+#include <librepcb/project/projectsnapshot.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -37,6 +39,7 @@ class QMainWindow;
 namespace librepcb {
 
 class UndoStack;
+class FileWriteBatch;
 
 namespace workspace {
 class Workspace;
@@ -45,6 +48,8 @@ class Workspace;
 namespace project {
 
 class Project;
+class ProjectJournal;
+class ComponentInstance;
 
 namespace editor {
 
@@ -94,6 +99,20 @@ class ProjectEditor final : public QObject
          */
         UndoStack& getUndoStack() const noexcept {return *mUndoStack;}
 
+        /**
+         * @brief Get a read-only snapshot of the current state of the project
+         *
+         * The snapshot is only recreated if the project was modified by the undo stack
+         * since the last call, and unmodified documents are shared with the previous
+         * snapshot. It can be passed to worker threads (e.g. for exports or checks)
+         * while the user keeps editing the project.
+         *
+         * @return The snapshot of the current state
+         *
+         * @throw Exception If the project could not be serialized
+         */
+        const ProjectSnapshot& getSnapshot();
+
 
         // General Methods
 
@@ -141,6 +160,24 @@ class ProjectEditor final : public QObject
          */
         void showBoardEditor() noexcept;
 
+        /**
+         * @brief Select the symbols of a component in the schematic editor and show it
+         *
+         * This is used for cross-probing from the board editor.
+         *
+         * @param component     The component to show
+         */
+        void showComponentInSchematicEditor(const ComponentInstance& component) noexcept;
+
+        /**
+         * @brief Select the device of a component in the board editor and show it
+         *
+         * This is used for cross-probing from the schematic editor.
+         *
+         * @param component     The component to show
+         */
+        void showComponentInBoardEditor(const ComponentInstance& component) noexcept;
+
         /**
          * @brief Execute the project settings dialog (blocking!)
          *
@@ -155,6 +192,24 @@ class ProjectEditor final : public QObject
          */
         void execNetClassesEditorDialog(QWidget* parent = nullptr) noexcept;
 
+        /**
+         * @brief Execute the bulk attribute editor dialog for all components (blocking!)
+         *
+         * @param parent    parent widget of the dialog (optional)
+         */
+        void execBulkAttributeEditorDialog(QWidget* parent = nullptr) noexcept;
+
+        /**
+         * @brief Ask for a filename and export the project directory to a zip archive
+         *
+         * Backup files and caches are not exported (see
+         * librepcb::project::ProjectArchive::exportProject()). If there are unsaved
+         * changes, the user is asked to save the project first.
+         *
+         * @param parent    parent widget of the dialogs (optional)
+         */
+        void execExportArchiveDialog(QWidget* parent = nullptr) noexcept;
+
         /**
          * @brief Save the whole project to the harddisc
          *
@@ -167,12 +222,30 @@ class ProjectEditor final : public QObject
         /**
          * @brief Make a automatic backup of the project (save to temporary files)
          *
+         * The project is serialized on the calling (main) thread, but the files are
+         * written in a background thread. When writing has finished, the signal
+         * #projectAutosaved() is emitted.
+         *
          * @note The whole save procedere is described in @ref doc_project_save.
          *
-         * @return true on success, false on failure
+         * @return true if the autosave was started, false on failure or if there was
+         *         nothing to save
          */
         bool autosaveProject() noexcept;
 
+        /**
+         * @brief Reload the project after its files were modified by another application
+         *
+         * If only schematics and boards were modified (e.g. after checking out another
+         * git branch), only these are reloaded while all other objects are kept (see
+         * librepcb::project::Project::reloadModifiedFiles()). Otherwise the signal
+         * #reopenRequested() is emitted to reopen the whole project. Since unsaved
+         * changes get lost, the user is asked for confirmation first.
+         *
+         * @param parent    parent widget of message boxes (optional)
+         */
+        void reloadFromDisk(QWidget* parent = nullptr) noexcept;
+
         /**
          * @brief Close the project (this will destroy this object!)
          *
@@ -203,10 +276,37 @@ class ProjectEditor final : public QObject
         void showControlPanelClicked();
         void projectEditorClosed();
 
+        /**
+         * @brief Emitted when the files of an autosave have been written
+         *
+         * @param success   false if at least one file could not be written
+         */
+        void projectAutosaved(bool success);
+
+        /**
+         * @brief Emitted if the project needs to be closed and opened again to reload it
+         *
+         * @see #reloadFromDisk()
+         */
+        void reopenRequested();
+
+
+    private slots:
+
+        void autosaveFilesWritten() noexcept;
+
 
     private: // Methods
 
         int getCountOfVisibleEditorWindows() const noexcept;
+        void finishAutosave() noexcept;
+        void appendToJournal() noexcept;
+        void clearJournal() noexcept;
+
+
+    private: // Types
+
+        class AutosaveWriter;
 
 
     private: // Data
@@ -214,9 +314,18 @@ class ProjectEditor final : public QObject
         workspace::Workspace& mWorkspace;
         Project& mProject;
         QTimer mAutoSaveTimer; ///< the timer for the periodically automatic saving functionality (see also @ref doc_project_save)
+        JobScheduler::Group mAutosaveJobs; ///< writes the autosave files in the background
+        QScopedPointer<FileWriteBatch> mAutosaveBatch; ///< files of the running autosave (or nullptr)
+        QStringList mAutosaveErrors; ///< only accessed while no autosave is being written
+        QScopedPointer<ProjectJournal> mJournal; ///< nullptr if autosave is disabled
+        QTimer mJournalTimer; ///< appends to #mJournal shortly after modifications
+        qint64 mAutosaveJournalSize; ///< journal size when the running autosave was serialized
         UndoStack* mUndoStack; ///< See @ref doc_project_undostack
         SchematicEditor* mSchematicEditor; ///< The schematic editor (GUI)
         BoardEditor* mBoardEditor; ///< The board editor (GUI)
+        int mMemoryReportProviderId; ///< see librepcb::MemoryReport::registerProvider()
+        ProjectSnapshot mSnapshot; ///< see #getSnapshot()
+        bool mSnapshotOutdated; ///< the project was modified after creating #mSnapshot
 };
 
 /*****************************************************************************************
@@ -25,6 +25,7 @@ SOURCES += \
     boardeditor/boardlayersdock.cpp \
     boardeditor/boardlayerstacksetupdialog.cpp \
     boardeditor/boardviapropertiesdialog.cpp \
+    boardeditor/deviceplacer.cpp \
     boardeditor/fabricationoutputdialog.cpp \
     boardeditor/fsm/bes_adddevice.cpp \
     boardeditor/fsm/bes_addvia.cpp \
@@ -33,12 +34,17 @@ SOURCES += \
     boardeditor/fsm/bes_fsm.cpp \
     boardeditor/fsm/bes_select.cpp \
     boardeditor/fsm/boardeditorevent.cpp \
+    boardeditor/netstatisticsdock.cpp \
     boardeditor/unplacedcomponentsdock.cpp \
     cmd/cmdaddcomponenttocircuit.cpp \
     cmd/cmdadddevicetoboard.cpp \
     cmd/cmdaddsymboltoschematic.cpp \
+    cmd/cmdaddsymbolstoschematic.cpp \
+    cmd/cmdapplyboardannotationdiff.cpp \
     cmd/cmdcombineallitemsunderboardnetpoint.cpp \
     cmd/cmdcombineallnetsignalsunderschematicnetpoint.cpp \
+    cmd/cmdcleanupboardtraces.cpp \
+    cmd/cmdcleanupschematicnetlines.cpp \
     cmd/cmdcombineboardnetpoints.cpp \
     cmd/cmdcombinenetsignals.cpp \
     cmd/cmdcombineschematicnetpoints.cpp \
@@ -46,6 +52,7 @@ SOURCES += \
     cmd/cmdflipselectedboarditems.cpp \
     cmd/cmdmoveselectedboarditems.cpp \
     cmd/cmdmoveselectedschematicitems.cpp \
+    cmd/cmdpasteschematicitems.cpp \
     cmd/cmdplaceboardnetpoint.cpp \
     cmd/cmdplaceschematicnetpoint.cpp \
     cmd/cmdremovedevicefromboard.cpp \
@@ -54,13 +61,17 @@ SOURCES += \
     cmd/cmdremoveunusednetsignals.cpp \
     cmd/cmdremoveviafromboard.cpp \
     cmd/cmdreplacedevice.cpp \
+    cmd/cmdreplacedevices.cpp \
     cmd/cmdrotateselectedboarditems.cpp \
     cmd/cmdrotateselectedschematicitems.cpp \
     dialogs/addcomponentdialog.cpp \
+    dialogs/bulkattributeeditordialog.cpp \
+    dialogs/componentinstanceattributesmodel.cpp \
     dialogs/editnetclassesdialog.cpp \
     dialogs/projectpropertieseditordialog.cpp \
     dialogs/projectsettingsdialog.cpp \
     docks/ercmsgdock.cpp \
+    docks/ercmsglistmodel.cpp \
     newprojectwizard/newprojectwizard.cpp \
     newprojectwizard/newprojectwizardpage_initialization.cpp \
     newprojectwizard/newprojectwizardpage_metadata.cpp \
@@ -76,6 +87,7 @@ SOURCES += \
     schematiceditor/schematicclipboard.cpp \
     schematiceditor/schematiceditor.cpp \
     schematiceditor/schematicpagesdock.cpp \
+    schematiceditor/schematicthumbnails.cpp \
     schematiceditor/symbolinstancepropertiesdialog.cpp \
 
 HEADERS += \
@@ -83,6 +95,7 @@ HEADERS += \
     boardeditor/boardlayersdock.h \
     boardeditor/boardlayerstacksetupdialog.h \
     boardeditor/boardviapropertiesdialog.h \
+    boardeditor/deviceplacer.h \
     boardeditor/fabricationoutputdialog.h \
     boardeditor/fsm/bes_adddevice.h \
     boardeditor/fsm/bes_addvia.h \
@@ -91,12 +104,17 @@ HEADERS += \
     boardeditor/fsm/bes_fsm.h \
     boardeditor/fsm/bes_select.h \
     boardeditor/fsm/boardeditorevent.h \
+    boardeditor/netstatisticsdock.h \
     boardeditor/unplacedcomponentsdock.h \
     cmd/cmdaddcomponenttocircuit.h \
     cmd/cmdadddevicetoboard.h \
     cmd/cmdaddsymboltoschematic.h \
+    cmd/cmdaddsymbolstoschematic.h \
+    cmd/cmdapplyboardannotationdiff.h \
     cmd/cmdcombineallitemsunderboardnetpoint.h \
     cmd/cmdcombineallnetsignalsunderschematicnetpoint.h \
+    cmd/cmdcleanupboardtraces.h \
+    cmd/cmdcleanupschematicnetlines.h \
     cmd/cmdcombineboardnetpoints.h \
     cmd/cmdcombinenetsignals.h \
     cmd/cmdcombineschematicnetpoints.h \
@@ -104,6 +122,7 @@ HEADERS += \
     cmd/cmdflipselectedboarditems.h \
     cmd/cmdmoveselectedboarditems.h \
     cmd/cmdmoveselectedschematicitems.h \
+    cmd/cmdpasteschematicitems.h \
     cmd/cmdplaceboardnetpoint.h \
     cmd/cmdplaceschematicnetpoint.h \
     cmd/cmdremovedevicefromboard.h \
@@ -112,13 +131,17 @@ HEADERS += \
     cmd/cmdremoveunusednetsignals.h \
     cmd/cmdremoveviafromboard.h \
     cmd/cmdreplacedevice.h \
+    cmd/cmdreplacedevices.h \
     cmd/cmdrotateselectedboarditems.h \
     cmd/cmdrotateselectedschematicitems.h \
     dialogs/addcomponentdialog.h \
+    dialogs/bulkattributeeditordialog.h \
+    dialogs/componentinstanceattributesmodel.h \
     dialogs/editnetclassesdialog.h \
     dialogs/projectpropertieseditordialog.h \
     dialogs/projectsettingsdialog.h \
     docks/ercmsgdock.h \
+    docks/ercmsglistmodel.h \
     newprojectwizard/newprojectwizard.h \
     newprojectwizard/newprojectwizardpage_initialization.h \
     newprojectwizard/newprojectwizardpage_metadata.h \
@@ -134,6 +157,7 @@ HEADERS += \
     schematiceditor/schematicclipboard.h \
     schematiceditor/schematiceditor.h \
     schematiceditor/schematicpagesdock.h \
+    schematiceditor/schematicthumbnails.h \
     schematiceditor/symbolinstancepropertiesdialog.h \
 
 FORMS += \
@@ -142,8 +166,10 @@ FORMS += \
     boardeditor/boardlayerstacksetupdialog.ui \
     boardeditor/boardviapropertiesdialog.ui \
     boardeditor/fabricationoutputdialog.ui \
+    boardeditor/netstatisticsdock.ui \
     boardeditor/unplacedcomponentsdock.ui \
     dialogs/addcomponentdialog.ui \
+    dialogs/bulkattributeeditordialog.ui \
     dialogs/editnetclassesdialog.ui \
     dialogs/projectpropertieseditordialog.ui \
     dialogs/projectsettingsdialog.ui \
@@ -37,6 +37,7 @@
 #include <librepcb/library/sym/symbol.h>
 #include "../../cmd/cmdaddcomponenttocircuit.h"
 #include "../../cmd/cmdaddsymboltoschematic.h"
+#include "../../cmd/cmdaddsymbolstoschematic.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -218,6 +219,13 @@ SES_Base::ProcRetVal SES_AddComponent::processSceneEvent(SEE_Base* event) noexce
                                 mCurrentComponent->getSymbolVariant().getSymbolItems()
                                 .value(mCurrentSymbVarItemIndex).get();
 
+                        // with shift pressed, add all remaining symbols at once
+                        if (currentSymbVarItem && (sceneEvent->modifiers() & Qt::ShiftModifier))
+                        {
+                            addRemainingSymbols(*schematic, mCurrentSymbolToPlace->getPosition());
+                            currentSymbVarItem = nullptr;
+                        }
+
                         if (currentSymbVarItem)
                         {
                             // create the next symbol instance and add it to the schematic
@@ -365,6 +373,23 @@ void SES_AddComponent::startAddingComponent(const Uuid& cmp, const Uuid& symbVar
     }
 }
 
+void SES_AddComponent::addRemainingSymbols(Schematic& schematic, const Point& pos)
+{
+    // arrange the symbols in a row to the right of the symbol placed last
+    const Length& gridInterval = mEditor.getGridProperties().getInterval();
+    QRectF rect = mCurrentSymbolToPlace->getGrabAreaScenePx().boundingRect();
+    Length spacing = Length::fromPx(rect.width(), gridInterval) + gridInterval * 4;
+    const auto& symbolItems = mCurrentComponent->getSymbolVariant().getSymbolItems();
+    QList<CmdSymbolInstancesAdd::Item> items;
+    for (int i = mCurrentSymbVarItemIndex; i < symbolItems.count(); ++i) {
+        Point itemPos = pos + Point(spacing * (i - mCurrentSymbVarItemIndex + 1), Length(0));
+        items.append(CmdSymbolInstancesAdd::Item{mCurrentComponent,
+            symbolItems.at(i)->getUuid(), itemPos, mCurrentSymbolToPlace->getRotation()});
+    }
+    mUndoStack.appendToCmdGroup(new CmdAddSymbolsToSchematic(mWorkspace, schematic,
+                                                             items)); // can throw
+}
+
 bool SES_AddComponent::abortCommand(bool showErrMsgBox) noexcept
 {
     try
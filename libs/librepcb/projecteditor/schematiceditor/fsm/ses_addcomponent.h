@@ -39,6 +39,7 @@ class ComponentSymbolVariantItem;
 
 namespace project {
 
+class Schematic;
 class ComponentInstance;
 class SI_Symbol;
 class CmdSymbolInstanceEdit;
@@ -76,6 +77,7 @@ class SES_AddComponent final : public SES_Base
         // Private Methods
         ProcRetVal processSceneEvent(SEE_Base* event) noexcept;
         void startAddingComponent(const Uuid& cmp = Uuid(), const Uuid& symbVar = Uuid());
+        void addRemainingSymbols(Schematic& schematic, const Point& pos);
         bool abortCommand(bool showErrMsgBox) noexcept;
 
 
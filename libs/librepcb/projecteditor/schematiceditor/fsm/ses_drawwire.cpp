@@ -69,7 +69,7 @@ SES_DrawWire::SES_DrawWire(SchematicEditor& editor, Ui::SchematicEditor& editorU
     SES_Base(editor, editorUi, editorGraphicsView, undoStack),
     mSubState(SubState_Idle), mWireMode(WireMode_HV), mFixedNetPoint(nullptr),
     mPositioningNetLine1(nullptr), mPositioningNetPoint1(nullptr),
-    mPositioningNetLine2(nullptr), mPositioningNetPoint2(nullptr),
+    mPositioningNetLine2(nullptr), mPositioningNetPoint2(nullptr), mSnapCacheValid(false),
     // command toolbar actions / widgets:
     mNetClassLabel(nullptr), mNetClassComboBox(nullptr), mNetSignalLabel(nullptr),
     mNetSignalComboBox(nullptr), mWidthLabel(nullptr), mWidthComboBox(nullptr)
@@ -256,7 +256,7 @@ SES_Base::ProcRetVal SES_DrawWire::processIdleSceneEvent(SEE_Base* event) noexce
             {
                 case Qt::LeftButton:
                     // start adding netpoints/netlines
-                    startPositioning(*schematic, pos);
+                    startPositioning(*schematic, getSnappedCursorPos(*schematic, pos));
                     return ForceStayInState;
                 default:
                     break;
@@ -302,7 +302,7 @@ SES_Base::ProcRetVal SES_DrawWire::processPositioningSceneEvent(SEE_Base* event)
             {
                 case Qt::LeftButton:
                     // fix the current point and add a new point + line
-                    addNextNetPoint(*schematic, pos);
+                    addNextNetPoint(*schematic, getSnappedCursorPos(*schematic, pos));
                     return ForceStayInState;
                 case Qt::RightButton:
                     return ForceStayInState;
@@ -324,7 +324,7 @@ SES_Base::ProcRetVal SES_DrawWire::processPositioningSceneEvent(SEE_Base* event)
                         mWireMode = static_cast<WireMode>(mWireMode+1);
                         if (mWireMode == WireMode_COUNT) mWireMode = static_cast<WireMode>(0);
                         updateWireModeActionsCheckedState();
-                        updateNetpointPositions(pos);
+                        updateNetpointPositions(getSnappedCursorPos(*schematic, pos));
                         return ForceStayInState;
                     }
                     break;
@@ -339,7 +339,10 @@ SES_Base::ProcRetVal SES_DrawWire::processPositioningSceneEvent(SEE_Base* event)
             QGraphicsSceneMouseEvent* sceneEvent = dynamic_cast<QGraphicsSceneMouseEvent*>(qevent);
             Q_ASSERT(sceneEvent);
             Point pos = Point::fromPx(sceneEvent->scenePos(), mEditor.getGridProperties().getInterval());
-            updateNetpointPositions(pos);
+            if (mSnapCacheValid && (pos == mSnapCacheCursorPos)) {
+                return ForceStayInState; // still in the same grid cell, nothing to update
+            }
+            updateNetpointPositions(getSnappedCursorPos(*schematic, pos));
             return ForceStayInState;
         }
 
@@ -414,6 +417,9 @@ bool SES_DrawWire::startPositioning(Schematic& schematic, const Point& pos,
         // highlight all elements of the current netsignal
         mCircuit.setHighlightedNetSignal(netsignal);
 
+        // the schematic has changed, so the snap target must be searched again
+        mSnapCacheValid = false;
+
         return true;
     }
     catch (Exception e)
@@ -493,6 +499,7 @@ bool SES_DrawWire::abortPositioning(bool showErrMsgBox) noexcept
     {
         mCircuit.setHighlightedNetSignal(nullptr);
         mSubState = SubState_Idle;
+        mSnapCacheValid = false;
         mFixedNetPoint = nullptr;
         mPositioningNetLine1 = nullptr;
         mPositioningNetLine2 = nullptr;
@@ -509,6 +516,24 @@ bool SES_DrawWire::abortPositioning(bool showErrMsgBox) noexcept
     }
 }
 
+Point SES_DrawWire::getSnappedCursorPos(Schematic& schematic, const Point& cursorPos) noexcept
+{
+    if (mSnapCacheValid && (cursorPos == mSnapCacheCursorPos)) {
+        return mSnapCacheSnappedPos;
+    }
+
+    // snap to the nearest pin or netpoint, even if it is not on the grid
+    QSet<const SI_Base*> ignore;
+    if (mPositioningNetPoint1) ignore.insert(mPositioningNetPoint1);
+    if (mPositioningNetPoint2) ignore.insert(mPositioningNetPoint2);
+    SI_Base* target = schematic.getNearestSnapTarget(cursorPos,
+        mEditor.getGridProperties().getInterval(), ignore);
+    mSnapCacheCursorPos = cursorPos;
+    mSnapCacheSnappedPos = target ? target->getPosition() : cursorPos;
+    mSnapCacheValid = true;
+    return mSnapCacheSnappedPos;
+}
+
 void SES_DrawWire::updateNetpointPositions(const Point& cursorPos) noexcept
 {
     mPositioningNetPoint1->setPosition(calcMiddlePointPos(mFixedNetPoint->getPosition(),
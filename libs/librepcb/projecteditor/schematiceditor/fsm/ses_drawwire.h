@@ -97,6 +97,7 @@ class SES_DrawWire final : public SES_Base
                               SI_NetPoint* fixedPoint = nullptr) noexcept;
         bool addNextNetPoint(Schematic& schematic, const Point& pos) noexcept;
         bool abortPositioning(bool showErrMsgBox) noexcept;
+        Point getSnappedCursorPos(Schematic& schematic, const Point& cursorPos) noexcept;
         void updateNetpointPositions(const Point& cursorPos) noexcept;
         void updateWireModeActionsCheckedState() noexcept;
         Point calcMiddlePointPos(const Point& p1, const Point p2, WireMode mode) const noexcept;
@@ -111,6 +112,11 @@ class SES_DrawWire final : public SES_Base
         SI_NetLine* mPositioningNetLine2; ///< line between p1 and p2
         SI_NetPoint* mPositioningNetPoint2; ///< the second netpoint to place
 
+        // Snapping (the result is cached as long as the cursor stays in the same grid cell)
+        bool mSnapCacheValid; ///< whether the cached snap position is up to date
+        Point mSnapCacheCursorPos; ///< the cursor position (mapped to the grid)
+        Point mSnapCacheSnappedPos; ///< the position of the snap target (or the cursor)
+
         // Widgets for the command toolbar
         QHash<WireMode, QAction*> mWireModeActions;
         QList<QAction*> mActionSeparators;
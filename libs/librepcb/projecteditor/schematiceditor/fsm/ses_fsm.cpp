@@ -23,6 +23,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <QtEvents>
+#include <librepcb/common/graphics/framestatistics.h>
 #include "ses_fsm.h"
 #include "schematiceditorevent.h"
 #include "../schematiceditor.h"
@@ -92,8 +93,10 @@ SES_Base::ProcRetVal SES_FSM::process(SEE_Base* event) noexcept
     ProcRetVal retval = PassToParentState;
 
     // let the current state process the event
-    if (mCurrentState != State_NoState)
+    if (mCurrentState != State_NoState) {
+        FrameStatistics::EventHandlerTimer timer(mSubStates[mCurrentState]->metaObject()->className());
         retval = mSubStates[mCurrentState]->process(event);
+    }
 
     switch (retval)
     {
@@ -23,11 +23,14 @@
 #include <QtCore>
 #include "ses_select.h"
 #include "../schematiceditor.h"
+#include <librepcb/projecteditor/projecteditor.h>
 #include "ui_schematiceditor.h"
 #include <librepcb/project/project.h>
 #include <librepcb/project/schematics/items/si_netpoint.h>
 #include <librepcb/project/schematics/schematic.h>
 #include <librepcb/common/undostack.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/gridproperties.h>
 #include <librepcb/project/schematics/items/si_netline.h>
 #include <librepcb/project/schematics/items/si_symbol.h>
 #include <librepcb/project/schematics/items/si_symbolpin.h>
@@ -41,6 +44,8 @@
 #include "../../cmd/cmdremoveselectedschematicitems.h"
 #include "../../cmd/cmdrotateselectedschematicitems.h"
 #include "../../cmd/cmdmoveselectedschematicitems.h"
+#include "../../cmd/cmdpasteschematicitems.h"
+#include "../schematicclipboard.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -242,6 +247,9 @@ SES_Base::ProcRetVal SES_Select::proccessIdleSceneRightMouseButtonReleased(
             aRemoveSymbol->setEnabled(cmpInstance.getPlacedSymbolsCount() > 1);
             QAction* aRemoveCmp = menu.addAction(QIcon(":/img/actions/cancel.png"), QString(tr("Remove Component %1")).arg(cmpInstance.getName()));
             menu.addSeparator();
+            QAction* aShowInBoard = menu.addAction(tr("Show in Board"));
+            aShowInBoard->setEnabled(!cmpInstance.getRegisteredDevices().isEmpty());
+            menu.addSeparator();
             QAction* aProperties = menu.addAction(tr("Properties"));
 
             // execute the context menu
@@ -270,6 +278,10 @@ SES_Base::ProcRetVal SES_Select::proccessIdleSceneRightMouseButtonReleased(
             {
                 // TODO
             }
+            else if (action == aShowInBoard)
+            {
+                mEditor.getProjectEditor().showComponentInBoardEditor(cmpInstance);
+            }
             else if (action == aProperties)
             {
                 // open the properties editor dialog of the selected item
@@ -374,6 +386,7 @@ SES_Base::ProcRetVal SES_Select::processSubStateMovingSceneEvent(SEE_Base* event
                     QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
                 }
                 mSelectedItemsMoveCommand.reset();
+                mMovePreviewItem.reset(); // also removes it from the scene
                 mSubState = SubState_Idle;
             }
             break;
@@ -385,7 +398,12 @@ SES_Base::ProcRetVal SES_Select::processSubStateMovingSceneEvent(SEE_Base* event
             Q_ASSERT(sceneEvent); if (!sceneEvent) break;
             Q_ASSERT(!mSelectedItemsMoveCommand.isNull());
             Point pos = Point::fromPx(sceneEvent->scenePos());
-            mSelectedItemsMoveCommand->setCurrentPosition(pos);
+            updateMovePreview(pos);
+            if (mMoveUpdateTimer.elapsed() >= 100) {
+                // moving the items themselves is expensive, so do it at a limited rate
+                mSelectedItemsMoveCommand->setCurrentPosition(pos);
+                mMoveUpdateTimer.restart();
+            }
             break;
         } // case QEvent::GraphicsSceneMouseMove
 
@@ -407,10 +425,35 @@ bool SES_Select::startMovingSelectedItems(Schematic& schematic, const Point& sta
 {
     Q_ASSERT(mSelectedItemsMoveCommand.isNull());
     mSelectedItemsMoveCommand.reset(new CmdMoveSelectedSchematicItems(schematic, startPos));
+
+    // while dragging, only a transient outline of the selected items follows the cursor
+    // immediately, the items themselves (and all connected netlines) are moved at a
+    // limited rate and finally when the mouse button is released
+    QPainterPath path;
+    foreach (const SI_Base* item, schematic.getSelectedItems(false, true, true, true, true, true,
+                                                         true, false, true, true, false)) {
+        path.addPath(item->getGrabAreaScenePx());
+    }
+    mMovePreviewItem.reset(new QGraphicsPathItem(path));
+    mMovePreviewItem->setPen(Qt::NoPen);
+    mMovePreviewItem->setBrush(QColor(255, 255, 255, 100));
+    mMovePreviewItem->setZValue(Schematic::ZValue_VisibleNetPoints + 1);
+    schematic.getGraphicsScene().addItem(*mMovePreviewItem);
+    mMoveStartPos = startPos;
+    mMoveUpdateTimer.start();
+
     mSubState = SubState_Moving;
     return true;
 }
 
+void SES_Select::updateMovePreview(const Point& pos) noexcept
+{
+    Schematic* schematic = mEditor.getActiveSchematic();
+    if ((!schematic) || (!mMovePreviewItem)) return;
+    Point delta = (pos - mMoveStartPos).mappedToGrid(schematic->getGridProperties().getInterval());
+    mMovePreviewItem->setPos(delta.toPxQPointF());
+}
+
 bool SES_Select::rotateSelectedItems(const Angle& angle) noexcept
 {
     Schematic* schematic = mEditor.getActiveSchematic();
@@ -449,18 +492,37 @@ bool SES_Select::removeSelectedItems() noexcept
 
 bool SES_Select::cutSelectedItems() noexcept
 {
-
-    return false; // TODO
+    if (!copySelectedItems()) return false;
+    return removeSelectedItems();
 }
 
 bool SES_Select::copySelectedItems() noexcept
 {
-    return false; // TODO
+    Schematic* schematic = mEditor.getActiveSchematic();
+    Q_ASSERT(schematic); if (!schematic) return false;
+
+    Point pos = mEditorGraphicsView.mapGlobalPosToScenePos(QCursor::pos(), true, true);
+    return (SchematicClipboard::instance().copy(*schematic, pos) > 0);
 }
 
 bool SES_Select::pasteItems() noexcept
 {
-    return false; // TODO
+    Schematic* schematic = mEditor.getActiveSchematic();
+    Q_ASSERT(schematic); if (!schematic) return false;
+    if (!SchematicClipboard::instance().hasData()) return false;
+
+    try
+    {
+        SchematicClipboard::Data data = SchematicClipboard::instance().getData(); // can throw
+        Point pos = mEditorGraphicsView.mapGlobalPosToScenePos(QCursor::pos(), true, true);
+        mUndoStack.execCmd(new CmdPasteSchematicItems(*schematic, data, pos - data.cursorPos));
+        return true;
+    }
+    catch (Exception& e)
+    {
+        QMessageBox::critical(&mEditor, tr("Error"), e.getMsg());
+        return false;
+    }
 }
 
 /*****************************************************************************************
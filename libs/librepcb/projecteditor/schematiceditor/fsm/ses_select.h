@@ -76,6 +76,7 @@ class SES_Select final : public SES_Base
         ProcRetVal proccessIdleSceneDoubleClick(QGraphicsSceneMouseEvent* mouseEvent,
                                                 Schematic* schematic) noexcept;
         bool startMovingSelectedItems(Schematic& schematic, const Point& startPos) noexcept;
+        void updateMovePreview(const Point& pos) noexcept;
         bool rotateSelectedItems(const Angle& angle) noexcept;
         bool removeSelectedItems() noexcept;
         bool cutSelectedItems() noexcept;
@@ -94,6 +95,9 @@ class SES_Select final : public SES_Base
         // Attributes
         SubState mSubState;     ///< the current substate
         QScopedPointer<CmdMoveSelectedSchematicItems> mSelectedItemsMoveCommand;
+        QScopedPointer<QGraphicsPathItem> mMovePreviewItem; ///< outline of the moved items
+        QElapsedTimer mMoveUpdateTimer; ///< to move the items at a limited rate only
+        Point mMoveStartPos; ///< the cursor position when the moving was started
 };
 
 /*****************************************************************************************
@@ -21,7 +21,19 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtWidgets>
 #include "schematicclipboard.h"
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/circuit/componentsignalinstance.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/items/si_symbol.h>
+#include <librepcb/project/schematics/items/si_symbolpin.h>
+#include <librepcb/project/schematics/items/si_netpoint.h>
+#include <librepcb/project/schematics/items/si_netline.h>
+#include <librepcb/project/schematics/items/si_netlabel.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -30,64 +42,324 @@ namespace librepcb {
 namespace project {
 namespace editor {
 
+/*****************************************************************************************
+ *  Helper Functions
+ ****************************************************************************************/
+
+namespace {
+
+void writeUuid(QDataStream& stream, const Uuid& uuid) noexcept
+{
+    stream << uuid.toStr().toLatin1(); // an empty array for null UUIDs
+}
+
+void writePoint(QDataStream& stream, const Point& point) noexcept
+{
+    stream << qint64(point.getX().toNm()) << qint64(point.getY().toNm());
+}
+
+void writeAngle(QDataStream& stream, const Angle& angle) noexcept
+{
+    stream << qint32(angle.toMicroDeg());
+}
+
+Uuid readUuid(QDataStream& stream) noexcept
+{
+    QByteArray str;
+    stream >> str;
+    return Uuid(QString::fromLatin1(str));
+}
+
+Point readPoint(QDataStream& stream) noexcept
+{
+    qint64 x = 0, y = 0;
+    stream >> x >> y;
+    return Point(Length(x), Length(y));
+}
+
+Angle readAngle(QDataStream& stream) noexcept
+{
+    qint32 microDeg = 0;
+    stream >> microDeg;
+    return Angle(microDeg);
+}
+
+template <typename T, typename ReadFn>
+QVector<T> readItems(QDataStream& stream, ReadFn readItem) noexcept
+{
+    quint32 count = 0;
+    stream >> count;
+    QVector<T> items;
+    while ((items.count() < int(count)) && (stream.status() == QDataStream::Ok)) {
+        items.append(readItem());
+    }
+    return items;
+}
+
+} // namespace
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 SchematicClipboard::SchematicClipboard() noexcept :
-    QObject(nullptr), mCutActive(false)
+    QObject(nullptr)
 {
 }
 
 SchematicClipboard::~SchematicClipboard() noexcept
 {
-    //clear();
 }
 
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
 
-/*void SchematicClipboard::clear() noexcept
+int SchematicClipboard::copy(const Schematic& schematic, const Point& cursorPos) noexcept
 {
-    qDeleteAll(mSymbolInstances);       mSymbolInstances.clear();
+    Data data = captureSelectedItems(schematic);
+    data.cursorPos = cursorPos;
+    if (data.getItemCount() > 0) {
+        QMimeData* mimeData = new QMimeData();
+        mimeData->setData(getMimeType(), serialize(data));
+        QApplication::clipboard()->setMimeData(mimeData); // takes the ownership
+    }
+    return data.getItemCount();
 }
 
-void SchematicClipboard::cut(const QList<SymbolInstance*>& symbols)
+bool SchematicClipboard::hasData() const noexcept
 {
-    mCutActive = true;
-    setElements(symbols);
+    const QMimeData* mimeData = QApplication::clipboard()->mimeData();
+    return mimeData && mimeData->hasFormat(getMimeType());
 }
 
-void SchematicClipboard::copy(const QList<SymbolInstance*>& symbols)
+SchematicClipboard::Data SchematicClipboard::getData() const
 {
-    mCutActive = false;
-    setElements(symbols);
+    const QMimeData* mimeData = QApplication::clipboard()->mimeData();
+    if ((!mimeData) || (!mimeData->hasFormat(getMimeType()))) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("The clipboard does not contain any schematic items."));
+    }
+    return deserialize(mimeData->data(getMimeType())); // can throw
 }
 
-void SchematicClipboard::paste(Schematic& schematic, QList<SymbolInstance*>& symbols)
-{
-    Q_ASSERT(symbols.isEmpty() == true);
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
 
-    foreach (DomElement* element, mSymbolInstances)
-    {
-        symbols.append(new SymbolInstance(schematic, *element));
+QByteArray SchematicClipboard::serialize(const Data& data) noexcept
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream << sMagic << sVersion;
+    writePoint(stream, data.cursorPos);
+    stream << quint32(data.components.count());
+    foreach (const Data::Component& cmp, data.components) {
+        writeUuid(stream, cmp.uuid);
+        writeUuid(stream, cmp.libComponent);
+        writeUuid(stream, cmp.symbVar);
+        stream << cmp.value;
+    }
+    stream << quint32(data.netSignals.count());
+    foreach (const Data::NetSignal& netsignal, data.netSignals) {
+        writeUuid(stream, netsignal.uuid);
+        writeUuid(stream, netsignal.netClass);
+        stream << netsignal.name << netsignal.hasAutoName;
     }
+    stream << quint32(data.signalConnections.count());
+    foreach (const Data::SignalConnection& connection, data.signalConnections) {
+        writeUuid(stream, connection.component);
+        writeUuid(stream, connection.signal);
+        writeUuid(stream, connection.netSignal);
+    }
+    stream << quint32(data.symbols.count());
+    foreach (const Data::Symbol& symbol, data.symbols) {
+        writeUuid(stream, symbol.uuid);
+        writeUuid(stream, symbol.component);
+        writeUuid(stream, symbol.symbolItem);
+        writePoint(stream, symbol.position);
+        writeAngle(stream, symbol.rotation);
+    }
+    stream << quint32(data.netPoints.count());
+    foreach (const Data::NetPoint& netpoint, data.netPoints) {
+        writeUuid(stream, netpoint.uuid);
+        writeUuid(stream, netpoint.netSignal);
+        writeUuid(stream, netpoint.symbol);
+        writeUuid(stream, netpoint.pin);
+        writePoint(stream, netpoint.position);
+    }
+    stream << quint32(data.netLines.count());
+    foreach (const Data::NetLine& netline, data.netLines) {
+        writeUuid(stream, netline.startPoint);
+        writeUuid(stream, netline.endPoint);
+    }
+    stream << quint32(data.netLabels.count());
+    foreach (const Data::NetLabel& netlabel, data.netLabels) {
+        writeUuid(stream, netlabel.netSignal);
+        writePoint(stream, netlabel.position);
+        writeAngle(stream, netlabel.rotation);
+    }
+    return bytes;
+}
 
-    mCutActive = false;
-}*/
+SchematicClipboard::Data SchematicClipboard::deserialize(const QByteArray& bytes)
+{
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_5_2);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if ((magic != sMagic) || (version != sVersion)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("The clipboard contains schematic items of an unsupported format."));
+    }
+    Data data;
+    data.cursorPos = readPoint(stream);
+    data.components = readItems<Data::Component>(stream, [&](){
+        Data::Component cmp;
+        cmp.uuid = readUuid(stream);
+        cmp.libComponent = readUuid(stream);
+        cmp.symbVar = readUuid(stream);
+        stream >> cmp.value;
+        return cmp;
+    });
+    data.netSignals = readItems<Data::NetSignal>(stream, [&](){
+        Data::NetSignal netsignal;
+        netsignal.uuid = readUuid(stream);
+        netsignal.netClass = readUuid(stream);
+        stream >> netsignal.name >> netsignal.hasAutoName;
+        return netsignal;
+    });
+    data.signalConnections = readItems<Data::SignalConnection>(stream, [&](){
+        Data::SignalConnection connection;
+        connection.component = readUuid(stream);
+        connection.signal = readUuid(stream);
+        connection.netSignal = readUuid(stream);
+        return connection;
+    });
+    data.symbols = readItems<Data::Symbol>(stream, [&](){
+        Data::Symbol symbol;
+        symbol.uuid = readUuid(stream);
+        symbol.component = readUuid(stream);
+        symbol.symbolItem = readUuid(stream);
+        symbol.position = readPoint(stream);
+        symbol.rotation = readAngle(stream);
+        return symbol;
+    });
+    data.netPoints = readItems<Data::NetPoint>(stream, [&](){
+        Data::NetPoint netpoint;
+        netpoint.uuid = readUuid(stream);
+        netpoint.netSignal = readUuid(stream);
+        netpoint.symbol = readUuid(stream);
+        netpoint.pin = readUuid(stream);
+        netpoint.position = readPoint(stream);
+        return netpoint;
+    });
+    data.netLines = readItems<Data::NetLine>(stream, [&](){
+        Data::NetLine netline;
+        netline.startPoint = readUuid(stream);
+        netline.endPoint = readUuid(stream);
+        return netline;
+    });
+    data.netLabels = readItems<Data::NetLabel>(stream, [&](){
+        Data::NetLabel netlabel;
+        netlabel.netSignal = readUuid(stream);
+        netlabel.position = readPoint(stream);
+        netlabel.rotation = readAngle(stream);
+        return netlabel;
+    });
+    if (stream.status() != QDataStream::Ok) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("The schematic items in the clipboard are corrupt."));
+    }
+    return data;
+}
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-/*void SchematicClipboard::setElements(const QList<SymbolInstance*>& symbols)
+SchematicClipboard::Data SchematicClipboard::captureSelectedItems(const Schematic& schematic) noexcept
 {
-    clear();
+    Data data;
+    QSet<const ComponentInstance*> components;
+    QSet<const NetSignal*> netsignals;
+    QSet<const ComponentSignalInstance*> connectedSignals;
+    QSet<const SI_Symbol*> symbols;
+    auto addNetSignal = [&](const NetSignal& netsignal) {
+        if (!netsignals.contains(&netsignal)) {
+            netsignals.insert(&netsignal);
+            data.netSignals.append(Data::NetSignal{netsignal.getUuid(),
+                netsignal.getNetClass().getUuid(), netsignal.getName(),
+                netsignal.hasAutoName()});
+        }
+    };
+
+    // get all selected items (including the netpoints of all selected netlines)
+    QList<SI_Base*> items = schematic.getSelectedItems(false, true, true, true, true, true,
+                                                       true, false, true, true, false);
 
-    foreach (SymbolInstance* symbol, symbols)
-        mSymbolInstances.append(symbol->serializeToDomElement());
-}*/
+    // symbols and their components
+    foreach (const SI_Base* item, items) {
+        if (item->getType() != SI_Base::Type_t::Symbol) continue;
+        const SI_Symbol* symbol = dynamic_cast<const SI_Symbol*>(item); Q_ASSERT(symbol);
+        const ComponentInstance& cmp = symbol->getComponentInstance();
+        if (!components.contains(&cmp)) {
+            components.insert(&cmp);
+            data.components.append(Data::Component{cmp.getUuid(),
+                cmp.getLibComponent().getUuid(), cmp.getSymbolVariant().getUuid(),
+                cmp.getValue()});
+        }
+        symbols.insert(symbol);
+        data.symbols.append(Data::Symbol{symbol->getUuid(), cmp.getUuid(),
+            symbol->getCompSymbVarItem().getUuid(), symbol->getPosition(),
+            symbol->getRotation()});
+    }
+
+    // netpoints (they stay attached to pins only if the symbol is copied too)
+    foreach (const SI_Base* item, items) {
+        if (item->getType() != SI_Base::Type_t::NetPoint) continue;
+        const SI_NetPoint* netpoint = dynamic_cast<const SI_NetPoint*>(item); Q_ASSERT(netpoint);
+        addNetSignal(netpoint->getNetSignal());
+        const SI_SymbolPin* pin = netpoint->getSymbolPin();
+        if (pin && symbols.contains(&pin->getSymbol())) {
+            data.netPoints.append(Data::NetPoint{netpoint->getUuid(),
+                netpoint->getNetSignal().getUuid(), pin->getSymbol().getUuid(),
+                pin->getLibPinUuid(), netpoint->getPosition()});
+            const ComponentSignalInstance* signal = pin->getComponentSignalInstance();
+            if (signal && (!connectedSignals.contains(signal))) {
+                connectedSignals.insert(signal);
+                data.signalConnections.append(Data::SignalConnection{
+                    signal->getComponentInstance().getUuid(),
+                    signal->getCompSignal().getUuid(), netpoint->getNetSignal().getUuid()});
+            }
+        } else {
+            data.netPoints.append(Data::NetPoint{netpoint->getUuid(),
+                netpoint->getNetSignal().getUuid(), Uuid(), Uuid(),
+                netpoint->getPosition()});
+        }
+    }
+
+    // netlines
+    foreach (const SI_Base* item, items) {
+        if (item->getType() != SI_Base::Type_t::NetLine) continue;
+        const SI_NetLine* netline = dynamic_cast<const SI_NetLine*>(item); Q_ASSERT(netline);
+        data.netLines.append(Data::NetLine{netline->getStartPoint().getUuid(),
+                                           netline->getEndPoint().getUuid()});
+    }
+
+    // netlabels
+    foreach (const SI_Base* item, items) {
+        if (item->getType() != SI_Base::Type_t::NetLabel) continue;
+        const SI_NetLabel* netlabel = dynamic_cast<const SI_NetLabel*>(item); Q_ASSERT(netlabel);
+        addNetSignal(netlabel->getNetSignal());
+        data.netLabels.append(Data::NetLabel{netlabel->getNetSignal().getUuid(),
+            netlabel->getPosition(), netlabel->getRotation()});
+    }
+
+    return data;
+}
 
 /*****************************************************************************************
  *  End of File
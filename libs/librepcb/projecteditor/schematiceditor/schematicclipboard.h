@@ -25,14 +25,13 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/units/all_length_units.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
-
-class DomElement;
-
 namespace project {
 
 class Schematic;
@@ -44,7 +43,12 @@ namespace editor {
  ****************************************************************************************/
 
 /**
- * @brief The SchematicClipboard class
+ * @brief The SchematicClipboard class copies schematic items to the system clipboard
+ *
+ * The selected items are captured as a compact binary snapshot (see #Data) with the
+ * MIME type #getMimeType(). Items refer to each other by their original UUIDs, which
+ * are replaced by new ones when pasting (see
+ * librepcb::project::editor::CmdPasteSchematicItems).
  *
  * @author ubruhin
  * @author 2015-03-07
@@ -55,28 +59,115 @@ class SchematicClipboard final : public QObject
 
     public:
 
+        // Types
+
+        /**
+         * @brief The snapshot of the copied items
+         *
+         * All positions are absolute, #cursorPos is the cursor position at the time
+         * the items were copied (used as the reference point for pasting).
+         */
+        struct Data {
+            struct Component {
+                Uuid uuid;
+                Uuid libComponent;
+                Uuid symbVar;
+                QString value;
+            };
+            struct NetSignal {
+                Uuid uuid;
+                Uuid netClass;
+                QString name;
+                bool hasAutoName;
+            };
+            struct SignalConnection {
+                Uuid component;
+                Uuid signal; ///< UUID of the library component signal
+                Uuid netSignal;
+            };
+            struct Symbol {
+                Uuid uuid;
+                Uuid component;
+                Uuid symbolItem;
+                Point position;
+                Angle rotation;
+            };
+            struct NetPoint {
+                Uuid uuid;
+                Uuid netSignal;
+                Uuid symbol; ///< null if the netpoint is not attached to a copied pin
+                Uuid pin; ///< UUID of the library symbol pin
+                Point position;
+            };
+            struct NetLine {
+                Uuid startPoint;
+                Uuid endPoint;
+            };
+            struct NetLabel {
+                Uuid netSignal;
+                Point position;
+                Angle rotation;
+            };
+
+            Point cursorPos;
+            QVector<Component> components;
+            QVector<NetSignal> netSignals;
+            QVector<SignalConnection> signalConnections;
+            QVector<Symbol> symbols;
+            QVector<NetPoint> netPoints;
+            QVector<NetLine> netLines;
+            QVector<NetLabel> netLabels;
+
+            int getItemCount() const noexcept {
+                return symbols.count() + netPoints.count() + netLines.count() + netLabels.count();
+            }
+        };
+
+
         // General Methods
-        //void clear() noexcept;
-        //void cut(const QList<SymbolInstance*>& symbols);
-        //void copy(const QList<SymbolInstance*>& symbols);
-        //void paste(Schematic& schematic, QList<SymbolInstance*>& symbols);
+
+        /**
+         * @brief Copy the selected items of a schematic to the system clipboard
+         *
+         * @param schematic     The schematic containing the selected items
+         * @param cursorPos     The reference position for pasting
+         *
+         * @return The number of copied items (nothing is copied if zero)
+         */
+        int copy(const Schematic& schematic, const Point& cursorPos) noexcept;
+
+        /**
+         * @brief Check whether the system clipboard contains schematic items
+         */
+        bool hasData() const noexcept;
+
+        /**
+         * @brief Get the items from the system clipboard
+         *
+         * @return The copied items
+         *
+         * @throw Exception If the clipboard contains no (or invalid) schematic items
+         */
+        Data getData() const;
 
 
         // Static Methods
         static SchematicClipboard& instance() noexcept {static SchematicClipboard i; return i;}
+        static QString getMimeType() noexcept {return QStringLiteral("application/x-librepcb-schematic-items");}
+        static QByteArray serialize(const Data& data) noexcept;
+        static Data deserialize(const QByteArray& bytes);
 
     private:
 
         // Private Methods
         SchematicClipboard() noexcept;
         ~SchematicClipboard() noexcept;
-        //void setElements(const QList<SymbolInstance*>& symbols);
-
+        static Data captureSelectedItems(const Schematic& schematic) noexcept;
 
-        // Attributes
-        bool mCutActive;
-        //QList<DomElement*> mSymbolInstances;
 
+        // Constants
+        static constexpr quint32 sMagic = 0x4C505343; ///< "LPSC"
+        static constexpr quint16 sVersion = 1;
 };
 
 /*****************************************************************************************
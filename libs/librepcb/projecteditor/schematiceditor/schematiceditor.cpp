@@ -32,6 +32,8 @@
 #include <librepcb/common/utils/undostackactiongroup.h>
 #include <librepcb/common/utils/exclusiveactiongroup.h>
 #include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/items/si_symbol.h>
+#include <librepcb/project/circuit/componentinstance.h>
 #include "schematicpagesdock.h"
 #include "../docks/ercmsgdock.h"
 #include "fsm/ses_fsm.h"
@@ -42,6 +44,7 @@
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/gridproperties.h>
 #include <librepcb/project/schematics/cmd/cmdschematicadd.h>
+#include "../cmd/cmdcleanupschematicnetlines.h"
 #include "../projecteditor.h"
 
 /*****************************************************************************************
@@ -86,6 +89,10 @@ SchematicEditor::SchematicEditor(ProjectEditor& projectEditor, Project& project)
 
     // connect some actions which are created with the Qt Designer
     connect(mUi->actionSave_Project, &QAction::triggered, &mProjectEditor, &ProjectEditor::saveProject);
+    connect(mUi->actionReload_Project, &QAction::triggered,
+            this, [this](){mProjectEditor.reloadFromDisk(this);});
+    connect(mUi->actionExportArchive, &QAction::triggered,
+            this, [this](){mProjectEditor.execExportArchiveDialog(this);});
     connect(mUi->actionQuit, &QAction::triggered, this, &SchematicEditor::close);
     connect(mUi->actionAbout_Qt, &QAction::triggered, qApp, &QApplication::aboutQt);
     connect(mUi->actionZoom_In, &QAction::triggered, mGraphicsView, &GraphicsView::zoomIn);
@@ -97,6 +104,8 @@ SchematicEditor::SchematicEditor(ProjectEditor& projectEditor, Project& project)
             &mProjectEditor, &ProjectEditor::showBoardEditor);
     connect(mUi->actionEditNetclasses, &QAction::triggered,
             [this](){mProjectEditor.execNetClassesEditorDialog(this);});
+    connect(mUi->actionEditComponentAttributes, &QAction::triggered,
+            [this](){mProjectEditor.execBulkAttributeEditorDialog(this);});
     connect(mUi->actionProjectSettings, &QAction::triggered,
             [this](){mProjectEditor.execProjectSettingsDialog(this);});
 
@@ -246,6 +255,38 @@ void SchematicEditor::abortAllCommands() noexcept
     mFsm->processEvent(new SEE_Base(SEE_Base::AbortCommand), true);
 }
 
+bool SchematicEditor::showComponentInstance(const ComponentInstance& component) noexcept
+{
+    QList<SI_Symbol*> symbols = component.getRegisteredSymbols().values();
+    if (symbols.isEmpty()) return false;
+
+    // all symbols of a component are placed in the same schematic
+    abortAllCommands();
+    Schematic& schematic = symbols.first()->getSchematic();
+    if (!setActiveSchematicIndex(mProject.getSchematicIndex(schematic))) return false;
+
+    // select the symbols
+    QRectF rect;
+    schematic.clearSelection();
+    foreach (SI_Symbol* symbol, symbols) {
+        symbol->setSelected(true);
+        rect |= symbol->getGrabAreaScenePx().boundingRect();
+    }
+
+    // scroll to the symbols, but keep the zoom level if they fit into the view
+    QRectF visibleRect = mGraphicsView->getVisibleSceneRect();
+    if (!visibleRect.contains(rect)) {
+        if ((rect.width() < visibleRect.width()) && (rect.height() < visibleRect.height())) {
+            visibleRect.moveCenter(rect.center());
+        } else {
+            visibleRect = rect.adjusted(-rect.width() / 4, -rect.height() / 4,
+                                        rect.width() / 4, rect.height() / 4);
+        }
+        mGraphicsView->setVisibleSceneRect(visibleRect);
+    }
+    return true;
+}
+
 /*****************************************************************************************
  *  Inherited Methods
  ****************************************************************************************/
@@ -380,14 +421,32 @@ void SchematicEditor::on_actionProjectProperties_triggered()
     dialog.exec();
 }
 
+void SchematicEditor::on_actionCleanUpNetLines_triggered()
+{
+    Schematic* schematic = getActiveSchematic();
+    if (!schematic) return;
+
+    try {
+        int netLineCount = schematic->getNetLines().count();
+        int netPointCount = schematic->getNetPoints().count();
+        mProjectEditor.getUndoStack().execCmd(new CmdCleanUpSchematicNetLines(*schematic)); // can throw
+        mUi->statusbar->showMessage(QString(tr("Net lines cleaned up: %1 net line(s) and "
+            "%2 net point(s) removed")).arg(netLineCount - schematic->getNetLines().count())
+            .arg(netPointCount - schematic->getNetPoints().count()), 5000);
+    } catch (Exception& e) {
+        QMessageBox::critical(this, tr("Error"), e.getMsg());
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
 bool SchematicEditor::graphicsViewEventHandler(QEvent* event)
 {
-    SEE_RedirectedQEvent* e = new SEE_RedirectedQEvent(SEE_Base::GraphicsViewEvent, event);
-    return mFsm->processEvent(e, true);
+    // this is called very often (e.g. mouse moves), so avoid an allocation per event
+    SEE_RedirectedQEvent e(SEE_Base::GraphicsViewEvent, event);
+    return mFsm->processEvent(&e, false);
 }
 
 void SchematicEditor::toolActionGroupChangeTriggered(const QVariant& newTool) noexcept
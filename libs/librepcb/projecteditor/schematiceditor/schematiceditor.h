@@ -41,6 +41,7 @@ namespace project {
 
 class Project;
 class Schematic;
+class ComponentInstance;
 
 namespace editor {
 
@@ -83,6 +84,18 @@ class SchematicEditor final : public QMainWindow, public IF_GraphicsViewEventHan
         // General Methods
         void abortAllCommands() noexcept;
 
+        /**
+         * @brief Show and select all symbols of a component (e.g. for cross-probing)
+         *
+         * Switches to the schematic page containing the symbols, replaces the current
+         * selection by the symbols and scrolls the view to them.
+         *
+         * @param component     The component to show
+         *
+         * @return false if the component has no symbols or the page could not be switched
+         */
+        bool showComponentInstance(const ComponentInstance& component) noexcept;
+
     protected:
 
         void closeEvent(QCloseEvent* event);
@@ -101,6 +114,7 @@ class SchematicEditor final : public QMainWindow, public IF_GraphicsViewEventHan
         void on_actionAddComp_gnd_triggered();
         void on_actionAddComp_vcc_triggered();
         void on_actionProjectProperties_triggered();
+        void on_actionCleanUpNetLines_triggered();
 
 
     signals:
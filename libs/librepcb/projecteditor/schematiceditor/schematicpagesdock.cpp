@@ -27,10 +27,12 @@
 #include <librepcb/project/project.h>
 #include <librepcb/project/schematics/schematic.h>
 #include "schematiceditor.h"
+#include "schematicthumbnails.h"
 #include <librepcb/project/schematics/cmd/cmdschematicadd.h>
 #include <librepcb/project/schematics/cmd/cmdschematicremove.h>
 #include <librepcb/common/undostack.h>
 #include "../projecteditor.h"
+#include <librepcb/workspace/workspace.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -48,6 +50,13 @@ SchematicPagesDock::SchematicPagesDock(Project& project, SchematicEditor& editor
 {
     mUi->setupUi(this);
 
+    // the thumbnails are rendered in the background and updated after modifications
+    mThumbnails.reset(new SchematicThumbnails(mProject,
+        mEditor.getProjectEditor().getUndoStack(),
+        mEditor.getProjectEditor().getWorkspace().getJobScheduler()));
+    connect(mThumbnails.data(), &SchematicThumbnails::thumbnailReady,
+            this, &SchematicPagesDock::thumbnailReady);
+
     // add all schematics to list widget
     for (int i = 0; i < mProject.getSchematics().count(); i++)
         schematicAdded(i);
@@ -64,6 +73,7 @@ SchematicPagesDock::SchematicPagesDock(Project& project, SchematicEditor& editor
 
 SchematicPagesDock::~SchematicPagesDock()
 {
+    mThumbnails.reset();
     delete mUi;         mUi = 0;
 }
 
@@ -98,7 +108,7 @@ void SchematicPagesDock::schematicAdded(int newIndex)
 
     QListWidgetItem* item = new QListWidgetItem();
     item->setText(QString("%1: %2").arg(newIndex+1).arg(schematic->getName()));
-    item->setIcon(schematic->getIcon());
+    item->setIcon(QPixmap::fromImage(mThumbnails->getThumbnail(*schematic)));
     mUi->listWidget->insertItem(newIndex, item);
 }
 
@@ -153,6 +163,22 @@ void SchematicPagesDock::on_listWidget_currentRowChanged(int currentRow)
     mEditor.setActiveSchematicIndex(currentRow);
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void SchematicPagesDock::thumbnailReady(const Uuid& uuid) noexcept
+{
+    for (int i = 0; i < mProject.getSchematics().count(); ++i) {
+        Schematic* schematic = mProject.getSchematicByIndex(i);
+        QListWidgetItem* item = mUi->listWidget->item(i);
+        if (schematic && item && (schematic->getUuid() == uuid)) {
+            item->setIcon(QPixmap::fromImage(mThumbnails->getThumbnail(*schematic)));
+            break;
+        }
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
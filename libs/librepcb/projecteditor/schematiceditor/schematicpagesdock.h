@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <librepcb/common/uuid.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -37,6 +38,7 @@ class Project;
 namespace editor {
 
 class SchematicEditor;
+class SchematicThumbnails;
 
 namespace Ui {
 class SchematicPagesDock;
@@ -82,10 +84,13 @@ class SchematicPagesDock final : public QDockWidget
         SchematicPagesDock(const SchematicPagesDock& other);
         SchematicPagesDock& operator=(const SchematicPagesDock& rhs);
 
+        void thumbnailReady(const Uuid& uuid) noexcept;
+
         // General
         Project& mProject;
         SchematicEditor& mEditor;
         Ui::SchematicPagesDock* mUi;
+        QScopedPointer<SchematicThumbnails> mThumbnails;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,311 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "schematicthumbnails.h"
+#include <librepcb/common/undostack.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/schematiclayerprovider.h>
+#include <librepcb/project/schematics/items/si_symbol.h>
+#include <librepcb/project/schematics/items/si_netpoint.h>
+#include <librepcb/project/schematics/items/si_netline.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Struct SchematicThumbnails::Page
+ ****************************************************************************************/
+
+/**
+ * @brief The primitives of a schematic page to render (in scene pixels)
+ *
+ * Only contains implicitly shared Qt value types, so it can be passed to the worker
+ * thread without accessing the project there.
+ */
+struct SchematicThumbnails::Page {
+    QVector<QPainterPath> symbols;
+    QVector<QLineF> netLines;
+    QVector<QPointF> junctions;
+    QColor symbolColor;
+    QColor netLineColor;
+};
+
+/*****************************************************************************************
+ *  Class SchematicThumbnails::Job
+ ****************************************************************************************/
+
+class SchematicThumbnails::Job final : public QRunnable
+{
+    public:
+        Job(SchematicThumbnails& thumbnails, const QString& key, uint hash,
+            const Page& page) noexcept :
+            QRunnable(), mThumbnails(thumbnails), mKey(key), mHash(hash), mPage(page) {}
+
+        void run() override {
+            emit mThumbnails.jobFinished(mKey, mHash, render());
+        }
+
+    private:
+        QImage render() const noexcept {
+            QImage image(getThumbnailSize(), QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::white);
+
+            QRectF sourceRect;
+            foreach (const QPainterPath& path, mPage.symbols) {
+                sourceRect = sourceRect.united(path.boundingRect());
+            }
+            foreach (const QLineF& line, mPage.netLines) {
+                sourceRect = sourceRect.united(QRectF(line.p1(), line.p2()).normalized());
+            }
+            if (sourceRect.isEmpty()) {
+                return image; // empty page
+            }
+            qreal margin = qMax(sourceRect.width(), sourceRect.height()) / 20;
+            sourceRect.adjust(-margin, -margin, margin, margin);
+            qreal scale = qMin(image.width() / sourceRect.width(),
+                               image.height() / sourceRect.height());
+
+            QPainter painter(&image);
+            painter.setRenderHints(QPainter::Antialiasing);
+            painter.translate(image.width() / 2.0, image.height() / 2.0);
+            painter.scale(scale, scale);
+            painter.translate(-sourceRect.center());
+            painter.setBrush(Qt::NoBrush);
+            painter.setPen(QPen(mPage.symbolColor, 0)); // cosmetic pen
+            foreach (const QPainterPath& path, mPage.symbols) {
+                painter.drawPath(path);
+            }
+            painter.setPen(QPen(mPage.netLineColor, 0)); // cosmetic pen
+            painter.drawLines(mPage.netLines);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(mPage.netLineColor);
+            qreal radius = 1.5 / scale; // in image pixels
+            foreach (const QPointF& junction, mPage.junctions) {
+                painter.drawEllipse(junction, radius, radius);
+            }
+            painter.end();
+            return image;
+        }
+
+        SchematicThumbnails& mThumbnails;
+        QString mKey;
+        uint mHash;
+        Page mPage;
+};
+
+/*****************************************************************************************
+ *  Hash Helpers
+ ****************************************************************************************/
+
+static void hashCombine(uint& seed, uint value) noexcept
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+static void hashCombine(uint& seed, const Point& point) noexcept
+{
+    hashCombine(seed, qHash(point.getX().toNm()));
+    hashCombine(seed, qHash(point.getY().toNm()));
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+SchematicThumbnails::SchematicThumbnails(Project& project, UndoStack& undoStack,
+                                         JobScheduler& scheduler) noexcept :
+    QObject(nullptr), mProject(project),
+    mJobs(scheduler, JobScheduler::Priority::Visible, 1)
+{
+    connect(this, &SchematicThumbnails::jobFinished,
+            this, &SchematicThumbnails::jobFinishedHandler, Qt::QueuedConnection);
+
+    // update the thumbnails when the modifications have settled
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(500);
+    connect(&mUpdateTimer, &QTimer::timeout,
+            this, &SchematicThumbnails::updateOutdatedThumbnails);
+    connect(&undoStack, &UndoStack::stateModified,
+            &mUpdateTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(&mProject, &Project::schematicAdded,
+            &mUpdateTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(&mProject, &Project::schematicRemoved,
+            &mUpdateTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+
+    updateOutdatedThumbnails();
+}
+
+SchematicThumbnails::~SchematicThumbnails() noexcept
+{
+    mJobs.cancel(); // remove all jobs which are not yet started
+    mJobs.waitForDone();
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QImage SchematicThumbnails::getThumbnail(const Schematic& schematic) const noexcept
+{
+    return mThumbnails.value(schematic.getUuid().toStr()).image;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void SchematicThumbnails::updateOutdatedThumbnails() noexcept
+{
+    QSet<QString> keys;
+    QHash<const library::Symbol*, QPainterPath> symbolPaths; // shared by all pages
+    foreach (const Schematic* schematic, mProject.getSchematics()) {
+        QString key = schematic->getUuid().toStr();
+        keys.insert(key);
+        uint hash = calcPageHash(*schematic);
+        bool upToDate = mPendingJobs.contains(key)
+            ? (mPendingJobs.value(key) == hash)
+            : (mThumbnails.contains(key) && (mThumbnails.value(key).hash == hash));
+        if (!upToDate) {
+            mPendingJobs.insert(key, hash);
+            mJobs.start(new Job(*this, key, hash, collectPage(*schematic, symbolPaths)));
+        }
+    }
+
+    // forget the thumbnails of removed pages
+    foreach (const QString& key, mThumbnails.keys()) {
+        if (!keys.contains(key)) {
+            mThumbnails.remove(key);
+        }
+    }
+}
+
+void SchematicThumbnails::jobFinishedHandler(const QString& key, uint hash,
+                                             const QImage& image) noexcept
+{
+    // an outdated image is still better than no image, until the newer one is rendered
+    if (mPendingJobs.value(key) == hash) {
+        mPendingJobs.remove(key);
+    }
+    mThumbnails.insert(key, Thumbnail{hash, image});
+    emit thumbnailReady(Uuid(key));
+}
+
+SchematicThumbnails::Page SchematicThumbnails::collectPage(const Schematic& schematic,
+    QHash<const library::Symbol*, QPainterPath>& symbolPaths) const noexcept
+{
+    Page page;
+    GraphicsLayer* symbolLayer = mProject.getLayers().getLayer(GraphicsLayer::sSymbolOutlines);
+    GraphicsLayer* netLineLayer = mProject.getLayers().getLayer(GraphicsLayer::sSchematicNetLines);
+    page.symbolColor = symbolLayer ? symbolLayer->getColor() : QColor(Qt::darkRed);
+    page.netLineColor = netLineLayer ? netLineLayer->getColor() : QColor(Qt::darkGreen);
+
+    page.symbols.reserve(schematic.getSymbols().count());
+    foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
+        const library::Symbol* libSymbol = &symbol->getLibSymbol();
+        if (!symbolPaths.contains(libSymbol)) {
+            symbolPaths.insert(libSymbol, getSymbolPath(*libSymbol));
+        }
+        QTransform transform;
+        transform.translate(symbol->getPosition().toPxQPointF().x(),
+                            symbol->getPosition().toPxQPointF().y());
+        transform.rotate(-symbol->getRotation().toDeg());
+        page.symbols.append(transform.map(symbolPaths.value(libSymbol)));
+    }
+    page.netLines.reserve(schematic.getNetLines().count());
+    foreach (const SI_NetLine* netline, schematic.getNetLines()) {
+        page.netLines.append(QLineF(netline->getStartPoint().getPosition().toPxQPointF(),
+                                    netline->getEndPoint().getPosition().toPxQPointF()));
+    }
+    foreach (const SI_NetPoint* netpoint, schematic.getNetPoints()) {
+        if (netpoint->isVisibleJunction()) {
+            page.junctions.append(netpoint->getPosition().toPxQPointF());
+        }
+    }
+    return page;
+}
+
+uint SchematicThumbnails::calcPageHash(const Schematic& schematic) noexcept
+{
+    uint hash = 0;
+    foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
+        hashCombine(hash, qHash(symbol->getLibSymbol().getUuid()));
+        hashCombine(hash, qHash(symbol->getLibSymbol().getVersion().toStr()));
+        hashCombine(hash, symbol->getPosition());
+        hashCombine(hash, qHash(symbol->getRotation().toMicroDeg()));
+    }
+    foreach (const SI_NetLine* netline, schematic.getNetLines()) {
+        hashCombine(hash, netline->getStartPoint().getPosition());
+        hashCombine(hash, netline->getEndPoint().getPosition());
+    }
+    foreach (const SI_NetPoint* netpoint, schematic.getNetPoints()) {
+        if (netpoint->isVisibleJunction()) {
+            hashCombine(hash, netpoint->getPosition());
+        }
+    }
+    return hash;
+}
+
+QPainterPath SchematicThumbnails::getSymbolPath(const library::Symbol& symbol) noexcept
+{
+    // the outlines of polygons and ellipses, and the lines of the pins (without texts)
+    QPainterPath path;
+    for (const Polygon& polygon : symbol.getPolygons()) {
+        path.addPath(polygon.toQPainterPathPx());
+    }
+    if (const CompactPolygonList* polygons = symbol.getCompactPolygons()) {
+        for (int i = 0; i < polygons->count(); ++i) {
+            path.addPath(polygons->toQPainterPathPx(i));
+        }
+    }
+    for (const Ellipse& ellipse : symbol.getEllipses()) {
+        QPainterPath ellipsePath;
+        ellipsePath.addEllipse(QPointF(0, 0), ellipse.getRadiusX().toPx(),
+                               ellipse.getRadiusY().toPx());
+        QTransform transform;
+        transform.translate(ellipse.getCenter().toPxQPointF().x(),
+                            ellipse.getCenter().toPxQPointF().y());
+        transform.rotate(-ellipse.getRotation().toDeg());
+        path.addPath(transform.map(ellipsePath));
+    }
+    for (const library::SymbolPin& pin : symbol.getPins()) {
+        Point end = pin.getPosition() + Point(pin.getLength(), 0).rotated(pin.getRotation());
+        path.moveTo(pin.getPosition().toPxQPointF());
+        path.lineTo(end.toPxQPointF());
+    }
+    return path;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,158 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_SCHEMATICTHUMBNAILS_H
+#define LIBREPCB_PROJECT_SCHEMATICTHUMBNAILS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcb/common/jobscheduler.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class UndoStack;
+
+namespace library {
+class Symbol;
+}
+
+namespace project {
+
+class Project;
+class Schematic;
+
+namespace editor {
+
+/*****************************************************************************************
+ *  Class SchematicThumbnails
+ ****************************************************************************************/
+
+/**
+ * @brief The SchematicThumbnails class provides small preview images of all schematic
+ *        pages of a project (e.g. for the page navigator)
+ *
+ * Rendering the graphics scene of a schematic would require to create the graphics
+ * items of every page (which are created lazily when a page is shown the first time)
+ * and blocks the GUI. Instead, the outlines of the symbols, the net lines and the
+ * junctions are collected from the model in the main thread, which is cheap, and
+ * rasterized to a QImage in the workspace's JobScheduler.
+ *
+ * The collected primitives of each page are hashed, and only pages whose hash has
+ * changed are rendered again. The hashes are updated shortly after the undo stack
+ * reported a modification, so editing a page only invalidates the thumbnail of this
+ * particular page.
+ *
+ * If the thumbnail of a page is not available yet, a null image is returned and the
+ * #thumbnailReady() signal is emitted as soon as it has been rendered.
+ *
+ * @note Use this class only from the main thread (the rendering itself runs in the
+ *       worker threads).
+ */
+class SchematicThumbnails final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        SchematicThumbnails() = delete;
+        SchematicThumbnails(const SchematicThumbnails& other) = delete;
+        SchematicThumbnails(Project& project, UndoStack& undoStack,
+                            JobScheduler& scheduler) noexcept;
+        ~SchematicThumbnails() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the thumbnail of a schematic page
+         *
+         * @param schematic     The schematic of the project
+         *
+         * @return The latest rendered thumbnail (may be slightly outdated while the
+         *         page is being rendered again), or a null image if it is not
+         *         available yet
+         */
+        QImage getThumbnail(const Schematic& schematic) const noexcept;
+
+        // Operator Overloadings
+        SchematicThumbnails& operator=(const SchematicThumbnails& rhs) = delete;
+
+        // Static Methods
+        static QSize getThumbnailSize() noexcept {return QSize(297, 210);} // DIN A4 format
+
+
+    signals:
+
+        /**
+         * @brief A (new) thumbnail of a schematic page is available
+         *
+         * @param uuid  The UUID of the schematic
+         */
+        void thumbnailReady(const Uuid& uuid);
+
+        /// Emitted from the worker thread when a job is finished (internal use only)
+        void jobFinished(const QString& key, uint hash, const QImage& image);
+
+
+    private: // Types
+
+        struct Page;
+        class Job;
+
+        struct Thumbnail {
+            uint hash;      ///< hash of the page the image was rendered from
+            QImage image;
+        };
+
+
+    private: // Methods
+
+        void updateOutdatedThumbnails() noexcept;
+        void jobFinishedHandler(const QString& key, uint hash, const QImage& image) noexcept;
+        Page collectPage(const Schematic& schematic,
+            QHash<const library::Symbol*, QPainterPath>& symbolPaths) const noexcept;
+        static uint calcPageHash(const Schematic& schematic) noexcept;
+        static QPainterPath getSymbolPath(const library::Symbol& symbol) noexcept;
+
+
+    private: // Data
+
+        Project& mProject;
+        JobScheduler::Group mJobs;
+        QTimer mUpdateTimer; ///< delays the update after modifications
+        QHash<QString, Thumbnail> mThumbnails; ///< key: UUID of the schematic
+        QHash<QString, uint> mPendingJobs; ///< key: UUID, value: hash of the rendered page
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_SCHEMATICTHUMBNAILS_H
@@ -25,6 +25,7 @@
 #include "favoriteprojectsmodel.h"
 #include "workspace.h"
 #include "settings/workspacesettings.h"
+#include "projectmetadatacache.h"
 #include <librepcb/common/fileio/smarttextfile.h>
 
 /*****************************************************************************************
@@ -40,6 +41,9 @@ namespace workspace {
 FavoriteProjectsModel::FavoriteProjectsModel(const Workspace& workspace) noexcept :
     QAbstractListModel(nullptr), mWorkspace(workspace)
 {
+    connect(&mWorkspace.getProjectMetadataCache(), &ProjectMetadataCache::metadataChanged,
+            this, &FavoriteProjectsModel::projectMetadataChanged);
+
     try {
         FilePath filepath = mWorkspace.getMetadataPath().getPathTo("favorite_projects.txt");
         if (filepath.isExistingFile()) {
@@ -114,6 +118,15 @@ void FavoriteProjectsModel::removeFavoriteProject(const FilePath& filepath) noex
     }
 }
 
+void FavoriteProjectsModel::projectMetadataChanged(const FilePath& projectFile) noexcept
+{
+    for (int i = 0; i < mFavoriteProjects.count(); ++i) {
+        if (mFavoriteProjects.at(i) == projectFile) {
+            emit dataChanged(index(i), index(i));
+        }
+    }
+}
+
 /*****************************************************************************************
  *  Inherited Methods
  ****************************************************************************************/
@@ -131,15 +144,37 @@ QVariant FavoriteProjectsModel::data(const QModelIndex& index, int role) const
     if (!index.isValid())
         return QVariant();
 
+    // only the cached metadata is used to avoid accessing the file system
+    const FilePath& filepath = mFavoriteProjects.at(index.row());
+    ProjectMetadataCache::Metadata metadata =
+        mWorkspace.getProjectMetadataCache().getMetadata(filepath);
+
     switch (role)
     {
         case Qt::DisplayRole:
-            return mFavoriteProjects.at(index.row()).getFilename();
+            return metadata.name.isEmpty() ? filepath.getFilename() : metadata.name;
+
+        case Qt::ToolTipRole:
+        {
+            if (!metadata.exists)
+                return tr("Project not found: %1").arg(filepath.toNative());
+            QString tooltip = metadata.name.isEmpty() ? filepath.getFilename() : metadata.name;
+            if (!metadata.version.isEmpty())
+                tooltip += " (" + metadata.version + ")";
+            if (metadata.lastModified.isValid())
+                tooltip += "\n" + tr("Last modified: %1").arg(metadata.lastModified.toString(Qt::DefaultLocaleShortDate));
+            return tooltip + "\n" + filepath.toNative();
+        }
+
+        case Qt::ForegroundRole:
+            if (!metadata.exists)
+                return QBrush(Qt::gray);
+            return QVariant();
 
         //case Qt::ToolTipRole:
         case Qt::StatusTipRole:
         case Qt::UserRole:
-            return mFavoriteProjects.at(index.row()).toNative();
+            return filepath.toNative();
 
         case Qt::DecorationRole:
             return QIcon(":/img/actions/bookmark.png");
@@ -69,6 +69,7 @@ class FavoriteProjectsModel : public QAbstractListModel
 
         // General Methods
         void save() noexcept;
+        void projectMetadataChanged(const FilePath& projectFile) noexcept;
 
         // Inherited Methods
         int rowCount(const QModelIndex& parent = QModelIndex()) const;
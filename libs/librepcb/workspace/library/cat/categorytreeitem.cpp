@@ -41,36 +41,27 @@ using namespace library;
 template <typename ElementType>
 CategoryTreeItem<ElementType>::CategoryTreeItem(const WorkspaceLibraryDb& library,
         const QStringList localeOrder, CategoryTreeItem* parent, const Uuid& uuid) noexcept :
-    mLocaleOrder(localeOrder), mParent(parent), mUuid(uuid),
-    mDepth(parent ? parent->getDepth() + 1 : 0), mExceptionMessage()
+    mLib(library), mLocaleOrder(localeOrder), mParent(parent), mUuid(uuid),
+    mCategoryFound(false), mDepth(parent ? parent->getDepth() + 1 : 0), mExceptionMessage(),
+    mChildsFetched(false)
 {
     try {
         if (!mUuid.isNull()) {
-            FilePath fp = getLatestCategory(library);
-            if (fp.isValid()) mCategory.reset(new ElementType(fp, true));
-        }
-
-        if ((!mUuid.isNull()) || (!mParent)) {
-            QSet<Uuid> childs = getCategoryChilds(library);
-            foreach (const Uuid& childUuid, childs) {
-                ChildType child(new CategoryTreeItem(library, mLocaleOrder, this, childUuid));
-                mChilds.append(child);
+            FilePath fp = getLatestCategory();
+            if (fp.isValid()) {
+                mLib.getElementTranslations<ElementType>(fp, mLocaleOrder, &mName,
+                                                         &mDescription); // can throw
+                mCategoryFound = true;
             }
-
-            // sort childs
-            qSort(mChilds.begin(), mChilds.end(),
-                  [](const ChildType& a, const ChildType& b)
-                  {return a->data(Qt::DisplayRole) < b->data(Qt::DisplayRole);});
-        }
-
-        if (!mParent) {
-            // add category for elements without category
-            ChildType child(new CategoryTreeItem(library, mLocaleOrder, this, Uuid()));
-            mChilds.append(child);
         }
     } catch (const Exception& e) {
         mExceptionMessage = e.getMsg();
     }
+
+    // the virtual category for elements without category never has childs
+    if (mParent && mUuid.isNull()) {
+        mChildsFetched = true;
+    }
 }
 
 template <typename ElementType>
@@ -97,6 +88,13 @@ int CategoryTreeItem<ElementType>::getChildNumber() const noexcept
     }
 }
 
+template <typename ElementType>
+bool CategoryTreeItem<ElementType>::hasChilds() const noexcept
+{
+    // as long as the childs are not fetched, assume there are some
+    return mChildsFetched ? (!mChilds.isEmpty()) : true;
+}
+
 template <typename ElementType>
 QVariant CategoryTreeItem<ElementType>::data(int role) const noexcept
 {
@@ -105,8 +103,8 @@ QVariant CategoryTreeItem<ElementType>::data(int role) const noexcept
         case Qt::DisplayRole:
             if (mUuid.isNull())
                 return "(Without Category)";
-            else if (mCategory)
-                return mCategory->getNames().value(mLocaleOrder);
+            else if (mCategoryFound)
+                return mName;
             else
                 return "(ERROR)";
 
@@ -120,8 +118,8 @@ QVariant CategoryTreeItem<ElementType>::data(int role) const noexcept
         case Qt::ToolTipRole:
             if (mUuid.isNull())
                 return "All library elements without a category";
-            else if (mCategory)
-                return mCategory->getDescriptions().value(mLocaleOrder);
+            else if (mCategoryFound)
+                return mDescription;
             else
                 return mExceptionMessage;
 
@@ -134,32 +132,73 @@ QVariant CategoryTreeItem<ElementType>::data(int role) const noexcept
     return QVariant();
 }
 
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+template <typename ElementType>
+int CategoryTreeItem<ElementType>::fetchChilds() noexcept
+{
+    if (mChildsFetched) return 0;
+    mChildsFetched = true;
+    mFetchedChilds.clear();
+
+    try {
+        QSet<Uuid> childs = getCategoryChilds(); // can throw
+        foreach (const Uuid& childUuid, childs) {
+            ChildType child(new CategoryTreeItem(mLib, mLocaleOrder, this, childUuid));
+            mFetchedChilds.append(child);
+        }
+
+        // sort childs
+        qSort(mFetchedChilds.begin(), mFetchedChilds.end(),
+              [](const ChildType& a, const ChildType& b)
+              {return a->data(Qt::DisplayRole) < b->data(Qt::DisplayRole);});
+    } catch (const Exception& e) {
+        mExceptionMessage = e.getMsg();
+    }
+
+    if (!mParent) {
+        // add category for elements without category
+        ChildType child(new CategoryTreeItem(mLib, mLocaleOrder, this, Uuid()));
+        mFetchedChilds.append(child);
+    }
+    return mFetchedChilds.count();
+}
+
+template <typename ElementType>
+void CategoryTreeItem<ElementType>::commitFetchedChilds() noexcept
+{
+    mChilds.append(mFetchedChilds);
+    mFetchedChilds.clear();
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
 template <>
-FilePath CategoryTreeItem<ComponentCategory>::getLatestCategory(const WorkspaceLibraryDb& lib) const
+FilePath CategoryTreeItem<ComponentCategory>::getLatestCategory() const
 {
-    return lib.getLatestComponentCategory(mUuid);
+    return mLib.getLatestComponentCategory(mUuid);
 }
 
 template <>
-FilePath CategoryTreeItem<PackageCategory>::getLatestCategory(const WorkspaceLibraryDb& lib) const
+FilePath CategoryTreeItem<PackageCategory>::getLatestCategory() const
 {
-    return lib.getLatestPackageCategory(mUuid);
+    return mLib.getLatestPackageCategory(mUuid);
 }
 
 template <>
-QSet<Uuid> CategoryTreeItem<ComponentCategory>::getCategoryChilds(const WorkspaceLibraryDb& lib) const
+QSet<Uuid> CategoryTreeItem<ComponentCategory>::getCategoryChilds() const
 {
-    return lib.getComponentCategoryChilds(mUuid);
+    return mLib.getComponentCategoryChilds(mUuid);
 }
 
 template <>
-QSet<Uuid> CategoryTreeItem<PackageCategory>::getCategoryChilds(const WorkspaceLibraryDb& lib) const
+QSet<Uuid> CategoryTreeItem<PackageCategory>::getCategoryChilds() const
 {
-    return lib.getPackageCategoryChilds(mUuid);
+    return mLib.getPackageCategoryChilds(mUuid);
 }
 
 /*****************************************************************************************
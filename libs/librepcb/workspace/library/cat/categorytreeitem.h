@@ -46,6 +46,11 @@ class WorkspaceLibraryDb;
 
 /**
  * @brief The CategoryTreeItem class
+ *
+ * The childs of an item are loaded lazily from the #WorkspaceLibraryDb (see
+ * #fetchChilds()), so only the categories which are actually expanded in a view need
+ * to be queried. The names and descriptions are read from the database as well, the
+ * category files are never loaded from disk.
  */
 template <typename ElementType>
 class CategoryTreeItem final
@@ -67,8 +72,24 @@ class CategoryTreeItem final
         CategoryTreeItem* getChild(int index)   const noexcept {return mChilds.value(index).data();}
         int getChildCount()                     const noexcept {return mChilds.count();}
         int getChildNumber()                    const noexcept;
+        bool hasChilds()                        const noexcept;
+        bool canFetchChilds()                   const noexcept {return !mChildsFetched;}
         QVariant data(int role)                 const noexcept;
 
+        // General Methods
+
+        /**
+         * @brief Load the childs from the database
+         *
+         * The loaded childs are not yet visible (#getChildCount() does not change), call
+         * #commitFetchedChilds() to add them. This allows models to call
+         * QAbstractItemModel::beginInsertRows() with the correct row count in between.
+         *
+         * @return The number of loaded childs
+         */
+        int fetchChilds() noexcept;
+        void commitFetchedChilds() noexcept;
+
         // Operator Overloadings
         CategoryTreeItem& operator=(const CategoryTreeItem& rhs) = delete;
 
@@ -79,17 +100,22 @@ class CategoryTreeItem final
         using ChildType = QSharedPointer<CategoryTreeItem<ElementType>>;
 
         // Methods
-        FilePath getLatestCategory(const WorkspaceLibraryDb& lib) const;
-        QSet<Uuid> getCategoryChilds(const WorkspaceLibraryDb& lib) const;
+        FilePath getLatestCategory() const;
+        QSet<Uuid> getCategoryChilds() const;
 
         // Attributes
+        const WorkspaceLibraryDb& mLib;
         QStringList mLocaleOrder;
         CategoryTreeItem* mParent;
         Uuid mUuid;
-        QScopedPointer<ElementType> mCategory;
+        bool mCategoryFound;
+        QString mName;
+        QString mDescription;
         unsigned int mDepth; ///< this is to avoid endless recursion in the parent-child relationship
         QString mExceptionMessage;
+        bool mChildsFetched;
         QList<ChildType> mChilds;
+        QList<ChildType> mFetchedChilds; ///< see #fetchChilds()
 };
 
 typedef CategoryTreeItem<library::ComponentCategory> ComponentCategoryTreeItem;
@@ -42,6 +42,9 @@ CategoryTreeModel<ElementType>::CategoryTreeModel(const WorkspaceLibraryDb& libr
     QAbstractItemModel(nullptr)
 {
     mRootItem.reset(new CategoryTreeItem<ElementType>(library, localeOrder, nullptr, Uuid()));
+    // the top level categories are always needed, deeper levels are fetched on demand
+    mRootItem->fetchChilds();
+    mRootItem->commitFetchedChilds();
 }
 
 template <typename ElementType>
@@ -135,6 +138,38 @@ QVariant CategoryTreeModel<ElementType>::data(const QModelIndex& index, int role
     return item->data(role);
 }
 
+template <typename ElementType>
+bool CategoryTreeModel<ElementType>::hasChildren(const QModelIndex& parent) const
+{
+    if (parent.isValid() && parent.column() != 0)
+        return false;
+
+    CategoryTreeItem<ElementType>* item = getItem(parent);
+    return item->hasChilds();
+}
+
+template <typename ElementType>
+bool CategoryTreeModel<ElementType>::canFetchMore(const QModelIndex& parent) const
+{
+    CategoryTreeItem<ElementType>* item = getItem(parent);
+    return item->canFetchChilds();
+}
+
+template <typename ElementType>
+void CategoryTreeModel<ElementType>::fetchMore(const QModelIndex& parent)
+{
+    CategoryTreeItem<ElementType>* item = getItem(parent);
+    int count = item->fetchChilds();
+    if (count > 0) {
+        beginInsertRows(parent, item->getChildCount(), item->getChildCount() + count - 1);
+        item->commitFetchedChilds();
+        endInsertRows();
+    } else {
+        // update the expand indicator of the item, it has no childs
+        emit dataChanged(parent, parent);
+    }
+}
+
 /*****************************************************************************************
  *  Explicit template instantiations
  ****************************************************************************************/
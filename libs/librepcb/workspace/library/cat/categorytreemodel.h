@@ -62,6 +62,9 @@ class CategoryTreeModel final : public QAbstractItemModel
         virtual QModelIndex parent(const QModelIndex& index) const;
         virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
         virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+        virtual bool hasChildren(const QModelIndex& parent = QModelIndex()) const;
+        virtual bool canFetchMore(const QModelIndex& parent) const;
+        virtual void fetchMore(const QModelIndex& parent);
 
         // Operator Overloadings
         CategoryTreeModel& operator=(const CategoryTreeModel& rhs) = delete;
@@ -36,7 +36,10 @@
 #include <librepcb/library/dev/device.h>
 #include "workspacelibrarydb.h"
 #include "../workspace.h"
+#include "../settings/workspacesettings.h"
 #include "workspacelibraryscanner.h"
+#include "workspacelibrarywatcher.h"
+#include "workspaceprojectindexer.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -51,12 +54,13 @@ using namespace library;
  ****************************************************************************************/
 
 WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws):
-    QObject(nullptr), mWorkspace(ws)
+    QObject(nullptr), mWorkspace(ws),
+    mFilePath(ws.getMetadataPath().getPathTo("library_cache.sqlite")), mScanSuspendCount(0)
 {
     qDebug("Load workspace library database...");
 
     // open SQLite database
-    FilePath dbFilePath = ws.getMetadataPath().getPathTo("library_cache.sqlite");
+    FilePath dbFilePath = mFilePath;
     mDb.reset(new SQLiteDatabase(dbFilePath)); // can throw
 
     // if the db has an old version, just remove the whole db and create a new one
@@ -70,6 +74,10 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws):
         setDbVersion(sCurrentDbVersion); // can throw
     }
 
+    // the precomputed translations are only updated if the locale order has changed
+    mLocaleOrder = readLocaleOrder(*mDb); // can throw
+    setLocaleOrder(mWorkspace.getSettings().getLibLocaleOrder().getLocaleOrder());
+
     // create library scanner object
     mLibraryScanner.reset(new WorkspaceLibraryScanner(mWorkspace));
     connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::started,
@@ -80,12 +88,41 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws):
             this, &WorkspaceLibraryDb::scanSucceeded, Qt::QueuedConnection);
     connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::failed,
             this, &WorkspaceLibraryDb::scanFailed, Qt::QueuedConnection);
+    connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::finished,
+            this, &WorkspaceLibraryDb::libraryScannerFinished, Qt::QueuedConnection);
+
+    // watch the libraries for modifications (the watched directories are updated after
+    // every scan since elements may have been added or removed)
+    mLibraryWatcher.reset(new WorkspaceLibraryWatcher(mWorkspace));
+    connect(mLibraryWatcher.data(), &WorkspaceLibraryWatcher::librariesModified,
+            this, &WorkspaceLibraryDb::startLibraryUpdate);
+    connect(this, &WorkspaceLibraryDb::scanSucceeded,
+            mLibraryWatcher.data(), &WorkspaceLibraryWatcher::updateWatchedDirectories);
+
+    // the cached latest versions are outdated after every scan, even if it failed (the
+    // scanner commits its changes library by library). The cache is cleared in the
+    // scanner thread, i.e. before #scanSucceeded() is received by the GUI thread.
+    connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::succeeded,
+            this, &WorkspaceLibraryDb::clearLatestVersionCache, Qt::DirectConnection);
+    connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::finished,
+            this, &WorkspaceLibraryDb::clearLatestVersionCache, Qt::DirectConnection);
+
+    // record which library elements are used by the projects of the workspace
+    mProjectIndexer.reset(new WorkspaceProjectIndexer(mFilePath, mWorkspace.getJobScheduler()));
+    connect(mProjectIndexer.data(), &WorkspaceProjectIndexer::indexUpdated,
+            this, &WorkspaceLibraryDb::projectIndexUpdated);
+    mProjectIndexer->requestCrawl(mWorkspace.getProjectsPath());
 
     qDebug("Workspace library database successfully loaded!");
 }
 
 WorkspaceLibraryDb::~WorkspaceLibraryDb() noexcept
 {
+    QMutexLocker locker(&mReadOnlyConnectionsMutex);
+    if (!mReadOnlyConnections.isEmpty()) {
+        qWarning() << "Workspace library database is destroyed while"
+                   << mReadOnlyConnections.count() << "worker threads are still running.";
+    }
 }
 
 /*****************************************************************************************
@@ -128,32 +165,72 @@ QMultiMap<Version, FilePath> WorkspaceLibraryDb::getDevices(const Uuid& uuid) co
 
 FilePath WorkspaceLibraryDb::getLatestComponentCategory(const Uuid& uuid) const
 {
-    return getLatestVersionFilePath(getComponentCategories(uuid));
+    return getLatestVersionFilePath("component_categories", uuid);
 }
 
 FilePath WorkspaceLibraryDb::getLatestPackageCategory(const Uuid& uuid) const
 {
-    return getLatestVersionFilePath(getPackageCategories(uuid));
+    return getLatestVersionFilePath("package_categories", uuid);
 }
 
 FilePath WorkspaceLibraryDb::getLatestSymbol(const Uuid& uuid) const
 {
-    return getLatestVersionFilePath(getSymbols(uuid));
+    return getLatestVersionFilePath("symbols", uuid);
 }
 
 FilePath WorkspaceLibraryDb::getLatestPackage(const Uuid& uuid) const
 {
-    return getLatestVersionFilePath(getPackages(uuid));
+    return getLatestVersionFilePath("packages", uuid);
 }
 
 FilePath WorkspaceLibraryDb::getLatestComponent(const Uuid& uuid) const
 {
-    return getLatestVersionFilePath(getComponents(uuid));
+    return getLatestVersionFilePath("components", uuid);
 }
 
 FilePath WorkspaceLibraryDb::getLatestDevice(const Uuid& uuid) const
 {
-    return getLatestVersionFilePath(getDevices(uuid));
+    return getLatestVersionFilePath("devices", uuid);
+}
+
+/*****************************************************************************************
+ *  Getters: Best Match Library Elements of many UUIDs at once
+ ****************************************************************************************/
+
+template <>
+QHash<Uuid, FilePath> WorkspaceLibraryDb::getLatestElements<ComponentCategory>(const QSet<Uuid>& uuids) const
+{
+    return getLatestVersionFilePaths("component_categories", uuids);
+}
+
+template <>
+QHash<Uuid, FilePath> WorkspaceLibraryDb::getLatestElements<PackageCategory>(const QSet<Uuid>& uuids) const
+{
+    return getLatestVersionFilePaths("package_categories", uuids);
+}
+
+template <>
+QHash<Uuid, FilePath> WorkspaceLibraryDb::getLatestElements<Symbol>(const QSet<Uuid>& uuids) const
+{
+    return getLatestVersionFilePaths("symbols", uuids);
+}
+
+template <>
+QHash<Uuid, FilePath> WorkspaceLibraryDb::getLatestElements<Package>(const QSet<Uuid>& uuids) const
+{
+    return getLatestVersionFilePaths("packages", uuids);
+}
+
+template <>
+QHash<Uuid, FilePath> WorkspaceLibraryDb::getLatestElements<Component>(const QSet<Uuid>& uuids) const
+{
+    return getLatestVersionFilePaths("components", uuids);
+}
+
+template <>
+QHash<Uuid, FilePath> WorkspaceLibraryDb::getLatestElements<Device>(const QSet<Uuid>& uuids) const
+{
+    return getLatestVersionFilePaths("devices", uuids);
 }
 
 /*****************************************************************************************
@@ -242,12 +319,84 @@ void WorkspaceLibraryDb::getElementTranslations<Device>(const FilePath& elemDir,
     getElementTranslations("devices", "device_id", elemDir, localeOrder, name, desc, keywords);
 }
 
+template <>
+QHash<FilePath, WorkspaceLibraryDb::ElementTranslations>
+WorkspaceLibraryDb::getElementTranslations<ComponentCategory>(const QList<FilePath>& elemDirs,
+    const QStringList& localeOrder) const
+{
+    return getElementTranslations("component_categories", "cat_id", elemDirs, localeOrder);
+}
+
+template <>
+QHash<FilePath, WorkspaceLibraryDb::ElementTranslations>
+WorkspaceLibraryDb::getElementTranslations<PackageCategory>(const QList<FilePath>& elemDirs,
+    const QStringList& localeOrder) const
+{
+    return getElementTranslations("package_categories", "cat_id", elemDirs, localeOrder);
+}
+
+template <>
+QHash<FilePath, WorkspaceLibraryDb::ElementTranslations>
+WorkspaceLibraryDb::getElementTranslations<Symbol>(const QList<FilePath>& elemDirs,
+    const QStringList& localeOrder) const
+{
+    return getElementTranslations("symbols", "symbol_id", elemDirs, localeOrder);
+}
+
+template <>
+QHash<FilePath, WorkspaceLibraryDb::ElementTranslations>
+WorkspaceLibraryDb::getElementTranslations<Package>(const QList<FilePath>& elemDirs,
+    const QStringList& localeOrder) const
+{
+    return getElementTranslations("packages", "package_id", elemDirs, localeOrder);
+}
+
+template <>
+QHash<FilePath, WorkspaceLibraryDb::ElementTranslations>
+WorkspaceLibraryDb::getElementTranslations<Component>(const QList<FilePath>& elemDirs,
+    const QStringList& localeOrder) const
+{
+    return getElementTranslations("components", "component_id", elemDirs, localeOrder);
+}
+
+template <>
+QHash<FilePath, WorkspaceLibraryDb::ElementTranslations>
+WorkspaceLibraryDb::getElementTranslations<Device>(const QList<FilePath>& elemDirs,
+    const QStringList& localeOrder) const
+{
+    return getElementTranslations("devices", "device_id", elemDirs, localeOrder);
+}
+
+QHash<FilePath, Uuid> WorkspaceLibraryDb::getDeviceMetadata(const QList<FilePath>& devDirs) const
+{
+    QHash<FilePath, Uuid> pkgUuids;
+    for (int offset = 0; offset < devDirs.count(); offset += sMaxFilePathsPerQuery) {
+        QHash<QString, FilePath> devDirsByRelPath;
+        QString placeholders = prepareFilePathPlaceholders(devDirs, offset, devDirsByRelPath);
+        QSqlQuery query = getConnection().prepareQuery(
+            "SELECT filepath, package_uuid FROM devices "
+            "WHERE filepath IN (" % placeholders % ")");
+        int i = 0;
+        foreach (const QString& relPath, devDirsByRelPath.keys()) {
+            query.bindValue(QString(":filepath%1").arg(i++), relPath);
+        }
+        getConnection().exec(query);
+
+        while (query.next()) {
+            Uuid uuid(query.value(1).toString());
+            if (uuid.isNull()) throw LogicError(__FILE__, __LINE__);
+            pkgUuids.insert(devDirsByRelPath.value(query.value(0).toString()), uuid);
+        }
+    }
+    return pkgUuids;
+}
+
 void WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir, Uuid* pkgUuid) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getConnection().prepareQuery(
         "SELECT package_uuid FROM devices WHERE filepath = :filepath");
     query.bindValue(":filepath", devDir.toRelative(mWorkspace.getLibrariesPath()));
-    mDb->exec(query);
+    getConnection().exec(query);
 
     Uuid uuid = query.first() ? Uuid(query.value(0).toString()) : Uuid();
     if (uuid.isNull()) {
@@ -258,6 +407,171 @@ void WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir, Uuid* pkgUuid
     if (pkgUuid) *pkgUuid = uuid;
 }
 
+void WorkspaceLibraryDb::getLibraryMetadata(const FilePath& libDir, Uuid* uuid,
+                                            Version* version) const
+{
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT uuid, version FROM libraries WHERE filepath = :filepath");
+    query.bindValue(":filepath", libDir.toRelative(mWorkspace.getLibrariesPath()));
+    getConnection().exec(query);
+
+    Uuid libUuid = query.first() ? Uuid(query.value(0).toString()) : Uuid();
+    if (libUuid.isNull()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr(
+            "Library not found in workspace library: \"%1\"")).arg(libDir.toNative()));
+    }
+
+    if (uuid) *uuid = libUuid;
+    if (version) *version = Version(query.value(1).toString());
+}
+
+/*****************************************************************************************
+ *  Getters: Search
+ ****************************************************************************************/
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::searchElements<ComponentCategory>(const QString& query,
+    const QStringList& localeOrder, int limit, int offset) const
+{
+    return searchElements("component_categories", "cat_id", query, localeOrder, limit, offset);
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::searchElements<PackageCategory>(const QString& query,
+    const QStringList& localeOrder, int limit, int offset) const
+{
+    return searchElements("package_categories", "cat_id", query, localeOrder, limit, offset);
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::searchElements<Symbol>(const QString& query,
+    const QStringList& localeOrder, int limit, int offset) const
+{
+    return searchElements("symbols", "symbol_id", query, localeOrder, limit, offset);
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::searchElements<Package>(const QString& query,
+    const QStringList& localeOrder, int limit, int offset) const
+{
+    return searchElements("packages", "package_id", query, localeOrder, limit, offset);
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::searchElements<Component>(const QString& query,
+    const QStringList& localeOrder, int limit, int offset) const
+{
+    return searchElements("components", "component_id", query, localeOrder, limit, offset);
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::searchElements<Device>(const QString& query,
+    const QStringList& localeOrder, int limit, int offset) const
+{
+    return searchElements("devices", "device_id", query, localeOrder, limit, offset);
+}
+
+/*****************************************************************************************
+ *  Getters: Parametric Search
+ ****************************************************************************************/
+
+QStringList WorkspaceLibraryDb::getComponentAttributeKeys() const
+{
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT DISTINCT key FROM components_attr ORDER BY key");
+    getConnection().exec(query);
+
+    QStringList keys;
+    while (query.next()) {
+        keys.append(query.value(0).toString());
+    }
+    return keys;
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getComponentsByAttribute(const QString& key,
+                                                        qreal minSiValue,
+                                                        qreal maxSiValue) const
+{
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT DISTINCT components.uuid FROM components_attr "
+        "INNER JOIN components ON components.id = components_attr.component_id "
+        "WHERE components_attr.key = :key "
+        "AND components_attr.si_value BETWEEN :min AND :max");
+    query.bindValue(":key", key);
+    query.bindValue(":min", minSiValue);
+    query.bindValue(":max", maxSiValue);
+    getConnection().exec(query);
+    return getUuidsFromQuery(query);
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getComponentsByAttribute(const QString& key,
+                                                        const QString& value) const
+{
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT DISTINCT components.uuid FROM components_attr "
+        "INNER JOIN components ON components.id = components_attr.component_id "
+        "WHERE components_attr.key = :key AND components_attr.value = :value");
+    query.bindValue(":key", key);
+    query.bindValue(":value", value);
+    getConnection().exec(query);
+    return getUuidsFromQuery(query);
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getDevicesByComponentAttribute(const QString& key,
+                                                              qreal minSiValue,
+                                                              qreal maxSiValue) const
+{
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT DISTINCT devices.uuid FROM components_attr "
+        "INNER JOIN components ON components.id = components_attr.component_id "
+        "INNER JOIN devices ON devices.component_uuid = components.uuid "
+        "WHERE components_attr.key = :key "
+        "AND components_attr.si_value BETWEEN :min AND :max");
+    query.bindValue(":key", key);
+    query.bindValue(":min", minSiValue);
+    query.bindValue(":max", maxSiValue);
+    getConnection().exec(query);
+    return getUuidsFromQuery(query);
+}
+
+/*****************************************************************************************
+ *  Getters: Resolved Metadata
+ ****************************************************************************************/
+
+QStringList WorkspaceLibraryDb::getLocaleOrder() const noexcept
+{
+    QMutexLocker locker(&mLocaleOrderMutex);
+    return mLocaleOrder;
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::getElementsByCategorySortedByName<Symbol>(
+    const Uuid& category) const
+{
+    return getElementsByCategorySortedByName("symbols", "symbol_id", category);
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::getElementsByCategorySortedByName<Package>(
+    const Uuid& category) const
+{
+    return getElementsByCategorySortedByName("packages", "package_id", category);
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::getElementsByCategorySortedByName<Component>(
+    const Uuid& category) const
+{
+    return getElementsByCategorySortedByName("components", "component_id", category);
+}
+
+template <>
+QList<Uuid> WorkspaceLibraryDb::getElementsByCategorySortedByName<Device>(
+    const Uuid& category) const
+{
+    return getElementsByCategorySortedByName("devices", "device_id", category);
+}
+
 /*****************************************************************************************
  *  Getters: Special
  ****************************************************************************************/
@@ -302,12 +616,46 @@ QSet<Uuid> WorkspaceLibraryDb::getDevicesByCategory(const Uuid& category) const
     return getElementsByCategory("devices", "device_id", category);
 }
 
+QSet<Uuid> WorkspaceLibraryDb::getComponentCategorySubtree(const Uuid& category) const
+{
+    return getCategorySubtree("component_categories", category);
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getPackageCategorySubtree(const Uuid& category) const
+{
+    return getCategorySubtree("package_categories", category);
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getSymbolsInCategorySubtree(const Uuid& category) const
+{
+    return getElementsInCategorySubtree("symbols", "symbol_id", "component_categories",
+                                        category);
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getPackagesInCategorySubtree(const Uuid& category) const
+{
+    return getElementsInCategorySubtree("packages", "package_id", "package_categories",
+                                        category);
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getComponentsInCategorySubtree(const Uuid& category) const
+{
+    return getElementsInCategorySubtree("components", "component_id", "component_categories",
+                                        category);
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getDevicesInCategorySubtree(const Uuid& category) const
+{
+    return getElementsInCategorySubtree("devices", "device_id", "component_categories",
+                                        category);
+}
+
 QSet<Uuid> WorkspaceLibraryDb::getDevicesOfComponent(const Uuid& component) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getConnection().prepareQuery(
         "SELECT uuid FROM devices WHERE component_uuid = :uuid");
     query.bindValue(":uuid", component.toStr());
-    mDb->exec(query);
+    getConnection().exec(query);
 
     QSet<Uuid> elements;
     while (query.next()) {
@@ -321,29 +669,254 @@ QSet<Uuid> WorkspaceLibraryDb::getDevicesOfComponent(const Uuid& component) cons
     return elements;
 }
 
+/*****************************************************************************************
+ *  Getters: Where-Used Index
+ ****************************************************************************************/
+
+QSet<Uuid> WorkspaceLibraryDb::getDevicesOfPackage(const Uuid& package) const
+{
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT uuid FROM devices WHERE package_uuid = :uuid");
+    query.bindValue(":uuid", package.toStr());
+    getConnection().exec(query);
+    return getUuidsFromQuery(query);
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getComponentsOfSymbol(const Uuid& symbol) const
+{
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT DISTINCT components.uuid FROM components_sym "
+        "INNER JOIN components ON components.id = components_sym.component_id "
+        "WHERE components_sym.symbol_uuid = :uuid");
+    query.bindValue(":uuid", symbol.toStr());
+    getConnection().exec(query);
+    return getUuidsFromQuery(query);
+}
+
+QSet<FilePath> WorkspaceLibraryDb::getProjectsUsingElements(const QSet<Uuid>& uuids) const
+{
+    QSet<FilePath> projects;
+    QList<Uuid> uuidList = uuids.toList();
+    for (int offset = 0; offset < uuidList.count(); offset += sMaxFilePathsPerQuery) {
+        QList<Uuid> chunk = uuidList.mid(offset, sMaxFilePathsPerQuery);
+        QStringList placeholders;
+        for (int i = 0; i < chunk.count(); ++i) {
+            placeholders.append(QString(":uuid%1").arg(i));
+        }
+        QSqlQuery query = getConnection().prepareQuery(
+            "SELECT DISTINCT projects.filepath FROM projects_elements "
+            "INNER JOIN projects ON projects.id = projects_elements.project_id "
+            "WHERE projects_elements.uuid IN (" % placeholders.join(", ") % ")");
+        for (int i = 0; i < chunk.count(); ++i) {
+            query.bindValue(placeholders.at(i), chunk.at(i).toStr());
+        }
+        getConnection().exec(query);
+        while (query.next()) {
+            FilePath filepath(query.value(0).toString());
+            if (filepath.isValid()) {
+                projects.insert(filepath);
+            } else {
+                throw LogicError(__FILE__, __LINE__);
+            }
+        }
+    }
+    return projects;
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
 
 void WorkspaceLibraryDb::startLibraryRescan() noexcept
 {
-    mLibraryScanner->start();
+    mLibraryScanner->requestFullScan();
+    startLibraryScannerIfRequired();
+}
+
+void WorkspaceLibraryDb::startLibraryUpdate(
+    const QHash<FilePath, QSet<FilePath>>& libraries) noexcept
+{
+    for (auto it = libraries.constBegin(); it != libraries.constEnd(); ++it) {
+        mLibraryScanner->requestLibraryUpdate(it.key(), it.value());
+    }
+    startLibraryScannerIfRequired();
+}
+
+void WorkspaceLibraryDb::suspendLibraryScans() noexcept
+{
+    mScanSuspendCount++;
+}
+
+void WorkspaceLibraryDb::resumeLibraryScans() noexcept
+{
+    Q_ASSERT(mScanSuspendCount > 0);
+    mScanSuspendCount = qMax(mScanSuspendCount - 1, 0);
+    startLibraryScannerIfRequired();
+}
+
+void WorkspaceLibraryDb::setLocaleOrder(const QStringList& localeOrder) noexcept
+{
+    if (localeOrder == getLocaleOrder()) {
+        return;
+    }
+
+    try {
+        QElapsedTimer timer;
+        timer.start();
+        SQLiteDatabase::TransactionScopeGuard transactionGuard(*mDb); // can throw
+        QSqlQuery query = mDb->prepareQuery(
+            "INSERT OR REPLACE INTO internal (key, value_text) "
+            "VALUES ('locale_order', :locale_order)");
+        query.bindValue(":locale_order", localeOrder.join(','));
+        mDb->exec(query); // can throw
+        resolveTranslations(*mDb, "component_categories", "cat_id", localeOrder); // can throw
+        resolveTranslations(*mDb, "package_categories", "cat_id", localeOrder); // can throw
+        resolveTranslations(*mDb, "symbols", "symbol_id", localeOrder); // can throw
+        resolveTranslations(*mDb, "packages", "package_id", localeOrder); // can throw
+        resolveTranslations(*mDb, "components", "component_id", localeOrder); // can throw
+        resolveTranslations(*mDb, "devices", "device_id", localeOrder); // can throw
+        transactionGuard.commit(); // can throw
+        qDebug() << "Library translations resolved for" << localeOrder
+                 << "in" << timer.elapsed() << "ms";
+    } catch (const Exception& e) {
+        // the element names are still correct, they are just resolved without the cache
+        qCritical() << "Could not resolve the library translations:" << e.getMsg();
+        return;
+    }
+
+    // only update the locale order after committing, so other connections never use
+    // translations which are resolved for another locale order
+    QMutexLocker locker(&mLocaleOrderMutex);
+    mLocaleOrder = localeOrder;
+}
+
+void WorkspaceLibraryDb::updateProjectIndex(const FilePath& projectFile) noexcept
+{
+    mProjectIndexer->requestProjectUpdate(projectFile);
+}
+
+void WorkspaceLibraryDb::waitForProjectIndex() noexcept
+{
+    mProjectIndexer->waitForDone();
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QStringList WorkspaceLibraryDb::readLocaleOrder(SQLiteDatabase& db)
+{
+    QSqlQuery query = db.prepareQuery(
+        "SELECT value_text FROM internal WHERE key = 'locale_order'");
+    db.exec(query); // can throw
+    if (query.next()) {
+        return query.value(0).toString().split(',', QString::SkipEmptyParts);
+    } else {
+        return QStringList();
+    }
+}
+
+void WorkspaceLibraryDb::resolveTranslations(SQLiteDatabase& db, const QString& table,
+    const QString& idRow, const QStringList& localeOrder, int libId)
+{
+    // Rank of the locale of a translation. Translations in other locales than the
+    // locale order and the default locale ("") get NULL and are not used at all. Every
+    // usage needs its own placeholders since they must not be bound multiple times.
+    int placeholderCount = 0;
+    auto localeRank = [&](){
+        QString rank = "CASE " % table % "_tr.locale";
+        for (int i = 0; i < localeOrder.count(); ++i) {
+            rank += QString(" WHEN :locale%1 THEN %2").arg(placeholderCount++).arg(i);
+        }
+        return rank % QString(" WHEN '' THEN %1 END").arg(localeOrder.count());
+    };
+    auto resolved = [&](const QString& column){
+        QString subquery = "(SELECT " % column % " FROM " % table % "_tr "
+            "WHERE " % table % "_tr." % idRow % " = " % table % ".id "
+            "AND " % column % " IS NOT NULL AND (" % localeRank() % ") IS NOT NULL ";
+        return subquery % "ORDER BY " % localeRank() % " LIMIT 1)";
+    };
+    QString sql = "UPDATE " % table % " SET "
+        "resolved_name = " % resolved("name") % ", "
+        "resolved_description = " % resolved("description") % ", "
+        "resolved_keywords = " % resolved("keywords");
+    if (libId >= 0) {
+        sql += " WHERE lib_id = :lib_id";
+    }
+
+    QSqlQuery query = db.prepareQuery(sql); // can throw
+    for (int i = 0; i < placeholderCount; ++i) {
+        query.bindValue(QString(":locale%1").arg(i), localeOrder.at(i % localeOrder.count()));
+    }
+    if (libId >= 0) {
+        query.bindValue(":lib_id", libId);
+    }
+    db.exec(query); // can throw
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void WorkspaceLibraryDb::libraryScannerFinished() noexcept
+{
+    // process the requests which were made while the scanner was running
+    startLibraryScannerIfRequired();
+}
+
+void WorkspaceLibraryDb::startLibraryScannerIfRequired() noexcept
+{
+    if ((mScanSuspendCount == 0) && mLibraryScanner->hasPendingRequests()) {
+        mLibraryScanner->start(); // does nothing if the scanner is already running
+    }
+}
+
+SQLiteDatabase& WorkspaceLibraryDb::getConnection() const
+{
+    QThread* currentThread = QThread::currentThread();
+    if (currentThread == thread()) {
+        return *mDb; // the thread of this object (usually the GUI thread)
+    }
+
+    QMutexLocker locker(&mReadOnlyConnectionsMutex);
+    auto it = mReadOnlyConnections.find(currentThread);
+    if (it == mReadOnlyConnections.end()) {
+        std::shared_ptr<SQLiteDatabase> db =
+            std::make_shared<SQLiteDatabase>(mFilePath, true); // can throw
+        it = mReadOnlyConnections.insert(currentThread, db);
+        // close the connection within its thread as soon as the thread is finished
+        connect(currentThread, &QThread::finished, this, [this, currentThread]() {
+            QMutexLocker locker(&mReadOnlyConnectionsMutex);
+            mReadOnlyConnections.remove(currentThread);
+        }, Qt::DirectConnection);
+    }
+    return *it.value();
+}
+
 void WorkspaceLibraryDb::getElementTranslations(const QString& table,
     const QString& idRow, const FilePath& elemDir, const QStringList& localeOrder,
     QString* name, QString* desc, QString* keywords) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    if (localeOrder == getLocaleOrder()) {
+        // use the translations precomputed for this locale order
+        QSqlQuery query = getConnection().prepareQuery(
+            "SELECT resolved_name, resolved_description, resolved_keywords "
+            "FROM " % table % " WHERE filepath = :filepath");
+        query.bindValue(":filepath", elemDir.toRelative(mWorkspace.getLibrariesPath()));
+        getConnection().exec(query);
+        bool found = query.next();
+        if (name) *name = found ? query.value(0).toString() : QString();
+        if (desc) *desc = found ? query.value(1).toString() : QString();
+        if (keywords) *keywords = found ? query.value(2).toString() : QString();
+        return;
+    }
+
+    QSqlQuery query = getConnection().prepareQuery(
         "SELECT locale, name, description, keywords FROM " % table % "_tr "
         "INNER JOIN " % table % " ON " % table % ".id=" % table % "_tr." % idRow % " "
         "WHERE " % table % ".filepath = :filepath");
     query.bindValue(":filepath", elemDir.toRelative(mWorkspace.getLibrariesPath()));
-    mDb->exec(query);
+    getConnection().exec(query);
 
     LocalizedNameMap nameMap;
     LocalizedDescriptionMap descriptionMap;
@@ -363,13 +936,94 @@ void WorkspaceLibraryDb::getElementTranslations(const QString& table,
     if (keywords) *keywords = keywordsMap.value(localeOrder);
 }
 
+QHash<FilePath, WorkspaceLibraryDb::ElementTranslations> WorkspaceLibraryDb::getElementTranslations(
+    const QString& table, const QString& idRow, const QList<FilePath>& elemDirs,
+    const QStringList& localeOrder) const
+{
+    QHash<FilePath, ElementTranslations> translations;
+    bool resolved = (localeOrder == getLocaleOrder());
+    for (int offset = 0; offset < elemDirs.count(); offset += sMaxFilePathsPerQuery) {
+        QHash<QString, FilePath> elemDirsByRelPath;
+        QString placeholders = prepareFilePathPlaceholders(elemDirs, offset, elemDirsByRelPath);
+        if (resolved) {
+            // use the translations precomputed for this locale order
+            QSqlQuery query = getConnection().prepareQuery(
+                "SELECT filepath, resolved_name, resolved_description, resolved_keywords "
+                "FROM " % table % " WHERE filepath IN (" % placeholders % ")");
+            int i = 0;
+            foreach (const QString& relPath, elemDirsByRelPath.keys()) {
+                query.bindValue(QString(":filepath%1").arg(i++), relPath);
+            }
+            getConnection().exec(query);
+            while (query.next()) {
+                ElementTranslations translation;
+                translation.name = query.value(1).toString();
+                translation.description = query.value(2).toString();
+                translation.keywords = query.value(3).toString();
+                translations.insert(elemDirsByRelPath.value(query.value(0).toString()),
+                                    translation);
+            }
+            continue;
+        }
+        QSqlQuery query = getConnection().prepareQuery(
+            "SELECT " % table % ".filepath, locale, name, description, keywords "
+            "FROM " % table % "_tr "
+            "INNER JOIN " % table % " ON " % table % ".id=" % table % "_tr." % idRow % " "
+            "WHERE " % table % ".filepath IN (" % placeholders % ")");
+        int i = 0;
+        foreach (const QString& relPath, elemDirsByRelPath.keys()) {
+            query.bindValue(QString(":filepath%1").arg(i++), relPath);
+        }
+        getConnection().exec(query);
+
+        QHash<QString, LocalizedNameMap> nameMaps;
+        QHash<QString, LocalizedDescriptionMap> descriptionMaps;
+        QHash<QString, LocalizedKeywordsMap> keywordsMaps;
+        while (query.next()) {
+            QString relPath     = query.value(0).toString();
+            QString locale      = query.value(1).toString();
+            QString name        = query.value(2).toString();
+            QString description = query.value(3).toString();
+            QString keywords    = query.value(4).toString();
+            if (!name.isNull())          nameMaps[relPath].insert(locale, name);
+            if (!description.isNull())   descriptionMaps[relPath].insert(locale, description);
+            if (!keywords.isNull())      keywordsMaps[relPath].insert(locale, keywords);
+        }
+
+        foreach (const QString& relPath, nameMaps.keys()) {
+            ElementTranslations translation;
+            translation.name = nameMaps.value(relPath).value(localeOrder);
+            translation.description = descriptionMaps.value(relPath).value(localeOrder);
+            translation.keywords = keywordsMaps.value(relPath).value(localeOrder);
+            translations.insert(elemDirsByRelPath.value(relPath), translation);
+        }
+    }
+    return translations;
+}
+
+QString WorkspaceLibraryDb::prepareFilePathPlaceholders(const QList<FilePath>& elemDirs,
+    int offset, QHash<QString, FilePath>& elemDirsByRelPath) const noexcept
+{
+    // the placeholders are named ":filepath0", ":filepath1", ..., in the order of
+    // elemDirsByRelPath.keys()
+    for (int i = offset; i < qMin(offset + sMaxFilePathsPerQuery, elemDirs.count()); ++i) {
+        elemDirsByRelPath.insert(elemDirs.at(i).toRelative(mWorkspace.getLibrariesPath()),
+                                 elemDirs.at(i));
+    }
+    QStringList placeholders;
+    for (int i = 0; i < elemDirsByRelPath.count(); ++i) {
+        placeholders.append(QString(":filepath%1").arg(i));
+    }
+    return placeholders.join(", ");
+}
+
 QMultiMap<Version, FilePath> WorkspaceLibraryDb::getElementFilePathsFromDb(
     const QString& tablename, const Uuid& uuid) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getConnection().prepareQuery(
         "SELECT version, filepath FROM " % tablename % " WHERE uuid = :uuid");
     query.bindValue(":uuid", uuid.toStr());
-    mDb->exec(query);
+    getConnection().exec(query);
 
     QMultiMap<Version, FilePath> elements;
     while (query.next()) {
@@ -385,20 +1039,132 @@ QMultiMap<Version, FilePath> WorkspaceLibraryDb::getElementFilePathsFromDb(
     return elements;
 }
 
-FilePath WorkspaceLibraryDb::getLatestVersionFilePath(const QMultiMap<Version, FilePath>& list) const noexcept
+FilePath WorkspaceLibraryDb::getLatestVersionFilePath(const QString& tablename,
+                                                     const Uuid& uuid) const
+{
+    QMutexLocker locker(&mLatestVersionCacheMutex);
+    return getLatestVersionCache(tablename).value(uuid); // can throw
+}
+
+QHash<Uuid, FilePath> WorkspaceLibraryDb::getLatestVersionFilePaths(
+    const QString& tablename, const QSet<Uuid>& uuids) const
+{
+    QMutexLocker locker(&mLatestVersionCacheMutex);
+    const QHash<Uuid, FilePath>& cache = getLatestVersionCache(tablename); // can throw
+    QHash<Uuid, FilePath> elements;
+    elements.reserve(uuids.count());
+    foreach (const Uuid& uuid, uuids) {
+        auto it = cache.constFind(uuid);
+        if (it != cache.constEnd()) {
+            elements.insert(uuid, it.value());
+        }
+    }
+    return elements;
+}
+
+const QHash<Uuid, FilePath>& WorkspaceLibraryDb::getLatestVersionCache(
+    const QString& tablename) const
+{
+    // must be called with mLatestVersionCacheMutex locked
+    auto it = mLatestVersionCache.constFind(tablename);
+    if (it != mLatestVersionCache.constEnd()) {
+        return it.value();
+    }
+
+    // version_key contains Version::toComparableBlob(), i.e. it is sorted by version,
+    // so the last row of every UUID is the latest version (with the lowest id)
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT uuid, filepath FROM " % tablename % " "
+        "ORDER BY version_key ASC, id DESC");
+    getConnection().exec(query); // can throw
+
+    QHash<Uuid, FilePath> elements;
+    while (query.next()) {
+        Uuid uuid(query.value(0).toString());
+        FilePath filepath(FilePath::fromRelative(mWorkspace.getLibrariesPath(),
+                                                 query.value(1).toString()));
+        if (!uuid.isNull() && filepath.isValid()) {
+            elements.insert(uuid, filepath);
+        } else {
+            throw LogicError(__FILE__, __LINE__);
+        }
+    }
+    return mLatestVersionCache.insert(tablename, elements).value();
+}
+
+void WorkspaceLibraryDb::clearLatestVersionCache() noexcept
+{
+    QMutexLocker locker(&mLatestVersionCacheMutex);
+    mLatestVersionCache.clear();
+}
+
+QList<Uuid> WorkspaceLibraryDb::searchElements(const QString& table, const QString& idRow,
+    const QString& query, const QStringList& localeOrder, int limit, int offset) const
+{
+    QString ftsQuery = toFtsQuery(query);
+    if (ftsQuery.isEmpty()) return QList<Uuid>();
+
+    // rank: matches in the name first, then matches in the preferred locales
+    QString localeRank = "CASE " % table % "_tr.locale";
+    for (int i = 0; i < localeOrder.count(); ++i) {
+        localeRank += QString(" WHEN :locale%1 THEN %1").arg(i);
+    }
+    localeRank += QString(" ELSE %1 END").arg(localeOrder.count());
+    QSqlQuery sqlQuery = getConnection().prepareQuery(
+        "SELECT " % table % ".uuid, MIN("
+            "(CASE WHEN " % table % "_fts.docid IN "
+                "(SELECT docid FROM " % table % "_fts WHERE name MATCH :name_query) "
+                "THEN 0 ELSE " % QString::number(localeOrder.count() + 1) % " END) + " %
+            localeRank % ") AS rank, "
+        "MIN(" % table % "_tr.name) AS name "
+        "FROM " % table % "_fts "
+        "INNER JOIN " % table % "_tr ON " % table % "_tr.id = " % table % "_fts.docid "
+        "INNER JOIN " % table % " ON " % table % ".id = " % table % "_tr." % idRow % " "
+        "WHERE " % table % "_fts MATCH :query "
+        "GROUP BY " % table % ".uuid "
+        "ORDER BY rank ASC, name ASC "
+        "LIMIT :limit OFFSET :offset");
+    sqlQuery.bindValue(":name_query", ftsQuery);
+    sqlQuery.bindValue(":query", ftsQuery);
+    for (int i = 0; i < localeOrder.count(); ++i) {
+        sqlQuery.bindValue(QString(":locale%1").arg(i), localeOrder.at(i));
+    }
+    sqlQuery.bindValue(":limit", limit);
+    sqlQuery.bindValue(":offset", offset);
+    getConnection().exec(sqlQuery);
+
+    QList<Uuid> elements;
+    while (sqlQuery.next()) {
+        Uuid uuid(sqlQuery.value(0).toString());
+        if (!uuid.isNull()) {
+            elements.append(uuid);
+        } else {
+            throw LogicError(__FILE__, __LINE__);
+        }
+    }
+    return elements;
+}
+
+QString WorkspaceLibraryDb::toFtsQuery(const QString& query) noexcept
 {
-    if (list.isEmpty())
-        return FilePath();
-    else
-        return list.last(); // highest version number
+    // Quote every word of the user input (so it cannot contain FTS operators) and match
+    // it as a prefix. All words must match (implicit AND).
+    QStringList terms;
+    foreach (QString word, query.split(QRegularExpression("\\s+"), QString::SkipEmptyParts)) {
+        word.remove('"');
+        if (!word.isEmpty()) {
+            terms.append("\"" % word % "\"*");
+        }
+    }
+    return terms.join(' ');
 }
 
 QSet<Uuid> WorkspaceLibraryDb::getCategoryChilds(const QString& tablename, const Uuid& categoryUuid) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getConnection().prepareQuery(
         "SELECT uuid FROM " % tablename % " WHERE parent_uuid " %
         (categoryUuid.isNull() ? QString("IS NULL") : "= '" % categoryUuid.toStr() % "'"));
-    mDb->exec(query);
+    getConnection().exec(query);
 
     QSet<Uuid> elements;
     while (query.next()) {
@@ -412,55 +1178,134 @@ QSet<Uuid> WorkspaceLibraryDb::getCategoryChilds(const QString& tablename, const
     return elements;
 }
 
-QList<Uuid> WorkspaceLibraryDb::getCategoryParents(const QString& tablename, Uuid category) const
+QList<Uuid> WorkspaceLibraryDb::getCategoryParents(const QString& tablename,
+                                                   const Uuid& category) const
 {
+    // Walk up the tree in one query. The first row is the category itself, each further
+    // row the parent of the previous one (latest version), the last row is NULL for a
+    // root category. The depth limit terminates endless loops.
+    QSqlQuery query = getConnection().prepareQuery(
+        "WITH RECURSIVE chain(uuid, depth) AS ("
+            "SELECT :uuid, 0 "
+            "UNION ALL "
+            "SELECT (SELECT parent_uuid FROM " % tablename % " "
+                    "WHERE " % tablename % ".uuid = chain.uuid "
+                    "ORDER BY version_key DESC LIMIT 1), depth + 1 "
+            "FROM chain WHERE chain.uuid IS NOT NULL AND depth < :max_depth"
+        ") "
+        "SELECT chain.uuid, EXISTS(SELECT 1 FROM " % tablename % " "
+                                  "WHERE " % tablename % ".uuid = chain.uuid) "
+        "FROM chain ORDER BY depth");
+    query.bindValue(":uuid", category.toStr());
+    query.bindValue(":max_depth", sMaxCategoryDepth);
+    getConnection().exec(query);
+
     QList<Uuid> parentUuids;
-    while (!(category = getCategoryParent(tablename, category)).isNull()) {
-        if (parentUuids.contains(category)) {
+    bool first = true;
+    while (query.next()) {
+        QVariant value = query.value(0);
+        if (value.isNull()) break; // reached the root
+        Uuid uuid(value.toString());
+        if (uuid.isNull()) {
+            throw LogicError(__FILE__, __LINE__);
+        } else if (!query.value(1).toBool()) {
+            throw RuntimeError(__FILE__, __LINE__, QString(tr("The category "
+                "\"%1\" does not exist in the library database.")).arg(uuid.toStr()));
+        } else if (first) {
+            first = false; // the category itself
+        } else if (parentUuids.contains(uuid) || (uuid == category)) {
             throw RuntimeError(__FILE__, __LINE__, QString(tr("Endless loop "
-                "in category parentship detected (%1).")).arg(category.toStr()));
+                "in category parentship detected (%1).")).arg(uuid.toStr()));
         } else {
-            parentUuids.append(category);
+            parentUuids.append(uuid);
         }
     }
     return parentUuids;
 }
 
-Uuid WorkspaceLibraryDb::getCategoryParent(const QString& tablename, const Uuid& category) const
+QSet<Uuid> WorkspaceLibraryDb::getCategorySubtree(const QString& tablename,
+                                                 const Uuid& category) const
 {
-    QSqlQuery query = mDb->prepareQuery(
-        "SELECT parent_uuid FROM " % tablename %
-        " WHERE uuid = '" % category.toStr() % "'" %
-        " ORDER BY version DESC" %
-        " LIMIT 1");
-    mDb->exec(query);
+    // UNION (instead of UNION ALL) also terminates endless loops
+    QSqlQuery query = getConnection().prepareQuery(
+        "WITH RECURSIVE subtree(uuid) AS ("
+            "SELECT uuid FROM " % tablename % " WHERE parent_uuid " %
+            (category.isNull() ? QString("IS NULL") : QString("= :uuid")) % " "
+            "UNION "
+            "SELECT " % tablename % ".uuid FROM " % tablename % " "
+            "INNER JOIN subtree ON " % tablename % ".parent_uuid = subtree.uuid"
+        ") "
+        "SELECT uuid FROM subtree");
+    if (!category.isNull()) query.bindValue(":uuid", category.toStr());
+    getConnection().exec(query);
 
-    if (query.next()) {
-        QVariant value = query.value(0);
-        Uuid uuid(value.toString());
+    QSet<Uuid> elements;
+    while (query.next()) {
+        Uuid uuid(query.value(0).toString());
         if (!uuid.isNull()) {
-            return uuid;
-        } else if (value.isNull()) {
-            return Uuid();
+            elements.insert(uuid);
         } else {
             throw LogicError(__FILE__, __LINE__);
         }
-    } else {
-        throw RuntimeError(__FILE__, __LINE__, QString(tr("The category "
-            "\"%1\" does not exist in the library database.")).arg(category.toStr()));
     }
+    elements.remove(category); // in case of an endless loop
+    return elements;
+}
+
+QSet<Uuid> WorkspaceLibraryDb::getElementsInCategorySubtree(const QString& tablename,
+    const QString& idrowname, const QString& categoryTablename, const Uuid& category) const
+{
+    QSqlQuery query = getConnection().prepareQuery(category.isNull() ?
+        QString("SELECT DISTINCT uuid FROM " % tablename) :
+        QString("WITH RECURSIVE subtree(uuid) AS ("
+                    "SELECT :uuid "
+                    "UNION "
+                    "SELECT " % categoryTablename % ".uuid FROM " % categoryTablename % " "
+                    "INNER JOIN subtree ON " % categoryTablename % ".parent_uuid = subtree.uuid"
+                ") "
+                "SELECT DISTINCT " % tablename % ".uuid FROM " % tablename % " "
+                "INNER JOIN " % tablename % "_cat "
+                "ON " % tablename % ".id=" % tablename % "_cat." % idrowname % " "
+                "WHERE " % tablename % "_cat.category_uuid IN (SELECT uuid FROM subtree)"));
+    if (!category.isNull()) query.bindValue(":uuid", category.toStr());
+    getConnection().exec(query);
+
+    QSet<Uuid> elements;
+    while (query.next()) {
+        Uuid uuid(query.value(0).toString());
+        if (!uuid.isNull()) {
+            elements.insert(uuid);
+        } else {
+            throw LogicError(__FILE__, __LINE__);
+        }
+    }
+    return elements;
 }
 
 QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(const QString& tablename,
     const QString& idrowname, const Uuid& categoryUuid) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getConnection().prepareQuery(
         "SELECT uuid FROM " % tablename % " LEFT JOIN " % tablename % "_cat "
         "ON " % tablename % ".id=" % tablename % "_cat." % idrowname % " "
         "WHERE category_uuid " %
         (categoryUuid.isNull() ? QString("IS NULL") : "= '" % categoryUuid.toStr() % "'"));
-    mDb->exec(query);
+    getConnection().exec(query);
+
+    QSet<Uuid> elements;
+    while (query.next()) {
+        Uuid uuid(query.value(0).toString());
+        if (!uuid.isNull()) {
+            elements.insert(uuid);
+        } else {
+            throw LogicError(__FILE__, __LINE__);
+        }
+    }
+    return elements;
+}
 
+QSet<Uuid> WorkspaceLibraryDb::getUuidsFromQuery(QSqlQuery& query)
+{
     QSet<Uuid> elements;
     while (query.next()) {
         Uuid uuid(query.value(0).toString());
@@ -473,14 +1318,39 @@ QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(const QString& tablename,
     return elements;
 }
 
+QList<Uuid> WorkspaceLibraryDb::getElementsByCategorySortedByName(const QString& tablename,
+    const QString& idrowname, const Uuid& categoryUuid) const
+{
+    QSqlQuery query = getConnection().prepareQuery(
+        "SELECT uuid FROM " % tablename % " LEFT JOIN " % tablename % "_cat "
+        "ON " % tablename % ".id=" % tablename % "_cat." % idrowname % " "
+        "WHERE category_uuid " %
+        (categoryUuid.isNull() ? QString("IS NULL") : QString("= :category_uuid")) % " "
+        "GROUP BY uuid "
+        "ORDER BY MIN(resolved_name COLLATE NOCASE) ASC, uuid ASC");
+    if (!categoryUuid.isNull()) query.bindValue(":category_uuid", categoryUuid.toStr());
+    getConnection().exec(query);
+
+    QList<Uuid> elements;
+    while (query.next()) {
+        Uuid uuid(query.value(0).toString());
+        if (!uuid.isNull()) {
+            elements.append(uuid);
+        } else {
+            throw LogicError(__FILE__, __LINE__);
+        }
+    }
+    return elements;
+}
+
 int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const
 {
     QString relativeLibraryPath = lib.toRelative(mWorkspace.getLibrariesPath());
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getConnection().prepareQuery(
         "SELECT id FROM libraries "
         "WHERE filepath = '" % relativeLibraryPath % "'"
         "LIMIT 1");
-    mDb->exec(query);
+    getConnection().exec(query);
 
     if (query.next()) {
         bool ok = false;
@@ -496,10 +1366,10 @@ int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const
 QList<FilePath> WorkspaceLibraryDb::getLibraryElements(const FilePath& lib,
                                                        const QString& tablename) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getConnection().prepareQuery(
         "SELECT filepath FROM " % tablename % " WHERE lib_id = :lib_id");
     query.bindValue(":lib_id", getLibraryId(lib));
-    mDb->exec(query);
+    getConnection().exec(query);
 
     QList<FilePath> elements;
     while (query.next()) {
@@ -533,7 +1403,11 @@ void WorkspaceLibraryDb::createAllTables()
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
-                        "`version` TEXT NOT NULL "
+                        "`version` TEXT NOT NULL, "
+                        "`version_key` BLOB NOT NULL, "
+                        "`mtime` INTEGER NOT NULL, "
+                        "`size` INTEGER NOT NULL, "
+                        "`hash` TEXT NOT NULL"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS libraries_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -550,8 +1424,15 @@ void WorkspaceLibraryDb::createAllTables()
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`mtime` INTEGER NOT NULL, "
+                        "`size` INTEGER NOT NULL, "
+                        "`hash` TEXT NOT NULL, "
+                        "`resolved_name` TEXT, "
+                        "`resolved_description` TEXT, "
+                        "`resolved_keywords` TEXT, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
+                        "`version_key` BLOB NOT NULL, "
                         "`parent_uuid` TEXT"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS component_categories_tr ("
@@ -569,8 +1450,15 @@ void WorkspaceLibraryDb::createAllTables()
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`mtime` INTEGER NOT NULL, "
+                        "`size` INTEGER NOT NULL, "
+                        "`hash` TEXT NOT NULL, "
+                        "`resolved_name` TEXT, "
+                        "`resolved_description` TEXT, "
+                        "`resolved_keywords` TEXT, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
+                        "`version_key` BLOB NOT NULL, "
                         "`parent_uuid` TEXT"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS package_categories_tr ("
@@ -588,8 +1476,15 @@ void WorkspaceLibraryDb::createAllTables()
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`mtime` INTEGER NOT NULL, "
+                        "`size` INTEGER NOT NULL, "
+                        "`hash` TEXT NOT NULL, "
+                        "`resolved_name` TEXT, "
+                        "`resolved_description` TEXT, "
+                        "`resolved_keywords` TEXT, "
                         "`uuid` TEXT NOT NULL, "
-                        "`version` TEXT NOT NULL"
+                        "`version` TEXT NOT NULL, "
+                        "`version_key` BLOB NOT NULL"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS symbols_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -612,8 +1507,15 @@ void WorkspaceLibraryDb::createAllTables()
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`mtime` INTEGER NOT NULL, "
+                        "`size` INTEGER NOT NULL, "
+                        "`hash` TEXT NOT NULL, "
+                        "`resolved_name` TEXT, "
+                        "`resolved_description` TEXT, "
+                        "`resolved_keywords` TEXT, "
                         "`uuid` TEXT NOT NULL, "
-                        "`version` TEXT NOT NULL "
+                        "`version` TEXT NOT NULL, "
+                        "`version_key` BLOB NOT NULL"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS packages_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -636,8 +1538,15 @@ void WorkspaceLibraryDb::createAllTables()
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`mtime` INTEGER NOT NULL, "
+                        "`size` INTEGER NOT NULL, "
+                        "`hash` TEXT NOT NULL, "
+                        "`resolved_name` TEXT, "
+                        "`resolved_description` TEXT, "
+                        "`resolved_keywords` TEXT, "
                         "`uuid` TEXT NOT NULL, "
-                        "`version` TEXT NOT NULL"
+                        "`version` TEXT NOT NULL, "
+                        "`version_key` BLOB NOT NULL"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS components_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -654,14 +1563,37 @@ void WorkspaceLibraryDb::createAllTables()
                         "`category_uuid` TEXT NOT NULL, "
                         "UNIQUE(component_id, category_uuid)"
                         ")");
+    queries << QString( "CREATE TABLE IF NOT EXISTS components_attr ("
+                        "`id` INTEGER PRIMARY KEY NOT NULL, "
+                        "`component_id` INTEGER REFERENCES components(id) NOT NULL, "
+                        "`key` TEXT NOT NULL, "
+                        "`type` TEXT NOT NULL, "
+                        "`value` TEXT, "
+                        "`unit` TEXT, "
+                        "`si_value` REAL, "
+                        "UNIQUE(component_id, key)"
+                        ")");
+    queries << QString( "CREATE TABLE IF NOT EXISTS components_sym ("
+                        "`id` INTEGER PRIMARY KEY NOT NULL, "
+                        "`component_id` INTEGER REFERENCES components(id) NOT NULL, "
+                        "`symbol_uuid` TEXT NOT NULL, "
+                        "UNIQUE(component_id, symbol_uuid)"
+                        ")");
 
     // devices
     queries << QString( "CREATE TABLE IF NOT EXISTS devices ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`mtime` INTEGER NOT NULL, "
+                        "`size` INTEGER NOT NULL, "
+                        "`hash` TEXT NOT NULL, "
+                        "`resolved_name` TEXT, "
+                        "`resolved_description` TEXT, "
+                        "`resolved_keywords` TEXT, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
+                        "`version_key` BLOB NOT NULL, "
                         "`component_uuid` TEXT NOT NULL, "
                         "`package_uuid` TEXT NOT NULL"
                         ")");
@@ -681,6 +1613,82 @@ void WorkspaceLibraryDb::createAllTables()
                         "UNIQUE(device_id, category_uuid)"
                         ")");
 
+    // projects (see #WorkspaceProjectIndexer)
+    queries << QString( "CREATE TABLE IF NOT EXISTS projects ("
+                        "`id` INTEGER PRIMARY KEY NOT NULL, "
+                        "`filepath` TEXT UNIQUE NOT NULL, "
+                        "`mtime` INTEGER NOT NULL"
+                        ")");
+    queries << QString( "CREATE TABLE IF NOT EXISTS projects_elements ("
+                        "`id` INTEGER PRIMARY KEY NOT NULL, "
+                        "`project_id` INTEGER REFERENCES projects(id) NOT NULL, "
+                        "`type` TEXT NOT NULL, "
+                        "`uuid` TEXT NOT NULL, "
+                        "UNIQUE(project_id, type, uuid)"
+                        ")");
+
+    // indices for the library scanner (elements are looked up per library)
+    foreach (const QString& table, QStringList{"component_categories", "package_categories",
+                                               "symbols", "packages", "components", "devices"}) {
+        queries << QString("CREATE INDEX IF NOT EXISTS %1_lib_id ON %1 (lib_id)").arg(table);
+    }
+
+    // indices for the lookup of elements by category and of devices by component
+    foreach (const QString& table, QStringList{"symbols", "packages", "components", "devices"}) {
+        queries << QString("CREATE INDEX IF NOT EXISTS %1_cat_category_uuid ON %1_cat "
+                           "(category_uuid)").arg(table);
+    }
+    queries << QString("CREATE INDEX IF NOT EXISTS devices_component_uuid ON devices "
+                       "(component_uuid)");
+
+    // indices for the where-used lookups (see #getProjectsUsingElements())
+    queries << QString("CREATE INDEX IF NOT EXISTS devices_package_uuid ON devices "
+                       "(package_uuid)");
+    queries << QString("CREATE INDEX IF NOT EXISTS components_sym_symbol_uuid ON "
+                       "components_sym (symbol_uuid)");
+    queries << QString("CREATE INDEX IF NOT EXISTS projects_elements_uuid ON "
+                       "projects_elements (uuid)");
+
+    // index for the parametric search (see #getComponentsByAttribute())
+    queries << QString("CREATE INDEX IF NOT EXISTS components_attr_key_si_value ON "
+                       "components_attr (key, si_value)");
+
+    // indices for the lookup of the latest version of an element
+    foreach (const QString& table, QStringList{"component_categories", "package_categories",
+                                               "symbols", "packages", "components", "devices"}) {
+        queries << QString("CREATE INDEX IF NOT EXISTS %1_uuid_version ON %1 "
+                           "(uuid, version_key)").arg(table);
+    }
+
+    // indices for sorting elements by their precomputed name (see #setLocaleOrder())
+    foreach (const QString& table, QStringList{"component_categories", "package_categories",
+                                               "symbols", "packages", "components", "devices"}) {
+        queries << QString("CREATE INDEX IF NOT EXISTS %1_resolved_name ON %1 "
+                           "(resolved_name COLLATE NOCASE)").arg(table);
+    }
+
+    // full-text search indices over the translations (see #searchElements()), kept up to
+    // date by triggers whenever the library scanner adds or removes translations
+    foreach (const QString& table, QStringList{"component_categories", "package_categories",
+                                               "symbols", "packages", "components", "devices"}) {
+        queries << QString("CREATE VIRTUAL TABLE IF NOT EXISTS %1_fts USING fts4("
+                           "content=\"%1_tr\", name, description, keywords)").arg(table);
+        queries << QString("CREATE TRIGGER IF NOT EXISTS %1_tr_ai AFTER INSERT ON %1_tr BEGIN "
+                           "INSERT INTO %1_fts (docid, name, description, keywords) "
+                           "VALUES (new.id, new.name, new.description, new.keywords); "
+                           "END").arg(table);
+        queries << QString("CREATE TRIGGER IF NOT EXISTS %1_tr_bd BEFORE DELETE ON %1_tr BEGIN "
+                           "DELETE FROM %1_fts WHERE docid = old.id; "
+                           "END").arg(table);
+        queries << QString("CREATE TRIGGER IF NOT EXISTS %1_tr_bu BEFORE UPDATE ON %1_tr BEGIN "
+                           "DELETE FROM %1_fts WHERE docid = old.id; "
+                           "END").arg(table);
+        queries << QString("CREATE TRIGGER IF NOT EXISTS %1_tr_au AFTER UPDATE ON %1_tr BEGIN "
+                           "INSERT INTO %1_fts (docid, name, description, keywords) "
+                           "VALUES (new.id, new.name, new.description, new.keywords); "
+                           "END").arg(table);
+    }
+
     // execute queries
     foreach (const QString& string, queries) {
         QSqlQuery query = mDb->prepareQuery(string); // can throw
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/exceptions.h>
@@ -31,6 +32,8 @@
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
+class QSqlQuery;
+
 namespace librepcb {
 
 class Version;
@@ -40,6 +43,8 @@ namespace workspace {
 
 class Workspace;
 class WorkspaceLibraryScanner;
+class WorkspaceLibraryWatcher;
+class WorkspaceProjectIndexer;
 
 /*****************************************************************************************
  *  Class WorkspaceLibraryDb
@@ -47,6 +52,12 @@ class WorkspaceLibraryScanner;
 
 /**
  * @brief The WorkspaceLibraryDb class
+ *
+ * All getters can be called from any thread. The thread of this object (i.e. the GUI
+ * thread) uses the main connection to the database, every other thread gets its own
+ * read-only connection which is closed when the thread finishes. As the database uses
+ * Write-Ahead Logging and the #WorkspaceLibraryScanner commits its changes library by
+ * library, queries are not blocked by a running scan.
  */
 class WorkspaceLibraryDb final : public QObject
 {
@@ -54,6 +65,17 @@ class WorkspaceLibraryDb final : public QObject
 
     public:
 
+        // Types
+
+        /**
+         * @brief Translated metadata of a library element (see #getElementTranslations())
+         */
+        struct ElementTranslations {
+            QString name;
+            QString description;
+            QString keywords;
+        };
+
         // Constructors / Destructor
         WorkspaceLibraryDb() = delete;
         WorkspaceLibraryDb(const WorkspaceLibraryDb& other) = delete;
@@ -85,6 +107,23 @@ class WorkspaceLibraryDb final : public QObject
         FilePath getLatestComponent(const Uuid& uuid) const;
         FilePath getLatestDevice(const Uuid& uuid) const;
 
+        // Getters: Best Match Library Elements of many UUIDs at once
+
+        /**
+         * @brief Get the latest versions of many elements without any database query
+         *
+         * The latest versions of all elements of a type are loaded with a single query
+         * on the first call (of this method or of the "getLatest*()" methods above) and
+         * kept in memory until the next scan has finished.
+         *
+         * @param uuids     The UUIDs of the elements
+         *
+         * @return The directories of the latest versions of all found elements (UUIDs
+         *         which do not exist in the database are not contained)
+         */
+        template <typename ElementType>
+        QHash<Uuid, FilePath> getLatestElements(const QSet<Uuid>& uuids) const;
+
         // Getters: Library elements of a specified library
         template <typename ElementType>
         QList<FilePath> getLibraryElements(const FilePath& lib) const;
@@ -95,6 +134,130 @@ class WorkspaceLibraryDb final : public QObject
                                     QString* name = nullptr, QString* desc = nullptr,
                                     QString* keywords = nullptr) const;
         void getDeviceMetadata(const FilePath& devDir, Uuid* pkgUuid = nullptr) const;
+        void getLibraryMetadata(const FilePath& libDir, Uuid* uuid = nullptr,
+                                Version* version = nullptr) const;
+
+        // Getters: Element Metadata of many elements at once
+
+        /**
+         * @brief Get the translations of many elements with as few queries as possible
+         *
+         * @param elemDirs      The directories of the elements
+         * @param localeOrder   The locales to use for the translations
+         *
+         * @return The translations of all found elements (elements which do not exist
+         *         in the database are not contained)
+         */
+        template <typename ElementType>
+        QHash<FilePath, ElementTranslations> getElementTranslations(
+            const QList<FilePath>& elemDirs, const QStringList& localeOrder) const;
+
+        /**
+         * @brief Get the package UUIDs of many devices with as few queries as possible
+         *
+         * @param devDirs   The directories of the devices
+         *
+         * @return The package UUIDs of all found devices
+         */
+        QHash<FilePath, Uuid> getDeviceMetadata(const QList<FilePath>& devDirs) const;
+
+        // Getters: Search
+
+        /**
+         * @brief Search library elements by their names, descriptions and keywords
+         *
+         * The search uses a full-text index over the translations of all locales, so it
+         * is fast even for large libraries. Every word of the query must match the
+         * beginning of a word in the name, description or keywords (case insensitive).
+         *
+         * @param query         The search terms, separated by whitespace
+         * @param localeOrder   Preferred locales, used to rank the results
+         * @param limit         Maximum count of results (-1 = unlimited)
+         * @param offset        Count of results to skip (for pagination)
+         *
+         * @return UUIDs of the matching elements, ranked by relevance: Elements whose
+         *         name matches come first, then elements matching in the preferred
+         *         locales. Elements with the same rank are sorted by name.
+         */
+        template <typename ElementType>
+        QList<Uuid> searchElements(const QString& query, const QStringList& localeOrder,
+                                   int limit = -1, int offset = 0) const;
+
+        // Getters: Parametric Search
+
+        /**
+         * @brief Get the keys of all attributes of all components (e.g. "RESISTANCE")
+         *
+         * @return The distinct attribute keys, sorted alphabetically
+         */
+        QStringList getComponentAttributeKeys() const;
+
+        /**
+         * @brief Get all components with a numeric attribute value within a range
+         *
+         * The values are compared in the SI base unit of their attribute type (see
+         * librepcb::Attribute::getSiValue()), so e.g. "10kΩ" matches the range
+         * [9900, 10100] independent of whether it is stored as 10 kiloohm or 10000 ohm.
+         *
+         * @param key           The attribute key
+         * @param minSiValue    The lower bound of the range (inclusive)
+         * @param maxSiValue    The upper bound of the range (inclusive)
+         *
+         * @return The UUIDs of all matching components
+         */
+        QSet<Uuid> getComponentsByAttribute(const QString& key, qreal minSiValue,
+                                            qreal maxSiValue) const;
+
+        /**
+         * @brief Get all components with a specific (untranslated) attribute value
+         *
+         * This is intended for non-numeric attributes like strings.
+         *
+         * @param key       The attribute key
+         * @param value     The value (see librepcb::Attribute::getValue())
+         *
+         * @return The UUIDs of all matching components
+         */
+        QSet<Uuid> getComponentsByAttribute(const QString& key, const QString& value) const;
+
+        /**
+         * @brief Get all devices of the components with a numeric attribute value within
+         *        a range
+         *
+         * @param key           The attribute key
+         * @param minSiValue    The lower bound of the range (inclusive)
+         * @param maxSiValue    The upper bound of the range (inclusive)
+         *
+         * @return The UUIDs of all devices of the matching components (see
+         *         #getComponentsByAttribute())
+         */
+        QSet<Uuid> getDevicesByComponentAttribute(const QString& key, qreal minSiValue,
+                                                  qreal maxSiValue) const;
+
+        // Getters: Resolved Metadata
+
+        /**
+         * @brief Get the locale order of the precomputed names, descriptions and keywords
+         *
+         * The translations of every element are resolved for this locale order while
+         * scanning and stored next to the element. So #getElementTranslations() does not
+         * need to resolve them again for this locale order, and elements can be sorted by
+         * their name within a single (indexed) query.
+         *
+         * @return The locale order set with #setLocaleOrder()
+         */
+        QStringList getLocaleOrder() const noexcept;
+
+        /**
+         * @brief Get all elements of a category, sorted by their name
+         *
+         * @param category  The category UUID (NULL = elements without category)
+         *
+         * @return The UUIDs of the elements, sorted case insensitively by their name in
+         *         the locale order #getLocaleOrder()
+         */
+        template <typename ElementType>
+        QList<Uuid> getElementsByCategorySortedByName(const Uuid& category) const;
 
         // Getters: Special
         QSet<Uuid> getComponentCategoryChilds(const Uuid& parent) const;
@@ -107,13 +270,151 @@ class WorkspaceLibraryDb final : public QObject
         QSet<Uuid> getDevicesByCategory(const Uuid& category) const;
         QSet<Uuid> getDevicesOfComponent(const Uuid& component) const;
 
+        // Getters: Where-Used Index
+
+        /**
+         * @brief Get all devices which use a package
+         *
+         * @param package   The package UUID
+         *
+         * @return The UUIDs of all devices referencing the package
+         */
+        QSet<Uuid> getDevicesOfPackage(const Uuid& package) const;
+
+        /**
+         * @brief Get all components which use a symbol in any of their symbol variants
+         *
+         * @param symbol    The symbol UUID
+         *
+         * @return The UUIDs of all components referencing the symbol
+         */
+        QSet<Uuid> getComponentsOfSymbol(const Uuid& symbol) const;
+
+        /**
+         * @brief Get all projects which contain at least one of some library elements
+         *
+         * The projects are indexed in the background by the #WorkspaceProjectIndexer,
+         * so projects which were not indexed yet (or modified since) may be missing.
+         *
+         * @param uuids     The UUIDs of the library elements (of any type)
+         *
+         * @return The *.lpp files of all projects containing any of the elements in
+         *         their project library
+         */
+        QSet<FilePath> getProjectsUsingElements(const QSet<Uuid>& uuids) const;
+
+        // Getters: Category Subtrees (one query each, independent of the tree depth)
+
+        /**
+         * @brief Get all (direct and indirect) child categories of a category
+         *
+         * @param category  The root of the subtree (NULL = all categories)
+         *
+         * @return The UUIDs of all categories in the subtree, excluding the root
+         */
+        QSet<Uuid> getComponentCategorySubtree(const Uuid& category) const;
+        QSet<Uuid> getPackageCategorySubtree(const Uuid& category) const;
+
+        /**
+         * @brief Get all elements which are assigned to a category or its subcategories
+         *
+         * @param category  The root of the subtree (NULL = all elements)
+         *
+         * @return The UUIDs of all elements in the subtree
+         */
+        QSet<Uuid> getSymbolsInCategorySubtree(const Uuid& category) const;
+        QSet<Uuid> getPackagesInCategorySubtree(const Uuid& category) const;
+        QSet<Uuid> getComponentsInCategorySubtree(const Uuid& category) const;
+        QSet<Uuid> getDevicesInCategorySubtree(const Uuid& category) const;
+
         // General Methods
 
         /**
          * @brief Rescan the whole library directory and update the SQLite database
+         *
+         * Only library elements which were added, modified or removed since the last
+         * scan are updated in the database (see #WorkspaceLibraryScanner).
          */
         void startLibraryRescan() noexcept;
 
+        /**
+         * @brief Update only some libraries (or some of their elements) in the database
+         *
+         * This is used to process modifications in the file system reported by the
+         * #WorkspaceLibraryWatcher. If a scan is already running, the update is done
+         * right after it has finished.
+         *
+         * @param libraries     The libraries to update (keys) with the element
+         *                      directories to update (values, empty = whole library)
+         */
+        void startLibraryUpdate(const QHash<FilePath, QSet<FilePath>>& libraries) noexcept;
+
+        /**
+         * @brief Defer all library scans until #resumeLibraryScans() is called
+         *
+         * This allows to make many modifications (e.g. installing many libraries) with
+         * only one consolidated scan at the end. Calls can be nested, the scans are
+         * resumed when #resumeLibraryScans() was called as many times as this method.
+         */
+        void suspendLibraryScans() noexcept;
+
+        /**
+         * @brief Resume the library scans suspended by #suspendLibraryScans()
+         */
+        void resumeLibraryScans() noexcept;
+
+        /**
+         * @brief Set the locale order of the precomputed translations
+         *
+         * The translations of all elements are resolved again within one transaction,
+         * thus this should only be called if the locale order has really changed.
+         *
+         * @param localeOrder   The new locale order (see #getLocaleOrder())
+         */
+        void setLocaleOrder(const QStringList& localeOrder) noexcept;
+
+        /**
+         * @brief Update the used library elements of a project in the where-used index
+         *
+         * This should be called after a project was saved. The projects directory of the
+         * workspace is crawled automatically when the database is opened.
+         *
+         * @param projectFile   The *.lpp file of the project
+         */
+        void updateProjectIndex(const FilePath& projectFile) noexcept;
+
+        /**
+         * @brief Wait until all pending updates of the where-used index are done
+         *
+         * This is intended for command line tools which query the index right after
+         * opening the workspace (the initial crawl runs in the background).
+         */
+        void waitForProjectIndex() noexcept;
+
+        // Static Methods (used by the #WorkspaceLibraryScanner)
+
+        /**
+         * @brief Get the locale order of the precomputed translations stored in a database
+         *
+         * @param db    The database connection
+         *
+         * @return The locale order set with #setLocaleOrder() (empty if never set)
+         */
+        static QStringList readLocaleOrder(SQLiteDatabase& db);
+
+        /**
+         * @brief Precompute the translations of elements for a specific locale order
+         *
+         * @param db            The database connection
+         * @param table         The element table (e.g. "symbols")
+         * @param idRow         The column of the "*_tr" table referencing the element
+         * @param localeOrder   The locale order to resolve the translations for
+         * @param libId         Only update the elements of this library (-1 = all)
+         */
+        static void resolveTranslations(SQLiteDatabase& db, const QString& table,
+                                        const QString& idRow,
+                                        const QStringList& localeOrder, int libId = -1);
+
         // Operator Overloadings
         WorkspaceLibraryDb& operator=(const WorkspaceLibraryDb& rhs) = delete;
 
@@ -124,22 +425,56 @@ class WorkspaceLibraryDb final : public QObject
         void scanProgressUpdate(int percent);
         void scanSucceeded(int elementCount);
         void scanFailed(QString errorMsg);
+        void projectIndexUpdated();
 
 
     private:
 
         // Private Methods
+
+        /**
+         * @brief Get the database connection of the current thread
+         *
+         * @return  The main connection for the thread of this object, a read-only
+         *          connection for all other threads (opened on the first call)
+         *
+         * @throw Exception If the connection could not be opened.
+         */
+        SQLiteDatabase& getConnection() const;
+        void libraryScannerFinished() noexcept;
+        void startLibraryScannerIfRequired() noexcept;
         void getElementTranslations(const QString& table, const QString& idRow,
                                     const FilePath& elemDir, const QStringList& localeOrder,
                                     QString* name, QString* desc, QString* keywords) const;
+        QHash<FilePath, ElementTranslations> getElementTranslations(const QString& table,
+            const QString& idRow, const QList<FilePath>& elemDirs,
+            const QStringList& localeOrder) const;
+        QString prepareFilePathPlaceholders(const QList<FilePath>& elemDirs, int offset,
+                                            QHash<QString, FilePath>& elemDirsByRelPath) const noexcept;
         QMultiMap<Version, FilePath> getElementFilePathsFromDb(const QString& tablename,
                                                                const Uuid& uuid) const;
-        FilePath getLatestVersionFilePath(const QMultiMap<Version, FilePath>& list) const noexcept;
+        FilePath getLatestVersionFilePath(const QString& tablename, const Uuid& uuid) const;
+        QHash<Uuid, FilePath> getLatestVersionFilePaths(const QString& tablename,
+                                                        const QSet<Uuid>& uuids) const;
+        const QHash<Uuid, FilePath>& getLatestVersionCache(const QString& tablename) const;
+        void clearLatestVersionCache() noexcept;
+        QList<Uuid> searchElements(const QString& table, const QString& idRow,
+                                   const QString& query, const QStringList& localeOrder,
+                                   int limit, int offset) const;
+        static QString toFtsQuery(const QString& query) noexcept;
         QSet<Uuid> getCategoryChilds(const QString& tablename, const Uuid& categoryUuid) const;
-        QList<Uuid> getCategoryParents(const QString& tablename, Uuid category) const;
-        Uuid getCategoryParent(const QString& tablename, const Uuid& category) const;
+        QList<Uuid> getCategoryParents(const QString& tablename, const Uuid& category) const;
+        QSet<Uuid> getCategorySubtree(const QString& tablename, const Uuid& category) const;
+        QSet<Uuid> getElementsInCategorySubtree(const QString& tablename,
+                                                const QString& idrowname,
+                                                const QString& categoryTablename,
+                                                const Uuid& category) const;
         QSet<Uuid> getElementsByCategory(const QString& tablename, const QString& idrowname,
                                          const Uuid& categoryUuid) const;
+        QList<Uuid> getElementsByCategorySortedByName(const QString& tablename,
+                                                      const QString& idrowname,
+                                                      const Uuid& categoryUuid) const;
+        static QSet<Uuid> getUuidsFromQuery(QSqlQuery& query);
         int getLibraryId(const FilePath& lib) const;
         QList<FilePath> getLibraryElements(const FilePath& lib, const QString& tablename) const;
         void createAllTables();
@@ -149,11 +484,23 @@ class WorkspaceLibraryDb final : public QObject
 
         // Attributes
         Workspace& mWorkspace;
+        FilePath mFilePath; ///< path to "library_cache.sqlite"
         QScopedPointer<SQLiteDatabase> mDb; ///< the SQLite database "library_cache.sqlite"
+        mutable QMutex mReadOnlyConnectionsMutex;
+        mutable QHash<QThread*, std::shared_ptr<SQLiteDatabase>> mReadOnlyConnections;
         QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+        QScopedPointer<WorkspaceLibraryWatcher> mLibraryWatcher;
+        QScopedPointer<WorkspaceProjectIndexer> mProjectIndexer;
+        int mScanSuspendCount; ///< scans are deferred while this is greater than zero
+        mutable QMutex mLocaleOrderMutex;
+        QStringList mLocaleOrder; ///< see #getLocaleOrder(), protected by #mLocaleOrderMutex
+        mutable QMutex mLatestVersionCacheMutex;
+        mutable QHash<QString, QHash<Uuid, FilePath>> mLatestVersionCache; ///< latest version of every element per table, cleared after scans
 
         // Constants
-        static const int sCurrentDbVersion = 1;
+        static const int sCurrentDbVersion = 8;
+        static const int sMaxFilePathsPerQuery = 500; ///< SQLite allows max. 999 parameters
+        static const int sMaxCategoryDepth = 1000; ///< to abort endless loops
 };
 
 /*****************************************************************************************
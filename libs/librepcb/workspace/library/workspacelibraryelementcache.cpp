@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "workspacelibraryelementcache.h"
+#include <librepcb/common/memoryreport.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/pkg/package.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+WorkspaceLibraryElementCache::WorkspaceLibraryElementCache(int maxElementCount) noexcept :
+    QObject(nullptr), mEntries(maxElementCount)
+{
+}
+
+WorkspaceLibraryElementCache::~WorkspaceLibraryElementCache() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WorkspaceLibraryElementCache::clear() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    mEntries.clear();
+}
+
+void WorkspaceLibraryElementCache::addToMemoryReport(MemoryReport& parent) const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    qint64 bytes = 0;
+    foreach (const QString& key, mEntries.keys()) {
+        const Entry* entry = mEntries.object(key);
+        bytes += MemoryReport::getStringSize(key) + sizeof(Entry)
+               + entry->element->getApproximateMemoryUsage();
+    }
+    parent.addChild("Library element cache", bytes, mEntries.count());
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QDateTime WorkspaceLibraryElementCache::getModificationTime(const FilePath& fp) noexcept
+{
+    return QFileInfo(fp.toStr()).lastModified();
+}
+
+void WorkspaceLibraryElementCache::compactGeometry(library::LibraryBaseElement& element) noexcept
+{
+    if (library::Symbol* symbol = dynamic_cast<library::Symbol*>(&element)) {
+        symbol->compactPolygons();
+    } else if (library::Package* package = dynamic_cast<library::Package*>(&element)) {
+        package->compactPolygons();
+    }
+}
+
+std::shared_ptr<const library::LibraryBaseElement> WorkspaceLibraryElementCache::find(
+    const FilePath& dir, const QDateTime& modified) noexcept
+{
+    QMutexLocker locker(&mMutex);
+    // QCache::object() also marks the entry as most recently used
+    Entry* entry = mEntries.object(dir.toStr());
+    if (entry && (entry->modified == modified)) {
+        return entry->element;
+    } else {
+        return nullptr;
+    }
+}
+
+void WorkspaceLibraryElementCache::insert(const FilePath& dir, const QDateTime& modified,
+    const std::shared_ptr<const library::LibraryBaseElement>& element) noexcept
+{
+    // elements which are still in use stay alive through their shared pointer, even if
+    // they get evicted here
+    QMutexLocker locker(&mMutex);
+    mEntries.insert(dir.toStr(), new Entry{modified, element});
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
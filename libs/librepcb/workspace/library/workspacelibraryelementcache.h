@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_WORKSPACELIBRARYELEMENTCACHE_H
+#define LIBREPCB_WORKSPACE_WORKSPACELIBRARYELEMENTCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <memory>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/library/librarybaseelement.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class MemoryReport;
+
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class WorkspaceLibraryElementCache
+ ****************************************************************************************/
+
+/**
+ * @brief The WorkspaceLibraryElementCache class keeps recently loaded (read-only)
+ *        library elements of the workspace libraries in memory
+ *
+ * Dialogs and docks which only need to show library elements (e.g. previews of devices
+ * or symbols) can get them from this cache instead of loading them from disk again and
+ * again. Elements are identified by their directory and are reloaded automatically if
+ * the modification time of their XML file has changed. The cache is cleared whenever
+ * the #WorkspaceLibraryDb has finished a rescan of the libraries.
+ *
+ * The returned elements are immutable and shared, so they must not be added to a
+ * project library. Use a fresh copy of the element for that purpose. To reduce the
+ * memory usage, the polygons of cached symbols and footprints are stored in the compact
+ * representation (see librepcb::CompactPolygonList), so read-only users must also
+ * consider librepcb::library::Symbol::getCompactPolygons() and
+ * librepcb::library::Footprint::getCompactPolygons().
+ *
+ * @note This class is thread-safe, so worker threads can get elements from it as well
+ *       (e.g. librepcb::ProjectLibraryUpdater). Elements are loaded without holding the
+ *       lock; if two threads load the same element concurrently, both get a valid
+ *       element and the one inserted last is kept in the cache.
+ */
+class WorkspaceLibraryElementCache final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        WorkspaceLibraryElementCache(const WorkspaceLibraryElementCache& other) = delete;
+        explicit WorkspaceLibraryElementCache(int maxElementCount = 256) noexcept;
+        ~WorkspaceLibraryElementCache() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Get a (cached) library element
+         *
+         * @tparam ElementType  The type of the library element (e.g. library::Device)
+         *
+         * @param dir   The directory of the library element
+         *
+         * @return The loaded element (never nullptr)
+         *
+         * @throw Exception if the element could not be loaded
+         */
+        template <typename ElementType>
+        std::shared_ptr<const ElementType> getElement(const FilePath& dir) {
+            QDateTime modified = getModificationTime(
+                dir.getPathTo(ElementType::getLongElementName() % ".xml"));
+            std::shared_ptr<const ElementType> element =
+                std::dynamic_pointer_cast<const ElementType>(find(dir, modified));
+            if (!element) {
+                std::shared_ptr<ElementType> loaded =
+                    std::make_shared<ElementType>(dir, true); // can throw
+                compactGeometry(*loaded);
+                element = loaded;
+                insert(dir, modified, element);
+            }
+            return element;
+        }
+
+        /**
+         * @brief Remove all elements from the cache
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of all cached elements to a report
+         */
+        void addToMemoryReport(MemoryReport& parent) const noexcept;
+
+        // Operator Overloadings
+        WorkspaceLibraryElementCache& operator=(const WorkspaceLibraryElementCache& rhs) = delete;
+
+
+    private: // Types
+
+        struct Entry {
+            QDateTime modified;
+            std::shared_ptr<const library::LibraryBaseElement> element;
+        };
+
+
+    private: // Methods
+
+        static QDateTime getModificationTime(const FilePath& fp) noexcept;
+        static void compactGeometry(library::LibraryBaseElement& element) noexcept;
+        std::shared_ptr<const library::LibraryBaseElement> find(const FilePath& dir,
+            const QDateTime& modified) noexcept;
+        void insert(const FilePath& dir, const QDateTime& modified,
+            const std::shared_ptr<const library::LibraryBaseElement>& element) noexcept;
+
+
+    private: // Data
+
+        mutable QMutex mMutex;           ///< protects #mEntries
+        QCache<QString, Entry> mEntries; ///< key: element directory
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WORKSPACE_WORKSPACELIBRARYELEMENTCACHE_H
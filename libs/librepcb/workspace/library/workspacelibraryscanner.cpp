@@ -20,11 +20,16 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <type_traits>
 #include <QtCore>
 #include "workspacelibraryscanner.h"
+#include <librepcb/common/attributes/attributetype.h>
+#include <librepcb/common/attributes/attributeunit.h>
+#include <librepcb/common/debugtrace.h>
 #include <librepcb/common/sqlitedatabase.h>
 #include <librepcb/library/elements.h>
 #include "../workspace.h"
+#include "workspacelibrarydb.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -34,13 +39,78 @@ namespace workspace {
 
 using namespace library;
 
+/*****************************************************************************************
+ *  Class WorkspaceLibraryScanner::ElementParser
+ ****************************************************************************************/
+
+/**
+ * @brief Parses a single library element directory in a thread pool worker
+ *
+ * The parser does not access the database at all, it only puts the parsed element into
+ * the queue of the database writer (which runs in the scanner thread). Exactly one
+ * result is enqueued per parser, even if parsing failed or the scan was aborted.
+ *
+ * If an index entry is passed and matches the content hash of the directory, the
+ * element is not parsed at all but the index entry is enqueued instead.
+ */
+template <typename ElementType>
+class WorkspaceLibraryScanner::ElementParser final : public QRunnable
+{
+    public:
+        ElementParser(const FilePath& filepath, const DirectoryState& state,
+                      const LibraryIndex::Entry* indexEntry,
+                      ParsedElementQueue<ElementType>& queue,
+                      const volatile bool& abort) noexcept :
+            mFilePath(filepath), mState(state), mIndexEntry(indexEntry), mQueue(queue),
+            mAbort(abort)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() noexcept override
+        {
+            ParsedElement<ElementType> result = {mFilePath, mState,
+                                                 QSharedPointer<ElementType>(), nullptr};
+            if ((!mAbort) && mIndexEntry) {
+                if (result.state.hash.isEmpty()) {
+                    result.state.hash = LibraryIndex::calcDirectoryHash(mFilePath);
+                }
+                if (result.state.hash == mIndexEntry->hash) {
+                    result.indexEntry = mIndexEntry; // no need to parse the element
+                }
+            }
+            if ((!mAbort) && (!result.indexEntry)) {
+                try {
+                    result.element.reset(new ElementType(mFilePath, true)); // can throw
+                    if (result.state.hash.isEmpty()) {
+                        result.state.hash = LibraryIndex::calcDirectoryHash(mFilePath);
+                    }
+                } catch (const Exception& e) {
+                    qWarning() << "Failed to open library element:" << mFilePath.toNative();
+                }
+            }
+            QMutexLocker locker(&mQueue.mutex);
+            mQueue.elements.enqueue(result);
+            mQueue.available.wakeOne();
+        }
+
+    private:
+        FilePath mFilePath;
+        DirectoryState mState;
+        const LibraryIndex::Entry* mIndexEntry; ///< nullptr if not contained in the index
+        ParsedElementQueue<ElementType>& mQueue;
+        const volatile bool& mAbort;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 WorkspaceLibraryScanner::WorkspaceLibraryScanner(Workspace& ws) noexcept :
-    QThread(nullptr), mWorkspace(ws), mAbort(false)
+    QThread(nullptr), mWorkspace(ws), mAbort(false), mTotalCount(0), mProcessedCount(0),
+    mLastReportedPercent(0), mFullScanRequested(false)
 {
+    mParserPool.setMaxThreadCount(qMax(QThread::idealThreadCount(), 1));
 }
 
 WorkspaceLibraryScanner::~WorkspaceLibraryScanner() noexcept
@@ -55,65 +125,166 @@ WorkspaceLibraryScanner::~WorkspaceLibraryScanner() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WorkspaceLibraryScanner::requestFullScan() noexcept
+{
+    QMutexLocker locker(&mRequestsMutex);
+    mFullScanRequested = true;
+    mRequestedLibraries.clear();
+}
+
+void WorkspaceLibraryScanner::requestLibraryUpdate(const FilePath& libDir,
+                                                   const QSet<FilePath>& elementDirs) noexcept
+{
+    QMutexLocker locker(&mRequestsMutex);
+    if (mFullScanRequested) {
+        return; // the library will be updated anyway
+    }
+    auto it = mRequestedLibraries.find(libDir);
+    if (it == mRequestedLibraries.end()) {
+        mRequestedLibraries.insert(libDir, elementDirs);
+    } else if (elementDirs.isEmpty()) {
+        it.value().clear(); // update the whole library
+    } else if (!it.value().isEmpty()) {
+        it.value().unite(elementDirs);
+    }
+}
+
+bool WorkspaceLibraryScanner::hasPendingRequests() const noexcept
+{
+    QMutexLocker locker(&mRequestsMutex);
+    return mFullScanRequested || (!mRequestedLibraries.isEmpty());
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
 void WorkspaceLibraryScanner::run() noexcept
 {
+    LIBREPCB_TRACE_SCOPE("WorkspaceLibraryScanner::run");
     try {
         mAbort = false;
+
+        // take the requests which were made until now (requests made while scanning
+        // will be processed by the next run)
+        QHash<FilePath, QSet<FilePath>> scopes; // empty set = whole library
+        bool fullScan = takePendingRequests(scopes);
+        if ((!fullScan) && scopes.isEmpty()) {
+            return; // nothing to do
+        }
         emit started();
 
-        // get a list of all available libraries
-        QList<QSharedPointer<library::Library>> libraries;
-        libraries.append(mWorkspace.getLocalLibraries().values());
-        libraries.append(mWorkspace.getRemoteLibraries().values());
+        // get a list of all libraries to scan (the libraries are only opened if their
+        // metadata has changed, see updateLibraryInDb())
+        QList<FilePath> libraries;
+        QList<FilePath> allLibraries;
+        allLibraries.append(mWorkspace.getLocalLibraryDirectories().values());
+        allLibraries.append(mWorkspace.getRemoteLibraryDirectories().values());
+        foreach (const FilePath& libDir, allLibraries) {
+            if (fullScan || scopes.contains(libDir)) {
+                libraries.append(libDir);
+            }
+        }
+
+        // search for all library elements (cheap compared to parsing them) to be able to
+        // report an accurate progress
+        struct LibraryDirectories {
+            QList<FilePath> cmpcat, pkgcat, sym, pkg, cmp, dev;
+            QSet<FilePath> scope; ///< the element directories to update (empty = all)
+        };
+        QList<LibraryDirectories> directories;
+        mTotalCount = 0;
+        foreach (const FilePath& libDir, libraries) {
+            LibraryDirectories dirs = {Library::searchForElements<ComponentCategory>(libDir),
+                                       Library::searchForElements<PackageCategory>(libDir),
+                                       Library::searchForElements<Symbol>(libDir),
+                                       Library::searchForElements<Package>(libDir),
+                                       Library::searchForElements<Component>(libDir),
+                                       Library::searchForElements<Device>(libDir),
+                                       scopes.value(libDir)};
+            if (!dirs.scope.isEmpty()) {
+                for (QList<FilePath>* list : {&dirs.cmpcat, &dirs.pkgcat, &dirs.sym,
+                                              &dirs.pkg, &dirs.cmp, &dirs.dev}) {
+                    for (auto it = list->begin(); it != list->end();) {
+                        it = dirs.scope.contains(*it) ? (it + 1) : list->erase(it);
+                    }
+                }
+            }
+            mTotalCount += dirs.cmpcat.count() + dirs.pkgcat.count() + dirs.sym.count()
+                         + dirs.pkg.count() + dirs.cmp.count() + dirs.dev.count();
+            directories.append(dirs);
+        }
+        mProcessedCount = 0;
+        mLastReportedPercent = 0;
 
         // open SQLite database
         FilePath dbFilePath = mWorkspace.getMetadataPath().getPathTo("library_cache.sqlite");
         SQLiteDatabase db(dbFilePath); // can throw
 
-        // begin database transaction
-        SQLiteDatabase::TransactionScopeGuard transactionGuard(db); // can throw
-
-        // clear all tables
-        clearAllTables(db);
-
-        // scan all libraries
+        // scan all libraries (the changes are committed library by library, so other
+        // connections are never blocked for a long time and see the updated libraries
+        // as soon as possible)
+        QElapsedTimer timer;
+        timer.start();
         int count = 0;
-        qreal percent = 0;
-        foreach (const QSharedPointer<Library>& lib, libraries) {
-            int libId = addLibraryToDb(db, lib);
+        QSet<int> libIds;
+        for (int i = 0; i < libraries.count(); ++i) {
+            const LibraryDirectories& dirs = directories.at(i);
+            SQLiteDatabase::TransactionScopeGuard transactionGuard(db); // can throw
+            // read within the transaction, so a concurrent change of the locale order
+            // either sees the scanned elements or has been committed before
+            mLocaleOrder = WorkspaceLibraryDb::readLocaleOrder(db); // can throw
+            int libId = -1;
+            try {
+                libId = updateLibraryInDb(db, libraries.at(i)); // can throw
+            } catch (const Exception& e) {
+                // an invalid library must not prevent the other libraries from being scanned
+                qCritical() << "Could not scan library" << libraries.at(i).toNative()
+                            << ":" << e.getMsg();
+                continue;
+            }
+            libIds.insert(libId);
+            if (mAbort) break;
+            QSharedPointer<LibraryIndex> index = loadLibraryIndex(libraries.at(i));
+            count += updateElementsInDb<ComponentCategory>(db, dirs.cmpcat,
+                                                           "component_categories", "cat_id", libId,
+                                                           dirs.scope, index.data());
             if (mAbort) break;
-            count += addCategoriesToDb<ComponentCategory>(db, lib->searchForElements<ComponentCategory>(),
-                                                          "component_categories", "cat_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            count += updateElementsInDb<PackageCategory>(db, dirs.pkgcat,
+                                                         "package_categories", "cat_id", libId,
+                                                         dirs.scope, index.data());
             if (mAbort) break;
-            count += addCategoriesToDb<PackageCategory>(db, lib->searchForElements<PackageCategory>(),
-                                                        "package_categories", "cat_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            count += updateElementsInDb<Symbol>(db, dirs.sym, "symbols", "symbol_id", libId,
+                                                dirs.scope, index.data());
             if (mAbort) break;
-            count += addElementsToDb<Symbol>(db, lib->searchForElements<Symbol>(),
-                                             "symbols", "symbol_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            count += updateElementsInDb<Package>(db, dirs.pkg, "packages", "package_id", libId,
+                                                 dirs.scope, index.data());
             if (mAbort) break;
-            count += addElementsToDb<Package>(db, lib->searchForElements<Package>(),
-                                              "packages", "package_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            count += updateElementsInDb<Component>(db, dirs.cmp,
+                                                   "components", "component_id", libId,
+                                                   dirs.scope, index.data());
             if (mAbort) break;
-            count += addElementsToDb<Component>(db, lib->searchForElements<Component>(),
-                                                "components", "component_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            count += updateElementsInDb<Device>(db, dirs.dev, "devices", "device_id", libId,
+                                                dirs.scope, index.data());
             if (mAbort) break;
-            count += addDevicesToDb(db, lib->searchForElements<Device>(),
-                                    "devices", "device_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            transactionGuard.commit(); // can throw
         }
 
-        // commit transaction
-        if (!mAbort) {
+        // remove libraries which do no longer exist
+        if (fullScan && (!mAbort)) {
+            SQLiteDatabase::TransactionScopeGuard transactionGuard(db); // can throw
+            removeObsoleteLibrariesFromDb(db, libIds);
             transactionGuard.commit(); // can throw
+        }
+
+        if (!mAbort) {
+            qDebug() << "Workspace library scan finished in" << timer.elapsed() << "ms"
+                     << "(" << libraries.count() << "libraries)";
+            emit progressUpdate(100);
             emit succeeded(count);
         }
     } catch (const Exception& e) {
@@ -121,201 +292,533 @@ void WorkspaceLibraryScanner::run() noexcept
     }
 }
 
-void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db)
+bool WorkspaceLibraryScanner::takePendingRequests(
+    QHash<FilePath, QSet<FilePath>>& libraries) noexcept
 {
-    // libraries
-    db.clearTable("libraries_tr");
-    db.clearTable("libraries");
-
-    // component categories
-    db.clearTable("component_categories_tr");
-    db.clearTable("component_categories");
-
-    // package categories
-    db.clearTable("package_categories_tr");
-    db.clearTable("package_categories");
-
-    // symbols
-    db.clearTable("symbols_tr");
-    db.clearTable("symbols_cat");
-    db.clearTable("symbols");
-
-    // packages
-    db.clearTable("packages_tr");
-    db.clearTable("packages_cat");
-    db.clearTable("packages");
-
-    // components
-    db.clearTable("components_tr");
-    db.clearTable("components_cat");
-    db.clearTable("components");
-
-    // devices
-    db.clearTable("devices_tr");
-    db.clearTable("devices_cat");
-    db.clearTable("devices");
+    QMutexLocker locker(&mRequestsMutex);
+    bool fullScan = mFullScanRequested;
+    libraries = mRequestedLibraries;
+    mFullScanRequested = false;
+    mRequestedLibraries.clear();
+    return fullScan;
 }
 
-int WorkspaceLibraryScanner::addLibraryToDb(SQLiteDatabase& db,
-                                            const QSharedPointer<library::Library>& lib)
+void WorkspaceLibraryScanner::reportProgress(int processedElements) noexcept
 {
-    QSqlQuery query = db.prepareQuery(
-        "INSERT INTO libraries "
-        "(filepath, uuid, version) VALUES "
-        "(:filepath, :uuid, :version)");
-    query.bindValue(":filepath",    lib->getFilePath().toRelative(mWorkspace.getLibrariesPath()));
-    query.bindValue(":uuid",        lib->getUuid().toStr());
-    query.bindValue(":version",     lib->getVersion().toStr());
-    int id = db.insert(query);
-    foreach (const QString& locale, lib->getAllAvailableLocales()) {
+    mProcessedCount += processedElements;
+    LIBREPCB_TRACE_COUNTER("WorkspaceLibraryScanner processed elements", mProcessedCount);
+    int percent = (mTotalCount > 0) ? (100 * mProcessedCount / mTotalCount) : 100;
+    if (percent != mLastReportedPercent) {
+        mLastReportedPercent = percent;
+        emit progressUpdate(percent);
+    }
+}
+
+int WorkspaceLibraryScanner::updateLibraryInDb(SQLiteDatabase& db, const FilePath& libDir)
+{
+    QString relPath = libDir.toRelative(mWorkspace.getLibrariesPath());
+    DirectoryState state = getDirectoryState(libDir);
+
+    QSqlQuery select = db.prepareQuery(
+        "SELECT id, mtime, size, hash FROM libraries WHERE filepath = :filepath");
+    select.bindValue(":filepath", relPath);
+    db.exec(select);
+    int id = -1;
+    if (select.next()) {
+        id = select.value(0).toInt();
+        DirectoryState cached = {select.value(1).toLongLong(), select.value(2).toLongLong(),
+                                 select.value(3).toString()};
+        if (!hasDirectoryChanged(cached, state, libDir)) {
+            updateStateInDb(db, "libraries", id, cached, state);
+            return id; // library metadata is still up to date
+        }
+    }
+
+    // the library needs to be parsed anyway, so the hash can be calculated right now
+    QScopedPointer<Library> lib(new Library(libDir, true)); // can throw
+    if (state.hash.isEmpty()) {
+        state.hash = LibraryIndex::calcDirectoryHash(libDir);
+    }
+
+    if (id >= 0) {
+        // keep the ID of the library as it is referenced by all its elements
+        QSqlQuery query = db.prepareQuery(
+            "UPDATE libraries SET uuid = :uuid, version = :version, "
+            "version_key = :version_key, mtime = :mtime, size = :size, hash = :hash "
+            "WHERE id = :id");
+        query.bindValue(":uuid",        lib->getUuid().toStr());
+        query.bindValue(":version",     lib->getVersion().toStr());
+        query.bindValue(":version_key", lib->getVersion().toComparableBlob());
+        query.bindValue(":mtime",       state.mtime);
+        query.bindValue(":size",        state.size);
+        query.bindValue(":hash",        state.hash);
+        query.bindValue(":id",          id);
+        db.exec(query);
+        QSqlQuery deleteTr = db.prepareQuery("DELETE FROM libraries_tr WHERE lib_id = :id");
+        deleteTr.bindValue(":id", id);
+        db.exec(deleteTr);
+    } else {
         QSqlQuery query = db.prepareQuery(
-            "INSERT INTO libraries_tr "
-            "(lib_id, locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id",  id);
-        query.bindValue(":locale",      locale);
-        query.bindValue(":name",        lib->getNames().value(locale));
-        query.bindValue(":description", lib->getDescriptions().value(locale));
-        query.bindValue(":keywords",    lib->getKeywords().value(locale));
-        db.insert(query);
+            "INSERT INTO libraries "
+            "(filepath, uuid, version, version_key, mtime, size, hash) VALUES "
+            "(:filepath, :uuid, :version, :version_key, :mtime, :size, :hash)");
+        query.bindValue(":filepath",    relPath);
+        query.bindValue(":uuid",        lib->getUuid().toStr());
+        query.bindValue(":version",     lib->getVersion().toStr());
+        query.bindValue(":version_key", lib->getVersion().toComparableBlob());
+        query.bindValue(":mtime",       state.mtime);
+        query.bindValue(":size",        state.size);
+        query.bindValue(":hash",        state.hash);
+        id = db.insert(query);
     }
+    addTranslationsToDb(db, *lib, "libraries", "lib_id", id);
     return id;
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addCategoriesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-    const QString& table, const QString& idColumn, int libId)
+int WorkspaceLibraryScanner::updateElementsInDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
+    const QString& table, const QString& idColumn, int libId, const QSet<FilePath>& scope,
+    const LibraryIndex* index)
 {
+    // elements which are not found in the filesystem anymore will be removed at the end
+    QHash<QString, CachedEntry> obsoleteEntries = getCachedEntries(db, table, libId);
+    if (!scope.isEmpty()) {
+        // elements outside the scope are not touched at all
+        QSet<QString> relPaths;
+        foreach (const FilePath& filepath, scope) {
+            relPaths.insert(filepath.toRelative(mWorkspace.getLibrariesPath()));
+        }
+        for (auto it = obsoleteEntries.begin(); it != obsoleteEntries.end();) {
+            it = relPaths.contains(it.key()) ? (it + 1) : obsoleteEntries.erase(it);
+        }
+    }
+    bool hasCategories = !std::is_base_of<LibraryCategory, ElementType>::value;
+
+    // determine which elements need to be (re)parsed
     int count = 0;
+    QList<QPair<FilePath, DirectoryState>> modifiedDirs;
     foreach (const FilePath& filepath, dirs) {
         if (mAbort) break;
-        try {
-            ElementType element(filepath, true); // can throw
-            QSqlQuery query = db.prepareQuery(
-                "INSERT INTO " % table % " "
-                "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
-                "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
-            query.bindValue(":lib_id",      libId);
-            query.bindValue(":filepath",    filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",        element.getUuid().toStr());
-            query.bindValue(":version",     element.getVersion().toStr());
-            query.bindValue(":parent_uuid", element.getParentUuid().isNull() ? QVariant(QVariant::String) : element.getParentUuid().toStr());
-            int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_tr "
-                    "(" % idColumn % ", locale, name, description, keywords) VALUES "
-                    "(:element_id, :locale, :name, :description, :keywords)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
-                db.insert(query);
+        QString relPath = filepath.toRelative(mWorkspace.getLibrariesPath());
+        DirectoryState state = getDirectoryState(filepath);
+        auto it = obsoleteEntries.find(relPath);
+        if (it != obsoleteEntries.end()) {
+            CachedEntry entry = it.value();
+            obsoleteEntries.erase(it);
+            if (!hasDirectoryChanged(entry.state, state, filepath)) {
+                updateStateInDb(db, table, entry.id, entry.state, state);
+                count++;
+                reportProgress(1);
+                continue; // element is still up to date
             }
+            removeElementFromDb(db, table, idColumn, hasCategories, entry.id);
+        }
+        modifiedDirs.append(qMakePair(filepath, state));
+    }
+
+    // Parse the added/modified elements in worker threads, but write them into the
+    // database only from this thread since the database connection is not shared.
+    ParsedElementQueue<ElementType> queue;
+    typedef QPair<FilePath, DirectoryState> DirAndState;
+    foreach (const DirAndState& pair, modifiedDirs) {
+        const LibraryIndex::Entry* entry = index ? index->getEntry(pair.first) : nullptr;
+        if (entry && (entry->type != ElementType::getShortElementName())) {
+            entry = nullptr;
+        }
+        if (entry && (entry->type == Component::getShortElementName()) &&
+            entry->symbols.isEmpty()) {
+            entry = nullptr; // index created before symbols were added to it
+        }
+        mParserPool.start(new ElementParser<ElementType>(pair.first, pair.second, entry,
+                                                         queue, mAbort));
+    }
+    int parsedCount = 0;
+    int indexedCount = 0; ///< elements added from the index (without parsing them)
+    for (int i = 0; i < modifiedDirs.count(); ++i) {
+        ParsedElement<ElementType> parsed;
+        {
+            QMutexLocker locker(&queue.mutex);
+            while (queue.elements.isEmpty()) {
+                queue.available.wait(&queue.mutex);
+            }
+            parsed = queue.elements.dequeue();
+        }
+        // on abort, just wait until all workers have finished (they will skip parsing)
+        if (parsed.indexEntry && (!mAbort)) {
+            addIndexEntryToDb(db, *parsed.indexEntry, parsed.filepath, parsed.state, table,
+                              idColumn, libId);
+            parsedCount++;
+            indexedCount++;
+            count++;
+        } else if (parsed.element && (!mAbort)) {
+            addElementToDb(db, *parsed.element, parsed.state, table, idColumn, libId);
+            parsedCount++;
             count++;
-        } catch (const Exception& e) {
-            qWarning() << "Failed to open library element:" << filepath.toNative();
+        }
+        reportProgress(1);
+    }
+
+    // precompute the translations of the added/modified elements
+    if ((parsedCount > 0) && (!mAbort)) {
+        WorkspaceLibraryDb::resolveTranslations(db, table, idColumn, mLocaleOrder,
+                                                libId); // can throw
+    }
+
+    // remove elements which do no longer exist
+    if (!mAbort) {
+        foreach (const CachedEntry& entry, obsoleteEntries) {
+            removeElementFromDb(db, table, idColumn, hasCategories, entry.id);
         }
     }
+
+    if ((parsedCount > 0) || (!obsoleteEntries.isEmpty())) {
+        qDebug() << "Library scanner:" << parsedCount << "added/modified (" << indexedCount
+                 << "from index) and" << obsoleteEntries.count()
+                 << "removed elements in table" << table;
+    }
     return count;
 }
 
-template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
+int WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
+    const LibraryCategory& element, const DirectoryState& state, const QString& table,
+    const QString& idColumn, int libId)
+{
+    QHash<QString, QVariant> columns;
+    columns.insert("parent_uuid", element.getParentUuid().isNull() ?
+                   QVariant(QVariant::String) : element.getParentUuid().toStr());
+    int id = insertElementRow(db, element.getFilePath(), element.getUuid(),
+                              element.getVersion(), state, table, libId, columns);
+    addTranslationsToDb(db, element, table, idColumn, id);
+    return id;
+}
+
+int WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
+    const LibraryElement& element, const DirectoryState& state, const QString& table,
+    const QString& idColumn, int libId)
+{
+    int id = insertElementRow(db, element.getFilePath(), element.getUuid(),
+                              element.getVersion(), state, table, libId,
+                              QHash<QString, QVariant>());
+    addTranslationsToDb(db, element, table, idColumn, id);
+    addCategoryAssignmentsToDb(db, element.getCategories(), table, idColumn, id);
+    return id;
+}
+
+int WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
+    const Component& element, const DirectoryState& state, const QString& table,
+    const QString& idColumn, int libId)
+{
+    int id = insertElementRow(db, element.getFilePath(), element.getUuid(),
+                              element.getVersion(), state, table, libId,
+                              QHash<QString, QVariant>());
+    addTranslationsToDb(db, element, table, idColumn, id);
+    addCategoryAssignmentsToDb(db, element.getCategories(), table, idColumn, id);
+    addAttributesToDb(db, element.getAttributes(), table, idColumn, id);
+    QSet<Uuid> symbols;
+    for (const ComponentSymbolVariant& variant : element.getSymbolVariants()) {
+        symbols.unite(variant.getAllSymbolUuids());
+    }
+    addSymbolReferencesToDb(db, symbols, id);
+    return id;
+}
+
+int WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
+    const Device& element, const DirectoryState& state, const QString& table,
+    const QString& idColumn, int libId)
+{
+    QHash<QString, QVariant> columns;
+    columns.insert("component_uuid", element.getComponentUuid().toStr());
+    columns.insert("package_uuid", element.getPackageUuid().toStr());
+    int id = insertElementRow(db, element.getFilePath(), element.getUuid(),
+                              element.getVersion(), state, table, libId, columns);
+    addTranslationsToDb(db, element, table, idColumn, id);
+    addCategoryAssignmentsToDb(db, element.getCategories(), table, idColumn, id);
+    return id;
+}
+
+int WorkspaceLibraryScanner::addIndexEntryToDb(SQLiteDatabase& db,
+    const LibraryIndex::Entry& entry, const FilePath& filepath, const DirectoryState& state,
     const QString& table, const QString& idColumn, int libId)
 {
-    int count = 0;
-    foreach (const FilePath& filepath, dirs) {
-        if (mAbort) break;
-        try {
-            ElementType element(filepath, true); // can throw
-            QSqlQuery query = db.prepareQuery(
-                "INSERT INTO " % table % " "
-                "(lib_id, filepath, uuid, version) VALUES "
-                "(:lib_id, :filepath, :uuid, :version)");
-            query.bindValue(":lib_id",      libId);
-            query.bindValue(":filepath",    filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",        element.getUuid().toStr());
-            query.bindValue(":version",     element.getVersion().toStr());
-            int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_tr "
-                    "(" % idColumn % ", locale, name, description, keywords) VALUES "
-                    "(:element_id, :locale, :name, :description, :keywords)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
-                db.insert(query);
-            }
-            foreach (const Uuid& categoryUuid, element.getCategories()) {
-                Q_ASSERT(!categoryUuid.isNull());
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_cat "
-                    "(" % idColumn % ", category_uuid) VALUES "
-                    "(:element_id, :category_uuid)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":category_uuid", categoryUuid.toStr());
-                db.insert(query);
-            }
-            count++;
-        } catch (const Exception& e) {
-            qWarning() << "Failed to open library element:" << filepath.toNative();
+    // the same rows as addElementToDb() adds for the corresponding element type
+    QHash<QString, QVariant> columns;
+    if ((entry.type == ComponentCategory::getShortElementName()) ||
+        (entry.type == PackageCategory::getShortElementName())) {
+        columns.insert("parent_uuid", entry.parentUuid.isNull() ?
+                       QVariant(QVariant::String) : entry.parentUuid.toStr());
+    } else if (entry.type == Device::getShortElementName()) {
+        columns.insert("component_uuid", entry.componentUuid.toStr());
+        columns.insert("package_uuid", entry.packageUuid.toStr());
+    }
+    int id = insertElementRow(db, filepath, entry.uuid, entry.version, state, table, libId,
+                              columns);
+    addTranslationsToDb(db, entry.names, entry.descriptions, entry.keywords, table,
+                        idColumn, id);
+    addCategoryAssignmentsToDb(db, entry.categories, table, idColumn, id);
+    if (entry.type == Component::getShortElementName()) {
+        addAttributesToDb(db, entry.attributes, table, idColumn, id);
+        addSymbolReferencesToDb(db, entry.symbols, id);
+    }
+    return id;
+}
+
+int WorkspaceLibraryScanner::insertElementRow(SQLiteDatabase& db, const FilePath& filepath,
+    const Uuid& uuid, const Version& version, const DirectoryState& state,
+    const QString& table, int libId, const QHash<QString, QVariant>& extraColumns)
+{
+    QStringList columnNames = extraColumns.keys();
+    QString columns = "lib_id, filepath, uuid, version, version_key, mtime, size, hash";
+    QString values = ":lib_id, :filepath, :uuid, :version, :version_key, :mtime, :size, :hash";
+    foreach (const QString& column, columnNames) {
+        columns += ", " % column;
+        values += ", :" % column;
+    }
+    QSqlQuery& query = db.getCachedQuery(
+        "INSERT INTO " % table % " (" % columns % ") VALUES (" % values % ")");
+    query.bindValue(":lib_id",      libId);
+    query.bindValue(":filepath",    filepath.toRelative(mWorkspace.getLibrariesPath()));
+    query.bindValue(":uuid",        uuid.toStr());
+    query.bindValue(":version",     version.toStr());
+    query.bindValue(":version_key", version.toComparableBlob());
+    query.bindValue(":mtime",       state.mtime);
+    query.bindValue(":size",        state.size);
+    query.bindValue(":hash",        state.hash);
+    foreach (const QString& column, columnNames) {
+        query.bindValue(":" % column, extraColumns.value(column));
+    }
+    return db.insert(query);
+}
+
+void WorkspaceLibraryScanner::addTranslationsToDb(SQLiteDatabase& db,
+    const LibraryBaseElement& element, const QString& table, const QString& idColumn, int id)
+{
+    addTranslationsToDb(db, element.getNames(), element.getDescriptions(),
+                        element.getKeywords(), table, idColumn, id);
+}
+
+void WorkspaceLibraryScanner::addTranslationsToDb(SQLiteDatabase& db,
+    const LocalizedNameMap& names, const LocalizedDescriptionMap& descriptions,
+    const LocalizedKeywordsMap& keywords, const QString& table, const QString& idColumn,
+    int id)
+{
+    // same locales as librepcb::library::LibraryBaseElement::getAllAvailableLocales()
+    QStringList allLocales = names.keys() + descriptions.keys() + keywords.keys();
+    allLocales.removeDuplicates();
+    allLocales.sort(Qt::CaseSensitive);
+    QVariantList ids, locales, nameValues, descriptionValues, keywordValues;
+    foreach (const QString& locale, allLocales) {
+        ids.append(id);
+        locales.append(locale);
+        nameValues.append(names.value(locale));
+        descriptionValues.append(descriptions.value(locale));
+        keywordValues.append(keywords.value(locale));
+    }
+    if (ids.isEmpty()) return;
+    QSqlQuery& query = db.getCachedQuery(
+        "INSERT INTO " % table % "_tr "
+        "(" % idColumn % ", locale, name, description, keywords) VALUES "
+        "(:element_id, :locale, :name, :description, :keywords)");
+    query.bindValue(":element_id",  ids);
+    query.bindValue(":locale",      locales);
+    query.bindValue(":name",        nameValues);
+    query.bindValue(":description", descriptionValues);
+    query.bindValue(":keywords",    keywordValues);
+    db.execBatch(query);
+}
+
+void WorkspaceLibraryScanner::addAttributesToDb(SQLiteDatabase& db,
+    const AttributeList& attributes, const QString& table, const QString& idColumn, int id)
+{
+    QVariantList ids, keys, types, values, units, siValues;
+    for (const Attribute& attribute : attributes) {
+        qreal siValue = attribute.getSiValue();
+        ids.append(id);
+        keys.append(attribute.getKey());
+        types.append(attribute.getType().getName());
+        values.append(attribute.getValue());
+        units.append(attribute.getUnit() ? attribute.getUnit()->getName() : QString());
+        siValues.append(qIsNaN(siValue) ? QVariant(QVariant::Double) : QVariant(siValue));
+    }
+    if (ids.isEmpty()) return;
+    QSqlQuery& query = db.getCachedQuery(
+        "INSERT INTO " % table % "_attr "
+        "(" % idColumn % ", key, type, value, unit, si_value) VALUES "
+        "(:element_id, :key, :type, :value, :unit, :si_value)");
+    query.bindValue(":element_id",  ids);
+    query.bindValue(":key",         keys);
+    query.bindValue(":type",        types);
+    query.bindValue(":value",       values);
+    query.bindValue(":unit",        units);
+    query.bindValue(":si_value",    siValues);
+    db.execBatch(query);
+}
+
+void WorkspaceLibraryScanner::addCategoryAssignmentsToDb(SQLiteDatabase& db,
+    const QSet<Uuid>& categories, const QString& table, const QString& idColumn, int id)
+{
+    QVariantList ids, categoryUuids;
+    foreach (const Uuid& categoryUuid, categories) {
+        Q_ASSERT(!categoryUuid.isNull());
+        ids.append(id);
+        categoryUuids.append(categoryUuid.toStr());
+    }
+    if (ids.isEmpty()) return;
+    QSqlQuery& query = db.getCachedQuery(
+        "INSERT INTO " % table % "_cat "
+        "(" % idColumn % ", category_uuid) VALUES "
+        "(:element_id, :category_uuid)");
+    query.bindValue(":element_id",  ids);
+    query.bindValue(":category_uuid", categoryUuids);
+    db.execBatch(query);
+}
+
+void WorkspaceLibraryScanner::addSymbolReferencesToDb(SQLiteDatabase& db,
+                                                      const QSet<Uuid>& symbols, int id)
+{
+    QVariantList ids, symbolUuids;
+    foreach (const Uuid& symbolUuid, symbols) {
+        ids.append(id);
+        symbolUuids.append(symbolUuid.toStr());
+    }
+    if (ids.isEmpty()) return;
+    QSqlQuery& query = db.getCachedQuery(
+        "INSERT INTO components_sym (component_id, symbol_uuid) VALUES "
+        "(:element_id, :symbol_uuid)");
+    query.bindValue(":element_id",  ids);
+    query.bindValue(":symbol_uuid", symbolUuids);
+    db.execBatch(query);
+}
+
+QHash<QString, WorkspaceLibraryScanner::CachedEntry> WorkspaceLibraryScanner::getCachedEntries(
+    SQLiteDatabase& db, const QString& table, int libId) const
+{
+    QSqlQuery query = db.prepareQuery(
+        "SELECT id, filepath, mtime, size, hash FROM " % table % " WHERE lib_id = :lib_id");
+    query.bindValue(":lib_id", libId);
+    db.exec(query);
+
+    QHash<QString, CachedEntry> entries;
+    while (query.next()) {
+        CachedEntry entry = {query.value(0).toInt(), {query.value(2).toLongLong(),
+                             query.value(3).toLongLong(), query.value(4).toString()}};
+        entries.insert(query.value(1).toString(), entry);
+    }
+    return entries;
+}
+
+void WorkspaceLibraryScanner::updateStateInDb(SQLiteDatabase& db, const QString& table,
+    int id, const DirectoryState& cached, const DirectoryState& state)
+{
+    if ((cached.mtime == state.mtime) && (cached.size == state.size)) {
+        return; // nothing to update
+    }
+    QSqlQuery& query = db.getCachedQuery(
+        "UPDATE " % table % " SET mtime = :mtime, size = :size, hash = :hash "
+        "WHERE id = :id");
+    query.bindValue(":mtime",   state.mtime);
+    query.bindValue(":size",    state.size);
+    query.bindValue(":hash",    state.hash);
+    query.bindValue(":id",      id);
+    db.exec(query);
+}
+
+void WorkspaceLibraryScanner::removeElementFromDb(SQLiteDatabase& db, const QString& table,
+    const QString& idColumn, bool hasCategories, int id)
+{
+    // remove referencing rows first because of the foreign key constraints
+    QStringList tables;
+    tables << table % "_tr";
+    if (hasCategories) tables << table % "_cat";
+    if (table == "components") tables << table % "_attr" << table % "_sym";
+    foreach (const QString& subTable, tables) {
+        QSqlQuery& query = db.getCachedQuery(
+            "DELETE FROM " % subTable % " WHERE " % idColumn % " = :id");
+        query.bindValue(":id", id);
+        db.exec(query);
+    }
+    QSqlQuery& query = db.getCachedQuery("DELETE FROM " % table % " WHERE id = :id");
+    query.bindValue(":id", id);
+    db.exec(query);
+}
+
+void WorkspaceLibraryScanner::removeLibraryFromDb(SQLiteDatabase& db, int libId)
+{
+    struct ElementTable {QString table; QString idColumn; bool hasCategories;};
+    QList<ElementTable> tables = {
+        {"component_categories",    "cat_id",       false},
+        {"package_categories",      "cat_id",       false},
+        {"symbols",                 "symbol_id",    true},
+        {"packages",                "package_id",   true},
+        {"components",              "component_id", true},
+        {"devices",                 "device_id",    true},
+    };
+    foreach (const ElementTable& t, tables) {
+        foreach (const CachedEntry& entry, getCachedEntries(db, t.table, libId)) {
+            removeElementFromDb(db, t.table, t.idColumn, t.hasCategories, entry.id);
         }
     }
-    return count;
+    removeElementFromDb(db, "libraries", "lib_id", false, libId);
 }
 
-int WorkspaceLibraryScanner::addDevicesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-    const QString& table, const QString& idColumn, int libId)
+void WorkspaceLibraryScanner::removeObsoleteLibrariesFromDb(SQLiteDatabase& db,
+                                                            const QSet<int>& existingIds)
 {
-    int count = 0;
-    foreach (const FilePath& filepath, dirs) {
-        if (mAbort) break;
-        try {
-            Device element(filepath, true); // can throw
-            QSqlQuery query = db.prepareQuery(
-                "INSERT INTO " % table % " "
-                "(lib_id, filepath, uuid, version, component_uuid, package_uuid) VALUES "
-                "(:lib_id, :filepath, :uuid, :version, :component_uuid, :package_uuid)");
-            query.bindValue(":lib_id",      libId);
-            query.bindValue(":filepath",        filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",            element.getUuid().toStr());
-            query.bindValue(":version",         element.getVersion().toStr());
-            query.bindValue(":component_uuid",  element.getComponentUuid().toStr());
-            query.bindValue(":package_uuid",    element.getPackageUuid().toStr());
-            int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_tr "
-                    "(" % idColumn % ", locale, name, description, keywords) VALUES "
-                    "(:element_id, :locale, :name, :description, :keywords)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
-                db.insert(query);
-            }
-            foreach (const Uuid& categoryUuid, element.getCategories()) {
-                Q_ASSERT(!categoryUuid.isNull());
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_cat "
-                    "(" % idColumn % ", category_uuid) VALUES "
-                    "(:element_id, :category_uuid)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":category_uuid", categoryUuid.toStr());
-                db.insert(query);
-            }
-            count++;
-        } catch (const Exception& e) {
-            qWarning() << "Failed to open library element:" << filepath.toNative();
+    QSqlQuery query = db.prepareQuery("SELECT id FROM libraries");
+    db.exec(query);
+    QList<int> obsoleteIds;
+    while (query.next()) {
+        int id = query.value(0).toInt();
+        if (!existingIds.contains(id)) {
+            obsoleteIds.append(id);
         }
     }
-    return count;
+    foreach (int id, obsoleteIds) {
+        removeLibraryFromDb(db, id);
+    }
+}
+
+QSharedPointer<LibraryIndex> WorkspaceLibraryScanner::loadLibraryIndex(
+    const FilePath& libDir) noexcept
+{
+    if (!LibraryIndex::getFilePath(libDir).isExistingFile()) {
+        return QSharedPointer<LibraryIndex>(); // the index is optional
+    }
+    try {
+        return QSharedPointer<LibraryIndex>(new LibraryIndex(libDir)); // can throw
+    } catch (const Exception& e) {
+        // not fatal since all elements can still be parsed
+        qWarning() << "Could not load library index of" << libDir.toNative() << ":"
+                   << e.getMsg();
+        return QSharedPointer<LibraryIndex>();
+    }
+}
+
+WorkspaceLibraryScanner::DirectoryState WorkspaceLibraryScanner::getDirectoryState(
+    const FilePath& dir) noexcept
+{
+    QFileInfo dirInfo(dir.toStr());
+    DirectoryState state = {dirInfo.lastModified().toMSecsSinceEpoch(), 0, QString()};
+    QDir qdir(dir.toStr());
+    foreach (const QFileInfo& info, qdir.entryInfoList(QDir::Files | QDir::Hidden)) {
+        state.mtime = qMax(state.mtime, info.lastModified().toMSecsSinceEpoch());
+        state.size += info.size();
+    }
+    return state;
+}
+
+bool WorkspaceLibraryScanner::hasDirectoryChanged(const DirectoryState& cached,
+    DirectoryState& current, const FilePath& dir) noexcept
+{
+    if ((cached.mtime == current.mtime) && (cached.size == current.size)) {
+        current.hash = cached.hash;
+        return false;
+    }
+
+    // The modification time or size has changed, but maybe only because the files were
+    // touched (e.g. by a VCS checkout), so compare the content hash before parsing the
+    // whole element again.
+    current.hash = LibraryIndex::calcDirectoryHash(dir);
+    return current.hash != cached.hash;
 }
 
 /*****************************************************************************************
@@ -24,7 +24,10 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <librepcb/common/attributes/attribute.h>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/serializablekeyvaluemap.h>
+#include <librepcb/library/libraryindex.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -33,9 +36,15 @@
 namespace librepcb {
 
 class SQLiteDatabase;
+class Uuid;
 
 namespace library {
 class Library;
+class LibraryBaseElement;
+class LibraryCategory;
+class LibraryElement;
+class Component;
+class Device;
 }
 
 namespace workspace {
@@ -49,6 +58,26 @@ class Workspace;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
+ * The scanner updates the workspace library database incrementally: For every library
+ * and every library element directory, a fingerprint (modification time, size and
+ * content hash of the contained files) is stored in the database. On a rescan, only
+ * directories whose fingerprint has changed are parsed again, new directories are added
+ * and no longer existing directories are removed from the database. So the time
+ * required for a rescan is proportional to the number of changed elements, not to the
+ * total number of elements in the workspace.
+ *
+ * Library elements which need to be parsed are parsed concurrently in a thread pool (see
+ * #ElementParser), while all database accesses are done by the scanner thread itself.
+ * If a library contains an index manifest (see librepcb::library::LibraryIndex), the
+ * elements whose content hash matches their index entry are added to the database from
+ * the index without parsing them at all.
+ *
+ * Besides a full scan (#requestFullScan()), only some libraries or even only some
+ * element directories of a library can be updated (#requestLibraryUpdate()). This is
+ * used to process the changes reported by the librepcb::workspace::WorkspaceLibraryWatcher.
+ * Requests made while a scan is running are processed by the next scan (see
+ * #hasPendingRequests()).
+ *
  * @warning Be very careful with dependencies to other objects as the #run() method is
  *          executed in a separate thread! Keep the number of dependencies as small as
  *          possible and consider thread synchronization and object lifetimes.
@@ -72,6 +101,31 @@ class WorkspaceLibraryScanner final : public QThread
         WorkspaceLibraryScanner(const WorkspaceLibraryScanner& other) = delete;
         ~WorkspaceLibraryScanner() noexcept;
 
+        // General Methods
+
+        /**
+         * @brief Request a scan of all libraries for the next run
+         */
+        void requestFullScan() noexcept;
+
+        /**
+         * @brief Request an update of a single library for the next run
+         *
+         * @param libDir        The directory of the library to update
+         * @param elementDirs   The element directories of the library which need to be
+         *                      updated. If empty, all elements of the library are updated.
+         */
+        void requestLibraryUpdate(const FilePath& libDir,
+                                  const QSet<FilePath>& elementDirs) noexcept;
+
+        /**
+         * @brief Check whether there are requests which are not processed yet
+         *
+         * If this returns true after the thread has finished, it needs to be started
+         * again.
+         */
+        bool hasPendingRequests() const noexcept;
+
         // Operator Overloadings
         WorkspaceLibraryScanner& operator=(const WorkspaceLibraryScanner& rhs) = delete;
 
@@ -84,25 +138,119 @@ class WorkspaceLibraryScanner final : public QThread
         void failed(QString errorMsg);
 
 
+    private: // Types
+
+        /**
+         * @brief Fingerprint of a library (element) directory
+         *
+         * Only the files directly inside the directory are taken into account (not
+         * recursive), i.e. the elements of a library do not affect the fingerprint of
+         * the library itself.
+         */
+        struct DirectoryState {
+            qint64 mtime;   ///< latest modification time (ms since epoch) of the files
+            qint64 size;    ///< total size of all files in bytes
+            QString hash;   ///< content hash (may be empty if not yet calculated)
+        };
+
+        /// The state of a library (element) as recorded in the database
+        struct CachedEntry {
+            int id;
+            DirectoryState state;
+        };
+
+        /// A library element parsed by an #ElementParser worker
+        template <typename ElementType>
+        struct ParsedElement {
+            FilePath filepath;
+            DirectoryState state;
+            QSharedPointer<ElementType> element; ///< nullptr if parsing failed
+            const library::LibraryIndex::Entry* indexEntry; ///< set instead of #element
+        };
+
+        /// Passes parsed elements from the workers to the (single) database writer
+        template <typename ElementType>
+        struct ParsedElementQueue {
+            QMutex mutex;
+            QWaitCondition available;
+            QQueue<ParsedElement<ElementType>> elements;
+        };
+
+        template <typename ElementType>
+        class ElementParser;
+
+
     private: // Methods
 
         void run() noexcept override;
-        void clearAllTables(SQLiteDatabase& db);
-        int addLibraryToDb(SQLiteDatabase& db, const QSharedPointer<library::Library>& lib);
+        bool takePendingRequests(QHash<FilePath, QSet<FilePath>>& libraries) noexcept;
+        void reportProgress(int processedElements) noexcept;
+        int updateLibraryInDb(SQLiteDatabase& db, const FilePath& libDir);
         template <typename ElementType>
-        int addCategoriesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
+        int updateElementsInDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
+                               const QString& table, const QString& idColumn, int libId,
+                               const QSet<FilePath>& scope,
+                               const library::LibraryIndex* index);
+        int addElementToDb(SQLiteDatabase& db, const library::LibraryCategory& element,
+                           const DirectoryState& state, const QString& table,
+                           const QString& idColumn, int libId);
+        int addElementToDb(SQLiteDatabase& db, const library::LibraryElement& element,
+                           const DirectoryState& state, const QString& table,
+                           const QString& idColumn, int libId);
+        int addElementToDb(SQLiteDatabase& db, const library::Component& element,
+                           const DirectoryState& state, const QString& table,
+                           const QString& idColumn, int libId);
+        int addElementToDb(SQLiteDatabase& db, const library::Device& element,
+                           const DirectoryState& state, const QString& table,
+                           const QString& idColumn, int libId);
+        int addIndexEntryToDb(SQLiteDatabase& db, const library::LibraryIndex::Entry& entry,
+                              const FilePath& filepath, const DirectoryState& state,
                               const QString& table, const QString& idColumn, int libId);
-        template <typename ElementType>
-        int addElementsToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                            const QString& table, const QString& idColumn, int libId);
-        int addDevicesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                           const QString& table, const QString& idColumn, int libId);
+        int insertElementRow(SQLiteDatabase& db, const FilePath& filepath, const Uuid& uuid,
+                             const Version& version, const DirectoryState& state,
+                             const QString& table, int libId,
+                             const QHash<QString, QVariant>& extraColumns);
+        void addTranslationsToDb(SQLiteDatabase& db, const library::LibraryBaseElement& element,
+                                 const QString& table, const QString& idColumn, int id);
+        void addTranslationsToDb(SQLiteDatabase& db, const LocalizedNameMap& names,
+                                 const LocalizedDescriptionMap& descriptions,
+                                 const LocalizedKeywordsMap& keywords,
+                                 const QString& table, const QString& idColumn, int id);
+        void addAttributesToDb(SQLiteDatabase& db, const AttributeList& attributes,
+                               const QString& table, const QString& idColumn, int id);
+        void addCategoryAssignmentsToDb(SQLiteDatabase& db, const QSet<Uuid>& categories,
+                                        const QString& table, const QString& idColumn,
+                                        int id);
+        void addSymbolReferencesToDb(SQLiteDatabase& db, const QSet<Uuid>& symbols, int id);
+        QHash<QString, CachedEntry> getCachedEntries(SQLiteDatabase& db, const QString& table,
+                                                     int libId) const;
+        void updateStateInDb(SQLiteDatabase& db, const QString& table, int id,
+                             const DirectoryState& cached, const DirectoryState& state);
+        void removeElementFromDb(SQLiteDatabase& db, const QString& table,
+                                 const QString& idColumn, bool hasCategories, int id);
+        void removeLibraryFromDb(SQLiteDatabase& db, int libId);
+        void removeObsoleteLibrariesFromDb(SQLiteDatabase& db, const QSet<int>& existingIds);
+        static QSharedPointer<library::LibraryIndex> loadLibraryIndex(
+            const FilePath& libDir) noexcept;
+        static DirectoryState getDirectoryState(const FilePath& dir) noexcept;
+        static bool hasDirectoryChanged(const DirectoryState& cached,
+                                        DirectoryState& current, const FilePath& dir) noexcept;
 
 
     private: // Data
 
         Workspace& mWorkspace;
         volatile bool mAbort;
+        QThreadPool mParserPool; ///< worker threads to parse library elements
+        int mTotalCount; ///< total number of library elements to scan
+        int mProcessedCount; ///< number of already processed library elements
+        int mLastReportedPercent;
+        QStringList mLocaleOrder; ///< to precompute the translations of scanned elements
+
+        // Pending Requests
+        mutable QMutex mRequestsMutex;
+        bool mFullScanRequested;
+        QHash<FilePath, QSet<FilePath>> mRequestedLibraries; ///< empty set = whole library
 };
 
 /*****************************************************************************************
@@ -0,0 +1,317 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "workspacelibrarythumbnails.h"
+#include "workspacelibrarydb.h"
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/memoryreport.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/pkg/package.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class ThumbnailPainter
+ ****************************************************************************************/
+
+/**
+ * @brief Collects the primitives of a symbol or footprint and paints them to an image
+ *
+ * Only works with QPainterPath objects and a QPainter on a QImage (no graphics scene or
+ * graphics items), so it can safely be used in a worker thread. Texts are not rendered
+ * since they are not readable in the small thumbnails anyway.
+ */
+class ThumbnailPainter final
+{
+    public:
+        explicit ThumbnailPainter(const QString& grabAreaLayerName) noexcept :
+            mGrabAreaLayerName(grabAreaLayerName) {}
+
+        void addPath(const QPainterPath& path, const QString& layerName,
+                     const Length& lineWidth, bool filled, bool grabArea) noexcept {
+            Primitive primitive;
+            primitive.path = path;
+            if (lineWidth > 0) {
+                primitive.pen = QPen(getColor(layerName), lineWidth.toPx(), Qt::SolidLine,
+                                     Qt::RoundCap, Qt::RoundJoin);
+            } else {
+                primitive.pen = Qt::NoPen;
+            }
+            if (filled) {
+                primitive.brush = QBrush(getColor(layerName), Qt::SolidPattern);
+            } else if (grabArea) {
+                primitive.brush = QBrush(getColor(mGrabAreaLayerName), Qt::SolidPattern);
+            }
+            qreal w = lineWidth.toPx() / 2;
+            mBoundingRect = mBoundingRect.united(path.boundingRect().adjusted(-w, -w, w, w));
+            mPrimitives.append(primitive);
+        }
+
+        void addPolygons(const PolygonList& polygons,
+                         const CompactPolygonList* compactPolygons) noexcept {
+            for (const Polygon& polygon : polygons) {
+                addPath(polygon.toQPainterPathPx(), polygon.getLayerName(),
+                        polygon.getLineWidth(), polygon.isFilled(), polygon.isGrabArea());
+            }
+            if (compactPolygons) {
+                for (int i = 0; i < compactPolygons->count(); ++i) {
+                    addPath(compactPolygons->toQPainterPathPx(i),
+                            compactPolygons->getLayerName(i), compactPolygons->getLineWidth(i),
+                            compactPolygons->isFilled(i), compactPolygons->isGrabArea(i));
+                }
+            }
+        }
+
+        void addEllipses(const EllipseList& ellipses) noexcept {
+            for (const Ellipse& ellipse : ellipses) {
+                QPainterPath path;
+                path.addEllipse(QPointF(0, 0), ellipse.getRadiusX().toPx(),
+                                ellipse.getRadiusY().toPx());
+                QTransform transform;
+                transform.translate(ellipse.getCenter().toPxQPointF().x(),
+                                    ellipse.getCenter().toPxQPointF().y());
+                transform.rotate(-ellipse.getRotation().toDeg());
+                addPath(transform.map(path), ellipse.getLayerName(), ellipse.getLineWidth(),
+                        ellipse.isFilled(), ellipse.isGrabArea());
+            }
+        }
+
+        QImage render(const QColor& background) const noexcept {
+            QImage image(WorkspaceLibraryThumbnails::getThumbnailSize(),
+                         QImage::Format_ARGB32_Premultiplied);
+            image.fill(background);
+            if (mBoundingRect.isEmpty()) {
+                return image; // nothing to draw
+            }
+            QRectF sourceRect = mBoundingRect;
+            qreal margin = qMax(sourceRect.width(), sourceRect.height()) / 20;
+            sourceRect.adjust(-margin, -margin, margin, margin);
+            qreal scale = qMin(image.width() / sourceRect.width(),
+                               image.height() / sourceRect.height());
+
+            QPainter painter(&image);
+            painter.setRenderHints(QPainter::Antialiasing);
+            painter.translate(image.width() / 2.0, image.height() / 2.0);
+            painter.scale(scale, scale);
+            painter.translate(-sourceRect.center());
+            foreach (const Primitive& primitive, mPrimitives) {
+                painter.setPen(primitive.pen);
+                painter.setBrush(primitive.brush);
+                painter.drawPath(primitive.path);
+            }
+            painter.end();
+            return image;
+        }
+
+    private:
+        QColor getColor(const QString& layerName) noexcept {
+            if (!mColors.contains(layerName)) {
+                mColors.insert(layerName, GraphicsLayer(layerName).getColor());
+            }
+            return mColors.value(layerName);
+        }
+
+        struct Primitive {
+            QPainterPath path;
+            QPen pen;
+            QBrush brush; ///< Qt::NoBrush by default
+        };
+
+        QString mGrabAreaLayerName;
+        QVector<Primitive> mPrimitives;
+        QHash<QString, QColor> mColors; ///< key: layer name
+        QRectF mBoundingRect;
+};
+
+/*****************************************************************************************
+ *  Class WorkspaceLibraryThumbnails::Job
+ ****************************************************************************************/
+
+class WorkspaceLibraryThumbnails::Job final : public QRunnable
+{
+    public:
+        Job(WorkspaceLibraryThumbnails& thumbnails, ElementType type, const QString& key,
+            const FilePath& elementDir, const FilePath& cacheFile,
+            const JobScheduler::CancellationToken& token) noexcept :
+            QRunnable(), mThumbnails(thumbnails), mType(type), mKey(key),
+            mElementDir(elementDir), mCacheFile(cacheFile), mToken(token) {}
+
+        void run() override {
+            QImage image;
+            if (mCacheFile.isExistingFile()) {
+                image.load(mCacheFile.toStr(), "PNG");
+            }
+            if (image.isNull() && (!mToken.isCanceled())) {
+                try {
+                    image = render(); // can throw
+                    QDir().mkpath(mCacheFile.getParentDir().toStr());
+                    if (!image.save(mCacheFile.toStr(), "PNG")) {
+                        qWarning() << "Could not save thumbnail:" << mCacheFile.toNative();
+                    }
+                } catch (const Exception& e) {
+                    qWarning() << "Could not render thumbnail of" << mElementDir.toNative()
+                               << ":" << e.getMsg();
+                }
+            }
+            emit mThumbnails.jobFinished(mKey, image);
+        }
+
+    private:
+        QImage render() const {
+            if (mType == ElementType::Symbol) {
+                library::Symbol symbol(mElementDir, true); // can throw
+                ThumbnailPainter painter(GraphicsLayer::sSymbolGrabAreas);
+                painter.addPolygons(symbol.getPolygons(), symbol.getCompactPolygons());
+                painter.addEllipses(symbol.getEllipses());
+                for (const library::SymbolPin& pin : symbol.getPins()) {
+                    QPainterPath path;
+                    path.moveTo(pin.getPosition().toPxQPointF());
+                    path.lineTo((pin.getPosition() + Point(pin.getLength(), 0)
+                                 .rotated(pin.getRotation())).toPxQPointF());
+                    painter.addPath(path, GraphicsLayer::sSymbolOutlines, Length(158750),
+                                    false, false);
+                }
+                return painter.render(Qt::white);
+            } else {
+                library::Package package(mElementDir, true); // can throw
+                if (package.getFootprints().isEmpty()) {
+                    throw RuntimeError(__FILE__, __LINE__, QString("Package has no footprints."));
+                }
+                const library::Footprint& footprint = *package.getFootprints().first();
+                ThumbnailPainter painter(GraphicsLayer::sTopGrabAreas);
+                painter.addPolygons(footprint.getPolygons(), footprint.getCompactPolygons());
+                painter.addEllipses(footprint.getEllipses());
+                for (const library::FootprintPad& pad : footprint.getPads()) {
+                    QTransform transform;
+                    transform.translate(pad.getPosition().toPxQPointF().x(),
+                                        pad.getPosition().toPxQPointF().y());
+                    transform.rotate(-pad.getRotation().toDeg());
+                    painter.addPath(transform.map(pad.toQPainterPathPx()), pad.getLayerName(),
+                                    Length(0), true, false);
+                }
+                return painter.render(Qt::black);
+            }
+        }
+
+        WorkspaceLibraryThumbnails& mThumbnails;
+        ElementType mType;
+        QString mKey;
+        FilePath mElementDir;
+        FilePath mCacheFile;
+        JobScheduler::CancellationToken mToken;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+WorkspaceLibraryThumbnails::WorkspaceLibraryThumbnails(const WorkspaceLibraryDb& db,
+                                                       JobScheduler& scheduler,
+                                                       const FilePath& cacheDir) noexcept :
+    QObject(nullptr), mDb(db), mCacheDir(cacheDir),
+    mJobs(scheduler, JobScheduler::Priority::Visible, 1), mImages(500)
+{
+    connect(this, &WorkspaceLibraryThumbnails::jobFinished,
+            this, &WorkspaceLibraryThumbnails::jobFinishedHandler, Qt::QueuedConnection);
+}
+
+WorkspaceLibraryThumbnails::~WorkspaceLibraryThumbnails() noexcept
+{
+    mJobs.cancel(); // remove all jobs which are not yet started
+    mJobs.waitForDone();
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QImage WorkspaceLibraryThumbnails::getSymbolThumbnail(const Uuid& uuid) noexcept
+{
+    return getThumbnail(ElementType::Symbol, uuid);
+}
+
+QImage WorkspaceLibraryThumbnails::getPackageThumbnail(const Uuid& uuid) noexcept
+{
+    return getThumbnail(ElementType::Package, uuid);
+}
+
+void WorkspaceLibraryThumbnails::addToMemoryReport(MemoryReport& parent) const noexcept
+{
+    qint64 bytes = 0;
+    foreach (const QString& key, mImages.keys()) {
+        bytes += MemoryReport::getStringSize(key) + mImages.object(key)->byteCount();
+    }
+    parent.addChild("Library thumbnails", bytes, mImages.count());
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QImage WorkspaceLibraryThumbnails::getThumbnail(ElementType type, const Uuid& uuid) noexcept
+{
+    try {
+        QMultiMap<Version, FilePath> elements = (type == ElementType::Symbol)
+            ? mDb.getSymbols(uuid) : mDb.getPackages(uuid); // can throw
+        if (elements.isEmpty()) return QImage();
+
+        // the map is sorted by version, so the last entry is the latest version
+        QString key = QString("%1_%2_%3").arg(type == ElementType::Symbol ? "sym" : "pkg")
+                      .arg(uuid.toStr()).arg(elements.lastKey().toStr());
+        if (const QImage* image = mImages.object(key)) {
+            return *image;
+        }
+        if (!mPendingJobs.contains(key)) {
+            mPendingJobs.insert(key, uuid);
+            FilePath cacheFile = mCacheDir.getPathTo(key % ".png");
+            mJobs.start(new Job(*this, type, key, elements.last(), cacheFile,
+                                mJobs.getCancellationToken()));
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Could not get thumbnail of" << uuid.toStr() << ":" << e.getMsg();
+    }
+    return QImage();
+}
+
+void WorkspaceLibraryThumbnails::jobFinishedHandler(const QString& key, const QImage& image) noexcept
+{
+    Uuid uuid = mPendingJobs.take(key);
+    // failed renderings are cached as null images to avoid rendering them again
+    mImages.insert(key, new QImage(image), 1);
+    if (!image.isNull()) {
+        emit thumbnailReady(uuid);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
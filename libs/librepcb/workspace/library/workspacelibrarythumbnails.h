@@ -0,0 +1,153 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_WORKSPACELIBRARYTHUMBNAILS_H
+#define LIBREPCB_WORKSPACE_WORKSPACELIBRARYTHUMBNAILS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/jobscheduler.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class MemoryReport;
+
+namespace workspace {
+
+class WorkspaceLibraryDb;
+
+/*****************************************************************************************
+ *  Class WorkspaceLibraryThumbnails
+ ****************************************************************************************/
+
+/**
+ * @brief The WorkspaceLibraryThumbnails class provides small preview images of symbols
+ *        and packages of the workspace libraries
+ *
+ * Building graphics items for every element shown in a list or tree view is much too
+ * slow, so this class renders the previews to QImage objects in the background (one
+ * job at a time, in the workspace's JobScheduler) instead. The worker only loads the
+ * element and paints its geometry with a QPainter, it never creates a QGraphicsScene or
+ * graphics items since these must only be used in the main thread. The rendered images
+ * are kept in memory and stored as PNG files in the
+ * workspace metadata directory. They are identified by element type, UUID and version
+ * of the element, so they never need to be invalidated explicitly.
+ *
+ * If a requested thumbnail is not available yet, a null image is returned and the
+ * #thumbnailReady() signal is emitted as soon as it has been loaded or rendered.
+ *
+ * @note Use this class only from the main thread (the rendering itself runs in the
+ *       worker thread).
+ */
+class WorkspaceLibraryThumbnails final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        WorkspaceLibraryThumbnails() = delete;
+        WorkspaceLibraryThumbnails(const WorkspaceLibraryThumbnails& other) = delete;
+        WorkspaceLibraryThumbnails(const WorkspaceLibraryDb& db, JobScheduler& scheduler,
+                                   const FilePath& cacheDir) noexcept;
+        ~WorkspaceLibraryThumbnails() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the thumbnail of the latest version of a symbol
+         *
+         * @param uuid  The UUID of the symbol
+         *
+         * @return The thumbnail, or a null image if it is not available (yet)
+         */
+        QImage getSymbolThumbnail(const Uuid& uuid) noexcept;
+
+        /**
+         * @brief Get the thumbnail of the default footprint of the latest version of a
+         *        package
+         *
+         * @param uuid  The UUID of the package
+         *
+         * @return The thumbnail, or a null image if it is not available (yet)
+         */
+        QImage getPackageThumbnail(const Uuid& uuid) noexcept;
+
+        /**
+         * @brief Add the approximate memory usage of the images in memory to a report
+         */
+        void addToMemoryReport(MemoryReport& parent) const noexcept;
+
+        // Operator Overloadings
+        WorkspaceLibraryThumbnails& operator=(const WorkspaceLibraryThumbnails& rhs) = delete;
+
+        // Static Methods
+        static QSize getThumbnailSize() noexcept {return QSize(128, 128);}
+
+
+    signals:
+
+        /**
+         * @brief A requested thumbnail is now available
+         *
+         * @param uuid  The UUID of the symbol or package
+         */
+        void thumbnailReady(const Uuid& uuid);
+
+        /// Emitted from the worker thread when a job is finished (internal use only)
+        void jobFinished(const QString& key, const QImage& image);
+
+
+    private: // Types
+
+        enum class ElementType {Symbol, Package};
+        class Job;
+
+
+    private: // Methods
+
+        QImage getThumbnail(ElementType type, const Uuid& uuid) noexcept;
+        void jobFinishedHandler(const QString& key, const QImage& image) noexcept;
+
+
+    private: // Data
+
+        const WorkspaceLibraryDb& mDb;
+        FilePath mCacheDir;
+        JobScheduler::Group mJobs;
+        QCache<QString, QImage> mImages; ///< key: type, UUID and version of the element
+        QHash<QString, Uuid> mPendingJobs; ///< key: same as #mImages
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WORKSPACE_WORKSPACELIBRARYTHUMBNAILS_H
@@ -0,0 +1,155 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "workspacelibrarywatcher.h"
+#include <librepcb/library/elements.h>
+#include "../workspace.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+using namespace library;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+WorkspaceLibraryWatcher::WorkspaceLibraryWatcher(Workspace& ws) noexcept :
+    QObject(nullptr), mWorkspace(ws), mWatcher(this), mDebounceTimer(this)
+{
+    mDebounceTimer.setSingleShot(true);
+    mDebounceTimer.setInterval(sDebounceDelayMs);
+    connect(&mDebounceTimer, &QTimer::timeout,
+            this, &WorkspaceLibraryWatcher::debounceTimerTimeout);
+    connect(&mWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &WorkspaceLibraryWatcher::directoryChanged);
+}
+
+WorkspaceLibraryWatcher::~WorkspaceLibraryWatcher() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WorkspaceLibraryWatcher::updateWatchedDirectories() noexcept
+{
+    QList<FilePath> libraries;
+    libraries.append(mWorkspace.getLocalLibraryDirectories().values());
+    libraries.append(mWorkspace.getRemoteLibraryDirectories().values());
+
+    QHash<QString, WatchedDirectory> oldDirectories = mWatchedDirectories;
+    mWatchedDirectories.clear();
+    foreach (const FilePath& libDir, libraries) {
+        addLibraryDirectories(libDir);
+    }
+
+    // only add/remove the differences to avoid needless system calls
+    QStringList removedPaths, addedPaths;
+    foreach (const QString& path, oldDirectories.keys()) {
+        if (!mWatchedDirectories.contains(path)) {
+            removedPaths.append(path);
+        }
+    }
+    foreach (const QString& path, mWatchedDirectories.keys()) {
+        if (!oldDirectories.contains(path)) {
+            addedPaths.append(path);
+        }
+    }
+    if (!removedPaths.isEmpty()) {
+        mWatcher.removePaths(removedPaths);
+    }
+    if (!addedPaths.isEmpty()) {
+        QStringList failedPaths = mWatcher.addPaths(addedPaths);
+        if (!failedPaths.isEmpty()) {
+            // e.g. the limit of inotify watches is reached
+            qWarning() << "Library watcher: Could not watch" << failedPaths.count()
+                       << "of" << addedPaths.count() << "directories.";
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void WorkspaceLibraryWatcher::addLibraryDirectories(const FilePath& libDir) noexcept
+{
+    mWatchedDirectories.insert(libDir.toStr(), WatchedDirectory{libDir, false});
+    QList<FilePath> typeDirs = {Library::getElementsDirectory<ComponentCategory>(libDir),
+                                Library::getElementsDirectory<PackageCategory>(libDir),
+                                Library::getElementsDirectory<Symbol>(libDir),
+                                Library::getElementsDirectory<Package>(libDir),
+                                Library::getElementsDirectory<Component>(libDir),
+                                Library::getElementsDirectory<Device>(libDir)};
+    foreach (const FilePath& typeDir, typeDirs) {
+        if (!typeDir.isExistingDir()) continue;
+        mWatchedDirectories.insert(typeDir.toStr(), WatchedDirectory{libDir, false});
+        QDir dir(typeDir.toStr());
+        foreach (const QString& dirname, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            FilePath elementDir = typeDir.getPathTo(dirname);
+            mWatchedDirectories.insert(elementDir.toStr(), WatchedDirectory{libDir, true});
+        }
+    }
+}
+
+void WorkspaceLibraryWatcher::directoryChanged(const QString& path) noexcept
+{
+    auto watched = mWatchedDirectories.constFind(path);
+    if (watched == mWatchedDirectories.constEnd()) {
+        return; // the directory is no longer relevant
+    }
+    auto it = mModifications.find(watched->library);
+    if (watched->isElement) {
+        if (it == mModifications.end()) {
+            mModifications.insert(watched->library, {FilePath(path)});
+        } else if (!it.value().isEmpty()) {
+            it.value().insert(FilePath(path));
+        }
+    } else if (it == mModifications.end()) {
+        mModifications.insert(watched->library, QSet<FilePath>()); // whole library
+    } else {
+        it.value().clear(); // whole library
+    }
+    mDebounceTimer.start(); // restarts the timer if it is already running
+}
+
+void WorkspaceLibraryWatcher::debounceTimerTimeout() noexcept
+{
+    QHash<FilePath, QSet<FilePath>> modifications = mModifications;
+    mModifications.clear();
+    if (!modifications.isEmpty()) {
+        emit librariesModified(modifications);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_WORKSPACELIBRARYWATCHER_H
+#define LIBREPCB_WORKSPACE_WORKSPACELIBRARYWATCHER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+class Workspace;
+
+/*****************************************************************************************
+ *  Class WorkspaceLibraryWatcher
+ ****************************************************************************************/
+
+/**
+ * @brief The WorkspaceLibraryWatcher class reports modifications of the workspace
+ *        libraries in the file system
+ *
+ * All libraries, their element type directories (e.g. "sym") and all their element
+ * directories are watched with a QFileSystemWatcher. Since a single change (e.g. saving
+ * an element in the library editor or a "git pull") usually emits a whole burst of
+ * notifications, they are collected for #sDebounceDelayMs milliseconds before the
+ * #librariesModified() signal is emitted once for all of them.
+ *
+ * If only element directories were modified, only these directories are reported. If
+ * the library itself or an element type directory was modified (e.g. an element was
+ * added or removed), the whole library is reported instead.
+ *
+ * @note The watched directories are not updated automatically, call
+ *       #updateWatchedDirectories() after the libraries were (re)scanned.
+ */
+class WorkspaceLibraryWatcher final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        WorkspaceLibraryWatcher() = delete;
+        WorkspaceLibraryWatcher(const WorkspaceLibraryWatcher& other) = delete;
+        explicit WorkspaceLibraryWatcher(Workspace& ws) noexcept;
+        ~WorkspaceLibraryWatcher() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Watch the directories of all libraries which currently exist
+         */
+        void updateWatchedDirectories() noexcept;
+
+        // Operator Overloadings
+        WorkspaceLibraryWatcher& operator=(const WorkspaceLibraryWatcher& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief Some libraries were modified
+         *
+         * @param libraries     The modified libraries (keys) with their modified element
+         *                      directories (values). An empty set of element directories
+         *                      means that the whole library needs to be updated.
+         */
+        void librariesModified(const QHash<FilePath, QSet<FilePath>>& libraries);
+
+
+    private: // Types
+
+        /// A watched directory
+        struct WatchedDirectory {
+            FilePath library;   ///< the library which contains the directory
+            bool isElement;     ///< whether the directory is a library element
+        };
+
+
+    private: // Methods
+
+        void addLibraryDirectories(const FilePath& libDir) noexcept;
+        void directoryChanged(const QString& path) noexcept;
+        void debounceTimerTimeout() noexcept;
+
+
+    private: // Data
+
+        Workspace& mWorkspace;
+        QFileSystemWatcher mWatcher;
+        QTimer mDebounceTimer;
+        QHash<QString, WatchedDirectory> mWatchedDirectories; ///< key: watched path
+        QHash<FilePath, QSet<FilePath>> mModifications; ///< not yet reported modifications
+
+        // Constants
+        static const int sDebounceDelayMs = 500;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WORKSPACE_WORKSPACELIBRARYWATCHER_H
@@ -0,0 +1,262 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtSql>
+#include "workspaceprojectindexer.h"
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class WorkspaceProjectIndexer::Job
+ ****************************************************************************************/
+
+class WorkspaceProjectIndexer::Job final : public QRunnable
+{
+    public:
+        Job(WorkspaceProjectIndexer& indexer, const FilePath& path, bool crawl,
+            const JobScheduler::CancellationToken& token) noexcept :
+            QRunnable(), mIndexer(indexer), mPath(path), mCrawl(crawl), mToken(token) {}
+
+        void run() override {
+            bool modified = false;
+            try {
+                // the job runs in a worker thread, thus it needs its own connection
+                SQLiteDatabase db(mIndexer.mDbFilePath); // can throw
+                if (mCrawl) {
+                    QList<FilePath> projects = findProjects(mPath, mToken);
+                    foreach (const FilePath& projectFile, projects) {
+                        if (mToken.isCanceled()) break;
+                        modified = updateProject(db, projectFile) || modified; // can throw
+                    }
+                    if (!mToken.isCanceled()) {
+                        modified = removeProjects(db, mPath, projects.toSet())
+                                   || modified; // can throw
+                    }
+                } else {
+                    modified = updateProject(db, mPath); // can throw
+                }
+            } catch (const Exception& e) {
+                qWarning() << "Could not update the project index:" << e.getMsg();
+            }
+            emit mIndexer.jobFinished(modified);
+        }
+
+    private:
+        WorkspaceProjectIndexer& mIndexer;
+        FilePath mPath;     ///< the root directory to crawl or the project file to update
+        bool mCrawl;
+        JobScheduler::CancellationToken mToken;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+WorkspaceProjectIndexer::WorkspaceProjectIndexer(const FilePath& dbFilePath,
+                                                 JobScheduler& scheduler) noexcept :
+    QObject(nullptr), mDbFilePath(dbFilePath),
+    mJobs(scheduler, JobScheduler::Priority::Background, 1)
+{
+    connect(this, &WorkspaceProjectIndexer::jobFinished,
+            this, &WorkspaceProjectIndexer::jobFinishedHandler, Qt::QueuedConnection);
+}
+
+WorkspaceProjectIndexer::~WorkspaceProjectIndexer() noexcept
+{
+    mJobs.cancel(); // the index is updated again by the next crawl
+    mJobs.waitForDone();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WorkspaceProjectIndexer::requestCrawl(const FilePath& rootDir) noexcept
+{
+    if (!rootDir.isValid()) return;
+    mJobs.start(new Job(*this, rootDir, true, mJobs.getCancellationToken()));
+}
+
+void WorkspaceProjectIndexer::requestProjectUpdate(const FilePath& projectFile) noexcept
+{
+    if (!projectFile.isValid()) return;
+    mJobs.start(new Job(*this, projectFile, false, mJobs.getCancellationToken()));
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void WorkspaceProjectIndexer::jobFinishedHandler(bool modified) noexcept
+{
+    if (modified) {
+        emit indexUpdated();
+    }
+}
+
+QList<FilePath> WorkspaceProjectIndexer::findProjects(const FilePath& rootDir,
+    const JobScheduler::CancellationToken& token) noexcept
+{
+    QList<FilePath> projects;
+    QList<FilePath> dirs{rootDir};
+    while ((!dirs.isEmpty()) && (!token.isCanceled())) {
+        QDir dir(dirs.takeFirst().toStr());
+        QStringList projectFiles = dir.entryList(QStringList("*.lpp"), QDir::Files);
+        if (projectFiles.count() == 1) {
+            // projects are never nested, so there is no need to search within a project
+            projects.append(FilePath(dir.absoluteFilePath(projectFiles.first())));
+            continue;
+        }
+        foreach (const QString& subdir, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            dirs.append(FilePath(dir.absoluteFilePath(subdir)));
+        }
+    }
+    return projects;
+}
+
+bool WorkspaceProjectIndexer::updateProject(SQLiteDatabase& db, const FilePath& projectFile)
+{
+    QSqlQuery query = db.prepareQuery(
+        "SELECT id, mtime FROM projects WHERE filepath = :filepath");
+    query.bindValue(":filepath", projectFile.toStr());
+    db.exec(query); // can throw
+    int id = query.next() ? query.value(0).toInt() : -1;
+    qint64 cachedMtime = (id >= 0) ? query.value(1).toLongLong() : -1;
+
+    if (!projectFile.isExistingFile()) {
+        if (id < 0) return false;
+        removeProjectsFromDb(db, {id}); // can throw
+        return true;
+    }
+
+    FilePath projectDir = projectFile.getParentDir();
+    qint64 mtime = getLibraryModificationTime(projectDir);
+    if ((id >= 0) && (mtime == cachedMtime)) {
+        return false; // the used library elements were not modified
+    }
+
+    SQLiteDatabase::TransactionScopeGuard transactionGuard(db); // can throw
+    if (id >= 0) {
+        QSqlQuery& deleteQuery = db.getCachedQuery(
+            "DELETE FROM projects_elements WHERE project_id = :id");
+        deleteQuery.bindValue(":id", id);
+        db.exec(deleteQuery); // can throw
+        QSqlQuery& updateQuery = db.getCachedQuery(
+            "UPDATE projects SET mtime = :mtime WHERE id = :id");
+        updateQuery.bindValue(":mtime", mtime);
+        updateQuery.bindValue(":id", id);
+        db.exec(updateQuery); // can throw
+    } else {
+        QSqlQuery& insertQuery = db.getCachedQuery(
+            "INSERT INTO projects (filepath, mtime) VALUES (:filepath, :mtime)");
+        insertQuery.bindValue(":filepath", projectFile.toStr());
+        insertQuery.bindValue(":mtime", mtime);
+        id = db.insert(insertQuery); // can throw
+    }
+
+    // the library elements of a project are stored in directories named by their UUID
+    QVariantList ids, types, uuids;
+    foreach (const QString& type, QStringList{"sym", "pkg", "cmp", "dev"}) {
+        QDir dir(projectDir.getPathTo("library/" % type).toStr());
+        foreach (const QString& name, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            Uuid uuid(name);
+            if (uuid.isNull()) continue;
+            ids.append(id);
+            types.append(type);
+            uuids.append(uuid.toStr());
+        }
+    }
+    if (!ids.isEmpty()) {
+        QSqlQuery& elementsQuery = db.getCachedQuery(
+            "INSERT INTO projects_elements (project_id, type, uuid) VALUES "
+            "(:project_id, :type, :uuid)");
+        elementsQuery.bindValue(":project_id", ids);
+        elementsQuery.bindValue(":type", types);
+        elementsQuery.bindValue(":uuid", uuids);
+        db.execBatch(elementsQuery); // can throw
+    }
+    transactionGuard.commit(); // can throw
+    return true;
+}
+
+bool WorkspaceProjectIndexer::removeProjects(SQLiteDatabase& db, const FilePath& rootDir,
+                                             const QSet<FilePath>& existingProjects)
+{
+    QSqlQuery query = db.prepareQuery("SELECT id, filepath FROM projects");
+    db.exec(query); // can throw
+    QList<int> obsoleteIds;
+    while (query.next()) {
+        FilePath filepath(query.value(1).toString());
+        if (filepath.isLocatedInDir(rootDir) && (!existingProjects.contains(filepath))) {
+            obsoleteIds.append(query.value(0).toInt());
+        }
+    }
+    if (obsoleteIds.isEmpty()) return false;
+    removeProjectsFromDb(db, obsoleteIds); // can throw
+    return true;
+}
+
+void WorkspaceProjectIndexer::removeProjectsFromDb(SQLiteDatabase& db, const QList<int>& ids)
+{
+    SQLiteDatabase::TransactionScopeGuard transactionGuard(db); // can throw
+    foreach (int id, ids) {
+        // remove referencing rows first because of the foreign key constraints
+        QSqlQuery& elementsQuery = db.getCachedQuery(
+            "DELETE FROM projects_elements WHERE project_id = :id");
+        elementsQuery.bindValue(":id", id);
+        db.exec(elementsQuery); // can throw
+        QSqlQuery& projectQuery = db.getCachedQuery("DELETE FROM projects WHERE id = :id");
+        projectQuery.bindValue(":id", id);
+        db.exec(projectQuery); // can throw
+    }
+    transactionGuard.commit(); // can throw
+}
+
+qint64 WorkspaceProjectIndexer::getLibraryModificationTime(const FilePath& projectDir) noexcept
+{
+    // adding or removing an element modifies the directory containing it
+    qint64 mtime = 0;
+    foreach (const QString& path, QStringList{"library", "library/sym", "library/pkg",
+                                              "library/cmp", "library/dev"}) {
+        QFileInfo info(projectDir.getPathTo(path).toStr());
+        if (info.isDir()) {
+            mtime = qMax(mtime, info.lastModified().toMSecsSinceEpoch());
+        }
+    }
+    return mtime;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
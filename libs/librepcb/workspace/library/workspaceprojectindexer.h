@@ -0,0 +1,138 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_WORKSPACEPROJECTINDEXER_H
+#define LIBREPCB_WORKSPACE_WORKSPACEPROJECTINDEXER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/jobscheduler.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class SQLiteDatabase;
+
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class WorkspaceProjectIndexer
+ ****************************************************************************************/
+
+/**
+ * @brief The WorkspaceProjectIndexer class records which library elements are used by
+ *        which projects in the workspace library database
+ *
+ * Every project contains copies of all its library elements in the subdirectories of
+ * its "library" directory, named by their UUID. So the used elements are determined by
+ * only listing these directories, without parsing any file. The results are written to
+ * the tables "projects" and "projects_elements", which are queried by
+ * librepcb::workspace::WorkspaceLibraryDb::getProjectsUsingElements().
+ *
+ * A crawl searches a whole directory tree (e.g. the projects directory of the
+ * workspace) for projects and removes the projects which no longer exist below it from
+ * the index. Projects whose library directories were not modified since the last crawl
+ * are skipped, so a crawl is cheap. Single projects can be updated as well (e.g. after
+ * they have been saved). All requests are processed one after another in the
+ * background.
+ *
+ * @note Use this class only from the main thread.
+ */
+class WorkspaceProjectIndexer final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        WorkspaceProjectIndexer() = delete;
+        WorkspaceProjectIndexer(const WorkspaceProjectIndexer& other) = delete;
+        WorkspaceProjectIndexer(const FilePath& dbFilePath, JobScheduler& scheduler) noexcept;
+        ~WorkspaceProjectIndexer() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Search a directory tree for projects and update their index entries
+         *
+         * @param rootDir   The directory to search
+         */
+        void requestCrawl(const FilePath& rootDir) noexcept;
+
+        /**
+         * @brief Update the index entries of a single project
+         *
+         * @param projectFile   The *.lpp file of the project (removed from the index if
+         *                      it does not exist)
+         */
+        void requestProjectUpdate(const FilePath& projectFile) noexcept;
+
+        /**
+         * @brief Wait until all requests are processed
+         */
+        void waitForDone() noexcept {mJobs.waitForDone();}
+
+        // Operator Overloadings
+        WorkspaceProjectIndexer& operator=(const WorkspaceProjectIndexer& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief The index has been modified by a request
+         */
+        void indexUpdated();
+
+        /// Emitted from the worker thread when a job is finished (internal use only)
+        void jobFinished(bool modified);
+
+
+    private: // Types
+        class Job;
+
+
+    private: // Methods
+        void jobFinishedHandler(bool modified) noexcept;
+        static QList<FilePath> findProjects(const FilePath& rootDir,
+                                            const JobScheduler::CancellationToken& token) noexcept;
+        static bool updateProject(SQLiteDatabase& db, const FilePath& projectFile);
+        static bool removeProjects(SQLiteDatabase& db, const FilePath& rootDir,
+                                   const QSet<FilePath>& existingProjects);
+        static void removeProjectsFromDb(SQLiteDatabase& db, const QList<int>& ids);
+        static qint64 getLibraryModificationTime(const FilePath& projectDir) noexcept;
+
+
+    private: // Data
+        FilePath mDbFilePath;
+        JobScheduler::Group mJobs;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WORKSPACE_WORKSPACEPROJECTINDEXER_H
@@ -0,0 +1,213 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "projectmetadatacache.h"
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/domelement.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class ProjectMetadataCache::Job
+ ****************************************************************************************/
+
+class ProjectMetadataCache::Job final : public QRunnable
+{
+    public:
+        Job(ProjectMetadataCache& cache, const FilePath& projectFile,
+            const Metadata& cached) noexcept :
+            QRunnable(), mCache(cache), mProjectFile(projectFile), mCached(cached) {}
+
+        void run() override {
+            QFileInfo info(mProjectFile.toStr());
+            Metadata metadata = mCached;
+            metadata.exists = info.isFile();
+            if (metadata.exists) {
+                // the cache file stores the time without milliseconds
+                QDateTime lastModified = info.lastModified();
+                if ((!mCached.lastModified.isValid()) || mCached.name.isEmpty() ||
+                    (lastModified.toTime_t() != mCached.lastModified.toTime_t())) {
+                    metadata.lastModified = lastModified;
+                    readMetadata(metadata);
+                }
+            }
+            emit mCache.jobFinished(mProjectFile.toStr(), metadata.name, metadata.version,
+                                    metadata.lastModified, metadata.exists);
+        }
+
+    private:
+        /// Read only the first elements of the project file instead of parsing it
+        void readMetadata(Metadata& metadata) const noexcept {
+            QFile file(mProjectFile.toStr());
+            if (!file.open(QIODevice::ReadOnly)) {
+                return;
+            }
+            QXmlStreamReader reader(&file);
+            bool nameFound = false, versionFound = false;
+            if (reader.readNextStartElement()) { // the root element
+                while ((!(nameFound && versionFound)) && reader.readNextStartElement()) {
+                    if (reader.name() == "name") {
+                        metadata.name = reader.readElementText();
+                        nameFound = true;
+                    } else if (reader.name() == "version") {
+                        metadata.version = reader.readElementText();
+                        versionFound = true;
+                    } else {
+                        reader.skipCurrentElement();
+                    }
+                }
+            }
+            if (reader.hasError()) {
+                qWarning() << "Could not read the metadata of" << mProjectFile.toNative()
+                           << ":" << reader.errorString();
+            }
+        }
+
+        ProjectMetadataCache& mCache;
+        FilePath mProjectFile;
+        Metadata mCached;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ProjectMetadataCache::ProjectMetadataCache(JobScheduler& scheduler,
+                                           const FilePath& cacheFile) noexcept :
+    QObject(nullptr), mCacheFile(cacheFile),
+    mJobs(scheduler, JobScheduler::Priority::Visible, 1), mModified(false)
+{
+    connect(this, &ProjectMetadataCache::jobFinished,
+            this, &ProjectMetadataCache::jobFinishedHandler, Qt::QueuedConnection);
+    load();
+}
+
+ProjectMetadataCache::~ProjectMetadataCache() noexcept
+{
+    mJobs.clear(); // remove all jobs which are not yet started
+    mJobs.waitForDone();
+    if (mModified) {
+        save();
+    }
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+ProjectMetadataCache::Metadata ProjectMetadataCache::getMetadata(const FilePath& projectFile) noexcept
+{
+    if (!mRefreshedProjects.contains(projectFile)) {
+        refresh(projectFile);
+    }
+    return mMetadata.value(projectFile, Metadata{QString(), QString(), QDateTime(), true});
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void ProjectMetadataCache::refresh(const FilePath& projectFile) noexcept
+{
+    if (!projectFile.isValid()) return;
+    mRefreshedProjects.insert(projectFile);
+    Metadata cached = mMetadata.value(projectFile, Metadata{QString(), QString(), QDateTime(), true});
+    mJobs.start(new Job(*this, projectFile, cached));
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void ProjectMetadataCache::jobFinishedHandler(const QString& projectFile, const QString& name,
+                                              const QString& version,
+                                              const QDateTime& lastModified,
+                                              bool exists) noexcept
+{
+    FilePath filepath(projectFile);
+    Metadata metadata{name, version, lastModified, exists};
+    auto it = mMetadata.find(filepath);
+    if ((it == mMetadata.end()) || (it.value() != metadata)) {
+        mMetadata.insert(filepath, metadata);
+        mModified = true;
+        emit metadataChanged(filepath);
+    }
+}
+
+void ProjectMetadataCache::load() noexcept
+{
+    if (!mCacheFile.isExistingFile()) return;
+    try {
+        DomDocument doc(FileUtils::readFile(mCacheFile), mCacheFile); // can throw
+        foreach (const DomElement* node, doc.getRoot().getChilds("project")) {
+            FilePath filepath(node->getAttribute<QString>("path", true)); // can throw
+            Metadata metadata;
+            metadata.name = node->getAttribute<QString>("name", false);
+            metadata.version = node->getAttribute<QString>("version", false);
+            metadata.lastModified = node->getAttribute<QDateTime>("last_modified", false);
+            metadata.exists = node->getAttribute<bool>("exists", true); // can throw
+            if (filepath.isValid()) {
+                mMetadata.insert(filepath, metadata);
+            }
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Could not load the project metadata cache:" << e.getMsg();
+    }
+}
+
+void ProjectMetadataCache::save() noexcept
+{
+    try {
+        QScopedPointer<DomElement> root(new DomElement("project_metadata_cache"));
+        QList<FilePath> projects = mMetadata.keys();
+        std::sort(projects.begin(), projects.end(),
+                  [](const FilePath& a, const FilePath& b) {return a.toStr() < b.toStr();});
+        foreach (const FilePath& filepath, projects) {
+            const Metadata& metadata = mMetadata[filepath];
+            DomElement* node = root->appendChild("project");
+            node->setAttribute("path", filepath.toStr());
+            node->setAttribute("name", metadata.name);
+            node->setAttribute("version", metadata.version);
+            node->setAttribute("last_modified", metadata.lastModified);
+            node->setAttribute("exists", metadata.exists);
+        }
+        DomDocument doc(*root.take());
+        FileUtils::writeFile(mCacheFile, doc.toByteArray()); // can throw
+        mModified = false;
+    } catch (const Exception& e) {
+        qWarning() << "Could not save the project metadata cache:" << e.getMsg();
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
@@ -0,0 +1,155 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_PROJECTMETADATACACHE_H
+#define LIBREPCB_WORKSPACE_PROJECTMETADATACACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/jobscheduler.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class ProjectMetadataCache
+ ****************************************************************************************/
+
+/**
+ * @brief The ProjectMetadataCache class caches some metadata of projects (name, version,
+ *        last modification) to show them in lists without accessing the file system
+ *
+ * The cache is loaded from and stored to a file in the workspace metadata directory,
+ * so the recent and favorite projects lists can show the metadata immediately at
+ * startup, even if the projects are located on a slow network share. Each project is
+ * refreshed once per session in the background (in the workspace's JobScheduler), as
+ * soon as its metadata is requested the first time. If the metadata has changed, #metadataChanged() is emitted.
+ *
+ * @note Use this class only from the main thread (the refreshing itself runs in the
+ *       worker thread).
+ *
+ * @todo Also cache a thumbnail of the first board. This requires to load the whole
+ *       project including its library elements, which should not be done here.
+ */
+class ProjectMetadataCache final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+
+        /// The cached metadata of a project
+        struct Metadata {
+            QString name;           ///< empty if unknown
+            QString version;        ///< empty if unknown
+            QDateTime lastModified; ///< of the *.lpp file (invalid if unknown)
+            bool exists;            ///< false if the project was not found
+
+            bool operator==(const Metadata& rhs) const noexcept {
+                return (name == rhs.name) && (version == rhs.version) &&
+                       (lastModified == rhs.lastModified) && (exists == rhs.exists);
+            }
+            bool operator!=(const Metadata& rhs) const noexcept {return !(*this == rhs);}
+        };
+
+
+        // Constructors / Destructor
+        ProjectMetadataCache() = delete;
+        ProjectMetadataCache(const ProjectMetadataCache& other) = delete;
+        ProjectMetadataCache(JobScheduler& scheduler, const FilePath& cacheFile) noexcept;
+        ~ProjectMetadataCache() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the cached metadata of a project
+         *
+         * If the project was not refreshed yet in this session, a refresh is started in
+         * the background.
+         *
+         * @param projectFile   The *.lpp file of the project
+         *
+         * @return The cached (maybe outdated) metadata. If the project is not cached
+         *         yet, the name is empty and the project is assumed to exist.
+         */
+        Metadata getMetadata(const FilePath& projectFile) noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Refresh the metadata of a project in the background, even if it was
+         *        already refreshed in this session (e.g. after it has been saved)
+         *
+         * @param projectFile   The *.lpp file of the project
+         */
+        void refresh(const FilePath& projectFile) noexcept;
+
+        // Operator Overloadings
+        ProjectMetadataCache& operator=(const ProjectMetadataCache& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief The metadata of a project has changed after refreshing it
+         *
+         * @param projectFile   The *.lpp file of the project
+         */
+        void metadataChanged(const FilePath& projectFile);
+
+        /// Emitted from the worker thread when a job is finished (internal use only)
+        void jobFinished(const QString& projectFile, const QString& name,
+                         const QString& version, const QDateTime& lastModified, bool exists);
+
+
+    private: // Types
+        class Job;
+
+
+    private: // Methods
+        void jobFinishedHandler(const QString& projectFile, const QString& name,
+                                const QString& version, const QDateTime& lastModified,
+                                bool exists) noexcept;
+        void load() noexcept;
+        void save() noexcept;
+
+
+    private: // Data
+        FilePath mCacheFile;
+        JobScheduler::Group mJobs;
+        QHash<FilePath, Metadata> mMetadata;
+        QSet<FilePath> mRefreshedProjects;  ///< refreshed (or pending) in this session
+        bool mModified;                     ///< whether #mMetadata needs to be saved
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WORKSPACE_PROJECTMETADATACACHE_H
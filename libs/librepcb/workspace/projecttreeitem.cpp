@@ -35,47 +35,11 @@ namespace workspace {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-ProjectTreeItem::ProjectTreeItem(ProjectTreeItem* parent, const FilePath& filepath) :
-    mFilePath(filepath), mParent(parent), mDepth(parent ? parent->getDepth() + 1 : 0)
+ProjectTreeItem::ProjectTreeItem(ProjectTreeItem* parent, const FilePath& filepath,
+                                 ItemType_t type) :
+    mFilePath(filepath), mParent(parent), mType(type), mFetchState(NotFetched),
+    mDepth(parent ? parent->getDepth() + 1 : 0)
 {
-    QMimeDatabase db;
-    mMimeType = db.mimeTypeForFile(mFilePath.toStr());
-
-    if (mFilePath.isExistingDir())
-    {
-        // it's a directory
-        QDir dir(mFilePath.toStr());
-
-        QStringList projectFiles = dir.entryList(QStringList("*.lpp"), QDir::Files);
-        if (projectFiles.count() == 1)
-        {
-            // it's a project folder
-            mType = ProjectFolder;
-        }
-        else
-        {
-            // it's a normal folder
-            mType = Folder;
-        }
-
-        // scan folder and add child items
-        if (mDepth < 15) // limit the maximum depth in the project directory to avoid endless recursion
-        {
-            QFileInfoList items = dir.entryInfoList(QDir::Files | QDir::Dirs |
-                                                    QDir::NoDotAndDotDot,
-                                                    QDir::DirsFirst | QDir::Name);
-            foreach (QFileInfo item, items)
-                mChilds.append(new ProjectTreeItem(this, FilePath(item.absoluteFilePath())));
-        }
-    }
-    else if (mFilePath.isExistingFile())
-    {
-        // it's a file
-        if (mFilePath.getSuffix() == "lpp")
-            mType = ProjectFile;
-        else
-            mType = File;
-    }    
 }
 
 ProjectTreeItem::~ProjectTreeItem()
@@ -87,6 +51,12 @@ ProjectTreeItem::~ProjectTreeItem()
  *  Getters
  ****************************************************************************************/
 
+bool ProjectTreeItem::canFetchMore() const
+{
+    // limit the maximum depth in the project directory to avoid endless recursion
+    return isDirectory() && (mFetchState == NotFetched) && (mDepth < 15);
+}
+
 int ProjectTreeItem::getChildNumber() const
 {
     if (mParent)
@@ -104,6 +74,15 @@ QVariant ProjectTreeItem::data(int role) const
 
         case Qt::DecorationRole:
         {
+            if (!mMimeType.isValid()) {
+                // only look at the extension to avoid reading the file
+                QMimeDatabase db;
+                if (isDirectory()) {
+                    mMimeType = db.mimeTypeForName("inode/directory");
+                } else {
+                    mMimeType = db.mimeTypeForFile(mFilePath.toStr(), QMimeDatabase::MatchExtension);
+                }
+            }
             switch (mType)
             {
                 case File:
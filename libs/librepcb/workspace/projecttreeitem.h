@@ -39,6 +39,11 @@ namespace workspace {
 /**
  * @brief The ProjectTreeItem class
  *
+ * The childs of a directory item are not loaded by the item itself, they are fetched
+ * asynchronously by the librepcb::workspace::ProjectTreeModel when the item gets
+ * expanded (see #canFetchMore()). The MIME type (only used for the icon) is determined
+ * on demand from the file extension.
+ *
  * @author ubruhin
  *
  * @date 2014-06-24
@@ -55,12 +60,21 @@ class ProjectTreeItem
             ProjectFolder,
         };
 
+        enum FetchState_t {
+            NotFetched,
+            Fetching,
+            Fetched,
+        };
+
         // Constructors / Destructor
-        ProjectTreeItem(ProjectTreeItem* parent, const FilePath& filepath);
+        ProjectTreeItem(ProjectTreeItem* parent, const FilePath& filepath, ItemType_t type);
         ~ProjectTreeItem();
 
         // Getters
         ItemType_t getType()                    const {return mType;}
+        bool isDirectory()                      const {return (mType == Folder) || (mType == ProjectFolder);}
+        FetchState_t getFetchState()            const {return mFetchState;}
+        bool canFetchMore()                     const;
         const FilePath& getFilePath()           const {return mFilePath;}
         unsigned int getDepth()                 const {return mDepth;}
         int getColumnCount()                    const {return 1;}
@@ -70,6 +84,14 @@ class ProjectTreeItem
         int getChildNumber()                    const;
         QVariant data(int role) const;
 
+        // Setters
+        void setType(ItemType_t type)               {mType = type;}
+        void setFetchState(FetchState_t state)      {mFetchState = state;}
+
+        // General Methods
+        void insertChild(int index, ProjectTreeItem* child) {mChilds.insert(index, child);}
+        ProjectTreeItem* takeChild(int index)       {return mChilds.takeAt(index);}
+
     private:
 
         // make some methods inaccessible...
@@ -80,7 +102,8 @@ class ProjectTreeItem
         FilePath mFilePath;
         ProjectTreeItem* mParent;
         ItemType_t mType;
-        QMimeType mMimeType;
+        FetchState_t mFetchState;
+        mutable QMimeType mMimeType; ///< invalid until the icon is requested the first time
         unsigned int mDepth; ///< this is to avoid endless recursion in the parent-child relationship
         QList<ProjectTreeItem*> mChilds;
 };
@@ -37,13 +37,20 @@ namespace workspace {
  ****************************************************************************************/
 
 ProjectTreeModel::ProjectTreeModel(const Workspace& workspace) :
-    QAbstractItemModel(0)
+    QAbstractItemModel(0), mWatcher(this)
 {
-    mRootProjectDirectory = new ProjectTreeItem(0, workspace.getProjectsPath());
+    mRootProjectDirectory = new ProjectTreeItem(0, workspace.getProjectsPath(),
+                                                ProjectTreeItem::Folder);
+    connect(&mScanner, &ProjectTreeScanner::directoryScanned,
+            this, &ProjectTreeModel::directoryScanned, Qt::QueuedConnection);
+    connect(&mWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &ProjectTreeModel::directoryChanged);
+    fetchItem(mRootProjectDirectory);
 }
 
 ProjectTreeModel::~ProjectTreeModel()
 {
+    mScanner.disconnect(this);
     delete mRootProjectDirectory;       mRootProjectDirectory = 0;
 }
 
@@ -110,6 +117,27 @@ QVariant ProjectTreeModel::data(const QModelIndex& index, int role) const
     return item->data(role);
 }
 
+bool ProjectTreeModel::hasChildren(const QModelIndex& parent) const
+{
+    ProjectTreeItem* item = getItem(parent);
+    if (item->getFetchState() == ProjectTreeItem::Fetched)
+        return item->getChildCount() > 0;
+    else
+        return item->canFetchMore() || (item->getFetchState() == ProjectTreeItem::Fetching);
+}
+
+bool ProjectTreeModel::canFetchMore(const QModelIndex& parent) const
+{
+    return getItem(parent)->canFetchMore();
+}
+
+void ProjectTreeModel::fetchMore(const QModelIndex& parent)
+{
+    ProjectTreeItem* item = getItem(parent);
+    if (item->canFetchMore())
+        fetchItem(item);
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -125,6 +153,117 @@ ProjectTreeItem* ProjectTreeModel::getItem(const QModelIndex& index) const
     return mRootProjectDirectory;
 }
 
+QModelIndex ProjectTreeModel::getIndex(ProjectTreeItem* item) const
+{
+    if (item == mRootProjectDirectory)
+        return QModelIndex();
+    else
+        return createIndex(item->getChildNumber(), 0, item);
+}
+
+void ProjectTreeModel::fetchItem(ProjectTreeItem* item)
+{
+    item->setFetchState(ProjectTreeItem::Fetching);
+    mDirectories.insert(item->getFilePath(), item);
+    mScanner.requestScan(item->getFilePath());
+}
+
+void ProjectTreeModel::directoryScanned()
+{
+    foreach (const ProjectTreeScanner::Result& result, mScanner.takeResults())
+    {
+        ProjectTreeItem* item = mDirectories.value(result.directory);
+        if (!item)
+            continue; // the item was removed in the meantime
+
+        // a folder becomes a project folder (or vice versa) if a *.lpp file is added
+        if ((item != mRootProjectDirectory) && (item->getType() != result.type))
+        {
+            item->setType(result.type);
+            QModelIndex index = getIndex(item);
+            emit dataChanged(index, index);
+        }
+
+        updateChilds(item, result);
+
+        if (item->getFetchState() != ProjectTreeItem::Fetched)
+        {
+            item->setFetchState(ProjectTreeItem::Fetched);
+            if (!mWatcher.addPath(item->getFilePath().toStr()))
+                qWarning() << "Could not watch the project directory" << item->getFilePath();
+        }
+    }
+}
+
+void ProjectTreeModel::directoryChanged(const QString& path)
+{
+    ProjectTreeItem* item = mDirectories.value(FilePath(path));
+    if (item && (item->getFetchState() == ProjectTreeItem::Fetched))
+        mScanner.requestScan(item->getFilePath()); // the childs are updated incrementally
+}
+
+void ProjectTreeModel::updateChilds(ProjectTreeItem* item,
+                                    const ProjectTreeScanner::Result& result)
+{
+    QModelIndex parentIndex = getIndex(item);
+    QHash<FilePath, bool> newEntries; // value: is directory
+    foreach (const ProjectTreeScanner::Entry& entry, result.entries)
+    {
+        newEntries.insert(entry.filepath, (entry.type == ProjectTreeItem::Folder) ||
+                                          (entry.type == ProjectTreeItem::ProjectFolder));
+    }
+
+    // remove childs which no longer exist (or changed from a file to a directory)
+    for (int i = item->getChildCount() - 1; i >= 0; --i)
+    {
+        ProjectTreeItem* child = item->getChild(i);
+        auto it = newEntries.constFind(child->getFilePath());
+        if ((it == newEntries.constEnd()) || (it.value() != child->isDirectory()))
+        {
+            beginRemoveRows(parentIndex, i, i);
+            item->takeChild(i);
+            forgetItem(child);
+            delete child;
+            endRemoveRows();
+        }
+    }
+
+    // the remaining childs have the same order as the entries, so only the missing
+    // entries need to be inserted
+    for (int i = 0; i < result.entries.count(); ++i)
+    {
+        const ProjectTreeScanner::Entry& entry = result.entries.at(i);
+        ProjectTreeItem* child = item->getChild(i);
+        if (child && (child->getFilePath() == entry.filepath))
+        {
+            if ((child->getType() != entry.type) &&
+                (child->getFetchState() == ProjectTreeItem::NotFetched))
+            {
+                child->setType(entry.type); // fetched childs update their type themselves
+                QModelIndex index = getIndex(child);
+                emit dataChanged(index, index);
+            }
+            continue;
+        }
+        beginInsertRows(parentIndex, i, i);
+        item->insertChild(i, new ProjectTreeItem(item, entry.filepath, entry.type));
+        endInsertRows();
+    }
+}
+
+void ProjectTreeModel::forgetItem(ProjectTreeItem* item)
+{
+    for (int i = 0; i < item->getChildCount(); ++i)
+        forgetItem(item->getChild(i));
+
+    if (mDirectories.value(item->getFilePath()) == item)
+    {
+        mDirectories.remove(item->getFilePath());
+        if (item->getFetchState() == ProjectTreeItem::Fetched)
+            mWatcher.removePath(item->getFilePath().toStr());
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
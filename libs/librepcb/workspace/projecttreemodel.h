@@ -25,6 +25,8 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <librepcb/common/fileio/filepath.h>
+#include "projecttreescanner.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -42,6 +44,12 @@ class ProjectTreeItem;
 /**
  * @brief The ProjectTreeModel class
  *
+ * The content of directories is loaded lazily when they get expanded (see
+ * #canFetchMore() and #fetchMore()) and listed asynchronously by a
+ * librepcb::workspace::ProjectTreeScanner, so the model can be created without touching
+ * the (maybe very large) projects directory. All loaded directories are watched for
+ * modifications, and the childs of modified directories are updated incrementally.
+ *
  * @author ubruhin
  *
  * @date 2014-06-24
@@ -66,6 +74,9 @@ class ProjectTreeModel : public QAbstractItemModel
         virtual QModelIndex parent(const QModelIndex& index) const;
         virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
         virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+        virtual bool hasChildren(const QModelIndex& parent = QModelIndex()) const;
+        virtual bool canFetchMore(const QModelIndex& parent) const;
+        virtual void fetchMore(const QModelIndex& parent);
 
     private:
 
@@ -75,9 +86,18 @@ class ProjectTreeModel : public QAbstractItemModel
 
         // Private Methods
         ProjectTreeItem* getItem(const QModelIndex& index) const;
+        QModelIndex getIndex(ProjectTreeItem* item) const;
+        void fetchItem(ProjectTreeItem* item);
+        void directoryScanned();
+        void directoryChanged(const QString& path);
+        void updateChilds(ProjectTreeItem* item, const ProjectTreeScanner::Result& result);
+        void forgetItem(ProjectTreeItem* item);
 
         // Attributes
         ProjectTreeItem* mRootProjectDirectory;
+        QHash<FilePath, ProjectTreeItem*> mDirectories; ///< all fetched/fetching directories
+        QFileSystemWatcher mWatcher;    ///< watches all fetched directories
+        ProjectTreeScanner mScanner;
 };
 
 /*****************************************************************************************
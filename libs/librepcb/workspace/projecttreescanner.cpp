@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "projecttreescanner.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ProjectTreeScanner::ProjectTreeScanner() noexcept :
+    QThread(nullptr), mAbort(false), mWorkerActive(false)
+{
+}
+
+ProjectTreeScanner::~ProjectTreeScanner() noexcept
+{
+    mAbort = true;
+    if (!wait(2000)) {
+        qWarning() << "Could not abort the project tree scanner thread!";
+        terminate();
+        if (!wait(2000)) {
+            qCritical() << "Could not terminate the project tree scanner thread!";
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void ProjectTreeScanner::requestScan(const FilePath& dir) noexcept
+{
+    bool startWorker = false;
+    {
+        QMutexLocker locker(&mRequestsMutex);
+        if (!mRequests.contains(dir)) {
+            mRequests.append(dir);
+        }
+        if (!mWorkerActive) {
+            mWorkerActive = true;
+            startWorker = true;
+        }
+    }
+    if (startWorker) {
+        wait(); // the previous run() may not have returned yet
+        start(QThread::LowPriority);
+    }
+}
+
+QList<ProjectTreeScanner::Result> ProjectTreeScanner::takeResults() noexcept
+{
+    QMutexLocker locker(&mResultsMutex);
+    QList<Result> results = mResults;
+    mResults.clear();
+    return results;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void ProjectTreeScanner::run() noexcept
+{
+    while (!mAbort) {
+        FilePath dir;
+        {
+            QMutexLocker locker(&mRequestsMutex);
+            if (mRequests.isEmpty()) {
+                mWorkerActive = false;
+                return;
+            }
+            dir = mRequests.takeFirst();
+        }
+        Result result = scanDirectory(dir);
+        {
+            QMutexLocker locker(&mResultsMutex);
+            mResults.append(result);
+        }
+        emit directoryScanned();
+    }
+    QMutexLocker locker(&mRequestsMutex);
+    mWorkerActive = false;
+}
+
+ProjectTreeScanner::Result ProjectTreeScanner::scanDirectory(const FilePath& dir) noexcept
+{
+    QDir qdir(dir.toStr());
+    Result result{dir, isProjectFolder(qdir) ? ProjectTreeItem::ProjectFolder :
+                                               ProjectTreeItem::Folder, QList<Entry>()};
+    QFileInfoList items = qdir.entryInfoList(QDir::Files | QDir::Dirs |
+                                             QDir::NoDotAndDotDot,
+                                             QDir::DirsFirst | QDir::Name);
+    foreach (const QFileInfo& item, items) {
+        Entry entry{dir.getPathTo(item.fileName()), ProjectTreeItem::File};
+        if (item.isDir()) {
+            entry.type = isProjectFolder(QDir(item.filePath())) ?
+                         ProjectTreeItem::ProjectFolder : ProjectTreeItem::Folder;
+        } else if (item.suffix() == "lpp") {
+            entry.type = ProjectTreeItem::ProjectFile;
+        }
+        result.entries.append(entry);
+    }
+    return result;
+}
+
+bool ProjectTreeScanner::isProjectFolder(const QDir& dir) noexcept
+{
+    return dir.entryList(QStringList("*.lpp"), QDir::Files).count() == 1;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
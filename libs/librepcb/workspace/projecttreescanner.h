@@ -0,0 +1,133 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_PROJECTTREESCANNER_H
+#define LIBREPCB_WORKSPACE_PROJECTTREESCANNER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+#include "projecttreeitem.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class ProjectTreeScanner
+ ****************************************************************************************/
+
+/**
+ * @brief The ProjectTreeScanner class lists directories of the project tree in a
+ *        separate thread
+ *
+ * The librepcb::workspace::ProjectTreeModel requests the content of a directory with
+ * #requestScan() as soon as the directory gets expanded (or was modified in the file
+ * system). The directory and all its subdirectories (to determine whether they are
+ * project folders) are listed in the worker thread, and the #directoryScanned() signal
+ * is emitted afterwards. The results can then be fetched with #takeResults().
+ *
+ * The thread is only running while there are pending requests.
+ *
+ * @warning The #run() method must not access any objects except the members of this
+ *          class (protected by the mutexes), as it is executed in a separate thread!
+ */
+class ProjectTreeScanner final : public QThread
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+
+        /// An item (file or directory) inside a scanned directory
+        struct Entry {
+            FilePath filepath;
+            ProjectTreeItem::ItemType_t type;
+        };
+
+        /// The result of a scanned directory
+        struct Result {
+            FilePath directory;
+            ProjectTreeItem::ItemType_t type;   ///< Folder or ProjectFolder
+            QList<Entry> entries;               ///< directories first, sorted by name
+        };
+
+
+        // Constructors / Destructor
+        ProjectTreeScanner() noexcept;
+        ProjectTreeScanner(const ProjectTreeScanner& other) = delete;
+        ~ProjectTreeScanner() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Request to list the content of a directory
+         *
+         * @param dir       The directory to scan (requests of already pending directories
+         *                  are ignored)
+         */
+        void requestScan(const FilePath& dir) noexcept;
+
+        /**
+         * @brief Take all results which were completed until now
+         *
+         * @return The results in the order they were completed
+         */
+        QList<Result> takeResults() noexcept;
+
+        // Operator Overloadings
+        ProjectTreeScanner& operator=(const ProjectTreeScanner& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief A requested directory was scanned (emitted from the worker thread)
+         */
+        void directoryScanned();
+
+
+    private: // Methods
+        void run() noexcept override;
+        static Result scanDirectory(const FilePath& dir) noexcept;
+        static bool isProjectFolder(const QDir& dir) noexcept;
+
+
+    private: // Data
+        volatile bool mAbort;
+        QMutex mRequestsMutex;
+        QList<FilePath> mRequests;  ///< pending requests (protected by #mRequestsMutex)
+        bool mWorkerActive;         ///< whether #run() processes #mRequests
+        QMutex mResultsMutex;
+        QList<Result> mResults;     ///< completed requests (protected by #mResultsMutex)
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WORKSPACE_PROJECTTREESCANNER_H
@@ -25,6 +25,7 @@
 #include "recentprojectsmodel.h"
 #include "workspace.h"
 #include "settings/workspacesettings.h"
+#include "projectmetadatacache.h"
 #include <librepcb/common/fileio/smarttextfile.h>
 
 /*****************************************************************************************
@@ -40,6 +41,9 @@ namespace workspace {
 RecentProjectsModel::RecentProjectsModel(const Workspace& workspace) noexcept :
     QAbstractListModel(nullptr), mWorkspace(workspace)
 {
+    connect(&mWorkspace.getProjectMetadataCache(), &ProjectMetadataCache::metadataChanged,
+            this, &RecentProjectsModel::projectMetadataChanged);
+
     try {
         FilePath filepath = mWorkspace.getMetadataPath().getPathTo("recent_projects.txt");
         if (filepath.isExistingFile()) {
@@ -85,6 +89,9 @@ void RecentProjectsModel::save() noexcept
 
 void RecentProjectsModel::setLastRecentProject(const FilePath& filepath) noexcept
 {
+    // the project was just opened, so its cached metadata is probably outdated
+    mWorkspace.getProjectMetadataCache().refresh(filepath);
+
     // if the filepath is already in the list, we just have to move it to the top of the list
     for (int i = 0; i < mRecentProjects.count(); i++)
     {
@@ -116,6 +123,15 @@ void RecentProjectsModel::setLastRecentProject(const FilePath& filepath) noexcep
     save();
 }
 
+void RecentProjectsModel::projectMetadataChanged(const FilePath& projectFile) noexcept
+{
+    for (int i = 0; i < mRecentProjects.count(); ++i) {
+        if (mRecentProjects.at(i) == projectFile) {
+            emit dataChanged(index(i), index(i));
+        }
+    }
+}
+
 /*****************************************************************************************
  *  Inherited Methods
  ****************************************************************************************/
@@ -133,17 +149,37 @@ QVariant RecentProjectsModel::data(const QModelIndex& index, int role) const
     if (!index.isValid())
         return QVariant();
 
+    // only the cached metadata is used to avoid accessing the file system
+    const FilePath& filepath = mRecentProjects.at(index.row());
+    ProjectMetadataCache::Metadata metadata =
+        mWorkspace.getProjectMetadataCache().getMetadata(filepath);
+
     switch (role)
     {
         case Qt::DisplayRole:
+            return metadata.name.isEmpty() ? filepath.getFilename() : metadata.name;
+
+        case Qt::ToolTipRole:
         {
-            return mRecentProjects.at(index.row()).getFilename();
+            if (!metadata.exists)
+                return tr("Project not found: %1").arg(filepath.toNative());
+            QString tooltip = metadata.name.isEmpty() ? filepath.getFilename() : metadata.name;
+            if (!metadata.version.isEmpty())
+                tooltip += " (" + metadata.version + ")";
+            if (metadata.lastModified.isValid())
+                tooltip += "\n" + tr("Last modified: %1").arg(metadata.lastModified.toString(Qt::DefaultLocaleShortDate));
+            return tooltip + "\n" + filepath.toNative();
         }
 
+        case Qt::ForegroundRole:
+            if (!metadata.exists)
+                return QBrush(Qt::gray);
+            return QVariant();
+
         //case Qt::ToolTipRole:
         case Qt::StatusTipRole:
         case Qt::UserRole:
-            return mRecentProjects.at(index.row()).toNative();
+            return filepath.toNative();
 
         case Qt::DecorationRole:
             return QIcon(":/img/actions/recent.png");
@@ -67,6 +67,7 @@ class RecentProjectsModel : public QAbstractListModel
 
         // General Methods
         void save() noexcept;
+        void projectMetadataChanged(const FilePath& projectFile) noexcept;
 
         // Inherited Methods
         int rowCount(const QModelIndex& parent = QModelIndex()) const;
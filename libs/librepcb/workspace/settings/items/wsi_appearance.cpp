@@ -35,11 +35,18 @@ namespace workspace {
  ****************************************************************************************/
 
 WSI_Appearance::WSI_Appearance(const QString& xmlTagName, DomElement* xmlElement) :
-    WSI_Base(xmlTagName, xmlElement), mUseOpenGl(false)
+    WSI_Base(xmlTagName, xmlElement), mUseOpenGl(false), mLodMinTextSize(8),
+    mLodMinPadSize(4), mLodMinFootprintSize(20)
 {
     if (xmlElement) {
         // load setting
         mUseOpenGl = xmlElement->getFirstChild("use_opengl", true)->getText<bool>(true);
+        // the level of detail settings are optional (added later)
+        if (DomElement* lod = xmlElement->getFirstChild("level_of_detail", false)) {
+            mLodMinTextSize = lod->getFirstChild("min_text_size", true)->getText<int>(true);
+            mLodMinPadSize = lod->getFirstChild("min_pad_size", true)->getText<int>(true);
+            mLodMinFootprintSize = lod->getFirstChild("min_footprint_size", true)->getText<int>(true);
+        }
     }
 
     // create widgets
@@ -51,6 +58,24 @@ WSI_Appearance::WSI_Appearance(const QString& xmlTagName, DomElement* xmlElement
     openGlLayout->addWidget(mUseOpenGlCheckBox.data(), openGlLayout->rowCount(), 0);
     openGlLayout->addWidget(new QLabel(tr("This setting will be applied only to newly "
                             "opened windows.")), openGlLayout->rowCount(), 0);
+
+    mLevelOfDetailWidget.reset(new QWidget());
+    QFormLayout* lodLayout = new QFormLayout(mLevelOfDetailWidget.data());
+    lodLayout->setContentsMargins(0, 0, 0, 0);
+    mLodMinTextSizeSpinBox.reset(new QSpinBox());
+    mLodMinPadSizeSpinBox.reset(new QSpinBox());
+    mLodMinFootprintSizeSpinBox.reset(new QSpinBox());
+    for (QSpinBox* spinBox : {mLodMinTextSizeSpinBox.data(), mLodMinPadSizeSpinBox.data(),
+                              mLodMinFootprintSizeSpinBox.data()}) {
+        spinBox->setRange(0, 100);
+        spinBox->setSuffix(" px");
+    }
+    mLodMinTextSizeSpinBox->setValue(mLodMinTextSize);
+    mLodMinPadSizeSpinBox->setValue(mLodMinPadSize);
+    mLodMinFootprintSizeSpinBox->setValue(mLodMinFootprintSize);
+    lodLayout->addRow(tr("Hide texts smaller than:"), mLodMinTextSizeSpinBox.data());
+    lodLayout->addRow(tr("Simplify pads smaller than:"), mLodMinPadSizeSpinBox.data());
+    lodLayout->addRow(tr("Simplify footprints smaller than:"), mLodMinFootprintSizeSpinBox.data());
 }
 
 WSI_Appearance::~WSI_Appearance() noexcept
@@ -64,16 +89,25 @@ WSI_Appearance::~WSI_Appearance() noexcept
 void WSI_Appearance::restoreDefault() noexcept
 {
     mUseOpenGlCheckBox->setChecked(false);
+    mLodMinTextSizeSpinBox->setValue(8);
+    mLodMinPadSizeSpinBox->setValue(4);
+    mLodMinFootprintSizeSpinBox->setValue(20);
 }
 
 void WSI_Appearance::apply() noexcept
 {
     mUseOpenGl = mUseOpenGlCheckBox->isChecked();
+    mLodMinTextSize = mLodMinTextSizeSpinBox->value();
+    mLodMinPadSize = mLodMinPadSizeSpinBox->value();
+    mLodMinFootprintSize = mLodMinFootprintSizeSpinBox->value();
 }
 
 void WSI_Appearance::revert() noexcept
 {
     mUseOpenGlCheckBox->setChecked(mUseOpenGl);
+    mLodMinTextSizeSpinBox->setValue(mLodMinTextSize);
+    mLodMinPadSizeSpinBox->setValue(mLodMinPadSize);
+    mLodMinFootprintSizeSpinBox->setValue(mLodMinFootprintSize);
 }
 
 /*****************************************************************************************
@@ -83,6 +117,10 @@ void WSI_Appearance::revert() noexcept
 void WSI_Appearance::serialize(DomElement& root) const
 {
     root.appendTextChild("use_opengl", mUseOpenGlCheckBox->isChecked());
+    DomElement* lod = root.appendChild("level_of_detail");
+    lod->appendTextChild("min_text_size", mLodMinTextSizeSpinBox->value());
+    lod->appendTextChild("min_pad_size", mLodMinPadSizeSpinBox->value());
+    lod->appendTextChild("min_footprint_size", mLodMinFootprintSizeSpinBox->value());
 }
 
 /*****************************************************************************************
@@ -55,10 +55,15 @@ class WSI_Appearance final : public WSI_Base
 
         // Getters
         bool getUseOpenGl() const noexcept {return mUseOpenGlCheckBox->isChecked();}
+        int getLodMinTextSize() const noexcept {return mLodMinTextSize;}
+        int getLodMinPadSize() const noexcept {return mLodMinPadSize;}
+        int getLodMinFootprintSize() const noexcept {return mLodMinFootprintSize;}
 
         // Getters: Widgets
         QString getUseOpenGlLabelText() const noexcept {return tr("Rendering Method:");}
         QWidget* getUseOpenGlWidget() const noexcept {return mUseOpenGlWidget.data();}
+        QString getLevelOfDetailLabelText() const noexcept {return tr("Level of Detail:");}
+        QWidget* getLevelOfDetailWidget() const noexcept {return mLevelOfDetailWidget.data();}
 
         // General Methods
         void restoreDefault() noexcept override;
@@ -75,10 +80,17 @@ class WSI_Appearance final : public WSI_Base
     private: // Data
 
         bool mUseOpenGl;
+        int mLodMinTextSize; ///< [px] smaller texts are not drawn
+        int mLodMinPadSize; ///< [px] smaller pads are drawn simplified
+        int mLodMinFootprintSize; ///< [px] smaller footprints are drawn as outline
 
         // Widgets
         QScopedPointer<QWidget> mUseOpenGlWidget;
         QScopedPointer<QCheckBox> mUseOpenGlCheckBox;
+        QScopedPointer<QWidget> mLevelOfDetailWidget;
+        QScopedPointer<QSpinBox> mLodMinTextSizeSpinBox;
+        QScopedPointer<QSpinBox> mLodMinPadSizeSpinBox;
+        QScopedPointer<QSpinBox> mLodMinFootprintSizeSpinBox;
 };
 
 /*****************************************************************************************
@@ -23,6 +23,11 @@
 #include <QtCore>
 #include <QtWidgets>
 #include "wsi_debugtools.h"
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/graphics/framestatistics.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/memoryreport.h>
+#include <librepcb/common/sqlitedatabase.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -35,11 +40,23 @@ namespace workspace {
  ****************************************************************************************/
 
 WSI_DebugTools::WSI_DebugTools(const QString& xmlTagName, DomElement* xmlElement) :
-    WSI_Base(xmlTagName, xmlElement)
+    WSI_Base(xmlTagName, xmlElement), mShowFrameStatistics(false),
+    mRecordFrameStatistics(false), mRecordSqlStatistics(false), mSlowSqlQueryMs(20)
 {
     if (xmlElement) {
-        // load setting
+        // load setting (the frame statistics settings are optional, added later)
+        if (DomElement* child = xmlElement->getFirstChild("frame_statistics", false)) {
+            mShowFrameStatistics = child->getFirstChild("overlay", true)->getText<bool>(true);
+            mRecordFrameStatistics = child->getFirstChild("record", true)->getText<bool>(true);
+            mFrameStatisticsCsvFilePath = child->getFirstChild("csv_file", true)->getText<QString>(false);
+        }
+        if (DomElement* child = xmlElement->getFirstChild("sql_statistics", false)) {
+            mRecordSqlStatistics = child->getFirstChild("record", true)->getText<bool>(true);
+            mSlowSqlQueryMs = child->getFirstChild("slow_query_ms", true)->getText<int>(true);
+        }
     }
+    applyFrameStatistics();
+    applySqlStatistics();
 
     // create a QWidget
     mWidget.reset(new QWidget());
@@ -48,6 +65,74 @@ WSI_DebugTools::WSI_DebugTools(const QString& xmlTagName, DomElement* xmlElement
     layout->addWidget(new QLabel(tr("Warning: Some of these settings may only work in DEBUG mode!")), 0, 0);
 #endif
 
+    // frame statistics
+    QGroupBox* frameStatisticsGroupBox = new QGroupBox(tr("Rendering Statistics"));
+    QVBoxLayout* frameStatisticsLayout = new QVBoxLayout(frameStatisticsGroupBox);
+    mShowFrameStatisticsCheckBox.reset(new QCheckBox(tr("Show frame statistics overlay in graphics views")));
+    mShowFrameStatisticsCheckBox->setChecked(mShowFrameStatistics);
+    frameStatisticsLayout->addWidget(mShowFrameStatisticsCheckBox.data());
+    mRecordFrameStatisticsCheckBox.reset(new QCheckBox(tr("Record frame statistics to CSV file:")));
+    mRecordFrameStatisticsCheckBox->setChecked(mRecordFrameStatistics);
+    frameStatisticsLayout->addWidget(mRecordFrameStatisticsCheckBox.data());
+    mFrameStatisticsCsvFilePathEdit.reset(new QLineEdit());
+    mFrameStatisticsCsvFilePathEdit->setPlaceholderText(tr("Absolute path to the CSV file"));
+    mFrameStatisticsCsvFilePathEdit->setText(mFrameStatisticsCsvFilePath);
+    frameStatisticsLayout->addWidget(mFrameStatisticsCsvFilePathEdit.data());
+    layout->addWidget(frameStatisticsGroupBox, layout->rowCount(), 0);
+
+    // startup timings
+    QGroupBox* startupTimingsGroupBox = new QGroupBox(tr("Workspace Startup"));
+    QVBoxLayout* startupTimingsLayout = new QVBoxLayout(startupTimingsGroupBox);
+    mStartupTimingsLabel.reset(new QLabel());
+    mStartupTimingsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    startupTimingsLayout->addWidget(mStartupTimingsLabel.data());
+    layout->addWidget(startupTimingsGroupBox, layout->rowCount(), 0);
+
+    // memory usage (approximate, reported by the opened workspace and projects)
+    QGroupBox* memoryGroupBox = new QGroupBox(tr("Memory Usage"));
+    QGridLayout* memoryLayout = new QGridLayout(memoryGroupBox);
+    mMemoryReportEdit.reset(new QPlainTextEdit());
+    mMemoryReportEdit->setReadOnly(true);
+    mMemoryReportEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    mMemoryReportEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    mMemoryReportEdit->setPlaceholderText(tr("Click \"Refresh\" to create a report."));
+    memoryLayout->addWidget(mMemoryReportEdit.data(), 0, 0, 1, 2);
+    QPushButton* refreshMemoryButton = new QPushButton(tr("Refresh"));
+    connect(refreshMemoryButton, &QPushButton::clicked, [this](){updateMemoryReport();});
+    memoryLayout->addWidget(refreshMemoryButton, 1, 0);
+    QPushButton* saveMemoryButton = new QPushButton(tr("Save to File..."));
+    connect(saveMemoryButton, &QPushButton::clicked, [this](){saveMemoryReport();});
+    memoryLayout->addWidget(saveMemoryButton, 1, 1);
+    layout->addWidget(memoryGroupBox, layout->rowCount(), 0);
+
+    // database query statistics (of all connections, e.g. the workspace library)
+    QGroupBox* sqlGroupBox = new QGroupBox(tr("Database Queries"));
+    QGridLayout* sqlLayout = new QGridLayout(sqlGroupBox);
+    mRecordSqlStatisticsCheckBox.reset(new QCheckBox(tr("Record query statistics and log queries slower than:")));
+    mRecordSqlStatisticsCheckBox->setChecked(mRecordSqlStatistics);
+    sqlLayout->addWidget(mRecordSqlStatisticsCheckBox.data(), 0, 0);
+    mSlowSqlQuerySpinBox.reset(new QSpinBox());
+    mSlowSqlQuerySpinBox->setRange(0, 100000);
+    mSlowSqlQuerySpinBox->setSuffix(" ms");
+    mSlowSqlQuerySpinBox->setValue(mSlowSqlQueryMs);
+    sqlLayout->addWidget(mSlowSqlQuerySpinBox.data(), 0, 1);
+    mSqlStatisticsEdit.reset(new QPlainTextEdit());
+    mSqlStatisticsEdit->setReadOnly(true);
+    mSqlStatisticsEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    mSqlStatisticsEdit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    mSqlStatisticsEdit->setPlaceholderText(tr("Click \"Refresh\" to show the recorded statistics."));
+    sqlLayout->addWidget(mSqlStatisticsEdit.data(), 1, 0, 1, 2);
+    QPushButton* refreshSqlButton = new QPushButton(tr("Refresh"));
+    connect(refreshSqlButton, &QPushButton::clicked, [this](){updateSqlStatistics();});
+    sqlLayout->addWidget(refreshSqlButton, 2, 0);
+    QPushButton* clearSqlButton = new QPushButton(tr("Clear"));
+    connect(clearSqlButton, &QPushButton::clicked, [this](){
+        SQLiteDatabase::clearQueryStatistics();
+        updateSqlStatistics();
+    });
+    sqlLayout->addWidget(clearSqlButton, 2, 1);
+    layout->addWidget(sqlGroupBox, layout->rowCount(), 0);
+
     // stretch the last row
     layout->setRowStretch(layout->rowCount(), 1);
 }
@@ -56,29 +141,111 @@ WSI_DebugTools::~WSI_DebugTools() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void WSI_DebugTools::setStartupTimings(const QList<QPair<QString, qint64>>& timings) noexcept
+{
+    QStringList lines;
+    qint64 total = 0;
+    foreach (const auto& timing, timings) {
+        lines.append(QString("%1: %2 ms").arg(timing.first).arg(timing.second));
+        total += timing.second;
+    }
+    lines.append(QString(tr("Total: %1 ms")).arg(total));
+    mStartupTimingsLabel->setText(lines.join("\n"));
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
 
 void WSI_DebugTools::restoreDefault() noexcept
 {
+    mShowFrameStatisticsCheckBox->setChecked(false);
+    mRecordFrameStatisticsCheckBox->setChecked(false);
+    mFrameStatisticsCsvFilePathEdit->clear();
+    mRecordSqlStatisticsCheckBox->setChecked(false);
+    mSlowSqlQuerySpinBox->setValue(20);
 }
 
 void WSI_DebugTools::apply() noexcept
 {
+    mShowFrameStatistics = mShowFrameStatisticsCheckBox->isChecked();
+    mRecordFrameStatistics = mRecordFrameStatisticsCheckBox->isChecked();
+    mFrameStatisticsCsvFilePath = mFrameStatisticsCsvFilePathEdit->text().trimmed();
+    applyFrameStatistics();
+    mRecordSqlStatistics = mRecordSqlStatisticsCheckBox->isChecked();
+    mSlowSqlQueryMs = mSlowSqlQuerySpinBox->value();
+    applySqlStatistics();
 }
 
 void WSI_DebugTools::revert() noexcept
 {
+    mShowFrameStatisticsCheckBox->setChecked(mShowFrameStatistics);
+    mRecordFrameStatisticsCheckBox->setChecked(mRecordFrameStatistics);
+    mFrameStatisticsCsvFilePathEdit->setText(mFrameStatisticsCsvFilePath);
+    mRecordSqlStatisticsCheckBox->setChecked(mRecordSqlStatistics);
+    mSlowSqlQuerySpinBox->setValue(mSlowSqlQueryMs);
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void WSI_DebugTools::applyFrameStatistics() const noexcept
+{
+    FrameStatistics& statistics = FrameStatistics::instance();
+    statistics.setOverlayEnabled(mShowFrameStatistics);
+    if (mRecordFrameStatistics) {
+        statistics.setCsvFilePath(FilePath(mFrameStatisticsCsvFilePath));
+    } else {
+        statistics.setCsvFilePath(FilePath());
+    }
+}
+
+void WSI_DebugTools::applySqlStatistics() const noexcept
+{
+    SQLiteDatabase::setQueryStatisticsEnabled(mRecordSqlStatistics, mSlowSqlQueryMs);
+}
+
+void WSI_DebugTools::updateSqlStatistics() noexcept
+{
+    mSqlStatisticsEdit->setPlainText(SQLiteDatabase::getQueryStatisticsReport());
+}
+
+void WSI_DebugTools::updateMemoryReport() noexcept
+{
+    mMemoryReportEdit->setPlainText(MemoryReport::createApplicationReport().toString());
+}
+
+void WSI_DebugTools::saveMemoryReport() noexcept
+{
+    QString filename = QFileDialog::getSaveFileName(mWidget.data(), tr("Save Memory Report"),
+        QDir::home().filePath("librepcb-memory-report.txt"), "*.txt");
+    if (filename.isEmpty()) return;
+
+    try {
+        // always save a fresh report, the shown one may be outdated
+        updateMemoryReport();
+        QString report = QString("%1\n\n%2\n").arg(QDateTime::currentDateTime().toString(
+            Qt::ISODate), mMemoryReportEdit->toPlainText());
+        FileUtils::writeFile(FilePath(filename), report.toUtf8()); // can throw
+    } catch (const Exception& e) {
+        QMessageBox::critical(mWidget.data(), tr("Error"), e.getMsg());
+    }
+}
+
 void WSI_DebugTools::serialize(DomElement& root) const
 {
-    Q_UNUSED(root);
+    DomElement* child = root.appendChild("frame_statistics");
+    child->appendTextChild("overlay", mShowFrameStatisticsCheckBox->isChecked());
+    child->appendTextChild("record", mRecordFrameStatisticsCheckBox->isChecked());
+    child->appendTextChild("csv_file", mFrameStatisticsCsvFilePathEdit->text().trimmed());
+    child = root.appendChild("sql_statistics");
+    child->appendTextChild("record", mRecordSqlStatisticsCheckBox->isChecked());
+    child->appendTextChild("slow_query_ms", mSlowSqlQuerySpinBox->value());
 }
 
 /*****************************************************************************************
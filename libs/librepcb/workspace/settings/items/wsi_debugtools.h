@@ -53,6 +53,15 @@ class WSI_DebugTools final : public WSI_Base
         // Getters: Widgets
         QWidget* getWidget() const noexcept {return mWidget.data();}
 
+        // Setters
+
+        /**
+         * @brief Show the durations of the workspace startup steps
+         *
+         * @param timings   See librepcb::workspace::Workspace::getStartupTimings()
+         */
+        void setStartupTimings(const QList<QPair<QString, qint64>>& timings) noexcept;
+
         // General Methods
         void restoreDefault() noexcept override;
         void apply() noexcept override;
@@ -65,10 +74,33 @@ class WSI_DebugTools final : public WSI_Base
         WSI_DebugTools& operator=(const WSI_DebugTools& rhs) = delete;
 
 
+    private: // Methods
+
+        void applyFrameStatistics() const noexcept;
+        void applySqlStatistics() const noexcept;
+        void updateSqlStatistics() noexcept;
+        void updateMemoryReport() noexcept;
+        void saveMemoryReport() noexcept;
+
+
     private: // Data
 
+        bool mShowFrameStatistics;
+        bool mRecordFrameStatistics;
+        QString mFrameStatisticsCsvFilePath;
+        bool mRecordSqlStatistics;
+        int mSlowSqlQueryMs;
+
         // Widgets
         QScopedPointer<QWidget> mWidget;
+        QScopedPointer<QCheckBox> mShowFrameStatisticsCheckBox;
+        QScopedPointer<QCheckBox> mRecordFrameStatisticsCheckBox;
+        QScopedPointer<QLineEdit> mFrameStatisticsCsvFilePathEdit;
+        QScopedPointer<QLabel> mStartupTimingsLabel;
+        QScopedPointer<QPlainTextEdit> mMemoryReportEdit;
+        QScopedPointer<QCheckBox> mRecordSqlStatisticsCheckBox;
+        QScopedPointer<QSpinBox> mSlowSqlQuerySpinBox;
+        QScopedPointer<QPlainTextEdit> mSqlStatisticsEdit;
 };
 
 /*****************************************************************************************
@@ -129,7 +129,10 @@ void WSI_LibraryLocaleOrder::restoreDefault() noexcept
 
 void WSI_LibraryLocaleOrder::apply() noexcept
 {
-    mList = mListTmp;
+    if (mListTmp != mList) {
+        mList = mListTmp;
+        emit localeOrderChanged(mList);
+    }
 }
 
 void WSI_LibraryLocaleOrder::revert() noexcept
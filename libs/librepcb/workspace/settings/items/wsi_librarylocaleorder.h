@@ -73,6 +73,16 @@ class WSI_LibraryLocaleOrder final : public WSI_Base
         WSI_LibraryLocaleOrder& operator=(const WSI_LibraryLocaleOrder& rhs) = delete;
 
 
+    signals:
+
+        /**
+         * @brief Emitted by #apply() if the locale order has been changed
+         *
+         * @param localeOrder   The new locale order
+         */
+        void localeOrderChanged(const QStringList& localeOrder);
+
+
     private: // Methods
 
         void btnUpClicked() noexcept;
@@ -0,0 +1,87 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "wsi_projectlibrarysharing.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+WSI_ProjectLibrarySharing::WSI_ProjectLibrarySharing(const QString& xmlTagName,
+                                                     DomElement* xmlElement) :
+    WSI_Base(xmlTagName, xmlElement), mEnabled(false)
+{
+    if (xmlElement) {
+        // load setting
+        mEnabled = xmlElement->getText<bool>(true);
+    }
+
+    // create the checkbox
+    mCheckBox.reset(new QCheckBox(tr("Store identical library elements only once "
+                                     "(using hard links)")));
+    mCheckBox->setToolTip(tr("Takes effect for projects opened afterwards."));
+    mCheckBox->setChecked(mEnabled);
+}
+
+WSI_ProjectLibrarySharing::~WSI_ProjectLibrarySharing() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WSI_ProjectLibrarySharing::restoreDefault() noexcept
+{
+    mCheckBox->setChecked(false);
+}
+
+void WSI_ProjectLibrarySharing::apply() noexcept
+{
+    mEnabled = mCheckBox->isChecked();
+}
+
+void WSI_ProjectLibrarySharing::revert() noexcept
+{
+    mCheckBox->setChecked(mEnabled);
+}
+
+void WSI_ProjectLibrarySharing::serialize(DomElement& root) const
+{
+    root.setText(mEnabled);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
@@ -0,0 +1,98 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_WSI_PROJECTLIBRARYSHARING_H
+#define LIBREPCB_WSI_PROJECTLIBRARYSHARING_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include "wsi_base.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class WSI_ProjectLibrarySharing
+ ****************************************************************************************/
+
+/**
+ * @brief The WSI_ProjectLibrarySharing class represents whether identical files of
+ *        project libraries are shared between projects
+ *
+ * If enabled, the project editor passes the workspace's librepcb::SharedFileStore to the
+ * project library, which then replaces the files of its elements by hard links into the
+ * store when saving the project. The setting is applied to projects opened afterwards.
+ */
+class WSI_ProjectLibrarySharing final : public WSI_Base
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        WSI_ProjectLibrarySharing() = delete;
+        WSI_ProjectLibrarySharing(const WSI_ProjectLibrarySharing& other) = delete;
+        WSI_ProjectLibrarySharing(const QString& xmlTagName, DomElement* xmlElement);
+        ~WSI_ProjectLibrarySharing() noexcept;
+
+        // Getters
+        bool isEnabled() const noexcept {return mEnabled;}
+
+        // Getters: Widgets
+        QString getLabelText() const noexcept {return tr("Project Libraries:");}
+        QWidget* getWidget() const noexcept {return mCheckBox.data();}
+
+        // General Methods
+        void restoreDefault() noexcept override;
+        void apply() noexcept override;
+        void revert() noexcept override;
+
+        /// @copydoc librepcb::SerializableObject::serialize()
+        void serialize(DomElement& root) const override;
+
+        // Operator Overloadings
+        WSI_ProjectLibrarySharing& operator=(const WSI_ProjectLibrarySharing& rhs) = delete;
+
+
+    private: // Data
+
+        /**
+         * @brief whether identical library files are shared between projects
+         *
+         * Default: false (hard links may confuse backup or synchronization tools)
+         */
+        bool mEnabled;
+
+        // Widgets
+        QScopedPointer<QCheckBox> mCheckBox;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WSI_PROJECTLIBRARYSHARING_H
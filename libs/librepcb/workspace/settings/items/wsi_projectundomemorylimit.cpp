@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "wsi_projectundomemorylimit.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+WSI_ProjectUndoMemoryLimit::WSI_ProjectUndoMemoryLimit(const QString& xmlTagName,
+                                                       DomElement* xmlElement) :
+    WSI_Base(xmlTagName, xmlElement),
+    mLimitMiB(1024), mLimitMiBTmp(mLimitMiB)
+{
+    if (xmlElement) {
+        // load setting
+        mLimitMiB = xmlElement->getText<uint>(true);
+    }
+    mLimitMiBTmp = mLimitMiB;
+
+    // create a spinbox
+    mSpinBox.reset(new QSpinBox());
+    mSpinBox->setMinimum(0);
+    mSpinBox->setMaximum(65536);
+    mSpinBox->setSingleStep(64);
+    mSpinBox->setValue(mLimitMiB);
+    mSpinBox->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    connect(mSpinBox.data(), static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            this, &WSI_ProjectUndoMemoryLimit::spinBoxValueChanged);
+
+    // create a QWidget
+    mWidget.reset(new QWidget());
+    QHBoxLayout* layout = new QHBoxLayout(mWidget.data());
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(mSpinBox.data());
+    layout->addWidget(new QLabel(tr("MiB (0 = unlimited)")));
+}
+
+WSI_ProjectUndoMemoryLimit::~WSI_ProjectUndoMemoryLimit() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WSI_ProjectUndoMemoryLimit::restoreDefault() noexcept
+{
+    mLimitMiBTmp = 1024;
+    mSpinBox->setValue(mLimitMiBTmp);
+}
+
+void WSI_ProjectUndoMemoryLimit::apply() noexcept
+{
+    mLimitMiB = mLimitMiBTmp;
+}
+
+void WSI_ProjectUndoMemoryLimit::revert() noexcept
+{
+    mLimitMiBTmp = mLimitMiB;
+    mSpinBox->setValue(mLimitMiBTmp);
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void WSI_ProjectUndoMemoryLimit::spinBoxValueChanged(int value) noexcept
+{
+    mLimitMiBTmp = value;
+}
+
+void WSI_ProjectUndoMemoryLimit::serialize(DomElement& root) const
+{
+    root.setText(mLimitMiB);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
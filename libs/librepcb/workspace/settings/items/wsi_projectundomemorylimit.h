@@ -0,0 +1,107 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_WSI_PROJECTUNDOMEMORYLIMIT_H
+#define LIBREPCB_WSI_PROJECTUNDOMEMORYLIMIT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include "wsi_base.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class WSI_ProjectUndoMemoryLimit
+ ****************************************************************************************/
+
+/**
+ * @brief The WSI_ProjectUndoMemoryLimit class represents the memory budget of the undo
+ *        stack of opened projects
+ *
+ * This setting is passed to librepcb::UndoStack::setMemoryLimit() by the project editor.
+ * A value of zero means that the undo history is not limited! A value greater than zero
+ * defines the approximate maximum memory usage in MiB.
+ */
+class WSI_ProjectUndoMemoryLimit final : public WSI_Base
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        WSI_ProjectUndoMemoryLimit() = delete;
+        WSI_ProjectUndoMemoryLimit(const WSI_ProjectUndoMemoryLimit& other) = delete;
+        WSI_ProjectUndoMemoryLimit(const QString& xmlTagName, DomElement* xmlElement);
+        ~WSI_ProjectUndoMemoryLimit() noexcept;
+
+        // Getters
+        uint getLimitMiB() const noexcept {return mLimitMiB;}
+        qint64 getLimitBytes() const noexcept {return qint64(mLimitMiB) * 1024 * 1024;}
+
+        // Getters: Widgets
+        QString getLabelText() const noexcept {return tr("Undo History Memory Limit:");}
+        QWidget* getWidget() const noexcept {return mWidget.data();}
+
+        // General Methods
+        void restoreDefault() noexcept override;
+        void apply() noexcept override;
+        void revert() noexcept override;
+
+        /// @copydoc librepcb::SerializableObject::serialize()
+        void serialize(DomElement& root) const override;
+
+        // Operator Overloadings
+        WSI_ProjectUndoMemoryLimit& operator=(const WSI_ProjectUndoMemoryLimit& rhs) = delete;
+
+
+    private: // Methods
+        void spinBoxValueChanged(int value) noexcept;
+
+
+    private: // Data
+
+        // General Attributes
+
+        /**
+         * @brief the memory limit [MiB] (0 = unlimited)
+         *
+         * Default: 1024 MiB
+         */
+        uint mLimitMiB;
+        uint mLimitMiBTmp;
+
+        // Widgets
+        QScopedPointer<QWidget> mWidget;
+        QScopedPointer<QSpinBox> mSpinBox;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WSI_PROJECTUNDOMEMORYLIMIT_H
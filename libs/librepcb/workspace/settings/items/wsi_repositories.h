@@ -57,7 +57,7 @@ class WSI_Repositories final : public WSI_Base
         ~WSI_Repositories() noexcept;
 
         // Getters
-        const QList<const Repository*>& getRepositories() const noexcept {return mList;}
+        const QList<Repository*>& getRepositories() const noexcept {return mList;}
 
         // Getters: Widgets
         QWidget* getWidget() const noexcept {return mWidget.data();}
@@ -90,7 +90,7 @@ class WSI_Repositories final : public WSI_Base
          * The repository with the highest priority is at index 0 of the list. In case of
          * version conflicts, the repository with the higher priority will be used.
          */
-        QList<const Repository*> mList;
+        QList<Repository*> mList;
         QList<const Repository*> mListTmp;
 
         // Widgets
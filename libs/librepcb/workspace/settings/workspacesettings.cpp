@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtWidgets>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/domdocument.h>
 #include <librepcb/common/fileio/smartxmlfile.h>
@@ -39,7 +40,8 @@ namespace workspace {
  ****************************************************************************************/
 
 WorkspaceSettings::WorkspaceSettings(const Workspace& workspace) :
-    QObject(nullptr), mXmlFilePath(workspace.getMetadataPath().getPathTo("settings.xml"))
+    QObject(nullptr), mXmlFilePath(workspace.getMetadataPath().getPathTo("settings.xml")),
+    mSaveTimer(), mModified(false)
 {
     qDebug("Load workspace settings...");
 
@@ -57,20 +59,36 @@ WorkspaceSettings::WorkspaceSettings(const Workspace& workspace) :
     loadSettingsItem(mAppLocale,                "app_locale",                   root);
     loadSettingsItem(mAppDefMeasUnits,          "app_default_meas_units",       root);
     loadSettingsItem(mProjectAutosaveInterval,  "project_autosave_interval",    root);
+    loadSettingsItem(mProjectUndoMemoryLimit,   "project_undo_memory_limit",    root);
+    loadSettingsItem(mProjectLibrarySharing,    "project_library_sharing",      root);
     loadSettingsItem(mAppearance,               "appearance",                   root);
     loadSettingsItem(mLibraryLocaleOrder,       "lib_locale_order",             root);
     loadSettingsItem(mLibraryNormOrder,         "lib_norm_order",               root);
     loadSettingsItem(mRepositories,             "repositories",                 root);
     loadSettingsItem(mDebugTools,               "debug_tools",                  root);
 
-    // load the settings dialog
-    mDialog.reset(new WorkspaceSettingsDialog(*this));
+    // write applied changes with a delay
+    mSaveTimer.setSingleShot(true);
+    mSaveTimer.setInterval(sSaveDelay);
+    connect(&mSaveTimer, &QTimer::timeout, this, [this](){
+        try {
+            saveScheduledChanges(); // can throw
+        } catch (const Exception& e) {
+            QMessageBox::critical(mDialog.data(), tr("Error"), QString(tr(
+                "Could not save the workspace settings: %1")).arg(e.getMsg()));
+        }
+    });
 
     qDebug("Workspace settings successfully loaded!");
 }
 
 WorkspaceSettings::~WorkspaceSettings() noexcept
 {
+    try {
+        saveScheduledChanges(); // can throw
+    } catch (const Exception& e) {
+        qCritical() << "Could not save the workspace settings:" << e.getMsg();
+    }
     mDialog.reset(); // the dialog must be deleted *before* any settings object!
     mItems.clear();
 }
@@ -86,13 +104,14 @@ void WorkspaceSettings::restoreDefaults() noexcept
     }
 }
 
-void WorkspaceSettings::applyAll()
+void WorkspaceSettings::applyAll() noexcept
 {
     foreach (WSI_Base* item, mItems) {
         item->apply();
     }
 
-    saveToFile(); // can throw
+    mModified = true;
+    mSaveTimer.start(); // restarts the delay if a save is already scheduled
 }
 
 void WorkspaceSettings::revertAll() noexcept
@@ -102,12 +121,24 @@ void WorkspaceSettings::revertAll() noexcept
     }
 }
 
+void WorkspaceSettings::saveScheduledChanges()
+{
+    mSaveTimer.stop();
+    if (mModified) {
+        saveToFile(); // can throw
+        mModified = false;
+    }
+}
+
 /*****************************************************************************************
  *  Public Slots
  ****************************************************************************************/
 
 void WorkspaceSettings::showSettingsDialog() noexcept
 {
+    if (!mDialog) {
+        mDialog.reset(new WorkspaceSettingsDialog(*this));
+    }
     mDialog->exec(); // this is blocking
 }
 
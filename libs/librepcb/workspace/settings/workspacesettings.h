@@ -31,6 +31,8 @@
 #include "items/wsi_applocale.h"
 #include "items/wsi_appdefaultmeasurementunits.h"
 #include "items/wsi_projectautosaveinterval.h"
+#include "items/wsi_projectundomemorylimit.h"
+#include "items/wsi_projectlibrarysharing.h"
 #include "items/wsi_librarylocaleorder.h"
 #include "items/wsi_librarynormorder.h"
 #include "items/wsi_debugtools.h"
@@ -59,7 +61,12 @@ class WorkspaceSettingsDialog;
  *
  * This class also provides a graphical dialog to show and edit all these settings. For
  * this purpose, the WorkspaceSettingsDialog class is used. It can be shown by calling
- * the slot #showSettingsDialog().
+ * the slot #showSettingsDialog(). The dialog is only created when it is shown the first
+ * time, as it is not needed at startup.
+ *
+ * Applied changes are not written to the settings file immediately, but after a short
+ * delay (see #sSaveDelay), so several changes in a row (e.g. "Apply" followed by "OK")
+ * lead to only one write. Pending changes are also written in the destructor.
  *
  * @author ubruhin
  * @date 2014-07-12
@@ -81,6 +88,8 @@ class WorkspaceSettings final : public QObject, public SerializableObject
         WSI_AppLocale& getAppLocale() const noexcept {return *mAppLocale;}
         WSI_AppDefaultMeasurementUnits& getAppDefMeasUnits() const noexcept {return *mAppDefMeasUnits;}
         WSI_ProjectAutosaveInterval& getProjectAutosaveInterval() const noexcept {return *mProjectAutosaveInterval;}
+        WSI_ProjectUndoMemoryLimit& getProjectUndoMemoryLimit() const noexcept {return *mProjectUndoMemoryLimit;}
+        WSI_ProjectLibrarySharing& getProjectLibrarySharing() const noexcept {return *mProjectLibrarySharing;}
         WSI_Appearance& getAppearance() const noexcept {return *mAppearance;}
         WSI_LibraryLocaleOrder& getLibLocaleOrder() const noexcept {return *mLibraryLocaleOrder;}
         WSI_LibraryNormOrder& getLibNormOrder() const noexcept {return *mLibraryNormOrder;}
@@ -90,12 +99,28 @@ class WorkspaceSettings final : public QObject, public SerializableObject
 
         // General Methods
         void restoreDefaults() noexcept;
-        void applyAll();
+
+        /**
+         * @brief Apply the modifications of all items and schedule writing the file
+         */
+        void applyAll() noexcept;
+
         void revertAll() noexcept;
 
+        /**
+         * @brief Write scheduled modifications to the settings file immediately
+         *
+         * @throw Exception If the file could not be written (it will be retried with the
+         *                  next call to #applyAll() or on destruction)
+         */
+        void saveScheduledChanges();
+
         // Operator Overloadings
         WorkspaceSettings& operator=(const WorkspaceSettings& rhs) = delete;
 
+        // Static Variables
+        static const int sSaveDelay = 1000; ///< delay from #applyAll() to writing the file [ms]
+
 
     public slots:
 
@@ -122,13 +147,17 @@ class WorkspaceSettings final : public QObject, public SerializableObject
 
         // General Attributes
         FilePath mXmlFilePath; ///< path to the "settings.xml" file
-        QScopedPointer<WorkspaceSettingsDialog> mDialog; ///< the settings dialog
+        QScopedPointer<WorkspaceSettingsDialog> mDialog; ///< the settings dialog (or nullptr)
+        QTimer mSaveTimer; ///< delays writing the file after #applyAll()
+        bool mModified; ///< whether applied changes are not yet written to the file
 
         // Settings Items
         QList<WSI_Base*> mItems; ///< contains all settings items
         QScopedPointer<WSI_AppLocale> mAppLocale;
         QScopedPointer<WSI_AppDefaultMeasurementUnits> mAppDefMeasUnits;
         QScopedPointer<WSI_ProjectAutosaveInterval> mProjectAutosaveInterval;
+        QScopedPointer<WSI_ProjectUndoMemoryLimit> mProjectUndoMemoryLimit;
+        QScopedPointer<WSI_ProjectLibrarySharing> mProjectLibrarySharing;
         QScopedPointer<WSI_Appearance> mAppearance;
         QScopedPointer<WSI_LibraryLocaleOrder> mLibraryLocaleOrder;
         QScopedPointer<WSI_LibraryNormOrder> mLibraryNormOrder;
@@ -51,16 +51,22 @@ WorkspaceSettingsDialog::WorkspaceSettingsDialog(WorkspaceSettings& settings) :
                                mSettings.getAppDefMeasUnits().getLengthUnitComboBox());
     mUi->generalLayout->addRow(mSettings.getProjectAutosaveInterval().getLabelText(),
                                mSettings.getProjectAutosaveInterval().getWidget());
+    mUi->generalLayout->addRow(mSettings.getProjectUndoMemoryLimit().getLabelText(),
+                               mSettings.getProjectUndoMemoryLimit().getWidget());
 
     // tab: appearance
     mUi->appearanceLayout->addRow(mSettings.getAppearance().getUseOpenGlLabelText(),
                                   mSettings.getAppearance().getUseOpenGlWidget());
+    mUi->appearanceLayout->addRow(mSettings.getAppearance().getLevelOfDetailLabelText(),
+                                  mSettings.getAppearance().getLevelOfDetailWidget());
 
     // tab: library
     mUi->libraryLayout->addRow(mSettings.getLibLocaleOrder().getLabelText(),
                                mSettings.getLibLocaleOrder().getWidget());
     mUi->libraryLayout->addRow(mSettings.getLibNormOrder().getLabelText(),
                                mSettings.getLibNormOrder().getWidget());
+    mUi->libraryLayout->addRow(mSettings.getProjectLibrarySharing().getLabelText(),
+                               mSettings.getProjectLibrarySharing().getWidget());
 
     // tab: repositories
     mUi->repositoriesLayout->addWidget(mSettings.getRepositories().getWidget());
@@ -88,13 +94,16 @@ WorkspaceSettingsDialog::~WorkspaceSettingsDialog()
     mSettings.getAppLocale().getWidget()->setParent(0);
     mSettings.getAppDefMeasUnits().getLengthUnitComboBox()->setParent(0);
     mSettings.getProjectAutosaveInterval().getWidget()->setParent(0);
+    mSettings.getProjectUndoMemoryLimit().getWidget()->setParent(0);
 
     // tab: appearance
     mSettings.getAppearance().getUseOpenGlWidget()->setParent(0);
+    mSettings.getAppearance().getLevelOfDetailWidget()->setParent(0);
 
     // tab: library
     mSettings.getLibLocaleOrder().getWidget()->setParent(0);
     mSettings.getLibNormOrder().getWidget()->setParent(0);
+    mSettings.getProjectLibrarySharing().getWidget()->setParent(0);
 
     // tab: repositories
     mSettings.getRepositories().getWidget()->setParent(0);
@@ -113,13 +122,8 @@ WorkspaceSettingsDialog::~WorkspaceSettingsDialog()
 
 void WorkspaceSettingsDialog::accept()
 {
-    try {
-        mSettings.applyAll(); // can throw
-        QDialog::accept();
-    } catch (const Exception& e) {
-        QMessageBox::critical(this, tr("Error"), e.getMsg());
-        QDialog::reject();
-    }
+    mSettings.applyAll();
+    QDialog::accept();
 }
 
 void WorkspaceSettingsDialog::reject()
@@ -138,11 +142,7 @@ void WorkspaceSettingsDialog::on_buttonBox_clicked(QAbstractButton *button)
     {
         case QDialogButtonBox::AcceptRole:
         case QDialogButtonBox::ApplyRole:
-            try {
-                mSettings.applyAll(); // can throw
-            } catch (const Exception& e) {
-                QMessageBox::critical(this, tr("Error"), e.getMsg());
-            }
+            mSettings.applyAll();
             break;
 
         case QDialogButtonBox::RejectRole:
@@ -28,9 +28,18 @@
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/smartversionfile.h>
 #include <librepcb/common/application.h>
+#include <librepcb/common/jobscheduler.h>
+#include <librepcb/common/fileio/sharedfilestore.h>
+#include <librepcb/common/memoryreport.h>
+#include <librepcb/common/graphics/strokefont.h>
+#include <librepcb/common/graphics/textlayoutcache.h>
+#include <librepcb/library/libraryelementcache.h>
 #include <librepcb/libraryeditor/libraryeditor.h>
 #include <librepcb/project/project.h>
 #include "library/workspacelibrarydb.h"
+#include "library/workspacelibraryelementcache.h"
+#include "library/workspacelibrarythumbnails.h"
+#include "projectmetadatacache.h"
 #include "projecttreemodel.h"
 #include "recentprojectsmodel.h"
 #include "favoriteprojectsmodel.h"
@@ -53,6 +62,7 @@ namespace workspace {
 
 Workspace::Workspace(const FilePath& wsPath) :
     QObject(nullptr),
+    mMemoryReportProviderId(0),
     mPath(wsPath),
     mProjectsPath(mPath.getPathTo("projects")),
     mMetadataPath(mPath.getPathTo("v" % qApp->getFileFormatVersion().toStr())),
@@ -77,7 +87,7 @@ Workspace::Workspace(const FilePath& wsPath) :
     FileUtils::makePath(mLibrariesPath); // can throw
 
     // Check if the workspace is locked (already open or application was crashed).
-    switch (mLock.getStatus()) // can throw
+    switch (mLock.getStatus(DirectoryLock::sDefaultTimeout)) // can throw
     {
         case DirectoryLock::LockStatus::Unlocked: {
             // nothing to do here (the workspace will be locked later)
@@ -97,68 +107,91 @@ Workspace::Workspace(const FilePath& wsPath) :
     }
 
     // the workspace can be opened by this application, so we will lock it
-    mLock.lock(); // can throw
+    mLock.lock(DirectoryLock::sDefaultTimeout); // can throw
 
     // all OK, let's load the workspace stuff!
 
+    // measure the time of each step to make startup regressions visible
+    QElapsedTimer timer;
+    timer.start();
+    auto addStartupTiming = [this, &timer](const QString& step){
+        mStartupTimings.append(qMakePair(step, timer.restart()));
+    };
+
     // load workspace settings
     mWorkspaceSettings.reset(new WorkspaceSettings(*this));
-
-    // load local libraries
-    FilePath localLibsDirPath = mLibrariesPath.getPathTo("local");
-    QDir localLibsDir(localLibsDirPath.toStr());
-    foreach (const QString& dir, localLibsDir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot)) {
-        FilePath libDirPath = localLibsDirPath.getPathTo(dir);
-        if (Library::isValidElementDirectory<Library>(libDirPath)) {
-            qDebug() << "Load local workspace library:" << dir;
-            try {
-                addLocalLibrary(dir); // can throw
-            } catch (Exception& e) {
-                // @todo do not show a message box here, better use something like a
-                // getLastError() method which is used by the ControlPanel to show errors
-                QMessageBox::critical(nullptr, tr("Error"), QString(tr(
-                    "Could not open local library %1: %2")).arg(dir, e.getMsg()));
+    mJobScheduler.reset(new JobScheduler());
+    mProjectLibraryStore.reset(new SharedFileStore(mMetadataPath.getPathTo("project_library_store")));
+    addStartupTiming("Load workspace settings");
+
+    // find local and remote libraries (they are opened on demand, see getLocalLibraries()
+    // and getRemoteLibraries(), as parsing all of them would slow down the startup)
+    for (bool remote : {false, true}) {
+        FilePath libsDirPath = mLibrariesPath.getPathTo(remote ? "remote" : "local");
+        QDir libsDir(libsDirPath.toStr());
+        foreach (const QString& dir, libsDir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot)) {
+            FilePath libDirPath = libsDirPath.getPathTo(dir);
+            if (Library::isValidElementDirectory<Library>(libDirPath)) {
+                (remote ? mRemoteLibraryDirs : mLocalLibraryDirs).insert(dir, libDirPath);
+            } else {
+                qWarning() << "Directory is not a valid libary:" << libDirPath.toNative();
             }
-        } else {
-            qWarning() << "Directory is not a valid libary:" << libDirPath.toNative();
-        }
-    }
-
-    // load remote libraries
-    FilePath remoteLibsDirPath = mLibrariesPath.getPathTo("remote");
-    QDir remoteLibsDir(remoteLibsDirPath.toStr());
-    foreach (const QString& dir, remoteLibsDir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot)) {
-        FilePath libDirPath = remoteLibsDirPath.getPathTo(dir);
-        if (Library::isValidElementDirectory<Library>(libDirPath)) {
-            qDebug() << "Load remote workspace library:" << dir;
-            try {
-                addRemoteLibrary(dir); // can throw
-            } catch (Exception& e) {
-                // @todo do not show a message box here, better use something like a
-                // getLastError() method which is used by the ControlPanel to show errors
-                QMessageBox::critical(nullptr, tr("Error"), QString(tr(
-                    "Could not open remote library %1: %2")).arg(dir, e.getMsg()));
-            }
-        } else {
-            qWarning() << "Directory is not a valid libary:" << libDirPath.toNative();
         }
     }
+    addStartupTiming("Find workspace libraries");
 
     // load library database
     mLibraryDb.reset(new WorkspaceLibraryDb(*this)); // can throw
-    connect(this, &Workspace::libraryAdded,
-            mLibraryDb.data(), &WorkspaceLibraryDb::startLibraryRescan);
+    connect(this, &Workspace::libraryAdded, mLibraryDb.data(), [this](const FilePath& libDir){
+        // only the new library needs to be scanned
+        mLibraryDb->startLibraryUpdate({{libDir, QSet<FilePath>()}});
+    });
     connect(this, &Workspace::libraryRemoved,
             mLibraryDb.data(), &WorkspaceLibraryDb::startLibraryRescan);
+    connect(&mWorkspaceSettings->getLibLocaleOrder(), &WSI_LibraryLocaleOrder::localeOrderChanged,
+            mLibraryDb.data(), &WorkspaceLibraryDb::setLocaleOrder);
+
+    // elements may have been added, removed or modified after a rescan
+    mLibraryElementCache.reset(new WorkspaceLibraryElementCache());
+    connect(mLibraryDb.data(), &WorkspaceLibraryDb::scanSucceeded,
+            mLibraryElementCache.data(), &WorkspaceLibraryElementCache::clear);
+
+    // thumbnails are identified by element versions, so they never need to be cleared
+    mLibraryThumbnails.reset(new WorkspaceLibraryThumbnails(*mLibraryDb, *mJobScheduler,
+                                                            mMetadataPath.getPathTo("thumbnails")));
+    addStartupTiming("Open library database");
 
     // load project models
+    mProjectMetadataCache.reset(new ProjectMetadataCache(*mJobScheduler,
+                                    mMetadataPath.getPathTo("project_metadata_cache.xml")));
     mRecentProjectsModel.reset(new RecentProjectsModel(*this));
     mFavoriteProjectsModel.reset(new FavoriteProjectsModel(*this));
     mProjectTreeModel.reset(new ProjectTreeModel(*this));
+    addStartupTiming("Load project models");
+
+    qint64 total = 0;
+    foreach (const auto& timing, mStartupTimings) {
+        qDebug() << "Workspace startup:" << timing.first << "took" << timing.second << "ms";
+        total += timing.second;
+    }
+    qDebug() << "Workspace opened in" << total << "ms";
+    mWorkspaceSettings->getDebugTools().setStartupTimings(mStartupTimings);
+
+    // make the memory usage of the caches visible in the debug tools
+    mMemoryReportProviderId = MemoryReport::registerProvider([this](MemoryReport& report){
+        MemoryReport& workspace = report.addChild("Workspace", sizeof(Workspace));
+        mLibraryElementCache->addToMemoryReport(workspace);
+        mLibraryThumbnails->addToMemoryReport(workspace);
+        MemoryReport& shared = report.addChild("Shared caches");
+        library::LibraryElementCache::addToMemoryReport(shared);
+        TextLayoutCache::addToMemoryReport(shared);
+        StrokeFont::addToMemoryReport(shared);
+    });
 }
 
 Workspace::~Workspace() noexcept
 {
+    MemoryReport::unregisterProvider(mMemoryReportProviderId);
 }
 
 /*****************************************************************************************
@@ -187,28 +220,69 @@ QAbstractItemModel& Workspace::getFavoriteProjectsModel() const noexcept
 Version Workspace::getVersionOfLibrary(const Uuid& uuid, bool local, bool remote) const noexcept
 {
     Version version;
-    if (local) {
-        foreach (const auto& lib, mLocalLibraries) { Q_ASSERT(lib);
-            if ((lib->getUuid() == uuid) && ((!version.isValid()) || (version < lib->getVersion()))) {
-                version = lib->getVersion();
+    for (bool isRemote : {false, true}) {
+        if ((isRemote && (!remote)) || ((!isRemote) && (!local))) continue;
+        QMap<QString, FilePath> dirs = isRemote ? getRemoteLibraryDirectories()
+                                                : getLocalLibraryDirectories();
+        const auto& libraries = isRemote ? mRemoteLibraries : mLocalLibraries;
+        for (auto it = dirs.constBegin(); it != dirs.constEnd(); ++it) {
+            Uuid libUuid;
+            Version libVersion;
+            if (QSharedPointer<Library> lib = libraries.value(it.key())) {
+                libUuid = lib->getUuid();
+                libVersion = lib->getVersion();
+            } else {
+                try {
+                    mLibraryDb->getLibraryMetadata(it.value(), &libUuid, &libVersion); // can throw
+                } catch (const Exception&) {
+                    // not scanned yet, so the library needs to be opened
+                    if (QSharedPointer<Library> lib = openLibrary(it.key(), isRemote)) {
+                        libUuid = lib->getUuid();
+                        libVersion = lib->getVersion();
+                    }
+                }
             }
-        }
-    }
-    if (remote) {
-        foreach (const auto& lib, mRemoteLibraries) { Q_ASSERT(lib);
-            if ((lib->getUuid() == uuid) && ((!version.isValid()) || (version < lib->getVersion()))) {
-                version = lib->getVersion();
+            if ((libUuid == uuid) && ((!version.isValid()) || (version < libVersion))) {
+                version = libVersion;
             }
         }
     }
     return version;
 }
 
+QMap<QString, FilePath> Workspace::getLocalLibraryDirectories() const noexcept
+{
+    QMutexLocker locker(&mLibraryDirsMutex);
+    return mLocalLibraryDirs;
+}
+
+QMap<QString, FilePath> Workspace::getRemoteLibraryDirectories() const noexcept
+{
+    QMutexLocker locker(&mLibraryDirsMutex);
+    return mRemoteLibraryDirs;
+}
+
+const QMap<QString, QSharedPointer<Library>> Workspace::getLocalLibraries() const noexcept
+{
+    openLibraries(false);
+    return mLocalLibraries;
+}
+
+const QMap<QString, QSharedPointer<Library>> Workspace::getRemoteLibraries() const noexcept
+{
+    openLibraries(true);
+    return mRemoteLibraries;
+}
+
 void Workspace::addLocalLibrary(const QString& libDirName)
 {
-    if (!mLocalLibraries.contains(libDirName)) {
+    if (!mLocalLibraryDirs.contains(libDirName)) {
         FilePath libDirPath = mLibrariesPath.getPathTo("local").getPathTo(libDirName);
         QSharedPointer<Library> library(new Library(libDirPath, false)); // can throw
+        {
+            QMutexLocker locker(&mLibraryDirsMutex);
+            mLocalLibraryDirs.insert(libDirName, libDirPath);
+        }
         mLocalLibraries.insert(libDirName, library);
         emit libraryAdded(libDirPath);
     }
@@ -216,20 +290,38 @@ void Workspace::addLocalLibrary(const QString& libDirName)
 
 void Workspace::addRemoteLibrary(const QString& libDirName)
 {
-    if (!mRemoteLibraries.contains(libDirName)) {
+    if (!mRemoteLibraryDirs.contains(libDirName)) {
         // remote libraries are always opened read-only!
         FilePath libDirPath = mLibrariesPath.getPathTo("remote").getPathTo(libDirName);
         QSharedPointer<Library> library(new Library(libDirPath, true)); // can throw
+        {
+            QMutexLocker locker(&mLibraryDirsMutex);
+            mRemoteLibraryDirs.insert(libDirName, libDirPath);
+        }
         mRemoteLibraries.insert(libDirName, library);
         emit libraryAdded(libDirPath);
     }
 }
 
+void Workspace::reloadRemoteLibrary(const QString& libDirName)
+{
+    if (mRemoteLibraryDirs.contains(libDirName)) {
+        FilePath libDirPath = mRemoteLibraryDirs.value(libDirName);
+        QSharedPointer<Library> library(new Library(libDirPath, true)); // can throw
+        mRemoteLibraries.insert(libDirName, library);
+    } else {
+        addRemoteLibrary(libDirName); // can throw
+    }
+}
+
 void Workspace::removeLocalLibrary(const QString& libDirName, bool rmDir)
 {
-    Library* library = mLocalLibraries.value(libDirName).data();
-    if (library) {
-        FilePath libDirPath = library->getFilePath();
+    if (mLocalLibraryDirs.contains(libDirName)) {
+        FilePath libDirPath = mLocalLibraryDirs.value(libDirName);
+        {
+            QMutexLocker locker(&mLibraryDirsMutex);
+            mLocalLibraryDirs.remove(libDirName);
+        }
         mLocalLibraries.remove(libDirName);
         emit libraryRemoved(libDirPath);
         if (rmDir)  FileUtils::removeDirRecursively(libDirPath); // can throw
@@ -238,9 +330,12 @@ void Workspace::removeLocalLibrary(const QString& libDirName, bool rmDir)
 
 void Workspace::removeRemoteLibrary(const QString& libDirName, bool rmDir)
 {
-    Library* library = mRemoteLibraries.value(libDirName).data();
-    if (library) {
-        FilePath libDirPath = library->getFilePath();
+    if (mRemoteLibraryDirs.contains(libDirName)) {
+        FilePath libDirPath = mRemoteLibraryDirs.value(libDirName);
+        {
+            QMutexLocker locker(&mLibraryDirsMutex);
+            mRemoteLibraryDirs.remove(libDirName);
+        }
         mRemoteLibraries.remove(libDirName);
         emit libraryRemoved(libDirPath);
         if (rmDir) FileUtils::removeDirRecursively(libDirPath); // can throw
@@ -271,6 +366,37 @@ void Workspace::removeFavoriteProject(const FilePath& filepath) noexcept
     mFavoriteProjectsModel->removeFavoriteProject(filepath);
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QSharedPointer<Library> Workspace::openLibrary(const QString& libDirName,
+                                               bool remote) const noexcept
+{
+    auto& libraries = remote ? mRemoteLibraries : mLocalLibraries;
+    QSharedPointer<Library> library = libraries.value(libDirName);
+    if (!library) {
+        FilePath libDirPath = (remote ? mRemoteLibraryDirs : mLocalLibraryDirs).value(libDirName);
+        try {
+            // remote libraries are always opened read-only!
+            qDebug() << "Open workspace library:" << libDirPath.toNative();
+            library.reset(new Library(libDirPath, remote)); // can throw
+            libraries.insert(libDirName, library);
+        } catch (const Exception& e) {
+            qCritical() << "Could not open workspace library" << libDirPath.toNative()
+                        << ":" << e.getMsg();
+        }
+    }
+    return library;
+}
+
+void Workspace::openLibraries(bool remote) const noexcept
+{
+    foreach (const QString& libDirName, (remote ? mRemoteLibraryDirs : mLocalLibraryDirs).keys()) {
+        openLibrary(libDirName, remote);
+    }
+}
+
 /*****************************************************************************************
  *  Static Methods
  ****************************************************************************************/
@@ -34,6 +34,9 @@
  ****************************************************************************************/
 namespace librepcb {
 
+class JobScheduler;
+class SharedFileStore;
+
 namespace library {
 class Library;
 }
@@ -44,11 +47,14 @@ class Project;
 
 namespace workspace {
 
+class ProjectMetadataCache;
 class ProjectTreeModel;
 class RecentProjectsModel;
 class FavoriteProjectsModel;
 class WorkspaceSettings;
 class WorkspaceLibraryDb;
+class WorkspaceLibraryElementCache;
+class WorkspaceLibraryThumbnails;
 
 /*****************************************************************************************
  *  Class Workspace
@@ -115,11 +121,29 @@ class Workspace final : public QObject
         QAbstractItemModel& getRecentProjectsModel() const noexcept;
         QAbstractItemModel& getFavoriteProjectsModel() const noexcept;
 
+        /**
+         * @brief Get the cached metadata of recent and favorite projects
+         */
+        ProjectMetadataCache& getProjectMetadataCache() const noexcept {return *mProjectMetadataCache;}
+
         /**
          * @brief Get the workspace settings
          */
         WorkspaceSettings& getSettings() const {return *mWorkspaceSettings;}
 
+        /**
+         * @brief Get the scheduler for background jobs of the workspace and its projects
+         */
+        JobScheduler& getJobScheduler() const noexcept {return *mJobScheduler;}
+
+        /**
+         * @brief Get the store to share identical files of project libraries
+         *
+         * @note    The store is only used by projects if enabled in the workspace settings
+         *          (see librepcb::workspace::WSI_ProjectLibrarySharing).
+         */
+        SharedFileStore& getProjectLibraryStore() const noexcept {return *mProjectLibraryStore;}
+
 
         // Library Management
 
@@ -131,24 +155,45 @@ class Workspace final : public QObject
          * @param remote    If true, remote libraries are searched
          *
          * @return The highest version of the library (invalid if library not installed)
+         *
+         * @note Libraries which are not opened yet are not opened by this method, their
+         *       version is read from the library database instead (if available).
          */
         Version getVersionOfLibrary(const Uuid& uuid, bool local = true, bool remote = true) const noexcept;
 
+        /**
+         * @brief Get the directories of all local libraries
+         *
+         * In contrast to #getLocalLibraries(), this does not open any library. This
+         * method is thread-safe.
+         *
+         * @return The library directories (key: directory name)
+         */
+        QMap<QString, FilePath> getLocalLibraryDirectories() const noexcept;
+
+        /**
+         * @brief Get the directories of all remote libraries
+         *
+         * @copydetails getLocalLibraryDirectories()
+         */
+        QMap<QString, FilePath> getRemoteLibraryDirectories() const noexcept;
+
         /**
          * @brief Get all local libraries (located in "workspace/v#/libraries/local")
          *
+         * The libraries are not opened at startup, but on the first call of this method.
+         * Libraries which could not be opened are not contained in the returned list.
+         *
          * @return A list of all local libraries
          */
-        const QMap<QString, QSharedPointer<library::Library>> getLocalLibraries() const noexcept
-        {return mLocalLibraries;}
+        const QMap<QString, QSharedPointer<library::Library>> getLocalLibraries() const noexcept;
 
         /**
          * @brief Get all remote libraries (located in "workspace/v#/libraries/remote")
          *
-         * @return A list of all remote libraries
+         * @copydetails getLocalLibraries()
          */
-        const QMap<QString, QSharedPointer<library::Library>> getRemoteLibraries() const noexcept
-        {return mRemoteLibraries;}
+        const QMap<QString, QSharedPointer<library::Library>> getRemoteLibraries() const noexcept;
 
         /**
          * @brief Add a new local library
@@ -188,12 +233,35 @@ class Workspace final : public QObject
          */
         void removeRemoteLibrary(const QString& libDirName, bool rmDir = true);
 
+        /**
+         * @brief Reload the metadata of a remote library after it was updated
+         *
+         * In contrast to removing and adding the library again, this does not trigger a
+         * rescan of the library, so the caller is responsible to update the library
+         * database (e.g. with librepcb::workspace::WorkspaceLibraryDb::startLibraryUpdate()).
+         *
+         * @param libDirName    The name of the (existing) remote library directory
+         *
+         * @throws Exception on error
+         */
+        void reloadRemoteLibrary(const QString& libDirName);
+
 
         /**
          * @brief Get the workspace library database
          */
         WorkspaceLibraryDb& getLibraryDb() const {return *mLibraryDb;}
 
+        /**
+         * @brief Get the cache of recently loaded (read-only) library elements
+         */
+        WorkspaceLibraryElementCache& getLibraryElementCache() const {return *mLibraryElementCache;}
+
+        /**
+         * @brief Get the thumbnails (preview images) of the workspace library elements
+         */
+        WorkspaceLibraryThumbnails& getLibraryThumbnails() const {return *mLibraryThumbnails;}
+
 
         // Project Management
 
@@ -231,6 +299,17 @@ class Workspace final : public QObject
         Workspace& operator=(const Workspace& rhs) = delete;
 
 
+        // Debugging
+
+        /**
+         * @brief Get the time spent in the steps of opening the workspace
+         *
+         * @return The names of the steps and their durations in milliseconds
+         */
+        const QList<QPair<QString, qint64>>& getStartupTimings() const noexcept
+        {return mStartupTimings;}
+
+
         // Static Methods
 
         /**
@@ -303,20 +382,37 @@ class Workspace final : public QObject
         void libraryRemoved(const FilePath& libDir);
 
 
+    private: // Methods
+
+        QSharedPointer<library::Library> openLibrary(const QString& libDirName,
+                                                     bool remote) const noexcept;
+        void openLibraries(bool remote) const noexcept;
+
+
     private: // Data
 
+        int mMemoryReportProviderId; ///< see librepcb::MemoryReport::registerProvider()
         FilePath mPath; ///< a FilePath object which represents the workspace directory
         FilePath mProjectsPath; ///< the directory "projects"
         FilePath mMetadataPath; ///< the subdirectory of the current file format version
         FilePath mLibrariesPath; ///< the directory "v#/libraries"
         DirectoryLock mLock; ///< to lock the version directory (#mVersionPath)
         QScopedPointer<WorkspaceSettings> mWorkspaceSettings; ///< the WorkspaceSettings object
-        QMap<QString, QSharedPointer<library::Library>> mLocalLibraries; ///< all local libraries
-        QMap<QString, QSharedPointer<library::Library>> mRemoteLibraries; ///< all remote libraries
+        QScopedPointer<JobScheduler> mJobScheduler; ///< shared by all background jobs
+        QScopedPointer<SharedFileStore> mProjectLibraryStore; ///< see #getProjectLibraryStore()
+        QMap<QString, FilePath> mLocalLibraryDirs; ///< directories of all local libraries
+        QMap<QString, FilePath> mRemoteLibraryDirs; ///< directories of all remote libraries
+        mutable QMutex mLibraryDirsMutex; ///< the library scanner reads the directories
+        mutable QMap<QString, QSharedPointer<library::Library>> mLocalLibraries; ///< opened local libraries
+        mutable QMap<QString, QSharedPointer<library::Library>> mRemoteLibraries; ///< opened remote libraries
         QScopedPointer<WorkspaceLibraryDb> mLibraryDb; ///< the library database
+        QScopedPointer<WorkspaceLibraryElementCache> mLibraryElementCache; ///< loaded library elements
+        QScopedPointer<WorkspaceLibraryThumbnails> mLibraryThumbnails; ///< library element previews
+        QScopedPointer<ProjectMetadataCache> mProjectMetadataCache; ///< used by the project models
         QScopedPointer<ProjectTreeModel> mProjectTreeModel; ///< a tree model for the whole projects directory
         QScopedPointer<RecentProjectsModel> mRecentProjectsModel; ///< a list model of all recent projects
         QScopedPointer<FavoriteProjectsModel> mFavoriteProjectsModel; ///< a list model of all favorite projects
+        QList<QPair<QString, qint64>> mStartupTimings; ///< see #getStartupTimings()
 };
 
 /*****************************************************************************************
@@ -25,9 +25,15 @@ SOURCES += \
     library/cat/categorytreeitem.cpp \
     library/cat/categorytreemodel.cpp \
     library/workspacelibrarydb.cpp \
+    library/workspacelibraryelementcache.cpp \
+    library/workspacelibrarythumbnails.cpp \
     library/workspacelibraryscanner.cpp \
+    library/workspacelibrarywatcher.cpp \
+    library/workspaceprojectindexer.cpp \
+    projectmetadatacache.cpp \
     projecttreeitem.cpp \
     projecttreemodel.cpp \
+    projecttreescanner.cpp \
     recentprojectsmodel.cpp \
     settings/items/wsi_appdefaultmeasurementunits.cpp \
     settings/items/wsi_appearance.cpp \
@@ -37,6 +43,8 @@ SOURCES += \
     settings/items/wsi_librarylocaleorder.cpp \
     settings/items/wsi_librarynormorder.cpp \
     settings/items/wsi_projectautosaveinterval.cpp \
+    settings/items/wsi_projectlibrarysharing.cpp \
+    settings/items/wsi_projectundomemorylimit.cpp \
     settings/items/wsi_repositories.cpp \
     settings/workspacesettings.cpp \
     settings/workspacesettingsdialog.cpp \
@@ -47,9 +55,15 @@ HEADERS += \
     library/cat/categorytreeitem.h \
     library/cat/categorytreemodel.h \
     library/workspacelibrarydb.h \
+    library/workspacelibraryelementcache.h \
+    library/workspacelibrarythumbnails.h \
     library/workspacelibraryscanner.h \
+    library/workspacelibrarywatcher.h \
+    library/workspaceprojectindexer.h \
+    projectmetadatacache.h \
     projecttreeitem.h \
     projecttreemodel.h \
+    projecttreescanner.h \
     recentprojectsmodel.h \
     settings/items/wsi_appdefaultmeasurementunits.h \
     settings/items/wsi_appearance.h \
@@ -59,6 +73,8 @@ HEADERS += \
     settings/items/wsi_librarylocaleorder.h \
     settings/items/wsi_librarynormorder.h \
     settings/items/wsi_projectautosaveinterval.h \
+    settings/items/wsi_projectlibrarysharing.h \
+    settings/items/wsi_projectundomemorylimit.h \
     settings/items/wsi_repositories.h \
     settings/workspacesettings.h \
     settings/workspacesettingsdialog.h \
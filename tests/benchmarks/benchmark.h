@@ -0,0 +1,114 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Class Benchmark
+ ****************************************************************************************/
+
+/**
+ * @brief Base class of all benchmark fixtures
+ *
+ * Every measurement is printed to stdout and recorded as properties in the report of
+ * googletest, so the results can be tracked over time in a machine-readable way:
+ *
+ *     benchmarks --gtest_output=xml:benchmarks.xml
+ *
+ * For every measurement named `name`, the properties `name_ns` (average nanoseconds per
+ * call as a decimal string) and `name_iterations` are written to the XML report.
+ */
+class Benchmark : public ::testing::Test
+{
+    protected:
+
+        /**
+         * @brief Measure the average duration of an operation
+         *
+         * The operation is called once without measuring (to warm up caches and lazy
+         * initializations), then `iterations` times while measuring the elapsed time.
+         *
+         * @param name          The name of the measurement (used as property key)
+         * @param iterations    How often the operation is called
+         * @param fun           The operation, called with the iteration index as argument
+         */
+        template <typename Fun>
+        static void measure(const std::string& name, int iterations, Fun fun)
+        {
+            fun(0);
+            QElapsedTimer timer;
+            timer.start();
+            for (int i = 0; i < iterations; ++i) {
+                fun(i);
+            }
+            record(name, timer.nsecsElapsed(), iterations);
+        }
+
+        /**
+         * @brief Print and record a measured duration
+         *
+         * @param name          The name of the measurement (used as property key)
+         * @param ns            The total measured duration in nanoseconds
+         * @param iterations    The count of operations measured in this duration
+         */
+        static void record(const std::string& name, qint64 ns, int iterations)
+        {
+            qreal nsPerCall = static_cast<qreal>(ns) / qMax(iterations, 1);
+            std::string value = QString::number(nsPerCall, 'f', 1).toStdString();
+            std::cout << name << ": " << value << " ns (" << iterations << " iterations)"
+                      << std::endl;
+            ::testing::Test::RecordProperty(name + "_ns", value);
+            ::testing::Test::RecordProperty(name + "_iterations", iterations);
+        }
+
+        /**
+         * @brief Prevent the compiler from optimizing away an otherwise unused result
+         */
+        template <typename T>
+        static void doNotOptimize(const T& value) noexcept
+        {
+            static const void* volatile sink = nullptr;
+            sink = &value;
+        }
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
+
+#endif // BENCHMARK_H
@@ -0,0 +1,238 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/domelement.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/serializableobjectlist.h>
+#include <librepcb/common/cam/gerberaperturelist.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include "../common/fileio/serializableobjectmock.h"
+#include "benchmark.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Types
+ ****************************************************************************************/
+
+struct CoreBenchmarkTagNameProvider {static constexpr const char* tagname = "object";};
+using MockList = SerializableObjectList<SerializableObjectMock, CoreBenchmarkTagNameProvider>;
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class CoreBenchmark : public Benchmark
+{
+    protected:
+        static const int sIterations = 1000000;
+        static const int sValues = 1000; ///< count of different input values
+
+        static QVector<Uuid> createUuids() noexcept
+        {
+            QVector<Uuid> uuids;
+            for (int i = 0; i < sValues; ++i) {
+                uuids.append(Uuid::createRandom());
+            }
+            return uuids;
+        }
+
+        static QStringList createMmStrings() noexcept
+        {
+            QStringList strings;
+            for (int i = 0; i < sValues; ++i) {
+                strings.append(Length(i * 123457 - 50000000).toMmString());
+            }
+            return strings;
+        }
+
+        /// A document similar to a big board file (many elements with attributes)
+        static QByteArray createLargeXml(int elements)
+        {
+            DomDocument doc(*new DomElement("board"));
+            for (int i = 0; i < elements; ++i) {
+                DomElement* child = doc.getRoot().appendChild("netline");
+                child->setAttribute("uuid", Uuid::createRandom());
+                child->setAttribute("start_point", Uuid::createRandom());
+                child->setAttribute("end_point", Uuid::createRandom());
+                child->setAttribute("width", Length(i * 1000));
+                child->appendTextChild("name", QString("netline %1").arg(i));
+            }
+            return doc.toByteArray(); // can throw
+        }
+};
+
+/*****************************************************************************************
+ *  Uuid
+ ****************************************************************************************/
+
+TEST_F(CoreBenchmark, testUuid)
+{
+    QVector<Uuid> uuids = createUuids();
+    QStringList strings;
+    QHash<Uuid, int> hash;
+    foreach (const Uuid& uuid, uuids) {
+        strings.append(uuid.toStr());
+        hash.insert(uuid, hash.count());
+    }
+
+    measure("uuid_create_random", sIterations / 10, [&](int){
+        doNotOptimize(Uuid::createRandom());
+    });
+    measure("uuid_from_string", sIterations, [&](int i){
+        doNotOptimize(Uuid(strings.at(i % sValues)));
+    });
+    measure("uuid_to_string", sIterations, [&](int i){
+        doNotOptimize(uuids.at(i % sValues).toStr());
+    });
+    measure("uuid_hash", sIterations, [&](int i){
+        doNotOptimize(qHash(uuids.at(i % sValues), 0));
+    });
+    measure("uuid_equal", sIterations, [&](int i){
+        doNotOptimize(uuids.at(i % sValues) == uuids.at((i + 1) % sValues));
+    });
+    measure("uuid_less", sIterations, [&](int i){
+        doNotOptimize(uuids.at(i % sValues) < uuids.at((i + 1) % sValues));
+    });
+    measure("uuid_qhash_lookup", sIterations, [&](int i){
+        doNotOptimize(hash.value(uuids.at(i % sValues)));
+    });
+}
+
+/*****************************************************************************************
+ *  Length / Point
+ ****************************************************************************************/
+
+TEST_F(CoreBenchmark, testLengthAndPoint)
+{
+    QStringList strings = createMmStrings();
+    QVector<Length> lengths;
+    foreach (const QString& str, strings) {
+        lengths.append(Length::fromMm(str));
+    }
+
+    measure("length_parse_mm", sIterations, [&](int i){
+        doNotOptimize(Length::fromMm(strings.at(i % sValues)));
+    });
+    measure("length_format_mm", sIterations, [&](int i){
+        doNotOptimize(lengths.at(i % sValues).toMmString());
+    });
+    measure("point_parse_mm", sIterations, [&](int i){
+        Point p;
+        p.setXmm(strings.at(i % sValues));
+        p.setYmm(strings.at((i + 1) % sValues));
+        doNotOptimize(p);
+    });
+    measure("point_format_mm", sIterations, [&](int i){
+        Point p(lengths.at(i % sValues), lengths.at((i + 1) % sValues));
+        doNotOptimize(QString(p.getX().toMmString() % "," % p.getY().toMmString()));
+    });
+    measure("point_rotate_45deg", sIterations, [&](int i){
+        Point p(lengths.at(i % sValues), lengths.at((i + 1) % sValues));
+        doNotOptimize(p.rotated(Angle::deg45()));
+    });
+}
+
+/*****************************************************************************************
+ *  DomDocument
+ ****************************************************************************************/
+
+TEST_F(CoreBenchmark, testDomDocument)
+{
+    const int elements = 50000;
+    QByteArray xml = createLargeXml(elements);
+    std::cout << "document size: " << xml.size() << " bytes" << std::endl;
+
+    measure("domdocument_parse_50k_elements", 10, [&](int){
+        DomDocument doc(xml, FilePath());
+        doNotOptimize(doc);
+    });
+    DomDocument doc(xml, FilePath());
+    measure("domdocument_serialize_50k_elements", 10, [&](int){
+        doNotOptimize(doc.toByteArray());
+    });
+}
+
+/*****************************************************************************************
+ *  SerializableObjectList
+ ****************************************************************************************/
+
+TEST_F(CoreBenchmark, testSerializableObjectList)
+{
+    QVector<Uuid> uuids = createUuids();
+    MockList list;
+    for (int i = 0; i < sValues; ++i) {
+        list.append(std::make_shared<SerializableObjectMock>(uuids.at(i), QString::number(i)));
+    }
+
+    measure("objectlist_1k_find_uuid", sIterations / 10, [&](int i){
+        doNotOptimize(list.find(uuids.at((i * 7919) % sValues)));
+    });
+    measure("objectlist_1k_find_name", sIterations / 10, [&](int i){
+        doNotOptimize(list.find(QString::number((i * 7919) % sValues)));
+    });
+    measure("objectlist_1k_contains_missing_uuid", sIterations / 10, [&](int){
+        doNotOptimize(list.contains(Uuid::createRandom()));
+    });
+}
+
+/*****************************************************************************************
+ *  Gerber
+ ****************************************************************************************/
+
+TEST_F(CoreBenchmark, testGerber)
+{
+    GerberApertureList apertures;
+    measure("gerber_aperture_lookup", sIterations, [&](int i){
+        doNotOptimize(apertures.setRect(Length(100000 + (i % 100) * 10000), Length(400000),
+                                        Angle::deg90() * (i % 4), Length(0)));
+    });
+    measure("gerber_aperture_list_string", 1000, [&](int){
+        doNotOptimize(apertures.generateString());
+    });
+
+    GerberGenerator gen("Benchmark", Uuid::createRandom(), "v1");
+    measure("gerber_draw_line", sIterations, [&](int i){
+        Point pos(Length((i % 1000) * 100000), Length((i / 1000) * 100000));
+        gen.drawLine(pos, pos + Point(100000, 50000), Length(150000 + (i % 8) * 50000));
+    });
+    measure("gerber_flash_circle", sIterations, [&](int i){
+        Point pos(Length((i % 1000) * 100000), Length((i / 1000) * 100000));
+        gen.flashCircle(pos, Length(500000 + (i % 8) * 50000), Length(0));
+    });
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include "../benchmark.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+using librepcb::tests::Benchmark;
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+/**
+ * @brief Benchmark of the item lookups of a board (used for every mouse event)
+ *
+ * The board contains a grid of 100x100 vias with a pitch of 1mm, and 100 traces with
+ * 100 segments each between the via rows.
+ */
+class BoardBenchmark : public Benchmark
+{
+    protected:
+        static const int sGridSize = 100;
+        static const int sQueries = 100000;
+
+        FilePath mProjectDir;
+        QScopedPointer<Project> mProject;
+        Board* mBoard;
+
+        BoardBenchmark() : mBoard(nullptr) {
+            mProjectDir = FilePath::getRandomTempPath().getPathTo("benchmark project");
+            mProject.reset(Project::create(mProjectDir.getPathTo("benchmark.lpp")));
+            Circuit& circuit = mProject->getCircuit();
+            NetClass* netclass = new NetClass(circuit, "default");
+            circuit.addNetClass(*netclass);
+            NetSignal* netsignal = new NetSignal(circuit, *netclass, "trace", false);
+            circuit.addNetSignal(*netsignal);
+
+            mBoard = mProject->createBoard("benchmark");
+            mProject->addBoard(*mBoard);
+            GraphicsLayer* layer = mBoard->getLayerStack().getLayer(GraphicsLayer::sTopCopper);
+            mBoard->beginBulkUpdate();
+            for (int y = 0; y < sGridSize; ++y) {
+                BI_NetPoint* previous = nullptr;
+                for (int x = 0; x < sGridSize; ++x) {
+                    mBoard->addVia(*new BI_Via(*mBoard, gridPosition(x, y), BI_Via::Shape::Round,
+                                               Length(600000), Length(300000), nullptr));
+                    BI_NetPoint* netpoint = new BI_NetPoint(*mBoard, *layer, *netsignal,
+                        gridPosition(x, y) + Point(500000, 500000));
+                    mBoard->addNetPoint(*netpoint);
+                    if (previous) {
+                        mBoard->addNetLine(*new BI_NetLine(*mBoard, *previous, *netpoint,
+                                                           Length(200000)));
+                    }
+                    previous = netpoint;
+                }
+            }
+            mBoard->endBulkUpdate();
+        }
+
+        virtual ~BoardBenchmark() {
+            mProject.reset();
+            QDir(mProjectDir.getParentDir().toStr()).removeRecursively();
+        }
+
+        static Point gridPosition(int x, int y) noexcept {
+            return Point(Length(x * 1000000), Length(y * 1000000));
+        }
+
+        /// Query positions which hit vias, netpoints, netlines and empty areas
+        static Point queryPosition(int i) noexcept {
+            int n = (i * 7919) % (sGridSize * sGridSize * 4);
+            return Point(Length((n % (sGridSize * 2)) * 500000),
+                         Length((n / (sGridSize * 2)) * 500000));
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardBenchmark, testItemsAtScenePos)
+{
+    measure("board_items_at_scene_pos", sQueries, [&](int i){
+        doNotOptimize(mBoard->getItemsAtScenePos(queryPosition(i)));
+    });
+}
+
+TEST_F(BoardBenchmark, testViasAtScenePos)
+{
+    measure("board_vias_at_scene_pos", sQueries, [&](int i){
+        doNotOptimize(mBoard->getViasAtScenePos(queryPosition(i), nullptr));
+    });
+}
+
+TEST_F(BoardBenchmark, testNetPointsAtScenePos)
+{
+    measure("board_netpoints_at_scene_pos", sQueries, [&](int i){
+        doNotOptimize(mBoard->getNetPointsAtScenePos(queryPosition(i), nullptr, nullptr));
+    });
+}
+
+TEST_F(BoardBenchmark, testNetLinesAtScenePos)
+{
+    measure("board_netlines_at_scene_pos", sQueries, [&](int i){
+        doNotOptimize(mBoard->getNetLinesAtScenePos(queryPosition(i), nullptr, nullptr));
+    });
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
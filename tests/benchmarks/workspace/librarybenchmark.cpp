@@ -0,0 +1,112 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/application.h>
+#include <librepcb/common/version.h>
+#include <librepcb/library/library.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include "../benchmark.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+using librepcb::tests::Benchmark;
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+/**
+ * @brief Benchmark of the workspace library scanner with a synthetic library
+ */
+class LibraryBenchmark : public Benchmark
+{
+    protected:
+        static const int sSymbols = 2000;
+
+        FilePath mWsDir;
+
+        LibraryBenchmark() {
+            mWsDir = FilePath::getRandomTempPath().getPathTo("benchmark workspace");
+            Workspace::createNewWorkspace(mWsDir);
+            FilePath libDir = mWsDir.getPathTo("v" % qApp->getFileFormatVersion().toStr())
+                              .getPathTo("libraries/local/benchmark.lplib");
+            library::Library lib(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                                 "Benchmark", "", "");
+            lib.saveTo(libDir);
+            FilePath symDir = library::Library::getElementsDirectory<library::Symbol>(libDir);
+            for (int i = 0; i < sSymbols; ++i) {
+                library::Symbol sym(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                                    QString("Symbol %1").arg(i), "", "benchmark");
+                sym.saveIntoParentDirectory(symDir);
+            }
+        }
+
+        virtual ~LibraryBenchmark() {
+            QDir(mWsDir.getParentDir().toStr()).removeRecursively();
+        }
+
+        /// Run a library rescan and wait until it has finished
+        static qint64 scan(Workspace& ws) {
+            QEventLoop loop;
+            QObject::connect(&ws.getLibraryDb(), &WorkspaceLibraryDb::scanSucceeded,
+                             &loop, &QEventLoop::quit);
+            QObject::connect(&ws.getLibraryDb(), &WorkspaceLibraryDb::scanFailed,
+                             &loop, &QEventLoop::quit);
+            QTimer timeout; // avoid hanging forever if the scan never finishes
+            timeout.setSingleShot(true);
+            QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+            timeout.start(600000);
+            QElapsedTimer timer;
+            timer.start();
+            ws.getLibraryDb().startLibraryRescan();
+            loop.exec();
+            return timer.nsecsElapsed();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(LibraryBenchmark, testScan)
+{
+    Workspace ws(mWsDir);
+    record("library_scan_2k_symbols_initial", scan(ws), 1);
+    record("library_scan_2k_symbols_unchanged", scan(ws), 1);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace workspace
+} // namespace librepcb
@@ -0,0 +1,91 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/units/angle.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(AngleTest, testSinCosOfMultiplesOf90deg)
+{
+    qreal sin, cos;
+    Angle::deg0().sinCos(sin, cos);
+    EXPECT_EQ(0.0, sin);
+    EXPECT_EQ(1.0, cos);
+    Angle::deg90().sinCos(sin, cos);
+    EXPECT_EQ(1.0, sin);
+    EXPECT_EQ(0.0, cos);
+    Angle::deg180().sinCos(sin, cos);
+    EXPECT_EQ(0.0, sin);
+    EXPECT_EQ(-1.0, cos);
+    Angle::deg270().sinCos(sin, cos);
+    EXPECT_EQ(-1.0, sin);
+    EXPECT_EQ(0.0, cos);
+    (-Angle::deg90()).sinCos(sin, cos);
+    EXPECT_EQ(-1.0, sin);
+    EXPECT_EQ(0.0, cos);
+}
+
+TEST(AngleTest, testSinCosOfMultiplesOf15deg)
+{
+    // the tabulated values must be symmetric in all quadrants
+    for (int deg = -345; deg < 360; deg += 15) {
+        qreal sin, cos;
+        Angle(deg * 1000000).sinCos(sin, cos);
+        EXPECT_NEAR(qSin(deg * M_PI / 180), sin, 1e-15) << deg;
+        EXPECT_NEAR(qCos(deg * M_PI / 180), cos, 1e-15) << deg;
+    }
+    qreal sin30, cos30, sin150, cos150;
+    Angle(30000000).sinCos(sin30, cos30);
+    Angle(150000000).sinCos(sin150, cos150);
+    EXPECT_EQ(0.5, sin30);
+    EXPECT_EQ(sin30, sin150);
+    EXPECT_EQ(cos30, -cos150);
+}
+
+TEST(AngleTest, testSinCosOfArbitraryAngles)
+{
+    for (qint32 microdeg = -359999999; microdeg < 360000000; microdeg += 12345677) {
+        Angle angle(microdeg);
+        qreal sin, cos;
+        angle.sinCos(sin, cos);
+        EXPECT_NEAR(qSin(angle.toRad()), sin, 1e-14) << microdeg;
+        EXPECT_NEAR(qCos(angle.toRad()), cos, 1e-14) << microdeg;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
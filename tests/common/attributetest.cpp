@@ -0,0 +1,96 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/attributes/attribute.h>
+#include <librepcb/common/attributes/attributetype.h>
+#include <librepcb/common/attributes/attributeunit.h>
+#include <librepcb/common/attributes/attrtypecapacitance.h>
+#include <librepcb/common/attributes/attrtyperesistance.h>
+#include <librepcb/common/attributes/attrtypestring.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class AttributeTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(AttributeTest, testTypeFromString)
+{
+    EXPECT_EQ(&AttrTypeResistance::instance(), &AttributeType::fromString("resistance"));
+    EXPECT_EQ(&AttrTypeString::instance(), &AttributeType::fromString("string"));
+    EXPECT_THROW(AttributeType::fromString("foo"), RuntimeError);
+}
+
+TEST(AttributeTest, testUnitFromString)
+{
+    const AttributeType& type = AttrTypeCapacitance::instance();
+    const AttributeUnit* unit = type.getUnitFromString("nanofarad");
+    ASSERT_NE(nullptr, unit);
+    EXPECT_EQ(QString("nanofarad"), unit->getName());
+    EXPECT_EQ(type.getDefaultUnit(), type.getUnitFromString("microfarad"));
+    EXPECT_THROW(type.getUnitFromString("ohm"), RuntimeError);
+    EXPECT_EQ(nullptr, AttrTypeString::instance().getUnitFromString(""));
+}
+
+TEST(AttributeTest, testSiValue)
+{
+    const AttributeType& type = AttrTypeResistance::instance();
+    Attribute a("R", type, "4.7", type.getUnitFromString("kiloohm"));
+    Attribute b("R", type, "10000", type.getUnitFromString("ohm"));
+    EXPECT_DOUBLE_EQ(4700, a.getSiValue());
+    EXPECT_DOUBLE_EQ(10000, b.getSiValue());
+    EXPECT_LT(a.getSiValue(), b.getSiValue());
+
+    b.setTypeValueUnit(type, "0.5", type.getUnitFromString("megaohm"));
+    EXPECT_DOUBLE_EQ(500000, b.getSiValue());
+    EXPECT_DOUBLE_EQ(500000, Attribute(b).getSiValue());
+}
+
+TEST(AttributeTest, testSiValueOfNonNumericValues)
+{
+    const AttributeType& type = AttrTypeResistance::instance();
+    EXPECT_TRUE(qIsNaN(Attribute("R", type, "", type.getDefaultUnit()).getSiValue()));
+    EXPECT_TRUE(qIsNaN(Attribute("S", AttrTypeString::instance(), "42",
+                                 nullptr).getSiValue()));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
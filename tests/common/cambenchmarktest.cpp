@@ -0,0 +1,146 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <QtCore>
+#include <functional>
+#include <iostream>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/cam/excellongenerator.h>
+#include <librepcb/common/geometry/polygon.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+/**
+ * @brief Timing benchmark of the CAM export
+ *
+ * The tests are disabled by default because they take some time and don't check
+ * anything. Run them with:
+ *
+ *     tests --gtest_also_run_disabled_tests --gtest_filter=CamBenchmarkTest.*
+ *
+ * The durations are printed and also recorded as properties in the XML report (see
+ * "--gtest_output=xml"), so they can be compared between builds.
+ */
+class CamBenchmarkTest : public ::testing::Test
+{
+    protected:
+        static const int sPrimitives = 100000;
+
+        template <typename Fun>
+        static void measure(const std::string& name, Fun fun)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            qint64 size = fun();
+            qint64 ms = timer.elapsed();
+            std::cout << name << ": " << ms << " ms, " << size << " bytes" << std::endl;
+            ::testing::Test::RecordProperty(name + "_ms", static_cast<int>(ms));
+        }
+
+        static qint64 exportGerber(const std::function<void(GerberGenerator&, int)>& draw)
+        {
+            GerberGenerator gen("Benchmark", Uuid::createRandom(), "v1");
+            for (int i = 0; i < sPrimitives; ++i) {
+                draw(gen, i);
+            }
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            gen.generate(buffer);
+            return buffer.size();
+        }
+
+        static Point gridPosition(int i) noexcept
+        {
+            return Point(Length((i % 1000) * 100000), Length((i / 1000) * 100000));
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(CamBenchmarkTest, DISABLED_testCopperLayer)
+{
+    measure("copper", [](){
+        return exportGerber([](GerberGenerator& gen, int i){
+            Point pos = gridPosition(i);
+            gen.drawLine(pos, pos + Point(100000, 50000), 150000 + (i % 8) * 50000);
+        });
+    });
+}
+
+TEST_F(CamBenchmarkTest, DISABLED_testPadLayer)
+{
+    measure("pads", [](){
+        return exportGerber([](GerberGenerator& gen, int i){
+            Angle rot = Angle::deg45() * (i % 8);
+            gen.flashRect(gridPosition(i), Length(800000), Length(400000), rot, Length(0));
+        });
+    });
+}
+
+TEST_F(CamBenchmarkTest, DISABLED_testOutlineLayer)
+{
+    measure("outlines", [](){
+        return exportGerber([](GerberGenerator& gen, int i){
+            Point pos = gridPosition(i);
+            Polygon polygon("brd_outlines", Length(200000), false, false, pos);
+            polygon.getSegments().append(std::make_shared<PolygonSegment>(
+                pos + Point(80000, 0), Angle::deg0()));
+            polygon.getSegments().append(std::make_shared<PolygonSegment>(
+                pos + Point(80000, 80000), Angle::deg90()));
+            polygon.getSegments().append(std::make_shared<PolygonSegment>(
+                pos, Angle::deg0()));
+            gen.drawPolygonOutline(polygon);
+        });
+    });
+}
+
+TEST_F(CamBenchmarkTest, DISABLED_testDrills)
+{
+    measure("drills", [](){
+        ExcellonGenerator gen;
+        gen.setHitOrder(ExcellonGenerator::HitOrder::NearestNeighbour);
+        for (int i = 0; i < sPrimitives; ++i) {
+            gen.drill(gridPosition((i * 7919) % sPrimitives), 300000 + (i % 5) * 100000);
+        }
+        gen.generate();
+        return static_cast<qint64>(gen.toStr().size());
+    });
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,210 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <QtCore>
+#include <librepcb/common/cam/camimagecomparator.h>
+#include <librepcb/common/cam/excellonreader.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/cam/gerberreader.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/jobscheduler.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class CamImageComparatorTest : public ::testing::Test
+{
+    protected:
+        JobScheduler mScheduler;
+
+        static CamImage readGenerated(GerberGenerator& gen)
+        {
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            gen.generate(buffer);
+            return GerberReader::read(buffer.data());
+        }
+
+        static CamImage readGerber(const QByteArray& content)
+        {
+            return GerberReader::read("%FSLAX66Y66*%\n%MOMM*%\n" + content + "M02*\n");
+        }
+
+        CamImageComparator::Result compare(const CamImage& a, const CamImage& b)
+        {
+            return CamImageComparator::compare(a, b, CamImageComparator::Options(), mScheduler);
+        }
+
+        static void drawPad(GerberGenerator& gen)
+        {
+            gen.flashObround(Point(3000000, 1000000), Length(2000000), Length(1000000),
+                             Angle::deg45(), Length(300000));
+        }
+
+        static void drawTrace(GerberGenerator& gen)
+        {
+            gen.drawLine(Point(0, 0), Point(5000000, 2000000), Length(250000));
+        }
+
+        static void drawArea(GerberGenerator& gen)
+        {
+            Polygon area("top_cu", Length(0), true, false, Point(-2000000, 0));
+            area.getSegments().append(std::make_shared<PolygonSegment>(
+                Point(-1000000, 0), Angle::deg180()));
+            area.getSegments().append(std::make_shared<PolygonSegment>(
+                Point(-2000000, 0), Angle::deg0()));
+            gen.drawPolygonArea(area);
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(CamImageComparatorTest, testReadGeneratedGerber)
+{
+    GerberGenerator gen("Project", Uuid::createRandom(), "v1");
+    drawTrace(gen);
+    drawArea(gen);
+    CamImage image = readGenerated(gen);
+    ASSERT_EQ(2, image.getObjects().count());
+    EXPECT_GT(image.getObjects().at(0).strokeWidth, 0);
+    EXPECT_EQ(0, image.getObjects().at(1).strokeWidth);
+    QRectF rect = image.getBoundingRect();
+    EXPECT_NEAR(-2000000, rect.left(), 1000);
+    EXPECT_NEAR(5125000, rect.right(), 1000);
+    EXPECT_NEAR(-500000, rect.top(), 1000); // the arc is the lower half of the circle
+    EXPECT_NEAR(2125000, rect.bottom(), 1000);
+}
+
+TEST_F(CamImageComparatorTest, testDifferentOrderIsEqual)
+{
+    GerberGenerator gen1("Project", Uuid::createRandom(), "v1");
+    drawTrace(gen1);
+    drawPad(gen1);
+    drawArea(gen1);
+    GerberGenerator gen2("Project", Uuid::createRandom(), "v2");
+    drawArea(gen2);
+    drawPad(gen2);
+    drawTrace(gen2);
+    CamImageComparator::Result result = compare(readGenerated(gen1), readGenerated(gen2));
+    EXPECT_TRUE(result.isEqual());
+    EXPECT_GT(result.pixels, 0);
+}
+
+TEST_F(CamImageComparatorTest, testMissingObjectIsDetected)
+{
+    GerberGenerator gen1("Project", Uuid::createRandom(), "v1");
+    drawTrace(gen1);
+    drawPad(gen1);
+    GerberGenerator gen2("Project", Uuid::createRandom(), "v1");
+    drawTrace(gen2);
+    CamImageComparator::Result result = compare(readGenerated(gen1), readGenerated(gen2));
+    EXPECT_FALSE(result.isEqual());
+    ASSERT_GE(result.differences.count(), 1);
+    QRectF rect;
+    foreach (const CamImageComparator::Difference& difference, result.differences) {
+        rect = rect.isNull() ? difference.rect : rect.united(difference.rect);
+    }
+    EXPECT_TRUE(rect.contains(QPointF(3600000, 1600000))); // outer end of the obround
+    EXPECT_FALSE(rect.contains(QPointF(500000, 200000)));   // the trace
+}
+
+TEST_F(CamImageComparatorTest, testToleranceOfShiftedObjects)
+{
+    CamImage image = readGerber("%ADD10C,1.0*%\nD10*\nX0Y0D03*\n");
+    CamImage smallShift = readGerber("%ADD10C,1.0*%\nD10*\nX10000Y0D03*\n");
+    CamImage largeShift = readGerber("%ADD10C,1.0*%\nD10*\nX200000Y0D03*\n");
+    EXPECT_TRUE(compare(image, smallShift).isEqual());
+    EXPECT_FALSE(compare(image, largeShift).isEqual());
+}
+
+TEST_F(CamImageComparatorTest, testEquivalentApertures)
+{
+    // a rotated rectangle macro and a standard rectangle with swapped dimensions
+    CamImage macro = readGerber("%AMROTATEDRECT*21,1,$1,$2,0,0,$3*%\n"
+                                "%ADD10ROTATEDRECT,2.0X1.0X90.0*%\nD10*\nX0Y0D03*\n");
+    CamImage rect = readGerber("%ADD11R,1.0X2.0*%\nD11*\nX0Y0D03*\n");
+    EXPECT_TRUE(compare(macro, rect).isEqual());
+
+    // a region with the same outline
+    CamImage region = readGerber("G36*\nX-500000Y-1000000D02*\nX500000Y-1000000D01*\n"
+                                 "X500000Y1000000D01*\nX-500000Y1000000D01*\n"
+                                 "X-500000Y-1000000D01*\nG37*\n");
+    EXPECT_TRUE(compare(rect, region).isEqual());
+}
+
+TEST_F(CamImageComparatorTest, testClearPolarity)
+{
+    CamImage solid = readGerber("%ADD10R,2.0X2.0*%\nD10*\nX0Y0D03*\n");
+    CamImage cleared = readGerber("%ADD10R,2.0X2.0*%\n%ADD11C,1.0*%\nD10*\nX0Y0D03*\n"
+                                  "%LPC*%\nD11*\nX0Y0D03*\n");
+    CamImageComparator::Result result = compare(solid, cleared);
+    EXPECT_FALSE(result.isEqual());
+    ASSERT_EQ(1, result.differences.count());
+    EXPECT_TRUE(result.differences.first().rect.contains(QPointF(0, 0)));
+}
+
+TEST_F(CamImageComparatorTest, testStepAndRepeat)
+{
+    CamImage panel = readGerber("%ADD10C,1.0*%\n%SRX2Y1I5.0J0*%\nD10*\nX0Y0D03*\n%SR*%\n");
+    CamImage copies = readGerber("%ADD10C,1.0*%\nD10*\nX0Y0D03*\nX5000000Y0D03*\n");
+    EXPECT_EQ(2, panel.getObjects().count());
+    EXPECT_TRUE(compare(panel, copies).isEqual());
+}
+
+TEST_F(CamImageComparatorTest, testReadExcellon)
+{
+    CamImage image = ExcellonReader::read(
+        "M48\n;DRILL FILE\nFMAT,2\nMETRIC,TZ\nT1C0.800\nT2C1.000\n%\nG90\nG05\nM71\n"
+        "T1\nX1.000000Y2.000000\nX-1.000000Y2.000000\n"
+        "T2\nX0.000000Y0.000000G85X3.000000Y0.000000\nT0\nM30\n");
+    ASSERT_EQ(3, image.getObjects().count());
+    QRectF rect = image.getBoundingRect();
+    EXPECT_NEAR(-1400000, rect.left(), 1000);
+    EXPECT_NEAR(3500000, rect.right(), 1000);
+    EXPECT_NEAR(-500000, rect.top(), 1000);
+    EXPECT_NEAR(2400000, rect.bottom(), 1000);
+}
+
+TEST_F(CamImageComparatorTest, testInvalidGerber)
+{
+    EXPECT_THROW(GerberReader::read("%ADD10C,1.0*%\nD10*\nX0Y0D03*\nM02*\n"), RuntimeError);
+    EXPECT_THROW(readGerber("D10*\nX0Y0D03*\n"), RuntimeError);
+    EXPECT_THROW(readGerber("%LMX*%\n"), RuntimeError);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,198 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <QtCore>
+#include <librepcb/common/cam/camimagewriter.h>
+#include <librepcb/common/cam/gerberreader.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/jobscheduler.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class CamImageWriterTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("CamImageWriterTest");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+            mFilePath = mTempDir.getPathTo("image.tiff");
+            mOptions.pixelsPerMm = 10;
+            mOptions.antialiasing = false;
+        }
+
+        virtual void TearDown() override
+        {
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        static CamImage readGerber(const QByteArray& content)
+        {
+            return GerberReader::read("%FSLAX66Y66*%\n%MOMM*%\n" + content + "M02*\n");
+        }
+
+        /// Decode the TIFF files written by CamImageWriter (not a general TIFF reader!)
+        static QImage readTiff(const FilePath& filepath, QHash<quint16, QVector<quint32>>& tags)
+        {
+            QByteArray content = FileUtils::readFile(filepath); // can throw
+            if (!content.startsWith(QByteArray("II\x2A\x00", 4))) return QImage();
+            const uchar* data = reinterpret_cast<const uchar*>(content.constData());
+            const uchar* ifd = data + qFromLittleEndian<quint32>(data + 4);
+            for (int i = 0; i < qFromLittleEndian<quint16>(ifd); ++i) {
+                const uchar* entry = ifd + 2 + i * 12;
+                quint16 tag = qFromLittleEndian<quint16>(entry);
+                quint16 type = qFromLittleEndian<quint16>(entry + 2);
+                quint32 count = qFromLittleEndian<quint32>(entry + 4);
+                int size = (type == 3) ? 2 : ((type == 5) ? 8 : 4);
+                const uchar* values = (count * size <= 4) ? (entry + 8)
+                    : (data + qFromLittleEndian<quint32>(entry + 8));
+                QVector<quint32> list;
+                for (quint32 k = 0; k < count * ((type == 5) ? 2 : 1); ++k) {
+                    list.append((size == 2) ? qFromLittleEndian<quint16>(values + 2 * k)
+                                            : qFromLittleEndian<quint32>(values + 4 * k));
+                }
+                tags.insert(tag, list);
+            }
+
+            int width = tags.value(256).value(0);
+            int height = tags.value(257).value(0);
+            int rows = tags.value(278).value(0);
+            QVector<quint32> offsets = tags.value(273);
+            QVector<quint32> byteCounts = tags.value(279);
+            if ((width < 1) || (height < 1) || (rows < 1) || offsets.isEmpty() ||
+                (offsets.count() != byteCounts.count()))
+            {
+                return QImage();
+            }
+            QImage image(width, height, QImage::Format_RGB32);
+            for (int strip = 0; strip < offsets.count(); ++strip) {
+                int y0 = strip * rows;
+                int stripRows = qMin(rows, height - y0);
+                QByteArray size(4, 0);
+                qToBigEndian(quint32(width * stripRows * 3), reinterpret_cast<uchar*>(size.data()));
+                QByteArray raw = qUncompress(size + content.mid(offsets.at(strip),
+                                                                byteCounts.at(strip)));
+                if (raw.size() != width * stripRows * 3) return QImage();
+                for (int y = 0; y < stripRows; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        const char* p = raw.constData() + (y * width + x) * 3;
+                        image.setPixel(x, y0 + y, qRgb(uchar(p[0]), uchar(p[1]), uchar(p[2])));
+                    }
+                }
+            }
+            return image;
+        }
+
+        JobScheduler mScheduler;
+        CamImageWriter::Options mOptions;
+        FilePath mTempDir;
+        FilePath mFilePath;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(CamImageWriterTest, testImageSize)
+{
+    QSize size = CamImageWriter::calcImageSize(QRectF(0, 0, 10000000, 5050000), 10);
+    EXPECT_EQ(QSize(100, 51), size);
+    EXPECT_EQ(QSize(1, 1), CamImageWriter::calcImageSize(QRectF(), 10));
+}
+
+TEST_F(CamImageWriterTest, testWriteStrips)
+{
+    // a square in the lower left quarter of a 100x100 pixels image
+    QVector<CamImageWriter::Layer> layers;
+    layers.append(CamImageWriter::Layer{readGerber("%ADD10R,5.0X5.0*%\nD10*\nX2500000Y2500000D03*\n"),
+                                        QColor(Qt::red)});
+    mOptions.stripHeight = 16;
+    mOptions.maxPendingStrips = 2;
+    CamImageWriter::writeTiff(layers, QRectF(0, 0, 10000000, 10000000), mOptions, mFilePath,
+                              mScheduler);
+
+    QHash<quint16, QVector<quint32>> tags;
+    QImage image = readTiff(mFilePath, tags);
+    ASSERT_FALSE(image.isNull());
+    EXPECT_EQ(QSize(100, 100), image.size());
+    EXPECT_EQ(QVector<quint32>({8, 8, 8}), tags.value(258));
+    EXPECT_EQ(QVector<quint32>({8}), tags.value(259));
+    EXPECT_EQ(QVector<quint32>({100000, 1000}), tags.value(282)); // 100 pixels per cm
+    EXPECT_EQ(7, tags.value(273).count());
+    EXPECT_EQ(qRgb(255, 0, 0), image.pixel(10, 90));
+    EXPECT_EQ(qRgb(255, 0, 0), image.pixel(45, 55));
+    EXPECT_EQ(qRgb(255, 255, 255), image.pixel(55, 45));
+    EXPECT_EQ(qRgb(255, 255, 255), image.pixel(90, 10));
+}
+
+TEST_F(CamImageWriterTest, testLayersAndClearObjects)
+{
+    // a square with a clear hole, covered by a transparent layer and the background
+    QVector<CamImageWriter::Layer> layers;
+    layers.append(CamImageWriter::Layer{readGerber("%ADD10R,8.0X8.0*%\n%ADD11C,2.0*%\n"
+        "D10*\nX5000000Y5000000D03*\n%LPC*%\nD11*\nX5000000Y5000000D03*\n"), QColor(Qt::blue)});
+    layers.append(CamImageWriter::Layer{readGerber("%ADD10R,10.0X2.0*%\nD10*\n"
+        "X5000000Y1000000D03*\n"), QColor(255, 0, 0, 128)});
+    mOptions.background = Qt::black;
+    mOptions.stripHeight = 1000; // only one strip
+    CamImageWriter::writeTiff(layers, QRectF(0, 0, 10000000, 10000000), mOptions, mFilePath,
+                              mScheduler);
+
+    QHash<quint16, QVector<quint32>> tags;
+    QImage image = readTiff(mFilePath, tags);
+    ASSERT_FALSE(image.isNull());
+    EXPECT_EQ(1, tags.value(273).count());
+    EXPECT_EQ(qRgb(0, 0, 255), image.pixel(20, 50));   // square
+    EXPECT_EQ(qRgb(0, 0, 0), image.pixel(50, 50));     // hole
+    EXPECT_EQ(qRgb(0, 0, 0), image.pixel(5, 50));      // outside
+    EXPECT_EQ(qRgb(128, 0, 0), image.pixel(5, 95));    // transparent over background
+    EXPECT_EQ(qRgb(128, 0, 127), image.pixel(50, 85)); // transparent over square
+}
+
+TEST_F(CamImageWriterTest, testInvalidPath)
+{
+    FileUtils::makePath(mTempDir);
+    FileUtils::writeFile(mTempDir.getPathTo("file"), "content");
+    EXPECT_THROW(CamImageWriter::writeTiff({}, QRectF(0, 0, 1000000, 1000000), mOptions,
+                                           mTempDir.getPathTo("file/image.tiff"), mScheduler),
+                 RuntimeError);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,72 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/camnumberformatter.h>
+#include <librepcb/common/units/length.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class CamNumberFormatterTest : public ::testing::Test
+{
+    protected:
+        QList<LengthBase_t> mValues = {0, 1, -1, 999999, -999999, 1000000, -1500,
+                                       123456789, -987654321, 2147483647};
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(CamNumberFormatterTest, testIntegerIsEqualToNmString)
+{
+    foreach (LengthBase_t nm, mValues) {
+        char buffer[CamNumberFormatter::sMaxIntegerLength];
+        char* end = CamNumberFormatter::writeInteger(buffer, nm);
+        EXPECT_EQ(Length(nm).toNmString().toStdString(), std::string(buffer, end - buffer));
+    }
+}
+
+TEST_F(CamNumberFormatterTest, testFixedPointIsEqualToMmString)
+{
+    foreach (LengthBase_t nm, mValues) {
+        char buffer[CamNumberFormatter::sMaxFixedPointLength];
+        char* end = CamNumberFormatter::writeFixedPoint(buffer, nm, 6);
+        EXPECT_EQ(Length(nm).toMmString().toStdString(), std::string(buffer, end - buffer));
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,104 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/geometry/compactpolygonlist.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+class CompactPolygonListTest : public ::testing::Test
+{
+    protected:
+        static PolygonList createPolygons() noexcept {
+            PolygonList polygons;
+            polygons.append(std::shared_ptr<Polygon>(Polygon::createRect(
+                "top_placement", Length(200000), false, true, Point(-1000000, -500000),
+                Length(2000000), Length(1000000))));
+            polygons.append(std::shared_ptr<Polygon>(Polygon::createCurve(
+                "top_documentation", Length(100000), false, false, Point(0, 0),
+                Point(1000000, 0), Angle::deg90())));
+            polygons.append(std::shared_ptr<Polygon>(Polygon::createLine(
+                "top_placement", Length(0), true, false, Point(-12345, 678),
+                Point(9876, -54321))));
+            return polygons;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(CompactPolygonListTest, testRoundTrip)
+{
+    PolygonList polygons = createPolygons();
+    CompactPolygonList compact(polygons);
+    ASSERT_EQ(3, compact.count());
+    EXPECT_EQ(QString("top_documentation"), compact.getLayerName(1));
+    EXPECT_EQ(Length(100000), compact.getLineWidth(1));
+    EXPECT_TRUE(compact.isGrabArea(0));
+    EXPECT_TRUE(compact.isFilled(2));
+    EXPECT_EQ(polygons.value(0)->getSegments().count() + 1, compact.getVertexCount(0));
+    EXPECT_EQ(Angle::deg90(), compact.getAngle(1, 1));
+    EXPECT_EQ(polygons, compact.toPolygonList());
+    EXPECT_EQ(compact, CompactPolygonList(compact.toPolygonList()));
+}
+
+TEST_F(CompactPolygonListTest, testPainterPath)
+{
+    PolygonList polygons = createPolygons();
+    CompactPolygonList compact(polygons);
+    for (int i = 0; i < polygons.count(); ++i) {
+        EXPECT_EQ(polygons.value(i)->toQPainterPathPx(), compact.toQPainterPathPx(i));
+    }
+}
+
+TEST_F(CompactPolygonListTest, testMemoryUsage)
+{
+    CompactPolygonList compact(createPolygons());
+    qint64 full = 0;
+    for (const Polygon& polygon : createPolygons()) {
+        full += sizeof(Polygon) + polygon.getSegments().count() * sizeof(PolygonSegment);
+    }
+    EXPECT_LT(compact.getMemoryUsage(), full);
+}
+
+TEST_F(CompactPolygonListTest, testTooLargeCoordinate)
+{
+    PolygonList polygons;
+    polygons.append(std::shared_ptr<Polygon>(Polygon::createLine(
+        "top_placement", Length(0), false, false, Point(0, 0), Point(Q_INT64_C(5000000000), 0))));
+    EXPECT_THROW(CompactPolygonList{polygons}, RangeError);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,105 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/debugtrace.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class DebugTraceTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("DebugTraceTest");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+            mTraceFile = mTempDir.getPathTo("trace.json");
+        }
+
+        virtual void TearDown() override
+        {
+            DebugTrace::instance().setOutputFilePath(FilePath());
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        FilePath mTempDir;
+        FilePath mTraceFile;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(DebugTraceTest, testWritesValidTraceEventJson)
+{
+    DebugTrace& trace = DebugTrace::instance();
+    trace.setOutputFilePath(mTraceFile);
+    ASSERT_TRUE(trace.isEnabled());
+    {
+        DebugTrace::Scope scope("outer");
+        LIBREPCB_TRACE_COUNTER("counter", 42);
+    }
+    trace.setOutputFilePath(FilePath());
+    EXPECT_FALSE(trace.isEnabled());
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(FileUtils::readFile(mTraceFile), &error);
+    ASSERT_EQ(QJsonParseError::NoError, error.error) << qPrintable(error.errorString());
+    ASSERT_TRUE(doc.isArray());
+    QMap<QString, QJsonObject> events;
+    foreach (const QJsonValue& value, doc.array()) {
+        QJsonObject event = value.toObject();
+        events.insert(event.value("ph").toString(), event);
+    }
+    EXPECT_EQ(QString("thread_name"), events.value("M").value("name").toString());
+    EXPECT_EQ(QString("outer"), events.value("X").value("name").toString());
+    EXPECT_GE(events.value("X").value("dur").toDouble(), 0.0);
+    EXPECT_EQ(QString("counter"), events.value("C").value("name").toString());
+    EXPECT_EQ(42, events.value("C").value("args").toObject().value("value").toInt());
+}
+
+TEST_F(DebugTraceTest, testDisabledScopeWritesNothing)
+{
+    { DebugTrace::Scope scope("not recorded"); }
+    EXPECT_FALSE(mTraceFile.isExistingFile());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -305,6 +305,42 @@ TEST_F(DirectoryLockTest, testStaleLock)
 }
 #endif
 
+TEST_F(DirectoryLockTest, testLockOfOtherHostWithoutHeartbeatIsStale)
+{
+    // get the lock
+    DirectoryLock lock(mTempDir);
+    lock.lock();
+
+    // pretend that the lock was created by another computer
+    QStringList lines = QString(FileUtils::readFile(mTempLockFilePath)).split('\n');
+    lines[2] = "ghost-" % SystemInfo::getHostname();
+    FileUtils::writeFile(mTempLockFilePath, lines.join('\n').toUtf8());
+    EXPECT_EQ(DirectoryLock::LockStatus::Locked, lock.getStatus());
+
+    // without a heartbeat for a long time, the lock is stale
+    QDateTime outdated = QDateTime::currentDateTimeUtc().addMSecs(
+        -DirectoryLock::sStaleLockTimeout - 60000);
+    lines[5] = outdated.toString(Qt::ISODate);
+    FileUtils::writeFile(mTempLockFilePath, lines.join('\n').toUtf8());
+    EXPECT_EQ(DirectoryLock::LockStatus::StaleLock, lock.getStatus());
+}
+
+TEST_F(DirectoryLockTest, testStatusLockUnlockWithTimeout)
+{
+    DirectoryLock lock(mTempDir);
+    EXPECT_EQ(DirectoryLock::LockStatus::Unlocked, lock.getStatus(5000));
+    lock.lock(5000);
+    EXPECT_EQ(DirectoryLock::LockStatus::Locked, lock.getStatus(5000));
+    EXPECT_TRUE(mTempLockFilePath.isExistingFile());
+    lock.unlock();
+    EXPECT_FALSE(mTempLockFilePath.isExistingFile());
+
+    // errors of the worker thread are rethrown
+    DirectoryLock ghostLock(mTempDir.getPathTo("ghost"));
+    EXPECT_THROW(ghostLock.getStatus(5000), Exception);
+    EXPECT_THROW(ghostLock.lock(5000), Exception);
+}
+
 TEST_F(DirectoryLockTest, testLockFileContent)
 {
     // get the lock
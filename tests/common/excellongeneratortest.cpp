@@ -0,0 +1,145 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <QtCore>
+#include <librepcb/common/cam/excellongenerator.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ExcellonGeneratorTest : public ::testing::Test
+{
+    protected:
+        /// Remove all lines which depend on the creation time or the application version
+        static std::string removeVolatileLines(const QString& data)
+        {
+            QStringList lines = data.split('\n');
+            for (int i = lines.count() - 1; i >= 0; --i) {
+                if (lines.at(i).startsWith(";Generated by") ||
+                    lines.at(i).startsWith(";Creation Date:")) {
+                    lines.removeAt(i);
+                }
+            }
+            return lines.join('\n').toStdString();
+        }
+
+        static void addHits(ExcellonGenerator& gen)
+        {
+            gen.drill(Point(1000000, 2000000), Length(800000));
+            gen.drill(Point(0, 0), Length(800000));
+            gen.drill(Point(500000, 500000), Length(3000000), false);
+            gen.slot(Point(0, 0), Point(2000000, 0), Length(1000000));
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ExcellonGeneratorTest, testGoldenOutput)
+{
+    ExcellonGenerator gen;
+    addHits(gen);
+    gen.generate();
+
+    EXPECT_EQ(std::string(
+        "M48\n"
+        ";DRILL FILE\n"
+        "FMAT,2\n"
+        "METRIC,TZ\n"
+        ";TYPE=PLATED\n"
+        "T1C0.800000\n"
+        "T2C1.000000\n"
+        ";TYPE=NON_PLATED\n"
+        "T3C3.000000\n"
+        "%\n"
+        "G90\n"
+        "G05\n"
+        "M71\n"
+        "T1\n"
+        "X1.000000Y2.000000\n"
+        "X0.000000Y0.000000\n"
+        "T2\n"
+        "X0.000000Y0.000000G85X2.000000Y0.000000\n"
+        "T3\n"
+        "X0.500000Y0.500000\n"
+        "T0\n"
+        "M30\n"), removeVolatileLines(gen.toStr()));
+}
+
+TEST_F(ExcellonGeneratorTest, testGoldenOutputOfNonPlatedHoles)
+{
+    ExcellonGenerator gen;
+    addHits(gen);
+    gen.generate(ExcellonGenerator::Plating::NonPlated);
+
+    EXPECT_EQ(std::string(
+        "M48\n"
+        ";DRILL FILE\n"
+        "FMAT,2\n"
+        "METRIC,TZ\n"
+        ";TYPE=NON_PLATED\n"
+        "T1C3.000000\n"
+        "%\n"
+        "G90\n"
+        "G05\n"
+        "M71\n"
+        "T1\n"
+        "X0.500000Y0.500000\n"
+        "T0\n"
+        "M30\n"), removeVolatileLines(gen.toStr()));
+}
+
+TEST_F(ExcellonGeneratorTest, testStreamOutputIsEqualToStringOutput)
+{
+    ExcellonGenerator gen;
+    gen.setHitOrder(ExcellonGenerator::HitOrder::NearestNeighbour);
+    for (int i = 0; i < 10000; ++i) {
+        gen.drill(Point((i * 7919) % 100000000, (i * 104729) % 100000000),
+                  Length(300000 + (i % 5) * 100000), (i % 7) != 0);
+    }
+    gen.generate();
+    QString streamed;
+    QTextStream stream(&streamed);
+    gen.generate(stream);
+
+    EXPECT_EQ(removeVolatileLines(gen.toStr()), removeVolatileLines(streamed));
+    // 10 tool definitions, 10 tool selections, "T0" and all the hits
+    QRegularExpression re("^[XT]\\d", QRegularExpression::MultilineOption);
+    EXPECT_EQ(10 + 10 + 1 + 10000, gen.toStr().count(re));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
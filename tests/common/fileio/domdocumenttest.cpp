@@ -0,0 +1,154 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/domdocument.h>
+#include <librepcb/common/fileio/domelement.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class DomDocumentTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(DomDocumentTest, testParseTree)
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                     "<root version=\"1\">\n"
+                     " <child name=\"a\">foo &amp; bar</child>\n"
+                     " <child name=\"b\"> </child>\n"
+                     " <parent>\n"
+                     "  <leaf/>\n"
+                     " </parent>\n"
+                     "</root>\n";
+    DomDocument doc(xml, FilePath());
+    DomElement& root = doc.getRoot("root");
+    EXPECT_EQ(&doc, root.getDocument(true));
+    EXPECT_EQ(QString("1"), root.getAttribute<QString>("version", true));
+    ASSERT_EQ(3, root.getChilds().count());
+    ASSERT_EQ(2, root.getChilds("child").count());
+    EXPECT_EQ(QString("a"), root.getChilds("child").at(0)->getAttribute<QString>("name", true));
+    EXPECT_EQ(QString("foo & bar"), root.getChilds("child").at(0)->getText<QString>(true));
+    EXPECT_EQ(QString(), root.getChilds("child").at(1)->getText<QString>(false));
+    DomElement* leaf = root.getFirstChild("parent/leaf", true, true);
+    EXPECT_EQ(&doc, leaf->getDocument(true));
+    EXPECT_FALSE(leaf->hasChilds());
+}
+
+TEST_F(DomDocumentTest, testRoundTrip)
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                     "<root a=\"1\">\n"
+                     " <text>hello</text>\n"
+                     " <empty/>\n"
+                     "</root>\n";
+    DomDocument doc(xml, FilePath());
+    EXPECT_EQ(xml.trimmed(), doc.toByteArray().trimmed());
+}
+
+TEST_F(DomDocumentTest, testParseFromDevice)
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                     "<root a=\"1\">\n"
+                     " <text>hello</text>\n"
+                     "</root>\n";
+    QBuffer buffer(&xml);
+    buffer.open(QIODevice::ReadOnly);
+    DomDocument doc(buffer, FilePath());
+    EXPECT_EQ(xml.trimmed(), doc.toByteArray().trimmed());
+
+    QByteArray invalid = "<root><child></root>";
+    QBuffer invalidBuffer(&invalid);
+    invalidBuffer.open(QIODevice::ReadOnly);
+    EXPECT_THROW(DomDocument(invalidBuffer, FilePath()), Exception);
+}
+
+TEST_F(DomDocumentTest, testAttributesAreSortedAndUnique)
+{
+    DomDocument doc(*new DomElement("root"));
+    doc.getRoot().setAttribute("c", QString("3"));
+    doc.getRoot().setAttribute("a", QString("1"));
+    doc.getRoot().setAttribute("b", QString("2"));
+    doc.getRoot().setAttribute("a", QString("4"));
+    EXPECT_TRUE(doc.getRoot().hasAttribute("b"));
+    EXPECT_FALSE(doc.getRoot().hasAttribute("d"));
+    EXPECT_EQ(QString("4"), doc.getRoot().getAttribute<QString>("a", true));
+    EXPECT_TRUE(doc.toByteArray().contains("<root a=\"4\" b=\"2\" c=\"3\"/>"));
+}
+
+TEST_F(DomDocumentTest, testMalformedDocumentThrows)
+{
+    EXPECT_THROW(DomDocument("<root><child></root>", FilePath()), Exception);
+    EXPECT_THROW(DomDocument("<root/><second/>", FilePath()), Exception);
+}
+
+TEST_F(DomDocumentTest, testEmptyDocumentThrows)
+{
+    EXPECT_THROW(DomDocument("", FilePath()), Exception);
+}
+
+TEST_F(DomDocumentTest, testBinaryRoundTrip)
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+                     "<root a=\"1\" b=\"&amp;\">\n"
+                     " <child name=\"x\">hello</child>\n"
+                     " <child name=\"y\"/>\n"
+                     " <parent>\n"
+                     "  <child name=\"z\">world</child>\n"
+                     " </parent>\n"
+                     "</root>\n";
+    DomDocument doc(xml, FilePath());
+    std::unique_ptr<DomDocument> copy = DomDocument::fromBinary(doc.toBinary(), FilePath());
+    EXPECT_EQ(doc.toByteArray(), copy->toByteArray());
+    EXPECT_EQ(copy.get(), copy->getRoot().getDocument(true));
+    EXPECT_EQ(QString(), copy->getRoot().getChilds("child").at(1)->getText<QString>(false));
+}
+
+TEST_F(DomDocumentTest, testInvalidBinaryDataThrows)
+{
+    DomDocument doc(*new DomElement("root", "text"));
+    QByteArray data = doc.toBinary();
+    EXPECT_THROW(DomDocument::fromBinary(QByteArray(), FilePath()), Exception);
+    EXPECT_THROW(DomDocument::fromBinary(data.left(data.size() - 1), FilePath()), Exception);
+    EXPECT_THROW(DomDocument::fromBinary(data + "x", FilePath()), Exception);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,126 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/filewritebatch.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class FileWriteBatchTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            // create temporary, empty directory
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("FileWriteBatchTest");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+            FileUtils::makePath(mTempDir);
+        }
+
+        virtual void TearDown() override
+        {
+            // remove temporary directory
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        FilePath mTempDir;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(FileWriteBatchTest, testCommit)
+{
+    FilePath existing = mTempDir.getPathTo("existing.txt");
+    FilePath added = mTempDir.getPathTo("subdir/added.txt");
+    FilePath removedDir = mTempDir.getPathTo("removed");
+    FileUtils::writeFile(existing, "old");
+    FileUtils::writeFile(removedDir.getPathTo("file.txt"), "old");
+
+    FileWriteBatch batch;
+    batch.append(existing, "new");
+    batch.append(added, "added");
+    batch.appendRemoval(removedDir);
+    batch.commit();
+
+    EXPECT_EQ(QByteArray("new"), FileUtils::readFile(existing));
+    EXPECT_EQ(QByteArray("added"), FileUtils::readFile(added));
+    EXPECT_FALSE(removedDir.isExistingDir());
+    EXPECT_EQ(QStringList({"existing.txt", "subdir"}),
+              QDir(mTempDir.toStr()).entryList(QDir::AllEntries | QDir::Hidden |
+                                               QDir::NoDotAndDotDot)); // no backups left
+}
+
+TEST_F(FileWriteBatchTest, testCommitRollsBackIfRenamingFails)
+{
+    FilePath existing = mTempDir.getPathTo("existing.txt");
+    FilePath added = mTempDir.getPathTo("added.txt");
+    FilePath blocked = mTempDir.getPathTo("blocked"); // a non-empty directory
+    FilePath removed = mTempDir.getPathTo("removed.txt");
+    FileUtils::writeFile(existing, "old");
+    FileUtils::writeFile(blocked.getPathTo("file.txt"), "old");
+    FileUtils::writeFile(removed, "old");
+
+    // replacing the directory by a file fails after the other files were renamed
+    FileWriteBatch batch;
+    bool existingWritten = false, addedWritten = false;
+    batch.append(existing, "new", [&](){existingWritten = true;});
+    batch.append(added, "added", [&](){addedWritten = true;});
+    batch.append(blocked, "new");
+    batch.appendRemoval(removed);
+    EXPECT_THROW(batch.commit(), Exception);
+    batch.notifyWritten();
+
+    // all files must be in their original state again
+    EXPECT_EQ(QByteArray("old"), FileUtils::readFile(existing));
+    EXPECT_FALSE(added.isExistingFile());
+    EXPECT_EQ(QByteArray("old"), FileUtils::readFile(blocked.getPathTo("file.txt")));
+    EXPECT_EQ(QByteArray("old"), FileUtils::readFile(removed));
+    EXPECT_FALSE(existingWritten);
+    EXPECT_FALSE(addedWritten);
+    EXPECT_EQ(QStringList({"blocked", "existing.txt", "removed.txt"}),
+              QDir(mTempDir.toStr()).entryList(QDir::AllEntries | QDir::Hidden |
+                                               QDir::NoDotAndDotDot)); // no backups left
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/mappedfile.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class MappedFileTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            // create temporary, empty directory
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("MappedFileTest");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+            FileUtils::makePath(mTempDir);
+        }
+
+        virtual void TearDown() override
+        {
+            // remove temporary directory
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        FilePath mTempDir;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(MappedFileTest, testContentEqualsReadFile)
+{
+    FilePath fp = mTempDir.getPathTo("file.xml");
+    FileUtils::writeFile(fp, QByteArray("<root>\n  <child/>\n</root>\n"));
+    MappedFile file(fp);
+    EXPECT_EQ(fp, file.getFilePath());
+    EXPECT_EQ(FileUtils::readFile(fp), file.getContent());
+}
+
+TEST_F(MappedFileTest, testEmptyFile)
+{
+    FilePath fp = mTempDir.getPathTo("empty.xml");
+    FileUtils::writeFile(fp, QByteArray());
+    MappedFile file(fp);
+    EXPECT_FALSE(file.isMapped());
+    EXPECT_TRUE(file.getContent().isEmpty());
+}
+
+TEST_F(MappedFileTest, testNonExistingFile)
+{
+    EXPECT_THROW(MappedFile(mTempDir.getPathTo("foo.xml")), Exception);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -24,6 +24,7 @@
 #include <QtCore>
 #include <gtest/gtest.h>
 #include <librepcb/common/fileio/serializableobjectlist.h>
+#include <librepcb/common/fileio/cmd/cmdlistelementsinsert.h>
 #include "serializableobjectmock.h"
 
 /*****************************************************************************************
@@ -338,6 +339,67 @@ TEST_F(SerializableObjectListTest, testOperatorMove)
     EXPECT_EQ(mMocks[1], l2[1]);
 }
 
+TEST_F(SerializableObjectListTest, testIndexOfLargeList)
+{
+    List l;
+    QList<Uuid> uuids;
+    for (int i = 0; i < 50; ++i) {
+        uuids.append(Uuid::createRandom());
+        l.append(std::make_shared<Mock>(uuids.last(), QString::number(i)));
+    }
+    EXPECT_EQ(42, l.indexOf(uuids[42]));
+    EXPECT_EQ(42, l.indexOf(QString("42")));
+    EXPECT_EQ(-1, l.indexOf(Uuid::createRandom()));
+    EXPECT_EQ(-1, l.indexOf(QString("foo")));
+
+    // inserting in front of indexed elements shifts their indices
+    l.insert(0, mMocks[0]);
+    EXPECT_EQ(0, l.indexOf(mMocks[0]->getUuid()));
+    EXPECT_EQ(43, l.indexOf(uuids[42]));
+    EXPECT_EQ(43, l.indexOf(QString("42")));
+
+    // removing the last element and appending other elements
+    l.remove(l.count() - 1);
+    l.append(mMocks[1]);
+    EXPECT_EQ(-1, l.indexOf(uuids[49]));
+    EXPECT_EQ(50, l.indexOf(mMocks[1]->getUuid()));
+    EXPECT_EQ(50, l.indexOf(QString("bar")));
+
+    // modifying the name of an element without notifying the list
+    l[10]->mName = "renamed";
+    EXPECT_EQ(10, l.indexOf(QString("renamed")));
+    EXPECT_EQ(-1, l.indexOf(QString("9")));
+
+    // removing an element in front of indexed elements shifts their indices back
+    l.remove(0);
+    EXPECT_EQ(-1, l.indexOf(mMocks[0]->getUuid()));
+    EXPECT_EQ(42, l.indexOf(uuids[42]));
+    EXPECT_EQ(42, l.indexOf(QString("42")));
+
+    // a sorted copy has its own indices
+    List sorted = l.sortedByUuid();
+    for (int i = 0; i < sorted.count(); ++i) {
+        EXPECT_EQ(i, sorted.indexOf(sorted[i]->getUuid()));
+    }
+}
+
+TEST_F(SerializableObjectListTest, testCmdListElementsInsert)
+{
+    List l{mMocks[0]};
+    QVector<std::shared_ptr<Mock>> elements = {mMocks[1], mMocks[2]};
+    CmdListElementsInsert<Mock, SerializableObjectListTagNameProvider> cmd(l, elements);
+    EXPECT_TRUE(cmd.execute());
+    EXPECT_EQ(3, l.count());
+    EXPECT_EQ(mMocks[1], l.value(1));
+    EXPECT_EQ(mMocks[2], l.value(2));
+    cmd.undo();
+    EXPECT_EQ(1, l.count());
+    EXPECT_EQ(mMocks[0], l.value(0));
+    cmd.redo();
+    EXPECT_EQ(3, l.count());
+    EXPECT_EQ(mMocks[2], l.value(2));
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -0,0 +1,108 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sharedfilestore.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class SharedFileStoreTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            // create temporary, empty directory
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("SharedFileStoreTest");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+            FileUtils::makePath(mTempDir);
+        }
+
+        virtual void TearDown() override
+        {
+            // remove temporary directory
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        FilePath mTempDir;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(SharedFileStoreTest, testIdenticalFilesAreShared)
+{
+    QByteArray content("<root>\n  <child/>\n</root>\n");
+    FileUtils::writeFile(mTempDir.getPathTo("a/element.xml"), content);
+    FileUtils::writeFile(mTempDir.getPathTo("b/element.xml"), content);
+    SharedFileStore store(mTempDir.getPathTo("store"));
+    EXPECT_EQ(0, store.shareDirectory(mTempDir.getPathTo("a")));
+    EXPECT_EQ(content.size(), store.shareDirectory(mTempDir.getPathTo("b")));
+    EXPECT_EQ(content, FileUtils::readFile(mTempDir.getPathTo("a/element.xml")));
+    EXPECT_EQ(content, FileUtils::readFile(mTempDir.getPathTo("b/element.xml")));
+}
+
+TEST_F(SharedFileStoreTest, testWritingSharedFileBreaksLink)
+{
+    QByteArray content("content");
+    FileUtils::writeFile(mTempDir.getPathTo("a/file"), content);
+    FileUtils::writeFile(mTempDir.getPathTo("b/file"), content);
+    SharedFileStore store(mTempDir.getPathTo("store"));
+    store.shareDirectory(mTempDir.getPathTo("a"));
+    store.shareDirectory(mTempDir.getPathTo("b"));
+    FileUtils::writeFile(mTempDir.getPathTo("b/file"), QByteArray("modified"));
+    EXPECT_EQ(content, FileUtils::readFile(mTempDir.getPathTo("a/file")));
+    EXPECT_EQ(QByteArray("modified"), FileUtils::readFile(mTempDir.getPathTo("b/file")));
+}
+
+TEST_F(SharedFileStoreTest, testDifferentFilesAreNotShared)
+{
+    FileUtils::writeFile(mTempDir.getPathTo("a/file"), QByteArray("foo"));
+    FileUtils::writeFile(mTempDir.getPathTo("b/file"), QByteArray("bar"));
+    SharedFileStore store(mTempDir.getPathTo("store"));
+    EXPECT_EQ(0, store.shareDirectory(mTempDir.getPathTo("a")));
+    EXPECT_EQ(0, store.shareDirectory(mTempDir.getPathTo("b")));
+    EXPECT_EQ(QByteArray("foo"), FileUtils::readFile(mTempDir.getPathTo("a/file")));
+    EXPECT_EQ(QByteArray("bar"), FileUtils::readFile(mTempDir.getPathTo("b/file")));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -147,6 +147,57 @@ TEST_P(FilePathTest, testOperatorAssign)
     EXPECT_EQ(p1.toStr(), p2.toStr());
 }
 
+TEST(FilePathTest, testFilenameComponents)
+{
+    FilePath p("/foo.d/bar.tar.gz");
+    EXPECT_EQ(QString("bar.tar.gz"), p.getFilename());
+    EXPECT_EQ(QString("bar"), p.getBasename());
+    EXPECT_EQ(QString("bar.tar"), p.getCompleteBasename());
+    EXPECT_EQ(QString("gz"), p.getSuffix());
+    EXPECT_EQ(QString("tar.gz"), p.getCompleteSuffix());
+    EXPECT_EQ(QString("/foo.d"), p.getParentDir().toStr());
+
+    FilePath noSuffix("/foo.d/bar");
+    EXPECT_EQ(QString("bar"), noSuffix.getBasename());
+    EXPECT_EQ(QString("bar"), noSuffix.getCompleteBasename());
+    EXPECT_EQ(QString(""), noSuffix.getSuffix());
+    EXPECT_EQ(QString(""), noSuffix.getCompleteSuffix());
+
+    FilePath root("/");
+    EXPECT_EQ(QString(""), root.getFilename());
+    EXPECT_FALSE(root.getParentDir().isValid());
+    EXPECT_EQ(QString("/"), FilePath("/foo").getParentDir().toStr());
+}
+
+TEST(FilePathTest, testGetPathTo)
+{
+    EXPECT_EQ(QString("/foo/bar.txt"), FilePath("/foo").getPathTo("bar.txt").toStr());
+    EXPECT_EQ(QString("/bar.txt"), FilePath("/").getPathTo("bar.txt").toStr());
+    EXPECT_EQ(QString("/foo/a/b"), FilePath("/foo").getPathTo("a//b/").toStr());
+    EXPECT_EQ(QString("/"), FilePath("/foo").getPathTo("..").toStr());
+    EXPECT_EQ(QString("txt"), FilePath("/foo").getPathTo("bar.txt").getSuffix());
+    EXPECT_FALSE(FilePath().getPathTo("bar.txt").isValid());
+}
+
+TEST(FilePathTest, testEqualityAndHash)
+{
+    FilePath p1("/foo/bar");
+    FilePath p2("/foo//bar/");
+    FilePath p3 = FilePath("/foo").getPathTo("bar");
+    EXPECT_TRUE(p1 == p2);
+    EXPECT_TRUE(p1 == p3);
+    EXPECT_EQ(qHash(p1, 42), qHash(p2, 42));
+    EXPECT_EQ(qHash(p1, 42), qHash(p3, 42));
+    EXPECT_FALSE(p1 == FilePath("/foo/baz"));
+    EXPECT_FALSE(p1 == FilePath());
+    EXPECT_TRUE(FilePath() == FilePath());
+    EXPECT_TRUE(p1.isLocatedInDir(FilePath("/foo")));
+    EXPECT_TRUE(p1.isLocatedInDir(FilePath("/")));
+    EXPECT_FALSE(p1.isLocatedInDir(FilePath("/fo")));
+    EXPECT_FALSE(p1.isLocatedInDir(p1));
+    EXPECT_EQ(QString("foo/bar"), p1.toRelative(FilePath("/")));
+}
+
 TEST(FilePathTest, testCleanFileName)
 {
     QString input(" ∑ ;.'[a]*(/∮E⋅→∞∏g¼∀x∈ ℝ:T@st⌈x⌉α∧¬β=∨)⊆\nℕ ₀H₂Ω⌀,"
@@ -0,0 +1,75 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerberaperturelist.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberApertureListTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(GerberApertureListTest, testEqualAperturesAreMerged)
+{
+    GerberApertureList list;
+    int circle = list.setCircle(Length(1000000), Length(0));
+    int rect = list.setRect(Length(2000000), Length(1000000), Angle::deg0(), Length(0));
+    EXPECT_EQ(10, circle);
+    EXPECT_EQ(11, rect);
+    EXPECT_EQ(circle, list.setCircle(Length(1000000), Length(0)));
+    EXPECT_EQ(rect, list.setRect(Length(2000000), Length(1000000), Angle::deg180(), Length(0)));
+    EXPECT_EQ(rect, list.setRect(Length(1000000), Length(2000000), Angle::deg90(), Length(0)));
+    EXPECT_NE(circle, list.setCircle(Length(1000000), Length(500000)));
+    EXPECT_NE(rect, list.setObround(Length(2000000), Length(1000000), Angle::deg0(), Length(0)));
+}
+
+TEST(GerberApertureListTest, testGenerateString)
+{
+    GerberApertureList list;
+    list.setCircle(Length(1000000), Length(0));
+    list.setRect(Length(2000000), Length(1000000), Angle::deg45(), Length(0));
+    list.setCircle(Length(1000000), Length(0));
+    QString str = list.generateString();
+    EXPECT_TRUE(str.contains("%ADD10C,1.000000*%\n")) << qPrintable(str);
+    EXPECT_TRUE(str.contains("%ADD11ROTATEDRECT,2.000000X1.000000X45.000000*%\n")) << qPrintable(str);
+    EXPECT_FALSE(str.contains("%ADD12")) << qPrintable(str);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,235 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <QtCore>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/geometry/polygon.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberGeneratorTest : public ::testing::Test
+{
+    protected:
+        Uuid mUuid = Uuid("c5b1a4ad-7eb5-4fd2-9bb5-6d5b80f31d3a");
+
+        static QByteArray generate(GerberGenerator& gen)
+        {
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            gen.generate(buffer);
+            return buffer.data();
+        }
+
+        /// Remove all lines which depend on the creation time or the application version
+        static QByteArray removeVolatileLines(const QByteArray& data)
+        {
+            QByteArray output;
+            foreach (const QByteArray& line, data.split('\n')) {
+                if ((!line.startsWith("%TF.GenerationSoftware,")) &&
+                    (!line.startsWith("%TF.CreationDate,")) &&
+                    (!line.startsWith("%TF.MD5,"))) {
+                    output.append(line).append('\n');
+                }
+            }
+            output.chop(1); // the last line (after the last linebreak) is empty
+            return output;
+        }
+
+        /// Check the MD5 attribute, which is calculated over everything before it
+        static void checkChecksum(const QByteArray& data)
+        {
+            int index = data.indexOf("%TF.MD5,");
+            ASSERT_GE(index, 0);
+            QByteArray content = data.left(index).replace('\n', QByteArray());
+            QByteArray md5 = QCryptographicHash::hash(content, QCryptographicHash::Md5).toHex();
+            EXPECT_EQ((QByteArray("%TF.MD5,") + md5 + "*%\nM02*\n").toStdString(),
+                      data.mid(index).toStdString());
+        }
+
+        /// Draw a deterministic mixture of traces, pads and areas on a 0.1mm grid
+        static void drawSyntheticBoard(GerberGenerator& gen, int primitives)
+        {
+            for (int i = 0; i < primitives; ++i) {
+                Point pos(Length((i % 1000) * 100000), Length((i / 1000) * 100000));
+                switch (i % 4) {
+                    case 0: {
+                        gen.drawLine(pos, pos + Point(50000, 25000), 150000 + (i % 3) * 50000);
+                        break;
+                    }
+                    case 1: {
+                        gen.flashCircle(pos, Length(600000), Length(0));
+                        break;
+                    }
+                    case 2: {
+                        Angle rot = ((i / 4) % 2) ? Angle::deg90() : Angle::deg0();
+                        gen.flashRect(pos, Length(800000), Length(400000), rot, Length(0));
+                        break;
+                    }
+                    default: {
+                        Polygon area("top_cu", Length(0), true, false, pos);
+                        area.getSegments().append(std::make_shared<PolygonSegment>(
+                            pos + Point(80000, 0), Angle::deg0()));
+                        area.getSegments().append(std::make_shared<PolygonSegment>(
+                            pos + Point(80000, 80000), Angle::deg0()));
+                        area.getSegments().append(std::make_shared<PolygonSegment>(
+                            pos + Point(0, 80000), Angle::deg0()));
+                        area.getSegments().append(std::make_shared<PolygonSegment>(
+                            pos, Angle::deg0()));
+                        gen.drawPolygonArea(area);
+                        break;
+                    }
+                }
+            }
+        }
+
+        void checkSyntheticBoard(int primitives)
+        {
+            GerberGenerator gen1("Synthetic", mUuid, "v1");
+            drawSyntheticBoard(gen1, primitives);
+            QByteArray data1 = generate(gen1);
+            GerberGenerator gen2("Synthetic", mUuid, "v1");
+            drawSyntheticBoard(gen2, primitives);
+            QByteArray data2 = generate(gen2);
+
+            // the output must be reproducible and must not lose any content, even if
+            // it is larger than the in-memory buffer of the generator
+            EXPECT_EQ(removeVolatileLines(data1), removeVolatileLines(data2));
+            EXPECT_EQ(primitives / 2, data1.count("D03*\n"));
+            EXPECT_EQ(primitives / 4, data1.count("G36*\n"));
+            EXPECT_EQ(primitives / 4, data1.count("G37*\n"));
+            EXPECT_EQ(primitives / 4 * 5, data1.count("D01*\n"));
+            EXPECT_EQ(1, data1.count("%ADD10C,0.150000*%\n"));
+            checkChecksum(data1);
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GerberGeneratorTest, testGoldenOutput)
+{
+    GerberGenerator gen("Project", mUuid, "v1");
+    gen.setFileFunction("Copper,L1,Top", GerberGenerator::LayerPolarity::Positive);
+    gen.setApertureFunction("Conductor");
+    gen.drawLine(Point(0, 0), Point(1000000, 0), Length(200000));
+    gen.setApertureFunction("ComponentPad");
+    gen.flashCircle(Point(1000000, 0), Length(1500000), Length(0));
+    gen.flashRect(Point(2000000, -500000), Length(1000000), Length(500000),
+                  Angle::deg90(), Length(0));
+
+    EXPECT_EQ(std::string(
+        "G04 --- HEADER BEGIN --- *\n"
+        "%TF.ProjectId,Project,c5b1a4ad-7eb5-4fd2-9bb5-6d5b80f31d3a,v1*%\n"
+        "%TF.Part,Single*%\n"
+        "%TF.FileFunction,Copper,L1,Top*%\n"
+        "%TF.FilePolarity,Positive*%\n"
+        "%FSLAX66Y66*%\n"
+        "%MOMM*%\n"
+        "G01*\n"
+        "G74*\n"
+        "G04 --- HEADER END --- *\n"
+        "G04 --- APERTURE LIST BEGIN --- *\n"
+        "%TA.AperFunction,Conductor*%\n"
+        "%ADD10C,0.200000*%\n"
+        "%TA.AperFunction,ComponentPad*%\n"
+        "%ADD11C,1.500000*%\n"
+        "%ADD12R,0.500000X1.000000*%\n"
+        "%TD.AperFunction*%\n"
+        "G04 --- APERTURE LIST END --- *\n"
+        "G04 --- BOARD BEGIN --- *\n"
+        "D10*\n"
+        "X0Y0D02*\n"
+        "X1000000Y0D01*\n"
+        "D11*\n"
+        "X1000000Y0D03*\n"
+        "D12*\n"
+        "X2000000Y-500000D03*\n"
+        "G04 --- BOARD END --- *\n"
+        "M02*\n"), removeVolatileLines(generate(gen)).toStdString());
+}
+
+TEST_F(GerberGeneratorTest, testGoldenOutputOfPanel)
+{
+    GerberGenerator gen("Project", mUuid, "v1");
+    gen.setStepAndRepeat(2, 3, Length(25000000), Length(30000000));
+    gen.flashCircle(Point(1000000, 2000000), Length(1000000), Length(0));
+
+    EXPECT_EQ(std::string(
+        "G04 --- HEADER BEGIN --- *\n"
+        "%TF.ProjectId,Project,c5b1a4ad-7eb5-4fd2-9bb5-6d5b80f31d3a,v1*%\n"
+        "%TF.Part,Array*%\n"
+        "%FSLAX66Y66*%\n"
+        "%MOMM*%\n"
+        "G01*\n"
+        "G74*\n"
+        "G04 --- HEADER END --- *\n"
+        "G04 --- APERTURE LIST BEGIN --- *\n"
+        "%ADD10C,1.000000*%\n"
+        "G04 --- APERTURE LIST END --- *\n"
+        "G04 --- BOARD BEGIN --- *\n"
+        "%SRX2Y3I25.000000J30.000000*%\n"
+        "D10*\n"
+        "X1000000Y2000000D03*\n"
+        "%SR*%\n"
+        "G04 --- BOARD END --- *\n"
+        "M02*\n"), removeVolatileLines(generate(gen)).toStdString());
+}
+
+TEST_F(GerberGeneratorTest, testChecksum)
+{
+    GerberGenerator gen("Project", mUuid, "v1");
+    gen.drawLine(Point(0, 0), Point(1000000, 0), Length(200000));
+    checkChecksum(generate(gen));
+}
+
+TEST_F(GerberGeneratorTest, testSyntheticBoard1k)
+{
+    checkSyntheticBoard(1000);
+}
+
+TEST_F(GerberGeneratorTest, testSyntheticBoard10k)
+{
+    checkSyntheticBoard(10000);
+}
+
+TEST_F(GerberGeneratorTest, testSyntheticBoard100k)
+{
+    checkSyntheticBoard(100000);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <QtCore>
+#include <librepcb/common/jobscheduler.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Helper Classes
+ ****************************************************************************************/
+
+class JobSchedulerTestJob final : public QRunnable
+{
+    public:
+        JobSchedulerTestJob(QAtomicInt& running, QAtomicInt& maxRunning,
+                            QAtomicInt& finished, QSemaphore* startSignal = nullptr) noexcept :
+            QRunnable(), mRunning(running), mMaxRunning(maxRunning), mFinished(finished),
+            mStartSignal(startSignal) {}
+
+        void run() override {
+            int running = mRunning.fetchAndAddOrdered(1) + 1;
+            int max = mMaxRunning.load();
+            while ((running > max) && (!mMaxRunning.testAndSetOrdered(max, running))) {
+                max = mMaxRunning.load();
+            }
+            if (mStartSignal) {
+                mStartSignal->acquire(); // block until the test lets the job finish
+            } else {
+                QThread::msleep(5);
+            }
+            mRunning.fetchAndAddOrdered(-1);
+            mFinished.fetchAndAddOrdered(1);
+        }
+
+    private:
+        QAtomicInt& mRunning;
+        QAtomicInt& mMaxRunning;
+        QAtomicInt& mFinished;
+        QSemaphore* mStartSignal;
+};
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class JobSchedulerTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(JobSchedulerTest, testGroupRunsJobsOneAfterAnother)
+{
+    JobScheduler scheduler(4);
+    QAtomicInt running(0), maxRunning(0), finished(0);
+    {
+        JobScheduler::Group group(scheduler, JobScheduler::Priority::Visible, 1);
+        for (int i = 0; i < 10; ++i) {
+            group.start(new JobSchedulerTestJob(running, maxRunning, finished));
+        }
+        EXPECT_TRUE(group.waitForDone());
+        EXPECT_EQ(0, group.getPendingJobCount());
+    }
+    EXPECT_EQ(10, finished.load());
+    EXPECT_EQ(1, maxRunning.load());
+    EXPECT_EQ(0, scheduler.getPendingJobCount());
+}
+
+TEST_F(JobSchedulerTest, testClearRemovesQueuedJobs)
+{
+    JobScheduler scheduler(4);
+    QAtomicInt running(0), maxRunning(0), finished(0);
+    QSemaphore startSignal;
+    JobScheduler::Group group(scheduler, JobScheduler::Priority::Background, 1);
+    for (int i = 0; i < 5; ++i) {
+        group.start(new JobSchedulerTestJob(running, maxRunning, finished, &startSignal));
+    }
+    EXPECT_FALSE(group.waitForDone(20)); // the first job is blocked
+    JobScheduler::CancellationToken token = group.getCancellationToken();
+    group.cancel();
+    EXPECT_TRUE(token.isCanceled());
+    EXPECT_FALSE(group.getCancellationToken().isCanceled());
+    startSignal.release(5);
+    EXPECT_TRUE(group.waitForDone());
+    EXPECT_EQ(1, finished.load());
+    EXPECT_EQ(0, scheduler.getPendingJobCount());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,135 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/units/length.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Data Type
+ ****************************************************************************************/
+
+typedef struct {
+    QString string;
+    LengthBase_t nanometers;
+} LengthTestData_t;
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class LengthTest : public ::testing::TestWithParam<LengthTestData_t>
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_P(LengthTest, testFromMmString)
+{
+    const LengthTestData_t& data = GetParam();
+
+    Length l = Length::fromMm(data.string);
+    EXPECT_EQ(data.nanometers, l.toNm());
+}
+
+TEST_P(LengthTest, testDeserializeFromString)
+{
+    const LengthTestData_t& data = GetParam();
+
+    Length l = Length::deserializeFromString(data.string);
+    EXPECT_EQ(data.nanometers, l.toNm());
+}
+
+TEST(LengthTest, testFromMmStringInvalid)
+{
+    EXPECT_THROW(Length::fromMm(QString("")), RuntimeError);
+    EXPECT_THROW(Length::fromMm(QString("-")), RuntimeError);
+    EXPECT_THROW(Length::fromMm(QString(".")), RuntimeError);
+    EXPECT_THROW(Length::fromMm(QString("abc")), RuntimeError);
+    EXPECT_THROW(Length::fromMm(QString("1,5")), RuntimeError);
+    EXPECT_THROW(Length::fromMm(QString("1.2.3")), RuntimeError);
+    EXPECT_THROW(Length::fromMm(QString("1e")), RuntimeError);
+    EXPECT_THROW(Length::fromMm(QString("1 2")), RuntimeError);
+}
+
+TEST(LengthTest, testFromMmStringOutOfRange)
+{
+    EXPECT_THROW(Length::fromMm(QString("9223372036854.775808")), RangeError);
+    EXPECT_THROW(Length::fromMm(QString("-9223372036854.775809")), RangeError);
+    EXPECT_THROW(Length::fromMm(QString("1e20")), RangeError);
+    EXPECT_THROW(Length::fromMm(QString("123456789012345678901234567890")), RangeError);
+}
+
+TEST(LengthTest, testMapToGrid)
+{
+    EXPECT_EQ(0, Length(0).mappedToGrid(Length(100)).toNm());
+    EXPECT_EQ(123, Length(123).mappedToGrid(Length(0)).toNm());
+    EXPECT_EQ(100, Length(149).mappedToGrid(Length(100)).toNm());
+    EXPECT_EQ(200, Length(150).mappedToGrid(Length(100)).toNm());
+    EXPECT_EQ(-100, Length(-149).mappedToGrid(Length(100)).toNm());
+    EXPECT_EQ(-100, Length(-150).mappedToGrid(Length(100)).toNm());
+    EXPECT_EQ(-200, Length(-151).mappedToGrid(Length(100)).toNm());
+    EXPECT_EQ(200, Length(150).mappedToGrid(Length(-100)).toNm());
+    EXPECT_EQ(Q_INT64_C(9223372036854000000),
+              Length(Q_INT64_C(9223372036854000001)).mappedToGrid(Length(1000000)).toNm());
+}
+
+/*****************************************************************************************
+ *  Test Data
+ ****************************************************************************************/
+
+INSTANTIATE_TEST_CASE_P(LengthTest, LengthTest, ::testing::Values(
+    //                string                         nanometers
+    LengthTestData_t({"0",                           0}),
+    LengthTestData_t({"-0",                          0}),
+    LengthTestData_t({"1",                           1000000}),
+    LengthTestData_t({"-1.5",                        -1500000}),
+    LengthTestData_t({"+0.000001",                   1}),
+    LengthTestData_t({"0.0000005",                   1}),
+    LengthTestData_t({"-0.0000005",                  -1}),
+    LengthTestData_t({"0.0000004999",                0}),
+    LengthTestData_t({"123456.789012",               123456789012}),
+    LengthTestData_t({" 2.54 ",                      2540000}),
+    LengthTestData_t({".5",                          500000}),
+    LengthTestData_t({"5.",                          5000000}),
+    LengthTestData_t({"1e3",                         1000000000}),
+    LengthTestData_t({"2.5E-3",                      2500}),
+    LengthTestData_t({"0.1000000000000000000001",    100000}),
+    LengthTestData_t({"9223372036854.775807",        Q_INT64_C(9223372036854775807)}),
+    LengthTestData_t({"-9223372036854.775808",       -Q_INT64_C(9223372036854775807) - 1})
+));
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
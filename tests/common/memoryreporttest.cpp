@@ -0,0 +1,87 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/memoryreport.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(MemoryReportTest, testTotalBytesIncludeChildren)
+{
+    MemoryReport report("Root", 10);
+    MemoryReport& child = report.addChild("Child", 100, 2);
+    child.addChild("Grandchild", 1000);
+    child.addBytes(5);
+    EXPECT_EQ(10, report.getOwnBytes());
+    EXPECT_EQ(1115, report.getTotalBytes());
+    EXPECT_EQ(1105, child.getTotalBytes());
+    EXPECT_EQ(2, child.getCount());
+    EXPECT_EQ(-1, report.getCount());
+}
+
+TEST(MemoryReportTest, testAddObjects)
+{
+    MemoryReport report("Root");
+    MemoryReport& child = report.addObjects<qint64>("Integers", 3);
+    EXPECT_EQ(static_cast<qint64>(3 * sizeof(qint64)), child.getTotalBytes());
+    EXPECT_EQ(3, child.getCount());
+}
+
+TEST(MemoryReportTest, testToString)
+{
+    MemoryReport report("Root");
+    report.addChild("Child", 2048, 4).addChild("Grandchild", 512);
+    EXPECT_EQ(QString("Root: 2.5 KiB\n  Child: 2.5 KiB (4x)\n    Grandchild: 512 B"),
+              report.toString());
+}
+
+TEST(MemoryReportTest, testProviders)
+{
+    int id = MemoryReport::registerProvider([](MemoryReport& report){
+        report.addChild("Test Provider", 42);
+    });
+    MemoryReport report = MemoryReport::createApplicationReport();
+    MemoryReport::unregisterProvider(id);
+    ASSERT_FALSE(report.getChildren().isEmpty());
+    EXPECT_EQ(QString("Test Provider"), report.getChildren().last()->getName());
+    EXPECT_EQ(42, report.getChildren().last()->getTotalBytes());
+
+    int count = report.getChildren().count();
+    EXPECT_EQ(count - 1, MemoryReport::createApplicationReport().getChildren().count());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/objectpool.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Data
+ ****************************************************************************************/
+
+class PooledTestObject final : public PooledObject<PooledTestObject>
+{
+    public:
+        explicit PooledTestObject(int value) : mValue(value) {
+            if (value < 0) throw std::runtime_error("negative value");
+        }
+        int mValue;
+        double mPadding[3];
+};
+
+class PooledThreadTestObject final : public PooledObject<PooledThreadTestObject>
+{
+    public:
+        int mValue = 0;
+        double mPadding[3];
+};
+
+class ObjectPoolTestThread final : public QThread
+{
+    public:
+        explicit ObjectPoolTestThread(int count) : mCount(count) {}
+        void run() override {
+            for (int i = 0; i < mCount; ++i) {
+                mObjects.append(new PooledThreadTestObject());
+            }
+            // delete half of the objects in this thread, the rest in the main thread
+            while (mObjects.count() > mCount / 2) {
+                delete mObjects.takeLast();
+            }
+        }
+        int mCount;
+        QList<PooledThreadTestObject*> mObjects;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(ObjectPoolTest, testMemoryIsReused)
+{
+    int usedCount = ObjectPool<PooledTestObject>::getUsedCount();
+    PooledTestObject* obj1 = new PooledTestObject(1);
+    EXPECT_EQ(usedCount + 1, ObjectPool<PooledTestObject>::getUsedCount());
+    EXPECT_GE(ObjectPool<PooledTestObject>::getCapacity(), usedCount + 1);
+    void* address = obj1;
+    delete obj1;
+    EXPECT_EQ(usedCount, ObjectPool<PooledTestObject>::getUsedCount());
+    PooledTestObject* obj2 = new PooledTestObject(2);
+    EXPECT_EQ(address, static_cast<void*>(obj2));
+    EXPECT_EQ(2, obj2->mValue);
+    delete obj2;
+}
+
+TEST(ObjectPoolTest, testManyObjects)
+{
+    int capacity = ObjectPool<PooledTestObject>::getCapacity();
+    QList<PooledTestObject*> objects;
+    for (int i = 0; i < 1000; ++i) {
+        objects.append(new PooledTestObject(i));
+    }
+    QSet<PooledTestObject*> uniqueObjects = objects.toSet();
+    EXPECT_EQ(1000, uniqueObjects.count());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(i, objects.at(i)->mValue);
+    }
+    qDeleteAll(objects);
+    int grownCapacity = ObjectPool<PooledTestObject>::getCapacity();
+    EXPECT_GE(grownCapacity, 1000);
+
+    // the capacity must not grow anymore when allocating the same count again
+    objects.clear();
+    for (int i = 0; i < 1000; ++i) {
+        objects.append(new PooledTestObject(i));
+    }
+    EXPECT_EQ(grownCapacity, ObjectPool<PooledTestObject>::getCapacity());
+    EXPECT_GE(grownCapacity, capacity);
+    qDeleteAll(objects);
+}
+
+TEST(ObjectPoolTest, testFreeBlocksOfExitedThreadAreReused)
+{
+    ObjectPoolTestThread thread(500);
+    thread.start();
+    ASSERT_TRUE(thread.wait());
+    EXPECT_EQ(250, ObjectPool<PooledThreadTestObject>::getUsedCount());
+    qDeleteAll(thread.mObjects);
+    EXPECT_EQ(0, ObjectPool<PooledThreadTestObject>::getUsedCount());
+
+    // all blocks (deleted in the exited thread or in this thread) must be reused
+    int capacity = ObjectPool<PooledThreadTestObject>::getCapacity();
+    EXPECT_GE(capacity, 500);
+    QList<PooledThreadTestObject*> objects;
+    for (int i = 0; i < capacity; ++i) {
+        objects.append(new PooledThreadTestObject());
+    }
+    EXPECT_EQ(capacity, objects.toSet().count());
+    EXPECT_EQ(capacity, ObjectPool<PooledThreadTestObject>::getCapacity());
+    qDeleteAll(objects);
+}
+
+TEST(ObjectPoolTest, testExceptionInConstructorReleasesMemory)
+{
+    int usedCount = ObjectPool<PooledTestObject>::getUsedCount();
+    EXPECT_THROW(new PooledTestObject(-1), std::runtime_error);
+    EXPECT_EQ(usedCount, ObjectPool<PooledTestObject>::getUsedCount());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
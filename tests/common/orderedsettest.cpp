@@ -0,0 +1,89 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/orderedset.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class OrderedSetTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(OrderedSetTest, testInsertKeepsOrder)
+{
+    OrderedSet<int> set;
+    EXPECT_TRUE(set.isEmpty());
+    EXPECT_TRUE(set.insert(3));
+    EXPECT_TRUE(set.insert(1));
+    EXPECT_TRUE(set.insert(2));
+    EXPECT_FALSE(set.insert(1)); // already contained
+    EXPECT_EQ(3, set.count());
+    EXPECT_EQ(QList<int>({3, 1, 2}), set.toList());
+}
+
+TEST(OrderedSetTest, testRemove)
+{
+    OrderedSet<int> set;
+    set.insert(3);
+    set.insert(1);
+    set.insert(2);
+    EXPECT_EQ(QList<int>({3, 1, 2}), set.toList()); // fill the cache
+    EXPECT_TRUE(set.remove(1));
+    EXPECT_FALSE(set.remove(1)); // no longer contained
+    EXPECT_FALSE(set.contains(1));
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_EQ(QList<int>({3, 2}), set.toList());
+}
+
+TEST(OrderedSetTest, testReinsertAppendsAtEnd)
+{
+    OrderedSet<int> set;
+    set.insert(1);
+    set.insert(2);
+    set.remove(1);
+    set.insert(1);
+    EXPECT_EQ(QList<int>({2, 1}), set.toList());
+    set.clear();
+    EXPECT_TRUE(set.isEmpty());
+    EXPECT_TRUE(set.toList().isEmpty());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
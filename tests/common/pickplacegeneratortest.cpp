@@ -0,0 +1,72 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <QtCore>
+#include <librepcb/common/cam/pickplacegenerator.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class PickPlaceGeneratorTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(PickPlaceGeneratorTest, testGoldenOutput)
+{
+    PickPlaceGenerator gen;
+    gen.addPart(PickPlaceGenerator::Part{"R10", "10k", "R0805", Point(1500000, -2000000),
+                                         Angle::deg90(), PickPlaceGenerator::BoardSide::Top});
+    gen.addPart(PickPlaceGenerator::Part{"R2", "1k, 1%", "R0805", Point(0, 0),
+                                         -Angle::deg90(), PickPlaceGenerator::BoardSide::Bottom});
+    gen.addPart(PickPlaceGenerator::Part{"C1", "100nF", "C0603", Point(-250000, 12345678),
+                                         Angle(0), PickPlaceGenerator::BoardSide::Top});
+
+    QString output;
+    QTextStream stream(&output);
+    gen.generate(stream);
+
+    EXPECT_EQ(std::string(
+        "Designator,Value,Package,X,Y,Rotation,Side\n"
+        "C1,100nF,C0603,-0.250000,12.345678,0.000000,Top\n"
+        "R2,\"1k, 1%\",R0805,0.000000,0.000000,270.000000,Bottom\n"
+        "R10,10k,R0805,1.500000,-2.000000,90.000000,Top\n"), output.toStdString());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,151 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/polygonclipper.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+class PolygonClipperTest : public ::testing::Test
+{
+    protected:
+        static PolygonClipper::Path rect(qint64 x, qint64 y, qint64 w, qint64 h) noexcept {
+            return PolygonClipper::Path{Point(x, y), Point(x + w, y), Point(x + w, y + h),
+                                        Point(x, y + h)};
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(PolygonClipperTest, testBooleanOperations)
+{
+    PolygonClipper::Paths a{rect(0, 0, 10, 10)};
+    PolygonClipper::Paths b{rect(5, 5, 10, 10)};
+    EXPECT_EQ(175, PolygonClipper::calcArea(PolygonClipper::unite(a, b)));
+    EXPECT_EQ(25, PolygonClipper::calcArea(PolygonClipper::intersect(a, b)));
+    EXPECT_EQ(75, PolygonClipper::calcArea(PolygonClipper::subtract(a, b)));
+    EXPECT_EQ(150, PolygonClipper::calcArea(PolygonClipper::execute(
+        PolygonClipper::Operation::Xor, a, b)));
+    EXPECT_EQ(1, PolygonClipper::unite(a, b).count());
+}
+
+TEST_F(PolygonClipperTest, testHoleOrientation)
+{
+    PolygonClipper::Paths result = PolygonClipper::subtract({rect(0, 0, 10, 10)},
+                                                            {rect(2, 2, 6, 6)});
+    ASSERT_EQ(2, result.count());
+    EXPECT_EQ(100, qMax(PolygonClipper::calcArea(result[0]), PolygonClipper::calcArea(result[1])));
+    EXPECT_EQ(-36, qMin(PolygonClipper::calcArea(result[0]), PolygonClipper::calcArea(result[1])));
+}
+
+TEST_F(PolygonClipperTest, testTouchingAndOverlappingInputs)
+{
+    // touching corners stay separate outlines, shared edges get merged
+    EXPECT_EQ(2, PolygonClipper::unite({rect(0, 0, 10, 10)}, {rect(10, 10, 10, 10)}).count());
+    EXPECT_EQ(1, PolygonClipper::unite({rect(0, 0, 10, 10)}, {rect(10, 0, 10, 10)}).count());
+    // clockwise and self-overlapping inputs are normalized
+    PolygonClipper::Path cw{Point(0, 0), Point(0, 10), Point(10, 10), Point(10, 0)};
+    EXPECT_EQ(100, PolygonClipper::calcArea(PolygonClipper::unite({cw, cw})));
+    // the self-intersecting "bowtie" consists of two triangles
+    PolygonClipper::Path bowtie{Point(0, 0), Point(10, 10), Point(10, 0), Point(0, 10)};
+    EXPECT_EQ(50, PolygonClipper::calcArea(PolygonClipper::unite({bowtie})));
+}
+
+TEST_F(PolygonClipperTest, testOffset)
+{
+    const Length tolerance(1000);
+    PolygonClipper::Paths square{rect(0, 0, 10000000, 10000000)};
+
+    // growing rounds the corners and must contain the exact result
+    qreal exact = 1e14 + 4 * 1e13 + M_PI * 1e12;
+    qreal grown = PolygonClipper::calcArea(PolygonClipper::offset(square, Length(1000000),
+                                                                  tolerance));
+    EXPECT_GE(grown, exact);
+    EXPECT_LE(grown, exact + 50e6 * tolerance.toNm());
+
+    // shrinking a convex outline keeps its corners
+    EXPECT_EQ(64e12, PolygonClipper::calcArea(PolygonClipper::offset(square,
+                                                                     Length(-1000000),
+                                                                     tolerance)));
+    EXPECT_TRUE(PolygonClipper::offset(square, Length(-6000000), tolerance).isEmpty());
+}
+
+TEST_F(PolygonClipperTest, testFromPolygonWithArcs)
+{
+    // a circle with a radius of 1mm, made of two half circles
+    Polygon polygon("", Length(0), true, false, Point(-1000000, 0));
+    polygon.getSegments().append(std::make_shared<PolygonSegment>(Point(1000000, 0),
+                                                                  Angle::deg180()));
+    polygon.getSegments().append(std::make_shared<PolygonSegment>(Point(-1000000, 0),
+                                                                  Angle::deg180()));
+    const Length tolerance(1000);
+    PolygonClipper::Path path = PolygonClipper::fromPolygon(polygon, tolerance);
+    qreal area = PolygonClipper::calcArea(path);
+    EXPECT_LE(area, M_PI * 1e12);
+    EXPECT_GE(area, M_PI * 1e12 - 2 * M_PI * 1e6 * tolerance.toNm());
+    foreach (const Point& p, path) {
+        EXPECT_NEAR(1000000, p.getLength().toNm(), 1);
+    }
+}
+
+TEST_F(PolygonClipperTest, testPerformance)
+{
+    // 10'000 overlapping circles with about 500'000 edges
+    PolygonClipper::Paths circles;
+    for (int x = 0; x < 100; ++x) {
+        for (int y = 0; y < 100; ++y) {
+            circles.append(PolygonClipper::createCircle(Point(x * 1500000, y * 1500000),
+                                                        Length(1000000), Length(1000)));
+        }
+    }
+    std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+    start = std::chrono::high_resolution_clock::now();
+    PolygonClipper::Paths result = PolygonClipper::unite(circles);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end-start;
+    std::cout << "Needed " << elapsed_seconds.count() << "s to unite " << circles.count()
+              << " circles\n";
+
+    // one outline with 99x99 holes between the circles
+    EXPECT_EQ(1 + 99 * 99, result.count());
+    EXPECT_LT(PolygonClipper::calcArea(result), 10000 * M_PI * 1e12);
+    EXPECT_GT(PolygonClipper::calcArea(result), 150e6 * 150e6 - 150e6 * 4 * 1e6);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
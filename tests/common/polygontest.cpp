@@ -0,0 +1,67 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/geometry/polygon.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class PolygonTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(PolygonTest, testFlattenedPointsCacheIsInvalidated)
+{
+    Polygon polygon("", Length(0), false, false, Point(0, 0));
+    polygon.getSegments().append(std::make_shared<PolygonSegment>(Point(1000000, 0),
+                                                                  Angle::deg0()));
+    const Length tolerance(1000);
+    EXPECT_EQ(2, polygon.toFlattenedPoints(tolerance).count());
+    polygon.getSegments().first()->setAngle(Angle::deg180());
+    int arcCount = polygon.toFlattenedPoints(tolerance).count();
+    EXPECT_GT(arcCount, 2);
+    EXPECT_LT(arcCount, polygon.toFlattenedPoints(Length(10)).count());
+    polygon.setStartPos(Point(-1000000, 0));
+    EXPECT_EQ(Point(-1000000, 0), polygon.toFlattenedPoints(tolerance).first());
+    polygon.getSegments().first()->setEndPos(Point(2000000, 0));
+    EXPECT_EQ(Point(2000000, 0), polygon.toFlattenedPoints(tolerance).last());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -160,6 +160,68 @@ TEST_F(SQLiteDatabaseTest, testInsert)
     }
 }
 
+TEST_F(SQLiteDatabaseTest, testCachedQuery)
+{
+    SQLiteDatabase db(mTempDbFilePath);
+    db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
+    QString sql = "INSERT INTO test (name) VALUES (:name)";
+    QSqlQuery& first = db.getCachedQuery(sql);
+    for (int i = 0; i < 100; ++i) {
+        QSqlQuery& query = db.getCachedQuery(sql);
+        EXPECT_EQ(&first, &query);
+        query.bindValue(":name", QString("row %1").arg(i));
+        int id = db.insert(query);
+        EXPECT_EQ(i + 1, id);
+    }
+    QSqlQuery& select = db.getCachedQuery("SELECT COUNT(*) FROM test");
+    db.exec(select);
+    ASSERT_TRUE(select.first());
+    EXPECT_EQ(100, select.value(0).toInt());
+}
+
+TEST_F(SQLiteDatabaseTest, testExecBatch)
+{
+    SQLiteDatabase db(mTempDbFilePath);
+    db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
+    QVariantList names;
+    for (int i = 0; i < 100; ++i) {
+        names.append(QString("row %1").arg(i));
+    }
+    QSqlQuery query = db.prepareQuery("INSERT INTO test (name) VALUES (:name)");
+    query.bindValue(":name", names);
+    db.execBatch(query);
+    QSqlQuery select = db.prepareQuery("SELECT name FROM test ORDER BY id");
+    db.exec(select);
+    QVariantList result;
+    while (select.next()) {
+        result.append(select.value(0));
+    }
+    EXPECT_EQ(names, result);
+}
+
+TEST_F(SQLiteDatabaseTest, testQueryStatistics)
+{
+    SQLiteDatabase db(mTempDbFilePath);
+    db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
+    SQLiteDatabase::clearQueryStatistics();
+    SQLiteDatabase::setQueryStatisticsEnabled(true, 0); // also log all query plans
+    QString sql = "SELECT name FROM test WHERE id = :id";
+    for (int i = 0; i < 10; ++i) {
+        QSqlQuery& query = db.getCachedQuery(sql);
+        query.bindValue(":id", i);
+        db.exec(query);
+    }
+    SQLiteDatabase::setQueryStatisticsEnabled(false);
+    db.exec("SELECT COUNT(*) FROM test"); // not recorded
+    QList<SQLiteDatabase::QueryStatistics> statistics = SQLiteDatabase::getQueryStatistics();
+    ASSERT_EQ(1, statistics.count());
+    EXPECT_EQ(sql, statistics.first().query);
+    EXPECT_EQ(10, statistics.first().count);
+    EXPECT_GE(statistics.first().totalNs, statistics.first().maxNs);
+    SQLiteDatabase::clearQueryStatistics();
+    EXPECT_TRUE(SQLiteDatabase::getQueryStatistics().isEmpty());
+}
+
 TEST_F(SQLiteDatabaseTest, testClearExistingTable)
 {
     SQLiteDatabase db(mTempDbFilePath);
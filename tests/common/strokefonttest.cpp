@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <QtCore>
+#include <librepcb/common/graphics/strokefont.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class StrokeFontTest : public ::testing::Test
+{
+    protected:
+        static void getExtents(const StrokeFont::Layout& layout, Point& min, Point& max) {
+            min = max = layout.strokes.first().first();
+            foreach (const QVector<Point>& stroke, layout.strokes) {
+                foreach (const Point& p, stroke) {
+                    min.setX(qMin(min.getX(), p.getX()));
+                    min.setY(qMin(min.getY(), p.getY()));
+                    max.setX(qMax(max.getX(), p.getX()));
+                    max.setY(qMax(max.getY(), p.getY()));
+                }
+            }
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(StrokeFontTest, testAlignment)
+{
+    Length height(1200000);
+    Point min, max;
+
+    // "H" is 4 units wide and 6 units (the cap height) high
+    getExtents(StrokeFont::get("H", height, Alignment(HAlign::left(), VAlign::bottom())),
+               min, max);
+    EXPECT_EQ(Point(0, 0), min);
+    EXPECT_EQ(Point(800000, 1200000), max);
+
+    getExtents(StrokeFont::get("H", height, Alignment(HAlign::right(), VAlign::top())),
+               min, max);
+    EXPECT_EQ(Point(-800000, -1200000), min);
+    EXPECT_EQ(Point(0, 0), max);
+
+    getExtents(StrokeFont::get("H", height, Alignment(HAlign::center(), VAlign::center())),
+               min, max);
+    EXPECT_EQ(Point(-400000, -600000), min);
+    EXPECT_EQ(Point(400000, 600000), max);
+}
+
+TEST_F(StrokeFontTest, testLayoutIsCachedAndIdentical)
+{
+    Alignment align(HAlign::left(), VAlign::bottom());
+    StrokeFont::Layout l1 = StrokeFont::get("R1\nC2", Length(1000000), align);
+    StrokeFont::Layout l2 = StrokeFont::get("R1\nC2", Length(1000000), align);
+    EXPECT_EQ(l1.strokes, l2.strokes);
+    EXPECT_EQ(l1.path, l2.path);
+    EXPECT_NE(l1.strokes, StrokeFont::get("R1\nC2", Length(2000000), align).strokes);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
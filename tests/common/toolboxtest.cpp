@@ -0,0 +1,75 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/toolbox.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ToolboxTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(ToolboxTest, testNaturalLessThan)
+{
+    EXPECT_TRUE(Toolbox::naturalLessThan("R2", "R10"));
+    EXPECT_FALSE(Toolbox::naturalLessThan("R10", "R2"));
+    EXPECT_FALSE(Toolbox::naturalLessThan("R1", "R1"));
+    EXPECT_TRUE(Toolbox::naturalLessThan("r1", "R2"));
+    EXPECT_TRUE(Toolbox::naturalLessThan("C9", "R1"));
+    EXPECT_TRUE(Toolbox::naturalLessThan("R", "R1"));
+    EXPECT_TRUE(Toolbox::naturalLessThan("U1-7", "U1-10"));
+    EXPECT_TRUE(Toolbox::naturalLessThan("U2-1", "U10-1"));
+
+    // equal in natural order, but still a strict weak ordering
+    EXPECT_NE(Toolbox::naturalLessThan("R01", "R1"), Toolbox::naturalLessThan("R1", "R01"));
+}
+
+TEST(ToolboxTest, testToCsvLine)
+{
+    EXPECT_EQ(QString(""), Toolbox::toCsvLine(QStringList()));
+    EXPECT_EQ(QString("a,b,"), Toolbox::toCsvLine({"a", "b", ""}));
+    EXPECT_EQ(QString("\"C1, C2\",100nF"), Toolbox::toCsvLine({"C1, C2", "100nF"}));
+    EXPECT_EQ(QString("\"2\"\" pin\""), Toolbox::toCsvLine({"2\" pin"}));
+    EXPECT_EQ(QString("\"line\nbreak\""), Toolbox::toCsvLine({"line\nbreak"}));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
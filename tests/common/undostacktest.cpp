@@ -0,0 +1,170 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/undostack.h>
+#include <librepcb/common/undocommand.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Class UndoCommandMock
+ ****************************************************************************************/
+
+/**
+ * @brief Command which does nothing but pretends to keep the given amount of memory
+ */
+class UndoCommandMock final : public UndoCommand
+{
+    public:
+        UndoCommandMock(const QString& text, qint64 size, QStringList& deleted) noexcept :
+            UndoCommand(text), mSize(size), mDeleted(deleted) {}
+        ~UndoCommandMock() noexcept {mDeleted.append(getText());}
+
+        qint64 getApproximateMemoryUsage() const noexcept override {
+            return UndoCommand::getApproximateMemoryUsage() + mSize;
+        }
+
+    private:
+        bool performExecute() override {return true;}
+        void performUndo() override {}
+        void performRedo() override {}
+
+        qint64 mSize;
+        QStringList& mDeleted;
+};
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class UndoStackTest : public ::testing::Test
+{
+    protected:
+        static constexpr qint64 sMiB = 1024 * 1024;
+        QStringList mDeleted; ///< texts of all deleted commands
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(UndoStackTest, testMemoryLimitRemovesOldestCommands)
+{
+    UndoStack stack;
+    stack.setMemoryLimit(10 * sMiB);
+    stack.execCmd(new UndoCommandMock("1", 3 * sMiB, mDeleted));
+    stack.execCmd(new UndoCommandMock("2", 3 * sMiB, mDeleted));
+    stack.execCmd(new UndoCommandMock("3", 3 * sMiB, mDeleted));
+    EXPECT_TRUE(mDeleted.isEmpty());
+
+    // the fourth command exceeds the limit, so the oldest command has to be removed
+    stack.execCmd(new UndoCommandMock("4", 3 * sMiB, mDeleted));
+    EXPECT_EQ(QStringList{"1"}, mDeleted);
+    EXPECT_LE(stack.getApproximateMemoryUsage(), 10 * sMiB);
+
+    // the remaining commands can still be undone, but the initial (clean) state is lost
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(stack.canUndo());
+        stack.undo();
+    }
+    EXPECT_FALSE(stack.canUndo());
+    EXPECT_FALSE(stack.isClean());
+}
+
+TEST_F(UndoStackTest, testMemoryLimitKeepsMostRecentCommand)
+{
+    UndoStack stack;
+    stack.setMemoryLimit(1 * sMiB);
+    stack.execCmd(new UndoCommandMock("1", 5 * sMiB, mDeleted));
+    EXPECT_TRUE(mDeleted.isEmpty());
+    stack.execCmd(new UndoCommandMock("2", 5 * sMiB, mDeleted));
+    EXPECT_EQ(QStringList{"1"}, mDeleted);
+    EXPECT_TRUE(stack.canUndo());
+    EXPECT_EQ(QString("Undo: 2"), stack.getUndoText());
+}
+
+TEST_F(UndoStackTest, testSetMemoryLimitTrimsExistingCommands)
+{
+    UndoStack stack;
+    stack.execCmd(new UndoCommandMock("1", 3 * sMiB, mDeleted));
+    stack.execCmd(new UndoCommandMock("2", 3 * sMiB, mDeleted));
+    stack.execCmd(new UndoCommandMock("3", 3 * sMiB, mDeleted));
+    EXPECT_TRUE(mDeleted.isEmpty()); // unlimited by default
+
+    stack.setMemoryLimit(5 * sMiB);
+    EXPECT_EQ((QStringList{"1", "2"}), mDeleted);
+    EXPECT_EQ(QString("Undo: 3"), stack.getUndoText());
+}
+
+TEST_F(UndoStackTest, testMemoryLimitDoesNotRemoveRedoableCommands)
+{
+    UndoStack stack;
+    stack.execCmd(new UndoCommandMock("1", 3 * sMiB, mDeleted));
+    stack.execCmd(new UndoCommandMock("2", 3 * sMiB, mDeleted));
+    stack.undo();
+
+    // only command "1" can be undone, so it has to be kept as the most recent one
+    stack.setMemoryLimit(1 * sMiB);
+    EXPECT_TRUE(mDeleted.isEmpty());
+    EXPECT_TRUE(stack.canUndo());
+    EXPECT_TRUE(stack.canRedo());
+}
+
+TEST_F(UndoStackTest, testMemoryUsageFollowsPushedAndDiscardedCommands)
+{
+    UndoStack stack;
+    EXPECT_EQ(0, stack.getApproximateMemoryUsage());
+    UndoCommandMock* cmd1 = new UndoCommandMock("1", 3 * sMiB, mDeleted);
+    qint64 size1 = cmd1->getApproximateMemoryUsage();
+    stack.execCmd(cmd1);
+    stack.execCmd(new UndoCommandMock("2", 5 * sMiB, mDeleted));
+    stack.undo();
+
+    // pushing a new command discards the redoable command "2"
+    UndoCommandMock* cmd3 = new UndoCommandMock("3", 1 * sMiB, mDeleted);
+    qint64 size3 = cmd3->getApproximateMemoryUsage();
+    stack.execCmd(cmd3);
+    EXPECT_EQ(QStringList{"2"}, mDeleted);
+    EXPECT_EQ(size1 + size3, stack.getApproximateMemoryUsage());
+
+    // a committed command group is measured including all its children
+    stack.beginCmdGroup("group");
+    stack.appendToCmdGroup(new UndoCommandMock("4", 2 * sMiB, mDeleted));
+    stack.commitCmdGroup();
+    EXPECT_GT(stack.getApproximateMemoryUsage(), size1 + size3 + 2 * sMiB);
+
+    stack.clear();
+    EXPECT_EQ(0, stack.getApproximateMemoryUsage());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
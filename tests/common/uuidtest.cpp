@@ -206,6 +206,20 @@ TEST_P(UuidTest, testOperatorComparisons)
     }
 }
 
+TEST_P(UuidTest, testQHash)
+{
+    const UuidTestData& data = GetParam();
+
+    Uuid uuid1(data.uuid);
+    Uuid uuid2(data.uuid.toUpper());
+    EXPECT_EQ(qHash(uuid1, 0), qHash(uuid2, 0));
+    if (data.valid) {
+        QHash<Uuid, int> hash;
+        hash.insert(uuid1, 42);
+        EXPECT_EQ(42, hash.value(uuid2, -1));
+    }
+}
+
 TEST(UuidTest, testCreateRandom)
 {
     for (int i = 0; i < 1000; i++) {
@@ -217,6 +231,23 @@ TEST(UuidTest, testCreateRandom)
     }
 }
 
+TEST(UuidTest, testDeterministicSeed)
+{
+    Uuid::setDeterministicSeed(42);
+    QList<Uuid> first;
+    for (int i = 0; i < 100; i++) {
+        first.append(Uuid::createRandom());
+    }
+    Uuid::setDeterministicSeed(42);
+    for (int i = 0; i < 100; i++) {
+        Uuid uuid = Uuid::createRandom();
+        EXPECT_EQ(first.at(i), uuid);
+        EXPECT_EQ(uuid, Uuid(uuid.toStr())); // must be a valid version 4 UUID
+    }
+    Uuid::setDeterministicSeed(0); // back to random UUIDs
+    EXPECT_FALSE(first.contains(Uuid::createRandom()));
+}
+
 /*****************************************************************************************
  *  Test Data
  ****************************************************************************************/
@@ -147,6 +147,17 @@ TEST(VersionTest, testToComparableStr)
               Version("0.0.3.0.600.0").toComparableStr());
 }
 
+TEST(VersionTest, testToComparableBlob)
+{
+    EXPECT_TRUE(Version("-1").toComparableBlob().isEmpty());
+    EXPECT_EQ(32, Version("0").toComparableBlob().size());
+    EXPECT_EQ(Version("1.2").toComparableBlob(), Version("1.2.0.0").toComparableBlob());
+    EXPECT_LT(Version("0.0.9").toComparableBlob(), Version("0.1").toComparableBlob());
+    EXPECT_LT(Version("9.99999").toComparableBlob(), Version("10").toComparableBlob());
+    EXPECT_LT(Version("1.2.3.4.5.6.7.8.9.9").toComparableBlob(),
+              Version("1.2.3.4.5.6.7.8.9.10").toComparableBlob());
+}
+
 TEST(VersionTest, testSetVersion)
 {
     Version v;
@@ -0,0 +1,156 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boardannotationdiff.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardAnnotationDiffTest : public ::testing::Test
+{
+    protected:
+        typedef BoardAnnotationDiff Diff;
+
+        static Diff::Component component(const QString& name, const Uuid& libComponent,
+                                         const QList<Uuid>& devices) noexcept {
+            return Diff::Component{Uuid::createRandom(), name, libComponent, false,
+                                   QHash<Uuid, Uuid>(), devices};
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardAnnotationDiffTest, testEmptyStateIsUpToDate)
+{
+    Diff::Result result = Diff::calculate(Diff::State());
+    EXPECT_TRUE(result.isEmpty());
+    EXPECT_TRUE(result.warnings.isEmpty());
+}
+
+TEST_F(BoardAnnotationDiffTest, testDeviceOperations)
+{
+    Uuid libCmp = Uuid::createRandom();
+    Uuid libCmpOld = Uuid::createRandom();
+    Uuid libDev = Uuid::createRandom();
+    Diff::State state;
+    state.gridInterval = Length(2540000);
+    state.components.append(component("R1", libCmp, {libDev}));     // missing device
+    state.components.append(component("R2", libCmp, {libDev}));     // replaced device
+    state.components.append(component("R3", libCmp, {libDev}));     // unchanged device
+    state.components.append(component("R4", libCmp, {}));           // no device known
+    Diff::Component schematicOnly = component("FRAME", libCmp, {libDev});
+    schematicOnly.schematicOnly = true;
+    state.components.append(schematicOnly);
+    state.devices.append(Diff::Device{state.components[1].uuid, Uuid::createRandom(), libCmpOld});
+    state.devices.append(Diff::Device{state.components[2].uuid, libDev, libCmp});
+    state.devices.append(Diff::Device{schematicOnly.uuid, libDev, libCmp});
+    state.devices.append(Diff::Device{Uuid::createRandom(), libDev, libCmp}); // removed cmp
+
+    Diff::Result result = Diff::calculate(state);
+    ASSERT_EQ(1, result.addedDevices.count());
+    EXPECT_EQ(state.components[0].uuid, result.addedDevices.first().componentUuid);
+    EXPECT_EQ(libDev, result.addedDevices.first().libDeviceUuid);
+    ASSERT_EQ(1, result.replacedDevices.count());
+    EXPECT_EQ(state.components[1].uuid, result.replacedDevices.first().componentUuid);
+    ASSERT_EQ(2, result.removedDevices.count());
+    EXPECT_TRUE(result.removedDevices.contains(schematicOnly.uuid));
+    EXPECT_TRUE(result.removedDevices.contains(state.devices[3].componentUuid));
+    EXPECT_EQ(1, result.warnings.count()); // R4
+}
+
+TEST_F(BoardAnnotationDiffTest, testTracesFollowPadNetSignals)
+{
+    Uuid libCmp = Uuid::createRandom();
+    Uuid signal = Uuid::createRandom();
+    Uuid oldNet = Uuid::createRandom();
+    Uuid newNet = Uuid::createRandom();
+    Diff::State state;
+    Diff::Component cmp = component("R1", libCmp, {});
+    cmp.signalNetSignals.insert(signal, newNet);
+    state.components.append(cmp);
+    state.devices.append(Diff::Device{cmp.uuid, Uuid::createRandom(), libCmp});
+
+    // pad -- netpoint -- via
+    Uuid via = Uuid::createRandom();
+    state.vias.append(Diff::Via{via, oldNet});
+    Diff::NetPoint p1{Uuid::createRandom(), oldNet, cmp.uuid, signal, Uuid()};
+    Diff::NetPoint p2{Uuid::createRandom(), oldNet, Uuid(), Uuid(), Uuid()};
+    Diff::NetPoint p3{Uuid::createRandom(), oldNet, Uuid(), Uuid(), via};
+    state.netPoints << p1 << p2 << p3;
+    state.netLines.append(Diff::NetLine{p1.uuid, p2.uuid});
+    state.netLines.append(Diff::NetLine{p2.uuid, p3.uuid});
+
+    // an unrelated trace which is not connected to any pad
+    Diff::NetPoint p4{Uuid::createRandom(), oldNet, Uuid(), Uuid(), Uuid()};
+    state.netPoints << p4;
+
+    Diff::Result result = Diff::calculate(state);
+    EXPECT_TRUE(result.warnings.isEmpty());
+    EXPECT_EQ(3, result.netPointChanges.count());
+    ASSERT_EQ(1, result.viaChanges.count());
+    EXPECT_EQ(via, result.viaChanges.first().itemUuid);
+    EXPECT_EQ(newNet, result.viaChanges.first().netSignalUuid);
+}
+
+TEST_F(BoardAnnotationDiffTest, testShortCircuitIsReported)
+{
+    Uuid libCmp = Uuid::createRandom();
+    Uuid signal1 = Uuid::createRandom();
+    Uuid signal2 = Uuid::createRandom();
+    Uuid net1 = Uuid::createRandom();
+    Uuid net2 = Uuid::createRandom();
+    Diff::State state;
+    Diff::Component cmp = component("R1", libCmp, {});
+    cmp.signalNetSignals.insert(signal1, net1);
+    cmp.signalNetSignals.insert(signal2, net2);
+    state.components.append(cmp);
+    state.devices.append(Diff::Device{cmp.uuid, Uuid::createRandom(), libCmp});
+    Diff::NetPoint p1{Uuid::createRandom(), net1, cmp.uuid, signal1, Uuid()};
+    Diff::NetPoint p2{Uuid::createRandom(), net1, cmp.uuid, signal2, Uuid()};
+    state.netPoints << p1 << p2;
+    state.netLines.append(Diff::NetLine{p1.uuid, p2.uuid});
+
+    Diff::Result result = Diff::calculate(state);
+    EXPECT_TRUE(result.isEmpty()); // conflicts are not resolved automatically
+    EXPECT_EQ(1, result.warnings.count());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,136 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boarditemgeometry.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardItemGeometryTest : public ::testing::Test
+{
+    protected:
+        static QRectF getBounds(const PolygonClipper::Path& path) noexcept {
+            qreal left = path.first().getX().toNm(), right = left;
+            qreal top = path.first().getY().toNm(), bottom = top;
+            for (const Point& p : path) {
+                left = qMin(left, qreal(p.getX().toNm()));
+                right = qMax(right, qreal(p.getX().toNm()));
+                top = qMin(top, qreal(p.getY().toNm()));
+                bottom = qMax(bottom, qreal(p.getY().toNm()));
+            }
+            return QRectF(QPointF(left, top), QPointF(right, bottom));
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardItemGeometryTest, testCircleOutlineContainsExactArea)
+{
+    Point center(Length(1000000), Length(-2000000));
+    BoardItemGeometry geometry = BoardItemGeometry::circle(center, Length(1000000));
+    const PolygonClipper::Path& outline = geometry.getOutline(Length(200000), Length(1000));
+    ASSERT_GE(outline.count(), 8);
+    qreal radius = 700000;
+    for (int i = 0; i < outline.count(); ++i) {
+        // the vertices and the edge midpoints must not be inside the exact circle
+        Point mid = (outline.at(i) + outline.at((i + 1) % outline.count())) / 2;
+        EXPECT_GE((outline.at(i) - center).getLength().toNm(), radius);
+        EXPECT_GE((mid - center).getLength().toNm(), radius - 1);
+    }
+    qreal area = PolygonClipper::calcArea(outline);
+    EXPECT_GT(area, M_PI * radius * radius);
+    EXPECT_LT(area, M_PI * (radius + 1000) * (radius + 1000));
+}
+
+TEST_F(BoardItemGeometryTest, testRectOutlineWithClearance)
+{
+    BoardItemGeometry geometry = BoardItemGeometry::rect(Point(), Length(2000000),
+                                                         Length(1000000), Angle::deg0(),
+                                                         false);
+    EXPECT_EQ(Length(0), geometry.getRadius());
+    EXPECT_EQ(2e12, PolygonClipper::calcArea(geometry.getOutline(Length(0))));
+    qreal c = 100000;
+    qreal area = PolygonClipper::calcArea(geometry.getOutline(Length(100000), Length(1000)));
+    qreal exact = (2000000 + 2 * c) * (1000000 + 2 * c) - (4 - M_PI) * c * c;
+    EXPECT_GT(area, exact);
+    EXPECT_LT(area, exact * 1.001);
+}
+
+TEST_F(BoardItemGeometryTest, testRotatedAndMirroredPads)
+{
+    Point center(Length(500000), Length(500000));
+    BoardItemGeometry geometry = BoardItemGeometry::rect(center, Length(2000000),
+                                                         Length(1000000), Angle::deg90(),
+                                                         true);
+    EXPECT_EQ(QRectF(QPointF(0, -500000), QPointF(1000000, 1500000)),
+              getBounds(geometry.getOutline(Length(0))));
+    BoardItemGeometry obround = BoardItemGeometry::obround(Point(), Length(1000000),
+                                                           Length(3000000), Angle::deg0(),
+                                                           false);
+    ASSERT_EQ(2, obround.getPoints().count());
+    EXPECT_EQ(Length(500000), obround.getRadius());
+    EXPECT_EQ(Length(2000000), (obround.getPoints().at(1) - obround.getPoints().at(0)).getLength());
+}
+
+TEST_F(BoardItemGeometryTest, testOctagonTouchesBoundingRect)
+{
+    BoardItemGeometry geometry = BoardItemGeometry::octagon(Point(), Length(1000000),
+                                                            Length(1000000), Angle::deg0(),
+                                                            false);
+    const PolygonClipper::Path& outline = geometry.getOutline(Length(0));
+    ASSERT_EQ(8, outline.count());
+    EXPECT_EQ(QRectF(QPointF(-500000, -500000), QPointF(500000, 500000)), getBounds(outline));
+    // a regular octagon with a flat-to-flat size of 1mm
+    qreal area = PolygonClipper::calcArea(outline);
+    EXPECT_NEAR(2 * (M_SQRT2 - 1) * 1e12, area, 1e6);
+}
+
+TEST_F(BoardItemGeometryTest, testTranslated)
+{
+    BoardItemGeometry geometry = BoardItemGeometry::line(Point(), Point(Length(1000), Length(0)),
+                                                         Length(200));
+    BoardItemGeometry moved = geometry.translated(Point(Length(10), Length(20)));
+    EXPECT_EQ(BoardItemGeometry::line(Point(Length(10), Length(20)),
+                                      Point(Length(1010), Length(20)), Length(200)), moved);
+    EXPECT_NE(geometry, moved);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,108 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardTest : public ::testing::Test
+{
+    protected:
+        FilePath mProjectDir;
+        QScopedPointer<Project> mProject;
+        Board* mBoard;
+        NetSignal* mNetSignal;
+
+        BoardTest() {
+            mProjectDir = FilePath::getRandomTempPath();
+            mProject.reset(Project::create(mProjectDir.getPathTo("project.lpp")));
+            mBoard = mProject->createBoard("board");
+            mProject->addBoard(*mBoard);
+            Circuit& circuit = mProject->getCircuit();
+            NetClass* netclass = new NetClass(circuit, "default");
+            circuit.addNetClass(*netclass);
+            mNetSignal = new NetSignal(circuit, *netclass, "net", false);
+            circuit.addNetSignal(*mNetSignal);
+        }
+
+        virtual ~BoardTest() {
+            mProject.reset();
+            QDir(mProjectDir.toStr()).removeRecursively();
+        }
+
+        BI_Via* addVia(const Point& pos) {
+            BI_Via* via = new BI_Via(*mBoard, pos, BI_Via::Shape::Round, Length(800000),
+                                     Length(300000), mNetSignal);
+            mBoard->addVia(*via);
+            return via;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardTest, testItemsAtScenePosAreInBoardOrder)
+{
+    // the last added via is the topmost one in the graphics scene, but the hit test
+    // must return the items in the order of the board, not in the stacking order
+    Point pos(Length(1000000), Length(2000000));
+    BI_Via* via1 = addVia(pos);
+    BI_Via* via2 = addVia(pos + Point(Length(100000), Length(0)));
+    BI_Via* via3 = addVia(pos - Point(Length(100000), Length(0)));
+    addVia(pos + Point(Length(10000000), Length(0))); // not at the position
+
+    QList<BI_Base*> expectedItems = {via1, via2, via3};
+    EXPECT_EQ(expectedItems, mBoard->getItemsAtScenePos(pos));
+    QList<BI_Via*> expectedVias = {via1, via2, via3};
+    EXPECT_EQ(expectedVias, mBoard->getViasAtScenePos(pos, nullptr));
+
+    // removing and adding a via again moves it to the end
+    mBoard->removeVia(*via1);
+    mBoard->addVia(*via1);
+    expectedItems = {via2, via3, via1};
+    EXPECT_EQ(expectedItems, mBoard->getItemsAtScenePos(pos));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,101 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/jobscheduler.h>
+#include <librepcb/project/projectarchive.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ProjectArchiveTest : public ::testing::Test
+{
+    protected:
+        FilePath mTmpDir;
+        FilePath mProjectDir;
+
+        ProjectArchiveTest() {
+            mTmpDir = FilePath::getRandomTempPath();
+            mProjectDir = mTmpDir.getPathTo("source/test project");
+            FileUtils::writeFile(mProjectDir.getPathTo("test project.lpp"), "<project/>\n");
+            FileUtils::writeFile(mProjectDir.getPathTo("boards/board.xml"),
+                                 QByteArray(100000, 'x'));
+            FileUtils::writeFile(mProjectDir.getPathTo("boards/board.xml~"), "backup");
+            FileUtils::writeFile(mProjectDir.getPathTo(".lock"), "lock");
+        }
+
+        virtual ~ProjectArchiveTest() {
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ProjectArchiveTest, testExcludedFiles)
+{
+    EXPECT_TRUE(ProjectArchive::isExcludedFile(".lock", false));
+    EXPECT_FALSE(ProjectArchive::isExcludedFile("boards/board.xml~", false));
+    EXPECT_TRUE(ProjectArchive::isExcludedFile("boards/board.xml~", true));
+    EXPECT_TRUE(ProjectArchive::isExcludedFile(".librepcb-cache/foo", true));
+    EXPECT_FALSE(ProjectArchive::isExcludedFile("boards/board.xml", true));
+}
+
+TEST_F(ProjectArchiveTest, testExportImport)
+{
+    JobScheduler scheduler(2);
+    FilePath zipFile = mTmpDir.getPathTo("archive.zip");
+    ProjectArchive::exportProject(mProjectDir, zipFile, scheduler, true);
+    ASSERT_TRUE(zipFile.isExistingFile());
+
+    FilePath destDir = mTmpDir.getPathTo("dest");
+    FilePath projectFile = ProjectArchive::importArchive(zipFile, destDir);
+    EXPECT_EQ(destDir.getPathTo("test project/test project.lpp"), projectFile);
+    EXPECT_EQ(QByteArray("<project/>\n"), FileUtils::readFile(projectFile));
+    EXPECT_EQ(QByteArray(100000, 'x'), FileUtils::readFile(
+                  destDir.getPathTo("test project/boards/board.xml")));
+    EXPECT_FALSE(destDir.getPathTo("test project/boards/board.xml~").isExistingFile());
+    EXPECT_FALSE(destDir.getPathTo("test project/.lock").isExistingFile());
+
+    // the project directory must not be overwritten
+    EXPECT_THROW(ProjectArchive::importArchive(zipFile, destDir), Exception);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,125 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/projectjournal.h>
+#include <librepcb/project/projectsnapshot.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ProjectJournalTest : public ::testing::Test
+{
+    protected:
+        FilePath mProjectDir;
+        FilePath mProjectFile;
+        FilePath mCircuitBackup;
+
+        ProjectJournalTest() {
+            mProjectDir = FilePath::getRandomTempPath().getPathTo("journal test");
+            mProjectFile = mProjectDir.getPathTo("project.lpp");
+            mCircuitBackup = mProjectDir.getPathTo("core/circuit.xml~");
+        }
+
+        virtual ~ProjectJournalTest() {
+            QDir(mProjectDir.getParentDir().toStr()).removeRecursively();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ProjectJournalTest, testAppendOnlyModifiedDocuments)
+{
+    QScopedPointer<Project> project(Project::create(mProjectFile));
+    ProjectSnapshot snapshot(*project, ProjectSnapshot());
+    ProjectJournal journal(mProjectDir);
+    EXPECT_EQ(0, journal.getSize());
+    EXPECT_EQ(1, journal.append(snapshot)); // only the circuit
+    qint64 size = journal.getSize();
+    EXPECT_GT(size, 0);
+    EXPECT_EQ(0, journal.append(ProjectSnapshot(*project, snapshot)));
+    EXPECT_EQ(size, journal.getSize());
+    journal.clear();
+    EXPECT_FALSE(journal.getFilePath().isExistingFile());
+    EXPECT_EQ(1, journal.append(snapshot)); // all documents again after clearing
+}
+
+TEST_F(ProjectJournalTest, testReplay)
+{
+    QScopedPointer<Project> project(Project::create(mProjectFile));
+    ProjectSnapshot snapshot(*project, ProjectSnapshot());
+    ProjectJournal journal(mProjectDir);
+    journal.append(snapshot);
+    ASSERT_FALSE(mCircuitBackup.isExistingFile());
+    EXPECT_EQ(1, ProjectJournal::replay(mProjectDir));
+    EXPECT_EQ(snapshot.getCircuit().dom->toByteArray(),
+              FileUtils::readFile(mCircuitBackup));
+}
+
+TEST_F(ProjectJournalTest, testReplayIgnoresIncompleteRecord)
+{
+    QScopedPointer<Project> project(Project::create(mProjectFile));
+    ProjectJournal journal(mProjectDir);
+    journal.append(ProjectSnapshot(*project, ProjectSnapshot()));
+    QByteArray content = FileUtils::readFile(journal.getFilePath());
+    content.chop(3);
+    FileUtils::writeFile(journal.getFilePath(), content);
+    EXPECT_EQ(0, ProjectJournal::replay(mProjectDir));
+    EXPECT_FALSE(mCircuitBackup.isExistingFile());
+}
+
+TEST_F(ProjectJournalTest, testDiscard)
+{
+    QScopedPointer<Project> project(Project::create(mProjectFile));
+    ProjectJournal journal(mProjectDir);
+    journal.append(ProjectSnapshot(*project, ProjectSnapshot()));
+    journal.discard(journal.getSize());
+    EXPECT_FALSE(journal.getFilePath().isExistingFile());
+    EXPECT_EQ(0, ProjectJournal::replay(mProjectDir));
+}
+
+TEST_F(ProjectJournalTest, testReplayWithoutJournal)
+{
+    EXPECT_EQ(0, ProjectJournal::replay(mProjectDir));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
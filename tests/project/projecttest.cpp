@@ -23,7 +23,9 @@
 #include <QtCore>
 #include <gtest/gtest.h>
 #include <librepcb/common/systeminfo.h>
+#include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/project/project.h>
+#include <librepcb/project/boards/board.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -177,6 +179,35 @@ TEST_F(ProjectTest, testSettersGetters)
     EXPECT_EQ(version, project->getVersion());
 }
 
+TEST_F(ProjectTest, testReloadModifiedBoardOfUnmodifiedProject)
+{
+    // create a project with a board and open it again (i.e. without modifications)
+    QScopedPointer<Project> project(Project::create(mProjectFile));
+    project->addBoard(*project->createBoard("original board"));
+    project->save(true);
+    project.reset();
+    project.reset(new Project(mProjectFile, false));
+    ASSERT_EQ(1, project->getBoards().count());
+    const Uuid boardUuid = project->getBoardByIndex(0)->getUuid();
+
+    // modify the board file like another application would do (e.g. git checkout)
+    FilePath boardFile = project->getBoardByIndex(0)->getFilePath();
+    QByteArray content = FileUtils::readFile(boardFile);
+    ASSERT_TRUE(content.contains(">original board<"));
+    content.replace(">original board<", ">modified board<");
+    FileUtils::writeFile(boardFile, content);
+
+    // the modification must be detected although the board was not modified in memory
+    EXPECT_TRUE(project->reloadModifiedFiles());
+    ASSERT_EQ(1, project->getBoards().count());
+    EXPECT_EQ(boardUuid, project->getBoardByIndex(0)->getUuid());
+    EXPECT_EQ(QString("modified board"), project->getBoardByIndex(0)->getName());
+
+    // now everything is up to date
+    EXPECT_TRUE(project->reloadModifiedFiles());
+    EXPECT_EQ(QString("modified board"), project->getBoardByIndex(0)->getName());
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
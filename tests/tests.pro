@@ -52,20 +52,51 @@ PRE_TARGETDEPS += \
     $${DESTDIR}/libquazip.a
 
 SOURCES += \
+    common/angletest.cpp \
     common/applicationtest.cpp \
+    common/attributetest.cpp \
+    common/cambenchmarktest.cpp \
+    common/camimagecomparatortest.cpp \
+    common/camimagewritertest.cpp \
+    common/camnumberformattertest.cpp \
+    common/compactpolygonlisttest.cpp \
+    common/debugtracetest.cpp \
     common/directorylocktest.cpp \
+    common/excellongeneratortest.cpp \
     common/filedownloadtest.cpp \
+    common/fileio/domdocumenttest.cpp \
+    common/fileio/filewritebatchtest.cpp \
+    common/fileio/mappedfiletest.cpp \
     common/fileio/serializableobjectlisttest.cpp \
+    common/fileio/sharedfilestoretest.cpp \
     common/filepathtest.cpp \
+    common/gerberaperturelisttest.cpp \
+    common/gerbergeneratortest.cpp \
+    common/jobschedulertest.cpp \
+    common/lengthtest.cpp \
+    common/memoryreporttest.cpp \
     common/networkrequesttest.cpp \
+    common/objectpooltest.cpp \
+    common/orderedsettest.cpp \
+    common/pickplacegeneratortest.cpp \
     common/pointtest.cpp \
+    common/polygonclippertest.cpp \
+    common/polygontest.cpp \
     common/ratiotest.cpp \
     common/scopeguardtest.cpp \
     common/sqlitedatabasetest.cpp \
+    common/strokefonttest.cpp \
     common/systeminfotest.cpp \
+    common/toolboxtest.cpp \
+    common/undostacktest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     main.cpp \
+    project/boardannotationdifftest.cpp \
+    project/boarditemgeometrytest.cpp \
+    project/boardtest.cpp \
+    project/projectarchivetest.cpp \
+    project/projectjournaltest.cpp \
     project/projecttest.cpp \
     workspace/workspacetest.cpp \
 